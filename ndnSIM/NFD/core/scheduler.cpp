@@ -25,6 +25,9 @@
 
 #include "scheduler.hpp"
 
+#include <algorithm>
+#include <unordered_set>
+
 namespace ns3 {
 
 /// @cond include_hidden
@@ -46,9 +49,84 @@ struct EventMemberImplObjTraits<std::function<void()>> {
 namespace nfd {
 namespace scheduler {
 
+static time::nanoseconds g_slack = time::nanoseconds::zero();
+
+/** \brief an event sharing the simulator event of its tick with others
+ */
+struct CoalescedEvent
+{
+  EventId id; ///< holds an empty ns3::EventId, identifies the event for cancel
+  int64_t deadline;
+  std::function<void()> callback;
+};
+
+/// coalesced events by tick, i.e. deadline divided by slack
+static std::unordered_map<int64_t, std::vector<CoalescedEvent>> g_ticks;
+
+/// coalesced events that are neither fired nor cancelled
+static std::unordered_set<const ns3::EventId*> g_pending;
+
+static bool g_isCleanupScheduled = false;
+
+static void
+fireTick(int64_t tick)
+{
+  auto i = g_ticks.find(tick);
+  if (i == g_ticks.end())
+    return;
+
+  std::vector<CoalescedEvent> events = std::move(i->second);
+  g_ticks.erase(i);
+
+  std::stable_sort(events.begin(), events.end(),
+                   [] (const CoalescedEvent& a, const CoalescedEvent& b) {
+                     return a.deadline < b.deadline;
+                   });
+  for (const CoalescedEvent& event : events) {
+    if (g_pending.erase(event.id.get()) > 0)
+      event.callback();
+  }
+}
+
+static void
+clearTicks()
+{
+  // simulator events of the ticks are gone with the simulator
+  g_ticks.clear();
+  g_pending.clear();
+  g_isCleanupScheduled = false;
+}
+
+static EventId
+scheduleCoalesced(const time::nanoseconds& after, const std::function<void()>& event)
+{
+  int64_t now = ns3::Simulator::Now().GetNanoSeconds();
+  int64_t deadline = now + after.count();
+  int64_t slack = g_slack.count();
+  int64_t tick = (deadline + slack - 1) / slack;
+
+  std::vector<CoalescedEvent>& events = g_ticks[tick];
+  if (events.empty()) {
+    ns3::Simulator::Schedule(ns3::NanoSeconds(tick * slack - now), &fireTick, tick);
+    if (!g_isCleanupScheduled) {
+      ns3::Simulator::ScheduleDestroy(&clearTicks);
+      g_isCleanupScheduled = true;
+    }
+  }
+
+  EventId id = std::make_shared<ns3::EventId>();
+  events.push_back(CoalescedEvent{id, deadline, event});
+  g_pending.insert(id.get());
+  return id;
+}
+
 EventId
 schedule(const time::nanoseconds& after, const std::function<void()>& event)
 {
+  if (g_slack > time::nanoseconds::zero() && after > time::nanoseconds::zero()) {
+    return scheduleCoalesced(after, event);
+  }
+
   ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
                                              &std::function<void()>::operator(), event);
   return std::make_shared<ns3::EventId>(id);
@@ -58,11 +136,25 @@ void
 cancel(const EventId& eventId)
 {
   if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
+    // a coalesced event holds an empty ns3::EventId, which the simulator ignores
+    if (g_pending.empty() || g_pending.erase(eventId.get()) == 0)
+      ns3::Simulator::Remove(*eventId);
     const_cast<EventId&>(eventId).reset();
   }
 }
 
+void
+setTimerSlack(const time::nanoseconds& slack)
+{
+  g_slack = std::max(slack, time::nanoseconds::zero());
+}
+
+time::nanoseconds
+getTimerSlack()
+{
+  return g_slack;
+}
+
 ScopedEventId::ScopedEventId()
 {
 }
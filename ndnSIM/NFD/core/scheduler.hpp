@@ -48,6 +48,23 @@ schedule(const time::nanoseconds& after, const std::function<void()>& event);
 void
 cancel(const EventId& eventId);
 
+/** \brief set the timer slack, by which events may fire late
+ *
+ *  With a positive slack, the deadline of an event scheduled after a non-zero delay is
+ *  rounded up to a multiple of the slack.  Events with the same rounded deadline share one
+ *  simulator event, fired in the order of their deadlines, so scheduling them mostly does not
+ *  insert into the simulator event queue and cancelling them does not remove from it.
+ *  A cancelled event is dropped when its shared event fires.
+ *
+ *  The default slack is zero: every event is a simulator event of its own and fires exactly
+ *  at its deadline.  Events already scheduled are not affected by a change of the slack.
+ */
+void
+setTimerSlack(const time::nanoseconds& slack);
+
+time::nanoseconds
+getTimerSlack();
+
 /** \brief cancels an event automatically upon destruction
  */
 class ScopedEventId : noncopyable
@@ -69,9 +69,47 @@ public:
     return time::milliseconds(1000);
   }
 
+  /** \brief publishes the dataset
+   *
+   *  The segments are kept after they are generated and signed.  Until the freshness period
+   *  has passed or invalidate() is called, publish() puts the same segments again, under the
+   *  same version, instead of generating and signing the dataset for every request.
+   */
   void
   publish()
   {
+    if (m_segments.empty() || time::steady_clock::now() >= m_segmentsExpiry) {
+      generateSegments();
+    }
+
+    for (const shared_ptr<Data>& data : m_segments) {
+      m_face.put(*data);
+    }
+  }
+
+  /** \brief discards the kept segments, the next publish() generates the dataset again
+   *
+   *  Call this when the table behind the dataset changes.
+   */
+  void
+  invalidate()
+  {
+    m_segments.clear();
+  }
+
+protected:
+  /** \brief In a derived class, write the octets into outBuffer.
+   */
+  virtual size_t
+  generate(ndn::EncodingBuffer& outBuffer) = 0;
+
+private:
+  void
+  generateSegments()
+  {
+    m_segments.clear();
+    m_segmentsExpiry = time::steady_clock::now() + m_freshnessPeriod;
+
     ndn::EncodingBuffer buffer;
     generate(buffer);
 
@@ -101,30 +139,20 @@ public:
         data->setFinalBlockId(segmentName[-1]);
       }
 
-      publishSegment(data);
+      m_keyChain.sign(*data);
+      m_segments.push_back(data);
       ++segmentNo;
     } while (segmentBegin < end);
   }
 
-protected:
-  /** \brief In a derived class, write the octets into outBuffer.
-   */
-  virtual size_t
-  generate(ndn::EncodingBuffer& outBuffer) = 0;
-
-private:
-  void
-  publishSegment(shared_ptr<Data>& data)
-  {
-    m_keyChain.sign(*data);
-    m_face.put(*data);
-  }
-
 private:
   FaceBase& m_face;
   const Name m_prefix;
   ndn::KeyChain& m_keyChain;
   const time::milliseconds m_freshnessPeriod;
+
+  std::vector<shared_ptr<Data>> m_segments;
+  time::steady_clock::TimePoint m_segmentsExpiry;
 };
 
 } // namespace nfd
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_SPSC_QUEUE_HPP
+#define NFD_CORE_SPSC_QUEUE_HPP
+
+#include "common.hpp"
+
+#include <atomic>
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief bounded lock-free queue with one producer thread and one consumer thread
+ *  \tparam T element type, must be move constructible
+ *
+ *  tryPush may only be called from the producer thread, tryPop from the consumer thread.
+ *  Neither call blocks or allocates: a full queue rejects the element, an empty queue
+ *  returns nothing.
+ */
+template<typename T>
+class SpscQueue : noncopyable
+{
+public:
+  /** \param capacity maximum number of queued elements, rounded up to a power of two
+   */
+  explicit
+  SpscQueue(size_t capacity)
+    : m_mask(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2)) - 1)
+    , m_slots(m_mask + 1)
+    , m_head(0)
+    , m_tail(0)
+  {
+  }
+
+  ~SpscQueue()
+  {
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i) {
+      slot(i)->~T();
+    }
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_mask + 1;
+  }
+
+  /** \brief number of queued elements
+   *
+   *  Exact only when called from the producer or consumer thread while the other is idle.
+   */
+  size_t
+  size() const
+  {
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+  }
+
+  bool
+  empty() const
+  {
+    return size() == 0;
+  }
+
+  /** \brief appends an element, called by the producer
+   *  \return false if the queue is full; \p element is left unchanged in that case
+   */
+  bool
+  tryPush(T&& element)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+      return false;
+
+    new (slot(tail)) T(std::move(element));
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool
+  tryPush(const T& element)
+  {
+    T copy(element);
+    return tryPush(std::move(copy));
+  }
+
+  /** \brief removes the oldest element, called by the consumer
+   *  \return false if the queue is empty
+   */
+  bool
+  tryPop(T& element)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+      return false;
+
+    T* queued = slot(head);
+    element = std::move(*queued);
+    queued->~T();
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static size_t
+  roundUpToPowerOfTwo(size_t n)
+  {
+    size_t power = 1;
+    while (power < n)
+      power <<= 1;
+    return power;
+  }
+
+  T*
+  slot(size_t index)
+  {
+    return reinterpret_cast<T*>(&m_slots[index & m_mask]);
+  }
+
+private:
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+  const size_t m_mask;
+  std::vector<Slot> m_slots;
+
+  // head and tail are written by different threads, keep them on different cache lines
+  alignas(64) std::atomic<size_t> m_head; ///< index of the oldest element, written by the consumer
+  alignas(64) std::atomic<size_t> m_tail; ///< index past the newest element, written by the producer
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SPSC_QUEUE_HPP
@@ -29,6 +29,13 @@
 #include "face.hpp"
 #include "core/global-io.hpp"
 
+#ifdef __linux__
+#include <cerrno>       // for errno
+#include <cstring>      // for std::memset()
+#include <deque>
+#include <sys/socket.h> // for recvmmsg() and sendmmsg()
+#endif
+
 namespace nfd {
 
 struct Unicast {};
@@ -62,6 +69,19 @@ public:
                   size_t nBytesReceived,
                   const boost::system::error_code& error);
 
+  /** \brief set the maximum number of datagrams received or sent with one system call
+   *
+   *  On Linux, a batch size greater than 1 makes the face drain datagrams queued on the
+   *  socket with recvmmsg(2) after each receive completion, and makes outgoing packets
+   *  queued in the same event loop iteration go out with a single sendmmsg(2).
+   *  Elsewhere, datagrams are always received and sent one at a time.
+   */
+  void
+  setBatchSize(size_t batchSize);
+
+  size_t
+  getBatchSize() const;
+
 protected:
   void
   processErrorCode(const boost::system::error_code& error);
@@ -75,6 +95,28 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  void
+  startReceive();
+
+  void
+  sendPayload(const Block& payload);
+
+#ifdef __linux__
+  /** \brief receive and process the datagrams already queued on the socket, without blocking
+   */
+  void
+  receiveBatch();
+
+  /** \brief send queued payloads with sendmmsg(2) until the queue is empty or the socket
+   *         would block
+   */
+  void
+  flushSendQueue();
+
+  void
+  handleWritable(const boost::system::error_code& error);
+#endif
+
   void
   keepFaceAliveUntilAllHandlersExecuted(const shared_ptr<Face>& face);
 
@@ -98,6 +140,16 @@ protected:
 private:
   uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
   bool m_hasBeenUsedRecently;
+  size_t m_batchSize;
+
+#ifdef __linux__
+  std::vector<uint8_t> m_batchBuffer;
+  std::vector<iovec> m_recvIovecs;
+  std::vector<mmsghdr> m_recvMessages;
+
+  std::deque<Block> m_sendQueue;
+  bool m_isFlushScheduled;
+#endif
 };
 
 
@@ -107,13 +159,14 @@ DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localU
                                  typename DatagramFace::protocol::socket socket)
   : Face(remoteUri, localUri, false, std::is_same<U, Multicast>::value)
   , m_socket(std::move(socket))
+  , m_batchSize(1)
+#ifdef __linux__
+  , m_isFlushScheduled(false)
+#endif
 {
   NFD_LOG_FACE_INFO("Creating face");
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&DatagramFace<T, U>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  startReceive();
 }
 
 template<class T, class U>
@@ -124,12 +177,7 @@ DatagramFace<T, U>::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  const Block& payload = interest.wireEncode();
-  m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                      bind(&DatagramFace<T, U>::handleSend, this,
-                           boost::asio::placeholders::error,
-                           boost::asio::placeholders::bytes_transferred,
-                           payload));
+  sendPayload(interest.wireEncode());
 }
 
 template<class T, class U>
@@ -140,7 +188,26 @@ DatagramFace<T, U>::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  const Block& payload = data.wireEncode();
+  sendPayload(data.wireEncode());
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::sendPayload(const Block& payload)
+{
+#ifdef __linux__
+  if (m_batchSize > 1) {
+    m_sendQueue.push_back(payload);
+    if (!m_isFlushScheduled) {
+      // packets sent by the forwarder while processing the current event are sent together
+      m_isFlushScheduled = true;
+      shared_ptr<Face> self = this->shared_from_this();
+      getGlobalIoService().post([this, self] { flushSendQueue(); });
+    }
+    return;
+  }
+#endif
+
   m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
                       bind(&DatagramFace<T, U>::handleSend, this,
                            boost::asio::placeholders::error,
@@ -210,12 +277,135 @@ DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
 {
   receiveDatagram(m_inputBuffer, nBytesReceived, error);
 
+#ifdef __linux__
+  if (!error && m_batchSize > 1 && m_socket.is_open())
+    receiveBatch();
+#endif
+
   if (m_socket.is_open())
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                           bind(&DatagramFace<T, U>::handleReceive, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+    startReceive();
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::startReceive()
+{
+  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
+                         bind(&DatagramFace<T, U>::handleReceive, this,
+                              boost::asio::placeholders::error,
+                              boost::asio::placeholders::bytes_transferred));
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::setBatchSize(size_t batchSize)
+{
+  m_batchSize = std::max<size_t>(batchSize, 1);
+
+#ifdef __linux__
+  // the first datagram of each batch is received into m_inputBuffer by async_receive
+  size_t nExtraMessages = m_batchSize - 1;
+  m_batchBuffer.resize(nExtraMessages * ndn::MAX_NDN_PACKET_SIZE);
+  m_recvIovecs.resize(nExtraMessages);
+  m_recvMessages.resize(nExtraMessages);
+  for (size_t i = 0; i < nExtraMessages; ++i) {
+    m_recvIovecs[i].iov_base = m_batchBuffer.data() + i * ndn::MAX_NDN_PACKET_SIZE;
+    m_recvIovecs[i].iov_len = ndn::MAX_NDN_PACKET_SIZE;
+    std::memset(&m_recvMessages[i], 0, sizeof(mmsghdr));
+    m_recvMessages[i].msg_hdr.msg_iov = &m_recvIovecs[i];
+    m_recvMessages[i].msg_hdr.msg_iovlen = 1;
+  }
+#endif
+}
+
+template<class T, class U>
+inline size_t
+DatagramFace<T, U>::getBatchSize() const
+{
+  return m_batchSize;
+}
+
+#ifdef __linux__
+template<class T, class U>
+inline void
+DatagramFace<T, U>::receiveBatch()
+{
+  int nMessages = ::recvmmsg(m_socket.native_handle(), m_recvMessages.data(),
+                             m_recvMessages.size(), MSG_DONTWAIT, nullptr);
+  if (nMessages < 0) {
+    // EAGAIN means nothing else is queued; other errors will be reported by the next receive
+    return;
+  }
+
+  boost::system::error_code error;
+  for (int i = 0; i < nMessages && m_socket.is_open(); ++i) {
+    receiveDatagram(m_batchBuffer.data() + i * ndn::MAX_NDN_PACKET_SIZE,
+                    m_recvMessages[i].msg_len, error);
+  }
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::flushSendQueue()
+{
+  m_isFlushScheduled = false;
+
+  while (!m_sendQueue.empty()) {
+    if (!m_socket.is_open()) {
+      m_sendQueue.clear();
+      return;
+    }
+
+    size_t nMessages = std::min(m_sendQueue.size(), m_batchSize);
+    std::vector<iovec> iovecs(nMessages);
+    std::vector<mmsghdr> messages(nMessages);
+    for (size_t i = 0; i < nMessages; ++i) {
+      iovecs[i].iov_base = const_cast<uint8_t*>(m_sendQueue[i].wire());
+      iovecs[i].iov_len = m_sendQueue[i].size();
+      std::memset(&messages[i], 0, sizeof(mmsghdr));
+      messages[i].msg_hdr.msg_iov = &iovecs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int nSent = ::sendmmsg(m_socket.native_handle(), messages.data(), nMessages, MSG_DONTWAIT);
+    if (nSent < 0) {
+      if (errno == EINTR)
+        continue;
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // resume when the socket becomes writable again
+        m_isFlushScheduled = true;
+        m_socket.async_send(boost::asio::null_buffers(),
+                            bind(&DatagramFace<T, U>::handleWritable, this,
+                                 boost::asio::placeholders::error));
+        return;
+      }
+
+      m_sendQueue.clear();
+      return processErrorCode(boost::system::error_code(errno, boost::system::system_category()));
+    }
+
+    for (int i = 0; i < nSent; ++i) {
+      NFD_LOG_FACE_TRACE("Successfully sent: " << messages[i].msg_len << " bytes");
+      this->getMutableCounters().getNOutBytes() += messages[i].msg_len;
+    }
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+  }
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleWritable(const boost::system::error_code& error)
+{
+  if (error) {
+    m_isFlushScheduled = false;
+    m_sendQueue.clear();
+    return processErrorCode(error);
+  }
+
+  flushSendQueue();
 }
+#endif // __linux__
 
 template<class T, class U>
 inline void
@@ -38,8 +38,12 @@
 #include <unistd.h>       // for dup()
 
 #if defined(__linux__)
-#include <netpacket/packet.h> // for struct packet_mreq
+#include <linux/filter.h>     // for struct sock_fprog
+#include <linux/if_packet.h>  // for struct packet_mreq and TPACKET_V3
+#include <sys/mman.h>         // for mmap()
 #include <sys/socket.h>       // for setsockopt()
+
+#include <atomic>             // for std::atomic_thread_fence()
 #endif
 
 #ifdef SIOCADDMULTI
@@ -62,14 +66,146 @@ NFD_LOG_INIT("EthernetFace");
 
 const time::nanoseconds EthernetFace::REASSEMBLER_LIFETIME = time::seconds(60);
 
+#if defined(__linux__)
+/// size of one ring block; the kernel hands over received frames one block at a time
+static const size_t RING_BLOCK_SIZE = 1 << 17;
+static const unsigned int RING_RX_BLOCK_COUNT = 32;
+static const unsigned int RING_TX_BLOCK_COUNT = 4;
+/// smallest frame slot, large enough for a standard 1500-byte MTU
+static const size_t RING_MIN_FRAME_SIZE = 1 << 11;
+/// a partially filled receive block is handed over after this many milliseconds
+static const unsigned int RING_BLOCK_TIMEOUT = 1;
+
+/**
+ * @brief Receive and transmit rings mapped from an AF_PACKET socket
+ *
+ * The receive ring is a sequence of TPACKET_V3 blocks holding variable-size frames.
+ * The transmit ring is a sequence of fixed-size frame slots.
+ */
+class EthernetFace::PacketRing : boost::noncopyable
+{
+public:
+  PacketRing(uint8_t* map, const tpacket_req3& rxReq, const tpacket_req3& txReq)
+    : m_map(map)
+    , m_mapSize(mapSize(rxReq, txReq))
+    , m_rxBlockSize(rxReq.tp_block_size)
+    , m_rxBlockCount(rxReq.tp_block_nr)
+    , m_rxBlockIndex(0)
+    , m_txFrames(map + static_cast<size_t>(rxReq.tp_block_size) * rxReq.tp_block_nr)
+    , m_txFrameSize(txReq.tp_frame_size)
+    , m_txFrameCount(txReq.tp_frame_nr)
+    , m_txFrameIndex(0)
+  {
+  }
+
+  ~PacketRing()
+  {
+    ::munmap(m_map, m_mapSize);
+  }
+
+  static size_t
+  mapSize(const tpacket_req3& rxReq, const tpacket_req3& txReq)
+  {
+    return static_cast<size_t>(rxReq.tp_block_size) * rxReq.tp_block_nr +
+           static_cast<size_t>(txReq.tp_block_size) * txReq.tp_block_nr;
+  }
+
+  /**
+   * @return the next receive block if the kernel has handed it over, otherwise nullptr
+   */
+  tpacket_block_desc*
+  getRxBlock()
+  {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_map + m_rxBlockIndex * m_rxBlockSize);
+    if ((loadStatus(block->hdr.bh1.block_status) & TP_STATUS_USER) == 0)
+      return nullptr;
+    return block;
+  }
+
+  /**
+   * @brief Gives the current receive block back to the kernel
+   */
+  void
+  releaseRxBlock()
+  {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_map + m_rxBlockIndex * m_rxBlockSize);
+    storeStatus(block->hdr.bh1.block_status, TP_STATUS_KERNEL);
+    m_rxBlockIndex = (m_rxBlockIndex + 1) % m_rxBlockCount;
+  }
+
+  /**
+   * @return the next transmit frame slot if it is free, otherwise nullptr
+   */
+  tpacket3_hdr*
+  getTxFrame()
+  {
+    auto frame = reinterpret_cast<tpacket3_hdr*>(m_txFrames + m_txFrameIndex * m_txFrameSize);
+    if (loadStatus(frame->tp_status) != TP_STATUS_AVAILABLE)
+      return nullptr;
+    return frame;
+  }
+
+  /**
+   * @brief Queues the current transmit frame slot for sending
+   */
+  void
+  commitTxFrame()
+  {
+    auto frame = reinterpret_cast<tpacket3_hdr*>(m_txFrames + m_txFrameIndex * m_txFrameSize);
+    storeStatus(frame->tp_status, TP_STATUS_SEND_REQUEST);
+    m_txFrameIndex = (m_txFrameIndex + 1) % m_txFrameCount;
+  }
+
+  size_t
+  getTxDataCapacity() const
+  {
+    return m_txFrameSize - TPACKET_ALIGN(sizeof(tpacket3_hdr));
+  }
+
+private:
+  // status words are shared with the kernel: frame contents must be read after
+  // and written before the status word
+  static uint32_t
+  loadStatus(const uint32_t& status)
+  {
+    uint32_t value = *static_cast<const volatile uint32_t*>(&status);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return value;
+  }
+
+  static void
+  storeStatus(uint32_t& status, uint32_t value)
+  {
+    std::atomic_thread_fence(std::memory_order_release);
+    *static_cast<volatile uint32_t*>(&status) = value;
+  }
+
+private:
+  uint8_t* m_map;
+  size_t m_mapSize;
+
+  size_t m_rxBlockSize;
+  size_t m_rxBlockCount;
+  size_t m_rxBlockIndex;
+
+  uint8_t* m_txFrames;
+  size_t m_txFrameSize;
+  size_t m_txFrameCount;
+  size_t m_txFrameIndex;
+};
+#endif // __linux__
+
 EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
                            const NetworkInterfaceInfo& interface,
-                           const ethernet::Address& address)
+                           const ethernet::Address& address,
+                           bool wantsPacketRing)
   : Face(FaceUri(address), FaceUri::fromDev(interface.name), false, true)
   , m_pcap(nullptr, pcap_close)
   , m_socket(std::move(socket))
 #if defined(__linux__)
   , m_interfaceIndex(interface.index)
+  , m_ringInputBufferSize(0)
+  , m_isRingFlushScheduled(false)
 #endif
   , m_interfaceName(interface.name)
   , m_srcAddress(interface.etherAddress)
@@ -79,21 +215,6 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
 #endif
 {
   NFD_LOG_FACE_INFO("Creating face on " << m_interfaceName << "/" << m_srcAddress);
-  pcapInit();
-
-  int fd = pcap_get_selectable_fd(m_pcap.get());
-  if (fd < 0)
-    BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
-
-  // need to duplicate the fd, otherwise both pcap_close()
-  // and stream_descriptor::close() will try to close the
-  // same fd and one of them will fail
-  m_socket.assign(::dup(fd));
-
-  m_interfaceMtu = getInterfaceMtu();
-  NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
-
-  m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
 
   char filter[100];
   // std::snprintf not found in some environments
@@ -103,12 +224,49 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().c_str(),
            m_srcAddress.toString().c_str());
-  setPacketFilter(filter);
+
+#if defined(__linux__)
+  if (wantsPacketRing && !packetRingInit(filter))
+    NFD_LOG_FACE_WARN("Falling back to libpcap");
+#endif
+
+  if (!isUsingPacketRing())
+    {
+      pcapInit();
+
+      int fd = pcap_get_selectable_fd(m_pcap.get());
+      if (fd < 0)
+        BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
+
+      // need to duplicate the fd, otherwise both pcap_close()
+      // and stream_descriptor::close() will try to close the
+      // same fd and one of them will fail
+      m_socket.assign(::dup(fd));
+
+      setPacketFilter(filter);
+    }
+
+  m_interfaceMtu = getInterfaceMtu();
+  NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
+
+  m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
 
   if (!m_destAddress.isBroadcast() && !joinMulticastGroup())
     {
       NFD_LOG_FACE_WARN("Falling back to promiscuous mode");
-      pcap_set_promisc(m_pcap.get(), 1);
+#if defined(__linux__)
+      if (m_ring)
+        {
+          packet_mreq mr{};
+          mr.mr_ifindex = m_interfaceIndex;
+          mr.mr_type = PACKET_MR_PROMISC;
+          if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+                           PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0)
+            NFD_LOG_FACE_WARN("setsockopt(PACKET_MR_PROMISC) failed: " << std::strerror(errno));
+        }
+      else
+#endif
+        pcap_set_promisc(m_pcap.get(), 1);
     }
 
   m_socket.async_read_some(boost::asio::null_buffers(),
@@ -117,6 +275,20 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
                                 boost::asio::placeholders::bytes_transferred));
 }
 
+EthernetFace::~EthernetFace()
+{
+}
+
+bool
+EthernetFace::isUsingPacketRing() const
+{
+#if defined(__linux__)
+  return m_ring != nullptr;
+#else
+  return false;
+#endif
+}
+
 void
 EthernetFace::sendInterest(const Interest& interest)
 {
@@ -155,6 +327,7 @@ EthernetFace::close()
   m_socket.cancel(error); // ignore errors
   m_socket.close(error);  // ignore errors
   m_pcap.reset();
+  // the rings stay mapped until destruction, a receive loop may still be walking them
 
   fail("Face closed");
 }
@@ -186,6 +359,87 @@ EthernetFace::pcapInit()
     NFD_LOG_FACE_WARN("pcap_setdirection failed: " << pcap_geterr(m_pcap.get()));
 }
 
+#if defined(__linux__)
+bool
+EthernetFace::packetRingInit(const char* filterString)
+{
+  // protocol 0: nothing is received until bind(), after the filter is in place
+  int fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (fd < 0)
+    {
+      NFD_LOG_FACE_WARN("socket(AF_PACKET) failed: " << std::strerror(errno));
+      return false;
+    }
+  m_socket.assign(fd);
+
+  auto fallBack = [this] (const std::string& what) {
+    NFD_LOG_FACE_WARN(what);
+    boost::system::error_code error;
+    m_socket.close(error); // ignore errors
+    m_ring.reset();
+    m_pcap.reset();
+    return false;
+  };
+
+  int version = TPACKET_V3;
+  if (::setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    return fallBack("setsockopt(PACKET_VERSION) failed: " + std::string(std::strerror(errno)));
+
+  // a frame slot holds the frame header, the Ethernet header and one MTU of payload
+  size_t frameSize = RING_MIN_FRAME_SIZE;
+  while (frameSize < TPACKET3_HDRLEN + ethernet::HDR_LEN + getInterfaceMtu())
+    frameSize <<= 1;
+  size_t blockSize = std::max(RING_BLOCK_SIZE, frameSize);
+
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = blockSize;
+  rxReq.tp_block_nr = RING_RX_BLOCK_COUNT;
+  rxReq.tp_frame_size = frameSize;
+  rxReq.tp_frame_nr = blockSize / frameSize * RING_RX_BLOCK_COUNT;
+  rxReq.tp_retire_blk_tov = RING_BLOCK_TIMEOUT;
+  if (::setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    return fallBack("setsockopt(PACKET_RX_RING) failed: " + std::string(std::strerror(errno)));
+
+  // TPACKET_V3 transmit rings need Linux 4.11 or later
+  tpacket_req3 txReq{};
+  txReq.tp_block_size = blockSize;
+  txReq.tp_block_nr = RING_TX_BLOCK_COUNT;
+  txReq.tp_frame_size = frameSize;
+  txReq.tp_frame_nr = blockSize / frameSize * RING_TX_BLOCK_COUNT;
+  if (::setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+    return fallBack("setsockopt(PACKET_TX_RING) failed: " + std::string(std::strerror(errno)));
+
+  void* map = ::mmap(nullptr, PacketRing::mapSize(rxReq, txReq), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED)
+    return fallBack("mmap failed: " + std::string(std::strerror(errno)));
+  m_ring.reset(new PacketRing(static_cast<uint8_t*>(map), rxReq, txReq));
+
+  // libpcap only compiles the filter, the kernel runs it on the socket
+  m_pcap.reset(pcap_open_dead(DLT_EN10MB, frameSize));
+  if (!m_pcap)
+    return fallBack("pcap_open_dead failed");
+  try
+    {
+      setPacketFilter(filterString);
+    }
+  catch (const Error& e)
+    {
+      return fallBack(e.what());
+    }
+
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ethernet::ETHERTYPE_NDN);
+  sll.sll_ifindex = m_interfaceIndex;
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+    return fallBack("bind failed: " + std::string(std::strerror(errno)));
+
+  NFD_LOG_FACE_DEBUG("Using packet ring with " << frameSize << "-byte frames");
+  return true;
+}
+#endif // __linux__
+
 void
 EthernetFace::setPacketFilter(const char* filterString)
 {
@@ -193,6 +447,23 @@ EthernetFace::setPacketFilter(const char* filterString)
   if (pcap_compile(m_pcap.get(), &filter, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
     BOOST_THROW_EXCEPTION(Error("pcap_compile: " + std::string(pcap_geterr(m_pcap.get()))));
 
+#if defined(__linux__)
+  if (m_ring)
+    {
+      // struct bpf_insn and struct sock_filter share the same layout
+      sock_fprog program{};
+      program.len = filter.bf_len;
+      program.filter = reinterpret_cast<sock_filter*>(filter.bf_insns);
+      int ret = ::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_ATTACH_FILTER,
+                             &program, sizeof(program));
+      pcap_freecode(&filter);
+      if (ret < 0)
+        BOOST_THROW_EXCEPTION(Error("setsockopt(SO_ATTACH_FILTER): " +
+                                    std::string(std::strerror(errno))));
+      return;
+    }
+#endif
+
   int ret = pcap_setfilter(m_pcap.get(), &filter);
   pcap_freecode(&filter);
   if (ret < 0)
@@ -276,6 +547,55 @@ EthernetFace::sendPacket(const ndn::Block& block)
 
   BOOST_ASSERT(block.size() <= m_interfaceMtu);
 
+#if defined(__linux__)
+  if (m_ring)
+    {
+      tpacket3_hdr* header = m_ring->getTxFrame();
+      if (header == nullptr)
+        {
+          // every slot is still queued: wait until the kernel has transmitted them
+          ::send(m_socket.native_handle(), nullptr, 0, 0);
+          header = m_ring->getTxFrame();
+        }
+      if (header == nullptr)
+        {
+          NFD_LOG_FACE_WARN("Transmit ring is full, dropping " << block.size() << " bytes");
+          return;
+        }
+
+      // build the frame in place, right after the frame header
+      uint8_t* frame = reinterpret_cast<uint8_t*>(header) + TPACKET_ALIGN(sizeof(tpacket3_hdr));
+      size_t payloadLength = std::max(block.size(), ethernet::MIN_DATA_LEN);
+      BOOST_ASSERT(ethernet::HDR_LEN + payloadLength <= m_ring->getTxDataCapacity());
+
+      ether_header* eh = reinterpret_cast<ether_header*>(frame);
+      std::copy(m_destAddress.begin(), m_destAddress.end(), eh->ether_dhost);
+      std::copy(m_srcAddress.begin(), m_srcAddress.end(), eh->ether_shost);
+      eh->ether_type = htons(ethernet::ETHERTYPE_NDN);
+
+      uint8_t* payload = frame + ethernet::HDR_LEN;
+      std::copy(block.begin(), block.end(), payload);
+      // pad with zeroes if the payload is too short
+      std::fill(payload + block.size(), payload + payloadLength, 0);
+
+      header->tp_len = ethernet::HDR_LEN + payloadLength;
+      header->tp_next_offset = 0;
+      m_ring->commitTxFrame();
+
+      if (!m_isRingFlushScheduled)
+        {
+          // frames queued while processing the current event are sent with one system call
+          m_isRingFlushScheduled = true;
+          shared_ptr<Face> self = this->shared_from_this();
+          getGlobalIoService().post([this, self] { flushRingFrames(); });
+        }
+
+      NFD_LOG_FACE_TRACE("Queued: " << block.size() << " bytes");
+      this->getMutableCounters().getNOutBytes() += block.size();
+      return;
+    }
+#endif
+
   /// \todo Right now there is no reserve when packet is received, but
   ///       we should reserve some space at the beginning and at the end
   ndn::EncodingBuffer buffer(block);
@@ -317,6 +637,21 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
   if (error)
     return processErrorCode(error);
 
+#if defined(__linux__)
+  if (m_ring)
+    {
+      receiveRingBlocks();
+      if (!m_pcap)
+        return; // the face was closed while processing received packets
+
+      m_socket.async_read_some(boost::asio::null_buffers(),
+                               bind(&EthernetFace::handleRead, this,
+                                    boost::asio::placeholders::error,
+                                    boost::asio::placeholders::bytes_transferred));
+      return;
+    }
+#endif
+
   pcap_pkthdr* header;
   const uint8_t* packet;
   int ret = pcap_next_ex(m_pcap.get(), &header, &packet);
@@ -354,25 +689,126 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
                                 boost::asio::placeholders::bytes_transferred));
 }
 
+#if defined(__linux__)
 void
-EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet)
+EthernetFace::receiveRingBlocks()
+{
+  tpacket_block_desc* block;
+  while (m_pcap && (block = m_ring->getRxBlock()) != nullptr)
+    {
+      const uint8_t* packetHeader = reinterpret_cast<const uint8_t*>(block) +
+                                    block->hdr.bh1.offset_to_first_pkt;
+      for (uint32_t i = 0; i < block->hdr.bh1.num_pkts && m_pcap; ++i)
+        {
+          auto header = reinterpret_cast<const tpacket3_hdr*>(packetHeader);
+          packetHeader += header->tp_next_offset;
+
+          const uint8_t* frame = reinterpret_cast<const uint8_t*>(header) + header->tp_mac;
+          size_t length = header->tp_snaplen;
+          if (!checkIncomingFrame(frame, length))
+            continue;
+
+          const ether_header* eh = reinterpret_cast<const ether_header*>(frame);
+          const ethernet::Address sourceAddress(eh->ether_shost);
+          const uint8_t* begin = frame + ethernet::HDR_LEN;
+          const uint8_t* end = frame + length;
+
+          // parse in place, the ring frame itself cannot outlive this block
+          const uint8_t* valueBegin = begin;
+          uint32_t type = 0;
+          uint64_t valueLength = 0;
+          if (!ndn::tlv::readType(valueBegin, end, type) ||
+              !ndn::tlv::readVarNumber(valueBegin, end, valueLength) ||
+              valueLength > static_cast<uint64_t>(end - valueBegin))
+            {
+              NFD_LOG_FACE_WARN("Block received from " << sourceAddress.toString()
+                                << " is invalid or too large to process");
+              continue;
+            }
+          size_t headerLength = valueBegin - begin;
+          size_t elementLength = headerLength + valueLength;
+
+          // copy the element once, without padding, into a buffer shared with earlier
+          // elements; it is reused when no received packet refers to it anymore
+          if (m_ringInputBuffer && m_ringInputBuffer.use_count() == 1)
+            m_ringInputBufferSize = 0;
+          if (!m_ringInputBuffer ||
+              m_ringInputBufferSize + elementLength > m_ringInputBuffer->size())
+            {
+              size_t bufferSize = std::max<size_t>(ndn::MAX_NDN_PACKET_SIZE, elementLength);
+              m_ringInputBuffer = make_shared<ndn::Buffer>(bufferSize);
+              m_ringInputBufferSize = 0;
+            }
+          std::copy(begin, begin + elementLength,
+                    m_ringInputBuffer->begin() + m_ringInputBufferSize);
+          ndn::Buffer::const_iterator elementBegin = m_ringInputBuffer->begin() +
+                                                     m_ringInputBufferSize;
+          m_ringInputBufferSize += elementLength;
+
+          Block fragmentBlock(m_ringInputBuffer, type,
+                              elementBegin, elementBegin + elementLength,
+                              elementBegin + headerLength, elementBegin + elementLength);
+          processIncomingFragment(sourceAddress, fragmentBlock);
+        }
+
+      m_ring->releaseRxBlock();
+    }
+
+#ifdef _DEBUG
+  tpacket_stats_v3 stats{};
+  socklen_t statsLength = sizeof(stats);
+  // the kernel resets the counters on every read
+  if (::getsockopt(m_socket.native_handle(), SOL_PACKET, PACKET_STATISTICS,
+                   &stats, &statsLength) == 0 && stats.tp_drops > 0)
+    NFD_LOG_FACE_DEBUG("Detected " << stats.tp_drops << " dropped packet(s)");
+#endif
+}
+
+void
+EthernetFace::flushRingFrames()
+{
+  m_isRingFlushScheduled = false;
+  if (!m_pcap)
+    return;
+
+  if (::send(m_socket.native_handle(), nullptr, 0, MSG_DONTWAIT) < 0 &&
+      errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS)
+    return fail("send: " + std::string(std::strerror(errno)));
+  // on EAGAIN or ENOBUFS the frames stay queued and go out with the next flush
+}
+#endif // __linux__
+
+bool
+EthernetFace::checkIncomingFrame(const uint8_t* frame, size_t length)
 {
-  size_t length = header->caplen;
   if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN) {
     NFD_LOG_FACE_WARN("Received frame is too short (" << length << " bytes)");
-    return;
+    return false;
   }
 
-  const ether_header* eh = reinterpret_cast<const ether_header*>(packet);
-  const ethernet::Address sourceAddress(eh->ether_shost);
+  const ether_header* eh = reinterpret_cast<const ether_header*>(frame);
 
   // assert in case BPF fails to filter unwanted frames
   BOOST_ASSERT_MSG(ethernet::Address(eh->ether_dhost) == m_destAddress,
                    "Received frame addressed to a different multicast group");
-  BOOST_ASSERT_MSG(sourceAddress != m_srcAddress,
+  BOOST_ASSERT_MSG(ethernet::Address(eh->ether_shost) != m_srcAddress,
                    "Received frame sent by this host");
   BOOST_ASSERT_MSG(ntohs(eh->ether_type) == ethernet::ETHERTYPE_NDN,
                    "Received frame with unrecognized ethertype");
+  static_cast<void>(eh);
+
+  return true;
+}
+
+void
+EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet)
+{
+  size_t length = header->caplen;
+  if (!checkIncomingFrame(packet, length))
+    return;
+
+  const ether_header* eh = reinterpret_cast<const ether_header*>(packet);
+  const ethernet::Address sourceAddress(eh->ether_shost);
 
   packet += ethernet::HDR_LEN;
   length -= ethernet::HDR_LEN;
@@ -387,6 +823,13 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
     return;
   }
 
+  processIncomingFragment(sourceAddress, fragmentBlock);
+}
+
+void
+EthernetFace::processIncomingFragment(const ethernet::Address& sourceAddress,
+                                      const Block& fragmentBlock)
+{
   NFD_LOG_FACE_TRACE("Received: " << fragmentBlock.size() << " bytes from "
                      << sourceAddress.toString());
   this->getMutableCounters().getNInBytes() += fragmentBlock.size();
@@ -410,6 +853,7 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
       BOOST_VERIFY(m_reassemblers.erase(sourceAddress) == 1);
     });
 
+  bool isOk = false;
   ndnlp::NdnlpData fragment;
   std::tie(isOk, fragment) = ndnlp::NdnlpData::fromBlock(fragmentBlock);
   if (!isOk) {
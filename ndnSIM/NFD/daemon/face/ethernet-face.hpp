@@ -60,9 +60,20 @@ public:
     Error(const std::string& what) : Face::Error(what) {}
   };
 
+  /**
+   * @param socket descriptor wrapper, the face assigns the capture file descriptor to it
+   * @param interface local network interface
+   * @param address Ethernet broadcast/multicast destination address
+   * @param wantsPacketRing on Linux, receive and transmit through a memory-mapped
+   *        AF_PACKET TPACKET_V3 ring instead of libpcap; libpcap is used when the
+   *        ring cannot be set up, and on other platforms
+   */
   EthernetFace(boost::asio::posix::stream_descriptor socket,
                const NetworkInterfaceInfo& interface,
-               const ethernet::Address& address);
+               const ethernet::Address& address,
+               bool wantsPacketRing = false);
+
+  ~EthernetFace();
 
   /// send an Interest
   void
@@ -80,6 +91,12 @@ public:
   void
   close() DECL_OVERRIDE;
 
+  /**
+   * @brief Returns whether frames go through the memory-mapped packet ring
+   */
+  bool
+  isUsingPacketRing() const;
+
 private:
   /**
    * @brief Allocates and initializes a libpcap context for live capture
@@ -87,6 +104,29 @@ private:
   void
   pcapInit();
 
+#if defined(__linux__)
+  /**
+   * @brief Opens an AF_PACKET socket and maps TPACKET_V3 receive and transmit rings on it
+   *
+   * @param filterString string containing the source BPF program
+   * @return true if successful, false if the face should fall back to libpcap
+   */
+  bool
+  packetRingInit(const char* filterString);
+
+  /**
+   * @brief Processes every ring block that the kernel has handed over to user space
+   */
+  void
+  receiveRingBlocks();
+
+  /**
+   * @brief Asks the kernel to transmit the frames queued in the transmit ring
+   */
+  void
+  flushRingFrames();
+#endif
+
   /**
    * @brief Installs a BPF filter on the receiving socket
    *
@@ -126,6 +166,18 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet);
 
 private:
+  /**
+   * @brief Checks the length and the link-layer header of a received frame
+   */
+  bool
+  checkIncomingFrame(const uint8_t* frame, size_t length);
+
+  /**
+   * @brief Passes a received NDNLP fragment to the reassembler of its sender
+   */
+  void
+  processIncomingFragment(const ethernet::Address& sourceAddress, const Block& fragmentBlock);
+
   /**
    * @brief Handles errors encountered by Boost.Asio on the receive path
    */
@@ -150,6 +202,14 @@ private:
 
 #if defined(__linux__)
   int m_interfaceIndex;
+
+  class PacketRing;
+  /// memory-mapped rings, or nullptr when frames go through libpcap
+  unique_ptr<PacketRing> m_ring;
+  /// buffer that received ring frames are copied into, shared by the Blocks parsed from it
+  shared_ptr<ndn::Buffer> m_ringInputBuffer;
+  size_t m_ringInputBufferSize;
+  bool m_isRingFlushScheduled;
 #endif
   std::string m_interfaceName;
   ethernet::Address m_srcAddress;
@@ -31,6 +31,11 @@
 
 namespace nfd {
 
+EthernetFactory::EthernetFactory()
+  : m_wantsPacketRing(false)
+{
+}
+
 shared_ptr<EthernetFace>
 EthernetFactory::createMulticastFace(const NetworkInterfaceInfo& interface,
                                      const ethernet::Address &address)
@@ -43,7 +48,7 @@ EthernetFactory::createMulticastFace(const NetworkInterfaceInfo& interface,
     return face;
 
   face = make_shared<EthernetFace>(boost::asio::posix::stream_descriptor(getGlobalIoService()),
-                                   interface, address);
+                                   interface, address, m_wantsPacketRing);
 
   auto key = std::make_pair(interface.name, address);
   face->onFail.connectSingleShot([this, key] (const std::string& reason) {
@@ -52,6 +52,8 @@ public:
   typedef std::map<std::pair<std::string, ethernet::Address>,
                    shared_ptr<EthernetFace>> MulticastFaceMap;
 
+  EthernetFactory();
+
   // from ProtocolFactory
   virtual void
   createFace(const FaceUri& uri,
@@ -87,6 +89,15 @@ public:
   virtual std::list<shared_ptr<const Channel>>
   getChannels() const;
 
+  /**
+   * \brief Use memory-mapped packet rings instead of libpcap where available
+   *
+   * Applies to multicast faces created afterwards.
+   * \sa EthernetFace::EthernetFace
+   */
+  void
+  setPacketRingEnabled(bool isEnabled);
+
 private:
   /**
    * \brief Look up EthernetFace using specified interface and address
@@ -102,6 +113,7 @@ private:
 
 private:
   MulticastFaceMap m_multicastFaces;
+  bool m_wantsPacketRing;
 };
 
 inline const EthernetFactory::MulticastFaceMap&
@@ -110,6 +122,12 @@ EthernetFactory::getMulticastFaces() const
   return m_multicastFaces;
 }
 
+inline void
+EthernetFactory::setPacketRingEnabled(bool isEnabled)
+{
+  m_wantsPacketRing = isEnabled;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_ETHERNET_FACTORY_HPP
@@ -160,6 +160,32 @@ public:
     return m_nOutDatas;
   }
 
+  /// incoming Nack
+  const PacketCounter&
+  getNInNacks() const
+  {
+    return m_nInNacks;
+  }
+
+  PacketCounter&
+  getNInNacks()
+  {
+    return m_nInNacks;
+  }
+
+  /// outgoing Nack
+  const PacketCounter&
+  getNOutNacks() const
+  {
+    return m_nOutNacks;
+  }
+
+  PacketCounter&
+  getNOutNacks()
+  {
+    return m_nOutNacks;
+  }
+
 protected:
   /** \brief copy current obseverations to a struct
    *  \param recipient an object with set methods for counters
@@ -179,6 +205,8 @@ private:
   PacketCounter m_nInDatas;
   PacketCounter m_nOutInterests;
   PacketCounter m_nOutDatas;
+  PacketCounter m_nInNacks;  ///< not in FaceStatus/ForwarderStatus, they have no Nack fields
+  PacketCounter m_nOutNacks;
 };
 
 /** \brief contains link layer byte counters
@@ -37,41 +37,76 @@ Face::Face(const FaceUri& remoteUri, const FaceUri& localUri, bool isLocal, bool
   , m_persistency(ndn::nfd::FACE_PERSISTENCY_PERSISTENT)
   , m_isMultiAccess(isMultiAccess)
   , m_isFailed(false)
+  , m_isCongested(false)
   , m_metric(0)
 {
   onReceiveInterest.connect([this] (const ndn::Interest&) { ++m_counters.getNInInterests(); });
   onReceiveData    .connect([this] (const ndn::Data&)     { ++m_counters.getNInDatas(); });
   onSendInterest   .connect([this] (const ndn::Interest&) { ++m_counters.getNOutInterests(); });
   onSendData       .connect([this] (const ndn::Data&)     { ++m_counters.getNOutDatas(); });
+  onReceiveNack    .connect([this] (const lp::Nack&)      { ++m_counters.getNInNacks(); });
+  onSendNack       .connect([this] (const lp::Nack&)      { ++m_counters.getNOutNacks(); });
 }
 
 Face::~Face()
 {
 }
 
+void
+Face::sendNack(const lp::Nack& nack)
+{
+  // (drop)
+}
+
 bool
 Face::isUp() const
 {
   return true;
 }
 
+size_t
+Face::getTransmitQueueLength() const
+{
+  return 0;
+}
+
+void
+Face::setCongested(bool isCongested)
+{
+  if (m_isCongested == isCongested) {
+    return;
+  }
+
+  m_isCongested = isCongested;
+  this->onCongestionChanged(isCongested);
+}
+
 bool
 Face::decodeAndDispatchInput(const Block& element)
+{
+  DecodedInput input;
+  if (!decodeInput(element, input))
+    return false;
+
+  dispatchInput(input);
+  return true;
+}
+
+bool
+Face::decodeInput(const Block& element, DecodedInput& input)
 {
   try {
     /// \todo Ensure lazy field decoding process
 
     if (element.type() == tlv::Interest)
       {
-        shared_ptr<Interest> i = make_shared<Interest>();
-        i->wireDecode(element);
-        this->onReceiveInterest(*i);
+        input.interest = make_shared<Interest>();
+        input.interest->wireDecode(element);
       }
     else if (element.type() == tlv::Data)
       {
-        shared_ptr<Data> d = make_shared<Data>();
-        d->wireDecode(element);
-        this->onReceiveData(*d);
+        input.data = make_shared<Data>();
+        input.data->wireDecode(element);
       }
     else
       return false;
@@ -79,10 +114,20 @@ Face::decodeAndDispatchInput(const Block& element)
     return true;
   }
   catch (const tlv::Error&) {
+    input = DecodedInput();
     return false;
   }
 }
 
+void
+Face::dispatchInput(const DecodedInput& input)
+{
+  if (input.interest != nullptr)
+    this->onReceiveInterest(*input.interest);
+  else if (input.data != nullptr)
+    this->onReceiveData(*input.data);
+}
+
 void
 Face::fail(const std::string& reason)
 {
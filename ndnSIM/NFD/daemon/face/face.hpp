@@ -88,9 +88,18 @@ public:
   /// fires when a Data is sent out
   signal::Signal<Face, Data> onSendData;
 
+  /// fires when a Nack is received
+  signal::Signal<Face, lp::Nack> onReceiveNack;
+
+  /// fires when a Nack is sent out
+  signal::Signal<Face, lp::Nack> onSendNack;
+
   /// fires when face disconnects or fails to perform properly
   signal::Signal<Face, std::string/*reason*/> onFail;
 
+  /// fires when the face becomes congested (true) or stops being congested (false)
+  signal::Signal<Face, bool> onCongestionChanged;
+
   /// send an Interest
   virtual void
   sendInterest(const Interest& interest) = 0;
@@ -99,6 +108,13 @@ public:
   virtual void
   sendData(const Data& data) = 0;
 
+  /** \brief send a Nack
+   *
+   *  In this base class the Nack is dropped, for faces that cannot carry Nacks.
+   */
+  virtual void
+  sendNack(const lp::Nack& nack);
+
   /** \brief Close the face
    *
    *  This terminates all communication on the face and cause
@@ -154,6 +170,21 @@ public: // attributes
   const FaceCounters&
   getCounters() const;
 
+  /** \brief Get the number of packets accepted by the face but not yet handed to the link
+   *
+   *  In this base class the face has no transmit queue, and this is always zero.
+   */
+  virtual size_t
+  getTransmitQueueLength() const;
+
+  /** \brief Get whether the transmit queue of the face is filling up
+   *
+   *  Strategies should prefer other upstreams while a face is congested.
+   *  It is never congested in this base class.
+   */
+  bool
+  isCongested() const;
+
   /** \return a FaceUri that represents the remote endpoint
    */
   const FaceUri&
@@ -175,11 +206,41 @@ public: // attributes
   virtual ndn::nfd::FaceStatus
   getFaceStatus() const;
 
+  /** \brief network layer packet decoded from a received TLV element
+   *
+   *  Exactly one of the pointers is set.
+   */
+  struct DecodedInput
+  {
+    shared_ptr<Interest> interest;
+    shared_ptr<Data> data;
+  };
+
 PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   void
   setPersistency(ndn::nfd::FacePersistency persistency);
 
+  /** \brief decodes a received TLV element into an Interest or a Data
+   *  \return false if the element is neither, or cannot be decoded
+   *
+   *  Touches no face state, so it may run on a different thread than dispatchInput.
+   */
+  static bool
+  decodeInput(const Block& element, DecodedInput& input);
+
+  /** \brief raises onReceiveInterest or onReceiveData for a decoded packet
+   */
+  void
+  dispatchInput(const DecodedInput& input);
+
+  /** \brief set whether the face is congested, raise onCongestionChanged if that changes
+   */
+  void
+  setCongested(bool isCongested);
+
 protected:
+  /** \brief decodeInput followed by dispatchInput
+   */
   bool
   decodeAndDispatchInput(const Block& element);
 
@@ -195,6 +256,8 @@ protected:
   DECLARE_SIGNAL_EMIT(onReceiveData)
   DECLARE_SIGNAL_EMIT(onSendInterest)
   DECLARE_SIGNAL_EMIT(onSendData)
+  DECLARE_SIGNAL_EMIT(onReceiveNack)
+  DECLARE_SIGNAL_EMIT(onSendNack)
 
 private:
   // this method should be used only by the FaceTable
@@ -211,6 +274,7 @@ private:
   ndn::nfd::FacePersistency m_persistency;
   const bool m_isMultiAccess;
   bool m_isFailed;
+  bool m_isCongested;
   uint64_t m_metric;
 
   // allow setting FaceId
@@ -271,6 +335,12 @@ Face::getCounters() const
   return m_counters;
 }
 
+inline bool
+Face::isCongested() const
+{
+  return m_isCongested;
+}
+
 inline FaceCounters&
 Face::getMutableCounters()
 {
@@ -34,32 +34,82 @@ NFD_LOG_INIT("NdnlpPartialMessageStore");
 PartialMessage::PartialMessage()
   : m_fragCount(0)
   , m_received(0)
+  , m_fragSize(0)
   , m_totalLength(0)
 {
 }
 
+void
+PartialMessage::reset()
+{
+  m_fragCount = 0;
+  m_received = 0;
+  m_fragSize = 0;
+  m_lastPayload.reset();
+  m_buffer.reset();
+  m_totalLength = 0;
+}
+
 bool
 PartialMessage::add(uint16_t fragIndex, uint16_t fragCount, const Block& payload)
 {
   if (m_received == 0) { // first packet
     m_fragCount = fragCount;
-    m_payloads.resize(fragCount);
+    m_isReceived.assign(fragCount, false);
   }
 
   if (m_fragCount != fragCount || fragIndex >= m_fragCount) {
     return false;
   }
 
-  if (!m_payloads[fragIndex].empty()) { // duplicate
+  if (m_isReceived[fragIndex]) { // duplicate
     return false;
   }
 
-  m_payloads[fragIndex] = payload;
+  size_t payloadSize = payload.value_size();
+  if (fragIndex + 1U < m_fragCount) {
+    if (m_fragSize == 0) {
+      if (payloadSize == 0 ||
+          (!m_lastPayload.empty() && m_lastPayload.value_size() > payloadSize)) {
+        return false;
+      }
+      m_fragSize = payloadSize;
+      m_buffer = ndn::makeBuffer(m_fragSize * m_fragCount);
+      if (!m_lastPayload.empty()) {
+        this->copyPayload(m_fragCount - 1, m_lastPayload);
+        m_lastPayload.reset();
+      }
+    }
+    else if (payloadSize != m_fragSize) {
+      return false;
+    }
+    this->copyPayload(fragIndex, payload);
+  }
+  else { // last fragment, may be shorter
+    if (m_fragSize == 0) {
+      m_lastPayload = payload;
+    }
+    else if (payloadSize > m_fragSize) {
+      return false;
+    }
+    else {
+      this->copyPayload(fragIndex, payload);
+    }
+  }
+
+  m_isReceived[fragIndex] = true;
   ++m_received;
-  m_totalLength += payload.value_size();
+  m_totalLength += payloadSize;
   return true;
 }
 
+void
+PartialMessage::copyPayload(size_t fragIndex, const Block& payload)
+{
+  std::copy(payload.value_begin(), payload.value_end(),
+            m_buffer->begin() + fragIndex * m_fragSize);
+}
+
 bool
 PartialMessage::isComplete() const
 {
@@ -70,14 +120,13 @@ std::tuple<bool, Block>
 PartialMessage::reassemble()
 {
   BOOST_ASSERT(this->isComplete());
+  BOOST_ASSERT(m_buffer != nullptr);
 
-  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(m_totalLength);
-  ndn::Buffer::iterator buf = buffer->begin();
-  for (const Block& payload : m_payloads) {
-    buf = std::copy(payload.value_begin(), payload.value_end(), buf);
-  }
-  BOOST_ASSERT(buf == buffer->end());
+  // the last fragment may have been shorter than the room left for it
+  BOOST_ASSERT(m_totalLength <= m_buffer->size());
+  m_buffer->resize(m_totalLength);
 
+  ndn::BufferPtr buffer = std::move(m_buffer);
   return Block::fromBuffer(buffer, 0);
 }
 
@@ -95,7 +144,9 @@ PartialMessage::reassembleSingle(const NdnlpData& fragment)
 }
 
 PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration)
-  : m_idleDuration(idleDuration)
+  : m_nSlotsInUse(0)
+  , m_idleDuration(idleDuration)
+  , m_isSweepScheduled(false)
 {
 }
 
@@ -110,14 +161,15 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   }
   else {
     uint64_t messageIdentifier = pkt.seq - pkt.fragIndex;
-    PartialMessage& pm = m_partialMessages[messageIdentifier];
-    this->scheduleCleanup(messageIdentifier, pm);
+    Slot& slot = this->getSlot(messageIdentifier);
+    slot.lastReceived = time::steady_clock::now();
 
+    PartialMessage& pm = slot.message;
     pm.add(pkt.fragIndex, pkt.fragCount, pkt.payload);
 
     if (pm.isComplete()) {
       std::tie(isReassembled, reassembled) = pm.reassemble();
-      m_partialMessages.erase(messageIdentifier);
+      this->releaseSlot(slot);
     }
     else {
       return;
@@ -133,19 +185,68 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   this->onReceive(reassembled);
 }
 
+PartialMessageStore::Slot&
+PartialMessageStore::getSlot(uint64_t messageIdentifier)
+{
+  Slot* freeSlot = nullptr;
+  for (Slot& slot : m_slots) {
+    if (!slot.isInUse) {
+      if (freeSlot == nullptr)
+        freeSlot = &slot;
+    }
+    else if (slot.messageIdentifier == messageIdentifier) {
+      if (time::steady_clock::now() - slot.lastReceived >= m_idleDuration) {
+        // expired, but not swept yet
+        NFD_LOG_TRACE(messageIdentifier << " cleanup");
+        slot.message.reset();
+      }
+      return slot;
+    }
+  }
+
+  if (freeSlot == nullptr) {
+    m_slots.emplace_back();
+    freeSlot = &m_slots.back();
+  }
+
+  freeSlot->messageIdentifier = messageIdentifier;
+  freeSlot->isInUse = true;
+  ++m_nSlotsInUse;
+
+  if (!m_isSweepScheduled) {
+    m_isSweepScheduled = true;
+    m_sweepEvent = scheduler::schedule(m_idleDuration / 2, bind(&PartialMessageStore::sweep, this));
+  }
+  return *freeSlot;
+}
+
 void
-PartialMessageStore::scheduleCleanup(uint64_t messageIdentifier,
-                                     PartialMessage& partialMessage)
+PartialMessageStore::releaseSlot(Slot& slot)
 {
-  partialMessage.expiry = scheduler::schedule(m_idleDuration,
-    bind(&PartialMessageStore::cleanup, this, messageIdentifier));
+  BOOST_ASSERT(slot.isInUse);
+  slot.isInUse = false;
+  slot.message.reset();
+  --m_nSlotsInUse;
 }
 
 void
-PartialMessageStore::cleanup(uint64_t messageIdentifier)
+PartialMessageStore::sweep()
 {
-  NFD_LOG_TRACE(messageIdentifier << " cleanup");
-  m_partialMessages.erase(messageIdentifier);
+  m_isSweepScheduled = false;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  for (Slot& slot : m_slots) {
+    if (slot.isInUse && now - slot.lastReceived >= m_idleDuration) {
+      NFD_LOG_TRACE(slot.messageIdentifier << " cleanup");
+      this->releaseSlot(slot);
+    }
+  }
+
+  // messages expire between idleDuration and 1.5 * idleDuration after their last fragment
+  if (m_nSlotsInUse > 0) {
+    m_isSweepScheduled = true;
+    m_sweepEvent = scheduler::schedule(m_idleDuration / 2, bind(&PartialMessageStore::sweep, this));
+  }
 }
 
 } // namespace ndnlp
@@ -33,6 +33,10 @@ namespace nfd {
 namespace ndnlp {
 
 /** \brief represents a partially received message
+ *
+ *  Fragment payloads are copied into one contiguous buffer as they arrive, so reassembly
+ *  does not copy them again. Every fragment but the last must have the same payload size,
+ *  as produced by Slicer; the buffer is allocated once that size is known.
  */
 class PartialMessage
 {
@@ -49,6 +53,11 @@ public:
   PartialMessage&
   operator=(PartialMessage&&) = default;
 
+  /** \brief forgets the current message, keeping allocated bookkeeping storage
+   */
+  void
+  reset();
+
   bool
   add(uint16_t fragIndex, uint16_t fragCount, const Block& payload);
 
@@ -69,17 +78,27 @@ public:
   static std::tuple<bool, Block>
   reassembleSingle(const NdnlpData& fragment);
 
-public:
-  scheduler::ScopedEventId expiry;
+private:
+  void
+  copyPayload(size_t fragIndex, const Block& payload);
 
 private:
   size_t m_fragCount;
   size_t m_received;
-  std::vector<Block> m_payloads;
+  std::vector<bool> m_isReceived;
+  /// payload size of every fragment but the last, 0 until one of them is received
+  size_t m_fragSize;
+  /// last fragment, kept until m_fragSize is known
+  Block m_lastPayload;
+  ndn::BufferPtr m_buffer;
   size_t m_totalLength;
 };
 
 /** \brief provides reassembly feature at receiver
+ *
+ *  Partial messages live in a pool of slots that is reused across messages. A message is
+ *  dropped when no fragment of it has been received for idleDuration; a single periodic
+ *  sweep, running only while partial messages exist, reclaims the slots of such messages.
  */
 class PartialMessageStore : noncopyable
 {
@@ -98,19 +117,55 @@ public:
    */
   signal::Signal<PartialMessageStore, Block> onReceive;
 
+  /** \return number of messages being reassembled
+   */
+  size_t
+  size() const;
+
 private:
+  struct Slot
+  {
+    Slot()
+      : messageIdentifier(0)
+      , isInUse(false)
+    {
+    }
+
+    uint64_t messageIdentifier;
+    time::steady_clock::TimePoint lastReceived;
+    bool isInUse;
+    PartialMessage message;
+  };
+
+  /** \brief finds the slot of a message, or takes a free slot for it
+   *
+   *  A message idle for longer than m_idleDuration is restarted.
+   */
+  Slot&
+  getSlot(uint64_t messageIdentifier);
+
   void
-  scheduleCleanup(uint64_t messageIdentifier, PartialMessage& partialMessage);
+  releaseSlot(Slot& slot);
 
   void
-  cleanup(uint64_t messageIdentifier);
+  sweep();
 
 private:
-  std::unordered_map<uint64_t, PartialMessage> m_partialMessages;
+  /// there are few messages in flight from one sender, so slots are searched linearly
+  std::vector<Slot> m_slots;
+  size_t m_nSlotsInUse;
 
   time::nanoseconds m_idleDuration;
+  scheduler::ScopedEventId m_sweepEvent;
+  bool m_isSweepScheduled;
 };
 
+inline size_t
+PartialMessageStore::size() const
+{
+  return m_nSlotsInUse;
+}
+
 } // namespace ndnlp
 } // namespace nfd
 
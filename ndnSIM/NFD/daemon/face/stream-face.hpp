@@ -69,6 +69,9 @@ protected:
   handleReceive(const boost::system::error_code& error,
                 size_t nBytesReceived);
 
+  void
+  startReceive();
+
   void
   shutdownSocket();
 
@@ -81,8 +84,14 @@ protected:
   NFD_LOG_INCLASS_DECLARE();
 
 private:
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
+  /** \brief buffer the socket receives into
+   *
+   *  Parsed elements share this buffer instead of copying out of it. A new buffer is
+   *  started when the current one is full and still referenced by received packets.
+   */
+  shared_ptr<ndn::Buffer> m_inputBuffer;
+  size_t m_inputBufferBegin; ///< offset of the first byte not yet parsed
+  size_t m_inputBufferSize;  ///< offset past the last received byte
   std::queue<Block> m_sendQueue;
 
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Interest>;
@@ -116,6 +125,8 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
                                     typename StreamFace::protocol::socket socket, bool isOnDemand)
   : FaceBase(remoteUri, localUri)
   , m_socket(std::move(socket))
+  , m_inputBuffer(make_shared<ndn::Buffer>(ndn::MAX_NDN_PACKET_SIZE))
+  , m_inputBufferBegin(0)
   , m_inputBufferSize(0)
 {
   NFD_LOG_FACE_INFO("Creating face");
@@ -123,10 +134,7 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
   this->setPersistency(isOnDemand ? ndn::nfd::FACE_PERSISTENCY_ON_DEMAND : ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
   StreamFaceValidator<T, FaceBase>::validateSocket(m_socket);
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&StreamFace<T, FaceBase>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  startReceive();
 }
 
 
@@ -262,18 +270,28 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
 
   m_inputBufferSize += nBytesReceived;
 
-  size_t offset = 0;
-
   bool isOk = true;
-  Block element;
-  while (m_inputBufferSize - offset > 0) {
-    std::tie(isOk, element) = Block::fromBuffer(m_inputBuffer + offset, m_inputBufferSize - offset);
+  while (m_inputBufferBegin < m_inputBufferSize) {
+    // parse in place, bounded by the received bytes rather than by the buffer capacity
+    const uint8_t* begin = m_inputBuffer->buf() + m_inputBufferBegin;
+    const uint8_t* end = m_inputBuffer->buf() + m_inputBufferSize;
+    const uint8_t* valueBegin = begin;
+    uint32_t type = 0;
+    uint64_t length = 0;
+    isOk = ndn::tlv::readType(valueBegin, end, type) &&
+           ndn::tlv::readVarNumber(valueBegin, end, length) &&
+           length <= static_cast<uint64_t>(end - valueBegin);
     if (!isOk)
       break;
 
-    offset += element.size();
+    ndn::Buffer::const_iterator bufferBegin = m_inputBuffer->begin();
+    ndn::Buffer::const_iterator elementValue = bufferBegin + (valueBegin - m_inputBuffer->buf());
+    Block element(m_inputBuffer, type,
+                  bufferBegin + m_inputBufferBegin, elementValue + length,
+                  elementValue, elementValue + length);
+    m_inputBufferBegin += element.size();
 
-    BOOST_ASSERT(offset <= m_inputBufferSize);
+    BOOST_ASSERT(m_inputBufferBegin <= m_inputBufferSize);
 
     if (!this->decodeAndDispatchInput(element)) {
       NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
@@ -281,7 +299,8 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
     }
   }
 
-  if (!isOk && m_inputBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0)
+  size_t nPendingBytes = m_inputBufferSize - m_inputBufferBegin;
+  if (!isOk && nPendingBytes == m_inputBuffer->size())
     {
       NFD_LOG_FACE_WARN("Failed to parse incoming packet or packet too large to process");
       shutdownSocket();
@@ -289,22 +308,33 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
       return;
     }
 
-  if (offset > 0)
+  bool isBufferShared = m_inputBuffer.use_count() > 1;
+  if (nPendingBytes == 0 && !isBufferShared)
+    {
+      // no packet received from this buffer is alive, so it can be reused from the start
+      m_inputBufferBegin = m_inputBufferSize = 0;
+    }
+  else if (m_inputBufferSize == m_inputBuffer->size())
     {
-      if (offset != m_inputBufferSize)
-        {
-          std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                    m_inputBuffer);
-          m_inputBufferSize -= offset;
-        }
-      else
-        {
-          m_inputBufferSize = 0;
-        }
+      // the buffer is full; continue in a new one, starting with the incomplete element
+      shared_ptr<ndn::Buffer> oldBuffer = m_inputBuffer;
+      if (isBufferShared)
+        m_inputBuffer = make_shared<ndn::Buffer>(ndn::MAX_NDN_PACKET_SIZE);
+      std::copy(oldBuffer->begin() + m_inputBufferBegin, oldBuffer->begin() + m_inputBufferSize,
+                m_inputBuffer->begin());
+      m_inputBufferBegin = 0;
+      m_inputBufferSize = nPendingBytes;
     }
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_inputBufferSize),
+  startReceive();
+}
+
+template<class T, class U>
+inline void
+StreamFace<T, U>::startReceive()
+{
+  m_socket.async_receive(boost::asio::buffer(m_inputBuffer->buf() + m_inputBufferSize,
+                                             m_inputBuffer->size() - m_inputBufferSize),
                          bind(&StreamFace<T, U>::handleReceive, this,
                               boost::asio::placeholders::error,
                               boost::asio::placeholders::bytes_transferred));
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_TRANSMIT_SCHEDULER_HPP
+#define NFD_DAEMON_FACE_TRANSMIT_SCHEDULER_HPP
+
+#include "common.hpp"
+
+#include <deque>
+
+namespace nfd {
+
+/** \brief priority classes of outgoing packets, in decreasing priority
+ */
+enum TransmitClass {
+  /// Nacks, and traffic that must keep low latency, like safety messages
+  TRANSMIT_CLASS_CONTROL,
+  /// retransmitted Interests, which are late already
+  TRANSMIT_CLASS_RETRANSMISSION,
+  /// Data, which satisfy pending Interests
+  TRANSMIT_CLASS_DATA,
+  /// new Interests
+  TRANSMIT_CLASS_INTEREST,
+  /// traffic that only fills the remaining capacity
+  TRANSMIT_CLASS_BULK,
+  TRANSMIT_CLASS_MAX
+};
+
+/** \brief queue of outgoing packets of a face, with priority classes and fair queuing
+ *  \tparam T queued item, must be move constructible
+ *
+ *  A packet of a class is dequeued only when all higher priority classes are empty.
+ *  Within a class, packets are grouped into flows, e.g. by name prefix, which share the
+ *  class by deficit round robin: in every round, a flow may send \p quantum times its weight
+ *  in octets.  Packets of one flow leave in the order they arrived.
+ */
+template<typename T>
+class TransmitScheduler : noncopyable
+{
+public:
+  typedef size_t FlowId;
+
+  /** \param limit maximum number of queued packets, zero for no limit
+   *  \param quantum octets a flow of weight one may send per round
+   */
+  explicit
+  TransmitScheduler(size_t limit = 0, size_t quantum = 1500)
+    : m_limit(limit)
+    , m_quantum(std::max<size_t>(quantum, 1))
+    , m_size(0)
+  {
+  }
+
+  /** \brief sets the weight of a flow, its share relative to other flows of the same class
+   *
+   *  Flows without a weight have weight one.
+   */
+  void
+  setWeight(FlowId flow, size_t weight)
+  {
+    if (weight <= 1)
+      m_weights.erase(flow);
+    else
+      m_weights[flow] = weight;
+  }
+
+  size_t
+  getWeight(FlowId flow) const
+  {
+    auto i = m_weights.find(flow);
+    return i == m_weights.end() ? 1 : i->second;
+  }
+
+  size_t
+  getLimit() const
+  {
+    return m_limit;
+  }
+
+  /** \brief number of queued packets
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /** \brief number of queued packets in a class
+   */
+  size_t
+  size(TransmitClass transmitClass) const
+  {
+    return m_classes[transmitClass].size;
+  }
+
+  /** \brief appends a packet of \p size octets to its flow
+   *  \return false if the queue is full; \p item is left unchanged in that case
+   */
+  bool
+  enqueue(T&& item, size_t size, TransmitClass transmitClass, FlowId flow)
+  {
+    if (m_limit > 0 && m_size >= m_limit)
+      return false;
+
+    Class& cls = m_classes[transmitClass];
+    std::deque<Item>& items = cls.flows[flow].items;
+    if (items.empty())
+      cls.active.push_back(flow);
+    items.push_back(Item{std::move(item), size});
+    ++cls.size;
+    ++m_size;
+    return true;
+  }
+
+  /** \brief removes the next packet to transmit
+   *  \return false if the queue is empty
+   */
+  bool
+  dequeue(T& item)
+  {
+    for (Class& cls : m_classes) {
+      if (cls.size == 0)
+        continue;
+
+      while (true) {
+        FlowId id = cls.active.front();
+        Flow& flow = cls.flows[id];
+        if (flow.deficit >= flow.items.front().size) {
+          item = std::move(flow.items.front().item);
+          flow.deficit -= flow.items.front().size;
+          flow.items.pop_front();
+          if (flow.items.empty()) {
+            // an idle flow does not save up its deficit
+            cls.flows.erase(id);
+            cls.active.pop_front();
+          }
+          --cls.size;
+          --m_size;
+          return true;
+        }
+
+        flow.deficit += m_quantum * getWeight(id);
+        cls.active.pop_front();
+        cls.active.push_back(id);
+      }
+    }
+    return false;
+  }
+
+  /** \brief removes all packets
+   */
+  void
+  clear()
+  {
+    for (Class& cls : m_classes) {
+      cls.flows.clear();
+      cls.active.clear();
+      cls.size = 0;
+    }
+    m_size = 0;
+  }
+
+private:
+  struct Item
+  {
+    T item;
+    size_t size;
+  };
+
+  struct Flow
+  {
+    Flow()
+      : deficit(0)
+    {
+    }
+
+    std::deque<Item> items;
+    size_t deficit;
+  };
+
+  struct Class
+  {
+    Class()
+      : size(0)
+    {
+    }
+
+    std::unordered_map<FlowId, Flow> flows;
+    std::deque<FlowId> active; ///< flows with packets, in round robin order
+    size_t size;
+  };
+
+  size_t m_limit;
+  size_t m_quantum;
+  size_t m_size;
+  Class m_classes[TRANSMIT_CLASS_MAX];
+  std::unordered_map<FlowId, size_t> m_weights;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_TRANSMIT_SCHEDULER_HPP
@@ -27,6 +27,10 @@
 #include "udp-face.hpp"
 #include "core/global-io.hpp"
 
+#ifdef __linux__
+#include <cstring> // for std::memcpy() and std::memset()
+#endif
+
 namespace nfd {
 
 NFD_LOG_INIT("UdpChannel");
@@ -38,6 +42,7 @@ UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
   : m_localEndpoint(localEndpoint)
   , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(timeout)
+  , m_batchSize(1)
 {
   setUri(FaceUri(m_localEndpoint));
 }
@@ -57,12 +62,7 @@ UdpChannel::listen(const FaceCreatedCallback& onFaceCreated,
     m_socket.set_option(ip::v6_only(true));
 
   m_socket.bind(m_localEndpoint);
-  m_socket.async_receive_from(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                              m_remoteEndpoint,
-                              bind(&UdpChannel::handleNewPeer, this,
-                                   boost::asio::placeholders::error,
-                                   boost::asio::placeholders::bytes_transferred,
-                                   onFaceCreated, onReceiveFailed));
+  startReceive(onFaceCreated, onReceiveFailed);
 }
 
 void
@@ -93,6 +93,28 @@ UdpChannel::size() const
   return m_channelFaces.size();
 }
 
+void
+UdpChannel::setBatchSize(size_t batchSize)
+{
+  m_batchSize = std::max<size_t>(batchSize, 1);
+
+#ifdef __linux__
+  // the first datagram of each batch is received into m_inputBuffer by async_receive_from
+  size_t nExtraMessages = m_batchSize - 1;
+  m_batchBuffer.resize(nExtraMessages * ndn::MAX_NDN_PACKET_SIZE);
+  m_batchAddresses.resize(nExtraMessages);
+  m_recvIovecs.resize(nExtraMessages);
+  m_recvMessages.resize(nExtraMessages);
+  for (size_t i = 0; i < nExtraMessages; ++i) {
+    m_recvIovecs[i].iov_base = m_batchBuffer.data() + i * ndn::MAX_NDN_PACKET_SIZE;
+    m_recvIovecs[i].iov_len = ndn::MAX_NDN_PACKET_SIZE;
+    std::memset(&m_recvMessages[i], 0, sizeof(mmsghdr));
+    m_recvMessages[i].msg_hdr.msg_iov = &m_recvIovecs[i];
+    m_recvMessages[i].msg_hdr.msg_iovlen = 1;
+  }
+#endif
+}
+
 std::pair<bool, shared_ptr<UdpFace>>
 UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency)
 {
@@ -118,6 +140,7 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersis
 
   auto face = make_shared<UdpFace>(FaceUri(remoteEndpoint), FaceUri(m_localEndpoint),
                                    std::move(socket), persistency, m_idleFaceTimeout);
+  face->setBatchSize(m_batchSize);
 
   face->onFail.connectSingleShot([this, remoteEndpoint] (const std::string&) {
     NFD_LOG_TRACE("Erasing " << remoteEndpoint << " from channel face map");
@@ -144,27 +167,84 @@ UdpChannel::handleNewPeer(const boost::system::error_code& error,
     return;
   }
 
-  NFD_LOG_DEBUG("[" << m_localEndpoint << "] New peer " << m_remoteEndpoint);
+  if (!dispatchDatagram(m_remoteEndpoint, m_inputBuffer, nBytesReceived,
+                        onFaceCreated, onReceiveFailed))
+    return;
+
+#ifdef __linux__
+  if (m_batchSize > 1 && !receiveBatch(onFaceCreated, onReceiveFailed))
+    return;
+#endif
+
+  startReceive(onFaceCreated, onReceiveFailed);
+}
+
+bool
+UdpChannel::dispatchDatagram(const udp::Endpoint& remoteEndpoint,
+                             const uint8_t* buffer, size_t nBytesReceived,
+                             const FaceCreatedCallback& onFaceCreated,
+                             const ConnectFailedCallback& onReceiveFailed)
+{
+  NFD_LOG_DEBUG("[" << m_localEndpoint << "] New peer " << remoteEndpoint);
 
   bool created;
   shared_ptr<UdpFace> face;
   try {
-    std::tie(created, face) = createFace(m_remoteEndpoint, ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
+    std::tie(created, face) = createFace(remoteEndpoint, ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
   }
   catch (const boost::system::system_error& e) {
     NFD_LOG_WARN("[" << m_localEndpoint << "] Failed to create face for peer "
-                 << m_remoteEndpoint << ": " << e.what());
+                 << remoteEndpoint << ": " << e.what());
     if (onReceiveFailed)
       onReceiveFailed(e.what());
-    return;
+    return false;
   }
 
   if (created)
     onFaceCreated(face);
 
   // dispatch the datagram to the face for processing
-  face->receiveDatagram(m_inputBuffer, nBytesReceived, error);
+  face->receiveDatagram(buffer, nBytesReceived, boost::system::error_code());
+  return true;
+}
+
+#ifdef __linux__
+bool
+UdpChannel::receiveBatch(const FaceCreatedCallback& onFaceCreated,
+                         const ConnectFailedCallback& onReceiveFailed)
+{
+  for (size_t i = 0; i < m_recvMessages.size(); ++i) {
+    m_recvMessages[i].msg_hdr.msg_name = &m_batchAddresses[i];
+    m_recvMessages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+  }
 
+  int nMessages = ::recvmmsg(m_socket.native_handle(), m_recvMessages.data(),
+                             m_recvMessages.size(), MSG_DONTWAIT, nullptr);
+  if (nMessages < 0) {
+    // EAGAIN means nothing else is queued; other errors will be reported by the next receive
+    return true;
+  }
+
+  for (int i = 0; i < nMessages; ++i) {
+    udp::Endpoint remoteEndpoint;
+    const msghdr& header = m_recvMessages[i].msg_hdr;
+    if (header.msg_namelen > remoteEndpoint.capacity())
+      continue;
+    std::memcpy(remoteEndpoint.data(), header.msg_name, header.msg_namelen);
+    remoteEndpoint.resize(header.msg_namelen);
+
+    if (!dispatchDatagram(remoteEndpoint, m_batchBuffer.data() + i * ndn::MAX_NDN_PACKET_SIZE,
+                          m_recvMessages[i].msg_len, onFaceCreated, onReceiveFailed))
+      return false;
+  }
+  return true;
+}
+#endif // __linux__
+
+void
+UdpChannel::startReceive(const FaceCreatedCallback& onFaceCreated,
+                         const ConnectFailedCallback& onReceiveFailed)
+{
   m_socket.async_receive_from(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
                               m_remoteEndpoint,
                               bind(&UdpChannel::handleNewPeer, this,
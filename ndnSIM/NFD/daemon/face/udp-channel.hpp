@@ -28,6 +28,10 @@
 
 #include "channel.hpp"
 
+#ifdef __linux__
+#include <sys/socket.h> // for recvmmsg()
+#endif
+
 namespace nfd {
 
 namespace udp {
@@ -91,6 +95,14 @@ public:
   bool
   isListening() const;
 
+  /** \brief set the maximum number of datagrams received or sent with one system call
+   *
+   *  The batch size applies to the channel socket and to the faces created afterwards.
+   *  \sa DatagramFace::setBatchSize
+   */
+  void
+  setBatchSize(size_t batchSize);
+
 private:
   std::pair<bool, shared_ptr<UdpFace>>
   createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency);
@@ -105,6 +117,27 @@ private:
                 const FaceCreatedCallback& onFaceCreated,
                 const ConnectFailedCallback& onReceiveFailed);
 
+  /** \return false if no face could be created for the sender
+   */
+  bool
+  dispatchDatagram(const udp::Endpoint& remoteEndpoint,
+                   const uint8_t* buffer, size_t nBytesReceived,
+                   const FaceCreatedCallback& onFaceCreated,
+                   const ConnectFailedCallback& onReceiveFailed);
+
+#ifdef __linux__
+  /** \brief receive and dispatch the datagrams already queued on the socket, without blocking
+   *  \return false if dispatching one of the datagrams failed
+   */
+  bool
+  receiveBatch(const FaceCreatedCallback& onFaceCreated,
+               const ConnectFailedCallback& onReceiveFailed);
+#endif
+
+  void
+  startReceive(const FaceCreatedCallback& onFaceCreated,
+               const ConnectFailedCallback& onReceiveFailed);
+
 private:
   std::map<udp::Endpoint, shared_ptr<UdpFace>> m_channelFaces;
 
@@ -126,6 +159,15 @@ private:
   time::seconds m_idleFaceTimeout;
 
   uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
+
+  size_t m_batchSize;
+
+#ifdef __linux__
+  std::vector<uint8_t> m_batchBuffer;
+  std::vector<sockaddr_storage> m_batchAddresses;
+  std::vector<iovec> m_recvIovecs;
+  std::vector<mmsghdr> m_recvMessages;
+#endif
 };
 
 inline bool
@@ -47,6 +47,7 @@ static const boost::asio::ip::address_v6 ALL_V6_ENDPOINT(
 
 UdpFactory::UdpFactory(const std::string& defaultPort/* = "6363"*/)
   : m_defaultPort(defaultPort)
+  , m_batchSize(1)
 {
 }
 
@@ -130,6 +131,7 @@ UdpFactory::createChannel(const udp::Endpoint& endpoint,
   }
 
   channel = make_shared<UdpChannel>(endpoint, timeout);
+  channel->setBatchSize(m_batchSize);
   m_channels[endpoint] = channel;
   prohibitEndpoint(endpoint);
 
@@ -227,6 +229,7 @@ UdpFactory::createMulticastFace(const udp::Endpoint& localEndpoint,
 
   face = make_shared<MulticastUdpFace>(multicastEndpoint, FaceUri(localEndpoint),
                                        std::move(receiveSocket), std::move(sendSocket));
+  face->setBatchSize(m_batchSize);
 
   face->onFail.connectSingleShot([this, localEndpoint] (const std::string& reason) {
     m_multicastFaces.erase(localEndpoint);
@@ -158,6 +158,15 @@ public:
   const MulticastFaceMap&
   getMulticastFaces() const;
 
+  /**
+   * \brief Set the number of datagrams received or sent with one system call
+   *
+   * Applies to channels and multicast faces created afterwards.
+   * \sa DatagramFace::setBatchSize
+   */
+  void
+  setBatchSize(size_t batchSize);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   prohibitEndpoint(const udp::Endpoint& endpoint);
@@ -201,6 +210,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   std::string m_defaultPort;
   std::set<udp::Endpoint> m_prohibitedEndpoints;
+  size_t m_batchSize;
 };
 
 inline const UdpFactory::MulticastFaceMap&
@@ -209,6 +219,12 @@ UdpFactory::getMulticastFaces() const
   return m_multicastFaces;
 }
 
+inline void
+UdpFactory::setBatchSize(size_t batchSize)
+{
+  m_batchSize = batchSize;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_UDP_FACTORY_HPP
@@ -37,6 +37,7 @@ WebSocketChannel::WebSocketChannel(const websocket::Endpoint& localEndpoint)
   : m_localEndpoint(localEndpoint)
   , m_isListening(false)
   , m_pingInterval(10000)
+  , m_coalescingDelay(0)
 {
   setUri(FaceUri(m_localEndpoint, "ws"));
 
@@ -63,6 +64,12 @@ WebSocketChannel::setPingInterval(time::milliseconds interval)
   m_pingInterval = interval;
 }
 
+void
+WebSocketChannel::setCoalescingDelay(const time::nanoseconds& delay)
+{
+  m_coalescingDelay = delay;
+}
+
 void
 WebSocketChannel::setPongTimeout(time::milliseconds timeout)
 {
@@ -106,6 +113,7 @@ WebSocketChannel::handleOpen(websocketpp::connection_hdl hdl)
     std::string remote = "wsclient://" + m_server.get_con_from_hdl(hdl)->get_remote_endpoint();
     auto face = make_shared<WebSocketFace>(FaceUri(remote), this->getUri(),
                                            hdl, ref(m_server));
+    face->setCoalescingDelay(m_coalescingDelay);
     m_onFaceCreatedCallback(face);
     m_channelFaces[hdl] = face;
     // Schedule ping message
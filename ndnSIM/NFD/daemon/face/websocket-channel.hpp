@@ -68,6 +68,14 @@ public:
   bool
   isListening() const;
 
+  /** \brief coalesce packets sent within \p delay into one WebSocket message
+   *
+   *  Applies to faces created afterwards.
+   *  \sa WebSocketFace::setCoalescingDelay
+   */
+  void
+  setCoalescingDelay(const time::nanoseconds& delay);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   setPingInterval(time::milliseconds interval);
@@ -112,6 +120,7 @@ private:
   bool m_isListening;
 
   time::milliseconds m_pingInterval;
+  time::nanoseconds m_coalescingDelay;
 };
 
 inline bool
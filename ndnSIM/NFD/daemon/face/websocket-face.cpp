@@ -36,6 +36,7 @@ WebSocketFace::WebSocketFace(const FaceUri& remoteUri, const FaceUri& localUri,
   , m_handle(hdl)
   , m_server(server)
   , m_closed(false)
+  , m_coalescingDelay(0)
 {
   NFD_LOG_FACE_INFO("Creating face");
   this->setPersistency(ndn::nfd::FACE_PERSISTENCY_ON_DEMAND);
@@ -51,14 +52,7 @@ WebSocketFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  const Block& payload = interest.wireEncode();
-  this->getMutableCounters().getNOutBytes() += payload.size();
-
-  websocketpp::lib::error_code ec;
-  m_server.send(m_handle, payload.wire(), payload.size(),
-                websocketpp::frame::opcode::binary, ec);
-  if (ec)
-    NFD_LOG_FACE_WARN("Failed to send Interest: " << ec.message());
+  sendPayload(interest.wireEncode());
 }
 
 void
@@ -71,14 +65,46 @@ WebSocketFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  const Block& payload = data.wireEncode();
+  sendPayload(data.wireEncode());
+}
+
+void
+WebSocketFace::sendPayload(const Block& payload)
+{
   this->getMutableCounters().getNOutBytes() += payload.size();
 
+  if (m_coalescingDelay <= time::nanoseconds::zero())
+    return sendMessage(payload.wire(), payload.size());
+
+  if (m_pendingMessage.size() + payload.size() > ndn::MAX_NDN_PACKET_SIZE)
+    flushPendingMessage();
+
+  if (m_pendingMessage.empty())
+    m_flushEvent = scheduler::schedule(m_coalescingDelay,
+                                       bind(&WebSocketFace::flushPendingMessage, this));
+
+  m_pendingMessage.insert(m_pendingMessage.end(), payload.begin(), payload.end());
+}
+
+void
+WebSocketFace::sendMessage(const uint8_t* buffer, size_t size)
+{
   websocketpp::lib::error_code ec;
-  m_server.send(m_handle, payload.wire(), payload.size(),
-                websocketpp::frame::opcode::binary, ec);
+  m_server.send(m_handle, buffer, size, websocketpp::frame::opcode::binary, ec);
   if (ec)
-    NFD_LOG_FACE_WARN("Failed to send Data: " << ec.message());
+    NFD_LOG_FACE_WARN("Failed to send " << size << " bytes: " << ec.message());
+}
+
+void
+WebSocketFace::flushPendingMessage()
+{
+  m_flushEvent.cancel();
+  if (m_pendingMessage.empty())
+    return;
+
+  NFD_LOG_FACE_TRACE("Sending " << m_pendingMessage.size() << " coalesced bytes");
+  sendMessage(m_pendingMessage.data(), m_pendingMessage.size());
+  m_pendingMessage.clear();
 }
 
 void
@@ -89,6 +115,8 @@ WebSocketFace::close()
 
   NFD_LOG_FACE_INFO("Closing face");
 
+  flushPendingMessage();
+
   m_closed = true;
   scheduler::cancel(m_pingEventId);
   websocketpp::lib::error_code ec;
@@ -110,21 +138,27 @@ WebSocketFace::handleReceive(const std::string& msg)
   NFD_LOG_FACE_TRACE("Received: " << msg.size() << " bytes");
   this->getMutableCounters().getNInBytes() += msg.size();
 
-  // Try to parse message data
-  bool isOk = false;
-  Block element;
-  std::tie(isOk, element) = Block::fromBuffer(reinterpret_cast<const uint8_t*>(msg.c_str()),
-                                              msg.size());
-  if (!isOk)
-    {
-      NFD_LOG_FACE_WARN("Received block is invalid or too large to process");
-      return;
-    }
-
-  if (!this->decodeAndDispatchInput(element))
+  // the peer may have coalesced several packets into this message
+  const uint8_t* buffer = reinterpret_cast<const uint8_t*>(msg.data());
+  size_t offset = 0;
+  while (offset < msg.size())
     {
-      NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
-      // ignore unknown packet and proceed
+      // Try to parse message data
+      bool isOk = false;
+      Block element;
+      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, msg.size() - offset);
+      if (!isOk)
+        {
+          NFD_LOG_FACE_WARN("Received block is invalid or too large to process");
+          return;
+        }
+      offset += element.size();
+
+      if (!this->decodeAndDispatchInput(element))
+        {
+          NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
+          // ignore unknown packet and proceed
+        }
     }
 }
 
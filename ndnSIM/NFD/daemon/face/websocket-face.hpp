@@ -69,18 +69,46 @@ public:
     m_pingEventId = id;
   }
 
-protected:
+  /** \brief coalesce packets sent within \p delay into one WebSocket message
+   *
+   *  A message carries concatenated TLV elements, up to MAX_NDN_PACKET_SIZE bytes.
+   *  Zero, the default, sends every packet in its own message as soon as it is sent.
+   */
+  void
+  setCoalescingDelay(const time::nanoseconds& delay)
+  {
+    m_coalescingDelay = delay;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   // friend because it needs to invoke protected handleReceive
   friend class WebSocketChannel;
 
+  /** \brief processes a received message, which may carry several TLV elements
+   */
   void
   handleReceive(const std::string& msg);
 
+private:
+  void
+  sendPayload(const Block& payload);
+
+  void
+  sendMessage(const uint8_t* buffer, size_t size);
+
+  void
+  flushPendingMessage();
+
 private:
   websocketpp::connection_hdl m_handle;
   websocket::Server& m_server;
   scheduler::EventId m_pingEventId;
   bool m_closed;
+
+  time::nanoseconds m_coalescingDelay;
+  /// packets waiting to be sent together, concatenated
+  std::vector<uint8_t> m_pendingMessage;
+  scheduler::ScopedEventId m_flushEvent;
 };
 
 } // namespace nfd
@@ -77,6 +77,10 @@ AccessStrategy::afterReceiveNewInterest(const Face& inFace,
   Name miName;
   shared_ptr<MtInfo> mi;
   std::tie(miName, mi) = this->findPrefixMeasurements(*pitEntry);
+  if (mi == nullptr) {
+    mi = this->seedPrefixMeasurements(*pitEntry);
+    miName = interest.getName().getPrefix(-1);
+  }
 
   // has measurements for Interest Name?
   if (mi != nullptr) {
@@ -220,6 +224,10 @@ AccessStrategy::updateMeasurements(const Face& inFace, const Data& data,
   FaceInfo& fi = m_fit[inFace.getId()];
   fi.rtt.addMeasurement(rtt);
 
+  if (data.getName().size() >= 1) {
+    m_rttPrior.addMeasurement(data.getName().getPrefix(-1), inFace.getId(), rtt);
+  }
+
   shared_ptr<MtInfo> mi = this->addPrefixMeasurements(data);
   if (mi->lastNexthop != inFace.getId()) {
     mi->lastNexthop = inFace.getId();
@@ -270,6 +278,33 @@ AccessStrategy::addPrefixMeasurements(const Data& data)
   return me->getOrCreateStrategyInfo<MtInfo>();
 }
 
+shared_ptr<AccessStrategy::MtInfo>
+AccessStrategy::seedPrefixMeasurements(const pit::Entry& pitEntry)
+{
+  const Name& name = pitEntry.getName();
+  RttPriorTable::Estimate estimate;
+  if (name.size() < 1 || !m_rttPrior.estimate(name, estimate)) {
+    return nullptr;
+  }
+
+  // same granularity as addPrefixMeasurements
+  shared_ptr<measurements::Entry> me = this->getMeasurements().get(name.getPrefix(-1));
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  static const time::nanoseconds ME_LIFETIME = time::seconds(8);
+  this->getMeasurements().extendLifetime(*me, ME_LIFETIME);
+
+  shared_ptr<MtInfo> mi = me->getOrCreateStrategyInfo<MtInfo>();
+  mi->lastNexthop = estimate.face;
+  mi->rtt.setPrior(estimate.rtt, estimate.deviation);
+  NFD_LOG_DEBUG(pitEntry.getInterest() << " seeded lastNexthop=" << estimate.face <<
+                " rtt=" << estimate.rtt.count() <<
+                " correlativity=" << estimate.correlativity);
+  return mi;
+}
+
 AccessStrategy::FaceInfo::FaceInfo()
   : rtt(1, time::milliseconds(1), 0.1)
 {
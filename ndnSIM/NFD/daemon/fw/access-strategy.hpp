@@ -29,6 +29,7 @@
 #include "strategy.hpp"
 #include "rtt-estimator.hpp"
 #include "retx-suppression-fixed.hpp"
+#include "rtt-prior-table.hpp"
 #include <unordered_set>
 #include <unordered_map>
 
@@ -45,6 +46,9 @@ namespace fw {
  *     the granularity of this knowledge is the parent of Data Name.
  *  3. Forward subsequent Interests to the last working nexthop.
  *     If it doesn't respond, multicast again.
+ *
+ *  For an Interest without measurements, measurements are initialized from prefixes with
+ *  correlated structured Names (see RttPriorTable), if any, instead of multicasting.
  */
 class AccessStrategy : public Strategy
 {
@@ -110,6 +114,12 @@ private: // StrategyInfo
   shared_ptr<MtInfo>
   addPrefixMeasurements(const Data& data);
 
+  /** \brief create per-prefix measurements for Interest from correlated prefixes
+   *  \return nullptr if no prefix is correlated with Interest Name
+   */
+  shared_ptr<MtInfo>
+  seedPrefixMeasurements(const pit::Entry& pitEntry);
+
   /** \brief global per-face StrategyInfo
    */
   class FaceInfo
@@ -168,6 +178,7 @@ public:
 private:
   FaceInfoTable m_fit;
   RetxSuppressionFixed m_retxSuppression;
+  RttPriorTable m_rttPrior;
   signal::ScopedConnection m_removeFaceInfoConn;
 };
 
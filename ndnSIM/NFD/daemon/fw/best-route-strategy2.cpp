@@ -115,6 +115,11 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
 
     if (it == nexthops.end()) {
       NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, inFace, nackHeader);
+
       this->rejectPendingInterest(pitEntry);
       return;
     }
@@ -157,5 +162,16 @@ BestRouteStrategy2::afterReceiveInterest(const Face& inFace,
   }
 }
 
+void
+BestRouteStrategy2::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                                     shared_ptr<fib::Entry> fibEntry,
+                                     shared_ptr<pit::Entry> pitEntry)
+{
+  if (!this->sendNacksIfAllUpstreamsNacked(pitEntry)) {
+    NFD_LOG_DEBUG(nack.getInterest() << " nack-from=" << inFace.getId()
+                                     << " waiting-for-other-upstreams");
+  }
+}
+
 } // namespace fw
 } // namespace nfd
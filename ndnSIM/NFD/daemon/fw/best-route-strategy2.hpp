@@ -39,6 +39,9 @@ namespace fw {
  *  exponential backoff algorithm), the strategy forwards the Interest again to
  *  the lowest-cost nexthop (except downstream) that is not previously used.
  *  If all nexthops have been used, the strategy starts over.
+ *
+ *  A new Interest without an eligible nexthop is answered with a Nack~NoRoute.
+ *  When every upstream has returned a Nack, Nacks are sent to all downstreams.
  */
 class BestRouteStrategy2 : public Strategy
 {
@@ -51,6 +54,11 @@ public:
                        shared_ptr<fib::Entry> fibEntry,
                        shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
 
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   shared_ptr<fib::Entry> fibEntry,
+                   shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
 public:
   static const Name STRATEGY_NAME;
 
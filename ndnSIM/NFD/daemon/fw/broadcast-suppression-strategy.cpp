@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "broadcast-suppression-strategy.hpp"
+#include "core/random.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-geo-position-tag.hpp"
+
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+namespace nfd {
+namespace fw {
+
+const Name BroadcastSuppressionStrategy::STRATEGY_NAME(
+  "ndn:/localhost/nfd/strategy/broadcast-suppression/%FD%01");
+NFD_REGISTER_STRATEGY(BroadcastSuppressionStrategy);
+
+BroadcastSuppressionStrategy::Parameters::Parameters()
+  : mode(MODE_COUNTER)
+  , probability(0.5)
+  , counterThreshold(2)
+  , maxDefer(time::milliseconds(20))
+  , range(250.0)
+{
+}
+
+BroadcastSuppressionStrategy::PitInfo::PitInfo()
+  : isDeferred(false)
+  , nOverheard(0)
+{
+}
+
+BroadcastSuppressionStrategy::BroadcastSuppressionStrategy(Forwarder& forwarder,
+                                                           const Name& name)
+  : Strategy(forwarder, name)
+  , m_parameters(getDefaultParameters())
+  , m_nForwarded(0)
+  , m_nSuppressed(0)
+{
+}
+
+BroadcastSuppressionStrategy::Parameters&
+BroadcastSuppressionStrategy::getDefaultParameters()
+{
+  static Parameters parameters;
+  return parameters;
+}
+
+void
+BroadcastSuppressionStrategy::afterReceiveInterest(const Face& inFace,
+                                                   const Interest& interest,
+                                                   shared_ptr<fib::Entry> fibEntry,
+                                                   shared_ptr<pit::Entry> pitEntry)
+{
+  bool hasNonLocal = false;
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
+    shared_ptr<Face> outFace = it->getFace();
+    if (!pitEntry->canForwardTo(*outFace))
+      continue;
+
+    if (outFace->isLocal())
+      this->sendInterest(pitEntry, outFace);
+    else
+      hasNonLocal = true;
+  }
+
+  if (!hasNonLocal) {
+    if (!pitEntry->hasUnexpiredOutRecords())
+      this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  if (inFace.isLocal()) {
+    this->forwardToNonLocal(pitEntry, *fibEntry);
+    return;
+  }
+
+  if (this->hasOverheardData(interest.getName())) {
+    // a neighbor has just served the name, likely in range of the requester as well
+    this->suppress(pitEntry);
+    return;
+  }
+
+  if (m_parameters.mode == MODE_PROBABILISTIC) {
+    boost::random::uniform_real_distribution<double> dist(0.0, 1.0);
+    if (dist(getGlobalRng()) < m_parameters.probability)
+      this->forwardToNonLocal(pitEntry, *fibEntry);
+    else
+      this->suppress(pitEntry);
+    return;
+  }
+
+  shared_ptr<PitInfo> pitInfo = pitEntry->getOrCreateStrategyInfo<PitInfo>();
+  if (pitInfo->isDeferred)
+    return; // e.g., retransmission from another downstream, the decision is pending
+
+  pitInfo->isDeferred = true;
+  pitInfo->nOverheard = 0;
+  pitInfo->deferTimer = scheduler::schedule(getDefer(interest),
+    bind(&BroadcastSuppressionStrategy::onDeferTimeout, this,
+         weak_ptr<pit::Entry>(pitEntry), weak_ptr<fib::Entry>(fibEntry)));
+}
+
+time::nanoseconds
+BroadcastSuppressionStrategy::getDefer(const Interest& interest) const
+{
+  time::nanoseconds::rep maxDefer = m_parameters.maxDefer.count();
+  if (maxDefer <= 0)
+    return time::nanoseconds::zero();
+
+  if (m_parameters.mode == MODE_COUNTER) {
+    boost::random::uniform_int_distribution<time::nanoseconds::rep> dist(0, maxDefer - 1);
+    return time::nanoseconds(dist(getGlobalRng()));
+  }
+
+  // MODE_DISTANCE: receivers far from the sender forward first, as they cover more new area
+  ns3::Vector position, previousHop;
+  if (!ns3::ndn::GeoPositionTag::GetCurrentNodePosition(position) ||
+      !ns3::ndn::GeoPositionTag::GetPreviousHopPosition(interest, previousHop))
+    return m_parameters.maxDefer;
+
+  double ratio = m_parameters.range > 0.0 ?
+                 ns3::CalculateDistance(position, previousHop) / m_parameters.range : 1.0;
+  ratio = std::min(ratio, 1.0);
+  return time::nanoseconds(static_cast<time::nanoseconds::rep>((1.0 - ratio) * maxDefer));
+}
+
+void
+BroadcastSuppressionStrategy::afterReceiveLoopedInterest(const Face& inFace,
+                                                         const Interest& interest,
+                                                         shared_ptr<pit::Entry> pitEntry)
+{
+  shared_ptr<PitInfo> pitInfo = pitEntry->getStrategyInfo<PitInfo>();
+  if (pitInfo == nullptr || !pitInfo->isDeferred)
+    return;
+
+  ++pitInfo->nOverheard;
+  uint32_t threshold = m_parameters.mode == MODE_COUNTER ? m_parameters.counterThreshold : 1;
+  if (pitInfo->nOverheard < threshold)
+    return;
+
+  pitInfo->isDeferred = false;
+  pitInfo->deferTimer.cancel();
+  this->suppress(pitEntry);
+}
+
+void
+BroadcastSuppressionStrategy::onDeferTimeout(weak_ptr<pit::Entry> pitEntryWeak,
+                                             weak_ptr<fib::Entry> fibEntryWeak)
+{
+  shared_ptr<pit::Entry> pitEntry = pitEntryWeak.lock();
+  if (pitEntry == nullptr)
+    return;
+
+  shared_ptr<PitInfo> pitInfo = pitEntry->getStrategyInfo<PitInfo>();
+  if (pitInfo != nullptr)
+    pitInfo->isDeferred = false;
+
+  if (pitEntry->getInRecords().empty())
+    return; // satisfied in the meantime
+
+  shared_ptr<fib::Entry> fibEntry = fibEntryWeak.lock();
+  if (fibEntry == nullptr) {
+    this->suppress(pitEntry);
+    return;
+  }
+
+  this->forwardToNonLocal(pitEntry, *fibEntry);
+}
+
+void
+BroadcastSuppressionStrategy::forwardToNonLocal(shared_ptr<pit::Entry> pitEntry,
+                                                const fib::Entry& fibEntry)
+{
+  ++m_nForwarded;
+
+  const fib::NextHopList& nexthops = fibEntry.getNextHops();
+  for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
+    shared_ptr<Face> outFace = it->getFace();
+    if (!outFace->isLocal() && pitEntry->canForwardTo(*outFace))
+      this->sendInterest(pitEntry, outFace);
+  }
+
+  if (!pitEntry->hasUnexpiredOutRecords()) {
+    this->rejectPendingInterest(pitEntry);
+  }
+}
+
+void
+BroadcastSuppressionStrategy::suppress(shared_ptr<pit::Entry> pitEntry)
+{
+  ++m_nSuppressed;
+
+  if (!pitEntry->hasUnexpiredOutRecords()) {
+    this->rejectPendingInterest(pitEntry);
+  }
+}
+
+} // namespace fw
+} // namespace nfd
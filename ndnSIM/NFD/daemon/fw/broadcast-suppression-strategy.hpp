@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_BROADCAST_SUPPRESSION_STRATEGY_HPP
+#define NFD_DAEMON_FW_BROADCAST_SUPPRESSION_STRATEGY_HPP
+
+#include "strategy.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief a forwarding strategy that forwards Interest to all FIB nexthops, with broadcast
+ *         storm mitigation for Interests received from other nodes
+ *
+ *  Interests from local faces (this node is the consumer) are forwarded right away, and
+ *  local nexthops (e.g., producers on this node) always receive the Interest.  Forwarding to
+ *  other nexthops is decided by the mode:
+ *  - MODE_PROBABILISTIC: forward with probability \p probability;
+ *  - MODE_COUNTER: wait a random time in [0, \p maxDefer), skip forwarding if
+ *    \p counterThreshold copies of the Interest were overheard in the meantime;
+ *  - MODE_DISTANCE: wait the longer the closer the previous hop is (\p maxDefer if it is at
+ *    this node's position, zero at \p range or farther), skip forwarding if a copy was
+ *    overheard in the meantime.  Positions come from ns-3 MobilityModels
+ *    (see ns3::ndn::GeoPositionTag), without them the wait is \p maxDefer.
+ *
+ *  Overheard copies are Interests with the same Nonce, e.g. rebroadcasts of neighbors on a
+ *  shared wireless face (see Strategy::afterReceiveLoopedInterest).
+ *
+ *  Interests from other nodes are not forwarded to other nexthops at all if Data under their
+ *  name were overheard recently (see Strategy::hasOverheardData).
+ */
+class BroadcastSuppressionStrategy : public Strategy
+{
+public:
+  enum Mode {
+    MODE_PROBABILISTIC,
+    MODE_COUNTER,
+    MODE_DISTANCE
+  };
+
+  struct Parameters
+  {
+    Parameters();
+
+    Mode mode;
+    double probability;         ///< MODE_PROBABILISTIC
+    uint32_t counterThreshold;  ///< MODE_COUNTER
+    time::nanoseconds maxDefer; ///< MODE_COUNTER and MODE_DISTANCE
+    double range;               ///< MODE_DISTANCE, meters
+  };
+
+  BroadcastSuppressionStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  /** \brief parameters of instances created afterwards
+   *
+   *  Every forwarder creates its instance of the strategy when the NDN stack is installed,
+   *  so the defaults should be changed before, e.g., before StackHelper::Install.
+   */
+  static Parameters&
+  getDefaultParameters();
+
+  const Parameters&
+  getParameters() const
+  {
+    return m_parameters;
+  }
+
+  void
+  setParameters(const Parameters& parameters)
+  {
+    m_parameters = parameters;
+  }
+
+  /** \return number of Interests forwarded to non-local nexthops
+   */
+  uint64_t
+  getNForwarded() const
+  {
+    return m_nForwarded;
+  }
+
+  /** \return number of Interests not forwarded to non-local nexthops
+   */
+  uint64_t
+  getNSuppressed() const
+  {
+    return m_nSuppressed;
+  }
+
+public: // triggers
+  virtual void
+  afterReceiveInterest(const Face& inFace,
+                       const Interest& interest,
+                       shared_ptr<fib::Entry> fibEntry,
+                       shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  virtual void
+  afterReceiveLoopedInterest(const Face& inFace, const Interest& interest,
+                             shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+public:
+  static const Name STRATEGY_NAME;
+
+private: // StrategyInfo
+  /** \brief StrategyInfo on PIT entry
+   */
+  class PitInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1030;
+    }
+
+    PitInfo();
+
+  public:
+    bool isDeferred;
+    uint32_t nOverheard; ///< copies overheard since the deferral started
+    scheduler::ScopedEventId deferTimer;
+  };
+
+private:
+  time::nanoseconds
+  getDefer(const Interest& interest) const;
+
+  void
+  onDeferTimeout(weak_ptr<pit::Entry> pitEntryWeak, weak_ptr<fib::Entry> fibEntryWeak);
+
+  void
+  forwardToNonLocal(shared_ptr<pit::Entry> pitEntry, const fib::Entry& fibEntry);
+
+  void
+  suppress(shared_ptr<pit::Entry> pitEntry);
+
+private:
+  Parameters m_parameters;
+  uint64_t m_nForwarded;
+  uint64_t m_nSuppressed;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_BROADCAST_SUPPRESSION_STRATEGY_HPP
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "delegation-cache.hpp"
+
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("DelegationCache");
+
+const time::nanoseconds DelegationCache::DEFAULT_LIFETIME = time::seconds(1);
+
+DelegationCache::DelegationCache(const Fib& fib, const time::nanoseconds& lifetime,
+                                 size_t capacity)
+  : m_fib(fib)
+  , m_lifetime(lifetime)
+  , m_capacity(std::max<size_t>(capacity, 1))
+  , m_nHits(0)
+  , m_nMisses(0)
+{
+}
+
+shared_ptr<fib::Entry>
+DelegationCache::findLongestPrefixMatch(const Interest& interest)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  const Block& link = interest.getLinkWire();
+  std::string key(reinterpret_cast<const char*>(link.wire()), link.size());
+
+  auto it = m_records.find(key);
+  if (it != m_records.end() && it->second.expiry > now) {
+    ++m_nHits;
+    Record& record = it->second;
+    if (record.fibVersion != m_fib.getVersion()) {
+      this->selectDelegation(record);
+    }
+    return record.fibEntry;
+  }
+
+  ++m_nMisses;
+  if (it == m_records.end()) {
+    if (m_records.size() >= m_capacity) {
+      this->evict(now);
+    }
+    it = m_records.emplace(std::move(key), Record()).first;
+  }
+
+  Record& record = it->second;
+  record.delegations.clear();
+  record.expiry = now + m_lifetime;
+  try {
+    ndn::Link decoded(link);
+    for (const auto& delegation : decoded.getDelegations()) {
+      record.delegations.push_back(std::get<1>(delegation));
+    }
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_DEBUG("findLongestPrefixMatch interest=" << interest.getName() <<
+                  " malformed Link: " << e.what());
+  }
+  this->selectDelegation(record);
+  return record.fibEntry;
+}
+
+void
+DelegationCache::selectDelegation(Record& record) const
+{
+  record.fibVersion = m_fib.getVersion();
+  record.fibEntry = nullptr;
+
+  for (const Name& delegation : record.delegations) {
+    shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch(delegation);
+    if (fibEntry->hasNextHops()) {
+      record.fibEntry = fibEntry;
+      return;
+    }
+    if (record.fibEntry == nullptr) {
+      record.fibEntry = fibEntry;
+    }
+  }
+}
+
+void
+DelegationCache::evict(const time::steady_clock::TimePoint& now)
+{
+  for (auto it = m_records.begin(); it != m_records.end();) {
+    if (it->second.expiry <= now) {
+      it = m_records.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  if (m_records.size() >= m_capacity) {
+    m_records.clear();
+  }
+}
+
+} // namespace fw
+} // namespace nfd
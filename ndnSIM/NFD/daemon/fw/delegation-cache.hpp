@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_DELEGATION_CACHE_HPP
+#define NFD_DAEMON_FW_DELEGATION_CACHE_HPP
+
+#include "table/fib.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief delegations of recently seen Link objects, with the FIB entry of the selected one
+ *
+ *  Interests of mobile producers usually all carry the same Link.  Instead of decoding the
+ *  Link and ranking its delegations for every Interest, the cache keeps, by the wire encoding
+ *  of the Link, its delegations in preference order and the FIB entry of the most preferred
+ *  delegation with a route.  A record is used for \p lifetime after its Link is decoded; the
+ *  delegation is selected again when the FIB version changes.
+ */
+class DelegationCache : noncopyable
+{
+public:
+  explicit
+  DelegationCache(const Fib& fib,
+                  const time::nanoseconds& lifetime = DEFAULT_LIFETIME,
+                  size_t capacity = 1024);
+
+  /** \brief find the FIB entry to forward an Interest carrying a Link
+   *  \pre interest.hasLink()
+   *  \return the FIB entry of the most preferred delegation with nexthops, or of the most
+   *          preferred delegation if none has a route; nullptr if the Link cannot be decoded
+   */
+  shared_ptr<fib::Entry>
+  findLongestPrefixMatch(const Interest& interest);
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  /// number of lookups answered without decoding the Link
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  /// number of lookups that decoded the Link
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  static const time::nanoseconds DEFAULT_LIFETIME;
+
+private:
+  struct Record
+  {
+    std::vector<Name> delegations; ///< by preference
+    shared_ptr<fib::Entry> fibEntry;
+    uint64_t fibVersion;
+    time::steady_clock::TimePoint expiry;
+  };
+
+  void
+  selectDelegation(Record& record) const;
+
+  /** \brief erase the expired records, and all of them if the cache is still full
+   */
+  void
+  evict(const time::steady_clock::TimePoint& now);
+
+private:
+  const Fib& m_fib;
+  time::nanoseconds m_lifetime;
+  size_t m_capacity;
+  std::unordered_map<std::string, Record> m_records; ///< by wire encoding of the Link
+  uint64_t m_nHits;
+  uint64_t m_nMisses;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_DELEGATION_CACHE_HPP
@@ -34,6 +34,8 @@ NFD_LOG_INIT("FaceTable");
 FaceTable::FaceTable(Forwarder& forwarder)
   : m_forwarder(forwarder)
   , m_lastFaceId(FACEID_RESERVED_MAX)
+  , m_faces(FACEID_RESERVED_MAX + 1)
+  , m_nFaces(0)
 {
 }
 
@@ -45,20 +47,22 @@ FaceTable::~FaceTable()
 shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  if (id < 0 || static_cast<size_t>(id) >= m_faces.size()) {
+    return shared_ptr<Face>();
+  }
+  return m_faces[id];
 }
 
 size_t
 FaceTable::size() const
 {
-  return m_faces.size();
+  return m_nFaces;
 }
 
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && this->get(face->getId()) != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
@@ -72,8 +76,8 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
+  BOOST_ASSERT(m_faces[faceId] == nullptr);
   this->addImpl(face, faceId);
 }
 
@@ -81,12 +85,17 @@ void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
   face->setId(faceId);
+  if (static_cast<size_t>(faceId) >= m_faces.size()) {
+    m_faces.resize(faceId + 1);
+  }
   m_faces[faceId] = face;
+  ++m_nFaces;
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
   face->onReceiveInterest.connect(bind(&Forwarder::onInterest, &m_forwarder, ref(*face), _1));
   face->onReceiveData.connect(bind(&Forwarder::onData, &m_forwarder, ref(*face), _1));
+  face->onReceiveNack.connect(bind(&Forwarder::onNack, &m_forwarder, ref(*face), _1));
   face->onFail.connectSingleShot(bind(&FaceTable::remove, this, face, _1));
 
   this->onAdd(face);
@@ -98,7 +107,8 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   this->onRemove(face);
 
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+  m_faces[faceId].reset();
+  --m_nFaces;
   face->setId(INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
@@ -112,7 +122,7 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
 FaceTable::ForwardRange
 FaceTable::getForwardRange() const
 {
-  return m_faces | boost::adaptors::map_values;
+  return m_faces | boost::adaptors::filtered(IsOccupied());
 }
 
 FaceTable::const_iterator
@@ -27,13 +27,17 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "face/face.hpp"
-#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/filtered.hpp>
 
 namespace nfd {
 
 class Forwarder;
 
 /** \brief container of all Faces
+ *
+ *  Faces are stored in a vector indexed by FaceId, so that get is a single array access.
+ *  FaceIds are allocated sequentially and never reused, so the slot of a removed Face stays
+ *  empty and a stale FaceId cannot find a later Face.
  */
 class FaceTable : noncopyable
 {
@@ -58,9 +62,20 @@ public:
   size() const;
 
 public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face>> FaceMap;
+  /** \brief slots indexed by FaceId, null for unused FaceIds
+   */
+  typedef std::vector<shared_ptr<Face>> FaceSlots;
+
+  struct IsOccupied
+  {
+    bool
+    operator()(const shared_ptr<Face>& slot) const
+    {
+      return slot != nullptr;
+    }
+  };
 
-  typedef boost::select_second_const_range<FaceMap> ForwardRange;
+  typedef boost::filtered_range<IsOccupied, const FaceSlots> ForwardRange;
 
   /** \brief ForwardIterator for shared_ptr<Face>
    */
@@ -98,7 +113,8 @@ private:
 private:
   Forwarder& m_forwarder;
   FaceId m_lastFaceId;
-  FaceMap m_faces;
+  FaceSlots m_faces;
+  size_t m_nFaces;
 };
 
 } // namespace nfd
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forwarder-stage-times.hpp"
+
+#include <chrono>
+
+namespace nfd {
+
+ScopedStageTimer* ScopedStageTimer::s_current = nullptr;
+
+namespace {
+
+// the wall clock is real time, unlike time::steady_clock, which follows the simulation
+struct Calibration
+{
+  Calibration()
+    : ticks(ForwarderStageTimes::readTicks())
+    , wallClock(std::chrono::steady_clock::now())
+  {
+  }
+
+  uint64_t ticks;
+  std::chrono::steady_clock::time_point wallClock;
+};
+
+const Calibration&
+getCalibration()
+{
+  static Calibration calibration;
+  return calibration;
+}
+
+} // namespace
+
+ForwarderStageTimes::ForwarderStageTimes()
+{
+  getCalibration();
+}
+
+const char*
+ForwarderStageTimes::getStageName(Stage stage)
+{
+  switch (stage) {
+  case STAGE_INCOMING_INTEREST:
+    return "IncomingInterest";
+  case STAGE_CS_LOOKUP:
+    return "ContentStoreLookup";
+  case STAGE_CS_MISS:
+    return "ContentStoreMiss";
+  case STAGE_CS_HIT:
+    return "ContentStoreHit";
+  case STAGE_STRATEGY_AFTER_RECEIVE_INTEREST:
+    return "StrategyAfterReceiveInterest";
+  case STAGE_OUTGOING_INTEREST:
+    return "OutgoingInterest";
+  case STAGE_INCOMING_DATA:
+    return "IncomingData";
+  case STAGE_PIT_MATCH:
+    return "PitMatch";
+  case STAGE_OUTGOING_DATA:
+    return "OutgoingData";
+  default:
+    return "Unknown";
+  }
+}
+
+void
+ForwarderStageTimes::merge(const ForwarderStageTimes& other)
+{
+  for (int stage = 0; stage < STAGE_MAX; ++stage) {
+    m_histograms[stage].Merge(other.m_histograms[stage]);
+  }
+}
+
+void
+ForwarderStageTimes::reset()
+{
+  for (int stage = 0; stage < STAGE_MAX; ++stage) {
+    m_histograms[stage].Reset();
+  }
+}
+
+double
+ForwarderStageTimes::getTicksPerNanosecond()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  const Calibration& calibration = getCalibration();
+  double nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - calibration.wallClock).count();
+  uint64_t ticks = readTicks() - calibration.ticks;
+  // too short to tell, e.g., in a unit test
+  if (nanoseconds < 1e6 || ticks == 0) {
+    return 1.0;
+  }
+  return ticks / nanoseconds;
+#else
+  return 1.0;
+#endif
+}
+
+void
+ForwarderStageTimes::print(std::ostream& os) const
+{
+  double ticksPerNanosecond = getTicksPerNanosecond();
+  double total = 0;
+  for (int stage = 0; stage < STAGE_MAX; ++stage) {
+    total += m_histograms[stage].GetMean() * m_histograms[stage].GetCount();
+  }
+
+  os << "Stage\tCount\tMean(ns)\tp50(ns)\tp99(ns)\tMax(ns)\tShare(%)\n";
+  for (int stage = 0; stage < STAGE_MAX; ++stage) {
+    const ns3::ndn::HdrHistogram& histogram = m_histograms[stage];
+    if (histogram.GetCount() == 0) {
+      continue;
+    }
+    double sum = histogram.GetMean() * histogram.GetCount();
+    os << getStageName(static_cast<Stage>(stage)) << "\t"
+       << histogram.GetCount() << "\t"
+       << histogram.GetMean() / ticksPerNanosecond << "\t"
+       << histogram.GetPercentile(50) / ticksPerNanosecond << "\t"
+       << histogram.GetPercentile(99) / ticksPerNanosecond << "\t"
+       << histogram.GetMax() / ticksPerNanosecond << "\t"
+       << (total > 0 ? sum * 100 / total : 0) << "\n";
+  }
+}
+
+} // namespace nfd
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FORWARDER_STAGE_TIMES_HPP
+#define NFD_DAEMON_FW_FORWARDER_STAGE_TIMES_HPP
+
+#include "common.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace nfd {
+
+/** \brief histograms of the wall-clock time spent in each forwarding pipeline stage
+ *
+ *  Stages are timed only when compiled with NFD_WITH_STAGE_TIMING defined, e.g.,
+ *  CXXFLAGS=-DNFD_WITH_STAGE_TIMING; otherwise NFD_STAGE_TIMER expands to nothing and the
+ *  histograms stay empty.
+ *
+ *  Every stage records its self time in TSC ticks (nanoseconds where there is no TSC): the
+ *  time spent in a nested stage, e.g., the strategy invoked by the ContentStore miss pipeline,
+ *  is counted in the nested stage only, so the stages add up to the forwarding time.
+ */
+class ForwarderStageTimes : noncopyable
+{
+public:
+  enum Stage {
+    STAGE_INCOMING_INTEREST,
+    STAGE_CS_LOOKUP,
+    STAGE_CS_MISS,
+    STAGE_CS_HIT,
+    STAGE_STRATEGY_AFTER_RECEIVE_INTEREST,
+    STAGE_OUTGOING_INTEREST,
+    STAGE_INCOMING_DATA,
+    STAGE_PIT_MATCH,
+    STAGE_OUTGOING_DATA,
+    STAGE_MAX
+  };
+
+  ForwarderStageTimes();
+
+  static const char*
+  getStageName(Stage stage);
+
+  void
+  record(Stage stage, uint64_t ticks)
+  {
+    m_histograms[stage].Record(ticks);
+  }
+
+  /** \return self times of the stage, in ticks
+   */
+  const ns3::ndn::HdrHistogram&
+  get(Stage stage) const
+  {
+    return m_histograms[stage];
+  }
+
+  /** \brief adds the times recorded in \p other, e.g., to sum up the forwarders of all nodes
+   */
+  void
+  merge(const ForwarderStageTimes& other);
+
+  void
+  reset();
+
+  static uint64_t
+  readTicks()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return time::duration_cast<time::nanoseconds>(
+             time::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  /** \return ticks per nanosecond, estimated against the wall clock since the first
+   *          ForwarderStageTimes was created
+   */
+  static double
+  getTicksPerNanosecond();
+
+  /** \brief prints count, mean, median, 99th percentile and maximum in nanoseconds, and the
+   *         share of the total time, of every stage that was timed
+   */
+  void
+  print(std::ostream& os) const;
+
+private:
+  ns3::ndn::HdrHistogram m_histograms[STAGE_MAX];
+};
+
+/** \brief records the self time of a stage from construction to destruction
+ */
+class ScopedStageTimer : noncopyable
+{
+public:
+  ScopedStageTimer(ForwarderStageTimes& times, ForwarderStageTimes::Stage stage)
+    : m_times(times)
+    , m_stage(stage)
+    , m_parent(s_current)
+    , m_nestedTicks(0)
+    , m_start(ForwarderStageTimes::readTicks())
+  {
+    s_current = this;
+  }
+
+  ~ScopedStageTimer()
+  {
+    uint64_t elapsed = ForwarderStageTimes::readTicks() - m_start;
+    m_times.record(m_stage, elapsed > m_nestedTicks ? elapsed - m_nestedTicks : 0);
+    if (m_parent != nullptr) {
+      m_parent->m_nestedTicks += elapsed;
+    }
+    s_current = m_parent;
+  }
+
+private:
+  ForwarderStageTimes& m_times;
+  ForwarderStageTimes::Stage m_stage;
+  ScopedStageTimer* m_parent;
+  uint64_t m_nestedTicks;
+  uint64_t m_start;
+
+  /// innermost running timer, of any forwarder, as pipelines of a node may run those of another
+  static ScopedStageTimer* s_current;
+};
+
+#define NFD_STAGE_TIMER_CONCAT(a, b) a##b
+#define NFD_STAGE_TIMER_VARIABLE(line) NFD_STAGE_TIMER_CONCAT(nfdStageTimer, line)
+
+/** \def NFD_STAGE_TIMER(times, stage)
+ *  \brief times the rest of the enclosing scope as \p stage, if NFD_WITH_STAGE_TIMING is defined
+ */
+#ifdef NFD_WITH_STAGE_TIMING
+#define NFD_STAGE_TIMER(times, stage) \
+  ::nfd::ScopedStageTimer NFD_STAGE_TIMER_VARIABLE(__LINE__)(times, \
+                                                             ::nfd::ForwarderStageTimes::stage)
+#else
+#define NFD_STAGE_TIMER(times, stage)
+#endif
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_FORWARDER_STAGE_TIMES_HPP
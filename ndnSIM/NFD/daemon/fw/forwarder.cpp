@@ -30,6 +30,9 @@
 #include "face/null-face.hpp"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "model/ndn-ns3.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
 
 #include <boost/random/uniform_int_distribution.hpp>
 
@@ -41,16 +44,22 @@ using fw::Strategy;
 
 const Name Forwarder::LOCALHOST_NAME("ndn:/localhost");
 
-Forwarder::Forwarder()
+Forwarder::Forwarder(double deadNonceListFalsePositiveRate)
   : m_faceTable(*this)
   , m_fib(m_nameTree)
   , m_pit(m_nameTree)
   , m_measurements(m_nameTree)
   , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
+  , m_deadNonceList(DeadNonceList::DEFAULT_LIFETIME, deadNonceListFalsePositiveRate)
+  , m_delegationCache(m_fib)
+  , m_pitTimers(bind(&Forwarder::onInterestUnsatisfied, this, _1),
+                bind(&Forwarder::onInterestFinalize, this, _1, _2, _3))
   , m_csFace(make_shared<NullFace>(FaceUri("contentstore://")))
+  , m_overheardDataLifetime(time::nanoseconds::zero())
   , m_nodeId(99999)  //?
 {
-  fw::installStrategies(*this);
+  // only the strategies in use are instantiated
+  m_strategyChoice.setStrategyFactory(bind(&fw::makeStrategy, ref(*this), _1));
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
   //----------------------------------------------------------------------------------------------
   m_strategyChoice.insert("/S", "ndn:/localhost/nfd/strategy/multicast");
@@ -64,6 +73,12 @@ Forwarder::~Forwarder()
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 {
+  NDN_CONFINED_SCOPE(m_confinement);
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_INCOMING_INTEREST);
+  NDN_PROFILE_ZONE("Forwarder::onIncomingInterest");
+  NDN_ALLOCATION_SCOPE(TABLES);
+  NDN_ALLOCATION_COUNT_PACKET();
+
 	/* receive Interest
 	cout<<"NDN:Node="<<m_nodeId
 			<<", onIncomingInterest face=" << inFace.getId()
@@ -111,6 +126,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   bool isPending = inRecords.begin() != inRecords.end();
   if (!isPending)
   {
+    NFD_STAGE_TIMER(m_stageTimes, STAGE_CS_LOOKUP);
     if (m_csFromNdnSim == nullptr) {
       m_cs.find(interest,
                 bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
@@ -136,6 +152,9 @@ Forwarder::onContentStoreMiss(const Face& inFace,
                               shared_ptr<pit::Entry> pitEntry,
                               const Interest& interest)
 {
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_CS_MISS);
+  NDN_PROFILE_ZONE("Forwarder::onContentStoreMiss");
+  NDN_ALLOCATION_SCOPE(TABLES);
 
 	/*
 	cout<<"NDN:onContentStoreMiss:Node="<<m_nodeId
@@ -144,26 +163,99 @@ Forwarder::onContentStoreMiss(const Face& inFace,
 	NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName());
 
 	//==============================================================================================================
+  const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
+  bool isPending = inRecords.begin() != inRecords.end();
+  if (isPending && pitEntry->getInRecord(inFace) == inRecords.end()) {
+    afterAggregateInterest(*pitEntry, inFace, interest);
+  }
+
   shared_ptr<Face> face = const_pointer_cast<Face>(inFace.shared_from_this());
   // insert InRecord
   pitEntry->insertOrUpdateInRecord(face, interest);
   // set PIT unsatisfy timer
   this->setUnsatisfyTimer(pitEntry);
 
+  // Interests arriving during the aggregation hold wait for its expiry
+  if (pitEntry->m_aggregationHoldTimer != nullptr) {
+    NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName() << " held");
+    return;
+  }
+
+  if (!isPending) {
+    const time::nanoseconds& hold =
+      m_strategyChoice.findEffectiveStrategy(*pitEntry).getAggregationHold();
+    if (hold > time::nanoseconds::zero()) {
+      pitEntry->m_aggregationHoldTimer = scheduler::schedule(hold,
+        bind(&Forwarder::onAggregationHoldExpiry, this, pitEntry));
+      return;
+    }
+  }
+
   // FIB lookup
-  shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch(*pitEntry);
+  shared_ptr<fib::Entry> fibEntry = this->lookupFib(*pitEntry);
 
   // dispatch to strategy
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_STRATEGY_AFTER_RECEIVE_INTEREST);
+  afterReceiveInterest(inFace, interest, fibEntry, pitEntry);
   this->dispatchToStrategy(pitEntry, bind(&Strategy::afterReceiveInterest, _1,
                                           cref(inFace), cref(interest), fibEntry, pitEntry));
 }
 
+shared_ptr<fib::Entry>
+Forwarder::lookupFib(const pit::Entry& pitEntry)
+{
+  shared_ptr<fib::Entry> fibEntry = m_fib.findLongestPrefixMatch(pitEntry);
+
+  const Interest& interest = pitEntry.getInterest();
+  if (!interest.hasLink() ||
+      (fibEntry->hasNextHops() && !fibEntry->getPrefix().empty())) {
+    return fibEntry;
+  }
+
+  if (interest.hasSelectedDelegation()) {
+    return m_fib.findLongestPrefixMatch(interest.getSelectedDelegation());
+  }
+
+  shared_ptr<fib::Entry> delegationEntry = m_delegationCache.findLongestPrefixMatch(interest);
+  return delegationEntry != nullptr ? delegationEntry : fibEntry;
+}
+
+void
+Forwarder::onAggregationHoldExpiry(shared_ptr<pit::Entry> pitEntry)
+{
+  NDN_CONFINED_SCOPE(m_confinement);
+  pitEntry->m_aggregationHoldTimer.reset();
+
+  const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
+  if (inRecords.begin() == inRecords.end()) {
+    return;
+  }
+  NFD_LOG_DEBUG("onAggregationHoldExpiry interest=" << pitEntry->getName() <<
+                " downstreams=" << inRecords.size());
+
+  // the strategy may delete in-records, keep the first Interest alive
+  shared_ptr<Face> inFace = inRecords.front().getFace();
+  shared_ptr<const Interest> interest = inRecords.front().getInterest().shared_from_this();
+
+  // FIB lookup
+  shared_ptr<fib::Entry> fibEntry = this->lookupFib(*pitEntry);
+
+  // dispatch to strategy
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_STRATEGY_AFTER_RECEIVE_INTEREST);
+  afterReceiveInterest(*inFace, *interest, fibEntry, pitEntry);
+  this->dispatchToStrategy(pitEntry, bind(&Strategy::afterReceiveInterest, _1,
+                                          cref(*inFace), cref(*interest), fibEntry, pitEntry));
+}
+
 void
 Forwarder::onContentStoreHit(const Face& inFace,
                              shared_ptr<pit::Entry> pitEntry,
                              const Interest& interest,
                              const Data& data)
 {
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_CS_HIT);
+  NDN_PROFILE_ZONE("Forwarder::onContentStoreHit");
+  NDN_ALLOCATION_SCOPE(TABLES);
   NFD_LOG_DEBUG("onContentStoreHit interest=" << interest.getName());
 
   beforeSatisfyInterest(*pitEntry, *m_csFace, data);
@@ -187,6 +279,9 @@ Forwarder::onInterestLoop(Face& inFace, const Interest& interest,
   NFD_LOG_DEBUG("onInterestLoop face=" << inFace.getId() <<
                 " interest=" << interest.getName());
 
+  this->dispatchToStrategy(pitEntry, bind(&Strategy::afterReceiveLoopedInterest, _1,
+                                          cref(inFace), cref(interest), pitEntry));
+
   // (drop)
 }
 
@@ -220,6 +315,9 @@ void
 Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
                               bool wantNewNonce)
 {
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_OUTGOING_INTEREST);
+  NDN_PROFILE_ZONE("Forwarder::onOutgoingInterest");
+  NDN_ALLOCATION_SCOPE(TABLES);
   if (outFace.getId() == INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingInterest face=invalid interest=" << pitEntry->getName());
     //cout<<"onOutgoingInterest face=invalid interest="<< pitEntry->getName()<<endl;
@@ -246,9 +344,8 @@ Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
     pickedInRecord->getInterest().shared_from_this());
 
   if (wantNewNonce) {
-    interest = make_shared<Interest>(*interest);
     static boost::random::uniform_int_distribution<uint32_t> dist;
-    interest->setNonce(dist(getGlobalRng()));
+    interest = interest->copyWithNonce(dist(getGlobalRng()));
   }
 
   // insert OutRecord
@@ -282,6 +379,7 @@ Forwarder::onInterestReject(shared_ptr<pit::Entry> pitEntry)
 void
 Forwarder::onInterestUnsatisfied(shared_ptr<pit::Entry> pitEntry)
 {
+  NDN_CONFINED_SCOPE(m_confinement);
   NFD_LOG_DEBUG("onInterestUnsatisfied interest=" << pitEntry->getName());
 
   // invoke PIT unsatisfied callback
@@ -305,12 +403,18 @@ Forwarder::onInterestFinalize(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 
   // PIT delete
   this->cancelUnsatisfyAndStragglerTimer(pitEntry);
+  scheduler::cancel(pitEntry->m_aggregationHoldTimer);
   m_pit.erase(pitEntry);
 }
 
 void
 Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
+  NDN_CONFINED_SCOPE(m_confinement);
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_INCOMING_DATA);
+  NDN_PROFILE_ZONE("Forwarder::onIncomingData");
+  NDN_ALLOCATION_SCOPE(TABLES);
+  NDN_ALLOCATION_COUNT_PACKET();
    /* receive Data
 	cout<<"NDN:Node="<<m_nodeId
 			<<", onIncomingData face=" << inFace.getId()
@@ -334,7 +438,11 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches;
+  {
+    NFD_STAGE_TIMER(m_stageTimes, STAGE_PIT_MATCH);
+    pitMatches = m_pit.findAllDataMatches(data);
+  }
   if (pitMatches.begin() == pitMatches.end()) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(inFace, data);
@@ -385,11 +493,15 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     // mark PIT satisfied
     pitEntry->deleteInRecords();
     pitEntry->deleteOutRecord(inFace);
+    scheduler::cancel(pitEntry->m_aggregationHoldTimer);
 
     // set PIT straggler timer
     this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
   }
 
+  // the packet is built once for all the downstreams
+  ns3::ndn::Convert::FanOut fanOut(data);
+
   // foreach pending downstream
   for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
       it != pendingDownstreams.end(); ++it)
@@ -412,8 +524,13 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 void
 Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 {
+  if (!inFace.isLocal() && m_overheardDataLifetime > time::nanoseconds::zero()) {
+    this->recordOverheardData(data.getName());
+  }
+
   // accept to cache?
-  bool acceptToCache = inFace.isLocal();
+  bool acceptToCache = inFace.isLocal() ||
+                       (m_overheardDataAdmission && m_overheardDataAdmission(inFace, data));
   if (acceptToCache) {
     // CS insert
     if (m_csFromNdnSim == nullptr)
@@ -427,9 +544,59 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
                 (acceptToCache ? " cached" : " not cached"));
 }
 
+void
+Forwarder::setOverheardDataAdmission(const OverheardDataAdmission& admission)
+{
+  m_overheardDataAdmission = admission;
+}
+
+void
+Forwarder::setOverheardDataLifetime(const time::nanoseconds& lifetime)
+{
+  m_overheardDataLifetime = lifetime;
+  if (lifetime <= time::nanoseconds::zero()) {
+    m_overheardData.clear();
+    m_overheardDataQueue.clear();
+  }
+}
+
+void
+Forwarder::recordOverheardData(const Name& name)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  // forget names whose last arrival is older than the lifetime
+  while (!m_overheardDataQueue.empty() &&
+         m_overheardDataQueue.front().first + m_overheardDataLifetime < now) {
+    auto it = m_overheardData.find(m_overheardDataQueue.front().second);
+    if (it != m_overheardData.end() && it->second == m_overheardDataQueue.front().first) {
+      m_overheardData.erase(it);
+    }
+    m_overheardDataQueue.pop_front();
+  }
+
+  m_overheardData[name] = now;
+  m_overheardDataQueue.emplace_back(now, name);
+}
+
+bool
+Forwarder::hasOverheardData(const Name& prefix) const
+{
+  time::steady_clock::TimePoint oldest = time::steady_clock::now() - m_overheardDataLifetime;
+  for (auto it = m_overheardData.lower_bound(prefix);
+       it != m_overheardData.end() && prefix.isPrefixOf(it->first); ++it) {
+    if (it->second >= oldest)
+      return true;
+  }
+  return false;
+}
+
 void
 Forwarder::onOutgoingData(const Data& data, Face& outFace)
 {
+  NFD_STAGE_TIMER(m_stageTimes, STAGE_OUTGOING_DATA);
+  NDN_PROFILE_ZONE("Forwarder::onOutgoingData");
+  NDN_ALLOCATION_SCOPE(TABLES);
   if (outFace.getId() == INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingData face=invalid data=" << data.getName());
     return;
@@ -453,6 +620,89 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
   ++m_counters.getNOutDatas();
 }
 
+void
+Forwarder::onIncomingNack(Face& inFace, const lp::Nack& nack)
+{
+  NDN_CONFINED_SCOPE(m_confinement);
+  ++m_counters.getNInNacks();
+
+  // multi-access face: a Nack cannot tell which of the downstreams it is for
+  if (inFace.isMultiAccess()) {
+    NFD_LOG_DEBUG("onIncomingNack face=" << inFace.getId() <<
+                  " nack=" << nack.getInterest().getName() <<
+                  "~" << nack.getReason() << " face-is-multi-access");
+    return;
+  }
+
+  // PIT match
+  shared_ptr<pit::Entry> pitEntry = m_pit.find(nack.getInterest());
+  if (pitEntry == nullptr) {
+    NFD_LOG_DEBUG("onIncomingNack face=" << inFace.getId() <<
+                  " nack=" << nack.getInterest().getName() <<
+                  "~" << nack.getReason() << " no-PIT-entry");
+    return;
+  }
+
+  // has OutRecord with the same Nonce?
+  pit::OutRecordCollection::iterator outRecord = pitEntry->getOutRecord(inFace);
+  if (outRecord == pitEntry->getOutRecords().end() || !outRecord->setIncomingNack(nack)) {
+    NFD_LOG_DEBUG("onIncomingNack face=" << inFace.getId() <<
+                  " nack=" << nack.getInterest().getName() <<
+                  "~" << nack.getReason() << " no-matching-out-record");
+    return;
+  }
+
+  NFD_LOG_DEBUG("onIncomingNack face=" << inFace.getId() <<
+                " nack=" << nack.getInterest().getName() << "~" << nack.getReason());
+
+  // trigger strategy: after receive Nack
+  shared_ptr<fib::Entry> fibEntry = this->lookupFib(*pitEntry);
+  this->dispatchToStrategy(pitEntry, bind(&Strategy::afterReceiveNack, _1,
+                                          cref(inFace), cref(nack), fibEntry, pitEntry));
+}
+
+void
+Forwarder::onOutgoingNack(shared_ptr<pit::Entry> pitEntry, const Face& outFace,
+                          const lp::NackHeader& nack)
+{
+  if (outFace.getId() == INVALID_FACEID) {
+    NFD_LOG_WARN("onOutgoingNack face=invalid nack=" << pitEntry->getName() <<
+                 "~" << nack.getReason());
+    return;
+  }
+
+  // has InRecord?
+  pit::InRecordCollection::const_iterator inRecord = pitEntry->getInRecord(outFace);
+  if (inRecord == pitEntry->getInRecords().end()) {
+    NFD_LOG_DEBUG("onOutgoingNack face=" << outFace.getId() <<
+                  " nack=" << pitEntry->getName() << "~" << nack.getReason() <<
+                  " no-in-record");
+    return;
+  }
+
+  // multi-access face: the Nack would reach the other downstreams too
+  if (outFace.isMultiAccess()) {
+    NFD_LOG_DEBUG("onOutgoingNack face=" << outFace.getId() <<
+                  " nack=" << pitEntry->getName() << "~" << nack.getReason() <<
+                  " face-is-multi-access");
+    return;
+  }
+
+  NFD_LOG_DEBUG("onOutgoingNack face=" << outFace.getId() <<
+                " nack=" << pitEntry->getName() << "~" << nack.getReason());
+
+  // create Nack packet with the Interest from InRecord
+  lp::Nack nackPkt(inRecord->getInterest());
+  nackPkt.setHeader(nack);
+
+  // erase InRecord
+  pitEntry->deleteInRecord(outFace);
+
+  // send Nack on face
+  const_cast<Face&>(outFace).sendNack(nackPkt);
+  ++m_counters.getNOutNacks();
+}
+
 static inline bool
 compare_InRecord_expiry(const pit::InRecord& a, const pit::InRecord& b)
 {
@@ -468,14 +718,11 @@ Forwarder::setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry)
     &compare_InRecord_expiry);
 
   time::steady_clock::TimePoint lastExpiry = lastExpiring->getExpiry();
-  time::nanoseconds lastExpiryFromNow = lastExpiry  - time::steady_clock::now();
-  if (lastExpiryFromNow <= time::seconds(0)) {
+  if (lastExpiry <= time::steady_clock::now()) {
     // TODO all InRecords are already expired; will this happen?
   }
 
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
-    bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
+  m_pitTimers.setUnsatisfyTimer(pitEntry, lastExpiry);
 }
 
 void
@@ -484,16 +731,13 @@ Forwarder::setStragglerTimer(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 {
   time::nanoseconds stragglerTime = time::milliseconds(100);
 
-  scheduler::cancel(pitEntry->m_stragglerTimer);
-  pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
-    bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
+  m_pitTimers.setStragglerTimer(pitEntry, stragglerTime, isSatisfied, dataFreshnessPeriod);
 }
 
 void
 Forwarder::cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry)
 {
-  scheduler::cancel(pitEntry->m_unsatisfyTimer);
-  scheduler::cancel(pitEntry->m_stragglerTimer);
+  m_pitTimers.cancel(*pitEntry);
 }
 
 static inline void
@@ -29,15 +29,21 @@
 #include "common.hpp"
 #include "core/scheduler.hpp"
 #include "forwarder-counters.hpp"
+#include "forwarder-stage-times.hpp"
+#include "delegation-cache.hpp"
 #include "face-table.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
+#include "table/pit-timer-wheel.hpp"
 #include "table/cs.hpp"
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
 #include "table/dead-nonce-list.hpp"
 
+#include <deque>
+
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/ndn-thread-confinement.hpp"
 
 
 namespace nfd {
@@ -55,7 +61,11 @@ class NullFace;
 class Forwarder
 {
 public:
-  Forwarder();
+  /** \param deadNonceListFalsePositiveRate if zero, Dead Nonce List keeps entries exactly;
+   *         otherwise, it keeps them in a DeadNonceFilter with this false positive rate
+   */
+  explicit
+  Forwarder(double deadNonceListFalsePositiveRate = 0.0);
 
   VIRTUAL_WITH_TESTS
   ~Forwarder();
@@ -63,6 +73,12 @@ public:
   const ForwarderCounters&
   getCounters() const;
 
+  /** \brief wall-clock time spent in the pipeline stages
+   *  \note empty unless compiled with NFD_WITH_STAGE_TIMING, see ForwarderStageTimes
+   */
+  ForwarderStageTimes&
+  getStageTimes();
+
 public: // faces
   FaceTable&
   getFaceTable();
@@ -88,6 +104,9 @@ public: // forwarding entrypoints and tables
   void
   onData(Face& face, const Data& data);
 
+  void
+  onNack(Face& face, const lp::Nack& nack);
+
   NameTree&
   getNameTree();
 
@@ -109,6 +128,9 @@ public: // forwarding entrypoints and tables
   DeadNonceList&
   getDeadNonceList();
 
+  const fw::DelegationCache&
+  getDelegationCache() const;
+
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
@@ -117,7 +139,44 @@ public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   SetNodeId(uint32_t id);
 
+public: // overheard Data
+  /** \brief decides whether unsolicited Data from a non-local face is inserted into the CS
+   */
+  typedef function<bool(const Face& inFace, const Data& data)> OverheardDataAdmission;
+
+  /** \brief set the CS admission filter of unsolicited Data from non-local faces
+   *
+   *  Such Data are, e.g., broadcasts overheard on a shared wireless face (see
+   *  ns3::ndn::NetDeviceFace::setOverhearing).  Without a filter (the default) they are not
+   *  cached.
+   */
+  void
+  setOverheardDataAdmission(const OverheardDataAdmission& admission);
+
+  /** \brief set how long the names of unsolicited Data from non-local faces are remembered
+   *
+   *  Zero (the default) disables the record.
+   */
+  void
+  setOverheardDataLifetime(const time::nanoseconds& lifetime);
+
+  const time::nanoseconds&
+  getOverheardDataLifetime() const;
+
+  /** \return whether unsolicited Data under \p prefix were received from a non-local face
+   *          within the lifetime
+   *  \sa fw::Strategy::hasOverheardData
+   */
+  bool
+  hasOverheardData(const Name& prefix) const;
+
 public:
+  /** \brief trigger before Interest is dispatched to the strategy
+   *  \sa Strategy::afterReceiveInterest
+   */
+  signal::Signal<Forwarder, Face, Interest, shared_ptr<fib::Entry>, shared_ptr<pit::Entry>>
+    afterReceiveInterest;
+
   /** \brief trigger before PIT entry is satisfied
    *  \sa Strategy::beforeSatisfyInterest
    */
@@ -128,6 +187,10 @@ public:
    */
   signal::Signal<Forwarder, pit::Entry> beforeExpirePendingInterest;
 
+  /** \brief trigger when an Interest from a new downstream is aggregated into a pending PIT entry
+   */
+  signal::Signal<Forwarder, pit::Entry, Face, Interest> afterAggregateInterest;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   /** \brief incoming Interest pipeline
    */
@@ -139,6 +202,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   void
   onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry> pitEntry, const Interest& interest);
 
+  /** \brief aggregation hold expiry pipeline
+   *
+   *  Dispatches the first remaining Interest of the PIT entry to the strategy.
+   */
+  void
+  onAggregationHoldExpiry(shared_ptr<pit::Entry> pitEntry);
+
   /** \brief Content Store hit pipeline
   */
   void
@@ -190,6 +260,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onOutgoingData(const Data& data, Face& outFace);
 
+  /** \brief incoming Nack pipeline
+   */
+  VIRTUAL_WITH_TESTS void
+  onIncomingNack(Face& inFace, const lp::Nack& nack);
+
+  /** \brief outgoing Nack pipeline
+   *
+   *  Sends a Nack with the Interest of the InRecord of \p outFace, and deletes the InRecord.
+   */
+  VIRTUAL_WITH_TESTS void
+  onOutgoingNack(shared_ptr<pit::Entry> pitEntry, const Face& outFace,
+                 const lp::NackHeader& nack);
+
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry);
@@ -201,6 +284,11 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief remember that Data with \p name was overheard, forget expired names
+   */
+  void
+  recordOverheardData(const Name& name);
+
   /** \brief insert Nonce to Dead Nonce List if necessary
    *  \param upstream if null, insert Nonces from all OutRecords;
    *                  if not null, insert Nonce only on the OutRecord of this face
@@ -210,6 +298,15 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
                       const time::milliseconds& dataFreshnessPeriod,
                       Face* upstream);
 
+  /** \brief FIB lookup for an Interest
+   *
+   *  An Interest with a Link is forwarded by the Interest name if the name has a route other
+   *  than the default route, e.g., in the region of the producer; otherwise by its selected
+   *  delegation, or by the most preferred delegation with a route (see fw::DelegationCache).
+   */
+  shared_ptr<fib::Entry>
+  lookupFib(const pit::Entry& pitEntry);
+
   /// call trigger (method) on the effective strategy of pitEntry
 #ifdef WITH_TESTS
   virtual void
@@ -222,6 +319,9 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   ForwarderCounters m_counters;
+  ForwarderStageTimes m_stageTimes;
+  /// the forwarder is only used by the logical process of its node
+  ns3::ndn::ThreadConfinement m_confinement;
 
   FaceTable m_faceTable;
 
@@ -233,10 +333,17 @@ private:
   Measurements   m_measurements;
   StrategyChoice m_strategyChoice;
   DeadNonceList  m_deadNonceList;
+  fw::DelegationCache m_delegationCache;
+  pit::TimerWheel m_pitTimers;
   shared_ptr<NullFace> m_csFace;
 
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
 
+  OverheardDataAdmission m_overheardDataAdmission;
+  time::nanoseconds m_overheardDataLifetime;
+  std::map<Name, time::steady_clock::TimePoint> m_overheardData; ///< last arrival by name
+  std::deque<std::pair<time::steady_clock::TimePoint, Name>> m_overheardDataQueue; ///< by arrival
+
   static const Name LOCALHOST_NAME;
 
   // allow Strategy (base class) to enter pipelines
@@ -246,12 +353,24 @@ private:
   uint32_t m_nodeId;
 };
 
+inline const time::nanoseconds&
+Forwarder::getOverheardDataLifetime() const
+{
+  return m_overheardDataLifetime;
+}
+
 inline const ForwarderCounters&
 Forwarder::getCounters() const
 {
   return m_counters;
 }
 
+inline ForwarderStageTimes&
+Forwarder::getStageTimes()
+{
+  return m_stageTimes;
+}
+
 inline FaceTable&
 Forwarder::getFaceTable()
 {
@@ -282,6 +401,12 @@ Forwarder::onData(Face& face, const Data& data)
   this->onIncomingData(face, data);
 }
 
+inline void
+Forwarder::onNack(Face& face, const lp::Nack& nack)
+{
+  this->onIncomingNack(face, nack);
+}
+
 inline NameTree&
 Forwarder::getNameTree()
 {
@@ -324,6 +449,12 @@ Forwarder::getDeadNonceList()
   return m_deadNonceList;
 }
 
+inline const fw::DelegationCache&
+Forwarder::getDelegationCache() const
+{
+  return m_delegationCache;
+}
+
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
 {
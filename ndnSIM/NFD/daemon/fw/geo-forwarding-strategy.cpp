@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "geo-forwarding-strategy.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-geo-position-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-geo-region-table.hpp"
+
+namespace nfd {
+namespace fw {
+
+const Name GeoForwardingStrategy::STRATEGY_NAME("ndn:/localhost/nfd/strategy/geo-forwarding/%FD%01");
+NFD_REGISTER_STRATEGY(GeoForwardingStrategy);
+
+const double GeoForwardingStrategy::MIN_PROGRESS = 1.0;
+
+GeoForwardingStrategy::GeoForwardingStrategy(Forwarder& forwarder, const Name& name)
+  : Strategy(forwarder, name)
+  , m_nSuppressed(0)
+{
+}
+
+bool
+GeoForwardingStrategy::makesProgress(const Interest& interest) const
+{
+  const ns3::ndn::GeoRegionTable::Region* region =
+    ns3::ndn::GeoRegionTable::Find(interest.getName());
+  ns3::Vector position;
+  if (region == nullptr || !ns3::ndn::GeoPositionTag::GetCurrentNodePosition(position))
+    return true;
+
+  double distance = ns3::CalculateDistance(position, region->center);
+  if (distance <= region->radius)
+    return true;
+
+  ns3::Vector previousHop;
+  if (!ns3::ndn::GeoPositionTag::GetPreviousHopPosition(interest, previousHop))
+    return true;
+
+  return distance + MIN_PROGRESS <= ns3::CalculateDistance(previousHop, region->center);
+}
+
+void
+GeoForwardingStrategy::afterReceiveInterest(const Face& inFace,
+                                            const Interest& interest,
+                                            shared_ptr<fib::Entry> fibEntry,
+                                            shared_ptr<pit::Entry> pitEntry)
+{
+  bool isForwarding = inFace.isLocal() || makesProgress(interest);
+  bool isSuppressed = false;
+
+  const fib::NextHopList& nexthops = fibEntry->getNextHops();
+  for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it) {
+    shared_ptr<Face> outFace = it->getFace();
+    if (!pitEntry->canForwardTo(*outFace))
+      continue;
+
+    if (isForwarding || outFace->isLocal())
+      this->sendInterest(pitEntry, outFace);
+    else
+      isSuppressed = true;
+  }
+
+  if (isSuppressed)
+    ++m_nSuppressed;
+
+  if (!pitEntry->hasUnexpiredOutRecords()) {
+    this->rejectPendingInterest(pitEntry);
+  }
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_GEO_FORWARDING_STRATEGY_HPP
+#define NFD_DAEMON_FW_GEO_FORWARDING_STRATEGY_HPP
+
+#include "strategy.hpp"
+
+namespace nfd {
+namespace fw {
+
+/** \brief a forwarding strategy for vehicular networks that forwards an Interest only if
+ *         the node is closer to the spatial region of the Interest than the previous hop
+ *
+ *  The region is the area registered in ns3::ndn::GeoRegionTable for the spatial segment
+ *  (/S/...) of the Interest name.  The position of the node comes from its ns-3 MobilityModel,
+ *  the position of the previous hop from the ns3::ndn::GeoPositionTag that NetDeviceFace
+ *  attaches to every frame.  Over a broadcast face, only the receivers that make geographic
+ *  progress rebroadcast the Interest, instead of every receiver as with MulticastStrategy.
+ *
+ *  Interests are forwarded to all FIB nexthops, like MulticastStrategy, if
+ *  - they come from a local face (this node is the consumer),
+ *  - the node is inside the region,
+ *  - there is no geographic information: the name has no registered region, the node has
+ *    no MobilityModel or the previous hop position is unknown.
+ *  Local faces (e.g., producers on this node) always receive the Interest.
+ */
+class GeoForwardingStrategy : public Strategy
+{
+public:
+  GeoForwardingStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual void
+  afterReceiveInterest(const Face& inFace,
+                       const Interest& interest,
+                       shared_ptr<fib::Entry> fibEntry,
+                       shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  /** \return number of Interests not forwarded to non-local faces for lack of progress
+   */
+  uint64_t
+  getNSuppressed() const
+  {
+    return m_nSuppressed;
+  }
+
+public:
+  static const Name STRATEGY_NAME;
+
+  /** \brief minimum distance in meters by which the node must be closer to the region
+   *         than the previous hop
+   */
+  static const double MIN_PROGRESS;
+
+private:
+  bool
+  makesProgress(const Interest& interest) const;
+
+private:
+  uint64_t m_nSuppressed;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_GEO_FORWARDING_STRATEGY_HPP
@@ -33,6 +33,7 @@ NFD_REGISTER_STRATEGY(MulticastStrategy);
 
 MulticastStrategy::MulticastStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder, name)
+  , m_retxSuppression(this->getMeasurements())
 {
 }
 
@@ -43,13 +44,18 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
                    shared_ptr<pit::Entry> pitEntry)
 {
   //=============================================================
+  bool isRetransmission = m_retxSuppression.decide(inFace, interest, *pitEntry) !=
+                          RetxSuppression::NEW;
+
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
   //cout<<"Multicast!";
   for (fib::NextHopList::const_iterator it = nexthops.begin(); it != nexthops.end(); ++it)
   {
     shared_ptr<Face> outFace = it->getFace();
 
-    if (pitEntry->canForwardTo(*outFace))
+    if (pitEntry->canForwardTo(*outFace) &&
+        (!isRetransmission ||
+         m_retxSuppression.decidePerUpstream(*pitEntry, *outFace) == RetxSuppression::FORWARD))
     {
       //cout<<"Forwarding Interest !"<<endl;
       this->sendInterest(pitEntry, outFace);
@@ -58,9 +64,29 @@ MulticastStrategy::afterReceiveInterest(const Face& inFace,
 
   if (!pitEntry->hasUnexpiredOutRecords())
   {
+    if (pitEntry->getOutRecords().empty()) {
+      lp::NackHeader nackHeader;
+      nackHeader.setReason(lp::NackReason::NO_ROUTE);
+      this->sendNack(pitEntry, inFace, nackHeader);
+    }
     this->rejectPendingInterest(pitEntry);
   }
 }
 
+void
+MulticastStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                                         const Face& inFace, const Data& data)
+{
+  m_retxSuppression.afterReceiveData(*pitEntry, inFace);
+}
+
+void
+MulticastStrategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                                    shared_ptr<fib::Entry> fibEntry,
+                                    shared_ptr<pit::Entry> pitEntry)
+{
+  this->sendNacksIfAllUpstreamsNacked(pitEntry);
+}
+
 } // namespace fw
 } // namespace nfd
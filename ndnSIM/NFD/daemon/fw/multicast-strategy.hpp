@@ -27,11 +27,18 @@
 #define NFD_DAEMON_FW_MULTICAST_STRATEGY_HPP
 
 #include "strategy.hpp"
+#include "retx-suppression-adaptive.hpp"
 
 namespace nfd {
 namespace fw {
 
 /** \brief a forwarding strategy that forwards Interest to all FIB nexthops
+ *
+ *  A retransmission is forwarded only to the nexthops that RetxSuppressionAdaptive
+ *  allows, i.e., nexthops not tried yet and nexthops whose last transmission is overdue.
+ *
+ *  A new Interest without any usable nexthop is answered with a Nack~NoRoute.
+ *  When every upstream has returned a Nack, Nacks are sent to all downstreams.
  */
 class MulticastStrategy : public Strategy
 {
@@ -44,8 +51,20 @@ public:
                        shared_ptr<fib::Entry> fibEntry,
                        shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
 
+  virtual void
+  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                        const Face& inFace, const Data& data) DECL_OVERRIDE;
+
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   shared_ptr<fib::Entry> fibEntry,
+                   shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
 public:
   static const Name STRATEGY_NAME;
+
+private:
+  RetxSuppressionAdaptive m_retxSuppression;
 };
 
 } // namespace fw
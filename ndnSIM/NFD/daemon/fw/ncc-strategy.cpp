@@ -73,6 +73,9 @@ NccStrategy::afterReceiveInterest(const Face& inFace,
   size_t nUpstreams = nexthops.size();
 
   shared_ptr<Face> bestFace = measurementsEntryInfo->getBestFace();
+  if (!static_cast<bool>(bestFace)) {
+    bestFace = this->seedMeasurementsEntryInfo(interest.getName(), *measurementsEntryInfo);
+  }
   if (static_cast<bool>(bestFace) && fibEntry->hasNextHop(bestFace) &&
       pitEntry->canForwardTo(*bestFace)) {
     // TODO Should we use `randlow = 100 + nrand48(h->seed) % 4096U;` ?
@@ -197,6 +200,13 @@ NccStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
     return;
   }
 
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
+  if (outRecord != pitEntry->getOutRecords().end() && data.getName().size() >= 1) {
+    time::steady_clock::Duration rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+    m_rttPrior.addMeasurement(data.getName().getPrefix(-1), inFace.getId(),
+                              time::duration_cast<RttEstimator::Duration>(rtt));
+  }
+
   shared_ptr<measurements::Entry> measurementsEntry = this->getMeasurements().get(*pitEntry);
 
   for (int i = 0; i < UPDATE_MEASUREMENTS_N_LEVELS; ++i) {
@@ -247,6 +257,25 @@ NccStrategy::getMeasurementsEntryInfo(shared_ptr<measurements::Entry> entry)
   return info;
 }
 
+shared_ptr<Face>
+NccStrategy::seedMeasurementsEntryInfo(const Name& name, MeasurementsEntryInfo& info)
+{
+  RttPriorTable::Estimate estimate;
+  if (!m_rttPrior.estimate(name, estimate)) {
+    return nullptr;
+  }
+
+  shared_ptr<Face> face = this->getFace(estimate.face);
+  if (!static_cast<bool>(face)) {
+    return nullptr;
+  }
+
+  info.bestFace = face;
+  info.prediction = std::max(MeasurementsEntryInfo::MIN_PREDICTION,
+                             std::min(MeasurementsEntryInfo::MAX_PREDICTION,
+                                      time::duration_cast<time::microseconds>(estimate.rtt)));
+  return face;
+}
 
 const time::microseconds NccStrategy::MeasurementsEntryInfo::INITIAL_PREDICTION =
                                                              time::microseconds(8192);
@@ -27,11 +27,15 @@
 #define NFD_DAEMON_FW_NCC_STRATEGY_HPP
 
 #include "strategy.hpp"
+#include "rtt-prior-table.hpp"
 
 namespace nfd {
 namespace fw {
 
 /** \brief a forwarding strategy similar to CCNx 0.7.2
+ *
+ *  When a Name has no best face, the best face and the prediction are initialized from
+ *  prefixes with correlated structured Names (see RttPriorTable), if any.
  */
 class NccStrategy : public Strategy
 {
@@ -124,6 +128,12 @@ protected:
   shared_ptr<MeasurementsEntryInfo>
   getMeasurementsEntryInfo(shared_ptr<pit::Entry> entry);
 
+  /** \brief initialize best face and prediction from prefixes correlated with \p name
+   *  \return the best face, or nullptr if no prefix is correlated or its face is gone
+   */
+  shared_ptr<Face>
+  seedMeasurementsEntryInfo(const Name& name, MeasurementsEntryInfo& info);
+
   /// propagate to another upstream
   void
   doPropagate(weak_ptr<pit::Entry> pitEntryWeak, weak_ptr<fib::Entry> fibEntryWeak);
@@ -140,6 +150,9 @@ protected:
   static const time::microseconds DEFER_RANGE_WITHOUT_BEST_FACE;
   static const int UPDATE_MEASUREMENTS_N_LEVELS = 2;
   static const time::nanoseconds MEASUREMENTS_LIFETIME;
+
+private:
+  RttPriorTable m_rttPrior;
 };
 
 } // namespace fw
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "retx-suppression-adaptive.hpp"
+
+namespace nfd {
+namespace fw {
+
+const RetxSuppressionAdaptive::Duration RetxSuppressionAdaptive::DEFAULT_MIN_INTERVAL =
+    time::milliseconds(10);
+const RetxSuppressionAdaptive::Duration RetxSuppressionAdaptive::DEFAULT_MAX_INTERVAL =
+    time::milliseconds(1000);
+const double RetxSuppressionAdaptive::MIN_SATISFACTION = 0.05;
+const double RetxSuppressionAdaptive::SATISFACTION_GAIN = 0.25;
+
+class RetxSuppressionAdaptive::MtInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1021;
+  }
+
+  class FaceInfo
+  {
+  public:
+    FaceInfo()
+      : rtt(1, time::milliseconds(1), 0.1)
+      , nAnswers(0)
+      , satisfaction(1.0)
+    {
+    }
+
+  public:
+    RttEstimator rtt;
+    uint32_t nAnswers;
+    /** \brief exponentially weighted ratio of answered transmissions, starts optimistic
+     */
+    double satisfaction;
+  };
+
+public:
+  std::unordered_map<FaceId, FaceInfo> faces;
+};
+
+RetxSuppressionAdaptive::RetxSuppressionAdaptive(MeasurementsAccessor& measurements,
+                                                 const Duration& minInterval,
+                                                 const Duration& maxInterval)
+  : m_measurements(measurements)
+  , m_minInterval(minInterval)
+  , m_maxInterval(maxInterval)
+{
+  BOOST_ASSERT(minInterval > time::milliseconds::zero());
+  BOOST_ASSERT(maxInterval >= minInterval);
+}
+
+RetxSuppression::Result
+RetxSuppressionAdaptive::decide(const Face& inFace, const Interest& interest,
+                                pit::Entry& pitEntry) const
+{
+  bool isNewPitEntry = !pitEntry.hasUnexpiredOutRecords();
+  return isNewPitEntry ? NEW : FORWARD;
+}
+
+shared_ptr<RetxSuppressionAdaptive::MtInfo>
+RetxSuppressionAdaptive::getMtInfo(const pit::Entry& pitEntry)
+{
+  static const time::nanoseconds ME_LIFETIME = time::seconds(16);
+
+  shared_ptr<measurements::Entry> me;
+  if (pitEntry.getName().size() >= 1) {
+    me = m_measurements.get(pitEntry.getName().getPrefix(-1));
+  }
+  if (me == nullptr) {
+    me = m_measurements.get(pitEntry);
+  }
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  m_measurements.extendLifetime(*me, ME_LIFETIME);
+  return me->getOrCreateStrategyInfo<MtInfo>();
+}
+
+RetxSuppressionAdaptive::Duration
+RetxSuppressionAdaptive::getInterval(const pit::Entry& pitEntry, const Face& outFace)
+{
+  shared_ptr<MtInfo> mi = this->getMtInfo(pitEntry);
+  if (mi == nullptr) {
+    return m_minInterval;
+  }
+
+  const MtInfo::FaceInfo& fi = mi->faces[outFace.getId()];
+  double rto = fi.nAnswers > 0 ? static_cast<double>(fi.rtt.computeRto().count()) :
+                                 static_cast<double>(m_minInterval.count());
+  double interval = rto / std::max(fi.satisfaction, MIN_SATISFACTION);
+  interval = std::max(interval, static_cast<double>(m_minInterval.count()));
+  interval = std::min(interval, static_cast<double>(m_maxInterval.count()));
+  return Duration(static_cast<Duration::rep>(interval));
+}
+
+RetxSuppression::Result
+RetxSuppressionAdaptive::decidePerUpstream(pit::Entry& pitEntry, const Face& outFace)
+{
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry.getOutRecord(outFace);
+  if (outRecord == pitEntry.getOutRecords().end()) {
+    // not tried for this PIT entry
+    return FORWARD;
+  }
+
+  time::steady_clock::Duration sinceLastOutgoing = time::steady_clock::now() -
+                                                   outRecord->getLastRenewed();
+  if (sinceLastOutgoing < this->getInterval(pitEntry, outFace)) {
+    return SUPPRESS;
+  }
+
+  // the last transmission was not answered in time
+  shared_ptr<MtInfo> mi = this->getMtInfo(pitEntry);
+  if (mi != nullptr) {
+    MtInfo::FaceInfo& fi = mi->faces[outFace.getId()];
+    fi.satisfaction -= fi.satisfaction * SATISFACTION_GAIN;
+  }
+  return FORWARD;
+}
+
+void
+RetxSuppressionAdaptive::afterReceiveData(const pit::Entry& pitEntry, const Face& inFace)
+{
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry.getOutRecord(inFace);
+  if (outRecord == pitEntry.getOutRecords().end()) {
+    return;
+  }
+
+  shared_ptr<MtInfo> mi = this->getMtInfo(pitEntry);
+  if (mi == nullptr) {
+    return;
+  }
+
+  time::steady_clock::Duration rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  MtInfo::FaceInfo& fi = mi->faces[inFace.getId()];
+  fi.rtt.addMeasurement(time::duration_cast<RttEstimator::Duration>(rtt));
+  ++fi.nAnswers;
+  fi.satisfaction += (1.0 - fi.satisfaction) * SATISFACTION_GAIN;
+}
+
+} // namespace fw
+} // namespace nfd
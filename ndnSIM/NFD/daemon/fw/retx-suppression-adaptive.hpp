@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_RETX_SUPPRESSION_ADAPTIVE_HPP
+#define NFD_DAEMON_FW_RETX_SUPPRESSION_ADAPTIVE_HPP
+
+#include "retx-suppression.hpp"
+#include "rtt-estimator.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief a retransmission suppression decision algorithm that
+ *         decides per upstream, from the RTT and satisfaction history of the upstream
+ *
+ *  For each prefix (parent of Interest Name) the Measurements entry keeps the RTT and an
+ *  exponentially weighted satisfaction ratio of every upstream.  A retransmission is
+ *  forwarded to an upstream if the upstream has not been tried for the PIT entry, or if
+ *  the last transmission to it occurred more than
+ *  MIN(MAX(RTO / MAX(satisfaction, MIN_SATISFACTION), minInterval), maxInterval) ago,
+ *  where RTO is minInterval if the upstream never answered.  Such a retransmission counts
+ *  as a miss of the upstream, an answer counts as a hit (see afterReceiveData).
+ *
+ *  So an upstream that answers reliably gets retransmissions soon after its RTO, and an
+ *  upstream that rarely answers gets them less often.
+ */
+class RetxSuppressionAdaptive : public RetxSuppression
+{
+public:
+  /** \brief time granularity
+   */
+  typedef time::microseconds Duration;
+
+  explicit
+  RetxSuppressionAdaptive(MeasurementsAccessor& measurements,
+                          const Duration& minInterval = DEFAULT_MIN_INTERVAL,
+                          const Duration& maxInterval = DEFAULT_MAX_INTERVAL);
+
+  /** \brief determines whether Interest is a retransmission
+   *  \return NEW or FORWARD; the decision for a retransmission is made by decidePerUpstream
+   */
+  virtual Result
+  decide(const Face& inFace, const Interest& interest,
+         pit::Entry& pitEntry) const DECL_OVERRIDE;
+
+  /** \brief determines whether a retransmission shall be forwarded to \p outFace
+   *  \return FORWARD or SUPPRESS
+   */
+  Result
+  decidePerUpstream(pit::Entry& pitEntry, const Face& outFace);
+
+  /** \brief record an answer of \p inFace
+   *
+   *  Should be called from Strategy::beforeSatisfyInterest.
+   */
+  void
+  afterReceiveData(const pit::Entry& pitEntry, const Face& inFace);
+
+  /** \return current suppression interval of \p outFace for the prefix of \p pitEntry
+   */
+  Duration
+  getInterval(const pit::Entry& pitEntry, const Face& outFace);
+
+public:
+  /** \brief StrategyInfo on measurements::Entry
+   */
+  class MtInfo;
+
+public:
+  static const Duration DEFAULT_MIN_INTERVAL;
+  static const Duration DEFAULT_MAX_INTERVAL;
+  static const double MIN_SATISFACTION;
+  static const double SATISFACTION_GAIN;
+
+private:
+  shared_ptr<MtInfo>
+  getMtInfo(const pit::Entry& pitEntry);
+
+private:
+  MeasurementsAccessor& m_measurements;
+  const Duration m_minInterval;
+  const Duration m_maxInterval;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_RETX_SUPPRESSION_ADAPTIVE_HPP
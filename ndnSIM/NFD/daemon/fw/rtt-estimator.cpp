@@ -56,6 +56,16 @@ RttEstimator::addMeasurement(Duration measure)
   m_multiplier = 1;
 }
 
+void
+RttEstimator::setPrior(Duration rtt, Duration deviation)
+{
+  if (m_nSamples > 0)
+    return;
+
+  m_rtt = static_cast<double>(rtt.count());
+  m_variance = static_cast<double>(deviation.count());
+}
+
 void
 RttEstimator::incrementMultiplier()
 {
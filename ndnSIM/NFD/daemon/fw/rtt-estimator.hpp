@@ -58,6 +58,14 @@ public:
   void
   addMeasurement(Duration measure);
 
+  /** \brief start from an estimate instead of the initial RTT
+   *
+   *  The estimate is used until the first measurement, which replaces it.
+   *  Has no effect if there are measurements already.
+   */
+  void
+  setPrior(Duration rtt, Duration deviation);
+
   void
   incrementMultiplier();
 
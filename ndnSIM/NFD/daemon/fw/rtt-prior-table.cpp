@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtt-prior-table.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+const time::nanoseconds RttPriorTable::AGE_CONSTANT = time::seconds(60);
+
+/// gain of the smoothed RTT of a prefix
+static const double SRTT_GAIN = 0.125;
+
+RttPriorTable::RttPriorTable(size_t capacity)
+  : m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+void
+RttPriorTable::addMeasurement(const Name& prefix, FaceId face, RttEstimator::Duration rtt)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  double sample = static_cast<double>(rtt.count());
+
+  RecordTable::iterator it = m_records.find(prefix);
+  if (it != m_records.end()) {
+    Record& record = it->second;
+    record.face = face;
+    record.srtt += (sample - record.srtt) * SRTT_GAIN;
+    record.lastUpdate = now;
+    m_lru.splice(m_lru.end(), m_lru, record.lruPosition);
+    return;
+  }
+
+  if (m_records.size() >= m_capacity) {
+    m_records.erase(*m_lru.front());
+    m_lru.pop_front();
+  }
+
+  it = m_records.insert(std::make_pair(prefix, Record())).first;
+  Record& record = it->second;
+  record.view = ndn::StructuredNameView(it->first);
+  record.face = face;
+  record.srtt = sample;
+  record.lastUpdate = now;
+  record.lruPosition = m_lru.insert(m_lru.end(), &it->first);
+}
+
+bool
+RttPriorTable::estimate(const Name& name, Estimate& estimate) const
+{
+  ndn::StructuredNameView query(name);
+  if (!query.hasSpatialPart() && !query.hasApplicationPart())
+    return false;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  double ageConstant = static_cast<double>(AGE_CONSTANT.count());
+
+  // weights are kept for the second pass computing the deviation
+  std::vector<std::pair<const Record*, double>> weights;
+  double sumWeight = 0.0;
+  double sumRtt = 0.0;
+  const Record* best = nullptr;
+  double bestCorrelativity = 0.0;
+
+  for (const RecordTable::value_type& item : m_records) {
+    const Record& record = item.second;
+    double correlativity = (query.spatialCorrelativityWith(record.view) +
+                            query.applicationCorrelativityWith(record.view)) / 2;
+    if (correlativity <= 0.0)
+      continue;
+
+    double age = static_cast<double>((now - record.lastUpdate).count());
+    double weight = correlativity * std::exp(-age / ageConstant);
+    weights.push_back(std::make_pair(&record, weight));
+    sumWeight += weight;
+    sumRtt += weight * record.srtt;
+
+    if (correlativity > bestCorrelativity) {
+      best = &record;
+      bestCorrelativity = correlativity;
+    }
+  }
+
+  if (best == nullptr || sumWeight <= 0.0)
+    return false;
+
+  double rtt = sumRtt / sumWeight;
+  double sumDeviation = 0.0;
+  for (const auto& weight : weights) {
+    sumDeviation += weight.second * std::abs(weight.first->srtt - rtt);
+  }
+
+  estimate.rtt = RttEstimator::Duration(static_cast<RttEstimator::Duration::rep>(rtt));
+  estimate.deviation = RttEstimator::Duration(
+                         static_cast<RttEstimator::Duration::rep>(sumDeviation / sumWeight));
+  estimate.face = best->face;
+  estimate.correlativity = bestCorrelativity;
+  return true;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_RTT_PRIOR_TABLE_HPP
+#define NFD_DAEMON_FW_RTT_PRIOR_TABLE_HPP
+
+#include "face/face.hpp"
+#include "rtt-estimator.hpp"
+
+#include <ndn-cxx/structured-name-view.hpp>
+
+#include <list>
+#include <map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief recent RTT and upstream of prefixes, used to initialize measurements of new prefixes
+ *
+ *  A strategy records the RTT and the upstream face of every Data it receives under the
+ *  prefix of the Data (usually the Name without its sequence number component).  When the
+ *  strategy sees a prefix without its own measurements, it asks for an estimate: the RTT is
+ *  the average of the recorded RTTs weighted by the spatial and application correlativity
+ *  (see ndn::StructuredNameView) of their prefixes with the new Name and by their age, and the
+ *  upstream is the face of the most correlated record.
+ *
+ *  Only Names with /S/<spatial> or /A/<application> segments have non-zero correlativity, so
+ *  strategies behave as before for other Names.  The table keeps the most recently updated
+ *  \p capacity prefixes; an estimate scans all of them.
+ */
+class RttPriorTable : noncopyable
+{
+public:
+  struct Estimate
+  {
+    RttEstimator::Duration rtt;
+    RttEstimator::Duration deviation; ///< weighted mean deviation of the recorded RTTs
+    FaceId face;                      ///< upstream of the most correlated prefix
+    double correlativity;             ///< correlativity of the most correlated prefix
+  };
+
+  explicit
+  RttPriorTable(size_t capacity = 256);
+
+  /** \brief record an RTT measured for a Data under \p prefix, received from \p face
+   */
+  void
+  addMeasurement(const Name& prefix, FaceId face, RttEstimator::Duration rtt);
+
+  /** \brief estimate RTT and upstream for \p name from correlated prefixes
+   *  \return false if no recorded prefix is correlated with \p name
+   */
+  bool
+  estimate(const Name& name, Estimate& estimate) const;
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  /** \brief time constant of the age weight exp(-age / AGE_CONSTANT)
+   */
+  static const time::nanoseconds AGE_CONSTANT;
+
+private:
+  struct Record
+  {
+    ndn::StructuredNameView view; ///< refers to the key in m_records
+    FaceId face;
+    double srtt;                  ///< smoothed RTT, microseconds
+    time::steady_clock::TimePoint lastUpdate;
+    std::list<const Name*>::iterator lruPosition;
+  };
+
+  typedef std::map<Name, Record> RecordTable;
+
+private:
+  size_t m_capacity;
+  RecordTable m_records;
+  std::list<const Name*> m_lru; ///< least recently updated first
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_RTT_PRIOR_TABLE_HPP
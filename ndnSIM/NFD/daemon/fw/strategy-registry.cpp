@@ -61,5 +61,24 @@ installStrategies(Forwarder& forwarder)
   }
 }
 
+shared_ptr<Strategy>
+makeStrategy(Forwarder& forwarder, const Name& strategyName)
+{
+  // same matching as StrategyChoice::getStrategy
+  const StrategyCreateFunc* candidate = nullptr;
+  const auto& factories = getStrategyFactories();
+  for (auto it = factories.lower_bound(strategyName);
+       it != factories.end() && strategyName.isPrefixOf(it->first); ++it) {
+    switch (it->first.size() - strategyName.size()) {
+    case 0: // exact match
+      return it->second(forwarder);
+    case 1: // unversioned strategyName matches versioned strategy
+      candidate = &it->second;
+      break;
+    }
+  }
+  return candidate != nullptr ? (*candidate)(forwarder) : nullptr;
+}
+
 } // namespace fw
 } // namespace nfd
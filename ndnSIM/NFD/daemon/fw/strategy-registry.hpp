@@ -42,6 +42,13 @@ makeDefaultStrategy(Forwarder& forwarder);
 void
 installStrategies(Forwarder& forwarder);
 
+/** \brief create a registered strategy
+ *  \param strategyName a versioned or unversioned strategyName
+ *  \return the strategy, or nullptr if no registered strategy has this name
+ */
+shared_ptr<Strategy>
+makeStrategy(Forwarder& forwarder, const Name& strategyName);
+
 
 typedef std::function<shared_ptr<Strategy>(Forwarder&)> StrategyCreateFunc;
 
@@ -27,6 +27,8 @@
 #include "forwarder.hpp"
 #include "core/logger.hpp"
 
+#include <unordered_set>
+
 namespace nfd {
 namespace fw {
 
@@ -39,6 +41,7 @@ Strategy::Strategy(Forwarder& forwarder, const Name& name)
   , m_forwarder(forwarder)
   , m_measurements(m_forwarder.getMeasurements(),
                    m_forwarder.getStrategyChoice(), *this)
+  , m_aggregationHold(time::nanoseconds::zero())
 {
 }
 
@@ -63,6 +66,82 @@ Strategy::beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry)
   NFD_LOG_DEBUG("beforeExpirePendingInterest pitEntry=" << pitEntry->getName());
 }
 
+void
+Strategy::afterReceiveLoopedInterest(const Face& inFace, const Interest& interest,
+                                     shared_ptr<pit::Entry> pitEntry)
+{
+  NFD_LOG_DEBUG("afterReceiveLoopedInterest pitEntry=" << pitEntry->getName() <<
+    " inFace=" << inFace.getId() << " nonce=" << interest.getNonce());
+}
+
+void
+Strategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                           shared_ptr<fib::Entry> fibEntry,
+                           shared_ptr<pit::Entry> pitEntry)
+{
+  NFD_LOG_DEBUG("afterReceiveNack inFace=" << inFace.getId() <<
+    " pitEntry=" << pitEntry->getName());
+}
+
+void
+Strategy::sendNacks(shared_ptr<pit::Entry> pitEntry, const lp::NackHeader& header,
+                    std::initializer_list<const Face*> exceptFaces)
+{
+  // populate downstreams with all downstreams faces
+  std::unordered_set<const Face*> downstreams;
+  std::transform(pitEntry->getInRecords().begin(), pitEntry->getInRecords().end(),
+                 std::inserter(downstreams, downstreams.end()),
+                 [] (const pit::InRecord& inR) { return inR.getFace().get(); });
+
+  // delete excluded faces
+  for (const Face* exceptFace : exceptFaces) {
+    downstreams.erase(exceptFace);
+  }
+
+  // send Nacks; sendNack deletes the in-record, so the faces are collected first
+  for (const Face* downstream : downstreams) {
+    this->sendNack(pitEntry, *downstream, header);
+  }
+}
+
+/** \return whether reason x is less severe than reason y
+ *  \note NackReason::NONE is treated as the most severe
+ */
+static bool
+isLessSevere(lp::NackReason x, lp::NackReason y)
+{
+  if (x == lp::NackReason::NONE) {
+    return false;
+  }
+  if (y == lp::NackReason::NONE) {
+    return true;
+  }
+  return static_cast<int>(x) < static_cast<int>(y);
+}
+
+bool
+Strategy::sendNacksIfAllUpstreamsNacked(shared_ptr<pit::Entry> pitEntry)
+{
+  lp::NackReason leastSevereReason = lp::NackReason::NONE;
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    const lp::NackHeader* inNack = outRecord.getIncomingNack();
+    if (inNack == nullptr) {
+      // an upstream may still answer
+      return false;
+    }
+    if (isLessSevere(inNack->getReason(), leastSevereReason)) {
+      leastSevereReason = inNack->getReason();
+    }
+  }
+
+  lp::NackHeader outNack;
+  outNack.setReason(leastSevereReason);
+  NFD_LOG_DEBUG("sendNacksIfAllUpstreamsNacked pitEntry=" << pitEntry->getName() <<
+    " reason=" << leastSevereReason);
+  this->sendNacks(pitEntry, outNack);
+  return true;
+}
+
 //void
 //Strategy::afterAddFibEntry(shared_ptr<fib::Entry> fibEntry)
 //{
@@ -54,6 +54,18 @@ public:
   const Name&
   getName() const;
 
+  /** \brief how long the first Interest of a PIT entry is held before dispatching it
+   *
+   *  During the hold, Interests for the PIT entry from other downstreams are aggregated into
+   *  it without triggering the strategy, so a burst of requests for popular content
+   *  is forwarded upstream once.  Zero, the default, disables the hold.
+   */
+  const time::nanoseconds&
+  getAggregationHold() const;
+
+  void
+  setAggregationHold(const time::nanoseconds& hold);
+
 public: // triggers
   /** \brief trigger after Interest is received
    *
@@ -110,6 +122,45 @@ public: // triggers
   virtual void
   beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief trigger after an Interest with a duplicate Nonce is received
+   *
+   *  Over a broadcast face, this is how a node overhears neighbors that have already
+   *  forwarded the same Interest.  The looped Interest is dropped by the forwarder
+   *  after this trigger.
+   *
+   *  In this base class this method does nothing.
+   *
+   *  \note The strategy is permitted to store a shared reference to pitEntry.
+   *        pitEntry is passed by value to reflect this fact.
+   */
+  virtual void
+  afterReceiveLoopedInterest(const Face& inFace, const Interest& interest,
+                             shared_ptr<pit::Entry> pitEntry);
+
+  /** \brief trigger after Nack is received
+   *
+   *  This trigger is invoked when an incoming Nack is received in response to
+   *  an forwarded Interest.
+   *  The Nack has been confirmed to be a response to the last Interest forwarded
+   *  to that upstream, i.e. the PIT out-record exists and has a matching Nonce.
+   *  The NackHeader has been recorded in the PIT out-record.
+   *
+   *  The strategy may retry with another upstream, or send Nacks downstream with
+   *  this->sendNacks and reject the pending Interest.
+   *
+   *  In this base class this method does nothing.
+   *
+   *  \note The strategy is permitted to store a weak reference to fibEntry.
+   *        Do not store a shared reference, because PIT entry may be deleted at any moment.
+   *        fibEntry is passed by value to allow obtaining a weak reference from it.
+   *  \note The strategy is permitted to store a shared reference to pitEntry.
+   *        pitEntry is passed by value to reflect this fact.
+   */
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   shared_ptr<fib::Entry> fibEntry,
+                   shared_ptr<pit::Entry> pitEntry);
+
 protected: // actions
   /// send Interest to outFace
   VIRTUAL_WITH_TESTS void
@@ -125,6 +176,32 @@ protected: // actions
   VIRTUAL_WITH_TESTS void
   rejectPendingInterest(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief send Nack to outFace
+   *
+   *  The outFace must have a PIT in-record, otherwise this method has no effect.
+   */
+  VIRTUAL_WITH_TESTS void
+  sendNack(shared_ptr<pit::Entry> pitEntry, const Face& outFace,
+           const lp::NackHeader& header);
+
+  /** \brief send Nack to every face that has an in-record,
+   *         except those in \p exceptFaces
+   *  \note This is not an action, but a helper that invokes the sendNack action.
+   */
+  void
+  sendNacks(shared_ptr<pit::Entry> pitEntry, const lp::NackHeader& header,
+            std::initializer_list<const Face*> exceptFaces = std::initializer_list<const Face*>());
+
+  /** \brief send Nacks downstream if every upstream has returned a Nack
+   *
+   *  The Nacks carry the least severe reason among the upstreams' Nacks.
+   *  The PIT entry is left to expire, because its out-records are still unexpired.
+   *  \note This is not an action, but a helper that invokes the sendNack action.
+   *  \return whether Nacks were sent
+   */
+  bool
+  sendNacksIfAllUpstreamsNacked(shared_ptr<pit::Entry> pitEntry);
+
 protected: // accessors
   MeasurementsAccessor&
   getMeasurements();
@@ -135,6 +212,15 @@ protected: // accessors
   const FaceTable&
   getFaceTable();
 
+  /** \return whether a neighbor recently served Data under \p prefix, i.e., unsolicited Data
+   *          were overheard on a non-local face within Forwarder::getOverheardDataLifetime
+   *
+   *  A strategy can skip forwarding an Interest that such Data would have satisfied.
+   *  Always false unless the lifetime is set (see ns3::ndn::StackHelper::SetOverhearing).
+   */
+  bool
+  hasOverheardData(const Name& prefix) const;
+
 protected: // accessors
   signal::Signal<FaceTable, shared_ptr<Face>>& afterAddFace;
   signal::Signal<FaceTable, shared_ptr<Face>>& beforeRemoveFace;
@@ -149,6 +235,8 @@ private:
   Forwarder& m_forwarder;
 
   MeasurementsAccessor m_measurements;
+
+  time::nanoseconds m_aggregationHold;
 };
 
 inline const Name&
@@ -157,6 +245,18 @@ Strategy::getName() const
   return m_name;
 }
 
+inline const time::nanoseconds&
+Strategy::getAggregationHold() const
+{
+  return m_aggregationHold;
+}
+
+inline void
+Strategy::setAggregationHold(const time::nanoseconds& hold)
+{
+  m_aggregationHold = hold;
+}
+
 inline void
 Strategy::sendInterest(shared_ptr<pit::Entry> pitEntry,
                        shared_ptr<Face> outFace,
@@ -171,6 +271,13 @@ Strategy::rejectPendingInterest(shared_ptr<pit::Entry> pitEntry)
   m_forwarder.onInterestReject(pitEntry);
 }
 
+inline void
+Strategy::sendNack(shared_ptr<pit::Entry> pitEntry, const Face& outFace,
+                   const lp::NackHeader& header)
+{
+  m_forwarder.onOutgoingNack(pitEntry, outFace, header);
+}
+
 inline MeasurementsAccessor&
 Strategy::getMeasurements()
 {
@@ -189,6 +296,12 @@ Strategy::getFaceTable()
   return m_forwarder.getFaceTable();
 }
 
+inline bool
+Strategy::hasOverheardData(const Name& prefix) const
+{
+  return m_forwarder.hasOverheardData(prefix);
+}
+
 } // namespace fw
 } // namespace nfd
 
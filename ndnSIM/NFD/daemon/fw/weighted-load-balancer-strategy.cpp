@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "weighted-load-balancer-strategy.hpp"
+#include "core/logger.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("WeightedLoadBalancerStrategy");
+
+const Name WeightedLoadBalancerStrategy::STRATEGY_NAME(
+  "ndn:/localhost/nfd/strategy/weighted-load-balancer/%FD%01");
+NFD_REGISTER_STRATEGY(WeightedLoadBalancerStrategy);
+
+const double WeightedLoadBalancerStrategy::MIN_SUCCESS = 0.05;
+const double WeightedLoadBalancerStrategy::SUCCESS_GAIN = 0.125;
+
+static const time::nanoseconds ME_LIFETIME = time::seconds(16);
+
+WeightedLoadBalancerStrategy::WeightedLoadBalancerStrategy(Forwarder& forwarder,
+                                                           const Name& name)
+  : Strategy(forwarder, name)
+{
+}
+
+WeightedLoadBalancerStrategy::MtInfo::FaceInfo::FaceInfo()
+  : rtt(1, time::milliseconds(1), 0.1)
+  , success(1.0)
+  , isMeasured(false)
+  , credit(0.0)
+{
+}
+
+double
+WeightedLoadBalancerStrategy::MtInfo::FaceInfo::getWeight() const
+{
+  double rto = time::duration_cast<time::microseconds>(rtt.computeRto()).count() / 1e6;
+  return std::max(success, MIN_SUCCESS) / std::max(rto, 1e-6);
+}
+
+void
+WeightedLoadBalancerStrategy::afterReceiveInterest(const Face& inFace,
+                                                   const Interest& interest,
+                                                   shared_ptr<fib::Entry> fibEntry,
+                                                   shared_ptr<pit::Entry> pitEntry)
+{
+  RetxSuppression::Result suppression = m_retxSuppression.decide(inFace, interest, *pitEntry);
+  if (suppression == RetxSuppression::SUPPRESS) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " suppressed");
+    return;
+  }
+
+  std::vector<shared_ptr<Face>> candidates;
+  for (const fib::NextHop& nexthop : fibEntry->getNextHops()) {
+    shared_ptr<Face> face = nexthop.getFace();
+    if (face->getId() != inFace.getId() && pitEntry->canForwardTo(*face)) {
+      candidates.push_back(face);
+    }
+  }
+
+  if (suppression == RetxSuppression::NEW && candidates.empty()) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " noNextHop");
+
+    lp::NackHeader nackHeader;
+    nackHeader.setReason(lp::NackReason::NO_ROUTE);
+    this->sendNack(pitEntry, inFace, nackHeader);
+
+    this->rejectPendingInterest(pitEntry);
+    return;
+  }
+
+  if (candidates.empty()) {
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmitNoNextHop");
+    return;
+  }
+
+  // congested upstreams are left out while others can take the Interest
+  auto isCongested = [] (const shared_ptr<Face>& face) { return face->isCongested(); };
+  if (!std::all_of(candidates.begin(), candidates.end(), isCongested)) {
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), isCongested),
+                     candidates.end());
+  }
+
+  // without measurements (FIB prefix is outside of this strategy), weights are all equal
+  shared_ptr<MtInfo> mi = this->getMtInfo(*fibEntry);
+  if (mi == nullptr) {
+    mi = make_shared<MtInfo>();
+  }
+
+  if (suppression == RetxSuppression::NEW) {
+    shared_ptr<Face> outFace = this->pickNext(*mi, candidates);
+    NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " newPitEntry-to=" << outFace->getId());
+    this->sendInterest(pitEntry, outFace);
+    return;
+  }
+
+  // heaviest upstream not tried yet
+  std::vector<double> weights = this->getWeights(*mi, candidates);
+  shared_ptr<Face> outFace;
+  double outWeight = -1.0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (pitEntry->getOutRecord(*candidates[i]) == pitEntry->getOutRecords().end() &&
+        weights[i] > outWeight) {
+      outFace = candidates[i];
+      outWeight = weights[i];
+    }
+  }
+
+  // otherwise, upstream tried earliest
+  if (outFace == nullptr) {
+    time::steady_clock::TimePoint earliest = time::steady_clock::TimePoint::max();
+    for (const shared_ptr<Face>& face : candidates) {
+      pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(*face);
+      if (outRecord->getLastRenewed() < earliest) {
+        earliest = outRecord->getLastRenewed();
+        outFace = face;
+      }
+    }
+    // the earlier transmission to it is given up
+    this->recordLoss(*mi, outFace->getId());
+  }
+
+  NFD_LOG_DEBUG(interest << " from=" << inFace.getId() << " retransmit-to=" << outFace->getId());
+  this->sendInterest(pitEntry, outFace);
+}
+
+void
+WeightedLoadBalancerStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                                                    const Face& inFace, const Data& data)
+{
+  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
+  if (outRecord == pitEntry->getOutRecords().end()) {
+    return;
+  }
+
+  shared_ptr<MtInfo> mi = this->findMtInfo(*pitEntry);
+  if (mi == nullptr) {
+    return;
+  }
+
+  time::steady_clock::Duration rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  MtInfo::FaceInfo& fi = mi->faces[inFace.getId()];
+  fi.rtt.addMeasurement(time::duration_cast<RttEstimator::Duration>(rtt));
+  fi.success += (1.0 - fi.success) * SUCCESS_GAIN;
+  fi.isMeasured = true;
+  NFD_LOG_DEBUG(pitEntry->getInterest() << " dataFrom " << inFace.getId() <<
+                " rtt=" << time::duration_cast<time::microseconds>(rtt).count() <<
+                " weight=" << fi.getWeight());
+}
+
+void
+WeightedLoadBalancerStrategy::beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry)
+{
+  shared_ptr<MtInfo> mi = this->findMtInfo(*pitEntry);
+  if (mi == nullptr) {
+    return;
+  }
+
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    if (outRecord.getIncomingNack() == nullptr) { // Nacks are counted when they arrive
+      NFD_LOG_DEBUG(pitEntry->getInterest() << " timeoutFrom " << outRecord.getFace()->getId());
+      this->recordLoss(*mi, outRecord.getFace()->getId());
+    }
+  }
+}
+
+void
+WeightedLoadBalancerStrategy::afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                                               shared_ptr<fib::Entry> fibEntry,
+                                               shared_ptr<pit::Entry> pitEntry)
+{
+  shared_ptr<MtInfo> mi = this->findMtInfo(*pitEntry);
+  if (mi != nullptr) {
+    this->recordLoss(*mi, inFace.getId());
+  }
+
+  this->sendNacksIfAllUpstreamsNacked(pitEntry);
+}
+
+double
+WeightedLoadBalancerStrategy::getWeight(const Name& prefix, FaceId face)
+{
+  shared_ptr<measurements::Entry> me = this->getMeasurements().findExactMatch(prefix);
+  if (me == nullptr) {
+    return 0.0;
+  }
+
+  shared_ptr<MtInfo> mi = me->getStrategyInfo<MtInfo>();
+  if (mi == nullptr) {
+    return 0.0;
+  }
+
+  auto it = mi->faces.find(face);
+  return it == mi->faces.end() ? 0.0 : it->second.getWeight();
+}
+
+shared_ptr<WeightedLoadBalancerStrategy::MtInfo>
+WeightedLoadBalancerStrategy::getMtInfo(const fib::Entry& fibEntry)
+{
+  shared_ptr<measurements::Entry> me = this->getMeasurements().get(fibEntry);
+  if (me == nullptr) { // FIB prefix is not in this strategy, e.g. the root FIB entry
+    return nullptr;
+  }
+
+  this->getMeasurements().extendLifetime(*me, ME_LIFETIME);
+  return me->getOrCreateStrategyInfo<MtInfo>();
+}
+
+shared_ptr<WeightedLoadBalancerStrategy::MtInfo>
+WeightedLoadBalancerStrategy::findMtInfo(const pit::Entry& pitEntry)
+{
+  shared_ptr<measurements::Entry> me = this->getMeasurements().findLongestPrefixMatch(pitEntry,
+    measurements::EntryWithStrategyInfo<MtInfo>());
+  if (me == nullptr) {
+    return nullptr;
+  }
+
+  this->getMeasurements().extendLifetime(*me, ME_LIFETIME);
+  return me->getStrategyInfo<MtInfo>();
+}
+
+std::vector<double>
+WeightedLoadBalancerStrategy::getWeights(MtInfo& mi,
+                                         const std::vector<shared_ptr<Face>>& candidates)
+{
+  std::vector<double> weights(candidates.size(), 0.0);
+  double maxMeasured = 0.0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const MtInfo::FaceInfo& fi = mi.faces[candidates[i]->getId()];
+    if (fi.isMeasured) {
+      weights[i] = fi.getWeight();
+      maxMeasured = std::max(maxMeasured, weights[i]);
+    }
+  }
+
+  // unmeasured nexthops are as good as the best one, or all equal if none is measured
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (!mi.faces[candidates[i]->getId()].isMeasured) {
+      weights[i] = maxMeasured > 0.0 ? maxMeasured : 1.0;
+    }
+  }
+  return weights;
+}
+
+shared_ptr<Face>
+WeightedLoadBalancerStrategy::pickNext(MtInfo& mi, const std::vector<shared_ptr<Face>>& candidates)
+{
+  BOOST_ASSERT(!candidates.empty());
+  std::vector<double> weights = this->getWeights(mi, candidates);
+
+  // smooth weighted round robin: every candidate earns its weight, the richest one is picked
+  // and pays the total, so picks are interleaved in proportion to the weights
+  double total = 0.0;
+  size_t picked = 0;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    MtInfo::FaceInfo& fi = mi.faces[candidates[i]->getId()];
+    fi.credit += weights[i];
+    total += weights[i];
+    if (fi.credit > mi.faces[candidates[picked]->getId()].credit) {
+      picked = i;
+    }
+  }
+  mi.faces[candidates[picked]->getId()].credit -= total;
+  return candidates[picked];
+}
+
+void
+WeightedLoadBalancerStrategy::recordLoss(MtInfo& mi, FaceId face)
+{
+  MtInfo::FaceInfo& fi = mi.faces[face];
+  fi.success -= fi.success * SUCCESS_GAIN;
+  fi.isMeasured = true;
+}
+
+} // namespace fw
+} // namespace nfd
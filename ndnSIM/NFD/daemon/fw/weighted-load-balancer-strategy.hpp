@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_WEIGHTED_LOAD_BALANCER_STRATEGY_HPP
+#define NFD_DAEMON_FW_WEIGHTED_LOAD_BALANCER_STRATEGY_HPP
+
+#include "strategy.hpp"
+#include "rtt-estimator.hpp"
+#include "retx-suppression-exponential.hpp"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief a strategy that splits the Interests of a prefix across all nexthops,
+ *         in proportion to their measured capacity
+ *
+ *  Every new Interest is forwarded to one nexthop chosen by smooth weighted round robin.
+ *  The weight of a nexthop is its success ratio divided by its RTO: the success ratio is
+ *  an exponentially weighted ratio of Interests answered by Data, lowered by timeouts and
+ *  Nacks, and the RTO comes from the RTT of the answers.  A nexthop that has not been
+ *  measured gets the largest weight among the measured ones, so new paths are probed.
+ *  Measurements are kept per FIB prefix, i.e. for all the traffic that is split.
+ *
+ *  A retransmission that is not suppressed (see RetxSuppressionExponential) goes to the
+ *  heaviest nexthop not tried for the Interest yet, or to the one tried earliest.
+ *  Congested nexthops (see Face::isCongested) are skipped, unless all of them are congested.
+ *  Without an eligible nexthop a new Interest is answered with a Nack~NoRoute.
+ */
+class WeightedLoadBalancerStrategy : public Strategy
+{
+public:
+  WeightedLoadBalancerStrategy(Forwarder& forwarder, const Name& name = STRATEGY_NAME);
+
+  virtual void
+  afterReceiveInterest(const Face& inFace,
+                       const Interest& interest,
+                       shared_ptr<fib::Entry> fibEntry,
+                       shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  virtual void
+  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
+                        const Face& inFace, const Data& data) DECL_OVERRIDE;
+
+  virtual void
+  beforeExpirePendingInterest(shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  virtual void
+  afterReceiveNack(const Face& inFace, const lp::Nack& nack,
+                   shared_ptr<fib::Entry> fibEntry,
+                   shared_ptr<pit::Entry> pitEntry) DECL_OVERRIDE;
+
+  /** \return current weight of \p face for the Interests under \p prefix,
+   *          or 0 if there are no measurements for them
+   */
+  double
+  getWeight(const Name& prefix, FaceId face);
+
+public:
+  static const Name STRATEGY_NAME;
+
+  /** \brief lowest success ratio, so that a nexthop that lost everything is still probed
+   */
+  static const double MIN_SUCCESS;
+
+  /** \brief gain of the exponentially weighted success ratio
+   */
+  static const double SUCCESS_GAIN;
+
+private: // StrategyInfo
+  /** \brief StrategyInfo in measurements table
+   */
+  class MtInfo : public StrategyInfo
+  {
+  public:
+    static constexpr int
+    getTypeId()
+    {
+      return 1040;
+    }
+
+    class FaceInfo
+    {
+    public:
+      FaceInfo();
+
+      double
+      getWeight() const;
+
+    public:
+      RttEstimator rtt;
+      double success; ///< exponentially weighted ratio of answered Interests
+      bool isMeasured;
+      double credit;  ///< smooth weighted round robin state
+    };
+
+  public:
+    std::unordered_map<FaceId, FaceInfo> faces;
+  };
+
+  shared_ptr<MtInfo>
+  getMtInfo(const fib::Entry& fibEntry);
+
+  /** \brief find measurements of the prefix that \p pitEntry was forwarded with
+   */
+  shared_ptr<MtInfo>
+  findMtInfo(const pit::Entry& pitEntry);
+
+  /** \return weight of every face in \p candidates
+   */
+  std::vector<double>
+  getWeights(MtInfo& mi, const std::vector<shared_ptr<Face>>& candidates);
+
+  /** \brief pick a face by smooth weighted round robin
+   */
+  shared_ptr<Face>
+  pickNext(MtInfo& mi, const std::vector<shared_ptr<Face>>& candidates);
+
+  /** \brief record that the Interest sent to \p face got no Data
+   */
+  void
+  recordLoss(MtInfo& mi, FaceId face);
+
+private:
+  RetxSuppressionExponential m_retxSuppression;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_WEIGHTED_LOAD_BALANCER_STRATEGY_HPP
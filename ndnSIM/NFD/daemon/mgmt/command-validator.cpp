@@ -26,6 +26,7 @@
 #include "core/logger.hpp"
 
 #include <ndn-cxx/util/io.hpp>
+#include <ndn-cxx/util/string-helper.hpp>
 #include <ndn-cxx/security/identity-certificate.hpp>
 
 #include <boost/filesystem.hpp>
@@ -62,6 +63,29 @@ aggregateErrors(std::stringstream& ss, const std::string& msg)
   ss << msg;
 }
 
+/** \brief reads the name and the hex-encoded value of a key shared with a local controller
+ *  \throw ConfigFile::Error the key is missing or malformed
+ */
+static void
+parseHmacKey(const ConfigSection& section, Name& keyName, shared_ptr<const ndn::Buffer>& key)
+{
+  try
+    {
+      keyName = Name(section.get<std::string>("hmac-key-name"));
+      key = ndn::fromHex(section.get<std::string>("hmac-key"));
+    }
+  catch (const std::exception& e)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Malformed HMAC key " +
+                                              section.get<std::string>("hmac-key-name", "")));
+    }
+
+  if (keyName.empty() || key->size() == 0)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error("Malformed HMAC key " + keyName.toUri()));
+    }
+}
+
 void
 CommandValidator::onConfig(const ConfigSection& section,
                            bool isDryRun,
@@ -83,9 +107,23 @@ CommandValidator::onConfig(const ConfigSection& section,
   for (authIt = section.begin(); authIt != section.end(); authIt++)
     {
       std::string certfile;
+      Name hmacKeyName;
+      shared_ptr<const ndn::Buffer> hmacKey;
       try
         {
-          certfile = authIt->second.get<std::string>("certfile");
+          if (authIt->second.get_child_optional("hmac-key-name"))
+            parseHmacKey(authIt->second, hmacKeyName, hmacKey);
+          else
+            certfile = authIt->second.get<std::string>("certfile");
+        }
+      catch (const ConfigFile::Error& e)
+        {
+          if (!isDryRun)
+            {
+              throw;
+            }
+          aggregateErrors(dryRunErrors, e.what());
+          continue;
         }
       catch (const std::runtime_error& e)
         {
@@ -100,7 +138,7 @@ CommandValidator::onConfig(const ConfigSection& section,
 
       shared_ptr<ndn::IdentityCertificate> id;
 
-      if (certfile != "any")
+      if (hmacKey == nullptr && certfile != "any")
         {
           path certfilePath = absolute(certfile, path(filename).parent_path());
           NFD_LOG_DEBUG("generated certfile path: " << certfilePath.native());
@@ -143,6 +181,8 @@ CommandValidator::onConfig(const ConfigSection& section,
       std::string keyNameForLogging;
       if (static_cast<bool>(id))
         keyNameForLogging = id->getPublicKeyName().toUri();
+      else if (hmacKey != nullptr)
+        keyNameForLogging = hmacKeyName.toUri();
       else
         {
           keyNameForLogging = "wildcard";
@@ -185,6 +225,8 @@ CommandValidator::onConfig(const ConfigSection& section,
                   const std::string regex = "^<localhost><nfd><" + privilegeName + ">";
                   if (static_cast<bool>(id))
                     m_validator.addInterestRule(regex, *id);
+                  else if (hmacKey != nullptr)
+                    m_validator.addInterestHmacRule(regex, hmacKeyName, *hmacKey);
                   else
                     m_validator.addInterestBypassRule(regex);
                 }
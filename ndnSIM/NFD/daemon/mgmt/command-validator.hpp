@@ -78,6 +78,11 @@ public:
                   const Name& keyName,
                   const ndn::PublicKey& publicKey);
 
+  void
+  addInterestHmacRule(const std::string& regex,
+                      const Name& keyName,
+                      const ndn::Buffer& key);
+
   void
   validate(const Interest& interest,
            const ndn::OnInterestValidated& onValidated,
@@ -103,6 +108,14 @@ CommandValidator::addInterestRule(const std::string& regex,
   m_validator.addInterestRule(regex, keyName, publicKey);
 }
 
+inline void
+CommandValidator::addInterestHmacRule(const std::string& regex,
+                                      const Name& keyName,
+                                      const ndn::Buffer& key)
+{
+  m_validator.addInterestHmacRule(regex, keyName, key);
+}
+
 inline void
 CommandValidator::validate(const Interest& interest,
                            const ndn::OnInterestValidated& onValidated,
@@ -340,6 +340,8 @@ FaceManager::onAddFace(shared_ptr<Face> face)
   face->copyStatusTo(notification);
 
   m_notificationStream.postNotification(notification);
+
+  m_faceStatusPublisher.invalidate();
 }
 
 void
@@ -350,6 +352,8 @@ FaceManager::onRemoveFace(shared_ptr<Face> face)
   face->copyStatusTo(notification);
 
   m_notificationStream.postNotification(notification);
+
+  m_faceStatusPublisher.invalidate();
 }
 
 bool
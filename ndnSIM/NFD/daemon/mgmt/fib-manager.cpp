@@ -39,6 +39,8 @@ NFD_LOG_INIT("FibManager");
 
 const Name FibManager::COMMAND_PREFIX = "/localhost/nfd/fib";
 
+const Name::Component FibManager::BATCH_VERB("batch");
+
 const size_t FibManager::COMMAND_UNSIGNED_NCOMPS =
   FibManager::COMMAND_PREFIX.size() +
   1 + // verb
@@ -148,6 +150,13 @@ FibManager::onValidatedFibRequest(const shared_ptr<const Interest>& request)
   const Name::Component& verb = command[COMMAND_PREFIX.size()];
   const Name::Component& parameterComponent = command[COMMAND_PREFIX.size() + 1];
 
+  if (verb == BATCH_VERB)
+    {
+      NFD_LOG_DEBUG("command result: processing verb: " << verb);
+      applyBatch(*request);
+      return;
+    }
+
   SignedVerbDispatchTable::const_iterator verbProcessor = m_signedVerbDispatch.find(verb);
   if (verbProcessor != m_signedVerbDispatch.end())
     {
@@ -177,6 +186,12 @@ FibManager::onValidatedFibRequest(const shared_ptr<const Interest>& request)
     }
 }
 
+void
+FibManager::onFibChanged()
+{
+  m_fibEnumerationPublisher.invalidate();
+}
+
 void
 FibManager::addNextHop(ControlParameters& parameters,
                        ControlResponse& response)
@@ -204,6 +219,7 @@ FibManager::addNextHop(ControlParameters& parameters,
       shared_ptr<fib::Entry> entry = m_managedFib.insert(prefix).first;
 
       entry->addNextHop(nextHopFace, cost);
+      m_fibEnumerationPublisher.invalidate();
 
       NFD_LOG_DEBUG("add-nexthop result: OK"
                     << " prefix:" << prefix
@@ -241,6 +257,7 @@ FibManager::removeNextHop(ControlParameters& parameters,
       if (static_cast<bool>(entry))
         {
           entry->removeNextHop(faceToRemove);
+          m_fibEnumerationPublisher.invalidate();
           NFD_LOG_DEBUG("remove-nexthop result: OK prefix: " << parameters.getName()
                         << " faceid: " << parameters.getFaceId());
 
@@ -264,6 +281,88 @@ FibManager::removeNextHop(ControlParameters& parameters,
   setResponse(response, 200, "Success", parameters.wireEncode());
 }
 
+void
+FibManager::applyBatch(const Interest& request)
+{
+  const Name& command = request.getName();
+
+  std::vector<ControlParameters> entries;
+  try
+    {
+      entries = ndn::nfd::BatchControlCommand::decodeEntries(command[COMMAND_PREFIX.size() + 1]);
+    }
+  catch (const tlv::Error& e)
+    {
+      NFD_LOG_DEBUG("batch result: FAIL reason: malformed: " << e.what());
+      sendResponse(command, 400, "Malformed command");
+      return;
+    }
+
+  if (entries.empty())
+    {
+      NFD_LOG_DEBUG("batch result: FAIL reason: empty");
+      sendResponse(command, 400, "Malformed command");
+      return;
+    }
+
+  ndn::nfd::FibBatchCommand batchCommand;
+  std::vector<shared_ptr<Face>> faces;
+  faces.reserve(entries.size());
+  for (ControlParameters& parameters : entries)
+    {
+      bool isSelfRegistration = (!parameters.hasFaceId() || parameters.getFaceId() == 0);
+      if (isSelfRegistration)
+        {
+          parameters.setFaceId(request.getIncomingFaceId());
+        }
+
+      if (!validateParameters(batchCommand, parameters))
+        {
+          NFD_LOG_DEBUG("batch result: FAIL reason: malformed entry");
+          sendResponse(command, 400, "Malformed command");
+          return;
+        }
+
+      shared_ptr<Face> face = m_getFace(parameters.getFaceId());
+      if (parameters.hasCost() && !static_cast<bool>(face))
+        {
+          NFD_LOG_DEBUG("batch result: FAIL reason: unknown-faceid: " << parameters.getFaceId());
+          sendResponse(command, 410, "Face not found");
+          return;
+        }
+      faces.push_back(face);
+    }
+
+  // every entry is valid: nothing below can fail
+  for (size_t i = 0; i < entries.size(); ++i)
+    {
+      const ControlParameters& parameters = entries[i];
+      if (parameters.hasCost())
+        {
+          shared_ptr<fib::Entry> entry = m_managedFib.insert(parameters.getName()).first;
+          entry->addNextHop(faces[i], parameters.getCost());
+        }
+      else if (static_cast<bool>(faces[i]))
+        {
+          // as remove-nexthop, removing from an unknown face or entry is not an error
+          shared_ptr<fib::Entry> entry = m_managedFib.findExactMatch(parameters.getName());
+          if (static_cast<bool>(entry))
+            {
+              entry->removeNextHop(faces[i]);
+              if (!entry->hasNextHops())
+                {
+                  m_managedFib.erase(*entry);
+                }
+            }
+        }
+    }
+
+  m_fibEnumerationPublisher.invalidate();
+
+  NFD_LOG_DEBUG("batch result: OK entries: " << entries.size());
+  sendResponse(command, 200, "Success", ControlParameters().wireEncode());
+}
+
 void
 FibManager::listEntries(const Interest& request)
 {
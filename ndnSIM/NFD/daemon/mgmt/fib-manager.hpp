@@ -53,6 +53,13 @@ public:
   void
   onFibRequest(const Interest& request);
 
+  /** \brief notifies the manager that the FIB was changed without a command
+   *
+   *  e.g. when routes of a simulation are installed directly
+   */
+  void
+  onFibChanged();
+
 private:
 
   void
@@ -66,6 +73,14 @@ private:
   removeNextHop(ControlParameters& parameters,
                 ControlResponse& response);
 
+  /** \brief apply a fib/batch command
+   *
+   *  The entries are validated and their faces are looked up before the FIB is touched,
+   *  so either every nexthop change is applied or none of them.
+   */
+  void
+  applyBatch(const Interest& request);
+
   void
   listEntries(const Interest& request);
 
@@ -94,6 +109,8 @@ private:
 
   static const Name COMMAND_PREFIX; // /localhost/nfd/fib
 
+  static const Name::Component BATCH_VERB;
+
   // number of components in an invalid, but not malformed, unsigned command.
   // (/localhost/nfd/fib + verb + parameters) = 5
   static const size_t COMMAND_UNSIGNED_NCOMPS;
@@ -168,6 +168,8 @@ StrategyChoiceManager::setStrategy(ControlParameters& parameters,
 
   if (m_strategyChoice.insert(prefix, selectedStrategy))
     {
+      m_listPublisher.invalidate();
+
       NFD_LOG_DEBUG("strategy-choice result: SUCCESS");
       auto currentStrategyChoice = m_strategyChoice.get(prefix);
       BOOST_ASSERT(currentStrategyChoice.first);
@@ -204,6 +206,7 @@ StrategyChoiceManager::unsetStrategy(ControlParameters& parameters,
     }
 
   m_strategyChoice.erase(parameters.getName());
+  m_listPublisher.invalidate();
 
   NFD_LOG_DEBUG("strategy-choice result: SUCCESS");
   setResponse(response, 200, "Success", parameters.wireEncode());
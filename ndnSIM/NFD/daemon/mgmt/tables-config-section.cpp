@@ -29,6 +29,8 @@
 #include "core/logger.hpp"
 #include "core/config-file.hpp"
 
+#include <limits>
+
 namespace nfd {
 
 NFD_LOG_INIT("TablesConfigSection");
@@ -80,6 +82,8 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
   // tables
   // {
   //    cs_max_packets 65536
+  //    cs_max_bytes 67108864
+  //    cs_policy lru
   //
   //    strategy_choice
   //    {
@@ -109,6 +113,41 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
       nCsMaxPackets = *valCsMaxPackets;
     }
 
+  // no limit in octets unless configured
+  size_t nCsMaxBytes = std::numeric_limits<size_t>::max();
+
+  boost::optional<const ConfigSection&> csMaxBytesNode =
+    configSection.get_child_optional("cs_max_bytes");
+
+  if (csMaxBytesNode)
+    {
+      boost::optional<size_t> valCsMaxBytes =
+        configSection.get_optional<size_t>("cs_max_bytes");
+
+      if (!valCsMaxBytes || *valCsMaxBytes == 0)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"cs_max_bytes\""
+                                                  " in \"tables\" section"));
+        }
+
+      nCsMaxBytes = *valCsMaxBytes;
+    }
+
+  unique_ptr<cs::Policy> csPolicy;
+
+  boost::optional<std::string> csPolicyName = configSection.get_optional<std::string>("cs_policy");
+
+  if (csPolicyName)
+    {
+      csPolicy = cs::makePolicy(*csPolicyName);
+
+      if (csPolicy == nullptr)
+        {
+          BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value for option \"cs_policy\""
+                                                  " in \"tables\" section"));
+        }
+    }
+
   boost::optional<const ConfigSection&> strategyChoiceSection =
     configSection.get_child_optional("strategy_choice");
 
@@ -119,9 +158,21 @@ TablesConfigSection::onConfig(const ConfigSection& configSection,
 
   if (!isDryRun)
     {
+      if (csPolicy != nullptr)
+        {
+          NFD_LOG_INFO("Setting CS policy to " << *csPolicyName);
+          m_cs.setPolicy(std::move(csPolicy));
+        }
+
       NFD_LOG_INFO("Setting CS max packets to " << nCsMaxPackets);
 
       m_cs.setLimit(nCsMaxPackets);
+
+      if (csMaxBytesNode)
+        {
+          NFD_LOG_INFO("Setting CS max bytes to " << nCsMaxBytes);
+        }
+      m_cs.setLimitBytes(nCsMaxBytes);
       m_areTablesConfigured = true;
     }
 }
@@ -30,11 +30,13 @@ namespace cs {
 
 EntryImpl::EntryImpl(const Name& name)
   : m_queryName(name)
+  , m_freshnessRecord(nullptr)
 {
   BOOST_ASSERT(this->isQuery());
 }
 
 EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited)
+  : m_freshnessRecord(nullptr)
 {
   this->setData(data, isUnsolicited);
   BOOST_ASSERT(!this->isQuery());
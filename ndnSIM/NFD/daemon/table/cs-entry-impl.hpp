@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_CS_ENTRY_IMPL_HPP
 
 #include "cs-entry.hpp"
+#include "cs-internal.hpp"
 
 namespace nfd {
 namespace cs {
@@ -60,6 +61,20 @@ public:
   void
   unsetUnsolicited();
 
+  /** \return the record of this entry in a freshness queue, or nullptr if there's none
+   */
+  FreshnessRecord*
+  getFreshnessRecord() const
+  {
+    return m_freshnessRecord;
+  }
+
+  void
+  setFreshnessRecord(FreshnessRecord* record)
+  {
+    m_freshnessRecord = record;
+  }
+
   bool
   operator<(const EntryImpl& other) const;
 
@@ -69,6 +84,7 @@ private:
 
 private:
   Name m_queryName;
+  FreshnessRecord* m_freshnessRecord;
 };
 
 } // namespace cs
@@ -40,6 +40,18 @@ class EntryImpl;
 typedef std::set<EntryImpl> Table;
 typedef Table::const_iterator iterator;
 
+/** \brief a stored entry in a freshness queue of the ContentStore
+ *
+ *  The record is invalidated instead of removed when its entry is refreshed or erased,
+ *  and dropped when it reaches the front of the queue.
+ */
+struct FreshnessRecord
+{
+  time::steady_clock::TimePoint staleTime;
+  iterator entry;
+  bool isValid;
+};
+
 } // namespace cs
 } // namespace nfd
 
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-matcher.hpp"
+
+#include <limits>
+
+namespace nfd {
+namespace cs {
+
+Matcher::Matcher(const Interest& interest)
+  : m_nameLength(interest.getName().size())
+  , m_minFullNameLength(m_nameLength + std::max(0, interest.getMinSuffixComponents()))
+  , m_maxFullNameLength(interest.getMaxSuffixComponents() >= 0 ?
+                        m_nameLength + interest.getMaxSuffixComponents() :
+                        std::numeric_limits<size_t>::max())
+  , m_hasKeyLocator(!interest.getPublisherPublicKeyLocator().empty())
+  , m_mustBeFresh(interest.getMustBeFresh())
+  , m_now(m_mustBeFresh ? time::steady_clock::now() : time::steady_clock::TimePoint())
+{
+  if (m_hasKeyLocator) {
+    m_keyLocator = interest.getPublisherPublicKeyLocator().wireEncode();
+  }
+
+  const Exclude& exclude = interest.getExclude();
+  for (Exclude::const_reverse_iterator i = exclude.rbegin(); i != exclude.rend(); ++i) {
+    m_exclude.emplace_back(&i->first, i->second);
+  }
+}
+
+bool
+Matcher::isExcluded(const name::Component& component) const
+{
+  // the last entry not greater than the component, as Exclude::isExcluded finds in its map
+  auto entry = std::upper_bound(m_exclude.begin(), m_exclude.end(), component,
+    [] (const name::Component& c, const std::pair<const name::Component*, bool>& e) {
+      return c < *e.first;
+    });
+  if (entry == m_exclude.begin()) {
+    return false;
+  }
+  --entry;
+  return entry->second || *entry->first == component;
+}
+
+bool
+Matcher::matches(const Entry& entry) const
+{
+  const Data& data = entry.getData();
+  size_t fullNameLength = data.getName().size() + 1;
+  BOOST_ASSERT(m_nameLength <= fullNameLength);
+
+  if (fullNameLength < m_minFullNameLength || fullNameLength > m_maxFullNameLength) {
+    return false;
+  }
+
+  // Exclude won't be violated if Interest Name is same as Data full Name
+  if (!m_exclude.empty() && fullNameLength > m_nameLength) {
+    const name::Component& next = m_nameLength + 1 == fullNameLength ?
+                                  data.getFullName().get(m_nameLength) :
+                                  data.getName().get(m_nameLength);
+    if (this->isExcluded(next)) {
+      return false;
+    }
+  }
+
+  if (m_hasKeyLocator) {
+    const Block& signatureInfo = data.getSignature().getInfo();
+    Block::element_const_iterator it = signatureInfo.find(tlv::KeyLocator);
+    if (it == signatureInfo.elements_end() || m_keyLocator != *it) {
+      return false;
+    }
+  }
+
+  if (m_mustBeFresh && entry.getStaleTime() < m_now) {
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_MATCHER_HPP
+#define NFD_DAEMON_TABLE_CS_MATCHER_HPP
+
+#include "cs-entry.hpp"
+
+namespace nfd {
+namespace cs {
+
+/** \brief selectors of an Interest, prepared for matching many entries of one lookup
+ *
+ *  Suffix bounds, the KeyLocator encoding and the current time are determined once, and the
+ *  Exclude is copied into a sorted array that is binary searched without following tree nodes.
+ *  The Interest must outlive the matcher.
+ */
+class Matcher : noncopyable
+{
+public:
+  explicit
+  Matcher(const Interest& interest);
+
+  /** \brief determines whether the Interest can be satisified by the stored Data
+   *  \return same as entry.canSatisfy(interest)
+   *  \pre Interest Name is a prefix of the full name of the entry
+   */
+  bool
+  matches(const Entry& entry) const;
+
+private:
+  bool
+  isExcluded(const name::Component& component) const;
+
+private:
+  size_t m_nameLength;
+  size_t m_minFullNameLength; ///< Name length plus MinSuffixComponents
+  size_t m_maxFullNameLength; ///< Name length plus MaxSuffixComponents, or SIZE_MAX
+  bool m_hasKeyLocator;
+  Block m_keyLocator;         ///< encoded PublisherPublicKeyLocator
+  bool m_mustBeFresh;
+  time::steady_clock::TimePoint m_now;
+
+  /** \brief Exclude entries in ascending order
+   *
+   *  A true flag excludes the components from that entry up to the next one, as in Exclude.
+   */
+  std::vector<std::pair<const name::Component*, bool>> m_exclude;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_MATCHER_HPP
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-2q.hpp"
+#include "cs.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+namespace cs {
+namespace twoq {
+
+const std::string TwoQPolicy::POLICY_NAME = "2q";
+
+TwoQPolicy::TwoQPolicy()
+  : Policy(POLICY_NAME)
+{
+}
+
+void
+TwoQPolicy::doAfterInsert(iterator i)
+{
+  GhostQueue::nth_index<1>::type& ghosts = m_out.get<1>();
+  GhostQueue::nth_index<1>::type::iterator ghost = ghosts.find(i->getName());
+  if (ghost != ghosts.end()) {
+    ghosts.erase(ghost);
+    m_hot.push_back(i);
+  }
+  else {
+    m_in.push_back(i);
+  }
+
+  this->evictEntries();
+}
+
+void
+TwoQPolicy::doAfterRefresh(iterator i)
+{
+  this->touch(i);
+}
+
+void
+TwoQPolicy::doBeforeErase(iterator i)
+{
+  if (m_in.get<1>().erase(i) == 0) {
+    m_hot.get<1>().erase(i);
+  }
+}
+
+void
+TwoQPolicy::doBeforeUse(iterator i)
+{
+  this->touch(i);
+}
+
+void
+TwoQPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+  while (this->isOverLimit()) {
+    BOOST_ASSERT(!m_in.empty() || !m_hot.empty());
+    iterator i;
+    size_t inCapacity = std::max<size_t>(this->getCs()->size() / 4, 1);
+    if (!m_in.empty() && (m_in.size() > inCapacity || m_hot.empty())) {
+      i = m_in.front();
+      m_in.pop_front();
+      this->remember(i->getName());
+    }
+    else {
+      i = m_hot.front();
+      m_hot.pop_front();
+    }
+    this->emitSignal(beforeEvict, i);
+  }
+}
+
+void
+TwoQPolicy::touch(iterator i)
+{
+  Queue::nth_index<1>::type::iterator it = m_hot.get<1>().find(i);
+  if (it != m_hot.get<1>().end()) {
+    m_hot.relocate(m_hot.end(), m_hot.project<0>(it));
+  }
+}
+
+void
+TwoQPolicy::remember(const Name& name)
+{
+  GhostQueue::iterator it;
+  bool isNew = false;
+  std::tie(it, isNew) = m_out.push_back(name);
+  if (!isNew) {
+    m_out.relocate(m_out.end(), it);
+  }
+
+  size_t capacity = std::max<size_t>(this->getCs()->size() / 2, 1);
+  while (m_out.size() > capacity) {
+    m_out.pop_front();
+  }
+}
+
+} // namespace twoq
+} // namespace cs
+} // namespace nfd
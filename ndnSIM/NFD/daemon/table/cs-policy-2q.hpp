@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_2Q_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_2Q_HPP
+
+#include "cs-policy.hpp"
+#include "common.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+namespace nfd {
+namespace cs {
+namespace twoq {
+
+struct EntryItComparator
+{
+  bool
+  operator()(const iterator& a, const iterator& b) const
+  {
+    return *a < *b;
+  }
+};
+
+typedef boost::multi_index_container<
+    iterator,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::ordered_unique<
+        boost::multi_index::identity<iterator>, EntryItComparator
+      >
+    >
+  > Queue;
+
+/** \brief Names of evicted Data, oldest first
+ */
+typedef boost::multi_index_container<
+    Name,
+    boost::multi_index::indexed_by<
+      boost::multi_index::sequenced<>,
+      boost::multi_index::hashed_unique<
+        boost::multi_index::identity<Name>, std::hash<Name>
+      >
+    >
+  > GhostQueue;
+
+/** \brief 2Q cs replacement policy
+ *
+ * A new entry is placed in a FIFO queue (A1in).  When it is evicted from there, its Name is
+ * kept in a ghost queue (A1out).  Data whose Name is found in the ghost queue was requested
+ * again after eviction, so it is placed in an LRU queue (Am) of hot entries instead.
+ * Hits in A1in do not promote an entry, so a scan of Names requested once passes through
+ * A1in without flushing hot entries out of Am.
+ *
+ * Entries are evicted from A1in while it holds more than a quarter of the stored entries
+ * (at least one) or Am is empty, otherwise from Am.  A1out remembers at most half as many Names
+ * as there are stored entries.
+ */
+class TwoQPolicy : public Policy
+{
+public:
+  TwoQPolicy();
+
+public:
+  static const std::string POLICY_NAME;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doAfterRefresh(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeErase(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeUse(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  evictEntries() DECL_OVERRIDE;
+
+private:
+  /** \brief moves an entry to the end of Am, if it is there
+   */
+  void
+  touch(iterator i);
+
+  /** \brief appends a Name to A1out, forgetting the oldest Names over capacity
+   */
+  void
+  remember(const Name& name);
+
+private:
+  Queue m_in;
+  GhostQueue m_out;
+  Queue m_hot;
+};
+
+} // namespace twoq
+
+using twoq::TwoQPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_2Q_HPP
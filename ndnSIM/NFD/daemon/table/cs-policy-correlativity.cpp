@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-policy-correlativity.hpp"
+#include "cs.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+namespace cs {
+namespace correlativity {
+
+const std::string CorrelativityPolicy::POLICY_NAME = "correlativity";
+const int CorrelativityPolicy::MAX_RESCORE = 8;
+
+CorrelativityPolicy::CorrelativityPolicy()
+  : Policy(POLICY_NAME)
+  , m_tick(0)
+  , m_hasLocation(false)
+  , m_generation(0)
+{
+}
+
+void
+CorrelativityPolicy::setLocation(const Name& location)
+{
+  m_hasLocation = false;
+  if (!location.empty()) {
+    this->setReference(location);
+    m_hasLocation = true;
+  }
+}
+
+void
+CorrelativityPolicy::doAfterInsert(iterator i)
+{
+  if (!i->isUnsolicited()) {
+    this->setReference(i->getName());
+  }
+
+  EntryInfo& info = m_entryInfoMap[i];
+  this->score(i, info, ++m_tick);
+
+  this->evictEntries();
+}
+
+void
+CorrelativityPolicy::doAfterRefresh(iterator i)
+{
+  this->doBeforeUse(i);
+}
+
+void
+CorrelativityPolicy::doBeforeErase(iterator i)
+{
+  EntryInfoMap::iterator it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+  m_scoreIndex.erase(it->second.key);
+  m_entryInfoMap.erase(it);
+}
+
+void
+CorrelativityPolicy::doBeforeUse(iterator i)
+{
+  this->setReference(i->getName());
+
+  EntryInfoMap::iterator it = m_entryInfoMap.find(i);
+  BOOST_ASSERT(it != m_entryInfoMap.end());
+  m_scoreIndex.erase(it->second.key);
+  this->score(i, it->second, ++m_tick);
+}
+
+void
+CorrelativityPolicy::evictEntries()
+{
+  BOOST_ASSERT(this->getCs() != nullptr);
+
+  while (this->isOverLimit()) {
+    this->evictOne();
+  }
+}
+
+void
+CorrelativityPolicy::evictOne()
+{
+  BOOST_ASSERT(!m_scoreIndex.empty());
+
+  for (int nRescored = 0; nRescored < MAX_RESCORE; ++nRescored) {
+    ScoreIndex::iterator lowest = m_scoreIndex.begin();
+    EntryInfo& info = m_entryInfoMap.find(lowest->second)->second;
+    if (info.generation == m_generation) {
+      break;
+    }
+
+    // the score was computed for an older reference, keep the age of the entry
+    iterator i = lowest->second;
+    m_scoreIndex.erase(lowest);
+    this->score(i, info, info.key.second);
+  }
+
+  iterator i = m_scoreIndex.begin()->second;
+  m_scoreIndex.erase(m_scoreIndex.begin());
+  m_entryInfoMap.erase(i);
+  this->emitSignal(beforeEvict, i);
+}
+
+void
+CorrelativityPolicy::setReference(const Name& name)
+{
+  if (m_hasLocation) {
+    return;
+  }
+
+  ndn::StructuredNameView view(name);
+  if (!view.hasSpatialPart()) {
+    return;
+  }
+
+  if (!m_reference.empty() &&
+      view.spatialEnd() - view.spatialBegin() ==
+      m_referenceView.spatialEnd() - m_referenceView.spatialBegin() &&
+      std::equal(view.spatialBegin(), view.spatialEnd(), m_referenceView.spatialBegin())) {
+    return;
+  }
+
+  m_reference = name;
+  m_referenceView = ndn::StructuredNameView(m_reference);
+  ++m_generation;
+}
+
+void
+CorrelativityPolicy::score(iterator i, EntryInfo& info, uint64_t tick)
+{
+  double score = 0.0;
+  if (!m_reference.empty()) {
+    score = ndn::StructuredNameView(i->getName()).spatialCorrelativityWith(m_referenceView);
+  }
+
+  info.key = ScoreKey(score, tick);
+  info.generation = m_generation;
+  m_scoreIndex.insert({info.key, i});
+}
+
+} // namespace correlativity
+} // namespace cs
+} // namespace nfd
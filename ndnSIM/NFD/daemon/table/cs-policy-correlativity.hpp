@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_POLICY_CORRELATIVITY_HPP
+#define NFD_DAEMON_TABLE_CS_POLICY_CORRELATIVITY_HPP
+
+#include "cs-policy.hpp"
+#include "common.hpp"
+
+#include <ndn-cxx/structured-name-view.hpp>
+
+namespace nfd {
+namespace cs {
+namespace correlativity {
+
+struct EntryItComparator
+{
+  bool
+  operator()(const iterator& a, const iterator& b) const
+  {
+    return *a < *b;
+  }
+};
+
+/** \brief (score, tick) of an entry, lowest evicted first
+ */
+typedef std::pair<double, uint64_t> ScoreKey;
+
+struct EntryInfo
+{
+  ScoreKey key;
+  uint64_t generation; ///< reference generation the score was computed with
+};
+
+typedef std::map<iterator, EntryInfo, EntryItComparator> EntryInfoMap;
+typedef std::map<ScoreKey, iterator> ScoreIndex;
+
+/** \brief spatial correlativity cs replacement policy
+ *
+ * Each entry is scored by the spatial correlativity (see ndn::StructuredNameView) of its Name
+ * with a reference Name.  The reference is the node location, if one is set, or else the Name
+ * of the latest Data that was used or inserted solicited.  The entry with the lowest score is
+ * evicted first, the oldest one among equal scores, so Data about far-away regions leaves
+ * before Data about the current region, and a new entry less correlated than every stored
+ * one is not admitted.  Names without spatial segment score 0 and are evicted in FIFO order.
+ *
+ * An entry is scored when it is inserted, refreshed or used.  When the reference moves,
+ * scores are not recomputed at once: an entry about to be evicted with a score of an older
+ * reference is rescored and put back into the index, at most MAX_RESCORE times per eviction.
+ */
+class CorrelativityPolicy : public Policy
+{
+public:
+  CorrelativityPolicy();
+
+  /** \brief sets the node location
+   *  \param location a Name with a spatial segment, e.g. /S/<region>/<cell>/A;
+   *                  an empty Name makes the reference follow request again
+   */
+  void
+  setLocation(const Name& location);
+
+public:
+  static const std::string POLICY_NAME;
+
+  static const int MAX_RESCORE;
+
+private:
+  virtual void
+  doAfterInsert(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doAfterRefresh(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeErase(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  doBeforeUse(iterator i) DECL_OVERRIDE;
+
+  virtual void
+  evictEntries() DECL_OVERRIDE;
+
+private:
+  /** \brief evicts one entry
+   *  \pre CS is not empty
+   */
+  void
+  evictOne();
+
+  /** \brief makes the Name the reference, if it has a spatial segment unlike the current one
+   */
+  void
+  setReference(const Name& name);
+
+  /** \brief (re)inserts the entry into the score index with its score for the reference
+   */
+  void
+  score(iterator i, EntryInfo& info, uint64_t tick);
+
+private:
+  EntryInfoMap m_entryInfoMap;
+  ScoreIndex m_scoreIndex;
+  uint64_t m_tick;
+
+  bool m_hasLocation;
+  Name m_reference;
+  ndn::StructuredNameView m_referenceView;
+  uint64_t m_generation;
+};
+
+} // namespace correlativity
+
+using correlativity::CorrelativityPolicy;
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_POLICY_CORRELATIVITY_HPP
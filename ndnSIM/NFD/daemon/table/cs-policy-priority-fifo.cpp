@@ -64,12 +64,23 @@ PriorityFifoPolicy::doBeforeUse(iterator i)
   BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
 }
 
+void
+PriorityFifoPolicy::doAfterStale(iterator i)
+{
+  BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
+
+  // an unsolicited entry stays in the queue evicted first
+  if (m_entryInfoMap[i]->queueType == QUEUE_FIFO) {
+    this->moveToStaleQueue(i);
+  }
+}
+
 void
 PriorityFifoPolicy::evictEntries()
 {
   BOOST_ASSERT(this->getCs() != nullptr);
 
-  while (this->getCs()->size() > this->getLimit()) {
+  while (this->isOverLimit()) {
     this->evictOne();
   }
 }
@@ -109,12 +120,8 @@ PriorityFifoPolicy::attachQueue(iterator i)
     entryInfo->queueType = QUEUE_STALE;
   }
   else {
+    // CS invokes afterStale when the entry becomes stale
     entryInfo->queueType = QUEUE_FIFO;
-
-    if (i->canStale()) {
-      entryInfo->moveStaleEventId = scheduler::schedule(i->getData().getFreshnessPeriod(),
-                                              bind(&PriorityFifoPolicy::moveToStaleQueue, this, i));
-    }
   }
 
   Queue& queue = m_queues[entryInfo->queueType];
@@ -128,10 +135,6 @@ PriorityFifoPolicy::detachQueue(iterator i)
   BOOST_ASSERT(m_entryInfoMap.find(i) != m_entryInfoMap.end());
 
   EntryInfo* entryInfo = m_entryInfoMap[i];
-  if (entryInfo->queueType == QUEUE_FIFO) {
-    scheduler::cancel(entryInfo->moveStaleEventId);
-  }
-
   m_queues[entryInfo->queueType].erase(entryInfo->queueIt);
   m_entryInfoMap.erase(i);
 }
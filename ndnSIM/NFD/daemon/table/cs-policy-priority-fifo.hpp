@@ -28,7 +28,6 @@
 
 #include "cs-policy.hpp"
 #include "common.hpp"
-#include "core/scheduler.hpp"
 
 namespace nfd {
 namespace cs {
@@ -48,7 +47,6 @@ struct EntryInfo
 {
   QueueType queueType;
   QueueIt queueIt;
-  scheduler::EventId moveStaleEventId;
 };
 
 struct EntryItComparator
@@ -91,6 +89,9 @@ private:
   virtual void
   doBeforeUse(iterator i) DECL_OVERRIDE;
 
+  virtual void
+  doAfterStale(iterator i) DECL_OVERRIDE;
+
   virtual void
   evictEntries() DECL_OVERRIDE;
 
@@ -26,11 +26,14 @@
 #include "cs-policy.hpp"
 #include "cs.hpp"
 
+#include <limits>
+
 namespace nfd {
 namespace cs {
 
 Policy::Policy(const std::string& policyName)
   : m_policyName(policyName)
+  , m_limitBytes(std::numeric_limits<size_t>::max())
 {
 }
 
@@ -47,6 +50,21 @@ Policy::setLimit(size_t nMaxEntries)
   this->evictEntries();
 }
 
+void
+Policy::setLimitBytes(size_t nMaxBytes)
+{
+  BOOST_ASSERT(nMaxBytes > 0);
+  m_limitBytes = nMaxBytes;
+
+  this->evictEntries();
+}
+
+bool
+Policy::isOverLimit() const
+{
+  return m_cs->size() > m_limit || m_cs->getNBytes() > m_limitBytes;
+}
+
 void
 Policy::afterInsert(iterator i)
 {
@@ -75,5 +93,17 @@ Policy::beforeUse(iterator i)
   this->doBeforeUse(i);
 }
 
+void
+Policy::afterStale(iterator i)
+{
+  BOOST_ASSERT(m_cs != nullptr);
+  this->doAfterStale(i);
+}
+
+void
+Policy::doAfterStale(iterator i)
+{
+}
+
 } // namespace cs
 } // namespace nfd
@@ -73,6 +73,22 @@ public:
   void
   setLimit(size_t nMaxEntries);
 
+  /** \brief gets hard limit (in octets of wire encoding of stored Data)
+   */
+  size_t
+  getLimitBytes() const;
+
+  /** \brief sets hard limit (in octets of wire encoding of stored Data)
+   *  \post getLimitBytes() == nMaxBytes
+   *  \post cs.getNBytes() <= getLimitBytes()
+   *
+   *  The policy may evict entries if necessary.
+   *  This limit applies together with the limit in number of entries.
+   *  It is std::numeric_limits<size_t>::max() (no limit) unless set.
+   */
+  void
+  setLimitBytes(size_t nMaxBytes);
+
   /** \brief emits when an entry is being evicted
    *
    *  A policy implementation should emit this signal to cause CS to erase the entry from its index.
@@ -109,6 +125,14 @@ public:
   void
   beforeUse(iterator i);
 
+  /** \brief invoked by CS after an entry becomes stale
+   *  \note This will not be invoked if CS erases stale entries, see Cs::setEvictStale.
+   *
+   *  The policy may give \p i a lower priority than fresh entries.
+   */
+  void
+  afterStale(iterator i);
+
 protected:
   /** \brief invoked after a new entry is created in CS
    *
@@ -146,18 +170,32 @@ protected:
   virtual void
   doBeforeUse(iterator i) = 0;
 
+  /** \brief invoked after an entry becomes stale
+   *
+   *  When overridden in a subclass, a policy implementation may move \p i
+   *  within its cleanup index.  The default implementation does nothing.
+   */
+  virtual void
+  doAfterStale(iterator i);
+
   /** \brief evicts zero or more entries
-   *  \post CS size does not exceed hard limit
+   *  \post CS size does not exceed hard limits
    */
   virtual void
   evictEntries() = 0;
 
+  /** \return whether CS size exceeds either hard limit, in which case an entry should be evicted
+   */
+  bool
+  isOverLimit() const;
+
 protected:
   DECLARE_SIGNAL_EMIT(beforeEvict)
 
 private:
   std::string m_policyName;
   size_t m_limit;
+  size_t m_limitBytes;
   Cs* m_cs;
 };
 
@@ -185,6 +223,12 @@ Policy::getLimit() const
   return m_limit;
 }
 
+inline size_t
+Policy::getLimitBytes() const
+{
+  return m_limitBytes;
+}
+
 } // namespace cs
 } // namespace nfd
 
@@ -25,8 +25,12 @@
 
 #include "cs.hpp"
 #include "cs-policy-priority-fifo.hpp"
+#include "cs-policy-lru.hpp"
+#include "cs-policy-2q.hpp"
+#include "cs-policy-correlativity.hpp"
 #include "core/logger.hpp"
 #include "core/algorithm.hpp"
+#include "utils/ndn-profiler-zones.hpp"
 
 NFD_LOG_INIT("ContentStore");
 
@@ -50,7 +54,28 @@ makeDefaultPolicy()
   return unique_ptr<Policy>(new PriorityFifoPolicy());
 }
 
+unique_ptr<Policy>
+makePolicy(const std::string& policyName)
+{
+  if (policyName == PriorityFifoPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new PriorityFifoPolicy());
+  }
+  if (policyName == LruPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new LruPolicy());
+  }
+  if (policyName == TwoQPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new TwoQPolicy());
+  }
+  if (policyName == CorrelativityPolicy::POLICY_NAME) {
+    return unique_ptr<Policy>(new CorrelativityPolicy());
+  }
+  return nullptr;
+}
+
 Cs::Cs(size_t nMaxPackets, unique_ptr<Policy> policy)
+  : m_nBytes(0)
+  , m_shouldEvictStale(false)
+  , m_hasStaleEvent(false)
 {
   this->setPolicyImpl(policy);
   m_policy->setLimit(nMaxPackets);
@@ -68,14 +93,40 @@ Cs::getLimit() const
   return m_policy->getLimit();
 }
 
+void
+Cs::setLimitBytes(size_t nMaxBytes)
+{
+  m_policy->setLimitBytes(nMaxBytes);
+}
+
+size_t
+Cs::getLimitBytes() const
+{
+  return m_policy->getLimitBytes();
+}
+
 void
 Cs::setPolicy(unique_ptr<Policy> policy)
 {
   BOOST_ASSERT(policy != nullptr);
   BOOST_ASSERT(m_policy != nullptr);
   size_t limit = m_policy->getLimit();
+  size_t limitBytes = m_policy->getLimitBytes();
   this->setPolicyImpl(policy);
   m_policy->setLimit(limit);
+  m_policy->setLimitBytes(limitBytes);
+}
+
+size_t
+Cs::getMemoryUsage() const
+{
+  // a std::set node has three links and a color next to the EntryImpl,
+  // the Data object shares its control block allocation
+  size_t perEntry = sizeof(EntryImpl) + 4 * sizeof(void*) + sizeof(Data) + 2 * sizeof(void*);
+  // an unordered_map node has the link and the cached hash next to the key-value pair
+  size_t perIndexItem = sizeof(ExactIndex::value_type) + 2 * sizeof(void*);
+  return m_nBytes + m_table.size() * perEntry +
+         m_exactIndex.size() * perIndexItem + m_exactIndex.bucket_count() * sizeof(void*);
 }
 
 bool
@@ -107,9 +158,16 @@ Cs::insert(const Data& data, bool isUnsolicited)
       entry.unsetUnsolicited();
     }
 
+    this->freshnessErase(it);
+    this->freshnessInsert(it);
     m_policy->afterRefresh(it);
   }
   else {
+    // index and count first, afterInsert may evict the entry right away
+    this->indexInsert(it);
+    m_nBytes += data.wireEncode().size();
+    this->afterNBytesChange(m_nBytes);
+    this->freshnessInsert(it);
     m_policy->afterInsert(it);
   }
 
@@ -121,6 +179,7 @@ Cs::find(const Interest& interest,
          const HitCallback& hitCallback,
          const MissCallback& missCallback) const
 {
+  NDN_PROFILE_ZONE("Cs::find");
   BOOST_ASSERT(static_cast<bool>(hitCallback));
   BOOST_ASSERT(static_cast<bool>(missCallback));
 
@@ -128,18 +187,30 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
-  iterator first = m_table.lower_bound(prefix);
+  Matcher matcher(interest); // selectors are prepared once for all candidates
+  iterator match = isRightmost ? m_table.end() : this->findExact(interest, matcher);
   iterator last = m_table.end();
-  if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
+  if (match != last) {
+    NFD_LOG_TRACE("  exact-index");
   }
-
-  iterator match = last;
-  if (isRightmost) {
-    match = this->findRightmost(interest, first, last);
+  else if (isRightmost) {
+    iterator first = m_table.lower_bound(prefix);
+    if (prefix.size() > 0) {
+      last = m_table.lower_bound(prefix.getSuccessor());
+    }
+    match = this->findRightmost(interest.getName().size(), matcher, first, last);
   }
   else {
-    match = this->findLeftmost(interest, first, last);
+    // entries under the prefix are contiguous from lower_bound, no need to find the successor
+    for (match = m_table.lower_bound(prefix); match != last; ++match) {
+      if (!prefix.isPrefixOf(match->getFullName())) {
+        match = last;
+        break;
+      }
+      if (matcher.matches(*match)) {
+        break;
+      }
+    }
   }
 
   if (match == last) {
@@ -153,26 +224,26 @@ Cs::find(const Interest& interest,
 }
 
 iterator
-Cs::findLeftmost(const Interest& interest, iterator first, iterator last) const
+Cs::findLeftmost(const Matcher& matcher, iterator first, iterator last) const
 {
-  return std::find_if(first, last, bind(&cs::EntryImpl::canSatisfy, _1, interest));
+  return std::find_if(first, last, bind(&Matcher::matches, &matcher, _1));
 }
 
 iterator
-Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
+Cs::findRightmost(size_t interestNameLength, const Matcher& matcher,
+                  iterator first, iterator last) const
 {
   // Each loop visits a sub-namespace under a prefix one component longer than Interest Name.
   // If there is a match in that sub-namespace, the leftmost match is returned;
   // otherwise, loop continues.
 
-  size_t interestNameLength = interest.getName().size();
   for (iterator right = last; right != first;) {
     iterator prev = std::prev(right);
 
     // special case: [first,prev] have exact Names
     if (prev->getName().size() == interestNameLength) {
       NFD_LOG_TRACE("  find-among-exact " << prev->getName());
-      iterator matchExact = this->findRightmostAmongExact(interest, first, right);
+      iterator matchExact = this->findRightmostAmongExact(matcher, first, right);
       return matchExact == right ? last : matchExact;
     }
 
@@ -181,7 +252,7 @@ Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
 
     // normal case: [left,right) are under one-component-longer prefix
     NFD_LOG_TRACE("  find-under-prefix " << prefix);
-    iterator match = this->findLeftmost(interest, left, right);
+    iterator match = this->findLeftmost(matcher, left, right);
     if (match != right) {
       return match;
     }
@@ -191,23 +262,170 @@ Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
 }
 
 iterator
-Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const
+Cs::findExact(const Interest& interest, const Matcher& matcher) const
+{
+  const Name& prefix = interest.getName();
+  ExactIndex::const_iterator found = m_exactIndex.find(&prefix);
+  if (found == m_exactIndex.end()) {
+    return m_table.end();
+  }
+
+  // Data Names that extend the prefix with a digest component could sort before the entry
+  iterator entry = found->second;
+  if (entry != m_table.begin() && prefix.isPrefixOf(std::prev(entry)->getName())) {
+    return m_table.end();
+  }
+
+  return matcher.matches(*entry) ? entry : m_table.end();
+}
+
+void
+Cs::indexInsert(iterator it)
+{
+  ExactIndex::iterator found;
+  bool isNew = false;
+  std::tie(found, isNew) = m_exactIndex.insert({&it->getName(), it});
+  if (!isNew && *it < *found->second) {
+    // the key must point to the Name of the indexed entry
+    m_exactIndex.erase(found);
+    m_exactIndex.insert({&it->getName(), it});
+  }
+}
+
+void
+Cs::indexErase(iterator it)
+{
+  ExactIndex::iterator found = m_exactIndex.find(&it->getName());
+  if (found == m_exactIndex.end() || found->second != it) {
+    return;
+  }
+  m_exactIndex.erase(found);
+
+  // entries with the same Name are next to each other, ordered by implicit digest
+  iterator next = std::next(it);
+  if (next != m_table.end() && next->getName() == it->getName()) {
+    m_exactIndex.insert({&next->getName(), next});
+  }
+}
+
+iterator
+Cs::findRightmostAmongExact(const Matcher& matcher, iterator first, iterator last) const
 {
-  return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
+  return find_last_if(first, last, bind(&Matcher::matches, &matcher, _1));
 }
 
 void
 Cs::setPolicyImpl(unique_ptr<Policy>& policy)
 {
   m_policy = std::move(policy);
-  m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
-      m_table.erase(it);
-    });
+  m_beforeEvictConnection = m_policy->beforeEvict.connect(bind(&Cs::eraseEntry, this, _1));
 
   m_policy->setCs(this);
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+void
+Cs::eraseEntry(iterator it)
+{
+  this->freshnessErase(it);
+  this->indexErase(it);
+  m_nBytes -= it->getData().wireEncode().size();
+  m_table.erase(it);
+  this->afterNBytesChange(m_nBytes);
+}
+
+void
+Cs::freshnessInsert(iterator it)
+{
+  if (!it->canStale()) {
+    return;
+  }
+
+  std::deque<FreshnessRecord>& queue =
+    m_freshnessQueues[time::milliseconds(it->getData().getFreshnessPeriod())];
+  queue.push_back(FreshnessRecord{it->getStaleTime(), it, true});
+  const_cast<EntryImpl&>(*it).setFreshnessRecord(&queue.back());
+
+  if (!m_hasStaleEvent || it->getStaleTime() < m_nextStaleTime) {
+    this->scheduleStale();
+  }
+}
+
+void
+Cs::freshnessErase(iterator it)
+{
+  FreshnessRecord* record = it->getFreshnessRecord();
+  if (record == nullptr) {
+    return;
+  }
+  // the record is dropped when it reaches the front of its queue
+  record->isValid = false;
+  const_cast<EntryImpl&>(*it).setFreshnessRecord(nullptr);
+}
+
+void
+Cs::processStale()
+{
+  m_hasStaleEvent = false;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  for (FreshnessQueues::iterator q = m_freshnessQueues.begin(); q != m_freshnessQueues.end();) {
+    std::deque<FreshnessRecord>& queue = q->second;
+    while (!queue.empty() && (!queue.front().isValid || queue.front().staleTime <= now)) {
+      FreshnessRecord record = queue.front();
+      if (record.isValid) {
+        const_cast<EntryImpl&>(*record.entry).setFreshnessRecord(nullptr);
+      }
+      queue.pop_front();
+
+      if (!record.isValid) {
+        continue;
+      }
+      if (m_shouldEvictStale) {
+        NFD_LOG_DEBUG("evict-stale " << record.entry->getName());
+        m_policy->beforeErase(record.entry);
+        this->eraseEntry(record.entry);
+      }
+      else {
+        m_policy->afterStale(record.entry);
+      }
+    }
+
+    if (queue.empty()) {
+      q = m_freshnessQueues.erase(q);
+    }
+    else {
+      ++q;
+    }
+  }
+
+  this->scheduleStale();
+}
+
+void
+Cs::scheduleStale()
+{
+  if (m_freshnessQueues.empty()) {
+    m_staleEvent.cancel();
+    m_hasStaleEvent = false;
+    return;
+  }
+
+  // there are few distinct FreshnessPeriods, so all queue fronts are visited
+  time::steady_clock::TimePoint next = time::steady_clock::TimePoint::max();
+  for (const FreshnessQueues::value_type& q : m_freshnessQueues) {
+    next = std::min(next, q.second.front().staleTime);
+  }
+
+  m_nextStaleTime = next;
+  m_hasStaleEvent = true;
+  time::nanoseconds delay = next - time::steady_clock::now();
+  if (delay < time::nanoseconds::zero()) {
+    delay = time::nanoseconds::zero();
+  }
+  m_staleEvent = scheduler::schedule(delay, bind(&Cs::processStale, this));
+}
+
 void
 Cs::dump()
 {
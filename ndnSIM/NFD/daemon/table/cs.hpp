@@ -43,6 +43,15 @@
  *  Within each queue, the iterators are kept in first-in-first-out order.
  *  Eviction procedure exhausts the first queue before moving onto the next queue,
  *  in the order of unsolicited, stale, and fresh queue.
+ *
+ *  Stale times are tracked by freshness queues, one FIFO queue of FreshnessRecords per
+ *  FreshnessPeriod.  Within a queue, records are ordered by stale time, so a single timer
+ *  at the earliest front is enough.  When an entry becomes stale, it is either erased or
+ *  handed to the policy, which may demote it; each entry costs amortized O(1).
+ *
+ *  Besides the Table, a hash index maps each Data Name to the Table entry with that Name
+ *  and the smallest implicit digest.  That entry is the leftmost one under its Name, so an
+ *  Interest that it satisfies is answered without searching the Table.
  */
 
 #ifndef NFD_DAEMON_TABLE_CS_HPP
@@ -51,6 +60,8 @@
 #include "cs-policy.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "cs-matcher.hpp"
+#include "core/scheduler.hpp"
 #include <ndn-cxx/util/signal.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -60,6 +71,13 @@ namespace cs {
 unique_ptr<Policy>
 makeDefaultPolicy();
 
+/** \brief creates a cs replacement policy by its name
+ *  \param policyName "fifo" (priority FIFO), "lru", "2q" or "correlativity"
+ *  \return the policy, or nullptr if \p policyName is unknown
+ */
+unique_ptr<Policy>
+makePolicy(const std::string& policyName);
+
 /** \brief represents the ContentStore
  */
 class Cs : noncopyable
@@ -105,6 +123,36 @@ public:
   size_t
   getLimit() const;
 
+  /** \brief changes capacity (in octets of wire encoding of stored Data)
+   *
+   *  Entries are evicted until both this limit and the limit in number of packets hold.
+   */
+  void
+  setLimitBytes(size_t nMaxBytes);
+
+  /** \return capacity (in octets of wire encoding of stored Data)
+   */
+  size_t
+  getLimitBytes() const;
+
+  /** \brief sets whether entries are erased when they become stale
+   *
+   *  If false (default), stale entries are kept to satisfy Interests without MustBeFresh,
+   *  and the policy is informed through Policy::afterStale.
+   *  The setting applies to entries becoming stale afterwards.
+   */
+  void
+  setEvictStale(bool shouldEvictStale)
+  {
+    m_shouldEvictStale = shouldEvictStale;
+  }
+
+  bool
+  getEvictStale() const
+  {
+    return m_shouldEvictStale;
+  }
+
   /** \brief changes cs replacement policy
    *  \pre size() == 0
    */
@@ -127,6 +175,24 @@ public:
     return m_table.size();
   }
 
+  /** \return total size of the wire encoding of stored packets
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
+  /** \return approximate number of bytes used by stored packets and the index structures
+   *  \note bookkeeping of the replacement policy is not included
+   */
+  size_t
+  getMemoryUsage() const;
+
+  /** \brief emits after getNBytes() changes, with the new value
+   */
+  signal::Signal<Cs, size_t> afterNBytesChange;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
@@ -159,32 +225,121 @@ public: // enumeration
     return boost::make_transform_iterator(m_table.end(), EntryFromEntryImpl());
   }
 
+  /** \return the first entry whose Name is not less than \p name
+   *
+   *  Entries are ordered by Name, so the entries under a prefix start at lowerBound(prefix).
+   */
+  const_iterator
+  lowerBound(const Name& name) const
+  {
+    return boost::make_transform_iterator(m_table.lower_bound(name), EntryFromEntryImpl());
+  }
+
 private: // find
   /** \brief find leftmost match in [first,last)
    *  \return the leftmost match, or last if not found
    */
   iterator
-  findLeftmost(const Interest& interest, iterator left, iterator right) const;
+  findLeftmost(const Matcher& matcher, iterator left, iterator right) const;
 
   /** \brief find rightmost match in [first,last)
    *  \return the rightmost match, or last if not found
    */
   iterator
-  findRightmost(const Interest& interest, iterator first, iterator last) const;
+  findRightmost(size_t interestNameLength, const Matcher& matcher,
+                iterator first, iterator last) const;
 
   /** \brief find rightmost match among entries with exact Names in [first,last)
    *  \return the rightmost match, or last if not found
    */
   iterator
-  findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
+  findRightmostAmongExact(const Matcher& matcher, iterator first, iterator last) const;
 
   void
   setPolicyImpl(unique_ptr<Policy>& policy);
 
+  /** \brief erases the entry from the Table and the indexes
+   *  \note the policy must have forgotten the entry
+   */
+  void
+  eraseEntry(iterator it);
+
+private: // exact Name index
+  struct NamePtrHash
+  {
+    size_t
+    operator()(const Name* name) const
+    {
+      return std::hash<Name>()(*name);
+    }
+  };
+
+  struct NamePtrEqual
+  {
+    bool
+    operator()(const Name* lhs, const Name* rhs) const
+    {
+      return *lhs == *rhs;
+    }
+  };
+
+  /** \brief Data Name => leftmost Table entry with that Name
+   *  \note keys point to the Name of the Data in the entry
+   */
+  typedef std::unordered_map<const Name*, iterator, NamePtrHash, NamePtrEqual> ExactIndex;
+
+  /** \brief find the entry in the exact Name index if it is the leftmost match of the Interest
+   *  \return the match, or m_table.end() if the Table has to be searched
+   */
+  iterator
+  findExact(const Interest& interest, const Matcher& matcher) const;
+
+  void
+  indexInsert(iterator it);
+
+  /** \brief remove the entry from the exact Name index, before it is erased from the Table
+   */
+  void
+  indexErase(iterator it);
+
+private: // freshness queues
+  /** \brief appends a record of the entry to the queue of its FreshnessPeriod
+   */
+  void
+  freshnessInsert(iterator it);
+
+  /** \brief invalidates the record of the entry, if any
+   */
+  void
+  freshnessErase(iterator it);
+
+  /** \brief handles entries that became stale, and reschedules the timer
+   */
+  void
+  processStale();
+
+  /** \brief schedules the timer at the earliest stale time among queue fronts
+   */
+  void
+  scheduleStale();
+
+  /** \brief FreshnessPeriod => records in order of stale time
+   *  \note std::deque keeps references to records valid on push_back and pop_front
+   */
+  typedef std::map<time::milliseconds, std::deque<FreshnessRecord>> FreshnessQueues;
+
 private:
   Table m_table;
+  ExactIndex m_exactIndex;
+  size_t m_nBytes;
   unique_ptr<Policy> m_policy;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
+
+  FreshnessQueues m_freshnessQueues;
+  bool m_shouldEvictStale;
+  scheduler::ScopedEventId m_staleEvent;
+  bool m_hasStaleEvent;
+  time::steady_clock::TimePoint m_nextStaleTime;
 };
 
 } // namespace cs
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-filter.hpp"
+#include "core/logger.hpp"
+
+#include <cmath>
+
+NFD_LOG_INIT("DeadNonceFilter");
+
+namespace nfd {
+
+const size_t DeadNonceFilter::NSLICES = 4;
+const size_t DeadNonceFilter::MIN_SLICE_CAPACITY = (1 << 6);
+
+DeadNonceFilter::DeadNonceFilter(const time::nanoseconds& lifetime, double falsePositiveRate)
+  : m_lifetime(lifetime)
+  , m_falsePositiveRate(falsePositiveRate)
+  , m_nRecentAdds(0)
+{
+  if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("falsePositiveRate must be within (0, 1)"));
+  }
+
+  // slices of up to NSLICES + 1 intervals are consulted for every lookup,
+  // and the slices opened within one interval have at most twice the rate of the first
+  m_sliceFalsePositiveRate = m_falsePositiveRate / (2 * (NSLICES + 1));
+
+  this->openSlice(MIN_SLICE_CAPACITY, m_sliceFalsePositiveRate);
+  m_rotateEvent = scheduler::schedule(m_lifetime / NSLICES,
+                                      bind(&DeadNonceFilter::rotate, this));
+}
+
+DeadNonceFilter::~DeadNonceFilter()
+{
+  scheduler::cancel(m_rotateEvent);
+}
+
+bool
+DeadNonceFilter::has(uint64_t entry) const
+{
+  for (const Slice& slice : m_slices) {
+    if (sliceHas(slice, entry))
+      return true;
+  }
+  return false;
+}
+
+void
+DeadNonceFilter::add(uint64_t entry)
+{
+  if (m_slices.back().size >= m_slices.back().capacity) {
+    NFD_LOG_TRACE("add slice full capacity=" << m_slices.back().capacity);
+    this->openSlice(m_slices.back().capacity * 2, m_slices.back().falsePositiveRate / 2);
+  }
+
+  sliceAdd(m_slices.back(), entry);
+  ++m_nRecentAdds;
+}
+
+size_t
+DeadNonceFilter::size() const
+{
+  size_t n = 0;
+  for (const Slice& slice : m_slices) {
+    n += slice.size;
+  }
+  return n;
+}
+
+size_t
+DeadNonceFilter::getMemoryUsage() const
+{
+  size_t n = sizeof(*this);
+  for (const Slice& slice : m_slices) {
+    n += sizeof(Slice) + slice.bits.capacity() * sizeof(uint64_t);
+  }
+  return n;
+}
+
+void
+DeadNonceFilter::openSlice(size_t capacity, double falsePositiveRate)
+{
+  static const double LN2 = std::log(2.0);
+
+  Slice slice;
+  slice.capacity = capacity;
+  slice.falsePositiveRate = falsePositiveRate;
+  slice.size = 0;
+  slice.start = time::steady_clock::now();
+
+  // optimal Bloom filter for capacity entries at falsePositiveRate
+  double bitsPerEntry = -std::log(falsePositiveRate) / (LN2 * LN2);
+  slice.nBits = static_cast<size_t>(std::ceil(bitsPerEntry * capacity));
+  slice.nBits = (slice.nBits + 63) / 64 * 64;
+  slice.nHashes = std::max<size_t>(1, static_cast<size_t>(std::round(bitsPerEntry * LN2)));
+  slice.bits.assign(slice.nBits / 64, 0);
+
+  m_slices.push_back(std::move(slice));
+}
+
+void
+DeadNonceFilter::rotate()
+{
+  // headroom of 1/4 over the rate of the last interval
+  this->openSlice(std::max(MIN_SLICE_CAPACITY, m_nRecentAdds + m_nRecentAdds / 4),
+                  m_sliceFalsePositiveRate);
+  m_nRecentAdds = 0;
+
+  // a slice is expired when the slice after it is older than lifetime,
+  // because all its entries were added before the next slice was opened
+  time::steady_clock::TimePoint expiry = time::steady_clock::now() - m_lifetime;
+  while (m_slices.size() > 1 && m_slices[1].start <= expiry) {
+    m_slices.pop_front();
+  }
+
+  NFD_LOG_TRACE("rotate nSlices=" << m_slices.size() <<
+                " capacity=" << m_slices.back().capacity);
+
+  m_rotateEvent = scheduler::schedule(m_lifetime / NSLICES,
+                                      bind(&DeadNonceFilter::rotate, this));
+}
+
+bool
+DeadNonceFilter::sliceHas(const Slice& slice, uint64_t entry)
+{
+  // entry is already a hash; derive bit positions by double hashing
+  uint64_t delta = (entry >> 32) | 1;
+  for (size_t i = 0; i < slice.nHashes; ++i, entry += delta) {
+    size_t bit = entry % slice.nBits;
+    if ((slice.bits[bit / 64] & (uint64_t(1) << (bit % 64))) == 0)
+      return false;
+  }
+  return true;
+}
+
+void
+DeadNonceFilter::sliceAdd(Slice& slice, uint64_t entry)
+{
+  uint64_t delta = (entry >> 32) | 1;
+  for (size_t i = 0; i < slice.nHashes; ++i, entry += delta) {
+    size_t bit = entry % slice.nBits;
+    slice.bits[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+  ++slice.size;
+}
+
+} // namespace nfd
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
+
+#include "common.hpp"
+#include "core/scheduler.hpp"
+
+#include <deque>
+
+namespace nfd {
+
+/** \brief a time-sliced Bloom filter of Dead Nonce List entries
+ *
+ *  Entries are inserted into the newest slice, a Bloom filter sized for the insertion rate
+ *  observed during the previous slice interval. Every lifetime/NSLICES a new slice is opened,
+ *  and slices whose newest entry is older than lifetime are dropped as a whole, so that
+ *  no counters or timestamps need to be stored per entry.
+ *
+ *  If a slice receives more entries than it has been sized for, a new slice of double
+ *  capacity and half the false positive rate is opened early, so that the false positive
+ *  rate of all slices opened within one interval is bounded under bursts.
+ */
+class DeadNonceFilter : noncopyable
+{
+public:
+  /** \brief constructs the filter
+   *  \param lifetime minimum duration each entry is kept
+   *  \param falsePositiveRate expected probability that has() returns true for an entry
+   *         that has not been added, must be within (0, 1)
+   *  \throw std::invalid_argument if falsePositiveRate is out of range
+   */
+  DeadNonceFilter(const time::nanoseconds& lifetime, double falsePositiveRate);
+
+  ~DeadNonceFilter();
+
+  /** \return true if entry has been added in the last lifetime, or with false positive rate
+   */
+  bool
+  has(uint64_t entry) const;
+
+  void
+  add(uint64_t entry);
+
+  /** \return number of entries added to slices that are still kept
+   */
+  size_t
+  size() const;
+
+  /** \return number of bytes used by the slices
+   */
+  size_t
+  getMemoryUsage() const;
+
+  double
+  getFalsePositiveRate() const
+  {
+    return m_falsePositiveRate;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct Slice
+  {
+    std::vector<uint64_t> bits;
+    size_t nBits;
+    size_t nHashes;
+    size_t capacity;
+    double falsePositiveRate;
+    size_t size;
+    time::steady_clock::TimePoint start;
+  };
+
+  /** \brief opens a new slice for \p capacity entries at \p falsePositiveRate
+   */
+  void
+  openSlice(size_t capacity, double falsePositiveRate);
+
+  /** \brief opens a new slice sized for the recent insertion rate, and drops expired slices
+   */
+  void
+  rotate();
+
+  static bool
+  sliceHas(const Slice& slice, uint64_t entry);
+
+  static void
+  sliceAdd(Slice& slice, uint64_t entry);
+
+  /// number of slice intervals per lifetime
+  static const size_t NSLICES;
+
+  static const size_t MIN_SLICE_CAPACITY;
+
+  /// slices from oldest to newest
+  std::deque<Slice> m_slices;
+
+private:
+  time::nanoseconds m_lifetime;
+  double m_falsePositiveRate;
+  /// false positive rate of slices opened on rotation
+  double m_sliceFalsePositiveRate;
+  size_t m_nRecentAdds;
+  scheduler::EventId m_rotateEvent;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_FILTER_HPP
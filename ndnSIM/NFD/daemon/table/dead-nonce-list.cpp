@@ -42,7 +42,7 @@ const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
-DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
+DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime, double falsePositiveRate)
   : m_lifetime(lifetime)
   , m_queue(m_index.get<0>())
   , m_ht(m_index.get<1>())
@@ -54,6 +54,11 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
+  if (falsePositiveRate != 0.0) {
+    m_filter.reset(new DeadNonceFilter(m_lifetime, falsePositiveRate));
+    return;
+  }
+
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
     m_queue.push_back(MARK);
   }
@@ -83,13 +88,30 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
+  if (m_filter != nullptr) {
+    return m_filter->size();
+  }
   return m_queue.size() - this->countMarks();
 }
 
+size_t
+DeadNonceList::getMemoryUsage() const
+{
+  if (m_filter != nullptr) {
+    return m_filter->getMemoryUsage();
+  }
+  // each node carries the links of the sequenced index and the hashed_non_unique index
+  return m_index.size() * (sizeof(Entry) + 4 * sizeof(void*)) +
+         m_ht.bucket_count() * sizeof(void*);
+}
+
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    return m_filter->has(entry);
+  }
   return m_ht.find(entry) != m_ht.end();
 }
 
@@ -97,6 +119,10 @@ void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
+  if (m_filter != nullptr) {
+    m_filter->add(entry);
+    return;
+  }
   m_queue.push_back(entry);
 
   this->evictEntries();
@@ -31,6 +31,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
+#include "dead-nonce-filter.hpp"
 
 namespace nfd {
 
@@ -50,6 +51,9 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Alternatively, entries can be kept in a DeadNonceFilter, which needs a few bytes per entry
+ *  at the cost of a configurable false positive rate.
  */
 class DeadNonceList : noncopyable
 {
@@ -59,10 +63,14 @@ public:
    *         must be no less than MIN_LIFETIME.
    *         This should be set to the duration in which most loops would have occured.
    *         A loop cannot be detected if delay of the cycle is greater than lifetime.
-   *  \throw std::invalid_argument if lifetime is less than MIN_LIFETIME
+   *  \param falsePositiveRate if zero, entries are kept in an exact index;
+   *         otherwise, entries are kept in a DeadNonceFilter with this false positive rate
+   *  \throw std::invalid_argument if lifetime is less than MIN_LIFETIME,
+   *         or falsePositiveRate is not within [0, 1)
    */
   explicit
-  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
+  DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME,
+                double falsePositiveRate = 0.0);
 
   ~DeadNonceList();
 
@@ -88,6 +96,16 @@ public:
   const time::nanoseconds&
   getLifetime() const;
 
+  /** \return false positive rate of DeadNonceFilter, or zero if entries are kept exactly
+   */
+  double
+  getFalsePositiveRate() const;
+
+  /** \return approximate number of bytes used to store entries
+   */
+  size_t
+  getMemoryUsage() const;
+
 private: // Entry and Index
   typedef uint64_t Entry;
 
@@ -143,6 +161,7 @@ private:
   Index m_index;
   Queue& m_queue;
   Hashtable& m_ht;
+  unique_ptr<DeadNonceFilter> m_filter;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -217,6 +236,12 @@ DeadNonceList::getLifetime() const
   return m_lifetime;
 }
 
+inline double
+DeadNonceList::getFalsePositiveRate() const
+{
+  return m_filter == nullptr ? 0.0 : m_filter->getFalsePositiveRate();
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
@@ -26,6 +26,7 @@
 #include "fib.hpp"
 #include "pit-entry.hpp"
 #include "measurements-entry.hpp"
+#include "pool-allocator.hpp"
 
 #include <boost/concept/assert.hpp>
 #include <boost/concept_check.hpp>
@@ -49,6 +50,9 @@ BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Fib::const_iterator>));
 Fib::Fib(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_version(1)
+  , m_nLpmCacheHits(0)
+  , m_nLpmCacheMisses(0)
 {
 }
 
@@ -65,12 +69,18 @@ predicate_NameTreeEntry_hasFibEntry(const name_tree::Entry& entry)
 shared_ptr<fib::Entry>
 Fib::findLongestPrefixMatch(const Name& prefix) const
 {
-  shared_ptr<name_tree::Entry> nameTreeEntry =
-    m_nameTree.findLongestPrefixMatch(prefix, &predicate_NameTreeEntry_hasFibEntry);
-  if (static_cast<bool>(nameTreeEntry)) {
-    return nameTreeEntry->getFibEntry();
+  return this->findLongestPrefixMatch(prefix, name_tree::computeHashSet(prefix));
+}
+
+shared_ptr<fib::Entry>
+Fib::findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashSet) const
+{
+  // the longest existing prefix carries the cached match, usually the name itself
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.findLongestPrefixMatch(prefix, hashSet);
+  if (!static_cast<bool>(nameTreeEntry)) {
+    return s_emptyEntry;
   }
-  return s_emptyEntry;
+  return this->findLongestPrefixMatch(nameTreeEntry);
 }
 
 shared_ptr<fib::Entry>
@@ -79,12 +89,20 @@ Fib::findLongestPrefixMatch(shared_ptr<name_tree::Entry> nameTreeEntry) const
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return entry;
-  nameTreeEntry = m_nameTree.findLongestPrefixMatch(nameTreeEntry,
-                                                    &predicate_NameTreeEntry_hasFibEntry);
-  if (static_cast<bool>(nameTreeEntry)) {
-    return nameTreeEntry->getFibEntry();
+
+  entry = nameTreeEntry->getFibLpmCache(m_version);
+  if (static_cast<bool>(entry)) {
+    ++m_nLpmCacheHits;
+    return entry;
   }
-  return s_emptyEntry;
+  ++m_nLpmCacheMisses;
+
+  shared_ptr<name_tree::Entry> match =
+    m_nameTree.findLongestPrefixMatch(nameTreeEntry->getParent(),
+                                      &predicate_NameTreeEntry_hasFibEntry);
+  entry = static_cast<bool>(match) ? match->getFibEntry() : s_emptyEntry;
+  nameTreeEntry->setFibLpmCache(m_version, entry);
+  return entry;
 }
 
 shared_ptr<fib::Entry>
@@ -123,9 +141,10 @@ Fib::insert(const Name& prefix)
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
-  entry = make_shared<fib::Entry>(prefix);
+  entry = std::allocate_shared<fib::Entry>(PoolAllocator<fib::Entry>(), prefix);
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
+  ++m_version;
   return std::make_pair(entry, true);
 }
 
@@ -135,6 +154,7 @@ Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   --m_nItems;
+  ++m_version;
 }
 
 void
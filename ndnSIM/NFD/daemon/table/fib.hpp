@@ -57,6 +57,12 @@ public: // lookup
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const Name& prefix) const;
 
+  /** \brief performs a longest prefix match with precomputed hash values
+   *  \param hashSet hash values of \p prefix, as returned by name_tree::computeHashSet
+   */
+  shared_ptr<fib::Entry>
+  findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashSet) const;
+
   /// performs a longest prefix match
   shared_ptr<fib::Entry>
   findLongestPrefixMatch(const pit::Entry& pitEntry) const;
@@ -92,6 +98,23 @@ public: // mutation
   void
   removeNextHopFromAllEntries(shared_ptr<Face> face);
 
+public: // longest prefix match cache
+  /** \return FIB version, which changes whenever a FIB entry is inserted or erased
+   *
+   *  Each NameTree entry caches the result of its last longest prefix match together with
+   *  the version; the result is reused while the version is unchanged.
+   */
+  uint64_t
+  getVersion() const;
+
+  /// number of longest prefix matches answered from the cache
+  uint64_t
+  getNLpmCacheHits() const;
+
+  /// number of longest prefix matches that walked up the NameTree
+  uint64_t
+  getNLpmCacheMisses() const;
+
 public: // enumeration
   class const_iterator;
 
@@ -152,6 +175,9 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  uint64_t m_version;
+  mutable uint64_t m_nLpmCacheHits;
+  mutable uint64_t m_nLpmCacheMisses;
 
   /** \brief The empty FIB entry.
    *
@@ -168,6 +194,24 @@ Fib::size() const
   return m_nItems;
 }
 
+inline uint64_t
+Fib::getVersion() const
+{
+  return m_version;
+}
+
+inline uint64_t
+Fib::getNLpmCacheHits() const
+{
+  return m_nLpmCacheHits;
+}
+
+inline uint64_t
+Fib::getNLpmCacheMisses() const
+{
+  return m_nLpmCacheMisses;
+}
+
 inline Fib::const_iterator
 Fib::end() const
 {
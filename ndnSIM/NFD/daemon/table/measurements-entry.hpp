@@ -54,12 +54,16 @@ public:
   const Name&
   getName() const;
 
+  /** \return the time the entry expires, unless its lifetime is extended
+   */
+  const time::steady_clock::TimePoint&
+  getExpiry() const;
+
 private:
   Name m_name;
 
 private: // lifetime
   time::steady_clock::TimePoint m_expiry;
-  scheduler::EventId m_cleanup;
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
 
   friend class nfd::NameTree;
@@ -73,6 +77,12 @@ Entry::getName() const
   return m_name;
 }
 
+inline const time::steady_clock::TimePoint&
+Entry::getExpiry() const
+{
+  return m_expiry;
+}
+
 } // namespace measurements
 } // namespace nfd
 
@@ -38,6 +38,11 @@ Measurements::Measurements(NameTree& nameTree)
 {
 }
 
+Measurements::~Measurements()
+{
+  scheduler::cancel(m_sweepEvent);
+}
+
 shared_ptr<Entry>
 Measurements::get(name_tree::Entry& nte)
 {
@@ -50,8 +55,10 @@ Measurements::get(name_tree::Entry& nte)
   ++m_nItems;
 
   entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
-                                         bind(&Measurements::cleanup, this, ref(*entry)));
+  m_expiryQueue.push(QueueItem{entry->m_expiry, entry});
+  if (m_sweepEvent == nullptr || entry->m_expiry < m_sweepTime) {
+    this->scheduleSweep(entry->m_expiry);
+  }
 
   return entry;
 }
@@ -147,9 +154,8 @@ Measurements::extendLifetime(Entry& entry,
     return;
   }
 
-  scheduler::cancel(entry.m_cleanup);
+  // the queued item is renewed when it is swept
   entry.m_expiry = expiry;
-  entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
 }
 
 void
@@ -163,4 +169,47 @@ Measurements::cleanup(Entry& entry)
   }
 }
 
+size_t
+Measurements::getMemoryUsage() const
+{
+  return m_nItems * (sizeof(Entry) + 2 * sizeof(void*)) +
+         m_expiryQueue.size() * sizeof(QueueItem);
+}
+
+void
+Measurements::sweep()
+{
+  m_sweepEvent.reset();
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (!m_expiryQueue.empty() && m_expiryQueue.top().expiry <= now) {
+    shared_ptr<Entry> entry = m_expiryQueue.top().entry.lock();
+    m_expiryQueue.pop();
+    if (entry == nullptr) {
+      continue;
+    }
+
+    if (entry->m_expiry > now) {
+      m_expiryQueue.push(QueueItem{entry->m_expiry, entry});
+    }
+    else {
+      this->cleanup(*entry);
+    }
+  }
+
+  if (!m_expiryQueue.empty()) {
+    this->scheduleSweep(std::max(m_expiryQueue.top().expiry, now + getSweepInterval()));
+  }
+}
+
+void
+Measurements::scheduleSweep(const time::steady_clock::TimePoint& when)
+{
+  scheduler::cancel(m_sweepEvent);
+  m_sweepTime = when;
+  time::nanoseconds delay = when - time::steady_clock::now();
+  m_sweepEvent = scheduler::schedule(std::max(delay, time::nanoseconds::zero()),
+                                     bind(&Measurements::sweep, this));
+}
+
 } // namespace nfd
@@ -29,6 +29,8 @@
 #include "measurements-entry.hpp"
 #include "name-tree.hpp"
 
+#include <queue>
+
 namespace nfd {
 
 namespace fib {
@@ -71,6 +73,9 @@ public:
 } // namespace measurements
 
 /** \brief represents the Measurements table
+ *
+ *  Expired entries are erased in batches by a periodic sweep, so extending the lifetime
+ *  of an entry does not schedule any event.
  */
 class Measurements : noncopyable
 {
@@ -78,6 +83,8 @@ public:
   explicit
   Measurements(NameTree& nametree);
 
+  ~Measurements();
+
   /** \brief find or insert a Measurements entry for \p name
    */
   shared_ptr<measurements::Entry>
@@ -121,6 +128,13 @@ public:
   static time::nanoseconds
   getInitialLifetime();
 
+  /** \brief minimum interval between sweeps
+   *
+   *  An entry may be kept up to this long after its lifetime.
+   */
+  static time::nanoseconds
+  getSweepInterval();
+
   /** \brief extend lifetime of an entry
    *
    *  The entry will be kept until at least now()+lifetime.
@@ -131,10 +145,27 @@ public:
   size_t
   size() const;
 
+  /** \return approximate number of bytes used by the entries and the expiry queue
+   *  \note strategy information stored on the entries is not included
+   */
+  size_t
+  getMemoryUsage() const;
+
 private:
   void
   cleanup(measurements::Entry& entry);
 
+  /** \brief erases entries whose lifetime has ended
+   *
+   *  An entry is queued with the expiry it had when queued. If its lifetime has been extended
+   *  since, it is queued again with the extended expiry instead of being erased.
+   */
+  void
+  sweep();
+
+  void
+  scheduleSweep(const time::steady_clock::TimePoint& when);
+
   shared_ptr<measurements::Entry>
   get(name_tree::Entry& nte);
 
@@ -147,6 +178,24 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+
+  struct QueueItem
+  {
+    time::steady_clock::TimePoint expiry;
+    weak_ptr<measurements::Entry> entry;
+
+    bool
+    operator>(const QueueItem& other) const
+    {
+      return expiry > other.expiry;
+    }
+  };
+
+  /// one item per entry, earliest queued expiry first
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> m_expiryQueue;
+
+  scheduler::EventId m_sweepEvent;
+  time::steady_clock::TimePoint m_sweepTime;
 };
 
 inline time::nanoseconds
@@ -155,6 +204,12 @@ Measurements::getInitialLifetime()
   return time::seconds(4);
 }
 
+inline time::nanoseconds
+Measurements::getSweepInterval()
+{
+  return time::seconds(1);
+}
+
 inline size_t
 Measurements::size() const
 {
@@ -38,27 +38,6 @@ class NameTree;
 
 namespace name_tree {
 
-// Forward declarations
-class Node;
-class Entry;
-
-/**
- * \brief Name Tree Node Class
- */
-class Node
-{
-public:
-  Node();
-
-  ~Node();
-
-public:
-  // variables are in public as this is just a data structure
-  shared_ptr<Entry> m_entry; // Name Tree Entry (i.e., Name Prefix Entry)
-  Node* m_prev; // Previous Name Tree Node (to resolve hash collision)
-  Node* m_next; // Next Name Tree Node (to resolve hash collision)
-};
-
 /**
  * \brief Name Tree Entry Class
  */
@@ -125,10 +104,20 @@ public: // attached table entries
   shared_ptr<strategy_choice::Entry>
   getStrategyChoiceEntry() const;
 
+public: // FIB longest prefix match cache
+  /** \brief caches the longest prefix match of this prefix in FIB
+   *  \param fibVersion FIB version in which fibEntry was found
+   */
+  void
+  setFibLpmCache(uint64_t fibVersion, const shared_ptr<fib::Entry>& fibEntry);
+
+  /** \return cached longest prefix match, or nullptr if it was not found in fibVersion
+   */
+  shared_ptr<fib::Entry>
+  getFibLpmCache(uint64_t fibVersion) const;
+
 private:
-  // Benefits of storing m_hash
-  // 1. m_hash is compared before m_prefix is compared
-  // 2. fast hash table resize support
+  // m_hash locates the hash table slot of this entry when it is erased
   size_t m_hash;
   Name m_prefix;
   shared_ptr<Entry> m_parent;     // Pointing to the parent entry.
@@ -137,9 +126,8 @@ private:
   std::vector<shared_ptr<pit::Entry> > m_pitEntries;
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
-
-  // get the Name Tree Node that is associated with this Name Tree Entry
-  Node* m_node;
+  uint64_t m_fibLpmVersion;
+  weak_ptr<fib::Entry> m_fibLpmEntry; // weak, so that erased FIB entries are not kept alive
 
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
@@ -217,6 +205,21 @@ Entry::getStrategyChoiceEntry() const
   return m_strategyChoiceEntry;
 }
 
+inline void
+Entry::setFibLpmCache(uint64_t fibVersion, const shared_ptr<fib::Entry>& fibEntry)
+{
+  m_fibLpmVersion = fibVersion;
+  m_fibLpmEntry = fibEntry;
+}
+
+inline shared_ptr<fib::Entry>
+Entry::getFibLpmCache(uint64_t fibVersion) const
+{
+  if (m_fibLpmVersion != fibVersion)
+    return shared_ptr<fib::Entry>();
+  return m_fibLpmEntry.lock();
+}
+
 } // namespace name_tree
 } // namespace nfd
 
@@ -26,6 +26,8 @@
 #include "name-tree.hpp"
 #include "core/logger.hpp"
 #include "core/city-hash.hpp"
+#include "pool-allocator.hpp"
+#include "utils/ndn-profiler-zones.hpp"
 
 #include <boost/concept/assert.hpp>
 #include <boost/concept_check.hpp>
@@ -111,114 +113,186 @@ computeHashSet(const Name& prefix)
   return hashValueSet;
 }
 
+HashSetTag::HashSetTag(const Name& name)
+  : m_nameWire(name.wireEncode())
+  , m_hashSet(computeHashSet(name))
+{
+}
+
+bool
+HashSetTag::isFor(const Name& name) const
+{
+  const Block& wire = name.wireEncode();
+  return wire.size() == m_nameWire.size() &&
+         (wire.wire() == m_nameWire.wire() ||
+          std::equal(wire.begin(), wire.end(), m_nameWire.begin()));
+}
+
 } // namespace name_tree
 
+// number of old table slots migrated by every insertion and erasure during a resize
+static const size_t MIGRATE_STEP = 8;
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t capacity = 1;
+  while (capacity < n)
+    capacity <<= 1;
+  return capacity;
+}
+
 NameTree::NameTree(size_t nBuckets)
   : m_nItems(0)
-  , m_nBuckets(nBuckets)
-  , m_minNBuckets(nBuckets)
+  , m_minNBuckets(roundUpToPowerOfTwo(nBuckets))
   , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
   , m_enlargeFactor(2)       // double the hash table size
   , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
   , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_table(m_minNBuckets)
+  , m_nMigrated(0)
   , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
 {
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
-                                          static_cast<double>(m_nBuckets));
+                                          static_cast<double>(m_table.size()));
 
   m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
-                                          static_cast<double>(m_nBuckets));
-
-  // array of node pointers
-  m_buckets = new name_tree::Node*[m_nBuckets];
-  // Initialize the pointer array
-  for (size_t i = 0; i < m_nBuckets; i++)
-    m_buckets[i] = 0;
+                                          static_cast<double>(m_table.size()));
 }
 
 NameTree::~NameTree()
 {
-  for (size_t i = 0; i < m_nBuckets; i++)
-    {
-      if (m_buckets[i] != 0) {
-        delete m_buckets[i];
-      }
-    }
-
-  delete [] m_buckets;
 }
 
-// insert() is a private function, and called by only lookup()
-std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+shared_ptr<name_tree::Entry>
+NameTree::find(size_t hash, const Name& name, size_t prefixLen) const
 {
-  NFD_LOG_TRACE("insert " << prefix);
+  // entries are in the current table, or in the old one if not migrated yet
+  for (const Table* table : {&m_table, &m_oldTable}) {
+    if (table->empty())
+      continue;
+
+    const size_t mask = table->size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Slot& slot = (*table)[i];
+      if (slot.entry == nullptr) {
+        if (slot.isTombstone)
+          continue;
+        break;
+      }
 
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
+      // isPrefixOf() is used to avoid making a copy of the name
+      const Name& prefix = slot.entry->getPrefix();
+      if (slot.hash == hash && prefix.size() == prefixLen && prefix.isPrefixOf(name))
+        return slot.entry;
+    }
+  }
 
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
+  return shared_ptr<name_tree::Entry>();
+}
 
-  // Check if this Name has been stored
-  name_tree::Node* node = m_buckets[loc];
-  name_tree::Node* nodePrev = node;  // initialize nodePrev to node
+void
+NameTree::insertSlot(size_t hash, shared_ptr<name_tree::Entry> entry)
+{
+  // the current table has no tombstones
+  const size_t mask = m_table.size() - 1;
+  size_t i = hash & mask;
+  while (m_table[i].entry != nullptr)
+    i = (i + 1) & mask;
+
+  m_table[i].hash = hash;
+  m_table[i].entry = std::move(entry);
+}
 
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
-    {
-      if (static_cast<bool>(node->m_entry))
-        {
-          if (prefix == node->m_entry->m_prefix)
-            {
-              return std::make_pair(node->m_entry, false); // false: old entry
-            }
-        }
-      nodePrev = node;
+void
+NameTree::eraseSlot(const shared_ptr<name_tree::Entry>& entry)
+{
+  const size_t hash = entry->getHash();
+
+  if (!m_oldTable.empty()) {
+    const size_t mask = m_oldTable.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      Slot& slot = m_oldTable[i];
+      if (slot.entry == entry) {
+        // probe sequences of the old table cannot be shifted, as the migration could skip them
+        slot.entry.reset();
+        slot.isTombstone = true;
+        return;
+      }
+      if (slot.entry == nullptr && !slot.isTombstone)
+        break;
     }
+  }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
-
-  // If no bucket is empty occupied, we need to create a new node, and it is
-  // linked from nodePrev
-  node = new name_tree::Node();
-  node->m_prev = nodePrev;
+  const size_t mask = m_table.size() - 1;
+  size_t i = hash & mask;
+  while (m_table[i].entry != entry) {
+    BOOST_ASSERT(m_table[i].entry != nullptr);
+    i = (i + 1) & mask;
+  }
 
-  if (nodePrev == 0)
-    {
-      m_buckets[loc] = node;
-    }
-  else
-    {
-      nodePrev->m_next = node;
+  // backward shift deletion: move up following entries whose probe sequence crosses the hole
+  for (size_t j = (i + 1) & mask; m_table[j].entry != nullptr; j = (j + 1) & mask) {
+    size_t home = m_table[j].hash & mask;
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      m_table[i].hash = m_table[j].hash;
+      m_table[i].entry = std::move(m_table[j].entry);
+      i = j;
     }
+  }
+  m_table[i].entry.reset();
+}
 
-  // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
-  entry->setHash(hashValue);
-  node->m_entry = entry; // link the Entry to its Node
-  entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
+void
+NameTree::migrate(size_t nSlots)
+{
+  for (; nSlots > 0 && m_nMigrated < m_oldTable.size(); --nSlots, ++m_nMigrated) {
+    Slot& slot = m_oldTable[m_nMigrated];
+    if (slot.entry != nullptr) {
+      insertSlot(slot.hash, std::move(slot.entry));
+      slot.entry.reset();
+      slot.isTombstone = true;
+    }
+  }
 
-  return std::make_pair(entry, true); // true: new entry
+  if (!m_oldTable.empty() && m_nMigrated == m_oldTable.size()) {
+    Table().swap(m_oldTable);
+    m_nMigrated = 0;
+  }
 }
 
 // Name Prefix Lookup. Create Name Tree Entry if not found
 shared_ptr<name_tree::Entry>
 NameTree::lookup(const Name& prefix)
 {
+  return lookup(prefix, name_tree::computeHashSet(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::lookup(const Name& prefix, const std::vector<size_t>& hashValueSet)
+{
+  NDN_PROFILE_ZONE("NameTree::lookup");
   NFD_LOG_TRACE("lookup " << prefix);
+  BOOST_ASSERT(hashValueSet.size() > prefix.size());
 
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
-      // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
-      entry = ret.first;
+      entry = find(hashValueSet[i], prefix, i);
 
-      if (ret.second == true)
+      if (!static_cast<bool>(entry))
         {
+          NFD_LOG_TRACE("Did not find " << prefix.getPrefix(i) << ", need to insert it to the table");
+
+          entry = std::allocate_shared<name_tree::Entry>(PoolAllocator<name_tree::Entry>(),
+                                                         prefix.getPrefix(i));
+          entry->setHash(hashValueSet[i]);
+
+          migrate(MIGRATE_STEP);
+          insertSlot(hashValueSet[i], entry);
+
           m_nItems++; // Increase the counter
           entry->m_parent = parent;
 
@@ -226,11 +300,11 @@ NameTree::lookup(const Name& prefix)
             {
               parent->m_children.push_back(entry);
             }
-        }
 
-      if (m_nItems > m_enlargeThreshold)
-        {
-          resize(m_enlargeFactor * m_nBuckets);
+          if (m_nItems > m_enlargeThreshold)
+            {
+              resize(m_enlargeFactor * m_table.size());
+            }
         }
 
       parent = entry;
@@ -244,69 +318,43 @@ NameTree::findExactMatch(const Name& prefix) const
 {
   NFD_LOG_TRACE("findExactMatch " << prefix);
 
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
-
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue <<
-                "  location = " << loc);
-
-  shared_ptr<name_tree::Entry> entry;
-  name_tree::Node* node = 0;
+  return find(name_tree::computeHash(prefix), prefix, prefix.size());
+}
 
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
-    {
-      entry = node->m_entry;
-      if (static_cast<bool>(entry))
-        {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
-            {
-              return entry;
-            }
-        } // if entry
-    } // for node
+shared_ptr<name_tree::Entry>
+NameTree::findExactMatch(const Name& name, size_t prefixLen,
+                         const std::vector<size_t>& hashSet) const
+{
+  BOOST_ASSERT(prefixLen <= name.size() && hashSet.size() > prefixLen);
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  return find(hashSet[prefixLen], name, prefixLen);
 }
 
 // Longest Prefix Match
 shared_ptr<name_tree::Entry>
 NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelector& entrySelector) const
 {
-  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
-
-  shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
+  return findLongestPrefixMatch(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
 
-  size_t hashValue = 0;
-  size_t loc = 0;
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashValueSet,
+                                 const name_tree::EntrySelector& entrySelector) const
+{
+  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
+  BOOST_ASSERT(hashValueSet.size() > prefix.size());
 
   for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
     {
-      hashValue = hashValueSet[i];
-      loc = hashValue % m_nBuckets;
-
-      name_tree::Node* node = 0;
-      for (node = m_buckets[loc]; node != 0; node = node->m_next)
+      shared_ptr<name_tree::Entry> entry = find(hashValueSet[i], prefix, i);
+      if (static_cast<bool>(entry) && entrySelector(*entry))
         {
-          entry = node->m_entry;
-          if (static_cast<bool>(entry))
-            {
-              // isPrefixOf() is used to avoid making a copy of the name
-              if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
-                  entrySelector(*entry))
-                {
-                  return entry;
-                }
-            } // if entry
-        } // for node
+          return entry;
+        }
     }
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  // if not found, a null pointer will be returned
+  return shared_ptr<name_tree::Entry>();
 }
 
 shared_ptr<name_tree::Entry>
@@ -357,38 +405,17 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
           BOOST_VERIFY(isFound == true);
         }
 
-      // remove this Entry and its Name Tree Node
-      name_tree::Node* node = entry->m_node;
-      name_tree::Node* nodePrev = node->m_prev;
-
-      // configure the previous node
-      if (nodePrev != 0)
-        {
-          // link the previous node to the next node
-          nodePrev->m_next = node->m_next;
-        }
-      else
-        {
-          m_buckets[entry->getHash() % m_nBuckets] = node->m_next;
-        }
-
-      // link the previous node with the next node (skip the erased one)
-      if (node->m_next != 0)
-        {
-          node->m_next->m_prev = nodePrev;
-          node->m_next = 0;
-        }
-
-      BOOST_ASSERT(node->m_next == 0);
+      // remove this Entry from the hash table
+      eraseSlot(entry);
+      migrate(MIGRATE_STEP);
 
       m_nItems--;
-      delete node;
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
 
       size_t newNBuckets = static_cast<size_t>(m_shrinkFactor *
-                                     static_cast<double>(m_nBuckets));
+                                     static_cast<double>(m_table.size()));
 
       if (newNBuckets >= m_minNBuckets && m_nItems < m_shrinkThreshold)
         {
@@ -407,18 +434,10 @@ NameTree::fullEnumerate(const name_tree::EntrySelector& entrySelector) const
 {
   NFD_LOG_TRACE("fullEnumerate");
 
-  // find the first eligible entry
-  for (size_t i = 0; i < m_nBuckets; i++) {
-    for (name_tree::Node* node = m_buckets[i]; node != 0; node = node->m_next) {
-      if (static_cast<bool>(node->m_entry) && entrySelector(*node->m_entry)) {
-        const_iterator it(FULL_ENUMERATE_TYPE, *this, node->m_entry, entrySelector);
-        return {it, end()};
-      }
-    }
-  }
-
-  // If none of the entry satisfies the requirements, then return the end() iterator.
-  return {end(), end()};
+  // all entries are descendants of the root entry, which exists unless the Name Tree is empty
+  return partialEnumerate(Name(), [entrySelector] (const name_tree::Entry& entry) {
+      return std::make_pair(entrySelector(entry), true);
+    });
 }
 
 boost::iterator_range<NameTree::const_iterator>
@@ -453,6 +472,14 @@ NameTree::partialEnumerate(const Name& prefix,
 boost::iterator_range<NameTree::const_iterator>
 NameTree::findAllMatches(const Name& prefix,
                          const name_tree::EntrySelector& entrySelector) const
+{
+  return findAllMatches(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
+
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& prefix,
+                         const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector) const
 {
   NFD_LOG_TRACE("NameTree::findAllMatches" << prefix);
 
@@ -462,7 +489,7 @@ NameTree::findAllMatches(const Name& prefix,
   // For trie-like design, it could be more efficient by walking down the
   // trie from the root node.
 
-  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, entrySelector);
+  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, hashSet, entrySelector);
 
   if (static_cast<bool>(entry)) {
     const_iterator begin(FIND_ALL_MATCHES_TYPE, *this, entry, entrySelector);
@@ -478,79 +505,58 @@ NameTree::resize(size_t newNBuckets)
 {
   NFD_LOG_TRACE("resize");
 
-  name_tree::Node** newBuckets = new name_tree::Node*[newNBuckets];
-  size_t count = 0;
-
-  // referenced ccnx hashtb.c hashtb_rehash()
-  name_tree::Node** pp = 0;
-  name_tree::Node* p = 0;
-  name_tree::Node* pre = 0;
-  name_tree::Node* q = 0; // record p->m_next
-  size_t i;
-  uint32_t h;
-  uint32_t b;
-
-  for (i = 0; i < newNBuckets; i++)
-    {
-      newBuckets[i] = 0;
-    }
-
-  for (i = 0; i < m_nBuckets; i++)
-    {
-      for (p = m_buckets[i]; p != 0; p = q)
-        {
-          count++;
-          q = p->m_next;
-          BOOST_ASSERT(static_cast<bool>(p->m_entry));
-          h = p->m_entry->m_hash;
-          b = h % newNBuckets;
-          pre = 0;
-          for (pp = &newBuckets[b]; *pp != 0; pp = &((*pp)->m_next))
-            {
-              pre = *pp;
-              continue;
-            }
-          p->m_prev = pre;
-          p->m_next = *pp; // Actually *pp always == 0 in this case
-          *pp = p;
-        }
-    }
-
-  BOOST_ASSERT(count == m_nItems);
-
-  name_tree::Node** oldBuckets = m_buckets;
-  m_buckets = newBuckets;
-  delete [] oldBuckets;
+  // a table is migrated completely before the next resize
+  migrate(m_oldTable.size());
 
-  m_nBuckets = newNBuckets;
+  m_oldTable.swap(m_table);
+  Table(newNBuckets).swap(m_table);
+  m_nMigrated = 0;
+  migrate(MIGRATE_STEP);
 
   m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
-                                              static_cast<double>(m_nBuckets));
+                                              static_cast<double>(m_table.size()));
   m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
-                                              static_cast<double>(m_nBuckets));
+                                              static_cast<double>(m_table.size()));
 }
 
 // For debugging
+size_t
+NameTree::getMemoryUsage() const
+{
+  size_t n = (m_table.capacity() + m_oldTable.capacity()) * sizeof(Slot);
+  for (const Table* table : {&m_table, &m_oldTable}) {
+    for (const Slot& slot : *table) {
+      if (slot.entry == nullptr) {
+        continue;
+      }
+      // PoolAllocator places the shared_ptr control block next to the entry
+      n += sizeof(name_tree::Entry) + 2 * sizeof(void*) +
+           slot.entry->getPrefix().size() * sizeof(name::Component) +
+           slot.entry->getChildren().capacity() * sizeof(shared_ptr<name_tree::Entry>) +
+           slot.entry->getPitEntries().capacity() * sizeof(shared_ptr<pit::Entry>);
+    }
+  }
+  return n;
+}
+
 void
 NameTree::dump(std::ostream& output) const
 {
   NFD_LOG_TRACE("dump()");
 
-  name_tree::Node* node = 0;
-  shared_ptr<name_tree::Entry> entry;
-
   using std::endl;
 
-  for (size_t i = 0; i < m_nBuckets; i++)
+  for (const Table* table : {&m_table, &m_oldTable})
     {
-      for (node = m_buckets[i]; node != 0; node = node->m_next)
+      for (size_t i = 0; i < table->size(); i++)
         {
-          entry = node->m_entry;
+          shared_ptr<name_tree::Entry> entry = (*table)[i].entry;
 
           // if the Entry exist, dump its information
           if (static_cast<bool>(entry))
             {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+              output << (table == &m_table ? "Bucket" : "OldBucket") << i << "\t"
+                     << entry->m_prefix.toUri() << endl;
               output << "\t\tHash " << entry->m_hash << endl;
 
               if (static_cast<bool>(entry->m_parent))
@@ -576,10 +582,13 @@ NameTree::dump(std::ostream& output) const
 
             } // if (static_cast<bool>(entry))
 
-        } // for node
-    } // for int i
+        } // for slot
+    } // for table
 
-  output << "Bucket count = " << m_nBuckets << endl;
+  output << "Bucket count = " << m_table.size() << endl;
+  if (!m_oldTable.empty())
+    output << "Old bucket count = " << m_oldTable.size()
+           << ", migrated = " << m_nMigrated << endl;
   output << "Stored item = " << m_nItems << endl;
   output << "--------------------------\n";
 }
@@ -612,42 +621,6 @@ NameTree::const_iterator::operator++()
 
   BOOST_ASSERT(m_entry != m_nameTree->m_end);
 
-  if (m_type == FULL_ENUMERATE_TYPE) // fullEnumerate
-    {
-      // process the entries in the same bucket first
-      while (m_entry->m_node->m_next != 0)
-        {
-          m_entry = m_entry->m_node->m_next->m_entry;
-          if ((*m_entrySelector)(*m_entry))
-            {
-              return *this;
-            }
-        }
-
-      // process other buckets
-
-      for (int newLocation = m_entry->m_hash % m_nameTree->m_nBuckets + 1;
-           newLocation < static_cast<int>(m_nameTree->m_nBuckets);
-           ++newLocation)
-        {
-          // process each bucket
-          name_tree::Node* node = m_nameTree->m_buckets[newLocation];
-          while (node != 0)
-            {
-              m_entry = node->m_entry;
-              if ((*m_entrySelector)(*m_entry))
-                {
-                  return *this;
-                }
-              node = node->m_next;
-            }
-        }
-
-      // Reach the end()
-      m_entry = m_nameTree->m_end;
-      return *this;
-    }
-
   if (m_type == PARTIAL_ENUMERATE_TYPE) // partialEnumerate
     {
       // We use pre-order traversal.
@@ -45,6 +45,58 @@ computeHash(const Name& prefix);
 std::vector<size_t>
 computeHashSet(const Name& prefix);
 
+/**
+ * \brief Tag that caches the hash set of an Interest or Data name
+ *
+ * The first NameTree operation on a packet attaches the tag, and later operations on the
+ * same packet reuse the hash values instead of hashing the name again.
+ */
+class HashSetTag : public ndn::Tag
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 0x0f575e48; // md5("NameHashSetTag")[0:8]
+  }
+
+  explicit
+  HashSetTag(const Name& name);
+
+  /**
+   * \brief Check whether the hash set was computed for \p name
+   * \details The tag is copied along with the packet, so the name may have changed since.
+   */
+  bool
+  isFor(const Name& name) const;
+
+  const std::vector<size_t>&
+  getHashSet() const
+  {
+    return m_hashSet;
+  }
+
+private:
+  Block m_nameWire;
+  std::vector<size_t> m_hashSet;
+};
+
+/**
+ * \brief Get the hash set of the packet name, computing it only if not cached in the packet
+ * \tparam Packet Interest or Data
+ */
+template<typename Packet>
+const std::vector<size_t>&
+getHashSet(const Packet& packet)
+{
+  shared_ptr<HashSetTag> tag = packet.template getTag<HashSetTag>();
+  if (tag == nullptr || !tag->isFor(packet.getName())) {
+    tag = make_shared<HashSetTag>(packet.getName());
+    packet.setTag(tag);
+  }
+  return tag->getHashSet();
+}
+
 /// a predicate to accept or reject an Entry in find operations
 typedef function<bool (const Entry& entry)> EntrySelector;
 
@@ -75,6 +127,12 @@ struct AnyEntrySubTree {
 
 /**
  * \brief Class Name Tree
+ *
+ * Entries are kept in an open addressing hash table with linear probing.  Each slot stores
+ * the hash of its entry, so that a probe usually compares the name only once.  The table is
+ * resized incrementally: a resize allocates the new table and moves a few slots of the old
+ * table on every following insertion or erasure, while lookups consult both tables until
+ * the old one is empty.
  */
 class NameTree : noncopyable
 {
@@ -95,12 +153,23 @@ public: // information
 
   /**
    * \brief Get the number of buckets in the Name Tree (NPHT)
-   * \details The number of buckets is the one that used to create the hash
-   * table, i.e., m_nBuckets.
+   * \details The number of buckets is the size of the current hash table, i.e., the one new
+   * entries are inserted to.  It is a power of two, the value given to the constructor is
+   * rounded up.
    */
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Get the approximate number of bytes used by the hash table and the entries
+   *
+   * Names are counted by their components; a wire buffer shared with packets is not counted.
+   * FIB, PIT, Measurements and StrategyChoice entries attached to the entries are reported by
+   * their own tables.  Visits all entries.
+   */
+  size_t
+  getMemoryUsage() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -121,6 +190,14 @@ public: // mutation
   shared_ptr<name_tree::Entry>
   lookup(const Name& prefix);
 
+  /**
+   * \brief Look for the Name Tree Entry with precomputed hash values
+   * \param hashSet hash values of \p prefix or a longer name it is a prefix of,
+   *        as returned by computeHashSet or getHashSet
+   */
+  shared_ptr<name_tree::Entry>
+  lookup(const Name& prefix, const std::vector<size_t>& hashSet);
+
   /**
    * \brief Delete a Name Tree Entry if this entry is empty.
    * \param entry The entry to be deleted if empty.
@@ -158,6 +235,13 @@ public: // matching
   shared_ptr<name_tree::Entry>
   findExactMatch(const Name& prefix) const;
 
+  /**
+   * \brief Exact match lookup for the first \p prefixLen components of \p name
+   * \param hashSet hash values of \p name, as returned by computeHashSet or getHashSet
+   */
+  shared_ptr<name_tree::Entry>
+  findExactMatch(const Name& name, size_t prefixLen, const std::vector<size_t>& hashSet) const;
+
   /**
    * \brief Longest prefix matching for the given name
    * \details Starts from the full name string, reduce the number of name component
@@ -168,6 +252,17 @@ public: // matching
                          const name_tree::EntrySelector& entrySelector =
                          name_tree::AnyEntry()) const;
 
+  /**
+   * \brief Longest prefix matching with precomputed hash values
+   * \param hashSet hash values of \p prefix or a longer name it is a prefix of,
+   *        as returned by computeHashSet or getHashSet
+   */
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const Name& prefix,
+                         const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector =
+                         name_tree::AnyEntry()) const;
+
   shared_ptr<name_tree::Entry>
   findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
                          const name_tree::EntrySelector& entrySelector =
@@ -191,6 +286,14 @@ public: // matching
   findAllMatches(const Name& prefix,
                  const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
 
+  /** \brief Enumerate all the name prefixes that satisfy the prefix and entrySelector,
+   *         with precomputed hash values of the prefix
+   */
+  boost::iterator_range<const_iterator>
+  findAllMatches(const Name& prefix,
+                 const std::vector<size_t>& hashSet,
+                 const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
+
 public: // enumeration
   /** \brief Enumerate all entries, optionally filtered by an EntrySelector.
    *  \return an unspecified type that have .begin() and .end() methods
@@ -292,11 +395,51 @@ public: // enumeration
   };
 
 private:
+  struct Slot
+  {
+    Slot()
+      : hash(0)
+      , isTombstone(false)
+    {
+    }
+
+    size_t hash;
+    shared_ptr<name_tree::Entry> entry; // empty slot if null
+    bool isTombstone; // slot of an entry that left the old table, probing continues past it
+  };
+
+  typedef std::vector<Slot> Table;
+
+  /**
+   * \brief Find the entry of the first \p prefixLen components of \p name
+   * \param hash hash value of the prefix, as computed by computeHash
+   * \return the Name Tree Entry, or a null shared_ptr if the prefix is not in the table
+   */
+  shared_ptr<name_tree::Entry>
+  find(size_t hash, const Name& name, size_t prefixLen) const;
+
+  /**
+   * \brief Put the entry in the first free slot of its probe sequence in the current table
+   */
+  void
+  insertSlot(size_t hash, shared_ptr<name_tree::Entry> entry);
+
+  /**
+   * \brief Remove the entry from the table that holds it
+   */
+  void
+  eraseSlot(const shared_ptr<name_tree::Entry>& entry);
+
+  /**
+   * \brief Move up to \p nSlots slots of the old table to the current table
+   */
+  void
+  migrate(size_t nSlots);
+
   /**
    * \brief Resize the hash table size when its load factor reaches a threshold.
-   * \details As we are currently using a hand-written hash table implementation
-   * for the Name Tree, the hash table resize() function should be kept in the
-   * name-tree.hpp file.
+   * \details The current table becomes the old table and is migrated by following
+   * insertions and erasures.  A migration that is still in progress is completed first.
    * \param newNBuckets The number of buckets for the new hash table.
    */
   void
@@ -304,7 +447,6 @@ private:
 
 private:
   size_t                        m_nItems;  // Number of items being stored
-  size_t                        m_nBuckets; // Number of hash buckets
   size_t                        m_minNBuckets; // Minimum number of hash buckets
   double                        m_enlargeLoadFactor;
   size_t                        m_enlargeThreshold;
@@ -312,20 +454,11 @@ private:
   double                        m_shrinkLoadFactor;
   size_t                        m_shrinkThreshold;
   double                        m_shrinkFactor;
-  name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  Table                         m_table; // current hash table, its size is a power of two
+  Table                         m_oldTable; // table being migrated, empty if none
+  size_t                        m_nMigrated; // slots of m_oldTable already migrated
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
-
-  /**
-   * \brief Create a Name Tree Entry if it does not exist, or return the existing
-   * Name Tree Entry address.
-   * \details Called by lookup() only.
-   * \return The first item is the Name Tree Entry address, the second item is
-   * a bool value indicates whether this is an old entry (false) or a new
-   * entry (true).
-   */
-  std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
 };
 
 inline NameTree::const_iterator::~const_iterator()
@@ -341,7 +474,7 @@ NameTree::size() const
 inline size_t
 NameTree::getNBuckets() const
 {
-  return m_nBuckets;
+  return m_table.size();
 }
 
 inline shared_ptr<name_tree::Entry>
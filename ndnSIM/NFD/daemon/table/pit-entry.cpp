@@ -33,7 +33,13 @@ const Name Entry::LOCALHOST_NAME("ndn:/localhost");
 const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
 Entry::Entry(const Interest& interest)
-  : m_interest(interest.shared_from_this())
+  : m_unsatisfyTimer(0)
+  , m_stragglerTimer(0)
+  , m_interest(interest.shared_from_this())
+  , m_needsPrefixMatch(interest.getMaxSuffixComponents() < 0 ||
+                       interest.getMaxSuffixComponents() > 1)
+  , m_strategyChoiceVersion(0)
+  , m_strategy(nullptr)
 {
 }
 
@@ -148,8 +154,8 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return inRecord.getFace() == face; });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    // newest record first
+    it = m_inRecords.emplace(m_inRecords.begin(), face);
   }
 
   it->update(interest);
@@ -163,6 +169,16 @@ Entry::getInRecord(const Face& face) const
     [&face] (const InRecord& inRecord) { return inRecord.getFace().get() == &face; });
 }
 
+void
+Entry::deleteInRecord(const Face& face)
+{
+  auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
+    [&face] (const InRecord& inRecord) { return inRecord.getFace().get() == &face; });
+  if (it != m_inRecords.end()) {
+    m_inRecords.erase(it);
+  }
+}
+
 void
 Entry::deleteInRecords()
 {
@@ -175,11 +191,12 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
     [&face] (const OutRecord& outRecord) { return outRecord.getFace() == face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    // newest record first
+    it = m_outRecords.emplace(m_outRecords.begin(), face);
   }
 
   it->update(interest);
+  it->clearIncomingNack();
   return it;
 }
 
@@ -190,6 +207,13 @@ Entry::getOutRecord(const Face& face) const
     [&face] (const OutRecord& outRecord) { return outRecord.getFace().get() == &face; });
 }
 
+OutRecordCollection::iterator
+Entry::getOutRecord(const Face& face)
+{
+  return std::find_if(m_outRecords.begin(), m_outRecords.end(),
+    [&face] (const OutRecord& outRecord) { return outRecord.getFace().get() == &face; });
+}
+
 void
 Entry::deleteOutRecord(const Face& face)
 {
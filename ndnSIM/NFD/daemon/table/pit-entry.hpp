@@ -30,6 +30,11 @@
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
 
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif // BOOST_VERSION >= 105800
+
 namespace nfd {
 
 class NameTree;
@@ -38,15 +43,38 @@ namespace name_tree {
 class Entry;
 }
 
+namespace fw {
+class Strategy;
+}
+
 namespace pit {
 
+/** \brief number of InRecords or OutRecords stored in a PIT entry without heap allocation
+ *
+ *  Most PIT entries have one or two records of each kind.
+ */
+#ifndef NFD_PIT_RECORDS_INLINE_CAPACITY
+#define NFD_PIT_RECORDS_INLINE_CAPACITY 2
+#endif // NFD_PIT_RECORDS_INLINE_CAPACITY
+
+#if BOOST_VERSION >= 105800
 /** \brief represents an unordered collection of InRecords
+ *  \note Inserting or deleting a record invalidates iterators and references to other records
+ *        of the same collection.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef boost::container::small_vector<InRecord, NFD_PIT_RECORDS_INLINE_CAPACITY>
+  InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *  \note Inserting or deleting a record invalidates iterators and references to other records
+ *        of the same collection.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, NFD_PIT_RECORDS_INLINE_CAPACITY>
+  OutRecordCollection;
+#else
+typedef std::vector<InRecord> InRecordCollection;
+typedef std::vector<OutRecord> OutRecordCollection;
+#endif // BOOST_VERSION >= 105800
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -78,6 +106,13 @@ public:
   const Name&
   getName() const;
 
+  /** \return whether Data with a longer name than the Interest can satisfy this entry
+   *
+   *  This is false only when MaxSuffixComponents restricts the Data name to the Interest name.
+   */
+  bool
+  needsPrefixMatch() const;
+
   /** \brief decides whether Interest can be forwarded to face
    *
    *  \return true if OutRecord of this face does not exist or has expired,
@@ -132,6 +167,10 @@ public: // InRecord
   InRecordCollection::const_iterator
   getInRecord(const Face& face) const;
 
+  /// deletes one InRecord for face if exists
+  void
+  deleteInRecord(const Face& face);
+
   /// deletes all InRecords
   void
   deleteInRecords();
@@ -142,7 +181,7 @@ public: // OutRecord
 
   /** \brief inserts a OutRecord for face, and updates it with interest
    *
-   *  If OutRecord for face exists, the existing one is updated.
+   *  If OutRecord for face exists, the existing one is updated and its Nack is cleared.
    *  \return an iterator to the OutRecord
    */
   OutRecordCollection::iterator
@@ -154,6 +193,9 @@ public: // OutRecord
   OutRecordCollection::const_iterator
   getOutRecord(const Face& face) const;
 
+  OutRecordCollection::iterator
+  getOutRecord(const Face& face);
+
   /// deletes one OutRecord for face if exists
   void
   deleteOutRecord(const Face& face);
@@ -163,14 +205,32 @@ public: // OutRecord
   bool
   hasUnexpiredOutRecords() const;
 
+public: // effective strategy cache
+  /** \return cached effective strategy, or nullptr if it was not found in strategyChoiceVersion
+   */
+  fw::Strategy*
+  getCachedStrategy(uint64_t strategyChoiceVersion) const;
+
+  /** \brief caches the effective strategy found in strategyChoiceVersion
+   */
+  void
+  setCachedStrategy(uint64_t strategyChoiceVersion, fw::Strategy& strategy) const;
+
 public:
-  scheduler::EventId m_unsatisfyTimer;
-  scheduler::EventId m_stragglerTimer;
+  /// token of the unsatisfy timer in pit::TimerWheel, zero if not set
+  uint64_t m_unsatisfyTimer;
+  /// token of the straggler timer in pit::TimerWheel, zero if not set
+  uint64_t m_stragglerTimer;
+  /// aggregation hold of the first Interest, see fw::Strategy::getAggregationHold
+  scheduler::EventId m_aggregationHoldTimer;
 
 private:
   shared_ptr<const Interest> m_interest;
+  bool m_needsPrefixMatch;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
+  mutable uint64_t m_strategyChoiceVersion;
+  mutable fw::Strategy* m_strategy;
 
   static const Name LOCALHOST_NAME;
   static const Name LOCALHOP_NAME;
@@ -187,6 +247,12 @@ Entry::getInterest() const
   return *m_interest;
 }
 
+inline bool
+Entry::needsPrefixMatch() const
+{
+  return m_needsPrefixMatch;
+}
+
 inline const InRecordCollection&
 Entry::getInRecords() const
 {
@@ -199,6 +265,19 @@ Entry::getOutRecords() const
   return m_outRecords;
 }
 
+inline fw::Strategy*
+Entry::getCachedStrategy(uint64_t strategyChoiceVersion) const
+{
+  return m_strategyChoiceVersion == strategyChoiceVersion ? m_strategy : nullptr;
+}
+
+inline void
+Entry::setCachedStrategy(uint64_t strategyChoiceVersion, fw::Strategy& strategy) const
+{
+  m_strategyChoiceVersion = strategyChoiceVersion;
+  m_strategy = &strategy;
+}
+
 } // namespace pit
 } // namespace nfd
 
@@ -29,8 +29,21 @@ namespace pit {
 
 OutRecord::OutRecord(shared_ptr<Face> face)
   : FaceRecord(face)
+  , m_hasIncomingNack(false)
 {
 }
 
+bool
+OutRecord::setIncomingNack(const lp::Nack& nack)
+{
+  if (nack.getInterest().getNonce() != this->getLastNonce()) {
+    return false;
+  }
+
+  m_hasIncomingNack = true;
+  m_incomingNack = nack.getHeader();
+  return true;
+}
+
 } // namespace pit
 } // namespace nfd
@@ -38,6 +38,32 @@ class OutRecord : public FaceRecord
 public:
   explicit
   OutRecord(shared_ptr<Face> face);
+
+  /** \return the Nack received for the last transmission, or nullptr if there is none
+   */
+  const lp::NackHeader*
+  getIncomingNack() const
+  {
+    return m_hasIncomingNack ? &m_incomingNack : nullptr;
+  }
+
+  /** \brief record a Nack received from the face
+   *  \return false if the Nack does not match the last transmission (different Nonce)
+   */
+  bool
+  setIncomingNack(const lp::Nack& nack);
+
+  /** \brief forget the Nack, e.g., when the Interest is retransmitted
+   */
+  void
+  clearIncomingNack()
+  {
+    m_hasIncomingNack = false;
+  }
+
+private:
+  bool m_hasIncomingNack;
+  lp::NackHeader m_incomingNack;
 };
 
 } // namespace pit
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pit-timer-wheel.hpp"
+
+namespace nfd {
+namespace pit {
+
+const time::nanoseconds TimerWheel::TICK = time::milliseconds(1);
+const size_t TimerWheel::NSLOTS;
+
+static_assert((TimerWheel::NSLOTS & (TimerWheel::NSLOTS - 1)) == 0,
+              "TimerWheel::NSLOTS must be a power of two");
+
+TimerWheel::TimerWheel(const UnsatisfyCallback& onUnsatisfy,
+                       const StragglerCallback& onStraggler)
+  : m_onUnsatisfy(onUnsatisfy)
+  , m_onStraggler(onStraggler)
+  , m_slots(NSLOTS)
+  , m_nTimers(0)
+  , m_lastToken(0)
+  , m_lastTick(0)
+  , m_pumpTick(0)
+{
+}
+
+TimerWheel::~TimerWheel()
+{
+  scheduler::cancel(m_pumpEvent);
+}
+
+uint64_t
+TimerWheel::getTick(const time::steady_clock::TimePoint& t, bool roundUp)
+{
+  time::nanoseconds sinceEpoch = t.time_since_epoch();
+  if (sinceEpoch <= time::nanoseconds::zero())
+    return 0;
+  return (sinceEpoch.count() + (roundUp ? TICK.count() - 1 : 0)) / TICK.count();
+}
+
+time::steady_clock::TimePoint
+TimerWheel::getTime(uint64_t tick)
+{
+  return time::steady_clock::TimePoint(
+    time::nanoseconds(static_cast<time::nanoseconds::rep>(tick) * TICK.count()));
+}
+
+void
+TimerWheel::setUnsatisfyTimer(shared_ptr<Entry> pitEntry,
+                              const time::steady_clock::TimePoint& expiry)
+{
+  pitEntry->m_unsatisfyTimer = this->add(pitEntry, expiry, false, false,
+                                         time::milliseconds(-1));
+}
+
+void
+TimerWheel::setStragglerTimer(shared_ptr<Entry> pitEntry, const time::nanoseconds& delay,
+                              bool isSatisfied, const time::milliseconds& dataFreshnessPeriod)
+{
+  pitEntry->m_stragglerTimer = this->add(pitEntry, time::steady_clock::now() + delay, true,
+                                         isSatisfied, dataFreshnessPeriod);
+}
+
+void
+TimerWheel::cancel(Entry& pitEntry)
+{
+  // stale timers are dropped when their slot is pumped
+  pitEntry.m_unsatisfyTimer = 0;
+  pitEntry.m_stragglerTimer = 0;
+}
+
+uint64_t
+TimerWheel::add(shared_ptr<Entry> pitEntry, const time::steady_clock::TimePoint& deadline,
+                bool isStraggler, bool isSatisfied, const time::milliseconds& dataFreshnessPeriod)
+{
+  if (m_nTimers == 0) {
+    // the wheel has been idle, so ticks up to now have not been pumped
+    m_lastTick = getTick(time::steady_clock::now(), false);
+  }
+
+  uint64_t tick = std::max(getTick(deadline, true), m_lastTick + 1);
+  uint64_t token = ++m_lastToken;
+  m_slots[tick & (NSLOTS - 1)].push_back(Timer{pitEntry, token, tick, isStraggler,
+                                               isSatisfied, dataFreshnessPeriod});
+  ++m_nTimers;
+
+  if (m_pumpEvent == nullptr || tick < m_pumpTick) {
+    this->schedulePump(tick);
+  }
+  return token;
+}
+
+void
+TimerWheel::schedulePump(uint64_t tick)
+{
+  scheduler::cancel(m_pumpEvent);
+  m_pumpTick = tick;
+
+  time::nanoseconds delay = getTime(tick) - time::steady_clock::now();
+  m_pumpEvent = scheduler::schedule(std::max(delay, time::nanoseconds::zero()),
+                                    bind(&TimerWheel::pump, this));
+}
+
+void
+TimerWheel::pump()
+{
+  m_pumpEvent.reset();
+  m_lastTick = m_pumpTick;
+
+  std::vector<Timer> timers;
+  timers.swap(m_slots[m_lastTick & (NSLOTS - 1)]);
+
+  for (Timer& timer : timers) {
+    shared_ptr<Entry> pitEntry = timer.pitEntry.lock();
+    uint64_t* token = nullptr;
+    if (pitEntry != nullptr) {
+      token = timer.isStraggler ? &pitEntry->m_stragglerTimer : &pitEntry->m_unsatisfyTimer;
+    }
+
+    if (token == nullptr || *token != timer.token) {
+      // cancelled, reset, or PIT entry is gone
+      --m_nTimers;
+      continue;
+    }
+
+    if (timer.tick != m_lastTick) {
+      // due in a later round of the wheel
+      m_slots[m_lastTick & (NSLOTS - 1)].push_back(std::move(timer));
+      continue;
+    }
+
+    --m_nTimers;
+    *token = 0;
+    if (timer.isStraggler) {
+      m_onStraggler(pitEntry, timer.isSatisfied, timer.dataFreshnessPeriod);
+    }
+    else {
+      m_onUnsatisfy(pitEntry);
+    }
+  }
+
+  if (m_nTimers == 0 || m_pumpEvent != nullptr) {
+    return;
+  }
+
+  // callbacks may have scheduled the pump already; otherwise find the next non-empty slot
+  for (uint64_t tick = m_lastTick + 1; ; ++tick) {
+    if (!m_slots[tick & (NSLOTS - 1)].empty()) {
+      this->schedulePump(tick);
+      return;
+    }
+  }
+}
+
+} // namespace pit
+} // namespace nfd
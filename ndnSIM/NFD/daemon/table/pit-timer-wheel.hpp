@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_TIMER_WHEEL_HPP
+#define NFD_DAEMON_TABLE_PIT_TIMER_WHEEL_HPP
+
+#include "pit-entry.hpp"
+
+namespace nfd {
+namespace pit {
+
+/** \brief a hashed timer wheel for unsatisfy and straggler timers of PIT entries
+ *
+ *  Timers are placed into one of NSLOTS slots according to the tick of their deadline,
+ *  rounded up to a multiple of TICK. A single scheduler event pumps the wheel at the next
+ *  tick having a non-empty slot, so that setting or cancelling a timer does not insert
+ *  into or remove from the simulator event queue, except when the new timer is due
+ *  before the next pump.
+ *
+ *  Each PIT entry remembers the token of its active timers in
+ *  Entry::m_unsatisfyTimer and Entry::m_stragglerTimer.
+ *  Cancellation resets the token; the stale timer is dropped when its slot is pumped.
+ */
+class TimerWheel : noncopyable
+{
+public:
+  typedef function<void(shared_ptr<Entry> pitEntry)> UnsatisfyCallback;
+
+  typedef function<void(shared_ptr<Entry> pitEntry, bool isSatisfied,
+                        const time::milliseconds& dataFreshnessPeriod)> StragglerCallback;
+
+  /** \brief granularity of timers; a timer fires at the first tick at or after its deadline
+   */
+  static const time::nanoseconds TICK;
+
+  /** \brief number of slots, must be a power of two
+   */
+  static const size_t NSLOTS = 1024;
+
+  TimerWheel(const UnsatisfyCallback& onUnsatisfy, const StragglerCallback& onStraggler);
+
+  ~TimerWheel();
+
+  /** \brief sets unsatisfy timer of \p pitEntry to fire at \p expiry
+   *
+   *  A previously set unsatisfy timer of the entry is cancelled.
+   */
+  void
+  setUnsatisfyTimer(shared_ptr<Entry> pitEntry, const time::steady_clock::TimePoint& expiry);
+
+  /** \brief sets straggler timer of \p pitEntry to fire after \p delay
+   *
+   *  A previously set straggler timer of the entry is cancelled.
+   */
+  void
+  setStragglerTimer(shared_ptr<Entry> pitEntry, const time::nanoseconds& delay,
+                    bool isSatisfied, const time::milliseconds& dataFreshnessPeriod);
+
+  /** \brief cancels unsatisfy and straggler timers of \p pitEntry
+   */
+  void
+  cancel(Entry& pitEntry);
+
+  /** \return number of timers in the wheel, including cancelled timers not yet dropped
+   */
+  size_t
+  size() const
+  {
+    return m_nTimers;
+  }
+
+private:
+  struct Timer
+  {
+    weak_ptr<Entry> pitEntry;
+    uint64_t token;
+    uint64_t tick;
+    bool isStraggler;
+    bool isSatisfied;
+    time::milliseconds dataFreshnessPeriod;
+  };
+
+  static uint64_t
+  getTick(const time::steady_clock::TimePoint& t, bool roundUp);
+
+  static time::steady_clock::TimePoint
+  getTime(uint64_t tick);
+
+  uint64_t
+  add(shared_ptr<Entry> pitEntry, const time::steady_clock::TimePoint& deadline,
+      bool isStraggler, bool isSatisfied, const time::milliseconds& dataFreshnessPeriod);
+
+  void
+  schedulePump(uint64_t tick);
+
+  void
+  pump();
+
+private:
+  UnsatisfyCallback m_onUnsatisfy;
+  StragglerCallback m_onStraggler;
+
+  std::vector<std::vector<Timer>> m_slots;
+  size_t m_nTimers;
+  uint64_t m_lastToken;
+
+  /// all ticks up to and including this one have been pumped
+  uint64_t m_lastTick;
+
+  scheduler::EventId m_pumpEvent;
+  uint64_t m_pumpTick;
+};
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_TIMER_WHEEL_HPP
@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "pool-allocator.hpp"
 #include <type_traits>
 
 #include <boost/concept/assert.hpp>
@@ -66,7 +67,8 @@ Pit::insert(const Interest& interest)
 {
   // first lookup() the Interest Name in the NameTree, which will creates all
   // the intermedia nodes, starting from the shortest prefix.
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
+  shared_ptr<name_tree::Entry> nameTreeEntry =
+    m_nameTree.lookup(interest.getName(), name_tree::getHashSet(interest));
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
   const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
@@ -81,24 +83,73 @@ Pit::insert(const Interest& interest)
     return { *it, false };
   }
 
-  shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  shared_ptr<pit::Entry> entry = std::allocate_shared<pit::Entry>(PoolAllocator<pit::Entry>(),
+                                                                 interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
+  countEntry(*entry, 1);
   return { entry, true };
 }
 
+shared_ptr<pit::Entry>
+Pit::find(const Interest& interest) const
+{
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.findExactMatch(interest.getName());
+  if (nameTreeEntry == nullptr) {
+    return nullptr;
+  }
+
+  const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
+  auto it = std::find_if(pitEntries.begin(), pitEntries.end(),
+                         [&interest] (const shared_ptr<pit::Entry>& entry) {
+                           return entry->getInterest().getName() == interest.getName() &&
+                                  entry->getInterest().getSelectors() == interest.getSelectors();
+                         });
+  return it == pitEntries.end() ? nullptr : *it;
+}
+
 pit::DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(),
-    [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); });
-
+  const Name& name = data.getName();
+  const std::vector<size_t>& hashSet = name_tree::getHashSet(data);
   pit::DataMatchResult matches;
-  for (const name_tree::Entry& nte : ntMatches) {
+
+  auto addMatches = [&] (const name_tree::Entry& nte) {
     for (const shared_ptr<pit::Entry>& pitEntry : nte.getPitEntries()) {
       if (pitEntry->getInterest().matchesData(data))
         matches.emplace_back(pitEntry);
     }
+  };
+
+  // Entries under the Data name may be of either kind.  Shorter names are only probed at the
+  // lengths where entries needing prefix matching exist; once a NameTree entry is found,
+  // its ancestors are reached through parent pointers instead of hash lookups.
+  shared_ptr<name_tree::Entry> nte;
+  if (name.size() < m_nEntriesOfLength.size() && m_nEntriesOfLength[name.size()] > 0) {
+    nte = m_nameTree.findExactMatch(name, name.size(), hashSet);
+    if (nte != nullptr) {
+      addMatches(*nte);
+    }
+  }
+
+  for (size_t len = std::min(name.size(), m_nPrefixEntriesOfLength.size()); len-- > 0; ) {
+    if (m_nPrefixEntriesOfLength[len] == 0) {
+      continue;
+    }
+
+    if (nte != nullptr) {
+      while (nte->getPrefix().size() > len) {
+        nte = nte->getParent();
+      }
+    }
+    else {
+      nte = m_nameTree.findExactMatch(name, len, hashSet);
+    }
+
+    if (nte != nullptr) {
+      addMatches(*nte);
+    }
   }
 
   return matches;
@@ -114,6 +165,55 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
 
   --m_nItems;
+  countEntry(*pitEntry, -1);
+}
+
+void
+Pit::countEntry(const pit::Entry& entry, int delta)
+{
+  size_t len = entry.getName().size();
+  if (m_nEntriesOfLength.size() <= len) {
+    m_nEntriesOfLength.resize(len + 1, 0);
+    m_nPrefixEntriesOfLength.resize(len + 1, 0);
+  }
+
+  m_nEntriesOfLength[len] += delta;
+  if (entry.needsPrefixMatch()) {
+    m_nPrefixEntriesOfLength[len] += delta;
+  }
+}
+
+template<typename Collection>
+static size_t
+getRecordsMemoryUsage(const Collection& records)
+{
+  // records within the inline capacity are part of the entry
+  if (records.capacity() <= NFD_PIT_RECORDS_INLINE_CAPACITY) {
+    return 0;
+  }
+  return records.capacity() * sizeof(typename Collection::value_type);
+}
+
+size_t
+Pit::getMemoryUsage() const
+{
+  size_t n = 0;
+  for (const pit::Entry& entry : *this) {
+    const Interest& interest = entry.getInterest();
+    n += sizeof(pit::Entry) + 2 * sizeof(void*) +
+         sizeof(Interest) + interest.wireEncode().size() +
+         getRecordsMemoryUsage(entry.getInRecords()) +
+         getRecordsMemoryUsage(entry.getOutRecords());
+
+    // an in-record keeps the Interest received on its face, which often is another copy
+    for (const pit::InRecord& inRecord : entry.getInRecords()) {
+      const Interest& received = inRecord.getInterest();
+      if (&received != &interest) {
+        n += sizeof(Interest) + received.wireEncode().size();
+      }
+    }
+  }
+  return n;
 }
 
 Pit::const_iterator
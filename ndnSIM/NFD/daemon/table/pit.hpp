@@ -58,6 +58,14 @@ public:
   size_t
   size() const;
 
+  /** \brief approximate number of bytes used by PIT entries, their records and Interests
+   *
+   *  The name tree entries holding the PIT entries are reported by NameTree.
+   *  Visits all entries.
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
@@ -66,6 +74,12 @@ public:
   std::pair<shared_ptr<pit::Entry>, bool>
   insert(const Interest& interest);
 
+  /** \brief finds a PIT entry for exact same name and selectors as Interest
+   *  \return the entry, or nullptr if not found
+   */
+  shared_ptr<pit::Entry>
+  find(const Interest& interest) const;
+
   /** \brief performs a Data match
    *  \return an iterable of all PIT entries matching data
    */
@@ -134,9 +148,17 @@ public: // enumeration
     size_t m_iPitEntry;
   };
 
+private:
+  void
+  countEntry(const pit::Entry& entry, int delta);
+
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  /// number of entries by Interest name length
+  std::vector<size_t> m_nEntriesOfLength;
+  /// number of entries that need prefix matching, by Interest name length
+  std::vector<size_t> m_nPrefixEntriesOfLength;
 };
 
 inline size_t
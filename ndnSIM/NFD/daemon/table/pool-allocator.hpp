@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_POOL_ALLOCATOR_HPP
+#define NFD_DAEMON_TABLE_POOL_ALLOCATOR_HPP
+
+#include "common.hpp"
+
+#include <type_traits>
+
+namespace nfd {
+
+/** \brief occupancy of the pool of a PoolAllocator tag
+ */
+struct PoolStats
+{
+  PoolStats()
+    : nSlabs(0)
+    , nBlocks(0)
+    , nInUse(0)
+  {
+  }
+
+  size_t nSlabs;  ///< slabs obtained from the global heap, never returned
+  size_t nBlocks; ///< blocks in all slabs
+  size_t nInUse;  ///< blocks handed out and not released yet
+};
+
+/** \return occupancy of the pool used by PoolAllocator<T, Tag> for any T
+ */
+template<typename Tag>
+PoolStats&
+getPoolStats()
+{
+  static PoolStats stats;
+  return stats;
+}
+
+/** \brief allocator that carves single objects out of slabs and reuses released blocks
+ *
+ *  Table entries are created and erased at the packet rate.  Objects allocated one at a time,
+ *  such as those of std::allocate_shared, are taken from a free list refilled with a slab of
+ *  SLAB_SIZE blocks at a time, so they stay close together in memory and their memory is
+ *  reused rather than returned to the global heap.  Other allocations use operator new.
+ *
+ *  The pool of a type is shared by all tables of the process.  Entries can outlive the table
+ *  that created them, and ns-3 runs every forwarder of a simulation in one thread.
+ *
+ *  \tparam Tag groups the statistics of getPoolStats; allocators rebound by allocate_shared
+ *              keep the Tag of the entry type
+ */
+template<typename T, typename Tag = T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef PoolAllocator<U, Tag> other;
+  };
+
+  static const size_t SLAB_SIZE = 64;
+
+  PoolAllocator()
+  {
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U, Tag>&)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    if (s_freeList == nullptr) {
+      allocateSlab();
+    }
+    Block* block = s_freeList;
+    s_freeList = block->next;
+    ++getPoolStats<Tag>().nInUse;
+    return reinterpret_cast<T*>(block);
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+
+    Block* block = reinterpret_cast<Block*>(p);
+    block->next = s_freeList;
+    s_freeList = block;
+    --getPoolStats<Tag>().nInUse;
+  }
+
+private:
+  union Block
+  {
+    Block* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  static void
+  allocateSlab()
+  {
+    Block* slab = static_cast<Block*>(::operator new(SLAB_SIZE * sizeof(Block)));
+    for (size_t i = SLAB_SIZE; i > 0; --i) {
+      slab[i - 1].next = s_freeList;
+      s_freeList = &slab[i - 1];
+    }
+
+    PoolStats& stats = getPoolStats<Tag>();
+    ++stats.nSlabs;
+    stats.nBlocks += SLAB_SIZE;
+  }
+
+private:
+  static Block* s_freeList;
+};
+
+template<typename T, typename Tag>
+const size_t PoolAllocator<T, Tag>::SLAB_SIZE;
+
+template<typename T, typename Tag>
+typename PoolAllocator<T, Tag>::Block* PoolAllocator<T, Tag>::s_freeList = nullptr;
+
+template<typename T, typename U, typename Tag>
+bool
+operator==(const PoolAllocator<T, Tag>&, const PoolAllocator<U, Tag>&)
+{
+  return true;
+}
+
+template<typename T, typename U, typename Tag>
+bool
+operator!=(const PoolAllocator<T, Tag>&, const PoolAllocator<U, Tag>&)
+{
+  return false;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_POOL_ALLOCATOR_HPP
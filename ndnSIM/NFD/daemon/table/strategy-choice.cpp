@@ -39,6 +39,7 @@ NFD_LOG_INIT("StrategyChoice");
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_version(1)
 {
   //cout<<"defaultStrategy="<<defaultStrategy->getName()<<endl;
   this->setDefaultStrategy(defaultStrategy);
@@ -72,6 +73,12 @@ StrategyChoice::install(shared_ptr<Strategy> strategy)
   return true;
 }
 
+void
+StrategyChoice::setStrategyFactory(const StrategyFactory& factory)
+{
+  m_strategyFactory = factory;
+}
+
 fw::Strategy*
 StrategyChoice::getStrategy(const Name& strategyName) const
 {
@@ -86,6 +93,15 @@ StrategyChoice::getStrategy(const Name& strategyName) const
       break;
     }
   }
+
+  if (candidate == nullptr && m_strategyFactory) {
+    shared_ptr<Strategy> strategy = m_strategyFactory(strategyName);
+    if (strategy != nullptr && m_strategyInstances.count(strategy->getName()) == 0) {
+      NFD_LOG_TRACE("getStrategy(" << strategyName << ") installing " << strategy->getName());
+      m_strategyInstances[strategy->getName()] = strategy;
+      candidate = strategy.get();
+    }
+  }
   return candidate;
 }
 
@@ -121,6 +137,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(*strategy);
+  ++m_version;
   return true;
 }
 
@@ -147,6 +164,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(shared_ptr<Entry>());
   m_nameTree.eraseEntryIfEmpty(nte);
   --m_nItems;
+  ++m_version;
 }
 
 std::pair<bool, Name>
@@ -198,6 +216,11 @@ StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
+  Strategy* strategy = pitEntry.getCachedStrategy(m_version);
+  if (strategy != nullptr) {
+    return *strategy;
+  }
+
   shared_ptr<name_tree::Entry> nte = m_nameTree.get(pitEntry);
 
   BOOST_ASSERT(static_cast<bool>(nte));
@@ -205,7 +228,9 @@ StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
   //cout<<"PIT entry="<<pitEntry.getName();
   //cout<<" ,name tree entry="<<nte->getPrefix()<<endl;
   //cout<<", Strategy="<<this->findEffectiveStrategy(nte).getName()<<endl;
-  return this->findEffectiveStrategy(nte);
+  Strategy& effectiveStrategy = this->findEffectiveStrategy(nte);
+  pitEntry.setCachedStrategy(m_version, effectiveStrategy);
+  return effectiveStrategy;
 }
 
 Strategy&
@@ -231,6 +256,7 @@ StrategyChoice::setDefaultStrategy(shared_ptr<Strategy> strategy)
   NFD_LOG_INFO("setDefaultStrategy " << strategy->getName());
 
   entry->setStrategy(*strategy);
+  ++m_version;
 }
 
 static inline void
@@ -62,6 +62,18 @@ public: // available Strategy types
   bool
   install(shared_ptr<fw::Strategy> strategy);
 
+  /** \brief creates a strategy from its versioned or unversioned name, nullptr if unknown
+   */
+  typedef function<shared_ptr<fw::Strategy>(const Name& strategyName)> StrategyFactory;
+
+  /** \brief install strategies on first use
+   *
+   *  A strategy that is not installed is created with \p factory when it is first chosen
+   *  or looked up, so that only the strategies in use are instantiated.
+   */
+  void
+  setStrategyFactory(const StrategyFactory& factory);
+
 public: // Strategy Choice table
   /** \brief set strategy of prefix to be strategyName
    *  \param strategyName the strategy to be used
@@ -93,7 +105,10 @@ public: // effective strategy
   fw::Strategy&
   findEffectiveStrategy(const Name& prefix) const;
 
-  /// get effective strategy for pitEntry
+  /** \brief get effective strategy for pitEntry
+   *
+   *  The result is cached on pitEntry until the version changes.
+   */
   fw::Strategy&
   findEffectiveStrategy(const pit::Entry& pitEntry) const;
 
@@ -101,6 +116,12 @@ public: // effective strategy
   fw::Strategy&
   findEffectiveStrategy(const measurements::Entry& measurementsEntry) const;
 
+  /** \return version of strategy choices, which changes whenever the effective strategy
+   *          of any prefix may have changed
+   */
+  uint64_t
+  getVersion() const;
+
 public: // enumeration
   class const_iterator
     : public std::iterator<std::forward_iterator_tag, const strategy_choice::Entry>
@@ -144,7 +165,7 @@ public: // enumeration
   end() const;
 
 private:
-  /** \brief get Strategy instance by strategyName
+  /** \brief get Strategy instance by strategyName, installing it if it can be created
    *  \param strategyName a versioned or unversioned strategyName
    */
   fw::Strategy*
@@ -164,9 +185,11 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  uint64_t m_version;
 
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
-  StrategyInstanceTable m_strategyInstances;
+  mutable StrategyInstanceTable m_strategyInstances; ///< extended by m_strategyFactory
+  StrategyFactory m_strategyFactory;
 };
 
 inline size_t
@@ -175,6 +198,12 @@ StrategyChoice::size() const
   return m_nItems;
 }
 
+inline uint64_t
+StrategyChoice::getVersion() const
+{
+  return m_version;
+}
+
 inline StrategyChoice::const_iterator
 StrategyChoice::end() const
 {
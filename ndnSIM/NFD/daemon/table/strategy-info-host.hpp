@@ -27,10 +27,27 @@
 #define NFD_DAEMON_TABLE_STRATEGY_INFO_HOST_HPP
 
 #include "fw/strategy-info.hpp"
+#include "pool-allocator.hpp"
+
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif // BOOST_VERSION >= 105800
 
 namespace nfd {
 
+/** \brief number of StrategyInfo items stored in a host without heap allocation
+ *
+ *  PIT entries, Measurements entries and face records mostly hold zero or one item.
+ */
+#ifndef NFD_STRATEGY_INFO_INLINE_CAPACITY
+#define NFD_STRATEGY_INFO_INLINE_CAPACITY 1
+#endif // NFD_STRATEGY_INFO_INLINE_CAPACITY
+
 /** \brief base class for an entity onto which StrategyInfo objects may be placed
+ *
+ *  Items are kept in a small array searched by type ID.  Items created by
+ *  getOrCreateStrategyInfo are taken from a PoolAllocator of their type.
  */
 class StrategyInfoHost
 {
@@ -66,9 +83,37 @@ public:
   clearStrategyInfo();
 
 private:
-  std::map<int, shared_ptr<fw::StrategyInfo>> m_items;
+  typedef std::pair<int, shared_ptr<fw::StrategyInfo>> Item;
+#if BOOST_VERSION >= 105800
+  typedef boost::container::small_vector<Item, NFD_STRATEGY_INFO_INLINE_CAPACITY> ItemCollection;
+#else
+  typedef std::vector<Item> ItemCollection;
+#endif // BOOST_VERSION >= 105800
+
+  ItemCollection::iterator
+  findItem(int typeId);
+
+  ItemCollection::const_iterator
+  findItem(int typeId) const;
+
+private:
+  ItemCollection m_items;
 };
 
+inline StrategyInfoHost::ItemCollection::iterator
+StrategyInfoHost::findItem(int typeId)
+{
+  return std::find_if(m_items.begin(), m_items.end(),
+                      [typeId] (const Item& item) { return item.first == typeId; });
+}
+
+inline StrategyInfoHost::ItemCollection::const_iterator
+StrategyInfoHost::findItem(int typeId) const
+{
+  return std::find_if(m_items.begin(), m_items.end(),
+                      [typeId] (const Item& item) { return item.first == typeId; });
+}
+
 
 template<typename T>
 shared_ptr<T>
@@ -77,7 +122,7 @@ StrategyInfoHost::getStrategyInfo() const
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  auto it = m_items.find(T::getTypeId());
+  auto it = this->findItem(T::getTypeId());
   if (it == m_items.end()) {
     return nullptr;
   }
@@ -91,11 +136,17 @@ StrategyInfoHost::setStrategyInfo(shared_ptr<T> item)
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
+  auto it = this->findItem(T::getTypeId());
   if (item == nullptr) {
-    m_items.erase(T::getTypeId());
+    if (it != m_items.end()) {
+      m_items.erase(it);
+    }
+  }
+  else if (it != m_items.end()) {
+    it->second = item;
   }
   else {
-    m_items[T::getTypeId()] = item;
+    m_items.emplace_back(T::getTypeId(), item);
   }
 }
 
@@ -108,7 +159,7 @@ StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
 
   shared_ptr<T> item = this->getStrategyInfo<T>();
   if (!static_cast<bool>(item)) {
-    item = make_shared<T>(std::forward<A>(args)...);
+    item = std::allocate_shared<T>(PoolAllocator<T>(), std::forward<A>(args)...);
     this->setStrategyInfo(item);
   }
   return item;
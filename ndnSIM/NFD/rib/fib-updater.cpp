@@ -38,6 +38,7 @@ NFD_LOG_INIT("FibUpdater");
 
 const unsigned int FibUpdater::MAX_NUM_TIMEOUTS = 10;
 const uint32_t FibUpdater::ERROR_FACE_NOT_FOUND = 410;
+const size_t FibUpdater::MAX_BATCH_SIZE = 4000;
 
 FibUpdater::FibUpdater(Rib& rib, ndn::nfd::Controller& controller)
   : m_rib(rib)
@@ -195,7 +196,8 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
   std::string updateString = (updates.size() == 1) ? " update" : " updates";
   NFD_LOG_DEBUG("Applying " << updates.size() << updateString << " to FIB");
 
-  for (const FibUpdate& update : updates) {
+  if (updates.size() == 1) {
+    const FibUpdate& update = updates.front();
     NFD_LOG_DEBUG("Sending FIB update: " << update);
 
     if (update.action == FibUpdate::ADD_NEXTHOP) {
@@ -204,7 +206,57 @@ FibUpdater::sendUpdates(const FibUpdateList& updates,
     else if (update.action == FibUpdate::REMOVE_NEXTHOP) {
       sendRemoveNextHopUpdate(update, onSuccess, onFailure);
     }
+    return;
+  }
+
+  // Split the updates into batches that each fit in one command Interest
+  FibUpdateList batch;
+  size_t batchSize = 0;
+  for (const FibUpdate& update : updates) {
+    size_t updateSize = update.name.wireEncode().size() + 32; // FaceId, Cost and headers
+
+    if (!batch.empty() && batchSize + updateSize > MAX_BATCH_SIZE) {
+      sendBatchUpdate(batch, onSuccess, onFailure);
+      batch.clear();
+      batchSize = 0;
+    }
+
+    batch.push_back(update);
+    batchSize += updateSize;
+  }
+
+  sendBatchUpdate(batch, onSuccess, onFailure);
+}
+
+void
+FibUpdater::sendBatchUpdate(const FibUpdateList& updates,
+                            const FibUpdateSuccessCallback& onSuccess,
+                            const FibUpdateFailureCallback& onFailure,
+                            uint32_t nTimeouts)
+{
+  NFD_LOG_DEBUG("Sending FIB batch of " << updates.size() << " updates");
+
+  std::vector<ControlParameters> entries;
+  entries.reserve(updates.size());
+  for (const FibUpdate& update : updates) {
+    NFD_LOG_TRACE("Batched FIB update: " << update);
+
+    ControlParameters parameters;
+    parameters.setName(update.name)
+              .setFaceId(update.faceId);
+
+    // an entry without Cost removes the nexthop
+    if (update.action == FibUpdate::ADD_NEXTHOP) {
+      parameters.setCost(update.cost);
+    }
+    entries.push_back(parameters);
   }
+
+  m_controller.startBatch<ndn::nfd::FibBatchCommand>(
+    entries,
+    bind(&FibUpdater::onBatchUpdateSuccess, this, updates, onSuccess, onFailure),
+    bind(&FibUpdater::onBatchUpdateError, this, updates, onSuccess, onFailure,
+         _1, _2, nTimeouts));
 }
 
 void
@@ -290,7 +342,12 @@ FibUpdater::onUpdateError(const FibUpdate update,
   NFD_LOG_DEBUG("Failed to apply " << update << " (code: " << code << ", error: " << error << ")");
 
   if (code == ndn::nfd::Controller::ERROR_TIMEOUT && nTimeouts < MAX_NUM_TIMEOUTS) {
-    sendAddNextHopUpdate(update, onSuccess, onFailure, ++nTimeouts);
+    if (update.action == FibUpdate::ADD_NEXTHOP) {
+      sendAddNextHopUpdate(update, onSuccess, onFailure, ++nTimeouts);
+    }
+    else {
+      sendRemoveNextHopUpdate(update, onSuccess, onFailure, ++nTimeouts);
+    }
   }
   else if (code == ERROR_FACE_NOT_FOUND) {
     if (update.faceId == m_batchFaceId) {
@@ -310,6 +367,50 @@ FibUpdater::onUpdateError(const FibUpdate update,
   }
 }
 
+void
+FibUpdater::onBatchUpdateSuccess(const FibUpdateList updates,
+                                 const FibUpdateSuccessCallback& onSuccess,
+                                 const FibUpdateFailureCallback& onFailure)
+{
+  for (const FibUpdate& update : updates) {
+    onUpdateSuccess(update, onSuccess, onFailure);
+  }
+}
+
+void
+FibUpdater::onBatchUpdateError(const FibUpdateList updates,
+                               const FibUpdateSuccessCallback& onSuccess,
+                               const FibUpdateFailureCallback& onFailure,
+                               uint32_t code, const std::string& error, uint32_t nTimeouts)
+{
+  NFD_LOG_DEBUG("Failed to apply FIB batch of " << updates.size() << " updates"
+                << " (code: " << code << ", error: " << error << ")");
+
+  if (code == ndn::nfd::Controller::ERROR_TIMEOUT && nTimeouts < MAX_NUM_TIMEOUTS) {
+    sendBatchUpdate(updates, onSuccess, onFailure, ++nTimeouts);
+  }
+  else if (code == ERROR_FACE_NOT_FOUND) {
+    if (updates.front().faceId == m_batchFaceId) {
+      onFailure(code, error);
+    }
+    else {
+      // Find out which updates refer to a non-existent face
+      for (const FibUpdate& update : updates) {
+        if (update.action == FibUpdate::ADD_NEXTHOP) {
+          sendAddNextHopUpdate(update, onSuccess, onFailure);
+        }
+        else {
+          sendRemoveNextHopUpdate(update, onSuccess, onFailure);
+        }
+      }
+    }
+  }
+  else {
+    BOOST_THROW_EXCEPTION(Error("Non-recoverable error: " + error + " code: " +
+                                std::to_string(code)));
+  }
+}
+
 void
 FibUpdater::addFibUpdate(FibUpdate update)
 {
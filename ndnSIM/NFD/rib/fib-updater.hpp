@@ -79,6 +79,10 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   /** \brief sends the passed updates to NFD
   *
+  *   A single update is sent as a FibAddNextHopCommand or FibRemoveNextHopCommand.
+  *   Several updates are sent as FibBatchCommands of at most MAX_BATCH_SIZE bytes each,
+  *   so that a bulk registration or a face removal does not cost one command per nexthop.
+  *
   *   onSuccess or onFailure will be called based on the results in
   *   onUpdateSuccess or onUpdateFailure
   *
@@ -104,6 +108,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   sendUpdatesForNonBatchFaceId(const FibUpdateSuccessCallback& onSuccess,
                                const FibUpdateFailureCallback& onFailure);
 
+  /** \brief sends the passed updates to NFD in one FibBatchCommand
+  *
+  *   The updates must all belong to either m_updatesForBatchFaceId or
+  *   m_updatesForNonBatchFaceId.
+  *
+  *   \param nTimeouts the number of times this batch has failed due to timeout
+  */
+  void
+  sendBatchUpdate(const FibUpdateList& updates,
+                  const FibUpdateSuccessCallback& onSuccess,
+                  const FibUpdateFailureCallback& onFailure,
+                  uint32_t nTimeouts = 0);
+
   /** \brief sends a FibAddNextHopCommand to NFD using the parameters supplied by
   *          the passed update
   *
@@ -175,6 +192,33 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
                 const FibUpdateFailureCallback& onFailure,
                 uint32_t code, const std::string& error, uint32_t nTimeouts);
 
+  /** \brief callback used by NfdController when a FibBatchCommand is successful
+  *
+  *   Every update in the batch is handled as by FibUpdater::onUpdateSuccess.
+  */
+  void
+  onBatchUpdateSuccess(const FibUpdateList updates,
+                       const FibUpdateSuccessCallback& onSuccess,
+                       const FibUpdateFailureCallback& onFailure);
+
+  /** \brief callback used by NfdController when a FibBatchCommand fails
+  *
+  *   If the batch has not reached the max number of timeouts allowed, the batch
+  *   is retried.
+  *
+  *   The forwarder rejects the whole batch if a nexthop face does not exist. If the
+  *   updates have the same Face ID as the update batch, the FIB update process fails.
+  *   Otherwise, the updates are sent again one command each, so that only the updates
+  *   for the non-existent face are dropped.
+  *
+  *   Otherwise, a non-recoverable error has occurred and an exception is thrown.
+  */
+  void
+  onBatchUpdateError(const FibUpdateList updates,
+                     const FibUpdateSuccessCallback& onSuccess,
+                     const FibUpdateFailureCallback& onFailure,
+                     uint32_t code, const std::string& error, uint32_t nTimeouts);
+
 private:
   /** \brief adds the update to an update list based on its Face ID
   *
@@ -271,6 +315,11 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 private:
   static const unsigned int MAX_NUM_TIMEOUTS;
   static const uint32_t ERROR_FACE_NOT_FOUND;
+
+  /** \brief maximum encoded size of the entries in one FibBatchCommand,
+   *         which keeps the signed command Interest well below the packet size limit
+   */
+  static const size_t MAX_BATCH_SIZE;
 };
 
 } // namespace rib
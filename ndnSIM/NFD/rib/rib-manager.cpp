@@ -37,6 +37,7 @@ NFD_LOG_INIT("RibManager");
 const Name RibManager::COMMAND_PREFIX = "/localhost/nfd/rib";
 const Name RibManager::REMOTE_COMMAND_PREFIX = "/localhop/nfd/rib";
 const Name RibManager::FACES_LIST_DATASET_PREFIX = "/localhost/nfd/faces/list";
+const Name::Component RibManager::BATCH_REGISTER_VERB("batch-register");
 
 const size_t RibManager::COMMAND_UNSIGNED_NCOMPS =
   RibManager::COMMAND_PREFIX.size() +
@@ -91,6 +92,8 @@ RibManager::RibManager(ndn::Face& face, ndn::KeyChain& keyChain)
                            UNSIGNED_COMMAND_VERBS +
                            (sizeof(UNSIGNED_COMMAND_VERBS) / sizeof(UnsignedVerbAndProcessor)))
 {
+  m_managedRib.afterRouteChange.connect(bind(&RibStatusPublisher::invalidate,
+                                             &m_ribStatusPublisher));
 }
 
 RibManager::~RibManager()
@@ -235,6 +238,12 @@ RibManager::onCommandValidated(const shared_ptr<const Interest>& request)
   const Name::Component& verb = command[COMMAND_PREFIX.size()];
   const Name::Component& parameterComponent = command[COMMAND_PREFIX.size() + 1];
 
+  if (verb == BATCH_REGISTER_VERB) {
+    NFD_LOG_DEBUG("command result: processing verb: " << verb);
+    registerEntries(request);
+    return;
+  }
+
   SignedVerbDispatchTable::const_iterator verbProcessor = m_signedVerbDispatch.find(verb);
 
   if (verbProcessor != m_signedVerbDispatch.end()) {
@@ -286,6 +295,66 @@ RibManager::registerEntry(const shared_ptr<const Interest>& request,
   // Respond since command is valid and authorized
   sendSuccessResponse(request, parameters);
 
+  RibUpdate update = createRegisterUpdate(parameters);
+
+  m_managedRib.beginApplyUpdate(update,
+                                bind(&RibManager::onRibUpdateSuccess, this, update),
+                                bind(&RibManager::onRibUpdateFailure, this, update, _1, _2));
+
+  m_registeredFaces.insert(update.getRoute().faceId);
+}
+
+void
+RibManager::registerEntries(const shared_ptr<const Interest>& request)
+{
+  const Name& command = request->getName();
+
+  std::vector<ControlParameters> entries;
+  try {
+    entries = ndn::nfd::BatchControlCommand::decodeEntries(command[COMMAND_PREFIX.size() + 1]);
+  }
+  catch (const tlv::Error& e) {
+    NFD_LOG_DEBUG("batch-register result: FAIL reason: malformed: " << e.what());
+    sendResponse(command, 400, "Malformed command");
+    return;
+  }
+
+  if (entries.empty()) {
+    NFD_LOG_DEBUG("batch-register result: FAIL reason: empty");
+    sendResponse(command, 400, "Malformed command");
+    return;
+  }
+
+  ndn::nfd::RibBatchRegisterCommand batchCommand;
+  for (ControlParameters& parameters : entries) {
+    if (!validateParameters(batchCommand, parameters)) {
+      NFD_LOG_DEBUG("batch-register result: FAIL reason: malformed entry");
+      sendResponse(command, 400, "Malformed command");
+      return;
+    }
+
+    bool isSelfRegistration = (!parameters.hasFaceId() || parameters.getFaceId() == 0);
+    if (isSelfRegistration) {
+      parameters.setFaceId(request->getIncomingFaceId());
+    }
+  }
+
+  // Respond since command is valid and authorized
+  sendSuccessResponse(request, ControlParameters());
+
+  RibUpdateList updates;
+  for (const ControlParameters& parameters : entries) {
+    updates.push_back(createRegisterUpdate(parameters));
+    m_registeredFaces.insert(parameters.getFaceId());
+  }
+
+  m_managedRib.beginApplyUpdates(updates, nullptr,
+                                 bind(&RibManager::onRibBatchUpdateFailure, this, _1, _2));
+}
+
+RibUpdate
+RibManager::createRegisterUpdate(const ControlParameters& parameters)
+{
   Route route;
   route.faceId = parameters.getFaceId();
   route.origin = parameters.getOrigin();
@@ -320,11 +389,7 @@ RibManager::registerEntry(const shared_ptr<const Interest>& request,
         .setName(parameters.getName())
         .setRoute(route);
 
-  m_managedRib.beginApplyUpdate(update,
-                                bind(&RibManager::onRibUpdateSuccess, this, update),
-                                bind(&RibManager::onRibUpdateFailure, this, update, _1, _2));
-
-  m_registeredFaces.insert(route.faceId);
+  return update;
 }
 
 void
@@ -550,6 +615,15 @@ RibManager::onRibUpdateFailure(const RibUpdate& update, uint32_t code, const std
   scheduleActiveFaceFetch(time::seconds(1));
 }
 
+void
+RibManager::onRibBatchUpdateFailure(uint32_t code, const std::string& error)
+{
+  NFD_LOG_DEBUG("RIB batch update failed (code: " << code << ", error: " << error << ")");
+
+  // Since the FIB rejected the update, clean up invalid routes
+  scheduleActiveFaceFetch(time::seconds(1));
+}
+
 void
 RibManager::onNrdCommandPrefixAddNextHopSuccess(const Name& prefix,
                                                 const ndn::nfd::ControlParameters& result)
@@ -80,6 +80,9 @@ public:
   void
   onRibUpdateFailure(const RibUpdate& update, uint32_t code, const std::string& error);
 
+  void
+  onRibBatchUpdateFailure(uint32_t code, const std::string& error);
+
 private:
   void
   onConfig(const ConfigSection& configSection,
@@ -116,10 +119,24 @@ private:
   registerEntry(const shared_ptr<const Interest>& request,
                 ControlParameters& parameters);
 
+  /** \brief processes a rib/batch-register command
+   *
+   *  All entries are validated before any route is added; the routes are then passed
+   *  to the RIB together, so that their FIB updates can share RibUpdateBatches.
+   */
+  void
+  registerEntries(const shared_ptr<const Interest>& request);
+
   void
   unregisterEntry(const shared_ptr<const Interest>& request,
                   ControlParameters& parameters);
 
+  /** \brief creates the REGISTER update for validated register parameters,
+   *         and schedules the expiration of the route
+   */
+  RibUpdate
+  createRegisterUpdate(const ControlParameters& parameters);
+
 private:
   void
   onCommandValidated(const shared_ptr<const Interest>& request);
@@ -231,6 +248,8 @@ private:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   static const Name REMOTE_COMMAND_PREFIX; // /localhop/nrd
 
+  static const Name::Component BATCH_REGISTER_VERB;
+
 private:
   // number of components in an invalid, but not malformed, unsigned command.
   // (/localhost/nrd + verb + options) = 4
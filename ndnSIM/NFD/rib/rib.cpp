@@ -115,6 +115,8 @@ Rib::insert(const Name& prefix, const Route& route)
       routeIt->cost = route.cost;
       routeIt->expires = route.expires;
     }
+
+    afterRouteChange(prefix);
   }
   else {
     // New name prefix
@@ -134,17 +136,23 @@ Rib::insert(const Name& prefix, const Route& route)
       parent->addChild(entry);
     }
 
-    RibEntryList children = findDescendants(prefix);
-
-    for (const auto& child : children) {
-      if (child->getParent() == parent) {
-        // Remove child from parent and inherit parent's child
-        if (parent != nullptr) {
-          parent->removeChild(child);
-        }
+    // Entries under the new prefix that had the same parent become its children.
+    // The subtree of each of them is skipped, so only the direct children are visited.
+    RibTable::iterator it = m_rib.upper_bound(prefix);
+    while (it != m_rib.end() && prefix.isPrefixOf(it->first)) {
+      shared_ptr<RibEntry> child = it->second;
+      if (child->getParent() != parent) {
+        ++it;
+        continue;
+      }
 
-        entry->addChild(child);
+      // Remove child from parent and inherit parent's child
+      if (parent != nullptr) {
+        parent->removeChild(child);
       }
+
+      entry->addChild(child);
+      it = m_rib.lower_bound(it->first.getSuccessor());
     }
 
     // Register with face lookup table
@@ -152,6 +160,7 @@ Rib::insert(const Name& prefix, const Route& route)
 
     // do something after inserting an entry
     afterInsertEntry(prefix);
+    afterRouteChange(prefix);
   }
 }
 
@@ -179,6 +188,8 @@ Rib::erase(const Name& prefix, const Route& route)
       if (entry->getRoutes().size() == 0) {
         eraseEntry(ribIt);
       }
+
+      afterRouteChange(entry->getName());
     }
   }
 }
@@ -237,10 +248,10 @@ Rib::findDescendantsForNonInsertedName(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  for (std::pair<Name, shared_ptr<RibEntry>> pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+  // names under prefix are contiguous in the table, starting at where prefix would be
+  for (RibTable::const_iterator it = m_rib.lower_bound(prefix);
+       it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -346,6 +357,52 @@ Rib::beginApplyUpdate(const RibUpdate& update,
   sendBatchFromQueue();
 }
 
+void
+Rib::beginApplyUpdates(const RibUpdateList& updates,
+                       const Rib::UpdateSuccessCallback& onSuccess,
+                       const Rib::UpdateFailureCallback& onFailure)
+{
+  BOOST_ASSERT(m_fibUpdater != nullptr);
+
+  unique_ptr<RibUpdateBatch> batch;
+  std::set<Name> batchNames;
+
+  for (const RibUpdate& update : updates) {
+    const Name& name = update.getName();
+
+    bool isIndependent = (batch != nullptr && batch->getFaceId() == update.getRoute().faceId);
+    if (isIndependent) {
+      // no name in the batch may be a prefix of this name
+      for (size_t i = 0; i <= name.size() && isIndependent; ++i) {
+        isIndependent = (batchNames.count(name.getPrefix(i)) == 0);
+      }
+
+      // names under this name are contiguous, starting from the name itself
+      std::set<Name>::const_iterator next = batchNames.lower_bound(name);
+      if (isIndependent && next != batchNames.end() && name.isPrefixOf(*next)) {
+        isIndependent = false;
+      }
+    }
+
+    if (!isIndependent) {
+      if (batch != nullptr) {
+        addBatchToQueue(*batch, onSuccess, onFailure);
+      }
+      batch.reset(new RibUpdateBatch(update.getRoute().faceId));
+      batchNames.clear();
+    }
+
+    batch->add(update);
+    batchNames.insert(name);
+  }
+
+  if (batch != nullptr) {
+    addBatchToQueue(*batch, onSuccess, onFailure);
+  }
+
+  sendBatchFromQueue();
+}
+
 void
 Rib::beginRemoveFace(uint64_t faceId)
 {
@@ -369,6 +426,14 @@ Rib::addUpdateToQueue(const RibUpdate& update,
   RibUpdateBatch batch(update.getRoute().faceId);
   batch.add(update);
 
+  addBatchToQueue(batch, onSuccess, onFailure);
+}
+
+void
+Rib::addBatchToQueue(const RibUpdateBatch& batch,
+                     const Rib::UpdateSuccessCallback& onSuccess,
+                     const Rib::UpdateFailureCallback& onFailure)
+{
   UpdateQueueItem item{batch, onSuccess, onFailure};
   m_updateBatches.push_back(std::move(item));
 }
@@ -387,8 +452,9 @@ Rib::sendBatchFromQueue()
 
   RibUpdateBatch& batch = item.batch;
 
-  // Until task #1698, each RibUpdateBatch contains exactly one RIB update
-  BOOST_ASSERT(batch.size() == 1);
+  // A batch with several RIB updates only comes from beginApplyUpdates,
+  // which guarantees that its updates do not affect each other
+  BOOST_ASSERT(batch.size() >= 1);
 
   const Rib::UpdateSuccessCallback& managerSuccessCallback = item.managerSuccessCallback;
   const Rib::UpdateFailureCallback& managerFailureCallback = item.managerFailureCallback;
@@ -114,6 +114,19 @@ public:
                    const UpdateSuccessCallback& onSuccess,
                    const UpdateFailureCallback& onFailure);
 
+  /** \brief passes the provided updates to FibUpdater in as few RibUpdateBatches as possible
+   *
+   *  FibUpdater computes all updates of a batch from the same RIB state, so consecutive
+   *  updates are put in one batch only while they have the same FaceId and none of their
+   *  names is a prefix of another name in the batch.  Other updates start a new batch.
+   *
+   *  onSuccess or onFailure is called once for each batch.
+   */
+  void
+  beginApplyUpdates(const RibUpdateList& updates,
+                    const UpdateSuccessCallback& onSuccess,
+                    const UpdateFailureCallback& onFailure);
+
   /** \brief starts the FIB update process when a face has been destroyed
    */
   void
@@ -157,6 +170,13 @@ private:
   void
   sendBatchFromQueue();
 
+  /** \brief adds the passed batch to the end of the update queue
+  */
+  void
+  addBatchToQueue(const RibUpdateBatch& batch,
+                  const Rib::UpdateSuccessCallback& onSuccess,
+                  const Rib::UpdateFailureCallback& onFailure);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   // Used by RibManager unit-tests to get sent batch to simulate successful FIB update
   function<void(RibUpdateBatch)> m_onSendBatchFromQueue;
@@ -208,6 +228,10 @@ public:
   ndn::util::signal::Signal<Rib, Name> afterInsertEntry;
   ndn::util::signal::Signal<Rib, Name> afterEraseEntry;
 
+  /** \brief signals that a route of the name was inserted, updated or erased
+   */
+  ndn::util::signal::Signal<Rib, Name> afterRouteChange;
+
 private:
   RibTable m_rib;
   FaceLookupTable m_faceMap;
@@ -167,6 +167,33 @@ BOOST_FIXTURE_TEST_CASE(ScopedEventIdMove, UnitTestTimeFixture)
   BOOST_CHECK_EQUAL(hit, 1);
 }
 
+BOOST_FIXTURE_TEST_CASE(TimerSlack, UnitTestTimeFixture)
+{
+  scheduler::setTimerSlack(time::milliseconds(10));
+  BOOST_CHECK(scheduler::getTimerSlack() == time::milliseconds(10));
+
+  std::vector<int> order;
+  scheduler::schedule(time::milliseconds(7), [&] { order.push_back(2); });
+  scheduler::schedule(time::milliseconds(3), [&] { order.push_back(1); });
+  EventId i = scheduler::schedule(time::milliseconds(5), [&] { order.push_back(0); });
+  scheduler::cancel(i);
+  scheduler::schedule(time::milliseconds(12), [&] { order.push_back(3); });
+
+  // all of the first tick fire together at its end, in the order of their deadlines
+  this->advanceClocks(time::milliseconds(1), 9);
+  BOOST_CHECK_EQUAL(order.size(), 0);
+  this->advanceClocks(time::milliseconds(1), 1);
+  BOOST_REQUIRE_EQUAL(order.size(), 2);
+  BOOST_CHECK_EQUAL(order[0], 1);
+  BOOST_CHECK_EQUAL(order[1], 2);
+
+  this->advanceClocks(time::milliseconds(1), 10);
+  BOOST_REQUIRE_EQUAL(order.size(), 3);
+  BOOST_CHECK_EQUAL(order[2], 3);
+
+  scheduler::setTimerSlack(time::nanoseconds::zero());
+}
+
 BOOST_AUTO_TEST_CASE(ThreadLocalScheduler)
 {
   scheduler::Scheduler* s1 = &scheduler::getGlobalScheduler();
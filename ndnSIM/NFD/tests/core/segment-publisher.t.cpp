@@ -165,6 +165,26 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Generate, T, DatasetSizes, SegmentPublisherFixt
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(Cache, SegmentPublisherFixture<10>)
+{
+  m_publisher.publish();
+  m_publisher.publish();
+  m_face->processEvents();
+
+  // the second request is answered with the same segment, the dataset is generated once
+  BOOST_REQUIRE_EQUAL(m_face->sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(m_face->sentDatas[0].getName(), m_face->sentDatas[1].getName());
+  BOOST_CHECK(m_face->sentDatas[0].wireEncode() == m_face->sentDatas[1].wireEncode());
+  size_t payloadLength = m_publisher.getTotalPayloadLength();
+
+  m_publisher.invalidate();
+  m_publisher.publish();
+  m_face->processEvents();
+
+  BOOST_CHECK_EQUAL(m_face->sentDatas.size(), 3);
+  BOOST_CHECK_EQUAL(m_publisher.getTotalPayloadLength(), 2 * payloadLength);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/spsc-queue.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <thread>
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestSpscQueue, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  SpscQueue<int> queue(3);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+  BOOST_CHECK(queue.empty());
+
+  int element = 0;
+  BOOST_CHECK_EQUAL(queue.tryPop(element), false);
+
+  for (int i = 1; i <= 4; ++i) {
+    BOOST_CHECK(queue.tryPush(i));
+  }
+  BOOST_CHECK_EQUAL(queue.tryPush(5), false);
+  BOOST_CHECK_EQUAL(queue.size(), 4);
+
+  BOOST_REQUIRE(queue.tryPop(element));
+  BOOST_CHECK_EQUAL(element, 1);
+  BOOST_CHECK(queue.tryPush(5));
+
+  for (int i = 2; i <= 5; ++i) {
+    BOOST_REQUIRE(queue.tryPop(element));
+    BOOST_CHECK_EQUAL(element, i);
+  }
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Destruction)
+{
+  auto data = makeData("/A");
+  {
+    SpscQueue<shared_ptr<Data>> queue(8);
+    queue.tryPush(data);
+    queue.tryPush(data);
+    BOOST_CHECK_EQUAL(data.use_count(), 3);
+  }
+  BOOST_CHECK_EQUAL(data.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(TwoThreads)
+{
+  static const int N_ELEMENTS = 100000;
+  SpscQueue<int> queue(64);
+
+  std::thread producer([&queue] {
+    for (int i = 0; i < N_ELEMENTS; ++i) {
+      while (!queue.tryPush(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int nReceived = 0;
+  bool isInOrder = true;
+  while (nReceived < N_ELEMENTS) {
+    int element = -1;
+    if (queue.tryPop(element)) {
+      isInOrder = isInOrder && element == nReceived;
+      ++nReceived;
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK(isInOrder);
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -179,6 +179,45 @@ BOOST_AUTO_TEST_CASE(SendPacket)
 //  BOOST_CHECK_EQUAL(m_face2_receivedDatas    [0].getName(), data1.getName());
 }
 
+BOOST_AUTO_TEST_CASE(SendPacketRing)
+{
+  if (m_interfaces.empty()) {
+    BOOST_WARN_MESSAGE(false, "No interfaces available for pcap, "
+                              "cannot perform SendPacketRing test");
+    return;
+  }
+
+  EthernetFactory factory;
+  factory.setPacketRingEnabled(true);
+  shared_ptr<EthernetFace> face = factory.createMulticastFace(m_interfaces.front(),
+                                    ethernet::getDefaultMulticastAddress());
+  BOOST_REQUIRE(static_cast<bool>(face));
+#if !defined(__linux__)
+  BOOST_CHECK_EQUAL(face->isUsingPacketRing(), false);
+#endif
+  BOOST_WARN_MESSAGE(face->isUsingPacketRing(), "Packet ring is not available, "
+                                                "the face has fallen back to libpcap");
+
+  face->onFail.connect([] (const std::string& reason) { BOOST_FAIL(reason); });
+
+  // more frames than one event loop iteration would usually carry
+  shared_ptr<Interest> interest = makeInterest("ndn:/x3A7AIoOAE");
+  shared_ptr<Data>     data     = makeData("ndn:/nGRVfRnfAS");
+  for (int i = 0; i < 100; ++i) {
+    face->sendInterest(*interest);
+    face->sendData    (*data    );
+  }
+
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutBytes(),
+                    100 * (14 * 2 + // 2 NDNLP headers
+                           interest->wireEncode().size() +
+                           data->wireEncode().size()));
+
+  // queued frames are flushed without failing the face
+  getGlobalIoService().poll();
+  getGlobalIoService().reset();
+}
+
 BOOST_AUTO_TEST_CASE(ProcessIncomingPacket)
 {
   if (m_interfaces.empty()) {
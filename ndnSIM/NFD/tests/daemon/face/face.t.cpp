@@ -59,6 +59,35 @@ BOOST_AUTO_TEST_CASE(LocalControlHeaderEnabled)
                          LOCAL_CONTROL_FEATURE_INCOMING_FACE_ID), false);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeThenDispatch)
+{
+  DummyFace face;
+  std::vector<Interest> receivedInterests;
+  std::vector<Data> receivedData;
+  face.onReceiveInterest.connect([&] (const Interest& interest) {
+    receivedInterests.push_back(interest);
+  });
+  face.onReceiveData.connect([&] (const Data& data) { receivedData.push_back(data); });
+
+  Face::DecodedInput input1;
+  BOOST_REQUIRE(Face::decodeInput(makeInterest("/A")->wireEncode(), input1));
+  Face::DecodedInput input2;
+  BOOST_REQUIRE(Face::decodeInput(makeData("/B")->wireEncode(), input2));
+  Face::DecodedInput input3;
+  BOOST_CHECK_EQUAL(Face::decodeInput(Block(tlv::Name), input3), false);
+
+  // decoding does not raise any event
+  BOOST_CHECK_EQUAL(receivedInterests.size(), 0);
+  BOOST_CHECK_EQUAL(receivedData.size(), 0);
+
+  face.dispatchInput(input2);
+  face.dispatchInput(input1);
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  BOOST_CHECK_EQUAL(receivedInterests[0].getName(), "/A");
+  BOOST_REQUIRE_EQUAL(receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(receivedData[0].getName(), "/B");
+}
+
 class FaceFailTestFace : public DummyFace
 {
 public:
@@ -86,6 +115,26 @@ public:
   int failCount;
 };
 
+BOOST_AUTO_TEST_CASE(Congestion)
+{
+  DummyFace face;
+  BOOST_CHECK_EQUAL(face.getTransmitQueueLength(), 0);
+  BOOST_CHECK_EQUAL(face.isCongested(), false);
+
+  std::vector<bool> changes;
+  face.onCongestionChanged.connect([&] (bool isCongested) { changes.push_back(isCongested); });
+
+  face.setCongested(true);
+  face.setCongested(true);
+  BOOST_CHECK_EQUAL(face.isCongested(), true);
+  face.setCongested(false);
+  BOOST_CHECK_EQUAL(face.isCongested(), false);
+
+  BOOST_REQUIRE_EQUAL(changes.size(), 2);
+  BOOST_CHECK_EQUAL(changes[0], true);
+  BOOST_CHECK_EQUAL(changes[1], false);
+}
+
 BOOST_AUTO_TEST_CASE(FailTwice)
 {
   FaceFailTestFace face;
@@ -299,6 +299,51 @@ BOOST_FIXTURE_TEST_CASE(ReassembleTimeout, ReassembleFixture)
                                 block.begin(),          block.end());
 }
 
+// fragments in any order, last fragment first
+BOOST_FIXTURE_TEST_CASE(ReassembleLastFirst, ReassembleFixture)
+{
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 4);
+
+  this->receiveNdnlpData(pa->at(3));
+  this->receiveNdnlpData(pa->at(1));
+  this->receiveNdnlpData(pa->at(0));
+  BOOST_CHECK_EQUAL(received.size(), 0);
+  this->receiveNdnlpData(pa->at(2));
+
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.at(0).begin(), received.at(0).end(),
+                                block.begin(),          block.end());
+  BOOST_CHECK_EQUAL(pms.size(), 0);
+}
+
+// idle partial messages are swept without any further fragment
+BOOST_FIXTURE_TEST_CASE(ReassembleSweep, ReassembleFixture)
+{
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  Block block2 = makeBlock(2000);
+  ndnlp::PacketArray pa2 = slicer.slice(block2);
+
+  this->receiveNdnlpData(pa->at(0));
+  this->receiveNdnlpData(pa2->at(0));
+  BOOST_CHECK_EQUAL(pms.size(), 2);
+
+  this->advanceClocks(time::milliseconds(10), 8);
+  this->receiveNdnlpData(pa2->at(1));
+  BOOST_CHECK_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL(pms.size(), 1);
+
+  this->advanceClocks(time::milliseconds(10), 15);
+  BOOST_CHECK_EQUAL(pms.size(), 0);
+
+  // the freed slot serves the next message
+  this->receiveNdnlpData(pa->at(1));
+  BOOST_CHECK_EQUAL(pms.size(), 1);
+  BOOST_CHECK_EQUAL(received.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
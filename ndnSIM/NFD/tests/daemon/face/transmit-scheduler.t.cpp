@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face/transmit-scheduler.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(FaceTransmitScheduler, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Priority)
+{
+  TransmitScheduler<int> scheduler;
+  BOOST_CHECK(scheduler.enqueue(1, 100, TRANSMIT_CLASS_INTEREST, 0));
+  BOOST_CHECK(scheduler.enqueue(2, 100, TRANSMIT_CLASS_DATA, 0));
+  BOOST_CHECK(scheduler.enqueue(3, 100, TRANSMIT_CLASS_CONTROL, 1));
+  BOOST_CHECK(scheduler.enqueue(4, 100, TRANSMIT_CLASS_INTEREST, 0));
+  BOOST_CHECK_EQUAL(scheduler.size(), 4);
+  BOOST_CHECK_EQUAL(scheduler.size(TRANSMIT_CLASS_INTEREST), 2);
+
+  std::vector<int> order;
+  int item = 0;
+  while (scheduler.dequeue(item)) {
+    order.push_back(item);
+  }
+  std::vector<int> expected{3, 2, 1, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+  BOOST_CHECK(scheduler.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Limit)
+{
+  TransmitScheduler<int> scheduler(2);
+  BOOST_CHECK(scheduler.enqueue(1, 100, TRANSMIT_CLASS_DATA, 0));
+  BOOST_CHECK(scheduler.enqueue(2, 100, TRANSMIT_CLASS_BULK, 0));
+  BOOST_CHECK(!scheduler.enqueue(3, 100, TRANSMIT_CLASS_CONTROL, 0));
+  BOOST_CHECK_EQUAL(scheduler.size(), 2);
+
+  scheduler.clear();
+  BOOST_CHECK(scheduler.empty());
+  BOOST_CHECK(scheduler.enqueue(3, 100, TRANSMIT_CLASS_CONTROL, 0));
+}
+
+BOOST_AUTO_TEST_CASE(WeightedFairQueuing)
+{
+  TransmitScheduler<int> scheduler(0, 1000);
+  scheduler.setWeight(1, 3);
+  BOOST_CHECK_EQUAL(scheduler.getWeight(1), 3);
+  BOOST_CHECK_EQUAL(scheduler.getWeight(2), 1);
+
+  // flow 1 arrives first with 40 packets, flow 2 right after with 40
+  for (int i = 0; i < 40; ++i) {
+    scheduler.enqueue(100 + i, 500, TRANSMIT_CLASS_DATA, 1);
+  }
+  for (int i = 0; i < 40; ++i) {
+    scheduler.enqueue(200 + i, 500, TRANSMIT_CLASS_DATA, 2);
+  }
+
+  // flow 1 sends three times as much as flow 2, in order within each flow
+  int nFlow1 = 0;
+  int nFlow2 = 0;
+  int lastFlow1 = 99;
+  int lastFlow2 = 199;
+  for (int i = 0; i < 40; ++i) {
+    int item = 0;
+    BOOST_REQUIRE(scheduler.dequeue(item));
+    if (item < 200) {
+      BOOST_CHECK_EQUAL(item, lastFlow1 + 1);
+      lastFlow1 = item;
+      ++nFlow1;
+    }
+    else {
+      BOOST_CHECK_EQUAL(item, lastFlow2 + 1);
+      lastFlow2 = item;
+      ++nFlow2;
+    }
+  }
+  BOOST_CHECK_EQUAL(nFlow1, 30);
+  BOOST_CHECK_EQUAL(nFlow2, 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -461,6 +461,64 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(EndToEnd, A, EndToEndAddresses)
   BOOST_CHECK_EQUAL(counters2.getNOutBytes(), nBytesSent2);
 }
 
+// end to end communication with recvmmsg/sendmmsg batching
+BOOST_AUTO_TEST_CASE_TEMPLATE(EndToEndBatched, A, EndToEndAddresses)
+{
+  LimitedIo limitedIo;
+  UdpFactory factory;
+  factory.setBatchSize(8);
+
+  shared_ptr<UdpChannel> channel1 = factory.createChannel(A::getLocalIp(), A::getPort1());
+  shared_ptr<Face> face1;
+  unique_ptr<FaceHistory> history1;
+  factory.createFace(A::getFaceUri2(),
+                     ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                     [&] (shared_ptr<Face> newFace) {
+                       face1 = newFace;
+                       history1.reset(new FaceHistory(*face1, limitedIo));
+                       limitedIo.afterOp();
+                     },
+                     [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  limitedIo.run(1, time::seconds(1));
+  BOOST_REQUIRE(face1 != nullptr);
+
+  shared_ptr<UdpChannel> channel2 = factory.createChannel(A::getLocalIp(), A::getPort2());
+  shared_ptr<Face> face2;
+  unique_ptr<FaceHistory> history2;
+  channel2->listen([&] (shared_ptr<Face> newFace) {
+                     BOOST_CHECK(face2 == nullptr);
+                     face2 = newFace;
+                     history2.reset(new FaceHistory(*face2, limitedIo));
+                     limitedIo.afterOp();
+                   },
+                   [] (const std::string& reason) { BOOST_ERROR(reason); });
+
+  // more packets than one batch, all queued in the same event loop iteration
+  shared_ptr<Interest> interest = makeInterest("/I");
+  shared_ptr<Data> data = makeData("/D");
+  for (int i = 0; i < 20; ++i) {
+    face1->sendData(*data);
+  }
+  size_t nBytesSent1 = 20 * data->wireEncode().size();
+
+  limitedIo.run(21, time::seconds(1)); // 1 accept, 20 receives
+  BOOST_REQUIRE(face2 != nullptr);
+  BOOST_CHECK_EQUAL(history2->receivedData.size(), 20);
+  BOOST_CHECK_EQUAL(face1->getCounters().getNOutBytes(), nBytesSent1);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNInBytes(), nBytesSent1);
+
+  for (int i = 0; i < 20; ++i) {
+    face2->sendInterest(*interest);
+  }
+  size_t nBytesSent2 = 20 * interest->wireEncode().size();
+
+  limitedIo.run(20, time::seconds(1)); // 20 receives
+  BOOST_CHECK_EQUAL(history1->receivedInterests.size(), 20);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNOutBytes(), nBytesSent2);
+  BOOST_CHECK_EQUAL(face1->getCounters().getNInBytes(), nBytesSent2);
+}
+
 // channel accepting multiple incoming connections
 BOOST_AUTO_TEST_CASE_TEMPLATE(MultipleAccepts, A, EndToEndAddresses)
 {
@@ -496,6 +496,44 @@ public:
 };
 
 
+BOOST_FIXTURE_TEST_CASE(ReceiveAcrossBuffers, SimpleEndToEndFixture)
+{
+  UnixStreamFactory factory;
+
+  shared_ptr<UnixStreamChannel> channel = factory.createChannel(CHANNEL_PATH1);
+  channel->listen(bind(&SimpleEndToEndFixture::onFaceCreated,   this, _1),
+                  bind(&SimpleEndToEndFixture::onConnectFailed, this, _1));
+
+  UnixStreamFace::protocol::socket client(g_io);
+  client.connect(UnixStreamFace::protocol::endpoint(CHANNEL_PATH1));
+  BOOST_CHECK_MESSAGE(limitedIo.run(1, time::seconds(1)) == LimitedIo::EXCEED_OPS, "Connect");
+
+  // enough packets to fill several receive buffers, with elements straddling the boundaries
+  std::vector<uint8_t> stream;
+  std::vector<Name> names;
+  const std::string content(1000, 'c');
+  for (int i = 0; i < 30; ++i) {
+    Name name("ndn:/ReceiveAcrossBuffers");
+    name.appendNumber(i);
+    names.push_back(name);
+
+    shared_ptr<Data> data = makeData(name);
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    signData(data);
+    stream.insert(stream.end(), data->wireEncode().begin(), data->wireEncode().end());
+  }
+  boost::asio::write(client, boost::asio::buffer(stream));
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(30, time::seconds(1)) == LimitedIo::EXCEED_OPS, "Receive");
+
+  // received packets keep referencing the buffers they were parsed from
+  BOOST_REQUIRE_EQUAL(receivedDatas.size(), 30);
+  for (size_t i = 0; i < receivedDatas.size(); ++i) {
+    BOOST_CHECK_EQUAL(receivedDatas[i].getName(), names[i]);
+    BOOST_CHECK_EQUAL(receivedDatas[i].getContent().value_size(), content.size());
+  }
+}
+
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(CorruptedInput, Dataset,
                                  CorruptedPackets, SimpleEndToEndFixture)
 {
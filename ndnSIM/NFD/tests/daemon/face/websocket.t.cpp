@@ -170,13 +170,19 @@ public:
   client1_onMessage(websocketpp::connection_hdl hdl,
                     websocketpp::config::asio_client::message_type::ptr msg)
   {
-    bool isOk = false;
-    Block element;
     const std::string& payload = msg->get_payload();
-    std::tie(isOk, element) = Block::fromBuffer(reinterpret_cast<const uint8_t*>(payload.c_str()),
-                                                payload.size());
-    if (isOk)
+    const uint8_t* buffer = reinterpret_cast<const uint8_t*>(payload.c_str());
+    size_t offset = 0;
+    // the face may coalesce several packets into one message
+    while (offset < payload.size())
       {
+        bool isOk = false;
+        Block element;
+        std::tie(isOk, element) = Block::fromBuffer(buffer + offset, payload.size() - offset);
+        if (!isOk)
+          break;
+        offset += element.size();
+
         try {
           if (element.type() == tlv::Interest)
             {
@@ -309,6 +315,42 @@ BOOST_FIXTURE_TEST_CASE(EndToEnd4, EndToEndFixture)
   BOOST_CHECK_EQUAL(channel1->size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(EndToEndCoalesced, EndToEndFixture)
+{
+  WebSocketFactory factory1("9696");
+
+  shared_ptr<WebSocketChannel> channel1 = factory1.createChannel("127.0.0.1", "20071");
+  channel1->setCoalescingDelay(time::milliseconds(10));
+  channel1->listen(bind(&EndToEndFixture::channel1_onFaceCreated, this, _1));
+
+  client1.clear_access_channels(websocketpp::log::alevel::all);
+  client1.init_asio(&getGlobalIoService());
+  client1.set_open_handler(bind(&EndToEndFixture::client1_onOpen, this, _1));
+  client1.set_message_handler(bind(&EndToEndFixture::client1_onMessage, this, _1, _2));
+
+  websocketpp::lib::error_code ec;
+  Client::connection_ptr con = client1.get_connection("ws://127.0.0.1:20071", ec);
+  client1.connect(con);
+
+  BOOST_CHECK_MESSAGE(limitedIo.run(2, time::seconds(10)) == LimitedIo::EXCEED_OPS,
+                      "WebSocketChannel error: cannot connect or cannot accept connection");
+  BOOST_REQUIRE(static_cast<bool>(face1));
+
+  shared_ptr<Interest> interest1 = makeInterest("ndn:/x7UEh8rvZd");
+  shared_ptr<Data>     data1     = makeData("ndn:/yF4BT9dCzJ");
+  face1->sendInterest(*interest1);
+  face1->sendData    (*data1);
+  face1->sendData    (*data1);
+  BOOST_CHECK_EQUAL(face1->getCounters().getNOutBytes(),
+                    interest1->wireEncode().size() + data1->wireEncode().size() * 2);
+
+  // one message carrying three packets: one operation per packet and one for the message
+  BOOST_CHECK_MESSAGE(limitedIo.run(4, time::seconds(10)) == LimitedIo::EXCEED_OPS,
+                      "WebSocketChannel error: cannot send coalesced packets");
+  BOOST_CHECK_EQUAL(client1_receivedInterests.size(), 1);
+  BOOST_CHECK_EQUAL(client1_receivedDatas    .size(), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/delegation-cache.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class DelegationCacheFixture : public UnitTestTimeFixture
+{
+public:
+  DelegationCacheFixture()
+    : fib(nameTree)
+    , cache(fib, time::seconds(1))
+    , face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+  {
+  }
+
+  shared_ptr<Interest>
+  makeInterestWithLink(const Name& name)
+  {
+    shared_ptr<ndn::Link> link = make_shared<ndn::Link>("/producer/link",
+      std::initializer_list<std::pair<uint32_t, Name>>{{10, "/net/ucla"}, {20, "/net/arizona"}});
+    signData(link);
+
+    shared_ptr<Interest> interest = makeInterest(name);
+    interest->setLink(link->wireEncode());
+    return interest;
+  }
+
+public:
+  NameTree nameTree;
+  Fib fib;
+  DelegationCache cache;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwDelegationCache, DelegationCacheFixture)
+
+BOOST_AUTO_TEST_CASE(Select)
+{
+  fib.insert("/net/arizona").first->addNextHop(face2, 0);
+  shared_ptr<Interest> interest = makeInterestWithLink("/producer/video/1");
+
+  // the preferred delegation has no route
+  shared_ptr<fib::Entry> entry = cache.findLongestPrefixMatch(*interest);
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/net/arizona"));
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 1);
+
+  // another Interest with the same Link
+  entry = cache.findLongestPrefixMatch(*makeInterestWithLink("/producer/video/2"));
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/net/arizona"));
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  // a route to the preferred delegation changes the FIB version
+  fib.insert("/net/ucla").first->addNextHop(face1, 0);
+  entry = cache.findLongestPrefixMatch(*interest);
+  BOOST_CHECK_EQUAL(entry->getPrefix(), Name("/net/ucla"));
+  BOOST_CHECK_EQUAL(cache.getNHits(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(NoRoute)
+{
+  shared_ptr<fib::Entry> entry = cache.findLongestPrefixMatch(*makeInterestWithLink("/producer"));
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_CHECK_EQUAL(entry->hasNextHops(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Lifetime)
+{
+  shared_ptr<Interest> interest = makeInterestWithLink("/producer/video/1");
+  cache.findLongestPrefixMatch(*interest);
+  this->advanceClocks(time::milliseconds(500));
+  cache.findLongestPrefixMatch(*interest);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+
+  this->advanceClocks(time::milliseconds(600));
+  cache.findLongestPrefixMatch(*interest);
+  BOOST_CHECK_EQUAL(cache.getNHits(), 1);
+  BOOST_CHECK_EQUAL(cache.getNMisses(), 2);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
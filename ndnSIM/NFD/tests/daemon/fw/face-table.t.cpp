@@ -80,6 +80,30 @@ BOOST_AUTO_TEST_CASE(AddRemove)
   BOOST_CHECK_EQUAL(onRemoveHistory[0], onAddHistory[0]);
 }
 
+BOOST_AUTO_TEST_CASE(GetStaleId)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  FaceId id1 = face1->getId();
+  BOOST_CHECK_EQUAL(faceTable.get(id1), face1);
+
+  face1->close();
+  BOOST_CHECK(faceTable.get(id1) == nullptr);
+
+  // FaceIds are not reused
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  faceTable.add(face2);
+  BOOST_CHECK_NE(face2->getId(), id1);
+  BOOST_CHECK(faceTable.get(id1) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.get(face2->getId()), face2);
+
+  BOOST_CHECK(faceTable.get(INVALID_FACEID) == nullptr);
+  BOOST_CHECK(faceTable.get(face2->getId() + 1000) == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(AddReserved)
 {
   Forwarder forwarder;
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fw/forwarder-stage-times.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <boost/test/output_test_stream.hpp>
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(FwForwarderStageTimes, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(MergeAndPrint)
+{
+  ForwarderStageTimes times;
+  times.record(ForwarderStageTimes::STAGE_CS_LOOKUP, 100);
+  times.record(ForwarderStageTimes::STAGE_CS_LOOKUP, 300);
+
+  ForwarderStageTimes other;
+  other.record(ForwarderStageTimes::STAGE_CS_LOOKUP, 200);
+  other.record(ForwarderStageTimes::STAGE_PIT_MATCH, 50);
+  times.merge(other);
+
+  BOOST_CHECK_EQUAL(times.get(ForwarderStageTimes::STAGE_CS_LOOKUP).GetCount(), 3);
+  BOOST_CHECK_EQUAL(times.get(ForwarderStageTimes::STAGE_CS_LOOKUP).GetMax(), 300);
+  BOOST_CHECK_EQUAL(times.get(ForwarderStageTimes::STAGE_PIT_MATCH).GetCount(), 1);
+  BOOST_CHECK_EQUAL(times.get(ForwarderStageTimes::STAGE_INCOMING_DATA).GetCount(), 0);
+
+  // stages without samples are not printed
+  boost::test_tools::output_test_stream os;
+  times.print(os);
+  std::string output = os.str();
+  BOOST_CHECK(output.find("ContentStoreLookup\t3\t") != std::string::npos);
+  BOOST_CHECK(output.find("PitMatch\t1\t") != std::string::npos);
+  BOOST_CHECK(output.find("IncomingData") == std::string::npos);
+
+  times.reset();
+  BOOST_CHECK_EQUAL(times.get(ForwarderStageTimes::STAGE_CS_LOOKUP).GetCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NestedSelfTime)
+{
+  ForwarderStageTimes times;
+  uint64_t begin = ForwarderStageTimes::readTicks();
+  {
+    ScopedStageTimer outer(times, ForwarderStageTimes::STAGE_INCOMING_INTEREST);
+    {
+      ScopedStageTimer inner(times, ForwarderStageTimes::STAGE_CS_MISS);
+      volatile uint64_t sum = 0;
+      for (int i = 0; i < 100000; ++i) {
+        sum += i;
+      }
+    }
+  }
+  uint64_t elapsed = ForwarderStageTimes::readTicks() - begin;
+
+  const ns3::ndn::HdrHistogram& outer = times.get(ForwarderStageTimes::STAGE_INCOMING_INTEREST);
+  const ns3::ndn::HdrHistogram& inner = times.get(ForwarderStageTimes::STAGE_CS_MISS);
+  BOOST_REQUIRE_EQUAL(outer.GetCount(), 1);
+  BOOST_REQUIRE_EQUAL(inner.GetCount(), 1);
+
+  // the loop is counted in the nested stage only
+  BOOST_CHECK_GT(inner.GetMax(), outer.GetMax());
+  BOOST_CHECK_LE(outer.GetMax() + inner.GetMax(), elapsed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
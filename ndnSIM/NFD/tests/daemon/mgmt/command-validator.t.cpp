@@ -650,6 +650,81 @@ BOOST_FIXTURE_TEST_CASE(Wildcard, TwoValidatorFixture)
   m_tester1.resetValidation();
 }
 
+BOOST_AUTO_TEST_CASE(HmacKey)
+{
+  const std::string HMAC_KEY_CONFIG =
+    "authorizations\n"
+    "{\n"
+    "  authorize\n"
+    "  {\n"
+    "    hmac-key-name /localhost/controller/KEY/hmac\n"
+    "    hmac-key 00112233445566778899aabbccddeeff\n"
+    "    privileges\n"
+    "    {\n"
+    "      fib\n"
+    "    }\n"
+    "  }\n"
+    "}\n";
+
+  ConfigFile config;
+  CommandValidator validator;
+  validator.addSupportedPrivilege("faces");
+  validator.addSupportedPrivilege("fib");
+  validator.setConfigFile(config);
+  config.parse(HMAC_KEY_CONFIG, false, CONFIG_PATH.native());
+
+  const Name keyName("/localhost/controller/KEY/hmac");
+  const uint8_t KEY[] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                         0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+  ndn::Buffer key(KEY, sizeof(KEY));
+  ndn::Buffer wrongKey(KEY, sizeof(KEY) - 1);
+
+  ndn::CommandInterestGenerator generator;
+  auto isValid = [&] (const Name& commandName, const ndn::Buffer& signingKey) {
+    shared_ptr<Interest> command = make_shared<Interest>(commandName);
+    generator.generateWithHmac(*command, keyName, signingKey);
+
+    int result = 0;
+    validator.validate(*command,
+                       [&] (const shared_ptr<const Interest>&) { result = 1; },
+                       [&] (const shared_ptr<const Interest>&, const std::string&) { result = -1; });
+    BOOST_REQUIRE_NE(result, 0);
+    return result > 0;
+  };
+
+  // the signer rules of the key are looked up once, the later commands use them
+  for (int i = 0; i < 3; ++i) {
+    BOOST_CHECK(isValid("/localhost/nfd/fib/add-nexthop", key));
+  }
+
+  BOOST_CHECK(!isValid("/localhost/nfd/faces/create", key));
+  BOOST_CHECK(!isValid("/localhost/nfd/fib/add-nexthop", wrongKey));
+}
+
+BOOST_AUTO_TEST_CASE(MalformedHmacKey)
+{
+  const std::string MALFORMED_HMAC_KEY_CONFIG =
+    "authorizations\n"
+    "{\n"
+    "  authorize\n"
+    "  {\n"
+    "    hmac-key-name /localhost/controller/KEY/hmac\n"
+    "    hmac-key not-hex\n"
+    "    privileges\n"
+    "    {\n"
+    "      fib\n"
+    "    }\n"
+    "  }\n"
+    "}\n";
+
+  ConfigFile config;
+  CommandValidator validator;
+  validator.addSupportedPrivilege("fib");
+  validator.setConfigFile(config);
+  BOOST_CHECK_THROW(config.parse(MALFORMED_HMAC_KEY_CONFIG, false, CONFIG_PATH.native()),
+                    ConfigFile::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
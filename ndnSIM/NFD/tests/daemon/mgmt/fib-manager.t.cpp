@@ -877,6 +877,97 @@ BOOST_AUTO_TEST_CASE(RemoveImplicitFaceId)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  addFace(face1);
+  addFace(face2);
+
+  shared_ptr<InternalFace> face = getInternalFace();
+  getFib().insert("/remove").first->addNextHop(face1, 5);
+
+  std::vector<ControlParameters> entries;
+  entries.push_back(ControlParameters().setName("/hello").setFaceId(1).setCost(101));
+  entries.push_back(ControlParameters().setName("/hello").setFaceId(2).setCost(202));
+  entries.push_back(ControlParameters().setName("/self").setCost(7));
+  entries.push_back(ControlParameters().setName("/remove").setFaceId(1));
+  entries.push_back(ControlParameters().setName("/missing").setFaceId(1000));
+
+  ndn::nfd::FibBatchCommand batchCommand;
+  shared_ptr<Interest> command(make_shared<Interest>(
+    batchCommand.getRequestName("/localhost/nfd", entries)));
+  command->setIncomingFaceId(2);
+  generateCommand(*command);
+
+  face->onReceiveData.connect([this, command] (const Data& response) {
+    this->validateControlResponse(response, command->getName(),
+                                  200, "Success", ControlParameters().wireEncode());
+  });
+
+  getFibManager().onFibRequest(*command);
+
+  BOOST_REQUIRE(didCallbackFire());
+
+  shared_ptr<fib::Entry> hello = getFib().findExactMatch("/hello");
+  BOOST_REQUIRE(static_cast<bool>(hello));
+  BOOST_CHECK_EQUAL(hello->getNextHops().size(), 2);
+
+  shared_ptr<fib::Entry> self = getFib().findExactMatch("/self");
+  BOOST_REQUIRE(static_cast<bool>(self));
+  BOOST_REQUIRE_EQUAL(self->getNextHops().size(), 1);
+  BOOST_CHECK(self->getNextHops().front().getFace() == face2);
+  BOOST_CHECK_EQUAL(self->getNextHops().front().getCost(), 7);
+
+  BOOST_CHECK(!static_cast<bool>(getFib().findExactMatch("/remove")));
+}
+
+BOOST_AUTO_TEST_CASE(BatchUnknownFaceId)
+{
+  addFace(make_shared<DummyFace>());
+
+  shared_ptr<InternalFace> face = getInternalFace();
+
+  std::vector<ControlParameters> entries;
+  entries.push_back(ControlParameters().setName("/hello").setFaceId(1).setCost(101));
+  entries.push_back(ControlParameters().setName("/world").setFaceId(1000).setCost(101));
+
+  ndn::nfd::FibBatchCommand batchCommand;
+  shared_ptr<Interest> command(make_shared<Interest>(
+    batchCommand.getRequestName("/localhost/nfd", entries)));
+  generateCommand(*command);
+
+  face->onReceiveData.connect([this, command] (const Data& response) {
+    this->validateControlResponse(response, command->getName(), 410, "Face not found");
+  });
+
+  getFibManager().onFibRequest(*command);
+
+  BOOST_REQUIRE(didCallbackFire());
+  // no entry of a rejected batch is applied
+  BOOST_CHECK_EQUAL(getFib().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BatchMalformed)
+{
+  shared_ptr<InternalFace> face = getInternalFace();
+
+  Name commandName("/localhost/nfd/fib");
+  commandName.append("batch");
+  commandName.append(ControlParameters().setFaceId(1).wireEncode());
+
+  shared_ptr<Interest> command(make_shared<Interest>(commandName));
+  generateCommand(*command);
+
+  face->onReceiveData.connect([this, command] (const Data& response) {
+    this->validateControlResponse(response, command->getName(), 400, "Malformed command");
+  });
+
+  getFibManager().onFibRequest(*command);
+
+  BOOST_REQUIRE(didCallbackFire());
+}
+
 BOOST_FIXTURE_TEST_CASE(TestFibEnumerationRequest, FibManagerFixture)
 {
   for (int i = 0; i < 87; i++)
@@ -178,6 +178,84 @@ BOOST_AUTO_TEST_CASE(InvalidValueCsMaxPackets)
                              this, _1, expectedMsg));
 }
 
+BOOST_AUTO_TEST_CASE(ValidCsMaxBytes)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_max_bytes 4096\n"
+    "}\n";
+
+  BOOST_REQUIRE_NE(m_cs.getLimitBytes(), 4096);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_NE(m_cs.getLimitBytes(), 4096);
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getLimitBytes(), 4096);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsMaxBytes)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_max_bytes 0\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_max_bytes\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
+BOOST_AUTO_TEST_CASE(ValidCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy 2q\n"
+    "}\n";
+
+  BOOST_REQUIRE_NE(m_cs.getPolicy()->getName(), "2q");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, true));
+  BOOST_CHECK_NE(m_cs.getPolicy()->getName(), "2q");
+
+  BOOST_REQUIRE_NO_THROW(runConfig(CONFIG, false));
+  BOOST_CHECK_EQUAL(m_cs.getPolicy()->getName(), "2q");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidValueCsPolicy)
+{
+  const std::string CONFIG =
+    "tables\n"
+    "{\n"
+    "  cs_policy invalid\n"
+    "}\n";
+
+  const std::string expectedMsg =
+    "Invalid value for option \"cs_policy\" in \"tables\" section";
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, true),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+
+  BOOST_CHECK_EXCEPTION(runConfig(CONFIG, false),
+                        ConfigFile::Error,
+                        bind(&TablesConfigSectionFixture::validateException,
+                             this, _1, expectedMsg));
+}
+
 BOOST_AUTO_TEST_CASE(ConfigStrategy)
 {
   const std::string CONFIG =
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/cs.hpp"
+#include "table/cs-policy-correlativity.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_AUTO_TEST_SUITE(CsCorrelativity)
+
+BOOST_FIXTURE_TEST_CASE(EvictFarFirst, UnitTestTimeFixture)
+{
+  Cs cs(3);
+  CorrelativityPolicy* policy = new CorrelativityPolicy();
+  cs.setPolicy(unique_ptr<Policy>(policy));
+  policy->setLocation("ndn:/S/r1/c1/A");
+
+  cs.insert(*makeData("ndn:/S/r1/c1/A/x"));
+  cs.insert(*makeData("ndn:/S/r2/c9/A/y"));
+  cs.insert(*makeData("ndn:/S/r1/c2/A/z"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // evict y, which is farthest from the location
+  cs.insert(*makeData("ndn:/S/r1/c1/A/w"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  cs.find(Interest("ndn:/S/r2/c9/A/y"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  // after moving, z is rescored and evicted, then x, the oldest of the remaining far entries
+  policy->setLocation("ndn:/S/r2/c9/A");
+  cs.insert(*makeData("ndn:/S/r2/c9/A/v"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  cs.find(Interest("ndn:/S/r1/c2/A/z"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  cs.insert(*makeData("ndn:/S/r2/c9/A/u"));
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  cs.find(Interest("ndn:/S/r1/c1/A/x"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/S/r1/c1/A/w"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_FIXTURE_TEST_CASE(RejectFarUnsolicited, UnitTestTimeFixture)
+{
+  Cs cs(2);
+  cs.setPolicy(unique_ptr<Policy>(new CorrelativityPolicy()));
+
+  // the reference follows solicited Data
+  cs.insert(*makeData("ndn:/S/r1/c1/A/x"));
+  cs.insert(*makeData("ndn:/S/r1/c2/A/z"));
+
+  // unsolicited y does not move the reference and is less correlated than stored entries
+  cs.insert(*makeData("ndn:/S/r2/c9/A/y"), true);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  cs.find(Interest("ndn:/S/r2/c9/A/y"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+  cs.find(Interest("ndn:/S/r1/c1/A/x"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
@@ -85,6 +85,42 @@ BOOST_FIXTURE_TEST_CASE(EvictOneLRU, UnitTestTimeFixture)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_FIXTURE_TEST_CASE(EvictLRUBytes, UnitTestTimeFixture)
+{
+  Cs cs(100);
+  cs.setPolicy(unique_ptr<Policy>(new LruPolicy()));
+
+  auto insert = [&cs] (const Name& name, size_t contentSize) {
+    shared_ptr<Data> data = makeData(name);
+    std::vector<uint8_t> content(contentSize);
+    data->setContent(content.data(), content.size());
+    cs.insert(*data);
+    return data->wireEncode().size();
+  };
+
+  size_t sizeA = insert("ndn:/A", 100);
+  size_t sizeB = insert("ndn:/B", 100);
+  size_t sizeC = insert("ndn:/C", 100);
+  cs.setLimitBytes(sizeA + sizeB + sizeC + 10);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+
+  // use A
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+
+  // evict B and C to make room for D
+  size_t sizeD = insert("ndn:/D", 200);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), sizeA + sizeD);
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+  cs.find(Interest("ndn:/C"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -120,6 +120,26 @@ BOOST_AUTO_TEST_CASE(FullName)
   CHECK_CS_FIND(2);
 }
 
+BOOST_AUTO_TEST_CASE(ExactNameIndex)
+{
+  m_cs.setLimit(2);
+  Name n1 = insert(1, "ndn:/A");
+  Name n2 = insert(2, "ndn:/A");
+
+  uint32_t leftmost = n1 < n2 ? 1 : 2;
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(leftmost);
+
+  // evicting an entry indexes the other entry with the same Name
+  insert(3, "ndn:/B");
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(2);
+
+  insert(4, "ndn:/C");
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(0);
+}
+
 BOOST_AUTO_TEST_CASE(Leftmost)
 {
   insert(1, "ndn:/A");
@@ -316,6 +336,56 @@ BOOST_AUTO_TEST_CASE(DigestExclude)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_CASE(MatcherSameAsCanSatisfy, UnitTestTimeFixture)
+{
+  std::vector<shared_ptr<Data>> stored;
+  for (const char* uri : {"/A", "/A/B", "/A/C", "/A/B/C", "/A/D/E/F"}) {
+    stored.push_back(makeData(uri));
+  }
+  shared_ptr<Data> keyData = make_shared<Data>("/A/K");
+  ndn::SignatureSha256WithRsa signature(ndn::KeyLocator("/key"));
+  signature.setValue(ndn::dataBlock(tlv::SignatureValue, static_cast<const uint8_t*>(nullptr), 0));
+  keyData->setSignature(signature);
+  keyData->wireEncode();
+  stored.push_back(keyData);
+  shared_ptr<Data> staleData = makeData("/A/S");
+  staleData->setFreshnessPeriod(time::milliseconds(0));
+  stored.push_back(staleData);
+
+  Exclude excludeB;
+  excludeB.excludeOne(name::Component("B"));
+  Exclude excludeAfterB;
+  excludeAfterB.excludeAfter(name::Component("B"));
+  Exclude excludeRange;
+  excludeRange.excludeBefore(name::Component("B")).excludeAfter(name::Component("D"));
+
+  std::vector<Interest> interests;
+  interests.push_back(Interest("/A"));
+  interests.push_back(Interest("/A").setMinSuffixComponents(3));
+  interests.push_back(Interest("/A").setMaxSuffixComponents(2));
+  interests.push_back(Interest("/A").setMinSuffixComponents(2).setMaxSuffixComponents(3));
+  interests.push_back(Interest("/A").setExclude(excludeB));
+  interests.push_back(Interest("/A").setExclude(excludeAfterB));
+  interests.push_back(Interest("/A").setExclude(excludeRange));
+  interests.push_back(Interest("/A/B").setExclude(excludeAfterB));
+  interests.push_back(Interest("/A").setPublisherPublicKeyLocator(ndn::KeyLocator("/key")));
+  interests.push_back(Interest("/A").setPublisherPublicKeyLocator(ndn::KeyLocator("/other")));
+  interests.push_back(Interest("/A").setMustBeFresh(true));
+  interests.push_back(Interest(stored[1]->getFullName()));
+
+  this->advanceClocks(time::milliseconds(1));
+  for (const Interest& interest : interests) {
+    Matcher matcher(interest);
+    for (const shared_ptr<Data>& data : stored) {
+      EntryImpl entry(data, false);
+      entry.updateStaleTime();
+      if (interest.getName().isPrefixOf(data->getFullName())) {
+        BOOST_CHECK_EQUAL(matcher.matches(entry), entry.canSatisfy(interest));
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(CachingPolicyNoCache)
 {
   Cs cs(3);
@@ -330,6 +400,86 @@ BOOST_AUTO_TEST_CASE(CachingPolicyNoCache)
           bind([] { BOOST_CHECK(true); }));
 }
 
+BOOST_AUTO_TEST_CASE(LimitBytes)
+{
+  Cs cs(100);
+  size_t nBytesSignaled = 0;
+  cs.afterNBytesChange.connect([&nBytesSignaled] (size_t nBytes) { nBytesSignaled = nBytes; });
+
+  auto insert = [&cs] (const Name& name, size_t contentSize) {
+    shared_ptr<Data> data = makeData(name);
+    std::vector<uint8_t> content(contentSize);
+    data->setContent(content.data(), content.size());
+    cs.insert(*data);
+    return data->wireEncode().size();
+  };
+
+  size_t sizeA = insert("ndn:/A", 1000);
+  size_t sizeB = insert("ndn:/B", 100);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), sizeA + sizeB);
+  BOOST_CHECK_EQUAL(nBytesSignaled, sizeA + sizeB);
+
+  // evict A
+  cs.setLimitBytes(sizeA + sizeB + 50);
+  size_t sizeC = insert("ndn:/C", 1000);
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), sizeB + sizeC);
+  BOOST_CHECK_EQUAL(nBytesSignaled, sizeB + sizeC);
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  // evict B
+  cs.setLimitBytes(sizeC);
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), sizeC);
+
+  // D does not fit
+  cs.setLimitBytes(sizeC - 1);
+  insert("ndn:/D", 1000);
+  BOOST_CHECK_EQUAL(cs.size(), 0);
+  BOOST_CHECK_EQUAL(cs.getNBytes(), 0);
+  BOOST_CHECK_EQUAL(nBytesSignaled, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(EvictStale, UnitTestTimeFixture)
+{
+  Cs cs(100);
+  cs.setEvictStale(true);
+
+  auto insert = [&cs] (const Name& name, time::milliseconds freshnessPeriod) {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(freshnessPeriod);
+    data->wireEncode();
+    cs.insert(*data);
+  };
+
+  insert("ndn:/A", time::milliseconds(10));
+  insert("ndn:/B", time::milliseconds(30));
+  insert("ndn:/C", time::milliseconds(10));
+  cs.insert(*makeData("ndn:/D")); // without FreshnessPeriod, never stale
+  BOOST_CHECK_EQUAL(cs.size(), 4);
+
+  this->advanceClocks(time::milliseconds(5));
+  insert("ndn:/C", time::milliseconds(10)); // refresh C until 15ms
+
+  this->advanceClocks(time::milliseconds(1), 6);
+  BOOST_CHECK_EQUAL(cs.size(), 3);
+  cs.find(Interest("ndn:/A"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+
+  this->advanceClocks(time::milliseconds(5));
+  BOOST_CHECK_EQUAL(cs.size(), 2);
+
+  this->advanceClocks(time::milliseconds(20));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  cs.find(Interest("ndn:/D"),
+          bind([] { BOOST_CHECK(true); }),
+          bind([] { BOOST_CHECK(false); }));
+  BOOST_CHECK_EQUAL(cs.getNBytes(), cs.begin()->getData().wireEncode().size());
+}
+
 BOOST_AUTO_TEST_CASE(Enumeration)
 {
   Cs cs;
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/dead-nonce-filter.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TableDeadNonceFilter, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(FalsePositiveRate)
+{
+  DeadNonceFilter filter(time::seconds(6), 0.01);
+
+  // grow beyond the initial slice, so that slices opened early are exercised
+  const uint64_t N = 10000;
+  for (uint64_t i = 0; i < N; ++i) {
+    filter.add(i * 0x9E3779B97F4A7C15ULL);
+  }
+  BOOST_CHECK_EQUAL(filter.size(), N);
+  BOOST_CHECK_GT(filter.m_slices.size(), 1);
+
+  for (uint64_t i = 0; i < N; ++i) {
+    BOOST_REQUIRE(filter.has(i * 0x9E3779B97F4A7C15ULL));
+  }
+
+  size_t nFalsePositives = 0;
+  for (uint64_t i = N; i < 11 * N; ++i) {
+    if (filter.has(i * 0x9E3779B97F4A7C15ULL))
+      ++nFalsePositives;
+  }
+  BOOST_CHECK_LT(nFalsePositives, 10 * N * 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(Lifetime)
+{
+  const time::milliseconds LIFETIME(200);
+  DeadNonceFilter filter(LIFETIME, 0.001);
+
+  filter.add(0x25390656);
+  this->advanceClocks(time::milliseconds(10), LIFETIME);
+  BOOST_CHECK_EQUAL(filter.has(0x25390656), true);
+
+  // slices are dropped within one slice interval after lifetime
+  this->advanceClocks(time::milliseconds(10), LIFETIME / DeadNonceFilter::NSLICES * 2);
+  BOOST_CHECK_EQUAL(filter.has(0x25390656), false);
+  BOOST_CHECK_EQUAL(filter.size(), 0);
+  BOOST_CHECK_LE(filter.m_slices.size(), DeadNonceFilter::NSLICES + 1);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidRate)
+{
+  BOOST_CHECK_THROW(DeadNonceFilter(time::seconds(6), 0.0), std::invalid_argument);
+  BOOST_CHECK_THROW(DeadNonceFilter(time::seconds(6), 1.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
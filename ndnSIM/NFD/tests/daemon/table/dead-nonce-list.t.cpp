@@ -50,6 +50,38 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
 }
 
+BOOST_AUTO_TEST_CASE(BasicFilter)
+{
+  Name nameA("ndn:/A");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  DeadNonceList dnl(DeadNonceList::DEFAULT_LIFETIME, 0.001);
+  BOOST_CHECK_EQUAL(dnl.getFalsePositiveRate(), 0.001);
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+
+  BOOST_CHECK_THROW(DeadNonceList(DeadNonceList::DEFAULT_LIFETIME, 1.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  DeadNonceList exact;
+  DeadNonceList filter(DeadNonceList::DEFAULT_LIFETIME, 0.001);
+  BOOST_CHECK_EQUAL(exact.getFalsePositiveRate(), 0.0);
+
+  Name name("ndn:/M");
+  for (uint32_t nonce = 1; nonce <= 100; ++nonce) {
+    exact.add(name, nonce);
+    filter.add(name, nonce);
+  }
+  BOOST_CHECK_GT(exact.getMemoryUsage(), 100 * sizeof(uint64_t));
+  BOOST_CHECK_LT(filter.getMemoryUsage(), exact.getMemoryUsage());
+}
+
 BOOST_AUTO_TEST_CASE(MinLifetime)
 {
   BOOST_CHECK_THROW(DeadNonceList dnl(time::milliseconds::zero()), std::invalid_argument);
@@ -400,6 +400,47 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatchCache)
+{
+  NameTree nameTree;
+  Fib fib(nameTree);
+  shared_ptr<fib::Entry> entryRoot = fib.insert("ndn:/").first;
+
+  // name tree entry of a deep name, as created by PIT
+  Name name("ndn:/S/addr_1/addr_1_2/addr_1_2_3/A/app/1");
+  nameTree.lookup(name);
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name), entryRoot);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheHits(), 0);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheMisses(), 1);
+
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name, name_tree::computeHashSet(name)), entryRoot);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheHits(), 1);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheMisses(), 1);
+
+  // insertion invalidates the cache
+  uint64_t version = fib.getVersion();
+  shared_ptr<fib::Entry> entryS1 = fib.insert("ndn:/S/addr_1").first;
+  BOOST_CHECK_NE(fib.getVersion(), version);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name), entryS1);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheMisses(), 2);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name), entryS1);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheHits(), 2);
+
+  // erasure invalidates the cache, and the erased entry is not kept alive
+  weak_ptr<fib::Entry> weakS1 = entryS1;
+  entryS1.reset();
+  fib.erase("ndn:/S/addr_1");
+  BOOST_CHECK(weakS1.expired());
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch(name), entryRoot);
+  BOOST_CHECK_EQUAL(fib.getNLpmCacheMisses(), 3);
+
+  // inserting an existing prefix does not change anything
+  version = fib.getVersion();
+  fib.insert("ndn:/");
+  BOOST_CHECK_EQUAL(fib.getVersion(), version);
+}
+
 BOOST_AUTO_TEST_CASE(Iterator)
 {
   NameTree nameTree;
@@ -182,6 +182,30 @@ BOOST_FIXTURE_TEST_CASE(Lifetime, UnitTestTimeFixture)
   BOOST_CHECK_EQUAL(measurements.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(RepeatedExtendLifetime, UnitTestTimeFixture)
+{
+  NameTree nameTree;
+  Measurements measurements(nameTree);
+  Name nameA("ndn:/A");
+
+  shared_ptr<measurements::Entry> entryA = measurements.get(nameA);
+  for (int i = 0; i < 100; ++i) {
+    measurements.extendLifetime(*entryA, Measurements::getInitialLifetime());
+    this->advanceClocks(time::milliseconds(100));
+  }
+  entryA.reset();
+  BOOST_CHECK(measurements.findExactMatch(nameA) != nullptr);
+
+  this->advanceClocks(time::milliseconds(100), Measurements::getInitialLifetime() -
+                                               time::milliseconds(200));
+  BOOST_CHECK(measurements.findExactMatch(nameA) != nullptr);
+
+  this->advanceClocks(time::milliseconds(100), Measurements::getSweepInterval() +
+                                               time::milliseconds(200));
+  BOOST_CHECK(measurements.findExactMatch(nameA) == nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+}
+
 BOOST_FIXTURE_TEST_CASE(EraseNameTreeEntry, UnitTestTimeFixture)
 {
   NameTree nameTree;
@@ -48,6 +48,34 @@ BOOST_AUTO_TEST_CASE(Hash)
   BOOST_CHECK_EQUAL(hashSet.size(), prefix.size() + 1);
 }
 
+BOOST_AUTO_TEST_CASE(HashSetTag)
+{
+  shared_ptr<Interest> interest = makeInterest("/A/B/C");
+  BOOST_CHECK(interest->getTag<name_tree::HashSetTag>() == nullptr);
+
+  const std::vector<size_t>& hashSet = name_tree::getHashSet(*interest);
+  BOOST_CHECK(hashSet == name_tree::computeHashSet("/A/B/C"));
+  shared_ptr<name_tree::HashSetTag> tag = interest->getTag<name_tree::HashSetTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK(tag->isFor("/A/B/C"));
+  BOOST_CHECK(!tag->isFor("/A/B/D"));
+
+  // cached hash set is reused
+  name_tree::getHashSet(*interest);
+  BOOST_CHECK_EQUAL(interest->getTag<name_tree::HashSetTag>(), tag);
+
+  // outdated hash set is replaced
+  interest->setName("/A/B/D");
+  BOOST_CHECK(name_tree::getHashSet(*interest) == name_tree::computeHashSet("/A/B/D"));
+
+  NameTree nt(16);
+  shared_ptr<name_tree::Entry> entry = nt.lookup("/A/B", name_tree::computeHashSet("/A/B/C"));
+  BOOST_CHECK_EQUAL(entry->getPrefix(), "/A/B");
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/A/B"), entry);
+  shared_ptr<Interest> interestAbc = makeInterest("/A/B/C");
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/A/B/C", name_tree::getHashSet(*interestAbc)), entry);
+}
+
 BOOST_AUTO_TEST_CASE(Entry)
 {
   Name prefix("ndn:/named-data/research/abc/def/ghi");
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pit-timer-wheel.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace pit {
+namespace tests {
+
+using namespace nfd::tests;
+
+class TimerWheelFixture : public UnitTestTimeFixture
+{
+protected:
+  TimerWheelFixture()
+    : wheel(bind(&TimerWheelFixture::onUnsatisfy, this, _1),
+            bind(&TimerWheelFixture::onStraggler, this, _1, _2, _3))
+    , lastIsSatisfied(false)
+  {
+  }
+
+  void
+  onUnsatisfy(shared_ptr<Entry> pitEntry)
+  {
+    unsatisfied.push_back(pitEntry->getName());
+  }
+
+  void
+  onStraggler(shared_ptr<Entry> pitEntry, bool isSatisfied,
+              const time::milliseconds& dataFreshnessPeriod)
+  {
+    stragglers.push_back(pitEntry->getName());
+    lastIsSatisfied = isSatisfied;
+    lastFreshnessPeriod = dataFreshnessPeriod;
+  }
+
+  shared_ptr<Entry>
+  makeEntry(const Name& name)
+  {
+    return make_shared<Entry>(*makeInterest(name));
+  }
+
+protected:
+  TimerWheel wheel;
+  std::vector<Name> unsatisfied;
+  std::vector<Name> stragglers;
+  bool lastIsSatisfied;
+  time::milliseconds lastFreshnessPeriod;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TablePitTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  shared_ptr<Entry> entryA = makeEntry("ndn:/A");
+  shared_ptr<Entry> entryB = makeEntry("ndn:/B");
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  wheel.setUnsatisfyTimer(entryB, now + time::milliseconds(200));
+  wheel.setUnsatisfyTimer(entryA, now + time::milliseconds(100));
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  this->advanceClocks(time::milliseconds(1), 99);
+  BOOST_CHECK_EQUAL(unsatisfied.size(), 0);
+
+  this->advanceClocks(time::milliseconds(1), 2);
+  BOOST_REQUIRE_EQUAL(unsatisfied.size(), 1);
+  BOOST_CHECK_EQUAL(unsatisfied[0], "ndn:/A");
+  BOOST_CHECK_EQUAL(entryA->m_unsatisfyTimer, 0);
+
+  this->advanceClocks(time::milliseconds(1), 100);
+  BOOST_REQUIRE_EQUAL(unsatisfied.size(), 2);
+  BOOST_CHECK_EQUAL(unsatisfied[1], "ndn:/B");
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ResetAndCancel)
+{
+  shared_ptr<Entry> entryA = makeEntry("ndn:/A");
+  shared_ptr<Entry> entryB = makeEntry("ndn:/B");
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  wheel.setUnsatisfyTimer(entryA, now + time::milliseconds(50));
+  wheel.setUnsatisfyTimer(entryB, now + time::milliseconds(50));
+
+  // moving a timer replaces the previous one
+  wheel.setUnsatisfyTimer(entryA, now + time::milliseconds(150));
+  wheel.cancel(*entryB);
+  wheel.setStragglerTimer(entryB, time::milliseconds(100), true, time::milliseconds(10));
+
+  this->advanceClocks(time::milliseconds(10), 12);
+  BOOST_CHECK_EQUAL(unsatisfied.size(), 0);
+  BOOST_REQUIRE_EQUAL(stragglers.size(), 1);
+  BOOST_CHECK_EQUAL(stragglers[0], "ndn:/B");
+  BOOST_CHECK_EQUAL(lastIsSatisfied, true);
+  BOOST_CHECK_EQUAL(lastFreshnessPeriod, time::milliseconds(10));
+
+  this->advanceClocks(time::milliseconds(10), 4);
+  BOOST_REQUIRE_EQUAL(unsatisfied.size(), 1);
+  BOOST_CHECK_EQUAL(unsatisfied[0], "ndn:/A");
+
+  // cancelled and replaced timers are dropped when their slots are pumped
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LongDeadline)
+{
+  shared_ptr<Entry> entryA = makeEntry("ndn:/A");
+  shared_ptr<Entry> entryB = makeEntry("ndn:/B");
+  time::nanoseconds rotation = TimerWheel::TICK * TimerWheel::NSLOTS;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  wheel.setUnsatisfyTimer(entryA, now + rotation * 3 + time::milliseconds(5));
+  wheel.setUnsatisfyTimer(entryB, now + time::milliseconds(5));
+
+  // entryB shares the slot of entryA, but entryA is due three rotations later
+  this->advanceClocks(time::milliseconds(10), rotation);
+  BOOST_CHECK_EQUAL(unsatisfied.size(), 1);
+
+  this->advanceClocks(time::milliseconds(10), rotation * 2 + time::milliseconds(10));
+  BOOST_CHECK_EQUAL(unsatisfied.size(), 2);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(EntryGone)
+{
+  shared_ptr<Entry> entryA = makeEntry("ndn:/A");
+  wheel.setUnsatisfyTimer(entryA, time::steady_clock::now() + time::milliseconds(10));
+  entryA.reset();
+
+  this->advanceClocks(time::milliseconds(1), 20);
+  BOOST_CHECK_EQUAL(unsatisfied.size(), 0);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace pit
+} // namespace nfd
@@ -151,6 +151,41 @@ BOOST_AUTO_TEST_CASE(EntryInOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.getOutRecords().end());
 }
 
+BOOST_AUTO_TEST_CASE(EntryManyRecords)
+{
+  // more records than are stored inline
+  const size_t N_FACES = NFD_PIT_RECORDS_INLINE_CAPACITY + 3;
+  std::vector<shared_ptr<Face>> faces;
+  for (size_t i = 0; i < N_FACES; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+  shared_ptr<Interest> interest = makeInterest("ndn:/7vMWgAOy");
+  pit::Entry entry(*interest);
+
+  for (const shared_ptr<Face>& face : faces) {
+    entry.insertOrUpdateInRecord(face, *interest);
+    entry.insertOrUpdateOutRecord(face, *interest);
+    BOOST_CHECK(entry.getInRecords().begin()->getFace() == face);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), N_FACES);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), N_FACES);
+
+  entry.deleteOutRecord(*faces[1]);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), N_FACES - 1);
+  BOOST_CHECK(entry.getOutRecord(*faces[1]) == entry.getOutRecords().end());
+  for (size_t i = 0; i < N_FACES; ++i) {
+    BOOST_REQUIRE(entry.getInRecord(*faces[i]) != entry.getInRecords().end());
+    BOOST_CHECK_EQUAL(entry.getInRecord(*faces[i])->getFace(), faces[i]);
+    if (i != 1) {
+      BOOST_REQUIRE(entry.getOutRecord(*faces[i]) != entry.getOutRecords().end());
+      BOOST_CHECK_EQUAL(entry.getOutRecord(*faces[i])->getFace(), faces[i]);
+    }
+  }
+
+  entry.deleteInRecords();
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(EntryNonce)
 {
   shared_ptr<Face> face1 = make_shared<DummyFace>();
@@ -394,6 +429,29 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  NameTree nameTree;
+  Pit pit(nameTree);
+  size_t nPitBytesBefore = pit.getMemoryUsage();
+  size_t nNameTreeBytesBefore = nameTree.getMemoryUsage();
+
+  shared_ptr<Interest> interest = makeInterest("/MemoryUsage/A/B");
+  shared_ptr<pit::Entry> entry = pit.insert(*interest).first;
+  size_t nPitBytes = pit.getMemoryUsage();
+  BOOST_CHECK_GT(nPitBytes, nPitBytesBefore + interest->wireEncode().size());
+  BOOST_CHECK_GT(nameTree.getMemoryUsage(), nNameTreeBytesBefore);
+
+  // an in-record sharing the Interest of the entry adds no Interest
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  entry->insertOrUpdateInRecord(face1, *interest);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), nPitBytes);
+
+  pit.erase(entry);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage(), nPitBytesBefore);
+  BOOST_CHECK_EQUAL(nameTree.getMemoryUsage(), nNameTreeBytesBefore);
+}
+
 BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 {
   Name nameA   ("ndn:/A");
@@ -453,6 +511,33 @@ BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 
 }
 
+BOOST_AUTO_TEST_CASE(FindAllDataMatchesExactEntries)
+{
+  shared_ptr<Interest> interestA = makeInterest("/A");
+  shared_ptr<Interest> interestAB = makeInterest("/A/B");
+  interestAB->setMaxSuffixComponents(1);
+
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  shared_ptr<pit::Entry> entryA = pit.insert(*interestA).first;
+  shared_ptr<pit::Entry> entryAB = pit.insert(*interestAB).first;
+  BOOST_CHECK_EQUAL(entryA->needsPrefixMatch(), true);
+  BOOST_CHECK_EQUAL(entryAB->needsPrefixMatch(), false);
+
+  pit::DataMatchResult matches = pit.findAllDataMatches(*makeData("/A/B"));
+  BOOST_REQUIRE_EQUAL(matches.size(), 2);
+  BOOST_CHECK_EQUAL(matches[0], entryAB);
+  BOOST_CHECK_EQUAL(matches[1], entryA);
+
+  matches = pit.findAllDataMatches(*makeData("/A/B/C"));
+  BOOST_REQUIRE_EQUAL(matches.size(), 1);
+  BOOST_CHECK_EQUAL(matches[0], entryA);
+
+  pit.erase(entryA);
+  BOOST_CHECK_EQUAL(pit.findAllDataMatches(*makeData("/A/B/C")).size(), 0);
+  BOOST_CHECK_EQUAL(pit.findAllDataMatches(*makeData("/A/B")).size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(Iterator)
 {
   NameTree nameTree(16);
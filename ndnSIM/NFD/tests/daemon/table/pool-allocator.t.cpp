@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pool-allocator.hpp"
+#include "table/pit.hpp"
+#include "table/fib.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TablePoolAllocator, BaseFixture)
+
+struct TestObject
+{
+  explicit
+  TestObject(int value)
+    : value(value)
+  {
+  }
+
+  int value;
+};
+
+BOOST_AUTO_TEST_CASE(ReuseBlocks)
+{
+  const PoolStats& stats = getPoolStats<TestObject>();
+  const size_t N_OBJECTS = PoolAllocator<TestObject>::SLAB_SIZE + 1;
+
+  std::vector<shared_ptr<TestObject>> objects;
+  for (size_t i = 0; i < N_OBJECTS; ++i) {
+    objects.push_back(std::allocate_shared<TestObject>(PoolAllocator<TestObject>(),
+                                                           static_cast<int>(i)));
+  }
+  BOOST_CHECK_EQUAL(stats.nInUse, N_OBJECTS);
+  BOOST_CHECK_EQUAL(stats.nSlabs, 2);
+  BOOST_CHECK_EQUAL(stats.nBlocks, 2 * PoolAllocator<TestObject>::SLAB_SIZE);
+
+  objects.resize(1);
+  BOOST_CHECK_EQUAL(stats.nInUse, 1);
+
+  // released blocks are reused before a new slab is taken
+  for (size_t i = 1; i < N_OBJECTS; ++i) {
+    objects.push_back(std::allocate_shared<TestObject>(PoolAllocator<TestObject>(),
+                                                           static_cast<int>(i)));
+  }
+  BOOST_CHECK_EQUAL(stats.nSlabs, 2);
+  for (size_t i = 0; i < N_OBJECTS; ++i) {
+    BOOST_CHECK_EQUAL(objects[i]->value, static_cast<int>(i));
+  }
+
+  objects.clear();
+  BOOST_CHECK_EQUAL(stats.nInUse, 0);
+}
+
+BOOST_AUTO_TEST_CASE(TableEntries)
+{
+  size_t nPitEntries = getPoolStats<pit::Entry>().nInUse;
+  size_t nFibEntries = getPoolStats<fib::Entry>().nInUse;
+  {
+    NameTree nameTree;
+    Pit pit(nameTree);
+    Fib fib(nameTree);
+
+    shared_ptr<Interest> interest = makeInterest("ndn:/pool/allocator");
+    pit.insert(*interest);
+    fib.insert("ndn:/pool");
+    BOOST_CHECK_EQUAL(getPoolStats<pit::Entry>().nInUse, nPitEntries + 1);
+    BOOST_CHECK_EQUAL(getPoolStats<fib::Entry>().nInUse, nFibEntries + 1);
+    BOOST_CHECK_GT(getPoolStats<name_tree::Entry>().nInUse, 0);
+  }
+  BOOST_CHECK_EQUAL(getPoolStats<pit::Entry>().nInUse, nPitEntries);
+  BOOST_CHECK_EQUAL(getPoolStats<fib::Entry>().nInUse, nFibEntries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -172,6 +172,41 @@ public:
   }
 };
 
+BOOST_AUTO_TEST_CASE(EffectiveStrategyCache)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P");
+  Name nameQ("ndn:/strategy/Q");
+  shared_ptr<Strategy> strategyP = make_shared<DummyStrategy>(ref(forwarder), nameP);
+  shared_ptr<Strategy> strategyQ = make_shared<DummyStrategy>(ref(forwarder), nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  table.install(strategyP);
+  table.install(strategyQ);
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  // { '/'=>P }
+
+  shared_ptr<Interest> interest = makeInterest("ndn:/A/B/1");
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+  BOOST_CHECK(pitEntry->getCachedStrategy(table.getVersion()) == nullptr);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_CHECK(pitEntry->getCachedStrategy(table.getVersion()) == strategyP.get());
+
+  uint64_t version = table.getVersion();
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  BOOST_CHECK_EQUAL(table.getVersion(), version); // not changing
+
+  BOOST_CHECK(table.insert("ndn:/A", nameQ));
+  // { '/'=>P, '/A'=>Q }
+  BOOST_CHECK_NE(table.getVersion(), version);
+  BOOST_CHECK(pitEntry->getCachedStrategy(table.getVersion()) == nullptr);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameQ);
+
+  table.erase("ndn:/A");
+  // { '/'=>P }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+}
+
 BOOST_AUTO_TEST_CASE(ClearStrategyInfo)
 {
   Forwarder forwarder;
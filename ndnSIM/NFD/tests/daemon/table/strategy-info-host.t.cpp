@@ -134,6 +134,23 @@ BOOST_AUTO_TEST_CASE(Types)
   BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 8063);
 }
 
+BOOST_AUTO_TEST_CASE(CreateFromPool)
+{
+  PoolStats& stats = getPoolStats<DummyStrategyInfo>();
+  size_t nInUse = stats.nInUse;
+
+  StrategyInfoHost host;
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(4417);
+  BOOST_CHECK_EQUAL(stats.nInUse, nInUse + 1);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo2>(5113);
+  host.setStrategyInfo<DummyStrategyInfo>(nullptr);
+  BOOST_CHECK_EQUAL(stats.nInUse, nInUse);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 5113);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
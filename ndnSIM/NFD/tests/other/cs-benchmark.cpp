@@ -24,8 +24,13 @@
  */
 
 #include "table/cs.hpp"
+#include "table/cs-policy-lru.hpp"
+#include "table/cs-policy-2q.hpp"
 #include <ndn-cxx/security/key-chain.hpp>
 
+#include <cmath>
+#include <random>
+
 #include "tests/test-common.hpp"
 
 namespace nfd {
@@ -217,6 +222,109 @@ BOOST_AUTO_TEST_CASE(Rightmost)
   BOOST_TEST_MESSAGE("find(rightmost) " << (N_INTERESTS * N_CHILDREN * REPEAT) << ": " << d);
 }
 
+// find(exact) hit and miss at increasing ContentStore sizes
+BOOST_AUTO_TEST_CASE(ExactScaling)
+{
+  const size_t REPEAT = 4;
+
+  for (size_t nEntries : {10000, 100000, 1000000}) {
+    Cs table(nEntries);
+    std::vector<shared_ptr<Data>> dataWorkload = makeDataWorkload(nEntries);
+    for (const auto& data : dataWorkload) {
+      table.insert(*data, false);
+    }
+    BOOST_REQUIRE(table.size() == nEntries);
+
+    std::vector<shared_ptr<Interest>> hitWorkload = makeInterestWorkload(nEntries);
+    std::vector<shared_ptr<Interest>> missWorkload =
+      makeInterestWorkload(nEntries, SimpleNameGenerator("/cs/benchmark/miss"));
+
+    size_t nHits = 0;
+    time::microseconds dHit = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : hitWorkload) {
+          table.find(*interest, bind([&nHits] { ++nHits; }), bind([]{}));
+        }
+      }
+    });
+    BOOST_CHECK_EQUAL(nHits, nEntries * REPEAT);
+
+    time::microseconds dMiss = timedRun([&] {
+      for (size_t j = 0; j < REPEAT; ++j) {
+        for (const auto& interest : missWorkload) {
+          table.find(*interest, bind([]{}), bind([]{}));
+        }
+      }
+    });
+
+    BOOST_TEST_MESSAGE("find(exact) in " << nEntries << " entries, " << (nEntries * REPEAT) <<
+                       " hits: " << dHit << ", " << (nEntries * REPEAT) << " misses: " << dMiss);
+  }
+}
+
+// hit ratio and cost of replacement policies on Zipf requests, with and without one-shot scans
+BOOST_AUTO_TEST_CASE(PolicyHitRatio)
+{
+  const size_t CAPACITY = 1000;
+  const size_t N_CATALOG = CAPACITY * 10;
+  const size_t N_REQUESTS = CAPACITY * 200;
+
+  // Zipf-Mandelbrot popularity as in ConsumerZipfMandelbrot, q=0.7 s=0.7
+  std::vector<double> popularity(N_CATALOG);
+  for (size_t rank = 0; rank < N_CATALOG; ++rank) {
+    popularity[rank] = 1.0 / std::pow(rank + 1 + 0.7, 0.7);
+  }
+  std::mt19937 rng(2015);
+  std::discrete_distribution<size_t> zipf(popularity.begin(), popularity.end());
+
+  std::vector<shared_ptr<Interest>> catalogInterests = makeInterestWorkload(N_CATALOG);
+  std::vector<shared_ptr<Data>> catalogData = makeDataWorkload(N_CATALOG);
+  std::vector<shared_ptr<Interest>> scanInterests =
+    makeInterestWorkload(N_REQUESTS, SimpleNameGenerator("/cs/benchmark/scan"));
+  std::vector<shared_ptr<Data>> scanData =
+    makeDataWorkload(N_REQUESTS, SimpleNameGenerator("/cs/benchmark/scan"));
+
+  // a request is an index into the catalog, or ~index into the scan for a unique Name
+  std::vector<size_t> zipfRequests(N_REQUESTS);
+  std::vector<size_t> scanRequests(N_REQUESTS);
+  for (size_t i = 0; i < N_REQUESTS; ++i) {
+    zipfRequests[i] = zipf(rng);
+    scanRequests[i] = i % 2 == 0 ? zipf(rng) : ~i;
+  }
+
+  for (const std::string& policyName : {LruPolicy::POLICY_NAME, TwoQPolicy::POLICY_NAME}) {
+    for (const auto& workload : {std::make_pair("zipf", &zipfRequests),
+                                 std::make_pair("zipf+scan", &scanRequests)}) {
+      Cs table(CAPACITY);
+      table.setPolicy(makePolicy(policyName));
+
+      size_t nHits = 0;
+      size_t nCatalogRequests = 0;
+      time::microseconds d = timedRun([&] {
+        for (size_t request : *workload.second) {
+          bool isScan = request >= N_CATALOG;
+          const Interest& interest = isScan ? *scanInterests[~request] : *catalogInterests[request];
+          const Data& data = isScan ? *scanData[~request] : *catalogData[request];
+          nCatalogRequests += isScan ? 0 : 1;
+
+          bool isHit = false;
+          table.find(interest, bind([&isHit] { isHit = true; }), bind([]{}));
+          if (isHit) {
+            ++nHits;
+          }
+          else {
+            table.insert(data, false);
+          }
+        }
+      });
+
+      BOOST_TEST_MESSAGE(policyName << " " << workload.first << " " << N_REQUESTS << ": " << d <<
+                         ", hit ratio of catalog requests " <<
+                         static_cast<double>(nHits) / nCatalogRequests);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,586 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/name-tree.hpp"
+#include "table/pit.hpp"
+#include "table/fib.hpp"
+#include "table/cs.hpp"
+#include "table/dead-nonce-list.hpp"
+#include "table/strategy-choice.hpp"
+#include "fw/forwarder.hpp"
+#include "rib/fib-updater.hpp"
+#include "tests/daemon/fw/dummy-strategy.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+/** \brief collects benchmark results and writes them as JSON when the program exits
+ *
+ *  The output follows the layout of Google Benchmark's JSON reporter, so that results of two
+ *  versions can be compared with the same tools.  The file name is taken from the
+ *  NFD_BENCHMARK_OUTPUT environment variable, table-benchmark.json by default.
+ */
+class BenchmarkReport : noncopyable
+{
+public:
+  struct Result
+  {
+    std::string table;
+    std::string operation;
+    size_t size;
+    size_t depth;
+    size_t nOps;
+    double nsPerOp;
+  };
+
+  static BenchmarkReport&
+  get()
+  {
+    static BenchmarkReport report;
+    return report;
+  }
+
+  void
+  add(const Result& result)
+  {
+    m_results.push_back(result);
+  }
+
+  ~BenchmarkReport()
+  {
+    const char* fileName = std::getenv("NFD_BENCHMARK_OUTPUT");
+    std::ofstream os(fileName != nullptr ? fileName : "table-benchmark.json");
+
+    os << "{\n"
+       << "  \"context\": {\n"
+#ifdef _DEBUG
+       << "    \"library_build_type\": \"debug\"\n"
+#else
+       << "    \"library_build_type\": \"release\"\n"
+#endif // _DEBUG
+       << "  },\n"
+       << "  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+      const Result& r = m_results[i];
+      os << (i == 0 ? "\n" : ",\n")
+         << "    {\n"
+         << "      \"name\": \"" << r.table << "/" << r.operation
+                                 << "/size:" << r.size << "/depth:" << r.depth << "\",\n"
+         << "      \"table\": \"" << r.table << "\",\n"
+         << "      \"operation\": \"" << r.operation << "\",\n"
+         << "      \"size\": " << r.size << ",\n"
+         << "      \"depth\": " << r.depth << ",\n"
+         << "      \"iterations\": " << r.nOps << ",\n"
+         << "      \"real_time\": " << r.nsPerOp << ",\n"
+         << "      \"time_unit\": \"ns\"\n"
+         << "    }";
+    }
+    os << "\n  ]\n"
+       << "}\n";
+  }
+
+private:
+  BenchmarkReport() = default;
+
+private:
+  std::vector<Result> m_results;
+};
+
+class TableBenchmarkFixture : public BaseFixture
+{
+protected:
+  TableBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+  }
+
+  /** \brief makes a name of \p depth components: /S/<region>.../A/<application>.../<seq>
+   *
+   *  Spatial components fan out by 8 per level, so that names of a run share prefixes the way
+   *  names of neighboring producers do.  The last component makes the name unique.
+   */
+  static Name
+  makeName(size_t i, size_t depth)
+  {
+    BOOST_ASSERT(depth >= 4);
+    size_t nSpatial = (depth - 2) / 2;
+    size_t nApplication = depth - 3 - nSpatial;
+
+    Name name("/S");
+    for (size_t level = 0, group = i; level < nSpatial; ++level, group /= 8) {
+      name.append("region" + to_string(group % 8));
+    }
+    name.append("A");
+    for (size_t level = 0; level < nApplication; ++level) {
+      name.append("app" + to_string((i >> level) % 4));
+    }
+    name.appendSequenceNumber(i);
+    return name;
+  }
+
+  static std::vector<Name>
+  makeNames(size_t count, size_t depth)
+  {
+    std::vector<Name> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      names.push_back(makeName(i, depth));
+    }
+    return names;
+  }
+
+  /** \brief runs \p f, which performs \p nOps operations, and reports the time per operation
+   *
+   *  The wall clock is used directly, it is not affected by the clocks ndnSIM installs.
+   */
+  static void
+  measure(const std::string& table, const std::string& operation, size_t size, size_t depth,
+          size_t nOps, const std::function<void()>& f)
+  {
+    auto t1 = std::chrono::steady_clock::now();
+    f();
+    auto t2 = std::chrono::steady_clock::now();
+
+    double nsPerOp = std::chrono::duration<double, std::nano>(t2 - t1).count() /
+                     std::max<size_t>(nOps, 1);
+    BenchmarkReport::get().add({table, operation, size, depth, nOps, nsPerOp});
+    BOOST_TEST_MESSAGE(table << "/" << operation << "/size:" << size << "/depth:" << depth <<
+                       " " << nsPerOp << " ns/op");
+  }
+
+protected:
+  static const std::vector<size_t> SIZES;
+  static const std::vector<size_t> DEPTHS;
+};
+
+const std::vector<size_t> TableBenchmarkFixture::SIZES = {1000, 10000, 100000};
+const std::vector<size_t> TableBenchmarkFixture::DEPTHS = {4, 8};
+
+BOOST_FIXTURE_TEST_SUITE(TableBenchmark, TableBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(NameTreeOperations)
+{
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      std::vector<Name> names = makeNames(size, depth);
+      NameTree nameTree;
+
+      measure("NameTree", "insert", size, depth, size, [&] {
+        for (const Name& name : names) {
+          nameTree.lookup(name);
+        }
+      });
+
+      size_t nFound = 0;
+      measure("NameTree", "findExactMatch", size, depth, size, [&] {
+        for (const Name& name : names) {
+          nFound += nameTree.findExactMatch(name) != nullptr;
+        }
+      });
+      BOOST_CHECK_EQUAL(nFound, size);
+
+      Name missSuffix("/miss");
+      std::vector<Name> lpmNames;
+      for (const Name& name : names) {
+        lpmNames.push_back(Name(name).append(missSuffix));
+      }
+      measure("NameTree", "findLongestPrefixMatch", size, depth, size, [&] {
+        for (const Name& name : lpmNames) {
+          nFound += nameTree.findLongestPrefixMatch(name) != nullptr;
+        }
+      });
+
+      size_t nVisited = 0;
+      measure("NameTree", "iterate", size, depth, nameTree.size(), [&] {
+        for (const name_tree::Entry& entry : nameTree.fullEnumerate()) {
+          nVisited += entry.getPrefix().size() > 0;
+        }
+      });
+      BOOST_CHECK_GT(nVisited, 0);
+
+      measure("NameTree", "erase", size, depth, size, [&] {
+        for (const Name& name : names) {
+          nameTree.eraseEntryIfEmpty(nameTree.findExactMatch(name));
+        }
+      });
+      BOOST_CHECK_EQUAL(nameTree.size(), 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(PitOperations)
+{
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      std::vector<shared_ptr<Interest>> interests;
+      std::vector<shared_ptr<Data>> data;
+      for (const Name& name : makeNames(size, depth)) {
+        interests.push_back(makeInterest(name));
+        data.push_back(makeData(name));
+      }
+      NameTree nameTree;
+      Pit pit(nameTree);
+
+      std::vector<shared_ptr<pit::Entry>> entries;
+      entries.reserve(size);
+      measure("Pit", "insert", size, depth, size, [&] {
+        for (const shared_ptr<Interest>& interest : interests) {
+          entries.push_back(pit.insert(*interest).first);
+        }
+      });
+
+      size_t nExisting = 0;
+      measure("Pit", "find", size, depth, size, [&] {
+        for (const shared_ptr<Interest>& interest : interests) {
+          nExisting += !pit.insert(*interest).second;
+        }
+      });
+      BOOST_CHECK_EQUAL(nExisting, size);
+
+      size_t nMatches = 0;
+      measure("Pit", "findAllDataMatches", size, depth, size, [&] {
+        for (const shared_ptr<Data>& item : data) {
+          nMatches += pit.findAllDataMatches(*item).size();
+        }
+      });
+      BOOST_CHECK_EQUAL(nMatches, size);
+
+      size_t nVisited = 0;
+      measure("Pit", "iterate", size, depth, pit.size(), [&] {
+        for (const pit::Entry& entry : pit) {
+          nVisited += entry.getInRecords().empty();
+        }
+      });
+      BOOST_CHECK_EQUAL(nVisited, size);
+
+      measure("Pit", "erase", size, depth, size, [&] {
+        for (const shared_ptr<pit::Entry>& entry : entries) {
+          pit.erase(entry);
+        }
+      });
+      BOOST_CHECK_EQUAL(pit.size(), 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FibOperations)
+{
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      // FIB entries are producer prefixes, lookups are for Data names under them
+      std::vector<Name> prefixes = makeNames(size, depth);
+      std::vector<Name> names;
+      for (const Name& prefix : prefixes) {
+        names.push_back(Name(prefix).appendSegment(0));
+      }
+      NameTree nameTree;
+      Fib fib(nameTree);
+
+      measure("Fib", "insert", size, depth, size, [&] {
+        for (const Name& prefix : prefixes) {
+          fib.insert(prefix);
+        }
+      });
+
+      size_t nFound = 0;
+      measure("Fib", "findLongestPrefixMatch", size, depth, size, [&] {
+        for (const Name& name : names) {
+          nFound += fib.findLongestPrefixMatch(name)->getPrefix().size() > 0;
+        }
+      });
+      BOOST_CHECK_EQUAL(nFound, size);
+
+      size_t nVisited = 0;
+      measure("Fib", "iterate", size, depth, fib.size(), [&] {
+        for (const fib::Entry& entry : fib) {
+          nVisited += entry.getNextHops().empty();
+        }
+      });
+      BOOST_CHECK_EQUAL(nVisited, size);
+
+      measure("Fib", "erase", size, depth, size, [&] {
+        for (const Name& prefix : prefixes) {
+          fib.erase(prefix);
+        }
+      });
+      BOOST_CHECK_EQUAL(fib.size(), 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CsOperations)
+{
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      std::vector<shared_ptr<Data>> data;
+      std::vector<shared_ptr<Interest>> exactInterests;
+      std::vector<shared_ptr<Interest>> prefixInterests;
+      for (const Name& name : makeNames(size, depth)) {
+        data.push_back(makeData(name));
+        exactInterests.push_back(makeInterest(name));
+        prefixInterests.push_back(makeInterest(name.getPrefix(-1)));
+      }
+      Cs cs(size);
+
+      measure("Cs", "insert", size, depth, size, [&] {
+        for (const shared_ptr<Data>& item : data) {
+          cs.insert(*item, false);
+        }
+      });
+      BOOST_CHECK_EQUAL(cs.size(), size);
+
+      size_t nHits = 0;
+      measure("Cs", "findExact", size, depth, size, [&] {
+        for (const shared_ptr<Interest>& interest : exactInterests) {
+          cs.find(*interest, bind([&nHits] { ++nHits; }), bind([]{}));
+        }
+      });
+      BOOST_CHECK_EQUAL(nHits, size);
+
+      measure("Cs", "findPrefix", size, depth, size, [&] {
+        for (const shared_ptr<Interest>& interest : prefixInterests) {
+          cs.find(*interest, bind([&nHits] { ++nHits; }), bind([]{}));
+        }
+      });
+      BOOST_CHECK_EQUAL(nHits, 2 * size);
+
+      size_t nVisited = 0;
+      measure("Cs", "iterate", size, depth, cs.size(), [&] {
+        for (const cs::Entry& entry : cs) {
+          nVisited += !entry.isUnsolicited();
+        }
+      });
+      BOOST_CHECK_EQUAL(nVisited, size);
+
+      // Cs has no erase, entries leave by eviction when the limit is lowered
+      measure("Cs", "evict", size, depth, size, [&] {
+        cs.setLimit(0);
+      });
+      BOOST_CHECK_EQUAL(cs.size(), 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DeadNonceListOperations)
+{
+  // the exact list keeps at most its capacity, which is adjusted only as time passes,
+  // so its insertions evict and only the latest entries are found
+  for (double falsePositiveRate : {0.0, 0.01}) {
+    std::string table = falsePositiveRate == 0.0 ? "DeadNonceList" : "DeadNonceList(filter)";
+    for (size_t depth : DEPTHS) {
+      for (size_t size : SIZES) {
+        std::vector<Name> names = makeNames(size, depth);
+        DeadNonceList dnl(DeadNonceList::DEFAULT_LIFETIME, falsePositiveRate);
+
+        measure(table, "insert", size, depth, size, [&] {
+          for (size_t i = 0; i < size; ++i) {
+            dnl.add(names[i], static_cast<uint32_t>(i));
+          }
+        });
+
+        size_t nFound = 0;
+        measure(table, "find", size, depth, size, [&] {
+          for (size_t i = 0; i < size; ++i) {
+            nFound += dnl.has(names[i], static_cast<uint32_t>(i));
+          }
+        });
+        BOOST_CHECK_GT(nFound, 0);
+
+        measure(table, "findMiss", size, depth, size, [&] {
+          for (size_t i = 0; i < size; ++i) {
+            nFound += dnl.has(names[i], static_cast<uint32_t>(i + size));
+          }
+        });
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(StrategyChoiceOperations)
+{
+  Forwarder forwarder;
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  Name strategyName("ndn:/strategy/benchmark");
+  table.install(make_shared<DummyStrategy>(ref(forwarder), strategyName));
+
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      // strategies are chosen for producer prefixes, lookups are for Interest names under them
+      std::vector<Name> prefixes = makeNames(size, depth);
+      std::vector<Name> names;
+      for (const Name& prefix : prefixes) {
+        names.push_back(Name(prefix).appendSegment(0));
+      }
+      size_t nRootEntries = table.size();
+
+      measure("StrategyChoice", "insert", size, depth, size, [&] {
+        for (const Name& prefix : prefixes) {
+          table.insert(prefix, strategyName);
+        }
+      });
+
+      size_t nFound = 0;
+      measure("StrategyChoice", "findEffectiveStrategy", size, depth, size, [&] {
+        for (const Name& name : names) {
+          nFound += table.findEffectiveStrategy(name).getName() == strategyName;
+        }
+      });
+      BOOST_CHECK_EQUAL(nFound, size);
+
+      size_t nVisited = 0;
+      measure("StrategyChoice", "iterate", size, depth, table.size(), [&] {
+        for (const strategy_choice::Entry& entry : table) {
+          nVisited += entry.getPrefix().size() > 0;
+        }
+      });
+      BOOST_CHECK_EQUAL(nVisited, size);
+
+      measure("StrategyChoice", "erase", size, depth, size, [&] {
+        for (const Name& prefix : prefixes) {
+          table.erase(prefix);
+        }
+      });
+      BOOST_CHECK_EQUAL(table.size(), nRootEntries);
+    }
+  }
+}
+
+/** \brief applies RIB updates as if NFD accepted every FIB update
+ *
+ *  FIB updates are computed but not sent, so the measurement covers the route inheritance
+ *  computation and the RIB table, not command signing.
+ */
+class RibBenchmarkFixture : public TableBenchmarkFixture
+{
+protected:
+  typedef rib::RibUpdate RibUpdate;
+  typedef rib::RibUpdateBatch RibUpdateBatch;
+
+  RibBenchmarkFixture()
+    : face(ndn::util::makeDummyClientFace())
+    , controller(*face, keyChain)
+    , fibUpdater(rib, controller)
+  {
+  }
+
+  void
+  apply(RibUpdate::Action action, const Name& name, uint64_t faceId, uint64_t flags)
+  {
+    rib::Route route;
+    route.faceId = faceId;
+    route.flags = flags;
+
+    RibUpdate update;
+    update.setAction(action)
+          .setName(name)
+          .setRoute(route);
+
+    RibUpdateBatch batch(faceId);
+    batch.add(update);
+
+    fibUpdater.m_inheritedRoutes.clear();
+    fibUpdater.m_updatesForBatchFaceId.clear();
+    fibUpdater.m_updatesForNonBatchFaceId.clear();
+    fibUpdater.computeUpdates(batch);
+    nFibUpdates += fibUpdater.m_updatesForBatchFaceId.size() +
+                   fibUpdater.m_updatesForNonBatchFaceId.size();
+
+    rib.onFibUpdateSuccess(batch, fibUpdater.m_inheritedRoutes, nullptr);
+  }
+
+protected:
+  shared_ptr<ndn::util::DummyClientFace> face;
+  ndn::KeyChain keyChain;
+  ndn::nfd::Controller controller;
+  rib::Rib rib;
+  rib::FibUpdater fibUpdater;
+  size_t nFibUpdates = 0;
+};
+
+BOOST_FIXTURE_TEST_CASE(RibOperations, RibBenchmarkFixture)
+{
+  const uint64_t childInherit = ndn::nfd::ROUTE_FLAG_CHILD_INHERIT;
+
+  for (size_t depth : DEPTHS) {
+    for (size_t size : SIZES) {
+      std::vector<Name> names = makeNames(size, depth);
+      std::set<Name> parents;
+      for (const Name& name : names) {
+        parents.insert(name.getPrefix(-1));
+      }
+
+      // a route inherited by the whole spatial namespace
+      apply(RibUpdate::REGISTER, "/S", 1, childInherit);
+
+      measure("Rib", "register", size, depth, size, [&] {
+        for (size_t i = 0; i < size; ++i) {
+          apply(RibUpdate::REGISTER, names[i], 2 + i % 16, childInherit);
+        }
+      });
+      BOOST_CHECK_EQUAL(rib.size(), size + 1);
+
+      // new entries between existing ones, their children are re-parented
+      measure("Rib", "registerParent", size, depth, parents.size(), [&] {
+        for (const Name& parent : parents) {
+          apply(RibUpdate::REGISTER, parent, 1, childInherit);
+        }
+      });
+
+      // the inherited route changes for every entry under /S
+      nFibUpdates = 0;
+      measure("Rib", "unregisterInherited", size, depth, 1, [&] {
+        apply(RibUpdate::UNREGISTER, "/S", 1, childInherit);
+      });
+      BOOST_CHECK_GT(nFibUpdates, 0);
+
+      measure("Rib", "unregister", size, depth, size + parents.size(), [&] {
+        for (size_t i = 0; i < size; ++i) {
+          apply(RibUpdate::UNREGISTER, names[i], 2 + i % 16, childInherit);
+        }
+        for (const Name& parent : parents) {
+          apply(RibUpdate::UNREGISTER, parent, 1, childInherit);
+        }
+      });
+      BOOST_CHECK(rib.empty());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
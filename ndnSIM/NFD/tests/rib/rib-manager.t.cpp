@@ -233,6 +233,59 @@ BOOST_FIXTURE_TEST_CASE(Unregister, AuthorizedRibManager)
 }
 
 
+BOOST_FIXTURE_TEST_CASE(BatchRegister, AuthorizedRibManager)
+{
+  std::vector<ControlParameters> entries;
+  entries.push_back(ControlParameters().setName("/S/region/A").setFaceId(1).setCost(10));
+  entries.push_back(ControlParameters().setName("/S/region/B").setFaceId(1).setCost(20));
+  entries.push_back(ControlParameters().setName("/S/region/B/app").setFaceId(1).setCost(30));
+
+  std::vector<size_t> batchSizes;
+  manager->m_managedRib.m_onSendBatchFromQueue = [&batchSizes] (const RibUpdateBatch& batch) {
+    batchSizes.push_back(batch.size());
+  };
+
+  ndn::nfd::RibBatchRegisterCommand command;
+  Interest commandInterest(command.getRequestName("/localhost/nfd", entries));
+  face->receive(commandInterest);
+  face->processEvents(time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 1);
+  ControlResponse response(face->sentDatas[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(response.getCode(), 200);
+
+  // /S/region/B/app is under /S/region/B, so it waits for the next RIB batch
+  BOOST_REQUIRE_EQUAL(batchSizes.size(), 1);
+  BOOST_CHECK_EQUAL(batchSizes[0], 2);
+  BOOST_CHECK_EQUAL(manager->m_managedRib.m_updateBatches.size(), 1);
+
+  // FIB updates of the first batch are sent in one command
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 1);
+  const Name& request = face->sentInterests[0].getName();
+  BOOST_CHECK(Name("/localhost/nfd/fib/batch").isPrefixOf(request));
+  std::vector<ControlParameters> fibEntries =
+    ndn::nfd::BatchControlCommand::decodeEntries(request[4]);
+  BOOST_REQUIRE_EQUAL(fibEntries.size(), 2);
+  BOOST_CHECK_EQUAL(fibEntries[0].getName(), Name("/S/region/A"));
+  BOOST_CHECK_EQUAL(fibEntries[0].getCost(), 10);
+  BOOST_CHECK_EQUAL(fibEntries[1].getName(), Name("/S/region/B"));
+  BOOST_CHECK_EQUAL(fibEntries[1].getCost(), 20);
+}
+
+BOOST_FIXTURE_TEST_CASE(BatchRegisterMalformed, AuthorizedRibManager)
+{
+  Name commandName("/localhost/nfd/rib/batch-register");
+  commandName.append(ControlParameters().setFaceId(1).wireEncode());
+
+  face->receive(Interest(commandName));
+  face->processEvents(time::milliseconds(1));
+
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 1);
+  ControlResponse response(face->sentDatas[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(response.getCode(), 400);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 0);
+}
+
 BOOST_FIXTURE_TEST_CASE(UnauthorizedCommand, UnauthorizedRibManager)
 {
   ControlParameters parameters;
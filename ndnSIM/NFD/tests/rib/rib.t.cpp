@@ -152,6 +152,35 @@ BOOST_AUTO_TEST_CASE(Children)
   BOOST_CHECK_EQUAL((rib.find(name3)->second)->getParent()->getName(), name4);
 }
 
+BOOST_AUTO_TEST_CASE(NestedChildren)
+{
+  rib::Rib rib;
+
+  Route route;
+  route.faceId = 1;
+  route.origin = 20;
+  rib.insert("/S", route);
+  rib.insert("/S/region/A", route);
+  rib.insert("/S/region/A/app", route);
+  rib.insert("/S/region/B", route);
+  rib.insert("/S/regionB", route);
+
+  BOOST_CHECK_EQUAL(rib.findDescendantsForNonInsertedName("/S/region").size(), 3);
+  BOOST_CHECK_EQUAL(rib.findDescendantsForNonInsertedName("/S/regio").size(), 0);
+
+  // only the entries directly under the new entry become its children
+  rib.insert("/S/region", route);
+
+  shared_ptr<rib::RibEntry> region = rib.find("/S/region")->second;
+  BOOST_CHECK_EQUAL(region->getChildren().size(), 2);
+  BOOST_CHECK_EQUAL(region->getParent()->getName(), "/S");
+  BOOST_CHECK_EQUAL(rib.find("/S")->second->getChildren().size(), 2);
+  BOOST_CHECK_EQUAL(rib.find("/S/region/A")->second->getParent(), region);
+  BOOST_CHECK_EQUAL(rib.find("/S/region/B")->second->getParent(), region);
+  BOOST_CHECK_EQUAL(rib.find("/S/region/A/app")->second->getParent()->getName(), "/S/region/A");
+  BOOST_CHECK_EQUAL(rib.find("/S/regionB")->second->getParent()->getName(), "/S");
+}
+
 BOOST_AUTO_TEST_CASE(EraseFace)
 {
   rib::Rib rib;
@@ -21,6 +21,7 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
+#include "ns3/enum.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-app-face.hpp"
@@ -39,6 +40,15 @@ App::GetTypeId(void)
                         .SetGroupName("Ndn")
                         .SetParent<Application>()
                         .AddConstructor<App>()
+                        .AddAttribute("Dispatch",
+                                      "How the application face delivers Interests and Data: "
+                                      "Scheduled (one event per packet), Batched (one event for "
+                                      "all packets of the same time) or Inline (no event)",
+                                      EnumValue(AppFace::DISPATCH_SCHEDULED),
+                                      MakeEnumAccessor(&App::m_dispatchMode),
+                                      MakeEnumChecker(AppFace::DISPATCH_SCHEDULED, "Scheduled",
+                                                      AppFace::DISPATCH_BATCHED, "Batched",
+                                                      AppFace::DISPATCH_INLINE, "Inline"))
 
                         .AddTraceSource("ReceivedInterests", "ReceivedInterests",
                                         MakeTraceSourceAccessor(&App::m_receivedInterests),
@@ -48,6 +58,10 @@ App::GetTypeId(void)
                                         MakeTraceSourceAccessor(&App::m_receivedDatas),
                                         "ns3::ndn::App::DataTraceCallback")
 
+                        .AddTraceSource("ReceivedNacks", "ReceivedNacks",
+                                        MakeTraceSourceAccessor(&App::m_receivedNacks),
+                                        "ns3::ndn::App::NackTraceCallback")
+
                         .AddTraceSource("TransmittedInterests", "TransmittedInterests",
                                         MakeTraceSourceAccessor(&App::m_transmittedInterests),
                                         "ns3::ndn::App::InterestTraceCallback")
@@ -62,6 +76,7 @@ App::App()
   : m_active(false)
   , m_face(0)
   , m_appId(std::numeric_limits<uint32_t>::max())
+  , m_dispatchMode(AppFace::DISPATCH_SCHEDULED)
 {
 }
 
@@ -115,6 +130,13 @@ App::OnData(shared_ptr<const Data> data)
   m_receivedDatas(data, this, m_face);
 }
 
+void
+App::OnNack(shared_ptr<const lp::Nack> nack)
+{
+  NS_LOG_FUNCTION(this << nack);
+  m_receivedNacks(nack, this, m_face);
+}
+
 // Application Methods
 void
 App::StartApplication() // Called at time specified by Start
@@ -128,7 +150,7 @@ App::StartApplication() // Called at time specified by Start
                 "Ndn stack should be installed on the node " << GetNode());
 
   // step 1. Create a face
-  m_face = std::make_shared<AppFace>(this);
+  m_face = std::make_shared<AppFace>(this, m_dispatchMode);
 
   // step 2. Add face to the Ndn stack
   GetNode()->GetObject<L3Protocol>()->addFace(m_face);
@@ -80,9 +80,17 @@ public:
   virtual void
   OnData(shared_ptr<const Data> data);
 
+  /**
+   * @brief Method that will be called every time a Nack arrives for an Interest of the app
+   * @param nack Nack carrying the rejected Interest and the reason
+   */
+  virtual void
+  OnNack(shared_ptr<const lp::Nack> nack);
+
 public:
   typedef void (*InterestTraceCallback)(shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>);
   typedef void (*DataTraceCallback)(shared_ptr<const Data>, Ptr<App>, shared_ptr<Face>);
+  typedef void (*NackTraceCallback)(shared_ptr<const lp::Nack>, Ptr<App>, shared_ptr<Face>);
 
 protected:
   virtual void
@@ -102,6 +110,7 @@ protected:
   bool m_active; ///< @brief Flag to indicate that application is active (set by StartApplication and StopApplication)
   shared_ptr<AppFace> m_face; ///< @brief automatically created application face through which application communicates
   uint32_t m_appId;
+  AppFace::DispatchMode m_dispatchMode; ///< @brief how the face delivers packets to the application
 
   TracedCallback<shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>>
     m_receivedInterests; ///< @brief App-level trace of received Interests
@@ -109,6 +118,9 @@ protected:
   TracedCallback<shared_ptr<const Data>, Ptr<App>, shared_ptr<Face>>
     m_receivedDatas; ///< @brief App-level trace of received Data
 
+  TracedCallback<shared_ptr<const lp::Nack>, Ptr<App>, shared_ptr<Face>>
+    m_receivedNacks; ///< @brief App-level trace of received Nacks
+
   TracedCallback<shared_ptr<const Interest>, Ptr<App>, shared_ptr<Face>>
     m_transmittedInterests; ///< @brief App-level trace of transmitted Interests
 
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-basic-consumer.hpp"
+#include "ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/integer.h"
+#include "ns3/double.h"
+
+#include "model/ndn-app-face.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+
+#include <string>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BasicConsumer");
+
+namespace ns3 {
+namespace ndn {
+
+RandomTreeNames::RandomTreeNames()
+  : m_aNameTree("A")
+  , m_sNameTree("S")
+  , m_isNameTreeBuilt(false)
+{
+}
+
+void
+RandomTreeNames::BuildNames()
+{
+  // same trees as ConsumerRandomCbr
+  if (!m_isNameTreeBuilt) {
+    m_aNameTree.InitBuild(3, 3);
+    m_sNameTree.BuildScene("scene1");
+    m_isNameTreeBuilt = true;
+  }
+}
+
+int64_t
+RandomTreeNames::AssignStreams(int64_t stream)
+{
+  int64_t nStreams = m_sNameTree.AssignStreams(stream);
+  nStreams += m_aNameTree.AssignStreams(stream + nStreams);
+  return nStreams;
+}
+
+ZipfMandelbrotNames::ZipfMandelbrotNames()
+  : m_n(100)
+  , m_q(0.7)
+  , m_s(0.7)
+  , m_seqRng(CreateObject<UniformRandomVariable>())
+{
+}
+
+TypeId
+ZipfMandelbrotNames::AddAttributes(TypeId tid)
+{
+  return tid
+    .AddAttribute("NumberOfContents", "Number of the Contents in total", StringValue("100"),
+                  MakeUintegerAccessor(&ZipfMandelbrotNames::m_n),
+                  MakeUintegerChecker<uint32_t>())
+
+    .AddAttribute("q", "parameter of improve rank", StringValue("0.7"),
+                  MakeDoubleAccessor(&ZipfMandelbrotNames::m_q), MakeDoubleChecker<double>())
+
+    .AddAttribute("s", "parameter of power", StringValue("0.7"),
+                  MakeDoubleAccessor(&ZipfMandelbrotNames::m_s), MakeDoubleChecker<double>());
+}
+
+void
+ZipfMandelbrotNames::BuildNames()
+{
+  m_sharedTable = ConsumerZipfMandelbrot::BuildPopularityTable(m_n, m_q, m_s, m_table);
+}
+
+int64_t
+ZipfMandelbrotNames::AssignStreams(int64_t stream)
+{
+  m_seqRng->SetStream(stream);
+  return 1;
+}
+
+template<class NameGenerator, class RtoPolicy>
+TypeId
+BasicConsumer<NameGenerator, RtoPolicy>::GetTypeId()
+{
+  static const std::string name = std::string("ns3::ndn::BasicConsumer") +
+                                  NameGenerator::GetPolicyName() + RtoPolicy::GetPolicyName();
+  static TypeId tid =
+    NameGenerator::AddAttributes(
+      TypeId(name.c_str())
+        .SetGroupName("Ndn")
+        .SetParent<Consumer>()
+        .AddConstructor<BasicConsumer>()
+
+        .AddAttribute("Frequency", "Frequency of interest packets", StringValue("1.0"),
+                      MakeDoubleAccessor(&BasicConsumer::m_frequency),
+                      MakeDoubleChecker<double>())
+
+        .AddAttribute("MaxSeq", "Maximum number of Interests to send",
+                      IntegerValue(std::numeric_limits<uint32_t>::max()),
+                      MakeIntegerAccessor(&BasicConsumer::m_seqMax),
+                      MakeIntegerChecker<uint32_t>()));
+
+  return tid;
+}
+
+template<class NameGenerator, class RtoPolicy>
+BasicConsumer<NameGenerator, RtoPolicy>::BasicConsumer()
+  : m_frequency(1.0)
+  , m_firstTime(true)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  m_seqMax = std::numeric_limits<uint32_t>::max();
+  m_rtoPolicy = RtoPolicy::POLICY;
+  m_isSameWithLastInterest = NameGenerator::IS_SAME_PREFIX;
+}
+
+template<class NameGenerator, class RtoPolicy>
+int64_t
+BasicConsumer<NameGenerator, RtoPolicy>::AssignStreams(int64_t stream)
+{
+  int64_t nStreams = Consumer::AssignStreams(stream);
+  return nStreams + NameGenerator::AssignStreams(stream + nStreams);
+}
+
+template<class NameGenerator, class RtoPolicy>
+void
+BasicConsumer<NameGenerator, RtoPolicy>::StartApplication()
+{
+  NameGenerator::BuildNames();
+
+  // the policies replace the attribute, also for the retransmissions with other estimators
+  m_rtoPolicy = RtoPolicy::POLICY;
+  m_isSameWithLastInterest = NameGenerator::IS_SAME_PREFIX;
+
+  // a subclass of RttMeanDeviation may override what would be called directly
+  m_meanDeviation = nullptr;
+  if (m_rtt->GetInstanceTypeId() == RttMeanDeviation::GetTypeId())
+    m_meanDeviation = StaticCast<RttMeanDeviation>(m_rtt);
+  else
+    NS_LOG_DEBUG("RTT estimator " << m_rtt->GetInstanceTypeId().GetName()
+                                  << " is called through RttEstimator");
+
+  Consumer::StartApplication();
+}
+
+template<class NameGenerator, class RtoPolicy>
+void
+BasicConsumer<NameGenerator, RtoPolicy>::ScheduleNextPacket()
+{
+  if (m_firstTime) {
+    m_sendEvent = Simulator::Schedule(Seconds(0.0), &BasicConsumer::SendNextPacket, this);
+    m_firstTime = false;
+  }
+  else if (!m_sendEvent.IsRunning())
+    m_sendEvent =
+      Simulator::Schedule(Seconds(1.0 / m_frequency), &BasicConsumer::SendNextPacket, this);
+}
+
+template<class NameGenerator, class RtoPolicy>
+void
+BasicConsumer<NameGenerator, RtoPolicy>::SendNextPacket()
+{
+  if (!m_active)
+    return;
+
+  NDN_ALLOCATION_SCOPE(APPS);
+
+  if (m_seq >= m_seqMax)
+    return; // we are totally done
+
+  uint32_t seq;
+  const Name& prefix = NameGenerator::Next(m_interestName, m_seq++, seq);
+
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  shared_ptr<const Interest> interest;
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry == nullptr || entry->interest == nullptr) {
+    time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+    interest = GetInterestTemplate(prefix, interestLifeTime).makeInterest(seq, nonce);
+  }
+  else {
+    interest = InterestTemplate::refreshNonce(*entry->interest, nonce);
+  }
+
+  NS_LOG_INFO("> Interest for " << seq);
+
+  BasicConsumer::WaitBeforeSendOutInterest(seq, interest);
+
+  m_transmittedInterests(interest, this, m_face);
+  m_face->onReceiveInterest(*interest);
+
+  BasicConsumer::ScheduleNextPacket();
+}
+
+template<class NameGenerator, class RtoPolicy>
+void
+BasicConsumer<NameGenerator, RtoPolicy>::WaitBeforeSendOutInterest(
+  uint32_t sequenceNumber, shared_ptr<const Interest>& interest)
+{
+  if (m_meanDeviation == nullptr) {
+    Consumer::WaitBeforeSendOutInterest(sequenceNumber, interest);
+    return;
+  }
+
+  ConsumerSeqTable::Entry& entry = RecordTransmission(sequenceNumber);
+
+  SequenceNumber32 seq(sequenceNumber);
+  Time rto = m_meanDeviation->GetRetransRtobySeq(seq);
+  if (rto.IsZero()) {
+    // first transmission
+    rto = RtoPolicy::Compute(*m_meanDeviation, interest->getName(),
+                             NameGenerator::IS_SAME_PREFIX);
+  }
+  if (m_lifeTimeRtoFactor > 0.0) {
+    time::milliseconds lifetime = GetInterestLifeTime(rto);
+    if (lifetime != interest->getInterestLifetime())
+      interest = InterestTemplate::refreshNonce(*interest, interest->getNonce(), lifetime);
+  }
+  entry.interest = interest;
+
+  entry.rto = rto;
+  m_seqTable.setDeadline(entry, Simulator::Now() + rto);
+  ScheduleRetxTimeout();
+  m_meanDeviation->RttMeanDeviation::SetInterestInfo(interest->getName(), seq, 1, rto);
+
+  m_interestSent(this, interest->getName(), sequenceNumber, rto);
+}
+
+template class BasicConsumer<SequentialNames, CorrelativityRto>;
+template class BasicConsumer<SequentialNames, TcpRto>;
+template class BasicConsumer<RandomTreeNames, CorrelativityRto>;
+template class BasicConsumer<RandomTreeNames, TcpRto>;
+template class BasicConsumer<ZipfMandelbrotNames, CorrelativityRto>;
+template class BasicConsumer<ZipfMandelbrotNames, TcpRto>;
+
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerCbrCorrelativity);
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerCbrTcp);
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerRandomCbrCorrelativity);
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerRandomCbrTcp);
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerZipfMandelbrotCorrelativity);
+NS_OBJECT_ENSURE_REGISTERED(BasicConsumerZipfMandelbrotTcp);
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_BASIC_CONSUMER_H
+#define NDN_BASIC_CONSUMER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+#include "ndn-consumer-random-cbr.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-alias-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.hpp"
+#include "ns3/ndnSIM/utils/ndn-shared-input.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Names of ConsumerCbr: the prefix with consecutive sequence numbers
+ */
+class SequentialNames {
+public:
+  static const char*
+  GetPolicyName()
+  {
+    return "Cbr";
+  }
+
+  static TypeId
+  AddAttributes(TypeId tid)
+  {
+    return tid;
+  }
+
+  /**
+   * @brief Whether every Interest has the same prefix as the previous one
+   */
+  static constexpr bool IS_SAME_PREFIX = true;
+
+  void
+  BuildNames()
+  {
+  }
+
+  int64_t
+  AssignStreams(int64_t)
+  {
+    return 0;
+  }
+
+  /**
+   * @brief Get the prefix and the sequence number of the @p count-th Interest
+   */
+  const Name&
+  Next(const Name& prefix, uint32_t count, uint32_t& seq)
+  {
+    seq = count;
+    return prefix;
+  }
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Names of ConsumerRandomCbr: a random spatial and application name with consecutive
+ *        sequence numbers, the Prefix attribute is not used
+ */
+class RandomTreeNames {
+public:
+  RandomTreeNames();
+
+  static const char*
+  GetPolicyName()
+  {
+    return "RandomCbr";
+  }
+
+  static TypeId
+  AddAttributes(TypeId tid)
+  {
+    return tid;
+  }
+
+  static constexpr bool IS_SAME_PREFIX = false;
+
+  void
+  BuildNames();
+
+  int64_t
+  AssignStreams(int64_t stream);
+
+  const Name&
+  Next(const Name&, uint32_t count, uint32_t& seq)
+  {
+    m_name = m_sNameTree.GetRandomName();
+    m_name.append(m_aNameTree.GetRandomName());
+    seq = count;
+    return m_name;
+  }
+
+private:
+  NsTree m_aNameTree;
+  NsTree m_sNameTree;
+  bool m_isNameTreeBuilt;
+  Name m_name;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Names of ConsumerZipfMandelbrot: the prefix with the sequence number of a content
+ *        drawn by popularity
+ */
+class ZipfMandelbrotNames {
+public:
+  ZipfMandelbrotNames();
+
+  static const char*
+  GetPolicyName()
+  {
+    return "ZipfMandelbrot";
+  }
+
+  static TypeId
+  AddAttributes(TypeId tid);
+
+  static constexpr bool IS_SAME_PREFIX = true;
+
+  void
+  BuildNames();
+
+  int64_t
+  AssignStreams(int64_t stream);
+
+  const Name&
+  Next(const Name& prefix, uint32_t, uint32_t& seq)
+  {
+    seq = m_table.empty() ? 1 : m_table.sample(m_seqRng->GetValue()) + 1; // [1, N]
+    return prefix;
+  }
+
+private:
+  uint32_t m_n;
+  double m_q;
+  double m_s;
+  std::shared_ptr<const SharedInput> m_sharedTable; // holds m_table if it is shared
+  AliasTable m_table;
+  Ptr<UniformRandomVariable> m_seqRng;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief RTO of the first transmission by Consumer::RTO_CORRELATIVITY
+ */
+class CorrelativityRto {
+public:
+  static const char*
+  GetPolicyName()
+  {
+    return "Correlativity";
+  }
+
+  static constexpr Consumer::RtoPolicy POLICY = Consumer::RTO_CORRELATIVITY;
+
+  static Time
+  Compute(RttMeanDeviation& rtt, const Name& name, bool isSamePrefix)
+  {
+    return isSamePrefix ? rtt.RttMeanDeviation::RetransmitTimeout()
+                        : rtt.RttMeanDeviation::CalRTObyCorrelativity(name);
+  }
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief RTO of the first transmission by Consumer::RTO_TCP
+ */
+class TcpRto {
+public:
+  static const char*
+  GetPolicyName()
+  {
+    return "Tcp";
+  }
+
+  static constexpr Consumer::RtoPolicy POLICY = Consumer::RTO_TCP;
+
+  static Time
+  Compute(RttMeanDeviation& rtt, const Name&, bool)
+  {
+    return rtt.RttMeanDeviation::RetransmitTimeout();
+  }
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Consumer sending Interests at a constant rate, with the names and the RTO fixed at
+ *        compile time
+ *
+ * ConsumerCbr, ConsumerRandomCbr and ConsumerZipfMandelbrot choose the next Interest and its
+ * RTO through virtual functions of the consumer and of the RTT estimator.  Here the names come
+ * from @p NameGenerator (SequentialNames, RandomTreeNames or ZipfMandelbrotNames) and the RTO
+ * of the first transmission from @p RtoPolicy (CorrelativityRto or TcpRto), and the RTT
+ * estimator is called without dynamic dispatch when it is a RttMeanDeviation (the default
+ * RttEstimatorType), so that sending an Interest has no virtual call left.  The RtoPolicy
+ * attribute is ignored; other estimators are called through RttEstimator.
+ *
+ * The combinations are registered as ns3::ndn::BasicConsumer followed by the policy names, e.g.,
+ * ns3::ndn::BasicConsumerZipfMandelbrotTcp, with the attributes of Consumer, Frequency,
+ * MaxSeq, and those of the name generator.  Timeouts and Nacks go through Consumer and the
+ * retransmission controller, as they are much rarer than Interests.  Unlike the apps they
+ * mirror, the gaps between Interests are not randomized, and names do not follow mobility.
+ */
+template<class NameGenerator, class RtoPolicy>
+class BasicConsumer final : public Consumer, public NameGenerator {
+public:
+  static TypeId
+  GetTypeId();
+
+  BasicConsumer();
+
+  virtual int64_t
+  AssignStreams(int64_t stream);
+
+  virtual void
+  WaitBeforeSendOutInterest(uint32_t sequenceNumber, shared_ptr<const Interest>& interest);
+
+protected:
+  virtual void
+  StartApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  SendNextPacket();
+
+private:
+  double m_frequency; ///< @brief Interests per second
+  bool m_firstTime;
+  Ptr<RttMeanDeviation> m_meanDeviation; ///< @brief m_rtt if it is exactly a RttMeanDeviation
+};
+
+typedef BasicConsumer<SequentialNames, CorrelativityRto> BasicConsumerCbrCorrelativity;
+typedef BasicConsumer<SequentialNames, TcpRto> BasicConsumerCbrTcp;
+typedef BasicConsumer<RandomTreeNames, CorrelativityRto> BasicConsumerRandomCbrCorrelativity;
+typedef BasicConsumer<RandomTreeNames, TcpRto> BasicConsumerRandomCbrTcp;
+typedef BasicConsumer<ZipfMandelbrotNames, CorrelativityRto>
+  BasicConsumerZipfMandelbrotCorrelativity;
+typedef BasicConsumer<ZipfMandelbrotNames, TcpRto> BasicConsumerZipfMandelbrotTcp;
+
+extern template class BasicConsumer<SequentialNames, CorrelativityRto>;
+extern template class BasicConsumer<SequentialNames, TcpRto>;
+extern template class BasicConsumer<RandomTreeNames, CorrelativityRto>;
+extern template class BasicConsumer<RandomTreeNames, TcpRto>;
+extern template class BasicConsumer<ZipfMandelbrotNames, CorrelativityRto>;
+extern template class BasicConsumer<ZipfMandelbrotNames, TcpRto>;
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BASIC_CONSUMER_H
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-correlated.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+
+#include "model/ndn-app-face.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerCorrelated");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerCorrelated);
+
+TypeId
+ConsumerCorrelated::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerCorrelated")
+      .SetGroupName("Ndn")
+      .SetParent<ConsumerCbr>()
+      .AddConstructor<ConsumerCorrelated>()
+
+      .AddAttribute("Hierarchy",
+                    "File of the spatial (/S/...) and application (/A/...) names, one per line "
+                    "with an optional weight; the trees of ConsumerRandomCbr if empty",
+                    StringValue(""), MakeStringAccessor(&ConsumerCorrelated::m_hierarchy),
+                    MakeStringChecker())
+
+      .AddAttribute("NumberOfContents",
+                    "Number of the contents of every spatial and application name",
+                    StringValue("100"), MakeUintegerAccessor(&ConsumerCorrelated::m_nContents),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("q", "parameter of improve rank", StringValue("0.7"),
+                    MakeDoubleAccessor(&ConsumerCorrelated::m_q), MakeDoubleChecker<double>())
+
+      .AddAttribute("s", "parameter of power", StringValue("0.7"),
+                    MakeDoubleAccessor(&ConsumerCorrelated::m_s), MakeDoubleChecker<double>())
+
+      .AddAttribute("LocalProbability",
+                    "Probability that a new request is about the region the node is in",
+                    StringValue("0.8"),
+                    MakeDoubleAccessor(&ConsumerCorrelated::m_localProbability),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("RepeatProbability",
+                    "Probability that a request repeats one of the last HistorySize ones",
+                    StringValue("0.2"),
+                    MakeDoubleAccessor(&ConsumerCorrelated::m_repeatProbability),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("HistorySize", "Number of recent requests that can be repeated",
+                    StringValue("16"), MakeUintegerAccessor(&ConsumerCorrelated::m_historySize),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("MeanOnTime", "Mean length of the bursts of Interests",
+                    StringValue("1s"), MakeTimeAccessor(&ConsumerCorrelated::m_meanOnTime),
+                    MakeTimeChecker())
+
+      .AddAttribute("MeanOffTime", "Mean length of the silences between bursts, 0 disables "
+                    "bursts", StringValue("0s"),
+                    MakeTimeAccessor(&ConsumerCorrelated::m_meanOffTime), MakeTimeChecker());
+
+  return tid;
+}
+
+ConsumerCorrelated::ConsumerCorrelated()
+  : m_nContents(100)
+  , m_q(0.7)
+  , m_s(0.7)
+  , m_localProbability(0.8)
+  , m_repeatProbability(0.2)
+  , m_historySize(16)
+  , aNameTree("A")
+  , sNameTree("S")
+  , m_isWorkloadBuilt(false)
+  , m_burstRng(CreateObject<ExponentialRandomVariable>())
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+int64_t
+ConsumerCorrelated::AssignStreams(int64_t stream)
+{
+  int64_t nStreams = Consumer::AssignStreams(stream);
+  if (m_random != 0) {
+    m_random->SetStream(stream + nStreams);
+    ++nStreams;
+  }
+  m_burstRng->SetStream(stream + nStreams);
+  ++nStreams;
+  nStreams += m_workload.AssignStreams(stream + nStreams);
+  nStreams += sNameTree.AssignStreams(stream + nStreams);
+  nStreams += aNameTree.AssignStreams(stream + nStreams);
+  return nStreams;
+}
+
+void
+ConsumerCorrelated::BuildWorkload()
+{
+  if (!m_hierarchy.empty()) {
+    try {
+      m_workload.Load(m_hierarchy);
+    }
+    catch (const std::runtime_error& e) {
+      NS_FATAL_ERROR("ConsumerCorrelated cannot load " << m_hierarchy << ": " << e.what());
+    }
+  }
+  else {
+    // same trees as ConsumerRandomCbr, with their probabilities as weights
+    aNameTree.InitBuild(3, 3);
+    sNameTree.BuildScene("scene1");
+    double probability;
+    for (size_t i = 0; i < sNameTree.GetNameNum(); ++i) {
+      const Name& name = sNameTree.GetNameByIndex(i, probability);
+      m_workload.AddSpatialName(name, probability);
+    }
+    for (size_t i = 0; i < aNameTree.GetNameNum(); ++i) {
+      const Name& name = aNameTree.GetNameByIndex(i, probability);
+      m_workload.AddAppName(name, probability);
+    }
+  }
+
+  m_mobility = GetNode()->GetObject<MobilityModel>();
+  if (m_mobility != 0) {
+    for (size_t i = 0; i < m_workload.GetNSpatialNames(); ++i)
+      m_prefetcher.AddSpatialName(m_workload.GetSpatialName(i));
+  }
+  m_isWorkloadBuilt = true;
+}
+
+void
+ConsumerCorrelated::StartApplication()
+{
+  // built here rather than in the constructor, so that the attributes and the streams
+  // assigned after the app is created are used
+  if (!m_isWorkloadBuilt)
+    BuildWorkload();
+  m_workload.SetPopularity(m_nContents, m_q, m_s);
+  m_workload.SetLocalProbability(m_localProbability);
+  m_workload.SetRepeatProbability(m_repeatProbability, m_historySize);
+  if (!IsFollowingMobility())
+    NS_LOG_DEBUG("Node " << GetNode()->GetId() << " has no region, requests are not local");
+
+  if (!m_meanOffTime.IsZero())
+    m_burstEnd = Simulator::Now() + Seconds(m_burstRng->GetValue(m_meanOnTime.GetSeconds(), 0));
+
+  Consumer::StartApplication();
+}
+
+bool
+ConsumerCorrelated::IsFollowingMobility() const
+{
+  return m_mobility != 0 && m_prefetcher.GetNSpatialNames() > 0;
+}
+
+void
+ConsumerCorrelated::ScheduleNextPacket()
+{
+  Time gap;
+  if (m_firstTime) {
+    m_firstTime = false;
+  }
+  else if (!m_sendEvent.IsRunning()) {
+    gap = (m_random == 0) ? Seconds(1.0 / m_frequency) : Seconds(m_random->GetValue());
+  }
+  else {
+    return;
+  }
+
+  if (!m_meanOffTime.IsZero() && Simulator::Now() + gap >= m_burstEnd) {
+    // the rest of the gap after the silence
+    gap += Seconds(m_burstRng->GetValue(m_meanOffTime.GetSeconds(), 0));
+    m_burstEnd = Simulator::Now() + gap +
+                 Seconds(m_burstRng->GetValue(m_meanOnTime.GetSeconds(), 0));
+  }
+
+  m_sendEvent = Simulator::Schedule(gap, &ConsumerCorrelated::SendRequest, this);
+}
+
+void
+ConsumerCorrelated::SendRequest()
+{
+  if (!m_active)
+    return;
+
+  if (m_seqMax != std::numeric_limits<uint32_t>::max() && m_seq >= m_seqMax)
+    return; // we are totally done
+  ++m_seq;
+
+  const Name* region = IsFollowingMobility() ? m_prefetcher.Predict(m_mobility, Seconds(0))
+                                             : nullptr;
+  Name prefix;
+  uint32_t seq = m_workload.Next(region, prefix);
+  m_isSameWithLastInterest = prefix == m_interestName;
+  m_interestName = prefix;
+
+  // a content requested again while its Interest is pending is sent with the same Interest
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  shared_ptr<const Interest> interest;
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry == nullptr || entry->interest == nullptr) {
+    time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+    interest = GetInterestTemplate(m_interestName, interestLifeTime).makeInterest(seq, nonce);
+  }
+  else {
+    interest = InterestTemplate::refreshNonce(*entry->interest, nonce);
+  }
+
+  NS_LOG_INFO("> Interest for " << interest->getName() << ", Total: " << m_seq);
+  WaitBeforeSendOutInterest(seq, interest);
+
+  m_transmittedInterests(interest, this, m_face);
+  m_face->onReceiveInterest(*interest);
+
+  ScheduleNextPacket();
+}
+
+} // namespace ndn
+} // namespace ns3
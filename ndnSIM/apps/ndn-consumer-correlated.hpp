@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_CORRELATED_H
+#define NDN_CONSUMER_CORRELATED_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer-cbr.hpp"
+#include "ndn-consumer-random-cbr.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-correlated-workload.hpp"
+#include "ns3/ndnSIM/utils/ndn-mobility-prefetcher.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Ndn application requesting names with the popularity, spatial and temporal locality
+ *        of vehicular requests, for cache and RTO experiments
+ *
+ * The names are drawn by CorrelatedWorkload from the names of the Hierarchy file, or, if
+ * none is set, from the trees of ConsumerRandomCbr.  The region the node is in is found with
+ * MobilityPrefetcher when the node has a MobilityModel and the spatial names have regions in
+ * GeoRegionTable.  The sequence number of an Interest is the id of its content, so the
+ * Prefix attribute is not used and MaxSeq limits the number of requests.
+ *
+ * Interests are sent at Frequency (see ConsumerCbr).  With MeanOffTime, they are sent in
+ * bursts of exponential length MeanOnTime separated by silences of exponential length
+ * MeanOffTime.
+ */
+class ConsumerCorrelated : public ConsumerCbr {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerCorrelated();
+
+  virtual int64_t
+  AssignStreams(int64_t stream);
+
+protected:
+  virtual void
+  StartApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  BuildWorkload();
+
+  bool
+  IsFollowingMobility() const;
+
+  /**
+   * @brief Draws the next request and sends its Interest
+   */
+  void
+  SendRequest();
+
+private:
+  std::string m_hierarchy;
+  uint32_t m_nContents;
+  double m_q;
+  double m_s;
+  double m_localProbability;
+  double m_repeatProbability;
+  uint32_t m_historySize;
+  Time m_meanOnTime;
+  Time m_meanOffTime;
+
+  NsTree aNameTree;
+  NsTree sNameTree;
+  bool m_isWorkloadBuilt;
+  CorrelatedWorkload m_workload;
+
+  MobilityPrefetcher m_prefetcher;
+  Ptr<MobilityModel> m_mobility;
+
+  Ptr<ExponentialRandomVariable> m_burstRng;
+  Time m_burstEnd; ///< end of the current burst
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_CORRELATED_H
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-pipeline.hpp"
+#include "ns3/ptr.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/integer.h"
+#include "ns3/double.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerPipeline");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerPipeline);
+
+TypeId
+ConsumerPipeline::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerPipeline")
+      .SetGroupName("Ndn")
+      .SetParent<Consumer>()
+      .AddConstructor<ConsumerPipeline>()
+
+      .AddAttribute("MaxSeq", "Maximum sequence number to request (number of segments)",
+                    IntegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeIntegerAccessor(&ConsumerPipeline::m_seqMax),
+                    MakeIntegerChecker<uint32_t>())
+
+      .AddAttribute("InitialWindow", "Initial congestion window (Interests)", DoubleValue(2.0),
+                    MakeDoubleAccessor(&ConsumerPipeline::m_initialWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("MaxWindow", "Maximum congestion window (Interests)", DoubleValue(64.0),
+                    MakeDoubleAccessor(&ConsumerPipeline::m_maxWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+      .AddAttribute("Beta", "Multiplicative decrease factor of the window on a timeout",
+                    DoubleValue(0.5), MakeDoubleAccessor(&ConsumerPipeline::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddAttribute("SpuriousRatio",
+                    "Data answering a retransmitted Interest sooner than this fraction of the "
+                    "smallest RTT answers the timed out transmission, so the timeout was spurious",
+                    DoubleValue(0.5), MakeDoubleAccessor(&ConsumerPipeline::m_spuriousRatio),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+      .AddTraceSource("CongestionWindow", "Number of Interests allowed to be outstanding",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_cwnd),
+                      "ns3::ndn::ConsumerPipeline::CongestionWindowTraceCallback")
+      .AddTraceSource("InFlight", "Current number of outstanding Interests",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_inFlight),
+                      "ns3::ndn::ConsumerPipeline::InFlightTraceCallback")
+      .AddTraceSource("SpuriousTimeout",
+                      "Timeout that was detected as spurious, its window decrease is undone",
+                      MakeTraceSourceAccessor(&ConsumerPipeline::m_spuriousTimeout),
+                      "ns3::ndn::ConsumerPipeline::SpuriousTimeoutCallback");
+
+  return tid;
+}
+
+ConsumerPipeline::ConsumerPipeline()
+  : m_initialWindow(2.0)
+  , m_maxWindow(64.0)
+  , m_beta(0.5)
+  , m_spuriousRatio(0.5)
+  , m_cwnd(2.0)
+  , m_ssthresh(64.0)
+  , m_inFlight(0)
+  , m_recoveryPoint(0)
+  , m_isInRecovery(false)
+  , m_canUndo(false)
+  , m_undoSeq(0)
+  , m_undoCwnd(0.0)
+  , m_undoSsthresh(0.0)
+{
+  m_seqMax = std::numeric_limits<uint32_t>::max();
+}
+
+void
+ConsumerPipeline::StartApplication()
+{
+  m_cwnd = std::min(m_initialWindow, m_maxWindow);
+  m_ssthresh = m_maxWindow;
+  m_minRtt = Time();
+  m_isInRecovery = false;
+  m_canUndo = false;
+
+  Consumer::StartApplication();
+}
+
+void
+ConsumerPipeline::ScheduleNextPacket()
+{
+  // segments carry correlated names, RTO of every first transmission is by correlativity
+  m_isSameWithLastInterest = false;
+
+  m_inFlight = m_seqTable.size();
+  if (m_inFlight >= static_cast<uint32_t>(m_cwnd) || m_sendEvent.IsRunning())
+    return;
+
+  // SendPacket calls back here, so the window is filled one Interest after another
+  m_sendEvent = Simulator::ScheduleNow(&Consumer::SendPacket, this);
+}
+
+void
+ConsumerPipeline::IncreaseWindow()
+{
+  if (m_cwnd < m_ssthresh)
+    m_cwnd = m_cwnd + 1.0; // slow start
+  else
+    m_cwnd = m_cwnd + 1.0 / m_cwnd;
+
+  m_cwnd = std::min<double>(m_cwnd, m_maxWindow);
+}
+
+void
+ConsumerPipeline::DecreaseWindow(uint32_t sequenceNumber)
+{
+  m_canUndo = true;
+  m_undoSeq = sequenceNumber;
+  m_undoCwnd = m_cwnd;
+  m_undoSsthresh = m_ssthresh;
+
+  m_ssthresh = std::max(2.0, m_cwnd * m_beta);
+  m_cwnd = std::min(m_ssthresh, m_maxWindow);
+
+  // Interests already sent belong to the same loss event
+  m_isInRecovery = true;
+  m_recoveryPoint = m_seq;
+}
+
+///////////////////////////////////////////////////
+//          Process incoming packets             //
+///////////////////////////////////////////////////
+
+void
+ConsumerPipeline::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  uint32_t seq = data->getName().at(-1).toSequenceNumber();
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry != nullptr) {
+    Time rtt = Simulator::Now() - entry->lastSendTime;
+
+    if (entry->retxCount == 1) {
+      if (m_minRtt.IsZero() || rtt < m_minRtt)
+        m_minRtt = rtt;
+    }
+    else if (m_canUndo && seq == m_undoSeq) {
+      m_canUndo = false;
+      if (!m_minRtt.IsZero()
+          && rtt.ToDouble(Time::S) < m_minRtt.ToDouble(Time::S) * m_spuriousRatio) {
+        NS_LOG_DEBUG("Spurious timeout of " << seq << ", window " << m_cwnd << " -> "
+                                            << m_undoCwnd);
+        m_cwnd = m_undoCwnd;
+        m_ssthresh = m_undoSsthresh;
+        m_isInRecovery = false;
+        m_spuriousTimeout(this, seq);
+      }
+    }
+
+    if (m_isInRecovery && seq >= m_recoveryPoint)
+      m_isInRecovery = false;
+
+    IncreaseWindow();
+  }
+
+  Consumer::OnData(data);
+
+  NS_LOG_DEBUG("Window: " << m_cwnd << ", InFlight: " << m_seqTable.size());
+  ScheduleNextPacket();
+}
+
+void
+ConsumerPipeline::OnTimeout(uint32_t sequenceNumber)
+{
+  if (!m_isInRecovery || sequenceNumber >= m_recoveryPoint) {
+    DecreaseWindow(sequenceNumber);
+    NS_LOG_DEBUG("Timeout of " << sequenceNumber << ", window: " << m_cwnd);
+  }
+
+  Consumer::OnTimeout(sequenceNumber);
+
+  // the Interest may have been given up
+  ScheduleNextPacket();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_PIPELINE_H
+#define NDN_CONSUMER_PIPELINE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * \brief Ndn application fetching segments /<prefix>/<seq> through a congestion window
+ *
+ * Up to the congestion window of Interests are outstanding at a time.  The window grows by one
+ * Interest per Data in slow start and by one Interest per window above the slow start
+ * threshold.  Deadlines of the Interests come from RTO by correlativity (RtoPolicy
+ * Correlativity), as the segments of a content object carry correlated names.
+ *
+ * A timeout shrinks the window (once per window of Interests), unless it turns out to be
+ * spurious: when Data answering a retransmitted Interest comes back sooner than SpuriousRatio
+ * of the smallest RTT seen, it answers the timed out transmission, and the window and slow
+ * start threshold are restored to their values before the timeout.
+ */
+class ConsumerPipeline : public Consumer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerPipeline();
+
+  // From App
+  virtual void
+  OnData(shared_ptr<const Data> contentObject);
+
+  virtual void
+  OnTimeout(uint32_t sequenceNumber);
+
+  double
+  GetCongestionWindow() const
+  {
+    return m_cwnd;
+  }
+
+  double
+  GetSlowStartThreshold() const
+  {
+    return m_ssthresh;
+  }
+
+public:
+  typedef void (*CongestionWindowTraceCallback)(double oldValue, double newValue);
+  typedef void (*InFlightTraceCallback)(uint32_t oldValue, uint32_t newValue);
+  typedef void (*SpuriousTimeoutCallback)(Ptr<App> app, uint32_t seqno);
+
+protected:
+  // from App
+  virtual void
+  StartApplication();
+
+  /**
+   * \brief Sends Interests while the window allows
+   */
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  IncreaseWindow();
+
+  void
+  DecreaseWindow(uint32_t sequenceNumber);
+
+private:
+  double m_initialWindow;
+  double m_maxWindow;
+  double m_beta;          // multiplicative decrease factor
+  double m_spuriousRatio; // retransmission RTT below this fraction of the min RTT is spurious
+
+  TracedValue<double> m_cwnd;
+  double m_ssthresh;
+  TracedValue<uint32_t> m_inFlight;
+  Time m_minRtt;
+
+  uint32_t m_recoveryPoint; // timeouts below this sequence number do not shrink the window again
+  bool m_isInRecovery;
+
+  // state before the last window decrease, restored if its timeout is spurious
+  bool m_canUndo;
+  uint32_t m_undoSeq;
+  double m_undoCwnd;
+  double m_undoSsthresh;
+
+  TracedCallback<Ptr<App>, uint32_t> m_spuriousTimeout;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif
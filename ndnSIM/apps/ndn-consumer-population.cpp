@@ -0,0 +1,387 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-population.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+
+#include "model/ndn-app-face.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerPopulation");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerPopulation);
+
+static const Time INITIAL_RTO = Seconds(1);
+static const Time MIN_RTO = MilliSeconds(200);
+static const Time MAX_RTO = Seconds(60);
+static const uint8_t MAX_BACKOFF = 6;
+
+TypeId
+ConsumerPopulation::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerPopulation")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<ConsumerPopulation>()
+
+      .AddAttribute("Prefix", "Name prefix of the Interests of all consumers", StringValue("/"),
+                    MakeNameAccessor(&ConsumerPopulation::m_prefix), MakeNameChecker())
+      .AddAttribute("NConsumers", "Number of logical consumers", UintegerValue(1),
+                    MakeUintegerAccessor(&ConsumerPopulation::m_nConsumers),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("Frequency", "Frequency of Interests of every consumer (in hertz)",
+                    StringValue("1.0"), MakeDoubleAccessor(&ConsumerPopulation::m_frequency),
+                    MakeDoubleChecker<double>())
+      .AddAttribute("Randomize",
+                    "Intervals between Interests of a consumer: none (default, consumers are "
+                    "evenly staggered) or exponential",
+                    StringValue("none"),
+                    MakeStringAccessor(&ConsumerPopulation::SetRandomize,
+                                       &ConsumerPopulation::GetRandomize),
+                    MakeStringChecker())
+      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+                    MakeTimeAccessor(&ConsumerPopulation::m_interestLifetime),
+                    MakeTimeChecker())
+      .AddAttribute("MaxTransmissions", "Transmissions of an Interest before it is given up",
+                    UintegerValue(3),
+                    MakeUintegerAccessor(&ConsumerPopulation::m_maxTransmissions),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("MaxSeq", "Maximum sequence number requested by every consumer",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeUintegerAccessor(&ConsumerPopulation::m_seqMax),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("FirstInterestDataDelay",
+                      "Consumer, sequence number, delay since the first transmission and number "
+                      "of transmissions of every satisfied Interest",
+                      MakeTraceSourceAccessor(&ConsumerPopulation::m_firstInterestDataDelay),
+                      "ns3::ndn::ConsumerPopulation::FirstInterestDataDelayCallback")
+      .AddTraceSource("InterestGivenUp",
+                      "Consumer and sequence number of every Interest given up",
+                      MakeTraceSourceAccessor(&ConsumerPopulation::m_interestGivenUp),
+                      "ns3::ndn::ConsumerPopulation::InterestGivenUpCallback");
+
+  return tid;
+}
+
+ConsumerPopulation::ConsumerPopulation()
+  : m_nConsumers(1)
+  , m_frequency(1.0)
+  , m_isExponential(false)
+  , m_maxTransmissions(3)
+  , m_seqMax(std::numeric_limits<uint32_t>::max())
+  , m_rand(CreateObject<UniformRandomVariable>())
+  , m_expRand(CreateObject<ExponentialRandomVariable>())
+  , m_nSent(0)
+  , m_nReceived(0)
+  , m_nGivenUp(0)
+{
+}
+
+void
+ConsumerPopulation::SetRandomize(const std::string& value)
+{
+  if (value == "exponential")
+    m_isExponential = true;
+  else if (value == "none")
+    m_isExponential = false;
+  else
+    NS_FATAL_ERROR("Randomize should be either none or exponential");
+}
+
+std::string
+ConsumerPopulation::GetRandomize() const
+{
+  return m_isExponential ? "exponential" : "none";
+}
+
+int64_t
+ConsumerPopulation::AssignStreams(int64_t stream)
+{
+  m_rand->SetStream(stream);
+  m_expRand->SetStream(stream + 1);
+  return 2;
+}
+
+Time
+ConsumerPopulation::GetRto(uint32_t consumer) const
+{
+  NS_ASSERT(consumer < m_srtts.size());
+  Time rto = INITIAL_RTO;
+  if (m_srtts[consumer] >= 0)
+    rto = std::max(MIN_RTO, Seconds(m_srtts[consumer] + 4 * m_rttvars[consumer]));
+  return std::min(MAX_RTO, Seconds(rto.GetSeconds() * (1 << m_backoffs[consumer])));
+}
+
+void
+ConsumerPopulation::UpdateRtt(uint32_t consumer, Time rtt)
+{
+  float sample = rtt.GetSeconds();
+  float& srtt = m_srtts[consumer];
+  float& rttvar = m_rttvars[consumer];
+  if (srtt < 0) {
+    srtt = sample;
+    rttvar = sample / 2;
+  }
+  else {
+    rttvar = 0.75f * rttvar + 0.25f * std::abs(srtt - sample);
+    srtt = 0.875f * srtt + 0.125f * sample;
+  }
+}
+
+size_t
+ConsumerPopulation::GetMemoryUsage() const
+{
+  size_t n = m_seqs.capacity() * sizeof(uint32_t) + m_srtts.capacity() * sizeof(float) +
+             m_rttvars.capacity() * sizeof(float) + m_backoffs.capacity() * sizeof(uint8_t);
+  // unordered_map node with the next link and the cached hash, plus the bucket
+  n += m_pending.size() * (sizeof(decltype(m_pending)::value_type) + 3 * sizeof(void*));
+  n += (m_sends.size() + m_timeouts.size()) * sizeof(QueueEntry);
+  return n;
+}
+
+void
+ConsumerPopulation::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  m_template.reset(new InterestTemplate(m_prefix,
+                                        time::milliseconds(m_interestLifetime.GetMilliSeconds())));
+  m_seqs.assign(m_nConsumers, 0);
+  m_srtts.assign(m_nConsumers, -1);
+  m_rttvars.assign(m_nConsumers, 0);
+  m_backoffs.assign(m_nConsumers, 0);
+  m_expRand->SetAttribute("Mean", DoubleValue(1.0 / m_frequency));
+  m_expRand->SetAttribute("Bound", DoubleValue(50.0 / m_frequency));
+
+  // first Interests are spread over one interval
+  Time now = Simulator::Now();
+  std::vector<QueueEntry> sends;
+  sends.reserve(m_nConsumers);
+  for (uint32_t consumer = 0; consumer < m_nConsumers; ++consumer) {
+    double offset = m_isExponential ? m_rand->GetValue(0, 1.0 / m_frequency)
+                                    : consumer / (m_nConsumers * m_frequency);
+    sends.push_back({now + Seconds(offset), consumer});
+  }
+  m_sends = Queue(std::greater<QueueEntry>(), std::move(sends));
+
+  ScheduleWakeUp();
+}
+
+void
+ConsumerPopulation::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel(m_wakeUpEvent);
+  m_sends = Queue();
+  m_timeouts = Queue();
+  m_pending.clear();
+
+  App::StopApplication();
+}
+
+Time
+ConsumerPopulation::GetInterval()
+{
+  if (m_isExponential)
+    return Seconds(m_expRand->GetValue());
+  return Seconds(1.0 / m_frequency);
+}
+
+void
+ConsumerPopulation::ScheduleWakeUp()
+{
+  Time next = Time::Max();
+  if (!m_sends.empty())
+    next = m_sends.top().first;
+  if (!m_timeouts.empty())
+    next = std::min(next, m_timeouts.top().first);
+
+  if (next == Time::Max()) {
+    Simulator::Cancel(m_wakeUpEvent);
+    return;
+  }
+
+  if (m_wakeUpEvent.IsRunning()) {
+    if (m_wakeUpTime <= next)
+      return;
+    Simulator::Cancel(m_wakeUpEvent);
+  }
+  m_wakeUpTime = next;
+  m_wakeUpEvent = Simulator::Schedule(std::max(next - Simulator::Now(), Time(0)),
+                                      &ConsumerPopulation::ProcessDue, this);
+}
+
+void
+ConsumerPopulation::ProcessDue()
+{
+  if (!m_active)
+    return;
+
+  Time now = Simulator::Now();
+  while (!m_sends.empty() && m_sends.top().first <= now) {
+    uint32_t consumer = m_sends.top().second;
+    m_sends.pop();
+    Send(consumer);
+  }
+
+  while (!m_timeouts.empty() && m_timeouts.top().first <= now) {
+    QueueEntry timeout = m_timeouts.top();
+    m_timeouts.pop();
+
+    auto pending = m_pending.find(timeout.second);
+    if (pending == m_pending.end() || pending->second.deadline != timeout.first)
+      continue; // answered or sent again
+
+    uint32_t consumer = timeout.second % m_nConsumers;
+    m_backoffs[consumer] = std::min<uint8_t>(m_backoffs[consumer] + 1, MAX_BACKOFF);
+    Retransmit(timeout.second);
+  }
+
+  ScheduleWakeUp();
+}
+
+void
+ConsumerPopulation::Send(uint32_t consumer)
+{
+  uint32_t seq = m_seqs[consumer];
+  if (seq >= m_seqMax ||
+      seq > (std::numeric_limits<uint32_t>::max() - consumer) / m_nConsumers) {
+    return; // the consumer is done
+  }
+  ++m_seqs[consumer];
+
+  uint32_t name = seq * m_nConsumers + consumer;
+  Time now = Simulator::Now();
+  Pending& pending = m_pending[name];
+  pending.firstSendTime = now;
+  pending.lastSendTime = now;
+  pending.deadline = now + GetRto(consumer);
+  pending.nTransmissions = 1;
+  m_timeouts.push({pending.deadline, name});
+  Transmit(name);
+
+  m_sends.push({now + GetInterval(), consumer});
+}
+
+void
+ConsumerPopulation::Retransmit(uint32_t name)
+{
+  auto i = m_pending.find(name);
+  NS_ASSERT(i != m_pending.end());
+  Pending& pending = i->second;
+  uint32_t consumer = name % m_nConsumers;
+
+  if (pending.nTransmissions >= m_maxTransmissions) {
+    NS_LOG_DEBUG("Consumer " << consumer << " gives up " << name / m_nConsumers);
+    m_interestGivenUp(this, consumer, name / m_nConsumers);
+    m_pending.erase(i);
+    ++m_nGivenUp;
+    return;
+  }
+
+  ++pending.nTransmissions;
+  pending.lastSendTime = Simulator::Now();
+  pending.deadline = pending.lastSendTime + GetRto(consumer);
+  m_timeouts.push({pending.deadline, name});
+  Transmit(name);
+}
+
+void
+ConsumerPopulation::Transmit(uint32_t name)
+{
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  shared_ptr<Interest> interest = m_template->makeInterest(name, nonce);
+  NS_LOG_INFO("> Interest for " << name);
+
+  ++m_nSent;
+  m_transmittedInterests(interest, this, m_face);
+  m_face->onReceiveInterest(*interest);
+}
+
+void
+ConsumerPopulation::OnData(shared_ptr<const Data> data)
+{
+  if (!m_active)
+    return;
+
+  App::OnData(data); // tracing inside
+
+  const Name& dataName = data->getName();
+  if (dataName.empty() || !dataName.at(-1).isSequenceNumber())
+    return;
+
+  uint32_t name = dataName.at(-1).toSequenceNumber();
+  auto pending = m_pending.find(name);
+  if (pending == m_pending.end())
+    return;
+
+  uint32_t consumer = name % m_nConsumers;
+  Time now = Simulator::Now();
+  // Karn's rule: the Data may answer any of several transmissions
+  if (pending->second.nTransmissions == 1)
+    UpdateRtt(consumer, now - pending->second.lastSendTime);
+  m_backoffs[consumer] = 0;
+
+  NS_LOG_INFO("< DATA for " << name);
+  m_firstInterestDataDelay(this, consumer, name / m_nConsumers,
+                           now - pending->second.firstSendTime, pending->second.nTransmissions);
+  m_pending.erase(pending);
+  ++m_nReceived;
+}
+
+void
+ConsumerPopulation::OnNack(shared_ptr<const lp::Nack> nack)
+{
+  if (!m_active)
+    return;
+
+  App::OnNack(nack); // tracing inside
+
+  const Name& interestName = nack->getInterest().getName();
+  if (interestName.empty() || !interestName.at(-1).isSequenceNumber())
+    return;
+
+  uint32_t name = interestName.at(-1).toSequenceNumber();
+  if (m_pending.count(name) == 0)
+    return;
+
+  // congestion: the timeout retransmits later, with backoff
+  if (nack->getReason() == lp::NackReason::CONGESTION)
+    return;
+
+  Retransmit(name);
+  ScheduleWakeUp();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_POPULATION_H
+#define NDN_CONSUMER_POPULATION_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-interest-template.hpp"
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Many logical consumers, each requesting Interests at a constant rate, in one app
+ *
+ * Instead of one ConsumerCbr per request stream, with its own AppFace, events, RTT estimator
+ * and tables, the population keeps the state of its NConsumers logical consumers in flat
+ * arrays, sends through one AppFace and has a single pending simulator event, at the earliest
+ * of the next send and the next retransmission timeout.  All sends and timeouts due at that
+ * time are processed at once.
+ *
+ * Consumer i requests /<Prefix>/<seq * NConsumers + i>, seq being its own sequence number,
+ * so names of different consumers never collide and Data are matched to the consumer by the
+ * last name component only.  Every consumer has its own RTO (as in TCP: smoothed RTT plus four
+ * times the RTT variation, with Karn's rule and exponential backoff), and an Interest is
+ * transmitted at most MaxTransmissions times.
+ */
+class ConsumerPopulation : public App {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerPopulation();
+
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+  virtual void
+  OnNack(shared_ptr<const lp::Nack> nack);
+
+  /**
+   * \brief Assign a fixed random variable stream number to the random variables used by the app
+   * \param stream first stream index to use
+   * \return number of stream indices used
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+  uint32_t
+  GetNConsumers() const
+  {
+    return m_nConsumers;
+  }
+
+  /**
+   * \brief Current RTO of the logical consumer
+   */
+  Time
+  GetRto(uint32_t consumer) const;
+
+  /**
+   * \brief Number of Interests sent, including retransmissions
+   */
+  uint64_t
+  GetNSent() const
+  {
+    return m_nSent;
+  }
+
+  uint64_t
+  GetNReceived() const
+  {
+    return m_nReceived;
+  }
+
+  /**
+   * \brief Number of Interests given up after MaxTransmissions
+   */
+  uint64_t
+  GetNGivenUp() const
+  {
+    return m_nGivenUp;
+  }
+
+  /**
+   * \brief Get approximate number of bytes used by the state of the logical consumers
+   */
+  size_t
+  GetMemoryUsage() const;
+
+public:
+  typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t consumer, uint32_t seq,
+                                                 Time delay, uint32_t retxCount);
+  typedef void (*InterestGivenUpCallback)(Ptr<App> app, uint32_t consumer, uint32_t seq);
+
+protected:
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+private:
+  void
+  SetRandomize(const std::string& value);
+
+  std::string
+  GetRandomize() const;
+
+  /**
+   * \brief Sends all Interests and handles all timeouts that are due, then schedules the next
+   *        wake-up
+   */
+  void
+  ProcessDue();
+
+  void
+  ScheduleWakeUp();
+
+  /**
+   * \brief Time until the next Interest of the consumer
+   */
+  Time
+  GetInterval();
+
+  void
+  Send(uint32_t consumer);
+
+  void
+  Transmit(uint32_t name);
+
+  void
+  Retransmit(uint32_t name);
+
+  void
+  UpdateRtt(uint32_t consumer, Time rtt);
+
+private:
+  Name m_prefix;
+  uint32_t m_nConsumers;
+  double m_frequency;
+  bool m_isExponential;
+  Time m_interestLifetime;
+  uint32_t m_maxTransmissions;
+  uint32_t m_seqMax;
+
+  Ptr<UniformRandomVariable> m_rand;
+  Ptr<ExponentialRandomVariable> m_expRand;
+  std::unique_ptr<InterestTemplate> m_template;
+
+  // per logical consumer, indexed by consumer
+  std::vector<uint32_t> m_seqs;    ///< next sequence number
+  std::vector<float> m_srtts;      ///< seconds, negative before the first sample
+  std::vector<float> m_rttvars;    ///< seconds
+  std::vector<uint8_t> m_backoffs; ///< exponent of the RTO multiplier
+
+  struct Pending {
+    Time firstSendTime;
+    Time lastSendTime;
+    Time deadline;
+    uint32_t nTransmissions;
+  };
+  std::unordered_map<uint32_t, Pending> m_pending; ///< by last name component
+
+  typedef std::pair<Time, uint32_t> QueueEntry;
+  typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>
+    Queue;
+  Queue m_sends;    ///< next send time and consumer
+  Queue m_timeouts; ///< deadline and name, stale if the Interest was answered or sent again
+
+  EventId m_wakeUpEvent;
+  Time m_wakeUpTime;
+
+  uint64_t m_nSent;
+  uint64_t m_nReceived;
+  uint64_t m_nGivenUp;
+
+  TracedCallback<Ptr<App>, uint32_t, uint32_t, Time, uint32_t> m_firstInterestDataDelay;
+  TracedCallback<Ptr<App>, uint32_t, uint32_t> m_interestGivenUp;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_POPULATION_H
@@ -28,9 +28,6 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
-#include<time.h>
-#include <stdlib.h>
-#include<cstdlib>
 #include "model/ndn-app-face.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerRandomCbr");
@@ -42,6 +39,8 @@ namespace ndn {
 //by Siyan Yao
 NsNode::NsNode(string str)
   : m_element(str)
+  , is_active(true)
+  , m_weight(1.0)
 {
 	//m_element = str;
 	NS_LOG_FUNCTION(this);
@@ -50,15 +49,15 @@ NsNode::NsNode(string str)
 NsNode::NsNode(string str, bool active)
    : m_element(str)
    , is_active(active)
+   , m_weight(1.0)
 {
 	NS_LOG_FUNCTION(this);
 }
 
 NsNode::~NsNode()
 {
-	for(list<NsNode*>::iterator it=p_childs.begin();it!=p_childs.end();it++)
+	for(vector<NsNode*>::iterator it=p_childs.begin();it!=p_childs.end();it++)
 	{
-		cout<<"delete node"<<*it;
 		delete *it;
 	}
 }
@@ -82,24 +81,19 @@ string NsNode::GetString(void)
 
 NsNode * NsNode::GetChildByIndex(unsigned short num)
 {
-	list<NsNode*>::iterator child=p_childs.begin();
-	for (int i = 0; i < num; i++)
-	{
-		if (child != p_childs.end())
-			++child;
-	}
-	return *child;
+	return p_childs[num];
 }
 
-NsNode * NsNode::GetActiveChlidByRandom(void)
+NsNode * NsNode::GetActiveChlidByRandom(Ptr<UniformRandomVariable> rand)
 {
 	list<NsNode*> tmpList;
 	list<NsNode*>::iterator i;
+	vector<NsNode*>::iterator child;
 	int index, x;
-	for(i=p_childs.begin(); i!=p_childs.end();i++)
+	for(child=p_childs.begin(); child!=p_childs.end();child++)
 	{
-		if((*i)->is_active)
-			tmpList.push_back(*i);
+		if((*child)->is_active)
+			tmpList.push_back(*child);
 	}
 	//Random Number
 	if(tmpList.size() == 0)
@@ -113,7 +107,7 @@ NsNode * NsNode::GetActiveChlidByRandom(void)
 	else
 	{
 
-		index = rand() % tmpList.size();
+		index = rand->GetInteger(0, tmpList.size() - 1);
 		for(x=0, i=tmpList.begin(); i!=tmpList.end();i++,x++)
 		{
 			if(x== index)
@@ -147,10 +141,23 @@ bool NsNode::GetStatus(void)
 {
 	return is_active;
 }
+
+void NsNode::SetWeight(double weight)
+{
+	NS_ASSERT_MSG(weight > 0, "Weight of a name tree node must be positive");
+	m_weight = weight;
+}
+
+double NsNode::GetWeight(void)
+{
+	return m_weight;
+}
 //=============================================================
 //Tree
 //by Siyan Yao
 NsTree::NsTree(string r)
+  : root(NULL)
+  , levels(0)
 {
 	//this->root = new NsNode(r);
 	if(r =="A")
@@ -163,17 +170,20 @@ NsTree::NsTree(string r)
 		//root->m_element = "addr";
 		this->root = new NsNode("addr", true);
 	}
-	//Init rand
-	unsigned int seed = (unsigned int) std::time(NULL);
-	srand(seed);
+	m_rand = CreateObject<UniformRandomVariable>();
 }
 
 NsTree::~NsTree()
 {
-	cout<<"delete root";
 	delete root;
 }
 
+int64_t NsTree::AssignStreams(int64_t stream)
+{
+	m_rand->SetStream(stream);
+	return 1;
+}
+
 void NsTree::InitBuild(unsigned short levels, unsigned short maxChilds)
 {
 	this->levels = levels;
@@ -185,7 +195,7 @@ void NsTree::Build(NsNode * r, unsigned short levels, unsigned short maxChilds)
 	int childNum;
 	if (levels == 0)
 		return;
-	childNum = rand() % maxChilds+1;
+	childNum = m_rand->GetInteger(1, maxChilds);
 	r->CreateChilds(childNum);
 	for (int i = 0; i < r->GetChildNum(); i++)
 	{
@@ -229,7 +239,7 @@ string NsTree::GetName(NsNode * node, unsigned int levels)
 				tmpName += GetName(node->GetChildByIndex(i), levels - 1);
 			}
 			*/
-			tmpNode = node->GetActiveChlidByRandom();
+			tmpNode = node->GetActiveChlidByRandom(m_rand);
 			if(tmpNode)
 			{
 				tmpName += GetName(tmpNode, levels - 1);
@@ -240,15 +250,119 @@ string NsTree::GetName(NsNode * node, unsigned int levels)
 	}
 }
 
-string NsTree::GetRandomName(void)
+const Name& NsTree::GetRandomName(void)
 {
-	/*
-	cout<<"GetRandomName="
-			<<root->GetString()
-			<<"Levels="<<this->GetLevels()
-			<<endl;*/
-	string name = GetName(root, this->GetLevels());
-	return name;
+	if(m_names.empty())
+		Flatten();
+
+	// pick a column uniformly, then either the column itself or its alias
+	double u = m_rand->GetValue(0, m_names.size());
+	size_t column = std::min(static_cast<size_t>(u), m_names.size() - 1);
+	if(u - column < m_threshold[column])
+		return m_names[column];
+	else
+		return m_names[m_alias[column]];
+}
+
+void NsTree::Flatten(void)
+{
+	m_names.clear();
+	m_probabilities.clear();
+	if(this->GetLevels() > 0)
+		Flatten(root, this->GetLevels(), Name(), 1.0);
+	if(m_names.empty())
+	{
+		// same as GetName for an empty walk
+		m_names.push_back(Name());
+		m_probabilities.push_back(1.0);
+	}
+	BuildAliasTable();
+}
+
+void NsTree::Flatten(NsNode* node, unsigned int levels, const Name& prefix, double probability)
+{
+	// same walk as GetName, enumerating every choice of active child
+	Name name(prefix);
+	string element = node->GetString();
+	if(element == "app")
+		name.append("A");
+	else if(element == "addr")
+		name.append("S");
+	else
+		name.append(element.c_str());
+
+	double sumWeight = 0.0;
+	if(levels > 1)
+	{
+		for (int i = 0; i < node->GetChildNum(); i++)
+		{
+			if(node->GetChildByIndex(i)->GetStatus())
+				sumWeight += node->GetChildByIndex(i)->GetWeight();
+		}
+	}
+
+	if(sumWeight == 0.0)
+	{
+		m_names.push_back(name);
+		m_probabilities.push_back(probability);
+		return;
+	}
+
+	for (int i = 0; i < node->GetChildNum(); i++)
+	{
+		NsNode* child = node->GetChildByIndex(i);
+		if(child->GetStatus())
+			Flatten(child, levels - 1, name, probability * child->GetWeight() / sumWeight);
+	}
+}
+
+void NsTree::BuildAliasTable(void)
+{
+	size_t n = m_probabilities.size();
+	m_threshold.assign(n, 1.0);
+	m_alias.resize(n);
+
+	vector<uint32_t> small, large;
+	vector<double> scaled(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		m_alias[i] = i;
+		scaled[i] = m_probabilities[i] * n;
+		if(scaled[i] < 1.0)
+			small.push_back(i);
+		else
+			large.push_back(i);
+	}
+
+	while(!small.empty() && !large.empty())
+	{
+		uint32_t s = small.back();
+		small.pop_back();
+		uint32_t l = large.back();
+
+		m_threshold[s] = scaled[s];
+		m_alias[s] = l;
+		scaled[l] -= 1.0 - scaled[s];
+		if(scaled[l] < 1.0)
+		{
+			large.pop_back();
+			small.push_back(l);
+		}
+	}
+	// leftovers are 1 up to rounding errors, m_threshold keeps them
+}
+
+size_t NsTree::GetNameNum(void)
+{
+	if(m_names.empty())
+		Flatten();
+	return m_names.size();
+}
+
+const Name& NsTree::GetNameByIndex(size_t i, double& probability)
+{
+	probability = m_probabilities[i];
+	return m_names[i];
 }
 
 int NsTree::GetLevels()
@@ -331,6 +445,33 @@ ConsumerRandomCbr::GetTypeId(void)
                     IntegerValue(std::numeric_limits<uint32_t>::max()),
                     MakeIntegerAccessor(&ConsumerRandomCbr::m_seqMax), MakeIntegerChecker<uint32_t>())
 
+      .AddAttribute("FollowMobility",
+                    "If true, the spatial part of names is the region the node is in "
+                    "(needs a MobilityModel and regions in GeoRegionTable)",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&ConsumerRandomCbr::m_followMobility),
+                    MakeBooleanChecker())
+
+      .AddAttribute("PrefetchLookahead",
+                    "Number of next Interests prefetched in their predicted regions "
+                    "(requires FollowMobility), 0 disables prefetching",
+                    UintegerValue(0),
+                    MakeUintegerAccessor(&ConsumerRandomCbr::m_prefetchLookahead),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddAttribute("PrefetchMaxRate",
+                    "Maximum rate of prefetch Interests (per second), 0 for no limit",
+                    DoubleValue(10.0),
+                    MakeDoubleAccessor(&ConsumerRandomCbr::m_prefetchMaxRate),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("PrefetchLifeTime", "LifeTime of prefetch Interests", StringValue("1s"),
+                    MakeTimeAccessor(&ConsumerRandomCbr::m_prefetchLifeTime), MakeTimeChecker())
+
+      .AddTraceSource("PrefetchSent", "Name and sequence number of every prefetch Interest",
+                      MakeTraceSourceAccessor(&ConsumerRandomCbr::m_prefetchSent),
+                      "ns3::ndn::ConsumerRandomCbr::PrefetchSentCallback")
+
     ;
 
   return tid;
@@ -341,31 +482,163 @@ ConsumerRandomCbr::ConsumerRandomCbr()
   , m_firstTime(true)
   , aNameTree("A")
   , sNameTree("S")
+  , m_isNameTreeBuilt(false)
+  , m_followMobility(false)
+  , m_prefetchLookahead(0)
+  , m_prefetchMaxRate(10.0)
+  , m_nextPrefetchSeq(0)
 {
   NS_LOG_FUNCTION_NOARGS();
   m_seqMax = std::numeric_limits<uint32_t>::max();
-  //================================================
-  //Yuwei
-  aNameTree.InitBuild(3,3);
-  sNameTree.BuildScene("scene1");
-  //sNameTree.InitBuild(4,3);
-  //aNameTree.Print();
-  //sNameTree.Print();
-  //cout<<"============================"<<endl;
 }
 
 ConsumerRandomCbr::~ConsumerRandomCbr()
 {
 }
 
+int64_t
+ConsumerRandomCbr::AssignStreams(int64_t stream)
+{
+  int64_t nStreams = Consumer::AssignStreams(stream);
+  if (m_random != 0) {
+    m_random->SetStream(stream + nStreams);
+    ++nStreams;
+  }
+  nStreams += sNameTree.AssignStreams(stream + nStreams);
+  nStreams += aNameTree.AssignStreams(stream + nStreams);
+  return nStreams;
+}
+
+void
+ConsumerRandomCbr::StartApplication()
+{
+  // name trees are built here rather than in the constructor, so that streams assigned
+  // after the app is created are used for the tree shape too
+  if (!m_isNameTreeBuilt) {
+    //================================================
+    //Yuwei
+    aNameTree.InitBuild(3,3);
+    sNameTree.BuildScene("scene1");
+    //sNameTree.InitBuild(4,3);
+    //aNameTree.Print();
+    //sNameTree.Print();
+    //cout<<"============================"<<endl;
+    m_isNameTreeBuilt = true;
+  }
+
+  if (m_followMobility && m_mobility == 0) {
+    m_mobility = GetNode()->GetObject<MobilityModel>();
+    if (m_mobility == 0)
+      NS_LOG_WARN("Node " << GetNode()->GetId() << " has no MobilityModel, names do not follow it");
+
+    for (size_t i = 0; i < sNameTree.GetNameNum(); ++i) {
+      double probability;
+      m_prefetcher.AddSpatialName(sNameTree.GetNameByIndex(i, probability));
+    }
+    if (m_prefetcher.GetNSpatialNames() == 0)
+      NS_LOG_WARN("No spatial name has a region in GeoRegionTable, names do not follow mobility");
+
+    if (m_prefetchMaxRate > 0)
+      m_prefetcher.SetRateLimit(m_prefetchMaxRate, std::max<uint32_t>(m_prefetchLookahead, 1));
+  }
+  m_nextPrefetchSeq = m_seq;
+
+  Consumer::StartApplication();
+}
+
+bool
+ConsumerRandomCbr::IsFollowingMobility() const
+{
+  return m_mobility != 0 && m_prefetcher.GetNSpatialNames() > 0;
+}
+
+const Name&
+ConsumerRandomCbr::GetUpcomingAppName(size_t i)
+{
+  while (m_upcomingAppNames.size() <= i)
+    m_upcomingAppNames.push_back(aNameTree.GetRandomName());
+  return m_upcomingAppNames[i];
+}
+
+void
+ConsumerRandomCbr::Prefetch(Time gap)
+{
+  Time now = Simulator::Now();
+  while (!m_prefetchExpiry.empty() && m_prefetchExpiry.front().first <= now) {
+    m_prefetchNames.erase(m_prefetchExpiry.front().second);
+    m_prefetchExpiry.pop_front();
+  }
+
+  // the Interest being scheduled gets m_seq, the k-th after it m_seq + k
+  m_nextPrefetchSeq = std::max(m_nextPrefetchSeq, m_seq + 1);
+  for (; m_nextPrefetchSeq <= m_seq + m_prefetchLookahead && m_nextPrefetchSeq < m_seqMax;
+       ++m_nextPrefetchSeq) {
+    uint32_t k = m_nextPrefetchSeq - m_seq;
+    const Name* region = m_prefetcher.Predict(m_mobility, gap + Seconds(k / m_frequency));
+    if (region == nullptr)
+      continue;
+    if (!m_prefetcher.TryAcquire())
+      break; // retried when the next Interest is scheduled
+
+    Name prefix(*region);
+    prefix.append(GetUpcomingAppName(k - 1));
+    uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+    time::milliseconds lifetime(m_prefetchLifeTime.GetMilliSeconds());
+    shared_ptr<Interest> interest =
+      GetInterestTemplate(prefix, lifetime).makeInterest(m_nextPrefetchSeq, nonce);
+
+    NS_LOG_INFO("> Prefetch for " << m_nextPrefetchSeq << " " << interest->getName());
+    m_prefetchNames.insert(interest->getName());
+    m_prefetchExpiry.push_back(std::make_pair(now + m_prefetchLifeTime, interest->getName()));
+
+    m_prefetchSent(this, interest->getName(), m_nextPrefetchSeq);
+    m_transmittedInterests(interest, this, m_face);
+    m_face->onReceiveInterest(*interest);
+  }
+}
+
+void
+ConsumerRandomCbr::OnData(shared_ptr<const Data> data)
+{
+  auto prefetch = m_prefetchNames.find(data->getName());
+  if (prefetch != m_prefetchNames.end()) {
+    m_prefetchNames.erase(prefetch);
+
+    // the Interest of the sequence number may have been sent meanwhile with the same name
+    uint32_t seq = data->getName().at(-1).toSequenceNumber();
+    ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+    if (entry == nullptr || entry->interest == nullptr ||
+        entry->interest->getName() != data->getName()) {
+      NS_LOG_INFO("< Prefetched DATA for " << seq);
+      if (m_active)
+        App::OnData(data); // tracing inside
+      return;
+    }
+  }
+
+  Consumer::OnData(data);
+}
+
 void
 ConsumerRandomCbr::ScheduleNextPacket()
 {
 	//For Random Cbr
 	//Yuwei
 	//===============================================================
-	string prefix=sNameTree.GetRandomName()+aNameTree.GetRandomName();
-	SetPrefix(prefix);
+	if (IsFollowingMobility()) {
+	  // expected gap, the actual one may be randomized
+	  Time gap = m_firstTime ? Seconds(0.0) : Seconds(1.0 / m_frequency);
+	  const Name* region = m_prefetcher.Predict(m_mobility, gap);
+	  m_interestName = region != nullptr ? *region : sNameTree.GetRandomName();
+	  m_interestName.append(GetUpcomingAppName(0));
+	  m_upcomingAppNames.pop_front();
+	  if (m_prefetchLookahead > 0)
+	    Prefetch(gap);
+	}
+	else {
+	  m_interestName = sNameTree.GetRandomName();
+	  m_interestName.append(aNameTree.GetRandomName());
+	}
 	m_isSameWithLastInterest = false;
 
 	//===============================================================
@@ -24,6 +24,12 @@
 
 #include "ndn-consumer.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-mobility-prefetcher.hpp"
+
+#include <deque>
+#include <unordered_set>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -37,44 +43,104 @@ public:
 	void CreateChilds(unsigned short num);
 	string GetString(void);
 	NsNode* GetChildByIndex(unsigned short i);
-	NsNode* GetActiveChlidByRandom(void);
+	NsNode* GetActiveChlidByRandom(Ptr<UniformRandomVariable> rand);
 	unsigned short GetChildNum(void);
 	void Print(void);
 	void Deactivate(void);
 	bool GetStatus(void);
+	/**
+	 * \brief Relative probability to choose this node among its active siblings (1 by default)
+	 */
+	void SetWeight(double weight);
+	double GetWeight(void);
 private:
 	string m_element;
-	list<NsNode*> p_childs;
+	vector<NsNode*> p_childs;
 	bool is_active;
+	double m_weight;
 };
 
+/**
+ * \brief Tree of name components from which random names are drawn
+ *
+ * A random name is a walk from the root that, at every level, continues to one of the active
+ * children with probability proportional to the child weights.  All possible walks are
+ * flattened into a list of pre-built names with their probabilities, and drawn from it in
+ * O(1) using an alias table (Vose's method).
+ */
 class NsTree{
 public:
 	NsTree(string r);
 	~NsTree();
+	/**
+	 * \brief Assign a fixed random variable stream number to the random variables used by the tree
+	 * \return number of streams used
+	 */
+	int64_t AssignStreams(int64_t stream);
 	void InitBuild(unsigned short levels, unsigned short maxChilds);
 	void Build(NsNode* r,unsigned short levels, unsigned short maxChilds);
 	string GetName(NsNode* node, unsigned int levels);
-	string GetRandomName(void);
+	/**
+	 * \brief Draw a random name
+	 *
+	 * The tree is flattened on the first call.  Call Flatten() again if the tree has been
+	 * modified after that.
+	 */
+	const Name& GetRandomName(void);
+	/**
+	 * \brief Build the list of names that can be drawn and the alias table
+	 */
+	void Flatten(void);
+	/**
+	 * \brief Names that can be drawn, with their probabilities
+	 */
+	size_t GetNameNum(void);
+	const Name& GetNameByIndex(size_t i, double& probability);
 	int GetLevels();
 	void Print(void);
 	//---------------------------------------------------------------------------
 	void BuildScene(string sc);
+private:
+	void Flatten(NsNode* node, unsigned int levels, const Name& prefix, double probability);
+	void BuildAliasTable(void);
 private:
 		NsNode* root;
 		int levels;
+		Ptr<UniformRandomVariable> m_rand;
+		//flattened walks
+		vector<Name> m_names;
+		vector<double> m_probabilities;
+		//alias table
+		vector<double> m_threshold;
+		vector<uint32_t> m_alias;
 };
 //============================================================================
 /**
  * @ingroup ndn-apps
  * @brief Ndn application for sending out Interest packets at a "constant" rate (Poisson process)
  * and with different names
+ *
+ * With FollowMobility, the spatial part of every name is the region the node is in when the
+ * Interest is sent (see MobilityPrefetcher) instead of a random one, so that a vehicle asks
+ * about its surroundings.  PrefetchLookahead then sends prefetch Interests for the names of
+ * the next Interests, with the regions predicted from the velocity of the node, so that their
+ * Data is already cached at the node (or close to it) when the Interests are sent.
+ *
+ * Prefetch Interests have low priority: they are rate limited, never retransmitted, and kept
+ * out of the RTT estimation and the delay traces.
  */
 class ConsumerRandomCbr : public Consumer {
 public:
   static TypeId
   GetTypeId();
 
+  // From Consumer
+  virtual void
+  OnData(shared_ptr<const Data> data);
+
+public:
+  typedef void (*PrefetchSentCallback)(Ptr<App> app, const Name& name, uint32_t seqno);
+
   /**
    * \brief Default constructor
    * Sets up randomizer function and packet sequence number
@@ -82,7 +148,13 @@ public:
   ConsumerRandomCbr();
   virtual ~ConsumerRandomCbr();
 
+  virtual int64_t
+  AssignStreams(int64_t stream);
+
 protected:
+  virtual void
+  StartApplication();
+
   /**
    * \brief Constructs the Interest packet and sends it using a callback to the underlying NDN
    * protocol
@@ -104,6 +176,23 @@ protected:
   std::string
   GetRandomize() const;
 
+private:
+  bool
+  IsFollowingMobility() const;
+
+  /**
+   * @brief Application part of the \p i-th Interest after the one being scheduled
+   */
+  const Name&
+  GetUpcomingAppName(size_t i);
+
+  /**
+   * @brief Sends prefetch Interests for the next PrefetchLookahead sequence numbers
+   * @param gap expected time until the Interest being scheduled is sent
+   */
+  void
+  Prefetch(Time gap);
+
 protected:
   double m_frequency; // Frequency of interest packets (in hertz)
   bool m_firstTime;
@@ -112,7 +201,20 @@ protected:
   //==========================================
   NsTree aNameTree;
   NsTree sNameTree;
+  bool m_isNameTreeBuilt;
+
+  bool m_followMobility;
+  uint32_t m_prefetchLookahead;
+  double m_prefetchMaxRate;
+  Time m_prefetchLifeTime;
+  MobilityPrefetcher m_prefetcher;
+  Ptr<MobilityModel> m_mobility;
+  std::deque<Name> m_upcomingAppNames; ///< application parts of the next Interests
+  uint32_t m_nextPrefetchSeq;          ///< first sequence number not prefetched yet
+  std::unordered_set<Name> m_prefetchNames; ///< names of pending prefetch Interests
+  std::deque<std::pair<Time, Name>> m_prefetchExpiry; ///< same names, by expiry
 
+  TracedCallback<Ptr<App> /* app */, const Name& /* name */, uint32_t /* seqno */> m_prefetchSent;
 };
 
 } // namespace ndn
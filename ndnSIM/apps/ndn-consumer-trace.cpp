@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-trace.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/names.h"
+#include "ns3/node.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerTrace");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(ConsumerTrace);
+
+TypeId
+ConsumerTrace::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ConsumerTrace")
+      .SetGroupName("Ndn")
+      .SetParent<Consumer>()
+      .AddConstructor<ConsumerTrace>()
+
+      .AddAttribute("TraceFile", "Request log to replay (CSV or binary)", StringValue(""),
+                    MakeStringAccessor(&ConsumerTrace::m_traceFile), MakeStringChecker())
+      .AddAttribute("TimeOffset", "Time added to the times of the requests in the log",
+                    StringValue("0s"), MakeTimeAccessor(&ConsumerTrace::m_timeOffset),
+                    MakeTimeChecker());
+
+  return tid;
+}
+
+ConsumerTrace::ConsumerTrace()
+  : m_hasNext(false)
+  , m_nRequests(0)
+{
+  m_seqMax = std::numeric_limits<uint32_t>::max();
+}
+
+void
+ConsumerTrace::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  if (m_traceFile.empty())
+    NS_FATAL_ERROR("ConsumerTrace needs a TraceFile");
+  m_reader.reset(new RequestTraceReader(m_traceFile, GetNode()->GetId(),
+                                        Names::FindName(GetNode())));
+  m_hasNext = false;
+
+  Consumer::StartApplication();
+}
+
+void
+ConsumerTrace::StopApplication()
+{
+  Consumer::StopApplication();
+  m_reader.reset();
+}
+
+void
+ConsumerTrace::ScheduleNextPacket()
+{
+  // also called after every (re)transmission, the next request is scheduled only once
+  if (m_sendEvent.IsRunning() || m_reader == nullptr)
+    return;
+
+  if (!m_hasNext) {
+    if (!m_reader->next(m_next)) {
+      NS_LOG_DEBUG("End of request log after " << m_nRequests << " requests");
+      return;
+    }
+    m_hasNext = true;
+    ++m_nRequests;
+  }
+
+  Time delay = std::max(m_next.time + m_timeOffset - Simulator::Now(), Time(0));
+  m_sendEvent = Simulator::Schedule(delay, &ConsumerTrace::SendRequest, this);
+}
+
+void
+ConsumerTrace::SendRequest()
+{
+  m_isSameWithLastInterest = m_next.name == m_interestName;
+  m_interestName = m_next.name;
+  m_hasNext = false;
+  SendPacket(); // schedules the next request
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_TRACE_H
+#define NDN_CONSUMER_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer.hpp"
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include <memory>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * \brief Ndn application replaying the requests of its node from a request log
+ *
+ * Every request of the node in TraceFile (see RequestTraceReader for the formats) is sent at
+ * its time plus TimeOffset, as an Interest for /<name>/<seq>, with the RTO and retransmissions
+ * of Consumer.  Requests whose time has passed when the app reaches them are sent at once.
+ *
+ * The node is matched by id, and in CSV logs also by the name registered by Names class.  The
+ * log is read as the simulation goes, one request ahead.
+ */
+class ConsumerTrace : public Consumer {
+public:
+  static TypeId
+  GetTypeId();
+
+  ConsumerTrace();
+
+  /**
+   * \brief Number of requests of the node read from the log so far
+   */
+  uint64_t
+  GetNRequests() const
+  {
+    return m_nRequests;
+  }
+
+protected:
+  virtual void
+  StartApplication();
+
+  virtual void
+  StopApplication();
+
+  virtual void
+  ScheduleNextPacket();
+
+private:
+  void
+  SendRequest();
+
+private:
+  std::string m_traceFile;
+  Time m_timeOffset;
+
+  std::unique_ptr<RequestTraceReader> m_reader;
+  RequestTraceReader::Request m_next; ///< \brief request the send event is scheduled for
+  bool m_hasNext;
+  uint64_t m_nRequests;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_TRACE_H
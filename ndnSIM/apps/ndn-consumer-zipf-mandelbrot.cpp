@@ -24,7 +24,8 @@
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-fw-hop-count-tag.hpp"
 
-#include <math.h>
+#include <cmath>
+#include <sstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
@@ -64,9 +65,10 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N(100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q(0.7)
   , m_s(0.7)
+  , m_isTableValid(false)
   , m_seqRng(CreateObject<UniformRandomVariable>())
 {
-  // SetNumberOfContents is called by NS-3 object system during the initialization
+  // the table is built on the first request, after NS-3 object system has set the attributes
 }
 
 ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot()
@@ -76,21 +78,54 @@ ConsumerZipfMandelbrot::~ConsumerZipfMandelbrot()
 void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
+  if (numOfContents != m_N)
+    m_isTableValid = false;
   m_N = numOfContents;
+}
 
-  NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
+void
+ConsumerZipfMandelbrot::BuildTable()
+{
+  m_isTableValid = true;
+  m_sharedTable = BuildPopularityTable(m_N, m_q, m_s, m_table);
+}
 
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
+std::shared_ptr<const SharedInput>
+ConsumerZipfMandelbrot::BuildPopularityTable(uint32_t n, double q, double s, AliasTable& table)
+{
+  NS_LOG_DEBUG(q << " and " << s << " and " << n);
+
+  if (SharedInput::IsEnabled()) {
+    // exact q and s, tables of different parameters must not be mixed up
+    std::ostringstream name;
+    name << "zipf-mandelbrot-" << n << "-" << std::hexfloat << q << "-" << s << ".table";
+    std::shared_ptr<const SharedInput> sharedTable =
+      SharedInput::GetOrCreate(name.str(), [=] (std::ostream& os) {
+          AliasTable table;
+          ComputeTable(n, q, s, table);
+          table.save(os);
+        });
+    if (table.attach(sharedTable->GetData(), sharedTable->GetSize()))
+      return sharedTable;
+
+    NS_LOG_WARN(sharedTable->GetFile() << " is not a popularity table, ignored");
   }
 
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+  ComputeTable(n, q, s, table);
+  return nullptr;
+}
+
+void
+ConsumerZipfMandelbrot::ComputeTable(uint32_t n, double q, double s, AliasTable& table)
+{
+  // p(k) ~ 1 / (k + q)^s, written without data dependencies between iterations
+  std::vector<double> weights(n);
+  const double k0 = 1.0 + q;
+  for (uint32_t i = 0; i < n; i++) {
+    weights[i] = std::exp(-s * std::log(k0 + i));
   }
+
+  table.build(weights);
 }
 
 uint32_t
@@ -102,8 +137,9 @@ ConsumerZipfMandelbrot::GetNumberOfContents() const
 void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
+  if (q != m_q)
+    m_isTableValid = false;
   m_q = q;
-  SetNumberOfContents(m_N);
 }
 
 double
@@ -115,8 +151,9 @@ ConsumerZipfMandelbrot::GetQ() const
 void
 ConsumerZipfMandelbrot::SetS(double s)
 {
+  if (s != m_s)
+    m_isTableValid = false;
   m_s = s;
-  SetNumberOfContents(m_N);
 }
 
 double
@@ -168,27 +205,19 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
 
-  //
-  shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-  nameWithSequence->appendSequenceNumber(seq);
-  //
-
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  shared_ptr<Interest> interest =
+    GetInterestTemplate(m_interestName, ::ndn::DEFAULT_INTEREST_LIFETIME).makeInterest(seq, nonce);
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
   NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTable.size() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
+  ConsumerSeqTable::Entry& entry = RecordTransmission(seq);
+  if (!entry.hasDeadline)
+    m_seqTable.setDeadline(entry, Simulator::Now());
+  ScheduleRetxTimeout();
 
   m_rtt->SentSeq(SequenceNumber32(seq), 1);
 
@@ -201,24 +230,15 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (!m_isTableValid)
+    BuildTable();
+  if (m_table.empty())
+    return 1;
 
   double p_random = m_seqRng->GetValue();
-  while (p_random == 0) {
-    p_random = m_seqRng->GetValue();
-  }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_table.sample(p_random) + 1; //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
@@ -27,6 +27,9 @@
 #include "ndn-consumer.hpp"
 #include "ndn-consumer-cbr.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-alias-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-shared-input.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -47,6 +50,9 @@ namespace ndn {
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution:
  *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * If a SharedInput directory is set, the popularity table is built once for all consumers and
+ * replications with the same N, q and s, and mapped from the directory.
  */
 class ConsumerZipfMandelbrot : public ConsumerCbr {
 public:
@@ -66,6 +72,14 @@ public:
   uint32_t
   GetNextSeq();
 
+  /**
+   * \brief Builds the alias table of the popularities of @p n contents, mapped from the
+   *        SharedInput directory if one is set
+   * \return the mapped file holding @p table, which must outlive the table, or nullptr
+   */
+  static std::shared_ptr<const SharedInput>
+  BuildPopularityTable(uint32_t n, double q, double s, AliasTable& table);
+
 protected:
   virtual void
   ScheduleNextPacket();
@@ -89,11 +103,22 @@ private:
   double
   GetS() const;
 
+  /**
+   * \brief Builds the alias table of the popularities, called on first use after N, q or s changed
+   */
+  void
+  BuildTable();
+
+  static void
+  ComputeTable(uint32_t n, double q, double s, AliasTable& table);
+
 private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  std::shared_ptr<const SharedInput> m_sharedTable; // holds m_table if it is shared
+  AliasTable m_table;         // popularity of content (index + 1)
+  bool m_isTableValid;        // false if N, q or s changed since the table was built
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
@@ -28,10 +28,15 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/object-factory.h"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "utils/ndn-correlativity-knowledge-base.hpp"
+#include "utils/ndn-rtt-hint-tag.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
@@ -44,6 +49,8 @@ namespace ndn {
 
 NS_OBJECT_ENSURE_REGISTERED(Consumer);
 
+static const size_t MAX_INTEREST_TEMPLATES = 1024;
+
 TypeId
 Consumer::GetTypeId(void)
 {
@@ -56,15 +63,55 @@ Consumer::GetTypeId(void)
 
       .AddAttribute("Prefix", "Name of the Interest", StringValue("/"),
                     MakeNameAccessor(&Consumer::m_interestName), MakeNameChecker())
-      .AddAttribute("LifeTime", "LifeTime for interest packet", StringValue("2s"),
+      .AddAttribute("LifeTime",
+                    "LifeTime for interest packet, the upper bound if the lifetime follows the "
+                    "RTO (see LifeTimeRtoFactor)",
+                    StringValue("2s"),
                     MakeTimeAccessor(&Consumer::m_interestLifeTime), MakeTimeChecker())
+      .AddAttribute("LifeTimeRtoFactor",
+                    "If positive, the lifetime of every transmission of an Interest is its RTO "
+                    "times this factor, between MinLifeTime and LifeTime, so that PIT entries "
+                    "on the path expire about when the Interest is retransmitted",
+                    DoubleValue(0.0), MakeDoubleAccessor(&Consumer::m_lifeTimeRtoFactor),
+                    MakeDoubleChecker<double>(0.0))
+      .AddAttribute("MinLifeTime", "Lower bound of lifetimes that follow the RTO",
+                    StringValue("100ms"),
+                    MakeTimeAccessor(&Consumer::m_minInterestLifeTime), MakeTimeChecker())
 
       .AddAttribute("RetxTimer",
-                    "Timeout defining how frequent retransmission timeouts should be checked",
+                    "Obsolete, kept for compatibility: retransmission timeouts are checked "
+                    "exactly at the earliest pending deadline",
                     StringValue("50ms"),
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
 
+      .AddAttribute("RttEstimatorType", "Type of RTT estimator used to calculate RTO",
+                    TypeIdValue(RttMeanDeviation::GetTypeId()),
+                    MakeTypeIdAccessor(&Consumer::SetRttEstimatorType,
+                                       &Consumer::GetRttEstimatorType),
+                    MakeTypeIdChecker())
+
+      .AddAttribute("RetxControllerType",
+                    "Type of controller deciding whether timed out Interests are retransmitted",
+                    TypeIdValue(RetxController::GetTypeId()),
+                    MakeTypeIdAccessor(&Consumer::SetRetxControllerType,
+                                       &Consumer::GetRetxControllerType),
+                    MakeTypeIdChecker())
+
+      .AddAttribute("RtoPolicy",
+                    "RTO of the first transmission of an Interest: Correlativity (RTO by "
+                    "correlativity unless the prefix is the same as for the last Interest, then "
+                    "Tcp), History (CalRTObyHistory) or Tcp (RetransmitTimeout)",
+                    EnumValue(RTO_CORRELATIVITY), MakeEnumAccessor(&Consumer::m_rtoPolicy),
+                    MakeEnumChecker(RTO_CORRELATIVITY, "Correlativity",
+                                    RTO_HISTORY, "History",
+                                    RTO_TCP, "Tcp"))
+      .AddAttribute("ShareCorrelativity",
+                    "If true, RTO by correlativity uses RTT samples of all consumers of the node "
+                    "that share correlativity (requires RttMeanDeviation estimator)",
+                    BooleanValue(false), MakeBooleanAccessor(&Consumer::m_shareCorrelativity),
+                    MakeBooleanChecker())
+
       .AddTraceSource("LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_lastRetransmittedInterestDataDelay),
@@ -73,7 +120,26 @@ Consumer::GetTypeId(void)
       .AddTraceSource("FirstInterestDataDelay",
                       "Delay between first transmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_firstInterestDataDelay),
-                      "ns3::ndn::Consumer::FirstInterestDataDelayCallback");
+                      "ns3::ndn::Consumer::FirstInterestDataDelayCallback")
+
+      .AddTraceSource("InterestSent",
+                      "Name, sequence number and RTO of every (re)transmitted Interest",
+                      MakeTraceSourceAccessor(&Consumer::m_interestSent),
+                      "ns3::ndn::Consumer::InterestSentCallback")
+
+      .AddTraceSource("DataReceived", "Name and sequence number of every received Data",
+                      MakeTraceSourceAccessor(&Consumer::m_dataReceived),
+                      "ns3::ndn::Consumer::DataReceivedCallback")
+
+      .AddTraceSource("Timeout",
+                      "Sequence number and RTO of every transmission whose RTO expired",
+                      MakeTraceSourceAccessor(&Consumer::m_timeout),
+                      "ns3::ndn::Consumer::TimeoutCallback")
+
+      .AddTraceSource("InterestGivenUp",
+                      "Sequence number of every Interest the retransmission controller gave up",
+                      MakeTraceSourceAccessor(&Consumer::m_interestGivenUp),
+                      "ns3::ndn::Consumer::InterestGivenUpCallback");
 
   return tid;
 }
@@ -82,26 +148,55 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0)             // don't request anything
-  , m_retxNum(3)      // We allow retransmition twice
   , m_isSameWithLastInterest(true)
+  , m_rtoPolicy(RTO_CORRELATIVITY)
+  , m_shareCorrelativity(false)
+  , m_lifeTimeRtoFactor(0.0)
 {
   NS_LOG_FUNCTION_NOARGS();
 
-  m_rtt = CreateObject<RttMeanDeviation>();
+  SetRttEstimatorType(RttMeanDeviation::GetTypeId());
+  SetRetxControllerType(RetxController::GetTypeId()); // 3 transmissions of every Interest
+}
+
+void
+Consumer::SetRttEstimatorType(TypeId type)
+{
+  if (m_rtt != 0 && m_rtt->GetInstanceTypeId() == type)
+    return;
+
+  ObjectFactory factory;
+  factory.SetTypeId(type);
+  m_rtt = factory.Create<RttEstimator>();
+}
+
+TypeId
+Consumer::GetRttEstimatorType() const
+{
+  return m_rtt->GetInstanceTypeId();
+}
+
+void
+Consumer::SetRetxControllerType(TypeId type)
+{
+  if (m_retxController != 0 && m_retxController->GetInstanceTypeId() == type)
+    return;
+
+  ObjectFactory factory;
+  factory.SetTypeId(type);
+  m_retxController = factory.Create<RetxController>();
+}
+
+TypeId
+Consumer::GetRetxControllerType() const
+{
+  return m_retxController->GetInstanceTypeId();
 }
 
 void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
-  if (m_retxEvent.IsRunning())
-  {
-    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
-    Simulator::Remove(m_retxEvent); // slower, but better for memory
-  }
-
-  // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
 }
 
 Time
@@ -110,43 +205,66 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+size_t
+Consumer::GetMemoryUsage() const
+{
+  // std::set node has three links and a color next to the value
+  size_t n = m_retxSeqs.size() * (sizeof(uint32_t) + 4 * sizeof(void*)) +
+             m_seqTable.getMemoryUsage() +
+             m_interestTemplates.size() * (sizeof(decltype(m_interestTemplates)::value_type) +
+                                           2 * sizeof(void*));
+  if (m_rtt != 0) {
+    n += m_rtt->GetMemoryUsage();
+  }
+  return n;
+}
+
 // Find out which interest with sequence should be retransmitted
 void
 Consumer::CheckRetxTimeout()
 {
   Time now = Simulator::Now();
 
-  //Get the RTO value from RTTestimator
-  Time rto;
-  // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
-  SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry, tmp;
-
-  while (!m_seqTimeouts.empty())
+  ConsumerSeqTable::Entry* entry;
+  while ((entry = m_seqTable.earliestDeadline()) != nullptr)
   {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    uint32_t seqNo = entry->seq;
-    //Get Rto value from RttHistory
-    rto = m_rtt->GetRtobySeq(SequenceNumber32(seqNo));
-    /*
-    cout<<"Seq = "<<seqNo
-    		<<",send Time="<<entry->time.ToDouble(Time::MS)
-    		<<", rto ="<<rto.ToDouble(Time::MS)
-			<<", now ="<<now.ToDouble(Time::MS)
-			<<endl;*/
     // timeout expired?
-    if (entry->time <= now)
+    if (entry->deadline <= now)
     {
-      //uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
+      uint32_t seqNo = entry->seq;
+      m_seqTable.clearDeadline(*entry);
       OnTimeout(seqNo);
     }
     else
       break; // nothing else to do. All later packets need not be retransmitted
   }
 
-  //cout<<m_retxTimer.ToDouble(Time::MS)<<endl;
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxTimeout();
+}
+
+void
+Consumer::ScheduleRetxTimeout()
+{
+  ConsumerSeqTable::Entry* entry = m_seqTable.earliestDeadline();
+  if (entry == nullptr) {
+    // nothing is outstanding, no need to wake up
+    if (m_retxEvent.IsRunning())
+      Simulator::Remove(m_retxEvent);
+    return;
+  }
+
+  Time deadline = entry->deadline;
+  if (m_retxEvent.IsRunning()) {
+    if (m_retxDeadline <= deadline)
+      return; // pending check is not later than needed, it will reschedule itself
+
+    // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
+    Simulator::Remove(m_retxEvent); // slower, but better for memory
+  }
+
+  m_retxDeadline = deadline;
+  m_retxEvent = Simulator::Schedule(std::max(deadline - Simulator::Now(), Time(0)),
+                                    &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
@@ -158,6 +276,15 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  if (m_shareCorrelativity) {
+    Ptr<RttMeanDeviation> rtt = DynamicCast<RttMeanDeviation>(m_rtt);
+    if (rtt != 0)
+      rtt->SetKnowledgeBase(CorrelativityKnowledgeBase::GetOrCreate(GetNode()));
+    else
+      NS_LOG_WARN("RTT estimator " << m_rtt->GetInstanceTypeId().GetName()
+                                   << " cannot share correlativity");
+  }
+
   ScheduleNextPacket();
 }
 
@@ -168,6 +295,7 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -179,6 +307,8 @@ Consumer::SendPacket()
   if (!m_active)
     return;
 
+  NDN_ALLOCATION_SCOPE(APPS);
+
   NS_LOG_FUNCTION_NOARGS();
 
   //Find the max value of sequence number
@@ -209,34 +339,27 @@ Consumer::SendPacket()
   }
 
   //-------------------------------------------------------------------------------------------------------------------
-  //if it a retranmitted interest, i will get it name from m_rtt
-  shared_ptr<Name> nameWithSequence;
-  Name tmpName = m_rtt->GetNamebySeq(SequenceNumber32(seq));
-  if(tmpName.toUri() == "/")
+  //Create an Interest packet from the pre-encoded template of the prefix
+  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+  shared_ptr<const Interest> interest;
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry == nullptr || entry->interest == nullptr)
   {
-	  //set a new name
-	  nameWithSequence = make_shared<Name>(m_interestName);
-	  nameWithSequence->appendSequenceNumber(seq);
+	  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
+	  interest = GetInterestTemplate(m_interestName, interestLifeTime).makeInterest(seq, nonce);
   }
   else
   {
-	  nameWithSequence = make_shared<Name>(tmpName);
+	  interest = InterestTemplate::refreshNonce(*entry->interest, nonce);
   }
 
-  //Create an Interest packet
-  shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-  interest->setName(*nameWithSequence);
-  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-  interest->setInterestLifetime(interestLifeTime);
-
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq);
 
   //Save time and squence number
   //How to set RTO for an interest
  // WillSendOutInterest(seq, *nameWithSequence);
-  WaitBeforeSendOutInterest(seq, *nameWithSequence);
+  WaitBeforeSendOutInterest(seq, interest);
 
   //------------------------------------------------------------------------
   /*Debug -Yuwei
@@ -277,6 +400,8 @@ Consumer::OnData(shared_ptr<const Data> data)
   if (!m_active)
     return;
 
+  NDN_ALLOCATION_SCOPE(APPS);
+
   App::OnData(data); // tracing inside
 
   NS_LOG_FUNCTION(this << data);
@@ -288,53 +413,45 @@ Consumer::OnData(shared_ptr<const Data> data)
   NS_LOG_INFO("< DATA for " << seq);
 
   int hopCount = 0;
+  bool hasHopCount = false;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr)
   { // e.g., packet came from local node's cache
     FwHopCountTag hopCountTag;
     if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
       hopCount = hopCountTag.Get();
+      hasHopCount = true;
       NS_LOG_DEBUG("Hop count: " << hopCount);
     }
+
+    RttHintTag hint;
+    if (ns3PacketTag->getPacket()->PeekPacketTag(hint)) {
+      NS_LOG_DEBUG("RTT hint: " << hint.GetSrtt() << ", " << hint.GetRttvar());
+      m_rtt->AddRttHint(data->getName(), hint.GetSrtt(), hint.GetRttvar(), hint.GetNSamples());
+    }
   }
 
   //--------------------------------------------------------------------------------------------------
   //Tracing
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end())
-  {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end())
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry != nullptr)
   {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->lastSendTime, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->firstSendTime, entry->retxCount,
+                             hopCount);
+
+    m_retxController->OnData(data->getName(), entry->retxCount);
   }
   //----------------------------------------------------------------------------------------------------
 
-  m_seqRetxCounts.erase(seq);   //recording the transmission number of every seq
-  m_seqTimeouts.erase(seq);    //record all the packets with send time for timeout
+  m_seqTable.erase(seq);        //send times, retransmission deadline and count of the seq
   m_retxSeqs.erase(seq);          //record the timeout seq , so consumer will send it later
-
-  m_seqFullDelay.erase(seq);     //Tracing
-  m_seqLastDelay.erase(seq);    //Tracing
+  ScheduleRetxTimeout();
 
   //m_rtt->AckSeq(SequenceNumber32(seq));
-  shared_ptr<Name> dataName = make_shared<Name>(data->getName());
-
-  //---------------------------------------------------------------------------------
-  //Yuwei
-  Ptr<MobilityModel> mob = GetNode()->GetObject<MobilityModel>();
-  Vector pos = mob->GetPosition ();
+  m_dataReceived(this, data->getName(), seq);
 
-  cout<<"Node="<<GetNode()->GetId()
-		  <<",Get Data="<<data->getName()
-		  <<",Seq="<<seq
-		  <<",Time="<<Simulator::Now().ToDouble(Time::S)
-		  <<"s,Pos=("<<pos.x<<","<<pos.y<<")"
-		  <<endl;
-  //---------------------------------------------------------------------------------
-  m_rtt->AckSeq(*dataName, SequenceNumber32(seq));
+  m_rtt->AckSeq(data->getName(), SequenceNumber32(seq), hasHopCount ? hopCount : -1);
 }
 
 void
@@ -343,16 +460,25 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   NS_LOG_FUNCTION(sequenceNumber);
 
   //cout<<"Seq="<<sequenceNumber<<", time="<<Simulator::Now().ToDouble(Time::MS)<<"ms"<<endl;
-  Name reIntName;
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(sequenceNumber);
+  m_timeout(this, sequenceNumber, entry != nullptr ? entry->rto : Time(0));
 
   // Double the next RTO
   // this is used in TCP method
   m_rtt->IncreaseMultiplier();
 
+  Retransmit(sequenceNumber);
+}
+
+void
+Consumer::Retransmit(uint32_t sequenceNumber)
+{
   //-----------------------------------------------------------------------------------
   //Yuwei
   // Retranmit this interest or not?
-  if(m_seqRetxCounts[sequenceNumber] < GetRetxNumber())
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(sequenceNumber);
+  if(entry == nullptr || entry->interest == nullptr
+     || m_retxController->OnTimeout(entry->interest->getName(), entry->retxCount))
   {
 	  //cout<<"SEQ: "<<sequenceNumber<<" transmitted "<<m_seqRetxCounts[sequenceNumber]<<"times."<<endl;
 	  //m_rtt->SentSeq(SequenceNumber32(sequenceNumber),1); // make sure to disable RTT calculation for this sample
@@ -360,19 +486,14 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
 	  m_retxSeqs.insert(sequenceNumber);     //insert data into retransmitted table, waiting for retransmitting
 
 	  //--------------------------------------------------------------------------------
-	  shared_ptr<Name> nameWithSequence;
-	  Name tmpName = m_rtt->GetNamebySeq(SequenceNumber32(sequenceNumber));
-	  if(tmpName.toUri() != "/")
+	  if (entry != nullptr && entry->interest != nullptr)
 	  {
-		  nameWithSequence = make_shared<Name>(tmpName);
-		  //Create an Interest packet
-		  shared_ptr<Interest> interest = make_shared<Interest>();
-		  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-		  interest->setName(*nameWithSequence);
-		  time::milliseconds interestLifeTime(m_interestLifeTime.GetMilliSeconds());
-		  interest->setInterestLifetime(interestLifeTime);
+		  //Reuse encoding of the previous transmission with a new nonce
+		  uint32_t nonce = m_rand->GetValue(0, std::numeric_limits<uint32_t>::max());
+		  shared_ptr<const Interest> interest =
+		    InterestTemplate::refreshNonce(*entry->interest, nonce);
 
-		  WaitBeforeSendOutInterest(sequenceNumber, *nameWithSequence);
+		  WaitBeforeSendOutInterest(sequenceNumber, interest);
 
 		  m_transmittedInterests(interest, this, m_face);
 		  m_face->onReceiveInterest(*interest);
@@ -382,50 +503,98 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   }
   else
   {
-	  //cout<<"Discard! "<<sequenceNumber<<" = "<<m_seqRetxCounts[sequenceNumber]<<endl;
 	  //discard this interest
-	  m_seqRetxCounts.erase(sequenceNumber);   //recording the transmission number of every seq
-	  m_seqFullDelay.erase(sequenceNumber);     //Tracing
-	  m_seqLastDelay.erase(sequenceNumber);    //Tracing
-	  m_seqTimeouts.erase(sequenceNumber);    //record all the packets with send time for timeout
+	  m_interestGivenUp(this, sequenceNumber);
+	  m_seqTable.erase(sequenceNumber);
+	  ScheduleRetxTimeout();
 	  m_rtt->DiscardInterestBySeq(SequenceNumber32(sequenceNumber));     //delete record in rtthistory
   }
 }
 
+void
+Consumer::OnNack(shared_ptr<const lp::Nack> nack)
+{
+  if (!m_active)
+    return;
+
+  App::OnNack(nack); // tracing inside
+
+  NS_LOG_FUNCTION(this << nack);
+
+  const Name& name = nack->getInterest().getName();
+  if (name.empty() || !name.at(-1).isSequenceNumber())
+    return;
+
+  uint32_t seq = name.at(-1).toSequenceNumber();
+  NS_LOG_INFO("< NACK for " << seq << ", reason: " << nack->getReason());
+
+  // Nacks for earlier transmissions and for given up sequence numbers are stale
+  ConsumerSeqTable::Entry* entry = m_seqTable.find(seq);
+  if (entry == nullptr || !entry->hasDeadline || entry->interest == nullptr
+      || entry->interest->getNonce() != nack->getInterest().getNonce())
+    return;
+
+  if (nack->getReason() == lp::NackReason::CONGESTION) {
+    m_seqTable.setDeadline(*entry, Simulator::Now() + entry->rto);
+    ScheduleRetxTimeout();
+    return;
+  }
+
+  m_seqTable.clearDeadline(*entry);
+  Retransmit(seq);
+}
+
 void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTable.size() << " items");
 
   //Save the time of interest with sequence number
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqRetxCounts[sequenceNumber]++;
+  ConsumerSeqTable::Entry& entry = RecordTransmission(sequenceNumber);
+  if (!entry.hasDeadline)
+    m_seqTable.setDeadline(entry, Simulator::Now());
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+
+  ScheduleRetxTimeout();
 }
 
 //=======================================================
 //Yuwei
+ConsumerSeqTable::Entry&
+Consumer::RecordTransmission(uint32_t sequenceNumber)
+{
+  ConsumerSeqTable::Entry& entry = m_seqTable.insert(sequenceNumber);
+  if (entry.retxCount == 0)
+    entry.firstSendTime = Simulator::Now();
+  entry.lastSendTime = Simulator::Now();
+  entry.retxCount++;
+  return entry;
+}
+
+time::milliseconds
+Consumer::GetInterestLifeTime(Time rto) const
+{
+  Time lifetime = m_interestLifeTime;
+  if (m_lifeTimeRtoFactor > 0.0) {
+    lifetime = std::min(lifetime, Time::FromDouble(rto.ToDouble(Time::S) * m_lifeTimeRtoFactor,
+                                                   Time::S));
+    lifetime = std::max(lifetime, m_minInterestLifeTime);
+  }
+  // rounded up, not to expire before the retransmission
+  return time::milliseconds((lifetime.GetMicroSeconds() + 999) / 1000);
+}
+
 void
-Consumer::WaitBeforeSendOutInterest(uint32_t sequenceNumber, Name name)
+Consumer::WaitBeforeSendOutInterest(uint32_t sequenceNumber, shared_ptr<const Interest>& interest)
 {
+	  Name name = interest->getName();
 	  NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-	                                << m_seqTimeouts.size() << " items");
+	                                << m_seqTable.size() << " items");
 
 	  //Save the time of interest with sequence number
-	  //m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-	  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-	  m_seqLastDelay.erase(sequenceNumber);
-	  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-	  m_seqRetxCounts[sequenceNumber]++;
+	  ConsumerSeqTable::Entry& entry = RecordTransmission(sequenceNumber);
 
 	  Time rto;
 
@@ -435,35 +604,45 @@ Consumer::WaitBeforeSendOutInterest(uint32_t sequenceNumber, Name name)
 	  // an retransmitted interest
 	  if(rto.ToDouble(Time::S) == 0.0)
 	  {
-		  //cout<<"@@@@@@@@@@@@@@@@@@"<<endl;
-		  if(!m_isSameWithLastInterest)
+		  //When the interest is sent the 1st time
+		  switch (m_rtoPolicy)
 		  {
-			  //When the interest is sent the 1st time
-			  //1、Get RTO by Correlativity
-			  rto = m_rtt->CalRTObyCorrelativity(name);
+		  case RTO_CORRELATIVITY:
+			  if(!m_isSameWithLastInterest)
+			  {
+				  //1、Get RTO by Correlativity
+				  rto = m_rtt->CalRTObyCorrelativity(name);
+			  }
+			  else
+			  {
+				  //TCP RTO
+				  NS_LOG_DEBUG("Same prefix as the last Interest, RTO by TCP method");
+				  rto = m_rtt->RetransmitTimeout();
+			  }
+			  break;
+		  case RTO_HISTORY:
 			  //2、Get RTO by History
-			  //rto = m_rtt->CalRTObyHistory();
-		  }
-		  else
-		  {
-			  //TCP RTO
-			  cout<<"***********************************"<<endl;
+			  rto = m_rtt->CalRTObyHistory();
+			  break;
+		  case RTO_TCP:
+			  //3、Get RTO by TCP Method
 			  rto = m_rtt->RetransmitTimeout();
+			  break;
 		  }
 	  }
+	  if (m_lifeTimeRtoFactor > 0.0) {
+		  time::milliseconds lifetime = GetInterestLifeTime(rto);
+		  if (lifetime != interest->getInterestLifetime())
+			  interest = InterestTemplate::refreshNonce(*interest, interest->getNonce(), lifetime);
+	  }
+	  entry.interest = interest;
 
-	  //==================================================================================
-	  //3、Get RTO by TCP Method
-	  //rto = m_rtt->RetransmitTimeout();
-	  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()+rto));
+	  entry.rto = rto;
+	  m_seqTable.setDeadline(entry, Simulator::Now() + rto);
+	  ScheduleRetxTimeout();
 	  m_rtt->SetInterestInfo(name, SequenceNumber32(sequenceNumber), 1, rto);
 
-	  cout<<"Node="<<GetNode()->GetId()
-			  <<", Send Interest="<<name
-			  <<", Seq="<<sequenceNumber
-			  <<", RTO="<<rto.ToDouble(Time::MS)<<"ms"
-			  <<", Time="<<Simulator::Now().ToDouble(Time::MS)
-			  <<"ms"<<endl;
+	  m_interestSent(this, name, sequenceNumber, rto);
 }
 
 void
@@ -477,16 +656,40 @@ Consumer::SetPrefix(string pre)
 	//cout<<m_interestName<<endl;
 }
 
+const InterestTemplate&
+Consumer::GetInterestTemplate(const Name& prefix, time::milliseconds lifetime)
+{
+  std::unordered_map<Name, InterestTemplate>::iterator i = m_interestTemplates.find(prefix);
+  if (i != m_interestTemplates.end()) {
+    if (i->second.getInterestLifetime() == lifetime)
+      return i->second;
+    m_interestTemplates.erase(i);
+  }
+
+  // bound the cache for apps that request many different prefixes
+  if (m_interestTemplates.size() >= MAX_INTEREST_TEMPLATES)
+    m_interestTemplates.clear();
+
+  return m_interestTemplates.emplace(prefix, InterestTemplate(prefix, lifetime)).first->second;
+}
+
+int64_t
+Consumer::AssignStreams(int64_t stream)
+{
+  m_rand->SetStream(stream);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------------------------
 void
 Consumer::SetRetxNumber(uint32_t num)
 {
-	m_retxNum = num;
+	m_retxController->SetMaxTransmissions(num);
 }
 uint32_t
 Consumer::GetRetxNumber() const
 {
-	return m_retxNum;
+	return m_retxController->GetMaxTransmissions();
 }
 
 //=======================================================
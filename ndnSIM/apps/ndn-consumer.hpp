@@ -30,17 +30,15 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-controller.hpp"
+#include "ns3/ndnSIM/utils/ndn-consumer-seq-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-interest-template.hpp"
 //#include "ndn-rtt-mean-deviation.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
 #include "ns3/mobility-module.h"
 
 #include <set>
-#include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <unordered_map>
 
 //-----------------------------------------------------------------------------
 //Yuwei
@@ -72,6 +70,17 @@ public:
   virtual void
   OnData(shared_ptr<const Data> contentObject);
 
+  /**
+   * @brief Reacts to a Nack for the last transmission of a sequence number
+   *
+   * A Nack~Congestion defers the retransmission by one RTO, which then happens on the timeout
+   * path, backing off the RTO.  Any other reason, e.g. NoRoute from a node whose route is gone,
+   * triggers an immediate retransmission (if the retransmission controller still allows one)
+   * without backing off, as the Nack tells that the Interest was not lost to congestion.
+   */
+  virtual void
+  OnNack(shared_ptr<const lp::Nack> nack);
+
   /**
    * @brief Timeout event
    * @param sequenceNumber time outed sequence number
@@ -79,6 +88,12 @@ public:
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  /**
+   * @brief Retransmits the sequence number, or gives it up if the controller refuses
+   */
+  void
+  Retransmit(uint32_t sequenceNumber);
+
   /**
    * @brief Actually send packet
    */
@@ -100,22 +115,94 @@ public:
 
   //=======================================================
   //Yuwei
+  /**
+   * @brief Records the transmission of the Interest and sets its RTO
+   *
+   * If the lifetime follows the RTO (see LifeTimeRtoFactor), \p interest is replaced by a copy
+   * with that lifetime, which is the one to send.
+   */
   virtual void
-  WaitBeforeSendOutInterest(uint32_t sequenceNumber, Name name);
+  WaitBeforeSendOutInterest(uint32_t sequenceNumber, shared_ptr<const Interest>& interest);
+
+  /**
+   * @brief Lifetime of an Interest transmitted with the RTO
+   */
+  time::milliseconds
+  GetInterestLifeTime(Time rto) const;
 
   void
   SetPrefix(string pre);
   //=======================================================
-  //Set the number of retransmit for every interest
+  //Set the number of transmissions for every interest (MaxTransmissions of the controller)
   void
   SetRetxNumber(uint32_t num);
 
   uint32_t
   GetRetxNumber() const;
   //=======================================================
+
+  /**
+   * \brief Assign a fixed random variable stream number to the random variables used by the app
+   * \param stream first stream index to use
+   * \return number of stream indices used
+   */
+  virtual int64_t
+  AssignStreams(int64_t stream);
+
+  /**
+   * \brief How RTO of the first transmission of an Interest is calculated
+   */
+  enum RtoPolicy {
+    RTO_CORRELATIVITY, ///< \brief RttEstimator::CalRTObyCorrelativity (TCP RTO for the same prefix)
+    RTO_HISTORY,       ///< \brief RttEstimator::CalRTObyHistory
+    RTO_TCP            ///< \brief RttEstimator::RetransmitTimeout
+  };
+
+  /**
+   * \brief Replaces RTT estimator with a new one of the given type
+   */
+  void
+  SetRttEstimatorType(TypeId type);
+
+  TypeId
+  GetRttEstimatorType() const;
+
+  Ptr<RttEstimator>
+  GetRttEstimator() const
+  {
+    return m_rtt;
+  }
+
+  /**
+   * \brief Replaces retransmission controller with a new one of the given type
+   */
+  void
+  SetRetxControllerType(TypeId type);
+
+  TypeId
+  GetRetxControllerType() const;
+
+  Ptr<RetxController>
+  GetRetxController() const
+  {
+    return m_retxController;
+  }
+
+  /**
+   * \brief Get approximate number of bytes used by the RTT estimator and per-Interest state
+   */
+  virtual size_t
+  GetMemoryUsage() const;
+
 public:
   typedef void (*LastRetransmittedInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
   typedef void (*FirstInterestDataDelayCallback)(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount);
+  typedef void (*InterestSentCallback)(Ptr<App> app, const Name& name, uint32_t seqno, Time rto);
+  typedef void (*DataReceivedCallback)(Ptr<App> app, const Name& name, uint32_t seqno);
+
+  typedef void (*TimeoutCallback)(Ptr<App> app, uint32_t seqno, Time rto);
+
+  typedef void (*InterestGivenUpCallback)(Ptr<App> app, uint32_t seqno);
 
 protected:
   // from App
@@ -138,9 +225,31 @@ protected:
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Returns pre-encoded Interest template for the prefix (created on first use)
+   */
+  const InterestTemplate&
+  GetInterestTemplate(const Name& prefix, time::milliseconds lifetime);
+
+  /**
+   * \brief Updates send times and transmission count of the sequence number in m_seqTable
+   */
+  ConsumerSeqTable::Entry&
+  RecordTransmission(uint32_t sequenceNumber);
+
+  /**
+   * \brief Schedules CheckRetxTimeout at the earliest deadline in m_seqTable
+   *
+   * Must be called after a deadline in m_seqTable is set or removed. Nothing is scheduled when no Interest is
+   * outstanding.
+   */
+  void
+  ScheduleRetxTimeout();
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
+   * \deprecated Retransmission timeouts are checked exactly at their deadlines
    */
   void
   SetRetxTimer(Time retxTimer);
@@ -160,18 +269,23 @@ protected:
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
   EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  Time m_retxDeadline; ///< @brief Time for which m_retxEvent is scheduled
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
   //Ptr<RttMeanDeviation> m_rtt;
+  Ptr<RetxController> m_retxController; ///< @brief decides whether to retransmit timed out Interests
 
   Time m_offTime;          ///< \brief Time interval between packets
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
+  Time m_minInterestLifeTime; ///< \brief lower bound of lifetimes that follow the RTO
+  double m_lifeTimeRtoFactor; ///< \brief lifetime in RTOs, 0 for the fixed m_interestLifeTime
 
   //----------------------------------------------------------------------------------
   //Yuwei
-  uint32_t m_retxNum;        ///number of retransmit for every interest
   bool m_isSameWithLastInterest;
+  RtoPolicy m_rtoPolicy;     ///< \brief how RTO of the first transmission is calculated
+  bool m_shareCorrelativity; ///< \brief use correlativity knowledge base of the node
 
   /// @cond include_hidden
   /**
@@ -182,60 +296,23 @@ protected:
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
+  ConsumerSeqTable m_seqTable; ///< \brief send times, retransmission deadlines and counts per seq
 
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  std::unordered_map<Name, InterestTemplate> m_interestTemplates; ///< \brief templates per prefix
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */,
                  uint32_t /*retx count*/, int32_t /*hop count*/> m_firstInterestDataDelay;
 
+  TracedCallback<Ptr<App> /* app */, const Name& /* name */, uint32_t /* seqno */, Time /* rto */>
+    m_interestSent;
+  TracedCallback<Ptr<App> /* app */, const Name& /* name */, uint32_t /* seqno */> m_dataReceived;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* rto */> m_timeout;
+
+  TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */> m_interestGivenUp;
+
   /// @endcond
 };
 
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-multi-prefix-producer.hpp"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "model/ndn-app-face.hpp"
+#include "model/ndn-ns3.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "utils/ndn-virtual-payload.hpp"
+
+#include <memory>
+#include <sstream>
+
+#include <boost/lexical_cast.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MultiPrefixProducer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(MultiPrefixProducer);
+
+TypeId
+MultiPrefixProducer::GetTypeId(void)
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::MultiPrefixProducer")
+      .SetGroupName("Ndn")
+      .SetParent<App>()
+      .AddConstructor<MultiPrefixProducer>()
+      .AddAttribute("Prefixes",
+                    "Whitespace separated prefixes for which producer has the data, each as "
+                    "<prefix>[,<payload size>[,<freshness>]]",
+                    StringValue(""), MakeStringAccessor(&MultiPrefixProducer::SetPrefixes,
+                                                        &MultiPrefixProducer::GetPrefixes),
+                    MakeStringChecker())
+      .AddAttribute("PayloadSize",
+                    "Virtual payload size for Content packets of prefixes without their own",
+                    UintegerValue(1024),
+                    MakeUintegerAccessor(&MultiPrefixProducer::m_virtualPayloadSize),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("VirtualPayload",
+                    "If true, the payload is not encoded in the Data content, but carried as "
+                    "zero-filled area of the ns-3 packet, which takes no memory in caches",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&MultiPrefixProducer::m_isVirtualPayload),
+                    MakeBooleanChecker())
+      .AddAttribute("Freshness",
+                    "Freshness of data packets of prefixes without their own, if 0, then "
+                    "unlimited freshness",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&MultiPrefixProducer::m_freshness),
+                    MakeTimeChecker())
+      .AddAttribute(
+         "Signature",
+         "Fake signature, 0 valid signature (default), other values application-specific",
+         UintegerValue(0), MakeUintegerAccessor(&MultiPrefixProducer::m_signature),
+         MakeUintegerChecker<uint32_t>())
+      .AddAttribute("KeyLocator",
+                    "Name to be used for key locator.  If root, then key locator is not used",
+                    NameValue(), MakeNameAccessor(&MultiPrefixProducer::m_keyLocator),
+                    MakeNameChecker());
+  return tid;
+}
+
+MultiPrefixProducer::MultiPrefixProducer()
+  : m_trie(1, TrieNode{std::map<name::Component, size_t>(), -1})
+  , m_virtualPayloadSize(1024)
+  , m_isVirtualPayload(false)
+  , m_signature(0)
+{
+  NS_LOG_FUNCTION_NOARGS();
+}
+
+void
+MultiPrefixProducer::SetPrefixes(std::string prefixes)
+{
+  m_prefixes = prefixes;
+  m_entries.clear();
+  m_trie.assign(1, TrieNode{std::map<name::Component, size_t>(), -1});
+
+  std::istringstream is(prefixes);
+  std::string item;
+  while (is >> item) {
+    std::istringstream fields(item);
+    std::string prefix, payloadSize, freshness;
+    std::getline(fields, prefix, ',');
+    std::getline(fields, payloadSize, ',');
+    std::getline(fields, freshness, ',');
+
+    Entry entry;
+    entry.prefix = Name(prefix);
+    entry.hasPayloadSize = !payloadSize.empty();
+    entry.payloadSize = entry.hasPayloadSize ? boost::lexical_cast<uint32_t>(payloadSize) : 0;
+    entry.hasFreshness = !freshness.empty();
+    entry.freshness = entry.hasFreshness ? Time(freshness) : Time();
+    AddEntry(entry);
+  }
+}
+
+std::string
+MultiPrefixProducer::GetPrefixes() const
+{
+  return m_prefixes;
+}
+
+void
+MultiPrefixProducer::AddPrefix(const Name& prefix, uint32_t payloadSize, Time freshness)
+{
+  AddEntry(Entry{prefix, payloadSize, freshness, true, true});
+}
+
+void
+MultiPrefixProducer::AddPrefix(const Name& prefix)
+{
+  AddEntry(Entry{prefix, 0, Time(), false, false});
+}
+
+void
+MultiPrefixProducer::AddEntry(const Entry& entry)
+{
+  size_t node = 0;
+  for (const name::Component& component : entry.prefix) {
+    std::map<name::Component, size_t>::iterator child = m_trie[node].children.find(component);
+    if (child != m_trie[node].children.end()) {
+      node = child->second;
+      continue;
+    }
+
+    size_t next = m_trie.size();
+    m_trie[node].children[component] = next;
+    m_trie.push_back(TrieNode{std::map<name::Component, size_t>(), -1}); // may move m_trie[node]
+    node = next;
+  }
+
+  if (m_trie[node].entry >= 0) {
+    m_entries[m_trie[node].entry] = entry;
+  }
+  else {
+    m_trie[node].entry = m_entries.size();
+    m_entries.push_back(entry);
+  }
+}
+
+const MultiPrefixProducer::Entry*
+MultiPrefixProducer::FindLongestPrefix(const Name& name) const
+{
+  size_t node = 0;
+  int match = m_trie[0].entry;
+  for (const name::Component& component : name) {
+    std::map<name::Component, size_t>::const_iterator child = m_trie[node].children.find(component);
+    if (child == m_trie[node].children.end())
+      break;
+    node = child->second;
+    if (m_trie[node].entry >= 0)
+      match = m_trie[node].entry;
+  }
+
+  return match >= 0 ? &m_entries[match] : 0;
+}
+
+bool
+MultiPrefixProducer::IsCovered(const Entry& entry) const
+{
+  if (entry.prefix.empty())
+    return false;
+
+  const Entry* cover = FindLongestPrefix(entry.prefix.getPrefix(-1));
+  return cover != 0;
+}
+
+// inherited from Application base class.
+void
+MultiPrefixProducer::StartApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  App::StartApplication();
+
+  for (const Entry& entry : m_entries) {
+    // Interests under a covered prefix come through the route of the covering one
+    if (IsCovered(entry))
+      continue;
+    FibHelper::AddRoute(GetNode(), entry.prefix, m_face, 0);
+  }
+}
+
+void
+MultiPrefixProducer::StopApplication()
+{
+  NS_LOG_FUNCTION_NOARGS();
+
+  App::StopApplication();
+}
+
+void
+MultiPrefixProducer::OnInterest(shared_ptr<const Interest> interest)
+{
+  App::OnInterest(interest); // tracing inside
+
+  NS_LOG_FUNCTION(this << interest);
+
+  if (!m_active)
+    return;
+
+  const Entry* entry = FindLongestPrefix(interest->getName());
+  if (entry == 0) {
+    NS_LOG_DEBUG("No prefix for " << interest->getName() << ", Interest dropped");
+    return;
+  }
+
+  uint32_t payloadSize = entry->hasPayloadSize ? entry->payloadSize : m_virtualPayloadSize;
+  Time freshness = entry->hasFreshness ? entry->freshness : m_freshness;
+
+  auto data = make_shared<Data>();
+  data->setName(interest->getName());
+  data->setFreshnessPeriod(::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+
+  data->setContent(::ndn::makeBuffer(m_isVirtualPayload ? 0 : payloadSize));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+
+  data->setSignature(signature);
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+
+  // to create real wire encoding
+  data->wireEncode();
+  if (m_isVirtualPayload)
+    setVirtualPayload(*data, payloadSize);
+
+  m_transmittedDatas(data, this, m_face);
+  m_face->onReceiveData(*data);
+}
+
+} // namespace ndn
+} // namespace ns3
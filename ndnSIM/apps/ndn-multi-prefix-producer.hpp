@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MULTI_PREFIX_PRODUCER_H
+#define NDN_MULTI_PREFIX_PRODUCER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-app.hpp"
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Interest-sink application serving a set of prefixes through one face
+ *
+ * Every Interest is answered with Data of the same name, whose payload size and freshness are
+ * those of the longest registered prefix of the name.  Interests that match no prefix are
+ * dropped.  A single face and a single FIB entry per prefix (none for prefixes that are
+ * covered by another one) replace one Producer per prefix.
+ *
+ * Prefixes are given by the Prefixes attribute, a whitespace separated list of entries
+ * <prefix>[,<payload size>[,<freshness>]], e.g. "/S/addr_0/A/app_0,1024,2s /S/addr_1/A/app_0".
+ * Missing values are taken from the PayloadSize and Freshness attributes.  Setting Prefixes
+ * replaces all prefixes, more can be added with AddPrefix before the application starts.
+ */
+class MultiPrefixProducer : public App {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  MultiPrefixProducer();
+
+  /**
+   * @brief Serves Data under the prefix with the payload size and freshness
+   *
+   * Adding a prefix again replaces its payload size and freshness.
+   */
+  void
+  AddPrefix(const Name& prefix, uint32_t payloadSize, Time freshness);
+
+  /**
+   * @brief Serves Data under the prefix with default payload size and freshness
+   */
+  void
+  AddPrefix(const Name& prefix);
+
+  size_t
+  GetNPrefixes() const
+  {
+    return m_entries.size();
+  }
+
+  // inherited from NdnApp
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest);
+
+protected:
+  // inherited from Application base class.
+  virtual void
+  StartApplication(); // Called at time specified by Start
+
+  virtual void
+  StopApplication(); // Called at time specified by Stop
+
+private:
+  struct Entry {
+    Name prefix;
+    uint32_t payloadSize;
+    Time freshness;
+    bool hasPayloadSize; // otherwise PayloadSize attribute
+    bool hasFreshness;   // otherwise Freshness attribute
+  };
+
+  // node of the prefix trie, children by next name component
+  struct TrieNode {
+    std::map<name::Component, size_t> children;
+    int entry; // index in m_entries, -1 if no prefix ends here
+  };
+
+  void
+  SetPrefixes(std::string prefixes);
+
+  std::string
+  GetPrefixes() const;
+
+  void
+  AddEntry(const Entry& entry);
+
+  /**
+   * @brief Returns the entry of the longest registered prefix of the name, 0 if none
+   */
+  const Entry*
+  FindLongestPrefix(const Name& name) const;
+
+  /**
+   * @brief Whether a shorter registered prefix covers the prefix of the entry
+   */
+  bool
+  IsCovered(const Entry& entry) const;
+
+private:
+  std::vector<Entry> m_entries;
+  std::vector<TrieNode> m_trie; // m_trie[0] is the root
+
+  std::string m_prefixes; // Prefixes attribute as set
+  uint32_t m_virtualPayloadSize;
+  bool m_isVirtualPayload;
+  Time m_freshness;
+
+  uint32_t m_signature;
+  Name m_keyLocator;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MULTI_PREFIX_PRODUCER_H
@@ -21,6 +21,8 @@
 #include "ns3/log.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
@@ -28,6 +30,12 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-virtual-payload.hpp"
+
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/crypto.hpp>
 
 #include <memory>
 
@@ -55,6 +63,11 @@ Producer::GetTypeId(void)
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
                     MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
                     MakeUintegerChecker<uint32_t>())
+      .AddAttribute("VirtualPayload",
+                    "If true, the payload is not encoded in the Data content, but carried as "
+                    "zero-filled area of the ns-3 packet, which takes no memory in caches",
+                    BooleanValue(false), MakeBooleanAccessor(&Producer::m_isVirtualPayload),
+                    MakeBooleanChecker())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
                     TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
                     MakeTimeChecker())
@@ -65,15 +78,73 @@ Producer::GetTypeId(void)
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker())
+      .AddAttribute("Signing",
+                    "How Data packets are signed: Fake (type 255 signature with the Signature "
+                    "attribute as value), DigestSha256 or HmacSha256 (keyed with HmacKey)",
+                    EnumValue(SIGNING_FAKE), MakeEnumAccessor(&Producer::m_signingMode),
+                    MakeEnumChecker(SIGNING_FAKE, "Fake",
+                                    SIGNING_DIGEST_SHA256, "DigestSha256",
+                                    SIGNING_HMAC_SHA256, "HmacSha256"))
+      .AddAttribute("HmacKey", "Shared key of HmacSha256 signatures", StringValue("ndnSIM"),
+                    MakeStringAccessor(&Producer::m_hmacKey), MakeStringChecker())
+      .AddAttribute("ResponseCacheSize",
+                    "Number of encoded Data packets kept to answer repeated Interests, 0 disables "
+                    "the cache",
+                    UintegerValue(256), MakeUintegerAccessor(&Producer::SetResponseCacheSize,
+                                                             &Producer::GetResponseCacheSize),
+                    MakeUintegerChecker<uint32_t>());
   return tid;
 }
 
 Producer::Producer()
+  : m_isVirtualPayload(false)
+  , m_signingMode(SIGNING_FAKE)
+  , m_responseCache(256)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
 
+void
+Producer::SetResponseCacheSize(uint32_t size)
+{
+  m_responseCache.setCapacity(size);
+}
+
+uint32_t
+Producer::GetResponseCacheSize() const
+{
+  return m_responseCache.getCapacity();
+}
+
+void
+Producer::BuildResponseTemplate()
+{
+  m_content = Block(::ndn::tlv::Content,
+                    ::ndn::makeBuffer(m_isVirtualPayload ? 0 : m_virtualPayloadSize));
+  m_content.encode();
+
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (m_keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(m_keyLocator);
+  }
+  signatureInfo.wireEncode(); // kept inside the info, copied with the signature
+
+  m_fakeSignature = Signature();
+  m_fakeSignature.setInfo(signatureInfo);
+  m_fakeSignature.setValue(
+    ::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+
+  m_hmacSignatureInfo = SignatureInfo(::ndn::tlv::SignatureHmacWithSha256);
+  if (m_keyLocator.size() > 0) {
+    m_hmacSignatureInfo.setKeyLocator(m_keyLocator);
+  }
+  m_hmacSignatureInfo.wireEncode();
+
+  m_responseCache.clear();
+}
+
 // inherited from Application base class.
 void
 Producer::StartApplication()
@@ -81,6 +152,9 @@ Producer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  // attributes do not change after start, so neither do content and signature of the Data
+  BuildResponseTemplate();
+
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
 }
 
@@ -95,6 +169,7 @@ Producer::StopApplication()
 void
 Producer::OnInterest(shared_ptr<const Interest> interest)
 {
+  NDN_ALLOCATION_SCOPE(APPS);
   App::OnInterest(interest); // tracing inside
 
   NS_LOG_FUNCTION(this << interest);
@@ -107,6 +182,18 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   //cout<<"Receive Interest="<<interest->getName()<<endl;
   //-----------------------------------------------------------------------------
 
+  shared_ptr<const Data> cached = m_responseCache.find(interest->getName());
+  if (cached != nullptr) {
+    // a copy shares the encoding, but has its own fields for the forwarder to set
+    auto data = make_shared<Data>(*cached);
+
+    NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with cached Data: "
+                        << data->getName());
+    m_transmittedDatas(data, this, m_face);
+    m_face->onReceiveData(*data);
+    return;
+  }
+
   Name dataName(interest->getName());
   // dataName.append(m_postfix);
   // dataName.appendVersion();
@@ -115,27 +202,44 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  // payload and signature info are encoded once, only name and meta info are encoded here
+  data->setContent(m_content);
 
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
+  // to create real wire encoding
+  if (m_signingMode == SIGNING_FAKE) {
+    data->setSignature(m_fakeSignature);
+    data->wireEncode();
+  }
+  else {
+    SignData(*data);
   }
+  if (m_isVirtualPayload)
+    setVirtualPayload(*data, m_virtualPayloadSize);
+  m_responseCache.insert(make_shared<Data>(*data));
 
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+  m_transmittedDatas(data, this, m_face);
+  m_face->onReceiveData(*data);
+}
 
-  data->setSignature(signature);
+void
+Producer::SignData(Data& data)
+{
+  if (m_signingMode == SIGNING_DIGEST_SHA256) {
+    StackHelper::getKeyChain().sign(data, ::ndn::signingWithSha256());
+    return;
+  }
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+  data.setSignature(Signature(m_hmacSignatureInfo));
 
-  // to create real wire encoding
-  data->wireEncode();
+  ::ndn::EncodingBuffer encoder;
+  data.wireEncode(encoder, true);
 
-  m_transmittedDatas(data, this, m_face);
-  m_face->onReceiveData(*data);
+  Block sigValue(::ndn::tlv::SignatureValue,
+                 ::ndn::crypto::hmacSha256(reinterpret_cast<const uint8_t*>(m_hmacKey.data()),
+                                           m_hmacKey.size(), encoder.buf(), encoder.size()));
+  data.wireEncode(encoder, sigValue);
 }
 
 } // namespace ndn
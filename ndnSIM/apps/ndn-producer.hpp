@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-response-cache.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -47,6 +48,16 @@ namespace ndn {
  * with Data packet with a specified size and name same as in Interest.
  */
 class Producer : public App {
+public:
+  /**
+   * @brief How the Data packets are signed
+   */
+  enum SigningMode {
+    SIGNING_FAKE,          ///< @brief signature of type 255 with the Signature attribute as value
+    SIGNING_DIGEST_SHA256, ///< @brief DigestSha256 computed through KeyChain
+    SIGNING_HMAC_SHA256    ///< @brief HMAC-SHA256 with the HmacKey attribute as shared key
+  };
+
 public:
   static TypeId
   GetTypeId(void);
@@ -65,14 +76,44 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Makes the content and signature shared by all Data of the producer
+   */
+  void
+  BuildResponseTemplate();
+
+  /**
+   * @brief Sign the Data with the configured DigestSha256 or HmacWithSha256 signature
+   *
+   * Name, meta info and signature info are encoded once, into the buffer that then gets the
+   * signature value, so the signed portion is hashed from the final encoding.
+   */
+  void
+  SignData(Data& data);
+
+  void
+  SetResponseCacheSize(uint32_t size);
+
+  uint32_t
+  GetResponseCacheSize() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
   uint32_t m_virtualPayloadSize;
+  bool m_isVirtualPayload;
   Time m_freshness;
 
   uint32_t m_signature;
   Name m_keyLocator;
+  SigningMode m_signingMode;
+  std::string m_hmacKey;
+
+  Block m_content;          // encoded zero payload of m_virtualPayloadSize octets
+  Signature m_fakeSignature; // with encoded SignatureInfo and SignatureValue
+  SignatureInfo m_hmacSignatureInfo; // encoded, with KeyLocator if set
+  DataResponseCache m_responseCache;
 };
 
 } // namespace ndn
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-packet-capture-query.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This program prints the packets of a capture written by ndn::PacketCapture, optionally only
+ * those under a name prefix and within a time range:
+ *
+ *     ./waf --run="ndn-packet-capture-query --input=packets.cap --prefix=/prefix --from=1 --to=2"
+ *
+ * The first query builds the index of the capture and saves it into "<input>.idx"; later queries
+ * skip the parts of the capture outside of the time range or without the prefix.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string prefix = "/";
+  double from = 0;
+  double to = -1;
+  bool countOnly = false;
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Packet capture file", input);
+  cmd.AddValue("prefix", "Print only packets under the prefix", prefix);
+  cmd.AddValue("from", "Print only packets captured at or after this time, in seconds", from);
+  cmd.AddValue("to", "Print only packets captured before this time, in seconds", to);
+  cmd.AddValue("count", "Print only the number of matching packets", countOnly);
+  cmd.Parse(argc, argv);
+
+  if (input.empty()) {
+    std::cerr << "--input must be specified" << std::endl;
+    return 2;
+  }
+
+  try {
+    ndn::PacketCaptureReader reader(input);
+
+    uint64_t nRecords = reader.Query(ndn::Name(prefix), Seconds(from),
+                                     to < 0 ? Time::Max() : Seconds(to),
+                                     [countOnly] (const ndn::PacketCaptureReader::Record& record) {
+                                       if (!countOnly)
+                                         ndn::PacketCaptureReader::PrintRecord(std::cout, record);
+                                     });
+    if (countOnly) {
+      std::cout << nRecords << std::endl;
+    }
+  }
+  catch (const std::runtime_error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,75 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-scenario-sweep.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This program runs all configurations of the sweep of a scenario description file (see
+ * ndn::ScenarioDescription) in parallel, each in its own output directory.
+ *
+ * The default scenario is ndn-simple with a sweep of the Interest frequency, the forwarding
+ * strategy and the RngRun:
+ *
+ *     ./waf --run="ndn-scenario-sweep --output=results --jobs=4"
+ *
+ * Trace files of configuration <i> are written to results/<i>/, and results/sweep.txt lists
+ * the parameters of all configurations.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string scenarioFile = "src/ndnSIM/examples/scenarios/ndn-simple-sweep.info";
+  std::string outputDir = "results";
+  uint32_t nJobs = 0;
+
+  CommandLine cmd;
+  cmd.AddValue("scenario", "Scenario description file", scenarioFile);
+  cmd.AddValue("output", "Output directory", outputDir);
+  cmd.AddValue("jobs", "Number of configurations running at the same time, 0 for all cores",
+               nJobs);
+  cmd.Parse(argc, argv);
+
+  ndn::ScenarioDescription scenario(scenarioFile);
+  ndn::ParameterSweep sweep(scenario);
+  sweep.setNProcesses(nJobs);
+
+  size_t nFailed = sweep.run(outputDir);
+  if (nFailed > 0) {
+    std::cerr << nFailed << " configurations failed, see " << outputDir << "/sweep.txt"
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
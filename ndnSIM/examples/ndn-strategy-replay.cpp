@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-strategy-replay.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * This scenario records the strategy triggers of the router in the topology of ndn-simple
+ * (consumer <-> router <-> producer) to a binary trace, or replays such a trace against a
+ * strategy and reports its calls, CPU time and forwarding decisions.
+ *
+ * To record, and then replay the trace against other strategies:
+ *
+ *     ./waf --run="ndn-strategy-replay --record=strategy-trace.bin"
+ *     ./waf --run="ndn-strategy-replay --replay=strategy-trace.bin
+ *                  --strategy=/localhost/nfd/strategy/ncc"
+ *
+ * Traces recorded with StrategyTracer in other scenarios can be replayed in the same way.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string record = "strategy-trace.bin";
+  std::string replay;
+  std::string strategy = "/localhost/nfd/strategy/best-route";
+  std::string decisions;
+
+  CommandLine cmd;
+  cmd.AddValue("record", "File to record the strategy trace of the router to", record);
+  cmd.AddValue("replay", "Strategy trace to replay instead of running the scenario", replay);
+  cmd.AddValue("strategy", "Strategy to run the scenario with, or to replay against", strategy);
+  cmd.AddValue("decisions", "File to write the decisions of a replay to", decisions);
+  cmd.Parse(argc, argv);
+
+  if (!replay.empty()) {
+    ndn::StrategyReplay strategyReplay(strategy);
+    if (!decisions.empty()) {
+      strategyReplay.SetDecisionStream(make_shared<std::ofstream>(decisions.c_str()));
+    }
+    strategyReplay.Load(replay);
+
+    Simulator::Run();
+    strategyReplay.PrintReport(std::cout);
+    Simulator::Destroy();
+    return 0;
+  }
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  ndn::StrategyChoiceHelper::InstallAll("/prefix", strategy);
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("10"));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  ndn::StrategyTracer::Install(nodes.Get(1), record);
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
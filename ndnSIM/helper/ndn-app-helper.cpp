@@ -23,10 +23,9 @@
 #include "ns3/names.h"
 
 #include "apps/ndn-app.hpp"
+#include "apps/ndn-consumer.hpp"
 
-#ifdef NS3_MPI
-#include "ns3/mpi-interface.h"
-#endif
+#include "utils/ndn-mpi.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.AppHelper");
 
@@ -81,15 +80,25 @@ AppHelper::Install(NodeContainer c)
   return apps;
 }
 
+int64_t
+AppHelper::AssignStreams(ApplicationContainer apps, int64_t stream)
+{
+  int64_t currentStream = stream;
+  for (ApplicationContainer::Iterator i = apps.Begin(); i != apps.End(); ++i) {
+    Ptr<Consumer> consumer = DynamicCast<Consumer>(*i);
+    if (consumer != 0)
+      currentStream += consumer->AssignStreams(currentStream);
+  }
+  return currentStream - stream;
+}
+
 Ptr<Application>
 AppHelper::InstallPriv(Ptr<Node> node)
 {
-#ifdef NS3_MPI
-  if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
+  if (!mpi::IsLocalNode(node)) {
     // don't create an app if MPI is enabled and node is not in the correct partition
     return 0;
   }
-#endif
 
   Ptr<Application> app = m_factory.Create<Application>();
   node->AddApplication(app);
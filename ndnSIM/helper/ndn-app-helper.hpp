@@ -91,6 +91,19 @@ public:
   ApplicationContainer
   Install(std::string nodeName);
 
+  /**
+   * @brief Assign fixed random variable stream numbers to the consumer applications
+   *
+   * Applications other than ns3::ndn::Consumer are skipped.  Should be called after all
+   * attributes of the applications are set.
+   *
+   * @param apps   applications, as returned by Install
+   * @param stream first stream index to use
+   * @returns number of stream indices used
+   */
+  static int64_t
+  AssignStreams(ApplicationContainer apps, int64_t stream);
+
 private:
   /**
    * \internal
@@ -0,0 +1,392 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-binary-mobility-helper.hpp"
+
+#include "utils/ndn-shared-input.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.BinaryMobilityHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace binary_mobility {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'M', 'O', 'B', '1', '\0'};
+
+enum RecordType : uint32_t {
+  SET_X = 0,
+  SET_Y = 1,
+  SET_Z = 2,
+  SETDEST = 3 ///< values are x, y and speed
+};
+
+/** \brief a movement, stored as is in the file
+ */
+struct Record
+{
+  double time; ///< seconds, negative for movements applied when the trace is installed
+  uint32_t node;
+  uint32_t type;
+  double values[3];
+};
+
+static_assert(sizeof(Record) == 40, "Record must not be padded");
+
+struct Header
+{
+  char magic[8];
+  uint32_t nNodes;
+  uint32_t reserved;
+  uint64_t nRecords;
+};
+
+static_assert(sizeof(Header) == 24, "Header must not be padded");
+
+/** \brief parse "$node_(<i>)"
+ */
+static bool
+parseNode(const std::string& token, uint32_t& node)
+{
+  const std::string prefix = "$node_(";
+  if (token.compare(0, prefix.size(), prefix) != 0 || token.back() != ')')
+    return false;
+
+  node = boost::lexical_cast<uint32_t>(token.substr(prefix.size(),
+                                                    token.size() - prefix.size() - 1));
+  return true;
+}
+
+/** \brief parse "$node_(<i>) set X_ <v>" or "$node_(<i>) setdest <x> <y> <speed>"
+ *  \return false if it is neither
+ */
+static bool
+parseMovement(const std::vector<std::string>& tokens, size_t first, Record& record)
+{
+  if (tokens.size() < first + 3 || !parseNode(tokens[first], record.node))
+    return false;
+
+  const std::string& command = tokens[first + 1];
+  if (command == "set" && tokens.size() >= first + 4) {
+    const std::string& axis = tokens[first + 2];
+    if (axis == "X_")
+      record.type = SET_X;
+    else if (axis == "Y_")
+      record.type = SET_Y;
+    else if (axis == "Z_")
+      record.type = SET_Z;
+    else
+      return false;
+    record.values[0] = boost::lexical_cast<double>(tokens[first + 3]);
+    record.values[1] = record.values[2] = 0.0;
+    return true;
+  }
+
+  if (command == "setdest" && tokens.size() >= first + 5) {
+    record.type = SETDEST;
+    for (size_t i = 0; i < 3; ++i)
+      record.values[i] = boost::lexical_cast<double>(tokens[first + 2 + i]);
+    return true;
+  }
+
+  return false;
+}
+
+/** \brief reads records of a converted trace window by window, and applies them
+ *
+ *  The trace is mapped read-only, so that replications running in parallel share its pages.
+ */
+class TraceReader : public SimpleRefCount<TraceReader>
+{
+public:
+  TraceReader(const std::string& file, Time window)
+    : m_window(window)
+    , m_hasNext(false)
+  {
+    m_input = SharedInput::Open(file);
+
+    Header header;
+    if (m_input->GetSize() < sizeof(header)) {
+      throw std::runtime_error("File " + file + " is not a converted mobility trace");
+    }
+    std::memcpy(&header, m_input->GetData(), sizeof(header));
+    if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic)) {
+      throw std::runtime_error("File " + file + " is not a converted mobility trace");
+    }
+    m_nNodes = header.nNodes;
+
+    // a truncated trace ends with its last complete record
+    m_records = reinterpret_cast<const Record*>(m_input->GetData() + sizeof(header));
+    m_nRemaining = std::min<uint64_t>(header.nRecords,
+                                      (m_input->GetSize() - sizeof(header)) / sizeof(Record));
+  }
+
+  uint32_t
+  getNNodes() const
+  {
+    return m_nNodes;
+  }
+
+  void
+  start(std::vector<Ptr<ConstantVelocityMobilityModel>> mobilities)
+  {
+    m_mobilities = std::move(mobilities);
+    m_arrivals.resize(m_mobilities.size());
+
+    readNext();
+    while (m_hasNext && m_next.time < 0) {
+      apply(m_next);
+      readNext();
+    }
+    loadWindow();
+  }
+
+private:
+  void
+  readNext()
+  {
+    m_hasNext = m_nRemaining > 0;
+    if (m_hasNext) {
+      m_next = *m_records++;
+      --m_nRemaining;
+    }
+  }
+
+  void
+  loadWindow()
+  {
+    Time end = Simulator::Now() + m_window;
+    while (m_hasNext && Seconds(m_next.time) <= end) {
+      Time delay = std::max(Seconds(m_next.time) - Simulator::Now(), Seconds(0));
+      Simulator::Schedule(delay, &TraceReader::apply, Ptr<TraceReader>(this), m_next);
+      readNext();
+    }
+
+    if (m_hasNext) {
+      // the events keep the reader, and so the mapping, until the end of the trace
+      Simulator::Schedule(Seconds(m_next.time) - m_window - Simulator::Now(),
+                          &TraceReader::loadWindow, Ptr<TraceReader>(this));
+    }
+  }
+
+  void
+  apply(Record record)
+  {
+    if (record.node >= m_mobilities.size() || m_mobilities[record.node] == 0)
+      return;
+
+    Ptr<ConstantVelocityMobilityModel> mobility = m_mobilities[record.node];
+    Vector position = mobility->GetPosition();
+    switch (record.type) {
+    case SET_X:
+      position.x = record.values[0];
+      mobility->SetPosition(position);
+      break;
+    case SET_Y:
+      position.y = record.values[0];
+      mobility->SetPosition(position);
+      break;
+    case SET_Z:
+      position.z = record.values[0];
+      mobility->SetPosition(position);
+      break;
+    case SETDEST: {
+      Simulator::Cancel(m_arrivals[record.node]);
+
+      Vector destination(record.values[0], record.values[1], position.z);
+      double distance = CalculateDistance(position, destination);
+      double speed = record.values[2];
+      if (distance <= 0.0 || speed <= 0.0) {
+        mobility->SetVelocity(Vector(0, 0, 0));
+        break;
+      }
+
+      mobility->SetVelocity(Vector((destination.x - position.x) / distance * speed,
+                                   (destination.y - position.y) / distance * speed, 0));
+      m_arrivals[record.node] = Simulator::Schedule(Seconds(distance / speed),
+                                                    &TraceReader::arrive, Ptr<TraceReader>(this),
+                                                    record.node, destination);
+      break;
+    }
+    default:
+      NS_LOG_WARN("Unknown movement type " << record.type);
+    }
+  }
+
+  void
+  arrive(uint32_t node, Vector destination)
+  {
+    m_mobilities[node]->SetVelocity(Vector(0, 0, 0));
+    m_mobilities[node]->SetPosition(destination);
+  }
+
+private:
+  std::shared_ptr<const SharedInput> m_input;
+  const Record* m_records; ///< next record to read
+  uint32_t m_nNodes;
+  uint64_t m_nRemaining;
+  Time m_window;
+  Record m_next;
+  bool m_hasNext;
+
+  std::vector<Ptr<ConstantVelocityMobilityModel>> m_mobilities; ///< by node index of the trace
+  std::vector<EventId> m_arrivals;                            ///< by node index of the trace
+};
+
+} // namespace binary_mobility
+
+using namespace binary_mobility;
+
+void
+BinaryMobilityHelper::Convert(const std::string& tclFile, const std::string& binaryFile)
+{
+  std::ifstream is(tclFile.c_str());
+  if (!is.is_open()) {
+    throw std::runtime_error("File " + tclFile + " cannot be opened for reading");
+  }
+
+  std::vector<Record> records;
+  uint32_t nNodes = 0;
+  std::string line;
+  for (size_t lineNo = 1; std::getline(is, line); ++lineNo) {
+    line = line.substr(0, line.find('#'));
+    std::replace(line.begin(), line.end(), '"', ' ');
+
+    std::istringstream tokenizer(line);
+    std::vector<std::string> tokens{std::istream_iterator<std::string>(tokenizer),
+                                    std::istream_iterator<std::string>()};
+    if (tokens.empty())
+      continue;
+
+    Record record;
+    try {
+      bool isMovement = false;
+      if (tokens[0] == "$ns_" && tokens.size() > 2 && tokens[1] == "at") {
+        record.time = boost::lexical_cast<double>(tokens[2]);
+        isMovement = parseMovement(tokens, 3, record);
+      }
+      else {
+        record.time = -1.0;
+        isMovement = parseMovement(tokens, 0, record);
+      }
+      if (!isMovement) {
+        NS_LOG_DEBUG(tclFile << ":" << lineNo << ": ignored");
+        continue;
+      }
+    }
+    catch (const boost::bad_lexical_cast&) {
+      throw std::runtime_error(tclFile + ":" + std::to_string(lineNo) + ": malformed number");
+    }
+
+    records.push_back(record);
+    nNodes = std::max(nNodes, record.node + 1);
+  }
+
+  // movements of the same time keep the order of the trace
+  std::stable_sort(records.begin(), records.end(),
+                   [] (const Record& a, const Record& b) { return a.time < b.time; });
+
+  // written aside and renamed, as a previous version may still be mapped by a reader
+  std::string temporaryFile = binaryFile + ".tmp";
+  {
+    std::ofstream os(temporaryFile.c_str(), std::ios_base::out | std::ios_base::trunc |
+                                            std::ios_base::binary);
+    if (!os.is_open()) {
+      throw std::runtime_error("File " + binaryFile + " cannot be opened for writing");
+    }
+
+    Header header;
+    std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+    header.nNodes = nNodes;
+    header.reserved = 0;
+    header.nRecords = records.size();
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    os.flush();
+    if (!os) {
+      std::remove(temporaryFile.c_str());
+      throw std::runtime_error("File " + binaryFile + " cannot be written");
+    }
+  }
+
+  if (std::rename(temporaryFile.c_str(), binaryFile.c_str()) != 0) {
+    std::remove(temporaryFile.c_str());
+    throw std::runtime_error("File " + binaryFile + " cannot be written");
+  }
+}
+
+BinaryMobilityHelper::BinaryMobilityHelper(const std::string& binaryFile)
+  : m_file(binaryFile)
+  , m_window(Seconds(10))
+{
+  m_nNodes = TraceReader(binaryFile, m_window).getNNodes();
+}
+
+void
+BinaryMobilityHelper::SetWindow(Time window)
+{
+  m_window = window;
+}
+
+void
+BinaryMobilityHelper::Install(const NodeContainer& nodes) const
+{
+  Ptr<TraceReader> reader = Create<TraceReader>(m_file, m_window);
+
+  std::vector<Ptr<ConstantVelocityMobilityModel>> mobilities;
+  for (uint32_t i = 0; i < std::min(m_nNodes, nodes.GetN()); ++i) {
+    Ptr<Node> node = nodes.Get(i);
+    Ptr<MobilityModel> model = node->GetObject<MobilityModel>();
+    if (model == 0) {
+      model = CreateObject<ConstantVelocityMobilityModel>();
+      node->AggregateObject(model);
+    }
+
+    Ptr<ConstantVelocityMobilityModel> mobility = DynamicCast<ConstantVelocityMobilityModel>(model);
+    if (mobility == 0) {
+      throw std::invalid_argument("Node " + std::to_string(node->GetId()) +
+                                  " has a MobilityModel other than ConstantVelocityMobilityModel");
+    }
+    mobilities.push_back(mobility);
+  }
+
+  reader->start(std::move(mobilities));
+}
+
+void
+BinaryMobilityHelper::Install() const
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+} // namespace ndn
+} // namespace ns3
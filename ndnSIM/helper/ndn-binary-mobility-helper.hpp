@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BINARY_MOBILITY_HELPER_H
+#define NDN_BINARY_MOBILITY_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Installs ns-2 mobility traces converted to a compact binary format
+ *
+ * ns3::Ns2MobilityHelper parses the whole tcl trace at startup and schedules all of its
+ * movements up front.  For long traces (e.g., exported from SUMO) both take a lot of time and
+ * memory.  Convert() turns the trace into a binary file of fixed-size records sorted by time
+ * once, and this helper reads it while the simulation runs: only movements within the next
+ * window (see SetWindow) are scheduled at any time.  The binary file is mapped read-only (see
+ * SharedInput): replications running in parallel on the same machine share one copy of it.
+ *
+ * The same subset of the ns-2 format as Ns2MobilityHelper supports is understood:
+ *
+ *     $node_(<i>) set X_|Y_|Z_ <value>
+ *     $node_(<i>) setdest <x> <y> <speed>
+ *     $ns_ at <time> "$node_(<i>) set X_|Y_|Z_ <value>"
+ *     $ns_ at <time> "$node_(<i>) setdest <x> <y> <speed>"
+ *
+ * Nodes move with ns3::ConstantVelocityMobilityModel, added to nodes without a MobilityModel.
+ *
+ * Example:
+ *
+ *     ndn::BinaryMobilityHelper::Convert("scene1.tcl", "scene1.mob"); // once
+ *     ...
+ *     ndn::BinaryMobilityHelper mobility("scene1.mob");
+ *     mobility.Install(nodes);
+ */
+class BinaryMobilityHelper {
+public:
+  /**
+   * @brief Convert an ns-2 mobility trace to the binary format
+   * @throw std::runtime_error a file cannot be opened or the trace is malformed
+   */
+  static void
+  Convert(const std::string& tclFile, const std::string& binaryFile);
+
+  /**
+   * @throw std::runtime_error the file cannot be opened or is not a converted trace
+   */
+  explicit
+  BinaryMobilityHelper(const std::string& binaryFile);
+
+  /**
+   * @brief Set how far ahead movements are scheduled (default 10 seconds)
+   */
+  void
+  SetWindow(Time window);
+
+  /**
+   * @brief Number of nodes in the trace, i.e., the largest node index plus one
+   */
+  uint32_t
+  GetNNodes() const
+  {
+    return m_nNodes;
+  }
+
+  /**
+   * @brief Install the trace on the nodes of the container, node i of the trace on the i-th
+   *        node of the container
+   *
+   * Movements of nodes beyond the end of the container are ignored.
+   *
+   * @throw std::invalid_argument a node has a MobilityModel other than
+   *        ConstantVelocityMobilityModel
+   */
+  void
+  Install(const NodeContainer& nodes) const;
+
+  /**
+   * @brief Install the trace on all nodes of the simulation, by node id
+   */
+  void
+  Install() const;
+
+private:
+  std::string m_file;
+  uint32_t m_nNodes;
+  Time m_window;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_MOBILITY_HELPER_H
@@ -0,0 +1,385 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-checkpoint-helper.hpp"
+#include "ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+#include "apps/ndn-consumer.hpp"
+#include "utils/ndn-checkpoint-stream.hpp"
+#include "utils/ndn-virtual-payload.hpp"
+#include "daemon/fw/forwarder.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CheckpointHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'C', 'K', 'P', 'T', '1'};
+
+struct Header
+{
+  char magic[8];
+  uint32_t nNodes;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 16, "Header must not be padded");
+
+void
+saveData(std::ostream& os, const std::vector<shared_ptr<const Data>>& packets)
+{
+  checkpoint::write<uint32_t>(os, packets.size());
+  for (const shared_ptr<const Data>& data : packets) {
+    checkpoint::writeBlock(os, data->wireEncode());
+    checkpoint::write<uint32_t>(os, getVirtualPayloadSize(*data));
+  }
+}
+
+void
+saveContentStore(std::ostream& os, Ptr<Node> node, nfd::Forwarder& forwarder)
+{
+  std::vector<shared_ptr<const Data>> packets;
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  if (contentStore != nullptr) {
+    for (Ptr<cs::Entry> entry = contentStore->Begin(); entry != contentStore->End();
+         entry = contentStore->Next(entry)) {
+      packets.push_back(entry->GetData());
+    }
+  }
+  else {
+    for (const nfd::cs::Entry& entry : forwarder.getCs()) {
+      packets.push_back(entry.getData().shared_from_this());
+    }
+  }
+  saveData(os, packets);
+}
+
+void
+loadContentStore(std::istream& is, Ptr<Node> node, nfd::Forwarder& forwarder)
+{
+  Ptr<ContentStore> contentStore = node->GetObject<ContentStore>();
+  uint32_t nPackets = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nPackets; ++i) {
+    shared_ptr<Data> data = make_shared<Data>(checkpoint::readBlock(is));
+    uint32_t virtualPayloadSize = checkpoint::read<uint32_t>(is);
+    if (virtualPayloadSize > 0)
+      setVirtualPayload(*data, virtualPayloadSize);
+
+    if (contentStore != nullptr)
+      contentStore->Add(data);
+    else
+      forwarder.getCs().insert(*data);
+  }
+}
+
+void
+saveFib(std::ostream& os, nfd::Forwarder& forwarder)
+{
+  std::vector<const nfd::fib::Entry*> entries;
+  for (const nfd::fib::Entry& entry : forwarder.getFib()) {
+    entries.push_back(&entry);
+  }
+
+  checkpoint::write<uint32_t>(os, entries.size());
+  for (const nfd::fib::Entry* entry : entries) {
+    checkpoint::writeBlock(os, entry->getPrefix().wireEncode());
+
+    // routes via application and internal faces are registered again by their owners
+    std::vector<const nfd::fib::NextHop*> nextHops;
+    for (const nfd::fib::NextHop& nextHop : entry->getNextHops()) {
+      if (!nextHop.getFace()->isLocal())
+        nextHops.push_back(&nextHop);
+    }
+
+    checkpoint::write<uint32_t>(os, nextHops.size());
+    for (const nfd::fib::NextHop* nextHop : nextHops) {
+      checkpoint::write<uint64_t>(os, nextHop->getFace()->getId());
+      checkpoint::write<uint64_t>(os, nextHop->getCost());
+    }
+  }
+}
+
+void
+loadFib(std::istream& is, Ptr<Node> node, Ptr<L3Protocol> ndn)
+{
+  uint32_t nEntries = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nEntries; ++i) {
+    Name prefix(checkpoint::readBlock(is));
+    uint32_t nNextHops = checkpoint::read<uint32_t>(is);
+    for (uint32_t j = 0; j < nNextHops; ++j) {
+      nfd::FaceId faceId = checkpoint::read<uint64_t>(is);
+      uint64_t cost = checkpoint::read<uint64_t>(is);
+
+      shared_ptr<Face> face = ndn->getFaceById(faceId);
+      if (face == nullptr) {
+        NS_LOG_WARN("Node " << node->GetId() << " has no face " << faceId
+                    << ", next hop of " << prefix << " is not restored");
+        continue;
+      }
+      FibHelper::AddRoute(node, prefix, face, cost);
+    }
+  }
+}
+
+void
+saveApps(std::ostream& os, Ptr<Node> node)
+{
+  std::vector<uint32_t> consumers;
+  for (uint32_t i = 0; i < node->GetNApplications(); ++i) {
+    Ptr<Consumer> consumer = DynamicCast<Consumer>(node->GetApplication(i));
+    if (consumer != nullptr && consumer->GetRttEstimator() != nullptr)
+      consumers.push_back(i);
+  }
+
+  checkpoint::write<uint32_t>(os, consumers.size());
+  for (uint32_t i : consumers) {
+    Ptr<RttEstimator> rtt = DynamicCast<Consumer>(node->GetApplication(i))->GetRttEstimator();
+    std::ostringstream state;
+    rtt->SaveState(state);
+
+    checkpoint::write<uint32_t>(os, i);
+    checkpoint::writeString(os, rtt->GetInstanceTypeId().GetName());
+    checkpoint::writeString(os, state.str());
+  }
+}
+
+void
+loadApps(std::istream& is, Ptr<Node> node)
+{
+  uint32_t nConsumers = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nConsumers; ++i) {
+    uint32_t index = checkpoint::read<uint32_t>(is);
+    std::string type = checkpoint::readString(is);
+    std::istringstream state(checkpoint::readString(is));
+
+    Ptr<Consumer> consumer = index < node->GetNApplications() ?
+                             DynamicCast<Consumer>(node->GetApplication(index)) : nullptr;
+    Ptr<RttEstimator> rtt = consumer != nullptr ? consumer->GetRttEstimator() : nullptr;
+    if (rtt == nullptr || rtt->GetInstanceTypeId().GetName() != type) {
+      NS_LOG_WARN("Application " << index << " of node " << node->GetId()
+                  << " is not a Consumer with " << type << ", RTT state is not restored");
+      continue;
+    }
+    rtt->LoadState(state);
+  }
+}
+
+} // namespace
+
+void
+CheckpointHelper::Save(const std::string& file)
+{
+  Save(file, NodeContainer::GetGlobal());
+}
+
+void
+CheckpointHelper::Save(const std::string& file, const NodeContainer& nodes)
+{
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc |
+                                 std::ios_base::binary);
+  if (!os.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for writing");
+  }
+
+  std::vector<Ptr<Node>> ndnNodes;
+  std::copy_if(nodes.Begin(), nodes.End(), std::back_inserter(ndnNodes),
+               [] (Ptr<Node> node) { return node->GetObject<L3Protocol>() != nullptr; });
+
+  Header header;
+  std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+  header.nNodes = ndnNodes.size();
+  header.reserved = 0;
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (Ptr<Node> node : ndnNodes) {
+    checkpoint::write<uint32_t>(os, node->GetId());
+    checkpoint::writeString(os, SaveNode(node));
+  }
+
+  if (!os) {
+    throw std::runtime_error("File " + file + " cannot be written");
+  }
+  NS_LOG_INFO("Saved state of " << ndnNodes.size() << " nodes to " << file);
+}
+
+void
+CheckpointHelper::ScheduleSave(Time when, const std::string& file)
+{
+  void (*save)(const std::string&) = &CheckpointHelper::Save;
+  Simulator::Schedule(when, save, file);
+}
+
+void
+CheckpointHelper::Load(const std::string& file)
+{
+  Load(file, NodeContainer::GetGlobal());
+}
+
+void
+CheckpointHelper::Load(const std::string& file, const NodeContainer& nodes)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for reading");
+  }
+
+  Header header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      !std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic)) {
+    throw std::runtime_error("File " + file + " is not a checkpoint");
+  }
+
+  std::set<uint32_t> ids;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    ids.insert((*node)->GetId());
+  }
+
+  uint32_t nRestored = 0;
+  for (uint32_t i = 0; i < header.nNodes; ++i) {
+    uint32_t id = checkpoint::read<uint32_t>(is);
+    std::string state = checkpoint::readString(is);
+    if (id >= NodeList::GetNNodes()) {
+      throw std::runtime_error("Checkpoint " + file + " has node " + std::to_string(id) +
+                               ", which does not exist");
+    }
+    if (ids.count(id) == 0)
+      continue;
+
+    LoadNode(state, NodeList::GetNode(id));
+    ++nRestored;
+  }
+  NS_LOG_INFO("Restored state of " << nRestored << " nodes from " << file);
+}
+
+void
+CheckpointHelper::ScheduleLoad(Time when, const std::string& file)
+{
+  void (*load)(const std::string&) = &CheckpointHelper::Load;
+  Simulator::Schedule(when, load, file);
+}
+
+std::string
+CheckpointHelper::SaveNode(Ptr<Node> node)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  nfd::Forwarder& forwarder = *ndn->getForwarder();
+
+  std::ostringstream os;
+  saveContentStore(os, node, forwarder);
+  saveFib(os, forwarder);
+
+  std::vector<shared_ptr<nfd::measurements::Entry>> entries;
+  for (const nfd::name_tree::Entry& nte : forwarder.getNameTree()) {
+    if (nte.getMeasurementsEntry() != nullptr)
+      entries.push_back(nte.getMeasurementsEntry());
+  }
+
+  const std::map<int, MeasurementsInfoCodec>& codecs = GetMeasurementsInfoCodecs();
+  ::ndn::time::steady_clock::TimePoint now = ::ndn::time::steady_clock::now();
+  checkpoint::write<uint32_t>(os, entries.size());
+  for (const shared_ptr<nfd::measurements::Entry>& entry : entries) {
+    checkpoint::writeBlock(os, entry->getName().wireEncode());
+    checkpoint::write<int64_t>(os, std::max(::ndn::time::nanoseconds::zero(),
+                                            entry->getExpiry() - now).count());
+
+    std::vector<std::pair<int, std::string>> infos;
+    for (const auto& codec : codecs) {
+      std::ostringstream info;
+      if (codec.second.save(*entry, info))
+        infos.emplace_back(codec.first, info.str());
+    }
+    checkpoint::write<uint32_t>(os, infos.size());
+    for (const auto& info : infos) {
+      checkpoint::write<int32_t>(os, info.first);
+      checkpoint::writeString(os, info.second);
+    }
+  }
+
+  saveApps(os, node);
+  return os.str();
+}
+
+void
+CheckpointHelper::LoadNode(const std::string& state, Ptr<Node> node)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  if (ndn == nullptr) {
+    throw std::runtime_error("Node " + std::to_string(node->GetId()) +
+                             " of the checkpoint has no NDN stack");
+  }
+  nfd::Forwarder& forwarder = *ndn->getForwarder();
+
+  std::istringstream is(state);
+  loadContentStore(is, node, forwarder);
+  loadFib(is, node, ndn);
+
+  const std::map<int, MeasurementsInfoCodec>& codecs = GetMeasurementsInfoCodecs();
+  uint32_t nEntries = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nEntries; ++i) {
+    Name name(checkpoint::readBlock(is));
+    ::ndn::time::nanoseconds lifetime(checkpoint::read<int64_t>(is));
+    shared_ptr<nfd::measurements::Entry> entry = forwarder.getMeasurements().get(name);
+    forwarder.getMeasurements().extendLifetime(*entry, lifetime);
+
+    uint32_t nInfos = checkpoint::read<uint32_t>(is);
+    for (uint32_t j = 0; j < nInfos; ++j) {
+      int typeId = checkpoint::read<int32_t>(is);
+      std::istringstream info(checkpoint::readString(is));
+      auto codec = codecs.find(typeId);
+      if (codec == codecs.end()) {
+        NS_LOG_WARN("StrategyInfo type " << typeId << " is not registered, information on "
+                    << name << " is not restored");
+        continue;
+      }
+      codec->second.load(*entry, info);
+    }
+  }
+
+  loadApps(is, node);
+}
+
+void
+CheckpointHelper::RegisterMeasurementsInfo(int typeId, const MeasurementsInfoCodec& codec)
+{
+  GetMeasurementsInfoCodecs()[typeId] = codec;
+}
+
+std::map<int, CheckpointHelper::MeasurementsInfoCodec>&
+CheckpointHelper::GetMeasurementsInfoCodecs()
+{
+  static std::map<int, MeasurementsInfoCodec> codecs;
+  return codecs;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CHECKPOINT_HELPER_H
+#define NDN_CHECKPOINT_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/NFD/daemon/table/measurements-entry.hpp"
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <functional>
+#include <iostream>
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Saves warmed-up forwarder and consumer state to a binary checkpoint and restores it
+ *        in a later run
+ *
+ * A checkpoint holds, for every node with the NDN stack:
+ *  - the Data packets in the content store (the NFD one or the ContentStore set with
+ *    StackHelper::SetOldContentStore), including their virtual payload
+ *  - FIB next hops via non-local faces, by face id
+ *  - Measurements entries with their remaining lifetime, and the strategy information on them
+ *    whose type has been registered with RegisterMeasurementsInfo
+ *  - the RTT estimator state of the Consumer applications, by application index
+ *
+ * Load() is meant for a run that builds the same topology, and installs the stacks and
+ * applications in the same order, so that node ids, face ids and application indexes match.
+ * Times are saved relative to the time of the checkpoint and restored relative to the time of
+ * the restore, so restored state has the same age as it had when it was saved.  Content store
+ * entries become fresh again, and are inserted in name order rather than in the order of the
+ * replacement policy.
+ *
+ * Example:
+ *
+ *     // warm-up run
+ *     ndn::CheckpointHelper::ScheduleSave(Seconds(700), "warm.ckpt");
+ *
+ *     // later runs, starting the consumers right away
+ *     ndn::CheckpointHelper::ScheduleLoad(Seconds(0), "warm.ckpt");
+ */
+class CheckpointHelper {
+public:
+  /**
+   * @brief Save the state of all nodes
+   * @throw std::runtime_error the file cannot be written
+   */
+  static void
+  Save(const std::string& file);
+
+  /**
+   * @brief Save the state of the nodes in the container
+   * @throw std::runtime_error the file cannot be written
+   */
+  static void
+  Save(const std::string& file, const NodeContainer& nodes);
+
+  /**
+   * @brief Schedule Save(file) at the specified time
+   */
+  static void
+  ScheduleSave(Time when, const std::string& file);
+
+  /**
+   * @brief Restore the state saved in the file on the nodes with the same ids
+   *
+   * Next hops via faces that do not exist and applications that are not Consumers with the
+   * same type of RTT estimator are skipped.
+   *
+   * @throw std::runtime_error the file cannot be read, is not a checkpoint, or has a node that
+   *        does not exist or has no NDN stack
+   */
+  static void
+  Load(const std::string& file);
+
+  /**
+   * @brief Restore the state of the nodes in the container only
+   */
+  static void
+  Load(const std::string& file, const NodeContainer& nodes);
+
+  /**
+   * @brief Schedule Load(file) at the specified time
+   */
+  static void
+  ScheduleLoad(Time when, const std::string& file);
+
+  /**
+   * @brief Save and restore strategy information of type Info on Measurements entries
+   *
+   * Strategy information is specific to the strategy, so it is only saved for the types that
+   * have been registered.  \p load is called on the Info created with getOrCreateStrategyInfo.
+   */
+  template<class Info>
+  static void
+  RegisterMeasurementsInfo(const std::function<void(const Info&, std::ostream&)>& save,
+                           const std::function<void(Info&, std::istream&)>& load)
+  {
+    MeasurementsInfoCodec codec;
+    codec.save = [save] (const nfd::measurements::Entry& entry, std::ostream& os) {
+      shared_ptr<Info> info = entry.getStrategyInfo<Info>();
+      if (info == nullptr)
+        return false;
+      save(*info, os);
+      return true;
+    };
+    codec.load = [load] (nfd::measurements::Entry& entry, std::istream& is) {
+      load(*entry.getOrCreateStrategyInfo<Info>(), is);
+    };
+    RegisterMeasurementsInfo(Info::getTypeId(), codec);
+  }
+
+private:
+  struct MeasurementsInfoCodec
+  {
+    /// @return false if the entry has no information of the type
+    std::function<bool(const nfd::measurements::Entry&, std::ostream&)> save;
+    std::function<void(nfd::measurements::Entry&, std::istream&)> load;
+  };
+
+  static void
+  RegisterMeasurementsInfo(int typeId, const MeasurementsInfoCodec& codec);
+
+  static std::map<int, MeasurementsInfoCodec>&
+  GetMeasurementsInfoCodecs();
+
+  static std::string
+  SaveNode(Ptr<Node> node);
+
+  static void
+  LoadNode(const std::string& state, Ptr<Node> node);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHECKPOINT_HELPER_H
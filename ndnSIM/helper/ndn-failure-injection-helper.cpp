@@ -0,0 +1,388 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-failure-injection-helper.hpp"
+#include "ndn-global-routing-helper.hpp"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-face.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/mobility-model.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.FailureInjectionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+static uint64_t
+makeNodePairKey(uint32_t node1, uint32_t node2)
+{
+  if (node1 > node2)
+    std::swap(node1, node2);
+  return (static_cast<uint64_t>(node1) << 32) | node2;
+}
+
+FailureInjectionHelper::FailureInjectionHelper()
+  : m_nDown(0)
+  , m_isIncrementalReroute(false)
+  , m_random(CreateObject<ExponentialRandomVariable>())
+  , m_nChanges(0)
+{
+}
+
+FailureInjectionHelper::~FailureInjectionHelper()
+{
+  for (auto& batch : m_batches) {
+    Simulator::Cancel(batch.second.event);
+  }
+}
+
+size_t
+FailureInjectionHelper::AddLink(shared_ptr<NetDeviceFace> face1, shared_ptr<NetDeviceFace> face2)
+{
+  Link link;
+  link.face1 = face1;
+  link.face2 = face2;
+  link.node1 = face1->GetNetDevice()->GetNode();
+  if (face2 != nullptr)
+    link.node2 = face2->GetNetDevice()->GetNode();
+  link.nFailures = 0;
+
+  size_t index = m_links.size();
+  m_links.push_back(link);
+  m_linksByFace[face1.get()] = index;
+  if (face2 != nullptr)
+    m_linksByFace[face2.get()] = index;
+  return index;
+}
+
+size_t
+FailureInjectionHelper::AddPointToPointLinks(const NodeContainer& nodes)
+{
+  size_t nAdded = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol>();
+    if (ndn == nullptr)
+      continue;
+
+    for (const auto& face : ndn->getForwarder()->getFaceTable()) {
+      shared_ptr<NetDeviceFace> face1 = std::dynamic_pointer_cast<NetDeviceFace>(face);
+      if (face1 == nullptr || m_linksByFace.count(face1.get()) > 0)
+        continue;
+
+      Ptr<PointToPointNetDevice> device1 =
+        DynamicCast<PointToPointNetDevice>(face1->GetNetDevice());
+      if (device1 == nullptr || device1->GetChannel() == nullptr)
+        continue;
+
+      Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(device1->GetChannel());
+      Ptr<NetDevice> device2 = channel->GetDevice(0);
+      if (device2 == device1)
+        device2 = channel->GetDevice(1);
+
+      Ptr<L3Protocol> ndn2 = device2->GetNode()->GetObject<L3Protocol>();
+      if (ndn2 == nullptr)
+        continue;
+      shared_ptr<NetDeviceFace> face2 =
+        std::dynamic_pointer_cast<NetDeviceFace>(ndn2->getFaceByNetDevice(device2));
+      if (face2 == nullptr)
+        continue;
+
+      size_t index = AddLink(face1, face2);
+      // the first link between two nodes is found by FindLink
+      m_linksByNodes.insert({makeNodePairKey((*node)->GetId(), device2->GetNode()->GetId()),
+                             index});
+      ++nAdded;
+    }
+  }
+  NS_LOG_DEBUG("Added " << nAdded << " point-to-point links");
+  return nAdded;
+}
+
+size_t
+FailureInjectionHelper::AddRadios(const NodeContainer& nodes)
+{
+  size_t nAdded = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol>();
+    if (ndn == nullptr)
+      continue;
+
+    for (const auto& face : ndn->getForwarder()->getFaceTable()) {
+      shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+      if (netDeviceFace == nullptr || m_linksByFace.count(netDeviceFace.get()) > 0 ||
+          DynamicCast<PointToPointNetDevice>(netDeviceFace->GetNetDevice()) != nullptr)
+        continue;
+
+      size_t index = AddLink(netDeviceFace, nullptr);
+      m_radiosByNode.insert({(*node)->GetId(), index});
+      ++nAdded;
+    }
+  }
+  NS_LOG_DEBUG("Added " << nAdded << " radios");
+  return nAdded;
+}
+
+size_t
+FailureInjectionHelper::FindLink(Ptr<Node> node1, Ptr<Node> node2) const
+{
+  NS_ASSERT(node1 != nullptr && node2 != nullptr);
+  auto link = m_linksByNodes.find(makeNodePairKey(node1->GetId(), node2->GetId()));
+  if (link == m_linksByNodes.end()) {
+    throw std::invalid_argument("No point-to-point link between nodes " +
+                                std::to_string(node1->GetId()) + " and " +
+                                std::to_string(node2->GetId()) + " was added");
+  }
+  return link->second;
+}
+
+size_t
+FailureInjectionHelper::FindRadio(Ptr<Node> node) const
+{
+  NS_ASSERT(node != nullptr);
+  auto radio = m_radiosByNode.find(node->GetId());
+  if (radio == m_radiosByNode.end()) {
+    throw std::invalid_argument("No radio of node " + std::to_string(node->GetId()) +
+                                " was added");
+  }
+  return radio->second;
+}
+
+FailureInjectionHelper::Batch&
+FailureInjectionHelper::GetBatch(Time at)
+{
+  if (at < Simulator::Now())
+    at = Simulator::Now();
+
+  auto batch = m_batches.find(at);
+  if (batch == m_batches.end()) {
+    batch = m_batches.insert({at, Batch()}).first;
+    batch->second.event = Simulator::Schedule(at - Simulator::Now(),
+                                              &FailureInjectionHelper::ApplyBatch, this, at);
+  }
+  return batch->second;
+}
+
+void
+FailureInjectionHelper::Fail(size_t link, Time at)
+{
+  NS_ASSERT(link < m_links.size());
+  GetBatch(at).failures.push_back(link);
+}
+
+void
+FailureInjectionHelper::Recover(size_t link, Time at)
+{
+  NS_ASSERT(link < m_links.size());
+  GetBatch(at).recoveries.push_back(link);
+}
+
+void
+FailureInjectionHelper::ScheduleRandom(Time start, Time stop, Time meanTimeToFailure,
+                                       Time meanTimeToRepair)
+{
+  NS_ASSERT(meanTimeToFailure.IsStrictlyPositive() && meanTimeToRepair.IsStrictlyPositive());
+
+  size_t nFailures = 0;
+  for (size_t link = 0; link < m_links.size(); ++link) {
+    Time time = start;
+    while (true) {
+      time += Seconds(m_random->GetValue(meanTimeToFailure.GetSeconds(), 0));
+      if (time >= stop)
+        break;
+      Fail(link, time);
+      time += Seconds(m_random->GetValue(meanTimeToRepair.GetSeconds(), 0));
+      Recover(link, time);
+      ++nFailures;
+    }
+  }
+  NS_LOG_DEBUG("Scheduled " << nFailures << " random failures of " << m_links.size()
+               << " links in " << m_batches.size() << " batches");
+}
+
+void
+FailureInjectionHelper::ScheduleRegional(Time at, const Vector& center, double radius,
+                                         Time duration)
+{
+  GetBatch(at).regions.push_back({center, radius, duration});
+}
+
+void
+FailureInjectionHelper::ScheduleTrace(const std::string& file)
+{
+  std::ifstream is(file);
+  if (!is) {
+    throw std::runtime_error("Cannot open failure trace " + file);
+  }
+
+  std::string line;
+  size_t lineNo = 0;
+  while (std::getline(is, line)) {
+    ++lineNo;
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+      continue;
+
+    std::istringstream fields(line);
+    double seconds;
+    std::string action, node1, node2;
+    if (!(fields >> seconds >> action >> node1) || (action != "down" && action != "up")) {
+      throw std::runtime_error(file + ":" + std::to_string(lineNo) +
+                               ": expected <time> <down|up> <node> [<node>]");
+    }
+    fields >> node2;
+
+    Ptr<Node> n1 = Names::Find<Node>(node1);
+    Ptr<Node> n2;
+    if (!node2.empty())
+      n2 = Names::Find<Node>(node2);
+    if (n1 == nullptr || (!node2.empty() && n2 == nullptr)) {
+      throw std::invalid_argument(file + ":" + std::to_string(lineNo) + ": unknown node");
+    }
+
+    size_t link = n2 == nullptr ? FindRadio(n1) : FindLink(n1, n2);
+    if (action == "down")
+      Fail(link, Seconds(seconds));
+    else
+      Recover(link, Seconds(seconds));
+  }
+}
+
+int64_t
+FailureInjectionHelper::AssignStreams(int64_t stream)
+{
+  m_random->SetStream(stream);
+  return 1;
+}
+
+void
+FailureInjectionHelper::FindRegion(const Region& region, std::vector<size_t>& links) const
+{
+  double radius2 = region.radius * region.radius;
+  auto isInside = [&] (const Ptr<Node>& node) {
+    if (node == nullptr)
+      return false;
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    if (mobility == nullptr)
+      return false;
+    Vector position = mobility->GetPosition();
+    double dx = position.x - region.center.x;
+    double dy = position.y - region.center.y;
+    double dz = position.z - region.center.z;
+    return dx * dx + dy * dy + dz * dz <= radius2;
+  };
+
+  for (size_t link = 0; link < m_links.size(); ++link) {
+    if (isInside(m_links[link].node1) || isInside(m_links[link].node2))
+      links.push_back(link);
+  }
+}
+
+void
+FailureInjectionHelper::ApplyBatch(Time at)
+{
+  auto i = m_batches.find(at);
+  NS_ASSERT(i != m_batches.end());
+  Batch batch = std::move(i->second);
+  m_batches.erase(i);
+
+  for (const Region& region : batch.regions) {
+    std::vector<size_t> links;
+    FindRegion(region, links);
+    NS_LOG_DEBUG("Region fails " << links.size() << " links");
+    Batch& recovery = GetBatch(at + region.duration);
+    recovery.recoveries.insert(recovery.recoveries.end(), links.begin(), links.end());
+    batch.failures.insert(batch.failures.end(), links.begin(), links.end());
+  }
+
+  std::vector<size_t> touched(batch.recoveries);
+  touched.insert(touched.end(), batch.failures.begin(), batch.failures.end());
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+  std::vector<bool> wasDown(touched.size());
+  for (size_t i = 0; i < touched.size(); ++i) {
+    wasDown[i] = m_links[touched[i]].nFailures > 0;
+  }
+
+  for (size_t index : batch.recoveries) {
+    if (m_links[index].nFailures > 0)
+      --m_links[index].nFailures;
+  }
+  for (size_t index : batch.failures) {
+    ++m_links[index].nFailures;
+  }
+
+  // only links whose state changed, e.g., not those recovered and failed again at once
+  std::vector<size_t> failed, recovered;
+  for (size_t i = 0; i < touched.size(); ++i) {
+    bool isDown = m_links[touched[i]].nFailures > 0;
+    if (isDown && !wasDown[i])
+      failed.push_back(touched[i]);
+    else if (!isDown && wasDown[i])
+      recovered.push_back(touched[i]);
+  }
+
+  for (size_t index : failed) {
+    Link& link = m_links[index];
+    link.face1->setLinkDown(true);
+    if (link.face2 != nullptr)
+      link.face2->setLinkDown(true);
+  }
+  for (size_t index : recovered) {
+    Link& link = m_links[index];
+    link.face1->setLinkDown(false);
+    if (link.face2 != nullptr)
+      link.face2->setLinkDown(false);
+  }
+  m_nDown += failed.size();
+  m_nDown -= recovered.size();
+  m_nChanges += failed.size() + recovered.size();
+
+  NS_LOG_DEBUG("Failed " << failed.size() << ", recovered " << recovered.size() << " links, "
+               << m_nDown << " down");
+
+  if (m_isIncrementalReroute) {
+    for (size_t index : failed) {
+      if (m_links[index].face2 != nullptr)
+        GlobalRoutingHelper::NotifyLinkChange(m_links[index].face1, m_links[index].face2, false);
+    }
+    for (size_t index : recovered) {
+      if (m_links[index].face2 != nullptr)
+        GlobalRoutingHelper::NotifyLinkChange(m_links[index].face1, m_links[index].face2, true);
+    }
+  }
+
+  if (m_rerouteCallback && (!failed.empty() || !recovered.empty()))
+    m_rerouteCallback(failed, recovered);
+}
+
+} // namespace ndn
+} // namespace ns3
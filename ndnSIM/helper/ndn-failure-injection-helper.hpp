@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_FAILURE_INJECTION_HELPER_H
+#define NDN_FAILURE_INJECTION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/vector.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceFace;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Scheduled failures and recoveries of many links at once
+ *
+ * The helper controls two kinds of links:
+ *  - point-to-point links between NDN nodes, each taken down on both of its faces
+ *  - radios, i.e., NetDeviceFaces on other devices (e.g., WifiNetDevice), each taken down on
+ *    its own node only
+ *
+ * A link is taken down with NetDeviceFace::setLinkDown, which works with any device and costs
+ * no reconfiguration of the device.  Failures and recoveries can be scheduled one by one,
+ * at random (see ScheduleRandom), for all links within a region (see ScheduleRegional) or
+ * from a trace file (see ScheduleTrace).  The changes scheduled for the same time are applied
+ * in one simulator event, and rerouting follows once per batch:
+ *  - with SetIncrementalReroute, GlobalRoutingHelper::NotifyLinkChange is called for every
+ *    point-to-point link that changed, so routes are updated when incremental routing is
+ *    enabled (see GlobalRoutingHelper::SetIncrementalRouting)
+ *  - the callback set with SetRerouteCallback gets the links that failed and recovered
+ *
+ * Failures of a link nest: a link failed twice, e.g., by a regional failure and at random,
+ * is back up after both recoveries.
+ *
+ * Unlike LinkControlHelper, the helper does not need to find the link of two nodes on every
+ * change, so it scales to topologies with thousands of links.
+ *
+ * The helper must exist as long as the simulation runs.
+ */
+class FailureInjectionHelper : noncopyable {
+public:
+  /**
+   * @brief Callback after a batch of changes, with the indexes of failed and recovered links
+   */
+  typedef std::function<void(const std::vector<size_t>& failed,
+                             const std::vector<size_t>& recovered)> RerouteCallback;
+
+  FailureInjectionHelper();
+
+  ~FailureInjectionHelper();
+
+  /**
+   * @brief Add the point-to-point links between NDN nodes of \p nodes
+   *
+   * Links already added are skipped.
+   * @return number of links added
+   */
+  size_t
+  AddPointToPointLinks(const NodeContainer& nodes = NodeContainer::GetGlobal());
+
+  /**
+   * @brief Add the NetDeviceFaces of \p nodes on devices other than point-to-point as radios
+   *
+   * Faces already added are skipped.
+   * @return number of links added
+   */
+  size_t
+  AddRadios(const NodeContainer& nodes = NodeContainer::GetGlobal());
+
+  size_t
+  GetNLinks() const
+  {
+    return m_links.size();
+  }
+
+  /**
+   * @brief Index of the point-to-point link between two nodes
+   * @throw std::invalid_argument the link was not added
+   */
+  size_t
+  FindLink(Ptr<Node> node1, Ptr<Node> node2) const;
+
+  /**
+   * @brief Index of the first radio of the node
+   * @throw std::invalid_argument the node has no radio added
+   */
+  size_t
+  FindRadio(Ptr<Node> node) const;
+
+  bool
+  IsDown(size_t link) const
+  {
+    return m_links.at(link).nFailures > 0;
+  }
+
+  /**
+   * @brief Number of links currently down
+   */
+  size_t
+  GetNDown() const
+  {
+    return m_nDown;
+  }
+
+  /**
+   * @brief Enables or disables notification of GlobalRoutingHelper on changes of
+   *        point-to-point links (disabled by default)
+   */
+  void
+  SetIncrementalReroute(bool enable)
+  {
+    m_isIncrementalReroute = enable;
+  }
+
+  void
+  SetRerouteCallback(const RerouteCallback& callback)
+  {
+    m_rerouteCallback = callback;
+  }
+
+  /**
+   * @brief Fail the link at time \p at
+   */
+  void
+  Fail(size_t link, Time at);
+
+  /**
+   * @brief Recover the link at time \p at
+   */
+  void
+  Recover(size_t link, Time at);
+
+  /**
+   * @brief Fail and recover every link independently at random, between \p start and \p stop
+   *
+   * The times up to the next failure and the durations of failures are exponential, with
+   * the given means.  A failure that started before \p stop lasts its full duration.
+   */
+  void
+  ScheduleRandom(Time start, Time stop, Time meanTimeToFailure, Time meanTimeToRepair);
+
+  /**
+   * @brief Fail at time \p at all links with a node within \p radius of \p center,
+   *        for \p duration
+   *
+   * Nodes without MobilityModel are never in the region.  Positions are taken at time \p at.
+   */
+  void
+  ScheduleRegional(Time at, const Vector& center, double radius, Time duration);
+
+  /**
+   * @brief Schedule the failures and recoveries of a trace file
+   *
+   * Every line of the file is either empty, a comment starting with #, or
+   *
+   *     <time in seconds> <down|up> <node> [<node>]
+   *
+   * with node names registered by Names class.  A line with two nodes changes the
+   * point-to-point link between them, one with one node its first radio.
+   *
+   * @throw std::runtime_error the file cannot be read or is malformed
+   * @throw std::invalid_argument the trace names unknown nodes or links
+   */
+  void
+  ScheduleTrace(const std::string& file);
+
+  /**
+   * @brief Use fixed random streams, starting with \p stream
+   * @return number of streams used
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+  /**
+   * @brief Number of failures and recoveries applied, which changed the state of a link
+   */
+  uint64_t
+  GetNChanges() const
+  {
+    return m_nChanges;
+  }
+
+private:
+  struct Link {
+    shared_ptr<NetDeviceFace> face1;
+    shared_ptr<NetDeviceFace> face2; ///< nullptr for radios
+    Ptr<Node> node1;
+    Ptr<Node> node2;
+    uint32_t nFailures;
+  };
+
+  struct Region {
+    Vector center;
+    double radius;
+    Time duration;
+  };
+
+  struct Batch {
+    std::vector<size_t> failures;
+    std::vector<size_t> recoveries;
+    std::vector<Region> regions; ///< links are found when the batch is applied
+    EventId event;
+  };
+
+  size_t
+  AddLink(shared_ptr<NetDeviceFace> face1, shared_ptr<NetDeviceFace> face2);
+
+  /**
+   * @brief Batch of changes at time \p at, scheduled on first use
+   */
+  Batch&
+  GetBatch(Time at);
+
+  void
+  ApplyBatch(Time at);
+
+  void
+  FindRegion(const Region& region, std::vector<size_t>& links) const;
+
+private:
+  std::vector<Link> m_links;
+  std::unordered_map<const NetDeviceFace*, size_t> m_linksByFace;
+  std::unordered_map<uint64_t, size_t> m_linksByNodes; ///< point-to-point, by node ids
+  std::unordered_map<uint32_t, size_t> m_radiosByNode; ///< first radio, by node id
+  size_t m_nDown;
+
+  std::map<Time, Batch> m_batches;
+
+  bool m_isIncrementalReroute;
+  RerouteCallback m_rerouteCallback;
+
+  Ptr<ExponentialRandomVariable> m_random;
+  uint64_t m_nChanges;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_FAILURE_INJECTION_HELPER_H
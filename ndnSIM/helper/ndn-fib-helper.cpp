@@ -39,6 +39,7 @@
 #include "ns3/data-rate.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
+#include "daemon/fw/forwarder.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
@@ -51,6 +52,19 @@ NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::FibManager> fibManager = l3protocol->getFibManager();
+  if (fibManager == nullptr) {
+    // lean mode: no management, update the FIB directly
+    shared_ptr<Face> face = l3protocol->getFaceById(parameters.getFaceId());
+    NS_ASSERT_MSG(face != nullptr, "Face with ID [" << parameters.getFaceId()
+                                   << "] does not exist on node [" << node->GetId() << "]");
+    shared_ptr<nfd::fib::Entry> entry =
+      l3protocol->getForwarder()->getFib().insert(parameters.getName()).first;
+    entry->addNextHop(face, parameters.hasCost() ? parameters.getCost() : 0);
+    return;
+  }
+
   NS_LOG_DEBUG("Add Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -61,14 +75,27 @@ FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> l3protocol = node->GetObject<L3Protocol>();
-  shared_ptr<nfd::FibManager> fibManager = l3protocol->getFibManager();
   fibManager->onFibRequest(*command);
 }
 
 void
 FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::FibManager> fibManager = L3protocol->getFibManager();
+  if (fibManager == nullptr) {
+    nfd::Fib& fib = L3protocol->getForwarder()->getFib();
+    shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(parameters.getName());
+    shared_ptr<Face> face = L3protocol->getFaceById(parameters.getFaceId());
+    if (entry != nullptr && face != nullptr) {
+      entry->removeNextHop(face);
+      if (!entry->hasNextHops()) {
+        fib.erase(*entry);
+      }
+    }
+    return;
+  }
+
   NS_LOG_DEBUG("Remove Next Hop command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -79,8 +106,6 @@ FibHelper::RemoveNextHop(const ControlParameters& parameters, Ptr<Node> node)
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
 
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
-  shared_ptr<nfd::FibManager> fibManager = L3protocol->getFibManager();
   fibManager->onFibRequest(*command);
 }
 
@@ -103,6 +128,39 @@ FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, shared_ptr<Face> face, i
   AddNextHop(parameters, node);
 }
 
+void
+FibHelper::AddRoutes(const std::vector<Route>& routes)
+{
+  Ptr<Node> node;
+  nfd::Fib* fib = nullptr;
+  shared_ptr<nfd::FibManager> fibManager;
+
+  for (const Route& route : routes) {
+    if (route.node != node) {
+      if (fibManager != nullptr)
+        fibManager->onFibChanged();
+
+      node = route.node;
+      Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+      NS_ASSERT_MSG(ndn != 0, "Ndn stack should be installed on the node");
+      fib = &ndn->getForwarder()->getFib();
+      fibManager = ndn->getFibManager();
+    }
+
+    NS_LOG_LOGIC("[" << node->GetId() << "]$ route add " << route.prefix << " via "
+                     << route.face->getLocalUri() << " metric " << route.metric);
+    NS_ASSERT_MSG(route.face->getId() != nfd::INVALID_FACEID,
+                  "Face " << route.face->getLocalUri() << " is not added to node ["
+                          << node->GetId() << "]");
+
+    // same conversion of the metric as ControlParameters::setCost
+    fib->insert(route.prefix).first->addNextHop(route.face, static_cast<uint64_t>(route.metric));
+  }
+
+  if (fibManager != nullptr)
+    fibManager->onFibChanged();
+}
+
 void
 FibHelper::AddRoute(Ptr<Node> node, const Name& prefix, uint32_t faceId, int32_t metric)
 {
@@ -29,6 +29,8 @@
 
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -44,6 +46,16 @@ using ::ndn::nfd::ControlParameters;
  */
 class FibHelper {
 public:
+  /**
+   * \brief Route to install with AddRoutes
+   */
+  struct Route {
+    Ptr<Node> node;
+    Name prefix;
+    shared_ptr<Face> face;
+    int32_t metric;
+  };
+
   /**
    * \brief Add forwarding entry to FIB
    *
@@ -101,6 +113,18 @@ public:
   AddRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName,
            int32_t metric);
 
+  /**
+   * \brief Add many forwarding entries to FIBs at once
+   *
+   * Unlike AddRoute, the entries are inserted directly into the FIB of each node, without
+   * encoding a management command per route.  Routes of the same node should be kept together,
+   * as the FIB of the node is looked up once for every run of such routes.
+   *
+   * \param routes Routes, the face of a route must belong to its node
+   */
+  static void
+  AddRoutes(const std::vector<Route>& routes);
+
   /**
    * \brief remove forwarding entry in FIB
    *
@@ -46,18 +46,19 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/simulator.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <ndn-cxx/structured-name-view.hpp>
 
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <set>
+#include <thread>
 #include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
@@ -214,176 +215,722 @@ GlobalRoutingHelper::AddOriginsForAll()
   }
 }
 
+bool GlobalRoutingHelper::s_isSpatialAggregation = false;
+
 void
-GlobalRoutingHelper::CalculateRoutes()
+GlobalRoutingHelper::SetSpatialAggregation(bool enable)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  s_isSpatialAggregation = enable;
+}
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+bool
+GlobalRoutingHelper::IsSpatialAggregation()
+{
+  return s_isSpatialAggregation;
+}
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+/**
+ * @brief Metric of every nexthop face of a route
+ */
+typedef std::map<shared_ptr<Face>, int32_t> NextHopMetrics;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
-      continue;
-    }
+/**
+ * @brief Routes of a node, by prefix
+ */
+typedef std::map<Name, NextHopMetrics> RouteTable;
 
-    boost::DistancesMap distances;
+/**
+ * @brief Range of prefix lengths of the spatial prefixes of name, from /S to the last region
+ * @return false if the name has no spatial part
+ */
+static bool
+getSpatialPrefixLengths(const Name& name, size_t& first, size_t& last)
+{
+  ::ndn::StructuredNameView view(name);
+  if (!view.hasSpatialPart())
+    return false;
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+  first = view.spatialBegin() - name.begin(); // ends with "S"
+  last = view.spatialEnd() - name.begin();
+  return true;
+}
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+/**
+ * @brief Collapses routes to spatial prefixes into the shortest common spatial prefix with the
+ *        same nexthop faces, see GlobalRoutingHelper::SetSpatialAggregation
+ */
+static RouteTable
+aggregateSpatialRoutes(const RouteTable& routes, const GlobalRouter::LocalPrefixList& localPrefixes)
+{
+  struct Aggregate
+  {
+    bool isDivergent;
+    NextHopMetrics nexthops;
+  };
+  std::map<Name, Aggregate> aggregates;
+
+  size_t first = 0, last = 0;
+  for (const auto& route : routes) {
+    if (!getSpatialPrefixLengths(route.first, first, last))
+      continue;
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+    for (size_t length = first; length <= last; ++length) {
+      auto inserted = aggregates.insert({route.first.getPrefix(length), Aggregate{false, route.second}});
+      Aggregate& aggregate = inserted.first->second;
+      if (inserted.second || aggregate.isDivergent)
+        continue;
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
+      bool isSameFaces = aggregate.nexthops.size() == route.second.size() &&
+        std::equal(aggregate.nexthops.begin(), aggregate.nexthops.end(), route.second.begin(),
+                   [] (const NextHopMetrics::value_type& a, const NextHopMetrics::value_type& b) {
+                     return a.first == b.first;
+                   });
+      if (!isSameFaces) {
+        aggregate.isDivergent = true;
         continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
+      }
+      for (const auto& nexthop : route.second) {
+        int32_t& metric = aggregate.nexthops[nexthop.first];
+        metric = std::min(metric, nexthop.second);
       }
     }
   }
+
+  // prefixes of the node itself are not reached through any of the faces
+  for (const auto& prefix : localPrefixes) {
+    if (!getSpatialPrefixLengths(*prefix, first, last))
+      continue;
+    for (size_t length = first; length <= last; ++length) {
+      auto aggregate = aggregates.find(prefix->getPrefix(length));
+      if (aggregate != aggregates.end())
+        aggregate->second.isDivergent = true;
+    }
+  }
+
+  RouteTable aggregated;
+  for (const auto& route : routes) {
+    if (!getSpatialPrefixLengths(route.first, first, last)) {
+      aggregated.insert(route);
+      continue;
+    }
+
+    size_t length = first;
+    for (; length <= last; ++length) {
+      auto aggregate = aggregates.find(route.first.getPrefix(length));
+      if (!aggregate->second.isDivergent) {
+        aggregated.insert({aggregate->first, aggregate->second.nexthops});
+        break;
+      }
+    }
+    if (length > last)
+      aggregated.insert(route);
+  }
+  return aggregated;
 }
 
-void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+namespace {
+
+const uint32_t NO_FACE = std::numeric_limits<uint32_t>::max();
+const uint32_t INF_DISTANCE = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Number of sources per thread whose routes are computed before they are installed
+ *
+ * Bounds the memory held by computed, but not yet installed routes.
+ */
+const size_t BATCH_SIZE_PER_THREAD = 32;
+
+/**
+ * @brief Snapshot of the GlobalRouter graph in flat arrays
+ *
+ * Shortest path computations on the snapshot touch neither ns-3 objects nor their reference
+ * counters, so computations for different sources can run on worker threads.
+ *
+ * Edges of all faces are in the snapshot, failed ones are masked, so the snapshot is built once
+ * and reused after link failures and recoveries.
+ */
+class RoutingGraph
 {
+public:
+  struct Edge
+  {
+    uint32_t target;
+    uint32_t metric;
+    uint32_t face; ///< index in faces, NO_FACE for edges from channels
+  };
+
+  /**
+   * @brief A destination reachable from the source of a computation
+   */
+  struct Reach
+  {
+    uint32_t destination;
+    uint32_t face; ///< index in faces of the first hop from the source
+    uint32_t distance;
+  };
+
+  RoutingGraph();
+
   /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
+   * @brief Mask the edges of failedFaces, and only those
    */
+  void
+  setFailedFaces(const std::set<shared_ptr<Face>>& failedFaces);
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  /**
+   * @brief Mask or unmask the edge of face, if it is in the snapshot
+   */
+  void
+  setFaceFailed(const shared_ptr<Face>& face, bool isFailed);
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  /**
+   * @brief Value of GlobalRouter::GetGeneration when the snapshot was built
+   */
+  uint64_t
+  getGeneration() const
+  {
+    return m_generation;
+  }
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  /**
+   * @return index of the vertex of router, or INF_DISTANCE if the router is not in the graph
+   */
+  uint32_t
+  getVertex(Ptr<GlobalRouter> router) const;
+
+  /**
+   * @brief Vertices of nodes, in the order of NodeList
+   */
+  std::vector<uint32_t>
+  getNodeVertices() const;
+
+  /**
+   * @brief Destinations reachable from source, through the first hop faces of shortest paths
+   * @param isAllPaths if true, the shortest path through every face of the source is reported
+   */
+  std::vector<Reach>
+  computeReaches(uint32_t source, bool isAllPaths) const;
+
+  /**
+   * @brief Shortest distances from every vertex to target
+   */
+  std::vector<uint32_t>
+  computeDistancesTo(uint32_t target) const;
+
+private:
+  /**
+   * @param firstFace if not NO_FACE, only paths leaving source through this face are considered
+   */
+  void
+  dijkstra(const std::vector<size_t>& offsets, const std::vector<Edge>& edges,
+           uint32_t source, uint32_t firstFace,
+           std::vector<uint32_t>& distances, std::vector<uint32_t>& firstFaces) const;
+
+  void
+  appendReaches(uint32_t source, const std::vector<uint32_t>& distances,
+                const std::vector<uint32_t>& firstFaces, std::vector<Reach>& reaches) const;
+
+public:
+  std::vector<Ptr<GlobalRouter>> routers;
+  std::vector<Ptr<Node>> nodes; ///< nullptr for channels
+  std::vector<std::vector<Name>> prefixes;
+  std::vector<shared_ptr<Face>> faces;
+
+private:
+  uint64_t m_generation;
+  std::unordered_map<const GlobalRouter*, uint32_t> m_vertices;
+  std::unordered_map<const Face*, uint32_t> m_faceIndices;
+  std::vector<uint8_t> m_isFaceFailed; ///< by index in faces
+  std::vector<size_t> m_offsets; ///< out edges of vertex i are [m_offsets[i], m_offsets[i+1])
+  std::vector<Edge> m_edges;
+  std::vector<size_t> m_reverseOffsets;
+  std::vector<Edge> m_reverseEdges; ///< with the face of the edge they reverse
+};
+
+RoutingGraph::RoutingGraph()
+  : m_generation(GlobalRouter::GetGeneration())
+{
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    m_vertices[PeekPointer(gr)] = routers.size();
+    routers.push_back(gr);
+    nodes.push_back(*node);
+  }
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0) {
+      m_vertices[PeekPointer(gr)] = routers.size();
+      routers.push_back(gr);
+      nodes.push_back(nullptr);
+    }
+  }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+  prefixes.resize(routers.size());
+  std::vector<std::vector<Edge>> reverse(routers.size());
+  m_offsets.push_back(0);
+  for (uint32_t vertex = 0; vertex < routers.size(); ++vertex) {
+    for (const auto& prefix : routers[vertex]->GetLocalPrefixes()) {
+      prefixes[vertex].push_back(*prefix);
+    }
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+    for (const auto& incidency : routers[vertex]->GetIncidencies()) {
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      auto target = m_vertices.find(PeekPointer(std::get<2>(incidency)));
+      if (target == m_vertices.end())
+        continue;
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& i : l3->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      faceIds.push_back(nfdFace->getId());
-      originalMetrics[nfdFace->getId()] = nfdFace->getMetric();
-      nfdFace->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+      Edge edge{target->second, 0, NO_FACE};
+      if (face != nullptr) {
+        auto index = m_faceIndices.insert({face.get(), faces.size()});
+        if (index.second)
+          faces.push_back(face);
+        edge.metric = face->getMetric();
+        edge.face = index.first->second;
+      }
+      m_edges.push_back(edge);
+      reverse[edge.target].push_back(Edge{vertex, edge.metric, edge.face});
     }
+    m_offsets.push_back(m_edges.size());
+  }
+
+  m_reverseOffsets.push_back(0);
+  for (const auto& edges : reverse) {
+    m_reverseEdges.insert(m_reverseEdges.end(), edges.begin(), edges.end());
+    m_reverseOffsets.push_back(m_reverseEdges.size());
+  }
+  m_isFaceFailed.assign(faces.size(), false);
+}
+
+void
+RoutingGraph::setFailedFaces(const std::set<shared_ptr<Face>>& failedFaces)
+{
+  m_isFaceFailed.assign(faces.size(), false);
+  for (const auto& face : failedFaces) {
+    setFaceFailed(face, true);
+  }
+}
+
+void
+RoutingGraph::setFaceFailed(const shared_ptr<Face>& face, bool isFailed)
+{
+  auto index = m_faceIndices.find(face.get());
+  if (index != m_faceIndices.end())
+    m_isFaceFailed[index->second] = isFailed;
+}
+
+uint32_t
+RoutingGraph::getVertex(Ptr<GlobalRouter> router) const
+{
+  auto vertex = m_vertices.find(PeekPointer(router));
+  return vertex != m_vertices.end() ? vertex->second : INF_DISTANCE;
+}
+
+std::vector<uint32_t>
+RoutingGraph::getNodeVertices() const
+{
+  std::vector<uint32_t> vertices;
+  for (uint32_t vertex = 0; vertex < nodes.size(); ++vertex) {
+    if (nodes[vertex] != nullptr)
+      vertices.push_back(vertex);
+  }
+  return vertices;
+}
 
-    for (auto& faceId : faceIds) {
-      shared_ptr<Face> k = l3->getForwarder()->getFaceTable().get(faceId);
-      shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(k);
-      if (face == 0) {
-        NS_LOG_DEBUG("Skipping non-netdevice face");
+void
+RoutingGraph::dijkstra(const std::vector<size_t>& offsets, const std::vector<Edge>& edges,
+                       uint32_t source, uint32_t firstFace,
+                       std::vector<uint32_t>& distances, std::vector<uint32_t>& firstFaces) const
+{
+  distances.assign(offsets.size() - 1, INF_DISTANCE);
+  firstFaces.assign(offsets.size() - 1, NO_FACE);
+
+  typedef std::pair<uint32_t, uint32_t> QueueEntry; // distance, vertex
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+  distances[source] = 0;
+  queue.push({0, source});
+  while (!queue.empty()) {
+    QueueEntry top = queue.top();
+    queue.pop();
+    uint32_t vertex = top.second;
+    if (top.first != distances[vertex])
+      continue; // stale entry
+
+    for (size_t i = offsets[vertex]; i < offsets[vertex + 1]; ++i) {
+      const Edge& edge = edges[i];
+      if (edge.face != NO_FACE && m_isFaceFailed[edge.face])
         continue;
+
+      uint32_t face = firstFaces[vertex];
+      if (vertex == source) {
+        if (firstFace != NO_FACE && edge.face != firstFace)
+          continue;
+        face = edge.face;
+      }
+
+      uint32_t distance = top.first + edge.metric;
+      if (distance < distances[edge.target]) {
+        distances[edge.target] = distance;
+        firstFaces[edge.target] = face;
+        queue.push({distance, edge.target});
       }
+    }
+  }
+}
+
+void
+RoutingGraph::appendReaches(uint32_t source, const std::vector<uint32_t>& distances,
+                            const std::vector<uint32_t>& firstFaces,
+                            std::vector<Reach>& reaches) const
+{
+  for (uint32_t vertex = 0; vertex < distances.size(); ++vertex) {
+    if (vertex == source || firstFaces[vertex] == NO_FACE || prefixes[vertex].empty())
+      continue;
+    reaches.push_back(Reach{vertex, firstFaces[vertex], distances[vertex]});
+  }
+}
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+std::vector<RoutingGraph::Reach>
+RoutingGraph::computeReaches(uint32_t source, bool isAllPaths) const
+{
+  std::vector<Reach> reaches;
+  std::vector<uint32_t> distances;
+  std::vector<uint32_t> firstFaces;
+
+  if (!isAllPaths) {
+    dijkstra(m_offsets, m_edges, source, NO_FACE, distances, firstFaces);
+    appendReaches(source, distances, firstFaces, reaches);
+    return reaches;
+  }
 
-      boost::DistancesMap distances;
+  std::set<uint32_t> sourceFaces;
+  for (size_t i = m_offsets[source]; i < m_offsets[source + 1]; ++i) {
+    if (m_edges[i].face != NO_FACE && !m_isFaceFailed[m_edges[i].face])
+      sourceFaces.insert(m_edges[i].face);
+  }
+  for (uint32_t face : sourceFaces) {
+    dijkstra(m_offsets, m_edges, source, face, distances, firstFaces);
+    appendReaches(source, distances, firstFaces, reaches);
+  }
+  return reaches;
+}
 
-      NS_LOG_DEBUG("-----------");
+std::vector<uint32_t>
+RoutingGraph::computeDistancesTo(uint32_t target) const
+{
+  std::vector<uint32_t> distances;
+  std::vector<uint32_t> firstFaces;
+  dijkstra(m_reverseOffsets, m_reverseEdges, target, NO_FACE, distances, firstFaces);
+  return distances;
+}
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+/**
+ * @brief Routes installed by CalculateRoutes, and failed links, kept for incremental routing
+ */
+struct IncrementalState
+{
+  std::map<uint32_t, RouteTable> routes; ///< by node id
+  std::set<shared_ptr<Face>> failedFaces;
+  std::unique_ptr<RoutingGraph> graph; ///< snapshot of the last calculation, reused on link changes
+  bool isCleanupScheduled = false;
+};
+
+IncrementalState&
+getIncrementalState()
+{
+  static IncrementalState state;
+  return state;
+}
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+void
+clearIncrementalState()
+{
+  getIncrementalState() = IncrementalState();
+}
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
+void
+scheduleIncrementalStateCleanup()
+{
+  // the state holds faces, which should not outlive the simulation
+  IncrementalState& state = getIncrementalState();
+  if (!state.isCleanupScheduled) {
+    Simulator::ScheduleDestroy(&clearIncrementalState);
+    state.isCleanupScheduled = true;
+  }
+}
+
+/**
+ * @brief Snapshot of the graph with the failed faces masked
+ *
+ * The snapshot is kept until the simulation ends, and rebuilt if \p isRebuilt or GlobalRouters
+ * changed since it was built.
+ */
+RoutingGraph&
+getRoutingGraph(bool isRebuilt)
+{
+  IncrementalState& state = getIncrementalState();
+  if (isRebuilt || state.graph == nullptr ||
+      state.graph->getGeneration() != GlobalRouter::GetGeneration()) {
+    state.graph.reset(new RoutingGraph);
+    scheduleIncrementalStateCleanup();
+  }
+  state.graph->setFailedFaces(state.failedFaces);
+  return *state.graph;
+}
+
+/**
+ * @brief Compute reaches of every source, the computations are spread over worker threads
+ */
+std::vector<std::vector<RoutingGraph::Reach>>
+computeReaches(const RoutingGraph& graph, const std::vector<uint32_t>& sources, bool isAllPaths)
+{
+  std::vector<std::vector<RoutingGraph::Reach>> reaches(sources.size());
+  std::atomic<size_t> next(0);
+  auto work = [&] {
+    for (size_t i = next++; i < sources.size(); i = next++) {
+      reaches[i] = graph.computeReaches(sources[i], isAllPaths);
+    }
+  };
+
+  size_t nThreads = std::min(GlobalRoutingHelper::GetNThreads(), sources.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return reaches;
+}
+
+RouteTable
+makeRouteTable(const RoutingGraph& graph, uint32_t source,
+               const std::vector<RoutingGraph::Reach>& reaches, bool isAllPaths)
+{
+  NS_LOG_DEBUG("Reachability from Node: " << graph.nodes[source]->GetId() << " ("
+               << Names::FindName(graph.nodes[source]) << ")");
+
+  RouteTable routes;
+  for (const auto& reach : reaches) {
+    const shared_ptr<Face>& face = graph.faces[reach.face];
+    for (const auto& prefix : graph.prefixes[reach.destination]) {
+      NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *face
+                   << " with distance " << reach.distance);
+
+      auto inserted = routes[prefix].insert({face, reach.distance});
+      if (!inserted.second) {
+        // prefix with several origins
+        inserted.first->second = std::min<int32_t>(inserted.first->second, reach.distance);
       }
+    }
+  }
+
+  if (!isAllPaths && GlobalRoutingHelper::IsSpatialAggregation()) {
+    size_t nRoutes = routes.size();
+    routes = aggregateSpatialRoutes(routes, graph.routers[source]->GetLocalPrefixes());
+    NS_LOG_DEBUG(" aggregated " << nRoutes << " routes into " << routes.size());
+  }
+  return routes;
+}
 
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
+/**
+ * @brief Install routes on node, removing nexthops of oldRoutes that are no longer there
+ */
+void
+installRoutes(Ptr<Node> node, const RouteTable& routes, const RouteTable& oldRoutes)
+{
+  for (const auto& oldRoute : oldRoutes) {
+    auto route = routes.find(oldRoute.first);
+    for (const auto& nexthop : oldRoute.second) {
+      if (route == routes.end() || route->second.count(nexthop.first) == 0) {
+        FibHelper::RemoveRoute(node, oldRoute.first, nexthop.first);
+      }
     }
+  }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+  std::vector<FibHelper::Route> added;
+  for (const auto& route : routes) {
+    auto oldRoute = oldRoutes.find(route.first);
+    for (const auto& nexthop : route.second) {
+      if (oldRoute != oldRoutes.end()) {
+        auto oldNexthop = oldRoute->second.find(nexthop.first);
+        if (oldNexthop != oldRoute->second.end() && oldNexthop->second == nexthop.second)
+          continue;
+      }
+      added.push_back({node, route.first, nexthop.first, nexthop.second});
     }
   }
+  FibHelper::AddRoutes(added);
+}
+
+/**
+ * @brief Compute and install routes of sources, batch by batch
+ * @param isUpdate if true, routes of the previous calculation are replaced
+ */
+void
+calculateRoutes(const RoutingGraph& graph, const std::vector<uint32_t>& sources, bool isAllPaths,
+                bool isUpdate)
+{
+  IncrementalState& state = getIncrementalState();
+  bool isKept = !isAllPaths && GlobalRoutingHelper::IsIncrementalRouting();
+  if (isKept)
+    scheduleIncrementalStateCleanup();
+
+  size_t batchSize = GlobalRoutingHelper::GetNThreads() * BATCH_SIZE_PER_THREAD;
+  for (size_t begin = 0; begin < sources.size(); begin += batchSize) {
+    std::vector<uint32_t> batch(sources.begin() + begin,
+                                sources.begin() + std::min(begin + batchSize, sources.size()));
+    std::vector<std::vector<RoutingGraph::Reach>> reaches = computeReaches(graph, batch, isAllPaths);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+      Ptr<Node> node = graph.nodes[batch[i]];
+      RouteTable routes = makeRouteTable(graph, batch[i], reaches[i], isAllPaths);
+      reaches[i].clear();
+
+      if (isUpdate) {
+        installRoutes(node, routes, state.routes[node->GetId()]);
+      }
+      else {
+        installRoutes(node, routes, RouteTable());
+      }
+
+      if (isKept)
+        state.routes[node->GetId()] = std::move(routes);
+    }
+  }
+}
+
+/**
+ * @brief Vertex of the node of a NetDeviceFace
+ */
+uint32_t
+getFaceVertex(const RoutingGraph& graph, shared_ptr<Face> face)
+{
+  shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+  if (netDeviceFace == nullptr)
+    return INF_DISTANCE;
+  return graph.getVertex(netDeviceFace->GetNetDevice()->GetNode()->GetObject<GlobalRouter>());
+}
+
+} // namespace
+
+size_t GlobalRoutingHelper::s_nThreads = 0;
+bool GlobalRoutingHelper::s_isIncrementalRouting = false;
+
+void
+GlobalRoutingHelper::SetNThreads(size_t nThreads)
+{
+  s_nThreads = nThreads;
+}
+
+size_t
+GlobalRoutingHelper::GetNThreads()
+{
+  if (s_nThreads != 0)
+    return s_nThreads;
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+void
+GlobalRoutingHelper::SetIncrementalRouting(bool enable)
+{
+  s_isIncrementalRouting = enable;
+  if (!enable)
+    clearIncrementalState();
+}
+
+bool
+GlobalRoutingHelper::IsIncrementalRouting()
+{
+  return s_isIncrementalRouting;
+}
+
+void
+GlobalRoutingHelper::CalculateRoutes()
+{
+  IncrementalState& state = getIncrementalState();
+  state.routes.clear();
+
+  // rebuilt, as metrics of faces may have changed
+  RoutingGraph& graph = getRoutingGraph(true);
+  calculateRoutes(graph, graph.getNodeVertices(), false, false);
+}
+
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes()
+{
+  // routes through all faces are not updated incrementally
+  IncrementalState& state = getIncrementalState();
+  state.routes.clear();
+
+  RoutingGraph& graph = getRoutingGraph(true);
+  calculateRoutes(graph, graph.getNodeVertices(), true, false);
+}
+
+void
+GlobalRoutingHelper::NotifyLinkChange(shared_ptr<Face> face1, shared_ptr<Face> face2, bool isUp)
+{
+  if (!s_isIncrementalRouting)
+    return;
+
+  NS_ASSERT(face1 != nullptr && face2 != nullptr);
+  IncrementalState& state = getIncrementalState();
+  scheduleIncrementalStateCleanup();
+
+  if (isUp) {
+    state.failedFaces.erase(face1);
+    state.failedFaces.erase(face2);
+  }
+  else {
+    bool isNew1 = state.failedFaces.insert(face1).second;
+    bool isNew2 = state.failedFaces.insert(face2).second;
+    if (!isNew1 && !isNew2)
+      return; // already failed
+  }
+
+  if (state.routes.empty())
+    return; // routes were not calculated yet
+
+  // sources with the link on a shortest path, in the graph that has the link
+  RoutingGraph& graph = getRoutingGraph(false);
+  graph.setFaceFailed(face1, false);
+  graph.setFaceFailed(face2, false);
+
+  uint32_t vertex1 = getFaceVertex(graph, face1);
+  uint32_t vertex2 = getFaceVertex(graph, face2);
+  if (vertex1 == INF_DISTANCE || vertex2 == INF_DISTANCE) {
+    NS_LOG_DEBUG("Link is not known to GlobalRouter");
+    return;
+  }
+
+  std::vector<uint32_t> to1 = graph.computeDistancesTo(vertex1);
+  std::vector<uint32_t> to2 = graph.computeDistancesTo(vertex2);
+  uint64_t metric1 = face1->getMetric();
+  uint64_t metric2 = face2->getMetric();
+
+  std::vector<uint32_t> affected;
+  std::vector<uint32_t> sources = graph.getNodeVertices();
+  for (uint32_t source : sources) {
+    if (state.routes.count(graph.nodes[source]->GetId()) == 0)
+      continue;
+
+    bool isOnPath = (to1[source] != INF_DISTANCE && to1[source] + metric1 == to2[source])
+                    || (to2[source] != INF_DISTANCE && to2[source] + metric2 == to1[source]);
+    if (isOnPath)
+      affected.push_back(source);
+  }
+  NS_LOG_DEBUG("Link " << (isUp ? "recovery" : "failure") << " affects " << affected.size()
+               << " of " << sources.size() << " nodes");
+
+  graph.setFaceFailed(face1, !isUp);
+  graph.setFaceFailed(face2, !isUp);
+  calculateRoutes(graph, affected, false, true);
 }
 
 } // namespace ndn
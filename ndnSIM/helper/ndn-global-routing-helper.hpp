@@ -21,6 +21,7 @@
 #define NDN_GLOBAL_ROUTING_HELPER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
 
 #include "ns3/ptr.h"
 
@@ -96,17 +97,86 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest paths of different nodes are computed in parallel (see SetNThreads), batch by
+   * batch, and routes of each batch are installed on the simulation thread.
+   *
+   * The GlobalRouter graph is copied into flat adjacency arrays once per call, with the metrics
+   * of the faces at that time.  Incremental updates on link changes reuse the copy, unless
+   * edges or prefixes were added to GlobalRouters in the meantime.
    */
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Set the number of threads computing shortest paths
+   *
+   * Zero (default) uses one thread per hardware thread; one computes on the simulation thread.
+   */
+  static void
+  SetNThreads(size_t nThreads);
+
+  static size_t
+  GetNThreads();
+
+  /**
+   * @brief Enables or disables incremental updates of routes on link failures and recoveries
+   *
+   * With incremental routing, CalculateRoutes remembers the routes installed on each node.
+   * When LinkControlHelper fails or recovers a link, only nodes that have the link on one of
+   * their shortest paths recompute their routes, and only the differences are applied to
+   * their FIBs.  Failed links are also excluded from later CalculateRoutes calls.
+   *
+   * Routes installed by CalculateAllPossibleRoutes are not updated.
+   *
+   * Disabled by default.
+   */
+  static void
+  SetIncrementalRouting(bool enable);
+
+  static bool
+  IsIncrementalRouting();
+
+  /**
+   * @brief Update routes after the link between face1 and face2 failed or recovered
+   *
+   * Called by LinkControlHelper; does nothing unless incremental routing is enabled.
+   *
+   * @param face1 face of one node
+   * @param face2 face of the other node, on the same link
+   * @param isUp  whether the link recovered or failed
+   */
+  static void
+  NotifyLinkChange(shared_ptr<Face> face1, shared_ptr<Face> face2, bool isUp);
+
+  /**
+   * @brief Enables or disables aggregation of spatial prefixes by CalculateRoutes
+   *
+   * With aggregation, the routes of a node to prefixes with a spatial part
+   * (/S/<region>/<subregion>/.../A/<application>) are collapsed into the shortest spatial
+   * prefix /S/<region>/... under which all routes have the same set of nexthop faces.
+   * Where nexthops diverge, or the node itself originates a prefix, the children are
+   * installed instead, aggregated in the same way.  Other prefixes are installed as they are.
+   *
+   * Interests for names that no route covered, but that fall under an aggregated prefix,
+   * follow the aggregated route, as with any route summarization.
+   *
+   * Disabled by default.
+   */
+  static void
+  SetSpatialAggregation(bool enable);
+
+  static bool
+  IsSpatialAggregation();
+
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
    * Refer to the implementation for more details.
    *
    * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   *consuming).  The shortest paths through different faces are computed in parallel, as in
+   * CalculateRoutes.
    */
   static void
   CalculateAllPossibleRoutes();
@@ -114,6 +184,11 @@ public:
 private:
   void
   Install(Ptr<Channel> channel);
+
+private:
+  static bool s_isSpatialAggregation;
+  static size_t s_nThreads;
+  static bool s_isIncrementalRouting;
 };
 
 } // namespace ndn
@@ -32,6 +32,11 @@ namespace ndn {
  * @ingroup ndn-helpers
  * @brief Helper class to control the up or down statuss of an NDN link connecting two specific
  *        nodes
+ *
+ * With GlobalRoutingHelper::SetIncrementalRouting, routes of the affected nodes are updated
+ * on every failure and recovery.
+ *
+ * To fail many links, or radios of wireless nodes, use FailureInjectionHelper.
  */
 class LinkControlHelper {
 public:
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-parameter-sweep.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <thread>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ParameterSweep");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+void
+createDirectory(const std::string& dir)
+{
+  try {
+    boost::filesystem::create_directories(dir);
+  }
+  catch (const boost::filesystem::filesystem_error& e) {
+    throw std::runtime_error("Directory " + dir + " cannot be created: " + e.what());
+  }
+}
+
+/** \brief exit status of a child as in a shell, 128 + signal number if it was killed
+ */
+int
+getExitStatus(int status)
+{
+  if (WIFEXITED(status))
+    return WEXITSTATUS(status);
+  if (WIFSIGNALED(status))
+    return 128 + WTERMSIG(status);
+  return 1;
+}
+
+} // namespace
+
+ParameterSweep::ParameterSweep(const ScenarioDescription& scenario)
+  : m_scenario(scenario)
+  , m_nProcesses(0)
+{
+}
+
+void
+ParameterSweep::setNProcesses(size_t nProcesses)
+{
+  m_nProcesses = nProcesses;
+}
+
+size_t
+ParameterSweep::getNProcesses() const
+{
+  if (m_nProcesses > 0)
+    return m_nProcesses;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t
+ParameterSweep::run(const std::string& outputDir) const
+{
+  if (NodeList::GetNNodes() > 0) {
+    throw std::logic_error("ParameterSweep must run before any node is created");
+  }
+
+  std::vector<ScenarioDescription::Parameters> configurations = m_scenario.expandSweep();
+  std::vector<std::string> dirs;
+  for (size_t i = 0; i < configurations.size(); ++i) {
+    dirs.push_back((boost::filesystem::path(outputDir) / std::to_string(i)).string());
+    createDirectory(dirs.back());
+
+    std::ofstream os((boost::filesystem::path(dirs.back()) / "parameters.txt").string().c_str());
+    for (const auto& parameter : configurations[i]) {
+      os << parameter.first << " " << parameter.second << "\n";
+    }
+  }
+
+  std::vector<int> statuses(configurations.size(), 1);
+  std::map<pid_t, size_t> running;
+  size_t next = 0;
+  while (next < configurations.size() || !running.empty()) {
+    if (next < configurations.size() && running.size() < getNProcesses()) {
+      // buffered output would be written by the child too
+      std::cout.flush();
+      std::cerr.flush();
+
+      pid_t pid = fork();
+      if (pid == 0) {
+        int status = 0;
+        try {
+          m_scenario.run(configurations[next], dirs[next]);
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Configuration " << next << " failed: " << e.what() << std::endl;
+          status = 1;
+        }
+        std::cout.flush();
+        _exit(status);
+      }
+
+      if (pid < 0) {
+        NS_LOG_ERROR("Configuration " << next << " cannot be started: " << std::strerror(errno));
+      }
+      else {
+        NS_LOG_INFO("Configuration " << next << " started, pid " << pid);
+        running[pid] = next;
+      }
+      ++next;
+      continue;
+    }
+
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR)
+        continue;
+      NS_LOG_ERROR("waitpid failed: " << std::strerror(errno));
+      break;
+    }
+
+    auto child = running.find(pid);
+    if (child == running.end())
+      continue; // not started by the sweep
+    statuses[child->second] = getExitStatus(status);
+    NS_LOG_INFO("Configuration " << child->second << " finished with status "
+                << statuses[child->second]);
+    running.erase(child);
+  }
+
+  std::ofstream os((boost::filesystem::path(outputDir) / "sweep.txt").string().c_str());
+  os << "Configuration";
+  if (!configurations.empty()) {
+    for (const auto& parameter : configurations.front()) {
+      os << "\t" << parameter.first;
+    }
+  }
+  os << "\tStatus\n";
+
+  size_t nFailed = 0;
+  for (size_t i = 0; i < configurations.size(); ++i) {
+    os << i;
+    for (const auto& parameter : configurations[i]) {
+      os << "\t" << parameter.second;
+    }
+    os << "\t" << statuses[i] << "\n";
+    nFailed += statuses[i] != 0;
+  }
+  return nFailed;
+}
+
+} // namespace ndn
+} // namespace ns3
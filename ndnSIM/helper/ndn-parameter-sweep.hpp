@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_HELPER_NDN_PARAMETER_SWEEP_HPP
+#define NDNSIM_HELPER_NDN_PARAMETER_SWEEP_HPP
+
+#include "ndn-scenario-description.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Runs all configurations of the sweep of a ScenarioDescription in parallel
+ *
+ * ns-3 runs one simulation per process, so every configuration runs in a child process forked
+ * from the caller.  Configuration i writes its trace files to <outputDir>/<i>/, next to
+ * parameters.txt with its parameter values.  <outputDir>/sweep.txt lists the configurations
+ * with their parameter values and exit status, one line each, to join with the trace files:
+ *
+ *     ndn::ScenarioDescription scenario("scenario.info");
+ *     ndn::ParameterSweep sweep(scenario);
+ *     size_t nFailed = sweep.run("results");
+ *
+ * The sweep must run before any node is created in the calling process.
+ */
+class ParameterSweep
+{
+public:
+  explicit
+  ParameterSweep(const ScenarioDescription& scenario);
+
+  /**
+   * @brief Set the maximum number of configurations running at the same time
+   * @param nProcesses 0 to use all cores
+   */
+  void
+  setNProcesses(size_t nProcesses);
+
+  size_t
+  getNProcesses() const;
+
+  /**
+   * @brief Run all configurations and wait for them to finish
+   * @return number of configurations that failed
+   * @throw std::logic_error nodes have been created in the calling process
+   * @throw std::runtime_error an output directory cannot be created
+   */
+  size_t
+  run(const std::string& outputDir) const;
+
+private:
+  const ScenarioDescription& m_scenario;
+  size_t m_nProcesses;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_PARAMETER_SWEEP_HPP
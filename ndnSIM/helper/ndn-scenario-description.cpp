@@ -0,0 +1,345 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-scenario-description.hpp"
+#include "ndn-app-helper.hpp"
+#include "ndn-fib-helper.hpp"
+#include "ndn-global-routing-helper.hpp"
+#include "ndn-strategy-choice-helper.hpp"
+
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+#include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/property_tree/info_parser.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+using boost::property_tree::ptree;
+
+namespace {
+
+const std::set<std::string> SECTIONS = {"parameters", "sweep", "stop", "rng-run", "defaults",
+                                        "stack", "topology", "strategies", "routes", "apps",
+                                        "tracers"};
+
+template<class T>
+T
+parseNumber(const std::string& value, const std::string& name, const std::string& key)
+{
+  try {
+    return boost::lexical_cast<T>(value);
+  }
+  catch (const boost::bad_lexical_cast&) {
+    throw ScenarioDescription::Error(name + ": malformed value \"" + value + "\" of " + key);
+  }
+}
+
+std::string
+joinPath(const std::string& dir, const std::string& file)
+{
+  if (dir.empty() || file.empty() || file[0] == '/')
+    return file;
+  return dir.back() == '/' ? dir + file : dir + "/" + file;
+}
+
+} // namespace
+
+ScenarioDescription::ScenarioDescription(const std::string& file)
+  : m_name(file)
+{
+  std::ifstream input(file.c_str());
+  if (!input.is_open()) {
+    throw Error("File " + file + " cannot be opened for reading");
+  }
+  *this = ScenarioDescription(input, file);
+}
+
+ScenarioDescription::ScenarioDescription(std::istream& input, const std::string& name)
+  : m_name(name)
+{
+  try {
+    boost::property_tree::read_info(input, m_tree);
+  }
+  catch (const boost::property_tree::info_parser_error& e) {
+    throw Error(name + ":" + std::to_string(e.line()) + ": " + e.message());
+  }
+
+  for (const auto& section : m_tree) {
+    if (SECTIONS.count(section.first) == 0) {
+      throw Error(name + ": unknown section \"" + section.first + "\"");
+    }
+  }
+  if (m_tree.count("topology") == 0) {
+    throw Error(name + ": section \"topology\" is missing");
+  }
+
+  for (const auto& parameter : m_tree.get_child("parameters", ptree())) {
+    m_defaults[parameter.first] = parameter.second.get_value<std::string>();
+  }
+}
+
+std::vector<ScenarioDescription::Parameters>
+ScenarioDescription::expandSweep() const
+{
+  std::vector<Parameters> configurations = {Parameters()};
+  for (const auto& dimension : m_tree.get_child("sweep", ptree())) {
+    std::vector<std::string> values = split(dimension.second.get_value<std::string>());
+    if (values.empty()) {
+      throw Error(m_name + ": sweep of " + dimension.first + " has no values");
+    }
+
+    std::vector<Parameters> expanded;
+    for (const Parameters& configuration : configurations) {
+      for (const std::string& value : values) {
+        expanded.push_back(configuration);
+        expanded.back()[dimension.first] = value;
+      }
+    }
+    configurations.swap(expanded);
+  }
+
+  for (Parameters& configuration : configurations) {
+    configuration.insert(m_defaults.begin(), m_defaults.end()); // keeps the swept values
+  }
+  return configurations;
+}
+
+Time
+ScenarioDescription::install(ScenarioHelper& helper, const Parameters& parameters,
+                             const std::string& outputDir) const
+{
+  Parameters values = parameters;
+  values.insert(m_defaults.begin(), m_defaults.end());
+
+  auto getValue = [&] (const ptree& node) {
+    return substitute(node.get_value<std::string>(), values);
+  };
+  auto getTokens = [&] (const std::string& key, const ptree& node, size_t nTokens) {
+    std::vector<std::string> tokens = split(getValue(node));
+    if (tokens.size() != nTokens) {
+      throw Error(m_name + ": " + key + " \"" + node.get_value<std::string>() + "\" must have " +
+                  std::to_string(nTokens) + " values");
+    }
+    return tokens;
+  };
+  auto unknownKey = [this] (const std::string& section, const std::string& key) {
+    return Error(m_name + ": unknown key \"" + key + "\" in section \"" + section + "\"");
+  };
+
+  for (const auto& attribute : m_tree.get_child("defaults", ptree())) {
+    Config::SetDefault(attribute.first, StringValue(getValue(attribute.second)));
+  }
+
+  if (m_tree.count("rng-run") > 0) {
+    RngSeedManager::SetRun(parseNumber<uint64_t>(getValue(m_tree.get_child("rng-run")),
+                                                 m_name, "rng-run"));
+  }
+
+  for (const auto& option : m_tree.get_child("stack", ptree())) {
+    std::string value = getValue(option.second);
+    if (option.first == "cs-size") {
+      helper.getStackHelper().setCsSize(parseNumber<size_t>(value, m_name, option.first));
+    }
+    else if (option.first == "lean") {
+      if (value != "yes" && value != "no") {
+        throw Error(m_name + ": lean must be yes or no");
+      }
+      helper.getStackHelper().SetLeanMode(value == "yes");
+    }
+    else {
+      throw unknownKey("stack", option.first);
+    }
+  }
+
+  std::vector<std::vector<std::string>> cliques;
+  for (const auto& link : m_tree.get_child("topology")) {
+    if (link.first != "link") {
+      throw unknownKey("topology", link.first);
+    }
+    cliques.push_back(split(getValue(link.second)));
+  }
+  helper.createTopology(cliques);
+
+  for (const auto& strategy : m_tree.get_child("strategies", ptree())) {
+    if (strategy.first != "strategy") {
+      throw unknownKey("strategies", strategy.first);
+    }
+    std::vector<std::string> tokens = getTokens(strategy.first, strategy.second, 2);
+    StrategyChoiceHelper::InstallAll(tokens[0], tokens[1]);
+  }
+
+  std::vector<std::pair<std::string, std::string>> origins;
+  for (const auto& route : m_tree.get_child("routes", ptree())) {
+    if (route.first == "route") {
+      std::vector<std::string> tokens = getTokens(route.first, route.second, 4);
+      FibHelper::AddRoute(helper.getNode(tokens[0]), tokens[2],
+                          helper.getFace(tokens[0], tokens[1]),
+                          parseNumber<int32_t>(tokens[3], m_name, "metric"));
+    }
+    else if (route.first == "origin") {
+      std::vector<std::string> tokens = getTokens(route.first, route.second, 2);
+      origins.emplace_back(tokens[0], tokens[1]);
+    }
+    else {
+      throw unknownKey("routes", route.first);
+    }
+  }
+
+  for (const auto& app : m_tree.get_child("apps", ptree())) {
+    if (app.first != "app") {
+      throw unknownKey("apps", app.first);
+    }
+
+    std::string node, type, start = "0s", stop;
+    std::vector<std::pair<std::string, std::string>> attributes;
+    for (const auto& option : app.second) {
+      std::string value = getValue(option.second);
+      if (option.first == "node")
+        node = value;
+      else if (option.first == "type")
+        type = value;
+      else if (option.first == "start")
+        start = value;
+      else if (option.first == "stop")
+        stop = value;
+      else
+        attributes.emplace_back(option.first, value);
+    }
+    if (node.empty() || type.empty()) {
+      throw Error(m_name + ": app must have node and type");
+    }
+
+    AppHelper appHelper(type);
+    for (const auto& attribute : attributes) {
+      appHelper.SetAttribute(attribute.first, StringValue(attribute.second));
+    }
+    ApplicationContainer installedApp = appHelper.Install(helper.getNode(node));
+    installedApp.Start(Time(start));
+    if (!stop.empty())
+      installedApp.Stop(Time(stop));
+  }
+
+  if (!origins.empty()) {
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    for (const auto& origin : origins) {
+      routingHelper.AddOrigin(origin.second, helper.getNode(origin.first));
+    }
+    GlobalRoutingHelper::CalculateRoutes();
+  }
+
+  for (const auto& tracer : m_tree.get_child("tracers", ptree())) {
+    std::vector<std::string> tokens = split(getValue(tracer.second));
+    if (tokens.empty() || tokens.size() > 2) {
+      throw Error(m_name + ": tracer " + tracer.first + " must have a file and an optional period");
+    }
+    std::string file = joinPath(outputDir, tokens[0]);
+    Time period = tokens.size() > 1 ? Time(tokens[1]) : Seconds(0.5);
+
+    if (tracer.first == "l3-rate")
+      L3RateTracer::InstallAll(file, period);
+    else if (tracer.first == "app-delay")
+      AppDelayTracer::InstallAll(file);
+    else if (tracer.first == "cs")
+      CsTracer::InstallAll(file, period);
+    else if (tracer.first == "l2-rate")
+      L2RateTracer::InstallAll(file, period);
+    else
+      throw unknownKey("tracers", tracer.first);
+  }
+
+  if (m_tree.count("stop") == 0)
+    return Time();
+  return Time(getValue(m_tree.get_child("stop")));
+}
+
+void
+ScenarioDescription::run(const Parameters& parameters, const std::string& outputDir) const
+{
+  {
+    ScenarioHelper helper;
+    Time stop = install(helper, parameters, outputDir);
+    if (stop.IsStrictlyPositive())
+      Simulator::Stop(stop);
+    Simulator::Run();
+  }
+
+  // tracers flush their files when destroyed
+  L3RateTracer::Destroy();
+  AppDelayTracer::Destroy();
+  CsTracer::Destroy();
+  L2RateTracer::Destroy();
+
+  Simulator::Destroy();
+  Names::Clear();
+  GlobalRouter::clear();
+}
+
+std::string
+ScenarioDescription::substitute(const std::string& value, const Parameters& parameters)
+{
+  std::string result;
+  size_t pos = 0;
+  while (true) {
+    size_t begin = value.find("${", pos);
+    if (begin == std::string::npos)
+      break;
+    size_t end = value.find('}', begin);
+    if (end == std::string::npos) {
+      throw Error("Unterminated parameter reference in \"" + value + "\"");
+    }
+
+    std::string name = value.substr(begin + 2, end - begin - 2);
+    auto parameter = parameters.find(name);
+    if (parameter == parameters.end()) {
+      throw Error("Unknown parameter \"" + name + "\" in \"" + value + "\"");
+    }
+    result.append(value, pos, begin - pos).append(parameter->second);
+    pos = end + 1;
+  }
+  return result.append(value, pos, std::string::npos);
+}
+
+std::vector<std::string>
+ScenarioDescription::split(const std::string& value)
+{
+  std::istringstream is(value);
+  return std::vector<std::string>(std::istream_iterator<std::string>(is),
+                                  std::istream_iterator<std::string>());
+}
+
+} // namespace ndn
+} // namespace ns3
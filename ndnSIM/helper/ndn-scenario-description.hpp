@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_HELPER_NDN_SCENARIO_DESCRIPTION_HPP
+#define NDNSIM_HELPER_NDN_SCENARIO_DESCRIPTION_HPP
+
+#include "ndn-scenario-helper.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Scenario for ScenarioHelper described in a file, with a grid of parameters to sweep
+ *
+ * The file uses the INFO format of the NFD configuration file.  Any value may refer to
+ * parameters as ${name}:
+ *
+ *     ; defaults of the parameters
+ *     parameters
+ *     {
+ *       frequency 1
+ *       strategy /localhost/nfd/strategy/best-route
+ *       run 1
+ *     }
+ *
+ *     ; every combination of the listed values is one configuration of the sweep
+ *     sweep
+ *     {
+ *       frequency "1 10 100"
+ *       strategy "/localhost/nfd/strategy/best-route /localhost/nfd/strategy/multicast"
+ *     }
+ *
+ *     stop 100s
+ *     rng-run ${run}              ; ns3::RngSeedManager::SetRun
+ *
+ *     defaults                    ; ns3::Config::SetDefault
+ *     {
+ *       ns3::PointToPointNetDevice::DataRate 10Mbps
+ *     }
+ *
+ *     stack
+ *     {
+ *       cs-size 100               ; StackHelper::setCsSize
+ *       lean no                   ; StackHelper::SetLeanMode
+ *     }
+ *
+ *     topology
+ *     {
+ *       link "1 2"                ; clique of nodes connected point-to-point
+ *       link "2 3"
+ *     }
+ *
+ *     strategies
+ *     {
+ *       strategy "/prefix ${strategy}"
+ *     }
+ *
+ *     routes
+ *     {
+ *       route "1 2 /prefix 1"     ; node, next hop node, prefix and metric
+ *       origin "3 /other"         ; routes to /other are calculated by GlobalRoutingHelper
+ *     }
+ *
+ *     apps
+ *     {
+ *       app
+ *       {
+ *         node 1
+ *         type ns3::ndn::ConsumerCbr
+ *         start 0s
+ *         stop 10s
+ *         Prefix /prefix          ; other keys are attributes of the application
+ *         Frequency ${frequency}
+ *       }
+ *     }
+ *
+ *     tracers                     ; files are written to the output directory of the run
+ *     {
+ *       l3-rate "rate-trace.txt 1s"
+ *       app-delay app-delays-trace.txt
+ *       cs "cs-trace.txt 1s"
+ *       l2-rate "l2-rate-trace.txt 1s"
+ *     }
+ *
+ * Only "topology" is mandatory.
+ *
+ * @sa ParameterSweep to run the configurations of the sweep in parallel
+ */
+class ScenarioDescription
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  typedef std::map<std::string, std::string> Parameters;
+
+  /**
+   * @brief Read the scenario from the file
+   * @throw Error the file cannot be read or is malformed
+   */
+  explicit
+  ScenarioDescription(const std::string& file);
+
+  /**
+   * @brief Read the scenario from the stream, @p name is used in error messages
+   * @throw Error the scenario is malformed
+   */
+  ScenarioDescription(std::istream& input, const std::string& name);
+
+  const Parameters&
+  getDefaultParameters() const
+  {
+    return m_defaults;
+  }
+
+  /**
+   * @brief Get all configurations of the sweep
+   *
+   * Dimensions vary in the order of the sweep section, the last one the fastest.  Without
+   * a sweep section, the only configuration has the default parameters.
+   */
+  std::vector<Parameters>
+  expandSweep() const;
+
+  /**
+   * @brief Create the scenario in the current simulation
+   * @param helper helper to create the scenario with, its topology must not be created yet
+   * @param parameters values of the parameters, on top of the defaults
+   * @param outputDir directory of the trace files, must exist
+   * @return stop time of the simulation
+   * @throw Error a value is malformed or refers to an unknown parameter
+   * @throw std::invalid_argument a node or link does not exist
+   */
+  Time
+  install(ScenarioHelper& helper, const Parameters& parameters,
+          const std::string& outputDir) const;
+
+  /**
+   * @brief Create the scenario, run it until the stop time and destroy the simulation
+   *
+   * Trace files are complete when the function returns.
+   */
+  void
+  run(const Parameters& parameters, const std::string& outputDir) const;
+
+private:
+  /**
+   * @brief Replace the references to parameters in the value
+   */
+  static std::string
+  substitute(const std::string& value, const Parameters& parameters);
+
+  static std::vector<std::string>
+  split(const std::string& value);
+
+private:
+  std::string m_name;
+  boost::property_tree::ptree m_tree;
+  Parameters m_defaults;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_HELPER_NDN_SCENARIO_DESCRIPTION_HPP
@@ -37,6 +37,16 @@ ScenarioHelper::ScenarioHelper()
 
 void
 ScenarioHelper::createTopology(std::initializer_list<std::initializer_list<std::string>/*node clique*/> topology)
+{
+  std::vector<std::vector<std::string>> cliques;
+  for (auto&& clique : topology) {
+    cliques.emplace_back(clique);
+  }
+  createTopology(cliques);
+}
+
+void
+ScenarioHelper::createTopology(const std::vector<std::vector<std::string>>& topology)
 {
   if (m_isTopologyInitialized) {
     throw std::logic_error("Topology cannot be created twice");
@@ -85,6 +95,12 @@ ScenarioHelper::disableStatusServer()
   ndnHelper.disableStatusServer();
 }
 
+void
+ScenarioHelper::setLeanMode()
+{
+  ndnHelper.SetLeanMode(true);
+}
+
 void
 ScenarioHelper::addRoutes(std::initializer_list<ScenarioHelper::RouteInfo> routes)
 {
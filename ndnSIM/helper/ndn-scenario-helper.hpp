@@ -27,6 +27,7 @@
 
 #include <ndn-cxx/name.hpp>
 #include <map>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -110,6 +111,13 @@ public:
   void
   createTopology(std::initializer_list<std::initializer_list<std::string>/*node clique*/> topology);
 
+  /**
+   * @brief Create topology from cliques built at run time
+   * @throw std::logic_error if createTopology is called more than once
+   */
+  void
+  createTopology(const std::vector<std::vector<std::string>>& topology);
+
   /**
    * @brief Create routes between topology nodes
    * @throw std::invalid_argument if the nodes or links between nodes do not exist
@@ -181,6 +189,21 @@ public: // topology accessors
   void
   disableStatusServer();
 
+  /**
+   * \brief Install only the data plane of NFD, see StackHelper::SetLeanMode
+   */
+  void
+  setLeanMode();
+
+  /**
+   * \brief Get the helper that installs the stack, to be configured before createTopology
+   */
+  StackHelper&
+  getStackHelper()
+  {
+    return ndnHelper;
+  }
+
 private:
   Ptr<Node>
   getOrCreateNode(const std::string& nodeName);
@@ -23,6 +23,8 @@
 #include "ns3/names.h"
 #include "ns3/string.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
@@ -30,6 +32,8 @@
 #include "utils/dummy-keychain.hpp"
 #include "model/cs/ndn-content-store.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
 #include <limits>
 #include <map>
 #include <boost/lexical_cast.hpp>
@@ -42,10 +46,22 @@ namespace ndn {
 StackHelper::StackHelper()
   : m_needSetDefaultRoutes(false)
   , m_maxCsSize(100)
+  , m_maxCsBytes(0)
+  , m_dnlFalsePositiveRate(0.0)
+  , m_isNeighborUnicast(false)
+  , m_neighborTimeout(Seconds(2))
+  , m_isAggregation(false)
+  , m_holdTime(MilliSeconds(1))
+  , m_maxDefer(Seconds(0))
+  , m_maxShapedInterests(64)
+  , m_isOverhearing(false)
+  , m_overheardDataLifetime(Seconds(1))
   , m_isRibManagerDisabled(false)
   , m_isFaceManagerDisabled(false)
   , m_isStatusServerDisabled(false)
   , m_isStrategyChoiceManagerDisabled(false)
+  , m_isLean(false)
+  , m_isPrototype(false)
 {
   setCustomNdnCxxClocks();
 
@@ -83,6 +99,45 @@ StackHelper::SetDefaultRoutes(bool needSet)
   m_needSetDefaultRoutes = needSet;
 }
 
+void
+StackHelper::SetNeighborUnicast(bool enable, Time neighborTimeout)
+{
+  NS_LOG_FUNCTION(this << enable << neighborTimeout);
+  m_isNeighborUnicast = enable;
+  m_neighborTimeout = neighborTimeout;
+}
+
+void
+StackHelper::SetAggregation(bool enable, Time holdTime)
+{
+  NS_LOG_FUNCTION(this << enable << holdTime);
+  m_isAggregation = enable;
+  m_holdTime = holdTime;
+}
+
+void
+StackHelper::SetBroadcastDefer(Time maxDefer)
+{
+  NS_LOG_FUNCTION(this << maxDefer);
+  m_maxDefer = maxDefer;
+}
+
+void
+StackHelper::SetInterestShaping(DataRate dataRate, uint32_t maxQueued)
+{
+  NS_LOG_FUNCTION(this << dataRate << maxQueued);
+  m_shapingRate = dataRate;
+  m_maxShapedInterests = maxQueued;
+}
+
+void
+StackHelper::SetOverhearing(bool enable, Time lifetime)
+{
+  NS_LOG_FUNCTION(this << enable << lifetime);
+  m_isOverhearing = enable;
+  m_overheardDataLifetime = lifetime;
+}
+
 void
 StackHelper::SetStackAttributes(const std::string& attr1, const std::string& value1,
                                 const std::string& attr2, const std::string& value2,
@@ -125,12 +180,34 @@ StackHelper::setCsSize(size_t maxSize)
   m_maxCsSize = maxSize;
 }
 
+void
+StackHelper::setCsMaxBytes(size_t maxBytes)
+{
+  m_maxCsBytes = maxBytes;
+}
+
+void
+StackHelper::setCsPolicy(const std::string& policyName)
+{
+  m_csPolicyName = policyName;
+}
+
+void
+StackHelper::setDeadNonceListFalsePositiveRate(double falsePositiveRate)
+{
+  m_dnlFalsePositiveRate = falsePositiveRate;
+}
+
 Ptr<FaceContainer>
 StackHelper::Install(const NodeContainer& c) const
 {
   Ptr<FaceContainer> faces = Create<FaceContainer>();
+  Ptr<L3Protocol> prototype;
   for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
-    faces->AddAll(Install(*i));
+    faces->AddAll(installStack(*i, prototype));
+    if (m_isPrototype && prototype == nullptr) {
+      prototype = (*i)->GetObject<L3Protocol>();
+    }
   }
   return faces;
 }
@@ -143,6 +220,12 @@ StackHelper::InstallAll() const
 
 Ptr<FaceContainer>
 StackHelper::Install(Ptr<Node> node) const
+{
+  return installStack(node, nullptr);
+}
+
+Ptr<FaceContainer>
+StackHelper::installStack(Ptr<Node> node, Ptr<L3Protocol> prototype) const
 {
   Ptr<FaceContainer> faces = Create<FaceContainer>();
 
@@ -153,6 +236,9 @@ StackHelper::Install(Ptr<Node> node) const
   }
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
+  if (prototype != nullptr) {
+    ndn->setPrototype(prototype);
+  }
 
   if (m_isRibManagerDisabled) {
     ndn->getConfig().put("ndnSIM.disable_rib_manager", true);
@@ -170,7 +256,20 @@ StackHelper::Install(Ptr<Node> node) const
     ndn->getConfig().put("ndnSIM.disable_strategy_choice_manager", true);
   }
 
+  if (m_isLean) {
+    ndn->getConfig().put("ndnSIM.lean", true);
+  }
+
   ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+  if (m_maxCsBytes != 0) {
+    ndn->getConfig().put("tables.cs_max_bytes", m_maxCsBytes);
+  }
+  if (!m_csPolicyName.empty()) {
+    ndn->getConfig().put("tables.cs_policy", m_csPolicyName);
+  }
+  if (m_dnlFalsePositiveRate != 0.0) {
+    ndn->getConfig().put("ndnSIM.dead_nonce_list_fp_rate", m_dnlFalsePositiveRate);
+  }
 
   // Create and aggregate content store if NFD's contest store has been disabled
   if (m_maxCsSize == 0) {
@@ -180,6 +279,11 @@ StackHelper::Install(Ptr<Node> node) const
   // Aggregate L3Protocol on node (must be after setting ndnSIM CS)
   node->AggregateObject(ndn);
 
+  if (m_isOverhearing) {
+    ndn->getForwarder()->setOverheardDataLifetime(
+      ::ndn::time::nanoseconds(m_overheardDataLifetime.GetNanoSeconds()));
+  }
+
   for (uint32_t index = 0; index < node->GetNDevices(); index++) {
     Ptr<NetDevice> device = node->GetDevice(index);
     // This check does not make sense: LoopbackNetDevice is installed only if IP stack is installed,
@@ -193,6 +297,71 @@ StackHelper::Install(Ptr<Node> node) const
   return faces;
 }
 
+void
+StackHelper::InstallLazily(const NodeContainer& c) const
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    Ptr<Node> node = *i;
+    if (node->GetObject<L3Protocol>() != 0 || m_inactiveNodes.count(node->GetId()) > 0) {
+      NS_FATAL_ERROR("Cannot re-install NDN stack on node " << node->GetId());
+    }
+
+    Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+    if (mobility == 0) {
+      Install(node);
+      continue;
+    }
+
+    m_inactiveNodes[node->GetId()] = mobility->GetPosition();
+    mobility->TraceConnectWithoutContext("CourseChange",
+                                         MakeCallback(&StackHelper::ActivateIfMoved, this));
+    // before applications installed later on the node are started
+    Simulator::ScheduleWithContext(node->GetId(), Seconds(0),
+                                   &StackHelper::ActivateIfRunsApplications, this, node);
+  }
+}
+
+void
+StackHelper::InstallAllLazily() const
+{
+  InstallLazily(NodeContainer::GetGlobal());
+}
+
+void
+StackHelper::ActivateIfMoved(Ptr<const MobilityModel> mobility) const
+{
+  Ptr<Node> node = mobility->GetObject<Node>();
+  if (node == 0)
+    return;
+
+  auto it = m_inactiveNodes.find(node->GetId());
+  if (it == m_inactiveNodes.end())
+    return; // already active, the trace source stays connected
+
+  Vector velocity = mobility->GetVelocity();
+  Vector position = mobility->GetPosition();
+  bool isMoving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+  bool hasMoved = position.x != it->second.x || position.y != it->second.y ||
+                  position.z != it->second.z;
+  if (isMoving || hasMoved)
+    Activate(node);
+}
+
+void
+StackHelper::ActivateIfRunsApplications(Ptr<Node> node) const
+{
+  if (node->GetNApplications() > 0 && m_inactiveNodes.count(node->GetId()) > 0)
+    Activate(node);
+}
+
+void
+StackHelper::Activate(Ptr<Node> node) const
+{
+  NS_LOG_DEBUG("Activating NDN stack on node " << node->GetId());
+  m_inactiveNodes.erase(node->GetId());
+  Install(node);
+}
+
 void
 StackHelper::AddNetDeviceFaceCreateCallback(TypeId netDeviceType,
                                             StackHelper::NetDeviceFaceCreateCallback callback)
@@ -228,6 +397,16 @@ StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
   NS_LOG_DEBUG("Creating default NetDeviceFace on node " << node->GetId());
 
   shared_ptr<NetDeviceFace> face = std::make_shared<NetDeviceFace>(node, netDevice);
+  if (m_isNeighborUnicast)
+    face->setNeighborUnicast(true, m_neighborTimeout);
+  if (m_isAggregation)
+    face->setAggregation(true, m_holdTime);
+  if (m_maxDefer.IsStrictlyPositive())
+    face->setBroadcastDefer(m_maxDefer);
+  if (m_shapingRate.GetBitRate() > 0)
+    face->setInterestShaping(m_shapingRate, m_maxShapedInterests);
+  if (m_isOverhearing)
+    face->setOverhearing(true);
 
   ndn->addFace(face);
   NS_LOG_LOGIC("Node " << node->GetId() << ": added NetDeviceFace as face #"
@@ -319,7 +498,13 @@ StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetD
 
   if (m_needSetDefaultRoutes) {
     // default route with lowest priority possible
-    FibHelper::AddRoute(node, "/", face, std::numeric_limits<int32_t>::max());
+    if (m_isPrototype) {
+      ndn->getForwarder()->getFib().insert("/").first
+        ->addNextHop(face, std::numeric_limits<int32_t>::max());
+    }
+    else {
+      FibHelper::AddRoute(node, "/", face, std::numeric_limits<int32_t>::max());
+    }
   }
   return face;
 }
@@ -348,5 +533,17 @@ StackHelper::disableStatusServer()
   m_isStatusServerDisabled = true;
 }
 
+void
+StackHelper::SetLeanMode(bool isLean)
+{
+  m_isLean = isLean;
+}
+
+void
+StackHelper::SetPrototypeMode(bool isPrototype)
+{
+  m_isPrototype = isPrototype;
+}
+
 } // namespace ndn
 } // namespace ns3
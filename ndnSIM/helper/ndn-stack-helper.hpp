@@ -22,10 +22,15 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/object-factory.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <map>
 
 #include "ndn-face-container.hpp"
 #include "ndn-fib-helper.hpp"
@@ -34,6 +39,7 @@
 namespace ns3 {
 
 class Node;
+class MobilityModel;
 
 namespace ndn {
 
@@ -75,6 +81,33 @@ public:
   void
   setCsSize(size_t maxSize);
 
+  /**
+   * @brief Set maximum size for NFD's Content Store (in bytes of wire encoding of stored Data)
+   *
+   * Entries are evicted until both this limit and the one set by setCsSize hold.
+   * 0 (default) means no limit in bytes.
+   */
+  void
+  setCsMaxBytes(size_t maxBytes);
+
+  /**
+   * @brief Set replacement policy of NFD's Content Store
+   * @param policyName "fifo" (priority FIFO, default), "lru", "2q" or "correlativity"
+   */
+  void
+  setCsPolicy(const std::string& policyName);
+
+  /**
+   * @brief Keep NFD's Dead Nonce List in a time-sliced Bloom filter
+   * @param falsePositiveRate probability that a non-looping Interest is considered looping;
+   *        0 (default) keeps exact hashes of Name and Nonce
+   *
+   * The filter needs a few bytes per Nonce, the exact list about 40 bytes.
+   * Use Forwarder::getDeadNonceList().getMemoryUsage() to compare.
+   */
+  void
+  setDeadNonceListFalsePositiveRate(double falsePositiveRate);
+
   /**
    * @brief Set ndnSIM 1.0 content store implementation and its attributes
    * @param contentStoreClass string, representing class of the content store
@@ -179,6 +212,47 @@ public:
   void
   SetDefaultRoutes(bool needSet);
 
+  /**
+   * \brief Set flag enabling unicast to known neighbors on faces of non point-to-point devices
+   * \see NetDeviceFace::setNeighborUnicast
+   */
+  void
+  SetNeighborUnicast(bool enable, Time neighborTimeout = Seconds(2));
+
+  /**
+   * \brief Set flag enabling aggregation of small packets on faces of non point-to-point devices
+   * \see NetDeviceFace::setAggregation
+   */
+  void
+  SetAggregation(bool enable, Time holdTime = MilliSeconds(1));
+
+  /**
+   * \brief Set maximum random delay of broadcast packets on faces of non point-to-point devices
+   * \see NetDeviceFace::setBroadcastDefer
+   */
+  void
+  SetBroadcastDefer(Time maxDefer);
+
+  /**
+   * \brief Set the rate of Data for which Interests are sent on faces of non point-to-point
+   *        devices, zero to disable Interest shaping
+   * \see NetDeviceFace::setInterestShaping
+   */
+  void
+  SetInterestShaping(DataRate dataRate, uint32_t maxQueued = 64);
+
+  /**
+   * \brief Set flag enabling overhearing of Data on faces of non point-to-point devices
+   *
+   * Overheard Data are remembered by the forwarder for \p lifetime, so that strategies can
+   * tell whether a neighbor has just served a name (see nfd::fw::Strategy::hasOverheardData).
+   * Whether they are also cached is decided by nfd::Forwarder::setOverheardDataAdmission.
+   *
+   * \see NetDeviceFace::setOverhearing
+   */
+  void
+  SetOverhearing(bool enable, Time lifetime = Seconds(1));
+
   static KeyChain&
   getKeyChain();
 
@@ -190,6 +264,37 @@ public:
   void
   Update(Ptr<Node> node);
 
+  /**
+   * \brief Install Ndn stack on each node in the container when it becomes active
+   *
+   * For scenarios where many nodes (e.g., vehicles of a mobility trace) enter the scene late, so
+   * that their forwarders and tables are not held until then.  A node is activated, i.e., the
+   * stack is installed as by Install, on the first course change of its MobilityModel that
+   * moves it, or at the start of the simulation if it has applications by then.  Nodes without
+   * MobilityModel are activated right away.
+   *
+   * The helper must not be destroyed before the simulation ends.  Routes of the global routing
+   * helper are computed only for the nodes active at the time.
+   */
+  void
+  InstallLazily(const NodeContainer& c) const;
+
+  /**
+   * \brief Install Ndn stack on all nodes in the simulation when they become active
+   * \see InstallLazily
+   */
+  void
+  InstallAllLazily() const;
+
+  /**
+   * \brief Number of nodes given to InstallLazily that are not active yet
+   */
+  size_t
+  GetNInactiveNodes() const
+  {
+    return m_inactiveNodes.size();
+  }
+
   /**
    *\brief Update Ndn stack on given nodes (Add faces for new devices)
    *
@@ -236,7 +341,38 @@ public:
   void
   disableStatusServer();
 
+  /**
+   * \brief Install only the data plane of NFD (lean mode)
+   *
+   * In lean mode the node gets the forwarder, its tables and faces, but no internal face,
+   * management (FIB, face, strategy choice managers, status server), RIB manager, or command
+   * validator.  FibHelper and StrategyChoiceHelper update the tables of such nodes directly,
+   * without signing and processing a management command per call.
+   *
+   * Applications using ndn-cxx API (ndn::Face) need the RIB manager to register prefixes,
+   * so only ndnSIM applications (ndn::App) should be installed on lean nodes.
+   */
+  void
+  SetLeanMode(bool isLean = true);
+
+  /**
+   * \brief Install the stacks of a NodeContainer, e.g., with InstallAll, from a prototype
+   *
+   * The first node is configured as usual and is the prototype of the other nodes of the
+   * container, whose stacks copy its Content Store limits and policy and its strategy choices
+   * instead of applying the tables section of the config again (see L3Protocol::setPrototype).
+   * Default routes (see SetDefaultRoutes) are inserted in the FIB directly instead of with a
+   * FIB management command per face.
+   *
+   * Independently of this mode, the strategies of a node are only instantiated when chosen.
+   */
+  void
+  SetPrototypeMode(bool isPrototype = true);
+
 private:
+  Ptr<FaceContainer>
+  installStack(Ptr<Node> node, Ptr<L3Protocol> prototype) const;
+
   shared_ptr<NetDeviceFace>
   DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> netDevice) const;
 
@@ -246,10 +382,21 @@ private:
   shared_ptr<NetDeviceFace>
   createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
+  void
+  ActivateIfMoved(Ptr<const MobilityModel> mobility) const;
+
+  void
+  ActivateIfRunsApplications(Ptr<Node> node) const;
+
+  void
+  Activate(Ptr<Node> node) const;
+
   bool m_isRibManagerDisabled;
   bool m_isFaceManagerDisabled;
   bool m_isStatusServerDisabled;
   bool m_isStrategyChoiceManagerDisabled;
+  bool m_isLean;
+  bool m_isPrototype;
 
 public:
   void
@@ -261,9 +408,23 @@ private:
 
   bool m_needSetDefaultRoutes;
   size_t m_maxCsSize;
+  size_t m_maxCsBytes;
+  std::string m_csPolicyName;
+  double m_dnlFalsePositiveRate;
+  bool m_isNeighborUnicast;
+  Time m_neighborTimeout;
+  bool m_isAggregation;
+  Time m_holdTime;
+  Time m_maxDefer;
+  DataRate m_shapingRate;
+  uint32_t m_maxShapedInterests;
+  bool m_isOverhearing;
+  Time m_overheardDataLifetime;
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
+
+  mutable std::map<uint32_t, Vector> m_inactiveNodes; ///< \brief initial position by node id
 };
 
 } // namespace ndn
@@ -23,6 +23,9 @@
 
 #include "ndn-stack-helper.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/strategy.hpp"
+
 namespace ns3 {
 namespace ndn {
 
@@ -31,6 +34,20 @@ NS_LOG_COMPONENT_DEFINE("ndn.StrategyChoiceHelper");
 void
 StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node> node)
 {
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
+  auto strategyChoiceManager = L3protocol->getStrategyChoiceManager();
+  if (strategyChoiceManager == nullptr) {
+    // lean mode: no management, update the strategy choice table directly
+    nfd::StrategyChoice& strategyChoice = L3protocol->getForwarder()->getStrategyChoice();
+    if (!strategyChoice.hasStrategy(parameters.getStrategy())) {
+      NS_FATAL_ERROR("Strategy " << parameters.getStrategy() << " is not installed on node "
+                     << node->GetId());
+    }
+    strategyChoice.insert(parameters.getName(), parameters.getStrategy());
+    NS_LOG_DEBUG("Forwarding strategy installed in node " << node->GetId());
+    return;
+  }
+
   NS_LOG_DEBUG("Strategy choice command was initialized");
   Block encodedParameters(parameters.wireEncode());
 
@@ -40,8 +57,6 @@ StrategyChoiceHelper::sendCommand(const ControlParameters& parameters, Ptr<Node>
 
   shared_ptr<Interest> command(make_shared<Interest>(commandName));
   StackHelper::getKeyChain().sign(*command);
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
-  auto strategyChoiceManager = L3protocol->getStrategyChoiceManager();
   strategyChoiceManager->onStrategyChoiceRequest(*command);
   NS_LOG_DEBUG("Forwarding strategy installed in node " << node->GetId());
 }
@@ -70,6 +85,29 @@ StrategyChoiceHelper::InstallAll(const Name& namePrefix, const Name& strategy)
   Install(NodeContainer::GetGlobal(), namePrefix, strategy);
 }
 
+void
+StrategyChoiceHelper::SetAggregationHold(Ptr<Node> node, const Name& namePrefix, const Time& hold)
+{
+  Ptr<L3Protocol> l3Protocol = node->GetObject<L3Protocol>();
+  NS_ASSERT(l3Protocol != nullptr);
+  NS_ASSERT(l3Protocol->getForwarder() != nullptr);
+
+  nfd::fw::Strategy& strategy =
+    l3Protocol->getForwarder()->getStrategyChoice().findEffectiveStrategy(namePrefix);
+  NS_LOG_DEBUG("Node ID: " << node->GetId() << " aggregation hold " << hold
+               << " for " << strategy.getName());
+  strategy.setAggregationHold(time::nanoseconds(hold.GetNanoSeconds()));
+}
+
+void
+StrategyChoiceHelper::SetAggregationHold(const NodeContainer& c, const Name& namePrefix,
+                                         const Time& hold)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    SetAggregationHold(*i, namePrefix, hold);
+  }
+}
+
 } // namespace ndn
 
 } // namespace ns
@@ -103,6 +103,23 @@ public:
   static void
   InstallAll(const Name& namePrefix);
 
+  /**
+   * @brief Set the aggregation hold of the strategy effective for @p namePrefix on @p node
+   *
+   * The first Interest of a PIT entry waits @p hold for Interests from other downstreams
+   * before it is forwarded.  The hold applies to every namespace that uses the same strategy
+   * on the node, so the strategy should be installed first.  Zero disables the hold.
+   */
+  static void
+  SetAggregationHold(Ptr<Node> node, const Name& namePrefix, const Time& hold);
+
+  /**
+   * @brief Set the aggregation hold of the strategy effective for @p namePrefix on nodes
+   *        in @p c container
+   */
+  static void
+  SetAggregationHold(const NodeContainer& c, const Name& namePrefix, const Time& hold);
+
 private:
   static void
   sendCommand(const ControlParameters& parameters, Ptr<Node> node);
@@ -0,0 +1,361 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-wireless-routing-helper.hpp"
+
+#include "ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-net-device-face.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.WirelessRoutingHelper");
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t WirelessRoutingHelper::NO_NODE = std::numeric_limits<uint32_t>::max();
+
+WirelessRoutingHelper::WirelessRoutingHelper(double range)
+  : m_range(range)
+  , m_grid(range > 0.0 ? range : 1.0)
+  , m_updateInterval(Seconds(1))
+  , m_isCalculated(false)
+  , m_nLinkChanges(0)
+  , m_nTreeComputations(0)
+  , m_nRouteChanges(0)
+{
+  if (!(range > 0.0)) {
+    throw std::invalid_argument("Range of WirelessRoutingHelper must be positive");
+  }
+}
+
+WirelessRoutingHelper::~WirelessRoutingHelper()
+{
+  Simulator::Cancel(m_updateEvent);
+  Simulator::Cancel(m_periodicEvent);
+  for (auto& i : m_routers) {
+    i.second.mobility->TraceDisconnectWithoutContext(
+      "CourseChange", MakeCallback(&WirelessRoutingHelper::OnCourseChange, this));
+  }
+}
+
+void
+WirelessRoutingHelper::Install(Ptr<Node> node)
+{
+  if (m_routers.count(node->GetId()) > 0)
+    return;
+
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+  if (mobility == 0) {
+    throw std::invalid_argument("Node " + std::to_string(node->GetId()) +
+                                " has no MobilityModel");
+  }
+
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  if (ndn == 0) {
+    throw std::invalid_argument("NDN stack is not installed on node " +
+                                std::to_string(node->GetId()));
+  }
+
+  shared_ptr<NetDeviceFace> face;
+  for (const auto& i : ndn->getForwarder()->getFaceTable()) {
+    shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(i);
+    if (netDeviceFace != nullptr &&
+        DynamicCast<PointToPointNetDevice>(netDeviceFace->GetNetDevice()) == 0) {
+      face = netDeviceFace;
+      break;
+    }
+  }
+  if (face == nullptr) {
+    throw std::invalid_argument("Node " + std::to_string(node->GetId()) +
+                                " has no wireless face");
+  }
+
+  Router& router = m_routers[node->GetId()];
+  router.node = node;
+  router.mobility = mobility;
+  router.face = face;
+  face->setOtherHostInterestFilter(true);
+
+  m_grid.Add(node);
+  mobility->TraceConnectWithoutContext("CourseChange",
+                                       MakeCallback(&WirelessRoutingHelper::OnCourseChange, this));
+
+  m_movedNodes.insert(node->GetId());
+  if (m_isCalculated)
+    ScheduleUpdate();
+}
+
+void
+WirelessRoutingHelper::Install(const NodeContainer& nodes)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Install(*node);
+  }
+}
+
+void
+WirelessRoutingHelper::InstallAll()
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+void
+WirelessRoutingHelper::AddOrigin(const Name& prefix, Ptr<Node> node)
+{
+  if (m_routers.count(node->GetId()) == 0) {
+    throw std::invalid_argument("WirelessRoutingHelper is not installed on node " +
+                                std::to_string(node->GetId()));
+  }
+
+  Tree& tree = m_trees[prefix];
+  tree.origins.insert(node->GetId());
+  if (m_isCalculated)
+    CalculateTree(prefix, tree);
+}
+
+void
+WirelessRoutingHelper::AddOrigins(const Name& prefix, const NodeContainer& nodes)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    AddOrigin(prefix, *node);
+  }
+}
+
+void
+WirelessRoutingHelper::CalculateRoutes()
+{
+  Simulator::Cancel(m_updateEvent);
+  Update();
+
+  m_isCalculated = true;
+  for (auto& tree : m_trees) {
+    CalculateTree(tree.first, tree.second);
+  }
+
+  Simulator::Cancel(m_periodicEvent);
+  if (m_updateInterval.IsStrictlyPositive()) {
+    m_periodicEvent = Simulator::Schedule(m_updateInterval,
+                                          &WirelessRoutingHelper::UpdatePeriodically, this);
+  }
+}
+
+void
+WirelessRoutingHelper::SetUpdateInterval(Time interval)
+{
+  m_updateInterval = interval;
+
+  if (m_isCalculated) {
+    Simulator::Cancel(m_periodicEvent);
+    if (m_updateInterval.IsStrictlyPositive()) {
+      m_periodicEvent = Simulator::Schedule(m_updateInterval,
+                                            &WirelessRoutingHelper::UpdatePeriodically, this);
+    }
+  }
+}
+
+void
+WirelessRoutingHelper::OnCourseChange(Ptr<const MobilityModel> mobility)
+{
+  Ptr<Node> node = mobility->GetObject<Node>();
+  if (node == 0)
+    return;
+
+  m_movedNodes.insert(node->GetId());
+  ScheduleUpdate();
+}
+
+void
+WirelessRoutingHelper::ScheduleUpdate()
+{
+  // course changes of many nodes at the same time are processed together, after the grid saw
+  // all of them
+  if (!m_updateEvent.IsRunning())
+    m_updateEvent = Simulator::ScheduleNow(&WirelessRoutingHelper::Update, this);
+}
+
+void
+WirelessRoutingHelper::UpdatePeriodically()
+{
+  for (const auto& router : m_routers) {
+    Vector velocity = router.second.mobility->GetVelocity();
+    if (velocity.x != 0.0 || velocity.y != 0.0 || velocity.z != 0.0)
+      m_movedNodes.insert(router.first);
+  }
+  Update();
+
+  m_periodicEvent = Simulator::Schedule(m_updateInterval,
+                                        &WirelessRoutingHelper::UpdatePeriodically, this);
+}
+
+void
+WirelessRoutingHelper::Update()
+{
+  std::vector<Link> added;
+  std::vector<Link> removed;
+  for (uint32_t nodeId : m_movedNodes) {
+    UpdateNeighbors(nodeId, added, removed);
+  }
+  m_movedNodes.clear();
+
+  if (!m_isCalculated || (added.empty() && removed.empty()))
+    return;
+
+  m_nLinkChanges += added.size() + removed.size();
+  NS_LOG_DEBUG(added.size() << " links added, " << removed.size() << " links removed");
+
+  for (auto& tree : m_trees) {
+    bool isAffected =
+      std::any_of(added.begin(), added.end(),
+                  [&tree] (const Link& link) { return IsAffected(tree.second, link, true); }) ||
+      std::any_of(removed.begin(), removed.end(),
+                  [&tree] (const Link& link) { return IsAffected(tree.second, link, false); });
+    if (isAffected)
+      CalculateTree(tree.first, tree.second);
+  }
+}
+
+void
+WirelessRoutingHelper::UpdateNeighbors(uint32_t nodeId, std::vector<Link>& added,
+                                       std::vector<Link>& removed)
+{
+  Router& router = m_routers[nodeId];
+
+  std::set<uint32_t> neighbors;
+  for (const Ptr<Node>& neighbor : m_grid.GetNeighbors(router.node, m_range)) {
+    neighbors.insert(neighbor->GetId());
+  }
+
+  for (uint32_t neighbor : neighbors) {
+    if (router.neighbors.count(neighbor) == 0) {
+      m_routers[neighbor].neighbors.insert(nodeId);
+      added.push_back({nodeId, neighbor});
+    }
+  }
+  for (uint32_t neighbor : router.neighbors) {
+    if (neighbors.count(neighbor) == 0) {
+      m_routers[neighbor].neighbors.erase(nodeId);
+      removed.push_back({nodeId, neighbor});
+    }
+  }
+  router.neighbors = std::move(neighbors);
+}
+
+bool
+WirelessRoutingHelper::IsAffected(const Tree& tree, const Link& link, bool isAdded)
+{
+  auto route1 = tree.routes.find(link.first);
+  auto route2 = tree.routes.find(link.second);
+
+  if (!isAdded) {
+    // only links of the tree carry shortest paths
+    return (route1 != tree.routes.end() && route1->second.nextHop == link.second) ||
+           (route2 != tree.routes.end() && route2->second.nextHop == link.first);
+  }
+
+  // the link gives a shorter path, or an equally short one through a lower node id
+  auto isBetter = [&tree] (std::map<uint32_t, Route>::const_iterator from, uint32_t fromId,
+                           std::map<uint32_t, Route>::const_iterator to) {
+    if (from == tree.routes.end())
+      return false;
+    if (to == tree.routes.end())
+      return true;
+    uint32_t distance = from->second.distance + 1;
+    return distance < to->second.distance ||
+           (distance == to->second.distance && fromId < to->second.nextHop);
+  };
+  return isBetter(route1, link.first, route2) || isBetter(route2, link.second, route1);
+}
+
+void
+WirelessRoutingHelper::CalculateTree(const Name& prefix, Tree& tree)
+{
+  ++m_nTreeComputations;
+
+  // breadth-first search from all origins at once, ties go to the lower node id
+  std::map<uint32_t, Route> routes;
+  std::deque<uint32_t> queue;
+  for (uint32_t origin : tree.origins) {
+    routes[origin] = Route{0, NO_NODE};
+    queue.push_back(origin);
+  }
+  while (!queue.empty()) {
+    uint32_t nodeId = queue.front();
+    queue.pop_front();
+    uint32_t distance = routes[nodeId].distance + 1;
+
+    for (uint32_t neighbor : m_routers[nodeId].neighbors) {
+      auto inserted = routes.insert({neighbor, Route{distance, nodeId}});
+      if (inserted.second) {
+        queue.push_back(neighbor);
+      }
+      else if (inserted.first->second.distance == distance &&
+               nodeId < inserted.first->second.nextHop) {
+        inserted.first->second.nextHop = nodeId;
+      }
+    }
+  }
+
+  for (const auto& oldRoute : tree.routes) {
+    auto route = routes.find(oldRoute.first);
+    if (oldRoute.second.nextHop != NO_NODE &&
+        (route == routes.end() || route->second.nextHop == NO_NODE)) {
+      Router& router = m_routers[oldRoute.first];
+      FibHelper::RemoveRoute(router.node, prefix, router.face);
+      router.face->removeNextHop(prefix);
+      ++m_nRouteChanges;
+    }
+  }
+
+  for (const auto& route : routes) {
+    if (route.second.nextHop == NO_NODE)
+      continue;
+
+    auto oldRoute = tree.routes.find(route.first);
+    bool isNew = oldRoute == tree.routes.end() || oldRoute->second.nextHop == NO_NODE;
+    if (!isNew && oldRoute->second.distance == route.second.distance &&
+        oldRoute->second.nextHop == route.second.nextHop)
+      continue;
+
+    Router& router = m_routers[route.first];
+    if (isNew || oldRoute->second.distance != route.second.distance) {
+      FibHelper::AddRoute(router.node, prefix, router.face, route.second.distance);
+    }
+    router.face->setNextHop(prefix,
+                            m_routers[route.second.nextHop].face->GetNetDevice()->GetAddress());
+    ++m_nRouteChanges;
+  }
+
+  NS_LOG_DEBUG(prefix << " reachable from " << routes.size() << " of " << m_routers.size()
+               << " nodes");
+  tree.routes = std::move(routes);
+}
+
+} // namespace ndn
+} // namespace ns3
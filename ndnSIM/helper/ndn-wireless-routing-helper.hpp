@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_WIRELESS_ROUTING_HELPER_H
+#define NDN_WIRELESS_ROUTING_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-spatial-grid.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-model.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceFace;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Oracle routing over the graph of nodes within radio range of each other
+ *
+ * The helper keeps a neighbor graph of the installed nodes, two nodes being neighbors if they
+ * are at most the range apart, and installs on every node routes along the shortest (fewest
+ * hops) path to the nearest origin of each prefix:
+ *  - a FIB entry via the wireless face, with the hop count as cost
+ *  - the link address of the next hop node on the face (NetDeviceFace::setNextHop), so that
+ *    Interests are unicast along the path, and other receivers drop them
+ *    (NetDeviceFace::setOtherHostInterestFilter)
+ *
+ * Nodes without a path to an origin get no route, so Interests are not flooded into partitions
+ * that cannot reach the producer.  This gives a baseline with ideal routing, to compare with
+ * flooding and with the geographic and suppression strategies.
+ *
+ * The graph is updated on course changes of the MobilityModels and, for moving nodes, every
+ * update interval, as neighbors also change between course changes.  Only prefixes whose
+ * shortest path trees are affected by the added and removed links are recomputed, and only
+ * changed routes are updated on the nodes.
+ *
+ * The helper must exist as long as the simulation runs.
+ */
+class WirelessRoutingHelper : noncopyable {
+public:
+  /**
+   * @param range radio range, in meters
+   * @throw std::invalid_argument the range is not positive
+   */
+  explicit
+  WirelessRoutingHelper(double range);
+
+  ~WirelessRoutingHelper();
+
+  /**
+   * @brief Add the node to the neighbor graph
+   *
+   * The wireless face of the node is its first NetDeviceFace that is not point-to-point.
+   *
+   * @throw std::invalid_argument the node has no MobilityModel, NDN stack or wireless face
+   */
+  void
+  Install(Ptr<Node> node);
+
+  void
+  Install(const NodeContainer& nodes);
+
+  void
+  InstallAll();
+
+  /**
+   * @brief Add \p node as an origin of \p prefix
+   *
+   * After CalculateRoutes, routes to the prefix are updated right away.
+   */
+  void
+  AddOrigin(const Name& prefix, Ptr<Node> node);
+
+  void
+  AddOrigins(const Name& prefix, const NodeContainer& nodes);
+
+  /**
+   * @brief Install routes to all origins, which then follow the movement of nodes
+   */
+  void
+  CalculateRoutes();
+
+  /**
+   * @brief Set how often neighbors of moving nodes are checked, zero to check them on course
+   *        changes only (default 1 second)
+   */
+  void
+  SetUpdateInterval(Time interval);
+
+  double
+  GetRange() const
+  {
+    return m_range;
+  }
+
+  /**
+   * @brief Number of links added to or removed from the neighbor graph after CalculateRoutes
+   */
+  uint64_t
+  GetNLinkChanges() const
+  {
+    return m_nLinkChanges;
+  }
+
+  /**
+   * @brief Number of shortest path tree computations of prefixes
+   */
+  uint64_t
+  GetNTreeComputations() const
+  {
+    return m_nTreeComputations;
+  }
+
+  /**
+   * @brief Number of routes installed, changed or removed on nodes
+   */
+  uint64_t
+  GetNRouteChanges() const
+  {
+    return m_nRouteChanges;
+  }
+
+private:
+  static const uint32_t NO_NODE;
+
+  struct Router {
+    Ptr<Node> node;
+    Ptr<MobilityModel> mobility;
+    shared_ptr<NetDeviceFace> face;
+    std::set<uint32_t> neighbors; ///< node ids
+  };
+
+  struct Route {
+    uint32_t distance; ///< hops to the nearest origin
+    uint32_t nextHop;  ///< node id, NO_NODE on origins
+  };
+
+  struct Tree {
+    std::set<uint32_t> origins;
+    std::map<uint32_t, Route> routes; ///< by node id, for nodes that reach an origin
+  };
+
+  typedef std::pair<uint32_t, uint32_t> Link;
+
+  void
+  OnCourseChange(Ptr<const MobilityModel> mobility);
+
+  void
+  ScheduleUpdate();
+
+  /**
+   * @brief Updates the neighbors of moved nodes and the trees affected by changed links
+   */
+  void
+  Update();
+
+  void
+  UpdatePeriodically();
+
+  void
+  UpdateNeighbors(uint32_t nodeId, std::vector<Link>& added, std::vector<Link>& removed);
+
+  /**
+   * @brief Whether the link changes the shortest path tree, given the tree before the change
+   */
+  static bool
+  IsAffected(const Tree& tree, const Link& link, bool isAdded);
+
+  /**
+   * @brief Recomputes the tree of \p prefix and applies the route changes to the nodes
+   */
+  void
+  CalculateTree(const Name& prefix, Tree& tree);
+
+private:
+  double m_range;
+  SpatialGrid m_grid;
+  Time m_updateInterval;
+
+  std::map<uint32_t, Router> m_routers; ///< by node id
+  std::map<Name, Tree> m_trees;         ///< by prefix
+  std::set<uint32_t> m_movedNodes;      ///< nodes whose neighbors need to be checked
+
+  bool m_isCalculated;
+  EventId m_updateEvent;
+  EventId m_periodicEvent;
+
+  uint64_t m_nLinkChanges;
+  uint64_t m_nTreeComputations;
+  uint64_t m_nRouteChanges;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_WIRELESS_ROUTING_HELPER_H
@@ -25,6 +25,10 @@
 #include "../../utils/trie/lfu-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
+#include "../../utils/trie/decayed-stats-policy.hpp"
+#include "../../utils/trie/byte-budget-policy.hpp"
+#include "../../utils/trie/greedy-dual-size-policy.hpp"
+#include "custom-policies/data-size-cost.hpp"
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -90,6 +94,39 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+typedef multi_policy_traits<boost::mpl::vector2<lru_policy_traits, decayed_stats_policy_traits>>
+  LruWithDecayedStatsTraits;
+typedef multi_policy_traits<boost::mpl::vector2<lfu_policy_traits, decayed_stats_policy_traits>>
+  LfuWithDecayedStatsTraits;
+
+template class ContentStoreImpl<LruWithDecayedStatsTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LruWithDecayedStatsTraits);
+
+template class ContentStoreImpl<LfuWithDecayedStatsTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithDecayedStatsTraits);
+
+// size-aware policies, MaxSize is the total size of the cached Data in octets
+typedef byte_budget_policy_traits<lru_policy_traits, data_wire_size> LruBytesTraits;
+typedef byte_budget_policy_traits<random_policy_traits, data_wire_size> RandomBytesTraits;
+typedef byte_budget_policy_traits<fifo_policy_traits, data_wire_size> FifoBytesTraits;
+typedef byte_budget_policy_traits<lfu_policy_traits, data_wire_size> LfuBytesTraits;
+typedef greedy_dual_size_policy_traits<data_wire_size, data_hop_cost> GreedyDualSizeTraits;
+
+template class ContentStoreImpl<LruBytesTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LruBytesTraits);
+
+template class ContentStoreImpl<RandomBytesTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RandomBytesTraits);
+
+template class ContentStoreImpl<FifoBytesTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoBytesTraits);
+
+template class ContentStoreImpl<LfuBytesTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuBytesTraits);
+
+template class ContentStoreImpl<GreedyDualSizeTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, GreedyDualSizeTraits);
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -114,6 +151,19 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy with a budget of octets
+ */
+class LruBytes : public ContentStoreImpl<LruBytesTraits> {
+};
+
+/**
+ * \brief Content Store implementing GreedyDual-Size cache replacement policy, weighing the hop
+ *        count of the Data against its size, with a budget of octets
+ */
+class GreedyDualSize : public ContentStoreImpl<GreedyDualSizeTraits> {
+};
 #endif
 
 } // namespace cs
@@ -32,6 +32,9 @@
 #include "ns3/string.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
+#include "../../utils/trie/trie-snapshot.hpp"
+
+#include <fstream>
 
 namespace ns3 {
 namespace ndn {
@@ -137,6 +140,22 @@ public:
     return super::getPolicy();
   }
 
+  /**
+   * @brief Write cached Data to the file, in the replacement order of the policy
+   *
+   * Only the encoded Data is kept: virtual payload and packet tags are not saved.
+   */
+  void
+  SaveSnapshot(const std::string& file) const;
+
+  /**
+   * @brief Add Data of a snapshot written by SaveSnapshot, e.g. to start with a warm cache
+   * @returns number of added entries
+   * @throws ndnSIM::snapshot_error the file is not a valid snapshot
+   */
+  size_t
+  LoadSnapshot(const std::string& file);
+
 public:
   typedef void (*CsEntryCallback)(Ptr<const Entry>);
 
@@ -172,7 +191,8 @@ ContentStoreImpl<Policy>::GetTypeId()
       .SetParent<ContentStore>()
       .AddConstructor<ContentStoreImpl<Policy>>()
       .AddAttribute("MaxSize",
-                    "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                    "Set maximum number of entries in ContentStore (total octets of the Data for "
+                    "size-aware policies). If 0, limit is not enforced",
                     StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
                                                              &ContentStoreImpl<Policy>::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
@@ -264,6 +284,40 @@ ContentStoreImpl<Policy>::Print(std::ostream& os) const
   }
 }
 
+template<class Policy>
+void
+ContentStoreImpl<Policy>::SaveSnapshot(const std::string& file) const
+{
+  std::ofstream os(file.c_str(), std::ios::binary | std::ios::trunc);
+  size_t nEntries =
+    ndnSIM::save_snapshot(os, this->getPolicy().begin(), this->getPolicy().end(),
+                          [](ndnSIM::snapshot_writer& writer,
+                             const typename super::parent_trie& node) {
+                            const Block& wire = node.payload()->GetData()->wireEncode();
+                            writer.write_block(wire.wire(), wire.size());
+                          });
+  NS_LOG_DEBUG("Saved " << nEntries << " entries to " << file);
+}
+
+template<class Policy>
+size_t
+ContentStoreImpl<Policy>::LoadSnapshot(const std::string& file)
+{
+  size_t nEntries =
+    ndnSIM::load_snapshot_file(static_cast<super&>(*this), file,
+                               [this](ndnSIM::snapshot_reader& reader) {
+                                 size_t size;
+                                 const uint8_t* wire = reader.read_block(size);
+                                 return Create<entry>(this, make_shared<Data>(Block(wire, size)));
+                               },
+                               [this](ndnSIM::snapshot_reader&, typename super::iterator item) {
+                                 item->payload()->SetTrie(item);
+                                 m_didAddEntry(item->payload());
+                               });
+  NS_LOG_DEBUG("Loaded " << nEntries << " entries from " << file);
+  return nEntries;
+}
+
 template<class Policy>
 void
 ContentStoreImpl<Policy>::SetMaxSize(uint32_t maxSize)
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef DATA_SIZE_COST_H_
+#define DATA_SIZE_COST_H_
+
+/// @cond include_hidden
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-ns3-packet-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-virtual-payload.hpp"
+
+#include <ns3/packet.h>
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Size of the Data of a ContentStore entry, in octets, for size-aware policies
+ *
+ * Virtual payload of the Data is included, as it is what the links carry.
+ */
+struct data_wire_size {
+  template<class Iterator>
+  size_t
+  operator()(Iterator item) const
+  {
+    const Data& data = *item->payload()->GetData();
+    return data.wireEncode().size() + getVirtualPayloadSize(data);
+  }
+};
+
+/**
+ * @brief Cost of fetching the Data of a ContentStore entry again, for GreedyDual-Size
+ *
+ * The cost is the number of hops the Data travelled before it was cached (FwHopCountTag),
+ * and at least 1.
+ */
+struct data_hop_cost {
+  template<class Iterator>
+  double
+  operator()(Iterator item) const
+  {
+    auto ns3PacketTag = item->payload()->GetData()->template getTag<Ns3PacketTag>();
+    if (ns3PacketTag == nullptr)
+      return 1;
+
+    FwHopCountTag hopCountTag;
+    if (!ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag))
+      return 1;
+    return std::max<double>(hopCountTag.Get(), 1);
+  }
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // DATA_SIZE_COST_H_
@@ -27,15 +27,19 @@
 
 #include "apps/ndn-app.hpp"
 
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE("ndn.AppFace");
 
 namespace ns3 {
 namespace ndn {
 
-AppFace::AppFace(Ptr<App> app)
+AppFace::AppFace(Ptr<App> app, DispatchMode dispatchMode)
   : LocalFace(FaceUri("appFace://"), FaceUri("appFace://"))
   , m_node(app->GetNode())
   , m_app(app)
+  , m_dispatchMode(dispatchMode)
+  , m_isDispatching(false)
 {
   NS_LOG_FUNCTION(this << app);
 
@@ -45,6 +49,7 @@ AppFace::AppFace(Ptr<App> app)
 AppFace::~AppFace()
 {
   NS_LOG_FUNCTION_NOARGS();
+  Simulator::Cancel(m_drainEvent);
 }
 
 void
@@ -53,6 +58,12 @@ AppFace::close()
   this->fail("Close connection");
 }
 
+void
+AppFace::setDispatchMode(DispatchMode dispatchMode)
+{
+  m_dispatchMode = dispatchMode;
+}
+
 void
 AppFace::sendInterest(const Interest& interest)
 {
@@ -60,8 +71,7 @@ AppFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  deliver(Delivery{interest.shared_from_this(), nullptr, nullptr});
 }
 
 void
@@ -71,8 +81,66 @@ AppFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  deliver(Delivery{nullptr, data.shared_from_this(), nullptr});
+}
+
+void
+AppFace::sendNack(const lp::Nack& nack)
+{
+  NS_LOG_FUNCTION(this << &nack);
+
+  this->emitSignal(onSendNack, nack);
+
+  deliver(Delivery{nullptr, nullptr, make_shared<lp::Nack>(nack)});
+}
+
+void
+AppFace::deliver(const Delivery& delivery)
+{
+  switch (m_dispatchMode) {
+  case DISPATCH_SCHEDULED:
+    // to decouple callbacks
+    if (delivery.interest != nullptr)
+      Simulator::ScheduleNow(&App::OnInterest, m_app, delivery.interest);
+    else if (delivery.data != nullptr)
+      Simulator::ScheduleNow(&App::OnData, m_app, delivery.data);
+    else
+      Simulator::ScheduleNow(&App::OnNack, m_app, delivery.nack);
+    break;
+  case DISPATCH_BATCHED:
+    m_queue.push_back(delivery);
+    if (!m_drainEvent.IsRunning())
+      m_drainEvent = Simulator::ScheduleNow(&AppFace::drain, this);
+    break;
+  case DISPATCH_INLINE:
+    m_queue.push_back(delivery);
+    if (!m_isDispatching)
+      drain();
+    break;
+  }
+}
+
+void
+AppFace::drain()
+{
+  NS_ASSERT(!m_isDispatching);
+
+  // inline, packets queued by the application's own callbacks are delivered by this loop too,
+  // batched, they wait for the next event
+  size_t count = m_dispatchMode == DISPATCH_BATCHED ? m_queue.size()
+                                                    : std::numeric_limits<size_t>::max();
+  m_isDispatching = true;
+  while (!m_queue.empty() && count-- > 0) {
+    Delivery delivery = std::move(m_queue.front());
+    m_queue.pop_front();
+    if (delivery.interest != nullptr)
+      m_app->OnInterest(delivery.interest);
+    else if (delivery.data != nullptr)
+      m_app->OnData(delivery.data);
+    else
+      m_app->OnNack(delivery.nack);
+  }
+  m_isDispatching = false;
 }
 
 void
@@ -87,5 +155,11 @@ AppFace::onReceiveData(const Data& data)
   this->emitSignal(onReceiveData, data);
 }
 
+void
+AppFace::onReceiveNack(const lp::Nack& nack)
+{
+  this->emitSignal(onReceiveNack, nack);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -24,6 +24,10 @@
 #include "ns3/ndnSIM/NFD/daemon/face/local-face.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include "ns3/event-id.h"
+
+#include <deque>
+
 namespace ns3 {
 
 class Packet;
@@ -45,10 +49,19 @@ class App;
  */
 class AppFace : public nfd::LocalFace {
 public:
+  /**
+   * \brief How Interests, Data and Nacks are delivered to the application
+   */
+  enum DispatchMode {
+    DISPATCH_SCHEDULED, ///< \brief one ScheduleNow event per packet
+    DISPATCH_BATCHED,   ///< \brief one ScheduleNow event delivers all packets queued until then
+    DISPATCH_INLINE     ///< \brief directly from the forwarder, without any event
+  };
+
   /**
    * \brief Default constructor
    */
-  AppFace(Ptr<App> app);
+  AppFace(Ptr<App> app, DispatchMode dispatchMode = DISPATCH_SCHEDULED);
 
   virtual ~AppFace();
 
@@ -65,6 +78,12 @@ public: // from nfd::Face
   virtual void
   sendData(const Data& data);
 
+  /**
+   * @brief Send Nack towards application
+   */
+  virtual void
+  sendNack(const lp::Nack& nack);
+
   /**
    * @brief Send Interest towards NFD
    */
@@ -77,12 +96,56 @@ public: // from nfd::Face
   void
   onReceiveData(const Data& data);
 
+  /**
+   * @brief Send Nack towards NFD
+   */
+  void
+  onReceiveNack(const lp::Nack& nack);
+
   virtual void
   close();
 
+  /**
+   * \brief Sets how Interests and Data are delivered to the application
+   *
+   * With DISPATCH_INLINE, packets that reach the face while the application is processing
+   * another one are queued and delivered right after it returns, so the application is never
+   * re-entered and the call depth stays bounded when it answers from within the callback (e.g.,
+   * a consumer sending the next Interest that hits the content store).
+   */
+  void
+  setDispatchMode(DispatchMode dispatchMode);
+
+  DispatchMode
+  getDispatchMode() const
+  {
+    return m_dispatchMode;
+  }
+
+private:
+  struct Delivery {
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+    shared_ptr<const lp::Nack> nack;
+  };
+
+  void
+  deliver(const Delivery& delivery);
+
+  /**
+   * \brief Delivers the queued packets to the application
+   */
+  void
+  drain();
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+
+  DispatchMode m_dispatchMode;
+  std::deque<Delivery> m_queue;
+  bool m_isDispatching;
+  EventId m_drainEvent;
 };
 
 } // namespace ndn
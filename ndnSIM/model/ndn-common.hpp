@@ -31,6 +31,7 @@
 #include <ndn-cxx/signature-info.hpp>
 #include <ndn-cxx/name.hpp>
 #include <ndn-cxx/data.hpp>
+#include <ndn-cxx/lp/nack.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 
 #include <ndn-cxx/util/time.hpp>
@@ -50,6 +51,8 @@ namespace time {
 using namespace ::ndn::time;
 }
 
+namespace lp = ::ndn::lp;
+
 using ::ndn::Exclude;
 
 using std::shared_ptr;
@@ -28,6 +28,7 @@ namespace ns3 {
 namespace ndn {
 
 uint32_t GlobalRouter::m_idCounter = 0;
+uint64_t GlobalRouter::s_generation = 0;
 
 NS_OBJECT_ENSURE_REGISTERED(GlobalRouter);
 
@@ -69,12 +70,14 @@ void
 GlobalRouter::AddLocalPrefix(shared_ptr<Name> prefix)
 {
   m_localPrefixes.push_back(prefix);
+  ++s_generation;
 }
 
 void
 GlobalRouter::AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> gr)
 {
   m_incidencies.push_back(std::make_tuple(this, face, gr));
+  ++s_generation;
 }
 
 GlobalRouter::IncidencyList&
@@ -93,6 +96,7 @@ void
 GlobalRouter::clear()
 {
   m_idCounter = 0;
+  ++s_generation;
 }
 
 } // namespace ndn
@@ -26,8 +26,8 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
-#include <list>
 #include <tuple>
+#include <vector>
 
 namespace ns3 {
 
@@ -48,13 +48,13 @@ public:
    */
   typedef std::tuple<Ptr<GlobalRouter>, shared_ptr<Face>, Ptr<GlobalRouter>> Incidency;
   /**
-   * @brief List of graph edges
+   * @brief List of graph edges, contiguous to be cheap to iterate
    */
-  typedef std::list<Incidency> IncidencyList;
+  typedef std::vector<Incidency> IncidencyList;
   /**
    * @brief List of locally exported prefixes
    */
-  typedef std::list<shared_ptr<Name>> LocalPrefixList;
+  typedef std::vector<shared_ptr<Name>> LocalPrefixList;
 
   /**
    * \brief Interface ID
@@ -114,6 +114,18 @@ public:
   static void
   clear();
 
+  /**
+   * @brief Counter incremented whenever an edge or prefix is added to any GlobalRouter
+   *
+   * Snapshots of the graph (e.g., the one of GlobalRoutingHelper) compare it to find out
+   * whether they need to be rebuilt.
+   */
+  static uint64_t
+  GetGeneration()
+  {
+    return s_generation;
+  }
+
 protected:
   virtual void
   NotifyNewAggregate(); ///< @brief Notify when the object is aggregated to another object (e.g.,
@@ -127,6 +139,7 @@ private:
   IncidencyList m_incidencies;
 
   static uint32_t m_idCounter;
+  static uint64_t s_generation;
 };
 
 inline bool
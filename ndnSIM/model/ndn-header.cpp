@@ -19,11 +19,11 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include "../utils/ndn-allocation-profiler.hpp"
+#include "../utils/ndn-data-wire-table.hpp"
+#include "../utils/ndn-profiler-zones.hpp"
 
-namespace io = boost::iostreams;
+#include <ndn-cxx/lp/packet.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -55,6 +55,19 @@ PacketHeader<Data>::GetTypeId()
   return tid;
 }
 
+template<>
+ns3::TypeId
+PacketHeader<lp::Nack>::GetTypeId()
+{
+  static ns3::TypeId tid =
+    ns3::TypeId("ns3::ndn::Nack")
+    .SetGroupName("Ndn")
+    .SetParent<Header>()
+    .AddConstructor<PacketHeader<lp::Nack>>()
+    ;
+  return tid;
+}
+
 template<class Pkt>
 TypeId
 PacketHeader<Pkt>::GetInstanceTypeId(void) const
@@ -67,61 +80,150 @@ PacketHeader<Pkt>::PacketHeader()
 {
 }
 
+template<class Pkt>
+std::atomic<uint64_t> PacketHeader<Pkt>::s_nEncodings{0};
+
 template<class Pkt>
 PacketHeader<Pkt>::PacketHeader(const Pkt& packet)
   : m_packet(packet.shared_from_this())
 {
+  if (!packet.hasWire())
+    ++s_nEncodings;
+  m_wire = packet.wireEncode();
+}
+
+/**
+ * A Nack is an NDNLPv2 LpPacket carrying the NackHeader and the Interest as its fragment.
+ */
+template<>
+PacketHeader<lp::Nack>::PacketHeader(const lp::Nack& nack)
+  : m_packet(make_shared<lp::Nack>(nack))
+{
+  ++s_nEncodings;
+  lp::Packet lpPacket(nack.getInterest().wireEncode());
+  lpPacket.add<lp::NackField>(nack.getHeader());
+  m_wire = lpPacket.wireEncode();
+}
+
+template<class Pkt>
+uint64_t
+PacketHeader<Pkt>::GetNEncodings()
+{
+  return s_nEncodings.load();
 }
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::GetSerializedSize(void) const
 {
-  return m_packet->wireEncode().size();
+  return m_wire.size();
 }
 
 template<class Pkt>
 void
 PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
 {
-  start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
+  start.Write(m_wire.wire(), m_wire.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
-  }
+/**
+ * @brief Reads TLV-TYPE or TLV-LENGTH, appending its encoding to the buffer
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& start, ::ndn::Buffer& encoding)
+{
+  if (start.GetRemainingSize() < 1)
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Truncated TLV header"));
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t first = start.ReadU8();
+  encoding.push_back(first);
+
+  size_t size = first < 253 ? 0 : (first == 253 ? 2 : (first == 254 ? 4 : 8));
+  if (start.GetRemainingSize() < size)
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Truncated TLV header"));
+
+  uint64_t value = first < 253 ? first : 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint8_t octet = start.ReadU8();
+    encoding.push_back(octet);
+    value = (value << 8) | octet;
   }
+  return value;
+}
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+/**
+ * @brief Reads the TLV element at the start into a buffer of its own
+ */
+static Block
+readBlock(ns3::Buffer::Iterator start)
+{
+  // TLV header first, to copy the whole packet into its final buffer at once
+  auto buffer = ::ndn::makeBuffer();
+  buffer->reserve(2 * 9);
+  readVarNumber(start, *buffer); // type
+  uint64_t length = readVarNumber(start, *buffer);
+
+  if (length > start.GetRemainingSize())
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("TLV length exceeds the packet size"));
+
+  size_t headerSize = buffer->size();
+  buffer->resize(headerSize + length);
+  start.Read(&(*buffer)[headerSize], length);
+
+  // the Block and all its elements point into the buffer, no more copies
+  return Block(buffer);
+}
+
+/**
+ * @brief Gets the wire to decode the packet from, shared across nodes for Data
+ */
+template<class Pkt>
+static Block
+shareWire(const Block& wire)
+{
+  return wire;
+}
+
+template<>
+Block
+shareWire<Data>(const Block& wire)
+{
+  return DataWireTable::IsEnabled() ? DataWireTable::Intern(wire) : wire;
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  NDN_PROFILE_ZONE("PacketHeader::Deserialize");
+  NDN_ALLOCATION_SCOPE(GLUE);
+  Block wire = shareWire<Pkt>(readBlock(start));
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(wire);
   m_packet = packet;
-  return packet->wireEncode().size();
+  m_wire = wire;
+  return wire.size();
+}
+
+template<>
+uint32_t
+PacketHeader<lp::Nack>::Deserialize(ns3::Buffer::Iterator start)
+{
+  NDN_PROFILE_ZONE("PacketHeader::Deserialize");
+  NDN_ALLOCATION_SCOPE(GLUE);
+  Block wire = readBlock(start);
+  lp::Packet lpPacket(wire);
+  if (!lpPacket.has<lp::NackField>() || !lpPacket.has<lp::FragmentField>())
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("LpPacket is not a Nack"));
+
+  ::ndn::Buffer::const_iterator fragmentBegin, fragmentEnd;
+  std::tie(fragmentBegin, fragmentEnd) = lpPacket.get<lp::FragmentField>();
+  auto nack = make_shared<lp::Nack>(Interest(Block(&*fragmentBegin,
+                                                   std::distance(fragmentBegin, fragmentEnd))));
+  nack->setHeader(lpPacket.get<lp::NackField>());
+  m_packet = nack;
+  m_wire = wire;
+  return wire.size();
 }
 
 template<>
@@ -138,6 +240,13 @@ PacketHeader<Data>::Print(std::ostream& os) const
   os << "D: " << *m_packet;
 }
 
+template<>
+void
+PacketHeader<lp::Nack>::Print(std::ostream& os) const
+{
+  os << "N: " << m_packet->getInterest() << "~" << m_packet->getReason();
+}
+
 template<class Pkt>
 shared_ptr<const Pkt>
 PacketHeader<Pkt>::getPacket()
@@ -147,12 +256,15 @@ PacketHeader<Pkt>::getPacket()
 
 typedef PacketHeader<Interest> InterestHeader;
 typedef PacketHeader<Data> DataHeader;
+typedef PacketHeader<lp::Nack> NackHeader;
 
 NS_OBJECT_ENSURE_REGISTERED(InterestHeader);
 NS_OBJECT_ENSURE_REGISTERED(DataHeader);
+NS_OBJECT_ENSURE_REGISTERED(NackHeader);
 
 template class PacketHeader<Interest>;
 template class PacketHeader<Data>;
+template class PacketHeader<lp::Nack>;
 
 } // namespace ndn
 } // namespace ns3
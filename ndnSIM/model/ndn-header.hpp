@@ -24,6 +24,8 @@
 
 #include "ndn-common.hpp"
 
+#include <atomic>
+
 namespace ns3 {
 namespace ndn {
 
@@ -55,8 +57,20 @@ public:
   shared_ptr<const Pkt>
   getPacket();
 
+  /**
+   * @brief Number of packets that had to be encoded when a header was made for them
+   *
+   * Size and serialization of a header use the encoding captured when the header is made, so
+   * a packet is encoded at most once per header, i.e. per transmission.
+   */
+  static uint64_t
+  GetNEncodings();
+
 private:
   shared_ptr<const Pkt> m_packet;
+  Block m_wire;
+
+  static std::atomic<uint64_t> s_nEncodings;
 };
 
 } // namespace ndn
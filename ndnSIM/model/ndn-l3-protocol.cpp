@@ -55,6 +55,12 @@ NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
 namespace ns3 {
 namespace ndn {
 
+#ifdef NFD_WITH_STAGE_TIMING
+// stage times of the forwarders disposed so far, printed when the last one is disposed
+static nfd::ForwarderStageTimes g_stageTimes;
+static size_t g_nTimedForwarders = 0;
+#endif // NFD_WITH_STAGE_TIMING
+
 const uint16_t L3Protocol::ETHERNET_FRAME_TYPE = 0x7777;
 const uint16_t L3Protocol::IP_STACK_PORT = 9695;
 
@@ -91,6 +97,14 @@ L3Protocol::GetTypeId(void)
       .AddTraceSource("TimedOutInterests", "TimedOutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_timedOutInterests),
                       "ns3::ndn::L3Protocol::TimedOutInterestsCallback")
+      .AddTraceSource("AggregatedInterests",
+                      "Interests from new downstreams aggregated into pending PIT entries",
+                      MakeTraceSourceAccessor(&L3Protocol::m_aggregatedInterests),
+                      "ns3::ndn::L3Protocol::AggregatedInterestsCallback")
+
+      .AddTraceSource("CsBytes", "Total size in bytes of Data held by NFD's Content Store",
+                      MakeTraceSourceAccessor(&L3Protocol::m_csBytes),
+                      "ns3::ndn::L3Protocol::CsBytesCallback")
     ;
   return tid;
 }
@@ -98,6 +112,22 @@ L3Protocol::GetTypeId(void)
 class L3Protocol::Impl {
 private:
   Impl()
+    : m_config(getInitialConfig())
+  {
+  }
+
+  /**
+   * \brief Get the initial config, parsed once for all nodes
+   */
+  static const nfd::ConfigSection&
+  getInitialConfig()
+  {
+    static const nfd::ConfigSection config = parseInitialConfig();
+    return config;
+  }
+
+  static nfd::ConfigSection
+  parseInitialConfig()
   {
     // Do not modify initial config file. Use helpers to set specific NFD parameters
     std::string initialConfig =
@@ -149,7 +179,9 @@ private:
       "\n";
 
     std::istringstream input(initialConfig);
-    boost::property_tree::read_info(input, m_config);
+    nfd::ConfigSection config;
+    boost::property_tree::read_info(input, config);
+    return config;
   }
 
   friend class L3Protocol;
@@ -167,6 +199,7 @@ private:
   nfd::ConfigSection m_config;
 
   Ptr<ContentStore> m_csFromNdnSim;
+  Ptr<L3Protocol> m_prototype;
 };
 
 L3Protocol::L3Protocol()
@@ -183,22 +216,37 @@ L3Protocol::~L3Protocol()
 void
 L3Protocol::initialize()
 {
-  m_impl->m_forwarder = make_shared<nfd::Forwarder>();
-
-  initializeManagement();
+  m_impl->m_forwarder = make_shared<nfd::Forwarder>(
+    this->getConfig().get<double>("ndnSIM.dead_nonce_list_fp_rate", 0.0));
+#ifdef NFD_WITH_STAGE_TIMING
+  ++g_nTimedForwarders;
+#endif // NFD_WITH_STAGE_TIMING
+
+  if (this->getConfig().get<bool>("ndnSIM.lean", false)) {
+    // data plane only: no internal face, managers, RIB or command validation
+    initializeTables();
+  }
+  else {
+    initializeManagement();
 
-  if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
-    Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
+    if (!this->getConfig().get<bool>("ndnSIM.disable_rib_manager", false)) {
+      Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
+    }
   }
 
   m_impl->m_forwarder->getFaceTable().addReserved(make_shared<nfd::NullFace>(), nfd::FACEID_NULL);
 
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
+  m_impl->m_forwarder->afterAggregateInterest.connect(std::ref(m_aggregatedInterests));
+  m_impl->m_forwarder->getCs().afterNBytesChange.connect(std::ref(m_csBytes));
 
   //--------------------------------------------------------------------------------
   //give forwarder node's id
   m_impl->m_forwarder->SetNodeId(m_node->GetId());
+
+  // the tables are configured
+  m_impl->m_prototype = nullptr;
 }
 
 class IgnoreSections
@@ -260,31 +308,93 @@ L3Protocol::initializeManagement()
                                                        keyChain);
   }
 
-  ConfigFile config((IgnoreSections({"general", "log", "rib", "ndnSIM"})));
+  std::vector<std::string> ignoredSections = {"general", "log", "rib", "ndnSIM"};
+  if (m_impl->m_prototype != nullptr) {
+    ignoredSections.push_back("tables");
+  }
+  ConfigFile config((IgnoreSections(ignoredSections)));
 
   TablesConfigSection tablesConfig(forwarder->getCs(),
                                    forwarder->getPit(),
                                    forwarder->getFib(),
                                    forwarder->getStrategyChoice(),
                                    forwarder->getMeasurements());
-  tablesConfig.setConfigFile(config);
+  if (m_impl->m_prototype == nullptr) {
+    tablesConfig.setConfigFile(config);
+  }
 
   m_impl->m_internalFace->getValidator().setConfigFile(config);
 
   forwarder->getFaceTable().addReserved(m_impl->m_internalFace, FACEID_INTERNAL_FACE);
 
-  m_impl->m_faceManager->setConfigFile(config);
+  if (m_impl->m_faceManager != nullptr) {
+    m_impl->m_faceManager->setConfigFile(config);
+  }
 
   // apply config
   config.parse(m_impl->m_config, false, "ndnSIM.conf");
 
-  tablesConfig.ensureTablesAreConfigured();
+  if (m_impl->m_prototype == nullptr) {
+    tablesConfig.ensureTablesAreConfigured();
+  }
+  else {
+    cloneTables();
+  }
 
   // add FIB entry for NFD Management Protocol
   shared_ptr<fib::Entry> entry = forwarder->getFib().insert("/localhost/nfd").first;
   entry->addNextHop(m_impl->m_internalFace, 0);
 }
 
+void
+L3Protocol::initializeTables()
+{
+  if (m_impl->m_prototype != nullptr) {
+    cloneTables();
+    return;
+  }
+
+  auto& forwarder = m_impl->m_forwarder;
+  using namespace nfd;
+
+  ConfigFile config((IgnoreSections({"general", "log", "rib", "ndnSIM", "face_system",
+                                     "authorizations"})));
+
+  TablesConfigSection tablesConfig(forwarder->getCs(),
+                                   forwarder->getPit(),
+                                   forwarder->getFib(),
+                                   forwarder->getStrategyChoice(),
+                                   forwarder->getMeasurements());
+  tablesConfig.setConfigFile(config);
+
+  config.parse(m_impl->m_config, false, "ndnSIM.conf");
+
+  tablesConfig.ensureTablesAreConfigured();
+}
+
+void
+L3Protocol::cloneTables()
+{
+  using namespace nfd;
+  Forwarder& forwarder = *m_impl->m_forwarder;
+  Forwarder& prototype = *m_impl->m_prototype->getForwarder();
+
+  Cs& cs = forwarder.getCs();
+  const Cs& prototypeCs = prototype.getCs();
+  const std::string& policyName = prototypeCs.getPolicy()->getName();
+  if (policyName != cs.getPolicy()->getName()) {
+    cs.setPolicy(cs::makePolicy(policyName));
+  }
+  cs.setLimit(prototypeCs.getLimit());
+  cs.setLimitBytes(prototypeCs.getLimitBytes());
+
+  // strategies are instantiated when first chosen
+  StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+  for (const strategy_choice::Entry& entry : prototype.getStrategyChoice()) {
+    strategyChoice.insert(entry.getPrefix(), entry.getStrategyName());
+  }
+}
+
 void
 L3Protocol::initializeRibManager()
 {
@@ -341,6 +451,13 @@ L3Protocol::getConfig()
   return m_impl->m_config;
 }
 
+void
+L3Protocol::setPrototype(Ptr<L3Protocol> prototype)
+{
+  NS_ASSERT_MSG(m_node == nullptr, "The stack is already aggregated to a node");
+  m_impl->m_prototype = prototype;
+}
+
 /*
  * This method is called by AddAgregate and completes the aggregation
  * by setting the node in the ndn stack
@@ -369,6 +486,17 @@ L3Protocol::DoDispose(void)
 {
   NS_LOG_FUNCTION(this);
 
+#ifdef NFD_WITH_STAGE_TIMING
+  if (m_impl->m_forwarder != nullptr) {
+    g_stageTimes.merge(m_impl->m_forwarder->getStageTimes());
+    if (--g_nTimedForwarders == 0) {
+      std::clog << "Forwarding pipeline stage times of all nodes:\n";
+      g_stageTimes.print(std::clog);
+      g_stageTimes.reset();
+    }
+  }
+#endif // NFD_WITH_STAGE_TIMING
+
   m_node = 0;
 
   Object::DoDispose();
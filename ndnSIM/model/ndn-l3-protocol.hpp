@@ -101,12 +101,16 @@ public:
 
   /**
    * \brief Get smart pointer to nfd::FibManager, used by node's NFD
+   *
+   * nullptr in lean mode (see StackHelper::SetLeanMode)
    */
   shared_ptr<nfd::FibManager>
   getFibManager();
 
   /**
    * \brief Get smart pointer to nfd::StrategyChoiceManager, used by node's NFD
+   *
+   * nullptr in lean mode, or if the manager is disabled
    */
   shared_ptr<nfd::StrategyChoiceManager>
   getStrategyChoiceManager();
@@ -148,6 +152,16 @@ public:
   nfd::ConfigSection&
   getConfig();
 
+  /**
+   * \brief Configure the tables like the stack of another node, instead of applying the
+   *        tables section of the config
+   *
+   * The Content Store limits and policy and the strategy choices of \p prototype are copied.
+   * Must be called before the stack is aggregated to its node (see StackHelper::SetPrototypeMode)
+   */
+  void
+  setPrototype(Ptr<L3Protocol> prototype);
+
 public: // Workaround for python bindings
   static Ptr<L3Protocol>
   getL3Protocol(Ptr<Object> node);
@@ -158,6 +172,10 @@ public:
 
   typedef void (*SatisfiedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace, const Data& data);
   typedef void (*TimedOutInterestsCallback)(const nfd::pit::Entry& pitEntry);
+  typedef void (*AggregatedInterestsCallback)(const nfd::pit::Entry& pitEntry, const Face& inFace,
+                                              const Interest& interest);
+
+  typedef void (*CsBytesCallback)(size_t nBytes);
 
 protected:
   virtual void
@@ -179,9 +197,21 @@ private:
   void
   initializeManagement();
 
+  /**
+   * \brief Apply the tables section of the config without the management plane (lean mode)
+   */
+  void
+  initializeTables();
+
   void
   initializeRibManager();
 
+  /**
+   * \brief Copy the configuration of the tables of the prototype
+   */
+  void
+  cloneTables();
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -199,6 +229,10 @@ private:
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
+  TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Interest&>
+    m_aggregatedInterests; ///< @brief trace of Interests aggregated into pending PIT entries
+
+  TracedCallback<size_t> m_csBytes; ///< @brief trace of the size of Data held by NFD's Content Store
 };
 
 } // namespace ndn
@@ -26,13 +26,26 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/mobility-model.h"
 
 // #include "ns3/address.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
 
+#include "../utils/ndn-allocation-profiler.hpp"
 #include "../utils/ndn-fw-hop-count-tag.hpp"
+#include "../utils/ndn-geo-position-tag.hpp"
+#include "../utils/ndn-profiler-zones.hpp"
+#include "../utils/ndn-pushed-data-tag.hpp"
+#include "../utils/ndn-rtt-hint-table.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-slicer.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-partial-message-store.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceFace");
 
@@ -43,6 +56,39 @@ NetDeviceFace::NetDeviceFace(Ptr<Node> node, const Ptr<NetDevice>& netDevice)
   : Face(FaceUri("netDeviceFace://"), FaceUri("netDeviceFace://"))
   , m_node(node)
   , m_netDevice(netDevice)
+  , m_reassemblyTimeout(MilliSeconds(100))
+  , m_nFragmentedPackets(0)
+  , m_nReassembledPackets(0)
+  , m_maxDefer(Seconds(0))
+  , m_nDeferCancelled(0)
+  , m_isAggregation(false)
+  , m_holdTime(MilliSeconds(1))
+  , m_nAggregatedFrames(0)
+  , m_nAggregatedPackets(0)
+  , m_maxTransmitQueue(0)
+  , m_nTransmitQueueDrops(0)
+  , m_isTransmitScheduling(false)
+  , m_flowPrefixLength(2)
+  , m_maxShapedInterests(64)
+  , m_shapingBurst(4)
+  , m_shapingTokens(0)
+  , m_averageDataSize(0)
+  , m_nShapedInterests(0)
+  , m_nShapingNacks(0)
+  , m_nShapingExpired(0)
+  , m_isNeighborUnicast(false)
+  , m_neighborTimeout(Seconds(2))
+  , m_nUnicastSent(0)
+  , m_isOtherHostInterestFilter(false)
+  , m_nFilteredInterests(0)
+  , m_isOverhearing(false)
+  , m_nOverheardData(0)
+  , m_nPushedData(0)
+  , m_isLinkDown(false)
+  , m_nLinkDownDrops(0)
+  , m_nDroppedNonNdn(0)
+  , m_nDroppedUnsolicitedData(0)
+  , m_nDroppedMalformed(0)
 {
   NS_LOG_FUNCTION(this << netDevice);
 
@@ -64,6 +110,34 @@ NetDeviceFace::~NetDeviceFace()
 void
 NetDeviceFace::close()
 {
+  for (auto& pending : m_pendingFrames) {
+    Simulator::Cancel(pending.second.flushEvent);
+  }
+  m_pendingFrames.clear();
+
+  for (auto& reassembler : m_reassemblers) {
+    Simulator::Cancel(reassembler.second.expireEvent);
+  }
+  m_reassemblers.clear();
+
+  for (auto& deferred : m_deferred) {
+    for (DeferredPacket& packet : deferred.second) {
+      Simulator::Cancel(packet.sendEvent);
+    }
+  }
+  m_deferred.clear();
+
+  Simulator::Cancel(m_transmitEvent);
+  m_transmitQueue.reset();
+  m_maxTransmitQueue = 0;
+  m_scheduledInterests.clear();
+
+  Simulator::Cancel(m_shapingEvent);
+  Simulator::Cancel(m_shapingNackEvent);
+  m_shapedInterests.clear();
+  m_refusedInterests.clear();
+  m_shapingRate = DataRate();
+
   m_node->UnregisterProtocolHandler(MakeCallback(&NetDeviceFace::receiveFromNetDevice, this));
   this->fail("Close connection");
 }
@@ -74,19 +148,583 @@ NetDeviceFace::GetNetDevice() const
   return m_netDevice;
 }
 
+size_t
+NetDeviceFace::getTransmitQueueLength() const
+{
+  return m_transmitQueue == nullptr ? 0 : m_transmitQueue->size();
+}
+
+void
+NetDeviceFace::setNeighborUnicast(bool enable, Time neighborTimeout)
+{
+  m_isNeighborUnicast = enable;
+  m_neighborTimeout = neighborTimeout;
+  if (!enable) {
+    m_upstreams.clear();
+    m_requesters.clear();
+    m_sentInterests.clear();
+  }
+}
+
+void
+NetDeviceFace::setReassemblyTimeout(Time timeout)
+{
+  m_reassemblyTimeout = timeout;
+
+  // stores are made anew with the new timeout
+  for (auto& reassembler : m_reassemblers) {
+    Simulator::Cancel(reassembler.second.expireEvent);
+  }
+  m_reassemblers.clear();
+}
+
+void
+NetDeviceFace::setBroadcastDefer(Time maxDefer)
+{
+  m_maxDefer = maxDefer;
+  if (m_maxDefer.IsStrictlyPositive() && m_deferRandom == 0) {
+    // made only when needed, not to shift random streams of simulations without deferring
+    m_deferRandom = CreateObject<UniformRandomVariable>();
+  }
+}
+
+void
+NetDeviceFace::sendOrDefer(Ptr<Packet> packet, const Address& to, const Name& name,
+                           bool isInterest, uint32_t nonce)
+{
+  if (!m_maxDefer.IsStrictlyPositive() || to != m_netDevice->GetBroadcast()) {
+    send(packet, to);
+    return;
+  }
+
+  std::vector<DeferredPacket>& deferred = m_deferred[name];
+  for (const DeferredPacket& other : deferred) {
+    if (other.isInterest == isInterest && (!isInterest || other.nonce == nonce))
+      return; // the same packet is already waiting
+  }
+
+  Time delay = Seconds(m_deferRandom->GetValue(0, m_maxDefer.GetSeconds()));
+  deferred.push_back(DeferredPacket{packet, to, isInterest, nonce,
+                                    Simulator::Schedule(delay, &NetDeviceFace::sendDeferred, this,
+                                                        name, isInterest, nonce)});
+}
+
+void
+NetDeviceFace::sendDeferred(Name name, bool isInterest, uint32_t nonce)
+{
+  auto entry = m_deferred.find(name);
+  if (entry == m_deferred.end())
+    return;
+
+  std::vector<DeferredPacket>& deferred = entry->second;
+  for (auto i = deferred.begin(); i != deferred.end(); ++i) {
+    if (i->isInterest == isInterest && i->nonce == nonce) {
+      Ptr<Packet> packet = i->packet;
+      Address to = i->to;
+      deferred.erase(i);
+      if (deferred.empty())
+        m_deferred.erase(entry);
+      send(packet, to);
+      return;
+    }
+  }
+}
+
+void
+NetDeviceFace::cancelDeferred(const Name& name, bool isInterest, uint32_t nonce)
+{
+  auto entry = m_deferred.find(name);
+  if (entry == m_deferred.end())
+    return;
+
+  // overheard Data make both the same Data and the Interests for them unnecessary
+  std::vector<DeferredPacket>& deferred = entry->second;
+  for (auto i = deferred.begin(); i != deferred.end();) {
+    if (!isInterest || (i->isInterest && i->nonce == nonce)) {
+      Simulator::Cancel(i->sendEvent);
+      ++m_nDeferCancelled;
+      NS_LOG_LOGIC("Deferred " << (i->isInterest ? "Interest " : "Data ") << name
+                   << " cancelled, overheard from a neighbor");
+      i = deferred.erase(i);
+    }
+    else {
+      ++i;
+    }
+  }
+  if (deferred.empty())
+    m_deferred.erase(entry);
+}
+
+void
+NetDeviceFace::setAggregation(bool enable, Time holdTime)
+{
+  m_isAggregation = enable;
+  m_holdTime = holdTime;
+  if (!enable) {
+    for (auto& pending : m_pendingFrames) {
+      Simulator::Cancel(pending.second.flushEvent);
+    }
+    std::vector<Address> destinations;
+    for (const auto& pending : m_pendingFrames) {
+      destinations.push_back(pending.first);
+    }
+    for (const Address& to : destinations) {
+      flush(to);
+    }
+  }
+}
+
+void
+NetDeviceFace::setTransmitQueue(uint32_t maxPackets, DataRate rate)
+{
+  NS_ASSERT_MSG(maxPackets == 0 || rate.GetBitRate() > 0, "Transmit queue needs a positive rate");
+
+  // packets already queued are kept, but handed to the device at once if there is no queue
+  std::unique_ptr<nfd::TransmitScheduler<QueuedFrame>> queue;
+  if (maxPackets > 0) {
+    queue.reset(new nfd::TransmitScheduler<QueuedFrame>(maxPackets, m_netDevice->GetMtu()));
+    for (const auto& weight : m_flowWeights) {
+      queue->setWeight(std::hash<Name>()(weight.first), weight.second);
+    }
+  }
+  queue.swap(m_transmitQueue);
+  m_maxTransmitQueue = maxPackets;
+  m_transmitRate = rate;
+
+  if (queue != nullptr) {
+    QueuedFrame frame;
+    while (queue->dequeue(frame)) {
+      sendFrame(frame.packet, frame.to);
+    }
+  }
+  transmitQueueChanged();
+}
+
+void
+NetDeviceFace::setTransmitScheduling(bool enable, size_t flowPrefixLength)
+{
+  m_isTransmitScheduling = enable;
+  m_flowPrefixLength = flowPrefixLength;
+  if (!enable)
+    m_scheduledInterests.clear();
+}
+
+void
+NetDeviceFace::setTransmitClass(const Name& prefix, nfd::TransmitClass transmitClass)
+{
+  m_transmitClasses[prefix] = transmitClass;
+}
+
+void
+NetDeviceFace::removeTransmitClass(const Name& prefix)
+{
+  m_transmitClasses.erase(prefix);
+}
+
 void
-NetDeviceFace::send(Ptr<Packet> packet)
+NetDeviceFace::setFlowWeight(const Name& prefix, size_t weight)
 {
-  NS_ASSERT_MSG(packet->GetSize() <= m_netDevice->GetMtu(),
-                "Packet size " << packet->GetSize() << " exceeds device MTU "
-                               << m_netDevice->GetMtu());
+  m_flowWeights[prefix] = weight;
+  if (m_transmitQueue != nullptr)
+    m_transmitQueue->setWeight(std::hash<Name>()(prefix), weight);
+}
+
+void
+NetDeviceFace::setInterestShaping(DataRate dataRate, uint32_t maxQueued, uint32_t burst)
+{
+  NS_ASSERT_MSG(burst > 0, "Interest shaping needs a burst of at least one Data");
+
+  m_shapingRate = dataRate;
+  m_maxShapedInterests = maxQueued;
+  m_shapingBurst = burst;
+  m_lastShapingRefill = Simulator::Now();
+
+  // queued Interests are sent at once if there is no shaping any more
+  Simulator::Cancel(m_shapingEvent);
+  releaseShapedInterests();
+}
+
+void
+NetDeviceFace::refillShapingTokens()
+{
+  Time now = Simulator::Now();
+  double dataSize = m_averageDataSize > 0 ? m_averageDataSize : m_netDevice->GetMtu();
+  m_shapingTokens = std::min(m_shapingTokens + (now - m_lastShapingRefill).GetSeconds() *
+                                                 m_shapingRate.GetBitRate() / 8,
+                             m_shapingBurst * dataSize);
+  m_lastShapingRefill = now;
+}
+
+void
+NetDeviceFace::releaseShapedInterests()
+{
+  bool isShaping = m_shapingRate.GetBitRate() > 0;
+  if (isShaping)
+    refillShapingTokens();
+
+  double dataSize = m_averageDataSize > 0 ? m_averageDataSize : m_netDevice->GetMtu();
+  size_t length = m_shapedInterests.size();
+  while (!m_shapedInterests.empty() && (!isShaping || m_shapingTokens >= dataSize)) {
+    ShapedInterest shaped = std::move(m_shapedInterests.front());
+    m_shapedInterests.pop_front();
+    if (shaped.expiry < Simulator::Now()) {
+      ++m_nShapingExpired;
+      NS_LOG_LOGIC("Interest " << shaped.interest->getName() << " expired in the shaping queue");
+      InterestShapingDrop(shaped.interest);
+      continue;
+    }
+    if (isShaping)
+      m_shapingTokens -= dataSize;
+    transmitInterest(*shaped.interest);
+  }
+  if (m_shapedInterests.size() != length)
+    InterestShapingQueueLength(m_shapedInterests.size());
+
+  if (!m_shapedInterests.empty()) {
+    Time wait = Seconds((dataSize - m_shapingTokens) * 8 / m_shapingRate.GetBitRate());
+    m_shapingEvent = Simulator::Schedule(wait, &NetDeviceFace::releaseShapedInterests, this);
+  }
+}
+
+void
+NetDeviceFace::nackRefusedInterests()
+{
+  std::vector<shared_ptr<const Interest>> refused;
+  refused.swap(m_refusedInterests);
+  for (const shared_ptr<const Interest>& interest : refused) {
+    lp::Nack nack(*interest);
+    nack.setReason(lp::NackReason::CONGESTION);
+    this->emitSignal(onReceiveNack, nack);
+  }
+}
+
+void
+NetDeviceFace::transmitQueueChanged()
+{
+  uint32_t length = getTransmitQueueLength();
+  TransmitQueueLength(length);
+
+  if (m_maxTransmitQueue > 0 && length >= m_maxTransmitQueue - m_maxTransmitQueue / 4)
+    setCongested(true);
+  else if (length <= m_maxTransmitQueue / 4)
+    setCongested(false);
+}
+
+// TLV type of container frames, assigned neither by NDN TLV nor by NDNLP
+static const uint32_t CONTAINER_TYPE = 96;
+
+// container header is at most this large: 1 octet type and up to 3 octets length
+static const uint32_t CONTAINER_OVERHEAD = 4;
+
+/**
+ * \brief Sets the value of a packet tag of the packet
+ *
+ * The packet shares its tag list with the packet it was copied from.  Removing a tag and adding
+ * it back makes the packet copy the list up to the tag and allocate a new list entry on top of
+ * that, while replacing writes the tag at its place in the list.
+ */
+template<class T>
+static void
+setPacketTag(Ptr<Packet> packet, T& tag)
+{
+  T current;
+  if (packet->PeekPacketTag(current))
+    packet->ReplacePacketTag(tag);
+  else
+    packet->AddPacketTag(tag);
+}
+
+/**
+ * \brief Whether the packet carries octets after its TLV element, e.g. a virtual payload
+ */
+static bool
+hasTrailingOctets(Ptr<const Packet> packet)
+{
+  uint8_t head[1 + 8 + 8];
+  uint32_t size = packet->CopyData(head, sizeof(head));
+  const uint8_t* begin = head;
+  const uint8_t* end = head + size;
+
+  uint32_t type;
+  uint64_t length;
+  if (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length))
+    return true;
+  return static_cast<uint64_t>(begin - head) + length != packet->GetSize();
+}
 
+void
+NetDeviceFace::send(Ptr<Packet> packet, const Address& to)
+{
   FwHopCountTag tag;
-  packet->RemovePacketTag(tag);
+  packet->PeekPacketTag(tag);
   tag.Increment();
-  packet->AddPacketTag(tag);
 
-  m_netDevice->Send(packet, m_netDevice->GetBroadcast(), L3Protocol::ETHERNET_FRAME_TYPE);
+  // packets with other tags, like RTT hints, are not aggregated, as a container carries only
+  // the hop count, nor are packets with virtual payload, as containers are split by TLV lengths
+  uint32_t budget = m_netDevice->GetMtu() - CONTAINER_OVERHEAD;
+  RttHintTag hint;
+  PushedDataTag pushed;
+  if (!m_isAggregation || 2 * packet->GetSize() > budget || packet->PeekPacketTag(hint)
+      || packet->PeekPacketTag(pushed) || hasTrailingOctets(packet)) {
+    setPacketTag(packet, tag);
+    sendFrame(packet, to);
+    return;
+  }
+
+  PendingFrame& pending = m_pendingFrames[to];
+  if (!pending.packets.empty() && pending.size + packet->GetSize() > budget) {
+    Simulator::Cancel(pending.flushEvent);
+    flush(to);
+  }
+
+  PendingFrame& frame = m_pendingFrames[to];
+  if (frame.packets.empty()) {
+    frame.size = 0;
+    frame.hopCount = tag;
+    frame.flushEvent = Simulator::Schedule(m_holdTime, &NetDeviceFace::flush, this, to);
+  }
+  frame.packets.push_back(packet);
+  frame.size += packet->GetSize();
+  if (tag.Get() > frame.hopCount.Get())
+    frame.hopCount = tag;
+}
+
+void
+NetDeviceFace::flush(Address to)
+{
+  auto pending = m_pendingFrames.find(to);
+  if (pending == m_pendingFrames.end())
+    return;
+
+  PendingFrame frame = std::move(pending->second);
+  m_pendingFrames.erase(pending);
+
+  Ptr<Packet> packet;
+  if (frame.packets.size() == 1) {
+    packet = frame.packets.front();
+  }
+  else {
+    ::ndn::EncodingBuffer header(CONTAINER_OVERHEAD, CONTAINER_OVERHEAD);
+    header.prependVarNumber(frame.size);
+    header.prependVarNumber(CONTAINER_TYPE);
+
+    packet = Create<Packet>(header.buf(), header.size());
+    for (const Ptr<Packet>& inner : frame.packets) {
+      packet->AddAtEnd(inner);
+    }
+    ++m_nAggregatedFrames;
+    m_nAggregatedPackets += frame.packets.size();
+  }
+
+  setPacketTag(packet, frame.hopCount);
+  sendFrame(packet, to);
+}
+
+void
+NetDeviceFace::sendFrame(Ptr<Packet> packet, const Address& to)
+{
+  if (m_transmitQueue == nullptr) {
+    transmitFrame(packet, to);
+    return;
+  }
+
+  nfd::TransmitClass transmitClass;
+  size_t flow;
+  classifyFrame(packet, transmitClass, flow);
+  uint32_t size = packet->GetSize();
+  if (!m_transmitQueue->enqueue(QueuedFrame{packet, to}, size, transmitClass, flow)) {
+    NS_LOG_LOGIC("Transmit queue full, packet dropped");
+    ++m_nTransmitQueueDrops;
+    TransmitQueueDrop(packet);
+    return;
+  }
+  transmitQueueChanged();
+
+  if (!m_transmitEvent.IsRunning())
+    transmitNext();
+}
+
+void
+NetDeviceFace::transmitNext()
+{
+  QueuedFrame frame;
+  if (m_transmitQueue == nullptr || !m_transmitQueue->dequeue(frame))
+    return;
+  transmitQueueChanged();
+
+  transmitFrame(frame.packet, frame.to);
+
+  // the next frame is handed over when the device would have sent this one
+  Time txTime = Seconds(frame.packet->GetSize() * 8.0 / m_transmitRate.GetBitRate());
+  m_transmitEvent = Simulator::Schedule(txTime, &NetDeviceFace::transmitNext, this);
+}
+
+void
+NetDeviceFace::transmitFrame(Ptr<Packet> packet, const Address& to)
+{
+  if (m_isLinkDown) {
+    ++m_nLinkDownDrops;
+    return;
+  }
+
+  if (to != m_netDevice->GetBroadcast())
+    ++m_nUnicastSent;
+
+  // position at the time of transmission, replaces the one of the previous hop
+  Ptr<MobilityModel> mobility = m_node->GetObject<MobilityModel>();
+  if (mobility != 0) {
+    GeoPositionTag position(mobility->GetPosition());
+    setPacketTag(packet, position);
+  }
+
+  if (packet->GetSize() <= m_netDevice->GetMtu()) {
+    m_netDevice->Send(packet, to, L3Protocol::ETHERNET_FRAME_TYPE);
+    return;
+  }
+
+  if (m_slicer == nullptr)
+    m_slicer.reset(new nfd::ndnlp::Slicer(m_netDevice->GetMtu()));
+
+  ::ndn::BufferPtr wire = ::ndn::makeBuffer(packet->GetSize());
+  packet->CopyData(wire->buf(), wire->size());
+  // virtual payload after the TLV element is sliced too, the receiver makes it virtual again
+  nfd::ndnlp::PacketArray fragments =
+    m_slicer->slice(Block(wire, wire->begin(), wire->end(), false));
+  ++m_nFragmentedPackets;
+
+  for (const Block& fragment : *fragments) {
+    Ptr<Packet> frame = packet->CreateFragment(0, 0); // keeps the packet tags
+    frame->AddAtEnd(Create<Packet>(fragment.wire(), fragment.size()));
+    m_netDevice->Send(frame, to, L3Protocol::ETHERNET_FRAME_TYPE);
+  }
+}
+
+// neighbor tables are only cleaned up when they grow beyond this size
+static const size_t MAX_NEIGHBOR_ENTRIES = 4096;
+
+void
+NetDeviceFace::purgeNeighborTables()
+{
+  Time now = Simulator::Now();
+
+  if (m_upstreams.size() > MAX_NEIGHBOR_ENTRIES) {
+    for (auto i = m_upstreams.begin(); i != m_upstreams.end();) {
+      i = now - i->second.lastSeen > m_neighborTimeout ? m_upstreams.erase(i) : std::next(i);
+    }
+    if (m_upstreams.size() > MAX_NEIGHBOR_ENTRIES)
+      m_upstreams.clear();
+  }
+
+  if (m_requesters.size() > MAX_NEIGHBOR_ENTRIES) {
+    for (auto i = m_requesters.begin(); i != m_requesters.end();) {
+      i = i->second.expiry < now ? m_requesters.erase(i) : std::next(i);
+    }
+    if (m_requesters.size() > MAX_NEIGHBOR_ENTRIES)
+      m_requesters.clear();
+  }
+
+  if (m_sentInterests.size() > MAX_NEIGHBOR_ENTRIES) {
+    for (auto i = m_sentInterests.begin(); i != m_sentInterests.end();) {
+      i = i->second.expiry < now ? m_sentInterests.erase(i) : std::next(i);
+    }
+    if (m_sentInterests.size() > MAX_NEIGHBOR_ENTRIES)
+      m_sentInterests.clear();
+  }
+
+  if (m_scheduledInterests.size() > MAX_NEIGHBOR_ENTRIES) {
+    for (auto i = m_scheduledInterests.begin(); i != m_scheduledInterests.end();) {
+      i = i->second.expiry < now ? m_scheduledInterests.erase(i) : std::next(i);
+    }
+    if (m_scheduledInterests.size() > MAX_NEIGHBOR_ENTRIES)
+      m_scheduledInterests.clear();
+  }
+}
+
+void
+NetDeviceFace::learnInterest(const Interest& interest, const Address& from)
+{
+  Time expiry = Simulator::Now() + MilliSeconds(interest.getInterestLifetime().count());
+
+  auto i = m_requesters.find(interest.getName());
+  if (i == m_requesters.end() || i->second.expiry < Simulator::Now()) {
+    m_requesters[interest.getName()] = Requester{from, expiry, false};
+  }
+  else {
+    i->second.isShared = i->second.isShared || i->second.address != from;
+    i->second.expiry = std::max(i->second.expiry, expiry);
+  }
+  purgeNeighborTables();
+}
+
+void
+NetDeviceFace::learnData(const Data& data, const Address& from)
+{
+  if (data.getName().empty())
+    return;
+
+  m_upstreams[data.getName().getPrefix(-1)] = Upstream{from, Simulator::Now()};
+  m_sentInterests.erase(data.getName());
+  purgeNeighborTables();
+}
+
+Address
+NetDeviceFace::getInterestDestination(const Interest& interest)
+{
+  Time now = Simulator::Now();
+  Address to = m_netDevice->GetBroadcast();
+
+  auto sent = m_sentInterests.find(interest.getName());
+  bool isRetransmission = sent != m_sentInterests.end() && sent->second.expiry >= now;
+  if (isRetransmission && !sent->second.wasUnicast && !interest.getName().empty()) {
+    auto upstream = m_upstreams.find(interest.getName().getPrefix(-1));
+    if (upstream != m_upstreams.end() && now - upstream->second.lastSeen <= m_neighborTimeout)
+      to = upstream->second.address;
+  }
+
+  m_sentInterests[interest.getName()] =
+    SentInterest{now + MilliSeconds(interest.getInterestLifetime().count()),
+                 to != m_netDevice->GetBroadcast()};
+  purgeNeighborTables();
+  return to;
+}
+
+Address
+NetDeviceFace::getDataDestination(const Data& data)
+{
+  Address to = m_netDevice->GetBroadcast();
+
+  auto requester = m_requesters.find(data.getName());
+  if (requester != m_requesters.end()) {
+    if (!requester->second.isShared && requester->second.expiry >= Simulator::Now())
+      to = requester->second.address;
+    m_requesters.erase(requester);
+  }
+  return to;
+}
+
+void
+NetDeviceFace::setNextHop(const Name& prefix, const Address& address)
+{
+  m_nextHops[prefix] = address;
+}
+
+void
+NetDeviceFace::removeNextHop(const Name& prefix)
+{
+  m_nextHops.erase(prefix);
+}
+
+bool
+NetDeviceFace::findNextHop(const Name& name, Address& address) const
+{
+  for (size_t length = name.size() + 1; length-- > 0;) {
+    auto nextHop = m_nextHops.find(name.getPrefix(length));
+    if (nextHop != m_nextHops.end()) {
+      address = nextHop->second;
+      return true;
+    }
+  }
+  return false;
 }
 
 void
@@ -94,21 +732,222 @@ NetDeviceFace::sendInterest(const Interest& interest)
 {
   NS_LOG_FUNCTION(this << &interest);
 
+  if (m_shapingRate.GetBitRate() == 0) {
+    transmitInterest(interest);
+    return;
+  }
+
+  refillShapingTokens();
+  double dataSize = m_averageDataSize > 0 ? m_averageDataSize : m_netDevice->GetMtu();
+  if (m_shapedInterests.empty() && m_shapingTokens >= dataSize) {
+    m_shapingTokens -= dataSize;
+    transmitInterest(interest);
+    return;
+  }
+
+  if (m_shapedInterests.size() >= m_maxShapedInterests) {
+    ++m_nShapingNacks;
+    NS_LOG_LOGIC("Shaping queue full, Interest " << interest.getName() << " Nacked");
+    InterestShapingDrop(interest.shared_from_this());
+    m_refusedInterests.push_back(interest.shared_from_this());
+    if (!m_shapingNackEvent.IsRunning())
+      m_shapingNackEvent = Simulator::ScheduleNow(&NetDeviceFace::nackRefusedInterests, this);
+    return;
+  }
+
+  ++m_nShapedInterests;
+  m_shapedInterests.push_back(
+    ShapedInterest{interest.shared_from_this(),
+                   Simulator::Now() + MilliSeconds(interest.getInterestLifetime().count())});
+  InterestShapingQueueLength(m_shapedInterests.size());
+  if (!m_shapingEvent.IsRunning())
+    releaseShapedInterests();
+}
+
+void
+NetDeviceFace::transmitInterest(const Interest& interest)
+{
+  NDN_ALLOCATION_SCOPE(GLUE);
+
   this->emitSignal(onSendInterest, interest);
 
+  if (m_isTransmitScheduling) {
+    Time now = Simulator::Now();
+    auto scheduled = m_scheduledInterests.find(interest.getName());
+    bool isRetransmission = scheduled != m_scheduledInterests.end() &&
+                            scheduled->second.expiry >= now;
+    m_scheduledInterests[interest.getName()] =
+      ScheduledInterest{now + MilliSeconds(interest.getInterestLifetime().count()),
+                        isRetransmission};
+    purgeNeighborTables();
+  }
+
   Ptr<Packet> packet = Convert::ToPacket(interest);
-  send(packet);
+  Address to;
+  if (m_nextHops.empty() || !findNextHop(interest.getName(), to)) {
+    to = m_isNeighborUnicast ? getInterestDestination(interest) : m_netDevice->GetBroadcast();
+  }
+  sendOrDefer(packet, to, interest.getName(), true, interest.getNonce());
 }
 
 void
 NetDeviceFace::sendData(const Data& data)
 {
   NS_LOG_FUNCTION(this << &data);
+  NDN_ALLOCATION_SCOPE(GLUE);
 
   this->emitSignal(onSendData, data);
 
   Ptr<Packet> packet = Convert::ToPacket(data);
-  send(packet);
+
+  // own statistics replace the hint of the upstream node, if there is any
+  Ptr<RttHintTable> hints = m_node->GetObject<RttHintTable>();
+  RttHintTag hint;
+  if (hints != 0 && hints->GetHint(data.getName(), hint)) {
+    setPacketTag(packet, hint);
+  }
+
+  sendOrDefer(packet, m_isNeighborUnicast ? getDataDestination(data) : m_netDevice->GetBroadcast(),
+              data.getName(), false, 0);
+}
+
+void
+NetDeviceFace::pushData(const Data& data, double correlativity)
+{
+  NS_LOG_FUNCTION(this << &data << correlativity);
+
+  this->emitSignal(onSendData, data);
+
+  Ptr<Packet> packet = Convert::ToPacket(data);
+  PushedDataTag tag(correlativity);
+  setPacketTag(packet, tag);
+  ++m_nPushedData;
+
+  // not deferred, nobody else serves the same Data
+  send(packet, m_netDevice->GetBroadcast());
+}
+
+void
+NetDeviceFace::sendNack(const lp::Nack& nack)
+{
+  NS_LOG_FUNCTION(this << &nack);
+
+  this->emitSignal(onSendNack, nack);
+
+  // unicast to the requester if it is known, without forgetting it, as Data may still come
+  Address to = m_netDevice->GetBroadcast();
+  if (m_isNeighborUnicast) {
+    auto requester = m_requesters.find(nack.getInterest().getName());
+    if (requester != m_requesters.end() && !requester->second.isShared &&
+        requester->second.expiry >= Simulator::Now())
+      to = requester->second.address;
+  }
+
+  send(Convert::ToPacket(nack), to);
+}
+
+// names of Data are looked for in this many first octets of a packet
+static const uint32_t PEEK_SIZE = 256;
+
+bool
+NetDeviceFace::peekDataName(Ptr<const Packet> packet, Name& name)
+{
+  uint8_t head[PEEK_SIZE];
+  uint32_t size = packet->CopyData(head, PEEK_SIZE);
+  const uint8_t* begin = head;
+  const uint8_t* end = head + size;
+
+  uint32_t type;
+  uint64_t length;
+  if (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length))
+    return false;
+
+  // Name is the first element of Data
+  const uint8_t* nameBegin = begin;
+  if (!::ndn::tlv::readType(begin, end, type) || type != ::ndn::tlv::Name
+      || !::ndn::tlv::readVarNumber(begin, end, length)
+      || length > static_cast<uint64_t>(end - begin))
+    return false;
+
+  name = Name(Block(nameBegin, begin + length - nameBegin));
+  return true;
+}
+
+void
+NetDeviceFace::classifyFrame(Ptr<const Packet> packet, nfd::TransmitClass& transmitClass,
+                             size_t& flow)
+{
+  transmitClass = nfd::TRANSMIT_CLASS_INTEREST;
+  flow = 0;
+  if (!m_isTransmitScheduling)
+    return;
+
+  uint8_t head[PEEK_SIZE];
+  uint32_t size = packet->CopyData(head, PEEK_SIZE);
+  const uint8_t* begin = head;
+  const uint8_t* end = head + size;
+
+  uint32_t type;
+  uint64_t length;
+  if (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length))
+    return;
+
+  // a container is scheduled as its first packet
+  if (type == CONTAINER_TYPE &&
+      (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length)))
+    return;
+
+  if (type == lp::tlv::LpPacket) {
+    transmitClass = nfd::TRANSMIT_CLASS_CONTROL;
+    return;
+  }
+  if (type == ::ndn::tlv::Data)
+    transmitClass = nfd::TRANSMIT_CLASS_DATA;
+
+  // Name is the first element of Interest and Data
+  const uint8_t* nameBegin = begin;
+  if (!::ndn::tlv::readType(begin, end, type) || type != ::ndn::tlv::Name
+      || !::ndn::tlv::readVarNumber(begin, end, length)
+      || length > static_cast<uint64_t>(end - begin))
+    return;
+  Name name(Block(nameBegin, begin + length - nameBegin));
+
+  if (transmitClass == nfd::TRANSMIT_CLASS_INTEREST) {
+    auto scheduled = m_scheduledInterests.find(name);
+    if (scheduled != m_scheduledInterests.end() && scheduled->second.isRetransmission)
+      transmitClass = nfd::TRANSMIT_CLASS_RETRANSMISSION;
+  }
+
+  if (!m_transmitClasses.empty()) {
+    for (size_t length = name.size() + 1; length-- > 0;) {
+      auto entry = m_transmitClasses.find(name.getPrefix(length));
+      if (entry != m_transmitClasses.end()) {
+        transmitClass = entry->second;
+        break;
+      }
+    }
+  }
+
+  // pushed Data only fill the capacity left, whatever the class of their prefix
+  PushedDataTag pushed;
+  if (packet->PeekPacketTag(pushed))
+    transmitClass = nfd::TRANSMIT_CLASS_BULK;
+
+  flow = std::hash<Name>()(name.getPrefix(m_flowPrefixLength));
+}
+
+bool
+NetDeviceFace::isUnsolicitedData(const Name& name, const std::vector<size_t>& hashSet)
+{
+  Ptr<L3Protocol> protocol = m_node->GetObject<L3Protocol>();
+  if (protocol == 0)
+    return false;
+
+  // same candidates as Pit::findAllDataMatches, whose Interests may still not match the Data
+  shared_ptr<nfd::name_tree::Entry> entry =
+    protocol->getForwarder()->getNameTree().findLongestPrefixMatch(name, hashSet,
+      [] (const nfd::name_tree::Entry& entry) { return entry.hasPitEntries(); });
+  return entry == nullptr;
 }
 
 // callback
@@ -117,24 +956,184 @@ NetDeviceFace::receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p,
                                     const Address& from, const Address& to,
                                     NetDevice::PacketType packetType)
 {
+  NDN_PROFILE_ZONE("NetDeviceFace::receiveFromNetDevice");
+  NDN_ALLOCATION_SCOPE(GLUE);
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  Ptr<Packet> packet = p->Copy();
+  if (m_isLinkDown) {
+    ++m_nLinkDownDrops;
+    return;
+  }
+
+  uint8_t type = 0;
+  p->CopyData(&type, 1);
+  if (type == ::ndn::tlv::Interest && packetType == NetDevice::PACKET_OTHERHOST &&
+      m_isOtherHostInterestFilter) {
+    ++m_nFilteredInterests;
+    return;
+  }
+
+  if (type == CONTAINER_TYPE) {
+    receiveContainer(p, from);
+  }
+  else if (type == nfd::tlv::NdnlpData) {
+    receiveFragment(p, from);
+  }
+  else {
+    receivePacket(p, from);
+  }
+}
+
+// per-neighbor reassemblers are dropped if nothing is received from the neighbor for this long
+static const Time REASSEMBLER_LIFETIME = Seconds(60);
+
+void
+NetDeviceFace::receiveFragment(Ptr<const Packet> p, const Address& from)
+{
+  ::ndn::BufferPtr wire = ::ndn::makeBuffer(p->GetSize());
+  p->CopyData(wire->buf(), wire->size());
+
+  bool isOk = false;
+  Block fragmentBlock;
+  std::tie(isOk, fragmentBlock) = Block::fromBuffer(wire, 0);
+  nfd::ndnlp::NdnlpData fragment;
+  if (isOk)
+    std::tie(isOk, fragment) = nfd::ndnlp::NdnlpData::fromBlock(fragmentBlock);
+  if (!isOk) {
+    ++m_nDroppedMalformed;
+    NS_LOG_ERROR("Malformed NDNLP fragment");
+    return;
+  }
+
+  Reassembler& reassembler = m_reassemblers[from];
+  if (reassembler.pms == nullptr) {
+    // new sender, fragment sequence numbers are only unique per sender
+    reassembler.pms.reset(new nfd::ndnlp::PartialMessageStore(
+      time::nanoseconds(m_reassemblyTimeout.GetNanoSeconds())));
+    reassembler.pms->onReceive.connect([this, from] (const Block& block) {
+        ++m_nReassembledPackets;
+        Ptr<Packet> packet = m_lastFragment->CreateFragment(0, 0); // keeps the packet tags
+        packet->AddAtEnd(Create<Packet>(block.wire(), block.size()));
+        // reassembled buffer ends with the virtual payload of the packet, if it has one
+        packet->AddPaddingAtEnd(block.getBuffer()->size() - block.size());
+        receivePacket(packet, from);
+      });
+  }
+  Simulator::Cancel(reassembler.expireEvent);
+  reassembler.expireEvent =
+    Simulator::Schedule(REASSEMBLER_LIFETIME, &NetDeviceFace::removeReassembler, this, from);
+
+  m_lastFragment = p;
+  reassembler.pms->receive(fragment);
+  m_lastFragment = nullptr;
+}
+
+void
+NetDeviceFace::removeReassembler(Address from)
+{
+  m_reassemblers.erase(from);
+}
+
+void
+NetDeviceFace::receiveContainer(Ptr<const Packet> p, const Address& from)
+{
+  // containers are not larger than the MTU, so element boundaries are found in a copy
+  std::vector<uint8_t> wire(p->GetSize());
+  p->CopyData(wire.data(), wire.size());
+  const uint8_t* begin = wire.data();
+  const uint8_t* end = wire.data() + wire.size();
+
+  uint32_t type;
+  uint64_t length;
+  if (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length)
+      || length != static_cast<uint64_t>(end - begin)) {
+    ++m_nDroppedMalformed;
+    NS_LOG_ERROR("Malformed container frame");
+    return;
+  }
+
+  while (begin != end) {
+    const uint8_t* element = begin;
+    if (!::ndn::tlv::readType(begin, end, type) || !::ndn::tlv::readVarNumber(begin, end, length)
+        || length > static_cast<uint64_t>(end - begin)) {
+      ++m_nDroppedMalformed;
+      NS_LOG_ERROR("Malformed packet in container frame");
+      return;
+    }
+    begin += length;
+
+    // fragments keep the packet tags of the container
+    receivePacket(p->CreateFragment(element - wire.data(), begin - element), from);
+  }
+}
+
+void
+NetDeviceFace::receivePacket(Ptr<const Packet> p, const Address& from)
+{
+  uint32_t type;
+  try {
+    type = Convert::getPacketType(p);
+  }
+  catch (::ndn::tlv::Error&) {
+    ++m_nDroppedNonNdn;
+    NS_LOG_ERROR("Unrecognized TLV packet");
+    return;
+  }
+
   try {
-    uint32_t type = Convert::getPacketType(p);
+    Name name;
+    shared_ptr<nfd::name_tree::HashSetTag> hashSetTag;
+    if (type == ::ndn::tlv::Data && peekDataName(p, name)) {
+      if (!m_deferred.empty())
+        cancelDeferred(name, false, 0);
+
+      hashSetTag = make_shared<nfd::name_tree::HashSetTag>(name);
+      if (isUnsolicitedData(name, hashSetTag->getHashSet())) {
+        // e.g., overheard broadcast of Data for other nodes
+        if (!m_isOverhearing) {
+          // the forwarder would drop it anyway
+          ++m_nDroppedUnsolicitedData;
+          NS_LOG_LOGIC("Unsolicited Data dropped");
+          return;
+        }
+        ++m_nOverheardData;
+        NS_LOG_LOGIC("Unsolicited Data passed to the forwarder");
+      }
+    }
+
+    // only packets that are processed are copied, RemoveHeader needs a packet of its own
+    Ptr<Packet> packet = p->Copy();
     if (type == ::ndn::tlv::Interest) {
       shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
+      if (m_isNeighborUnicast)
+        learnInterest(*i, from);
+      if (!m_deferred.empty())
+        cancelDeferred(i->getName(), true, i->getNonce());
       this->emitSignal(onReceiveInterest, *i);
     }
-    else if (type == ::ndn::tlv::Data) {
-      shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
-      this->emitSignal(onReceiveData, *d);
+    else if (type == lp::tlv::LpPacket) {
+      shared_ptr<const lp::Nack> nack = Convert::FromPacket<lp::Nack>(packet);
+      this->emitSignal(onReceiveNack, *nack);
     }
     else {
-      NS_LOG_ERROR("Unsupported TLV packet");
+      uint32_t size = packet->GetSize();
+      shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
+      // gain of 1/8, as for the smoothed RTT
+      m_averageDataSize = m_averageDataSize > 0 ? m_averageDataSize + (size - m_averageDataSize) / 8
+                                                : size;
+      if (hashSetTag != nullptr)
+        d->setTag(hashSetTag); // PIT lookup of the forwarder does not hash the name again
+      if (m_isNeighborUnicast)
+        learnData(*d, from);
+      if (!m_scheduledInterests.empty())
+        m_scheduledInterests.erase(d->getName());
+      if (!m_deferred.empty())
+        cancelDeferred(d->getName(), false, 0);
+      this->emitSignal(onReceiveData, *d);
     }
   }
   catch (::ndn::tlv::Error&) {
+    ++m_nDroppedMalformed;
     NS_LOG_ERROR("Unrecognized TLV packet");
   }
 }
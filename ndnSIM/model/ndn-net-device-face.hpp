@@ -22,8 +22,28 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
+#include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/transmit-scheduler.hpp"
 
 #include "ns3/net-device.h"
+#include "ns3/address.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/data-rate.h"
+#include "ns3/traced-callback.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace nfd {
+namespace ndnlp {
+class Slicer;
+class PartialMessageStore;
+} // namespace ndnlp
+} // namespace nfd
 
 namespace ns3 {
 namespace ndn {
@@ -62,10 +82,27 @@ public: // from nfd::Face
   virtual void
   sendData(const Data& data);
 
+  virtual void
+  sendNack(const lp::Nack& nack);
+
   virtual void
   close();
 
+  virtual size_t
+  getTransmitQueueLength() const;
+
 public:
+  /**
+   * \brief Broadcasts Data that no neighbor asked for, to be cached by the neighbors
+   *
+   * The packet is tagged with PushedDataTag and \p correlativity.  With transmit scheduling,
+   * it is sent in the bulk class, after all other traffic of the face.  Neighbors pass it to
+   * their forwarder as unsolicited Data only if they overhear (see setOverhearing).
+   * \sa PushCache
+   */
+  void
+  pushData(const Data& data, double correlativity);
+
   /**
    * \brief Get NetDevice associated with the face
    *
@@ -74,18 +111,693 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Enables or disables unicast to known neighbors
+   *
+   * By default every packet is sent to the broadcast address.  With neighbor unicast, the face
+   * learns the link addresses of neighbors from the packets it receives:
+   *  - Data are unicast to the neighbor that sent the Interest, if exactly one did
+   *  - a retransmitted Interest is unicast to the neighbor that last sent Data under the same
+   *    prefix (name without its last component) within \p neighborTimeout
+   *
+   * Everything else is broadcast, and so is an Interest whose previous transmission was unicast,
+   * so a neighbor that moved away costs at most one transmission.
+   */
+  void
+  setNeighborUnicast(bool enable, Time neighborTimeout = Seconds(2));
+
+  bool
+  isNeighborUnicast() const
+  {
+    return m_isNeighborUnicast;
+  }
+
+  /**
+   * \brief Sets the link address of the next hop of Interests under \p prefix
+   *
+   * Interests under a prefix with a next hop (longest prefix match) are unicast to it,
+   * regardless of neighbor unicast.  Other Interests are sent as usual.
+   * \sa WirelessRoutingHelper
+   */
+  void
+  setNextHop(const Name& prefix, const Address& address);
+
+  void
+  removeNextHop(const Name& prefix);
+
+  /**
+   * \brief Enables or disables dropping of received Interests unicast to other nodes
+   *
+   * The face receives frames in promiscuous mode, so by default it also processes Interests
+   * that neighbors unicast to each other.  With next hops (see setNextHop), only the node
+   * on the route should forward them.  Interests inside containers or fragments are not
+   * filtered.
+   */
+  void
+  setOtherHostInterestFilter(bool enable)
+  {
+    m_isOtherHostInterestFilter = enable;
+  }
+
+  /**
+   * \brief Number of received Interests dropped, as they were unicast to another node
+   * \sa setOtherHostInterestFilter
+   */
+  uint64_t
+  getNFilteredInterests() const
+  {
+    return m_nFilteredInterests;
+  }
+
+  /**
+   * \brief Enables or disables passing overheard Data to the forwarder
+   *
+   * By default received Data without a pending Interest on the node are dropped by the face
+   * (see getNDroppedUnsolicitedData).  With overhearing, they are decoded and passed to the
+   * forwarder as unsolicited Data, which can cache them and remember that a neighbor served
+   * the name (see nfd::Forwarder::setOverheardDataAdmission and
+   * nfd::Forwarder::setOverheardDataLifetime).
+   */
+  void
+  setOverhearing(bool enable)
+  {
+    m_isOverhearing = enable;
+  }
+
+  bool
+  isOverhearing() const
+  {
+    return m_isOverhearing;
+  }
+
+  /**
+   * \brief Sets how long fragments of a packet from one neighbor are kept for reassembly
+   *
+   * Packets larger than the device MTU are sent as NDNLP fragments and reassembled by the
+   * receiving face.  A partially received packet is discarded if no more of its fragments
+   * arrive within \p timeout.
+   */
+  void
+  setReassemblyTimeout(Time timeout);
+
+  Time
+  getReassemblyTimeout() const
+  {
+    return m_reassemblyTimeout;
+  }
+
+  /**
+   * \brief Number of packets sent as NDNLP fragments
+   */
+  uint64_t
+  getNFragmentedPackets() const
+  {
+    return m_nFragmentedPackets;
+  }
+
+  /**
+   * \brief Number of packets reassembled from NDNLP fragments
+   */
+  uint64_t
+  getNReassembledPackets() const
+  {
+    return m_nReassembledPackets;
+  }
+
+  /**
+   * \brief Enables or disables deferring of broadcast packets
+   *
+   * With \p maxDefer larger than zero, every Interest and Data to be broadcast is held for a
+   * random time, uniform in [0, \p maxDefer).  The packet is not sent at all, if in the meantime
+   * the face overhears the same packet from a neighbor (Interest with the same name and nonce,
+   * Data with the same name) or Data that satisfy the held Interest.  Neighbors that would all
+   * forward the same packet at once thus spread out and mostly only one of them sends it.
+   *
+   * Packets unicast to known neighbors are not deferred.
+   */
+  void
+  setBroadcastDefer(Time maxDefer);
+
+  Time
+  getBroadcastDefer() const
+  {
+    return m_maxDefer;
+  }
+
+  /**
+   * \brief Number of deferred packets that were not sent, as a neighbor sent them first
+   */
+  uint64_t
+  getNDeferCancelled() const
+  {
+    return m_nDeferCancelled;
+  }
+
+  /**
+   * \brief Enables or disables aggregation of small packets into container frames
+   *
+   * Packets bound for the same link address, which are not larger than half of the device MTU,
+   * are held for at most \p holdTime and sent together in one container frame, as soon as the
+   * next packet would not fit into the MTU.  Interests and small Data thus share the fixed
+   * per-frame overhead of the MAC.  A frame holding a single packet is sent as is.
+   *
+   * The receiving face unpacks containers regardless of its own setting.  Packets in a
+   * container carry the hop count of the container, i.e., the largest one of them.
+   */
+  void
+  setAggregation(bool enable, Time holdTime = MilliSeconds(1));
+
+  bool
+  isAggregation() const
+  {
+    return m_isAggregation;
+  }
+
+  /**
+   * \brief Number of container frames sent
+   */
+  uint64_t
+  getNAggregatedFrames() const
+  {
+    return m_nAggregatedFrames;
+  }
+
+  /**
+   * \brief Number of packets sent inside container frames
+   */
+  uint64_t
+  getNAggregatedPackets() const
+  {
+    return m_nAggregatedPackets;
+  }
+
+  /**
+   * \brief Enables or disables the transmit queue of the face
+   *
+   * By default packets are handed to the NetDevice as soon as they are sent, and pile up in the
+   * queue of the device (e.g., WifiMacQueue) where the forwarder cannot see them.  With
+   * \p maxPackets larger than zero, they wait in a queue of the face instead, and are handed to
+   * the device one at a time, each after the previous one would have been transmitted at
+   * \p rate.  Packets arriving at a full queue are dropped.
+   *
+   * The face is congested (see nfd::Face::isCongested) from when the queue is three quarters
+   * full, until it drains to a quarter.
+   *
+   * The queue is FIFO, unless transmit scheduling is enabled.
+   */
+  void
+  setTransmitQueue(uint32_t maxPackets, DataRate rate);
+
+  /**
+   * \brief Enables or disables scheduling of the transmit queue by class and flow
+   *
+   * With scheduling, every queued packet is put into a class (see nfd::TransmitClass): Nacks
+   * are control traffic, Interests sent again before the previous one expired or was answered
+   * are retransmissions, and the rest are Data or new Interests.  setTransmitClass overrides
+   * the class of packets under a prefix, except for pushed Data (see pushData), which are
+   * always bulk.  A class is served only when all higher priority classes are empty.
+   *
+   * Within a class, packets with the same first \p flowPrefixLength name components form a
+   * flow, and flows share the class by deficit round robin, in proportion to their weights
+   * (see setFlowWeight).  A container frame is scheduled as its first packet.
+   */
+  void
+  setTransmitScheduling(bool enable, size_t flowPrefixLength = 2);
+
+  bool
+  isTransmitScheduling() const
+  {
+    return m_isTransmitScheduling;
+  }
+
+  /**
+   * \brief Sets the class of packets under \p prefix (longest prefix match)
+   * \sa setTransmitScheduling
+   */
+  void
+  setTransmitClass(const Name& prefix, nfd::TransmitClass transmitClass);
+
+  void
+  removeTransmitClass(const Name& prefix);
+
+  /**
+   * \brief Sets the weight of the flow of packets under \p prefix, one by default
+   *
+   * \p prefix should have as many components as the flow prefix (see setTransmitScheduling).
+   */
+  void
+  setFlowWeight(const Name& prefix, size_t weight);
+
+  uint32_t
+  getTransmitQueueLimit() const
+  {
+    return m_maxTransmitQueue;
+  }
+
+  /**
+   * \brief Number of packets dropped, as the transmit queue was full
+   */
+  uint64_t
+  getNTransmitQueueDrops() const
+  {
+    return m_nTransmitQueueDrops;
+  }
+
+  /**
+   * \brief Enables or disables hop-by-hop shaping of the Interests sent
+   *
+   * Every Interest sent brings back a Data over the same link.  With \p dataRate larger than
+   * zero, Interests are sent at most at the rate at which their Data fit into \p dataRate,
+   * i.e., the capacity of the link left for the Data of this face, e.g., a share of the
+   * 802.11p channel: a token bucket filled with \p dataRate holds enough for \p burst Data,
+   * and each Interest takes the average size of the Data received by the face (the MTU until
+   * the first one is received).
+   *
+   * Interests beyond the rate wait in a FIFO queue of at most \p maxQueued Interests, and
+   * Interests that expire in the queue are dropped.  An Interest arriving at a full queue is
+   * answered with a Nack of reason Congestion, so that the strategy can try another face or
+   * the consumer slow down, instead of collapsing the channel with Data that cannot fit.
+   */
+  void
+  setInterestShaping(DataRate dataRate, uint32_t maxQueued = 64, uint32_t burst = 4);
+
+  DataRate
+  getInterestShapingRate() const
+  {
+    return m_shapingRate;
+  }
+
+  size_t
+  getInterestShapingQueueLength() const
+  {
+    return m_shapedInterests.size();
+  }
+
+  /**
+   * \brief Average size of the Data received by the face, used for Interest shaping
+   */
+  double
+  getAverageDataSize() const
+  {
+    return m_averageDataSize;
+  }
+
+  /**
+   * \brief Number of Interests that waited in the shaping queue
+   */
+  uint64_t
+  getNShapedInterests() const
+  {
+    return m_nShapedInterests;
+  }
+
+  /**
+   * \brief Number of Interests answered with a Nack, as the shaping queue was full
+   */
+  uint64_t
+  getNShapingNacks() const
+  {
+    return m_nShapingNacks;
+  }
+
+  /**
+   * \brief Number of Interests dropped, as they expired in the shaping queue
+   */
+  uint64_t
+  getNShapingExpired() const
+  {
+    return m_nShapingExpired;
+  }
+
+  /**
+   * \brief Number of packets sent to a unicast address
+   */
+  uint64_t
+  getNUnicastSent() const
+  {
+    return m_nUnicastSent;
+  }
+
+  /**
+   * \brief Number of received frames that are not NDN packets
+   */
+  uint64_t
+  getNDroppedNonNdn() const
+  {
+    return m_nDroppedNonNdn;
+  }
+
+  /**
+   * \brief Number of received Data dropped before decoding, as no Interest is pending for them
+   *
+   * These are mostly Data broadcast to other nodes and overheard.  They are not counted as
+   * incoming Data of the face.
+   */
+  uint64_t
+  getNDroppedUnsolicitedData() const
+  {
+    return m_nDroppedUnsolicitedData;
+  }
+
+  /**
+   * \brief Number of received Data without a pending Interest passed to the forwarder
+   * \sa setOverhearing
+   */
+  uint64_t
+  getNOverheardData() const
+  {
+    return m_nOverheardData;
+  }
+
+  /**
+   * \brief Number of Data sent by pushData
+   */
+  uint64_t
+  getNPushedData() const
+  {
+    return m_nPushedData;
+  }
+
+  /**
+   * \brief Takes the link of the face down or brings it back up
+   *
+   * While the link is down, frames are neither handed to the NetDevice nor taken from it,
+   * whatever the type of the device.  Packets already queued by the face are dropped when
+   * their turn comes.
+   * \sa FailureInjectionHelper
+   */
+  void
+  setLinkDown(bool isDown)
+  {
+    m_isLinkDown = isDown;
+  }
+
+  bool
+  isLinkDown() const
+  {
+    return m_isLinkDown;
+  }
+
+  /**
+   * \brief Number of frames not sent or not received, as the link was down
+   */
+  uint64_t
+  getNLinkDownDrops() const
+  {
+    return m_nLinkDownDrops;
+  }
+
+  /**
+   * \brief Number of received NDN packets that could not be decoded
+   */
+  uint64_t
+  getNDroppedMalformed() const
+  {
+    return m_nDroppedMalformed;
+  }
+
 private:
+  /**
+   * \brief Sends the Interest, after the shaping queue
+   */
+  void
+  transmitInterest(const Interest& interest);
+
+  /**
+   * \brief Adds the tokens accumulated since the last refill to the shaping bucket
+   */
+  void
+  refillShapingTokens();
+
+  /**
+   * \brief Sends the queued Interests that the bucket allows, and waits for the next one
+   */
+  void
+  releaseShapedInterests();
+
+  /**
+   * \brief Passes Nacks for the Interests refused by the shaper to the forwarder
+   *
+   * Nacks are not passed from within sendInterest, i.e., from within the strategy.
+   */
+  void
+  nackRefusedInterests();
+
+  void
+  send(Ptr<Packet> packet, const Address& to);
+
+  /**
+   * \brief Sends the packet, or puts it into the transmit queue if the face has one
+   */
+  void
+  sendFrame(Ptr<Packet> packet, const Address& to);
+
+  /**
+   * \brief Hands the packet to the NetDevice, as NDNLP fragments if it exceeds the MTU
+   */
+  void
+  transmitFrame(Ptr<Packet> packet, const Address& to);
+
+  /**
+   * \brief Transmits the packet at the head of the transmit queue
+   */
+  void
+  transmitNext();
+
+  void
+  transmitQueueChanged();
+
+  /**
+   * \brief Gets the class and flow of a packet from its first octets
+   */
+  void
+  classifyFrame(Ptr<const Packet> packet, nfd::TransmitClass& transmitClass, size_t& flow);
+
+  /**
+   * \brief Sends the packets held for \p to
+   */
+  void
+  flush(Address to);
+
+  /**
+   * \brief Sends a packet, after a random delay if it is broadcast and deferring is enabled
+   */
+  void
+  sendOrDefer(Ptr<Packet> packet, const Address& to, const Name& name, bool isInterest,
+              uint32_t nonce);
+
+  void
+  sendDeferred(Name name, bool isInterest, uint32_t nonce);
+
+  /**
+   * \brief Cancels deferred packets made unnecessary by the overheard one
+   */
+  void
+  cancelDeferred(const Name& name, bool isInterest, uint32_t nonce);
+
+  /**
+   * \brief Processes one NDN packet, possibly taken out of a container
+   */
+  void
+  receivePacket(Ptr<const Packet> p, const Address& from);
+
+  void
+  receiveContainer(Ptr<const Packet> p, const Address& from);
+
+  void
+  receiveFragment(Ptr<const Packet> p, const Address& from);
+
+  void
+  removeReassembler(Address from);
+
+  /**
+   * \brief Updates the neighbor tables with the received packet
+   */
+  void
+  learnInterest(const Interest& interest, const Address& from);
+
   void
-  send(Ptr<Packet> packet);
+  learnData(const Data& data, const Address& from);
+
+  Address
+  getInterestDestination(const Interest& interest);
+
+  /**
+   * \brief Finds the next hop of the longest prefix of \p name
+   */
+  bool
+  findNextHop(const Name& name, Address& address) const;
+
+  Address
+  getDataDestination(const Data& data);
+
+  /**
+   * \brief Removes expired entries if the neighbor tables grew too large
+   */
+  void
+  purgeNeighborTables();
 
   /// \brief callback from lower layers
   void
   receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol,
                        const Address& from, const Address& to, NetDevice::PacketType packetType);
 
+  /**
+   * \brief Gets the name of the Data in the packet from its first octets
+   *
+   * Returns false if the name cannot be found there, so that the packet is fully decoded.
+   */
+  bool
+  peekDataName(Ptr<const Packet> packet, Name& name);
+
+  /**
+   * \brief Whether the node has no pending Interest for Data with the name
+   * \param hashSet NameTree hash values of the name, reused by the forwarder for the Data
+   */
+  bool
+  isUnsolicitedData(const Name& name, const std::vector<size_t>& hashSet);
+
+public:
+  /**
+   * \brief Trace of the number of packets in the transmit queue, fires whenever it changes
+   */
+  TracedCallback<uint32_t> TransmitQueueLength;
+
+  /**
+   * \brief Trace of packets dropped, as the transmit queue was full
+   */
+  TracedCallback<Ptr<const Packet>> TransmitQueueDrop;
+
+  /**
+   * \brief Trace of the number of Interests in the shaping queue, fires whenever it changes
+   */
+  TracedCallback<uint32_t> InterestShapingQueueLength;
+
+  /**
+   * \brief Trace of Interests answered with a Nack or dropped by the shaper
+   */
+  TracedCallback<shared_ptr<const Interest>> InterestShapingDrop;
+
 private:
   Ptr<Node> m_node;
   Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
+
+  struct Upstream {
+    Address address;
+    Time lastSeen;
+  };
+
+  struct Requester {
+    Address address;
+    Time expiry;
+    bool isShared; // requested by more than one neighbor
+  };
+
+  struct SentInterest {
+    Time expiry;
+    bool wasUnicast;
+  };
+
+  struct PendingFrame {
+    std::vector<Ptr<Packet>> packets;
+    uint32_t size; // of the packets, without the container header
+    FwHopCountTag hopCount; // largest one of the packets
+    EventId flushEvent;
+  };
+
+  struct QueuedFrame {
+    Ptr<Packet> packet;
+    Address to;
+  };
+
+  struct ScheduledInterest {
+    Time expiry;
+    bool isRetransmission; // sent again before the previous one expired or was answered
+  };
+
+  struct ShapedInterest {
+    shared_ptr<const Interest> interest;
+    Time expiry;
+  };
+
+  struct Reassembler {
+    std::unique_ptr<nfd::ndnlp::PartialMessageStore> pms;
+    EventId expireEvent;
+  };
+
+  std::unique_ptr<nfd::ndnlp::Slicer> m_slicer; ///< \brief made on first use, when MTU is known
+  Time m_reassemblyTimeout;
+  std::map<Address, Reassembler> m_reassemblers; ///< \brief by link address of the sender
+  Ptr<const Packet> m_lastFragment; ///< \brief fragment being processed, for its packet tags
+  uint64_t m_nFragmentedPackets;
+  uint64_t m_nReassembledPackets;
+
+  struct DeferredPacket {
+    Ptr<Packet> packet;
+    Address to;
+    bool isInterest;
+    uint32_t nonce; // of Interest
+    EventId sendEvent;
+  };
+
+  Time m_maxDefer;
+  Ptr<UniformRandomVariable> m_deferRandom; ///< \brief made when deferring is enabled
+  std::unordered_map<Name, std::vector<DeferredPacket>> m_deferred; ///< \brief by name
+  uint64_t m_nDeferCancelled;
+
+  bool m_isAggregation;
+  Time m_holdTime;
+  std::map<Address, PendingFrame> m_pendingFrames; ///< \brief by link address
+  uint64_t m_nAggregatedFrames;
+  uint64_t m_nAggregatedPackets;
+
+  std::unique_ptr<nfd::TransmitScheduler<QueuedFrame>> m_transmitQueue;
+  uint32_t m_maxTransmitQueue;
+  DataRate m_transmitRate;
+  EventId m_transmitEvent; ///< \brief pending while the link transmits the last frame
+  uint64_t m_nTransmitQueueDrops;
+
+  bool m_isTransmitScheduling;
+  size_t m_flowPrefixLength;
+  std::unordered_map<Name, nfd::TransmitClass> m_transmitClasses; ///< \brief by name prefix
+  std::unordered_map<Name, size_t> m_flowWeights; ///< \brief by flow prefix
+  std::unordered_map<Name, ScheduledInterest> m_scheduledInterests; ///< \brief by Interest name
+
+  DataRate m_shapingRate; ///< \brief zero if Interests are not shaped
+  uint32_t m_maxShapedInterests;
+  uint32_t m_shapingBurst; ///< \brief in Data
+  double m_shapingTokens; ///< \brief in octets of Data
+  Time m_lastShapingRefill;
+  double m_averageDataSize; ///< \brief EWMA of received Data, in octets
+  std::deque<ShapedInterest> m_shapedInterests;
+  EventId m_shapingEvent; ///< \brief pending while Interests wait for tokens
+  std::vector<shared_ptr<const Interest>> m_refusedInterests; ///< \brief to be Nacked
+  EventId m_shapingNackEvent;
+  uint64_t m_nShapedInterests;
+  uint64_t m_nShapingNacks;
+  uint64_t m_nShapingExpired;
+
+  bool m_isNeighborUnicast;
+  Time m_neighborTimeout;
+  std::unordered_map<Name, Upstream> m_upstreams;       ///< \brief by Data name prefix
+  std::unordered_map<Name, Requester> m_requesters;     ///< \brief by Interest name
+  std::unordered_map<Name, SentInterest> m_sentInterests; ///< \brief by Interest name
+  uint64_t m_nUnicastSent;
+
+  std::unordered_map<Name, Address> m_nextHops; ///< \brief by Interest name prefix
+  bool m_isOtherHostInterestFilter;
+  uint64_t m_nFilteredInterests;
+
+  bool m_isOverhearing;
+  uint64_t m_nOverheardData;
+  uint64_t m_nPushedData;
+
+  bool m_isLinkDown;
+  uint64_t m_nLinkDownDrops;
+
+  uint64_t m_nDroppedNonNdn;
+  uint64_t m_nDroppedUnsolicitedData;
+  uint64_t m_nDroppedMalformed;
 };
 
 } // namespace ndn
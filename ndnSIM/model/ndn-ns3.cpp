@@ -22,13 +22,49 @@
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
+#include <ndn-cxx/lp/nack.hpp>
 
 #include "ndn-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
 
+#include "ns3/tag.h"
+
+#include <atomic>
+
 namespace ns3 {
 namespace ndn {
 
+/**
+ * @brief Packet of the same size and with the same packet tags, but without the bytes
+ *
+ * What remains of a frame after the NDN packet is the virtual payload (see setVirtualPayload),
+ * which the zero-filled area of a new packet stands for.  The buffer of the frame, whose NDN
+ * packet is already copied into the Block, is then no longer referenced by the decoded packet.
+ *
+ * @return the packet itself if one of its tags cannot be copied
+ */
+static Ptr<const Packet>
+withoutBytes(Ptr<const Packet> packet)
+{
+  Ptr<Packet> bare = Create<Packet>(packet->GetSize());
+
+  PacketTagIterator i = packet->GetPacketTagIterator();
+  while (i.HasNext()) {
+    PacketTagIterator::Item item = i.Next();
+    if (!item.GetTypeId().HasConstructor())
+      return packet;
+
+    Callback<ObjectBase*> constructor = item.GetTypeId().GetConstructor();
+    std::unique_ptr<Tag> tag(dynamic_cast<Tag*>(constructor()));
+    if (tag == nullptr)
+      return packet;
+    item.GetTag(*tag);
+    bare->AddPacketTag(*tag);
+  }
+
+  return bare;
+}
+
 template<class T>
 std::shared_ptr<const T>
 Convert::FromPacket(Ptr<Packet> packet)
@@ -37,7 +73,7 @@ Convert::FromPacket(Ptr<Packet> packet)
   packet->RemoveHeader(header);
 
   auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  pkt->setTag(make_shared<Ns3PacketTag>(withoutBytes(packet)));
 
   return pkt;
 }
@@ -48,9 +84,33 @@ Convert::FromPacket<Interest>(Ptr<Packet> packet);
 template std::shared_ptr<const Data>
 Convert::FromPacket<Data>(Ptr<Packet> packet);
 
+template std::shared_ptr<const lp::Nack>
+Convert::FromPacket<lp::Nack>(Ptr<Packet> packet);
+
+namespace {
+
+/// Data of the innermost FanOut of the thread, with its packet once built
+struct FanOutState
+{
+  const Data* data = nullptr;
+  Ptr<const Packet> packet;
+};
+
+std::atomic<uint64_t> g_nFanOutCopies{0};
+
+FanOutState&
+getFanOutState()
+{
+  // forwarders of different nodes may run on different threads
+  static thread_local FanOutState state;
+  return state;
+}
+
+} // namespace
+
 template<class T>
-Ptr<Packet>
-Convert::ToPacket(const T& pkt)
+static Ptr<Packet>
+buildPacket(const T& pkt)
 {
   PacketHeader<T> header(pkt);
 
@@ -68,11 +128,57 @@ Convert::ToPacket(const T& pkt)
   return packet;
 }
 
+template<class T>
+Ptr<Packet>
+Convert::ToPacket(const T& pkt)
+{
+  return buildPacket(pkt);
+}
+
+template<>
+Ptr<Packet>
+Convert::ToPacket<Data>(const Data& data)
+{
+  FanOutState& state = getFanOutState();
+  if (state.data != &data) {
+    return buildPacket(data);
+  }
+
+  if (state.packet == nullptr) {
+    // the faces change the tags of their copies only
+    state.packet = buildPacket(data);
+  }
+  else {
+    g_nFanOutCopies.fetch_add(1, std::memory_order_relaxed);
+  }
+  return state.packet->Copy();
+}
+
+Convert::FanOut::FanOut(const Data& data)
+  : m_previousData(getFanOutState().data)
+  , m_previousPacket(getFanOutState().packet)
+{
+  getFanOutState().data = &data;
+  getFanOutState().packet = nullptr;
+}
+
+Convert::FanOut::~FanOut()
+{
+  getFanOutState().data = m_previousData;
+  getFanOutState().packet = m_previousPacket;
+}
+
+uint64_t
+Convert::GetNFanOutCopies()
+{
+  return g_nFanOutCopies.load();
+}
+
 template Ptr<Packet>
 Convert::ToPacket<Interest>(const Interest& packet);
 
 template Ptr<Packet>
-Convert::ToPacket<Data>(const Data& packet);
+Convert::ToPacket<lp::Nack>(const lp::Nack& packet);
 
 uint32_t
 Convert::getPacketType(Ptr<const Packet> packet)
@@ -83,7 +189,8 @@ Convert::getPacketType(Ptr<const Packet> packet)
     throw ::ndn::tlv::Error("Unknown header");
   }
 
-  if (type == ::ndn::tlv::Interest || type == ::ndn::tlv::Data) {
+  // Nacks are the only LpPackets sent by the faces
+  if (type == ::ndn::tlv::Interest || type == ::ndn::tlv::Data || type == lp::tlv::LpPacket) {
     return type;
   }
   else {
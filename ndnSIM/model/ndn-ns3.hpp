@@ -20,6 +20,8 @@
 #ifndef NDN_NS3_HPP
 #define NDN_NS3_HPP
 
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include <memory>
@@ -29,6 +31,13 @@ namespace ndn {
 
 class Convert {
 public:
+  /**
+   * @brief Decode the NDN packet at the start of the ns-3 packet
+   *
+   * The decoded packet gets an Ns3PacketTag with the packet tags and the virtual payload of
+   * the ns-3 packet, but not its buffer, so a packet in a table or queue occupies the memory
+   * of its Block only.  With DataWireTable enabled, equal Data share the buffer of that Block.
+   */
   template<class T>
   static std::shared_ptr<const T>
   FromPacket(Ptr<Packet> packet);
@@ -37,10 +46,41 @@ public:
   static Ptr<Packet>
   ToPacket(const T& pkt);
 
+  /**
+   * @brief Build the packet of a Data once for all the faces it is sent on during the scope
+   *
+   * Data satisfying the Interests of several downstreams is sent on each of their faces.
+   * Within the scope, the first ToPacket of the Data builds its ns-3 packet, and the next ones
+   * return shallow copies of it (ns-3 packets are copy-on-write), so that each face only
+   * updates its own tags, e.g., the hop count.  Scopes can be nested.
+   */
+  class FanOut : noncopyable
+  {
+  public:
+    explicit
+    FanOut(const Data& data);
+
+    ~FanOut();
+
+  private:
+    const Data* m_previousData;
+    Ptr<const Packet> m_previousPacket;
+  };
+
+  /**
+   * @brief Number of Data packets that were copied from a FanOut instead of being built
+   */
+  static uint64_t
+  GetNFanOutCopies();
+
   static uint32_t
   getPacketType(Ptr<const Packet> packet);
 };
 
+template<>
+Ptr<Packet>
+Convert::ToPacket<Data>(const Data& data);
+
 } // namespace ndn
 } // namespace ns3
 
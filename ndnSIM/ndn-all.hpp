@@ -23,6 +23,12 @@
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-global-routing-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-binary-mobility-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-wireless-routing-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-failure-injection-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-checkpoint-helper.hpp"
+#include "ns3/ndnSIM/helper/ndn-scenario-description.hpp"
+#include "ns3/ndnSIM/helper/ndn-parameter-sweep.hpp"
 // #include "ns3/ndnSIM/helper/ndn-ip-faces-helper.hpp"
 // #include "ns3/ndnSIM/helper/ndn-link-control-helper.hpp"
 
@@ -30,9 +36,37 @@
 #include "ns3/ndnSIM/utils/topology/rocketfuel-map-reader.hpp"
 #include "ns3/ndnSIM/utils/topology/rocketfuel-weights-reader.hpp"
 #include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-aggregation-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-app-delay-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-app-packet-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-consumer-event-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-cs-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-trace-filter.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-l3-trace-hub.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-memory-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-packet-capture.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-rto-tracer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-strategy-tracer.hpp"
+#include "ns3/ndnSIM/utils/ndn-allocation-profiler.hpp"
+#include "ns3/ndnSIM/utils/ndn-correlated-workload.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-wire-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-event-profiler.hpp"
+#include "ns3/ndnSIM/utils/ndn-geo-region-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
+#include "ns3/ndnSIM/utils/ndn-metrics-exporter.hpp"
+#include "ns3/ndnSIM/utils/ndn-mobility-prefetcher.hpp"
+#include "ns3/ndnSIM/utils/ndn-mpi.hpp"
+#include "ns3/ndnSIM/utils/ndn-profiler-zones.hpp"
+#include "ns3/ndnSIM/utils/ndn-push-cache.hpp"
+#include "ns3/ndnSIM/utils/ndn-rtt-hint-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-shared-input.hpp"
+#include "ns3/ndnSIM/utils/ndn-spatial-grid.hpp"
+#include "ns3/ndnSIM/utils/ndn-steady-state-detector.hpp"
+#include "ns3/ndnSIM/utils/ndn-strategy-replay.hpp"
+#include "ns3/ndnSIM/utils/ndn-thread-confinement.hpp"
 
 // #include "ns3/ndnSIM/model/ndn-app-face.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
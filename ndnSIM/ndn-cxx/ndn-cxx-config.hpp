@@ -0,0 +1,7 @@
+#define NDN_CXX_HAVE_STD_TO_STRING 1
+#define NDN_CXX_HAVE_IS_NOTHROW_MOVE_CONSTRUCTIBLE 1
+#define NDN_CXX_HAVE_IS_NOTHROW_MOVE_ASSIGNABLE 1
+#define NDN_CXX_HAVE_IS_NOTHROW_COPY_CONSTRUCTIBLE 1
+#define NDN_CXX_HAVE_IS_NOTHROW_COPY_ASSIGNABLE 1
+#define NDN_CXX_HAVE_IS_MOVE_CONSTRUCTIBLE 1
+#define NDN_CXX_WITH_BUFFER_POOL 1
@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "compact-name.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <limits>
+
+namespace ndn {
+
+CompactName::CompactName()
+{
+}
+
+CompactName::CompactName(const Name& name)
+{
+  for (const name::Component& component : name) {
+    append(component);
+  }
+}
+
+CompactName::CompactName(const Block& wire)
+{
+  wireDecode(wire);
+}
+
+CompactName::CompactName(const char* uri)
+  : CompactName(Name(uri))
+{
+}
+
+void
+CompactName::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::Name)
+    BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding Name"));
+
+  clear();
+
+  // walk the components directly, without parsing the block into sub-blocks
+  const uint8_t* begin = wire.value();
+  const uint8_t* end = begin + wire.value_size();
+  while (begin != end) {
+    uint32_t type = tlv::readType(begin, end);
+    uint64_t length = tlv::readVarNumber(begin, end);
+    if (length > static_cast<uint64_t>(end - begin))
+      BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
+    if (type != tlv::NameComponent && type != tlv::ImplicitSha256DigestComponent)
+      BOOST_THROW_EXCEPTION(Error("Cannot construct name::Component from not a NameComponent "
+                                  "or ImplicitSha256DigestComponent TLV wire block"));
+
+    append(type, begin, length);
+    begin += length;
+  }
+
+  m_wire = make_shared<Block>(wire);
+}
+
+const Block&
+CompactName::wireEncode() const
+{
+  if (m_wire != nullptr)
+    return *m_wire;
+
+  shared_ptr<Buffer> buffer = makeBuffer(tlv::sizeOfVarNumber(tlv::Name) +
+                                                  tlv::sizeOfVarNumber(m_bytes.size()) +
+                                                  m_bytes.size());
+  uint8_t* out = buffer->buf();
+  out[0] = static_cast<uint8_t>(tlv::Name);
+  ++out;
+  if (m_bytes.size() < 253) {
+    *out++ = static_cast<uint8_t>(m_bytes.size());
+  }
+  else if (m_bytes.size() <= std::numeric_limits<uint16_t>::max()) {
+    *out++ = 253;
+    *out++ = static_cast<uint8_t>(m_bytes.size() >> 8);
+    *out++ = static_cast<uint8_t>(m_bytes.size());
+  }
+  else {
+    *out++ = 254;
+    for (int shift = 24; shift >= 0; shift -= 8)
+      *out++ = static_cast<uint8_t>(m_bytes.size() >> shift);
+  }
+  std::memcpy(out, m_bytes.data(), m_bytes.size());
+
+  m_wire = make_shared<Block>(buffer);
+  return *m_wire;
+}
+
+Name
+CompactName::toName() const
+{
+  return Name(wireEncode());
+}
+
+void
+CompactName::appendVarNumber(uint64_t number)
+{
+  // same as tlv::writeVarNumber
+  uint8_t buffer[9];
+  size_t length = 0;
+  if (number < 253) {
+    buffer[length++] = static_cast<uint8_t>(number);
+  }
+  else {
+    int nBytes = number <= std::numeric_limits<uint16_t>::max() ? 2 :
+                 (number <= std::numeric_limits<uint32_t>::max() ? 4 : 8);
+    buffer[length++] = nBytes == 2 ? 253 : (nBytes == 4 ? 254 : 255);
+    for (int shift = 8 * (nBytes - 1); shift >= 0; shift -= 8)
+      buffer[length++] = static_cast<uint8_t>(number >> shift);
+  }
+  m_bytes.append(buffer, length);
+}
+
+CompactName&
+CompactName::append(uint32_t type, const uint8_t* value, size_t valueSize)
+{
+  m_offsets.push_back(static_cast<uint32_t>(m_bytes.size()));
+  appendVarNumber(type);
+  appendVarNumber(valueSize);
+  m_bytes.append(value, valueSize);
+  m_wire.reset();
+  return *this;
+}
+
+CompactName&
+CompactName::append(const CompactName& name)
+{
+  if (&name == this)
+    return append(CompactName(name));
+
+  uint32_t base = static_cast<uint32_t>(m_bytes.size());
+  for (size_t i = 0; i < name.size(); ++i)
+    m_offsets.push_back(base + name.m_offsets[i]);
+  m_bytes.append(name.m_bytes.data(), name.m_bytes.size());
+  m_wire.reset();
+  return *this;
+}
+
+CompactName&
+CompactName::appendNumber(uint64_t number)
+{
+  // nonNegativeInteger, same as Component::fromNumber
+  uint8_t value[8];
+  size_t length = number <= std::numeric_limits<uint8_t>::max() ? 1 :
+                  (number <= std::numeric_limits<uint16_t>::max() ? 2 :
+                   (number <= std::numeric_limits<uint32_t>::max() ? 4 : 8));
+  for (size_t i = length; i > 0; --i) {
+    value[i - 1] = static_cast<uint8_t>(number);
+    number >>= 8;
+  }
+  return append(tlv::NameComponent, value, length);
+}
+
+CompactName&
+CompactName::appendNumberWithMarker(uint8_t marker, uint64_t number)
+{
+  uint8_t value[9];
+  value[0] = marker;
+  size_t length = number <= std::numeric_limits<uint8_t>::max() ? 1 :
+                  (number <= std::numeric_limits<uint16_t>::max() ? 2 :
+                   (number <= std::numeric_limits<uint32_t>::max() ? 4 : 8));
+  for (size_t i = length; i > 0; --i) {
+    value[i] = static_cast<uint8_t>(number);
+    number >>= 8;
+  }
+  return append(tlv::NameComponent, value, length + 1);
+}
+
+void
+CompactName::clear()
+{
+  m_bytes.clear();
+  m_offsets.clear();
+  m_wire.reset();
+}
+
+void
+CompactName::parseComponent(size_t i, uint32_t& type,
+                            const uint8_t*& value, size_t& valueSize) const
+{
+  const uint8_t* begin = m_bytes.data() + m_offsets[i];
+  const uint8_t* end = m_bytes.data() + componentEnd(i);
+  type = tlv::readType(begin, end);
+  valueSize = static_cast<size_t>(tlv::readVarNumber(begin, end));
+  value = begin;
+}
+
+name::Component
+CompactName::get(ssize_t i) const
+{
+  if (i < 0)
+    i += size();
+  if (i < 0 || static_cast<size_t>(i) >= size())
+    BOOST_THROW_EXCEPTION(Error("Requested component does not exist (out of bounds)"));
+
+  const uint8_t* begin = m_bytes.data() + m_offsets[i];
+  return name::Component(Block(begin, componentEnd(i) - m_offsets[i]));
+}
+
+CompactName
+CompactName::getPrefix(ssize_t nComponents) const
+{
+  if (nComponents < 0)
+    nComponents += size();
+  nComponents = std::max<ssize_t>(0, std::min<ssize_t>(nComponents, size()));
+
+  CompactName prefix;
+  if (nComponents > 0) {
+    prefix.m_offsets.assign(m_offsets.data(), nComponents);
+    prefix.m_bytes.assign(m_bytes.data(), componentEnd(nComponents - 1));
+  }
+  return prefix;
+}
+
+bool
+CompactName::isPrefixOf(const CompactName& other) const
+{
+  if (size() > other.size())
+    return false;
+  if (empty())
+    return true;
+
+  // equal components have equal encodings, so the prefix is a byte prefix ending at a boundary
+  return other.componentEnd(size() - 1) == m_bytes.size() &&
+         std::memcmp(m_bytes.data(), other.m_bytes.data(), m_bytes.size()) == 0;
+}
+
+int
+CompactName::compare(const CompactName& other) const
+{
+  size_t count = std::min(size(), other.size());
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t type1 = 0, type2 = 0;
+    const uint8_t* value1 = nullptr;
+    const uint8_t* value2 = nullptr;
+    size_t size1 = 0, size2 = 0;
+    parseComponent(i, type1, value1, size1);
+    other.parseComponent(i, type2, value2, size2);
+
+    // same order as name::Component::compare
+    if (type1 != type2)
+      return type1 < type2 ? -1 : 1;
+    if (size1 != size2)
+      return size1 < size2 ? -1 : 1;
+    if (size1 > 0) {
+      int comp = std::memcmp(value1, value2, size1);
+      if (comp != 0)
+        return comp;
+    }
+  }
+
+  if (size() == other.size())
+    return 0;
+  return size() < other.size() ? -1 : 1;
+}
+
+size_t
+CompactName::getMemoryUsage() const
+{
+  size_t n = sizeof(CompactName);
+  if (!m_bytes.isInline())
+    n += m_bytes.capacity();
+  if (!m_offsets.isInline())
+    n += m_offsets.capacity() * sizeof(uint32_t);
+  if (m_wire != nullptr)
+    n += sizeof(Block) + m_wire->size() + 4 * sizeof(void*); // block, buffer and control blocks
+  return n;
+}
+
+size_t
+CompactName::hash() const
+{
+  return boost::hash_range(m_bytes.data(), m_bytes.data() + m_bytes.size());
+}
+
+std::ostream&
+operator<<(std::ostream& os, const CompactName& name)
+{
+  return os << name.toName();
+}
+
+} // namespace ndn
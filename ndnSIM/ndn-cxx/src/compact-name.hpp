@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_COMPACT_NAME_HPP
+#define NDN_COMPACT_NAME_HPP
+
+#include "name.hpp"
+#include "detail/small-vector.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Compact representation of a Name
+ *
+ * A Name holds a Block per component, each with its own buffer reference and iterators.
+ * CompactName instead keeps the TLV encodings of all components in a single byte buffer and
+ * the start offset of each component in a table.  Both are stored inline for short names
+ * (up to INLINE_BYTES bytes of components and INLINE_COMPONENTS components), so building such
+ * a name does not allocate.
+ *
+ * Conversion to Name and to the Name TLV block is lazy: wireEncode() builds the block on
+ * the first call and caches it until the name is modified.
+ *
+ * Components are compared in the canonical order, as Name::compare does.
+ */
+class CompactName
+{
+public:
+  typedef Name::Error Error;
+
+  static const size_t INLINE_BYTES = 64;
+  static const size_t INLINE_COMPONENTS = 8;
+
+  CompactName();
+
+  explicit
+  CompactName(const Name& name);
+
+  /**
+   * @brief Decode from the wire encoding of a Name
+   */
+  explicit
+  CompactName(const Block& wire);
+
+  /**
+   * @brief Parse from URI
+   */
+  explicit
+  CompactName(const char* uri);
+
+  void
+  wireDecode(const Block& wire);
+
+  /**
+   * @brief Get Name TLV block, encoded on first use after a modification
+   */
+  const Block&
+  wireEncode() const;
+
+  /**
+   * @brief Create a Name with the same components
+   */
+  Name
+  toName() const;
+
+  std::string
+  toUri() const
+  {
+    return toName().toUri();
+  }
+
+public: // modifiers
+  /**
+   * @brief Append a component with the specified TLV type and value
+   */
+  CompactName&
+  append(uint32_t type, const uint8_t* value, size_t valueSize);
+
+  CompactName&
+  append(const name::Component& component)
+  {
+    return append(component.type(), component.value(), component.value_size());
+  }
+
+  CompactName&
+  append(const CompactName& name);
+
+  void
+  push_back(const name::Component& component)
+  {
+    append(component);
+  }
+
+  CompactName&
+  appendNumber(uint64_t number);
+
+  CompactName&
+  appendNumberWithMarker(uint8_t marker, uint64_t number);
+
+  CompactName&
+  appendSegment(uint64_t segmentNo)
+  {
+    return appendNumberWithMarker(name::SEGMENT_MARKER, segmentNo);
+  }
+
+  CompactName&
+  appendSequenceNumber(uint64_t seqNo)
+  {
+    return appendNumberWithMarker(name::SEQUENCE_NUMBER_MARKER, seqNo);
+  }
+
+  void
+  clear();
+
+public: // access
+  size_t
+  size() const
+  {
+    return m_offsets.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_offsets.empty();
+  }
+
+  /**
+   * @brief Get a copy of the i-th component, negative i counts from the end
+   * @throw Error i is out of range
+   */
+  name::Component
+  get(ssize_t i) const;
+
+  /**
+   * @brief Get the first n components, negative n drops components from the end
+   */
+  CompactName
+  getPrefix(ssize_t nComponents) const;
+
+  bool
+  isPrefixOf(const CompactName& other) const;
+
+  /**
+   * @brief Compare with the other name in the canonical order
+   * @return negative, zero or positive, as Name::compare
+   */
+  int
+  compare(const CompactName& other) const;
+
+  /**
+   * @brief Approximate number of bytes used by the name, including the cached block
+   */
+  size_t
+  getMemoryUsage() const;
+
+  /**
+   * @brief Hash of the TLV encodings of the components
+   */
+  size_t
+  hash() const;
+
+public: // comparison operators
+  bool
+  operator==(const CompactName& other) const
+  {
+    return m_bytes.size() == other.m_bytes.size() && size() == other.size() &&
+           std::memcmp(m_bytes.data(), other.m_bytes.data(), m_bytes.size()) == 0;
+  }
+
+  bool
+  operator!=(const CompactName& other) const
+  {
+    return !(*this == other);
+  }
+
+  bool
+  operator<(const CompactName& other) const
+  {
+    return compare(other) < 0;
+  }
+
+  bool
+  operator<=(const CompactName& other) const
+  {
+    return compare(other) <= 0;
+  }
+
+  bool
+  operator>(const CompactName& other) const
+  {
+    return compare(other) > 0;
+  }
+
+  bool
+  operator>=(const CompactName& other) const
+  {
+    return compare(other) >= 0;
+  }
+
+private:
+  void
+  appendVarNumber(uint64_t number);
+
+  /**
+   * @brief Get type and value of the i-th component
+   */
+  void
+  parseComponent(size_t i, uint32_t& type, const uint8_t*& value, size_t& valueSize) const;
+
+  size_t
+  componentEnd(size_t i) const
+  {
+    return i + 1 < m_offsets.size() ? m_offsets[i + 1] : m_bytes.size();
+  }
+
+private:
+  SmallVector<uint8_t, INLINE_BYTES> m_bytes;        ///< TLV encodings of the components
+  SmallVector<uint32_t, INLINE_COMPONENTS> m_offsets; ///< start of each component in m_bytes
+  mutable shared_ptr<Block> m_wire;                   ///< cached Name TLV, reset on modification
+};
+
+std::ostream&
+operator<<(std::ostream& os, const CompactName& name);
+
+} // namespace ndn
+
+namespace std {
+template<>
+struct hash<ndn::CompactName>
+{
+  size_t
+  operator()(const ndn::CompactName& name) const
+  {
+    return name.hash();
+  }
+};
+
+} // namespace std
+
+#endif // NDN_COMPACT_NAME_HPP
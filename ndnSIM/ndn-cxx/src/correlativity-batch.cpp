@@ -0,0 +1,350 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "correlativity-batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace ndn {
+
+const InternedStructuredName::Handle InternedStructuredName::NONE;
+const size_t CorrelativityBatch::MAX_BATCHED_COMPONENTS;
+const uint32_t CorrelativityBatch::Segments::NO_SEGMENT;
+
+/// samples compared at once, the columns are padded to a multiple of it
+static const size_t LANES = 8;
+
+InternedStructuredName::InternedStructuredName()
+  : m_spatialSize(0)
+  , m_hasSpatialPart(false)
+  , m_hasApplicationPart(false)
+{
+}
+
+InternedStructuredName::InternedStructuredName(const StructuredNameView& view,
+                                               name::Dictionary& dictionary,
+                                               bool isLastComponentUnique)
+{
+  Name::const_iterator last = view.hasApplicationPart() ? view.getName().end() - 1
+                                                        : Name::const_iterator();
+  assign(view, [&] (Name::const_iterator component) {
+      if (isLastComponentUnique && component == last)
+        return NONE;
+      return dictionary.intern(*component);
+    });
+}
+
+InternedStructuredName
+InternedStructuredName::lookup(const StructuredNameView& view, const name::Dictionary& dictionary)
+{
+  InternedStructuredName name;
+  name.assign(view, [&] (Name::const_iterator component) {
+      Handle handle = NONE;
+      if (!dictionary.find(*component, handle))
+        return NONE;
+      return handle;
+    });
+  return name;
+}
+
+template<typename Get>
+void
+InternedStructuredName::assign(const StructuredNameView& view, const Get& get)
+{
+  m_handles.clear();
+  m_hasSpatialPart = view.hasSpatialPart();
+  m_hasApplicationPart = view.hasApplicationPart();
+
+  if (m_hasSpatialPart) {
+    for (Name::const_iterator i = view.spatialBegin(); i != view.spatialEnd(); ++i)
+      m_handles.push_back(get(i));
+  }
+  m_spatialSize = m_handles.size();
+
+  if (m_hasApplicationPart) {
+    for (Name::const_iterator i = view.applicationBegin(); i != view.applicationEnd(); ++i)
+      m_handles.push_back(get(i));
+  }
+}
+
+namespace {
+
+/** \brief Sum of the position weights of Name::correlativity, fed with the pairs of equal
+ *         components in row-major order
+ */
+class PositionWeights
+{
+public:
+  PositionWeights()
+    : m_lcs(0.0)
+    , m_hasCommon(false)
+    , m_lastA(0)
+    , m_lastB(0)
+    , m_lastC(0)
+  {
+  }
+
+  /** \param posA 1-based position in the first range
+   *  \param posB 1-based position in the second range
+   */
+  void
+  add(size_t posA, size_t posB)
+  {
+    size_t posC = 0;
+    if (!m_hasCommon) {
+      posC = std::max(posA, posB);
+      m_hasCommon = true;
+    }
+    else {
+      ptrdiff_t diffA = static_cast<ptrdiff_t>(posA) - static_cast<ptrdiff_t>(m_lastA);
+      ptrdiff_t diffB = static_cast<ptrdiff_t>(posB) - static_cast<ptrdiff_t>(m_lastB);
+      posC = m_lastC + static_cast<size_t>(std::max(diffA, diffB));
+    }
+
+    m_lcs += pow2(posC);
+    m_lastA = posA;
+    m_lastB = posB;
+    m_lastC = posC;
+  }
+
+  double
+  getCorrelativity(size_t size1, size_t size2) const
+  {
+    if (!m_hasCommon)
+      return 0.0;
+
+    size_t commonLength = m_lastC + std::max(size1 - m_lastA, size2 - m_lastB);
+    return m_lcs / prefixSum(commonLength);
+  }
+
+private:
+  /** \return 2^-k
+   */
+  static double
+  pow2(size_t k)
+  {
+    static const std::vector<double> table = [] {
+      std::vector<double> values(64);
+      for (size_t i = 0; i < values.size(); ++i)
+        values[i] = std::ldexp(1.0, -static_cast<int>(i));
+      return values;
+    }();
+    return k < table.size() ? table[k] : std::ldexp(1.0, -static_cast<int>(k));
+  }
+
+  /** \return 2^-1 + ... + 2^-k
+   */
+  static double
+  prefixSum(size_t k)
+  {
+    return 1.0 - pow2(k);
+  }
+
+private:
+  double m_lcs;
+  bool m_hasCommon;
+  size_t m_lastA;
+  size_t m_lastB;
+  size_t m_lastC;
+};
+
+/** \brief Set @p bit in the masks of the samples whose handle in @p column is @p handle
+ *  \param n number of samples, a multiple of LANES
+ */
+void
+markEqual(const InternedStructuredName::Handle* column, InternedStructuredName::Handle handle,
+          uint32_t bit, uint32_t* masks, size_t n)
+{
+#if defined(__AVX2__)
+  const __m256i value = _mm256_set1_epi32(static_cast<int>(handle));
+  const __m256i bits = _mm256_set1_epi32(static_cast<int>(bit));
+  for (size_t k = 0; k < n; k += 8) {
+    __m256i handles = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + k));
+    __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + k));
+    mask = _mm256_or_si256(mask, _mm256_and_si256(_mm256_cmpeq_epi32(handles, value), bits));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(masks + k), mask);
+  }
+#elif defined(__SSE2__)
+  const __m128i value = _mm_set1_epi32(static_cast<int>(handle));
+  const __m128i bits = _mm_set1_epi32(static_cast<int>(bit));
+  for (size_t k = 0; k < n; k += 4) {
+    __m128i handles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + k));
+    __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + k));
+    mask = _mm_or_si128(mask, _mm_and_si128(_mm_cmpeq_epi32(handles, value), bits));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(masks + k), mask);
+  }
+#else
+  for (size_t k = 0; k < n; ++k) {
+    masks[k] |= column[k] == handle ? bit : 0;
+  }
+#endif
+}
+
+} // unnamed namespace
+
+double
+CorrelativityBatch::correlativity(const Handle* first1, size_t size1,
+                                  const Handle* first2, size_t size2)
+{
+  if (size1 == 0 || size2 == 0)
+    return 0.0;
+
+  PositionWeights weights;
+  for (size_t i = 0; i < size1; ++i) {
+    if (first1[i] == InternedStructuredName::NONE)
+      continue;
+    for (size_t j = 0; j < size2; ++j) {
+      if (first1[i] == first2[j])
+        weights.add(i + 1, j + 1);
+    }
+  }
+  return weights.getCorrelativity(size1, size2);
+}
+
+void
+CorrelativityBatch::Segments::grow(size_t nPadded)
+{
+  m_sizes.resize(std::max(m_sizes.size(), nPadded), NO_SEGMENT);
+  for (std::vector<Handle>& column : m_columns) {
+    column.resize(std::max(column.size(), nPadded), InternedStructuredName::NONE);
+  }
+}
+
+void
+CorrelativityBatch::Segments::set(size_t sample, bool hasSegment, const Handle* handles,
+                                  size_t size)
+{
+  if (!hasSegment) {
+    m_sizes[sample] = NO_SEGMENT;
+    size = 0;
+  }
+  else if (size > MAX_BATCHED_COMPONENTS) {
+    m_sizes[sample] = size;
+    m_long.emplace_back(sample, std::vector<Handle>(handles, handles + size));
+    size = 0;
+  }
+  else {
+    m_sizes[sample] = size;
+    while (m_columns.size() < size) {
+      m_columns.emplace_back(m_sizes.size(), InternedStructuredName::NONE);
+    }
+    m_nColumns = std::max(m_nColumns, size);
+  }
+
+  // positions of previous samples of the column are overwritten
+  for (size_t j = 0; j < m_columns.size(); ++j) {
+    m_columns[j][sample] = j < size ? handles[j] : InternedStructuredName::NONE;
+  }
+}
+
+void
+CorrelativityBatch::Segments::clear()
+{
+  m_long.clear();
+  m_nColumns = 0;
+}
+
+void
+CorrelativityBatch::Segments::score(bool hasQuery, const Handle* query, size_t querySize,
+                                    size_t nSamples, double* out)
+{
+  std::fill(out, out + nSamples, 0.0);
+  if (!hasQuery || querySize == 0 || nSamples == 0)
+    return;
+
+  // the padding lanes hold handles of earlier batches, their masks are ignored
+  size_t nPadded = (nSamples + LANES - 1) / LANES * LANES;
+  m_masks.assign(querySize * nPadded, 0);
+  for (size_t i = 0; i < querySize; ++i) {
+    if (query[i] == InternedStructuredName::NONE)
+      continue;
+    for (size_t j = 0; j < m_nColumns; ++j) {
+      markEqual(m_columns[j].data(), query[i], 1u << j, &m_masks[i * nPadded], nPadded);
+    }
+  }
+
+  for (size_t k = 0; k < nSamples; ++k) {
+    uint32_t size = m_sizes[k];
+    if (size == NO_SEGMENT || size == 0 || size > MAX_BATCHED_COMPONENTS)
+      continue;
+
+    PositionWeights weights;
+    for (size_t i = 0; i < querySize; ++i) {
+      for (uint32_t bits = m_masks[i * nPadded + k]; bits != 0; bits &= bits - 1) {
+        size_t j = __builtin_ctz(bits);
+        weights.add(i + 1, j + 1);
+      }
+    }
+    out[k] = weights.getCorrelativity(querySize, size);
+  }
+
+  for (const auto& sample : m_long) {
+    out[sample.first] = correlativity(query, querySize, sample.second.data(), sample.second.size());
+  }
+}
+
+CorrelativityBatch::CorrelativityBatch()
+  : m_size(0)
+  , m_capacity(0)
+{
+}
+
+void
+CorrelativityBatch::add(const InternedStructuredName& sample)
+{
+  if (m_size == m_capacity) {
+    m_capacity += LANES;
+    m_spatial.grow(m_capacity);
+    m_application.grow(m_capacity);
+  }
+
+  m_spatial.set(m_size, sample.hasSpatialPart(), sample.spatialBegin(), sample.spatialSize());
+  m_application.set(m_size, sample.hasApplicationPart(), sample.applicationBegin(),
+                    sample.applicationSize());
+  ++m_size;
+}
+
+void
+CorrelativityBatch::clear()
+{
+  m_size = 0;
+  m_spatial.clear();
+  m_application.clear();
+}
+
+void
+CorrelativityBatch::score(const InternedStructuredName& query,
+                          std::vector<double>& spatial, std::vector<double>& application)
+{
+  spatial.resize(m_size);
+  application.resize(m_size);
+  m_spatial.score(query.hasSpatialPart(), query.spatialBegin(), query.spatialSize(),
+                  m_size, spatial.data());
+  m_application.score(query.hasApplicationPart(), query.applicationBegin(),
+                      query.applicationSize(), m_size, application.data());
+}
+
+} // namespace ndn
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CORRELATIVITY_BATCH_HPP
+#define NDN_CORRELATIVITY_BATCH_HPP
+
+#include "name-dictionary.hpp"
+#include "structured-name-view.hpp"
+
+#include <limits>
+
+namespace ndn {
+
+/**
+ * @brief Spatial and application segments of a structured name (see StructuredNameView) as
+ *        handles of a name::Dictionary
+ */
+class InternedStructuredName
+{
+public:
+  typedef name::Dictionary::Handle Handle;
+
+  /**
+   * @brief Handle of a component equal to no other component, not even to another NONE
+   */
+  static const Handle NONE = std::numeric_limits<Handle>::max();
+
+  /**
+   * @brief Create a name without spatial and application segments
+   */
+  InternedStructuredName();
+
+  /**
+   * @brief Intern the components of the segments
+   * @param isLastComponentUnique the last component of the name is known to differ from all
+   *        other components (e.g., a sequence number), it is not interned but set to NONE
+   */
+  InternedStructuredName(const StructuredNameView& view, name::Dictionary& dictionary,
+                         bool isLastComponentUnique = false);
+
+  /**
+   * @brief Get the handles of the components of the segments without adding components to
+   *        the dictionary, components not in the dictionary are NONE
+   */
+  static InternedStructuredName
+  lookup(const StructuredNameView& view, const name::Dictionary& dictionary);
+
+  bool
+  hasSpatialPart() const
+  {
+    return m_hasSpatialPart;
+  }
+
+  bool
+  hasApplicationPart() const
+  {
+    return m_hasApplicationPart;
+  }
+
+  const Handle*
+  spatialBegin() const
+  {
+    return m_handles.data();
+  }
+
+  size_t
+  spatialSize() const
+  {
+    return m_spatialSize;
+  }
+
+  const Handle*
+  applicationBegin() const
+  {
+    return m_handles.data() + m_spatialSize;
+  }
+
+  size_t
+  applicationSize() const
+  {
+    return m_handles.size() - m_spatialSize;
+  }
+
+  /**
+   * @brief Approximate number of bytes used by this name, excluding the dictionary
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return sizeof(InternedStructuredName) + m_handles.capacity() * sizeof(Handle);
+  }
+
+private:
+  template<typename Get>
+  void
+  assign(const StructuredNameView& view, const Get& get);
+
+private:
+  std::vector<Handle> m_handles; ///< spatial segment, then application segment
+  size_t m_spatialSize;
+  bool m_hasSpatialPart;
+  bool m_hasApplicationPart;
+};
+
+/**
+ * @brief Scores one structured name against many samples in one call
+ *
+ * Gives the same spatial and application correlativity as StructuredNameView, computed on
+ * handles of components instead of components.  Samples are stored position by position: the
+ * handles of the j-th component of the segments of all samples are contiguous.  For every
+ * component of the queried name, one pass over each position compares the component with 8
+ * samples at a time (SSE2 or AVX2 when available) and records the equal positions in a
+ * bitmask per sample.  The position weights of Name::correlativity are then summed over the
+ * set bits of the masks, and samples without any equal component cost nothing more.
+ *
+ * Segments longer than MAX_BATCHED_COMPONENTS components are scored one by one.
+ *
+ * Example:
+ *
+ *     CorrelativityBatch batch;
+ *     for (const InternedStructuredName& sample : samples)
+ *       batch.add(sample);
+ *     batch.score(InternedStructuredName::lookup(StructuredNameView(name), dictionary),
+ *                 spatial, application);
+ */
+class CorrelativityBatch : noncopyable
+{
+public:
+  typedef InternedStructuredName::Handle Handle;
+
+  static const size_t MAX_BATCHED_COMPONENTS = 32;
+
+  CorrelativityBatch();
+
+  /**
+   * @brief Add a sample, whose index is the number of samples added before
+   */
+  void
+  add(const InternedStructuredName& sample);
+
+  /**
+   * @brief Remove all samples, keeping the memory for the next ones
+   */
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Compute the correlativity of @p query with every sample
+   * @param query name interned in the dictionary of the samples
+   * @param[out] spatial spatial correlativity by sample index
+   * @param[out] application application correlativity by sample index
+   */
+  void
+  score(const InternedStructuredName& query,
+        std::vector<double>& spatial, std::vector<double>& application);
+
+  /**
+   * @brief Name::correlativity of two ranges of handles
+   */
+  static double
+  correlativity(const Handle* first1, size_t size1, const Handle* first2, size_t size2);
+
+private:
+  /**
+   * @brief One kind of segment of all samples
+   */
+  class Segments
+  {
+  public:
+    void
+    grow(size_t nPadded);
+
+    void
+    set(size_t sample, bool hasSegment, const Handle* handles, size_t size);
+
+    void
+    clear();
+
+    void
+    score(bool hasQuery, const Handle* query, size_t querySize, size_t nSamples, double* out);
+
+  private:
+    static const uint32_t NO_SEGMENT = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> m_sizes; ///< by sample, NO_SEGMENT if the sample has no segment
+    std::vector<std::vector<Handle>> m_columns; ///< by position, then by sample
+    size_t m_nColumns = 0; ///< longest batched segment of the samples
+    std::vector<std::pair<size_t, std::vector<Handle>>> m_long; ///< samples not batched
+    std::vector<uint32_t> m_masks; ///< by component of the query, then by sample
+  };
+
+private:
+  size_t m_size;
+  size_t m_capacity; ///< samples the columns have room for, a multiple of the number of lanes
+  Segments m_spatial;
+  Segments m_application;
+};
+
+} // namespace ndn
+
+#endif // NDN_CORRELATIVITY_BATCH_HPP
@@ -21,8 +21,11 @@
 
 #include "data.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/encoding-arena.hpp"
 #include "util/crypto.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-allocation-profiler.hpp"
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Data>));
@@ -34,15 +37,21 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 
 Data::Data()
   : m_content(tlv::Content) // empty content
+  , m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
 }
 
 Data::Data(const Name& name)
   : m_name(name)
+  , m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_isMetaInfoPending(false)
+  , m_isSignaturePending(false)
 {
   wireDecode(wire);
 }
@@ -61,7 +70,8 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
 
   // (reverse encoding)
 
-  if (!unsignedPortion && !m_signature)
+  const Signature& signature = getSignature();
+  if (!unsignedPortion && !signature)
     {
       BOOST_THROW_EXCEPTION(Error("Requested wire format, but data packet has not been signed yet"));
     }
@@ -69,11 +79,11 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
   if (!unsignedPortion)
     {
       // SignatureValue
-      totalLength += encoder.prependBlock(m_signature.getValue());
+      totalLength += encoder.prependBlock(signature.getValue());
     }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   // Content
   totalLength += encoder.prependBlock(getContent());
@@ -121,19 +131,23 @@ Data::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  NDN_ALLOCATION_SCOPE(ENCODING);
 
-  EncodingBuffer buffer(estimatedSize, 0);
+  // single pass into the arena, then a copy: Data may be cached for long, and would keep the
+  // whole chunk alive
+  EncodingArena& arena = EncodingArena::get();
+  arena.reserve();
+  EncodingBuffer buffer(arena.getChunk(), arena.getFreeSize());
   wireEncode(buffer);
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
+  const_cast<Data*>(this)->wireDecode(arena.detach(buffer));
   return m_wire;
 }
 
 void
 Data::wireDecode(const Block& wire)
 {
+  NDN_ALLOCATION_SCOPE(ENCODING);
   m_fullName.clear();
   m_wire = wire;
   m_wire.parse();
@@ -147,16 +161,28 @@ Data::wireDecode(const Block& wire)
   // Name
   m_name.wireDecode(m_wire.get(tlv::Name));
 
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  // MetaInfo, decoded on first use
+  m_wire.get(tlv::MetaInfo);
+  m_isMetaInfoPending = true;
 
   // Content
   m_content = m_wire.get(tlv::Content);
 
-  ///////////////
-  // Signature //
-  ///////////////
+  // Signature, decoded on first use
+  m_wire.get(tlv::SignatureInfo);
+  m_isSignaturePending = true;
+}
 
+void
+Data::decodeMetaInfo() const
+{
+  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  m_isMetaInfoPending = false;
+}
+
+void
+Data::decodeSignature() const
+{
   // SignatureInfo
   m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
 
@@ -164,6 +190,8 @@ Data::wireDecode(const Block& wire)
   Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
   if (val != m_wire.elements_end())
     m_signature.setValue(*val);
+
+  m_isSignaturePending = false;
 }
 
 Data&
@@ -317,6 +345,12 @@ Data::onChanged()
   // !!!Note!!! Signature is not invalidated and it is responsibility of
   // the application to do proper re-signing if necessary
 
+  // the fields not decoded yet are lost with the wire
+  if (m_isMetaInfoPending)
+    decodeMetaInfo();
+  if (m_isSignaturePending)
+    decodeSignature();
+
   m_wire.reset();
   m_fullName.clear();
 }
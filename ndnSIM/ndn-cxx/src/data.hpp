@@ -131,6 +131,13 @@ public:
 
   /**
    * @brief Decode from the wire format
+   *
+   * Only the name and the content are decoded right away.  MetaInfo and Signature are
+   * decoded from the wire on the first call of their accessors (or of any modifier), so
+   * forwarders that look only at the name and the content do not pay for them.  Errors in
+   * their encoding are therefore reported by the accessors.
+   *
+   * @throw Error the wire is not a Data packet or lacks MetaInfo or SignatureInfo
    */
   void
   wireDecode(const Block& wire);
@@ -317,11 +324,23 @@ protected:
   void
   onChanged();
 
+private:
+  /**
+   * @brief Decode the fields whose decoding wireDecode deferred
+   */
+  void
+  decodeMetaInfo() const;
+
+  void
+  decodeSignature() const;
+
 private:
   Name m_name;
-  MetaInfo m_metaInfo;
+  mutable MetaInfo m_metaInfo;
   mutable Block m_content;
-  Signature m_signature;
+  mutable Signature m_signature;
+  mutable bool m_isMetaInfoPending;  ///< @brief m_metaInfo is yet to be decoded from m_wire
+  mutable bool m_isSignaturePending; ///< @brief m_signature is yet to be decoded from m_wire
 
   mutable Block m_wire;
   mutable Name m_fullName;
@@ -348,30 +367,34 @@ Data::getName() const
 inline const MetaInfo&
 Data::getMetaInfo() const
 {
+  if (m_isMetaInfoPending)
+    decodeMetaInfo();
   return m_metaInfo;
 }
 
 inline uint32_t
 Data::getContentType() const
 {
-  return m_metaInfo.getType();
+  return getMetaInfo().getType();
 }
 
 inline const time::milliseconds&
 Data::getFreshnessPeriod() const
 {
-  return m_metaInfo.getFreshnessPeriod();
+  return getMetaInfo().getFreshnessPeriod();
 }
 
 inline const name::Component&
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 inline const Signature&
 Data::getSignature() const
 {
+  if (m_isSignaturePending)
+    decodeSignature();
   return m_signature;
 }
 
@@ -26,7 +26,8 @@
 #include "../face.hpp"
 
 #include "registered-prefix.hpp"
-#include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "interest-filter-table.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
@@ -52,8 +53,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   class NfdFace : public ::nfd::LocalFace
@@ -114,6 +113,7 @@ public:
   Impl(Face& face)
     : m_face(face)
     , m_scheduler(m_face.getIoService())
+    , m_pendingInterestTable(m_scheduler)
   {
     ns3::Ptr<ns3::Node> node = ns3::NodeList::GetNode(ns3::Simulator::GetContext());
     NS_ASSERT_MSG(node->GetObject<ns3::ndn::L3Protocol>() != 0,
@@ -131,26 +131,16 @@ public:
   void
   satisfyPendingInterests(const Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest().matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
-
-        entry = m_pendingInterestTable.erase(entry);
-
-        matchedEntry->invokeDataCallback(data);
-      }
-      else
-        ++entry;
+    for (const auto& entry : m_pendingInterestTable.extractMatches(data)) {
+      entry->invokeDataCallback(data);
     }
   }
 
   void
   processInterestFilters(const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -161,11 +151,7 @@ public:
   asyncExpressInterest(const shared_ptr<const Interest>& interest,
                        const OnData& onData, const OnTimeout& onTimeout)
   {
-    auto entry =
-      m_pendingInterestTable.insert(make_shared<PendingInterest>(interest,
-                                                                 onData, onTimeout,
-                                                                 ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+    m_pendingInterestTable.insert(make_shared<PendingInterest>(interest, onData, onTimeout));
 
     m_nfdFace->emitSignal(onReceiveInterest, *interest);
   }
@@ -173,7 +159,7 @@ public:
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.remove(pendingInterestId);
   }
 
   void
@@ -188,19 +174,13 @@ public:
   void
   asyncSetInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    m_interestFilterTable.insert(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.remove(interestFilterId);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -239,7 +219,7 @@ public:
 
     if (static_cast<bool>(registeredPrefix->getFilter())) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (static_cast<bool>(onSuccess)) {
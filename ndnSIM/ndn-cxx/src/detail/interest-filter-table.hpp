@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+
+#include "interest-filter-record.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interest filters set by the application
+ *
+ * Filters are indexed by their prefix, so dispatching an Interest looks up the prefixes of
+ * its name at the filter prefix lengths actually in use, rather than trying every filter.
+ * Regex filters are only evaluated when their prefix matches.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  InterestFilterTable()
+    : m_nRecords(0)
+    , m_lastSerial(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_nRecords;
+  }
+
+  void
+  insert(const shared_ptr<InterestFilterRecord>& record)
+  {
+    const Name& prefix = record->getFilter().getPrefix();
+    m_records[prefix].push_back({record, ++m_lastSerial});
+    if (m_nPrefixesOfLength.size() <= prefix.size()) {
+      m_nPrefixesOfLength.resize(prefix.size() + 1, 0);
+    }
+    ++m_nPrefixesOfLength[prefix.size()];
+    ++m_nRecords;
+    m_ids[getId(record)] = record;
+  }
+
+  /**
+   * @brief Remove the record with the given id
+   * @return whether the record was found
+   */
+  bool
+  remove(const InterestFilterId* id)
+  {
+    auto record = m_ids.find(id);
+    if (record == m_ids.end()) {
+      return false;
+    }
+    remove(shared_ptr<InterestFilterRecord>(record->second));
+    return true;
+  }
+
+  void
+  remove(const shared_ptr<InterestFilterRecord>& record)
+  {
+    const Name& prefix = record->getFilter().getPrefix();
+    auto records = m_records.find(prefix);
+    if (records == m_records.end()) {
+      return;
+    }
+    for (auto item = records->second.begin(); item != records->second.end(); ++item) {
+      if (item->record == record) {
+        erase(prefix, item);
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Return the records matching @p name in the order they were inserted
+   */
+  std::vector<shared_ptr<InterestFilterRecord>>
+  findMatches(const Name& name) const
+  {
+    std::vector<const Record*> matches;
+    size_t nLengths = std::min(name.size() + 1, m_nPrefixesOfLength.size());
+    for (size_t length = 0; length < nLengths; ++length) {
+      if (m_nPrefixesOfLength[length] == 0) {
+        continue;
+      }
+      auto records = m_records.find(length == name.size() ? name : name.getPrefix(length));
+      if (records == m_records.end()) {
+        continue;
+      }
+      for (const Record& record : records->second) {
+        if (!record.record->getFilter().hasRegexFilter() || record.record->doesMatch(name)) {
+          matches.push_back(&record);
+        }
+      }
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const Record* a, const Record* b) { return a->serial < b->serial; });
+
+    std::vector<shared_ptr<InterestFilterRecord>> records;
+    records.reserve(matches.size());
+    for (const Record* match : matches) {
+      records.push_back(match->record);
+    }
+    return records;
+  }
+
+private:
+  struct Record
+  {
+    shared_ptr<InterestFilterRecord> record;
+    uint64_t serial;
+  };
+
+  static const InterestFilterId*
+  getId(const shared_ptr<InterestFilterRecord>& record)
+  {
+    return reinterpret_cast<const InterestFilterId*>(record.get());
+  }
+
+  void
+  erase(const Name& prefix, std::vector<Record>::iterator record)
+  {
+    m_ids.erase(getId(record->record));
+    --m_nPrefixesOfLength[prefix.size()];
+    --m_nRecords;
+
+    auto records = m_records.find(prefix);
+    records->second.erase(record);
+    if (records->second.empty()) {
+      m_records.erase(records);
+    }
+  }
+
+private:
+  std::unordered_map<Name, std::vector<Record>> m_records;
+  std::unordered_map<const InterestFilterId*, shared_ptr<InterestFilterRecord>> m_ids;
+  std::vector<size_t> m_nPrefixesOfLength;
+  size_t m_nRecords;
+  uint64_t m_lastSerial;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
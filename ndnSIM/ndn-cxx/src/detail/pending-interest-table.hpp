@@ -0,0 +1,324 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+#include "../util/signal.hpp"
+#include "../util/scheduler.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
+
+#include "pending-interest.hpp"
+
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interests expressed by the application
+ *
+ * Entries are indexed by Interest name, so an incoming Data only looks up the prefixes of
+ * its own name (and only at the name lengths actually present in the table) instead of
+ * checking every pending Interest.  Timeouts are kept in one FIFO per Interest lifetime;
+ * since deadlines within a FIFO never decrease, the table needs a single scheduler event
+ * for its earliest deadline, and inserting or satisfying an entry costs O(1).
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  explicit
+  PendingInterestTable(Scheduler& scheduler)
+    : m_timeoutEvent(scheduler)
+    , m_hasTimeout(false)
+    , m_scheduler(scheduler)
+    , m_nEntries(0)
+    , m_lastSerial(0)
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_nEntries;
+  }
+
+  bool
+  empty() const
+  {
+    return m_nEntries == 0;
+  }
+
+  /**
+   * @brief Add an entry and schedule its timeout according to the Interest lifetime
+   */
+  void
+  insert(const shared_ptr<PendingInterest>& entry)
+  {
+    const Name& name = entry->getInterest().getName();
+    Bucket& bucket = m_buckets[name];
+    bucket.push_back({entry, ++m_lastSerial});
+
+    m_index[getId(*entry)] = {&bucket, std::prev(bucket.end())};
+    if (m_nNamesOfLength.size() <= name.size()) {
+      m_nNamesOfLength.resize(name.size() + 1, 0);
+    }
+    ++m_nNamesOfLength[name.size()];
+    ++m_nEntries;
+
+    time::nanoseconds lifetime = entry->getLifetime();
+    time::steady_clock::TimePoint deadline = time::steady_clock::now() + lifetime;
+    m_deadlines[lifetime].push_back({deadline, getId(*entry), m_lastSerial});
+    if (!m_hasTimeout || deadline < m_nextTimeout) {
+      scheduleTimeout(deadline);
+    }
+  }
+
+  /**
+   * @brief Remove the entry with the given id, if it is still pending
+   */
+  void
+  remove(const PendingInterestId* id)
+  {
+    auto location = m_index.find(id);
+    if (location == m_index.end()) {
+      return;
+    }
+    erase(location);
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  /**
+   * @brief Remove all entries satisfied by @p data and return them in expression order
+   */
+  std::vector<shared_ptr<PendingInterest>>
+  extractMatches(const Data& data)
+  {
+    std::vector<Record> matches;
+    const Name& dataName = data.getName();
+    size_t nLengths = std::min(dataName.size() + 1, m_nNamesOfLength.size());
+    for (size_t length = 0; length < nLengths; ++length) {
+      if (m_nNamesOfLength[length] > 0) {
+        extractMatches(length == dataName.size() ? dataName : dataName.getPrefix(length),
+                       data, matches);
+      }
+    }
+    // Interests carrying the implicit digest component
+    if (dataName.size() + 1 < m_nNamesOfLength.size() &&
+        m_nNamesOfLength[dataName.size() + 1] > 0) {
+      extractMatches(data.getFullName(), data, matches);
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [] (const Record& a, const Record& b) { return a.serial < b.serial; });
+
+    std::vector<shared_ptr<PendingInterest>> entries;
+    entries.reserve(matches.size());
+    for (const Record& match : matches) {
+      entries.push_back(match.entry);
+    }
+    if (!matches.empty() && empty()) {
+      this->onEmpty();
+    }
+    return entries;
+  }
+
+  void
+  clear()
+  {
+    m_buckets.clear();
+    m_index.clear();
+    m_nNamesOfLength.clear();
+    m_deadlines.clear();
+    m_timeoutEvent.cancel();
+    m_hasTimeout = false;
+    m_nEntries = 0;
+    this->onEmpty();
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when the table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  struct Record
+  {
+    shared_ptr<PendingInterest> entry;
+    uint64_t serial;
+  };
+
+  /// entries with the same Interest name, in expression order
+  typedef std::list<Record> Bucket;
+
+  struct Location
+  {
+    Bucket* bucket;
+    Bucket::iterator record;
+  };
+
+  typedef std::unordered_map<const PendingInterestId*, Location> Index;
+
+  struct Deadline
+  {
+    time::steady_clock::TimePoint time;
+    const PendingInterestId* id;
+    uint64_t serial;
+  };
+
+  static const PendingInterestId*
+  getId(const PendingInterest& entry)
+  {
+    return reinterpret_cast<const PendingInterestId*>(&entry.getInterest());
+  }
+
+  void
+  extractMatches(const Name& name, const Data& data, std::vector<Record>& matches)
+  {
+    auto bucket = m_buckets.find(name);
+    if (bucket == m_buckets.end()) {
+      return;
+    }
+    for (auto record = bucket->second.begin(); record != bucket->second.end(); ) {
+      if (record->entry->getInterest().matchesData(data)) {
+        matches.push_back(*record);
+        m_index.erase(getId(*record->entry));
+        record = bucket->second.erase(record);
+        --m_nNamesOfLength[name.size()];
+        --m_nEntries;
+      }
+      else {
+        ++record;
+      }
+    }
+    if (bucket->second.empty()) {
+      m_buckets.erase(bucket);
+    }
+  }
+
+  void
+  erase(Index::iterator location)
+  {
+    Bucket& bucket = *location->second.bucket;
+    const Name name = location->second.record->entry->getInterest().getName();
+    bucket.erase(location->second.record);
+    m_index.erase(location);
+    if (bucket.empty()) {
+      m_buckets.erase(name);
+    }
+    --m_nNamesOfLength[name.size()];
+    --m_nEntries;
+  }
+
+  /**
+   * @return whether @p deadline still refers to a pending entry
+   */
+  bool
+  isLive(const Deadline& deadline) const
+  {
+    auto location = m_index.find(deadline.id);
+    return location != m_index.end() && location->second.record->serial == deadline.serial;
+  }
+
+  void
+  scheduleTimeout(const time::steady_clock::TimePoint& deadline)
+  {
+    m_hasTimeout = true;
+    m_nextTimeout = deadline;
+    m_timeoutEvent = m_scheduler.scheduleEvent(std::max(deadline - time::steady_clock::now(),
+                                                        time::nanoseconds::zero()),
+                                               bind(&PendingInterestTable::processTimeouts,
+                                                    this));
+  }
+
+  /**
+   * @brief Time out all expired entries and schedule the next earliest deadline
+   *
+   * Callbacks may modify the table, so the earliest deadline is looked up again after each.
+   */
+  void
+  processTimeouts()
+  {
+    m_timeoutEvent.release();
+    m_hasTimeout = false;
+
+    while (true) {
+      auto earliest = m_deadlines.end();
+      for (auto queue = m_deadlines.begin(); queue != m_deadlines.end(); ) {
+        while (!queue->second.empty() && !isLive(queue->second.front())) {
+          queue->second.pop_front();
+        }
+        if (queue->second.empty()) {
+          queue = m_deadlines.erase(queue);
+          continue;
+        }
+        if (earliest == m_deadlines.end() ||
+            queue->second.front().time < earliest->second.front().time) {
+          earliest = queue;
+        }
+        ++queue;
+      }
+
+      if (earliest == m_deadlines.end()) {
+        return;
+      }
+      Deadline deadline = earliest->second.front();
+      if (deadline.time > time::steady_clock::now()) {
+        scheduleTimeout(deadline.time);
+        return;
+      }
+      earliest->second.pop_front();
+
+      auto location = m_index.find(deadline.id);
+      shared_ptr<PendingInterest> entry = location->second.record->entry;
+      erase(location);
+
+      entry->invokeTimeoutCallback();
+      if (empty()) {
+        this->onEmpty();
+      }
+    }
+  }
+
+private:
+  util::scheduler::ScopedEventId m_timeoutEvent;
+  bool m_hasTimeout;
+  time::steady_clock::TimePoint m_nextTimeout;
+  Scheduler& m_scheduler;
+
+  std::unordered_map<Name, Bucket> m_buckets;
+  Index m_index;
+  std::vector<size_t> m_nNamesOfLength;
+  size_t m_nEntries;
+  uint64_t m_lastSerial;
+
+  /// deadline FIFOs keyed by Interest lifetime
+  std::map<time::nanoseconds, std::deque<Deadline>> m_deadlines;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -26,11 +26,15 @@
 #include "../interest.hpp"
 #include "../data.hpp"
 #include "../util/time.hpp"
-#include "../util/scheduler.hpp"
-#include "../util/scheduler-scoped-event-id.hpp"
 
 namespace ndn {
 
+/**
+ * @brief An Interest expressed by the application and waiting for Data or timeout
+ *
+ * The entry itself does not schedule anything: its timeout is tracked by
+ * PendingInterestTable, which keeps a single scheduler event for all entries.
+ */
 class PendingInterest : noncopyable
 {
 public:
@@ -38,28 +42,19 @@ public:
   typedef function<void(const Interest&)> OnTimeout;
 
   /**
-   * @brief Create a new PitEntry and set the timeout based on the current time and
-   *        the interest lifetime.
+   * @brief Create a new PitEntry
    *
    * @param interest A shared_ptr for the interest
    * @param onData A function object to call when a matching data packet is received.
    * @param onTimeout A function object to call if the interest times out.
    *                  If onTimeout is an empty OnTimeout(), this does not use it.
-   * @param scheduler Scheduler instance to use to schedule a timeout event.  The scheduled
-   *                  event will be automatically cancelled when pending interest is destroyed.
    */
   PendingInterest(shared_ptr<const Interest> interest, const OnData& onData,
-                  const OnTimeout& onTimeout, Scheduler& scheduler)
+                  const OnTimeout& onTimeout)
     : m_interest(interest)
     , m_onData(onData)
     , m_onTimeout(onTimeout)
-    , m_timeoutEvent(scheduler)
   {
-    m_timeoutEvent =
-      scheduler.scheduleEvent(m_interest->getInterestLifetime() > time::milliseconds::zero() ?
-                              m_interest->getInterestLifetime() :
-                              DEFAULT_INTEREST_LIFETIME,
-                              bind(&PendingInterest::invokeTimeoutCallback, this));
   }
 
   /**
@@ -72,25 +67,25 @@ public:
   }
 
   /**
-   * @brief invokes the DataCallback
-   * @note If the DataCallback is an empty function, this method does nothing.
+   * @return the time after which the Interest times out, counted from its expression
    */
-  void
-  invokeDataCallback(const Data& data)
+  time::nanoseconds
+  getLifetime() const
   {
-    m_onData(*m_interest, const_cast<Data&>(data));
+    return m_interest->getInterestLifetime() > time::milliseconds::zero() ?
+           m_interest->getInterestLifetime() : DEFAULT_INTEREST_LIFETIME;
   }
 
   /**
-   * @brief Set cleanup function to be called after interest times out
+   * @brief invokes the DataCallback
+   * @note If the DataCallback is an empty function, this method does nothing.
    */
   void
-  setDeleter(const std::function<void()>& deleter)
+  invokeDataCallback(const Data& data)
   {
-    m_deleter = deleter;
+    m_onData(*m_interest, const_cast<Data&>(data));
   }
 
-private:
   /**
    * @brief invokes the TimeoutCallback
    * @note If the TimeoutCallback is an empty function, this method does nothing.
@@ -101,17 +96,12 @@ private:
     if (m_onTimeout) {
       m_onTimeout(*m_interest);
     }
-
-    BOOST_ASSERT(m_deleter);
-    m_deleter();
   }
 
 private:
   shared_ptr<const Interest> m_interest;
   const OnData m_onData;
   const OnTimeout m_onTimeout;
-  util::scheduler::ScopedEventId m_timeoutEvent;
-  std::function<void()> m_deleter;
 };
 
 
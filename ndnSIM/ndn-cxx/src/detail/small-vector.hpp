@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_SMALL_VECTOR_HPP
+#define NDN_DETAIL_SMALL_VECTOR_HPP
+
+#include "../common.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+namespace ndn {
+
+/**
+ * @brief A vector of POD elements that keeps up to N elements inline
+ *
+ * Elements move to the heap when the size exceeds N, and stay there until clear().
+ */
+template<class T, size_t N>
+class SmallVector
+{
+  static_assert(std::is_pod<T>::value, "T must be a POD type");
+
+public:
+  SmallVector()
+    : m_data(m_inline)
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  SmallVector(const SmallVector& other)
+    : SmallVector()
+  {
+    assign(other.data(), other.size());
+  }
+
+  SmallVector&
+  operator=(const SmallVector& other)
+  {
+    if (this != &other)
+      assign(other.data(), other.size());
+    return *this;
+  }
+
+  ~SmallVector()
+  {
+    if (m_data != m_inline)
+      delete[] m_data;
+  }
+
+  const T*
+  data() const
+  {
+    return m_data;
+  }
+
+  T*
+  data()
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  bool
+  isInline() const
+  {
+    return m_data == m_inline;
+  }
+
+  const T&
+  operator[](size_t i) const
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_data[i];
+  }
+
+  T&
+  operator[](size_t i)
+  {
+    BOOST_ASSERT(i < m_size);
+    return m_data[i];
+  }
+
+  void
+  push_back(const T& value)
+  {
+    reserve(m_size + 1);
+    m_data[m_size++] = value;
+  }
+
+  void
+  append(const T* values, size_t n)
+  {
+    reserve(m_size + n);
+    std::memcpy(m_data + m_size, values, n * sizeof(T));
+    m_size += n;
+  }
+
+  void
+  assign(const T* values, size_t n)
+  {
+    m_size = 0;
+    append(values, n);
+  }
+
+  /**
+   * @brief Shrink to the first n elements
+   */
+  void
+  truncate(size_t n)
+  {
+    BOOST_ASSERT(n <= m_size);
+    m_size = n;
+  }
+
+  void
+  clear()
+  {
+    if (m_data != m_inline)
+      delete[] m_data;
+    m_data = m_inline;
+    m_size = 0;
+    m_capacity = N;
+  }
+
+  void
+  reserve(size_t capacity)
+  {
+    if (capacity <= m_capacity)
+      return;
+
+    capacity = std::max(capacity, 2 * m_capacity);
+    T* data = new T[capacity];
+    std::memcpy(data, m_data, m_size * sizeof(T));
+    if (m_data != m_inline)
+      delete[] m_data;
+    m_data = data;
+    m_capacity = capacity;
+  }
+
+private:
+  T* m_data;
+  size_t m_size;
+  size_t m_capacity;
+  T m_inline[N];
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_SMALL_VECTOR_HPP
@@ -157,7 +157,7 @@ Block::Block(const uint8_t* buffer, size_t maxlength)
       BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
     }
 
-  m_buffer = make_shared<Buffer>(buffer, (tmp_begin - buffer) + length);
+  m_buffer = makeBuffer(buffer, (tmp_begin - buffer) + length);
 
   m_begin = m_buffer->begin();
   m_end = m_buffer->end();
@@ -182,7 +182,7 @@ Block::Block(const void* bufferX, size_t maxlength)
       BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
     }
 
-  m_buffer = make_shared<Buffer>(buffer, (tmp_begin - buffer) + length);
+  m_buffer = makeBuffer(buffer, (tmp_begin - buffer) + length);
 
   m_begin = m_buffer->begin();
   m_end = m_buffer->end();
@@ -252,24 +252,28 @@ Block::fromStream(std::istream& is)
 std::tuple<bool, Block>
 Block::fromBuffer(ConstBufferPtr buffer, size_t offset)
 {
-  Buffer::const_iterator tempBegin = buffer->begin() + offset;
+  // read type and length through a pointer, with the fast readers for contiguous buffers
+  const uint8_t* bufferBegin = buffer->data();
+  const uint8_t* tempBegin = bufferBegin + offset;
+  const uint8_t* tempEnd = bufferBegin + buffer->size();
 
   uint32_t type;
-  bool isOk = tlv::readType(tempBegin, buffer->end(), type);
+  bool isOk = tlv::readType(tempBegin, tempEnd, type);
   if (!isOk)
     return std::make_tuple(false, Block());
 
   uint64_t length;
-  isOk = tlv::readVarNumber(tempBegin, buffer->end(), length);
+  isOk = tlv::readVarNumber(tempBegin, tempEnd, length);
   if (!isOk)
     return std::make_tuple(false, Block());
 
-  if (length > static_cast<uint64_t>(buffer->end() - tempBegin))
+  if (length > static_cast<uint64_t>(tempEnd - tempBegin))
     return std::make_tuple(false, Block());
 
+  Buffer::const_iterator valueBegin = buffer->begin() + (tempBegin - bufferBegin);
   return std::make_tuple(true, Block(buffer, type,
-                                     buffer->begin() + offset, tempBegin + length,
-                                     tempBegin, tempBegin + length));
+                                     buffer->begin() + offset, valueBegin + length,
+                                     valueBegin, valueBegin + length));
 }
 
 std::tuple<bool, Block>
@@ -291,7 +295,7 @@ Block::fromBuffer(const uint8_t* buffer, size_t maxSize)
   if (length > static_cast<uint64_t>(tempEnd - tempBegin))
     return std::make_tuple(false, Block());
 
-  BufferPtr sharedBuffer = make_shared<Buffer>(buffer, tempBegin + length);
+  BufferPtr sharedBuffer = makeBuffer(buffer, tempBegin + length);
   return std::make_tuple(true,
          Block(sharedBuffer, type,
                sharedBuffer->begin(), sharedBuffer->end(),
@@ -324,12 +328,15 @@ Block::parse() const
   if (!m_subBlocks.empty() || value_size() == 0)
     return;
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
+  // walk the value through a pointer, with the fast readers for contiguous buffers
+  Buffer::const_iterator valueBegin = value_begin();
+  const uint8_t* base = value();
+  const uint8_t* begin = base;
+  const uint8_t* end = base + value_size();
 
   while (begin != end)
     {
-      Buffer::const_iterator element_begin = begin;
+      const uint8_t* element_begin = begin;
 
       uint32_t type = tlv::readType(begin, end);
       uint64_t length = tlv::readVarNumber(begin, end);
@@ -339,12 +346,14 @@ Block::parse() const
           m_subBlocks.clear();
           BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
         }
-      Buffer::const_iterator element_end = begin + length;
+      const uint8_t* element_end = begin + length;
 
       m_subBlocks.push_back(Block(m_buffer,
                                   type,
-                                  element_begin, element_end,
-                                  begin, element_end));
+                                  valueBegin + (element_begin - base),
+                                  valueBegin + (element_end - base),
+                                  valueBegin + (begin - base),
+                                  valueBegin + (element_end - base)));
 
       begin = element_end;
       // don't do recursive parsing, just the top level
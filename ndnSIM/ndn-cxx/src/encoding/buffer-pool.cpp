@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "buffer-pool.hpp"
+
+namespace ndn {
+
+const size_t BufferPool::N_SIZE_CLASSES;
+const size_t BufferPool::SIZE_CLASSES[BufferPool::N_SIZE_CLASSES] = {64, 256, 1500, 8800};
+
+namespace {
+
+size_t
+getSizeClass(size_t size)
+{
+  size_t sizeClass = 0;
+  while (sizeClass < BufferPool::N_SIZE_CLASSES && size > BufferPool::SIZE_CLASSES[sizeClass])
+    ++sizeClass;
+  return sizeClass;
+}
+
+struct FreeBlock
+{
+  FreeBlock* next;
+};
+
+class ThreadPool : noncopyable
+{
+public:
+  ThreadPool()
+    : m_freeLists()
+  {
+  }
+
+  ~ThreadPool();
+
+  void*
+  allocate(size_t size);
+
+  void
+  deallocate(void* p, size_t size);
+
+  void
+  trim();
+
+public:
+  BufferPoolStats stats;
+
+private:
+  FreeBlock* m_freeLists[BufferPool::N_SIZE_CLASSES];
+};
+
+// Blocks can be released after the pool of their thread is destroyed, e.g. by the destructors
+// of static objects; they then go straight to operator delete.
+thread_local bool t_isPoolDestroyed = false;
+thread_local ThreadPool t_pool;
+
+ThreadPool::~ThreadPool()
+{
+  trim();
+  t_isPoolDestroyed = true;
+}
+
+void*
+ThreadPool::allocate(size_t size)
+{
+  ++stats.nAllocations;
+  ++stats.nInUse;
+
+  size_t sizeClass = getSizeClass(size);
+  if (sizeClass == BufferPool::N_SIZE_CLASSES) {
+    ++stats.nHeapAllocations;
+    return ::operator new(size);
+  }
+
+  FreeBlock* block = m_freeLists[sizeClass];
+  if (block == nullptr) {
+    ++stats.nHeapAllocations;
+    return ::operator new(BufferPool::SIZE_CLASSES[sizeClass]);
+  }
+
+  m_freeLists[sizeClass] = block->next;
+  --stats.nFreeBlocks;
+  return block;
+}
+
+void
+ThreadPool::deallocate(void* p, size_t size)
+{
+  if (stats.nInUse > 0) // the block may have been allocated by another thread
+    --stats.nInUse;
+
+  size_t sizeClass = getSizeClass(size);
+  if (sizeClass == BufferPool::N_SIZE_CLASSES) {
+    ::operator delete(p);
+    return;
+  }
+
+  FreeBlock* block = static_cast<FreeBlock*>(p);
+  block->next = m_freeLists[sizeClass];
+  m_freeLists[sizeClass] = block;
+  ++stats.nFreeBlocks;
+}
+
+void
+ThreadPool::trim()
+{
+  for (FreeBlock*& list : m_freeLists) {
+    while (list != nullptr) {
+      FreeBlock* block = list;
+      list = block->next;
+      ::operator delete(block);
+    }
+  }
+  stats.nFreeBlocks = 0;
+}
+
+} // unnamed namespace
+
+void*
+BufferPool::allocate(size_t size)
+{
+  if (t_isPoolDestroyed)
+    return ::operator new(size);
+
+  return t_pool.allocate(size);
+}
+
+void
+BufferPool::deallocate(void* p, size_t size)
+{
+  if (t_isPoolDestroyed) {
+    ::operator delete(p);
+    return;
+  }
+
+  t_pool.deallocate(p, size);
+}
+
+const BufferPoolStats&
+BufferPool::getStats()
+{
+  return t_pool.stats;
+}
+
+void
+BufferPool::trim()
+{
+  if (!t_isPoolDestroyed)
+    t_pool.trim();
+}
+
+} // namespace ndn
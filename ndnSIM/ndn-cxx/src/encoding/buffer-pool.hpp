@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BUFFER_POOL_HPP
+#define NDN_ENCODING_BUFFER_POOL_HPP
+
+#include "../common.hpp"
+
+#include <type_traits>
+
+namespace ndn {
+
+/**
+ * @brief Counters of the buffer pool of a thread
+ */
+struct BufferPoolStats
+{
+  BufferPoolStats()
+    : nAllocations(0)
+    , nHeapAllocations(0)
+    , nInUse(0)
+    , nFreeBlocks(0)
+  {
+  }
+
+  uint64_t nAllocations;     ///< blocks handed out
+  uint64_t nHeapAllocations; ///< blocks obtained from operator new, for a miss or a large size
+  size_t nInUse;             ///< blocks handed out and not released yet
+  size_t nFreeBlocks;        ///< released blocks kept for reuse
+};
+
+/**
+ * @brief Free lists of memory blocks in a few size classes, one set per thread
+ *
+ * A request is rounded up to the smallest size class that holds it and served from the free
+ * list of that class.  Released blocks go back to the free list of the releasing thread, and
+ * are returned to the global heap only by trim() or when the thread exits.  Requests larger
+ * than the largest class go to operator new.
+ *
+ * The classes cover a name or a small control block, an Interest, a Data that fits an
+ * Ethernet MTU and the default 8800-byte EncodingBuffer.
+ */
+class BufferPool : noncopyable
+{
+public:
+  static const size_t N_SIZE_CLASSES = 4;
+  static const size_t SIZE_CLASSES[N_SIZE_CLASSES];
+
+  static void*
+  allocate(size_t size);
+
+  /**
+   * @param size the size given to allocate
+   */
+  static void
+  deallocate(void* p, size_t size);
+
+  /**
+   * @brief Get the counters of the pool of the calling thread
+   */
+  static const BufferPoolStats&
+  getStats();
+
+  /**
+   * @brief Return the free blocks of the calling thread to the global heap
+   */
+  static void
+  trim();
+};
+
+/**
+ * @brief Stateless allocator of BufferPool, usable with std::vector and std::allocate_shared
+ */
+template<typename T>
+class BufferAllocator
+{
+public:
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type is_always_equal;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef BufferAllocator<U> other;
+  };
+
+  BufferAllocator() noexcept
+  {
+  }
+
+  template<typename U>
+  BufferAllocator(const BufferAllocator<U>&) noexcept
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(BufferPool::allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    BufferPool::deallocate(p, n * sizeof(T));
+  }
+};
+
+template<typename T, typename U>
+bool
+operator==(const BufferAllocator<T>&, const BufferAllocator<U>&)
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool
+operator!=(const BufferAllocator<T>&, const BufferAllocator<U>&)
+{
+  return false;
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BUFFER_POOL_HPP
@@ -50,7 +50,10 @@ public:
   std::streamsize
   write(const char_type* s, std::streamsize n)
   {
-    std::copy(s, s+n, std::back_inserter(m_container));
+    // grow and copy in bulk rather than push back every octet
+    size_t size = m_container.size();
+    m_container.resize(size + n);
+    std::copy(s, s + n, m_container.begin() + size);
     return n;
   }
 
@@ -83,7 +86,7 @@ public:
    * Default constructor
    */
   OBufferStream()
-    : m_buffer(make_shared<Buffer>())
+    : m_buffer(makeBuffer())
     , m_device(*m_buffer)
   {
     open(m_device);
@@ -40,13 +40,12 @@ Buffer::Buffer()
 }
 
 Buffer::Buffer(size_t size)
-  : std::vector<uint8_t>(size, 0)
+  : detail::BufferBase(size, 0)
 {
 }
 
 Buffer::Buffer(const void* buf, size_t length)
-  : std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(buf),
-                         reinterpret_cast<const uint8_t*>(buf) + length)
+  : Buffer(reinterpret_cast<const uint8_t*>(buf), reinterpret_cast<const uint8_t*>(buf) + length)
 {
 }
 
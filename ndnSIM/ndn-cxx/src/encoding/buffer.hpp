@@ -25,7 +25,9 @@
 #define NDN_ENCODING_BUFFER_HPP
 
 #include "../common.hpp"
+#include "buffer-pool.hpp"
 
+#include <iterator>
 #include <vector>
 
 namespace ndn {
@@ -34,14 +36,28 @@ class Buffer;
 typedef shared_ptr<const Buffer> ConstBufferPtr;
 typedef shared_ptr<Buffer> BufferPtr;
 
+namespace detail {
+
+#ifdef NDN_CXX_WITH_BUFFER_POOL
+typedef std::vector<uint8_t, BufferAllocator<uint8_t>> BufferBase;
+#else
+typedef std::vector<uint8_t> BufferBase;
+#endif // NDN_CXX_WITH_BUFFER_POOL
+
+} // namespace detail
+
 /**
  * @brief Class representing a general-use automatically managed/resized buffer
  *
  * In most respect, Buffer class is equivalent to std::vector<uint8_t> and is in fact
  * uses it as a base class.  In addition to that, it provides buf() and buf<T>() helper
  * method for easier access to the underlying data (buf<T>() casts pointer to the requested class)
+ *
+ * When the library is built with the buffer pool (NDN_CXX_WITH_BUFFER_POOL), the bytes are
+ * allocated from BufferPool rather than with std::allocator; use makeBuffer to allocate the
+ * Buffer object and its shared_ptr control block from the pool too.
  */
-class Buffer : public std::vector<uint8_t>
+class Buffer : public detail::BufferBase
 {
 public:
   /** @brief Creates an empty buffer
@@ -67,7 +83,7 @@ public:
    */
   template <class InputIterator>
   Buffer(InputIterator first, InputIterator last)
-    : std::vector<uint8_t>(first, last)
+    : Buffer(first, last, typename std::iterator_traits<InputIterator>::iterator_category())
   {
   }
 
@@ -126,8 +142,34 @@ public:
   {
     return reinterpret_cast<const T*>(&front());
   }
+
+private:
+  template <class InputIterator>
+  Buffer(InputIterator first, InputIterator last, std::input_iterator_tag)
+    : detail::BufferBase(first, last)
+  {
+  }
+
+  // std::vector copies element by element into memory of an allocator other than
+  // std::allocator; filling and then copying lets both steps use memset and memmove
+  template <class ForwardIterator>
+  Buffer(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+    : detail::BufferBase(std::distance(first, last))
+  {
+    std::copy(first, last, begin());
+  }
 };
 
+/** @brief Create a Buffer with the given constructor arguments, in a single allocation with
+ *         its shared_ptr control block
+ */
+template<typename... Args>
+BufferPtr
+makeBuffer(Args&&... args)
+{
+  return std::allocate_shared<Buffer>(Buffer::allocator_type(), std::forward<Args>(args)...);
+}
+
 } // namespace ndn
 
 #endif // NDN_ENCODING_BUFFER_HPP
@@ -144,6 +144,17 @@ public: // unique interface to the Encoder
   typedef Buffer::iterator iterator;
   typedef Buffer::const_iterator const_iterator;
 
+  /**
+   * @brief Create instance of the encoder that prepends into an existing buffer
+   * @param buffer buffer to prepend into, e.g., a chunk of EncodingArena
+   * @param end    offset in @p buffer in front of which data is prepended
+   *
+   * Bytes from @p end to the end of @p buffer may belong to other blocks, so only prepend*
+   * operations are allowed.  If the space in front of @p end is not enough, data is moved
+   * into a new buffer.
+   */
+  Encoder(const shared_ptr<Buffer>& buffer, size_t end);
+
   /**
    * @brief Create EncodingBlock from existing block
    *
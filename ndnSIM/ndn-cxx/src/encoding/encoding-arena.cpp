@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding-arena.hpp"
+
+namespace ndn {
+namespace encoding {
+
+const size_t EncodingArena::CHUNK_SIZE;
+
+EncodingArena&
+EncodingArena::get()
+{
+  static thread_local EncodingArena arena;
+  return arena;
+}
+
+EncodingArena::EncodingArena()
+  : m_free(0)
+  , m_maxPacketSize(0)
+{
+}
+
+void
+EncodingArena::reserve()
+{
+  if (m_chunk != nullptr && m_free >= m_maxPacketSize)
+    return;
+
+  m_chunk = makeBuffer(std::max(CHUNK_SIZE, 2 * m_maxPacketSize));
+  m_free = m_chunk->size();
+}
+
+Block
+EncodingArena::commit(EncodingBuffer& encoder)
+{
+  m_maxPacketSize = std::max(m_maxPacketSize, encoder.size());
+
+  // the encoder has moved into a buffer of its own if the packet did not fit
+  if (encoder.getBuffer() == m_chunk) {
+    m_free = encoder.begin() - m_chunk->begin();
+  }
+  return encoder.block();
+}
+
+Block
+EncodingArena::detach(EncodingBuffer& encoder)
+{
+  m_maxPacketSize = std::max(m_maxPacketSize, encoder.size());
+
+  return Block(makeBuffer(encoder.buf(), encoder.size()));
+}
+
+} // namespace encoding
+} // namespace ndn
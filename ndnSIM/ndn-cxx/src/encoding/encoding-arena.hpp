@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_ENCODING_ARENA_HPP
+#define NDN_ENCODING_ENCODING_ARENA_HPP
+
+#include "../common.hpp"
+#include "encoding-buffer.hpp"
+
+namespace ndn {
+namespace encoding {
+
+/**
+ * @brief Chunks of memory into which packets are encoded back to front
+ *
+ * Encoding a packet into its own buffer takes two passes, EncodingEstimator to find the size
+ * of the buffer and EncodingBuffer to fill it, and allocates the buffer.  With the arena,
+ * packets are encoded in one pass, in front of the previously encoded one in the current
+ * chunk, and their blocks refer to the chunk.  A new chunk is started when the free space of
+ * the current one is smaller than the largest packet encoded so far.
+ *
+ * A chunk is freed when none of its blocks is used anymore; a long-lived block in a chunk
+ * keeps the whole chunk alive.  Packets kept for long, like Data, can be copied out with
+ * EncodingArena::detach, in which case the space in the chunk is reused for the next packet.
+ *
+ * Every thread has its own arena, see EncodingArena::get.  Encodings into the arena cannot be
+ * nested: a packet must be committed or detached before the next one is encoded.
+ */
+class EncodingArena : noncopyable
+{
+public:
+  static const size_t CHUNK_SIZE = 16384;
+
+  /**
+   * @brief Get the arena of the calling thread
+   */
+  static EncodingArena&
+  get();
+
+  EncodingArena();
+
+  /**
+   * @brief Make sure the free space of the current chunk can hold the largest packet encoded
+   *        so far, starting a new chunk if it cannot
+   *
+   *     arena.reserve();
+   *     EncodingBuffer encoder(arena.getChunk(), arena.getFreeSize());
+   */
+  void
+  reserve();
+
+  const shared_ptr<Buffer>&
+  getChunk() const
+  {
+    return m_chunk;
+  }
+
+  /**
+   * @brief Size of the free space at the front of the current chunk
+   */
+  size_t
+  getFreeSize() const
+  {
+    return m_free;
+  }
+
+  /**
+   * @brief Take the bytes prepended by @p encoder out of the free space
+   * @return block of the encoded bytes, referring to the chunk
+   */
+  Block
+  commit(EncodingBuffer& encoder);
+
+  /**
+   * @brief Copy the bytes prepended by @p encoder into a buffer of their own
+   *
+   * The free space of the chunk is not reduced.
+   */
+  Block
+  detach(EncodingBuffer& encoder);
+
+  /**
+   * @brief Size of the largest packet encoded so far
+   */
+  size_t
+  getMaxPacketSize() const
+  {
+    return m_maxPacketSize;
+  }
+
+private:
+  shared_ptr<Buffer> m_chunk;
+  size_t m_free;          ///< @brief bytes [0, m_free) of the chunk are free
+  size_t m_maxPacketSize; ///< @brief cached upper bound of the size of the next packet
+};
+
+} // namespace encoding
+
+using encoding::EncodingArena;
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_ENCODING_ARENA_HPP
@@ -48,6 +48,11 @@ public:
     : Encoder(block)
   {
   }
+
+  EncodingImpl(const shared_ptr<Buffer>& buffer, size_t end)
+    : Encoder(buffer, end)
+  {
+  }
 };
 
 /**
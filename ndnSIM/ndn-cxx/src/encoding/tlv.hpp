@@ -96,7 +96,8 @@ enum SignatureTypeValue {
   DigestSha256 = 0,
   SignatureSha256WithRsa = 1,
   // <Unassigned> = 2,
-  SignatureSha256WithEcdsa = 3
+  SignatureSha256WithEcdsa = 3,
+  SignatureHmacWithSha256 = 4
 };
 
 /** @brief TLV codes for SignatureInfo features
@@ -111,7 +112,12 @@ enum {
   AdditionalDescription = 258,
   DescriptionEntry = 512,
   DescriptionKey = 513,
-  DescriptionValue = 514
+  DescriptionValue = 514,
+
+  MerkleProof = 259,
+  MerkleLeafIndex = 515,
+  MerkleLeafCount = 516,
+  MerkleHash = 517
 };
 
 /** @brief indicates a possible value of ContentType field
@@ -190,6 +196,25 @@ template<class InputIterator>
 inline uint32_t
 readType(InputIterator& begin, const InputIterator& end);
 
+/**
+ * @brief Read VAR-NUMBER in NDN-TLV encoding from a contiguous buffer
+ *
+ * Same as the InputIterator version, which it takes over for plain pointers.  The 1-byte and
+ * 3-byte encodings, used by nearly all TLV types and lengths, are read with a single bounds
+ * check.
+ */
+inline bool
+readVarNumber(const uint8_t*& begin, const uint8_t* end, uint64_t& number);
+
+inline bool
+readType(const uint8_t*& begin, const uint8_t* end, uint32_t& type);
+
+inline uint64_t
+readVarNumber(const uint8_t*& begin, const uint8_t* end);
+
+inline uint32_t
+readType(const uint8_t*& begin, const uint8_t* end);
+
 /**
  * @brief Get number of bytes necessary to hold value of VAR-NUMBER
  */
@@ -384,6 +409,63 @@ readType(InputIterator& begin, const InputIterator& end)
   return static_cast<uint32_t>(type);
 }
 
+inline bool
+readVarNumber(const uint8_t*& begin, const uint8_t* end, uint64_t& number)
+{
+  if (begin != end && begin[0] < 253) {
+    number = begin[0];
+    ++begin;
+    return true;
+  }
+  if (end - begin >= 3 && begin[0] == 253) {
+    number = (static_cast<uint64_t>(begin[1]) << 8) | begin[2];
+    begin += 3;
+    return true;
+  }
+  return readVarNumber<const uint8_t*>(begin, end, number);
+}
+
+inline bool
+readType(const uint8_t*& begin, const uint8_t* end, uint32_t& type)
+{
+  uint64_t number = 0;
+  bool isOk = readVarNumber(begin, end, number);
+  if (!isOk || number > std::numeric_limits<uint32_t>::max())
+    {
+      return false;
+    }
+
+  type = static_cast<uint32_t>(number);
+  return true;
+}
+
+inline uint64_t
+readVarNumber(const uint8_t*& begin, const uint8_t* end)
+{
+  if (begin != end && begin[0] < 253) {
+    return *begin++;
+  }
+  if (end - begin >= 3 && begin[0] == 253) {
+    uint64_t number = (static_cast<uint64_t>(begin[1]) << 8) | begin[2];
+    begin += 3;
+    return number;
+  }
+  // longer encodings and errors
+  return readVarNumber<const uint8_t*>(begin, end);
+}
+
+inline uint32_t
+readType(const uint8_t*& begin, const uint8_t* end)
+{
+  uint64_t type = readVarNumber(begin, end);
+  if (type > std::numeric_limits<uint32_t>::max())
+    {
+      BOOST_THROW_EXCEPTION(Error("TLV type code exceeds allowed maximum"));
+    }
+
+  return static_cast<uint32_t>(type);
+}
+
 size_t
 sizeOfVarNumber(uint64_t varNumber)
 {
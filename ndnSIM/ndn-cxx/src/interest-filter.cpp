@@ -21,6 +21,7 @@
 
 #include "interest-filter.hpp"
 
+#include "util/regex/regex-automaton.hpp"
 #include "util/regex/regex-pattern-list-matcher.hpp"
 
 namespace ndn {
@@ -29,6 +30,7 @@ InterestFilter::InterestFilter(const Name& prefix, const std::string& regexFilte
   : m_prefix(prefix)
   , m_regexFilter(ndn::make_shared<RegexPatternListMatcher>(regexFilter,
                                                             shared_ptr<RegexBackrefManager>()))
+  , m_regexAutomaton(ndn::make_shared<RegexAutomaton>(regexFilter))
 {
 }
 
@@ -45,7 +47,7 @@ InterestFilter::doesMatch(const Name& name) const
     if (!isMatch)
       return false;
 
-    return m_regexFilter->match(name, m_prefix.size(), name.size() - m_prefix.size());
+    return m_regexAutomaton->match(name, m_prefix.size(), name.size() - m_prefix.size());
   }
   else {
     // perform just prefix match
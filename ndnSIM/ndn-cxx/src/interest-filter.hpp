@@ -27,6 +27,7 @@
 namespace ndn {
 
 class RegexPatternListMatcher;
+class RegexAutomaton;
 
 class InterestFilter
 {
@@ -127,6 +128,7 @@ public:
 private:
   Name m_prefix;
   shared_ptr<RegexPatternListMatcher> m_regexFilter;
+  shared_ptr<RegexAutomaton> m_regexAutomaton; ///< matches like m_regexFilter, in one pass
 };
 
 std::ostream&
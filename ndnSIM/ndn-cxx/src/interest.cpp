@@ -20,10 +20,13 @@
  */
 
 #include "interest.hpp"
+#include "encoding/encoding-arena.hpp"
 #include "util/random.hpp"
 #include "util/crypto.hpp"
 #include "data.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-allocation-profiler.hpp"
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Interest>));
@@ -36,6 +39,7 @@ static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
 Interest::Interest()
   : m_interestLifetime(time::milliseconds::min())
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
@@ -43,6 +47,7 @@ Interest::Interest(const Name& name)
   : m_name(name)
   , m_interestLifetime(time::milliseconds::min())
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
@@ -50,10 +55,12 @@ Interest::Interest(const Name& name, const time::milliseconds& interestLifetime)
   : m_name(name)
   , m_interestLifetime(interestLifetime)
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
 Interest::Interest(const Block& wire)
+  : m_wireUseCount(0)
 {
   wireDecode(wire);
 }
@@ -76,7 +83,8 @@ Interest&
 Interest::setNonce(uint32_t nonce)
 {
   if (m_wire.hasWire() && m_nonce.value_size() == sizeof(uint32_t)) {
-    std::memcpy(const_cast<uint8_t*>(m_nonce.value()), &nonce, sizeof(nonce));
+    uint8_t* wire = getMutableWire();
+    std::memcpy(wire + (m_nonce.value() - m_wire.wire()), &nonce, sizeof(nonce));
   }
   else {
     m_nonce = makeBinaryBlock(tlv::Nonce,
@@ -87,6 +95,50 @@ Interest::setNonce(uint32_t nonce)
   return *this;
 }
 
+Interest&
+Interest::setInterestLifetime(const time::milliseconds& interestLifetime)
+{
+  m_interestLifetime = interestLifetime;
+  if (!m_wire.hasWire())
+    return *this;
+
+  Block::element_const_iterator val = m_wire.find(tlv::InterestLifetime);
+  if (val == m_wire.elements_end() ||
+      interestLifetime < time::milliseconds::zero() ||
+      interestLifetime == DEFAULT_INTEREST_LIFETIME ||
+      val->value_size() != tlv::sizeOfNonNegativeInteger(interestLifetime.count())) {
+    m_wire.reset();
+    return *this;
+  }
+
+  size_t offset = val->value() - m_wire.wire();
+  size_t length = val->value_size();
+  uint8_t* value = getMutableWire() + offset;
+  uint64_t count = interestLifetime.count();
+  for (size_t i = length; i > 0; --i) {
+    value[i - 1] = static_cast<uint8_t>(count);
+    count >>= 8;
+  }
+  return *this;
+}
+
+uint8_t*
+Interest::getMutableWire()
+{
+  // the buffer may be shared with copies of this Interest, with blocks obtained from
+  // wireEncode() or, for the buffer this Interest was decoded from, with other packets
+  if (m_wireUseCount == 0 ||
+      static_cast<size_t>(m_wire.getBuffer().use_count()) != m_wireUseCount) {
+    // other fields keep referring to the old buffer, which has the same content
+    m_wire = Block(makeBuffer(m_wire.wire(), m_wire.size()));
+    m_wire.parse();
+    m_nonce = *m_wire.find(tlv::Nonce);
+
+    m_wireUseCount = m_wire.getBuffer().use_count();
+  }
+  return const_cast<uint8_t*>(m_wire.wire());
+}
+
 void
 Interest::refreshNonce()
 {
@@ -101,6 +153,26 @@ Interest::refreshNonce()
   setNonce(newNonce);
 }
 
+shared_ptr<Interest>
+Interest::copyWithNonce(uint32_t nonce) const
+{
+  shared_ptr<Interest> interest = make_shared<Interest>(*this);
+  if (!m_wire.hasWire() || m_nonce.value_size() != sizeof(uint32_t)) {
+    interest->setNonce(nonce);
+    return interest;
+  }
+
+  shared_ptr<Buffer> buffer = makeBuffer(m_wire.wire(), m_wire.size());
+  std::memcpy(&(*buffer)[m_nonce.value() - m_wire.wire()], &nonce, sizeof(nonce));
+
+  // other fields of the copy keep referring to the original buffer, which has the same content
+  interest->m_wire = Block(buffer);
+  interest->m_wire.parse();
+  interest->m_nonce = *interest->m_wire.find(tlv::Nonce);
+  interest->m_wireUseCount = buffer.use_count() - 1;
+  return interest;
+}
+
 bool
 Interest::matchesName(const Name& name) const
 {
@@ -279,14 +351,16 @@ Interest::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  NDN_ALLOCATION_SCOPE(ENCODING);
 
-  EncodingBuffer buffer(estimatedSize, 0);
+  // single pass into the arena; Interests are short-lived, so the block keeps referring to it
+  EncodingArena& arena = EncodingArena::get();
+  arena.reserve();
+  EncodingBuffer buffer(arena.getChunk(), arena.getFreeSize());
   wireEncode(buffer);
 
   // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+  const_cast<Interest*>(this)->wireDecode(arena.commit(buffer));
 
   return m_wire;
 }
@@ -294,8 +368,10 @@ Interest::wireEncode() const
 void
 Interest::wireDecode(const Block& wire)
 {
+  NDN_ALLOCATION_SCOPE(ENCODING);
   m_wire = wire;
   m_wire.parse();
+  m_wireUseCount = 0;
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -375,6 +451,15 @@ Interest::getLink() const
   BOOST_THROW_EXCEPTION(Error("There is no encapsulated link object"));
 }
 
+const Block&
+Interest::getLinkWire() const
+{
+  if (!hasLink()) {
+    BOOST_THROW_EXCEPTION(Error("There is no encapsulated link object"));
+  }
+  return m_link;
+}
+
 void
 Interest::setLink(const Block& link)
 {
@@ -138,6 +138,13 @@ public: // Link and forwarding hint
   Link
   getLink() const;
 
+  /**
+   * @brief Get the wire encoding of the link object, without decoding it
+   * @throws Interest::Error if there is no link object contained in the interest
+   */
+  const Block&
+  getLinkWire() const;
+
   /**
    * @brief Set the link object for this interest
    * @param link The link object that will be included in this interest (in wire format)
@@ -232,13 +239,14 @@ public: // Name and guiders
     return m_interestLifetime;
   }
 
+  /** @brief Set Interest's lifetime
+   *
+   *  If wire format already exists and encodes the lifetime with as many bytes as
+   *  @p interestLifetime needs, this call replaces the lifetime in the existing wire format,
+   *  without resetting and recreating it.
+   */
   Interest&
-  setInterestLifetime(const time::milliseconds& interestLifetime)
-  {
-    m_interestLifetime = interestLifetime;
-    m_wire.reset();
-    return *this;
-  }
+  setInterestLifetime(const time::milliseconds& interestLifetime);
 
   /** @brief Check if Nonce set
    */
@@ -258,7 +266,8 @@ public: // Name and guiders
   /** @brief Set Interest's nonce
    *
    *  If wire format already exists, this call simply replaces nonce in the
-   *  existing wire format, without resetting and recreating it.
+   *  existing wire format, without resetting and recreating it.  The wire format is
+   *  copied first if it is shared, e.g. with copies of this Interest.
    */
   Interest&
   setNonce(uint32_t nonce);
@@ -273,6 +282,24 @@ public: // Name and guiders
   void
   refreshNonce();
 
+  /** @brief Make a copy of this Interest with a different nonce
+   *
+   *  If wire format already exists, the copy gets a private copy of the wire format with
+   *  the nonce replaced, without re-encoding it. Unlike setNonce on a copy, this does not
+   *  modify the wire format that the copy would share with this Interest.
+   */
+  shared_ptr<Interest>
+  copyWithNonce(uint32_t nonce) const;
+
+private:
+  /** @brief Get the first byte of m_wire for patching it in place
+   *
+   *  If the buffer of m_wire may be used by others, m_wire and m_nonce are moved to a copy
+   *  of the encoded Interest first (copy-on-write).
+   */
+  uint8_t*
+  getMutableWire();
+
 public: // local control header
   nfd::LocalControlHeader&
   getLocalControlHeader()
@@ -444,6 +471,8 @@ private:
   mutable Block m_link;
   size_t m_selectedDelegationIndex;
   mutable Block m_wire;
+  /// use count of m_wire's buffer when this Interest became its only user, 0 if it is not
+  size_t m_wireUseCount;
 
   nfd::LocalControlHeader m_localControlHeader;
   friend class nfd::LocalControlHeader;
@@ -59,9 +59,16 @@ ControlCommand::getRequestName(const Name& commandPrefix,
 {
   this->validateRequest(parameters);
 
+  Name name = this->getCommandName(commandPrefix);
+  name.append(parameters.wireEncode());
+  return name;
+}
+
+Name
+ControlCommand::getCommandName(const Name& commandPrefix) const
+{
   Name name = commandPrefix;
   name.append(m_module).append(m_verb);
-  name.append(parameters.wireEncode());
   return name;
 }
 
@@ -91,6 +98,53 @@ ControlCommand::FieldValidator::validate(const ControlParameters& parameters) co
   }
 }
 
+BatchControlCommand::BatchControlCommand(const std::string& module, const std::string& verb)
+  : ControlCommand(module, verb)
+{
+}
+
+Name
+BatchControlCommand::getRequestName(const Name& commandPrefix,
+                                    const std::vector<ControlParameters>& entries) const
+{
+  if (entries.empty()) {
+    BOOST_THROW_EXCEPTION(ArgumentError("batch must contain at least one entry"));
+  }
+
+  EncodingBuffer encoder;
+  for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+    this->validateRequest(*entry);
+    entry->wireEncode(encoder);
+  }
+
+  Name name = this->getCommandName(commandPrefix);
+  name.append(encoder.buf(), encoder.size());
+  return name;
+}
+
+std::vector<ControlParameters>
+BatchControlCommand::decodeEntries(const name::Component& component)
+{
+  std::vector<ControlParameters> entries;
+
+  Buffer::const_iterator begin = component.value_begin();
+  Buffer::const_iterator end = component.value_end();
+  while (begin != end) {
+    Buffer::const_iterator valueBegin = begin;
+    tlv::readType(valueBegin, end);
+    uint64_t length = tlv::readVarNumber(valueBegin, end);
+    if (length > static_cast<uint64_t>(std::distance(valueBegin, end))) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
+    }
+
+    Buffer::const_iterator entryEnd = valueBegin + length;
+    entries.push_back(ControlParameters(Block(component, begin, entryEnd)));
+    begin = entryEnd;
+  }
+
+  return entries;
+}
+
 FaceCreateCommand::FaceCreateCommand()
   : ControlCommand("faces", "create")
 {
@@ -236,6 +290,24 @@ FibRemoveNextHopCommand::validateResponse(const ControlParameters& parameters) c
   }
 }
 
+FibBatchCommand::FibBatchCommand()
+  : BatchControlCommand("fib", "batch")
+{
+  m_requestValidator
+    .required(CONTROL_PARAMETER_NAME)
+    .optional(CONTROL_PARAMETER_FACE_ID)
+    .optional(CONTROL_PARAMETER_COST);
+}
+
+void
+FibBatchCommand::applyDefaultsToRequest(ControlParameters& parameters) const
+{
+  // Cost is not defaulted: its absence marks the entry as a removal
+  if (!parameters.hasFaceId()) {
+    parameters.setFaceId(0);
+  }
+}
+
 StrategyChoiceSetCommand::StrategyChoiceSetCommand()
   : ControlCommand("strategy-choice", "set")
 {
@@ -315,6 +387,35 @@ RibRegisterCommand::validateResponse(const ControlParameters& parameters) const
   }
 }
 
+RibBatchRegisterCommand::RibBatchRegisterCommand()
+  : BatchControlCommand("rib", "batch-register")
+{
+  m_requestValidator
+    .required(CONTROL_PARAMETER_NAME)
+    .optional(CONTROL_PARAMETER_FACE_ID)
+    .optional(CONTROL_PARAMETER_ORIGIN)
+    .optional(CONTROL_PARAMETER_COST)
+    .optional(CONTROL_PARAMETER_FLAGS)
+    .optional(CONTROL_PARAMETER_EXPIRATION_PERIOD);
+}
+
+void
+RibBatchRegisterCommand::applyDefaultsToRequest(ControlParameters& parameters) const
+{
+  if (!parameters.hasFaceId()) {
+    parameters.setFaceId(0);
+  }
+  if (!parameters.hasOrigin()) {
+    parameters.setOrigin(ROUTE_ORIGIN_APP);
+  }
+  if (!parameters.hasCost()) {
+    parameters.setCost(0);
+  }
+  if (!parameters.hasFlags()) {
+    parameters.setFlags(ROUTE_FLAG_CHILD_INHERIT);
+  }
+}
+
 RibUnregisterCommand::RibUnregisterCommand()
   : ControlCommand("rib", "unregister")
 {
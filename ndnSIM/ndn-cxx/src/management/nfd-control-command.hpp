@@ -78,6 +78,11 @@ public:
 protected:
   ControlCommand(const std::string& module, const std::string& verb);
 
+  /** \brief construct <commandPrefix>/<module>/<verb>
+   */
+  Name
+  getCommandName(const Name& commandPrefix) const;
+
   class FieldValidator
   {
   public:
@@ -131,6 +136,34 @@ private:
 };
 
 
+/**
+ * \ingroup management
+ * \brief base class of a ControlCommand that carries a list of ControlParameters
+ *
+ *  The request Name is <commandPrefix>/<module>/<verb>/<entries>, where the <entries>
+ *  component is the concatenation of the ControlParameters TLV of every entry.
+ *  Each entry is validated with the request validator of the command.
+ */
+class BatchControlCommand : public ControlCommand
+{
+public:
+  /** \brief construct the Name for a request Interest
+   *  \throw ArgumentError if entries is empty or an entry is invalid
+   */
+  Name
+  getRequestName(const Name& commandPrefix, const std::vector<ControlParameters>& entries) const;
+
+  /** \brief decode the entries from the <entries> component of a request Name
+   *  \throw tlv::Error if the component is not a sequence of ControlParameters
+   */
+  static std::vector<ControlParameters>
+  decodeEntries(const name::Component& component);
+
+protected:
+  BatchControlCommand(const std::string& module, const std::string& verb);
+};
+
+
 /**
  * \ingroup management
  * \brief represents a faces/create command
@@ -242,6 +275,24 @@ public:
 };
 
 
+/**
+ * \ingroup management
+ * \brief represents a fib/batch command
+ *
+ *  Every entry is a nexthop change: an entry with Cost adds or updates the nexthop as
+ *  fib/add-nexthop does, an entry without Cost removes it as fib/remove-nexthop does.
+ *  The forwarder applies either all entries or none of them.
+ */
+class FibBatchCommand : public BatchControlCommand
+{
+public:
+  FibBatchCommand();
+
+  virtual void
+  applyDefaultsToRequest(ControlParameters& parameters) const;
+};
+
+
 /**
  * \ingroup management
  * \brief represents a strategy-choice/set command
@@ -290,6 +341,23 @@ public:
 };
 
 
+/**
+ * \ingroup management
+ * \brief represents a rib/batch-register command
+ *
+ *  Every entry is a route, with the same fields and defaults as a rib/register command.
+ *  The response carries no fields.
+ */
+class RibBatchRegisterCommand : public BatchControlCommand
+{
+public:
+  RibBatchRegisterCommand();
+
+  virtual void
+  applyDefaultsToRequest(ControlParameters& parameters) const;
+};
+
+
 /**
  * \ingroup management
  * \brief represents a rib/unregister command
@@ -43,6 +43,16 @@ Controller::startCommand(const shared_ptr<ControlCommand>& command,
                          const CommandOptions& options)
 {
   Name requestName = command->getRequestName(options.getPrefix(), parameters);
+  this->sendCommand(command, requestName, onSuccess, onFailure, options);
+}
+
+void
+Controller::sendCommand(const shared_ptr<ControlCommand>& command,
+                        const Name& requestName,
+                        const CommandSucceedCallback& onSuccess,
+                        const CommandFailCallback& onFailure,
+                        const CommandOptions& options)
+{
   Interest interest(requestName);
   interest.setInterestLifetime(options.getTimeout());
   m_keyChain.sign(interest, options.getSigningInfo());
@@ -67,6 +67,21 @@ public:
     this->startCommand(command, parameters, onSuccess, onFailure, options);
   }
 
+  /** \brief start execution of a BatchControlCommand carrying several entries
+   *  \throw ControlCommand::ArgumentError if entries is empty or an entry is invalid
+   */
+  template<typename Command>
+  void
+  startBatch(const std::vector<ControlParameters>& entries,
+             const CommandSucceedCallback& onSuccess,
+             const CommandFailCallback& onFailure,
+             const CommandOptions& options = CommandOptions())
+  {
+    shared_ptr<Command> command = make_shared<Command>();
+    Name requestName = command->getRequestName(options.getPrefix(), entries);
+    this->sendCommand(command, requestName, onSuccess, onFailure, options);
+  }
+
 private:
   void
   startCommand(const shared_ptr<ControlCommand>& command,
@@ -75,6 +90,13 @@ private:
                const CommandFailCallback& onFailure,
                const CommandOptions& options);
 
+  void
+  sendCommand(const shared_ptr<ControlCommand>& command,
+              const Name& requestName,
+              const CommandSucceedCallback& onSuccess,
+              const CommandFailCallback& onFailure,
+              const CommandOptions& options);
+
   void
   processCommandResponse(const Data& data,
                          const shared_ptr<ControlCommand>& command,
@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-dictionary.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <cstring>
+#include <limits>
+
+namespace ndn {
+namespace name {
+
+/// size of arena chunks, components larger than a quarter of it get their own buffer
+static const size_t CHUNK_SIZE = 16384;
+
+Dictionary::Dictionary()
+  : m_chunkUsed(CHUNK_SIZE)
+  , m_arenaSize(0)
+{
+}
+
+Dictionary&
+Dictionary::getDefault()
+{
+  static Dictionary dictionary;
+  return dictionary;
+}
+
+size_t
+Dictionary::hashWire(const Block& wire)
+{
+  return boost::hash_range(wire.wire(), wire.wire() + wire.size());
+}
+
+Dictionary::Handle
+Dictionary::intern(const Component& component)
+{
+  const Block& wire = component.wireEncode();
+  size_t hash = hashWire(wire);
+
+  auto range = m_index.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Block& candidate = m_components[it->second];
+    if (candidate.size() == wire.size() &&
+        std::memcmp(candidate.wire(), wire.wire(), wire.size()) == 0)
+      return it->second;
+  }
+
+  BOOST_ASSERT(m_components.size() < std::numeric_limits<Handle>::max());
+  Handle handle = static_cast<Handle>(m_components.size());
+  m_components.push_back(store(wire));
+  m_index.insert(range.second, std::make_pair(hash, handle));
+  return handle;
+}
+
+bool
+Dictionary::find(const Component& component, Handle& handle) const
+{
+  const Block& wire = component.wireEncode();
+
+  auto range = m_index.equal_range(hashWire(wire));
+  for (auto it = range.first; it != range.second; ++it) {
+    const Block& candidate = m_components[it->second];
+    if (candidate.size() == wire.size() &&
+        std::memcmp(candidate.wire(), wire.wire(), wire.size()) == 0) {
+      handle = it->second;
+      return true;
+    }
+  }
+  return false;
+}
+
+Component
+Dictionary::store(const Block& wire)
+{
+  if (wire.size() > CHUNK_SIZE / 4) {
+    m_arenaSize += wire.size();
+    return Component(Block(makeBuffer(wire.wire(), wire.size())));
+  }
+
+  if (m_chunkUsed + wire.size() > CHUNK_SIZE) {
+    // chunk is allocated at full size and never resized, so blocks can point into it
+    m_chunk = makeBuffer(CHUNK_SIZE);
+    m_chunkUsed = 0;
+    m_arenaSize += CHUNK_SIZE;
+  }
+
+  std::memcpy(m_chunk->buf() + m_chunkUsed, wire.wire(), wire.size());
+  ConstBufferPtr chunk = m_chunk;
+  Buffer::const_iterator begin = chunk->begin() + m_chunkUsed;
+  m_chunkUsed += wire.size();
+  return Component(Block(chunk, begin, begin + wire.size()));
+}
+
+void
+Dictionary::clear()
+{
+  m_components.clear();
+  m_index.clear();
+  m_chunk.reset();
+  m_chunkUsed = CHUNK_SIZE;
+  m_arenaSize = 0;
+}
+
+size_t
+Dictionary::getMemoryUsage() const
+{
+  // unordered_multimap nodes have the link and the cached hash next to the value
+  static const size_t NODE_OVERHEAD = 2 * sizeof(void*);
+
+  return sizeof(Dictionary) + m_arenaSize +
+         m_components.capacity() * sizeof(Component) +
+         m_index.size() * (sizeof(decltype(m_index)::value_type) + NODE_OVERHEAD) +
+         m_index.bucket_count() * sizeof(void*);
+}
+
+} // namespace name
+
+InternedName::InternedName()
+  : m_dictionary(&name::Dictionary::getDefault())
+{
+}
+
+InternedName::InternedName(const Name& name, name::Dictionary& dictionary)
+  : m_dictionary(&dictionary)
+{
+  m_handles.reserve(name.size());
+  for (const name::Component& component : name) {
+    m_handles.push_back(dictionary.intern(component));
+  }
+}
+
+InternedName
+InternedName::getPrefix(ssize_t nComponents) const
+{
+  if (nComponents < 0)
+    nComponents += m_handles.size();
+  nComponents = std::max<ssize_t>(0, std::min<ssize_t>(nComponents, m_handles.size()));
+
+  InternedName prefix;
+  prefix.m_dictionary = m_dictionary;
+  prefix.m_handles.assign(m_handles.begin(), m_handles.begin() + nComponents);
+  return prefix;
+}
+
+bool
+InternedName::isPrefixOf(const InternedName& other) const
+{
+  BOOST_ASSERT(m_dictionary == other.m_dictionary);
+
+  if (size() > other.size())
+    return false;
+
+  return std::equal(m_handles.begin(), m_handles.end(), other.m_handles.begin());
+}
+
+Name
+InternedName::toName() const
+{
+  Name name;
+  for (Handle handle : m_handles) {
+    name.append(m_dictionary->get(handle));
+  }
+  return name;
+}
+
+} // namespace ndn
+
+namespace std {
+
+size_t
+hash<ndn::InternedName>::operator()(const ndn::InternedName& name) const
+{
+  size_t seed = name.size();
+  for (size_t i = 0; i < name.size(); ++i) {
+    boost::hash_combine(seed, name.get(i));
+  }
+  return seed;
+}
+
+} // namespace std
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_NAME_DICTIONARY_HPP
+#define NDN_NAME_DICTIONARY_HPP
+
+#include "name.hpp"
+
+#include <unordered_map>
+
+namespace ndn {
+namespace name {
+
+/**
+ * @brief Interning dictionary of name components
+ *
+ * Every distinct component is stored once, in an append-only arena, and is identified by a
+ * 32-bit handle.  Two components interned in the same dictionary are equal if and only if
+ * their handles are equal, so names made of handles (InternedName) are compared and hashed
+ * without looking at component bytes.
+ *
+ * Components are never removed: the dictionary is meant for name spaces with a bounded set
+ * of distinct components (e.g., region and application labels of structured names).
+ * Interning components that are unique per packet (sequence numbers, nonces) grows the arena
+ * indefinitely.
+ */
+class Dictionary : noncopyable
+{
+public:
+  typedef uint32_t Handle;
+
+  Dictionary();
+
+  /**
+   * @brief Process-wide dictionary
+   */
+  static Dictionary&
+  getDefault();
+
+  /**
+   * @brief Get handle of the component, adding the component if it is not in the dictionary
+   */
+  Handle
+  intern(const Component& component);
+
+  /**
+   * @brief Get handle of the component without adding it
+   * @return whether the component is in the dictionary
+   */
+  bool
+  find(const Component& component, Handle& handle) const;
+
+  /**
+   * @brief Get the component of a handle
+   *
+   * The returned component refers to the arena, and remains valid until the dictionary
+   * is cleared or destroyed.
+   */
+  const Component&
+  get(Handle handle) const
+  {
+    BOOST_ASSERT(handle < m_components.size());
+    return m_components[handle];
+  }
+
+  size_t
+  size() const
+  {
+    return m_components.size();
+  }
+
+  /**
+   * @brief Remove all components
+   * @warning invalidates all handles obtained from this dictionary
+   */
+  void
+  clear();
+
+  /**
+   * @brief Approximate number of bytes used by the arena and the index
+   */
+  size_t
+  getMemoryUsage() const;
+
+private:
+  static size_t
+  hashWire(const Block& wire);
+
+  Component
+  store(const Block& wire);
+
+private:
+  std::vector<Component> m_components; ///< handle => component in the arena
+  std::unordered_multimap<size_t, Handle> m_index; ///< hash of the wire => handle
+  shared_ptr<Buffer> m_chunk; ///< arena chunk being filled
+  size_t m_chunkUsed;
+  size_t m_arenaSize;
+};
+
+} // namespace name
+
+/**
+ * @brief Name represented as a sequence of handles of a name::Dictionary
+ *
+ * An InternedName has 4 bytes per component, and equality, hashing and prefix tests are
+ * done on handles.  Names interned in different dictionaries must not be compared.
+ */
+class InternedName
+{
+public:
+  typedef name::Dictionary::Handle Handle;
+
+  InternedName();
+
+  /**
+   * @brief Intern all components of the name
+   */
+  explicit
+  InternedName(const Name& name, name::Dictionary& dictionary = name::Dictionary::getDefault());
+
+  size_t
+  size() const
+  {
+    return m_handles.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_handles.empty();
+  }
+
+  /**
+   * @brief Get handle of the i-th component, negative i counts from the end
+   */
+  Handle
+  get(ssize_t i) const
+  {
+    if (i < 0)
+      i += m_handles.size();
+    return m_handles.at(i);
+  }
+
+  /**
+   * @brief Get the first n components, negative n drops components from the end
+   */
+  InternedName
+  getPrefix(ssize_t nComponents) const;
+
+  bool
+  isPrefixOf(const InternedName& other) const;
+
+  /**
+   * @brief Convert back to a Name
+   *
+   * Components of the returned Name share the arena of the dictionary.
+   */
+  Name
+  toName() const;
+
+  const name::Dictionary&
+  getDictionary() const
+  {
+    BOOST_ASSERT(m_dictionary != nullptr);
+    return *m_dictionary;
+  }
+
+  bool
+  operator==(const InternedName& other) const
+  {
+    return m_handles == other.m_handles;
+  }
+
+  bool
+  operator!=(const InternedName& other) const
+  {
+    return m_handles != other.m_handles;
+  }
+
+  /**
+   * @brief Approximate number of bytes used by this name, excluding the dictionary
+   */
+  size_t
+  getMemoryUsage() const
+  {
+    return sizeof(InternedName) + m_handles.capacity() * sizeof(Handle);
+  }
+
+private:
+  std::vector<Handle> m_handles;
+  name::Dictionary* m_dictionary;
+};
+
+} // namespace ndn
+
+namespace std {
+template<>
+struct hash<ndn::InternedName>
+{
+  size_t
+  operator()(const ndn::InternedName& name) const;
+};
+
+} // namespace std
+
+#endif // NDN_NAME_DICTIONARY_HPP
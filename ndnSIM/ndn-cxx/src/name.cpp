@@ -24,13 +24,18 @@
  */
 
 #include "name.hpp"
+#include "structured-name-view.hpp"
 
 #include "util/time.hpp"
 #include "util/string-helper.hpp"
 #include "encoding/block.hpp"
 #include "encoding/encoding-buffer.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-profiler-zones.hpp"
+
 #include <boost/functional/hash.hpp>
+#include <cmath>
+#include <cstring>
 
 namespace ndn {
 
@@ -309,96 +314,157 @@ Name::equals(const Name& name) const
   if (size() != name.size())
     return false;
 
-  for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
-      return false;
-  }
-
-  return true;
+  return compare(name) == 0;
 }
 
 //==============================================================
 //Yuwei
+namespace {
+
+/** \brief Table of 2^-k and of the prefix sums 2^-1 + ... + 2^-k used by correlativity
+ */
+class CorrelativityTable
+{
+public:
+  static const size_t SIZE = 64;
+
+  CorrelativityTable()
+  {
+    m_prefixSum[0] = 0.0;
+    for (size_t k = 0; k < SIZE; ++k) {
+      m_pow2[k] = std::ldexp(1.0, -static_cast<int>(k));
+      if (k > 0)
+        m_prefixSum[k] = m_prefixSum[k - 1] + m_pow2[k];
+    }
+  }
+
+  /** \return 2^-k
+   */
+  double
+  pow2(size_t k) const
+  {
+    return k < SIZE ? m_pow2[k] : std::ldexp(1.0, -static_cast<int>(k));
+  }
+
+  /** \return 2^-1 + ... + 2^-k
+   */
+  double
+  prefixSum(size_t k) const
+  {
+    return k < SIZE ? m_prefixSum[k] : 1.0 - pow2(k);
+  }
+
+private:
+  double m_pow2[SIZE];
+  double m_prefixSum[SIZE];
+};
+
+const CorrelativityTable&
+getCorrelativityTable()
+{
+  static const CorrelativityTable table;
+  return table;
+}
+
+/** \brief Hashes of name components, stored on the stack for names of typical length
+ */
+class ComponentHashes : noncopyable
+{
+public:
+  static const size_t N_INLINE = 32;
+
+  ComponentHashes(Name::const_iterator first, Name::const_iterator last)
+    : m_size(last - first)
+    , m_hashes(m_inline)
+  {
+    if (m_size > N_INLINE) {
+      m_heap.resize(m_size);
+      m_hashes = m_heap.data();
+    }
+    for (size_t i = 0; i < m_size; ++i, ++first) {
+      // Component::equals compares only TLV-VALUE
+      m_hashes[i] = boost::hash_range(first->value_begin(), first->value_end());
+    }
+  }
+
+  size_t
+  operator[](size_t i) const
+  {
+    return m_hashes[i];
+  }
+
+private:
+  size_t m_size;
+  size_t m_inline[N_INLINE];
+  std::vector<size_t> m_heap;
+  size_t* m_hashes;
+};
+
+} // unnamed namespace
+
+double
+Name::correlativity(const_iterator first1, const_iterator last1,
+                    const_iterator first2, const_iterator last2)
+{
+  // Every pair of equal components (i, j), enumerated in row-major order with 1-based
+  // positions, is placed on a common axis at c_0 = max(i_0, j_0),
+  // c_h = c_{h-1} + max(i_h - i_{h-1}, j_h - j_{h-1}).  The common length extends the last
+  // position by the longer of the two remaining tails, and
+  //
+  //   correlativity = sum(2^-c_h) / sum_{x=1..commonLength}(2^-x)
+  //
+  // Positions are consumed as soon as they are found, so no per-pair storage is needed.
+  const size_t size1 = last1 - first1;
+  const size_t size2 = last2 - first2;
+  if (size1 == 0 || size2 == 0)
+    return 0.0;
+
+  const CorrelativityTable& table = getCorrelativityTable();
+  ComponentHashes hashes1(first1, last1);
+  ComponentHashes hashes2(first2, last2);
+
+  double lcs = 0.0;
+  bool hasCommon = false;
+  size_t lastA = 0, lastB = 0, lastC = 0;
+
+  for (size_t i = 0; i < size1; ++i) {
+    for (size_t j = 0; j < size2; ++j) {
+      if (hashes1[i] != hashes2[j] || first1[i] != first2[j])
+        continue;
+
+      size_t posA = i + 1;
+      size_t posB = j + 1;
+      size_t posC = 0;
+      if (!hasCommon) {
+        posC = std::max(posA, posB);
+        hasCommon = true;
+      }
+      else {
+        // posA never decreases; a negative difference for B is dominated by A's
+        ptrdiff_t diffA = static_cast<ptrdiff_t>(posA) - static_cast<ptrdiff_t>(lastA);
+        ptrdiff_t diffB = static_cast<ptrdiff_t>(posB) - static_cast<ptrdiff_t>(lastB);
+        posC = lastC + static_cast<size_t>(std::max(diffA, diffB));
+      }
+
+      lcs += table.pow2(posC);
+      lastA = posA;
+      lastB = posB;
+      lastC = posC;
+    }
+  }
+
+  if (!hasCommon)
+    return 0.0;
+
+  size_t commonLength = lastC + std::max(size1 - lastA, size2 - lastB);
+  return lcs / table.prefixSum(commonLength);
+}
+
 double
 Name::correlativityWith(const Name& name) const
 {
-	uint32_t MaxLength = this->size()+name.size();
-	uint16_t *Pos_A = new  uint16_t [MaxLength];
-	uint16_t *Pos_B = new  uint16_t [MaxLength];
-	uint16_t *Pos_C = new  uint16_t [MaxLength];
-	uint16_t bigger;
-	uint16_t cmnLen;
-	uint16_t x;
-
-	memset(Pos_A,0,MaxLength*sizeof(uint16_t));
-	memset(Pos_B,0,MaxLength*sizeof(uint16_t));
-	memset(Pos_C,0,MaxLength*sizeof(uint16_t));
-
-	size_t i, j;
-	size_t h, k=0;
-	//size_t tmpPosA=0, tmpPosB=0;
-
-    double lcs = 0.0;
-    double full = 0.0;
-    double co = 0.0;                 //correlativity
-	//------------------------------------------------------------------------------------------
-	//Find the position of common element
-	for(i=0; i<this->size(); i++)
-	{
-		for(j=0; j<name.size();j++)
-		{
-			if(this->at(i) == name.at(j))
-			{
-				Pos_A[k]= (i+1);  //tmpPosA;  From 1 to ...
-				Pos_B[k]= (j+1);  //tmpPosB;
-				//cout<<this->at(i)<<"------"<<name.at(j)<<endl;
-				//cout<<k<<","<<Pos_A[k]<<","<<Pos_B[k]<<endl;
-				k++;
-			}
-		}
-	}
-	/*
-    for(h=0; h<k; h++)
-    {
-    	cout<<Pos_A[h]<<"--"<<Pos_B[h]<<endl;
-    }
-    cout<<endl;*/
-	//------------------------------------------------------------------------------------------
-	if(Pos_A[0] > 0 && Pos_B[0] > 0)
-	{
-		Pos_C[0]=(Pos_A[0]>=Pos_B[0])?Pos_A[0]:Pos_B[0];
-		for(h=0; h<k-1; h++)
-		{
-			bigger=(Pos_A[h+1]-Pos_A[h])>=(Pos_B[h+1]-Pos_B[h])?Pos_A[h+1]-Pos_A[h]:Pos_B[h+1]-Pos_B[h];
-			Pos_C[h+1]=Pos_C[h]+bigger;
-		}
-		bigger=(this->size()-Pos_A[k-1])>=(name.size()-Pos_B[k-1])?(this->size()-Pos_A[k-1]):(name.size()-Pos_B[k-1]);
-		cmnLen = Pos_C[k-1]+bigger;
-		//-----------------------------------------------------------------------------------------
-	    for(h=0; h<k; h++)
-	    {
-	    	//cout<<Pos_C[h]<<"--";
-	    	lcs+=pow(2,(-Pos_C[h]));
-	    }
-	    //cout<<endl;
-	    //cout<<cmnLen<<endl;
-
-	    for(x=1; x<=cmnLen; x++)
-	     {
-	    	full+=pow(2,(-x));
-	     }
-	    //-----------------------------------------------------------------------------------------
-	    co = lcs/full;
-	}
-	else
-	{
-		co = 0.0;
-	}
-    //-----------------------------------------------------------------------------------------------
-	delete[] Pos_A;
-	delete[] Pos_B;
-	delete[] Pos_C;
-	return co;
+  NDN_PROFILE_ZONE("Name::correlativityWith");
+  return correlativity(begin(), end(), name.begin(), name.end());
 }
 
 size_t
@@ -417,42 +483,32 @@ Name::find(string part) const
 PartialName
 Name::getAppPart() const
 {
-	size_t pos = this->find("A");
-	Name ApplicationName=this->getSubName(pos+1); //we don't want "A" included
-	//std::cout<<"ApplicationName:  "<<ApplicationName<<std::endl;
-	return ApplicationName;
+	StructuredNameView view(*this);
+	if (!view.hasApplicationPart())
+		BOOST_THROW_EXCEPTION(Error("Name has no application part"));
+	return getSubName(view.applicationBegin() - begin()); //we don't want "A" included
 }
 
 //-----------------------------------------------------------------------------------------------------------
 PartialName
 Name::getSpPart() const
 {
-	size_t pos1 = this->find("S");
-	size_t pos2 = this->find("A");
-	Name SpatialName=this->getSubName(pos1+1, pos2-pos1-1); //we don't want "S" included
-	//std::cout<<"SpatialName:  "<<SpatialName<<std::endl;
-	return SpatialName;
+	StructuredNameView view(*this);
+	if (!view.hasSpatialPart())
+		BOOST_THROW_EXCEPTION(Error("Name has no spatial part"));
+	return getSubName(view.spatialBegin() - begin(), view.spatialEnd() - view.spatialBegin()); //we don't want "S" included
 }
 //-----------------------------------------------------------------------------------------------------------
 double
 Name::getAppcorrelativityWith(const Name& name) const
 {
-	  Name app1(this->getAppPart());
-	  Name app2(name.getAppPart());
-	  cout<<app1<<endl;
-	  cout<<app2<<endl;
-	  return app1.correlativityWith(app2);
+	return StructuredNameView(*this).applicationCorrelativityWith(StructuredNameView(name));
 }
 //-----------------------------------------------------------------------------------------------------------
 double
 Name::getSpcorrelativityWith(const Name& name) const
 {
-	  Name sp1, sp2;
-	  sp1=this->getSpPart();
-	  sp2=name.getSpPart();
-	  cout<<sp1.toUri()<<endl;
-	  cout<<sp2.toUri()<<endl;
-	  return sp1.correlativityWith(sp2);
+	return StructuredNameView(*this).spatialCorrelativityWith(StructuredNameView(name));
 }
 
 //==============================================================
@@ -464,15 +520,35 @@ Name::isPrefixOf(const Name& name) const
   if (size() > name.size())
     return false;
 
-  // Check if at least one of given components doesn't match.
-  for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
-      return false;
-  }
+  return compare(0, size(), name, 0, size()) == 0;
+}
 
-  return true;
+namespace {
+
+/** \brief Offset of the first byte at which [a, a + n) and [b, b + n) differ, or n if none
+ *
+ *  Compares a machine word at a time.
+ */
+size_t
+findMismatch(const uint8_t* a, const uint8_t* b, size_t n)
+{
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t wordA, wordB;
+    std::memcpy(&wordA, a + i, sizeof(wordA));
+    std::memcpy(&wordB, b + i, sizeof(wordB));
+    if (wordA != wordB)
+      break;
+  }
+  for (; i < n; ++i) {
+    if (a[i] != b[i])
+      return i;
+  }
+  return n;
 }
 
+} // unnamed namespace
+
 int
 Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t count2) const
 {
@@ -480,7 +556,32 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
   count2 = std::min(count2, other.size() - pos2);
   size_t count = std::min(count1, count2);
 
-  for (size_t i = 0; i < count; ++i) {
+  size_t i = 0;
+  if (count > 0 && m_nameBlock.hasWire() && other.m_nameBlock.hasWire()) {
+    // Components of an encoded Name lie back to back in its wire.  Both ranges parse into the
+    // same components up to the first differing byte, so the components before it are equal
+    // and only the one holding it needs to be compared in the canonical order.
+    const Block::element_container& elements1 = m_nameBlock.elements();
+    const Block::element_container& elements2 = other.m_nameBlock.elements();
+    const uint8_t* begin1 = elements1[pos1].wire();
+    const uint8_t* begin2 = elements2[pos2].wire();
+    const Block& last1 = elements1[pos1 + count - 1];
+    const Block& last2 = elements2[pos2 + count - 1];
+    size_t size1 = last1.wire() + last1.size() - begin1;
+    size_t size2 = last2.wire() + last2.size() - begin2;
+
+    size_t mismatch = findMismatch(begin1, begin2, std::min(size1, size2));
+    if (mismatch == size1 && size1 == size2)
+      i = count;
+    while (i < count) {
+      const Block& component = elements1[pos1 + i];
+      if (static_cast<size_t>(component.wire() + component.size() - begin1) > mismatch)
+        break;
+      ++i;
+    }
+  }
+
+  for (; i < count; ++i) {
     int comp = this->at(pos1 + i).compare(other.at(pos2 + i));
     if (comp != 0) { // i-th component differs
       return comp;
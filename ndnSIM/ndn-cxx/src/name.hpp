@@ -388,6 +388,16 @@ public:
   double
   correlativityWith(const Name& name) const;
 
+  /**
+   * @brief Calculate the correlativity between two ranges of name components
+   *
+   * Does not allocate memory for ranges of up to 32 components.  Components are compared
+   * by hash first and by value only when the hashes are equal.
+   */
+  static double
+  correlativity(const_iterator first1, const_iterator last1,
+                const_iterator first2, const_iterator last2);
+
   //find a element from a name and return its position
   size_t
   find(string part) const;
@@ -401,10 +411,12 @@ public:
   getSpPart() const;
 
   //Get Applicaiotn correlativity between current name and other name
+  //(0 if either name has no "A" component, see StructuredNameView)
   double
   getAppcorrelativityWith(const Name& name) const;
 
   //Get Spatial correlativity between current name and other name
+  //(0 if either name has no "S" ... "A" segment, see StructuredNameView)
   double
   getSpcorrelativityWith(const Name& name) const;
 
@@ -22,17 +22,20 @@
  */
 
 #include "key-chain.hpp"
+#include "merkle-tree.hpp"
 
 #include "../util/random.hpp"
 #include "../util/config-file.hpp"
 
 #include "sec-public-info-sqlite3.hpp"
+#include "sec-public-info-memory.hpp"
 
 #ifdef NDN_CXX_HAVE_OSX_SECURITY
 #include "sec-tpm-osx.hpp"
 #endif // NDN_CXX_HAVE_OSX_SECURITY
 
 #include "sec-tpm-file.hpp"
+#include "sec-tpm-memory.hpp"
 
 namespace ndn {
 namespace security {
@@ -61,12 +64,14 @@ const std::string DEFAULT_TPM_SCHEME = "tpm-file";
 //
 // Also, cannot use Type::SCHEME, as its value may be uninitialized
 NDN_CXX_KEYCHAIN_REGISTER_PIB(SecPublicInfoSqlite3, "pib-sqlite3", "sqlite3");
+NDN_CXX_KEYCHAIN_REGISTER_PIB(SecPublicInfoMemory, "pib-memory", "memory");
 
 #ifdef NDN_CXX_HAVE_OSX_SECURITY
 NDN_CXX_KEYCHAIN_REGISTER_TPM(SecTpmOsx, "tpm-osxkeychain", "osx-keychain");
 #endif // NDN_CXX_HAVE_OSX_SECURITY
 
 NDN_CXX_KEYCHAIN_REGISTER_TPM(SecTpmFile, "tpm-file", "file");
+NDN_CXX_KEYCHAIN_REGISTER_TPM(SecTpmMemory, "tpm-memory", "memory");
 
 template<class T>
 struct Factory
@@ -468,7 +473,7 @@ KeyChain::prepareSignatureInfo(const SigningInfo& params)
         signingCertName = m_pib->getDefaultCertificateNameForIdentity(params.getSignerName());
       }
       catch (SecPublicInfo::Error&) {
-        signingCertName = createIdentity(params.getSignerName());
+        signingCertName = createIdentity(params.getSignerName(), m_tpm->getDefaultKeyParams());
       }
 
       signingCert = m_pib->getCertificate(signingCertName);
@@ -525,6 +530,48 @@ KeyChain::sign(Interest& interest, const SigningInfo& params)
   signImpl(interest, params);
 }
 
+void
+KeyChain::signBatch(const std::vector<shared_ptr<Data>>& batch, const SigningInfo& params)
+{
+  if (batch.empty())
+    return;
+
+  Name keyName;
+  SignatureInfo sigInfo;
+  std::tie(keyName, sigInfo) = prepareSignatureInfo(params);
+
+  if (keyName == DIGEST_SHA256_IDENTITY) {
+    for (const shared_ptr<Data>& data : batch)
+      signPacketWrapper(*data, Signature(sigInfo), keyName, params.getDigestAlgorithm());
+    return;
+  }
+
+  // a leaf is the hash of what the packet would be signed over alone, see computeMerkleLeaf
+  std::vector<ConstBufferPtr> leaves;
+  leaves.reserve(batch.size());
+  for (const shared_ptr<Data>& data : batch) {
+    data->setSignature(Signature(sigInfo));
+
+    EncodingBuffer encoder;
+    data->wireEncode(encoder, true);
+    leaves.push_back(crypto::sha256(encoder.buf(), encoder.size()));
+  }
+
+  security::MerkleTree tree(std::move(leaves));
+  Block sigValue = pureSign(tree.getRoot().buf(), tree.getRoot().size(),
+                            keyName, params.getDigestAlgorithm());
+
+  for (size_t i = 0; i < batch.size(); ++i) {
+    SignatureInfo info(sigInfo);
+    info.appendTypeSpecificTlv(tree.getProof(i).wireEncode());
+    batch[i]->setSignature(Signature(info));
+
+    EncodingBuffer encoder;
+    batch[i]->wireEncode(encoder, true);
+    batch[i]->wireEncode(encoder, sigValue);
+  }
+}
+
 Block
 KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const SigningInfo& params)
 {
@@ -675,7 +722,7 @@ KeyChain::setDefaultCertificateInternal()
           defaultIdentity.append("tmp-identity")
             .append(reinterpret_cast<uint8_t*>(&random), 4);
         }
-      createIdentity(defaultIdentity);
+      createIdentity(defaultIdentity, m_tpm->getDefaultKeyParams());
       m_pib->setDefaultIdentity(defaultIdentity);
       m_pib->refreshDefaultCertificate();
     }
@@ -754,7 +801,7 @@ KeyChain::signByIdentity(const uint8_t* buffer, size_t bufferLength, const Name&
     }
   catch (SecPublicInfo::Error& e)
     {
-      signingCertificateName = createIdentity(identityName);
+      signingCertificateName = createIdentity(identityName, m_tpm->getDefaultKeyParams());
       // Ideally, no exception will be thrown out, unless something goes wrong in the TPM, which
       // is a fatal error.
     }
@@ -773,14 +820,7 @@ KeyChain::signByIdentity(const uint8_t* buffer, size_t bufferLength, const Name&
 void
 KeyChain::signWithSha256(Data& data)
 {
-  DigestSha256 sig;
-  data.setSignature(sig);
-
-  Block sigValue(tlv::SignatureValue,
-                 crypto::sha256(data.wireEncode().value(),
-                                data.wireEncode().value_size() -
-                                data.getSignature().getValue().size()));
-  data.setSignatureValue(sigValue);
+  signPacketWrapper(data, DigestSha256(), DIGEST_SHA256_IDENTITY, DIGEST_ALGORITHM_SHA256);
 }
 
 void
@@ -292,6 +292,26 @@ public:
   void
   sign(Interest& interest, const SigningInfo& params = DEFAULT_SIGNING_INFO);
 
+  /**
+   * @brief Sign a batch of Data packets with a single signature
+   *
+   * The packets are the leaves of a Merkle tree, and only the root of the tree is signed
+   * according to @p params.  Each packet gets the signature of the root as its SignatureValue,
+   * and its inclusion proof as a MerkleProof block in the SignatureInfo, so that it can be
+   * verified alone.  Bulk content, e.g. the segments of a file, thus costs one private key
+   * operation per batch rather than one per packet.
+   *
+   * SignatureSha256 packets have no private key operation to save and are signed one by one.
+   *
+   * @param batch The Data packets to sign
+   * @param params The signing parameters.
+   * @throws Error if signing fails.
+   * @see security::MerkleTree
+   */
+  void
+  signBatch(const std::vector<shared_ptr<Data>>& batch,
+            const SigningInfo& params = DEFAULT_SIGNING_INFO);
+
   /**
    * @brief Sign buffer according to the supplied signing information
    *
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "merkle-tree.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../util/crypto.hpp"
+
+namespace ndn {
+namespace security {
+
+static_assert(std::is_base_of<tlv::Error, MerkleProof::Error>::value,
+              "MerkleProof::Error must inherit from tlv::Error");
+
+MerkleProof::MerkleProof()
+  : m_leafIndex(0)
+  , m_nLeaves(1)
+{
+}
+
+MerkleProof::MerkleProof(size_t leafIndex, size_t nLeaves, std::vector<ConstBufferPtr> path)
+  : m_leafIndex(leafIndex)
+  , m_nLeaves(nLeaves)
+  , m_path(std::move(path))
+{
+}
+
+MerkleProof::MerkleProof(const Block& block)
+{
+  wireDecode(block);
+}
+
+ConstBufferPtr
+MerkleProof::computeRoot(const Buffer& leafHash) const
+{
+  if (m_leafIndex >= m_nLeaves)
+    BOOST_THROW_EXCEPTION(Error("Leaf index is out of range"));
+
+  ConstBufferPtr hash = make_shared<Buffer>(leafHash.buf(), leafHash.size());
+  std::vector<ConstBufferPtr>::const_iterator sibling = m_path.begin();
+  for (size_t index = m_leafIndex, nNodes = m_nLeaves; nNodes > 1;
+       index /= 2, nNodes = (nNodes + 1) / 2) {
+    if (index % 2 == 0 && index + 1 == nNodes)
+      continue; // moved up unchanged
+
+    if (sibling == m_path.end())
+      BOOST_THROW_EXCEPTION(Error("MerkleProof is too short"));
+
+    if (index % 2 == 0)
+      hash = MerkleTree::hashNode(*hash, **sibling);
+    else
+      hash = MerkleTree::hashNode(**sibling, *hash);
+    ++sibling;
+  }
+
+  if (sibling != m_path.end())
+    BOOST_THROW_EXCEPTION(Error("MerkleProof is too long"));
+
+  return hash;
+}
+
+template<encoding::Tag TAG>
+size_t
+MerkleProof::wireEncode(EncodingImpl<TAG>& encoder) const
+{
+  size_t totalLength = 0;
+
+  for (auto hash = m_path.rbegin(); hash != m_path.rend(); ++hash) {
+    totalLength += encoder.prependByteArrayBlock(tlv::MerkleHash, (*hash)->buf(), (*hash)->size());
+  }
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::MerkleLeafCount, m_nLeaves);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::MerkleLeafIndex, m_leafIndex);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::MerkleProof);
+  return totalLength;
+}
+
+template size_t
+MerkleProof::wireEncode<encoding::EncoderTag>(EncodingImpl<encoding::EncoderTag>& encoder) const;
+
+template size_t
+MerkleProof::wireEncode<encoding::EstimatorTag>(EncodingImpl<encoding::EstimatorTag>& encoder) const;
+
+const Block&
+MerkleProof::wireEncode() const
+{
+  if (m_wire.hasWire())
+    return m_wire;
+
+  EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+  m_wire.parse();
+
+  return m_wire;
+}
+
+void
+MerkleProof::wireDecode(const Block& wire)
+{
+  if (wire.type() != tlv::MerkleProof)
+    BOOST_THROW_EXCEPTION(Error("Unexpected TLV type when decoding MerkleProof"));
+
+  m_wire = wire;
+  m_wire.parse();
+
+  if (m_wire.elements_size() < 2 ||
+      m_wire.elements()[0].type() != tlv::MerkleLeafIndex ||
+      m_wire.elements()[1].type() != tlv::MerkleLeafCount)
+    BOOST_THROW_EXCEPTION(Error("MerkleProof does not start with MerkleLeafIndex and "
+                                "MerkleLeafCount"));
+
+  m_leafIndex = static_cast<size_t>(readNonNegativeInteger(m_wire.elements()[0]));
+  m_nLeaves = static_cast<size_t>(readNonNegativeInteger(m_wire.elements()[1]));
+
+  m_path.clear();
+  for (auto element = m_wire.elements_begin() + 2; element != m_wire.elements_end(); ++element) {
+    if (element->type() != tlv::MerkleHash)
+      BOOST_THROW_EXCEPTION(Error("Unexpected TLV type in MerkleProof"));
+    m_path.push_back(make_shared<Buffer>(element->value(), element->value_size()));
+  }
+}
+
+MerkleTree::MerkleTree(std::vector<ConstBufferPtr> leaves)
+{
+  if (leaves.empty())
+    BOOST_THROW_EXCEPTION(MerkleProof::Error("MerkleTree needs at least one leaf"));
+
+  m_levels.push_back(std::move(leaves));
+  while (m_levels.back().size() > 1) {
+    const std::vector<ConstBufferPtr>& level = m_levels.back();
+    std::vector<ConstBufferPtr> parents;
+    parents.reserve((level.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < level.size(); i += 2) {
+      parents.push_back(hashNode(*level[i], *level[i + 1]));
+    }
+    if (level.size() % 2 == 1)
+      parents.push_back(level.back());
+
+    m_levels.push_back(std::move(parents));
+  }
+}
+
+MerkleProof
+MerkleTree::getProof(size_t leafIndex) const
+{
+  if (leafIndex >= getNLeaves())
+    BOOST_THROW_EXCEPTION(MerkleProof::Error("Leaf index is out of range"));
+
+  std::vector<ConstBufferPtr> path;
+  size_t index = leafIndex;
+  for (size_t i = 0; i + 1 < m_levels.size(); ++i, index /= 2) {
+    size_t sibling = index ^ 1;
+    if (sibling < m_levels[i].size())
+      path.push_back(m_levels[i][sibling]);
+  }
+  return MerkleProof(leafIndex, getNLeaves(), std::move(path));
+}
+
+ConstBufferPtr
+MerkleTree::hashNode(const Buffer& left, const Buffer& right)
+{
+  // a leaf is the hash of a signed portion, which starts with a Name TLV and never with 0x01
+  Buffer input;
+  input.reserve(1 + left.size() + right.size());
+  input.push_back(0x01);
+  input.insert(input.end(), left.begin(), left.end());
+  input.insert(input.end(), right.begin(), right.end());
+  return crypto::sha256(input.buf(), input.size());
+}
+
+bool
+hasMerkleProof(const Signature& signature)
+{
+  const Block& info = signature.getInfo();
+  info.parse();
+  return info.find(tlv::MerkleProof) != info.elements_end();
+}
+
+MerkleProof
+getMerkleProof(const Signature& signature)
+{
+  const Block& info = signature.getInfo();
+  info.parse();
+  Block::element_const_iterator proof = info.find(tlv::MerkleProof);
+  if (proof == info.elements_end())
+    BOOST_THROW_EXCEPTION(MerkleProof::Error("SignatureInfo has no MerkleProof"));
+
+  return MerkleProof(*proof);
+}
+
+ConstBufferPtr
+computeMerkleLeaf(const Data& data)
+{
+  const Block& wire = data.wireEncode();
+  const Block& info = wire.get(tlv::SignatureInfo);
+  info.parse();
+
+  Block infoWithoutProof(tlv::SignatureInfo);
+  for (const Block& element : info.elements()) {
+    if (element.type() != tlv::MerkleProof)
+      infoWithoutProof.push_back(element);
+  }
+  infoWithoutProof.encode();
+
+  Buffer signedPortion(wire.value(), info.wire());
+  signedPortion.insert(signedPortion.end(), infoWithoutProof.begin(), infoWithoutProof.end());
+  return crypto::sha256(signedPortion.buf(), signedPortion.size());
+}
+
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_MERKLE_TREE_HPP
+#define NDN_SECURITY_MERKLE_TREE_HPP
+
+#include "../common.hpp"
+#include "../data.hpp"
+#include "../encoding/block.hpp"
+#include "../encoding/encoding-buffer.hpp"
+
+namespace ndn {
+namespace security {
+
+/** @brief Inclusion proof of a Data packet in a batch signed with one signature
+ *
+ *  The proof is carried in SignatureInfo of the Data, and the SignatureValue holds the
+ *  signature of the Merkle root of the batch:
+ *  @code
+ *  MerkleProof ::= MERKLE-PROOF-TYPE TLV-LENGTH
+ *                    MerkleLeafIndex
+ *                    MerkleLeafCount
+ *                    MerkleHash*
+ *  @endcode
+ *  MerkleHash elements are the sibling hashes on the path from the leaf up to the root.
+ *  @sa MerkleTree
+ */
+class MerkleProof
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+public:
+  MerkleProof();
+
+  MerkleProof(size_t leafIndex, size_t nLeaves, std::vector<ConstBufferPtr> path);
+
+  explicit
+  MerkleProof(const Block& block);
+
+  size_t
+  getLeafIndex() const
+  {
+    return m_leafIndex;
+  }
+
+  size_t
+  getNLeaves() const
+  {
+    return m_nLeaves;
+  }
+
+  const std::vector<ConstBufferPtr>&
+  getPath() const
+  {
+    return m_path;
+  }
+
+  /** @brief Compute the root of the tree from the hash of the leaf
+   *  @throw Error the path does not match the position of the leaf
+   */
+  ConstBufferPtr
+  computeRoot(const Buffer& leafHash) const;
+
+  template<encoding::Tag TAG>
+  size_t
+  wireEncode(EncodingImpl<TAG>& encoder) const;
+
+  const Block&
+  wireEncode() const;
+
+  /** @throw Error when an invalid TLV block supplied
+   */
+  void
+  wireDecode(const Block& wire);
+
+private:
+  size_t m_leafIndex;
+  size_t m_nLeaves;
+  std::vector<ConstBufferPtr> m_path;
+
+  mutable Block m_wire;
+};
+
+/** @brief Binary hash tree over the leaf hashes of a batch of packets
+ *
+ *  An inner node is SHA-256 of 0x01 followed by the hashes of its children.  The last node
+ *  of a level with an odd number of nodes is moved up to the next level unchanged.
+ */
+class MerkleTree
+{
+public:
+  /** @throw MerkleProof::Error there are no leaves
+   */
+  explicit
+  MerkleTree(std::vector<ConstBufferPtr> leaves);
+
+  const Buffer&
+  getRoot() const
+  {
+    return *m_levels.back().front();
+  }
+
+  size_t
+  getNLeaves() const
+  {
+    return m_levels.front().size();
+  }
+
+  MerkleProof
+  getProof(size_t leafIndex) const;
+
+  static ConstBufferPtr
+  hashNode(const Buffer& left, const Buffer& right);
+
+private:
+  std::vector<std::vector<ConstBufferPtr>> m_levels; ///< from the leaves up to the root
+};
+
+/** @return whether the SignatureInfo has a MerkleProof
+ */
+bool
+hasMerkleProof(const Signature& signature);
+
+/** @throw MerkleProof::Error the SignatureInfo has no valid MerkleProof
+ */
+MerkleProof
+getMerkleProof(const Signature& signature);
+
+/** @brief Compute the leaf hash of a Data packet signed in a batch
+ *
+ *  The leaf is SHA-256 of the signed portion of the Data with the MerkleProof taken out of
+ *  the SignatureInfo, i.e. the bytes the packet would be signed over if it was signed alone.
+ *  The Data must be encoded.
+ */
+ConstBufferPtr
+computeMerkleLeaf(const Data& data);
+
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_MERKLE_TREE_HPP
@@ -0,0 +1,361 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "sec-public-info-memory.hpp"
+
+namespace ndn {
+
+const std::string SecPublicInfoMemory::SCHEME("pib-memory");
+
+SecPublicInfoMemory::SecPublicInfoMemory(const std::string& location)
+  : SecPublicInfo(location)
+  , m_hasTpmLocator(false)
+  , m_hasDefaultIdentity(false)
+{
+}
+
+SecPublicInfoMemory::~SecPublicInfoMemory()
+{
+}
+
+void
+SecPublicInfoMemory::setTpmLocator(const std::string& tpmLocator)
+{
+  if (m_hasTpmLocator && m_tpmLocator != tpmLocator) {
+    // same as SecPublicInfoSqlite3: a different TPM invalidates all keys
+    m_identities.clear();
+    m_keys.clear();
+    m_certificates.clear();
+    m_hasDefaultIdentity = false;
+    m_defaultIdentity.clear();
+    m_defaultCertificate.reset();
+  }
+
+  m_hasTpmLocator = true;
+  m_tpmLocator = tpmLocator;
+}
+
+std::string
+SecPublicInfoMemory::getTpmLocator()
+{
+  if (!m_hasTpmLocator)
+    BOOST_THROW_EXCEPTION(SecPublicInfo::Error("TPM info does not exist"));
+
+  return m_tpmLocator;
+}
+
+std::string
+SecPublicInfoMemory::getPibLocator()
+{
+  return SCHEME + ":" + m_location;
+}
+
+bool
+SecPublicInfoMemory::doesIdentityExist(const Name& identityName)
+{
+  return m_identities.count(identityName) > 0;
+}
+
+void
+SecPublicInfoMemory::addIdentity(const Name& identityName)
+{
+  m_identities.insert(std::make_pair(identityName, Name()));
+}
+
+bool
+SecPublicInfoMemory::revokeIdentity()
+{
+  return false;
+}
+
+bool
+SecPublicInfoMemory::doesPublicKeyExist(const Name& keyName)
+{
+  if (keyName.empty())
+    BOOST_THROW_EXCEPTION(Error("Incorrect key name " + keyName.toUri()));
+
+  return m_keys.count(keyName) > 0;
+}
+
+void
+SecPublicInfoMemory::addKey(const Name& keyName, const PublicKey& publicKeyDer)
+{
+  if (keyName.empty())
+    return;
+
+  if (doesPublicKeyExist(keyName))
+    return;
+
+  addIdentity(keyName.getPrefix(-1));
+
+  KeyEntry& entry = m_keys[keyName];
+  entry.publicKey = make_shared<PublicKey>(publicKeyDer);
+}
+
+shared_ptr<PublicKey>
+SecPublicInfoMemory::getPublicKey(const Name& keyName)
+{
+  std::map<Name, KeyEntry>::const_iterator it = m_keys.find(keyName);
+  if (it == m_keys.end())
+    BOOST_THROW_EXCEPTION(Error("SecPublicInfoMemory::getPublicKey  public key does not exist"));
+
+  return make_shared<PublicKey>(*it->second.publicKey);
+}
+
+KeyType
+SecPublicInfoMemory::getPublicKeyType(const Name& keyName)
+{
+  std::map<Name, KeyEntry>::const_iterator it = m_keys.find(keyName);
+  if (it == m_keys.end())
+    return KEY_TYPE_NULL;
+
+  return it->second.publicKey->getKeyType();
+}
+
+bool
+SecPublicInfoMemory::doesCertificateExist(const Name& certificateName)
+{
+  return m_certificates.count(certificateName) > 0;
+}
+
+void
+SecPublicInfoMemory::addCertificate(const IdentityCertificate& certificate)
+{
+  const Name& certificateName = certificate.getName();
+  Name keyName = IdentityCertificate::certificateNameToPublicKeyName(certificateName);
+
+  addKey(keyName, certificate.getPublicKeyInfo());
+
+  if (doesCertificateExist(certificateName))
+    return;
+
+  m_certificates[certificateName] = make_shared<IdentityCertificate>(certificate);
+}
+
+shared_ptr<IdentityCertificate>
+SecPublicInfoMemory::getCertificate(const Name& certificateName)
+{
+  std::map<Name, shared_ptr<IdentityCertificate>>::const_iterator it =
+    m_certificates.find(certificateName);
+  if (it == m_certificates.end())
+    BOOST_THROW_EXCEPTION(Error("SecPublicInfoMemory::getCertificate  certificate does not "
+                                "exist"));
+
+  // the caller may modify the returned certificate
+  return make_shared<IdentityCertificate>(*it->second);
+}
+
+Name
+SecPublicInfoMemory::getDefaultIdentity()
+{
+  if (!m_hasDefaultIdentity)
+    BOOST_THROW_EXCEPTION(Error("SecPublicInfoMemory::getDefaultIdentity  no default identity"));
+
+  return m_defaultIdentity;
+}
+
+void
+SecPublicInfoMemory::setDefaultIdentityInternal(const Name& identityName)
+{
+  addIdentity(identityName);
+
+  m_hasDefaultIdentity = true;
+  m_defaultIdentity = identityName;
+}
+
+Name
+SecPublicInfoMemory::getDefaultKeyNameForIdentity(const Name& identityName)
+{
+  std::map<Name, Name>::const_iterator it = m_identities.find(identityName);
+  if (it == m_identities.end() || it->second.empty())
+    BOOST_THROW_EXCEPTION(Error("SecPublicInfoMemory::getDefaultKeyNameForIdentity key not "
+                                "found"));
+
+  return it->second;
+}
+
+void
+SecPublicInfoMemory::setDefaultKeyNameForIdentityInternal(const Name& keyName)
+{
+  if (!doesPublicKeyExist(keyName))
+    BOOST_THROW_EXCEPTION(Error("Key does not exist:" + keyName.toUri()));
+
+  m_identities[keyName.getPrefix(-1)] = keyName;
+}
+
+Name
+SecPublicInfoMemory::getDefaultCertificateNameForKey(const Name& keyName)
+{
+  if (keyName.empty())
+    BOOST_THROW_EXCEPTION(Error("SecPublicInfoMemory::getDefaultCertificateNameForKey wrong key"));
+
+  std::map<Name, KeyEntry>::const_iterator it = m_keys.find(keyName);
+  if (it == m_keys.end() || it->second.defaultCertificate.empty())
+    BOOST_THROW_EXCEPTION(Error("certificate not found"));
+
+  return it->second.defaultCertificate;
+}
+
+void
+SecPublicInfoMemory::setDefaultCertificateNameForKeyInternal(const Name& certificateName)
+{
+  if (!doesCertificateExist(certificateName))
+    BOOST_THROW_EXCEPTION(Error("certificate does not exist:" + certificateName.toUri()));
+
+  Name keyName = IdentityCertificate::certificateNameToPublicKeyName(certificateName);
+  m_keys[keyName].defaultCertificate = certificateName;
+}
+
+void
+SecPublicInfoMemory::getAllIdentities(std::vector<Name>& nameList, bool isDefault)
+{
+  for (const auto& identity : m_identities) {
+    bool isDefaultIdentity = m_hasDefaultIdentity && identity.first == m_defaultIdentity;
+    if (isDefaultIdentity == isDefault)
+      nameList.push_back(identity.first);
+  }
+}
+
+void
+SecPublicInfoMemory::getAllKeyNames(std::vector<Name>& nameList, bool isDefault)
+{
+  for (const auto& key : m_keys) {
+    std::map<Name, Name>::const_iterator identityIt = m_identities.find(key.first.getPrefix(-1));
+    bool isDefaultKey = identityIt != m_identities.end() && identityIt->second == key.first;
+    if (isDefaultKey == isDefault)
+      nameList.push_back(key.first);
+  }
+}
+
+void
+SecPublicInfoMemory::getAllKeyNamesOfIdentity(const Name& identity,
+                                              std::vector<Name>& nameList,
+                                              bool isDefault)
+{
+  std::map<Name, Name>::const_iterator identityIt = m_identities.find(identity);
+  if (identityIt == m_identities.end())
+    return;
+
+  // keys of an identity are adjacent in the canonical order, after the identity name
+  for (std::map<Name, KeyEntry>::const_iterator it = m_keys.upper_bound(identity);
+       it != m_keys.end() && identity.isPrefixOf(it->first); ++it) {
+    if (it->first.size() != identity.size() + 1)
+      continue;
+
+    bool isDefaultKey = identityIt->second == it->first;
+    if (isDefaultKey == isDefault)
+      nameList.push_back(it->first);
+  }
+}
+
+void
+SecPublicInfoMemory::getAllCertificateNames(std::vector<Name>& nameList, bool isDefault)
+{
+  for (const auto& certificate : m_certificates) {
+    Name keyName = IdentityCertificate::certificateNameToPublicKeyName(certificate.first);
+    std::map<Name, KeyEntry>::const_iterator keyIt = m_keys.find(keyName);
+    bool isDefaultCertificate = keyIt != m_keys.end() &&
+                                keyIt->second.defaultCertificate == certificate.first;
+    if (isDefaultCertificate == isDefault)
+      nameList.push_back(certificate.first);
+  }
+}
+
+void
+SecPublicInfoMemory::getAllCertificateNamesOfKey(const Name& keyName,
+                                                 std::vector<Name>& nameList,
+                                                 bool isDefault)
+{
+  if (keyName.empty())
+    return;
+
+  std::map<Name, KeyEntry>::const_iterator keyIt = m_keys.find(keyName);
+  if (keyIt == m_keys.end())
+    return;
+
+  for (const auto& certificate : m_certificates) {
+    if (IdentityCertificate::certificateNameToPublicKeyName(certificate.first) != keyName)
+      continue;
+
+    bool isDefaultCertificate = keyIt->second.defaultCertificate == certificate.first;
+    if (isDefaultCertificate == isDefault)
+      nameList.push_back(certificate.first);
+  }
+}
+
+void
+SecPublicInfoMemory::deleteCertificateInfo(const Name& certificateName)
+{
+  if (certificateName.empty())
+    return;
+
+  if (m_certificates.erase(certificateName) == 0)
+    return;
+
+  Name keyName = IdentityCertificate::certificateNameToPublicKeyName(certificateName);
+  std::map<Name, KeyEntry>::iterator keyIt = m_keys.find(keyName);
+  if (keyIt != m_keys.end() && keyIt->second.defaultCertificate == certificateName)
+    keyIt->second.defaultCertificate.clear();
+}
+
+void
+SecPublicInfoMemory::deletePublicKeyInfo(const Name& keyName)
+{
+  if (keyName.empty())
+    return;
+
+  std::vector<Name> certificateNames;
+  getAllCertificateNamesOfKey(keyName, certificateNames, true);
+  getAllCertificateNamesOfKey(keyName, certificateNames, false);
+  for (const Name& certificateName : certificateNames)
+    m_certificates.erase(certificateName);
+
+  m_keys.erase(keyName);
+
+  std::map<Name, Name>::iterator identityIt = m_identities.find(keyName.getPrefix(-1));
+  if (identityIt != m_identities.end() && identityIt->second == keyName)
+    identityIt->second.clear();
+}
+
+void
+SecPublicInfoMemory::deleteIdentityInfo(const Name& identityName)
+{
+  std::vector<Name> keyNames;
+  getAllKeyNamesOfIdentity(identityName, keyNames, true);
+  getAllKeyNamesOfIdentity(identityName, keyNames, false);
+  for (const Name& keyName : keyNames)
+    deletePublicKeyInfo(keyName);
+
+  m_identities.erase(identityName);
+
+  if (m_hasDefaultIdentity && m_defaultIdentity == identityName) {
+    m_hasDefaultIdentity = false;
+    m_defaultIdentity.clear();
+  }
+}
+
+std::string
+SecPublicInfoMemory::getScheme()
+{
+  return SCHEME;
+}
+
+} // namespace ndn
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_SEC_PUBLIC_INFO_MEMORY_HPP
+#define NDN_SECURITY_SEC_PUBLIC_INFO_MEMORY_HPP
+
+#include "../common.hpp"
+#include "sec-public-info.hpp"
+
+#include <map>
+
+namespace ndn {
+
+/**
+ * @brief PIB that keeps identities, keys and certificates in memory
+ *
+ * The contents have the same lifetime as the instance and are never written to disk, so
+ * creating a KeyChain with this PIB does not open or initialize a database.  It is meant for
+ * simulations and unit tests, where each KeyChain starts empty; pair it with SecTpmMemory:
+ * @code
+ * KeyChain keyChain("pib-memory:", "tpm-memory:");
+ * @endcode
+ */
+class SecPublicInfoMemory : public SecPublicInfo
+{
+public:
+  class Error : public SecPublicInfo::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : SecPublicInfo::Error(what)
+    {
+    }
+  };
+
+  explicit
+  SecPublicInfoMemory(const std::string& location = "");
+
+  virtual
+  ~SecPublicInfoMemory();
+
+  /**********************
+   * from SecPublicInfo *
+   **********************/
+
+  virtual void
+  setTpmLocator(const std::string& tpmLocator);
+
+  virtual std::string
+  getTpmLocator();
+
+  virtual std::string
+  getPibLocator();
+
+  virtual bool
+  doesIdentityExist(const Name& identityName);
+
+  virtual void
+  addIdentity(const Name& identityName);
+
+  virtual bool
+  revokeIdentity();
+
+  virtual bool
+  doesPublicKeyExist(const Name& keyName);
+
+  virtual void
+  addKey(const Name& keyName, const PublicKey& publicKeyDer);
+
+  virtual shared_ptr<PublicKey>
+  getPublicKey(const Name& keyName);
+
+  virtual KeyType
+  getPublicKeyType(const Name& keyName);
+
+  virtual bool
+  doesCertificateExist(const Name& certificateName);
+
+  virtual void
+  addCertificate(const IdentityCertificate& certificate);
+
+  virtual shared_ptr<IdentityCertificate>
+  getCertificate(const Name& certificateName);
+
+  virtual Name
+  getDefaultIdentity();
+
+  virtual Name
+  getDefaultKeyNameForIdentity(const Name& identityName);
+
+  virtual Name
+  getDefaultCertificateNameForKey(const Name& keyName);
+
+  virtual void
+  getAllIdentities(std::vector<Name>& nameList, bool isDefault);
+
+  virtual void
+  getAllKeyNames(std::vector<Name>& nameList, bool isDefault);
+
+  virtual void
+  getAllKeyNamesOfIdentity(const Name& identity, std::vector<Name>& nameList, bool isDefault);
+
+  virtual void
+  getAllCertificateNames(std::vector<Name>& nameList, bool isDefault);
+
+  virtual void
+  getAllCertificateNamesOfKey(const Name& keyName, std::vector<Name>& nameList, bool isDefault);
+
+  virtual void
+  deleteCertificateInfo(const Name& certificateName);
+
+  virtual void
+  deletePublicKeyInfo(const Name& keyName);
+
+  virtual void
+  deleteIdentityInfo(const Name& identity);
+
+private:
+  virtual void
+  setDefaultIdentityInternal(const Name& identityName);
+
+  virtual void
+  setDefaultKeyNameForIdentityInternal(const Name& keyName);
+
+  virtual void
+  setDefaultCertificateNameForKeyInternal(const Name& certificateName);
+
+  virtual std::string
+  getScheme();
+
+public:
+  static const std::string SCHEME;
+
+private:
+  struct KeyEntry
+  {
+    shared_ptr<PublicKey> publicKey;
+    Name defaultCertificate; ///< empty if the key has no default certificate
+  };
+
+  bool m_hasTpmLocator;
+  std::string m_tpmLocator;
+
+  bool m_hasDefaultIdentity;
+  Name m_defaultIdentity;
+
+  std::map<Name, Name> m_identities; ///< identity => default key name, empty if none
+  std::map<Name, KeyEntry> m_keys;
+  std::map<Name, shared_ptr<IdentityCertificate>> m_certificates;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_SEC_PUBLIC_INFO_MEMORY_HPP
@@ -86,6 +86,18 @@ SecRuleSpecific::matchSignerName(const Data& data)
     }
 }
 
+bool
+SecRuleSpecific::matchDataName(const Name& dataName)
+{
+  return m_dataRegex->match(dataName);
+}
+
+bool
+SecRuleSpecific::matchSignerName(const Name& signerName)
+{
+  return m_isExempted || m_signerRegex->match(signerName);
+}
+
 bool
 SecRuleSpecific::satisfy(const Data& data)
 {
@@ -95,8 +107,8 @@ SecRuleSpecific::satisfy(const Data& data)
 bool
 SecRuleSpecific::satisfy(const Name& dataName, const Name& signerName)
 {
-  bool isSignerMatched = m_isExempted || m_signerRegex->match(signerName);
-  return m_dataRegex->match(dataName) && isSignerMatched;
+  bool isSignerMatched = matchSignerName(signerName);
+  return matchDataName(dataName) && isSignerMatched;
 }
 
 } // namespace ndn
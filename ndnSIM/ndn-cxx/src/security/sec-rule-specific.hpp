@@ -52,6 +52,12 @@ public:
   bool
   matchSignerName(const Data& data);
 
+  bool
+  matchDataName(const Name& dataName);
+
+  bool
+  matchSignerName(const Name& signerName);
+
   bool
   satisfy(const Data& data);
 
@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "sec-tpm-memory.hpp"
+
+#include "../encoding/buffer-stream.hpp"
+
+#include "cryptopp.hpp"
+
+namespace ndn {
+
+const std::string SecTpmMemory::SCHEME("tpm-memory");
+
+SecTpmMemory::SecTpmMemory(const std::string& location)
+  : SecTpm(location)
+  , m_inTerminal(false)
+{
+}
+
+SecTpmMemory::~SecTpmMemory()
+{
+}
+
+void
+SecTpmMemory::generateKeyPairInTpm(const Name& keyName, const KeyParams& params)
+{
+  if (doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC))
+    BOOST_THROW_EXCEPTION(Error("public key exists"));
+  if (doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
+    BOOST_THROW_EXCEPTION(Error("private key exists"));
+
+  try {
+    using namespace CryptoPP;
+
+    AutoSeededRandomPool rng;
+    OBufferStream privateKeyOs;
+    OBufferStream publicKeyOs;
+
+    switch (params.getKeyType()) {
+    case KEY_TYPE_RSA: {
+      const RsaKeyParams& rsaParams = static_cast<const RsaKeyParams&>(params);
+      InvertibleRSAFunction privateKey;
+      privateKey.Initialize(rng, rsaParams.getKeySize());
+
+      FileSink privateKeySink(privateKeyOs);
+      privateKey.DEREncode(privateKeySink);
+      privateKeySink.MessageEnd();
+
+      RSAFunction publicKey(privateKey);
+      FileSink publicKeySink(publicKeyOs);
+      publicKey.DEREncode(publicKeySink);
+      publicKeySink.MessageEnd();
+      break;
+    }
+    case KEY_TYPE_ECDSA: {
+      const EcdsaKeyParams& ecdsaParams = static_cast<const EcdsaKeyParams&>(params);
+
+      CryptoPP::OID curveName;
+      switch (ecdsaParams.getKeySize()) {
+      case 384:
+        curveName = ASN1::secp384r1();
+        break;
+      default:
+        curveName = ASN1::secp256r1();
+      }
+
+      ECDSA<ECP, SHA256>::PrivateKey privateKey;
+      DL_GroupParameters_EC<ECP> cryptoParams(curveName);
+      cryptoParams.SetEncodeAsOID(true);
+      privateKey.Initialize(rng, cryptoParams);
+
+      ECDSA<ECP, SHA256>::PublicKey publicKey;
+      privateKey.MakePublicKey(publicKey);
+      publicKey.AccessGroupParameters().SetEncodeAsOID(true);
+
+      FileSink privateKeySink(privateKeyOs);
+      privateKey.DEREncode(privateKeySink);
+      privateKeySink.MessageEnd();
+
+      FileSink publicKeySink(publicKeyOs);
+      publicKey.Save(publicKeySink);
+      publicKeySink.MessageEnd();
+      break;
+    }
+    default:
+      BOOST_THROW_EXCEPTION(Error("Unsupported key type"));
+    }
+
+    KeyPair& keyPair = m_keys[keyName];
+    keyPair.privateKey = privateKeyOs.buf();
+    keyPair.publicKey = publicKeyOs.buf();
+  }
+  catch (KeyParams::Error& e) {
+    BOOST_THROW_EXCEPTION(Error(e.what()));
+  }
+  catch (CryptoPP::Exception& e) {
+    BOOST_THROW_EXCEPTION(Error(e.what()));
+  }
+}
+
+void
+SecTpmMemory::deleteKeyPairInTpm(const Name& keyName)
+{
+  m_keys.erase(keyName);
+}
+
+shared_ptr<PublicKey>
+SecTpmMemory::getPublicKeyFromTpm(const Name& keyName)
+{
+  if (!doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC))
+    BOOST_THROW_EXCEPTION(Error("Public Key does not exist"));
+
+  const Buffer& publicKey = *m_keys[keyName].publicKey;
+  return make_shared<PublicKey>(publicKey.buf(), publicKey.size());
+}
+
+std::string
+SecTpmMemory::getScheme()
+{
+  return SCHEME;
+}
+
+const KeyParams&
+SecTpmMemory::getDefaultKeyParams() const
+{
+  static const EcdsaKeyParams params;
+  return params;
+}
+
+ConstBufferPtr
+SecTpmMemory::exportPrivateKeyPkcs8FromTpm(const Name& keyName)
+{
+  if (!doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
+    BOOST_THROW_EXCEPTION(Error("private key doesn't exist"));
+
+  return m_keys[keyName].privateKey;
+}
+
+bool
+SecTpmMemory::importPrivateKeyPkcs8IntoTpm(const Name& keyName, const uint8_t* buf, size_t size)
+{
+  m_keys[keyName].privateKey = make_shared<Buffer>(buf, size);
+  return true;
+}
+
+bool
+SecTpmMemory::importPublicKeyPkcs1IntoTpm(const Name& keyName, const uint8_t* buf, size_t size)
+{
+  m_keys[keyName].publicKey = make_shared<Buffer>(buf, size);
+  return true;
+}
+
+Block
+SecTpmMemory::signInTpm(const uint8_t* data, size_t dataLength,
+                        const Name& keyName, DigestAlgorithm digestAlgorithm)
+{
+  if (!doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
+    BOOST_THROW_EXCEPTION(Error("private key doesn't exist"));
+
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    BOOST_THROW_EXCEPTION(Error("Unsupported digest algorithm"));
+
+  try {
+    using namespace CryptoPP;
+    AutoSeededRandomPool rng;
+
+    shared_ptr<PublicKey> publicKey = getPublicKeyFromTpm(keyName);
+
+    const Buffer& privateKeyDer = *m_keys[keyName].privateKey;
+    ByteQueue bytes;
+    bytes.Put(privateKeyDer.buf(), privateKeyDer.size());
+    bytes.MessageEnd();
+
+    switch (publicKey->getKeyType()) {
+    case KEY_TYPE_RSA: {
+      RSA::PrivateKey privateKey;
+      privateKey.Load(bytes);
+      RSASS<PKCS1v15, SHA256>::Signer signer(privateKey);
+
+      OBufferStream os;
+      StringSource(data, dataLength,
+                   true,
+                   new SignerFilter(rng, signer, new FileSink(os)));
+
+      return Block(tlv::SignatureValue, os.buf());
+    }
+    case KEY_TYPE_ECDSA: {
+      ECDSA<ECP, SHA256>::PrivateKey privateKey;
+      privateKey.Load(bytes);
+      ECDSA<ECP, SHA256>::Signer signer(privateKey);
+
+      OBufferStream os;
+      StringSource(data, dataLength,
+                   true,
+                   new SignerFilter(rng, signer, new FileSink(os)));
+
+      uint8_t buf[200];
+      size_t bufSize = DSAConvertSignatureFormat(buf, 200, DSA_DER,
+                                                 os.buf()->buf(), os.buf()->size(),
+                                                 DSA_P1363);
+
+      return Block(tlv::SignatureValue, make_shared<Buffer>(buf, bufSize));
+    }
+    default:
+      BOOST_THROW_EXCEPTION(Error("Unsupported key type"));
+    }
+  }
+  catch (CryptoPP::Exception& e) {
+    BOOST_THROW_EXCEPTION(Error(e.what()));
+  }
+}
+
+ConstBufferPtr
+SecTpmMemory::decryptInTpm(const uint8_t* data, size_t dataLength,
+                           const Name& keyName, bool isSymmetric)
+{
+  BOOST_THROW_EXCEPTION(Error("SecTpmMemory::decryptInTpm is not supported"));
+}
+
+ConstBufferPtr
+SecTpmMemory::encryptInTpm(const uint8_t* data, size_t dataLength,
+                           const Name& keyName, bool isSymmetric)
+{
+  BOOST_THROW_EXCEPTION(Error("SecTpmMemory::encryptInTpm is not supported"));
+}
+
+void
+SecTpmMemory::generateSymmetricKeyInTpm(const Name& keyName, const KeyParams& params)
+{
+  BOOST_THROW_EXCEPTION(Error("SecTpmMemory::generateSymmetricKeyInTpm is not supported"));
+}
+
+bool
+SecTpmMemory::doesKeyExistInTpm(const Name& keyName, KeyClass keyClass)
+{
+  std::map<Name, KeyPair>::const_iterator it = m_keys.find(keyName);
+  if (it == m_keys.end())
+    return false;
+
+  switch (keyClass) {
+  case KEY_CLASS_PUBLIC:
+    return it->second.publicKey != nullptr;
+  case KEY_CLASS_PRIVATE:
+    return it->second.privateKey != nullptr;
+  default:
+    return false;
+  }
+}
+
+bool
+SecTpmMemory::generateRandomBlock(uint8_t* res, size_t size)
+{
+  try {
+    CryptoPP::AutoSeededRandomPool rng;
+    rng.GenerateBlock(res, size);
+    return true;
+  }
+  catch (CryptoPP::Exception& e) {
+    return false;
+  }
+}
+
+} // namespace ndn
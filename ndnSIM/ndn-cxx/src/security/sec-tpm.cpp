@@ -47,6 +47,13 @@ SecTpm::getTpmLocator()
   return this->getScheme() + ":" + m_location;
 }
 
+const KeyParams&
+SecTpm::getDefaultKeyParams() const
+{
+  static const RsaKeyParams params;
+  return params;
+}
+
 ConstBufferPtr
 SecTpm::exportPrivateKeyPkcs5FromTpm(const Name& keyName, const string& passwordStr)
 {
@@ -221,6 +221,17 @@ public:
   virtual void
   addAppToAcl(const Name& keyName, KeyClass keyClass, const std::string& appPath, AclType acl) = 0;
 
+  /**
+   * @brief Get parameters of the keys for identities that KeyChain creates on its own
+   *
+   * KeyChain creates an identity when asked to sign as one without a certificate, and a
+   * temporary default identity when the PIB has none.
+   *
+   * @return RSA parameters with the default key size, unless overridden by the TPM
+   */
+  virtual const KeyParams&
+  getDefaultKeyParams() const;
+
   /**
    * @brief Export a private key in PKCS#5 format
    *
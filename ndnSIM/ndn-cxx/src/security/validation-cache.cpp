@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "validation-cache.hpp"
+
+namespace ndn {
+
+ValidationCache::ValidationCache(size_t capacity, const time::seconds& maxLifetime)
+  : m_capacity(std::max<size_t>(capacity, 1))
+  , m_maxLifetime(maxLifetime)
+{
+}
+
+std::string
+ValidationCache::makeKey(const uint8_t* digest, size_t digestSize, const Certificate& certificate)
+{
+  // the digest, then the certificate name, which includes its version
+  const Block& certificateName = certificate.getName().wireEncode();
+
+  std::string key(reinterpret_cast<const char*>(digest), digestSize);
+  key.append(reinterpret_cast<const char*>(certificateName.wire()), certificateName.size());
+  return key;
+}
+
+void
+ValidationCache::insert(const Data& data, const Certificate& certificate)
+{
+  // implicit digest of the Data
+  const name::Component& digest = data.getFullName().get(-1);
+  insert(makeKey(digest.value(), digest.value_size(), certificate), certificate);
+}
+
+bool
+ValidationCache::contains(const Data& data, const Certificate& certificate)
+{
+  const name::Component& digest = data.getFullName().get(-1);
+  return contains(makeKey(digest.value(), digest.value_size(), certificate));
+}
+
+void
+ValidationCache::insertMerkleRoot(const Buffer& root, const Certificate& certificate)
+{
+  insert(makeKey(root.buf(), root.size(), certificate), certificate);
+}
+
+bool
+ValidationCache::containsMerkleRoot(const Buffer& root, const Certificate& certificate)
+{
+  return contains(makeKey(root.buf(), root.size(), certificate));
+}
+
+void
+ValidationCache::insert(std::string key, const Certificate& certificate)
+{
+  time::system_clock::TimePoint expiry = std::min(time::system_clock::now() + m_maxLifetime,
+                                                  certificate.getNotAfter());
+
+  auto found = m_index.find(key);
+  if (found != m_index.end()) {
+    found->second->expiry = expiry;
+    m_entries.splice(m_entries.begin(), m_entries, found->second);
+    return;
+  }
+
+  if (m_index.size() >= m_capacity) {
+    m_index.erase(m_entries.back().key);
+    m_entries.pop_back();
+  }
+
+  m_entries.push_front(Entry{key, expiry});
+  m_index.emplace(std::move(key), m_entries.begin());
+}
+
+bool
+ValidationCache::contains(const std::string& key)
+{
+  auto found = m_index.find(key);
+  if (found == m_index.end())
+    return false;
+
+  EntryList::iterator entry = found->second;
+  if (entry->expiry < time::system_clock::now()) {
+    m_index.erase(found);
+    m_entries.erase(entry);
+    return false;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, entry);
+  return true;
+}
+
+void
+ValidationCache::clear()
+{
+  m_index.clear();
+  m_entries.clear();
+}
+
+} // namespace ndn
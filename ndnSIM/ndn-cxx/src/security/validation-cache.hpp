@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_VALIDATION_CACHE_HPP
+#define NDN_SECURITY_VALIDATION_CACHE_HPP
+
+#include "../common.hpp"
+#include "../data.hpp"
+#include "certificate.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Cache of Data packets whose signatures were verified
+ *
+ * An entry records that the Data with an implicit digest was verified with a certificate.
+ * The digest covers the whole Data including its signature, so the same Data received again,
+ * e.g. from another face or after a retransmission, needs no public key operation.
+ *
+ * Validators consult the cache only after they found the signing certificate among their
+ * trust anchors or in their CertificateCache, so an entry is not used longer than its
+ * certificate is cached.  In addition, an entry expires after maxLifetime or when the
+ * certificate is no longer valid, whichever comes first.  When the cache is full, the least
+ * recently used entry is evicted.
+ *
+ * For Data signed in a batch, the Merkle root of the batch can be recorded as well, so that
+ * the other packets of the batch need no public key operation either.
+ */
+class ValidationCache : noncopyable
+{
+public:
+  explicit
+  ValidationCache(size_t capacity = 1000, const time::seconds& maxLifetime = time::seconds(3600));
+
+  /**
+   * @brief Record that the signature of the Data was verified with the certificate
+   */
+  void
+  insert(const Data& data, const Certificate& certificate);
+
+  /**
+   * @return whether the signature of the Data was verified with the certificate before
+   *         and the entry has not expired
+   */
+  bool
+  contains(const Data& data, const Certificate& certificate);
+
+  /**
+   * @brief Record that the signature of the Merkle root was verified with the certificate
+   */
+  void
+  insertMerkleRoot(const Buffer& root, const Certificate& certificate);
+
+  bool
+  containsMerkleRoot(const Buffer& root, const Certificate& certificate);
+
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+private:
+  static std::string
+  makeKey(const uint8_t* digest, size_t digestSize, const Certificate& certificate);
+
+  void
+  insert(std::string key, const Certificate& certificate);
+
+  bool
+  contains(const std::string& key);
+
+private:
+  struct Entry
+  {
+    std::string key;
+    time::system_clock::TimePoint expiry;
+  };
+  typedef std::list<Entry> EntryList;
+
+  size_t m_capacity;
+  time::seconds m_maxLifetime;
+  EntryList m_entries; ///< most recently used first
+  std::unordered_map<std::string, EntryList::iterator> m_index;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_VALIDATION_CACHE_HPP
@@ -379,6 +379,8 @@ ValidatorConfig::reset()
 {
   if (static_cast<bool>(m_certificateCache))
     m_certificateCache->reset();
+  if (m_validationCache != nullptr)
+    m_validationCache->clear();
   m_interestRules.clear();
   m_dataRules.clear();
 
@@ -790,11 +792,8 @@ ValidatorConfig::checkSignature(const Packet& packet,
 
   if (static_cast<bool>(trustedCert))
     {
-      if (verifySignature(packet, signature, trustedCert->getPublicKeyInfo()))
-        return onValidated(packet.shared_from_this());
-      else
-        return onValidationFailed(packet.shared_from_this(),
-                                  "Cannot verify signature");
+      return verifySignature(packet.shared_from_this(), *trustedCert,
+                             onValidated, onValidationFailed, "Cannot verify signature");
     }
   else
     {
@@ -852,12 +851,9 @@ ValidatorConfig::onCertValidated(const shared_ptr<const Data>& signCertificate,
       if (static_cast<bool>(m_certificateCache))
         m_certificateCache->insertCertificate(certificate);
 
-      if (verifySignature(*packet, certificate->getPublicKeyInfo()))
-        return onValidated(packet);
-      else
-        return onValidationFailed(packet,
-                                  "Cannot verify signature: " +
-                                  packet->getName().toUri());
+      return verifySignature(packet, *certificate,
+                             onValidated, onValidationFailed,
+                             "Cannot verify signature: " + packet->getName().toUri());
     }
   else
     {
@@ -79,12 +79,9 @@ ValidatorRegex::onCertificateValidated(const shared_ptr<const Data>& signCertifi
       if (static_cast<bool>(m_certificateCache))
         m_certificateCache->insertCertificate(certificate);
 
-      if (verifySignature(*data, certificate->getPublicKeyInfo()))
-        return onValidated(data);
-      else
-        return onValidationFailed(data,
-                                  "Cannot verify signature: " +
-                                  data->getName().toUri());
+      return verifySignature(data, *certificate,
+                             onValidated, onValidationFailed,
+                             "Cannot verify signature: " + data->getName().toUri());
     }
   else
     {
@@ -154,12 +151,9 @@ ValidatorRegex::checkPolicy(const Data& data,
 
               if (static_cast<bool>(trustedCert))
                 {
-                  if (verifySignature(data, data.getSignature(), trustedCert->getPublicKeyInfo()))
-                    return onValidated(data.shared_from_this());
-                  else
-                    return onValidationFailed(data.shared_from_this(),
-                                              "Cannot verify signature: " +
-                                              data.getName().toUri());
+                  return verifySignature(data.shared_from_this(), *trustedCert,
+                                         onValidated, onValidationFailed,
+                                         "Cannot verify signature: " + data.getName().toUri());
                 }
               else
                 {
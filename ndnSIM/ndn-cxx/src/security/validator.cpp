@@ -36,11 +36,13 @@ static OID SECP384R1("1.3.132.0.34");
 
 Validator::Validator(Face* face)
   : m_face(face)
+  , m_validationCache(make_shared<ValidationCache>())
 {
 }
 
 Validator::Validator(Face& face)
   : m_face(&face)
+  , m_validationCache(make_shared<ValidationCache>())
 {
 }
 
@@ -102,16 +104,42 @@ Validator::onData(const Interest& interest,
            nextStep->m_nSteps);
 }
 
+/**
+ * @return the Merkle root of the batch of a Data signed in a batch, or nullptr if its
+ *         MerkleProof is invalid
+ */
+static ConstBufferPtr
+computeMerkleRoot(const Data& data)
+{
+  try {
+    security::MerkleProof proof = security::getMerkleProof(data.getSignature());
+    return proof.computeRoot(*security::computeMerkleLeaf(data));
+  }
+  catch (const tlv::Error&) {
+    return nullptr;
+  }
+}
+
 bool
 Validator::verifySignature(const Data& data, const PublicKey& key)
 {
   if (!data.getSignature().hasKeyLocator())
     return false;
 
+  return verifySignature(data, data.getSignature(), key);
+}
+
+bool
+Validator::verifySignature(const Data& data, const Signature& sig, const PublicKey& key)
+{
+  if (security::hasMerkleProof(sig)) {
+    ConstBufferPtr root = computeMerkleRoot(data);
+    return root != nullptr && verifySignature(root->buf(), root->size(), sig, key);
+  }
+
   return verifySignature(data.wireEncode().value(),
-                         data.wireEncode().value_size() -
-                         data.getSignature().getValue().size(),
-                         data.getSignature(), key);
+                         data.wireEncode().value_size() - data.getSignature().getValue().size(),
+                         sig, key);
 }
 
 bool
@@ -142,6 +170,105 @@ Validator::verifySignature(const Interest& interest, const PublicKey& key)
     }
 }
 
+bool
+Validator::verifySignature(const Data& data, const Signature& sig, const Certificate& certificate)
+{
+  if (m_validationCache != nullptr && m_validationCache->contains(data, certificate))
+    return true;
+
+  if (security::hasMerkleProof(sig)) {
+    ConstBufferPtr root = computeMerkleRoot(data);
+    if (root == nullptr)
+      return false;
+
+    if (m_validationCache == nullptr || !m_validationCache->containsMerkleRoot(*root, certificate)) {
+      if (!verifySignature(root->buf(), root->size(), sig, certificate.getPublicKeyInfo()))
+        return false;
+
+      if (m_validationCache != nullptr)
+        m_validationCache->insertMerkleRoot(*root, certificate);
+    }
+  }
+  else if (!verifySignature(data, sig, certificate.getPublicKeyInfo()))
+    return false;
+
+  if (m_validationCache != nullptr)
+    m_validationCache->insert(data, certificate);
+  return true;
+}
+
+void
+Validator::verifySignature(const shared_ptr<const Data>& data, const Certificate& certificate,
+                           const VerificationPool::Continuation& continuation)
+{
+  if (m_verificationPool == nullptr)
+    return continuation(verifySignature(*data, certificate));
+
+  if (!data->getSignature().hasKeyLocator())
+    return continuation(false);
+
+  shared_ptr<ValidationCache> cache = m_validationCache;
+  if (cache != nullptr && cache->contains(*data, certificate))
+    // still goes through the pool, so that the continuations stay in order
+    return m_verificationPool->submit([] { return true; }, continuation);
+
+  // the workers only read the encoding, it must not be built on their threads
+  data->wireEncode();
+
+  PublicKey publicKey = certificate.getPublicKeyInfo();
+  auto signer = make_shared<Certificate>(certificate);
+
+  if (security::hasMerkleProof(data->getSignature())) {
+    // hashing the batch is cheap, the root is verified once
+    ConstBufferPtr root = computeMerkleRoot(*data);
+    if (root == nullptr)
+      return continuation(false);
+
+    if (cache != nullptr && cache->containsMerkleRoot(*root, certificate)) {
+      cache->insert(*data, certificate);
+      return m_verificationPool->submit([] { return true; }, continuation);
+    }
+
+    Signature sig = data->getSignature();
+    return m_verificationPool->submit([=] {
+                                        return verifySignature(root->buf(), root->size(),
+                                                               sig, publicKey);
+                                      },
+                                      [=] (bool isVerified) {
+                                        if (isVerified && cache != nullptr) {
+                                          cache->insertMerkleRoot(*root, *signer);
+                                          cache->insert(*data, *signer);
+                                        }
+                                        continuation(isVerified);
+                                      });
+  }
+
+  m_verificationPool->submit([=] { return verifySignature(*data, publicKey); },
+                             [=] (bool isVerified) {
+                               if (isVerified && cache != nullptr)
+                                 cache->insert(*data, *signer);
+                               continuation(isVerified);
+                             });
+}
+
+void
+Validator::verifySignature(const shared_ptr<const Interest>& interest,
+                           const Certificate& certificate,
+                           const VerificationPool::Continuation& continuation)
+{
+  if (m_verificationPool == nullptr)
+    return continuation(verifySignature(*interest, certificate));
+
+  if (interest->getName().size() < 2)
+    return continuation(false);
+
+  interest->getName().wireEncode();
+
+  PublicKey publicKey = certificate.getPublicKeyInfo();
+  m_verificationPool->submit([=] { return verifySignature(*interest, publicKey); },
+                             continuation);
+}
+
 bool
 Validator::verifySignature(const uint8_t* buf,
                            const size_t size,
@@ -35,6 +35,9 @@
 #include "digest-sha256.hpp"
 #include "validation-request.hpp"
 #include "identity-certificate.hpp"
+#include "validation-cache.hpp"
+#include "verification-pool.hpp"
+#include "merkle-tree.hpp"
 
 namespace ndn {
 
@@ -124,16 +127,16 @@ public:
     return verifySignature(blob.buf(), blob.size(), sig, publicKey);
   }
 
-  /// @brief Verify the data using the publicKey against the SHA256-RSA signature.
+  /**
+   * @brief Verify the data using the publicKey against the SHA256-RSA signature.
+   *
+   * If the SignatureInfo has a MerkleProof, the signature is verified over the Merkle root
+   * computed from the Data and the proof.
+   */
   static bool
   verifySignature(const Data& data,
                   const Signature& sig,
-                  const PublicKey& publicKey)
-  {
-    return verifySignature(data.wireEncode().value(),
-                           data.wireEncode().value_size() - data.getSignature().getValue().size(),
-                           sig, publicKey);
-  }
+                  const PublicKey& publicKey);
 
   /** @brief Verify the interest using the publicKey against the SHA256-RSA signature.
    *
@@ -200,7 +203,110 @@ public:
   static bool
   verifySignature(const uint8_t* buf, const size_t size, const DigestSha256& sig);
 
+  /**
+   * @brief Set the cache of verified Data signatures
+   *
+   * @param cache The cache, or nullptr to verify every Data.  By default, the validator has a
+   *              ValidationCache of its own.
+   */
+  void
+  setValidationCache(shared_ptr<ValidationCache> cache)
+  {
+    m_validationCache = std::move(cache);
+  }
+
+  shared_ptr<ValidationCache>
+  getValidationCache() const
+  {
+    return m_validationCache;
+  }
+
+  /**
+   * @brief Set the worker threads for public key signature verification
+   *
+   * With a pool, the public key operations of validate() run on the worker threads, and
+   * onValidated or onValidationFailed is invoked later from the io_service of the pool, in the
+   * order in which the packets reached verification.  Failures found before the verification,
+   * e.g. a missing KeyLocator, are still reported immediately.  The validator must outlive the
+   * pending verifications.
+   *
+   * @param pool The pool, or nullptr (default) to verify on the calling thread
+   */
+  void
+  setVerificationPool(shared_ptr<VerificationPool> pool)
+  {
+    m_verificationPool = std::move(pool);
+  }
+
+  shared_ptr<VerificationPool>
+  getVerificationPool() const
+  {
+    return m_verificationPool;
+  }
+
 protected:
+  /**
+   * @brief Verify the signature of the Data with the public key of the certificate
+   *
+   * The verification is skipped if the validation cache shows that the same Data, or for Data
+   * signed in a batch another Data of the batch, was verified with the same certificate before.
+   * The certificate must be trusted already.
+   */
+  bool
+  verifySignature(const Data& data, const Signature& sig, const Certificate& certificate);
+
+  bool
+  verifySignature(const Data& data, const Certificate& certificate)
+  {
+    return verifySignature(data, data.getSignature(), certificate);
+  }
+
+  /// @brief Verify the signed Interest with the certificate, signed Interests are not cached
+  bool
+  verifySignature(const Interest& interest, const Signature& sig, const Certificate& certificate)
+  {
+    return verifySignature(interest, sig, certificate.getPublicKeyInfo());
+  }
+
+  bool
+  verifySignature(const Interest& interest, const Certificate& certificate)
+  {
+    return verifySignature(interest, certificate.getPublicKeyInfo());
+  }
+
+  /**
+   * @brief Verify the signature with the certificate and pass the result to the continuation
+   *
+   * The continuation is invoked before return if there is no verification pool or the packet
+   * cannot be verified, and from the io_service of the pool otherwise.
+   */
+  void
+  verifySignature(const shared_ptr<const Data>& data, const Certificate& certificate,
+                  const VerificationPool::Continuation& continuation);
+
+  void
+  verifySignature(const shared_ptr<const Interest>& interest, const Certificate& certificate,
+                  const VerificationPool::Continuation& continuation);
+
+  /**
+   * @brief Verify the signature with the certificate, then call onValidated(packet) or
+   *        onValidationFailed(packet, failureInfo)
+   */
+  template<class Packet, class OnValidated, class OnFailed>
+  void
+  verifySignature(const shared_ptr<const Packet>& packet, const Certificate& certificate,
+                  const OnValidated& onValidated, const OnFailed& onValidationFailed,
+                  const std::string& failureInfo)
+  {
+    verifySignature(packet, certificate,
+                    [=] (bool isVerified) {
+                      if (isVerified)
+                        onValidated(packet);
+                      else
+                        onValidationFailed(packet, failureInfo);
+                    });
+  }
+
   /**
    * @brief Check the Data against policy and return the next validation step if necessary.
    *
@@ -313,6 +419,8 @@ protected:
 
 protected:
   Face* m_face;
+  shared_ptr<ValidationCache> m_validationCache;
+  shared_ptr<VerificationPool> m_verificationPool;
 };
 
 } // namespace ndn
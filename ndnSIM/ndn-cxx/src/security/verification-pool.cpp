@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "verification-pool.hpp"
+
+namespace ndn {
+
+VerificationPool::VerificationPool(boost::asio::io_service& ioService, size_t nThreads)
+  : m_ioService(ioService)
+  , m_isStopped(false)
+{
+  if (nThreads == 0)
+    nThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  for (size_t i = 0; i < nThreads; ++i)
+    m_threads.emplace_back(&VerificationPool::run, this);
+}
+
+VerificationPool::~VerificationPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopped = true;
+  }
+  m_hasWork.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+void
+VerificationPool::submit(const Task& task, const Continuation& continuation)
+{
+  auto job = make_shared<Job>();
+  job->task = task;
+  job->continuation = continuation;
+  job->isDone = false;
+  job->result = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(job);
+    m_submitted.push_back(job);
+  }
+  m_hasWork.notify_one();
+}
+
+void
+VerificationPool::run()
+{
+  while (true) {
+    shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_hasWork.wait(lock, [this] { return m_isStopped || !m_queue.empty(); });
+      if (m_isStopped)
+        return;
+
+      job = m_queue.front();
+      m_queue.pop_front();
+    }
+
+    bool result = false;
+    try {
+      result = job->task();
+    }
+    catch (const std::exception&) {
+      result = false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    job->result = result;
+    job->isDone = true;
+    postCompleted();
+  }
+}
+
+void
+VerificationPool::postCompleted()
+{
+  // io_service runs posted handlers in the order they were posted
+  while (!m_submitted.empty() && m_submitted.front()->isDone) {
+    const Job& job = *m_submitted.front();
+    m_ioService.post(bind(job.continuation, job.result));
+    m_submitted.pop_front();
+  }
+}
+
+} // namespace ndn
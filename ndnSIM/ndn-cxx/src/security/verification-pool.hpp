@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_VERIFICATION_POOL_HPP
+#define NDN_SECURITY_VERIFICATION_POOL_HPP
+
+#include "../common.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+
+/**
+ * @brief Worker threads that run signature verifications for validators
+ *
+ * A verification task is submitted together with its continuation.  The task runs on one of
+ * the worker threads, and the continuation receives the result on the thread that runs the
+ * io_service, i.e. where face callbacks run.  Continuations are invoked in the order the tasks
+ * were submitted, regardless of the order in which the workers finish them.
+ *
+ * A task must not use objects that may be modified by the io_service thread while it runs.
+ *
+ * Tasks that did not start before the pool is destroyed are dropped without invoking their
+ * continuations.
+ */
+class VerificationPool : noncopyable
+{
+public:
+  typedef function<bool()> Task;
+  typedef function<void(bool)> Continuation;
+
+  /**
+   * @param ioService io_service where continuations are posted
+   * @param nThreads number of worker threads, 0 to use the number of hardware threads
+   */
+  explicit
+  VerificationPool(boost::asio::io_service& ioService, size_t nThreads = 0);
+
+  ~VerificationPool();
+
+  /**
+   * @brief Run the task on a worker thread, then post its continuation to the io_service
+   *
+   * An exception thrown from the task is a failed verification.  Thread safe.
+   */
+  void
+  submit(const Task& task, const Continuation& continuation);
+
+  size_t
+  getNThreads() const
+  {
+    return m_threads.size();
+  }
+
+private:
+  struct Job
+  {
+    Task task;
+    Continuation continuation;
+    bool isDone;
+    bool result;
+  };
+
+  void
+  run();
+
+  /**
+   * @brief Post the continuations of the completed jobs at the front of m_submitted
+   * @pre m_mutex is locked
+   */
+  void
+  postCompleted();
+
+private:
+  boost::asio::io_service& m_ioService;
+
+  std::mutex m_mutex;
+  std::condition_variable m_hasWork;
+  bool m_isStopped;
+  std::deque<shared_ptr<Job>> m_queue;     ///< jobs that have not started yet
+  std::deque<shared_ptr<Job>> m_submitted; ///< jobs whose continuations are not posted yet
+
+  std::vector<std::thread> m_threads;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_VERIFICATION_POOL_HPP
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "structured-name-view.hpp"
+
+namespace ndn {
+
+static inline bool
+isSingleCharacter(const name::Component& component, char c)
+{
+  return component.type() == tlv::NameComponent &&
+         component.value_size() == 1 &&
+         *component.value_begin() == static_cast<uint8_t>(c);
+}
+
+bool
+StructuredNameView::isSpatialMarker(const name::Component& component)
+{
+  return isSingleCharacter(component, 'S');
+}
+
+bool
+StructuredNameView::isApplicationMarker(const name::Component& component)
+{
+  return isSingleCharacter(component, 'A');
+}
+
+StructuredNameView::StructuredNameView()
+  : m_name(nullptr)
+  , m_spatialBegin(Name::npos)
+  , m_spatialEnd(Name::npos)
+  , m_applicationBegin(Name::npos)
+{
+}
+
+StructuredNameView::StructuredNameView(const Name& name)
+  : m_name(&name)
+  , m_spatialBegin(Name::npos)
+  , m_spatialEnd(Name::npos)
+  , m_applicationBegin(Name::npos)
+{
+  size_t spatialMarker = Name::npos;
+  for (size_t i = 0; i < name.size(); ++i) {
+    const name::Component& component = name[i];
+    if (spatialMarker == Name::npos && isSpatialMarker(component)) {
+      spatialMarker = i;
+    }
+    else if (isApplicationMarker(component)) {
+      m_applicationBegin = i + 1;
+      if (spatialMarker != Name::npos) {
+        m_spatialBegin = spatialMarker + 1;
+        m_spatialEnd = i;
+      }
+      break;
+    }
+  }
+}
+
+double
+StructuredNameView::spatialCorrelativityWith(const StructuredNameView& other) const
+{
+  if (!hasSpatialPart() || !other.hasSpatialPart())
+    return 0.0;
+
+  return Name::correlativity(spatialBegin(), spatialEnd(),
+                             other.spatialBegin(), other.spatialEnd());
+}
+
+double
+StructuredNameView::applicationCorrelativityWith(const StructuredNameView& other) const
+{
+  if (!hasApplicationPart() || !other.hasApplicationPart())
+    return 0.0;
+
+  return Name::correlativity(applicationBegin(), applicationEnd(),
+                             other.applicationBegin(), other.applicationEnd());
+}
+
+} // namespace ndn
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_STRUCTURED_NAME_VIEW_HPP
+#define NDN_STRUCTURED_NAME_VIEW_HPP
+
+#include "name.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Non-owning view of a structured name /.../S/<spatial>/A/<application>
+ *
+ * The spatial segment is the range between the first "S" and the first "A" component,
+ * the application segment is everything after the first "A" component.  Both offsets are
+ * located once on construction by comparing component values, without building strings.
+ *
+ * The view refers to the Name it was created from, which must not be modified or
+ * destroyed while the view is in use.
+ */
+class StructuredNameView
+{
+public:
+  /**
+   * @brief Create an empty view (no spatial or application segment)
+   */
+  StructuredNameView();
+
+  explicit
+  StructuredNameView(const Name& name);
+
+  const Name&
+  getName() const
+  {
+    BOOST_ASSERT(m_name != nullptr);
+    return *m_name;
+  }
+
+  /**
+   * @return true if the name has both "S" and "A" markers (in this order)
+   */
+  bool
+  hasSpatialPart() const
+  {
+    return m_spatialBegin != Name::npos;
+  }
+
+  /**
+   * @return true if the name has an "A" marker
+   */
+  bool
+  hasApplicationPart() const
+  {
+    return m_applicationBegin != Name::npos;
+  }
+
+  Name::const_iterator
+  spatialBegin() const
+  {
+    return m_name->begin() + m_spatialBegin;
+  }
+
+  Name::const_iterator
+  spatialEnd() const
+  {
+    return m_name->begin() + m_spatialEnd;
+  }
+
+  Name::const_iterator
+  applicationBegin() const
+  {
+    return m_name->begin() + m_applicationBegin;
+  }
+
+  Name::const_iterator
+  applicationEnd() const
+  {
+    return m_name->end();
+  }
+
+  /**
+   * @brief Correlativity between spatial segments
+   * @return 0 if either name has no spatial segment
+   */
+  double
+  spatialCorrelativityWith(const StructuredNameView& other) const;
+
+  /**
+   * @brief Correlativity between application segments
+   * @return 0 if either name has no application segment
+   */
+  double
+  applicationCorrelativityWith(const StructuredNameView& other) const;
+
+  /**
+   * @return true if the component is the spatial marker "S"
+   */
+  static bool
+  isSpatialMarker(const name::Component& component);
+
+  /**
+   * @return true if the component is the application marker "A"
+   */
+  static bool
+  isApplicationMarker(const name::Component& component);
+
+private:
+  const Name* m_name;
+  size_t m_spatialBegin;     ///< first component after "S", or npos
+  size_t m_spatialEnd;       ///< offset of "A"
+  size_t m_applicationBegin; ///< first component after "A", or npos
+};
+
+} // namespace ndn
+
+#endif // NDN_STRUCTURED_NAME_VIEW_HPP
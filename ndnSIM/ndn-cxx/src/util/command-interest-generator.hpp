@@ -26,6 +26,7 @@
 #include "../security/key-chain.hpp"
 #include "../util/time.hpp"
 #include "../util/random.hpp"
+#include "../util/crypto.hpp"
 
 namespace ndn {
 
@@ -58,6 +59,15 @@ public:
   void
   generateWithIdentity(Interest& interest, const Name& identity);
 
+  /**
+   * @brief sign the command with HMAC-SHA256 keyed with a secret shared with the validator
+   *
+   * @param keyName KeyLocator.Name, the key name given to the validator
+   * @sa CommandInterestValidator::addInterestHmacRule
+   */
+  void
+  generateWithHmac(Interest& interest, const Name& keyName, const Buffer& key);
+
 private:
   time::milliseconds m_lastTimestamp;
   KeyChain m_keyChain;
@@ -83,6 +93,31 @@ CommandInterestGenerator::generateWithIdentity(Interest& interest, const Name& i
                   security::SigningInfo(security::SigningInfo::SIGNER_TYPE_ID, identity));
 }
 
+inline void
+CommandInterestGenerator::generateWithHmac(Interest& interest, const Name& keyName,
+                                           const Buffer& key)
+{
+  time::milliseconds timestamp = time::toUnixTimestamp(time::system_clock::now());
+  if (timestamp <= m_lastTimestamp)
+    timestamp = m_lastTimestamp + time::milliseconds(1);
+  m_lastTimestamp = timestamp;
+
+  SignatureInfo info(tlv::SignatureHmacWithSha256, KeyLocator(keyName));
+
+  Name signedName = interest.getName();
+  signedName
+    .append(name::Component::fromNumber(timestamp.count()))        // timestamp
+    .append(name::Component::fromNumber(random::generateWord64())) // nonce
+    .append(info.wireEncode());                                    // signatureInfo
+
+  ConstBufferPtr digest = crypto::hmacSha256(key.buf(), key.size(),
+                                             signedName.wireEncode().value(),
+                                             signedName.wireEncode().value_size());
+  Block sigValue(tlv::SignatureValue, digest);
+  sigValue.encode();
+  signedName.append(sigValue);                                     // signatureValue
+  interest.setName(signedName);
+}
 
 } // namespace ndn
 
@@ -65,6 +65,24 @@ sha256(const uint8_t* data, size_t dataLength)
     }
 }
 
+ConstBufferPtr
+hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t dataLength)
+{
+  try
+    {
+      using namespace CryptoPP;
+
+      HMAC<SHA256> hmac(key, keyLength);
+      OBufferStream os;
+      StringSource(data, dataLength, true, new HashFilter(hmac, new FileSink(os)));
+      return os.buf();
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      return ConstBufferPtr();
+    }
+}
+
 } // namespace crypto
 
 } // namespace ndn
@@ -52,6 +52,18 @@ static const size_t SHA256_DIGEST_SIZE = 32;
 ConstBufferPtr
 sha256(const uint8_t* data, size_t dataLength);
 
+/**
+ * @brief Compute the HMAC-SHA256 of data with a shared secret key.
+ *
+ * @param key Pointer to the key.
+ * @param keyLength The length of the key.
+ * @param data Pointer to the input byte array.
+ * @param dataLength The length of data.
+ * @return A pointer to a buffer of SHA256_DIGEST_SIZE octets.
+ */
+ConstBufferPtr
+hmacSha256(const uint8_t* key, size_t keyLength, const uint8_t* data, size_t dataLength);
+
 } // namespace crypto
 
 } // namespace ndn
@@ -263,6 +263,15 @@ InMemoryStorage::selectChild(const Interest& interest,
       Cache::index<byFullName>::type::iterator rightmostCandidate = startingPoint;
       Name currentChildPrefix("");
 
+      // at begin(), the starting point can be the leftmost match under its child
+      if (hasRightmostSelector &&
+          interest.getName().isPrefixOf((*startingPoint)->getFullName()) &&
+          interest.matchesData((*startingPoint)->getData()))
+        {
+          currentChildPrefix = (*startingPoint)->getFullName()
+                                 .getPrefix(interest.getName().size() + 1);
+        }
+
       while (true)
         {
           ++rightmostCandidate;
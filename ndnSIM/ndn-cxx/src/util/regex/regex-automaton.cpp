@@ -0,0 +1,416 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "regex-automaton.hpp"
+#include "regex-matcher.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace ndn {
+
+static const size_t MAX_DFA_STATES = 4096;
+static const size_t MAX_CACHED_COMPONENTS = 4096;
+static const size_t MAX_REPETITIONS = std::numeric_limits<size_t>::max();
+
+const size_t RegexAutomaton::NfaState::NONE;
+
+/**
+ * @brief Index after the closing @p right of the sub-pattern starting before @p index, like
+ *        RegexPatternListMatcher::extractSubPattern
+ */
+static size_t
+extractSubPattern(const std::string& expr, char left, char right, size_t index, size_t end)
+{
+  size_t lcount = 1;
+  size_t rcount = 0;
+
+  while (lcount > rcount) {
+    if (index >= end)
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Parenthesis mismatch"));
+
+    if (left == expr[index])
+      lcount++;
+
+    if (right == expr[index])
+      rcount++;
+
+    index++;
+  }
+  return index;
+}
+
+static size_t
+extractRepetition(const std::string& expr, size_t index, size_t end)
+{
+  if (index == end)
+    return index;
+
+  if ('+' == expr[index] || '?' == expr[index] || '*' == expr[index])
+    return ++index;
+
+  if ('{' == expr[index]) {
+    while ('}' != expr[index]) {
+      index++;
+      if (index == end)
+        BOOST_THROW_EXCEPTION(RegexMatcher::Error("Missing right brace bracket"));
+    }
+    return ++index;
+  }
+  return index;
+}
+
+/**
+ * @brief Parse the repetition of a pattern, like RegexRepeatMatcher::parseRepetition
+ */
+static void
+parseRepetition(const std::string& repetition, size_t& repeatMin, size_t& repeatMax)
+{
+  if (repetition.empty()) {
+    repeatMin = 1;
+    repeatMax = 1;
+  }
+  else if (repetition == "?") {
+    repeatMin = 0;
+    repeatMax = 1;
+  }
+  else if (repetition == "+") {
+    repeatMin = 1;
+    repeatMax = MAX_REPETITIONS;
+  }
+  else if (repetition == "*") {
+    repeatMin = 0;
+    repeatMax = MAX_REPETITIONS;
+  }
+  else {
+    size_t separator = repetition.find(',');
+    size_t size = repetition.size();
+    if (boost::regex_match(repetition, boost::regex("\\{[0-9]+,[0-9]+\\}"))) {
+      repeatMin = std::atoi(repetition.substr(1, separator - 1).c_str());
+      repeatMax = std::atoi(repetition.substr(separator + 1, size - separator - 2).c_str());
+    }
+    else if (boost::regex_match(repetition, boost::regex("\\{,[0-9]+\\}"))) {
+      repeatMin = 0;
+      repeatMax = std::atoi(repetition.substr(separator + 1, size - separator - 2).c_str());
+    }
+    else if (boost::regex_match(repetition, boost::regex("\\{[0-9]+,\\}"))) {
+      repeatMin = std::atoi(repetition.substr(1, separator).c_str());
+      repeatMax = MAX_REPETITIONS;
+    }
+    else if (boost::regex_match(repetition, boost::regex("\\{[0-9]+\\}"))) {
+      repeatMin = std::atoi(repetition.substr(1, size - 1).c_str());
+      repeatMax = repeatMin;
+    }
+    else
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Unrecognized repetition format " + repetition));
+
+    if (repeatMin > repeatMax)
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Wrong repetition number " + repetition));
+  }
+}
+
+/**
+ * @brief Index after the component expression starting before @p index, like
+ *        RegexComponentSetMatcher::extractComponent
+ */
+static size_t
+extractComponent(const std::string& expr, size_t index)
+{
+  size_t lcount = 1;
+  size_t rcount = 0;
+
+  while (lcount > rcount) {
+    if (index >= expr.size())
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Error: square brackets mismatch"));
+
+    if (expr[index] == '<')
+      lcount++;
+    else if (expr[index] == '>')
+      rcount++;
+    index++;
+  }
+  return index;
+}
+
+RegexAutomaton::RegexAutomaton(const std::string& expr)
+{
+  Fragment nfa = compileList(expr, 0, expr.size());
+  m_nfaStart = nfa.start;
+  m_nfaAccept = nfa.accept;
+
+  resetDfa();
+}
+
+size_t
+RegexAutomaton::addNfaState()
+{
+  m_nfa.emplace_back();
+  return m_nfa.size() - 1;
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::compileList(const std::string& expr, size_t begin, size_t end)
+{
+  size_t state = addNfaState();
+  Fragment list{state, state};
+
+  size_t index = begin;
+  while (index < end) {
+    Fragment pattern = compilePattern(expr, index, end, index);
+    m_nfa[list.accept].epsilons.push_back(pattern.start);
+    list.accept = pattern.accept;
+  }
+  return list;
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::compilePattern(const std::string& expr, size_t begin, size_t end, size_t& next)
+{
+  char left = expr[begin];
+  char right;
+  switch (left) {
+  case '(':
+    right = ')';
+    break;
+  case '<':
+    right = '>';
+    break;
+  case '[':
+    right = ']';
+    break;
+  default:
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Unexpected syntax"));
+  }
+
+  size_t indicator = extractSubPattern(expr, left, right, begin + 1, end);
+  next = extractRepetition(expr, indicator, end);
+
+  size_t repeatMin = 0;
+  size_t repeatMax = 0;
+  parseRepetition(expr.substr(indicator, next - indicator), repeatMin, repeatMax);
+
+  if (left == '(') {
+    // the sub-pattern is compiled again for every copy
+    return repeat([&] { return compileList(expr, begin + 1, indicator - 1); },
+                  repeatMin, repeatMax);
+  }
+
+  size_t atom = compileComponentSet(expr.substr(begin, indicator - begin));
+  return repeat([this, atom] {
+      size_t start = addNfaState();
+      size_t accept = addNfaState();
+      m_nfa[start].atom = atom;
+      m_nfa[start].next = accept;
+      return Fragment{start, accept};
+    }, repeatMin, repeatMax);
+}
+
+size_t
+RegexAutomaton::compileComponentSet(const std::string& expr)
+{
+  if (expr.size() < 2)
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Regexp compile error (cannot parse " +
+                                              expr + ")"));
+
+  Atom atom;
+  atom.isInclusion = true;
+
+  size_t index = 1;
+  size_t end = expr.size();
+  if (expr[0] == '<') {
+    index = 0;
+  }
+  else if (expr[end - 1] != ']') {
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Regexp compile error (no matching ']' in " +
+                                              expr + ")"));
+  }
+  else {
+    --end;
+    if (expr[1] == '^') {
+      atom.isInclusion = false;
+      index = 2;
+    }
+  }
+
+  while (index < end) {
+    if (expr[index] != '<')
+      BOOST_THROW_EXCEPTION(RegexMatcher::Error("Component expr error " + expr));
+
+    size_t componentEnd = extractComponent(expr, index + 1);
+    std::string component = expr.substr(index + 1, componentEnd - index - 2);
+    atom.isAny.push_back(component.empty());
+    atom.components.push_back(component.empty() ? boost::regex() : boost::regex(component));
+    index = componentEnd;
+  }
+
+  if (index != end)
+    BOOST_THROW_EXCEPTION(RegexMatcher::Error("Not sufficient expr to parse " + expr));
+
+  m_atoms.push_back(std::move(atom));
+  return m_atoms.size() - 1;
+}
+
+RegexAutomaton::Fragment
+RegexAutomaton::repeat(const std::function<Fragment()>& build, size_t repeatMin,
+                       size_t repeatMax)
+{
+  size_t state = addNfaState();
+  Fragment result{state, state};
+
+  for (size_t i = 0; i < repeatMin; ++i) {
+    Fragment copy = build();
+    m_nfa[result.accept].epsilons.push_back(copy.start);
+    result.accept = copy.accept;
+  }
+
+  if (repeatMax == MAX_REPETITIONS) {
+    // any number of further copies
+    Fragment copy = build();
+    size_t accept = addNfaState();
+    m_nfa[result.accept].epsilons.push_back(copy.start);
+    m_nfa[result.accept].epsilons.push_back(accept);
+    m_nfa[copy.accept].epsilons.push_back(copy.start);
+    m_nfa[copy.accept].epsilons.push_back(accept);
+    result.accept = accept;
+    return result;
+  }
+
+  for (size_t i = repeatMin; i < repeatMax; ++i) {
+    // optional copy
+    Fragment copy = build();
+    size_t accept = addNfaState();
+    m_nfa[result.accept].epsilons.push_back(copy.start);
+    m_nfa[result.accept].epsilons.push_back(accept);
+    m_nfa[copy.accept].epsilons.push_back(accept);
+    result.accept = accept;
+  }
+  return result;
+}
+
+size_t
+RegexAutomaton::getClass(const name::Component& component) const
+{
+  std::string key(reinterpret_cast<const char*>(component.wire()), component.size());
+  auto cached = m_componentClasses.find(key);
+  if (cached != m_componentClasses.end())
+    return cached->second;
+
+  // like RegexComponentMatcher, the regular expressions match the URI of the component
+  std::string uri = component.toUri();
+  std::vector<bool> atoms(m_atoms.size());
+  for (size_t i = 0; i < m_atoms.size(); ++i) {
+    const Atom& atom = m_atoms[i];
+    bool isMatched = false;
+    for (size_t j = 0; j < atom.components.size() && !isMatched; ++j) {
+      isMatched = atom.isAny[j] || boost::regex_match(uri, atom.components[j]);
+    }
+    atoms[i] = atom.isInclusion ? isMatched : !isMatched;
+  }
+
+  auto inserted = m_classes.emplace(std::move(atoms), m_classes.size());
+  if (inserted.second)
+    m_classAtoms.push_back(&inserted.first->first);
+
+  if (m_componentClasses.size() >= MAX_CACHED_COMPONENTS)
+    m_componentClasses.clear();
+  m_componentClasses.emplace(std::move(key), inserted.first->second);
+  return inserted.first->second;
+}
+
+size_t
+RegexAutomaton::getDfaState(std::vector<size_t> nfaStates) const
+{
+  // closure under epsilon transitions
+  std::vector<bool> isIncluded(m_nfa.size());
+  for (size_t state : nfaStates)
+    isIncluded[state] = true;
+  for (size_t i = 0; i < nfaStates.size(); ++i) {
+    for (size_t epsilon : m_nfa[nfaStates[i]].epsilons) {
+      if (!isIncluded[epsilon]) {
+        isIncluded[epsilon] = true;
+        nfaStates.push_back(epsilon);
+      }
+    }
+  }
+  std::sort(nfaStates.begin(), nfaStates.end());
+
+  auto found = m_dfaIndex.find(nfaStates);
+  if (found != m_dfaIndex.end())
+    return found->second;
+
+  DfaState state;
+  state.isAccepting = isIncluded[m_nfaAccept];
+  state.nfaStates = nfaStates;
+  m_dfa.push_back(std::move(state));
+  m_dfaIndex.emplace(std::move(nfaStates), m_dfa.size() - 1);
+  return m_dfa.size() - 1;
+}
+
+size_t
+RegexAutomaton::step(size_t dfaState, size_t componentClass) const
+{
+  std::vector<size_t>& transitions = m_dfa[dfaState].transitions;
+  if (transitions.size() <= componentClass)
+    transitions.resize(componentClass + 1, NfaState::NONE);
+  if (transitions[componentClass] != NfaState::NONE)
+    return transitions[componentClass];
+
+  const std::vector<bool>& atoms = *m_classAtoms[componentClass];
+  std::vector<size_t> next;
+  for (size_t state : m_dfa[dfaState].nfaStates) {
+    const NfaState& nfaState = m_nfa[state];
+    if (nfaState.atom != NfaState::NONE && atoms[nfaState.atom])
+      next.push_back(nfaState.next);
+  }
+  std::sort(next.begin(), next.end());
+  next.erase(std::unique(next.begin(), next.end()), next.end());
+
+  // m_dfa may grow, and transitions be invalidated
+  size_t nextState = getDfaState(std::move(next));
+  m_dfa[dfaState].transitions[componentClass] = nextState;
+  return nextState;
+}
+
+void
+RegexAutomaton::resetDfa() const
+{
+  m_dfa.clear();
+  m_dfaIndex.clear();
+  m_dfaStart = getDfaState({m_nfaStart});
+}
+
+bool
+RegexAutomaton::match(const Name& name, size_t offset, size_t len) const
+{
+  if (m_dfa.size() > MAX_DFA_STATES)
+    resetDfa();
+
+  size_t state = m_dfaStart;
+  for (size_t i = offset; i < offset + len; ++i) {
+    if (m_dfa[state].nfaStates.empty())
+      return false; // no match, whatever follows
+
+    state = step(state, getClass(name.get(i)));
+  }
+  return m_dfa[state].isAccepting;
+}
+
+} // namespace ndn
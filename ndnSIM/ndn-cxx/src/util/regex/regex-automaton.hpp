@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+#define NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
+
+#include "../../common.hpp"
+#include "../../name.hpp"
+
+#include <boost/regex.hpp>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ndn {
+
+/**
+ * @brief Deterministic automaton over name components, accepting the names matched by the
+ *        expression of a RegexPatternListMatcher
+ *
+ * RegexPatternListMatcher and its sub-matchers find a match by trying every split of the name
+ * between the patterns, recursively.  The automaton decides the same match in one pass over the
+ * components, without backtracking: the expression is compiled into an NFA whose transitions
+ * are component sets, and the DFA states, i.e., sets of NFA states, are built on first use.
+ *
+ * The alphabet of the DFA is the classes of components: two components are in the same class
+ * if they match the same component sets.  The class of a component is computed once with the
+ * regular expressions of the component sets, and cached with the component, so a match of a
+ * known name costs a lookup per component and no regular expression.
+ *
+ * The automaton only decides whether a name matches, back references are not captured.
+ * Both caches are bounded, and cleared when full.
+ */
+class RegexAutomaton : noncopyable
+{
+public:
+  /**
+   * @brief Compile the expression of a pattern list, e.g., "<a>(<b><>*)?[^<c>]"
+   * @throw RegexMatcher::Error the expression is malformed
+   */
+  explicit
+  RegexAutomaton(const std::string& expr);
+
+  /**
+   * @brief Whether components [offset, offset + len) of @p name match the whole expression
+   */
+  bool
+  match(const Name& name, size_t offset, size_t len) const;
+
+  bool
+  match(const Name& name) const
+  {
+    return match(name, 0, name.size());
+  }
+
+  size_t
+  getNNfaStates() const
+  {
+    return m_nfa.size();
+  }
+
+  /**
+   * @brief Number of DFA states built so far
+   */
+  size_t
+  getNDfaStates() const
+  {
+    return m_dfa.size();
+  }
+
+  /**
+   * @brief Number of component classes found so far
+   */
+  size_t
+  getNClasses() const
+  {
+    return m_classes.size();
+  }
+
+private:
+  /**
+   * @brief Component set, like RegexComponentSetMatcher
+   */
+  struct Atom
+  {
+    std::vector<boost::regex> components; ///< an empty expression matches any component
+    std::vector<bool> isAny;
+    bool isInclusion;
+  };
+
+  struct NfaState
+  {
+    static const size_t NONE = std::numeric_limits<size_t>::max();
+
+    size_t atom = NONE; ///< transition to next on a component of the set, if not NONE
+    size_t next = NONE;
+    std::vector<size_t> epsilons;
+  };
+
+  /**
+   * @brief Part of the NFA with a single entry and a single exit
+   */
+  struct Fragment
+  {
+    size_t start;
+    size_t accept;
+  };
+
+  struct DfaState
+  {
+    std::vector<size_t> nfaStates; ///< sorted, closed under epsilon transitions
+    bool isAccepting = false;
+    std::vector<size_t> transitions; ///< by component class, NfaState::NONE if not built yet
+  };
+
+  size_t
+  addNfaState();
+
+  Fragment
+  compileList(const std::string& expr, size_t begin, size_t end);
+
+  /**
+   * @brief Compile the pattern at @p begin, with its repetition
+   * @param[out] next index after the pattern
+   */
+  Fragment
+  compilePattern(const std::string& expr, size_t begin, size_t end, size_t& next);
+
+  size_t
+  compileComponentSet(const std::string& expr);
+
+  /**
+   * @brief Chain @p repeatMin to @p repeatMax copies of the fragment built by @p build
+   */
+  Fragment
+  repeat(const std::function<Fragment()>& build, size_t repeatMin, size_t repeatMax);
+
+  size_t
+  getClass(const name::Component& component) const;
+
+  size_t
+  getDfaState(std::vector<size_t> nfaStates) const;
+
+  size_t
+  step(size_t dfaState, size_t componentClass) const;
+
+  void
+  resetDfa() const;
+
+private:
+  std::vector<Atom> m_atoms;
+  std::vector<NfaState> m_nfa;
+  size_t m_nfaStart;
+  size_t m_nfaAccept;
+
+  // built while matching
+  mutable std::vector<DfaState> m_dfa;
+  mutable std::map<std::vector<size_t>, size_t> m_dfaIndex;
+  mutable size_t m_dfaStart;
+  mutable std::map<std::vector<bool>, size_t> m_classes; ///< atoms matched by the class
+  mutable std::vector<const std::vector<bool>*> m_classAtoms;
+  mutable std::unordered_map<std::string, size_t> m_componentClasses; ///< by component wire
+};
+
+} // namespace ndn
+
+#endif // NDN_UTIL_REGEX_REGEX_AUTOMATON_HPP
@@ -23,6 +23,7 @@
 
 #include "regex-top-matcher.hpp"
 
+#include "regex-automaton.hpp"
 #include "regex-backref-manager.hpp"
 #include "regex-pattern-list-matcher.hpp"
 
@@ -69,6 +70,10 @@ RegexTopMatcher::compile()
   // because the argument-dependent lookup prefers STL to boost
   m_primaryMatcher = ndn::make_shared<RegexPatternListMatcher>(expr,
                                                                m_primaryBackrefManager);
+
+  // the secondary expression accepts every name accepted by the primary one
+  m_automaton = make_shared<RegexAutomaton>(static_cast<bool>(m_secondaryMatcher) ?
+                                            m_secondaryMatcher->getExpr() : expr);
 }
 
 bool
@@ -78,6 +83,16 @@ RegexTopMatcher::match(const Name& name)
 
   m_matchResult.clear();
 
+  if (!m_automaton->match(name))
+    return false;
+
+  // without back references, both matchers would capture the whole name
+  if (m_primaryBackrefManager->size() == 0 && m_secondaryBackrefManager->size() == 0)
+    {
+      m_matchResult.assign(name.begin(), name.end());
+      return true;
+    }
+
   if (m_primaryMatcher->match(name, 0, name.size()))
     {
       m_matchResult = m_primaryMatcher->getMatchResult();
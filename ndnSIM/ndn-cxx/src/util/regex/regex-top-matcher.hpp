@@ -32,6 +32,7 @@ namespace ndn {
 
 class RegexPatternListMatcher;
 class RegexBackrefManager;
+class RegexAutomaton;
 
 class RegexTopMatcher: public RegexMatcher
 {
@@ -70,6 +71,8 @@ private:
   shared_ptr<RegexPatternListMatcher> m_secondaryMatcher;
   shared_ptr<RegexBackrefManager> m_primaryBackrefManager;
   shared_ptr<RegexBackrefManager> m_secondaryBackrefManager;
+  /// accepts the names matched by either matcher, which are only run for the back references
+  shared_ptr<RegexAutomaton> m_automaton;
   bool m_isSecondaryUsed;
 };
 
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+
+#include "rtt-estimator.hpp"
+
+#include <cstdlib>
+
+namespace ndn {
+namespace util {
+
+RttEstimator::Options::Options()
+  : alpha(0.125)
+  , beta(0.25)
+  , k(4)
+  , initialRto(time::seconds(1))
+  , minRto(time::milliseconds(200))
+  , maxRto(time::minutes(1))
+  , rtoBackoffMultiplier(2)
+{
+}
+
+RttEstimator::RttEstimator(const Options& options)
+  : m_options(options)
+  , m_hasSamples(false)
+  , m_sRtt(time::nanoseconds::zero())
+  , m_rttVar(time::nanoseconds::zero())
+  , m_rto(options.initialRto)
+{
+}
+
+void
+RttEstimator::addMeasurement(const time::nanoseconds& rtt, size_t nExpectedSamples)
+{
+  if (!m_hasSamples) {
+    m_sRtt = rtt;
+    m_rttVar = rtt / 2;
+    m_hasSamples = true;
+  }
+  else {
+    double n = static_cast<double>(std::max<size_t>(nExpectedSamples, 1));
+    double alpha = m_options.alpha / n;
+    double beta = m_options.beta / n;
+    int64_t error = std::abs((m_sRtt - rtt).count());
+    m_rttVar = time::nanoseconds(static_cast<int64_t>((1 - beta) * m_rttVar.count() +
+                                                      beta * error));
+    m_sRtt = time::nanoseconds(static_cast<int64_t>((1 - alpha) * m_sRtt.count() +
+                                                    alpha * rtt.count()));
+  }
+
+  m_rto = std::min(std::max(m_sRtt + m_options.k * m_rttVar, m_options.minRto),
+                   m_options.maxRto);
+}
+
+void
+RttEstimator::backoffRto()
+{
+  m_rto = std::min(m_rto * m_options.rtoBackoffMultiplier, m_options.maxRto);
+}
+
+} // namespace util
+} // namespace ndn
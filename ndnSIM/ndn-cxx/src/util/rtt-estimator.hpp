@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+
+#ifndef NDN_UTIL_RTT_ESTIMATOR_HPP
+#define NDN_UTIL_RTT_ESTIMATOR_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief RTT and retransmission timeout estimator
+ *
+ * Implements the mean/deviation estimator of RFC 6298, with the gains scaled down when
+ * several samples are expected per RTT (as for a window of pipelined Interests).
+ */
+class RttEstimator
+{
+public:
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    double alpha; ///< gain of the smoothed RTT
+    double beta; ///< gain of the RTT variation
+    int k; ///< RTT variation multiplier in the RTO
+    time::nanoseconds initialRto;
+    time::nanoseconds minRto;
+    time::nanoseconds maxRto;
+    int rtoBackoffMultiplier;
+  };
+
+  explicit
+  RttEstimator(const Options& options = Options());
+
+  /**
+   * @brief Record a new RTT sample
+   * @param rtt the sampled RTT; must not come from a retransmitted Interest (Karn's rule)
+   * @param nExpectedSamples number of samples expected during one RTT
+   */
+  void
+  addMeasurement(const time::nanoseconds& rtt, size_t nExpectedSamples = 1);
+
+  /**
+   * @brief Multiply the RTO by the backoff multiplier, up to maxRto
+   */
+  void
+  backoffRto();
+
+  time::nanoseconds
+  getEstimatedRto() const
+  {
+    return m_rto;
+  }
+
+  time::nanoseconds
+  getSmoothedRtt() const
+  {
+    return m_sRtt;
+  }
+
+  time::nanoseconds
+  getRttVariation() const
+  {
+    return m_rttVar;
+  }
+
+  bool
+  hasSamples() const
+  {
+    return m_hasSamples;
+  }
+
+private:
+  Options m_options;
+  bool m_hasSamples;
+  time::nanoseconds m_sRtt;
+  time::nanoseconds m_rttVar;
+  time::nanoseconds m_rto;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_RTT_ESTIMATOR_HPP
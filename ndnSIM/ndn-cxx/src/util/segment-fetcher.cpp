@@ -21,98 +21,367 @@
 
 #include "segment-fetcher.hpp"
 
-#include "../encoding/buffer-stream.hpp"
+#include "../encoding/buffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace ndn {
 namespace util {
 
+SegmentFetcher::Options::Options()
+  : useConstantCwnd(false)
+  , initCwnd(1.0)
+  , initSsthresh(std::numeric_limits<double>::max())
+  , aiStep(1.0)
+  , mdCoef(0.5)
+  , maxRetries(8)
+  , useRto(true)
+{
+}
+
 SegmentFetcher::SegmentFetcher(Face& face,
+                               const Options& options,
                                const VerifySegment& verifySegment,
                                const CompleteCallback& completeCallback,
                                const ErrorCallback& errorCallback)
   : m_face(face)
+  , m_scheduler(face.getIoService())
+  , m_options(options)
   , m_verifySegment(verifySegment)
   , m_completeCallback(completeCallback)
   , m_errorCallback(errorCallback)
-  , m_buffer(make_shared<OBufferStream>())
+  , m_isStopped(false)
+  , m_nFirstSegmentRetries(0)
+  , m_rtt(options.rttOptions)
+  , m_cwnd(options.initCwnd)
+  , m_ssthresh(options.initSsthresh)
+  , m_recoveryPoint(0)
+  , m_nextSegment(0)
+  , m_nSegments(0)
+  , m_lastSerial(0)
+  , m_nReceived(0)
+  , m_totalSize(0)
+{
+}
+
+void
+SegmentFetcher::fetch(Face& face,
+                      const Interest& baseInterest,
+                      const VerifySegment& verifySegment,
+                      const CompleteCallback& completeCallback,
+                      const ErrorCallback& errorCallback)
 {
+  Options options;
+  options.useConstantCwnd = true;
+  options.initCwnd = 1.0;
+  options.maxRetries = 0;
+  options.useRto = false;
+
+  fetch(face, baseInterest, options, verifySegment, completeCallback, errorCallback);
 }
 
 void
 SegmentFetcher::fetch(Face& face,
                       const Interest& baseInterest,
+                      const Options& options,
                       const VerifySegment& verifySegment,
                       const CompleteCallback& completeCallback,
                       const ErrorCallback& errorCallback)
 {
   shared_ptr<SegmentFetcher> fetcher =
-    shared_ptr<SegmentFetcher>(new SegmentFetcher(face, verifySegment,
+    shared_ptr<SegmentFetcher>(new SegmentFetcher(face, options, verifySegment,
                                                   completeCallback, errorCallback));
 
-  fetcher->fetchFirstSegment(baseInterest, fetcher);
+  fetcher->m_interest = baseInterest;
+  fetcher->fetchFirstSegment(fetcher);
 }
 
 void
-SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
-                                  const shared_ptr<SegmentFetcher>& self)
+SegmentFetcher::fetchFirstSegment(const shared_ptr<SegmentFetcher>& self)
 {
-  Interest interest(baseInterest);
+  Interest interest(m_interest);
+  interest.refreshNonce();
   interest.setChildSelector(1);
   interest.setMustBeFresh(true);
 
   m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::onSegmentReceived, this, _1, _2, true, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+                         bind(&SegmentFetcher::onFirstSegmentReceived, this, _2, self),
+                         bind(&SegmentFetcher::onFirstSegmentTimeout, this, self));
 }
 
 void
-SegmentFetcher::fetchNextSegment(const Interest& origInterest, const Name& dataName,
-                                 uint64_t segmentNo,
-                                 const shared_ptr<SegmentFetcher>& self)
+SegmentFetcher::onFirstSegmentReceived(const Data& data, const shared_ptr<SegmentFetcher>& self)
 {
-  Interest interest(origInterest); // to preserve any special selectors
+  if (m_isStopped) {
+    return;
+  }
+
+  if (!m_verifySegment(data)) {
+    return fail(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
+  }
+
+  uint64_t segmentNo = 0;
+  try {
+    segmentNo = data.getName().get(-1).toSegment();
+  }
+  catch (const tlv::Error& e) {
+    return fail(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+  }
+
+  // the Interest sent under the version discovery selectors only starts the pipeline
+  m_versionedName = data.getName().getPrefix(-1);
+  m_interest.setChildSelector(0);
+  m_interest.setMustBeFresh(false);
+
+  if (segmentNo == 0) {
+    m_nextSegment = 1;
+    if (!storeSegment(data, 0)) {
+      return;
+    }
+    increaseWindow();
+    if (m_nSegments != 0 && m_nReceived == m_nSegments) {
+      return finish();
+    }
+  }
+
+  fillWindow(self);
+}
+
+void
+SegmentFetcher::onFirstSegmentTimeout(const shared_ptr<SegmentFetcher>& self)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  if (m_nFirstSegmentRetries >= m_options.maxRetries) {
+    return fail(INTEREST_TIMEOUT, "Timeout");
+  }
+
+  ++m_nFirstSegmentRetries;
+  fetchFirstSegment(self);
+}
+
+void
+SegmentFetcher::fillWindow(const shared_ptr<SegmentFetcher>& self)
+{
+  size_t window = std::max<size_t>(static_cast<size_t>(m_cwnd), 1);
+
+  while (m_pending.size() < window) {
+    if (!m_retxQueue.empty()) {
+      std::pair<uint64_t, size_t> retx = m_retxQueue.front();
+      m_retxQueue.pop_front();
+      fetchSegment(retx.first, retx.second, self);
+    }
+    else if (m_nSegments == 0 || m_nextSegment < m_nSegments) {
+      fetchSegment(m_nextSegment++, 0, self);
+    }
+    else {
+      break;
+    }
+  }
+}
+
+void
+SegmentFetcher::fetchSegment(uint64_t segmentNo, size_t nRetries,
+                             const shared_ptr<SegmentFetcher>& self)
+{
+  Interest interest(m_interest); // to preserve any special selectors
   interest.refreshNonce();
-  interest.setChildSelector(0);
-  interest.setMustBeFresh(false);
-  interest.setName(dataName.getPrefix(-1).appendSegment(segmentNo));
-  m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::onSegmentReceived, this, _1, _2, false, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+  interest.setName(Name(m_versionedName).appendSegment(segmentNo));
+
+  PendingSegment& pending = m_pending[segmentNo];
+  pending.sendTime = time::steady_clock::now();
+  pending.nRetries = nRetries;
+  pending.serial = ++m_lastSerial;
+  pending.interestId =
+    m_face.expressInterest(interest,
+                           bind(&SegmentFetcher::onSegmentReceived, this, _2, self),
+                           bind(&SegmentFetcher::onSegmentTimeout, this,
+                                segmentNo, pending.serial, self));
+  if (m_options.useRto) {
+    pending.timeoutEvent =
+      m_scheduler.scheduleEvent(m_rtt.getEstimatedRto(),
+                                bind(&SegmentFetcher::onSegmentTimeout, this,
+                                     segmentNo, pending.serial, self));
+  }
 }
 
 void
-SegmentFetcher::onSegmentReceived(const Interest& origInterest,
-                                  const Data& data, bool isSegmentZeroExpected,
-                                  const shared_ptr<SegmentFetcher>& self)
+SegmentFetcher::onSegmentReceived(const Data& data, const shared_ptr<SegmentFetcher>& self)
 {
+  if (m_isStopped) {
+    return;
+  }
+
   if (!m_verifySegment(data)) {
-    return m_errorCallback(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
+    return fail(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
   }
 
+  uint64_t segmentNo = 0;
   try {
-    uint64_t currentSegment = data.getName().get(-1).toSegment();
+    segmentNo = data.getName().get(-1).toSegment();
+  }
+  catch (const tlv::Error& e) {
+    return fail(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+  }
 
-    if (isSegmentZeroExpected && currentSegment != 0) {
-      fetchNextSegment(origInterest, data.getName(), 0, self);
+  auto pending = m_pending.find(segmentNo);
+  if (pending == m_pending.end()) {
+    return; // duplicate, or beyond the last segment
+  }
+
+  if (pending->second.nRetries == 0) {
+    m_rtt.addMeasurement(time::steady_clock::now() - pending->second.sendTime,
+                         std::max<size_t>(static_cast<size_t>(m_cwnd), 1));
+  }
+  m_scheduler.cancelEvent(pending->second.timeoutEvent);
+  m_pending.erase(pending);
+
+  if (!storeSegment(data, segmentNo)) {
+    return;
+  }
+  increaseWindow();
+
+  if (m_nSegments != 0 && m_nReceived == m_nSegments) {
+    return finish();
+  }
+  fillWindow(self);
+}
+
+void
+SegmentFetcher::onSegmentTimeout(uint64_t segmentNo, uint64_t serial,
+                                 const shared_ptr<SegmentFetcher>& self)
+{
+  if (m_isStopped) {
+    return;
+  }
+
+  auto pending = m_pending.find(segmentNo);
+  if (pending == m_pending.end() || pending->second.serial != serial) {
+    return; // already satisfied or retransmitted
+  }
+
+  size_t nRetries = pending->second.nRetries;
+  if (nRetries >= m_options.maxRetries) {
+    return fail(INTEREST_TIMEOUT, "Timeout");
+  }
+
+  m_face.removePendingInterest(pending->second.interestId);
+  m_scheduler.cancelEvent(pending->second.timeoutEvent);
+  m_pending.erase(pending);
+
+  m_rtt.backoffRto();
+  decreaseWindow(segmentNo);
+
+  m_retxQueue.push_back({segmentNo, nRetries + 1});
+  fillWindow(self);
+}
+
+bool
+SegmentFetcher::storeSegment(const Data& data, uint64_t segmentNo)
+{
+  const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
+  if (!finalBlockId.empty() && m_nSegments == 0) {
+    try {
+      m_nSegments = finalBlockId.toSegment() + 1;
     }
-    else {
-      m_buffer->write(reinterpret_cast<const char*>(data.getContent().value()),
-                      data.getContent().value_size());
-
-      const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
-      if (finalBlockId.empty() ||
-          finalBlockId.toSegment() > currentSegment)
-        {
-          fetchNextSegment(origInterest, data.getName(), currentSegment + 1, self);
-        }
-      else {
-        return m_completeCallback(m_buffer->buf());
-      }
+    catch (const tlv::Error& e) {
+      fail(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+      return false;
     }
+
+    // drop the Interests sent past the last segment
+    for (auto pending = m_pending.lower_bound(m_nSegments); pending != m_pending.end(); ) {
+      m_face.removePendingInterest(pending->second.interestId);
+      m_scheduler.cancelEvent(pending->second.timeoutEvent);
+      pending = m_pending.erase(pending);
+    }
+    m_retxQueue.erase(std::remove_if(m_retxQueue.begin(), m_retxQueue.end(),
+                                     [this] (const std::pair<uint64_t, size_t>& retx) {
+                                       return retx.first >= m_nSegments;
+                                     }),
+                      m_retxQueue.end());
+    m_segments.reserve(m_nSegments);
   }
-  catch (const tlv::Error& e) {
-    m_errorCallback(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+
+  if (m_nSegments != 0 && segmentNo >= m_nSegments) {
+    return true;
+  }
+
+  if (m_segments.size() <= segmentNo) {
+    m_segments.resize(segmentNo + 1);
+  }
+  if (!m_segments[segmentNo].hasWire()) {
+    m_segments[segmentNo] = data.getContent();
+    m_totalSize += data.getContent().value_size();
+    ++m_nReceived;
+  }
+  return true;
+}
+
+void
+SegmentFetcher::increaseWindow()
+{
+  if (m_options.useConstantCwnd) {
+    return;
+  }
+
+  if (m_cwnd < m_ssthresh) {
+    m_cwnd += m_options.aiStep; // slow start
+  }
+  else {
+    m_cwnd += m_options.aiStep / std::floor(m_cwnd);
+  }
+}
+
+void
+SegmentFetcher::decreaseWindow(uint64_t segmentNo)
+{
+  if (m_options.useConstantCwnd || segmentNo < m_recoveryPoint) {
+    return; // at most one decrease per window of losses
+  }
+
+  m_ssthresh = std::max(2.0, m_cwnd * m_options.mdCoef);
+  m_cwnd = m_ssthresh;
+  m_recoveryPoint = m_nextSegment;
+}
+
+void
+SegmentFetcher::finish()
+{
+  m_segments.resize(m_nSegments);
+
+  auto buffer = make_shared<Buffer>(m_totalSize);
+  uint8_t* position = buffer->buf();
+  for (const Block& segment : m_segments) {
+    position = std::copy(segment.value_begin(), segment.value_end(), position);
+  }
+
+  m_isStopped = true;
+  cancelPendingSegments();
+  m_completeCallback(buffer);
+}
+
+void
+SegmentFetcher::fail(uint32_t code, const std::string& msg)
+{
+  m_isStopped = true;
+  cancelPendingSegments();
+  m_errorCallback(code, msg);
+}
+
+void
+SegmentFetcher::cancelPendingSegments()
+{
+  for (const auto& pending : m_pending) {
+    m_face.removePendingInterest(pending.second.interestId);
+    m_scheduler.cancelEvent(pending.second.timeoutEvent);
   }
+  m_pending.clear();
+  m_retxQueue.clear();
 }
 
 } // util
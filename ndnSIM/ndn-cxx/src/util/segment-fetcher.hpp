@@ -24,11 +24,13 @@
 
 #include "../common.hpp"
 #include "../face.hpp"
+#include "rtt-estimator.hpp"
+#include "scheduler.hpp"
 
-namespace ndn {
-
-class OBufferStream;
+#include <deque>
+#include <map>
 
+namespace ndn {
 namespace util {
 
 /**
@@ -68,18 +70,24 @@ public:
  *
  *    >> Interest: /<prefix>/<version>/<segment=0>
  *
- * 5. Keep sending Interests for the next segment while the retrieved Data does not have
- *    FinalBlockId or FinalBlockId != Data.getName().get(-1).
+ * 5. Keep sending Interests for the next segments, up to the congestion window, until
+ *    FinalBlockId of a retrieved Data tells the last segment number.
  *
  *    >> Interest: /<prefix>/<version>/<segment=(N+1))>
  *
  * 6. Fire onCompletion callback with memory block that combines content part from all
  *    segmented objects.
  *
+ * Segments may arrive out of order; their content is kept until the object is complete and
+ * then copied once into a buffer of the final size.  The window follows AIMD (slow start,
+ * then additive increase; multiplicative decrease on a loss) unless Options::useConstantCwnd
+ * is set.  A segment is retransmitted when no Data arrives within the RTO computed by an
+ * RttEstimator, or when its Interest lifetime expires.
+ *
  * If an error occurs during the fetching process, an error callback is fired
  * with a proper error code.  The following errors are possible:
  *
- * - `INTEREST_TIMEOUT`: if any of the Interests times out
+ * - `INTEREST_TIMEOUT`: if an Interest times out more than Options::maxRetries times
  * - `DATA_HAS_NO_SEGMENT`: if any of the retrieved Data packets don't have segment
  *   as a last component of the name (not counting implicit digest)
  * - `SEGMENT_VERIFICATION_FAIL`: if any retrieved segment fails user-provided validation
@@ -125,9 +133,31 @@ public:
     SEGMENT_VERIFICATION_FAIL = 3
   };
 
+  /**
+   * @brief Fetching parameters
+   */
+  class Options
+  {
+  public:
+    Options();
+
+  public:
+    bool useConstantCwnd; ///< if true, the window stays at initCwnd
+    double initCwnd; ///< initial window, in segments
+    double initSsthresh; ///< initial slow start threshold, in segments
+    double aiStep; ///< additive increase per RTT in congestion avoidance, in segments
+    double mdCoef; ///< multiplicative decrease coefficient on loss
+    size_t maxRetries; ///< retransmissions of one segment before INTEREST_TIMEOUT
+    bool useRto; ///< if false, a segment is only lost when its Interest lifetime expires
+    RttEstimator::Options rttOptions;
+  };
+
   /**
    * @brief Initiate segment fetching
    *
+   * Segments are fetched one at a time and the first timeout aborts fetching, i.e., as
+   * with constant window of one segment, no retransmissions, and no RTO.
+   *
    * @param face          Reference to the Face that should be used to fetch data
    * @param baseInterest  An Interest for the initial segment of requested data.
    *                      This interest may include custom InterestLifetime and selectors that
@@ -149,31 +179,111 @@ public:
         const CompleteCallback& completeCallback,
         const ErrorCallback& errorCallback);
 
+  /**
+   * @brief Initiate pipelined segment fetching
+   *
+   * @param options Window and retransmission parameters
+   * @see fetch(Face&, const Interest&, const VerifySegment&, const CompleteCallback&,
+   *            const ErrorCallback&)
+   */
+  static
+  void
+  fetch(Face& face,
+        const Interest& baseInterest,
+        const Options& options,
+        const VerifySegment& verifySegment,
+        const CompleteCallback& completeCallback,
+        const ErrorCallback& errorCallback);
+
 private:
   SegmentFetcher(Face& face,
+                 const Options& options,
                  const VerifySegment& verifySegment,
                  const CompleteCallback& completeCallback,
                  const ErrorCallback& errorCallback);
 
   void
-  fetchFirstSegment(const Interest& baseInterest, const shared_ptr<SegmentFetcher>& self);
+  fetchFirstSegment(const shared_ptr<SegmentFetcher>& self);
+
+  void
+  onFirstSegmentReceived(const Data& data, const shared_ptr<SegmentFetcher>& self);
+
+  void
+  onFirstSegmentTimeout(const shared_ptr<SegmentFetcher>& self);
+
+  /**
+   * @brief Express Interests while the window allows, retransmissions first
+   */
+  void
+  fillWindow(const shared_ptr<SegmentFetcher>& self);
+
+  void
+  fetchSegment(uint64_t segmentNo, size_t nRetries, const shared_ptr<SegmentFetcher>& self);
+
+  void
+  onSegmentReceived(const Data& data, const shared_ptr<SegmentFetcher>& self);
+
+  void
+  onSegmentTimeout(uint64_t segmentNo, uint64_t serial, const shared_ptr<SegmentFetcher>& self);
+
+  /**
+   * @brief Store the content of a verified segment
+   * @return false if the segment is invalid, in which case fetching was aborted
+   */
+  bool
+  storeSegment(const Data& data, uint64_t segmentNo);
+
+  void
+  increaseWindow();
+
+  void
+  decreaseWindow(uint64_t segmentNo);
+
+  void
+  finish();
 
   void
-  fetchNextSegment(const Interest& origInterest, const Name& dataName, uint64_t segmentNo,
-                   const shared_ptr<SegmentFetcher>& self);
+  fail(uint32_t code, const std::string& msg);
 
   void
-  onSegmentReceived(const Interest& origInterest,
-                    const Data& data, bool isSegmentZeroExpected,
-                    const shared_ptr<SegmentFetcher>& self);
+  cancelPendingSegments();
 
 private:
+  struct PendingSegment
+  {
+    const PendingInterestId* interestId;
+    scheduler::EventId timeoutEvent;
+    time::steady_clock::TimePoint sendTime;
+    size_t nRetries;
+    uint64_t serial;
+  };
+
   Face& m_face;
+  Scheduler m_scheduler;
+  Options m_options;
   VerifySegment m_verifySegment;
   CompleteCallback m_completeCallback;
   ErrorCallback m_errorCallback;
+  bool m_isStopped;
+
+  Interest m_interest;
+  Name m_versionedName;
+  size_t m_nFirstSegmentRetries;
+
+  RttEstimator m_rtt;
+  double m_cwnd;
+  double m_ssthresh;
+  uint64_t m_recoveryPoint; ///< segments below this were sent before the last decrease
+
+  uint64_t m_nextSegment; ///< lowest segment number never requested
+  uint64_t m_nSegments; ///< number of segments, or 0 if FinalBlockId is not yet known
+  std::map<uint64_t, PendingSegment> m_pending;
+  std::deque<std::pair<uint64_t, size_t>> m_retxQueue; ///< segment number and retry count
+  uint64_t m_lastSerial;
 
-  shared_ptr<OBufferStream> m_buffer;
+  std::vector<Block> m_segments; ///< contents indexed by segment number
+  size_t m_nReceived;
+  size_t m_totalSize;
 };
 
 } // util
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "sharded-in-memory-storage.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+namespace util {
+
+ShardedInMemoryStorage::ShardedInMemoryStorage(size_t nShards, size_t nKeyComponents,
+                                               const ShardFactory& makeShard)
+  : m_nShards(std::max<size_t>(nShards, 1))
+  , m_nKeyComponents(nKeyComponents)
+  , m_shards(new Shard[m_nShards])
+{
+  for (size_t i = 0; i < m_nShards; ++i) {
+    m_shards[i].storage = makeShard();
+  }
+}
+
+ShardedInMemoryStorage::Shard&
+ShardedInMemoryStorage::getShard(const Name& name, size_t nComponents) const
+{
+  size_t seed = 0;
+  for (size_t i = 0; i < nComponents; ++i) {
+    const name::Component& component = name.get(i);
+    boost::hash_combine(seed, boost::hash_range(component.wire(),
+                                                component.wire() + component.size()));
+  }
+  return m_shards[seed % m_nShards];
+}
+
+ShardedInMemoryStorage::Shard*
+ShardedInMemoryStorage::findShard(const Name& prefix) const
+{
+  // a matching Data name is at most one component (the digest) shorter than the prefix,
+  // so it has the same key components only if the prefix is longer than the key
+  if (prefix.size() <= m_nKeyComponents)
+    return nullptr;
+
+  return &getShard(prefix, m_nKeyComponents);
+}
+
+void
+ShardedInMemoryStorage::insert(const Data& data)
+{
+  const Name& name = data.getName();
+  Shard& shard = getShard(name, std::min(name.size(), m_nKeyComponents));
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.storage->insert(data);
+}
+
+/** @return whether Data a is a better match of the Interest than Data b,
+ *  both being the best matches in their shards
+ */
+static bool
+isBetterMatch(const Interest& interest, const Data& a, const Data& b)
+{
+  const Name& fullNameA = a.getFullName();
+  const Name& fullNameB = b.getFullName();
+
+  // rightmost: first the rightmost child, then the leftmost match under it
+  size_t childPos = interest.getName().size();
+  if (interest.getChildSelector() == 1 &&
+      fullNameA.size() > childPos && fullNameB.size() > childPos) {
+    int comp = fullNameA.get(childPos).compare(fullNameB.get(childPos));
+    if (comp != 0)
+      return comp > 0;
+  }
+
+  return fullNameA < fullNameB;
+}
+
+shared_ptr<const Data>
+ShardedInMemoryStorage::find(const Interest& interest)
+{
+  Shard* shard = findShard(interest.getName());
+  if (shard != nullptr) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->storage->find(interest);
+  }
+
+  shared_ptr<const Data> best;
+  for (size_t i = 0; i < m_nShards; ++i) {
+    shared_ptr<const Data> match;
+    {
+      std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+      match = m_shards[i].storage->find(interest);
+    }
+    if (match != nullptr && (best == nullptr || isBetterMatch(interest, *match, *best)))
+      best = match;
+  }
+  return best;
+}
+
+shared_ptr<const Data>
+ShardedInMemoryStorage::find(const Name& name)
+{
+  Shard* shard = findShard(name);
+  if (shard != nullptr) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    return shard->storage->find(name);
+  }
+
+  for (size_t i = 0; i < m_nShards; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    shared_ptr<const Data> match = m_shards[i].storage->find(name);
+    if (match != nullptr)
+      return match;
+  }
+  return nullptr;
+}
+
+void
+ShardedInMemoryStorage::erase(const Name& prefix, bool isPrefix)
+{
+  Shard* shard = findShard(prefix);
+  for (size_t i = 0; i < m_nShards; ++i) {
+    if (shard != nullptr && shard != &m_shards[i])
+      continue;
+
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    m_shards[i].storage->erase(prefix, isPrefix);
+  }
+}
+
+size_t
+ShardedInMemoryStorage::size() const
+{
+  size_t n = 0;
+  for (size_t i = 0; i < m_nShards; ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    n += m_shards[i].storage->size();
+  }
+  return n;
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
+#define NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <mutex>
+
+namespace ndn {
+namespace util {
+
+/** @brief In-memory storage that can be used from several threads
+ *
+ *  Packets are distributed over a number of InMemoryStorage shards by the first
+ *  nKeyComponents components of their names, and each shard has a lock of its own, so that
+ *  threads working on different parts of the namespace do not wait for each other.  Names
+ *  shorter than nKeyComponents use all their components.
+ *
+ *  Interests and Names longer than nKeyComponents are looked up in one shard.  Shorter ones
+ *  can match packets in any shard; every shard is searched, and the results are combined
+ *  according to the ChildSelector, so the result is the same as that of a single storage.
+ *  The replacement policy of each shard sees the access even if its packet is not chosen.
+ *
+ *  Each shard has its own replacement policy and limit, e.g. for 8 LRU shards:
+ *  @code
+ *  ShardedInMemoryStorage ims(8, 2, [] {
+ *      return unique_ptr<InMemoryStorage>(new InMemoryStorageLru(1000));
+ *    });
+ *  @endcode
+ */
+class ShardedInMemoryStorage : noncopyable
+{
+public:
+  typedef function<unique_ptr<InMemoryStorage>()> ShardFactory;
+
+  /** @param nShards number of shards, at least 1
+   *  @param nKeyComponents number of leading name components that select the shard
+   *  @param makeShard creates the storage of a shard, called nShards times
+   */
+  ShardedInMemoryStorage(size_t nShards, size_t nKeyComponents, const ShardFactory& makeShard);
+
+  /** @brief Inserts a Data packet into the shard of its name
+   */
+  void
+  insert(const Data& data);
+
+  /** @brief Finds the best match Data for an Interest
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /** @brief Finds the Data with a Name with or without the implicit digest
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /** @brief Deletes entries by prefix, or the entry with a full name if isPrefix is false
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /** @return number of packets stored in all shards
+   */
+  size_t
+  size() const;
+
+  size_t
+  getNShards() const
+  {
+    return m_nShards;
+  }
+
+private:
+  struct Shard
+  {
+    mutable std::mutex mutex;
+    unique_ptr<InMemoryStorage> storage;
+  };
+
+  Shard&
+  getShard(const Name& name, size_t nComponents) const;
+
+  /** @return the only shard that can have packets under the prefix, or nullptr if any shard can
+   */
+  Shard*
+  findShard(const Name& prefix) const;
+
+private:
+  size_t m_nShards;
+  size_t m_nKeyComponents;
+  unique_ptr<Shard[]> m_shards;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
@@ -79,6 +79,10 @@ private: // API for owner
   isEmpty() const;
 
   /** \brief emits a signal
+   *
+   *  Emitting a signal without handlers costs one branch; slots are neither copied nor
+   *  reference-counted during emission.
+   *
    *  \param args arguments passed to all handlers
    *  \warning Emitting the signal from a handler is undefined behavior.
    *  \warning Destructing the Signal object during signal emission is undefined behavior.
@@ -231,6 +235,20 @@ Signal<Owner, TArgs...>::operator()(const TArgs&... args)
   typename SlotList::iterator last = m_slots.end();
   --last;
 
+  if (it == last) {
+    // a single handler, as for most per-packet signals, is invoked without the loop
+    m_currentSlot = it;
+    try {
+      m_currentSlot->handler(args...);
+    }
+    catch (...) {
+      m_isExecuting = false;
+      throw;
+    }
+    m_isExecuting = false;
+    return;
+  }
+
   try {
     bool isLast = false;
     while (!isLast) {
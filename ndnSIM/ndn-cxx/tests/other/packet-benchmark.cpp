@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Packet Benchmark
+
+#include "name.hpp"
+#include "interest.hpp"
+#include "data.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+
+namespace ndn {
+namespace tests {
+
+/** @brief Collects benchmark results and writes them as JSON when the program exits
+ *
+ *  The output follows the layout of Google Benchmark's JSON reporter, as the table benchmark
+ *  of NFD does, so that results of two versions can be compared with the same tools.  The file
+ *  name is taken from the NDN_CXX_BENCHMARK_OUTPUT environment variable,
+ *  packet-benchmark.json by default.
+ */
+class BenchmarkReport : noncopyable
+{
+public:
+  struct Result
+  {
+    std::string type;
+    std::string operation;
+    size_t depth;
+    size_t payloadSize;
+    size_t nOps;
+    double nsPerOp;
+  };
+
+  static BenchmarkReport&
+  get()
+  {
+    static BenchmarkReport report;
+    return report;
+  }
+
+  void
+  add(const Result& result)
+  {
+    m_results.push_back(result);
+  }
+
+  ~BenchmarkReport()
+  {
+    const char* fileName = std::getenv("NDN_CXX_BENCHMARK_OUTPUT");
+    std::ofstream os(fileName != nullptr ? fileName : "packet-benchmark.json");
+
+    os << "{\n"
+       << "  \"context\": {\n"
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\"\n"
+#else
+       << "    \"library_build_type\": \"debug\"\n"
+#endif // NDEBUG
+       << "  },\n"
+       << "  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+      const Result& r = m_results[i];
+      os << (i == 0 ? "\n" : ",\n")
+         << "    {\n"
+         << "      \"name\": \"" << r.type << "/" << r.operation
+                                 << "/depth:" << r.depth << "/payload:" << r.payloadSize << "\",\n"
+         << "      \"type\": \"" << r.type << "\",\n"
+         << "      \"operation\": \"" << r.operation << "\",\n"
+         << "      \"depth\": " << r.depth << ",\n"
+         << "      \"payload\": " << r.payloadSize << ",\n"
+         << "      \"iterations\": " << r.nOps << ",\n"
+         << "      \"real_time\": " << r.nsPerOp << ",\n"
+         << "      \"time_unit\": \"ns\"\n"
+         << "    }";
+    }
+    os << "\n  ]\n"
+       << "}\n";
+  }
+
+private:
+  BenchmarkReport() = default;
+
+private:
+  std::vector<Result> m_results;
+};
+
+class PacketBenchmarkFixture
+{
+protected:
+  /** @brief Makes a name of @p depth components: /S/<region>.../A/<seq>
+   *
+   *  Spatial components fan out by 8 per level, as in names of neighboring producers.
+   */
+  static Name
+  makeName(size_t i, size_t depth)
+  {
+    BOOST_ASSERT(depth >= 3);
+    Name name("/S");
+    for (size_t level = 1; level + 2 < depth; ++level) {
+      name.append("region" + std::to_string((i >> (3 * level)) % 8));
+    }
+    name.append("A");
+    name.appendSequenceNumber(i);
+    return name;
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, size_t payloadSize)
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(time::seconds(1));
+    data->setContent(makeBuffer(payloadSize));
+    data->setSignature(s_signature);
+    data->wireEncode();
+    return data;
+  }
+
+  static Interest
+  makeInterest(const Name& name)
+  {
+    Interest interest(name);
+    interest.setNonce(static_cast<uint32_t>(std::hash<Name>()(name)));
+    interest.setInterestLifetime(time::seconds(2));
+    return interest;
+  }
+
+  /** @brief Runs @p f, which performs N_OPS operations, and reports the time per operation
+   */
+  static void
+  measure(const std::string& type, const std::string& operation, size_t depth, size_t payloadSize,
+          const std::function<void()>& f)
+  {
+    auto t1 = std::chrono::steady_clock::now();
+    f();
+    auto t2 = std::chrono::steady_clock::now();
+
+    double nsPerOp = std::chrono::duration<double, std::nano>(t2 - t1).count() / N_OPS;
+    BenchmarkReport::get().add({type, operation, depth, payloadSize, N_OPS, nsPerOp});
+    BOOST_TEST_MESSAGE(type << "/" << operation << "/depth:" << depth << "/payload:" <<
+                       payloadSize << " " << nsPerOp << " ns/op");
+  }
+
+protected:
+  static const size_t N_OPS = 20000;
+  static const std::vector<size_t> DEPTHS;
+  static const std::vector<size_t> PAYLOAD_SIZES;
+  static const SignatureSha256WithRsa s_signature;
+
+  /// results are accumulated here, so that the compiler cannot drop the measured code
+  size_t m_sink = 0;
+};
+
+const std::vector<size_t> PacketBenchmarkFixture::DEPTHS = {3, 7, 10};
+const std::vector<size_t> PacketBenchmarkFixture::PAYLOAD_SIZES = {0, 1024, 8192};
+
+static SignatureSha256WithRsa
+makeSignature()
+{
+  // the encoding of an RSA signature, there is no need to compute one
+  SignatureSha256WithRsa signature(KeyLocator(Name("/S/region0/A/KEY/ksk-1/ID-CERT")));
+  signature.setValue(makeBinaryBlock(tlv::SignatureValue, std::vector<uint8_t>(256).data(), 256));
+  return signature;
+}
+
+const SignatureSha256WithRsa PacketBenchmarkFixture::s_signature = makeSignature();
+
+BOOST_FIXTURE_TEST_SUITE(PacketBenchmark, PacketBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(NameOperations)
+{
+  for (size_t depth : DEPTHS) {
+    std::vector<Name> names;
+    std::vector<std::string> uris;
+    for (size_t i = 0; i < N_OPS; ++i) {
+      names.push_back(makeName(i, depth));
+      uris.push_back(names.back().toUri());
+    }
+
+    measure("Name", "fromUri", depth, 0, [&] {
+      for (const std::string& uri : uris) {
+        m_sink += Name(uri).size();
+      }
+    });
+
+    measure("Name", "append", depth, 0, [&] {
+      for (const Name& name : names) {
+        Name copy;
+        for (const name::Component& component : name) {
+          copy.append(component);
+        }
+        m_sink += copy.size();
+      }
+    });
+
+    measure("Name", "toUri", depth, 0, [&] {
+      for (const Name& name : names) {
+        m_sink += name.toUri().size();
+      }
+    });
+
+    measure("Name", "wireEncode", depth, 0, [&] {
+      for (const Name& name : names) {
+        m_sink += Name(name).wireEncode().size();
+      }
+    });
+
+    measure("Name", "hash", depth, 0, [&] {
+      for (const Name& name : names) {
+        m_sink += std::hash<Name>()(name);
+      }
+    });
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InterestOperations)
+{
+  for (size_t depth : DEPTHS) {
+    std::vector<Name> names;
+    std::vector<Block> wires;
+    for (size_t i = 0; i < N_OPS; ++i) {
+      names.push_back(makeName(i, depth));
+      Interest interest = makeInterest(names.back());
+      wires.push_back(interest.wireEncode());
+    }
+
+    measure("Interest", "encode", depth, 0, [&] {
+      for (const Name& name : names) {
+        m_sink += makeInterest(name).wireEncode().size();
+      }
+    });
+
+    measure("Interest", "decode", depth, 0, [&] {
+      for (const Block& wire : wires) {
+        Interest interest(Block(wire.getBuffer(), wire.begin(), wire.end()));
+        m_sink += interest.getName().size() + interest.getNonce();
+      }
+    });
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DataOperations)
+{
+  for (size_t depth : DEPTHS) {
+    for (size_t payloadSize : PAYLOAD_SIZES) {
+      std::vector<Name> names;
+      std::vector<Block> wires;
+      for (size_t i = 0; i < N_OPS; ++i) {
+        names.push_back(makeName(i, depth));
+        wires.push_back(makeData(names.back(), payloadSize)->wireEncode());
+      }
+
+      measure("Data", "encode", depth, payloadSize, [&] {
+        for (const Name& name : names) {
+          m_sink += makeData(name, payloadSize)->wireEncode().size();
+        }
+      });
+
+      measure("Data", "decode", depth, payloadSize, [&] {
+        for (const Block& wire : wires) {
+          Data data(Block(wire.getBuffer(), wire.begin(), wire.end()));
+          m_sink += data.getName().size() + data.getContent().value_size() +
+                    data.getSignature().getValue().value_size();
+        }
+      });
+
+      measure("Block", "parse", depth, payloadSize, [&] {
+        for (const Block& wire : wires) {
+          Block block(wire.getBuffer(), wire.begin(), wire.end());
+          block.parse();
+          m_sink += block.elements().size();
+        }
+      });
+    }
+  }
+
+  BOOST_CHECK_GT(m_sink, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "compact-name.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCompactName)
+
+BOOST_AUTO_TEST_CASE(Conversion)
+{
+  Name name("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+  name.appendSequenceNumber(1000);
+
+  CompactName compact(name);
+  BOOST_CHECK_EQUAL(compact.size(), name.size());
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+  BOOST_CHECK(compact.wireEncode() == name.wireEncode());
+  BOOST_CHECK_EQUAL(CompactName(name.wireEncode()).toName(), name);
+  BOOST_CHECK_EQUAL(compact.get(1), name::Component("NankaiDistrict"));
+  BOOST_CHECK_EQUAL(compact.get(-1), name.get(-1));
+  BOOST_CHECK_THROW(compact.get(7), CompactName::Error);
+  BOOST_CHECK_EQUAL(compact.toUri(), name.toUri());
+
+  Block notName = name::Component("A").wireEncode();
+  BOOST_CHECK_THROW(CompactName{notName}, tlv::Error);
+
+  CompactName empty;
+  BOOST_CHECK(empty.empty());
+  BOOST_CHECK_EQUAL(empty.toName(), Name());
+}
+
+BOOST_AUTO_TEST_CASE(Appends)
+{
+  CompactName compact("/S/region");
+  compact.append(name::Component("A"))
+         .appendNumber(300)
+         .appendSegment(2)
+         .appendSequenceNumber(70000);
+
+  Name name("/S/region");
+  name.append("A")
+      .appendNumber(300)
+      .appendSegment(2)
+      .appendSequenceNumber(70000);
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+
+  // the cached encoding is updated after a modification
+  Block wire = compact.wireEncode();
+  compact.push_back(name::Component("last"));
+  name.append("last");
+  BOOST_CHECK(wire != compact.wireEncode());
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+
+  CompactName twice(compact);
+  twice.append(twice);
+  BOOST_CHECK_EQUAL(twice.toName(), Name(name).append(name));
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+
+  // grows beyond inline storage
+  std::string large(300, 'x');
+  for (int i = 0; i < 20; ++i) {
+    compact.append(name::Component(large));
+    name.append(large);
+  }
+  BOOST_CHECK_EQUAL(compact.toName(), name);
+  BOOST_CHECK_GT(compact.getMemoryUsage(), 20 * large.size());
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  std::vector<std::string> uris{"/", "/A", "/A/B", "/A/C", "/AB", "/B", "/A/%00", "/%00/A"};
+  for (const std::string& uri1 : uris) {
+    for (const std::string& uri2 : uris) {
+      Name name1(uri1), name2(uri2);
+      CompactName compact1(name1), compact2(name2);
+      int expected = name1.compare(name2);
+      int actual = compact1.compare(compact2);
+      BOOST_CHECK_EQUAL(expected < 0, actual < 0);
+      BOOST_CHECK_EQUAL(expected == 0, actual == 0);
+      BOOST_CHECK_EQUAL(name1 == name2, compact1 == compact2);
+      BOOST_CHECK_EQUAL(name1.isPrefixOf(name2), compact1.isPrefixOf(compact2));
+      if (name1 == name2) {
+        BOOST_CHECK_EQUAL(std::hash<CompactName>()(compact1), std::hash<CompactName>()(compact2));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  CompactName compact("/S/region/A/app/%FE%01");
+  BOOST_CHECK_EQUAL(compact.getPrefix(-1).toName(), Name("/S/region/A/app"));
+  BOOST_CHECK_EQUAL(compact.getPrefix(2).toName(), Name("/S/region"));
+  BOOST_CHECK_EQUAL(compact.getPrefix(10), compact);
+  BOOST_CHECK(compact.getPrefix(-10).empty());
+  BOOST_CHECK(compact.getPrefix(-1).isPrefixOf(compact));
+  BOOST_CHECK(!CompactName("/S/reg").isPrefixOf(compact));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
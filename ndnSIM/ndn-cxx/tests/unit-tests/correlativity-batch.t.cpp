@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "correlativity-batch.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestCorrelativityBatch)
+
+BOOST_AUTO_TEST_CASE(MatchesStructuredNameView)
+{
+  std::vector<Name> names = {
+    Name("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion"),
+    Name("/S/NankaiDistrict/NanjingRoad/BinjiangStreet/A/TrafficInformer/RoadStatus"),
+    Name("/S/HepingDistrict/A/Weather/Forecast"),
+    Name("/S/NankaiDistrict/A/Weather/TrafficInformer/Weather"),
+    Name("/S/WeijingRoad/NankaiDistrict/WeijingRoad/A/RoadCongestion/TrafficInformer"),
+    Name("/A/TrafficInformer/RoadCongestion"),
+    Name("/S/NankaiDistrict/A"),
+    Name("/prefix/without/markers"),
+  };
+
+  // segments longer than the batched ones
+  Name longName("/S");
+  for (int i = 0; i < 40; ++i)
+    longName.append(i % 3 == 0 ? "NankaiDistrict" : "Road" + std::to_string(i));
+  longName.append("A").append("TrafficInformer");
+  for (int i = 0; i < 40; ++i)
+    longName.append("Item" + std::to_string(i % 7));
+  names.push_back(longName);
+
+  name::Dictionary dictionary;
+  CorrelativityBatch batch;
+  std::vector<StructuredNameView> views;
+  for (const Name& name : names) {
+    views.emplace_back(name);
+    batch.add(InternedStructuredName(views.back(), dictionary));
+  }
+  BOOST_CHECK_EQUAL(batch.size(), names.size());
+
+  std::vector<Name> queries = names;
+  queries.push_back(Name("/S/NankaiDistrict/Unknown/WeijingRoad/A/Unknown/TrafficInformer"));
+  std::vector<double> spatial;
+  std::vector<double> application;
+  for (const Name& query : queries) {
+    StructuredNameView queryView(query);
+    size_t dictionarySize = dictionary.size();
+    batch.score(InternedStructuredName::lookup(queryView, dictionary), spatial, application);
+    BOOST_CHECK_EQUAL(dictionary.size(), dictionarySize);
+
+    BOOST_REQUIRE_EQUAL(spatial.size(), names.size());
+    BOOST_REQUIRE_EQUAL(application.size(), names.size());
+    for (size_t k = 0; k < names.size(); ++k) {
+      BOOST_CHECK_CLOSE(spatial[k], queryView.spatialCorrelativityWith(views[k]), 1e-9);
+      BOOST_CHECK_CLOSE(application[k], queryView.applicationCorrelativityWith(views[k]), 1e-9);
+    }
+  }
+
+  // the memory is reused by the next samples
+  batch.clear();
+  BOOST_CHECK_EQUAL(batch.size(), 0);
+  batch.add(InternedStructuredName(views[2], dictionary));
+  batch.score(InternedStructuredName::lookup(views[2], dictionary), spatial, application);
+  BOOST_REQUIRE_EQUAL(spatial.size(), 1);
+  BOOST_CHECK_CLOSE(spatial[0], 1.0, 1e-9);
+  BOOST_CHECK_CLOSE(application[0], 1.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(UniqueLastComponent)
+{
+  name::Dictionary dictionary;
+  Name sample("/S/NankaiDistrict/A/TrafficInformer");
+  sample.appendSequenceNumber(1);
+  InternedStructuredName interned(StructuredNameView(sample), dictionary, true);
+  BOOST_CHECK_EQUAL(dictionary.size(), 2);
+  BOOST_CHECK_EQUAL(interned.applicationSize(), 2);
+  BOOST_CHECK_EQUAL(interned.applicationBegin()[1], InternedStructuredName::NONE);
+
+  // the same name has the correlativity of names with different last components
+  Name other("/S/NankaiDistrict/A/TrafficInformer");
+  other.appendSequenceNumber(2);
+  CorrelativityBatch batch;
+  batch.add(interned);
+  std::vector<double> spatial;
+  std::vector<double> application;
+  batch.score(InternedStructuredName(StructuredNameView(sample), dictionary, true),
+              spatial, application);
+  BOOST_CHECK_CLOSE(application[0], StructuredNameView(sample).applicationCorrelativityWith(
+                                      StructuredNameView(other)), 1e-9);
+  BOOST_CHECK_LT(application[0], 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
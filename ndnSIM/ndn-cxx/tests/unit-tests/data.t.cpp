@@ -369,6 +369,41 @@ BOOST_FIXTURE_TEST_CASE(Decode, TestDataFixture)
   BOOST_REQUIRE_EQUAL(signatureVerified, true);
 }
 
+BOOST_AUTO_TEST_CASE(LazyDecode)
+{
+  // SignatureInfo whose first element is not SignatureType
+  std::vector<uint8_t> wire(Data1, Data1 + sizeof(Data1));
+  BOOST_REQUIRE_EQUAL(wire[42], tlv::SignatureType);
+  wire[42] = tlv::KeyLocator;
+
+  // MetaInfo and Signature are decoded on first use
+  ndn::Data d;
+  BOOST_REQUIRE_NO_THROW(d.wireDecode(Block(wire.data(), wire.size())));
+  BOOST_CHECK_EQUAL(d.getName(), Name("/local/ndn/prefix"));
+  BOOST_CHECK_EQUAL(d.getContent().value_size(), sizeof(Content1));
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_THROW(d.getSignature(), tlv::Error);
+
+  // MetaInfo and Signature survive a modification of the decoded Data
+  ndn::Data d2(Block(Data1, sizeof(Data1)));
+  d2.setContent(Content1, 4);
+  BOOST_CHECK_EQUAL(d2.hasWire(), false);
+  BOOST_CHECK_EQUAL(d2.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d2.getSignature().getType(), static_cast<uint32_t>(Signature::Sha256WithRsa));
+
+  ndn::Data d3(d2.wireEncode());
+  BOOST_CHECK_EQUAL(d3.getContent().value_size(), 4);
+  BOOST_CHECK_EQUAL(d3.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK(d3.getSignature() == ndn::Data(Block(Data1, sizeof(Data1))).getSignature());
+
+  // a copy made before decoding decodes on its own
+  ndn::Data d4(Block(Data1, sizeof(Data1)));
+  ndn::Data d5(d4);
+  BOOST_CHECK_EQUAL(d5.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d4.getSignature().getValue().value_size(), 128);
+  BOOST_CHECK(d4 == d5);
+}
+
 BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
 {
   // manual data packet creation for now
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/buffer-pool.hpp"
+#include "encoding/buffer.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingBufferPool)
+
+BOOST_AUTO_TEST_CASE(SizeClasses)
+{
+  BufferPool::trim();
+  const BufferPoolStats& stats = BufferPool::getStats();
+
+  for (size_t size : {1, 64, 65, 256, 1500, 8800}) {
+    void* p = BufferPool::allocate(size);
+    BufferPool::deallocate(p, size);
+
+    // the released block is reused for any size of the same class
+    uint64_t nHeapAllocations = stats.nHeapAllocations;
+    size_t nFreeBlocks = stats.nFreeBlocks;
+    void* q = BufferPool::allocate(size);
+    BOOST_CHECK_EQUAL(q, p);
+    BOOST_CHECK_EQUAL(stats.nHeapAllocations, nHeapAllocations);
+    BOOST_CHECK_EQUAL(stats.nFreeBlocks, nFreeBlocks - 1);
+    BufferPool::deallocate(q, size);
+  }
+  BOOST_CHECK_EQUAL(stats.nFreeBlocks, BufferPool::N_SIZE_CLASSES);
+
+  // larger sizes are not pooled
+  uint64_t nHeapAllocations = stats.nHeapAllocations;
+  size_t nInUse = stats.nInUse;
+  void* p = BufferPool::allocate(8801);
+  BOOST_CHECK_EQUAL(stats.nHeapAllocations, nHeapAllocations + 1);
+  BOOST_CHECK_EQUAL(stats.nInUse, nInUse + 1);
+  BufferPool::deallocate(p, 8801);
+  BOOST_CHECK_EQUAL(stats.nInUse, nInUse);
+  BOOST_CHECK_EQUAL(stats.nFreeBlocks, BufferPool::N_SIZE_CLASSES);
+
+  BufferPool::trim();
+  BOOST_CHECK_EQUAL(stats.nFreeBlocks, 0);
+}
+
+#ifdef NDN_CXX_WITH_BUFFER_POOL
+
+BOOST_AUTO_TEST_CASE(MakeBuffer)
+{
+  BufferPool::trim();
+  const BufferPoolStats& stats = BufferPool::getStats();
+  uint8_t bytes[] = {0x01, 0x02, 0x03};
+
+  // Buffer with its control block, and its bytes
+  uint64_t nAllocations = stats.nAllocations;
+  BufferPtr buffer = makeBuffer(bytes, sizeof(bytes));
+  BOOST_CHECK_EQUAL(stats.nAllocations, nAllocations + 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer->begin(), buffer->end(), bytes, bytes + sizeof(bytes));
+
+  buffer.reset();
+  uint64_t nHeapAllocations = stats.nHeapAllocations;
+  buffer = makeBuffer(1000);
+  BOOST_CHECK_EQUAL(buffer->size(), 1000);
+  buffer.reset();
+  buffer = makeBuffer(bytes, sizeof(bytes));
+  BOOST_CHECK_EQUAL(stats.nHeapAllocations, nHeapAllocations + 1); // 1000 bytes
+}
+
+#endif // NDN_CXX_WITH_BUFFER_POOL
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/encoding-arena.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "interest.hpp"
+#include "data.hpp"
+#include "security/digest-sha256.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingEncodingArena)
+
+template<class Packet>
+static Block
+encodeInOwnBuffer(const Packet& packet)
+{
+  EncodingEstimator estimator;
+  size_t estimatedSize = packet.wireEncode(estimator);
+
+  EncodingBuffer buffer(estimatedSize, 0);
+  packet.wireEncode(buffer);
+  return buffer.block();
+}
+
+BOOST_AUTO_TEST_CASE(Commit)
+{
+  EncodingArena arena;
+  BOOST_CHECK_EQUAL(arena.getFreeSize(), 0);
+
+  Block blocks[3];
+  for (Block& block : blocks) {
+    arena.reserve();
+    EncodingBuffer encoder(arena.getChunk(), arena.getFreeSize());
+    encoder.prependByteArray(reinterpret_cast<const uint8_t*>("test"), 4);
+    encoder.prependVarNumber(4);
+    encoder.prependVarNumber(tlv::Content);
+    block = arena.commit(encoder);
+  }
+
+  BOOST_CHECK_EQUAL(arena.getMaxPacketSize(), 6);
+  BOOST_CHECK_EQUAL(arena.getFreeSize(), EncodingArena::CHUNK_SIZE - 3 * 6);
+  for (const Block& block : blocks) {
+    BOOST_CHECK(block.getBuffer() == arena.getChunk());
+    BOOST_CHECK_EQUAL(block.type(), tlv::Content);
+    BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(block.value()), 4), "test");
+  }
+  // packets are placed back to front
+  BOOST_CHECK(blocks[1].end() == blocks[0].begin());
+  BOOST_CHECK(blocks[2].end() == blocks[1].begin());
+}
+
+BOOST_AUTO_TEST_CASE(Detach)
+{
+  EncodingArena arena;
+  arena.reserve();
+  size_t freeSize = arena.getFreeSize();
+
+  EncodingBuffer encoder(arena.getChunk(), arena.getFreeSize());
+  encoder.prependVarNumber(0);
+  encoder.prependVarNumber(tlv::Content);
+  Block block = arena.detach(encoder);
+
+  BOOST_CHECK(block.getBuffer() != arena.getChunk());
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), 2);
+  BOOST_CHECK_EQUAL(block.type(), tlv::Content);
+  BOOST_CHECK_EQUAL(arena.getFreeSize(), freeSize);
+  BOOST_CHECK_EQUAL(arena.getMaxPacketSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(LargerThanFreeSpace)
+{
+  EncodingArena arena;
+  std::vector<uint8_t> value(EncodingArena::CHUNK_SIZE, 0xFF);
+
+  arena.reserve();
+  shared_ptr<Buffer> chunk = arena.getChunk();
+  EncodingBuffer encoder(arena.getChunk(), arena.getFreeSize());
+  encoder.prependRange(value.begin(), value.end());
+  encoder.prependVarNumber(value.size());
+  encoder.prependVarNumber(tlv::Content);
+
+  // the encoder moved to a buffer of its own, the chunk is unchanged
+  Block block = arena.commit(encoder);
+  BOOST_CHECK(block.getBuffer() != chunk);
+  BOOST_CHECK_EQUAL(block.value_size(), value.size());
+  BOOST_CHECK_EQUAL(arena.getFreeSize(), EncodingArena::CHUNK_SIZE);
+  BOOST_CHECK_EQUAL(arena.getMaxPacketSize(), block.size());
+
+  // the next chunk can hold the largest packet
+  arena.reserve();
+  BOOST_CHECK(arena.getChunk() != chunk);
+  BOOST_CHECK_GE(arena.getFreeSize(), block.size());
+}
+
+BOOST_AUTO_TEST_CASE(InterestWireEncode)
+{
+  Interest interest1("/A/B/C");
+  interest1.setNonce(1);
+  interest1.setInterestLifetime(time::seconds(2));
+  Interest interest2("/A/B/D");
+  interest2.setNonce(2);
+
+  const Block& wire1 = interest1.wireEncode();
+  const Block& wire2 = interest2.wireEncode();
+  BOOST_CHECK(wire1 == encodeInOwnBuffer(interest1));
+  BOOST_CHECK(wire2 == encodeInOwnBuffer(interest2));
+
+  // both Interests are in the chunk of the arena
+  BOOST_CHECK(wire1.getBuffer() == wire2.getBuffer());
+  BOOST_CHECK(wire1.getBuffer() == EncodingArena::get().getChunk());
+
+  BOOST_CHECK_EQUAL(Interest(wire1).getName(), Name("/A/B/C"));
+  BOOST_CHECK_EQUAL(Interest(wire2).getNonce(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(DataWireEncode)
+{
+  Data data("/A/B/C");
+  std::vector<uint8_t> content(1024, 0x01);
+  data.setContent(content.data(), content.size());
+  data.setSignature(DigestSha256());
+  data.setSignatureValue(Block(tlv::SignatureValue, make_shared<Buffer>(32)));
+
+  const Block& wire = data.wireEncode();
+  BOOST_CHECK(wire == encodeInOwnBuffer(data));
+
+  // Data has a buffer of its own, of the exact size
+  BOOST_CHECK(wire.getBuffer() != EncodingArena::get().getChunk());
+  BOOST_CHECK_EQUAL(wire.getBuffer()->size(), wire.size());
+  BOOST_CHECK_EQUAL(Data(wire).getContent().value_size(), content.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
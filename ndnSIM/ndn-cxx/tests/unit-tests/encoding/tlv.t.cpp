@@ -141,6 +141,44 @@ BOOST_AUTO_TEST_CASE(ReadFromBuffer)
   BOOST_CHECK_EQUAL(value, 4294967296LL);
 }
 
+BOOST_AUTO_TEST_CASE(ReadFromPointerMatchesIterator)
+{
+  // readers for plain pointers behave as the generic ones for every start and end
+  std::vector<uint8_t> buffer(BUFFER, BUFFER + sizeof(BUFFER));
+  for (size_t offset = 0; offset <= sizeof(BUFFER); ++offset) {
+    for (size_t size = 0; offset + size <= sizeof(BUFFER); ++size) {
+      const uint8_t* begin = BUFFER + offset;
+      uint64_t value = 0;
+      bool isOk = readVarNumber(begin, BUFFER + offset + size, value);
+
+      std::vector<uint8_t>::const_iterator iBegin = buffer.begin() + offset;
+      std::vector<uint8_t>::const_iterator iEnd = iBegin + size;
+      uint64_t iValue = 0;
+      bool iIsOk = readVarNumber(iBegin, iEnd, iValue);
+
+      BOOST_CHECK_EQUAL(isOk, iIsOk);
+      if (isOk) {
+        BOOST_CHECK_EQUAL(value, iValue);
+        BOOST_CHECK_EQUAL(begin - BUFFER, iBegin - buffer.begin());
+      }
+
+      begin = BUFFER + offset;
+      if (iIsOk)
+        BOOST_CHECK_EQUAL(readVarNumber(begin, BUFFER + offset + size), iValue);
+      else
+        BOOST_CHECK_THROW(readVarNumber(begin, BUFFER + offset + size), Error);
+    }
+  }
+
+  const uint8_t* begin = BUFFER + 10;
+  uint32_t type = 0;
+  BOOST_CHECK_EQUAL(readType(begin, BUFFER + sizeof(BUFFER), type), false);
+  begin = BUFFER + 10;
+  BOOST_CHECK_THROW(readType(begin, BUFFER + sizeof(BUFFER)), Error);
+  begin = BUFFER + 2;
+  BOOST_CHECK_EQUAL(readType(begin, BUFFER + sizeof(BUFFER)), 253);
+}
+
 BOOST_AUTO_TEST_CASE(ReadFromStream)
 {
   typedef boost::iostreams::stream<boost::iostreams::array_source> ArrayStream;
@@ -955,6 +955,82 @@ BOOST_AUTO_TEST_CASE(Encode)
   BOOST_CHECK_NE(i.getNonce(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(CopyWithNonce)
+{
+  ndn::Interest i(ndn::Name("/local/ndn/prefix"));
+  i.setNonce(1);
+  const Block& wire = i.wireEncode();
+
+  shared_ptr<Interest> copy = i.copyWithNonce(2);
+  BOOST_CHECK_EQUAL(copy->getNonce(), 2);
+  BOOST_CHECK_EQUAL(copy->getName(), i.getName());
+  BOOST_CHECK_EQUAL(copy->hasWire(), true);
+  BOOST_CHECK_NE(copy->wireEncode().wire(), wire.wire());
+  BOOST_CHECK_EQUAL(copy->wireEncode().size(), wire.size());
+
+  // the original wire format is not modified
+  BOOST_CHECK_EQUAL(i.getNonce(), 1);
+  BOOST_CHECK_EQUAL(Interest(wire).getNonce(), 1);
+  BOOST_CHECK_EQUAL(Interest(copy->wireEncode()).getNonce(), 2);
+
+  ndn::Interest noWire(ndn::Name("/local/ndn/prefix"));
+  BOOST_CHECK_EQUAL(noWire.copyWithNonce(3)->getNonce(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(SetNonceCopyOnWrite)
+{
+  ndn::Interest i(ndn::Name("/local/ndn/prefix"));
+  i.setNonce(1);
+  Block wire = i.wireEncode();
+
+  // the wire format is shared with the block above, it is copied before the nonce is replaced
+  i.setNonce(2);
+  BOOST_CHECK_EQUAL(i.hasWire(), true);
+  BOOST_CHECK_NE(i.wireEncode().wire(), wire.wire());
+  BOOST_CHECK_EQUAL(Interest(wire).getNonce(), 1);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 2);
+
+  // the copied wire format is used only by i, the nonce is replaced in place
+  const uint8_t* patched = i.wireEncode().wire();
+  i.setNonce(3);
+  BOOST_CHECK_EQUAL(i.wireEncode().wire(), patched);
+  BOOST_CHECK_EQUAL(i.getNonce(), 3);
+
+  // a copy shares the wire format
+  ndn::Interest copy(i);
+  copy.setNonce(4);
+  BOOST_CHECK_EQUAL(copy.getNonce(), 4);
+  BOOST_CHECK_EQUAL(i.getNonce(), 3);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 3);
+  BOOST_CHECK_EQUAL(Interest(copy.wireEncode()).getNonce(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(SetInterestLifetimeInPlace)
+{
+  ndn::Interest i(ndn::Name("/local/ndn/prefix"));
+  i.setNonce(1);
+  i.setInterestLifetime(time::milliseconds(2000));
+  Block wire = i.wireEncode();
+
+  // same encoded width, the lifetime is replaced in a copy of the wire format
+  i.setInterestLifetime(time::milliseconds(3000));
+  BOOST_CHECK_EQUAL(i.hasWire(), true);
+  BOOST_CHECK_EQUAL(i.getInterestLifetime(), time::milliseconds(3000));
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getInterestLifetime(), time::milliseconds(3000));
+  BOOST_CHECK_EQUAL(Interest(wire).getInterestLifetime(), time::milliseconds(2000));
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 1);
+
+  // different width, the Interest is encoded again
+  i.setInterestLifetime(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(i.hasWire(), false);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getInterestLifetime(), time::milliseconds(100));
+
+  // the default lifetime is not encoded
+  i.setInterestLifetime(DEFAULT_INTEREST_LIFETIME);
+  BOOST_CHECK_EQUAL(i.hasWire(), false);
+  BOOST_CHECK(i.wireEncode().find(tlv::InterestLifetime) == i.wireEncode().elements_end());
+}
+
 BOOST_AUTO_TEST_CASE(EncodeWithLocalHeader)
 {
   ndn::Interest interest(ndn::Name("/local/ndn/prefix"));
@@ -185,6 +185,53 @@ BOOST_AUTO_TEST_CASE(FibRemoveNextHop)
   BOOST_CHECK_EQUAL(p1.getFaceId(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FibBatch)
+{
+  FibBatchCommand command;
+
+  ControlParameters add;
+  add.setName("ndn:/A")
+     .setFaceId(22)
+     .setCost(6);
+  ControlParameters remove;
+  remove.setName("ndn:/B");
+  BOOST_CHECK_NO_THROW(command.validateRequest(add));
+  BOOST_CHECK_NO_THROW(command.validateRequest(remove));
+  BOOST_CHECK_NO_THROW(command.validateResponse(ControlParameters()));
+
+  command.applyDefaultsToRequest(remove);
+  BOOST_REQUIRE(remove.hasFaceId());
+  BOOST_CHECK_EQUAL(remove.getFaceId(), 0);
+  BOOST_CHECK(!remove.hasCost());
+
+  std::vector<ControlParameters> entries{add, remove};
+  Name n1;
+  BOOST_CHECK_NO_THROW(n1 = command.getRequestName("/PREFIX", entries));
+  BOOST_REQUIRE_EQUAL(n1.size(), 4);
+  BOOST_CHECK(Name("ndn:/PREFIX/fib/batch").isPrefixOf(n1));
+
+  std::vector<ControlParameters> decoded = BatchControlCommand::decodeEntries(n1[-1]);
+  BOOST_REQUIRE_EQUAL(decoded.size(), 2);
+  BOOST_CHECK_EQUAL(decoded[0].getName(), Name("ndn:/A"));
+  BOOST_CHECK_EQUAL(decoded[0].getFaceId(), 22);
+  BOOST_CHECK_EQUAL(decoded[0].getCost(), 6);
+  BOOST_CHECK_EQUAL(decoded[1].getName(), Name("ndn:/B"));
+  BOOST_CHECK(!decoded[1].hasCost());
+
+  BOOST_CHECK_THROW(command.getRequestName("/PREFIX", std::vector<ControlParameters>()),
+                    ControlCommand::ArgumentError);
+
+  ControlParameters invalid;
+  invalid.setFaceId(22);
+  entries.push_back(invalid);
+  BOOST_CHECK_THROW(command.getRequestName("/PREFIX", entries), ControlCommand::ArgumentError);
+
+  static const uint8_t TRUNCATED[] = {0x68, 0x05, 0x07, 0x03, 0x08, 0x01};
+  BOOST_CHECK_THROW(BatchControlCommand::decodeEntries(name::Component(TRUNCATED,
+                                                                       sizeof(TRUNCATED))),
+                    tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(StrategyChoiceSet)
 {
   StrategyChoiceSetCommand command;
@@ -259,6 +306,46 @@ BOOST_AUTO_TEST_CASE(RibRegister)
   BOOST_CHECK_NO_THROW(command.validateResponse(p2));
 }
 
+BOOST_AUTO_TEST_CASE(RibBatchRegister)
+{
+  RibBatchRegisterCommand command;
+
+  ControlParameters p1;
+  p1.setName("ndn:/S/region/A");
+  ControlParameters p2;
+  p2.setName("ndn:/S/region/B")
+    .setFaceId(2)
+    .setCost(6)
+    .setExpirationPeriod(time::milliseconds(10000));
+  BOOST_CHECK_NO_THROW(command.validateRequest(p1));
+  BOOST_CHECK_NO_THROW(command.validateRequest(p2));
+  BOOST_CHECK_NO_THROW(command.validateResponse(ControlParameters()));
+
+  Name n1;
+  BOOST_CHECK_NO_THROW(n1 = command.getRequestName("/PREFIX",
+                                                   std::vector<ControlParameters>{p1, p2}));
+  BOOST_CHECK(Name("ndn:/PREFIX/rib/batch-register").isPrefixOf(n1));
+
+  std::vector<ControlParameters> decoded = BatchControlCommand::decodeEntries(n1[-1]);
+  BOOST_REQUIRE_EQUAL(decoded.size(), 2);
+  BOOST_CHECK_EQUAL(decoded[1].getName(), Name("ndn:/S/region/B"));
+  BOOST_CHECK_EQUAL(decoded[1].getExpirationPeriod(), time::milliseconds(10000));
+
+  command.applyDefaultsToRequest(p1);
+  BOOST_REQUIRE(p1.hasFaceId());
+  BOOST_CHECK_EQUAL(p1.getFaceId(), 0);
+  BOOST_REQUIRE(p1.hasOrigin());
+  BOOST_CHECK_EQUAL(p1.getOrigin(), static_cast<uint64_t>(ROUTE_ORIGIN_APP));
+  BOOST_REQUIRE(p1.hasFlags());
+  BOOST_CHECK_EQUAL(p1.getFlags(), static_cast<uint64_t>(ROUTE_FLAG_CHILD_INHERIT));
+
+  ControlParameters p3;
+  p3.setName("ndn:/S")
+    .setStrategy("ndn:/strategy/P");
+  BOOST_CHECK_THROW(command.getRequestName("/PREFIX", std::vector<ControlParameters>{p1, p3}),
+                    ControlCommand::ArgumentError);
+}
+
 BOOST_AUTO_TEST_CASE(RibUnregister)
 {
   RibUnregisterCommand command;
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-dictionary.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameDictionary)
+
+BOOST_AUTO_TEST_CASE(Intern)
+{
+  name::Dictionary dictionary;
+
+  name::Dictionary::Handle a = dictionary.intern(name::Component("A"));
+  name::Dictionary::Handle s = dictionary.intern(name::Component("S"));
+  BOOST_CHECK_NE(a, s);
+  BOOST_CHECK_EQUAL(dictionary.intern(name::Component("A")), a);
+  BOOST_CHECK_EQUAL(dictionary.size(), 2);
+
+  // same value, different type
+  name::Dictionary::Handle digest = dictionary.intern(name::Component(Block(tlv::ImplicitSha256DigestComponent,
+                                                                            make_shared<Buffer>(32))));
+  name::Dictionary::Handle generic = dictionary.intern(name::Component(make_shared<Buffer>(32)));
+  BOOST_CHECK_NE(digest, generic);
+
+  name::Dictionary::Handle handle = 0;
+  BOOST_CHECK(dictionary.find(name::Component("S"), handle));
+  BOOST_CHECK_EQUAL(handle, s);
+  BOOST_CHECK(!dictionary.find(name::Component("missing"), handle));
+  BOOST_CHECK_EQUAL(dictionary.size(), 4);
+
+  BOOST_CHECK_EQUAL(dictionary.get(a), name::Component("A"));
+
+  // large components and many small ones span several arena chunks
+  std::string large(10000, 'x');
+  name::Dictionary::Handle largeHandle = dictionary.intern(name::Component(large));
+  std::vector<name::Dictionary::Handle> handles;
+  for (int i = 0; i < 5000; ++i) {
+    handles.push_back(dictionary.intern(name::Component::fromNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(dictionary.get(largeHandle), name::Component(large));
+  for (int i = 0; i < 5000; ++i) {
+    BOOST_CHECK_EQUAL(dictionary.get(handles[i]).toNumber(), i);
+  }
+  BOOST_CHECK_GT(dictionary.getMemoryUsage(), large.size());
+
+  dictionary.clear();
+  BOOST_CHECK_EQUAL(dictionary.size(), 0);
+  BOOST_CHECK(!dictionary.find(name::Component("A"), handle));
+}
+
+BOOST_AUTO_TEST_CASE(Names)
+{
+  name::Dictionary dictionary;
+
+  InternedName name1(Name("/S/NankaiDistrict/A/TrafficInformer/%00%01"), dictionary);
+  InternedName name2(Name("/S/NankaiDistrict/A/TrafficInformer/%00%02"), dictionary);
+  InternedName prefix(Name("/S/NankaiDistrict/A/TrafficInformer"), dictionary);
+  BOOST_CHECK_EQUAL(dictionary.size(), 6);
+
+  BOOST_CHECK_EQUAL(name1.size(), 5);
+  BOOST_CHECK(name1 != name2);
+  BOOST_CHECK(name1.getPrefix(-1) == name2.getPrefix(-1));
+  BOOST_CHECK(name1.getPrefix(-1) == prefix);
+  BOOST_CHECK_EQUAL(std::hash<InternedName>()(name1.getPrefix(4)), std::hash<InternedName>()(prefix));
+  BOOST_CHECK_EQUAL(name1.get(0), name1.get(-5));
+  BOOST_CHECK_EQUAL(name1.getPrefix(10).size(), 5);
+  BOOST_CHECK(name1.getPrefix(-10).empty());
+
+  BOOST_CHECK(prefix.isPrefixOf(name1));
+  BOOST_CHECK(prefix.isPrefixOf(prefix));
+  BOOST_CHECK(!name1.isPrefixOf(prefix));
+  BOOST_CHECK(!name1.isPrefixOf(name2));
+
+  BOOST_CHECK_EQUAL(name1.toName(), Name("/S/NankaiDistrict/A/TrafficInformer/%00%01"));
+  BOOST_CHECK_EQUAL(InternedName().toName(), Name());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -449,6 +449,42 @@ BOOST_AUTO_TEST_CASE(Compare)
   BOOST_CHECK_EQUAL( 1, Name("/Z/A/C/Y").compare(1, 2, Name("/X/A"),   1));
 }
 
+BOOST_AUTO_TEST_CASE(CompareWire)
+{
+  // encoded names are compared on their wire bytes, which must agree with the component order
+  std::string large(300, 'x');
+  std::vector<Name> names{Name("/"), Name("/A"), Name("/A/B"), Name("/A/C"), Name("/AB"),
+                          Name("/B"), Name("/A/%00"), Name("/%00/A"), Name("/A/B/C/D/E/F/G/H"),
+                          Name("/A/B/C/D/E/F/G/I"), Name("/A").append(large),
+                          Name("/A").append(large + "y"), Name("/A").appendNumber(1),
+                          Name("/A").appendNumber(256),
+                          Name("/A").appendImplicitSha256Digest(std::vector<uint8_t>(32, 1).data(),
+                                                                32)};
+
+  for (const Name& name1 : names) {
+    Name wire1(Name(name1).wireEncode());
+    BOOST_REQUIRE(wire1.hasWire() && !name1.hasWire());
+    for (const Name& name2 : names) {
+      Name wire2(Name(name2).wireEncode());
+      int expected = name1.compare(name2);
+      int actual = wire1.compare(wire2);
+      BOOST_CHECK_EQUAL(expected < 0, actual < 0);
+      BOOST_CHECK_EQUAL(expected == 0, actual == 0);
+      BOOST_CHECK_EQUAL(name1.equals(name2), wire1.equals(wire2));
+      BOOST_CHECK_EQUAL(name1.isPrefixOf(name2), wire1.isPrefixOf(wire2));
+
+      for (size_t pos1 = 0; pos1 < name1.size(); ++pos1) {
+        for (size_t pos2 = 0; pos2 < name2.size(); ++pos2) {
+          expected = name1.compare(pos1, 2, name2, pos2, 3);
+          actual = wire1.compare(pos1, 2, wire2, pos2, 3);
+          BOOST_CHECK_EQUAL(expected < 0, actual < 0);
+          BOOST_CHECK_EQUAL(expected == 0, actual == 0);
+        }
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(ZeroLengthComponentCompare)
 {
   name::Component comp0("");
@@ -559,6 +595,31 @@ BOOST_AUTO_TEST_CASE(SubNameOutOfRangeIndexes)
   BOOST_CHECK_EQUAL("/first/second/last", name.getSubName(-10, 10));
 }
 
+BOOST_AUTO_TEST_CASE(Correlativity)
+{
+  BOOST_CHECK_CLOSE(Name("/a/b/c").correlativityWith("/a/b/c"), 1.0, 1e-9);
+  BOOST_CHECK_EQUAL(Name("/a/b").correlativityWith("/c/d"), 0.0);
+  BOOST_CHECK_EQUAL(Name().correlativityWith("/c/d"), 0.0);
+
+  // common positions 1 and 3 out of 3: (2^-1 + 2^-3) / (2^-1 + 2^-2 + 2^-3)
+  BOOST_CHECK_CLOSE(Name("/a/b/c").correlativityWith("/a/x/c"), 0.625 / 0.875, 1e-9);
+
+  // components with equal hash input but different order
+  BOOST_CHECK_CLOSE(Name("/a/b").correlativityWith("/b/a"),
+                    Name("/b/a").correlativityWith("/a/b"), 1e-9);
+
+  // names longer than the inline hash storage
+  Name longName;
+  for (int i = 0; i < 40; ++i) {
+    longName.append(std::to_string(i));
+  }
+  BOOST_CHECK_CLOSE(longName.correlativityWith(longName), 1.0, 1e-9);
+
+  Name name("/S/x/y/A/app/z");
+  BOOST_CHECK_CLOSE(Name::correlativity(name.begin() + 1, name.begin() + 3,
+                                        name.begin() + 1, name.begin() + 3), 1.0, 1e-9);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
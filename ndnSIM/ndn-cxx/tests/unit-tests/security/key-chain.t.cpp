@@ -417,6 +417,45 @@ BOOST_AUTO_TEST_CASE(GeneralSigningInterface)
                                                                 interest5.getName()[-1].blockFromValue()))));
 }
 
+BOOST_AUTO_TEST_CASE(SignBatch)
+{
+  KeyChain keyChain;
+  Name id("/id");
+  Name certName = keyChain.createIdentity(id);
+  shared_ptr<IdentityCertificate> idCert = keyChain.getCertificate(certName);
+
+  std::vector<shared_ptr<Data>> batch;
+  for (uint64_t segment = 0; segment < 5; ++segment) {
+    auto data = make_shared<Data>(Name("/file").appendSegment(segment));
+    data->setContent(reinterpret_cast<const uint8_t*>("segment"), 7);
+    batch.push_back(data);
+  }
+  keyChain.signBatch(batch, SigningInfo(SigningInfo::SIGNER_TYPE_CERT, certName));
+
+  for (const shared_ptr<Data>& data : batch) {
+    BOOST_CHECK_EQUAL(data->getSignature().getKeyLocator().getName(), certName.getPrefix(-1));
+    BOOST_CHECK(data->getSignature().getValue() == batch[0]->getSignature().getValue());
+
+    Data received(data->wireEncode());
+    BOOST_CHECK(security::hasMerkleProof(received.getSignature()));
+    BOOST_CHECK(Validator::verifySignature(received, idCert->getPublicKeyInfo()));
+  }
+
+  // the proof of one packet does not cover another
+  Data tampered(*batch[1]);
+  tampered.setContent(reinterpret_cast<const uint8_t*>("changed"), 7);
+  tampered.wireEncode();
+  BOOST_CHECK(!Validator::verifySignature(tampered, idCert->getPublicKeyInfo()));
+
+  // SignatureSha256 packets are signed one by one
+  std::vector<shared_ptr<Data>> digestBatch{make_shared<Data>("/digest/1"),
+                                            make_shared<Data>("/digest/2")};
+  keyChain.signBatch(digestBatch, SigningInfo(SigningInfo::SIGNER_TYPE_SHA256));
+  for (const shared_ptr<Data>& data : digestBatch) {
+    BOOST_CHECK(Validator::verifySignature(*data, DigestSha256(data->getSignature())));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
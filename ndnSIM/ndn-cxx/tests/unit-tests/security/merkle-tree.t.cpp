@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/merkle-tree.hpp"
+#include "util/crypto.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(SecurityMerkleTree)
+
+static std::vector<ConstBufferPtr>
+makeLeaves(size_t nLeaves)
+{
+  std::vector<ConstBufferPtr> leaves;
+  for (size_t i = 0; i < nLeaves; ++i) {
+    std::string value = "leaf" + std::to_string(i);
+    leaves.push_back(crypto::sha256(reinterpret_cast<const uint8_t*>(value.data()),
+                                    value.size()));
+  }
+  return leaves;
+}
+
+static bool
+isRoot(const MerkleProof& proof, const Buffer& leaf, const MerkleTree& tree)
+{
+  try {
+    return *proof.computeRoot(leaf) == tree.getRoot();
+  }
+  catch (const MerkleProof::Error&) {
+    return false;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Proofs)
+{
+  BOOST_CHECK_THROW(MerkleTree(std::vector<ConstBufferPtr>()), MerkleProof::Error);
+
+  for (size_t nLeaves = 1; nLeaves <= 17; ++nLeaves) {
+    std::vector<ConstBufferPtr> leaves = makeLeaves(nLeaves);
+    MerkleTree tree(leaves);
+    BOOST_CHECK_EQUAL(tree.getNLeaves(), nLeaves);
+
+    for (size_t i = 0; i < nLeaves; ++i) {
+      MerkleProof proof = tree.getProof(i);
+      BOOST_CHECK_EQUAL(proof.getLeafIndex(), i);
+      BOOST_CHECK(isRoot(proof, *leaves[i], tree));
+
+      MerkleProof decoded(proof.wireEncode());
+      BOOST_CHECK_EQUAL(decoded.getNLeaves(), nLeaves);
+      BOOST_CHECK(isRoot(decoded, *leaves[i], tree));
+
+      if (nLeaves > 1) {
+        // another leaf, or the right leaf at another position
+        BOOST_CHECK(!isRoot(proof, *leaves[(i + 1) % nLeaves], tree));
+        BOOST_CHECK(!isRoot(MerkleProof((i + 1) % nLeaves, nLeaves, proof.getPath()),
+                            *leaves[i], tree));
+      }
+    }
+  }
+
+  BOOST_CHECK_THROW(MerkleTree(makeLeaves(3)).getProof(3), MerkleProof::Error);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidProofs)
+{
+  std::vector<ConstBufferPtr> leaves = makeLeaves(4);
+  MerkleTree tree(leaves);
+  std::vector<ConstBufferPtr> path = tree.getProof(1).getPath();
+  BOOST_REQUIRE_EQUAL(path.size(), 2);
+
+  BOOST_CHECK_THROW(MerkleProof(1, 4, {path[0]}).computeRoot(*leaves[1]), MerkleProof::Error);
+  BOOST_CHECK_THROW(MerkleProof(1, 4, {path[0], path[1], path[1]}).computeRoot(*leaves[1]),
+                    MerkleProof::Error);
+  BOOST_CHECK_THROW(MerkleProof(4, 4, path).computeRoot(*leaves[1]), MerkleProof::Error);
+
+  BOOST_CHECK_THROW(MerkleProof(Block(tlv::MerkleProof)), MerkleProof::Error);
+  BOOST_CHECK_THROW(MerkleProof(makeNonNegativeIntegerBlock(tlv::MerkleLeafIndex, 0)),
+                    MerkleProof::Error);
+}
+
+BOOST_AUTO_TEST_CASE(DataLeaf)
+{
+  Data data("/batch/segment/0");
+  data.setContent(reinterpret_cast<const uint8_t*>("content"), 7);
+
+  SignatureInfo info(tlv::SignatureSha256WithRsa, KeyLocator(Name("/key")));
+  data.setSignature(Signature(info));
+  EncodingBuffer encoder;
+  data.wireEncode(encoder, true);
+  ConstBufferPtr expected = crypto::sha256(encoder.buf(), encoder.size());
+
+  MerkleTree tree({expected, expected});
+  info.appendTypeSpecificTlv(tree.getProof(0).wireEncode());
+  data.setSignature(Signature(info));
+  EncodingBuffer signedEncoder;
+  data.wireEncode(signedEncoder, true);
+  data.wireEncode(signedEncoder, makeBinaryBlock(tlv::SignatureValue, tree.getRoot().buf(),
+                                                 tree.getRoot().size()));
+
+  Data received(data.wireEncode());
+  BOOST_REQUIRE(hasMerkleProof(received.getSignature()));
+  BOOST_CHECK(*computeMerkleLeaf(received) == *expected);
+  BOOST_CHECK(*getMerkleProof(received.getSignature()).computeRoot(*expected) == tree.getRoot());
+
+  BOOST_CHECK(!hasMerkleProof(Signature(SignatureInfo(tlv::SignatureSha256WithRsa))));
+  BOOST_CHECK_THROW(getMerkleProof(Signature(SignatureInfo(tlv::SignatureSha256WithRsa))),
+                    MerkleProof::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/sec-public-info-memory.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+class PibMemoryFixture
+{
+public:
+  PibMemoryFixture()
+    : keyChain("pib-memory:", "tpm-memory:")
+  {
+    keyName = keyChain.generateEcdsaKeyPair("/TestSecPublicInfoMemory/id", true);
+    certificate = keyChain.selfSign(keyName);
+    keyName2 = keyChain.generateEcdsaKeyPair("/TestSecPublicInfoMemory/id", false);
+    certificate2 = keyChain.selfSign(keyName2);
+  }
+
+public:
+  KeyChain keyChain;
+  Name keyName;
+  Name keyName2;
+  shared_ptr<IdentityCertificate> certificate;
+  shared_ptr<IdentityCertificate> certificate2;
+  SecPublicInfoMemory pib;
+};
+
+BOOST_AUTO_TEST_SUITE(SecuritySecPublicInfoMemory)
+
+BOOST_AUTO_TEST_CASE(TpmLocator)
+{
+  SecPublicInfoMemory pib;
+
+  BOOST_REQUIRE_THROW(pib.getTpmLocator(), SecPublicInfo::Error);
+  pib.addIdentity("/test/id1");
+
+  // TPM locator is not set yet, the content is kept
+  pib.setTpmLocator("tpm-memory:");
+  BOOST_CHECK(pib.doesIdentityExist("/test/id1"));
+  BOOST_CHECK_EQUAL(pib.getTpmLocator(), "tpm-memory:");
+
+  pib.setTpmLocator("tpm-memory:");
+  BOOST_CHECK(pib.doesIdentityExist("/test/id1"));
+
+  // a different TPM resets the content
+  pib.setTpmLocator("tpm-file:");
+  BOOST_CHECK(!pib.doesIdentityExist("/test/id1"));
+}
+
+BOOST_FIXTURE_TEST_CASE(Defaults, PibMemoryFixture)
+{
+  Name identity("/TestSecPublicInfoMemory/id");
+
+  BOOST_CHECK_THROW(pib.getDefaultIdentity(), SecPublicInfo::Error);
+  BOOST_CHECK_THROW(pib.getDefaultKeyNameForIdentity(identity), SecPublicInfo::Error);
+  BOOST_CHECK_THROW(pib.getCertificate(certificate->getName()), SecPublicInfo::Error);
+  BOOST_CHECK_THROW(pib.setDefaultKeyNameForIdentity(keyName), SecPublicInfo::Error);
+
+  // adding the certificate adds the key and the identity
+  pib.addCertificateAsIdentityDefault(*certificate);
+  pib.addCertificate(*certificate2);
+  BOOST_CHECK(pib.doesIdentityExist(identity));
+  BOOST_CHECK(pib.doesPublicKeyExist(keyName2));
+  BOOST_CHECK_EQUAL(pib.getPublicKeyType(keyName), KEY_TYPE_ECDSA);
+  BOOST_CHECK_EQUAL(pib.getPublicKeyType("/TestSecPublicInfoMemory/id/ksk-0"), KEY_TYPE_NULL);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyNameForIdentity(identity), keyName);
+  BOOST_CHECK_EQUAL(pib.getDefaultCertificateNameForKey(keyName), certificate->getName());
+  BOOST_CHECK_THROW(pib.getDefaultCertificateNameForKey(keyName2), SecPublicInfo::Error);
+  BOOST_CHECK(pib.getCertificate(certificate->getName())->wireEncode() ==
+              certificate->wireEncode());
+
+  std::vector<Name> names;
+  pib.getAllKeyNamesOfIdentity(identity, names, true);
+  BOOST_REQUIRE_EQUAL(names.size(), 1);
+  BOOST_CHECK_EQUAL(names[0], keyName);
+  names.clear();
+  pib.getAllKeyNamesOfIdentity(identity, names, false);
+  BOOST_REQUIRE_EQUAL(names.size(), 1);
+  BOOST_CHECK_EQUAL(names[0], keyName2);
+  names.clear();
+  pib.getAllCertificateNames(names, false);
+  BOOST_REQUIRE_EQUAL(names.size(), 1);
+  BOOST_CHECK_EQUAL(names[0], certificate2->getName());
+
+  pib.setDefaultIdentity(identity);
+  BOOST_CHECK_EQUAL(pib.getDefaultIdentity(), identity);
+  pib.refreshDefaultCertificate();
+  BOOST_REQUIRE(pib.getDefaultCertificate() != nullptr);
+  BOOST_CHECK_EQUAL(pib.getDefaultCertificate()->getName(), certificate->getName());
+
+  pib.setDefaultKeyNameForIdentity(keyName2);
+  BOOST_CHECK_EQUAL(pib.getDefaultKeyNameForIdentity(identity), keyName2);
+}
+
+BOOST_FIXTURE_TEST_CASE(Delete, PibMemoryFixture)
+{
+  Name identity("/TestSecPublicInfoMemory/id");
+  pib.addCertificateAsSystemDefault(*certificate);
+  pib.addCertificate(*certificate2);
+
+  pib.deleteCertificateInfo(certificate->getName());
+  BOOST_CHECK(!pib.doesCertificateExist(certificate->getName()));
+  BOOST_CHECK_THROW(pib.getDefaultCertificateNameForKey(keyName), SecPublicInfo::Error);
+  BOOST_CHECK(pib.doesPublicKeyExist(keyName));
+
+  pib.deletePublicKeyInfo(keyName);
+  BOOST_CHECK(!pib.doesPublicKeyExist(keyName));
+  BOOST_CHECK_THROW(pib.getDefaultKeyNameForIdentity(identity), SecPublicInfo::Error);
+  BOOST_CHECK(pib.doesPublicKeyExist(keyName2));
+
+  pib.deleteIdentityInfo(identity);
+  BOOST_CHECK(!pib.doesIdentityExist(identity));
+  BOOST_CHECK(!pib.doesPublicKeyExist(keyName2));
+  BOOST_CHECK(!pib.doesCertificateExist(certificate2->getName()));
+  BOOST_CHECK_THROW(pib.getDefaultIdentity(), SecPublicInfo::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/sec-tpm-memory.hpp"
+#include "security/key-chain.hpp"
+#include "security/signing-helpers.hpp"
+#include "security/validator.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(SecuritySecTpmMemory)
+
+BOOST_AUTO_TEST_CASE(Delete)
+{
+  SecTpmMemory tpm;
+
+  Name keyName("/TestSecTpmMemory/Delete/ksk-1");
+  BOOST_CHECK_NO_THROW(tpm.generateKeyPairInTpm(keyName, EcdsaKeyParams()));
+  BOOST_CHECK_THROW(tpm.generateKeyPairInTpm(keyName, EcdsaKeyParams()), SecTpmMemory::Error);
+
+  BOOST_CHECK_EQUAL(tpm.doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC), true);
+  BOOST_CHECK_EQUAL(tpm.doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE), true);
+  BOOST_CHECK_EQUAL(tpm.doesKeyExistInTpm(keyName, KEY_CLASS_SYMMETRIC), false);
+
+  tpm.deleteKeyPairInTpm(keyName);
+
+  BOOST_CHECK_EQUAL(tpm.doesKeyExistInTpm(keyName, KEY_CLASS_PUBLIC), false);
+  BOOST_CHECK_EQUAL(tpm.doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE), false);
+  BOOST_CHECK_THROW(tpm.getPublicKeyFromTpm(keyName), SecTpmMemory::Error);
+}
+
+BOOST_AUTO_TEST_CASE(SignVerify)
+{
+  SecTpmMemory tpm;
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+
+  Name rsaKeyName("/TestSecTpmMemory/SignVerify/ksk-rsa");
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(rsaKeyName, RsaKeyParams(2048)));
+  Block rsaSigValue = tpm.signInTpm(content, sizeof(content), rsaKeyName, DIGEST_ALGORITHM_SHA256);
+  shared_ptr<PublicKey> rsaKey = tpm.getPublicKeyFromTpm(rsaKeyName);
+  BOOST_CHECK_EQUAL(rsaKey->getKeyType(), KEY_TYPE_RSA);
+  SignatureSha256WithRsa rsaSig;
+  rsaSig.setValue(rsaSigValue);
+  BOOST_CHECK(Validator::verifySignature(content, sizeof(content), rsaSig, *rsaKey));
+
+  Name ecdsaKeyName("/TestSecTpmMemory/SignVerify/ksk-ecdsa");
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(ecdsaKeyName, EcdsaKeyParams()));
+  Block ecdsaSigValue = tpm.signInTpm(content, sizeof(content),
+                                      ecdsaKeyName, DIGEST_ALGORITHM_SHA256);
+  shared_ptr<PublicKey> ecdsaKey = tpm.getPublicKeyFromTpm(ecdsaKeyName);
+  BOOST_CHECK_EQUAL(ecdsaKey->getKeyType(), KEY_TYPE_ECDSA);
+  SignatureSha256WithEcdsa ecdsaSig;
+  ecdsaSig.setValue(ecdsaSigValue);
+  BOOST_CHECK(Validator::verifySignature(content, sizeof(content), ecdsaSig, *ecdsaKey));
+  BOOST_CHECK(!Validator::verifySignature(content, sizeof(content), ecdsaSig, *rsaKey));
+
+  BOOST_CHECK_THROW(tpm.signInTpm(content, sizeof(content), "/TestSecTpmMemory/ksk-none",
+                                  DIGEST_ALGORITHM_SHA256),
+                    SecTpmMemory::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ImportExportKey)
+{
+  SecTpmMemory tpm;
+  SecTpmMemory tpm2;
+
+  Name keyName("/TestSecTpmMemory/ImportExportKey/ksk-1");
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, EcdsaKeyParams()));
+
+  ConstBufferPtr exported;
+  BOOST_REQUIRE_NO_THROW(exported = tpm.exportPrivateKeyPkcs5FromTpm(keyName, "1234"));
+  BOOST_REQUIRE(tpm2.importPrivateKeyPkcs5IntoTpm(keyName, exported->buf(), exported->size(),
+                                                  "1234"));
+  BOOST_CHECK_EQUAL(tpm2.doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE), true);
+  BOOST_CHECK_EQUAL(*tpm2.getPublicKeyFromTpm(keyName), *tpm.getPublicKeyFromTpm(keyName));
+
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+  SignatureSha256WithEcdsa sig;
+  sig.setValue(tpm2.signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256));
+  BOOST_CHECK(Validator::verifySignature(content, sizeof(content), sig,
+                                         *tpm.getPublicKeyFromTpm(keyName)));
+}
+
+BOOST_AUTO_TEST_CASE(InMemoryKeyChain)
+{
+  KeyChain keyChain("pib-memory:", "tpm-memory:");
+  BOOST_CHECK_EQUAL(keyChain.getPib().getPibLocator(), "pib-memory:");
+  BOOST_CHECK_EQUAL(keyChain.getTpm().getTpmLocator(), "tpm-memory:");
+
+  // signing as an unknown identity creates it, with a cheap key
+  Data data("/TestSecTpmMemory/InMemoryKeyChain/data");
+  Name identity("/TestSecTpmMemory/InMemoryKeyChain");
+  BOOST_REQUIRE_NO_THROW(keyChain.sign(data, signingByIdentity(identity)));
+
+  Name keyName = keyChain.getDefaultKeyNameForIdentity(identity);
+  BOOST_CHECK_EQUAL(keyChain.getPib().getPublicKeyType(keyName), KEY_TYPE_ECDSA);
+  BOOST_CHECK(Validator::verifySignature(data, *keyChain.getPublicKey(keyName)));
+
+  // contents are not shared between instances
+  KeyChain keyChain2("pib-memory:", "tpm-memory:");
+  BOOST_CHECK(!keyChain2.doesIdentityExist(identity));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
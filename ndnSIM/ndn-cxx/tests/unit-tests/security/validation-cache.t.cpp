@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/validation-cache.hpp"
+#include "security/identity-certificate.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace tests {
+
+class ValidationCacheFixture : public UnitTestTimeFixture
+{
+public:
+  ValidationCacheFixture()
+  {
+    cert1.setName("/tmp/KEY/ksk-1/ID-CERT/%FD%01");
+    cert1.setNotBefore(time::system_clock::now());
+    cert1.setNotAfter(time::system_clock::now() + time::days(1));
+
+    cert2.setName("/tmp/KEY/ksk-1/ID-CERT/%FD%02");
+    cert2.setNotBefore(time::system_clock::now());
+    cert2.setNotAfter(time::system_clock::now() + time::seconds(10));
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, const std::string& content)
+  {
+    auto data = make_shared<Data>(name);
+    data->setContent(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+    return util::signData(data);
+  }
+
+public:
+  IdentityCertificate cert1;
+  IdentityCertificate cert2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SecurityValidationCache, ValidationCacheFixture)
+
+BOOST_AUTO_TEST_CASE(InsertContains)
+{
+  ValidationCache cache;
+  shared_ptr<Data> data = makeData("/A/1", "a");
+  BOOST_CHECK(!cache.contains(*data, cert1));
+
+  cache.insert(*data, cert1);
+  BOOST_CHECK(cache.contains(*data, cert1));
+  BOOST_CHECK(!cache.contains(*data, cert2));
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  // same Name, different content
+  BOOST_CHECK(!cache.contains(*makeData("/A/1", "b"), cert1));
+
+  // same packet, decoded again
+  Data received(data->wireEncode());
+  BOOST_CHECK(cache.contains(received, cert1));
+
+  cache.insert(*data, cert1);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK(!cache.contains(*data, cert1));
+}
+
+BOOST_AUTO_TEST_CASE(Expiry)
+{
+  ValidationCache cache(10, time::seconds(60));
+  shared_ptr<Data> data = makeData("/A/1", "a");
+  cache.insert(*data, cert1);
+  cache.insert(*data, cert2);
+
+  // cert2 is no longer valid
+  advanceClocks(time::seconds(20));
+  BOOST_CHECK(cache.contains(*data, cert1));
+  BOOST_CHECK(!cache.contains(*data, cert2));
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  // lifetime of the entry
+  advanceClocks(time::seconds(50));
+  BOOST_CHECK(!cache.contains(*data, cert1));
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  ValidationCache cache(2);
+  BOOST_CHECK_EQUAL(cache.getCapacity(), 2);
+  shared_ptr<Data> data1 = makeData("/A/1", "1");
+  shared_ptr<Data> data2 = makeData("/A/2", "2");
+  shared_ptr<Data> data3 = makeData("/A/3", "3");
+
+  cache.insert(*data1, cert1);
+  cache.insert(*data2, cert1);
+  BOOST_CHECK(cache.contains(*data1, cert1)); // data2 becomes the least recently used
+
+  cache.insert(*data3, cert1);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.contains(*data1, cert1));
+  BOOST_CHECK(!cache.contains(*data2, cert1));
+  BOOST_CHECK(cache.contains(*data3, cert1));
+}
+
+BOOST_AUTO_TEST_CASE(MerkleRoot)
+{
+  ValidationCache cache;
+  Buffer root1(32);
+  Buffer root2(32);
+  root2[0] = 1;
+
+  cache.insertMerkleRoot(root1, cert1);
+  BOOST_CHECK(cache.containsMerkleRoot(root1, cert1));
+  BOOST_CHECK(!cache.containsMerkleRoot(root1, cert2));
+  BOOST_CHECK(!cache.containsMerkleRoot(root2, cert1));
+
+  advanceClocks(time::days(2));
+  BOOST_CHECK(!cache.containsMerkleRoot(root1, cert1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
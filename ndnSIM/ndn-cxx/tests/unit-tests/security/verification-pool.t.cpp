@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/verification-pool.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio/deadline_timer.hpp>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(SecurityVerificationPool)
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  boost::asio::io_service io;
+  boost::asio::io_service::work work(io);
+  VerificationPool pool(io, 4);
+  BOOST_CHECK_EQUAL(pool.getNThreads(), 4);
+
+  const int N_TASKS = 200;
+  std::vector<std::pair<int, bool>> results;
+  std::thread::id ioThread = std::this_thread::get_id();
+  bool isOnIoThread = true;
+
+  for (int i = 0; i < N_TASKS; ++i) {
+    pool.submit([i] {
+                  // later tasks finish first
+                  std::this_thread::sleep_for(std::chrono::microseconds((N_TASKS - i) % 7 * 100));
+                  if (i % 5 == 0)
+                    throw std::runtime_error("bad signature");
+                  return i % 3 != 0;
+                },
+                [&, i] (bool isVerified) {
+                  isOnIoThread = isOnIoThread && std::this_thread::get_id() == ioThread;
+                  results.push_back(std::make_pair(i, isVerified));
+                  if (results.size() == N_TASKS)
+                    io.stop();
+                });
+  }
+
+  boost::asio::deadline_timer timeout(io, boost::posix_time::seconds(10));
+  timeout.async_wait([&io] (const boost::system::error_code& error) {
+      if (!error)
+        io.stop();
+    });
+  io.run();
+
+  BOOST_CHECK(isOnIoThread);
+  BOOST_REQUIRE_EQUAL(results.size(), N_TASKS);
+  for (int i = 0; i < N_TASKS; ++i) {
+    BOOST_CHECK_EQUAL(results[i].first, i);
+    BOOST_CHECK_EQUAL(results[i].second, i % 5 != 0 && i % 3 != 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DestroyWithPendingTasks)
+{
+  boost::asio::io_service io;
+  int nContinuations = 0;
+  {
+    VerificationPool pool(io, 1);
+    for (int i = 0; i < 100; ++i) {
+      pool.submit([] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    return true;
+                  },
+                  [&] (bool) { ++nContinuations; });
+    }
+  }
+  io.run();
+  BOOST_CHECK_LT(nContinuations, 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "structured-name-view.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestStructuredNameView)
+
+BOOST_AUTO_TEST_CASE(Segments)
+{
+  Name name("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+  StructuredNameView view(name);
+
+  BOOST_REQUIRE(view.hasSpatialPart());
+  BOOST_REQUIRE(view.hasApplicationPart());
+  BOOST_CHECK_EQUAL(view.spatialEnd() - view.spatialBegin(), 2);
+  BOOST_CHECK_EQUAL(*view.spatialBegin(), name::Component("NankaiDistrict"));
+  BOOST_CHECK_EQUAL(view.applicationEnd() - view.applicationBegin(), 2);
+  BOOST_CHECK_EQUAL(*view.applicationBegin(), name::Component("TrafficInformer"));
+
+  BOOST_CHECK_EQUAL(name.getSpPart(), Name("/NankaiDistrict/WeijingRoad"));
+  BOOST_CHECK_EQUAL(name.getAppPart(), Name("/TrafficInformer/RoadCongestion"));
+}
+
+BOOST_AUTO_TEST_CASE(MissingMarkers)
+{
+  Name noMarkers("/prefix/S1/AA");
+  StructuredNameView view1(noMarkers);
+  BOOST_CHECK(!view1.hasSpatialPart());
+  BOOST_CHECK(!view1.hasApplicationPart());
+  BOOST_CHECK_THROW(noMarkers.getAppPart(), Name::Error);
+
+  Name appOnly("/A/Weather");
+  StructuredNameView view2(appOnly);
+  BOOST_CHECK(!view2.hasSpatialPart());
+  BOOST_CHECK(view2.hasApplicationPart());
+  BOOST_CHECK_EQUAL(view2.spatialCorrelativityWith(view2), 0.0);
+  BOOST_CHECK_CLOSE(view2.applicationCorrelativityWith(view2), 1.0, 1e-9);
+
+  StructuredNameView empty;
+  BOOST_CHECK(!empty.hasSpatialPart());
+  BOOST_CHECK(!empty.hasApplicationPart());
+}
+
+BOOST_AUTO_TEST_CASE(Correlativity)
+{
+  Name name1("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+  Name name2("/S/NankaiDistrict/NanjingRoad/BinjiangStreet/A/TrafficInformer/RoadStatus");
+  StructuredNameView view1(name1);
+  StructuredNameView view2(name2);
+
+  BOOST_CHECK_CLOSE(view1.spatialCorrelativityWith(view2),
+                    name1.getSpPart().correlativityWith(name2.getSpPart()), 1e-9);
+  BOOST_CHECK_CLOSE(view1.applicationCorrelativityWith(view2),
+                    name1.getAppPart().correlativityWith(name2.getAppPart()), 1e-9);
+  BOOST_CHECK_CLOSE(name1.getSpcorrelativityWith(name2), view1.spatialCorrelativityWith(view2),
+                    1e-9);
+  BOOST_CHECK_CLOSE(name1.getAppcorrelativityWith(name2),
+                    view1.applicationCorrelativityWith(view2), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -82,6 +82,20 @@ BOOST_AUTO_TEST_CASE(ConstructFromStream)
                                 digest2->buf() + digest2->size());
 }
 
+BOOST_AUTO_TEST_CASE(HmacSha256)
+{
+  // RFC 4231, test case 2
+  std::string key = "Jefe";
+  std::string input = "what do ya want for nothing?";
+  ConstBufferPtr hmac = crypto::hmacSha256(reinterpret_cast<const uint8_t*>(key.data()),
+                                           key.size(),
+                                           reinterpret_cast<const uint8_t*>(input.data()),
+                                           input.size());
+  BOOST_REQUIRE(hmac != nullptr);
+  BOOST_CHECK_EQUAL(toHex(*hmac),
+                    "5BDCC146BF60754E6A042426089575C75A003F089D2739839DEC58B964EC3843");
+}
+
 BOOST_AUTO_TEST_CASE(Compare)
 {
   uint8_t origin[4] = {0x01, 0x02, 0x03, 0x04};
@@ -28,6 +28,7 @@
 #include "util/regex/regex-repeat-matcher.hpp"
 #include "util/regex/regex-backref-matcher.hpp"
 #include "util/regex/regex-top-matcher.hpp"
+#include "util/regex/regex-automaton.hpp"
 #include "util/regex.hpp"
 
 #include "boost-test.hpp"
@@ -464,6 +465,59 @@ BOOST_AUTO_TEST_CASE(TopMatcherAdvanced)
   BOOST_CHECK_EQUAL(cm->expand(), Name("/ndn/edu/ucla/yingdi/mac/"));
 }
 
+BOOST_AUTO_TEST_CASE(Automaton)
+{
+  std::vector<string> exprs = {
+    "<a><b>", "<a>*<b>", "(<a><b>)+<c>?", "[<a><b>]{2,3}", "[^<a>]*<a>", "<>*<c><>",
+    "(<a>(<b>)*)*", "<a>{,2}<b>{1,}", "<(x+)\\.(y)>", "((<a>)?<b>)*<a>", "[<a><.*c>]+[^<b>]?",
+  };
+  std::vector<string> components = {"a", "b", "c", "ac", "x.y", "xx.y"};
+
+  for (const string& expr : exprs) {
+    RegexAutomaton automaton(expr);
+    shared_ptr<RegexPatternListMatcher> matcher =
+      make_shared<RegexPatternListMatcher>(expr, make_shared<RegexBackrefManager>());
+
+    // every name of up to 4 components
+    std::vector<Name> names(1);
+    for (size_t i = 0; i < names.size(); ++i) {
+      BOOST_CHECK_MESSAGE(automaton.match(names[i]) == matcher->match(names[i], 0, names[i].size()),
+                          expr << " " << names[i]);
+      if (names[i].size() < 4) {
+        for (const string& component : components) {
+          names.push_back(Name(names[i]).append(component));
+        }
+      }
+    }
+    // components matched by the same component sets share their class
+    BOOST_CHECK_LE(automaton.getNClasses(), components.size());
+    BOOST_CHECK_GT(automaton.getNDfaStates(), 0);
+  }
+
+  RegexAutomaton automaton("<a><>*");
+  BOOST_CHECK_EQUAL(automaton.match(Name("/x/a/b"), 1, 2), true);
+  BOOST_CHECK_EQUAL(automaton.match(Name("/x/a/b"), 0, 3), false);
+
+  BOOST_CHECK_THROW(RegexAutomaton("<a"), RegexMatcher::Error);
+  BOOST_CHECK_THROW(RegexAutomaton("(<a>"), RegexMatcher::Error);
+}
+
+BOOST_AUTO_TEST_CASE(TopMatcherAutomaton)
+{
+  // without back references, the match is decided by the automaton alone
+  shared_ptr<Regex> cm = make_shared<Regex>("<a>[<b><c>]*<d>$");
+  BOOST_CHECK_EQUAL(cm->match(Name("/x/a/b/c/b/d")), true);
+  BOOST_CHECK_EQUAL(cm->getMatchResult().size(), 6);
+  BOOST_CHECK_EQUAL(cm->expand("\\0"), Name("/x/a/b/c/b/d"));
+  BOOST_CHECK_EQUAL(cm->match(Name("/x/a/b/e/d")), false);
+  BOOST_CHECK_EQUAL(cm->getMatchResult().size(), 0);
+
+  cm = make_shared<Regex>("^<a>(<>*)<d>");
+  BOOST_CHECK_EQUAL(cm->match(Name("/a/b/c/d/e")), true);
+  BOOST_CHECK_EQUAL(cm->expand("\\1"), Name("/b/c"));
+  BOOST_CHECK_EQUAL(cm->match(Name("/x/a/b/c/d/e")), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
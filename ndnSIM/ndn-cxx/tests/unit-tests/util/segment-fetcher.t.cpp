@@ -292,6 +292,73 @@ BOOST_FIXTURE_TEST_CASE(TripleWithInitialSegmentFetching, Fixture)
 }
 
 
+BOOST_FIXTURE_TEST_CASE(PipelinedOutOfOrder, Fixture)
+{
+  SegmentFetcher::Options options;
+  options.useConstantCwnd = true;
+  options.initCwnd = 4;
+
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)), options,
+                        DontVerifySegment(),
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1));
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+  advanceClocks(time::milliseconds(1), 10);
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 5);
+  for (uint64_t segment = 1; segment <= 4; ++segment) {
+    BOOST_CHECK_EQUAL(face->sentInterests[segment].getName(),
+                      Name("/hello/world/version0").appendSegment(segment));
+  }
+
+  face->receive(*makeData("/hello/world/version0", 3, true));
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 2, false));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nDatas, 0);
+
+  face->receive(*makeData("/hello/world/version0", 1, false));
+  advanceClocks(time::milliseconds(1), 10);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nDatas, 1);
+  BOOST_CHECK_EQUAL(dataSize, 56);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(PipelinedRetransmission, Fixture)
+{
+  SegmentFetcher::Options options;
+  options.rttOptions.initialRto = time::milliseconds(100);
+  options.maxRetries = 1;
+
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)), options,
+                        DontVerifySegment(),
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1));
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+  advanceClocks(time::milliseconds(1), 10);
+
+  // slow start: the window grew to two segments
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 3);
+
+  face->receive(*makeData("/hello/world/version0", 2, true));
+  advanceClocks(time::milliseconds(10), 100);
+
+  // segment 1 is retransmitted once, then fetching gives up
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(face->sentInterests[3].getName(),
+                    Name("/hello/world/version0").appendSegment(1));
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, static_cast<uint32_t>(SegmentFetcher::INTEREST_TIMEOUT));
+  BOOST_CHECK_EQUAL(nDatas, 0);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
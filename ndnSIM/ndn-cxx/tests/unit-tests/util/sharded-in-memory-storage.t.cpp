@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/sharded-in-memory-storage.hpp"
+#include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-persistent.hpp"
+
+#include "boost-test.hpp"
+#include "../make-interest-data.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Sharded)
+
+static unique_ptr<InMemoryStorage>
+makePersistent()
+{
+  return unique_ptr<InMemoryStorage>(new InMemoryStoragePersistent);
+}
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  ShardedInMemoryStorage ims(4, 2, &makePersistent);
+  BOOST_CHECK_EQUAL(ims.getNShards(), 4);
+
+  std::vector<shared_ptr<Data>> stored;
+  for (const char* uri : {"/A", "/A/B", "/A/B/C", "/A/C/D", "/B/A/1", "/B/A/2", "/B/C"}) {
+    stored.push_back(makeData(uri));
+    ims.insert(*stored.back());
+  }
+  BOOST_CHECK_EQUAL(ims.size(), stored.size());
+
+  for (const shared_ptr<Data>& data : stored) {
+    BOOST_REQUIRE(ims.find(data->getName()) != nullptr);
+    BOOST_CHECK_EQUAL(ims.find(data->getName())->getName(), data->getName());
+    BOOST_REQUIRE(ims.find(data->getFullName()) != nullptr);
+    BOOST_CHECK_EQUAL(ims.find(data->getFullName())->getFullName(), data->getFullName());
+    BOOST_REQUIRE(ims.find(*makeInterest(data->getFullName())) != nullptr);
+  }
+  BOOST_CHECK(ims.find("/A/D") == nullptr);
+  BOOST_CHECK(ims.find(*makeInterest("/C")) == nullptr);
+
+  ims.erase("/B/A");
+  BOOST_CHECK_EQUAL(ims.size(), stored.size() - 2);
+  BOOST_CHECK(ims.find("/B/A/1") == nullptr);
+  ims.erase("/A");
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  ims.erase(stored.back()->getFullName(), false);
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SameAsSingleStorage)
+{
+  ShardedInMemoryStorage sharded(8, 3, &makePersistent);
+  InMemoryStoragePersistent single;
+
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      shared_ptr<Data> data = makeData(Name("/S/region").appendNumber(i).appendNumber(j));
+      sharded.insert(*data);
+      single.insert(*data);
+    }
+  }
+
+  Exclude exclude;
+  exclude.excludeAfter(name::Component::fromNumber(3));
+  std::vector<Name> names{"/", "/S", "/S/region", Name("/S/region").appendNumber(2),
+                          Name("/S/region").appendNumber(2).appendNumber(3)};
+  for (const Name& name : names) {
+    for (int childSelector = 0; childSelector <= 1; ++childSelector) {
+      for (bool hasExclude : {false, true}) {
+        Interest interest(name);
+        interest.setChildSelector(childSelector);
+        if (hasExclude)
+          interest.setExclude(exclude);
+
+        shared_ptr<const Data> expected = single.find(interest);
+        shared_ptr<const Data> actual = sharded.find(interest);
+        BOOST_REQUIRE_EQUAL(expected == nullptr, actual == nullptr);
+        if (expected != nullptr)
+          BOOST_CHECK_EQUAL(actual->getFullName(), expected->getFullName());
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  ShardedInMemoryStorage ims(4, 2, [] {
+      return unique_ptr<InMemoryStorage>(new InMemoryStorageLru(1000));
+    });
+
+  // Data are encoded and their full names computed before they are shared by the threads
+  static const int N_THREADS = 4;
+  static const int N_PACKETS = 200;
+  std::vector<std::vector<shared_ptr<Data>>> packets(N_THREADS);
+  for (int t = 0; t < N_THREADS; ++t) {
+    for (int i = 0; i < N_PACKETS; ++i) {
+      packets[t].push_back(makeData(Name("/producer").appendNumber(t).appendNumber(i)));
+      packets[t].back()->getFullName();
+    }
+  }
+
+  std::vector<int> nFound(N_THREADS, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < N_THREADS; ++t) {
+    threads.emplace_back([&, t] {
+        for (const shared_ptr<Data>& data : packets[t]) {
+          ims.insert(*data);
+        }
+        for (const shared_ptr<Data>& data : packets[t]) {
+          if (ims.find(data->getName()) != nullptr)
+            ++nFound[t];
+        }
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(ims.size(), N_THREADS * N_PACKETS);
+  for (int t = 0; t < N_THREADS; ++t) {
+    BOOST_CHECK_EQUAL(nFound[t], N_PACKETS);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Sharded
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -95,12 +95,15 @@ BOOST_AUTO_TEST_CASE(FromHexChar)
 BOOST_AUTO_TEST_CASE(FromHex)
 {
   BOOST_CHECK_NO_THROW(fromHex("48656c6c6f2c20776f726c6421"));
-  BOOST_CHECK(*fromHex("48656c6c6f2c20776f726c6421") ==
-    (std::vector<uint8_t>{0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x21}));
+  ConstBufferPtr buffer = fromHex("48656c6c6f2c20776f726c6421");
+  std::vector<uint8_t> expected{0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f, 0x72, 0x6c,
+                                0x64, 0x21};
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer->begin(), buffer->end(), expected.begin(), expected.end());
 
   BOOST_CHECK_NO_THROW(fromHex("012a3Bc4defAB5CdEF"));
-  BOOST_CHECK(*fromHex("012a3Bc4defAB5CdEF") ==
-    (std::vector<uint8_t>{0x01, 0x2a, 0x3b, 0xc4, 0xde, 0xfa, 0xb5, 0xcd, 0xef}));
+  buffer = fromHex("012a3Bc4defAB5CdEF");
+  expected = {0x01, 0x2a, 0x3b, 0xc4, 0xde, 0xfa, 0xb5, 0xcd, 0xef};
+  BOOST_CHECK_EQUAL_COLLECTIONS(buffer->begin(), buffer->end(), expected.begin(), expected.end());
 
   BOOST_CHECK_THROW(fromHex("1"), StringHelperError);
   BOOST_CHECK_THROW(fromHex("zz"), StringHelperError);
@@ -0,0 +1,428 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-benchmark-compare.cpp
+
+#include "ns3/core-module.h"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+/**
+ * Runs another benchmark several times, and compares its results with a baseline stored in a
+ * JSON file, so that the performance impact of a change can be checked before merging.
+ *
+ * The benchmark is any command printing tab-separated tables, like the other programs in
+ * tests/other: a line with a non-numeric value after its first column is the header of the
+ * following rows, lines starting with # are ignored.  Every numeric cell is a metric named
+ * "<first column of the row>/<column header>", e.g., "Interest/p99(us)" of
+ * ndn-forwarder-benchmark.  The peak resident size of every run is added as "PeakRSS(KB)".
+ *
+ * With --save, the samples of all runs are written to the baseline.  Otherwise, for every
+ * metric of the baseline, the difference of the means is reported with its confidence
+ * interval (Welch's t-test).  The change is significant when the interval does not include
+ * zero; metrics whose column contains "/s" or "Satisfaction" are better when higher, all others
+ * (times, allocations, memory) when lower.  The exit status is 1 if any metric regressed.
+ *
+ *     ./waf --run "ndn-benchmark-compare --runs=10 --baseline=forwarder.json --save
+ *                  --command='build/src/ndnSIM/tests/other/ndn-forwarder-benchmark --rounds=20000'"
+ *     (change the code, rebuild)
+ *     ./waf --run "ndn-benchmark-compare --runs=10 --baseline=forwarder.json
+ *                  --command='build/src/ndnSIM/tests/other/ndn-forwarder-benchmark --rounds=20000'"
+ */
+class BenchmarkCompare {
+public:
+  BenchmarkCompare()
+    : m_runs(10)
+    , m_baseline("benchmark-baseline.json")
+    , m_confidence(0.95)
+    , m_shouldSave(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  typedef std::map<std::string, std::vector<double>> Samples;
+
+  struct Interval {
+    double mean;
+    double halfWidth;
+  };
+
+  void
+  runOnce(Samples& samples) const;
+
+  static void
+  parseTables(const std::string& output, Samples& samples);
+
+  void
+  save(const Samples& samples) const;
+
+  Samples
+  load() const;
+
+  /**
+   * @return the difference of the means of \p current and \p baseline, with the half width
+   *         of its confidence interval
+   */
+  Interval
+  compare(const std::vector<double>& baseline, const std::vector<double>& current) const;
+
+  static double
+  quantile(double confidence, double df);
+
+  static bool
+  isHigherBetter(const std::string& metric);
+
+private:
+  uint32_t m_runs;
+  std::string m_command;
+  std::string m_baseline;
+  double m_confidence;
+  bool m_shouldSave;
+};
+
+void
+BenchmarkCompare::runOnce(Samples& samples) const
+{
+  int fds[2];
+  if (pipe(fds) != 0) {
+    NS_FATAL_ERROR("pipe failed: " << std::strerror(errno));
+  }
+
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    dup2(fds[1], STDOUT_FILENO);
+    close(fds[1]);
+    execl("/bin/sh", "sh", "-c", m_command.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+  }
+  close(fds[1]);
+  if (pid < 0) {
+    NS_FATAL_ERROR("fork failed: " << std::strerror(errno));
+  }
+
+  std::string output;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) != 0) {
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      break;
+    output.append(buffer, n);
+  }
+  close(fds[0]);
+
+  // the resource usage of the benchmark alone, not of the previous runs
+  int status = 0;
+  ::rusage usage;
+  while (wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    NS_FATAL_ERROR("Benchmark failed: " << m_command);
+  }
+
+  parseTables(output, samples);
+  samples["PeakRSS(KB)"].push_back(usage.ru_maxrss);
+}
+
+void
+BenchmarkCompare::parseTables(const std::string& output, Samples& samples)
+{
+  std::vector<std::string> header;
+  std::istringstream lines(output);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::vector<std::string> cells;
+    std::istringstream is(line);
+    std::string cell;
+    while (std::getline(is, cell, '\t')) {
+      cells.push_back(cell);
+    }
+
+    if (cells.size() < 2)
+      continue;
+
+    // cells without a number (e.g., "-" or "failed") are skipped
+    std::map<size_t, double> values;
+    for (size_t i = 1; i < cells.size(); ++i) {
+      char* end = nullptr;
+      double value = std::strtod(cells[i].c_str(), &end);
+      if (end != cells[i].c_str() && *end == '\0')
+        values[i] = value;
+    }
+
+    if (values.empty()) {
+      // a header, or a row of a failed configuration, which has fewer cells
+      if (header.empty() || cells.size() >= header.size())
+        header = cells;
+      continue;
+    }
+
+    for (const auto& value : values) {
+      std::string column = value.first < header.size() ? header[value.first]
+                                                       : std::to_string(value.first);
+      samples[cells[0] + "/" + column].push_back(value.second);
+    }
+  }
+}
+
+void
+BenchmarkCompare::save(const Samples& samples) const
+{
+  std::ofstream os(m_baseline.c_str());
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << m_baseline);
+  }
+
+  os.precision(10);
+  os << "{\n"
+     << "  \"command\": \"";
+  for (char c : m_command) {
+    if (c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  os << "\",\n"
+     << "  \"runs\": " << m_runs << ",\n"
+     << "  \"metrics\": {";
+  bool isFirst = true;
+  for (const auto& metric : samples) {
+    os << (isFirst ? "\n" : ",\n") << "    \"" << metric.first << "\": [";
+    for (size_t i = 0; i < metric.second.size(); ++i) {
+      os << (i == 0 ? "" : ", ") << metric.second[i];
+    }
+    os << "]";
+    isFirst = false;
+  }
+  os << "\n  }\n}\n";
+}
+
+BenchmarkCompare::Samples
+BenchmarkCompare::load() const
+{
+  boost::property_tree::ptree tree;
+  try {
+    boost::property_tree::read_json(m_baseline, tree);
+  }
+  catch (const boost::property_tree::json_parser_error& e) {
+    NS_FATAL_ERROR("Cannot read the baseline: " << e.what());
+  }
+
+  std::string command = tree.get<std::string>("command", "");
+  if (command != m_command) {
+    std::cerr << "Warning: the baseline was recorded with a different command: " << command
+              << std::endl;
+  }
+
+  Samples samples;
+  // metric names contain '/', which must not be taken as a path separator
+  for (const auto& metric : tree.get_child("metrics", boost::property_tree::ptree())) {
+    std::vector<double>& values = samples[metric.first];
+    for (const auto& value : metric.second) {
+      values.push_back(value.second.get_value<double>());
+    }
+  }
+  return samples;
+}
+
+double
+BenchmarkCompare::quantile(double confidence, double df)
+{
+  // two-sided quantiles of Student's t distribution, for 90%, 95% and 99% confidence
+  static const double t90[] = {6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833,
+                               1.812, 1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734,
+                               1.729, 1.725, 1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703,
+                               1.701, 1.699, 1.697};
+  static const double t95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                               2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+                               2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+                               2.048, 2.045, 2.042};
+  static const double t99[] = {63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250,
+                               3.169, 3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878,
+                               2.861, 2.845, 2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771,
+                               2.763, 2.756, 2.750};
+
+  const double* table = confidence >= 0.99 ? t99 : confidence >= 0.95 ? t95 : t90;
+  double normal = confidence >= 0.99 ? 2.576 : confidence >= 0.95 ? 1.960 : 1.645;
+  // Welch's degrees of freedom are not integers, rounding down is conservative
+  size_t i = static_cast<size_t>(std::max(1.0, std::floor(df)));
+  return i <= 30 ? table[i - 1] : normal;
+}
+
+BenchmarkCompare::Interval
+BenchmarkCompare::compare(const std::vector<double>& baseline,
+                          const std::vector<double>& current) const
+{
+  auto meanAndVariance = [] (const std::vector<double>& values, double& mean, double& variance) {
+    mean = 0;
+    for (double value : values) {
+      mean += value;
+    }
+    mean /= values.size();
+    variance = 0;
+    for (double value : values) {
+      variance += (value - mean) * (value - mean);
+    }
+    variance = values.size() > 1 ? variance / (values.size() - 1) : 0;
+  };
+
+  double baselineMean, baselineVariance, currentMean, currentVariance;
+  meanAndVariance(baseline, baselineMean, baselineVariance);
+  meanAndVariance(current, currentMean, currentVariance);
+
+  double vb = baselineVariance / baseline.size();
+  double vc = currentVariance / current.size();
+  if (vb + vc == 0) {
+    return Interval{currentMean - baselineMean, 0};
+  }
+
+  double df = (vb + vc) * (vb + vc);
+  double denominator = 0;
+  if (baseline.size() > 1)
+    denominator += vb * vb / (baseline.size() - 1);
+  if (current.size() > 1)
+    denominator += vc * vc / (current.size() - 1);
+  df = denominator > 0 ? df / denominator : 1;
+
+  return Interval{currentMean - baselineMean, quantile(m_confidence, df) * std::sqrt(vb + vc)};
+}
+
+bool
+BenchmarkCompare::isHigherBetter(const std::string& metric)
+{
+  // the column header follows the first column of the row
+  std::string column = metric.substr(metric.find('/') + 1);
+  return column.find("/s") != std::string::npos
+         || column.find("Satisfaction") != std::string::npos;
+}
+
+int
+BenchmarkCompare::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("command", "Benchmark to run, with its arguments", m_command);
+  cmd.AddValue("runs", "Number of runs of the benchmark", m_runs);
+  cmd.AddValue("baseline", "JSON file with the baseline samples", m_baseline);
+  cmd.AddValue("save", "Store the runs as the baseline instead of comparing", m_shouldSave);
+  cmd.AddValue("confidence", "Confidence level of the intervals: 0.90, 0.95 or 0.99",
+               m_confidence);
+  cmd.Parse(argc, argv);
+
+  if (m_command.empty()) {
+    NS_FATAL_ERROR("No benchmark to run, see --command");
+  }
+  if (m_runs < 2) {
+    NS_FATAL_ERROR("At least 2 runs are needed for confidence intervals");
+  }
+
+  Samples samples;
+  for (uint32_t i = 0; i < m_runs; ++i) {
+    runOnce(samples);
+    std::cerr << "Run " << i + 1 << "/" << m_runs << " done" << std::endl;
+  }
+
+  if (m_shouldSave) {
+    save(samples);
+    std::cout << "# baseline of " << samples.size() << " metrics written to " << m_baseline
+              << "\n";
+    return 0;
+  }
+
+  Samples baseline = load();
+  std::cout << "# " << m_confidence * 100 << "% confidence intervals of the change, "
+            << m_runs << " runs\n";
+  std::cout << "Metric"
+            << "\t"
+            << "Baseline"
+            << "\t"
+            << "Current"
+            << "\t"
+            << "Change(%)"
+            << "\t"
+            << "CI(%)"
+            << "\t"
+            << "Verdict"
+            << "\n";
+
+  size_t nRegressions = 0;
+  for (const auto& metric : baseline) {
+    auto current = samples.find(metric.first);
+    if (metric.second.empty() || current == samples.end() || current->second.empty()) {
+      std::cout << metric.first << "\t-\t-\t-\t-\tmissing\n";
+      continue;
+    }
+
+    Interval difference = compare(metric.second, current->second);
+    double baselineMean = 0;
+    for (double value : metric.second) {
+      baselineMean += value;
+    }
+    baselineMean /= metric.second.size();
+    double scale = baselineMean != 0 ? 100 / std::abs(baselineMean) : 0;
+
+    std::string verdict = "~";
+    if (std::abs(difference.mean) > difference.halfWidth) {
+      bool isBetter = (difference.mean > 0) == isHigherBetter(metric.first);
+      verdict = isBetter ? "improvement" : "REGRESSION";
+      if (!isBetter)
+        ++nRegressions;
+    }
+
+    std::cout << metric.first << "\t" << baselineMean << "\t" << baselineMean + difference.mean
+              << "\t" << difference.mean * scale << "\t±" << difference.halfWidth * scale << "\t"
+              << verdict << "\n";
+  }
+
+  return nRegressions > 0 ? 1 : 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::BenchmarkCompare benchmark;
+  return benchmark.run(argc, argv);
+}
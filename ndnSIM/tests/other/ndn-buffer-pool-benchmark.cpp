@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-buffer-pool-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/encoding/buffer-pool.hpp>
+
+#include <sys/time.h>
+#include <cstdlib>
+#include <new>
+
+static uint64_t g_allocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_allocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+
+/**
+ * Measures the heap allocations of the per-packet Buffers on the path of an Interest and its
+ * Data: the Interest is decoded from a copy of its wire, as PacketHeader::Deserialize does,
+ * then a Data with fresh content is created, encoded and decoded from a copy of its wire.
+ * Mallocs/Pkt counts every call to operator new; the BufferPool columns are the Buffer
+ * allocations and the part of them that reached operator new.  Without the buffer pool
+ * (--without-buffer-pool) the BufferPool columns are zero.
+ *
+ *     ./waf --run "ndn-buffer-pool-benchmark --rounds=200000 --payload=1024"
+ */
+class BufferPoolBenchmark {
+public:
+  BufferPoolBenchmark()
+    : m_rounds(200000)
+    , m_payload(1024)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_rounds;
+  uint32_t m_payload;
+};
+
+double
+BufferPoolBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+BufferPoolBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("rounds", "Number of Interest/Data exchanges", m_rounds);
+  cmd.AddValue("payload", "Payload size of the Data", m_payload);
+  cmd.Parse(argc, argv);
+
+  ndn::Name name("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+  name.appendSequenceNumber(12345);
+
+  ndn::Interest interest(name);
+  interest.setNonce(0xdeadbeef);
+  interest.setInterestLifetime(ndn::time::milliseconds(2000));
+  const ::ndn::Block& interestWire = interest.wireEncode();
+
+  ndn::Signature signature(ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                           ::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+
+  const ::ndn::BufferPoolStats& stats = ::ndn::BufferPool::getStats();
+  uint64_t allocations = g_allocations;
+  uint64_t poolAllocations = stats.nAllocations;
+  uint64_t poolHeapAllocations = stats.nHeapAllocations;
+  size_t wireSize = 0;
+
+  double begin = now();
+  for (uint32_t round = 0; round < m_rounds; ++round) {
+    ndn::Interest received(::ndn::Block(interestWire.wire(), interestWire.size()));
+
+    ndn::Data data(received.getName());
+    data.setFreshnessPeriod(ndn::time::milliseconds(1000));
+    data.setContent(::ndn::makeBuffer(m_payload));
+    data.setSignature(signature);
+    const ::ndn::Block& dataWire = data.wireEncode();
+    wireSize = dataWire.size();
+
+    ndn::Data delivered(::ndn::Block(dataWire.wire(), dataWire.size()));
+    NS_ASSERT(delivered.getName().size() == name.size());
+  }
+  double elapsed = now() - begin;
+
+  std::cout << "Size"
+            << "\t"
+            << "ns/Pkt"
+            << "\t"
+            << "Mallocs/Pkt"
+            << "\t"
+            << "BufferPool/Pkt"
+            << "\t"
+            << "BufferPoolHeap/Pkt"
+            << "\n";
+
+  std::cout << wireSize << "\t" << elapsed * 1e9 / m_rounds << "\t"
+            << static_cast<double>(g_allocations - allocations) / m_rounds << "\t"
+            << static_cast<double>(stats.nAllocations - poolAllocations) / m_rounds << "\t"
+            << static_cast<double>(stats.nHeapAllocations - poolHeapAllocations) / m_rounds
+            << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::BufferPoolBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,401 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-forwarder-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-time.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/access-strategy.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/best-route-strategy2.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/multicast-strategy.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/ncc-strategy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include <sys/time.h>
+
+// every allocation of the program is counted, the benchmark takes the difference around the
+// forwarding calls
+static uint64_t g_nAllocations = 0;
+
+void*
+operator new(std::size_t size)
+{
+  ++g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace ns3 {
+
+/**
+ * Pushes a synthetic Interest/Data stream through nfd::Forwarder with in-memory faces, without
+ * nodes, net devices or channels.  Interests arrive on a downstream face, every upstream face
+ * that forwards an Interest gets it satisfied immediately by the first one.  Forwarding steps
+ * are ns-3 events --interval apart, so PIT and strategy timers run as in a simulation.
+ *
+ * Reports packets per second of forwarding processing time, heap allocations per packet and
+ * median and 99th percentile processing time of Interests and Data.
+ *
+ *     ./waf --run "ndn-forwarder-benchmark --strategy=best-route2 --names=zipf --cs-size=1000"
+ */
+class ForwarderBenchmark {
+public:
+  ForwarderBenchmark()
+    : m_rounds(100000)
+    , m_strategy("best-route2")
+    , m_names("zipf")
+    , m_catalog(10000)
+    , m_zipfS(0.7)
+    , m_depth(6)
+    , m_csSize(1000)
+    , m_nUpstreams(2)
+    , m_interval(MicroSeconds(10))
+    , m_payload(1024)
+    , m_round(0)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  class BenchmarkFace : public nfd::Face {
+  public:
+    BenchmarkFace()
+      : nfd::Face(::ndn::util::FaceUri("dummy://"), ::ndn::util::FaceUri("dummy://"))
+      , hasPendingInterest(false)
+      , nSentData(0)
+    {
+    }
+
+    virtual void
+    sendInterest(const ndn::Interest& interest)
+    {
+      hasPendingInterest = true;
+    }
+
+    virtual void
+    sendData(const ndn::Data& data)
+    {
+      ++nSentData;
+    }
+
+    virtual void
+    close()
+    {
+      this->fail("close");
+    }
+
+  public:
+    bool hasPendingInterest;
+    uint64_t nSentData;
+  };
+
+  struct Samples {
+    std::vector<double> times; // seconds
+    uint64_t nAllocations = 0;
+  };
+
+  ndn::Name
+  makeName(size_t i) const;
+
+  std::shared_ptr<ndn::Data>
+  makeData(const ndn::Name& name) const;
+
+  void
+  installStrategy();
+
+  void
+  Step();
+
+  template<class F>
+  static void
+  measure(Samples& samples, const F& f);
+
+  static void
+  report(const std::string& type, Samples& samples);
+
+  static double
+  now();
+
+private:
+  uint32_t m_rounds;
+  std::string m_strategy;
+  std::string m_names;
+  uint32_t m_catalog;
+  double m_zipfS;
+  uint32_t m_depth;
+  uint32_t m_csSize;
+  uint32_t m_nUpstreams;
+  Time m_interval;
+  uint32_t m_payload;
+
+  std::unique_ptr<nfd::Forwarder> m_forwarder;
+  std::shared_ptr<BenchmarkFace> m_downstream;
+  std::vector<std::shared_ptr<BenchmarkFace>> m_upstreams;
+  std::vector<ndn::Name> m_catalogNames;
+  std::vector<std::shared_ptr<ndn::Data>> m_catalogData;
+  std::mt19937 m_rng;
+  std::discrete_distribution<size_t> m_zipf;
+
+  uint32_t m_round;
+  Samples m_interestSamples;
+  Samples m_dataSamples;
+};
+
+double
+ForwarderBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+ndn::Name
+ForwarderBenchmark::makeName(size_t i) const
+{
+  // /S/<region>.../A/<application>.../<seq>, regions fan out by 8 per level
+  size_t nSpatial = (m_depth - 2) / 2;
+  size_t nApplication = m_depth - 3 - nSpatial;
+
+  ndn::Name name("/S");
+  for (size_t level = 0, group = i; level < nSpatial; ++level, group /= 8) {
+    name.append("region" + std::to_string(group % 8));
+  }
+  name.append("A");
+  for (size_t level = 0; level < nApplication; ++level) {
+    name.append("app" + std::to_string((i >> level) % 4));
+  }
+  name.appendSequenceNumber(i);
+  return name;
+}
+
+std::shared_ptr<ndn::Data>
+ForwarderBenchmark::makeData(const ndn::Name& name) const
+{
+  auto data = std::make_shared<ndn::Data>(name);
+  data->setFreshnessPeriod(::ndn::time::seconds(1));
+  data->setContent(std::make_shared< ::ndn::Buffer>(m_payload));
+  ndn::Signature signature(ndn::SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                           ::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data->setSignature(signature);
+  data->wireEncode();
+  return data;
+}
+
+void
+ForwarderBenchmark::installStrategy()
+{
+  std::shared_ptr<nfd::fw::Strategy> strategy;
+  if (m_strategy == "multicast") {
+    strategy = std::make_shared<nfd::fw::MulticastStrategy>(std::ref(*m_forwarder));
+  }
+  else if (m_strategy == "best-route2") {
+    strategy = std::make_shared<nfd::fw::BestRouteStrategy2>(std::ref(*m_forwarder));
+  }
+  else if (m_strategy == "ncc") {
+    strategy = std::make_shared<nfd::fw::NccStrategy>(std::ref(*m_forwarder));
+  }
+  else if (m_strategy == "access") {
+    strategy = std::make_shared<nfd::fw::AccessStrategy>(std::ref(*m_forwarder));
+  }
+  else {
+    NS_FATAL_ERROR("Unknown strategy " << m_strategy);
+  }
+
+  nfd::StrategyChoice& strategyChoice = m_forwarder->getStrategyChoice();
+  strategyChoice.install(strategy);
+  strategyChoice.insert("/", strategy->getName());
+}
+
+template<class F>
+void
+ForwarderBenchmark::measure(Samples& samples, const F& f)
+{
+  uint64_t nAllocations = g_nAllocations;
+  double begin = now();
+  f();
+  double elapsed = now() - begin;
+  samples.nAllocations += g_nAllocations - nAllocations;
+  samples.times.push_back(elapsed);
+}
+
+void
+ForwarderBenchmark::Step()
+{
+  // the Interest and the Data are prepared outside of the measured calls
+  bool isSequential = m_names == "sequential";
+  size_t i = isSequential ? m_round : m_zipf(m_rng);
+  auto interest = std::make_shared<ndn::Interest>(isSequential ? makeName(i) : m_catalogNames[i]);
+  interest->setNonce(m_round);
+  interest->setInterestLifetime(::ndn::time::seconds(1));
+  interest->wireEncode();
+  std::shared_ptr<ndn::Data> data = isSequential ? makeData(interest->getName()) : m_catalogData[i];
+
+  measure(m_interestSamples, [&] { m_forwarder->onInterest(*m_downstream, *interest); });
+
+  // the first upstream that got the Interest answers, the others stay pending until timeout
+  auto upstream = std::find_if(m_upstreams.begin(), m_upstreams.end(),
+                               [] (const std::shared_ptr<BenchmarkFace>& face) {
+                                 return face->hasPendingInterest;
+                               });
+  if (upstream != m_upstreams.end()) {
+    measure(m_dataSamples, [&] { m_forwarder->onData(**upstream, *data); });
+  }
+  for (const std::shared_ptr<BenchmarkFace>& face : m_upstreams) {
+    face->hasPendingInterest = false;
+  }
+
+  if (++m_round < m_rounds) {
+    Simulator::Schedule(m_interval, &ForwarderBenchmark::Step, this);
+  }
+}
+
+void
+ForwarderBenchmark::report(const std::string& type, Samples& samples)
+{
+  std::vector<double>& times = samples.times;
+  if (times.empty()) {
+    std::cout << type << "\t0\t-\t-\t-\t-\n";
+    return;
+  }
+
+  double total = 0;
+  for (double t : times) {
+    total += t;
+  }
+  std::sort(times.begin(), times.end());
+  double p50 = times[times.size() / 2];
+  double p99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+
+  std::cout << type << "\t" << times.size() << "\t" << times.size() / total << "\t"
+            << static_cast<double>(samples.nAllocations) / times.size() << "\t"
+            << p50 * 1e6 << "\t" << p99 * 1e6 << "\n";
+}
+
+int
+ForwarderBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("rounds", "Number of Interests to send", m_rounds);
+  cmd.AddValue("strategy", "Forwarding strategy: multicast, best-route2, ncc or access",
+               m_strategy);
+  cmd.AddValue("names", "Name distribution: zipf (over the catalog) or sequential (all unique)",
+               m_names);
+  cmd.AddValue("catalog", "Number of distinct names requested with zipf", m_catalog);
+  cmd.AddValue("zipf-s", "Exponent of the zipf distribution", m_zipfS);
+  cmd.AddValue("depth", "Number of name components, at least 4", m_depth);
+  cmd.AddValue("cs-size", "Maximum number of packets in the content store", m_csSize);
+  cmd.AddValue("upstreams", "Number of upstream faces in the FIB entry", m_nUpstreams);
+  cmd.AddValue("interval", "Simulated time between two Interests", m_interval);
+  cmd.AddValue("payload", "Payload size of the Data", m_payload);
+  cmd.Parse(argc, argv);
+
+  if (m_depth < 4) {
+    NS_FATAL_ERROR("Names need at least 4 components");
+  }
+  if (m_names != "zipf" && m_names != "sequential") {
+    NS_FATAL_ERROR("Unknown name distribution " << m_names);
+  }
+
+  // PIT and strategy timers run on simulated time, as in the ndnSIM stack
+  ::ndn::time::setCustomClocks(std::make_shared<ndn::time::CustomSteadyClock>(),
+                               std::make_shared<ndn::time::CustomSystemClock>());
+
+  m_forwarder.reset(new nfd::Forwarder());
+  m_forwarder->getCs().setLimit(m_csSize);
+  installStrategy();
+
+  m_downstream = std::make_shared<BenchmarkFace>();
+  m_forwarder->addFace(m_downstream);
+  std::shared_ptr<nfd::fib::Entry> fibEntry = m_forwarder->getFib().insert("/S").first;
+  for (uint32_t i = 0; i < m_nUpstreams; ++i) {
+    m_upstreams.push_back(std::make_shared<BenchmarkFace>());
+    m_forwarder->addFace(m_upstreams.back());
+    fibEntry->addNextHop(m_upstreams.back(), i);
+  }
+
+  if (m_names == "zipf") {
+    std::vector<double> popularity(m_catalog);
+    for (uint32_t i = 0; i < m_catalog; ++i) {
+      m_catalogNames.push_back(makeName(i));
+      m_catalogData.push_back(makeData(m_catalogNames.back()));
+      popularity[i] = 1.0 / std::pow(i + 1, m_zipfS);
+    }
+    m_zipf = std::discrete_distribution<size_t>(popularity.begin(), popularity.end());
+  }
+
+  m_interestSamples.times.reserve(m_rounds);
+  m_dataSamples.times.reserve(m_rounds);
+
+  Simulator::Schedule(Seconds(0), &ForwarderBenchmark::Step, this);
+  double begin = now();
+  Simulator::Run();
+  double elapsed = now() - begin;
+
+  std::cout << "# strategy=" << m_strategy << " names=" << m_names << " cs-size=" << m_csSize
+            << " upstreams=" << m_nUpstreams << " rounds=" << m_rounds
+            << " satisfied=" << m_downstream->nSentData << " run=" << elapsed << "s\n";
+  std::cout << "Type"
+            << "\t"
+            << "Packets"
+            << "\t"
+            << "Packets/s"
+            << "\t"
+            << "Allocs/Packet"
+            << "\t"
+            << "p50(us)"
+            << "\t"
+            << "p99(us)"
+            << "\n";
+  report("Interest", m_interestSamples);
+  report("Data", m_dataSamples);
+
+  m_upstreams.clear();
+  m_downstream.reset();
+  m_forwarder.reset();
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::ForwarderBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-name-compare-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <sys/time.h>
+#include <set>
+
+namespace ns3 {
+
+/**
+ * Measures Name comparison in an ordered container, as the Content Store does it.  Names are
+ * decoded from their wire encoding, as those of received packets are, and share a long common
+ * prefix.  The columns are insertions, exact lookups and isPrefixOf checks per second.
+ *
+ *     ./waf --run "ndn-name-compare-benchmark --names=100000 --rounds=10"
+ */
+class NameCompareBenchmark {
+public:
+  NameCompareBenchmark()
+    : m_nNames(100000)
+    , m_rounds(10)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  static double
+  now();
+
+private:
+  uint32_t m_nNames;
+  uint32_t m_rounds;
+};
+
+double
+NameCompareBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+int
+NameCompareBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("names", "Number of distinct names", m_nNames);
+  cmd.AddValue("rounds", "Number of times each operation is repeated", m_rounds);
+  cmd.Parse(argc, argv);
+
+  ndn::Name prefix("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+  std::vector<ndn::Name> names;
+  for (uint32_t i = 0; i < m_nNames; ++i) {
+    ndn::Name name(prefix);
+    name.appendSequenceNumber(i % 1000).appendSegment(i / 1000);
+    names.push_back(ndn::Name(name.wireEncode()));
+  }
+  ndn::Name decodedPrefix(prefix.wireEncode());
+
+  std::cout << "Names"
+            << "\t"
+            << "ops/s/Insert"
+            << "\t"
+            << "ops/s/Find"
+            << "\t"
+            << "ops/s/IsPrefixOf"
+            << "\n";
+
+  double insert = 0;
+  double find = 0;
+  double isPrefixOf = 0;
+  size_t nFound = 0;
+  for (uint32_t round = 0; round < m_rounds; ++round) {
+    std::set<ndn::Name> table;
+    double begin = now();
+    for (const ndn::Name& name : names) {
+      table.insert(name);
+    }
+    insert += now() - begin;
+
+    begin = now();
+    for (const ndn::Name& name : names) {
+      nFound += table.count(name);
+    }
+    find += now() - begin;
+
+    begin = now();
+    for (const ndn::Name& name : names) {
+      nFound += decodedPrefix.isPrefixOf(name);
+    }
+    isPrefixOf += now() - begin;
+  }
+  NS_ASSERT(nFound > 0);
+
+  double nOps = static_cast<double>(m_rounds) * m_nNames;
+  std::cout << m_nNames << "\t" << nOps / insert << "\t" << nOps / find << "\t"
+            << nOps / isPrefixOf << "\n";
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::NameCompareBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
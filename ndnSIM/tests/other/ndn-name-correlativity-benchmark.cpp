@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-name-correlativity-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/correlativity-batch.hpp>
+
+#include <sys/time.h>
+#include <cmath>
+
+namespace ns3 {
+
+/**
+ * Compares ndn::Name::correlativityWith against the previous implementation, which
+ * allocated three position arrays per call and evaluated pow(2, -x) in the loops, and the
+ * spatial and application correlativity of ndn::StructuredNameView, pair by pair, against
+ * ndn::CorrelativityBatch scoring a name against all samples at once.
+ *
+ *     ./waf --run "ndn-name-correlativity-benchmark --rounds=1000000"
+ */
+class NameCorrelativityBenchmark {
+public:
+  NameCorrelativityBenchmark()
+    : m_rounds(1000000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  /**
+   * \brief Previous implementation of Name::correlativityWith, kept for comparison
+   *
+   * Position arrays are sized for all component pairs, the original size (n + m) could
+   * overflow when components repeat.
+   */
+  static double
+  legacyCorrelativity(const ndn::Name& a, const ndn::Name& b);
+
+  template<class F>
+  double
+  measure(const std::vector<std::pair<ndn::Name, ndn::Name>>& pairs, const F& f, double& checksum);
+
+  /**
+   * \brief Compare pairwise and batch scoring of structured names
+   */
+  void
+  runSegments(const std::vector<ndn::Name>& names);
+
+  static double
+  now();
+
+private:
+  uint32_t m_rounds;
+};
+
+double
+NameCorrelativityBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+double
+NameCorrelativityBenchmark::legacyCorrelativity(const ndn::Name& a, const ndn::Name& b)
+{
+  uint32_t maxLength = a.size() * b.size() + 1;
+  uint16_t* posA = new uint16_t[maxLength];
+  uint16_t* posB = new uint16_t[maxLength];
+  uint16_t* posC = new uint16_t[maxLength];
+  memset(posA, 0, maxLength * sizeof(uint16_t));
+  memset(posB, 0, maxLength * sizeof(uint16_t));
+  memset(posC, 0, maxLength * sizeof(uint16_t));
+
+  size_t k = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    for (size_t j = 0; j < b.size(); j++) {
+      if (a.at(i) == b.at(j)) {
+        posA[k] = i + 1;
+        posB[k] = j + 1;
+        k++;
+      }
+    }
+  }
+
+  double lcs = 0.0;
+  double full = 0.0;
+  double co = 0.0;
+  if (posA[0] > 0 && posB[0] > 0) {
+    uint16_t bigger;
+    posC[0] = (posA[0] >= posB[0]) ? posA[0] : posB[0];
+    for (size_t h = 0; h < k - 1; h++) {
+      bigger = (posA[h + 1] - posA[h]) >= (posB[h + 1] - posB[h]) ? posA[h + 1] - posA[h]
+                                                                  : posB[h + 1] - posB[h];
+      posC[h + 1] = posC[h] + bigger;
+    }
+    bigger = (a.size() - posA[k - 1]) >= (b.size() - posB[k - 1]) ? (a.size() - posA[k - 1])
+                                                                  : (b.size() - posB[k - 1]);
+    uint16_t cmnLen = posC[k - 1] + bigger;
+    for (size_t h = 0; h < k; h++) {
+      lcs += pow(2, (-posC[h]));
+    }
+    for (uint16_t x = 1; x <= cmnLen; x++) {
+      full += pow(2, (-x));
+    }
+    co = lcs / full;
+  }
+
+  delete[] posA;
+  delete[] posB;
+  delete[] posC;
+  return co;
+}
+
+template<class F>
+double
+NameCorrelativityBenchmark::measure(const std::vector<std::pair<ndn::Name, ndn::Name>>& pairs,
+                                    const F& f, double& checksum)
+{
+  checksum = 0.0;
+  double begin = now();
+  for (uint32_t round = 0; round < m_rounds; ++round) {
+    const std::pair<ndn::Name, ndn::Name>& p = pairs[round % pairs.size()];
+    checksum += f(p.first, p.second);
+  }
+  return (now() - begin) * 1e9 / m_rounds;
+}
+
+int
+NameCorrelativityBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("rounds", "Number of correlativity evaluations", m_rounds);
+  cmd.Parse(argc, argv);
+
+  std::vector<ndn::Name> names = {
+    "/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion",
+    "/S/NankaiDistrict/NanjingRoad/BinjiangStreet/A/TrafficInformer/RoadStatus",
+    "/S/NankaiDistrict/WeijingRoad/BinjiangStreet/A/TrafficInformer/RoadCongestion/Level",
+    "/S/HepingDistrict/A/Weather/Forecast",
+    "/S/HepingDistrict/NanjingRoad/A/Weather/Forecast/Hourly",
+  };
+
+  std::vector<std::pair<ndn::Name, ndn::Name>> pairs;
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (size_t j = 0; j < names.size(); ++j) {
+      pairs.push_back(std::make_pair(ndn::Name(names[i]).appendSequenceNumber(i),
+                                     ndn::Name(names[j]).appendSequenceNumber(names.size() + j)));
+    }
+  }
+
+  double maxDifference = 0.0;
+  for (const auto& p : pairs) {
+    maxDifference = std::max(maxDifference, std::abs(p.first.correlativityWith(p.second)
+                                                     - legacyCorrelativity(p.first, p.second)));
+  }
+
+  double legacyChecksum = 0.0, currentChecksum = 0.0;
+  double legacyCost = measure(pairs, &NameCorrelativityBenchmark::legacyCorrelativity,
+                              legacyChecksum);
+  double currentCost = measure(pairs, [] (const ndn::Name& a, const ndn::Name& b) {
+      return a.correlativityWith(b);
+    }, currentChecksum);
+
+  std::cout << "Implementation\tns/call\tchecksum\n"
+            << "legacy\t" << legacyCost << "\t" << legacyChecksum << "\n"
+            << "current\t" << currentCost << "\t" << currentChecksum << "\n"
+            << "max |difference| = " << maxDifference << "\n";
+
+  runSegments(names);
+  return 0;
+}
+
+void
+NameCorrelativityBenchmark::runSegments(const std::vector<ndn::Name>& names)
+{
+  // a correlativity RTO estimate scores a name against hundreds of sample names
+  const size_t nSamples = 256;
+  std::vector<ndn::Name> samples;
+  for (size_t i = 0; i < nSamples; ++i) {
+    samples.push_back(ndn::Name(names[i % names.size()]).appendSequenceNumber(i));
+  }
+  std::vector<::ndn::StructuredNameView> views(samples.begin(), samples.end());
+
+  ::ndn::name::Dictionary dictionary;
+  std::vector<::ndn::InternedStructuredName> interned;
+  for (const ::ndn::StructuredNameView& view : views) {
+    interned.emplace_back(view, dictionary, true);
+  }
+
+  std::vector<ndn::Name> queries;
+  for (size_t i = 0; i < names.size(); ++i) {
+    queries.push_back(ndn::Name(names[i]).appendSequenceNumber(nSamples + i));
+  }
+
+  uint32_t nQueries = std::max<uint32_t>(1, m_rounds / nSamples);
+  double pairwiseChecksum = 0.0;
+  double begin = now();
+  for (uint32_t round = 0; round < nQueries; ++round) {
+    ::ndn::StructuredNameView query(queries[round % queries.size()]);
+    for (const ::ndn::StructuredNameView& view : views) {
+      pairwiseChecksum += query.spatialCorrelativityWith(view) +
+                          query.applicationCorrelativityWith(view);
+    }
+  }
+  double pairwiseCost = (now() - begin) * 1e9 / (nQueries * nSamples);
+
+  // the samples are added for every query, as the correlativity engine does for its candidates
+  ::ndn::CorrelativityBatch batch;
+  std::vector<double> spatial;
+  std::vector<double> application;
+  double batchChecksum = 0.0;
+  begin = now();
+  for (uint32_t round = 0; round < nQueries; ++round) {
+    ::ndn::StructuredNameView query(queries[round % queries.size()]);
+    batch.clear();
+    for (const ::ndn::InternedStructuredName& sample : interned) {
+      batch.add(sample);
+    }
+    batch.score(::ndn::InternedStructuredName::lookup(query, dictionary), spatial, application);
+    for (size_t k = 0; k < nSamples; ++k) {
+      batchChecksum += spatial[k] + application[k];
+    }
+  }
+  double batchCost = (now() - begin) * 1e9 / (nQueries * nSamples);
+
+  std::cout << "\nSegments\tns/sample\tchecksum\n"
+            << "pairwise\t" << pairwiseCost << "\t" << pairwiseChecksum << "\n"
+            << "batch\t" << batchCost << "\t" << batchChecksum << "\n";
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::NameCorrelativityBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,362 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-rto-replay.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace ns3 {
+
+/**
+ * Replays the Interest and Data events recorded by ndn::AppPacketTracer against RTT
+ * estimators and RTO policies, and reports how well the RTO of first transmissions would have
+ * fitted the recorded RTTs:
+ *
+ *  - Clean: Interests satisfied without retransmission, the ones with a known RTT
+ *  - Spurious: ratio of clean Interests whose RTO is below the RTT, i.e. which would have been
+ *    retransmitted although Data was on its way
+ *  - RtoError: mean RTO - RTT (ms) of clean Interests
+ *  - RelError: mean |RTO - RTT| / RTT of clean Interests
+ *  - LossDetect: mean RTO (ms) of lost first transmissions, i.e. delay before retransmission
+ *  - ns/Call: CPU time of one RTO calculation
+ *
+ * Every application (Node, AppId) gets its own estimator, which goes through the same calls as
+ * in ndn::Consumer.  Transmission times are those of the recording, so retransmissions happen
+ * when the recording estimator decided, not the replayed one.  Estimator attributes can be set
+ * on the command line, e.g. --ns3::ndn::RttMeanDeviation::HistoryWindow=5s.
+ *
+ *     ./waf --run "ndn-rto-replay --trace=app-packet-trace.txt
+ *                  --estimators=ns3::ndn::RttMeanDeviation --policies=Correlativity,History,Tcp"
+ */
+class RtoReplay {
+public:
+  RtoReplay()
+    : m_estimators("ns3::ndn::RttMeanDeviation")
+    , m_policies("Correlativity,History,Tcp")
+    , m_lifetime(Seconds(2))
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  enum EventType { INTEREST, DATA, DISCARD };
+
+  struct Event {
+    Time time;
+    EventType type;
+    size_t request;
+  };
+
+  // one Interest, with all its transmissions
+  struct Request {
+    size_t app;
+    ndn::Name name;
+    SequenceNumber32 seq;
+    Time firstSend;
+    Time lastSend;
+    uint32_t nTransmissions;
+    bool isSatisfied;
+    Time rcvTime;
+  };
+
+  struct Result {
+    uint64_t nClean;
+    uint64_t nSpurious;
+    double rtoError;
+    double relError;
+    uint64_t nLost;
+    double lossDetect;
+    uint64_t nCalls;
+    double cpuTime;
+  };
+
+  bool
+  load(const std::string& file);
+
+  Result
+  replay(const std::string& estimator, const std::string& policy);
+
+  void
+  process(size_t eventIndex);
+
+  static std::vector<std::string>
+  split(const std::string& list);
+
+private:
+  std::string m_trace;
+  std::string m_estimators;
+  std::string m_policies;
+  Time m_lifetime;
+
+  std::vector<Event> m_events;
+  std::vector<Request> m_requests;
+  size_t m_nApps;
+
+  // replay state
+  std::string m_policy;
+  std::vector<Ptr<ndn::RttEstimator>> m_rtt;
+  std::vector<ndn::Name> m_lastPrefix;
+  std::vector<uint32_t> m_nSent;
+  std::vector<Time> m_firstRto;
+  Result m_result;
+};
+
+std::vector<std::string>
+RtoReplay::split(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::istringstream is(list);
+  std::string item;
+  while (std::getline(is, item, ',')) {
+    if (!item.empty())
+      items.push_back(item);
+  }
+  return items;
+}
+
+bool
+RtoReplay::load(const std::string& file)
+{
+  std::ifstream is(file.c_str());
+  if (!is.is_open()) {
+    std::cerr << "Cannot open " << file << std::endl;
+    return false;
+  }
+
+  std::map<std::pair<std::string, std::string>, size_t> apps;
+  std::map<std::pair<size_t, ndn::Name>, size_t> outstanding;
+
+  std::string line;
+  std::getline(is, line); // header
+  while (std::getline(is, line)) {
+    std::istringstream fields(line);
+    double time;
+    std::string node, appId, type, uri;
+    if (!(fields >> time >> node >> appId >> type >> uri))
+      continue;
+
+    size_t app = apps.insert(std::make_pair(std::make_pair(node, appId), apps.size())).first->second;
+    ndn::Name name(uri);
+    auto key = std::make_pair(app, name);
+    auto i = outstanding.find(key);
+
+    if (type == "Interest") {
+      if (i == outstanding.end()) {
+        Request request;
+        request.app = app;
+        request.name = name;
+        request.seq = SequenceNumber32(name.at(-1).isSequenceNumber()
+                                         ? name.at(-1).toSequenceNumber()
+                                         : m_requests.size());
+        request.firstSend = Seconds(time);
+        request.nTransmissions = 0;
+        request.isSatisfied = false;
+        i = outstanding.insert(std::make_pair(key, m_requests.size())).first;
+        m_requests.push_back(request);
+      }
+      Request& request = m_requests[i->second];
+      request.lastSend = Seconds(time);
+      ++request.nTransmissions;
+      m_events.push_back(Event{Seconds(time), INTEREST, i->second});
+    }
+    else if (type == "Data" && i != outstanding.end()) {
+      Request& request = m_requests[i->second];
+      request.isSatisfied = true;
+      request.rcvTime = Seconds(time);
+      m_events.push_back(Event{Seconds(time), DATA, i->second});
+      outstanding.erase(i);
+    }
+  }
+
+  // the consumer discards unsatisfied Interests when their lifetime is over
+  for (size_t r = 0; r < m_requests.size(); ++r) {
+    if (!m_requests[r].isSatisfied)
+      m_events.push_back(Event{m_requests[r].lastSend + m_lifetime, DISCARD, r});
+  }
+
+  m_nApps = apps.size();
+  return true;
+}
+
+void
+RtoReplay::process(size_t eventIndex)
+{
+  const Event& event = m_events[eventIndex];
+  const Request& request = m_requests[event.request];
+  Ptr<ndn::RttEstimator> rtt = m_rtt[request.app];
+
+  switch (event.type) {
+  case INTEREST: {
+    if (++m_nSent[event.request] > 1) {
+      // same as Consumer::OnTimeout
+      rtt->IncreaseMultiplier();
+      rtt->SetRetransmitbySeq(request.seq);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    // same as Consumer::WaitBeforeSendOutInterest
+    Time rto = rtt->GetRetransRtobySeq(request.seq);
+    if (rto.IsZero()) {
+      ndn::Name prefix = request.name.getPrefix(-1);
+      if (m_policy == "Correlativity")
+        rto = prefix == m_lastPrefix[request.app] ? rtt->RetransmitTimeout()
+                                                  : rtt->CalRTObyCorrelativity(request.name);
+      else if (m_policy == "History")
+        rto = rtt->CalRTObyHistory();
+      else
+        rto = rtt->RetransmitTimeout();
+      m_lastPrefix[request.app] = prefix;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    m_result.cpuTime += std::chrono::duration<double, std::nano>(end - begin).count();
+    ++m_result.nCalls;
+
+    rtt->SetInterestInfo(request.name, request.seq, 1, rto);
+    if (m_nSent[event.request] == 1)
+      m_firstRto[event.request] = rto;
+    break;
+  }
+  case DATA:
+    rtt->AckSeq(request.name, request.seq);
+    break;
+  case DISCARD:
+    rtt->DiscardInterestBySeq(request.seq);
+    break;
+  }
+}
+
+RtoReplay::Result
+RtoReplay::replay(const std::string& estimator, const std::string& policy)
+{
+  ObjectFactory factory;
+  factory.SetTypeId(estimator);
+
+  m_rtt.clear();
+  for (size_t app = 0; app < m_nApps; ++app) {
+    m_rtt.push_back(factory.Create<ndn::RttEstimator>());
+  }
+  m_lastPrefix.assign(m_nApps, ndn::Name());
+  m_nSent.assign(m_requests.size(), 0);
+  m_firstRto.assign(m_requests.size(), Time());
+  m_policy = policy;
+  m_result = Result();
+
+  for (size_t e = 0; e < m_events.size(); ++e) {
+    Simulator::Schedule(m_events[e].time, &RtoReplay::process, this, e);
+  }
+  Simulator::Run();
+  Simulator::Destroy();
+
+  Result result = m_result;
+  for (size_t r = 0; r < m_requests.size(); ++r) {
+    const Request& request = m_requests[r];
+    double rto = m_firstRto[r].ToDouble(Time::S);
+
+    if (request.isSatisfied && request.nTransmissions == 1) {
+      double rtt = (request.rcvTime - request.firstSend).ToDouble(Time::S);
+      ++result.nClean;
+      if (rto < rtt)
+        ++result.nSpurious;
+      result.rtoError += rto - rtt;
+      if (rtt > 0)
+        result.relError += std::abs(rto - rtt) / rtt;
+    }
+    else {
+      ++result.nLost;
+      result.lossDetect += rto;
+    }
+  }
+  m_rtt.clear();
+  return result;
+}
+
+int
+RtoReplay::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("trace", "Trace file written by ndn::AppPacketTracer", m_trace);
+  cmd.AddValue("estimators", "Comma-separated TypeIds of the RTT estimators to replay",
+               m_estimators);
+  cmd.AddValue("policies", "Comma-separated RTO policies: Correlativity, History, Tcp",
+               m_policies);
+  cmd.AddValue("lifetime", "Interest lifetime, after which unsatisfied Interests are discarded",
+               m_lifetime);
+  cmd.Parse(argc, argv);
+
+  if (m_trace.empty()) {
+    std::cerr << "--trace is required" << std::endl;
+    return 1;
+  }
+  if (!load(m_trace))
+    return 1;
+
+  std::cout << "Estimator"
+            << "\t"
+            << "Policy"
+            << "\t"
+            << "Interests"
+            << "\t"
+            << "Clean"
+            << "\t"
+            << "Spurious"
+            << "\t"
+            << "RtoError"
+            << "\t"
+            << "RelError"
+            << "\t"
+            << "LossDetect"
+            << "\t"
+            << "ns/Call"
+            << "\n";
+
+  for (const std::string& estimator : split(m_estimators)) {
+    for (const std::string& policy : split(m_policies)) {
+      Result result = replay(estimator, policy);
+      double nClean = std::max<uint64_t>(result.nClean, 1);
+
+      std::cout << estimator << "\t" << policy << "\t" << m_requests.size() << "\t"
+                << result.nClean << "\t" << result.nSpurious / nClean << "\t"
+                << result.rtoError * 1000 / nClean << "\t" << result.relError / nClean << "\t"
+                << result.lossDetect * 1000 / std::max<uint64_t>(result.nLost, 1) << "\t"
+                << result.cpuTime / std::max<uint64_t>(result.nCalls, 1) << "\n";
+    }
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RtoReplay replay;
+  return replay.run(argc, argv);
+}
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-rtt-history-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/utils/ndn-rtt-mean-deviation.hpp"
+
+#include <sys/time.h>
+
+namespace ns3 {
+
+/**
+ * Measures the per-Interest cost of the RttEstimator history operations used by
+ * ndn::Consumer (SetInterestInfo, GetRtobySeq, GetRetransRtobySeq, GetNamebySeq,
+ * SetRetransmitbySeq, AckSeq and DiscardInterestBySeq) for growing history sizes.
+ *
+ * With the sequence-number index the cost per Interest should stay flat.
+ *
+ *     ./waf --run "ndn-rtt-history-benchmark --max-history=64000 --rounds=100000"
+ */
+class RttHistoryBenchmark {
+public:
+  RttHistoryBenchmark()
+    : m_maxHistory(64000)
+    , m_rounds(100000)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  double
+  measure(size_t historySize);
+
+  static double
+  now();
+
+private:
+  uint32_t m_maxHistory;
+  uint32_t m_rounds;
+};
+
+double
+RttHistoryBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+double
+RttHistoryBenchmark::measure(size_t historySize)
+{
+  Ptr<ndn::RttMeanDeviation> rtt = CreateObject<ndn::RttMeanDeviation>();
+  ndn::Name prefix("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion");
+
+  std::vector<ndn::Name> names;
+  names.reserve(historySize + m_rounds);
+  for (uint32_t seq = 0; seq < historySize + m_rounds; ++seq) {
+    names.push_back(ndn::Name(prefix).appendSequenceNumber(seq));
+  }
+
+  for (uint32_t seq = 0; seq < historySize; ++seq) {
+    rtt->SetInterestInfo(names[seq], SequenceNumber32(seq), 1, MilliSeconds(200));
+  }
+
+  double begin = now();
+  for (uint32_t round = 0; round < m_rounds; ++round) {
+    // oldest outstanding Interest is retransmitted, newest one is sent and acknowledged
+    SequenceNumber32 oldest(round);
+    SequenceNumber32 newest(historySize + round);
+
+    rtt->SetInterestInfo(names[newest.GetValue()], newest, 1, MilliSeconds(200));
+    rtt->GetRtobySeq(newest);
+    rtt->GetNamebySeq(oldest);
+    rtt->SetRetransmitbySeq(oldest);
+    rtt->GetRetransRtobySeq(oldest);
+    rtt->AckSeq(names[newest.GetValue()], newest);
+    rtt->DiscardInterestBySeq(oldest);
+  }
+  double elapsed = now() - begin;
+
+  return elapsed * 1e9 / m_rounds;
+}
+
+int
+RttHistoryBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("max-history", "Largest history size to evaluate", m_maxHistory);
+  cmd.AddValue("rounds", "Number of Interests to process for each history size", m_rounds);
+  cmd.Parse(argc, argv);
+
+  std::cout << "HistorySize"
+            << "\t"
+            << "ns/Interest"
+            << "\n";
+
+  for (size_t historySize = 1000; historySize <= m_maxHistory; historySize *= 2) {
+    std::cout << historySize << "\t" << measure(historySize) << "\n";
+  }
+
+  Simulator::Destroy();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::RttHistoryBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -0,0 +1,778 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trace-analyzer.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-async-trace-writer.hpp"
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+/**
+ * Post-processes the traces of one or more replications of a scenario, in parallel.
+ *
+ * Every directory of --dirs holds the traces of one replication, e.g., written by
+ *
+ *     ndn::AppDelayTracer::InstallAll("<dir>/app-delays-trace.txt");
+ *     ndn::L3RateTracer::InstallAll("<dir>/rate-trace.txt", Seconds(1.0));
+ *     ndn::ConsumerEventTracer::InstallAll("<dir>/consumer-events.txt");
+ *
+ * Missing traces are skipped.  Text traces are memory-mapped and split into chunks at line
+ * boundaries, one per thread; binary (".bin") and compressed (".gz", ".zst") traces can only
+ * be read sequentially, and are read by a thread each.  The partial results are then merged,
+ * per replication and over all of them.
+ *
+ * Reported:
+ *  - per replication and over all of them: percentiles of the delays of the app delay trace
+ *    (FullDelay rows, i.e., from the first Interest, or LastDelay with --delay=last), number
+ *    of retransmissions (RetxCount - 1 of the FullDelay rows), and satisfaction ratio: the
+ *    share of the sequence numbers requested by consumers (consumer event trace) that were
+ *    satisfied, or, without consumer event trace, SatisfiedInterests over SatisfiedInterests
+ *    and TimedOutInterests of the rate trace
+ *  - per prefix, over all replications: Interests sent and Data received per second by the
+ *    consumers, and satisfaction ratio (consumer event trace)
+ *  - per type of the rate trace, over all replications: packets and kilobytes per second in
+ *    the network (sum of the raw columns over the traced time)
+ *
+ *     ./waf --run "ndn-trace-analyzer --dirs=results/run1,results/run2,results/run3 --threads=8"
+ */
+class TraceAnalyzer {
+public:
+  TraceAnalyzer()
+    : m_delays("app-delays-trace.txt")
+    , m_rates("rate-trace.txt")
+    , m_events("consumer-events.txt")
+    , m_delayType("full")
+    , m_nThreads(std::max(1u, std::thread::hardware_concurrency()))
+  {
+  }
+
+  void
+  run(int argc, char* argv[]);
+
+private:
+  struct Span {
+    double first = -1;
+    double last = -1;
+
+    void
+    add(double time)
+    {
+      if (first < 0 || time < first)
+        first = time;
+      if (time > last)
+        last = time;
+    }
+
+    void
+    merge(const Span& other)
+    {
+      if (other.first >= 0) {
+        add(other.first);
+        add(other.last);
+      }
+    }
+  };
+
+  struct PrefixStats {
+    uint64_t nInterests = 0;
+    uint64_t nData = 0;
+    std::unordered_set<uint64_t> requested; ///< node, app and sequence number
+    std::unordered_set<uint64_t> satisfied;
+  };
+
+  struct RateStats {
+    double packets = 0;
+    double kilobytes = 0;
+  };
+
+  /**
+   * @brief Results of a part of the traces, merged into those of a replication, and of all
+   */
+  struct Stats {
+    ndn::HdrHistogram delays; ///< microseconds
+    uint64_t nRetransmissions = 0;
+    std::map<std::string, PrefixStats> prefixes;
+    Span eventSpan;
+    std::map<std::string, RateStats> rates;
+    Span rateSpan;
+    uint64_t nBytes = 0;
+
+    void
+    merge(const Stats& other);
+  };
+
+  enum TraceKind {
+    DELAYS,
+    RATES,
+    EVENTS
+  };
+
+  struct Task {
+    TraceKind kind;
+    size_t replication;
+    std::string file;
+    const char* begin; ///< chunk of a memory-mapped text trace, nullptr for a whole file
+    const char* end;
+    std::vector<std::string> header;
+  };
+
+  /**
+   * @brief Fields of a row, text or binary
+   */
+  class Row {
+  public:
+    virtual
+    ~Row() = default;
+
+    virtual double
+    getNumber(size_t column) const = 0;
+
+    virtual void
+    getString(size_t column, std::string& value) const = 0;
+
+    /**
+     * @brief Hash of a string column, without copying it
+     */
+    virtual uint64_t
+    getHash(size_t column) const = 0;
+  };
+
+  class TextRow;
+  class BinaryRow;
+
+  /**
+   * @brief Indexes of the columns used for a kind of trace, SIZE_MAX if missing
+   */
+  struct Columns {
+    explicit
+    Columns(const std::vector<std::string>& header);
+
+    size_t
+    find(const char* name) const;
+
+    /**
+     * @brief Whether the columns used for @p kind are present
+     */
+    bool
+    isComplete(TraceKind kind) const;
+
+    std::vector<std::string> names;
+    size_t time, node, appId, seqNo, type, delayUs, retxCount, prefix, packetsRaw, kilobytesRaw;
+  };
+
+  void
+  addTasks(TraceKind kind, size_t replication, const std::string& file);
+
+  void
+  runTask(const Task& task, Stats& stats) const;
+
+  void
+  processRow(TraceKind kind, const Columns& columns, const Row& row, Stats& stats,
+             std::string& buffer) const;
+
+  void
+  print(const std::vector<Stats>& replications, const Stats& all) const;
+
+  static std::vector<std::string>
+  splitHeader(const std::string& line);
+
+  static uint64_t
+  hashBytes(const char* data, size_t size);
+
+  static double
+  now();
+
+private:
+  std::string m_dirs;
+  std::string m_delays;
+  std::string m_rates;
+  std::string m_events;
+  std::string m_delayType;
+  uint32_t m_nThreads;
+
+  std::vector<std::string> m_replications;
+  std::vector<Task> m_tasks;
+  std::vector<std::pair<void*, size_t>> m_mappings;
+};
+
+class TraceAnalyzer::TextRow : public Row {
+public:
+  static const size_t MAX_FIELDS = 16;
+
+  /**
+   * @param line without the line break; the byte after it must not be a digit
+   */
+  TextRow(const char* line, const char* end)
+    : m_nFields(0)
+  {
+    const char* field = line;
+    for (const char* p = line; p <= end && m_nFields < MAX_FIELDS; ++p) {
+      if (p == end || *p == '\t') {
+        m_fields[m_nFields++] = std::make_pair(field, p);
+        field = p + 1;
+      }
+    }
+  }
+
+  size_t
+  getNFields() const
+  {
+    return m_nFields;
+  }
+
+  double
+  getNumber(size_t column) const override
+  {
+    if (column >= m_nFields)
+      return 0;
+    // fields end with a tab or the byte after the line, so strtod stops there
+    return std::strtod(m_fields[column].first, nullptr);
+  }
+
+  void
+  getString(size_t column, std::string& value) const override
+  {
+    if (column >= m_nFields) {
+      value.clear();
+      return;
+    }
+    value.assign(m_fields[column].first, m_fields[column].second);
+  }
+
+  uint64_t
+  getHash(size_t column) const override
+  {
+    if (column >= m_nFields)
+      return 0;
+    return hashBytes(m_fields[column].first, m_fields[column].second - m_fields[column].first);
+  }
+
+private:
+  std::pair<const char*, const char*> m_fields[MAX_FIELDS];
+  size_t m_nFields;
+};
+
+class TraceAnalyzer::BinaryRow : public Row {
+public:
+  explicit
+  BinaryRow(const ndn::BinaryTraceReader& reader)
+    : m_reader(reader)
+  {
+  }
+
+  double
+  getNumber(size_t column) const override
+  {
+    return m_reader.GetNumber(column);
+  }
+
+  void
+  getString(size_t column, std::string& value) const override
+  {
+    value = m_reader.GetName(column);
+  }
+
+  uint64_t
+  getHash(size_t column) const override
+  {
+    const std::string& value = m_reader.GetName(column);
+    return hashBytes(value.data(), value.size());
+  }
+
+private:
+  const ndn::BinaryTraceReader& m_reader;
+};
+
+TraceAnalyzer::Columns::Columns(const std::vector<std::string>& header)
+  : names(header)
+{
+  time = find("Time");
+  node = find("Node");
+  appId = find("AppId");
+  seqNo = find("SeqNo");
+  type = find("Type");
+  delayUs = find("DelayUS");
+  retxCount = find("RetxCount");
+  prefix = find("Prefix");
+  packetsRaw = find("PacketRaw");
+  kilobytesRaw = find("KilobytesRaw");
+}
+
+size_t
+TraceAnalyzer::Columns::find(const char* name) const
+{
+  auto it = std::find(names.begin(), names.end(), name);
+  return it == names.end() ? SIZE_MAX : it - names.begin();
+}
+
+bool
+TraceAnalyzer::Columns::isComplete(TraceKind kind) const
+{
+  switch (kind) {
+  case DELAYS:
+    return type != SIZE_MAX && delayUs != SIZE_MAX && retxCount != SIZE_MAX;
+  case RATES:
+    return time != SIZE_MAX && type != SIZE_MAX && packetsRaw != SIZE_MAX &&
+           kilobytesRaw != SIZE_MAX;
+  case EVENTS:
+    return time != SIZE_MAX && node != SIZE_MAX && appId != SIZE_MAX && seqNo != SIZE_MAX &&
+           type != SIZE_MAX && prefix != SIZE_MAX;
+  default:
+    return false;
+  }
+}
+
+void
+TraceAnalyzer::Stats::merge(const Stats& other)
+{
+  delays.Merge(other.delays);
+  nRetransmissions += other.nRetransmissions;
+  for (const auto& prefix : other.prefixes) {
+    PrefixStats& stats = prefixes[prefix.first];
+    stats.nInterests += prefix.second.nInterests;
+    stats.nData += prefix.second.nData;
+    stats.requested.insert(prefix.second.requested.begin(), prefix.second.requested.end());
+    stats.satisfied.insert(prefix.second.satisfied.begin(), prefix.second.satisfied.end());
+  }
+  eventSpan.merge(other.eventSpan);
+  for (const auto& rate : other.rates) {
+    rates[rate.first].packets += rate.second.packets;
+    rates[rate.first].kilobytes += rate.second.kilobytes;
+  }
+  rateSpan.merge(other.rateSpan);
+  nBytes += other.nBytes;
+}
+
+double
+TraceAnalyzer::now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+uint64_t
+TraceAnalyzer::hashBytes(const char* data, size_t size)
+{
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::vector<std::string>
+TraceAnalyzer::splitHeader(const std::string& line)
+{
+  std::vector<std::string> header;
+  boost::split(header, line, boost::is_any_of("\t"));
+  for (std::string& column : header) {
+    boost::trim(column);
+  }
+  return header;
+}
+
+void
+TraceAnalyzer::addTasks(TraceKind kind, size_t replication, const std::string& file)
+{
+  if (access(file.c_str(), R_OK) != 0) {
+    return;
+  }
+
+  std::string uncompressed = ndn::AsyncTraceWriter::StripCompressionSuffix(file);
+  if (uncompressed != file || ndn::BinaryTraceWriter::IsBinaryFile(file)) {
+    m_tasks.push_back(Task{kind, replication, file, nullptr, nullptr, {}});
+    return;
+  }
+
+  int fd = open(file.c_str(), O_RDONLY);
+  struct stat status;
+  if (fd < 0 || fstat(fd, &status) != 0) {
+    NS_FATAL_ERROR("Cannot open " << file << ": " << std::strerror(errno));
+  }
+  size_t size = status.st_size;
+  if (size == 0) {
+    close(fd);
+    return;
+  }
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    NS_FATAL_ERROR("Cannot map " << file << ": " << std::strerror(errno));
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  m_mappings.push_back(std::make_pair(data, size));
+
+  const char* begin = static_cast<const char*>(data);
+  const char* end = begin + size;
+  const char* headerEnd = std::find(begin, end, '\n');
+  std::vector<std::string> header = splitHeader(std::string(begin, headerEnd));
+  begin = headerEnd == end ? end : headerEnd + 1;
+
+  // chunks of at least 1 MB, ending after a line break
+  const size_t MIN_CHUNK = 1 << 20;
+  size_t nChunks = std::max<size_t>(1, std::min<size_t>(m_nThreads,
+                                                        (end - begin) / MIN_CHUNK));
+  size_t chunkSize = (end - begin) / nChunks + 1;
+  while (begin < end) {
+    const char* chunkEnd = begin + std::min<size_t>(chunkSize, end - begin);
+    chunkEnd = std::find(chunkEnd, end, '\n');
+    if (chunkEnd != end)
+      ++chunkEnd;
+    m_tasks.push_back(Task{kind, replication, file, begin, chunkEnd, header});
+    begin = chunkEnd;
+  }
+}
+
+void
+TraceAnalyzer::runTask(const Task& task, Stats& stats) const
+{
+  std::string buffer;
+
+  if (task.begin != nullptr) {
+    Columns columns(task.header);
+    if (!columns.isComplete(task.kind)) {
+      // e.g., an app delay trace of periodic summaries
+      std::cerr << "Skipping " << task.file << ": unexpected columns" << std::endl;
+      return;
+    }
+    std::string lastLine;
+    const char* line = task.begin;
+    while (line < task.end) {
+      const char* lineEnd = std::find(line, task.end, '\n');
+      // the last line of a file without a line break is copied, for strtod to stop before the
+      // end of the mapping
+      const char* next = lineEnd;
+      if (lineEnd == task.end) {
+        lastLine.assign(line, lineEnd);
+        line = lastLine.c_str();
+        lineEnd = line + lastLine.size();
+      }
+      else {
+        ++next;
+      }
+
+      // repeated headers, e.g., of traces written by several processes, start with a letter
+      if (lineEnd > line && (std::isdigit(static_cast<unsigned char>(*line)) || *line == '-' ||
+                             *line == '.')) {
+        TextRow row(line, lineEnd);
+        processRow(task.kind, columns, row, stats, buffer);
+      }
+      line = next;
+    }
+    stats.nBytes += task.end - task.begin;
+    return;
+  }
+
+  std::shared_ptr<std::istream> is;
+  if (ndn::BinaryTraceWriter::IsBinaryFile(task.file)) {
+    if (ndn::AsyncTraceWriter::StripCompressionSuffix(task.file) != task.file) {
+      is = ndn::AsyncTraceWriter::OpenForReading(task.file);
+    }
+    else {
+      is = std::make_shared<std::ifstream>(task.file.c_str(), std::ios_base::binary);
+    }
+    if (is == nullptr || !*is) {
+      NS_FATAL_ERROR("Cannot open " << task.file);
+    }
+    ndn::BinaryTraceReader reader(*is);
+    std::vector<std::string> header;
+    for (const auto& column : reader.GetColumns()) {
+      header.push_back(column.name);
+    }
+    Columns columns(header);
+    if (!columns.isComplete(task.kind)) {
+      std::cerr << "Skipping " << task.file << ": unexpected columns" << std::endl;
+      return;
+    }
+    BinaryRow row(reader);
+    while (reader.Next()) {
+      processRow(task.kind, columns, row, stats, buffer);
+    }
+  }
+  else {
+    // compressed text trace, decompressed in memory
+    is = ndn::AsyncTraceWriter::OpenForReading(task.file);
+    if (is == nullptr) {
+      NS_FATAL_ERROR("Cannot open " << task.file);
+    }
+    std::string content((std::istreambuf_iterator<char>(*is)), std::istreambuf_iterator<char>());
+    const char* end = content.c_str() + content.size();
+    const char* headerEnd = std::find(content.c_str(), end, '\n');
+    Task text{task.kind, task.replication, task.file, headerEnd == end ? end : headerEnd + 1, end,
+              splitHeader(std::string(content.c_str(), headerEnd))};
+    // the terminating null of content stops strtod on the last line
+    runTask(text, stats);
+    stats.nBytes -= text.end - text.begin;
+  }
+  // the size on disk
+  std::ifstream file(task.file.c_str(), std::ios_base::binary | std::ios_base::ate);
+  stats.nBytes += std::max<std::streamoff>(0, file.tellg());
+}
+
+void
+TraceAnalyzer::processRow(TraceKind kind, const Columns& columns, const Row& row, Stats& stats,
+                          std::string& buffer) const
+{
+  switch (kind) {
+  case DELAYS: {
+    row.getString(columns.type, buffer);
+    if (buffer == "FullDelay") {
+      stats.nRetransmissions += std::max(0.0, row.getNumber(columns.retxCount) - 1);
+      if (m_delayType == "full") {
+        stats.delays.Record(std::max(0.0, row.getNumber(columns.delayUs)));
+      }
+    }
+    else if (buffer == "LastDelay" && m_delayType == "last") {
+      stats.delays.Record(std::max(0.0, row.getNumber(columns.delayUs)));
+    }
+    break;
+  }
+  case RATES: {
+    row.getString(columns.type, buffer);
+    RateStats& rate = stats.rates[buffer];
+    rate.packets += row.getNumber(columns.packetsRaw);
+    rate.kilobytes += row.getNumber(columns.kilobytesRaw);
+    stats.rateSpan.add(row.getNumber(columns.time));
+    break;
+  }
+  case EVENTS: {
+    row.getString(columns.prefix, buffer);
+    PrefixStats& prefix = stats.prefixes[buffer];
+    uint64_t key = row.getHash(columns.node) * 31 +
+                   ((static_cast<uint64_t>(row.getNumber(columns.appId)) << 32) |
+                    static_cast<uint32_t>(row.getNumber(columns.seqNo)));
+    row.getString(columns.type, buffer);
+    if (buffer == "Interest") {
+      ++prefix.nInterests;
+      prefix.requested.insert(key);
+    }
+    else if (buffer == "Data") {
+      ++prefix.nData;
+      prefix.satisfied.insert(key);
+    }
+    stats.eventSpan.add(row.getNumber(columns.time));
+    break;
+  }
+  }
+}
+
+void
+TraceAnalyzer::print(const std::vector<Stats>& replications, const Stats& all) const
+{
+  auto printSatisfaction = [] (const Stats& stats) {
+    uint64_t nRequested = 0;
+    uint64_t nSatisfied = 0;
+    for (const auto& prefix : stats.prefixes) {
+      nRequested += prefix.second.requested.size();
+      nSatisfied += prefix.second.satisfied.size();
+    }
+    if (nRequested > 0) {
+      std::cout << static_cast<double>(nSatisfied) / nRequested;
+      return;
+    }
+    auto satisfied = stats.rates.find("SatisfiedInterests");
+    auto timedOut = stats.rates.find("TimedOutInterests");
+    if (satisfied != stats.rates.end() && timedOut != stats.rates.end() &&
+        satisfied->second.packets + timedOut->second.packets > 0) {
+      std::cout << satisfied->second.packets /
+                     (satisfied->second.packets + timedOut->second.packets);
+      return;
+    }
+    std::cout << "-";
+  };
+
+  std::cout << "Replication"
+            << "\t"
+            << "Delays"
+            << "\t"
+            << "Mean(ms)"
+            << "\t"
+            << "p50(ms)"
+            << "\t"
+            << "p95(ms)"
+            << "\t"
+            << "p99(ms)"
+            << "\t"
+            << "Max(ms)"
+            << "\t"
+            << "Retransmissions"
+            << "\t"
+            << "Satisfaction"
+            << "\n";
+  for (size_t i = 0; i <= replications.size(); ++i) {
+    const Stats& stats = i < replications.size() ? replications[i] : all;
+    std::cout << (i < replications.size() ? m_replications[i] : "all") << "\t"
+              << stats.delays.GetCount() << "\t"
+              << stats.delays.GetMean() / 1000 << "\t"
+              << stats.delays.GetPercentile(50) / 1000.0 << "\t"
+              << stats.delays.GetPercentile(95) / 1000.0 << "\t"
+              << stats.delays.GetPercentile(99) / 1000.0 << "\t"
+              << stats.delays.GetMax() / 1000.0 << "\t"
+              << stats.nRetransmissions << "\t";
+    printSatisfaction(stats);
+    std::cout << "\n";
+  }
+
+  // rates over the traced time of every replication
+  double eventTime = 0;
+  double rateTime = 0;
+  for (const Stats& stats : replications) {
+    eventTime += std::max(0.0, stats.eventSpan.last);
+    rateTime += std::max(0.0, stats.rateSpan.last);
+  }
+
+  if (!all.prefixes.empty()) {
+    std::cout << "\n"
+              << "Prefix"
+              << "\t"
+              << "Interests/s"
+              << "\t"
+              << "Data/s"
+              << "\t"
+              << "Satisfaction"
+              << "\n";
+    for (const auto& prefix : all.prefixes) {
+      const PrefixStats& stats = prefix.second;
+      std::cout << prefix.first << "\t"
+                << (eventTime > 0 ? stats.nInterests / eventTime : 0) << "\t"
+                << (eventTime > 0 ? stats.nData / eventTime : 0) << "\t"
+                << (stats.requested.empty() ? 0 :
+                    static_cast<double>(stats.satisfied.size()) / stats.requested.size())
+                << "\n";
+    }
+  }
+
+  if (!all.rates.empty()) {
+    std::cout << "\n"
+              << "Type"
+              << "\t"
+              << "Packets/s"
+              << "\t"
+              << "Kilobytes/s"
+              << "\n";
+    for (const auto& rate : all.rates) {
+      std::cout << rate.first << "\t"
+                << (rateTime > 0 ? rate.second.packets / rateTime : 0) << "\t"
+                << (rateTime > 0 ? rate.second.kilobytes / rateTime : 0) << "\n";
+    }
+  }
+}
+
+void
+TraceAnalyzer::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("dirs", "Comma-separated directories of the replications", m_dirs);
+  cmd.AddValue("delays", "File name of the app delay trace in every directory", m_delays);
+  cmd.AddValue("rates", "File name of the rate trace in every directory", m_rates);
+  cmd.AddValue("events", "File name of the consumer event trace in every directory", m_events);
+  cmd.AddValue("delay", "Delays to report: full (from the first Interest) or last", m_delayType);
+  cmd.AddValue("threads", "Number of parsing threads", m_nThreads);
+  cmd.Parse(argc, argv);
+
+  if (m_dirs.empty()) {
+    m_dirs = ".";
+  }
+  if (m_delayType != "full" && m_delayType != "last") {
+    NS_FATAL_ERROR("--delay should be full or last");
+  }
+  m_nThreads = std::max<uint32_t>(m_nThreads, 1);
+  boost::split(m_replications, m_dirs, boost::is_any_of(","));
+
+  double start = now();
+  for (size_t i = 0; i < m_replications.size(); ++i) {
+    addTasks(DELAYS, i, m_replications[i] + "/" + m_delays);
+    addTasks(RATES, i, m_replications[i] + "/" + m_rates);
+    addTasks(EVENTS, i, m_replications[i] + "/" + m_events);
+  }
+  if (m_tasks.empty()) {
+    NS_FATAL_ERROR("No trace found in " << m_dirs);
+  }
+
+  // whole files first, as they take the longest
+  std::stable_sort(m_tasks.begin(), m_tasks.end(), [] (const Task& a, const Task& b) {
+      return a.begin == nullptr && b.begin != nullptr;
+    });
+
+  std::vector<Stats> results(m_tasks.size());
+  std::atomic<size_t> nextTask(0);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < std::min<size_t>(m_nThreads, m_tasks.size()); ++i) {
+    threads.emplace_back([&] {
+        for (size_t task = nextTask++; task < m_tasks.size(); task = nextTask++) {
+          runTask(m_tasks[task], results[task]);
+        }
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<Stats> replications(m_replications.size());
+  Stats all;
+  for (size_t i = 0; i < m_tasks.size(); ++i) {
+    replications[m_tasks[i].replication].merge(results[i]);
+    all.merge(results[i]);
+  }
+  for (const auto& mapping : m_mappings) {
+    munmap(mapping.first, mapping.second);
+  }
+
+  double elapsed = now() - start;
+  std::cout << "# " << m_tasks.size() << " tasks, " << all.nBytes / 1e6 << " MB in " << elapsed
+            << " s with " << m_nThreads << " threads\n";
+  print(replications, all);
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TraceAnalyzer analyzer;
+  analyzer.run(argc, argv);
+  return 0;
+}
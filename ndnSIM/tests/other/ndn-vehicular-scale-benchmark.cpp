@@ -0,0 +1,501 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-vehicular-scale-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ns2-mobility-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-80211p-helper.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/ndnSIM/utils/ndn-event-profiler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3 {
+
+/**
+ * Runs the vehicular scenario of scratch/Simulation.cc (802.11p, multicast strategy,
+ * ConsumerRandomCbr and Producer apps) on synthetic road networks of increasing size, to track
+ * how the simulator scales across changes.
+ *
+ * For every size, an ns2 mobility trace is generated on a square grid of streets, whose side
+ * grows with the square root of the number of vehicles so that the density stays constant:
+ *  - grid: every vehicle drives straight along its street and turns back at the border
+ *  - manhattan: at every intersection, a vehicle goes straight with probability 0.5, turns
+ *    left or right with probability 0.25 each
+ *
+ * A fraction of the vehicles run ConsumerRandomCbr.  Static roadside units at random
+ * intersections run a Producer for the first spatial component of the scene1 names
+ * (/S/addr_0, /S/addr_1, /S/addr_2) of the vertical third of the area they stand in.
+ *
+ * Every size runs for --sim-time in a child process, one after the other, so that the peak
+ * resident size is the one of that size alone.  The report lists, for every size, the wall
+ * time of Simulator::Run, the executed events and events per second (see EventProfiler), the
+ * peak resident size, and the ratio of Interests sent before the last --settle-time that were
+ * satisfied:
+ *
+ *     ./waf --run "ndn-vehicular-scale-benchmark --sizes=100,500,1000 --pattern=manhattan
+ *                  --sim-time=60 --output=scale.json"
+ */
+class VehicularScaleBenchmark {
+public:
+  VehicularScaleBenchmark()
+    : m_sizes("100,500,1000,5000,10000")
+    , m_pattern("grid")
+    , m_simTime(Seconds(60))
+    , m_settleTime(Seconds(4))
+    , m_consumerFraction(0.1)
+    , m_frequency(1.0)
+    , m_vehiclesPerRsu(50)
+    , m_blockSize(200)
+    , m_vehiclesPerBlock(4)
+    , m_seed(1)
+    , m_output("vehicular-scale.json")
+    , m_keepMobility(false)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  struct Result {
+    uint32_t nVehicles = 0;
+    uint32_t nRsus = 0;
+    int status = 1;
+    double wallTime = 0;
+    uint64_t nEvents = 0;
+    int64_t peakRss = 0; // bytes
+    uint64_t nRequested = 0;
+    uint64_t nSatisfied = 0;
+  };
+
+  struct Layout {
+    uint32_t nBlocks; // per side
+    std::vector<Vector> rsus;
+  };
+
+  Layout
+  writeMobility(const std::string& file, uint32_t nVehicles) const;
+
+  void
+  runSize(const std::string& mobilityFile, uint32_t nVehicles, const Layout& layout,
+          Result& result);
+
+  Result
+  forkSize(uint32_t nVehicles);
+
+  void
+  InterestSent(Ptr<ndn::App> app, const ndn::Name& name, uint32_t seq, Time rto);
+
+  void
+  DataReceived(Ptr<ndn::App> app, const ndn::Name& name, uint32_t seq);
+
+  void
+  writeReport(const std::vector<Result>& results) const;
+
+  static uint64_t
+  makeKey(Ptr<ndn::App> app, uint32_t seq)
+  {
+    return (static_cast<uint64_t>(app->GetNode()->GetId()) << 32) | seq;
+  }
+
+  static double
+  now();
+
+private:
+  std::string m_sizes;
+  std::string m_pattern;
+  Time m_simTime;
+  Time m_settleTime;
+  double m_consumerFraction;
+  double m_frequency;
+  uint32_t m_vehiclesPerRsu;
+  double m_blockSize;
+  double m_vehiclesPerBlock;
+  uint32_t m_seed;
+  std::string m_output;
+  bool m_keepMobility;
+
+  std::unordered_set<uint64_t> m_requested;
+  uint64_t m_nSatisfied = 0;
+};
+
+double
+VehicularScaleBenchmark::now()
+{
+  ::timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + (0.000001 * (unsigned)t.tv_usec);
+}
+
+VehicularScaleBenchmark::Layout
+VehicularScaleBenchmark::writeMobility(const std::string& file, uint32_t nVehicles) const
+{
+  std::mt19937 rng(m_seed * 7919 + nVehicles);
+  Layout layout;
+  layout.nBlocks = std::max<uint32_t>(2, std::ceil(std::sqrt(nVehicles / m_vehiclesPerBlock)));
+  std::uniform_int_distribution<uint32_t> intersection(0, layout.nBlocks);
+  std::uniform_int_distribution<int> direction(0, 3);
+  std::uniform_real_distribution<double> speed(10, 20); // m/s
+  std::discrete_distribution<int> turn({0.5, 0.25, 0.25}); // straight, left, right
+
+  std::ofstream os(file.c_str());
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << file);
+  }
+
+  // +x, +y, -x, -y
+  static const int dx[] = {1, 0, -1, 0};
+  static const int dy[] = {0, 1, 0, -1};
+  auto isInside = [&] (int x, int y) {
+    return x >= 0 && y >= 0 && x <= static_cast<int>(layout.nBlocks)
+           && y <= static_cast<int>(layout.nBlocks);
+  };
+
+  double end = m_simTime.ToDouble(Time::S);
+  for (uint32_t i = 0; i < nVehicles; ++i) {
+    int x = intersection(rng);
+    int y = intersection(rng);
+    int d = direction(rng);
+    double v = speed(rng);
+    os << "$node_(" << i << ") set X_ " << x * m_blockSize << "\n"
+       << "$node_(" << i << ") set Y_ " << y * m_blockSize << "\n"
+       << "$node_(" << i << ") set Z_ 0\n";
+
+    for (double t = 0; t < end; t += m_blockSize / v) {
+      if (m_pattern == "manhattan") {
+        int choice = turn(rng);
+        int turned = choice == 0 ? d : choice == 1 ? (d + 1) % 4 : (d + 3) % 4;
+        if (isInside(x + dx[turned], y + dy[turned]))
+          d = turned;
+      }
+      // straight on is always possible inside the grid, except at the border
+      if (!isInside(x + dx[d], y + dy[d]))
+        d = (d + 2) % 4;
+
+      x += dx[d];
+      y += dy[d];
+      os << "$ns_ at " << t << " \"$node_(" << i << ") setdest " << x * m_blockSize << " "
+         << y * m_blockSize << " " << v << "\"\n";
+    }
+  }
+
+  // roadside units stay at their intersection
+  uint32_t nRsus = std::max<uint32_t>(3, nVehicles / m_vehiclesPerRsu);
+  for (uint32_t i = 0; i < nRsus; ++i) {
+    Vector position(intersection(rng) * m_blockSize, intersection(rng) * m_blockSize, 0);
+    layout.rsus.push_back(position);
+    os << "$node_(" << nVehicles + i << ") set X_ " << position.x << "\n"
+       << "$node_(" << nVehicles + i << ") set Y_ " << position.y << "\n"
+       << "$node_(" << nVehicles + i << ") set Z_ 0\n";
+  }
+  return layout;
+}
+
+void
+VehicularScaleBenchmark::InterestSent(Ptr<ndn::App> app, const ndn::Name& name, uint32_t seq,
+                                      Time rto)
+{
+  // retransmissions are inserted again, without effect
+  if (Simulator::Now() < m_simTime - m_settleTime)
+    m_requested.insert(makeKey(app, seq));
+}
+
+void
+VehicularScaleBenchmark::DataReceived(Ptr<ndn::App> app, const ndn::Name& name, uint32_t seq)
+{
+  if (m_requested.erase(makeKey(app, seq)) > 0)
+    ++m_nSatisfied;
+}
+
+void
+VehicularScaleBenchmark::runSize(const std::string& mobilityFile, uint32_t nVehicles,
+                                 const Layout& layout, Result& result)
+{
+  ndn::EventProfiler::Enable();
+  RngSeedManager::SetSeed(m_seed);
+
+  NodeContainer vehicles;
+  vehicles.Create(nVehicles);
+  NodeContainer rsus;
+  rsus.Create(layout.rsus.size());
+  NodeContainer nodes(vehicles, rsus);
+
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+  wifiPhy.SetChannel(wifiChannel.Create());
+  NqosWaveMacHelper wifi80211pMac = NqosWaveMacHelper::Default();
+  Wifi80211pHelper wifi80211p = Wifi80211pHelper::Default();
+  wifi80211p.Install(wifiPhy, wifi80211pMac, nodes);
+
+  Ns2MobilityHelper ns2helper(mobilityFile);
+  ns2helper.Install();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/multicast");
+
+  // every third of the area along x produces the names of one top-level region of scene1
+  double side = layout.nBlocks * m_blockSize;
+  for (size_t i = 0; i < layout.rsus.size(); ++i) {
+    int region = std::min(2, static_cast<int>(layout.rsus[i].x * 3 / (side + 1)));
+    ndn::AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/S/addr_" + std::to_string(region));
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(rsus.Get(i));
+  }
+
+  uint32_t nConsumers = std::max<uint32_t>(1, std::lround(nVehicles * m_consumerFraction));
+  std::mt19937 rng(m_seed);
+  std::vector<uint32_t> consumers(nVehicles);
+  std::iota(consumers.begin(), consumers.end(), 0);
+  std::shuffle(consumers.begin(), consumers.end(), rng);
+  consumers.resize(std::min(nConsumers, nVehicles));
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerRandomCbr");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(m_frequency));
+  ApplicationContainer consumerApps;
+  std::uniform_real_distribution<double> start(0, 1);
+  for (uint32_t i : consumers) {
+    ApplicationContainer app = consumerHelper.Install(vehicles.Get(i));
+    app.Start(Seconds(start(rng)));
+    consumerApps.Add(app);
+  }
+  ndn::AppHelper::AssignStreams(consumerApps, 0);
+
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::Consumer/InterestSent",
+                                MakeCallback(&VehicularScaleBenchmark::InterestSent, this));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::Consumer/DataReceived",
+                                MakeCallback(&VehicularScaleBenchmark::DataReceived, this));
+
+  Simulator::Stop(m_simTime);
+  double begin = now();
+  Simulator::Run();
+  result.wallTime = now() - begin;
+
+  for (const ndn::EventProfiler::Record& record : ndn::EventProfiler::GetRecords()) {
+    result.nEvents += record.nExecuted;
+  }
+  result.nSatisfied = m_nSatisfied;
+  result.nRequested = m_nSatisfied + m_requested.size();
+
+  Simulator::Destroy();
+
+  ::rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  result.peakRss = static_cast<int64_t>(usage.ru_maxrss) * 1024;
+  result.status = 0;
+}
+
+VehicularScaleBenchmark::Result
+VehicularScaleBenchmark::forkSize(uint32_t nVehicles)
+{
+  Result result;
+  result.nVehicles = nVehicles;
+
+  std::string mobilityFile = "vehicular-" + m_pattern + "-" + std::to_string(nVehicles) + ".tcl";
+  Layout layout = writeMobility(mobilityFile, nVehicles);
+  result.nRsus = layout.rsus.size();
+
+  int fds[2];
+  if (pipe(fds) != 0) {
+    NS_FATAL_ERROR("pipe failed: " << std::strerror(errno));
+  }
+
+  // buffered output would be written by the child too
+  std::cout.flush();
+  std::cerr.flush();
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    runSize(mobilityFile, nVehicles, layout, result);
+    std::ostringstream os;
+    os << result.wallTime << " " << result.nEvents << " " << result.peakRss << " "
+       << result.nRequested << " " << result.nSatisfied << "\n";
+    std::string line = os.str();
+    bool isWritten = write(fds[1], line.data(), line.size()) == static_cast<ssize_t>(line.size());
+    close(fds[1]);
+    _exit(isWritten ? 0 : 1);
+  }
+  close(fds[1]);
+  if (pid < 0) {
+    NS_FATAL_ERROR("fork failed: " << std::strerror(errno));
+  }
+
+  std::string line;
+  char buffer[256];
+  ssize_t n;
+  while ((n = read(fds[0], buffer, sizeof(buffer))) != 0) {
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      break;
+    line.append(buffer, n);
+  }
+  close(fds[0]);
+
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+  }
+  bool isExited = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+  std::istringstream is(line);
+  if (isExited && is >> result.wallTime >> result.nEvents >> result.peakRss
+                     >> result.nRequested >> result.nSatisfied) {
+    result.status = 0;
+  }
+
+  if (!m_keepMobility) {
+    std::remove(mobilityFile.c_str());
+  }
+  return result;
+}
+
+void
+VehicularScaleBenchmark::writeReport(const std::vector<Result>& results) const
+{
+  std::ofstream os(m_output.c_str());
+  if (!os) {
+    NS_FATAL_ERROR("Cannot write " << m_output);
+  }
+
+  os << "{\n"
+     << "  \"pattern\": \"" << m_pattern << "\",\n"
+     << "  \"simTime\": " << m_simTime.ToDouble(Time::S) << ",\n"
+     << "  \"consumerFraction\": " << m_consumerFraction << ",\n"
+     << "  \"frequency\": " << m_frequency << ",\n"
+     << "  \"seed\": " << m_seed << ",\n"
+     << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& result = results[i];
+    os << (i == 0 ? "\n" : ",\n")
+       << "    {\"vehicles\": " << result.nVehicles
+       << ", \"rsus\": " << result.nRsus
+       << ", \"status\": " << (result.status == 0 ? "\"ok\"" : "\"failed\"");
+    if (result.status == 0) {
+      os << ", \"wallTime\": " << result.wallTime
+         << ", \"events\": " << result.nEvents
+         << ", \"eventRate\": " << (result.wallTime > 0 ? result.nEvents / result.wallTime : 0)
+         << ", \"peakRss\": " << result.peakRss
+         << ", \"requested\": " << result.nRequested
+         << ", \"satisfied\": " << result.nSatisfied
+         << ", \"satisfactionRatio\": ";
+      if (result.nRequested > 0)
+        os << static_cast<double>(result.nSatisfied) / result.nRequested;
+      else
+        os << "null";
+    }
+    os << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+int
+VehicularScaleBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("sizes", "Comma-separated numbers of vehicles", m_sizes);
+  cmd.AddValue("pattern", "Mobility pattern: grid or manhattan", m_pattern);
+  cmd.AddValue("sim-time", "Simulated time of every size", m_simTime);
+  cmd.AddValue("settle-time", "Interests sent in the last settle-time are not counted",
+               m_settleTime);
+  cmd.AddValue("consumers", "Fraction of the vehicles running ConsumerRandomCbr",
+               m_consumerFraction);
+  cmd.AddValue("frequency", "Interests per second of every consumer", m_frequency);
+  cmd.AddValue("vehicles-per-rsu", "Number of vehicles per roadside producer", m_vehiclesPerRsu);
+  cmd.AddValue("block", "Length of a block between two intersections, in meters", m_blockSize);
+  cmd.AddValue("density", "Number of vehicles per block", m_vehiclesPerBlock);
+  cmd.AddValue("seed", "Seed of the mobility, the placements and the simulation", m_seed);
+  cmd.AddValue("output", "JSON report", m_output);
+  cmd.AddValue("keep-mobility", "Keep the generated ns2 mobility files", m_keepMobility);
+  cmd.Parse(argc, argv);
+
+  if (m_pattern != "grid" && m_pattern != "manhattan") {
+    NS_FATAL_ERROR("Unknown mobility pattern " << m_pattern);
+  }
+  if (m_settleTime >= m_simTime) {
+    NS_FATAL_ERROR("settle-time must be shorter than sim-time");
+  }
+
+  std::vector<uint32_t> sizes;
+  std::istringstream is(m_sizes);
+  std::string size;
+  while (std::getline(is, size, ',')) {
+    sizes.push_back(std::stoul(size));
+  }
+
+  std::cout << "Vehicles"
+            << "\t"
+            << "Wall(s)"
+            << "\t"
+            << "Events/s"
+            << "\t"
+            << "PeakRSS(MB)"
+            << "\t"
+            << "Satisfaction"
+            << "\n";
+
+  std::vector<Result> results;
+  for (uint32_t nVehicles : sizes) {
+    results.push_back(forkSize(nVehicles));
+    const Result& result = results.back();
+    if (result.status != 0) {
+      std::cout << nVehicles << "\tfailed\n";
+      continue;
+    }
+    std::cout << nVehicles << "\t" << result.wallTime << "\t"
+              << (result.wallTime > 0 ? result.nEvents / result.wallTime : 0) << "\t"
+              << result.peakRss / 1048576.0 << "\t"
+              << (result.nRequested > 0 ? static_cast<double>(result.nSatisfied) / result.nRequested
+                                        : 0)
+              << std::endl;
+  }
+
+  writeReport(results);
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::VehicularScaleBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
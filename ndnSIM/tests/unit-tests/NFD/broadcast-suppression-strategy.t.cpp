@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/broadcast-suppression-strategy.hpp"
+#include "ns3/ndnSIM/helper/ndn-strategy-choice-helper.hpp"
+
+#include "ns3/constant-position-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::fw::BroadcastSuppressionStrategy;
+
+class BroadcastSuppressionStrategyFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  BroadcastSuppressionStrategyFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+  }
+
+  ~BroadcastSuppressionStrategyFixture()
+  {
+    BroadcastSuppressionStrategy::getDefaultParameters() = BroadcastSuppressionStrategy::Parameters();
+  }
+
+  void
+  setPosition(const std::string& node, double x)
+  {
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(x, 0, 0));
+    getNode(node)->AggregateObject(mobility);
+  }
+
+  void
+  createChain(double probability)
+  {
+    BroadcastSuppressionStrategy::Parameters& parameters =
+      BroadcastSuppressionStrategy::getDefaultParameters();
+    parameters.mode = BroadcastSuppressionStrategy::MODE_PROBABILISTIC;
+    parameters.probability = probability;
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+      });
+
+    addRoutes({
+        {"1", "2", "/S", 1},
+        {"2", "3", "/S", 1},
+      });
+    StrategyChoiceHelper::InstallAll("/S", "/localhost/nfd/strategy/broadcast-suppression");
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/S/Region/A/app"}, {"Frequency", "10"}},
+            "0s", "0.99s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/S/Region/A/app"}, {"PayloadSize", "100"}},
+            "0s", "100s"}
+      });
+  }
+
+  void
+  runChain(double probability)
+  {
+    createChain(probability);
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdBroadcastSuppressionStrategy, BroadcastSuppressionStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(AlwaysForward)
+{
+  runChain(1.0);
+
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(NeverForward)
+{
+  runChain(0.0);
+
+  // the consumer node forwards, the relay does not
+  BOOST_CHECK_GE(getFace("1", "2")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 0);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(OverheardData)
+{
+  createChain(1.0);
+
+  // the relay has overheard Data for the first 5 Interests of the consumer
+  shared_ptr<nfd::Forwarder> forwarder = getNode("2")->GetObject<L3Protocol>()->getForwarder();
+  forwarder->setOverheardDataLifetime(time::seconds(100));
+  for (uint32_t seq = 0; seq < 5; ++seq) {
+    Data data(Name("/S/Region/A/app").appendSequenceNumber(seq));
+    forwarder->onDataUnsolicited(*getFace("2", "3"), data);
+  }
+  BOOST_CHECK(forwarder->hasOverheardData(Name("/S/Region/A/app").appendSequenceNumber(4)));
+  BOOST_CHECK(!forwarder->hasOverheardData(Name("/S/Region/A/app").appendSequenceNumber(5)));
+  BOOST_CHECK(forwarder->hasOverheardData("/S/Region"));
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 5);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 5);
+
+  // without an admission filter, only the Data of forwarded Interests are cached
+  BOOST_CHECK_EQUAL(forwarder->getCs().size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(Distance)
+{
+  BroadcastSuppressionStrategy::Parameters& parameters =
+    BroadcastSuppressionStrategy::getDefaultParameters();
+  parameters.mode = BroadcastSuppressionStrategy::MODE_DISTANCE;
+  parameters.maxDefer = time::milliseconds(100);
+  parameters.range = 250;
+
+  //     1
+  //    / \       1 at 0, 3 at 50, 2 at 200
+  //   2 - 3
+  createTopology({
+      {"1", "2"},
+      {"1", "3"},
+      {"2", "3"},
+    });
+  setPosition("1", 0);
+  setPosition("2", 200);
+  setPosition("3", 50);
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+      {"1", "3", "/S", 1},
+      {"2", "3", "/S", 1},
+      {"3", "2", "/S", 1},
+    });
+  StrategyChoiceHelper::InstallAll("/S", "/localhost/nfd/strategy/broadcast-suppression");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Region/A/app"}, {"Frequency", "10"}},
+          "0s", "0.99s"},
+    });
+
+  // stop before the consumer retransmits
+  Simulator::Stop(Seconds(0.98));
+  Simulator::Run();
+
+  // node 2 is farther from the consumer and rebroadcasts first, node 3 overhears the copy
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getFaceStatus().getNOutInterests(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/geo-forwarding-strategy.hpp"
+#include "ns3/ndnSIM/helper/ndn-strategy-choice-helper.hpp"
+#include "ns3/ndnSIM/utils/ndn-geo-region-table.hpp"
+
+#include "ns3/constant-position-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class GeoForwardingStrategyFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ~GeoForwardingStrategyFixture()
+  {
+    GeoRegionTable::Clear();
+  }
+
+  void
+  setPosition(const std::string& node, double x)
+  {
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(x, 0, 0));
+    getNode(node)->AggregateObject(mobility);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdGeoForwardingStrategy, GeoForwardingStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(ForwardOnProgress)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  //   4 --- 1 --- 2 --- 3   (region around 3)
+  createTopology({
+      {"1", "2"},
+      {"1", "4"},
+      {"2", "3"},
+    });
+  setPosition("4", -100);
+  setPosition("1", 0);
+  setPosition("2", 100);
+  setPosition("3", 200);
+  GeoRegionTable::Add("/Region", Vector(200, 0, 0), 10);
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+      {"1", "4", "/S", 1},
+      {"2", "3", "/S", 1},
+      {"4", "1", "/S", 1},
+    });
+  StrategyChoiceHelper::InstallAll("/S", "/localhost/nfd/strategy/geo-forwarding");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Region/A/app"}, {"Frequency", "10"}},
+          "0s", "0.99s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/S/Region/A/app"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // the consumer floods, node 4 is farther from the region than node 1 and does not forward
+  BOOST_CHECK_EQUAL(getFace("1", "4")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("4", "1")->getFaceStatus().getNInInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("4", "1")->getFaceStatus().getNOutInterests(), 0);
+
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(NoRegion)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+      {"2", "3"},
+    });
+  setPosition("1", 0);
+  setPosition("2", -100);
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+      {"2", "3", "/S", 1},
+    });
+  StrategyChoiceHelper::InstallAll("/S", "/localhost/nfd/strategy/geo-forwarding");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Unknown/A/app"}, {"Frequency", "10"}},
+          "0s", "0.99s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/S/Unknown/A/app"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+
+  // without a registered region the strategy forwards like multicast
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
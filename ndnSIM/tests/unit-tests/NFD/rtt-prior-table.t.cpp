@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/rtt-prior-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::fw::RttPriorTable;
+
+BOOST_FIXTURE_TEST_SUITE(NfdRttPriorTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Estimate)
+{
+  RttPriorTable table;
+  RttPriorTable::Estimate estimate;
+  BOOST_CHECK(!table.estimate("/S/NankaiDistrict/A/TrafficInformer/%00%01", estimate));
+
+  table.addMeasurement("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer", 300,
+                       time::milliseconds(20));
+  table.addMeasurement("/S/HepingDistrict/A/Weather", 301, time::milliseconds(100));
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  BOOST_REQUIRE(table.estimate("/S/NankaiDistrict/A/TrafficInformer/%00%01", estimate));
+  BOOST_CHECK_EQUAL(estimate.face, 300);
+  BOOST_CHECK_EQUAL(estimate.rtt, time::milliseconds(20));
+  BOOST_CHECK_EQUAL(estimate.deviation, time::microseconds(0));
+  BOOST_CHECK_GT(estimate.correlativity, 0.0);
+
+  // correlated with both prefixes, the RTT is in between
+  BOOST_REQUIRE(table.estimate("/S/NankaiDistrict/A/Weather", estimate));
+  BOOST_CHECK_GT(estimate.rtt, time::milliseconds(20));
+  BOOST_CHECK_LT(estimate.rtt, time::milliseconds(100));
+  BOOST_CHECK_GT(estimate.deviation, time::microseconds(0));
+
+  // names without structured segments are not correlated
+  BOOST_CHECK(!table.estimate("/prefix/A", estimate));
+  BOOST_CHECK(!table.estimate("/other", estimate));
+}
+
+BOOST_AUTO_TEST_CASE(Capacity)
+{
+  RttPriorTable table(2);
+  table.addMeasurement("/S/R1/A/app", 300, time::milliseconds(10));
+  table.addMeasurement("/S/R2/A/app", 301, time::milliseconds(10));
+  table.addMeasurement("/S/R1/A/app", 302, time::milliseconds(10)); // R1 is the most recent
+  table.addMeasurement("/S/R3/A/other", 303, time::milliseconds(10));
+  BOOST_CHECK_EQUAL(table.size(), 2);
+
+  RttPriorTable::Estimate estimate;
+  BOOST_REQUIRE(table.estimate("/S/R1/A/app/%00%01", estimate));
+  BOOST_CHECK_EQUAL(estimate.face, 302);
+  BOOST_CHECK(!table.estimate("/S/R2/A/unrelated", estimate));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
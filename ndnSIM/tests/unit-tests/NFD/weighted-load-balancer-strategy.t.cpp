@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/fw/weighted-load-balancer-strategy.hpp"
+#include "ns3/ndnSIM/helper/ndn-strategy-choice-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-face.hpp"
+
+#include "ns3/channel.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class WeightedLoadBalancerStrategyFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  WeightedLoadBalancerStrategyFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+  }
+
+  void
+  setDelay(const std::string& node1, const std::string& node2, const std::string& delay)
+  {
+    auto face = std::dynamic_pointer_cast<NetDeviceFace>(getFace(node1, node2));
+    BOOST_REQUIRE(face != nullptr);
+    face->GetNetDevice()->GetChannel()->SetAttribute("Delay", StringValue(delay));
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdWeightedLoadBalancerStrategy, WeightedLoadBalancerStrategyFixture)
+
+BOOST_AUTO_TEST_CASE(SplitByRtt)
+{
+  //     2
+  //   /   \        1-3 is four times slower than the other links
+  //  1     4
+  //   \   /
+  //     3
+  createTopology({
+      {"1", "2"},
+      {"1", "3"},
+      {"2", "4"},
+      {"3", "4"},
+    });
+  setDelay("1", "3", "40ms");
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+      {"1", "3", "/S", 1},
+      {"2", "4", "/S", 1},
+      {"3", "4", "/S", 1},
+    });
+  StrategyChoiceHelper::Install(getNode("1"), "/S",
+                                "/localhost/nfd/strategy/weighted-load-balancer");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Region/A/app"}, {"Frequency", "100"}},
+          "0s", "9.99s"},
+      {"4", "ns3::ndn::Producer",
+          {{"Prefix", "/S/Region/A/app"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(11.0));
+  Simulator::Run();
+
+  uint64_t nFast = getFace("1", "2")->getFaceStatus().getNOutInterests();
+  uint64_t nSlow = getFace("1", "3")->getFaceStatus().getNOutInterests();
+  BOOST_CHECK_EQUAL(nFast + nSlow, 1000);
+  BOOST_CHECK_GT(nSlow, 50);
+  BOOST_CHECK_GT(nFast, 2 * nSlow);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas() +
+                    getFace("1", "3")->getFaceStatus().getNInDatas(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(NoRoute)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+    });
+  StrategyChoiceHelper::InstallAll("/S", "/localhost/nfd/strategy/weighted-load-balancer");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Region/A/app"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+    });
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  // node 2 has no route and answers every Interest with a Nack
+  BOOST_CHECK_GE(getFace("1", "2")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 0);
+  BOOST_CHECK_GE(static_cast<uint64_t>(getFace("2", "1")->getCounters().getNOutNacks()), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
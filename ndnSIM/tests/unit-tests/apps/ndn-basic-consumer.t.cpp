@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "apps/ndn-basic-consumer.hpp"
+
+#include "../tests-common.hpp"
+
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+class BasicConsumerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  BasicConsumerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "3"},
+        {"2", "3"},
+      });
+
+    addRoutes({
+        {"1", "3", "/", 1},
+        {"2", "3", "/", 1},
+      });
+  }
+
+  void
+  connect()
+  {
+    Ptr<Application> app1 = getNode("1")->GetApplication(0);
+    app1->TraceConnectWithoutContext("InterestSent",
+                                     MakeCallback(&BasicConsumerFixture::interestSent1, this));
+    app1->TraceConnectWithoutContext("DataReceived",
+                                     MakeCallback(&BasicConsumerFixture::dataReceived1, this));
+    Ptr<Application> app2 = getNode("2")->GetApplication(0);
+    app2->TraceConnectWithoutContext("InterestSent",
+                                     MakeCallback(&BasicConsumerFixture::interestSent2, this));
+    app2->TraceConnectWithoutContext("DataReceived",
+                                     MakeCallback(&BasicConsumerFixture::dataReceived2, this));
+  }
+
+  void
+  interestSent1(Ptr<App>, const Name&, uint32_t, Time rto)
+  {
+    rtos1.push_back(rto);
+  }
+
+  void
+  interestSent2(Ptr<App>, const Name&, uint32_t, Time rto)
+  {
+    rtos2.push_back(rto);
+  }
+
+  void
+  dataReceived1(Ptr<App>, const Name& name, uint32_t seq)
+  {
+    names1.insert(name.getPrefix(-1));
+    seqs1.push_back(seq);
+  }
+
+  void
+  dataReceived2(Ptr<App>, const Name& name, uint32_t seq)
+  {
+    names2.insert(name.getPrefix(-1));
+    seqs2.push_back(seq);
+  }
+
+public:
+  std::vector<Time> rtos1;
+  std::vector<Time> rtos2;
+  std::set<Name> names1;
+  std::set<Name> names2;
+  std::vector<uint32_t> seqs1;
+  std::vector<uint32_t> seqs2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsBasicConsumer, BasicConsumerFixture)
+
+BOOST_AUTO_TEST_CASE(SameAsConsumerCbr)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTimeRtoFactor", "2"}},
+          "0s", "2s"},
+      {"2", "ns3::ndn::BasicConsumerCbrTcp",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTimeRtoFactor", "2"}},
+          "0s", "2s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+  connect();
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(rtos1.size(), 20);
+  BOOST_CHECK_EQUAL_COLLECTIONS(rtos1.begin(), rtos1.end(), rtos2.begin(), rtos2.end());
+  BOOST_CHECK_EQUAL(seqs1.size(), 20);
+  BOOST_CHECK_EQUAL_COLLECTIONS(seqs1.begin(), seqs1.end(), seqs2.begin(), seqs2.end());
+}
+
+BOOST_AUTO_TEST_CASE(Names)
+{
+  addApps({
+      {"1", "ns3::ndn::BasicConsumerRandomCbrCorrelativity",
+          {{"Frequency", "10"}},
+          "0s", "2s"},
+      {"2", "ns3::ndn::BasicConsumerZipfMandelbrotTcp",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"NumberOfContents", "10"},
+           {"MaxSeq", "15"}},
+          "0s", "2s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+  connect();
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(seqs1.size(), 20);
+  BOOST_CHECK_GT(names1.size(), 1);
+
+  BOOST_CHECK_EQUAL(seqs2.size(), 15);
+  BOOST_CHECK_EQUAL(names2.size(), 1);
+  for (uint32_t seq : seqs2) {
+    BOOST_CHECK_GE(seq, 1);
+    BOOST_CHECK_LE(seq, 10);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-population.hpp"
+
+#include "../tests-common.hpp"
+
+#include <set>
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerPopulationFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerPopulationFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("100Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("1000"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+  }
+
+  Ptr<ConsumerPopulation>
+  getPopulation()
+  {
+    return DynamicCast<ConsumerPopulation>(getNode("1")->GetApplication(0));
+  }
+
+  void
+  onData(Ptr<App> app, uint32_t consumer, uint32_t seq, Time delay, uint32_t nTransmissions)
+  {
+    BOOST_CHECK(received.insert({consumer, seq}).second);
+    BOOST_CHECK_GE(delay, MilliSeconds(20));
+    if (nTransmissions > 1)
+      ++nRetransmitted;
+  }
+
+public:
+  std::set<std::pair<uint32_t, uint32_t>> received;
+  size_t nRetransmitted = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumerPopulation, ConsumerPopulationFixture)
+
+BOOST_AUTO_TEST_CASE(AllSatisfied)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerPopulation",
+          {{"Prefix", "/prefix"}, {"NConsumers", "100"}, {"Frequency", "2"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  getPopulation()->TraceConnectWithoutContext("FirstInterestDataDelay",
+                                              MakeCallback(&ConsumerPopulationFixture::onData,
+                                                           this));
+
+  Simulator::Stop(Seconds(5.0));
+  Simulator::Run();
+
+  Ptr<ConsumerPopulation> population = getPopulation();
+  // 10 Interests of every consumer, the last ones may still be in flight
+  BOOST_CHECK_EQUAL(population->GetNSent(), 1000);
+  BOOST_CHECK_GE(population->GetNReceived(), 990);
+  BOOST_CHECK_EQUAL(population->GetNReceived(), received.size());
+  BOOST_CHECK_EQUAL(nRetransmitted, 0);
+  BOOST_CHECK_EQUAL(population->GetNGivenUp(), 0);
+  BOOST_CHECK_LT(population->GetRto(0), Seconds(1));
+  BOOST_CHECK_GT(population->GetRto(0), Seconds(0));
+}
+
+BOOST_AUTO_TEST_CASE(GivenUp)
+{
+  // no producer
+  addApps({
+      {"1", "ns3::ndn::ConsumerPopulation",
+          {{"Prefix", "/prefix"}, {"NConsumers", "10"}, {"Frequency", "1"}, {"MaxSeq", "1"},
+           {"MaxTransmissions", "2"}},
+          "0s", "100s"},
+    });
+
+  Simulator::Stop(Seconds(10.0));
+  Simulator::Run();
+
+  Ptr<ConsumerPopulation> population = getPopulation();
+  BOOST_CHECK_EQUAL(population->GetNSent(), 20);
+  BOOST_CHECK_EQUAL(population->GetNReceived(), 0);
+  BOOST_CHECK_EQUAL(population->GetNGivenUp(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-trace.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumerTrace, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  std::string file = "consumer-trace-test.csv";
+  {
+    std::ofstream os(file);
+    os << "time,node,name\n"
+       << "1.0,1,/prefix/a\n"
+       << "2.0,2,/prefix/b\n"
+       << "2.5,1,/prefix/c\n"
+       << "4.0,1,/other/d\n";
+  }
+
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"1", "2", "/other", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerTrace",
+          {{"TraceFile", file}, {"TimeOffset", "0.5s"}},
+          "0s", "100s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(1.2));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNInInterests(), 0);
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNInInterests(), 2);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 2);
+
+  Simulator::Stop(Seconds(2.0));
+  Simulator::Run();
+  // the Interest for /other is not answered, and is retransmitted
+  BOOST_CHECK_GE(getFace("2", "1")->getFaceStatus().getNInInterests(), 3);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 2);
+
+  Ptr<ConsumerTrace> consumer = DynamicCast<ConsumerTrace>(getNode("1")->GetApplication(0));
+  BOOST_CHECK_EQUAL(consumer->GetNRequests(), 3);
+
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
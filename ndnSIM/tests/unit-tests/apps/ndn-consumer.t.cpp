@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "apps/ndn-consumer.hpp"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerFixture()
+    : nMismatches(0)
+    , nTransmissions(0)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+  }
+
+  void
+  connect()
+  {
+    Ptr<Application> app = getNode("1")->GetApplication(0);
+    app->TraceConnectWithoutContext("InterestSent",
+                                    MakeCallback(&ConsumerFixture::interestSent, this));
+    app->TraceConnectWithoutContext("TransmittedInterests",
+                                    MakeCallback(&ConsumerFixture::transmittedInterest, this));
+  }
+
+  void
+  interestSent(Ptr<App>, const Name&, uint32_t, Time rto)
+  {
+    lastRto = rto;
+  }
+
+  void
+  transmittedInterest(shared_ptr<const Interest> interest, Ptr<App>, shared_ptr<Face>)
+  {
+    Time expected = std::max(MilliSeconds(100),
+                             std::min(Seconds(2),
+                                      Time::FromDouble(lastRto.ToDouble(Time::S) * 2, Time::S)));
+    time::milliseconds lifetime((expected.GetMicroSeconds() + 999) / 1000);
+    if (interest->getInterestLifetime() != lifetime)
+      ++nMismatches;
+    minLifetime = nTransmissions == 0 ? interest->getInterestLifetime()
+                                      : std::min(minLifetime, interest->getInterestLifetime());
+    ++nTransmissions;
+  }
+
+public:
+  Time lastRto;
+  size_t nMismatches;
+  size_t nTransmissions;
+  time::milliseconds minLifetime;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsConsumer, ConsumerFixture)
+
+BOOST_AUTO_TEST_CASE(LifeTimeFollowsRto)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTimeRtoFactor", "2"},
+           {"MinLifeTime", "100ms"}, {"LifeTime", "2s"}},
+          "0s", "5s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+  connect();
+
+  Simulator::Stop(Seconds(6));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nTransmissions, 50);
+  BOOST_CHECK_EQUAL(nMismatches, 0);
+  // the RTO comes down to MinRTO with the samples, and so does the lifetime
+  BOOST_CHECK_LT(minLifetime, time::milliseconds(2000));
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(FixedLifeTime)
+{
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTime", "2s"}},
+          "0s", "1s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+  connect();
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nTransmissions, 10);
+  BOOST_CHECK_EQUAL(minLifetime, time::milliseconds(2000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-binary-mobility-helper.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class BinaryMobilityHelperFixture : public CleanupFixture
+{
+public:
+  BinaryMobilityHelperFixture()
+    : tclFile("binary-mobility-helper-test.tcl")
+    , binaryFile("binary-mobility-helper-test.mob")
+  {
+    std::ofstream os(tclFile.c_str());
+    os << "# initial positions\n"
+       << "$node_(0) set X_ 0.0\n"
+       << "$node_(0) set Y_ 0.0\n"
+       << "$node_(0) set Z_ 0.0\n"
+       << "$node_(1) set X_ 100.0\n"
+       << "$node_(1) set Y_ 0.0\n"
+       << "$god_ set-dist 0 1 1\n"
+       << "$ns_ at 1.0 \"$node_(0) setdest 100.0 0.0 10.0\"\n"
+       << "$ns_ at 60.0 \"$node_(0) set X_ 500.0\"\n"
+       << "$ns_ at 30.0 \"$node_(1) setdest 100.0 50.0 5.0\"\n"
+       << "$ns_ at 35.0 \"$node_(1) setdest 0.0 25.0 5.0\"\n";
+  }
+
+  ~BinaryMobilityHelperFixture()
+  {
+    std::remove(tclFile.c_str());
+    std::remove(binaryFile.c_str());
+  }
+
+  void
+  savePosition(Ptr<Node> node)
+  {
+    positions.push_back(node->GetObject<MobilityModel>()->GetPosition());
+  }
+
+  void
+  checkPosition(size_t i, double x, double y)
+  {
+    BOOST_REQUIRE_LT(i, positions.size());
+    BOOST_CHECK_SMALL(positions[i].x - x, 1e-6);
+    BOOST_CHECK_SMALL(positions[i].y - y, 1e-6);
+  }
+
+public:
+  std::string tclFile;
+  std::string binaryFile;
+  std::vector<Vector> positions;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnBinaryMobilityHelper, BinaryMobilityHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  BinaryMobilityHelper::Convert(tclFile, binaryFile);
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  BinaryMobilityHelper mobility(binaryFile);
+  BOOST_CHECK_EQUAL(mobility.GetNNodes(), 2);
+  mobility.SetWindow(Seconds(5));
+  mobility.Install(nodes);
+
+  Ptr<Node> node0 = nodes.Get(0), node1 = nodes.Get(1);
+  savePosition(node1);
+  for (double t : {6.0, 20.0, 70.0}) {
+    Simulator::Schedule(Seconds(t), &BinaryMobilityHelperFixture::savePosition, this, node0);
+  }
+  for (double t : {32.0, 45.0, 70.0}) {
+    Simulator::Schedule(Seconds(t), &BinaryMobilityHelperFixture::savePosition, this, node1);
+  }
+
+  Simulator::Stop(Seconds(100));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(positions.size(), 7);
+  checkPosition(0, 100, 0); // initial position
+  checkPosition(1, 50, 0);  // node 0 moving
+  checkPosition(2, 100, 0); // arrived
+  checkPosition(3, 100, 10); // node 1 moving
+  checkPosition(4, 50, 25); // turned at 35 s
+  checkPosition(5, 500, 0); // node 0 moved by set X_
+  checkPosition(6, 0, 25);  // node 1 arrived
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  BOOST_CHECK_THROW(BinaryMobilityHelper::Convert("no-such-file.tcl", binaryFile),
+                    std::runtime_error);
+  BOOST_CHECK_THROW(BinaryMobilityHelper mobility("no-such-file.mob"), std::runtime_error);
+  BOOST_CHECK_THROW(BinaryMobilityHelper mobility(tclFile), std::runtime_error);
+
+  std::ofstream(tclFile.c_str()) << "$ns_ at 1.0 \"$node_(0) setdest 1.0 abc 1.0\"\n";
+  BOOST_CHECK_THROW(BinaryMobilityHelper::Convert(tclFile, binaryFile), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "helper/ndn-checkpoint-helper.hpp"
+#include "apps/ndn-consumer.hpp"
+#include "utils/ndn-checkpoint-stream.hpp"
+#include "NFD/daemon/fw/strategy-info.hpp"
+
+#include "ns3/simulator.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class CheckpointTestInfo : public nfd::fw::StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 9000;
+  }
+
+public:
+  uint32_t value = 0;
+};
+
+class CheckpointHelperFixture : public CleanupFixture
+{
+public:
+  CheckpointHelperFixture()
+    : file("checkpoint-helper-test.ckpt")
+  {
+    CheckpointHelper::RegisterMeasurementsInfo<CheckpointTestInfo>(
+      [] (const CheckpointTestInfo& info, std::ostream& os) {
+        checkpoint::write<uint32_t>(os, info.value);
+      },
+      [] (CheckpointTestInfo& info, std::istream& is) {
+        info.value = checkpoint::read<uint32_t>(is);
+      });
+  }
+
+  ~CheckpointHelperFixture()
+  {
+    std::remove(file.c_str());
+  }
+
+  void
+  createScenario(ScenarioHelper& scenario, const std::string& consumerStart,
+                 const std::string& consumerStop)
+  {
+    scenario.createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    scenario.addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            consumerStart, consumerStop},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  Ptr<RttEstimator>
+  getRttEstimator(ScenarioHelper& scenario)
+  {
+    return DynamicCast<Consumer>(scenario.getNode("1")->GetApplication(0))->GetRttEstimator();
+  }
+
+public:
+  std::string file;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnCheckpointHelper, CheckpointHelperFixture)
+
+BOOST_AUTO_TEST_CASE(SaveAndLoad)
+{
+  size_t csSize = 0;
+  Time estimate;
+  {
+    ScenarioHelper warmUp;
+    createScenario(warmUp, "0s", "4.45s");
+    warmUp.addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    nfd::Forwarder& forwarder = *warmUp.getNode("2")->GetObject<L3Protocol>()->getForwarder();
+    shared_ptr<nfd::measurements::Entry> entry = forwarder.getMeasurements().get("/prefix");
+    forwarder.getMeasurements().extendLifetime(*entry, time::seconds(60));
+    entry->getOrCreateStrategyInfo<CheckpointTestInfo>()->value = 42;
+
+    CheckpointHelper::ScheduleSave(Seconds(5), file);
+    Simulator::Stop(Seconds(5.001));
+    Simulator::Run();
+
+    csSize = forwarder.getCs().size();
+    estimate = getRttEstimator(warmUp)->GetCurrentEstimate();
+    BOOST_CHECK_EQUAL(csSize, 45);
+
+    Simulator::Destroy();
+    Names::Clear();
+    GlobalRouter::clear();
+  }
+
+  // same scenario without routes, consumer requests the cached Data again
+  ScenarioHelper restored;
+  createScenario(restored, "1s", "1.95s");
+  CheckpointHelper::Load(file);
+
+  nfd::Forwarder& forwarder = *restored.getNode("2")->GetObject<L3Protocol>()->getForwarder();
+  BOOST_CHECK_EQUAL(forwarder.getCs().size(), csSize);
+  BOOST_CHECK_EQUAL(getRttEstimator(restored)->GetCurrentEstimate(), estimate);
+
+  shared_ptr<nfd::fib::Entry> fibEntry = forwarder.getFib().findExactMatch("/prefix");
+  BOOST_REQUIRE(fibEntry != nullptr);
+  BOOST_CHECK(fibEntry->hasNextHop(restored.getFace("2", "3")));
+
+  shared_ptr<nfd::measurements::Entry> entry = forwarder.getMeasurements().findExactMatch("/prefix");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE(entry->getStrategyInfo<CheckpointTestInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(entry->getStrategyInfo<CheckpointTestInfo>()->value, 42);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  // all 10 Interests are satisfied from the restored cache of node 1
+  BOOST_CHECK_EQUAL(restored.getFace("1", "2")->getFaceStatus().getNOutInterests(), 0);
+  BOOST_CHECK_EQUAL(restored.getFace("2", "3")->getFaceStatus().getNOutInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NotACheckpoint)
+{
+  {
+    std::ofstream os(file.c_str());
+    os << "not a checkpoint";
+  }
+  BOOST_CHECK_THROW(CheckpointHelper::Load(file), std::runtime_error);
+  BOOST_CHECK_THROW(CheckpointHelper::Load("nonexistent.ckpt"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-failure-injection-helper.hpp"
+#include "model/ndn-net-device-face.hpp"
+
+#include "ns3/constant-position-mobility-model.h"
+
+#include "NFD/core/scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+class FailureInjectionFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  FailureInjectionFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  bool
+  isLinkDown(const std::string& node1, const std::string& node2)
+  {
+    return std::static_pointer_cast<NetDeviceFace>(getFace(node1, node2))->isLinkDown();
+  }
+
+public:
+  FailureInjectionHelper failures;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnFailureInjectionHelper, FailureInjectionFixture)
+
+BOOST_AUTO_TEST_CASE(FailAndRecover)
+{
+  BOOST_CHECK_EQUAL(failures.AddPointToPointLinks(), 2);
+  BOOST_CHECK_EQUAL(failures.AddPointToPointLinks(), 0);
+  BOOST_CHECK_EQUAL(failures.GetNLinks(), 2);
+  BOOST_CHECK_THROW(failures.FindLink(getNode("1"), getNode("3")), std::invalid_argument);
+
+  size_t link = failures.FindLink(getNode("3"), getNode("2"));
+  BOOST_CHECK_EQUAL(link, failures.FindLink(getNode("2"), getNode("3")));
+
+  std::vector<size_t> changes;
+  failures.SetRerouteCallback([&] (const std::vector<size_t>& failed,
+                                   const std::vector<size_t>& recovered) {
+      changes.push_back(failed.size() * 10 + recovered.size());
+    });
+
+  failures.Fail(link, Seconds(5.1));
+  failures.Fail(link, Seconds(7.1)); // nested failure
+  failures.Recover(link, Seconds(8.1));
+  failures.Recover(link, Seconds(10.1));
+
+  nfd::scheduler::schedule(time::milliseconds(5200), [&] {
+      BOOST_CHECK(failures.IsDown(link));
+      BOOST_CHECK(isLinkDown("2", "3") && isLinkDown("3", "2"));
+      BOOST_CHECK(!isLinkDown("1", "2"));
+      BOOST_CHECK_EQUAL(getFace("3", "2")->getFaceStatus().getNInInterests(), 6);
+    });
+
+  nfd::scheduler::schedule(time::milliseconds(9200), [&] {
+      BOOST_CHECK(failures.IsDown(link));
+      BOOST_CHECK_EQUAL(getFace("3", "2")->getFaceStatus().getNInInterests(), 6);
+    });
+
+  nfd::scheduler::schedule(time::milliseconds(15100), [&] {
+      BOOST_CHECK(!failures.IsDown(link));
+      BOOST_CHECK(!isLinkDown("2", "3"));
+      BOOST_CHECK_GE(getFace("3", "2")->getFaceStatus().getNInInterests(), 11);
+    });
+
+  Simulator::Stop(Seconds(15.2));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(failures.GetNChanges(), 2);
+  BOOST_CHECK_EQUAL(failures.GetNDown(), 0);
+  BOOST_CHECK_EQUAL(changes.size(), 2);
+  BOOST_CHECK_EQUAL(changes[0], 10);
+  BOOST_CHECK_EQUAL(changes[1], 1);
+}
+
+BOOST_AUTO_TEST_CASE(Regional)
+{
+  failures.AddPointToPointLinks();
+
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+  mobility->SetPosition(Vector(100, 0, 0));
+  getNode("1")->AggregateObject(mobility);
+
+  failures.ScheduleRegional(Seconds(1), Vector(0, 0, 0), 50, Seconds(1));
+  failures.ScheduleRegional(Seconds(3), Vector(90, 0, 0), 50, Seconds(1));
+
+  nfd::scheduler::schedule(time::milliseconds(1500), [&] {
+      BOOST_CHECK_EQUAL(failures.GetNDown(), 0);
+    });
+  nfd::scheduler::schedule(time::milliseconds(3500), [&] {
+      BOOST_CHECK_EQUAL(failures.GetNDown(), 1);
+      BOOST_CHECK(isLinkDown("1", "2"));
+      BOOST_CHECK(!isLinkDown("2", "3"));
+    });
+
+  Simulator::Stop(Seconds(4.5));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(failures.GetNDown(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Random)
+{
+  failures.AddPointToPointLinks();
+  failures.AssignStreams(1);
+  failures.ScheduleRandom(Seconds(0), Seconds(50), Seconds(5), Seconds(1));
+
+  size_t maxDown = 0;
+  failures.SetRerouteCallback([&] (const std::vector<size_t>&, const std::vector<size_t>&) {
+      maxDown = std::max(maxDown, failures.GetNDown());
+    });
+
+  Simulator::Stop(Seconds(100));
+  Simulator::Run();
+
+  BOOST_CHECK_GT(failures.GetNChanges(), 4);
+  BOOST_CHECK_EQUAL(failures.GetNChanges() % 2, 0);
+  BOOST_CHECK_GT(maxDown, 0);
+  BOOST_CHECK_EQUAL(failures.GetNDown(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Trace)
+{
+  failures.AddPointToPointLinks();
+
+  std::string file = "failure-injection-trace.txt";
+  {
+    std::ofstream os(file);
+    os << "# time action nodes\n"
+       << "\n"
+       << "1.0 down 1 2\n"
+       << "2.0 up 2 1\n";
+  }
+  failures.ScheduleTrace(file);
+
+  nfd::scheduler::schedule(time::milliseconds(1500), [&] {
+      BOOST_CHECK(isLinkDown("1", "2"));
+    });
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  BOOST_CHECK(!isLinkDown("1", "2"));
+
+  {
+    std::ofstream os(file);
+    os << "1.0 down 1 3\n";
+  }
+  BOOST_CHECK_THROW(failures.ScheduleTrace(file), std::invalid_argument);
+  {
+    std::ofstream os(file);
+    os << "1.0 sideways 1 2\n";
+  }
+  BOOST_CHECK_THROW(failures.ScheduleTrace(file), std::runtime_error);
+  std::remove(file.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,8 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +99,23 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  FibHelper::AddRoutes({
+      {getNode("1"), "/prefix", getFace("1", "2"), 10},
+      {getNode("1"), "/other", getFace("1", "2"), 20},
+      {getNode("2"), "/other", getFace("2", "1"), 1}
+    });
+
+  const nfd::Fib& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+  shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch("/other");
+  BOOST_REQUIRE(entry != nullptr);
+  BOOST_REQUIRE_EQUAL(entry->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(entry->getNextHops().front().getCost(), 20);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
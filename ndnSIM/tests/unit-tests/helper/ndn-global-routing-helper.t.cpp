@@ -18,6 +18,7 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -146,6 +147,121 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(SpatialAggregation)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    1 1ms 100\n"
+        << "A3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/S/city/north/A/app1", Names::Find<Node>("B3"));
+  ndnGlobalRoutingHelper.AddOrigins("/S/city/north/street/A/app2", Names::Find<Node>("B3"));
+  ndnGlobalRoutingHelper.AddOrigins("/S/city/south/A/app1", Names::Find<Node>("C3"));
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+
+  ndn::GlobalRoutingHelper::SetSpatialAggregation(true);
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  ndn::GlobalRoutingHelper::SetSpatialAggregation(false);
+
+  // siblings behind B3 collapse, /S/city diverges
+  const nfd::Fib& fibA = Names::Find<Node>("A3")->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fibA.findExactMatch("/S/city/north") != nullptr);
+  BOOST_CHECK(fibA.findExactMatch("/S/city/south") != nullptr);
+  BOOST_CHECK(fibA.findExactMatch("/prefix") != nullptr);
+  BOOST_CHECK(fibA.findExactMatch("/S/city") == nullptr);
+  BOOST_CHECK(fibA.findExactMatch("/S/city/north/A/app1") == nullptr);
+  BOOST_CHECK(fibA.findExactMatch("/S/city/north/street/A/app2") == nullptr);
+
+  // own prefixes of a node keep its parents expanded
+  const nfd::Fib& fibC = Names::Find<Node>("C3")->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fibC.findExactMatch("/S/city/north") != nullptr);
+  BOOST_CHECK(fibC.findExactMatch("/S/city") == nullptr);
+  BOOST_CHECK(fibC.findExactMatch("/S") == nullptr);
+
+  const nfd::Fib& fibB = Names::Find<Node>("B3")->GetObject<ndn::L3Protocol>()->getForwarder()->getFib();
+  BOOST_CHECK(fibB.findExactMatch("/S/city/south") != nullptr);
+  BOOST_CHECK(fibB.findExactMatch("/S/city") == nullptr);
+  BOOST_CHECK(fibB.findExactMatch("/S") == nullptr);
+}
+
+class IncrementalRoutingFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  IncrementalRoutingFixture()
+  {
+    createTopology({
+        {"A", "B", "C"}
+      });
+    getFace("A", "C")->setMetric(10);
+    getFace("C", "A")->setMetric(10);
+
+    GlobalRoutingHelper::SetNThreads(4);
+    GlobalRoutingHelper::SetIncrementalRouting(true);
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    routingHelper.AddOrigins("/prefix", getNode("C"));
+    GlobalRoutingHelper::CalculateRoutes();
+  }
+
+  ~IncrementalRoutingFixture()
+  {
+    GlobalRoutingHelper::SetIncrementalRouting(false);
+    GlobalRoutingHelper::SetNThreads(0);
+  }
+
+  std::set<shared_ptr<Face>>
+  getNextHops(const std::string& node)
+  {
+    std::set<shared_ptr<Face>> nexthops;
+    const nfd::Fib& fib = getNode(node)->GetObject<L3Protocol>()->getForwarder()->getFib();
+    shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch("/prefix");
+    if (entry != nullptr) {
+      for (const auto& nexthop : entry->getNextHops()) {
+        nexthops.insert(nexthop.getFace());
+      }
+    }
+    return nexthops;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(IncrementalRouting, IncrementalRoutingFixture)
+{
+  BOOST_CHECK(getNextHops("A") == std::set<shared_ptr<Face>>{getFace("A", "B")});
+  BOOST_CHECK(getNextHops("B") == std::set<shared_ptr<Face>>{getFace("B", "C")});
+
+  LinkControlHelper::FailLink(getNode("B"), getNode("C"));
+  BOOST_CHECK(getNextHops("A") == std::set<shared_ptr<Face>>{getFace("A", "C")});
+  BOOST_CHECK(getNextHops("B") == std::set<shared_ptr<Face>>{getFace("B", "A")});
+
+  // failed links are excluded from a full calculation as well
+  GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(getNextHops("B") == std::set<shared_ptr<Face>>{getFace("B", "A")});
+
+  LinkControlHelper::UpLink(getNode("B"), getNode("C"));
+  BOOST_CHECK(getNextHops("A") == std::set<shared_ptr<Face>>{getFace("A", "B")});
+  BOOST_CHECK(getNextHops("B") == std::set<shared_ptr<Face>>{getFace("B", "C")});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "helper/ndn-scenario-description.hpp"
+#include "helper/ndn-parameter-sweep.hpp"
+#include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const std::string SCENARIO = R"INFO(
+parameters
+{
+  frequency 10
+  strategy /localhost/nfd/strategy/best-route
+}
+
+sweep
+{
+  frequency "10 20"
+  strategy "/localhost/nfd/strategy/best-route /localhost/nfd/strategy/multicast"
+}
+
+stop 2s
+
+topology
+{
+  link "1 2"
+  link "2 3"
+}
+
+strategies
+{
+  strategy "/prefix ${strategy}"
+}
+
+routes
+{
+  route "1 2 /prefix 1"
+  route "2 3 /prefix 1"
+}
+
+apps
+{
+  app
+  {
+    node 1
+    type ns3::ndn::ConsumerCbr
+    start 0s
+    stop 0.999s
+    Prefix /prefix
+    Frequency ${frequency}
+  }
+  app
+  {
+    node 3
+    type ns3::ndn::Producer
+    Prefix /prefix
+    PayloadSize 1024
+  }
+}
+
+tracers
+{
+  l3-rate "rate-trace.txt 0.5s"
+  app-delay app-delays-trace.txt
+}
+)INFO";
+
+class ScenarioDescriptionFixture : public CleanupFixture
+{
+public:
+  ScenarioDescription
+  parse(const std::string& text)
+  {
+    std::istringstream is(text);
+    return ScenarioDescription(is, "test");
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnScenarioDescription, ScenarioDescriptionFixture)
+
+BOOST_AUTO_TEST_CASE(Sweep)
+{
+  ScenarioDescription scenario = parse(SCENARIO);
+  BOOST_CHECK_EQUAL(scenario.getDefaultParameters().at("frequency"), "10");
+
+  std::vector<ScenarioDescription::Parameters> configurations = scenario.expandSweep();
+  BOOST_REQUIRE_EQUAL(configurations.size(), 4);
+  BOOST_CHECK_EQUAL(configurations[0].at("frequency"), "10");
+  BOOST_CHECK_EQUAL(configurations[0].at("strategy"), "/localhost/nfd/strategy/best-route");
+  BOOST_CHECK_EQUAL(configurations[1].at("frequency"), "10");
+  BOOST_CHECK_EQUAL(configurations[1].at("strategy"), "/localhost/nfd/strategy/multicast");
+  BOOST_CHECK_EQUAL(configurations[3].at("frequency"), "20");
+
+  BOOST_CHECK_EQUAL(parse("topology { link \"1 2\" }").expandSweep().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(parse("topology {"), ScenarioDescription::Error);
+  BOOST_CHECK_THROW(parse("stop 1s"), ScenarioDescription::Error);
+  BOOST_CHECK_THROW(parse("topology { link \"1 2\" }\nunknown 1"), ScenarioDescription::Error);
+
+  ScenarioHelper helper;
+  BOOST_CHECK_THROW(parse("topology { link \"1 ${missing}\" }").install(helper, {}, ""),
+                    ScenarioDescription::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Install)
+{
+  ScenarioHelper helper;
+  Time stop = parse(SCENARIO).install(helper, {{"frequency", "20"}}, "");
+  BOOST_CHECK_EQUAL(stop, Seconds(2));
+
+  Simulator::Stop(stop);
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(helper.getFace("1", "2")->getFaceStatus().getNOutInterests(), 20);
+  BOOST_CHECK_EQUAL(helper.getFace("3", "2")->getFaceStatus().getNOutDatas(), 20);
+
+  L3RateTracer::Destroy();
+  AppDelayTracer::Destroy();
+  boost::filesystem::remove("rate-trace.txt");
+  boost::filesystem::remove("app-delays-trace.txt");
+}
+
+BOOST_AUTO_TEST_CASE(ParallelSweep)
+{
+  std::string outputDir = "parameter-sweep-test";
+  ScenarioDescription scenario = parse(SCENARIO);
+  ParameterSweep sweep(scenario);
+  sweep.setNProcesses(2);
+  BOOST_CHECK_EQUAL(sweep.getNProcesses(), 2);
+
+  BOOST_CHECK_EQUAL(sweep.run(outputDir), 0);
+  for (int i = 0; i < 4; ++i) {
+    boost::filesystem::path dir = boost::filesystem::path(outputDir) / std::to_string(i);
+    BOOST_CHECK(boost::filesystem::exists(dir / "parameters.txt"));
+    BOOST_CHECK(boost::filesystem::file_size(dir / "rate-trace.txt") > 0);
+    BOOST_CHECK(boost::filesystem::file_size(dir / "app-delays-trace.txt") > 0);
+  }
+
+  std::ifstream is((boost::filesystem::path(outputDir) / "sweep.txt").string().c_str());
+  std::string line;
+  std::getline(is, line);
+  BOOST_CHECK_EQUAL(line, "Configuration\tfrequency\tstrategy\tStatus");
+  std::getline(is, line);
+  BOOST_CHECK_EQUAL(line, "0\t10\t/localhost/nfd/strategy/best-route\t0");
+
+  boost::filesystem::remove_all(outputDir);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/core/scheduler.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnStackHelper, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(InstallLazily)
+{
+  NodeContainer nodes;
+  nodes.Create(3);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    (*node)->AggregateObject(CreateObject<ConstantVelocityMobilityModel>());
+  }
+  Ptr<Node> consumer = nodes.Get(0), vehicle = nodes.Get(1), parked = nodes.Get(2);
+  Ptr<Node> static_ = CreateObject<Node>(); // no MobilityModel
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallLazily(nodes);
+  ndnHelper.InstallLazily(NodeContainer(static_));
+  BOOST_CHECK_EQUAL(ndnHelper.GetNInactiveNodes(), 3);
+  BOOST_CHECK(static_->GetObject<L3Protocol>() != 0);
+  BOOST_CHECK(consumer->GetObject<L3Protocol>() == 0);
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.Install(consumer);
+
+  // a course change that does not move the node keeps it inactive
+  vehicle->GetObject<ConstantVelocityMobilityModel>()->SetPosition(Vector(0, 0, 0));
+  Simulator::Schedule(Seconds(5), &ConstantVelocityMobilityModel::SetVelocity,
+                      vehicle->GetObject<ConstantVelocityMobilityModel>(), Vector(10, 0, 0));
+
+  nfd::scheduler::schedule(time::seconds(1), [&] {
+      BOOST_CHECK(consumer->GetObject<L3Protocol>() != 0);
+      BOOST_CHECK(vehicle->GetObject<L3Protocol>() == 0);
+      BOOST_CHECK_EQUAL(ndnHelper.GetNInactiveNodes(), 2);
+    });
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK(vehicle->GetObject<L3Protocol>() != 0);
+  BOOST_CHECK(parked->GetObject<L3Protocol>() == 0);
+  BOOST_CHECK_EQUAL(ndnHelper.GetNInactiveNodes(), 1);
+}
+
+class LeanModeFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  LeanModeFixture()
+  {
+    setLeanMode();
+    createTopology({
+        {"1", "2"}
+      });
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(LeanMode, LeanModeFixture)
+{
+  Ptr<L3Protocol> ndn = getNode("1")->GetObject<L3Protocol>();
+  BOOST_CHECK(ndn->getFibManager() == nullptr);
+  BOOST_CHECK(ndn->getStrategyChoiceManager() == nullptr);
+  BOOST_CHECK(ndn->getFaceById(nfd::FACEID_INTERNAL_FACE) == nullptr);
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+      {"1", "2", "/other", 1}
+    });
+  FibHelper::RemoveRoute(getNode("1"), "/other", getFace("1", "2"));
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/prefix") != nullptr);
+  BOOST_CHECK(ndn->getForwarder()->getFib().findExactMatch("/other") == nullptr);
+
+  StrategyChoiceHelper::Install(getNode("1"), "/prefix", "/localhost/nfd/strategy/broadcast");
+  BOOST_CHECK_EQUAL(ndn->getForwarder()->getStrategyChoice().findEffectiveStrategy("/prefix")
+                      .getName().getPrefix(-1),
+                    "/localhost/nfd/strategy/broadcast");
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 10);
+}
+
+class PrototypeModeFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  PrototypeModeFixture()
+  {
+    getStackHelper().SetPrototypeMode();
+    getStackHelper().SetDefaultRoutes(true);
+    getStackHelper().setCsSize(10);
+    getStackHelper().setCsPolicy("lru");
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(PrototypeMode, PrototypeModeFixture)
+{
+  for (const std::string& name : {"1", "2", "3"}) {
+    nfd::Forwarder& forwarder = *getNode(name)->GetObject<L3Protocol>()->getForwarder();
+    BOOST_CHECK_EQUAL(forwarder.getCs().getLimit(), 10);
+    BOOST_CHECK_EQUAL(forwarder.getCs().getPolicy()->getName(), "lru");
+
+    nfd::StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+    BOOST_CHECK_EQUAL(strategyChoice.findEffectiveStrategy("/prefix").getName().getPrefix(-1),
+                      "/localhost/nfd/strategy/best-route");
+    BOOST_CHECK_EQUAL(strategyChoice.findEffectiveStrategy("/localhost").getName().getPrefix(-1),
+                      "/localhost/nfd/strategy/multicast");
+    // instantiated on first use
+    BOOST_CHECK(strategyChoice.hasStrategy("/localhost/nfd/strategy/ncc"));
+
+    shared_ptr<nfd::fib::Entry> route = forwarder.getFib().findExactMatch("/");
+    BOOST_REQUIRE(route != nullptr);
+    BOOST_CHECK_EQUAL(route->getNextHops().size(), name == "2" ? 2 : 1);
+  }
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "9.99s"},
+      {"3", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
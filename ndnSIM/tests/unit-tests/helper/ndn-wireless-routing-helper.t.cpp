@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "helper/ndn-wireless-routing-helper.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/constant-position-mobility-model.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class WirelessRoutingHelperFixture : public CleanupFixture
+{
+public:
+  WirelessRoutingHelperFixture()
+  {
+    // a line of nodes 80 meters apart on one shared channel
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    nodes.Create(4);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+      device->SetAddress(Mac48Address::Allocate());
+      device->SetChannel(channel);
+      nodes.Get(i)->AddDevice(device);
+
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+      mobility->SetPosition(Vector(80 * i, 0, 0));
+      nodes.Get(i)->AggregateObject(mobility);
+    }
+
+    StackHelper ndnHelper;
+    ndnHelper.Install(nodes);
+  }
+
+  /**
+   * @return cost of the route to /prefix, -1 if there is none
+   */
+  int
+  getCost(uint32_t node)
+  {
+    const nfd::Fib& fib = nodes.Get(node)->GetObject<L3Protocol>()->getForwarder()->getFib();
+    shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch("/prefix");
+    if (entry == nullptr || entry->getNextHops().empty())
+      return -1;
+    return entry->getNextHops().front().getCost();
+  }
+
+  void
+  run()
+  {
+    Simulator::Stop(Seconds(0.5));
+    Simulator::Run();
+  }
+
+public:
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnWirelessRoutingHelper, WirelessRoutingHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Routes)
+{
+  WirelessRoutingHelper routing(100);
+  routing.SetUpdateInterval(Seconds(0));
+  routing.Install(nodes);
+  routing.AddOrigin("/prefix", nodes.Get(3));
+  routing.CalculateRoutes();
+
+  BOOST_CHECK_EQUAL(getCost(0), 3);
+  BOOST_CHECK_EQUAL(getCost(1), 2);
+  BOOST_CHECK_EQUAL(getCost(2), 1);
+  BOOST_CHECK_EQUAL(getCost(3), -1);
+  BOOST_CHECK_EQUAL(routing.GetNRouteChanges(), 3);
+  BOOST_CHECK_EQUAL(routing.GetNTreeComputations(), 1);
+
+  // node 1 leaves, node 0 is partitioned from the origin
+  nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(80, 500, 0));
+  run();
+  BOOST_CHECK_EQUAL(getCost(0), -1);
+  BOOST_CHECK_EQUAL(getCost(1), -1);
+  BOOST_CHECK_EQUAL(getCost(2), 1);
+  BOOST_CHECK_EQUAL(routing.GetNLinkChanges(), 2);
+  BOOST_CHECK_EQUAL(routing.GetNTreeComputations(), 2);
+
+  // a link with no effect on the tree does not cause a computation
+  nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(80, 600, 0));
+  nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(80, 520, 0));
+  run();
+  BOOST_CHECK_EQUAL(routing.GetNLinkChanges(), 3);
+  BOOST_CHECK_EQUAL(routing.GetNTreeComputations(), 2);
+
+  // node 0 comes next to the origin
+  nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(300, 0, 0));
+  run();
+  BOOST_CHECK_EQUAL(getCost(0), 1);
+  BOOST_CHECK_EQUAL(getCost(2), 1);
+  BOOST_CHECK_EQUAL(routing.GetNTreeComputations(), 3);
+
+  BOOST_CHECK_THROW(routing.AddOrigin("/other", CreateObject<Node>()), std::invalid_argument);
+  BOOST_CHECK_THROW(WirelessRoutingHelper(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
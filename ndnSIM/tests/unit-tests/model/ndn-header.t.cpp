@@ -47,6 +47,94 @@ BOOST_AUTO_TEST_CASE(TypeId)
  BOOST_CHECK_EQUAL(dataPktHeader.GetSerializedSize(), 1354); // 328 + 1024
 }
 
+BOOST_AUTO_TEST_CASE(SerializeDeserialize)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix/interest");
+  interest->setNonce(42);
+
+  auto data = make_shared<ndn::Data>("/prefix/data");
+  data->setContent(std::make_shared< ::ndn::Buffer>(1024)); // TLV-LENGTH of 3 octets
+  ndn::StackHelper::getKeyChain().sign(*data);
+
+  Ptr<Packet> interestPacket = Create<Packet>();
+  interestPacket->AddHeader(PacketHeader<Interest>(*interest));
+  Ptr<Packet> dataPacket = Create<Packet>();
+  dataPacket->AddHeader(PacketHeader<Data>(*data));
+
+  PacketHeader<Interest> interestHeader;
+  BOOST_CHECK_EQUAL(interestPacket->RemoveHeader(interestHeader), interest->wireEncode().size());
+  BOOST_CHECK_EQUAL(interestHeader.getPacket()->wireEncode(), interest->wireEncode());
+  BOOST_CHECK_EQUAL(interestPacket->GetSize(), 0);
+
+  PacketHeader<Data> dataHeader;
+  BOOST_CHECK_EQUAL(dataPacket->RemoveHeader(dataHeader), data->wireEncode().size());
+  BOOST_CHECK_EQUAL(dataHeader.getPacket()->wireEncode(), data->wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(Nack)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix/interest");
+  interest->setNonce(42);
+  lp::Nack nack(*interest);
+  nack.setReason(lp::NackReason::NO_ROUTE);
+
+  PacketHeader<lp::Nack> header(nack);
+  BOOST_CHECK_EQUAL(header.GetTypeId().GetName().c_str(), "ns3::ndn::Nack");
+
+  Ptr<Packet> packet = Convert::ToPacket(nack);
+  BOOST_CHECK_EQUAL(Convert::getPacketType(packet), lp::tlv::LpPacket);
+
+  shared_ptr<const lp::Nack> received = Convert::FromPacket<lp::Nack>(packet);
+  BOOST_CHECK_EQUAL(received->getReason(), lp::NackReason::NO_ROUTE);
+  BOOST_CHECK_EQUAL(received->getInterest().wireEncode(), interest->wireEncode());
+  BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+
+  // an Interest is not a Nack
+  Ptr<Packet> interestPacket = Convert::ToPacket(*interest);
+  PacketHeader<lp::Nack> notNack;
+  BOOST_CHECK_THROW(interestPacket->PeekHeader(notNack), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(EncodedOnce)
+{
+  auto data = make_shared<ndn::Data>("/prefix/data");
+  data->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  data->setFreshnessPeriod(ndn::time::milliseconds(1000)); // resets the wire encoding
+
+  uint64_t nEncodings = PacketHeader<Data>::GetNEncodings();
+  PacketHeader<Data> header(*data);
+  BOOST_CHECK_EQUAL(PacketHeader<Data>::GetNEncodings(), nEncodings + 1);
+
+  // ns-3 asks for size and serialization of every header added
+  for (int i = 0; i < 3; ++i) {
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(header);
+    BOOST_CHECK_EQUAL(header.GetSerializedSize(), data->wireEncode().size());
+  }
+  BOOST_CHECK_EQUAL(PacketHeader<Data>::GetNEncodings(), nEncodings + 1);
+
+  // the packet is encoded already
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+  BOOST_CHECK_EQUAL(PacketHeader<Data>::GetNEncodings(), nEncodings + 1);
+
+  PacketHeader<Data> received;
+  packet->RemoveHeader(received);
+  BOOST_CHECK_EQUAL(PacketHeader<Data>::GetNEncodings(), nEncodings + 1);
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTruncated)
+{
+  auto data = make_shared<ndn::Data>("/prefix/data");
+  data->setContent(std::make_shared< ::ndn::Buffer>(100));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  const Block& wire = data->wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 10);
+  PacketHeader<Data> header;
+  BOOST_CHECK_THROW(packet->PeekHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
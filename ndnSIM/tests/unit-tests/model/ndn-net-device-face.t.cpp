@@ -19,6 +19,7 @@
 
 
 #include "model/ndn-net-device-face.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -58,6 +59,277 @@ BOOST_AUTO_TEST_CASE(Basic)
 
   BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNInInterests(), 100);
   BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
+
+  auto face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+  BOOST_CHECK_EQUAL(face->getNDroppedUnsolicitedData(), 0);
+  BOOST_CHECK_EQUAL(face->getNDroppedNonNdn(), 0);
+  BOOST_CHECK_EQUAL(face->getNDroppedMalformed(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(UnsolicitedDataDropped)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // Interests expire before Data comes back
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTime", "5ms"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  auto face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+  BOOST_CHECK_GE(face->getNDroppedUnsolicitedData(), 100);
+  BOOST_CHECK_EQUAL(face->getFaceStatus().getNInDatas(), 0);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(),
+                    face->getNDroppedUnsolicitedData());
+}
+
+BOOST_AUTO_TEST_CASE(Overhearing)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  auto face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+  face->setOverhearing(true);
+
+  shared_ptr<nfd::Forwarder> forwarder = getNode("1")->GetObject<L3Protocol>()->getForwarder();
+  forwarder->setOverheardDataLifetime(time::seconds(100));
+  size_t nAdmissions = 0;
+  forwarder->setOverheardDataAdmission([&] (const nfd::Face& inFace, const Data& data) {
+      BOOST_CHECK_EQUAL(inFace.getId(), face->getId());
+      return ++nAdmissions % 2 == 0;
+    });
+
+  // Interests expire before Data comes back
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}, {"LifeTime", "5ms"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(face->getNDroppedUnsolicitedData(), 0);
+  BOOST_CHECK_GE(face->getNOverheardData(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), face->getNOverheardData());
+  BOOST_CHECK_EQUAL(nAdmissions, face->getNOverheardData());
+  BOOST_CHECK_EQUAL(forwarder->getCs().size(), nAdmissions / 2);
+
+  BOOST_CHECK(forwarder->hasOverheardData("/prefix"));
+  BOOST_CHECK(!forwarder->hasOverheardData("/other"));
+}
+
+BOOST_AUTO_TEST_CASE(Aggregation)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // small Data are aggregated too
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "100"}},
+          "0s", "0.995s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "10"}},
+          "0s", "100s"}
+    });
+
+  auto consumerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  auto producerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("2", "1"));
+  BOOST_REQUIRE(consumerFace != nullptr && producerFace != nullptr);
+  consumerFace->setAggregation(true, MilliSeconds(50));
+  producerFace->setAggregation(true, MilliSeconds(50));
+
+  Simulator::Stop(Seconds(2.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(consumerFace->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNInInterests(), 100);
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNOutDatas(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getFaceStatus().getNInDatas(), 100);
+
+  BOOST_CHECK_GT(consumerFace->getNAggregatedFrames(), 0);
+  BOOST_CHECK_LT(consumerFace->getNAggregatedFrames(), 50);
+  BOOST_CHECK_GT(producerFace->getNAggregatedPackets(), 0);
+  BOOST_CHECK_EQUAL(consumerFace->getNDroppedMalformed(), 0);
+  BOOST_CHECK_EQUAL(producerFace->getNDroppedMalformed(), 0);
+}
+
+static uint32_t g_maxShapingQueueLength = 0;
+
+static void
+recordShapingQueueLength(uint32_t length)
+{
+  g_maxShapingQueueLength = std::max(g_maxShapingQueueLength, length);
+}
+
+BOOST_AUTO_TEST_CASE(InterestShaping)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // ten times more Interests than the Data that fit into the shaping rate
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1000"}},
+          "0s", "0.9995s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  auto face = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(face != nullptr);
+  face->setInterestShaping(DataRate("800kbps"), 64);
+
+  g_maxShapingQueueLength = 0;
+  face->InterestShapingQueueLength.ConnectWithoutContext(MakeCallback(&recordShapingQueueLength));
+
+  Simulator::Stop(Seconds(3.001));
+  Simulator::Run();
+
+  // 100 kB/s of Data of more than 1 kB each, for one second and until the queue drained
+  uint64_t nOutInterests = face->getFaceStatus().getNOutInterests();
+  BOOST_CHECK_GE(nOutInterests, 120);
+  BOOST_CHECK_LE(nOutInterests, 200);
+  BOOST_CHECK_EQUAL(face->getFaceStatus().getNInDatas(), nOutInterests);
+  BOOST_CHECK_GT(face->getAverageDataSize(), 1024);
+
+  BOOST_CHECK_EQUAL(g_maxShapingQueueLength, 64);
+  BOOST_CHECK_EQUAL(face->getInterestShapingQueueLength(), 0);
+  BOOST_CHECK_GT(face->getNShapedInterests(), 0);
+  BOOST_CHECK_GT(face->getNShapingNacks(), 500);
+  BOOST_CHECK_EQUAL(static_cast<uint64_t>(face->getCounters().getNInNacks()),
+                    face->getNShapingNacks());
+}
+
+BOOST_AUTO_TEST_CASE(Fragmentation)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // Data do not fit into the 1500-octet MTU
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "4000"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  auto consumerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  auto producerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("2", "1"));
+  BOOST_REQUIRE(consumerFace != nullptr && producerFace != nullptr);
+
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNOutDatas(), 100);
+  BOOST_CHECK_EQUAL(producerFace->getNFragmentedPackets(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getNReassembledPackets(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getFaceStatus().getNInDatas(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getNFragmentedPackets(), 0);
+  BOOST_CHECK_EQUAL(consumerFace->getNDroppedMalformed(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BroadcastDefer)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  auto consumerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  auto producerFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("2", "1"));
+  BOOST_REQUIRE(consumerFace != nullptr && producerFace != nullptr);
+  consumerFace->setBroadcastDefer(MilliSeconds(20));
+  producerFace->setBroadcastDefer(MilliSeconds(20));
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  // nothing to overhear on a point-to-point link, all packets are merely delayed
+  BOOST_CHECK_EQUAL(producerFace->getFaceStatus().getNInInterests(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getFaceStatus().getNInDatas(), 100);
+  BOOST_CHECK_EQUAL(consumerFace->getNDeferCancelled(), 0);
+  BOOST_CHECK_EQUAL(producerFace->getNDeferCancelled(), 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
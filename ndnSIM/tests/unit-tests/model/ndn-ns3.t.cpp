@@ -21,6 +21,8 @@
 #include "helper/ndn-stack-helper.hpp"
 #include "model/ndn-header.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
+#include "utils/ndn-virtual-payload.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -54,6 +56,67 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(FromPacket)
+{
+  auto data = std::make_shared<ndn::Data>("/prefix/data");
+  ndn::StackHelper::getKeyChain().sign(*data);
+  setVirtualPayload(*data, 1000);
+
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+  FwHopCountTag hopCount;
+  hopCount.Increment();
+  packet->AddPacketTag(hopCount);
+
+  shared_ptr<const ndn::Data> received = Convert::FromPacket<ndn::Data>(packet);
+  BOOST_CHECK_EQUAL(received->wireEncode(), data->wireEncode());
+  BOOST_CHECK_EQUAL(getVirtualPayloadSize(*received), 1000);
+
+  // the tag keeps the packet tags, but not the buffer of the received packet
+  shared_ptr<Ns3PacketTag> tag = received->getTag<Ns3PacketTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK(tag->getPacket() != packet);
+  FwHopCountTag receivedHopCount;
+  BOOST_REQUIRE(tag->getPacket()->PeekPacketTag(receivedHopCount));
+  BOOST_CHECK_EQUAL(receivedHopCount.Get(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(FanOut)
+{
+  auto data = std::make_shared<ndn::Data>("/prefix/data");
+  ndn::StackHelper::getKeyChain().sign(*data);
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+  FwHopCountTag hopCount;
+  hopCount.Increment();
+  packet->AddPacketTag(hopCount);
+  shared_ptr<const ndn::Data> received = Convert::FromPacket<ndn::Data>(packet);
+
+  uint64_t nCopies = Convert::GetNFanOutCopies();
+  {
+    Convert::FanOut fanOut(*received);
+    Ptr<Packet> packet1 = Convert::ToPacket(*received);
+    Ptr<Packet> packet2 = Convert::ToPacket(*received);
+    BOOST_CHECK_EQUAL(Convert::GetNFanOutCopies(), nCopies + 1);
+    BOOST_CHECK(packet1 != packet2);
+
+    // the tags of a copy are its own
+    FwHopCountTag tag;
+    BOOST_REQUIRE(packet1->RemovePacketTag(tag));
+    tag.Increment();
+    packet1->AddPacketTag(tag);
+    BOOST_REQUIRE(packet2->PeekPacketTag(tag));
+    BOOST_CHECK_EQUAL(tag.Get(), 1);
+
+    BOOST_CHECK_EQUAL(Convert::FromPacket<ndn::Data>(packet2)->wireEncode(), data->wireEncode());
+
+    // other packets are built as usual
+    Convert::ToPacket(*data);
+    BOOST_CHECK_EQUAL(Convert::GetNFanOutCopies(), nCopies + 1);
+  }
+
+  Convert::ToPacket(*received);
+  BOOST_CHECK_EQUAL(Convert::GetNFanOutCopies(), nCopies + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -206,6 +206,49 @@ BOOST_AUTO_TEST_CASE(ExpressInterestWithRib)
   BOOST_CHECK(hasFired);
 }
 
+class InterestsWithLifetimes : public BaseTesterApp
+{
+public:
+  InterestsWithLifetimes(const std::vector<std::pair<Name, time::milliseconds>>& interests,
+                         const NameCallback& onTimeout)
+  {
+    for (const auto& interest : interests) {
+      m_face.expressInterest(Interest(interest.first, interest.second),
+                             std::bind([] { BOOST_ERROR("Unexpected data"); }),
+                             std::bind(onTimeout, interest.first));
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ExpressInterestTimeoutOrder)
+{
+  std::vector<std::pair<Name, double>> timeouts;
+
+  FactoryCallbackApp::Install(getNode("A"), [this, &timeouts] () -> shared_ptr<void> {
+      return make_shared<InterestsWithLifetimes>(
+        std::vector<std::pair<Name, time::milliseconds>>{{"/test/a", time::milliseconds(3000)},
+                                                          {"/test/b", time::milliseconds(1000)},
+                                                          {"/test", time::milliseconds(2000)},
+                                                          {"/test/c", time::milliseconds(1000)}},
+        [&timeouts] (const Name& name) {
+          timeouts.push_back({name, Simulator::Now().ToDouble(Time::S)});
+        });
+    })
+    .Start(Seconds(1.0));
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(timeouts.size(), 4);
+  BOOST_CHECK_EQUAL(timeouts[0].first, "/test/b");
+  BOOST_CHECK_EQUAL(timeouts[1].first, "/test/c");
+  BOOST_CHECK_EQUAL(timeouts[2].first, "/test");
+  BOOST_CHECK_EQUAL(timeouts[3].first, "/test/a");
+  BOOST_CHECK_CLOSE(timeouts[0].second, 2.0, 0.1);
+  BOOST_CHECK_CLOSE(timeouts[2].second, 3.0, 0.1);
+  BOOST_CHECK_CLOSE(timeouts[3].second, 4.0, 0.1);
+}
+
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////
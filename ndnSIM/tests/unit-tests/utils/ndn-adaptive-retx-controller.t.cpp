@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-adaptive-retx-controller.hpp"
+
+#include "ns3/uinteger.h"
+
+#include <random>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnAdaptiveRetxController, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(FixedBudget)
+{
+  Ptr<RetxController> controller = CreateObject<RetxController>();
+  Name name("/S/NankaiDistrict/A/Traffic/%FE%01");
+
+  BOOST_CHECK(controller->OnTimeout(name, 1));
+  BOOST_CHECK(controller->OnTimeout(name, 2));
+  BOOST_CHECK(!controller->OnTimeout(name, 3));
+
+  controller->SetMaxTransmissions(1);
+  BOOST_CHECK(!controller->OnTimeout(name, 1));
+}
+
+class AdaptiveRetxControllerFixture : public CleanupFixture
+{
+public:
+  AdaptiveRetxControllerFixture()
+    : controller(CreateObject<AdaptiveRetxController>())
+    , nBudgetChanges(0)
+    , lastBudget(0)
+  {
+    controller->TraceConnectWithoutContext("BudgetChanged",
+                                           MakeCallback(&AdaptiveRetxControllerFixture::budgetChanged,
+                                                        this));
+  }
+
+  void
+  budgetChanged(const Name& prefix, uint32_t oldBudget, uint32_t newBudget)
+  {
+    ++nBudgetChanges;
+    lastBudget = newBudget;
+  }
+
+  /**
+   * \brief Run an Interest whose first \p nLost transmissions are lost
+   * \return number of transmissions made
+   */
+  uint32_t
+  fetch(const Name& name, uint32_t nLost)
+  {
+    uint32_t nTransmissions = 1;
+    for (; nTransmissions <= nLost; ++nTransmissions) {
+      if (!controller->OnTimeout(name, nTransmissions))
+        return nTransmissions;
+    }
+    controller->OnData(name, nTransmissions);
+    return nTransmissions;
+  }
+
+public:
+  Ptr<AdaptiveRetxController> controller;
+  int nBudgetChanges;
+  uint32_t lastBudget;
+};
+
+BOOST_FIXTURE_TEST_CASE(IndependentLosses, AdaptiveRetxControllerFixture)
+{
+  Name name("/S/NankaiDistrict/A/Traffic/%FE%01");
+  BOOST_CHECK_EQUAL(controller->GetBudget(name), 3);
+
+  // half of the transmissions are lost, 3 transmissions satisfy only 87.5% of the Interests
+  std::minstd_rand random(1);
+  double sumBudget = 0.0;
+  uint32_t minBudget = 100;
+  for (int i = 0; i < 400; ++i) {
+    for (uint32_t nTransmissions = 1;; ++nTransmissions) {
+      if (random() % 2 != 0) {
+        controller->OnData(name, nTransmissions);
+        break;
+      }
+      if (!controller->OnTimeout(name, nTransmissions))
+        break;
+    }
+
+    if (i >= 100) {
+      sumBudget += controller->GetBudget(name);
+      minBudget = std::min(minBudget, controller->GetBudget(name));
+    }
+  }
+  BOOST_CHECK_GT(sumBudget / 300, 4.0);
+  BOOST_CHECK_GE(minBudget, 3);
+  BOOST_CHECK_GT(nBudgetChanges, 0);
+
+  // budget is per prefix
+  BOOST_CHECK_EQUAL(controller->GetBudget(Name("/S/HepingDistrict/A/Traffic/%FE%01")), 3);
+  BOOST_CHECK(controller->GetStats(Name("/S/HepingDistrict/A/Weather/%FE%01")) != nullptr);
+  BOOST_CHECK(controller->GetStats(Name("/S/Elsewhere/A/Weather/%FE%01")) == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(UnreachableData, AdaptiveRetxControllerFixture)
+{
+  Name name("/S/NankaiDistrict/A/Traffic/%FE%01");
+
+  // retransmissions never return
+  for (int i = 0; i < 50; ++i) {
+    fetch(name, i % 4 == 0 ? 100 : 0);
+  }
+  BOOST_CHECK_EQUAL(controller->GetBudget(name), 2); // MinTransmissions
+  BOOST_CHECK_EQUAL(lastBudget, 2);
+
+  // without losses the budget remains at the lower bound
+  for (int i = 0; i < 50; ++i) {
+    fetch(name, 0);
+  }
+  BOOST_CHECK_EQUAL(controller->GetBudget(name), 2);
+  const AdaptiveRetxController::Stats* stats = controller->GetStats(name);
+  BOOST_REQUIRE(stats != nullptr);
+  BOOST_CHECK_GT(stats->satisfaction, 0.95);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
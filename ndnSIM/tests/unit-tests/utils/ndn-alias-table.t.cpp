@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-alias-table.hpp"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnAliasTable)
+
+BOOST_AUTO_TEST_CASE(ExactProbabilities)
+{
+  std::vector<double> weights = {1, 2, 3, 4, 0, 10};
+  AliasTable table;
+  table.build(weights);
+  BOOST_CHECK_EQUAL(table.size(), weights.size());
+
+  // evenly spread values of u give every index exactly its share, up to the grid size
+  const uint32_t nValues = 1000000;
+  std::vector<uint32_t> counts(weights.size());
+  for (uint32_t k = 0; k < nValues; ++k) {
+    uint32_t i = table.sample((k + 0.5) / nValues);
+    BOOST_REQUIRE_LT(i, weights.size());
+    ++counts[i];
+  }
+
+  for (size_t i = 0; i < weights.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION(counts[i] / double(nValues), weights[i] / 20, 1e-4);
+  }
+  BOOST_CHECK_EQUAL(counts[4], 0);
+}
+
+BOOST_AUTO_TEST_CASE(ZipfMandelbrot)
+{
+  const uint32_t n = 1000;
+  std::vector<double> weights(n);
+  double sum = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    weights[i] = 1.0 / std::pow(i + 1 + 0.7, 0.7);
+    sum += weights[i];
+  }
+
+  AliasTable table;
+  table.build(weights);
+
+  // popular contents are spread over the columns of many other indices
+  const uint32_t nValues = 10000000;
+  std::vector<uint32_t> counts(4);
+  for (uint32_t k = 0; k < nValues; ++k) {
+    uint32_t i = table.sample((k + 0.5) / nValues);
+    if (i < counts.size())
+      ++counts[i];
+  }
+  for (size_t i = 0; i < counts.size(); ++i) {
+    BOOST_CHECK_CLOSE_FRACTION(counts[i] / double(nValues), weights[i] / sum, 1e-3);
+  }
+
+  BOOST_CHECK_LT(table.sample(0.999999999999), n);
+}
+
+BOOST_AUTO_TEST_CASE(Degenerate)
+{
+  AliasTable table;
+  table.build(std::vector<double>());
+  BOOST_CHECK(table.empty());
+
+  table.build(std::vector<double>(3, 0.0)); // no weight at all, uniform
+  BOOST_CHECK_EQUAL(table.sample(0.1), 0);
+  BOOST_CHECK_EQUAL(table.sample(0.5), 1);
+  BOOST_CHECK_EQUAL(table.sample(0.9), 2);
+
+  table.build(std::vector<double>(1, 5.0));
+  BOOST_CHECK_EQUAL(table.sample(0.0), 0);
+  BOOST_CHECK_EQUAL(table.sample(0.99), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-allocation-profiler.hpp"
+
+#include <boost/test/output_test_stream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class AllocationProfilerFixture : public CleanupFixture
+{
+public:
+  AllocationProfilerFixture()
+  {
+    AllocationProfiler::Reset();
+  }
+
+  ~AllocationProfilerFixture()
+  {
+    AllocationProfiler::Disable();
+    AllocationProfiler::Reset();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnAllocationProfiler, AllocationProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(Subsystems)
+{
+  // not counted while disabled
+  {
+    AllocationProfiler::Scope scope(AllocationProfiler::APPS);
+    AllocationProfiler::RecordAllocation(100);
+  }
+  AllocationProfiler::CountPacket();
+  BOOST_CHECK_EQUAL(AllocationProfiler::GetCounters(AllocationProfiler::APPS).nAllocations, 0);
+  BOOST_CHECK_EQUAL(AllocationProfiler::GetNPackets(), 0);
+
+  AllocationProfiler::Enable(0);
+  BOOST_CHECK(AllocationProfiler::IsEnabled());
+
+  // the bodies of the scopes do not allocate, so the counts are exact even when operator new
+  // is replaced
+  {
+    AllocationProfiler::Scope tables(AllocationProfiler::TABLES);
+    AllocationProfiler::RecordAllocation(100);
+    AllocationProfiler::CountPacket();
+    {
+      AllocationProfiler::Scope encoding(AllocationProfiler::ENCODING);
+      AllocationProfiler::RecordAllocation(40);
+      AllocationProfiler::RecordAllocation(60);
+    }
+    AllocationProfiler::RecordAllocation(20);
+    AllocationProfiler::CountPacket();
+  }
+
+  AllocationProfiler::Counters tables = AllocationProfiler::GetCounters(AllocationProfiler::TABLES);
+  BOOST_CHECK_EQUAL(tables.nAllocations, 2);
+  BOOST_CHECK_EQUAL(tables.nBytes, 120);
+  AllocationProfiler::Counters encoding =
+    AllocationProfiler::GetCounters(AllocationProfiler::ENCODING);
+  BOOST_CHECK_EQUAL(encoding.nAllocations, 2);
+  BOOST_CHECK_EQUAL(encoding.nBytes, 100);
+  BOOST_CHECK_EQUAL(AllocationProfiler::GetNPackets(), 2);
+
+  boost::test_tools::output_test_stream os;
+  AllocationProfiler::PrintReport(os);
+  std::string report = os.str();
+  BOOST_CHECK(report.find("Packets\t2\n") != std::string::npos);
+  BOOST_CHECK(report.find("Tables\t2\t120\t1\t60\n") != std::string::npos);
+  BOOST_CHECK(report.find("Encoding\t2\t100\t1\t50\n") != std::string::npos);
+
+  AllocationProfiler::Reset();
+  BOOST_CHECK_EQUAL(AllocationProfiler::GetCounters(AllocationProfiler::TABLES).nAllocations, 0);
+  BOOST_CHECK_EQUAL(AllocationProfiler::GetNPackets(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CallSites)
+{
+  AllocationProfiler::Enable(2);
+  {
+    AllocationProfiler::Scope scope(AllocationProfiler::TRACERS);
+    for (int i = 0; i < 10; ++i) {
+      AllocationProfiler::RecordAllocation(8);
+    }
+  }
+  AllocationProfiler::Disable();
+
+  std::vector<AllocationProfiler::CallSite> callSites = AllocationProfiler::GetCallSites();
+  BOOST_REQUIRE(!callSites.empty());
+
+  // every other allocation is sampled, and each sample stands for two allocations
+  uint64_t nAllocations = 0;
+  for (const AllocationProfiler::CallSite& callSite : callSites) {
+    nAllocations += callSite.nAllocations;
+  }
+  BOOST_CHECK_GE(nAllocations, 10);
+  BOOST_CHECK_EQUAL(nAllocations % 2, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
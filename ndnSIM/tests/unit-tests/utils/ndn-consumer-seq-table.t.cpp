@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-consumer-seq-table.hpp"
+
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnConsumerSeqTable)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  ConsumerSeqTable table;
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK(table.find(1) == nullptr);
+
+  for (uint32_t seq = 0; seq < 1000; ++seq) {
+    ConsumerSeqTable::Entry& entry = table.insert(seq);
+    BOOST_CHECK_EQUAL(entry.seq, seq);
+    BOOST_CHECK_EQUAL(entry.retxCount, 0);
+    BOOST_CHECK(!entry.hasDeadline);
+    entry.retxCount = seq + 1;
+  }
+  BOOST_CHECK_EQUAL(table.size(), 1000);
+  BOOST_CHECK_EQUAL(table.insert(10).retxCount, 11); // existing entry is returned
+
+  for (uint32_t seq = 0; seq < 1000; seq += 2) {
+    table.erase(seq);
+  }
+  table.erase(5000); // no such entry
+  BOOST_CHECK_EQUAL(table.size(), 500);
+
+  for (uint32_t seq = 0; seq < 1000; ++seq) {
+    ConsumerSeqTable::Entry* entry = table.find(seq);
+    if (seq % 2 == 0) {
+      BOOST_CHECK(entry == nullptr);
+    }
+    else {
+      BOOST_REQUIRE(entry != nullptr);
+      BOOST_CHECK_EQUAL(entry->retxCount, seq + 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Deadlines)
+{
+  ConsumerSeqTable table;
+  BOOST_CHECK(table.earliestDeadline() == nullptr);
+
+  std::map<uint32_t, Time> deadlines;
+  for (uint32_t seq = 0; seq < 100; ++seq) {
+    Time deadline = MilliSeconds((seq * 37) % 100);
+    table.setDeadline(table.insert(seq), deadline);
+    deadlines[seq] = deadline;
+  }
+
+  // move some deadlines, remove others
+  for (uint32_t seq = 0; seq < 100; seq += 3) {
+    table.setDeadline(*table.find(seq), MilliSeconds(200 + seq));
+    deadlines[seq] = MilliSeconds(200 + seq);
+  }
+  for (uint32_t seq = 1; seq < 100; seq += 3) {
+    table.erase(seq);
+    deadlines.erase(seq);
+  }
+  for (uint32_t seq = 2; seq < 100; seq += 9) {
+    table.clearDeadline(*table.find(seq));
+    deadlines.erase(seq);
+  }
+
+  Time last;
+  size_t nExpired = 0;
+  while (ConsumerSeqTable::Entry* entry = table.earliestDeadline()) {
+    BOOST_CHECK(entry->deadline >= last);
+    BOOST_CHECK_EQUAL(entry->deadline, deadlines[entry->seq]);
+    last = entry->deadline;
+    table.clearDeadline(*entry);
+    ++nExpired;
+  }
+  BOOST_CHECK_EQUAL(nExpired, deadlines.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-correlated-workload.hpp"
+
+#include "../tests-common.hpp"
+
+#include <set>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnCorrelatedWorkload, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Load)
+{
+  std::istringstream is("# scene\n"
+                        "/S/West 1\n"
+                        "\n"
+                        "/S/East 0\n"
+                        "/A/Traffic/Congestion\n"
+                        "/A/Parking 2.5\n");
+  CorrelatedWorkload workload;
+  workload.Load(is);
+  BOOST_CHECK_EQUAL(workload.GetNSpatialNames(), 2);
+  BOOST_CHECK_EQUAL(workload.GetSpatialName(1), "/S/East");
+  BOOST_CHECK_EQUAL(workload.GetNAppNames(), 2);
+
+  std::istringstream noMarker("/Traffic 1\n");
+  BOOST_CHECK_THROW(workload.Load(noMarker), std::runtime_error);
+  std::istringstream badWeight("/S/North -1\n");
+  BOOST_CHECK_THROW(workload.Load(badWeight), std::runtime_error);
+  std::istringstream extraField("/S/North 1 2\n");
+  BOOST_CHECK_THROW(workload.Load(extraField), std::runtime_error);
+
+  CorrelatedWorkload empty;
+  Name prefix;
+  BOOST_CHECK_THROW(empty.Next(nullptr, prefix), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(SpatialLocality)
+{
+  CorrelatedWorkload workload;
+  workload.AddSpatialName("/S/West", 1);
+  workload.AddSpatialName("/S/East", 0);
+  workload.AddAppName("/A/Traffic");
+  workload.AddAppName("/A/Parking");
+  workload.SetPopularity(10, 0.7, 0.7);
+  workload.SetLocalProbability(1.0);
+  workload.SetRepeatProbability(0.0, 16);
+
+  Name east("/S/East");
+  Name prefix;
+  std::set<Name> prefixes;
+  for (int i = 0; i < 200; ++i) {
+    uint32_t id = workload.Next(nullptr, prefix);
+    BOOST_CHECK(Name("/S/West").isPrefixOf(prefix));
+    BOOST_CHECK_LT(id, 2 * 2 * 10);
+    BOOST_CHECK_EQUAL(workload.GetPrefix(id), prefix);
+    prefixes.insert(prefix);
+
+    workload.Next(&east, prefix);
+    BOOST_CHECK(east.isPrefixOf(prefix));
+  }
+  BOOST_CHECK_EQUAL(prefixes.size(), 2);
+
+  // not a spatial name of the workload
+  Name north("/S/North");
+  workload.Next(&north, prefix);
+  BOOST_CHECK(Name("/S/West").isPrefixOf(prefix));
+}
+
+BOOST_AUTO_TEST_CASE(TemporalLocality)
+{
+  CorrelatedWorkload workload;
+  workload.AddSpatialName("/S/West");
+  workload.AddAppName("/A/Traffic");
+  workload.SetPopularity(1000, 0.7, 0.0);
+
+  workload.SetRepeatProbability(1.0, 1);
+  Name prefix;
+  uint32_t first = workload.Next(nullptr, prefix);
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(workload.Next(nullptr, prefix), first);
+  }
+
+  // repeats are spread over the history
+  workload.SetRepeatProbability(0.5, 4);
+  std::vector<uint32_t> ids;
+  for (int i = 0; i < 400; ++i) {
+    ids.push_back(workload.Next(nullptr, prefix));
+  }
+  std::set<uint32_t> distinct(ids.begin(), ids.end());
+  BOOST_CHECK_LT(distinct.size(), 300);
+  BOOST_CHECK_GT(distinct.size(), 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
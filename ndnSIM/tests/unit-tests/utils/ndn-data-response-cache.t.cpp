@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-response-cache.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnDataResponseCache)
+
+static shared_ptr<const Data>
+makeData(const std::string& name)
+{
+  auto data = make_shared<Data>(Name(name));
+  data->setSignature(Signature(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                               ::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0)));
+  data->wireEncode();
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(LeastRecentlyUsed)
+{
+  DataResponseCache cache(2);
+  BOOST_CHECK(cache.find("/a") == nullptr);
+
+  cache.insert(makeData("/a"));
+  cache.insert(makeData("/b"));
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_REQUIRE(cache.find("/a") != nullptr); // /b is now the least recently used
+  BOOST_CHECK_EQUAL(cache.find("/a")->getName(), Name("/a"));
+
+  cache.insert(makeData("/c"));
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find("/b") == nullptr);
+  BOOST_CHECK(cache.find("/a") != nullptr);
+  BOOST_CHECK(cache.find("/c") != nullptr);
+
+  // inserting the same name again replaces the Data
+  shared_ptr<const Data> c = makeData("/c");
+  cache.insert(c);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK_EQUAL(cache.find("/c"), c);
+
+  cache.setCapacity(1);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  BOOST_CHECK(cache.find("/c") != nullptr);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  DataResponseCache cache;
+  cache.insert(makeData("/a"));
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK(cache.find("/a") == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-data-wire-table.hpp"
+#include "model/ndn-ns3.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+
+#include <thread>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class DataWireTableFixture : public CleanupFixture
+{
+public:
+  DataWireTableFixture()
+  {
+    auto data = std::make_shared<ndn::Data>("/prefix/data");
+    data->setContent(std::make_shared< ::ndn::Buffer>(1024));
+    ndn::StackHelper::getKeyChain().sign(*data);
+    packet = Convert::ToPacket(*data);
+  }
+
+  ~DataWireTableFixture()
+  {
+    DataWireTable::Disable();
+  }
+
+public:
+  Ptr<Packet> packet;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnDataWireTable, DataWireTableFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  BOOST_CHECK(!DataWireTable::IsEnabled());
+
+  shared_ptr<const ndn::Data> data1 = Convert::FromPacket<ndn::Data>(packet);
+  shared_ptr<const ndn::Data> data2 = Convert::FromPacket<ndn::Data>(packet);
+  BOOST_CHECK_EQUAL(data1->wireEncode(), data2->wireEncode());
+  BOOST_CHECK(data1->wireEncode().getBuffer() != data2->wireEncode().getBuffer());
+  BOOST_CHECK_EQUAL(DataWireTable::GetNLookups(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Shared)
+{
+  DataWireTable::Enable();
+
+  shared_ptr<const ndn::Data> data1 = Convert::FromPacket<ndn::Data>(packet);
+  shared_ptr<const ndn::Data> data2 = Convert::FromPacket<ndn::Data>(packet);
+  BOOST_CHECK(data1 != data2);
+  BOOST_CHECK_EQUAL(data2->getName(), "/prefix/data");
+  BOOST_CHECK_EQUAL(data2->getContent().value_size(), 1024);
+  BOOST_CHECK(data1->wireEncode().getBuffer() == data2->wireEncode().getBuffer());
+
+  BOOST_CHECK_EQUAL(DataWireTable::GetNEntries(), 1);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNLookups(), 2);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNHits(), 1);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNSharedBytes(), data1->wireEncode().size());
+
+  // Interests are not interned
+  Convert::FromPacket<ndn::Interest>(Convert::ToPacket(ndn::Interest("/prefix")));
+  BOOST_CHECK_EQUAL(DataWireTable::GetNLookups(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Different)
+{
+  DataWireTable::Enable();
+
+  auto other = std::make_shared<ndn::Data>("/prefix/other");
+  ndn::StackHelper::getKeyChain().sign(*other);
+
+  shared_ptr<const ndn::Data> data1 = Convert::FromPacket<ndn::Data>(packet);
+  shared_ptr<const ndn::Data> data2 = Convert::FromPacket<ndn::Data>(Convert::ToPacket(*other));
+  BOOST_CHECK(data1->wireEncode().getBuffer() != data2->wireEncode().getBuffer());
+  BOOST_CHECK_EQUAL(DataWireTable::GetNEntries(), 2);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNHits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Released)
+{
+  DataWireTable::Enable();
+
+  shared_ptr<const ndn::Data> data = Convert::FromPacket<ndn::Data>(packet);
+  std::weak_ptr<const ::ndn::Buffer> buffer = data->wireEncode().getBuffer();
+  data.reset();
+  // the table does not keep the buffer alive
+  BOOST_CHECK(buffer.expired());
+
+  data = Convert::FromPacket<ndn::Data>(packet);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNHits(), 0);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNEntries(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  DataWireTable::Enable();
+
+  // nodes of different logical processes of a multithreaded simulator
+  Block wire = Convert::FromPacket<ndn::Data>(packet)->wireEncode();
+  std::vector<std::thread> threads;
+  std::vector<Block> interned(4);
+  for (Block& block : interned) {
+    threads.emplace_back([&] {
+        for (int i = 0; i < 1000; ++i) {
+          block = DataWireTable::Intern(wire);
+        }
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (const Block& block : interned) {
+    BOOST_CHECK(block.getBuffer() == wire.getBuffer());
+  }
+  BOOST_CHECK_EQUAL(DataWireTable::GetNLookups(), 4001);
+  BOOST_CHECK_EQUAL(DataWireTable::GetNHits(), 4000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
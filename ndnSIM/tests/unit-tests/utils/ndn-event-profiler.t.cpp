@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-event-profiler.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include <sstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class EventProfilerFixture : public CleanupFixture
+{
+public:
+  ~EventProfilerFixture()
+  {
+    EventProfiler::Disable();
+    EventProfiler::SetReportInterval(Seconds(0));
+  }
+
+  void
+  run()
+  {
+    ScenarioHelper helper;
+    helper.createTopology({
+        {"1", "2"},
+      });
+    helper.addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+    helper.addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "1s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+            "0s", "100s"}
+      });
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnEventProfiler, EventProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(CallbackType)
+{
+  EventProfiler::Enable();
+  BOOST_CHECK(EventProfiler::IsEnabled());
+  run();
+
+  std::vector<EventProfiler::Record> records = EventProfiler::GetRecords();
+  BOOST_REQUIRE(!records.empty());
+
+  uint64_t nConsumerEvents = 0;
+  for (const EventProfiler::Record& record : records) {
+    BOOST_CHECK_LE(record.nExecuted + record.nCancelled, record.nScheduled);
+    if (record.label.find("ns3::ndn::Consumer") != std::string::npos) {
+      nConsumerEvents += record.nExecuted;
+    }
+  }
+  // ~10 Interests, and the retransmission timer checks
+  BOOST_CHECK_GE(nConsumerEvents, 10);
+
+  for (size_t i = 1; i < records.size(); ++i) {
+    BOOST_CHECK_GE(records[i - 1].wallTime, records[i].wallTime);
+  }
+
+  std::ostringstream csv;
+  EventProfiler::WriteCsv(csv);
+  BOOST_CHECK_EQUAL(csv.str().substr(0, csv.str().find('\n')),
+                    "Label,Scheduled,Executed,Cancelled,WallTime,MeanTime");
+
+  std::ostringstream report;
+  EventProfiler::PrintReport(report, 3);
+  BOOST_CHECK(report.str().find("Executed") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Caller)
+{
+  EventProfiler::Enable(EventProfiler::CALLER);
+  EventProfiler::SetReportInterval(Seconds(1), 1);
+  run();
+
+  std::vector<EventProfiler::Record> records = EventProfiler::GetRecords();
+  BOOST_REQUIRE(!records.empty());
+  // caller, followed by the callback type
+  for (const EventProfiler::Record& record : records) {
+    BOOST_CHECK_NE(record.label.find(' '), std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Nodes)
+{
+  EventProfiler::Enable();
+  run();
+
+  std::vector<EventProfiler::NodeRecord> records = EventProfiler::GetNodeRecords();
+  uint64_t nNodeEvents[2] = {0, 0};
+  uint64_t nExecuted = 0;
+  for (const EventProfiler::NodeRecord& record : records) {
+    BOOST_CHECK_GT(record.nExecuted, 0);
+    if (record.node < 2) {
+      nNodeEvents[record.node] = record.nExecuted;
+    }
+    nExecuted += record.nExecuted;
+  }
+  // the consumer and the producer run in the contexts of their nodes
+  BOOST_CHECK_GE(nNodeEvents[0], 10);
+  BOOST_CHECK_GE(nNodeEvents[1], 10);
+
+  uint64_t nRecordExecuted = 0;
+  for (const EventProfiler::Record& record : EventProfiler::GetRecords()) {
+    nRecordExecuted += record.nExecuted;
+  }
+  BOOST_CHECK_EQUAL(nExecuted, nRecordExecuted);
+
+  for (size_t i = 1; i < records.size(); ++i) {
+    BOOST_CHECK_GE(records[i - 1].wallTime, records[i].wallTime);
+  }
+
+  std::ostringstream csv;
+  EventProfiler::WriteNodeCsv(csv);
+  BOOST_CHECK_EQUAL(csv.str().substr(0, csv.str().find('\n')),
+                    "Node,Executed,WallTime,MeanTime,Share,X,Y");
+
+  std::ostringstream report;
+  EventProfiler::PrintNodeReport(report, 2);
+  BOOST_CHECK(report.str().find("Node") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
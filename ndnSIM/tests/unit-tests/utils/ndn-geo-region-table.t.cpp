@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-geo-region-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class GeoRegionTableFixture
+{
+public:
+  ~GeoRegionTableFixture()
+  {
+    GeoRegionTable::Clear();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnGeoRegionTable, GeoRegionTableFixture)
+
+BOOST_AUTO_TEST_CASE(LongestPrefix)
+{
+  GeoRegionTable::Add("/NankaiDistrict", Vector(0, 0, 0), 1000);
+  GeoRegionTable::Add("/NankaiDistrict/WeijingRoad", Vector(100, 200, 0), 50);
+  BOOST_CHECK_EQUAL(GeoRegionTable::GetNRegions(), 2);
+
+  const GeoRegionTable::Region* region =
+    GeoRegionTable::Find("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/%FE%01");
+  BOOST_REQUIRE(region != nullptr);
+  BOOST_CHECK_EQUAL(region->center.y, 200);
+  BOOST_CHECK_EQUAL(region->radius, 50);
+
+  region = GeoRegionTable::Find("/S/NankaiDistrict/HongqiRoad/A/TrafficInformer/%FE%01");
+  BOOST_REQUIRE(region != nullptr);
+  BOOST_CHECK_EQUAL(region->radius, 1000);
+
+  // only the spatial segment is matched
+  BOOST_CHECK(GeoRegionTable::Find("/S/HepingDistrict/A/NankaiDistrict") == nullptr);
+  BOOST_CHECK(GeoRegionTable::Find("/NankaiDistrict/WeijingRoad") == nullptr);
+  BOOST_CHECK(GeoRegionTable::Find("/S/A/TrafficInformer") == nullptr);
+
+  GeoRegionTable::Add("/NankaiDistrict", Vector(0, 0, 0), 500);
+  BOOST_CHECK_EQUAL(GeoRegionTable::GetNRegions(), 2);
+  BOOST_CHECK_EQUAL(GeoRegionTable::Find("/S/NankaiDistrict/A/Weather")->radius, 500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
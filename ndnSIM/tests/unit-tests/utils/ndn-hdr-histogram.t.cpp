@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-hdr-histogram.hpp"
+
+#include <limits>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnHdrHistogram)
+
+BOOST_AUTO_TEST_CASE(Percentiles)
+{
+  HdrHistogram h;
+  BOOST_CHECK_EQUAL(h.GetCount(), 0);
+  BOOST_CHECK_EQUAL(h.GetPercentile(50), 0);
+  BOOST_CHECK_EQUAL(h.GetMin(), 0);
+
+  for (uint64_t i = 1; i <= 100000; ++i) {
+    h.Record(i * 1000); // 1 us .. 100 ms in nanoseconds
+  }
+
+  BOOST_CHECK_EQUAL(h.GetCount(), 100000);
+  BOOST_CHECK_CLOSE(h.GetMean(), 50000500.0, 0.0001);
+  BOOST_CHECK_EQUAL(h.GetMin(), 1000);
+  BOOST_CHECK_EQUAL(h.GetMax(), 100000000);
+  BOOST_CHECK_CLOSE(static_cast<double>(h.GetPercentile(50)), 50000000.0, 1.0);
+  BOOST_CHECK_CLOSE(static_cast<double>(h.GetPercentile(95)), 95000000.0, 1.0);
+  BOOST_CHECK_CLOSE(static_cast<double>(h.GetPercentile(99)), 99000000.0, 1.0);
+  BOOST_CHECK_EQUAL(h.GetPercentile(100), 100000000);
+  BOOST_CHECK_EQUAL(h.GetPercentile(0), 1000);
+
+  h.Reset();
+  BOOST_CHECK_EQUAL(h.GetCount(), 0);
+  BOOST_CHECK_EQUAL(h.GetMax(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValues)
+{
+  HdrHistogram h;
+  h.Record(1, 90);
+  h.Record(2, 9);
+  h.Record(5);
+
+  // values below 128 are exact
+  BOOST_CHECK_EQUAL(h.GetPercentile(50), 1);
+  BOOST_CHECK_EQUAL(h.GetPercentile(95), 2);
+  BOOST_CHECK_EQUAL(h.GetPercentile(99), 2);
+  BOOST_CHECK_EQUAL(h.GetPercentile(99.5), 5);
+  BOOST_CHECK_CLOSE(h.GetMean(), 1.13, 0.0001);
+
+  HdrHistogram other;
+  other.Record(std::numeric_limits<uint64_t>::max());
+  h.Merge(other);
+  BOOST_CHECK_EQUAL(h.GetCount(), 101);
+  BOOST_CHECK_EQUAL(h.GetPercentile(100), std::numeric_limits<uint64_t>::max());
+  BOOST_CHECK_EQUAL(h.GetMin(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-interest-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnInterestTemplate)
+
+BOOST_AUTO_TEST_CASE(MatchesEncoding)
+{
+  Name prefix("/S/NankaiDistrict/A/TrafficInformer");
+  std::vector<time::milliseconds> lifetimes = {time::milliseconds(2000),
+                                               ::ndn::DEFAULT_INTEREST_LIFETIME};
+  std::vector<uint32_t> seqs = {0, 1, 255, 256, 65535, 65536, 123456789,
+                                std::numeric_limits<uint32_t>::max()};
+
+  for (time::milliseconds lifetime : lifetimes) {
+    InterestTemplate interestTemplate(prefix, lifetime);
+    for (uint32_t seq : seqs) {
+      shared_ptr<Interest> interest = interestTemplate.makeInterest(seq, 0xdeadbeef);
+
+      Interest expected;
+      expected.setName(Name(prefix).appendSequenceNumber(seq));
+      expected.setNonce(0xdeadbeef);
+      expected.setInterestLifetime(lifetime);
+      BOOST_CHECK_EQUAL(interest->wireEncode(), expected.wireEncode());
+      BOOST_CHECK_EQUAL(interest->getName().get(-1).toSequenceNumber(), seq);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RefreshNonce)
+{
+  InterestTemplate interestTemplate("/prefix", time::milliseconds(1000));
+  shared_ptr<Interest> interest = interestTemplate.makeInterest(42, 1);
+  shared_ptr<Interest> copy = make_shared<Interest>(*interest); // shares the encoding
+
+  shared_ptr<Interest> retx = InterestTemplate::refreshNonce(*interest, 2);
+  BOOST_CHECK_EQUAL(retx->getNonce(), 2);
+  BOOST_CHECK_EQUAL(retx->getName(), interest->getName());
+  BOOST_CHECK_EQUAL(retx->getInterestLifetime(), time::milliseconds(1000));
+  BOOST_CHECK_EQUAL(interest->getNonce(), 1);
+  BOOST_CHECK_EQUAL(copy->getNonce(), 1);
+
+  Interest noNonce(Name("/prefix/1"));
+  BOOST_CHECK_EQUAL(InterestTemplate::refreshNonce(noNonce, 3)->getNonce(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(RefreshNonceAndLifetime)
+{
+  InterestTemplate interestTemplate("/prefix", time::milliseconds(2000));
+  shared_ptr<Interest> interest = interestTemplate.makeInterest(42, 1);
+
+  // in place, with leading zero octets
+  shared_ptr<Interest> shorter =
+    InterestTemplate::refreshNonce(*interest, 2, time::milliseconds(150));
+  BOOST_CHECK_EQUAL(shorter->getNonce(), 2);
+  BOOST_CHECK_EQUAL(shorter->getName(), interest->getName());
+  BOOST_CHECK_EQUAL(shorter->getInterestLifetime(), time::milliseconds(150));
+  BOOST_CHECK_EQUAL(shorter->wireEncode().size(), interest->wireEncode().size());
+  BOOST_CHECK_EQUAL(interest->getInterestLifetime(), time::milliseconds(2000));
+
+  // encoded anew
+  shared_ptr<Interest> longer =
+    InterestTemplate::refreshNonce(*interest, 3, time::milliseconds(100000));
+  BOOST_CHECK_EQUAL(longer->getNonce(), 3);
+  BOOST_CHECK_EQUAL(longer->getInterestLifetime(), time::milliseconds(100000));
+
+  InterestTemplate defaultTemplate("/prefix");
+  shared_ptr<Interest> withoutLifetime = defaultTemplate.makeInterest(42, 1);
+  BOOST_CHECK_EQUAL(InterestTemplate::refreshNonce(*withoutLifetime, 4, time::milliseconds(300))
+                      ->getInterestLifetime(), time::milliseconds(300));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
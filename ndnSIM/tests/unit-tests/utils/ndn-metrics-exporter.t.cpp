@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-metrics-exporter.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class MetricsExporterFixture : public CleanupFixture
+{
+public:
+  ~MetricsExporterFixture()
+  {
+    MetricsExporter::Disable();
+    MetricsExporter::SetInterval(Seconds(1));
+  }
+
+  void
+  run()
+  {
+    ScenarioHelper helper;
+    helper.createTopology({
+        {"1", "2"},
+      });
+    helper.addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+    helper.addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.95s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+            "0s", "100s"}
+      });
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+  }
+
+  static sockaddr_in
+  localAddress(uint16_t port)
+  {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnMetricsExporter, MetricsExporterFixture)
+
+BOOST_AUTO_TEST_CASE(Http)
+{
+  MetricsExporter::SetInterval(Seconds(0)); // snapshot at every check
+  MetricsExporter::EnableHttp(0);
+  BOOST_CHECK(MetricsExporter::IsEnabled());
+  BOOST_REQUIRE_NE(MetricsExporter::GetHttpPort(), 0);
+
+  run();
+
+  MetricsExporter::Snapshot snapshot = MetricsExporter::GetSnapshot();
+  BOOST_CHECK_GT(snapshot.simulationTime, 1.9);
+  BOOST_CHECK_GT(snapshot.memory, 0);
+  BOOST_CHECK_EQUAL(snapshot.nSatisfied, 10);
+  BOOST_CHECK_EQUAL(snapshot.nGivenUp, 0);
+  BOOST_CHECK_EQUAL(snapshot.nPitEntries, 0);
+  BOOST_CHECK(!snapshot.hasEvents); // EventProfiler is not enabled
+
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address = localAddress(MetricsExporter::GetHttpPort());
+  BOOST_REQUIRE_EQUAL(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  const std::string request = "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  ::send(fd, request.data(), request.size(), 0);
+
+  std::string response;
+  char buffer[4096];
+  ssize_t n = 0;
+  while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+    response.append(buffer, n);
+  }
+  ::close(fd);
+
+  BOOST_CHECK_EQUAL(response.find("HTTP/1.0 200 OK\r\n"), 0);
+  BOOST_CHECK_NE(response.find("\nndnsim_satisfied_interests_total 10\n"), std::string::npos);
+  BOOST_CHECK_NE(response.find("\nndnsim_snapshot_age_seconds "), std::string::npos);
+
+  MetricsExporter::Disable();
+  BOOST_CHECK(!MetricsExporter::IsEnabled());
+  BOOST_CHECK_EQUAL(MetricsExporter::GetHttpPort(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Statsd)
+{
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in address = localAddress(0);
+  BOOST_REQUIRE_EQUAL(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  socklen_t length = sizeof(address);
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+  timeval timeout = {2, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  MetricsExporter::SetInterval(Seconds(0));
+  MetricsExporter::EnableStatsd("127.0.0.1", ntohs(address.sin_port), "test");
+
+  run();
+
+  // the last snapshot is pushed within the poll interval of the background thread
+  bool isPushed = false;
+  char buffer[4096];
+  ssize_t n = 0;
+  while (!isPushed && (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+    std::string datagram(buffer, n);
+    BOOST_CHECK_EQUAL(datagram.find("test.simulation_time_seconds:"), 0);
+    isPushed = datagram.find("\ntest.satisfied_interests:10|g\n") != std::string::npos;
+  }
+  ::close(fd);
+  BOOST_CHECK(isPushed);
+}
+
+BOOST_AUTO_TEST_CASE(PrometheusFormat)
+{
+  MetricsExporter::Snapshot snapshot;
+  snapshot.simulationTime = 12.5;
+  snapshot.memory = 123456789;
+  snapshot.satisfactionRatio = NAN;
+
+  std::ostringstream os;
+  MetricsExporter::PrintPrometheus(os, snapshot, 0.5);
+  BOOST_CHECK_NE(os.str().find("# TYPE ndnsim_simulation_time_seconds gauge\n"
+                               "ndnsim_simulation_time_seconds 12.5\n"), std::string::npos);
+  BOOST_CHECK_NE(os.str().find("\nndnsim_memory_bytes 123456789\n"), std::string::npos);
+  BOOST_CHECK_NE(os.str().find("\nndnsim_satisfaction_ratio NaN\n"), std::string::npos);
+  BOOST_CHECK_NE(os.str().find("\nndnsim_snapshot_age_seconds 0.5\n"), std::string::npos);
+  BOOST_CHECK_EQUAL(os.str().find("events"), std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-mobility-prefetcher.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class MobilityPrefetcherFixture : public CleanupFixture
+{
+public:
+  MobilityPrefetcherFixture()
+  {
+    GeoRegionTable::Clear();
+    GeoRegionTable::Add("/West", Vector(0, 0, 0));
+    GeoRegionTable::Add("/East", Vector(1000, 0, 0));
+    GeoRegionTable::Add("/East/Square", Vector(1000, 500, 0), 50);
+  }
+
+  ~MobilityPrefetcherFixture()
+  {
+    GeoRegionTable::Clear();
+  }
+
+  void
+  acquire(MobilityPrefetcher* prefetcher, int* nAcquired)
+  {
+    if (prefetcher->TryAcquire())
+      ++*nAcquired;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnMobilityPrefetcher, MobilityPrefetcherFixture)
+
+BOOST_AUTO_TEST_CASE(Predict)
+{
+  MobilityPrefetcher prefetcher;
+  BOOST_CHECK(prefetcher.AddSpatialName("/S/West"));
+  BOOST_CHECK(prefetcher.AddSpatialName("/S/East/Road"));
+  BOOST_CHECK(prefetcher.AddSpatialName("/S/East/Square"));
+  BOOST_CHECK(!prefetcher.AddSpatialName("/S/North"));
+  BOOST_CHECK_EQUAL(prefetcher.GetNSpatialNames(), 3);
+
+  Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel>();
+  mobility->SetPosition(Vector(100, 0, 0));
+  mobility->SetVelocity(Vector(20, 0, 0));
+
+  const Name* name = prefetcher.Predict(mobility, Seconds(0));
+  BOOST_REQUIRE(name != nullptr);
+  BOOST_CHECK_EQUAL(*name, "/S/West");
+
+  // at 700 m after 30 s
+  name = prefetcher.Predict(mobility, Seconds(30));
+  BOOST_REQUIRE(name != nullptr);
+  BOOST_CHECK_EQUAL(*name, "/S/East/Road");
+
+  // the square is closer, but only within its radius
+  mobility->SetPosition(Vector(1000, 300, 0));
+  mobility->SetVelocity(Vector(0, 10, 0));
+  name = prefetcher.Predict(mobility, Seconds(0));
+  BOOST_REQUIRE(name != nullptr);
+  BOOST_CHECK_EQUAL(*name, "/S/East/Road");
+  name = prefetcher.Predict(mobility, Seconds(20));
+  BOOST_REQUIRE(name != nullptr);
+  BOOST_CHECK_EQUAL(*name, "/S/East/Square");
+
+  MobilityPrefetcher empty;
+  BOOST_CHECK(empty.Predict(mobility, Seconds(1)) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(RateLimit)
+{
+  MobilityPrefetcher prefetcher;
+  int nAcquired = 0;
+  for (int i = 0; i < 100; ++i) {
+    acquire(&prefetcher, &nAcquired);
+  }
+  BOOST_CHECK_EQUAL(nAcquired, 100);
+
+  prefetcher.SetRateLimit(10, 5);
+  nAcquired = 0;
+  for (int i = 0; i < 100; ++i) {
+    Simulator::Schedule(MilliSeconds(i * 10), &MobilityPrefetcherFixture::acquire, this,
+                        &prefetcher, &nAcquired);
+  }
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  // the burst, then one every 100 ms (up to rounding at the token boundaries)
+  BOOST_CHECK_GE(nAcquired, 5 + 8);
+  BOOST_CHECK_LE(nAcquired, 5 + 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
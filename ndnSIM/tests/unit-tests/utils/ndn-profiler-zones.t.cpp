@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-profiler-zones.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/test/output_test_stream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProfilerZonesFixture : public CleanupFixture
+{
+public:
+  ~ProfilerZonesFixture()
+  {
+    ProfilerZones::Disable();
+  }
+
+  static void
+  work()
+  {
+    ProfilerZones::Scope outer("Outer");
+    ProfilerZones::Scope inner("Inner");
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnProfilerZones, ProfilerZonesFixture)
+
+BOOST_AUTO_TEST_CASE(Record)
+{
+  ProfilerZonesFixture::work();
+  BOOST_CHECK_EQUAL(ProfilerZones::GetNZones(), 0);
+
+  ProfilerZones::Enable("");
+  BOOST_CHECK(ProfilerZones::IsEnabled());
+  Simulator::Schedule(MilliSeconds(200), &ProfilerZonesFixture::work);
+  Simulator::Schedule(MilliSeconds(700), &ProfilerZonesFixture::work);
+  Simulator::Schedule(MilliSeconds(1500), &ProfilerZonesFixture::work);
+  Simulator::Run();
+
+  // 3 x 2 zones, and the markers of simulated seconds 0 and 1
+  BOOST_CHECK_EQUAL(ProfilerZones::GetNZones(), 8);
+
+  boost::test_tools::output_test_stream os;
+  ProfilerZones::WriteTrace(os);
+  std::string trace = os.str();
+  BOOST_CHECK(trace.find("{\"name\":\"Outer\",\"pid\":1,\"tid\":1,\"ts\":") != std::string::npos);
+  BOOST_CHECK(trace.find("\"ph\":\"X\",\"dur\":") != std::string::npos);
+  BOOST_CHECK(trace.find("\"args\":{\"sim\":1.5}") != std::string::npos);
+  BOOST_CHECK(trace.find("{\"name\":\"SimulatedSecond\"") != std::string::npos);
+
+  ProfilerZones::Disable();
+  BOOST_CHECK(!ProfilerZones::IsEnabled());
+  BOOST_CHECK_EQUAL(ProfilerZones::GetNZones(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(MaxZones)
+{
+  ProfilerZones::Enable("", 5);
+  for (int i = 0; i < 10; ++i) {
+    ProfilerZonesFixture::work();
+  }
+  BOOST_CHECK_LE(ProfilerZones::GetNZones(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-push-cache.hpp"
+
+#include "model/ndn-net-device-face.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnPushCache, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Correlativity)
+{
+  Ptr<PushCache> pushCache = CreateObject<PushCache>();
+  pushCache->SetAttribute("SpatialThreshold", DoubleValue(0.1));
+  pushCache->SetAttribute("ApplicationThreshold", DoubleValue(0.1));
+
+  Name served("/S/District/Road/A/Traffic/%FE%01");
+  BOOST_CHECK_GT(pushCache->GetCorrelativity(served, "/S/District/Square/A/Traffic/%FE%02"), 0.0);
+  BOOST_CHECK_EQUAL(pushCache->GetCorrelativity(served, "/S/Elsewhere/A/Traffic/%FE%02"), 0.0);
+  BOOST_CHECK_EQUAL(pushCache->GetCorrelativity(served, "/S/District/Road/A/Weather/Now"), 0.0);
+  BOOST_CHECK_EQUAL(pushCache->GetCorrelativity(served, "/prefix/%FE%02"), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(PushToNeighbor)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  // vehicles 1 and 3 around the road side unit 2
+  createTopology({
+      {"1", "2"},
+      {"3", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/S", 1},
+      {"3", "2", "/S", 1},
+    });
+
+  Ptr<PushCache> pushCache = PushCache::Install(getNode("2"));
+  pushCache->SetAttribute("SpatialThreshold", DoubleValue(0.1));
+  pushCache->SetAttribute("ApplicationThreshold", DoubleValue(0.1));
+  pushCache->SetAttribute("MaxPushes", UintegerValue(100));
+  PushCache::InstallReceiver(getNode("1"));
+
+  addApps({
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/S"}, {"PayloadSize", "100"}, {"Freshness", "100s"}},
+          "0s", "100s"},
+      // Data served recently are not pushed
+      {"3", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/District/Road/A/Traffic"}, {"Frequency", "10"}, {"MaxSeq", "10"}},
+          "0s", "2s"},
+      {"3", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/Elsewhere/A/Traffic"}, {"Frequency", "10"}, {"MaxSeq", "10"}},
+          "0s", "2s"},
+      // pushes what vehicle 3 got about the district, and nothing else
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/District/Square/A/Traffic"}, {"Frequency", "10"}, {"MaxSeq", "1"}},
+          "15s", "16s"},
+      // from the own content store
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/S/District/Road/A/Traffic"}, {"Frequency", "10"}, {"MaxSeq", "5"}},
+          "20s", "21s"},
+    });
+
+  Simulator::Stop(Seconds(30));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(pushCache->GetNPushed(), 10);
+  auto rsuFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("2", "1"));
+  BOOST_REQUIRE(rsuFace != nullptr);
+  BOOST_CHECK_EQUAL(rsuFace->getNPushedData(), 10);
+
+  auto vehicleFace = std::dynamic_pointer_cast<NetDeviceFace>(getFace("1", "2"));
+  BOOST_REQUIRE(vehicleFace != nullptr);
+  BOOST_CHECK_EQUAL(vehicleFace->getNOverheardData(), 10);
+  BOOST_CHECK_EQUAL(vehicleFace->getFaceStatus().getNOutInterests(), 1);
+  BOOST_CHECK_EQUAL(getNode("1")->GetObject<L3Protocol>()->getForwarder()->getCs().size(), 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-request-trace.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace ns3 {
+namespace ndn {
+
+class RequestTraceFixture
+{
+public:
+  ~RequestTraceFixture()
+  {
+    std::remove(file.c_str());
+  }
+
+  void
+  writeCsv(const std::string& content)
+  {
+    std::ofstream os(file);
+    os << content;
+  }
+
+public:
+  std::string file = "request-trace-test.log";
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRequestTrace, RequestTraceFixture)
+
+BOOST_AUTO_TEST_CASE(Csv)
+{
+  writeCsv("time,node,name\n"
+           "# comment\n"
+           "0.5,car1,/S/A/a\n"
+           "\n"
+           "1.0,3,/S/A/b\r\n"
+           "1.5,car2,/S/A/c\n"
+           "2.0,car1,/S/A/d");
+
+  RequestTraceReader reader(file, 3, "car1");
+  BOOST_CHECK(!reader.isBinary());
+
+  RequestTraceReader::Request request;
+  BOOST_REQUIRE(reader.next(request));
+  BOOST_CHECK_EQUAL(request.time, Seconds(0.5));
+  BOOST_CHECK_EQUAL(request.name, Name("/S/A/a"));
+  BOOST_REQUIRE(reader.next(request));
+  BOOST_CHECK_EQUAL(request.time, Seconds(1.0));
+  BOOST_CHECK_EQUAL(request.name, Name("/S/A/b"));
+  BOOST_REQUIRE(reader.next(request));
+  BOOST_CHECK_EQUAL(request.time, Seconds(2.0));
+  BOOST_CHECK_EQUAL(request.name, Name("/S/A/d"));
+  BOOST_CHECK(!reader.next(request));
+  BOOST_CHECK(!reader.next(request));
+
+  RequestTraceReader other(file, 1);
+  BOOST_CHECK(!other.next(request));
+}
+
+BOOST_AUTO_TEST_CASE(CsvMalformed)
+{
+  writeCsv("0.5,1,/S/A/a\n"
+           "x,1,/S/A/b\n");
+
+  RequestTraceReader reader(file, 1);
+  RequestTraceReader::Request request;
+  BOOST_CHECK(reader.next(request));
+  BOOST_CHECK_THROW(reader.next(request), std::runtime_error);
+
+  // malformed requests of other nodes are not parsed
+  RequestTraceReader other(file, 2);
+  BOOST_CHECK(!other.next(request));
+
+  writeCsv("0.5;1;/S/A/a\n");
+  RequestTraceReader noCommas(file, 1);
+  BOOST_CHECK_THROW(noCommas.next(request), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(Binary)
+{
+  {
+    RequestTraceWriter writer(file);
+    for (uint32_t i = 0; i < 1000; ++i) {
+      writer.write(MilliSeconds(i), i % 3, Name("/S/A").appendNumber(i));
+    }
+  }
+
+  RequestTraceReader reader(file, 1, "1");
+  BOOST_CHECK(reader.isBinary());
+
+  RequestTraceReader::Request request;
+  uint32_t n = 0;
+  while (reader.next(request)) {
+    uint32_t i = 3 * n + 1;
+    BOOST_CHECK_EQUAL(request.time, MilliSeconds(i));
+    BOOST_CHECK_EQUAL(request.name, Name("/S/A").appendNumber(i));
+    ++n;
+  }
+  BOOST_CHECK_EQUAL(n, 333);
+
+  // truncated in the middle of a request
+  std::ifstream is(file, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  is.close();
+  {
+    std::ofstream os(file, std::ios::binary | std::ios::trunc);
+    os.write(content.data(), content.size() - 3);
+  }
+  RequestTraceReader truncated(file, 0);
+  BOOST_CHECK_THROW(while (truncated.next(request)) {}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(MissingFile)
+{
+  BOOST_CHECK_THROW(RequestTraceReader("/nonexistent/request-trace.log", 0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-rtt-hint-table.hpp"
+
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRttHintTable, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Prefix)
+{
+  BOOST_CHECK_EQUAL(RttHintTag::GetPrefix(Name("/S/NankaiDistrict/WeijingRoad/A/Traffic/%FE%01")),
+                    Name("/S/NankaiDistrict/WeijingRoad"));
+  BOOST_CHECK_EQUAL(RttHintTag::GetPrefix(Name("/prefix/%FE%01")), Name("/prefix"));
+}
+
+BOOST_AUTO_TEST_CASE(TagSerialization)
+{
+  Ptr<Packet> packet = Create<Packet>();
+  packet->AddPacketTag(RttHintTag(MilliSeconds(30), MicroSeconds(4500), 7));
+
+  Ptr<Packet> copy = packet->Copy();
+  RttHintTag hint;
+  BOOST_REQUIRE(copy->PeekPacketTag(hint));
+  BOOST_CHECK_EQUAL(hint.GetSrtt(), MilliSeconds(30));
+  BOOST_CHECK_EQUAL(hint.GetRttvar(), MicroSeconds(4500));
+  BOOST_CHECK_EQUAL(hint.GetNSamples(), 7);
+}
+
+BOOST_AUTO_TEST_CASE(Statistics)
+{
+  Ptr<RttHintTable> table = CreateObject<RttHintTable>();
+  table->SetAttribute("MaxAge", TimeValue(Seconds(10)));
+  Name name1("/S/NankaiDistrict/A/Traffic/%FE%01");
+  Name name2("/S/NankaiDistrict/A/Weather/%FE%02");
+
+  RttHintTag hint;
+  BOOST_CHECK(!table->GetHint(name1, hint));
+
+  table->Measurement(name1, MilliSeconds(80));
+  table->Measurement(name2, MilliSeconds(40)); // same spatial prefix
+  BOOST_CHECK_EQUAL(table->GetNPrefixes(), 1);
+
+  BOOST_REQUIRE(table->GetHint(Name("/S/NankaiDistrict/A/Other/%FE%03"), hint));
+  BOOST_CHECK_EQUAL(hint.GetNSamples(), 2);
+  BOOST_CHECK_EQUAL(hint.GetSrtt(), MilliSeconds(75));   // 80 - 40 / 8
+  BOOST_CHECK_EQUAL(hint.GetRttvar(), MilliSeconds(40)); // 40 + (40 - 40) / 4
+
+  // outdated statistics are not piggybacked and start over with the next sample
+  Simulator::Stop(Seconds(11));
+  Simulator::Run();
+  BOOST_CHECK(!table->GetHint(name1, hint));
+  table->Measurement(name1, MilliSeconds(20));
+  BOOST_REQUIRE(table->GetHint(name1, hint));
+  BOOST_CHECK_EQUAL(hint.GetNSamples(), 1);
+  BOOST_CHECK_EQUAL(hint.GetSrtt(), MilliSeconds(20));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-rtt-mean-deviation.hpp"
+
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class RttMeanDeviationFixture : public CleanupFixture
+{
+public:
+  RttMeanDeviationFixture()
+    : rtt(CreateObject<RttMeanDeviation>())
+    , nChecks(0)
+  {
+    prefixes.push_back(Name("/S/NankaiDistrict/WeijingRoad/A/TrafficInformer/RoadCongestion"));
+    prefixes.push_back(Name("/S/NankaiDistrict/NanjingRoad/BinjiangStreet/A/TrafficInformer/RoadStatus"));
+    prefixes.push_back(Name("/S/HepingDistrict/A/Weather/Forecast"));
+  }
+
+  Name
+  makeName(uint32_t seq)
+  {
+    return Name(prefixes[seq % prefixes.size()]).appendSequenceNumber(seq);
+  }
+
+  void
+  send(uint32_t seq)
+  {
+    rtt->SetInterestInfo(makeName(seq), SequenceNumber32(seq), 1, Seconds(1));
+  }
+
+  void
+  ack(uint32_t seq)
+  {
+    rtt->AckSeq(makeName(seq), SequenceNumber32(seq));
+  }
+
+  void
+  ackFrom(uint32_t seq, int32_t hopCount)
+  {
+    rtt->AckSeq(makeName(seq), SequenceNumber32(seq), hopCount);
+  }
+
+  void
+  discard(uint32_t seq)
+  {
+    rtt->DiscardInterestBySeq(SequenceNumber32(seq));
+  }
+
+  void
+  check(uint32_t seq)
+  {
+    Name name = makeName(seq);
+    Time expected = rtt->CalRTObyCorrelativityFullScan(name);
+    Time actual = rtt->CalRTObyCorrelativity(name);
+    BOOST_CHECK_CLOSE(actual.ToDouble(Time::S), expected.ToDouble(Time::S), 1e-6);
+
+    Name unrelated("/S/Elsewhere/A/Other/Thing");
+    unrelated.appendSequenceNumber(seq);
+    BOOST_CHECK_EQUAL(rtt->CalRTObyCorrelativity(unrelated),
+                      rtt->CalRTObyCorrelativityFullScan(unrelated));
+    ++nChecks;
+  }
+
+public:
+  Ptr<RttMeanDeviation> rtt;
+  std::vector<Name> prefixes;
+  int nChecks;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRttMeanDeviation, RttMeanDeviationFixture)
+
+BOOST_AUTO_TEST_CASE(CorrelativityMatchesFullScan)
+{
+  const uint32_t nInterests = 1200; // 10 minutes, longer than the 3 minute window
+
+  for (uint32_t seq = 0; seq < nInterests; ++seq) {
+    Time sendTime = MilliSeconds(500 * seq);
+    Simulator::Schedule(sendTime, &RttMeanDeviationFixture::send, this, seq);
+
+    if (seq % 7 == 3) {
+      // retransmitted Interest, its sample is not used
+      Simulator::Schedule(sendTime + MilliSeconds(200), &RttMeanDeviationFixture::send, this, seq);
+      Simulator::Schedule(sendTime + MilliSeconds(300), &RttMeanDeviationFixture::ack, this, seq);
+    }
+    else if (seq % 11 == 5) {
+      // Interest is given up
+      Simulator::Schedule(sendTime + MilliSeconds(400), &RttMeanDeviationFixture::discard, this,
+                          seq);
+    }
+    else if (seq % 13 != 7) { // otherwise, Interest stays unanswered
+      Simulator::Schedule(sendTime + MilliSeconds(20 + 7 * (seq % 17)),
+                          &RttMeanDeviationFixture::ack, this, seq);
+    }
+
+    if (seq % 50 == 49) {
+      Simulator::Schedule(sendTime + MilliSeconds(450), &RttMeanDeviationFixture::check, this,
+                          nInterests + seq);
+    }
+  }
+
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nChecks, nInterests / 50);
+}
+
+BOOST_AUTO_TEST_CASE(CopyKeepsCorrelativity)
+{
+  for (uint32_t seq = 0; seq < 10; ++seq) {
+    Simulator::Schedule(MilliSeconds(100 * seq), &RttMeanDeviationFixture::send, this, seq);
+    Simulator::Schedule(MilliSeconds(100 * seq + 30 + seq), &RttMeanDeviationFixture::ack, this,
+                        seq);
+  }
+  Simulator::Run();
+
+  Ptr<RttEstimator> copy = rtt->Copy();
+  Name name = makeName(100);
+  BOOST_CHECK_EQUAL(copy->CalRTObyCorrelativity(name), rtt->CalRTObyCorrelativity(name));
+}
+
+void
+countEvictions(uint32_t* total, uint32_t oldValue, uint32_t newValue)
+{
+  *total = newValue;
+}
+
+BOOST_AUTO_TEST_CASE(HistoryWindow)
+{
+  rtt->SetAttribute("HistoryWindow", TimeValue(Seconds(10)));
+  rtt->SetAttribute("AgeingGranularity", TimeValue(Seconds(5)));
+
+  uint32_t nEvicted = 0;
+  rtt->TraceConnectWithoutContext("HistoryEvictions",
+                                  MakeBoundCallback(&countEvictions, &nEvicted));
+
+  for (uint32_t seq = 0; seq < 10; ++seq) {
+    Simulator::Schedule(Seconds(seq), &RttMeanDeviationFixture::send, this, seq);
+    Simulator::Schedule(Seconds(seq) + MilliSeconds(50), &RttMeanDeviationFixture::ack, this, seq);
+  }
+  // records 0..5 were received more than 10 seconds ago
+  Simulator::Schedule(Seconds(15) + MilliSeconds(100), &RttMeanDeviationFixture::check, this, 100);
+  // within AgeingGranularity from the previous pass, nothing is aged
+  Simulator::Schedule(Seconds(17) + MilliSeconds(100), &RttMeanDeviation::CalRTObyCorrelativity,
+                      rtt, makeName(101));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nEvicted, 6);
+  BOOST_CHECK_EQUAL(nChecks, 1);
+}
+
+BOOST_AUTO_TEST_CASE(SharedKnowledgeBase)
+{
+  for (uint32_t seq = 0; seq < 5; ++seq) {
+    Simulator::Schedule(MilliSeconds(100 * seq), &RttMeanDeviationFixture::send, this, seq);
+    Simulator::Schedule(MilliSeconds(100 * seq + 30 + seq), &RttMeanDeviationFixture::ack, this,
+                        seq);
+  }
+  Simulator::Run();
+
+  // samples acknowledged before the knowledge base is set are moved to it
+  Ptr<CorrelativityKnowledgeBase> knowledgeBase = CreateObject<CorrelativityKnowledgeBase>();
+  rtt->SetKnowledgeBase(knowledgeBase);
+  BOOST_CHECK_EQUAL(knowledgeBase->GetNSamples(), 5);
+
+  for (uint32_t seq = 5; seq < 10; ++seq) {
+    send(seq);
+    Simulator::Schedule(MilliSeconds(40 + seq), &RttMeanDeviationFixture::ack, this, seq);
+  }
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(knowledgeBase->GetNSamples(), 10);
+
+  // an estimator without samples of its own uses the samples of the other one
+  Ptr<RttMeanDeviation> other = CreateObject<RttMeanDeviation>();
+  other->SetKnowledgeBase(knowledgeBase);
+  Name name = makeName(100);
+  BOOST_CHECK_CLOSE(other->CalRTObyCorrelativity(name).ToDouble(Time::S),
+                    rtt->CalRTObyCorrelativityFullScan(name).ToDouble(Time::S), 1e-6);
+
+  // same sequence numbers of different estimators are different samples
+  other->SetInterestInfo(makeName(0), SequenceNumber32(0), 1, Seconds(1));
+  Simulator::Schedule(MilliSeconds(10), &RttMeanDeviation::AckSeq, other, makeName(0),
+                      SequenceNumber32(0));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(knowledgeBase->GetNSamples(), 11);
+
+  // copies do not share, destroyed estimators withdraw their samples
+  BOOST_CHECK(DynamicCast<RttMeanDeviation>(rtt->Copy())->GetKnowledgeBase() == 0);
+  rtt = 0;
+  BOOST_CHECK_EQUAL(knowledgeBase->GetNSamples(), 1);
+  other->Reset();
+  BOOST_CHECK_EQUAL(knowledgeBase->GetNSamples(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RttHints)
+{
+  rtt->SetAttribute("MaxHintSamples", UintegerValue(4));
+  Name name = makeName(0);
+
+  // without samples and hints, RTO is the initial one
+  Time initialRto = rtt->CalRTObyCorrelativity(name);
+
+  rtt->AddRttHint(name, MilliSeconds(300), MilliSeconds(50), 20);
+  BOOST_CHECK_EQUAL(rtt->GetCurrentEstimate(), MilliSeconds(300));
+  BOOST_CHECK_CLOSE(rtt->CalRTObyCorrelativity(name).ToDouble(Time::S), 0.5, 1e-6);
+  BOOST_CHECK_EQUAL(rtt->CalRTObyCorrelativity(makeName(2)), initialRto); // other prefix
+
+  // hint weights 4 samples against one seeded and one measured
+  send(0);
+  Simulator::Schedule(MilliSeconds(250), &RttMeanDeviationFixture::ack, this, 0);
+  Simulator::Run();
+  BOOST_CHECK_CLOSE(rtt->CalRTObyCorrelativity(name).ToDouble(Time::S),
+                    (4 * 0.5 + 2 * 0.25) / 6, 1e-6);
+
+  // hints are dropped after HistoryWindow
+  Simulator::Stop(Minutes(4));
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(rtt->CalRTObyCorrelativity(makeName(3)), initialRto);
+}
+
+BOOST_AUTO_TEST_CASE(HopStratified)
+{
+  // Interests of the first prefix, two thirds answered by a cache 1 hop away in 300 ms,
+  // the others by the producer 6 hops away in 900 ms
+  for (uint32_t i = 0; i < 9; ++i) {
+    uint32_t seq = 3 * i;
+    bool isCacheHit = i % 3 != 2;
+    Simulator::Schedule(Seconds(i), &RttMeanDeviationFixture::send, this, seq);
+    Simulator::Schedule(Seconds(i) + MilliSeconds(isCacheHit ? 300 : 900),
+                        &RttMeanDeviationFixture::ackFrom, this, seq, isCacheHit ? 1 : 6);
+  }
+  Simulator::Run();
+
+  Name name = makeName(300);
+  Time mixed = rtt->CalRTObyCorrelativity(name);
+  BOOST_CHECK_GT(mixed.ToDouble(Time::S), 0.3);
+  BOOST_CHECK_LT(mixed.ToDouble(Time::S), 0.9);
+  BOOST_CHECK_CLOSE(mixed.ToDouble(Time::S),
+                    rtt->CalRTObyCorrelativityFullScan(name).ToDouble(Time::S), 1e-6);
+
+  // the name is predicted to be served by the cache
+  rtt->SetAttribute("HopStratified", BooleanValue(true));
+  BOOST_CHECK_CLOSE(rtt->CalRTObyCorrelativity(name).ToDouble(Time::S), 0.3, 1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-shared-input.hpp"
+#include "utils/ndn-alias-table.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SharedInputFixture : public CleanupFixture
+{
+public:
+  SharedInputFixture()
+    : directory("shared-input-test")
+  {
+  }
+
+  ~SharedInputFixture()
+  {
+    SharedInput::SetDirectory("");
+    boost::filesystem::remove_all(directory);
+  }
+
+public:
+  std::string directory;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSharedInput, SharedInputFixture)
+
+BOOST_AUTO_TEST_CASE(Open)
+{
+  boost::filesystem::create_directories(directory);
+  std::string file = directory + "/input";
+  {
+    std::ofstream os(file.c_str());
+    os << "first";
+  }
+
+  std::shared_ptr<const SharedInput> input = SharedInput::Open(file);
+  BOOST_REQUIRE_EQUAL(input->GetSize(), 5);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(input->GetData()), 5), "first");
+  // mapped once per process
+  BOOST_CHECK_EQUAL(SharedInput::Open(file), input);
+
+  // a replaced file is mapped again, the previous mapping keeps the previous content
+  std::string replacement = directory + "/replacement";
+  {
+    std::ofstream os(replacement.c_str());
+    os << "second!";
+  }
+  BOOST_REQUIRE_EQUAL(std::rename(replacement.c_str(), file.c_str()), 0);
+  std::shared_ptr<const SharedInput> replaced = SharedInput::Open(file);
+  BOOST_CHECK_NE(replaced, input);
+  BOOST_CHECK_EQUAL(replaced->GetSize(), 7);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(input->GetData()), 5), "first");
+
+  BOOST_CHECK_THROW(SharedInput::Open(directory + "/no-such-file"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(GetOrCreate)
+{
+  int nWritten = 0;
+  auto write = [&nWritten] (std::ostream& os) {
+    ++nWritten;
+    os << "content";
+  };
+
+  BOOST_CHECK(!SharedInput::IsEnabled());
+  BOOST_CHECK(SharedInput::GetOrCreate("input", write) == nullptr);
+  BOOST_CHECK_EQUAL(nWritten, 0);
+
+  SharedInput::SetDirectory(directory);
+  BOOST_CHECK(SharedInput::IsEnabled());
+  std::shared_ptr<const SharedInput> input = SharedInput::GetOrCreate("input", write);
+  BOOST_REQUIRE(input != nullptr);
+  BOOST_CHECK_EQUAL(nWritten, 1);
+  BOOST_CHECK_EQUAL(input->GetSize(), 7);
+
+  // another replication only maps it
+  input.reset();
+  input = SharedInput::GetOrCreate("input", write);
+  BOOST_CHECK_EQUAL(nWritten, 1);
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(input->GetData()), 7), "content");
+}
+
+BOOST_AUTO_TEST_CASE(PopularityTable)
+{
+  std::vector<double> weights = {1, 2, 3, 4, 0, 10};
+  AliasTable table;
+  table.build(weights);
+
+  SharedInput::SetDirectory(directory);
+  std::shared_ptr<const SharedInput> input =
+    SharedInput::GetOrCreate("table", [&table] (std::ostream& os) { table.save(os); });
+
+  AliasTable attached;
+  BOOST_REQUIRE(attached.attach(input->GetData(), input->GetSize()));
+  BOOST_CHECK_EQUAL(attached.size(), table.size());
+  for (double u = 0.0; u < 1.0; u += 0.001) {
+    BOOST_CHECK_EQUAL(attached.sample(u), table.sample(u));
+  }
+
+  // copies of an attached table use the same memory, copies of a built one their own
+  AliasTable copy = table;
+  table.build(std::vector<double>(2, 1.0));
+  BOOST_CHECK_EQUAL(copy.size(), weights.size());
+  BOOST_CHECK_EQUAL(copy.sample(0.9), attached.sample(0.9));
+
+  BOOST_CHECK(!attached.attach(input->GetData(), input->GetSize() - 1));
+  BOOST_CHECK_EQUAL(attached.size(), weights.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
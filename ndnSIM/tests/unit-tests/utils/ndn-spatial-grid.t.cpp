@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-spatial-grid.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/simulator.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SpatialGridFixture : public CleanupFixture
+{
+public:
+  Ptr<Node>
+  createNode(const Vector& position, const Vector& velocity)
+  {
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel>();
+    mobility->SetPosition(position);
+    mobility->SetVelocity(velocity);
+    node->AggregateObject(mobility);
+    nodes.Add(node);
+    return node;
+  }
+
+  std::set<uint32_t>
+  getIds(const std::vector<Ptr<Node>>& nodes)
+  {
+    std::set<uint32_t> ids;
+    for (const Ptr<Node>& node : nodes) {
+      ids.insert(node->GetId());
+    }
+    return ids;
+  }
+
+  std::set<uint32_t>
+  getIdsInRange(const Vector& position, double range)
+  {
+    std::set<uint32_t> ids;
+    for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+      if (CalculateDistance((*node)->GetObject<MobilityModel>()->GetPosition(), position) <= range)
+        ids.insert((*node)->GetId());
+    }
+    return ids;
+  }
+
+  void
+  check(const SpatialGrid* grid, std::vector<Vector> positions, double range)
+  {
+    for (const Vector& position : positions) {
+      if (getIds(grid->GetNodesInRange(position, range)) != getIdsInRange(position, range))
+        ++nInconsistent;
+    }
+  }
+
+public:
+  NodeContainer nodes;
+  int nInconsistent = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSpatialGrid, SpatialGridFixture)
+
+BOOST_AUTO_TEST_CASE(Static)
+{
+  Ptr<Node> a = createNode(Vector(0, 0, 0), Vector(0, 0, 0));
+  Ptr<Node> b = createNode(Vector(150, 0, 0), Vector(0, 0, 0));
+  Ptr<Node> c = createNode(Vector(-90, -90, 0), Vector(0, 0, 0));
+  createNode(Vector(1000, 1000, 0), Vector(0, 0, 0));
+
+  SpatialGrid grid(100);
+  grid.Install(nodes);
+  BOOST_CHECK_EQUAL(grid.GetNNodes(), 4);
+
+  BOOST_CHECK(getIds(grid.GetNodesInRange(Vector(0, 0, 0), 150)) ==
+              std::set<uint32_t>({a->GetId(), b->GetId(), c->GetId()}));
+  BOOST_CHECK(getIds(grid.GetNeighbors(a, 140)) == std::set<uint32_t>({c->GetId()}));
+  BOOST_CHECK(grid.GetNodesInRange(Vector(500, 500, 0), 100).empty());
+
+  BOOST_CHECK_THROW(SpatialGrid(0), std::invalid_argument);
+  BOOST_CHECK_THROW(grid.Add(CreateObject<Node>()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Moving)
+{
+  // a column of vehicles moves through a row of parked ones
+  for (int i = 0; i < 20; ++i) {
+    createNode(Vector(i * 50, 0, 0), Vector(0, 0, 0));
+    createNode(Vector(-500, i * 10, 0), Vector(20, -1.5, 0));
+  }
+
+  SpatialGrid grid(100);
+  grid.Install(nodes);
+
+  std::vector<Vector> positions = {Vector(0, 0, 0), Vector(300, 10, 0), Vector(950, -20, 0)};
+  for (int step = 1; step <= 60; ++step) {
+    Simulator::Schedule(Seconds(step), &SpatialGridFixture::check, this,
+                        &grid, positions, 120.0);
+  }
+
+  Simulator::Stop(Seconds(61));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(nInconsistent, 0);
+  BOOST_CHECK_GT(grid.GetNCellChanges(), 20 * 10);
+
+  // a course change moves the node right away
+  Ptr<Node> node = nodes.Get(1);
+  node->GetObject<MobilityModel>()->SetPosition(Vector(5000, 5000, 0));
+  BOOST_CHECK(getIds(grid.GetNodesInRange(Vector(5000, 5000, 0), 1)) ==
+              std::set<uint32_t>({node->GetId()}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-steady-state-detector.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/test/output_test_stream.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class SteadyStateDetectorFixture : public CleanupFixture
+{
+public:
+  ~SteadyStateDetectorFixture()
+  {
+    SteadyStateDetector::Disable();
+    SteadyStateDetector::SetMinBatches(10);
+    SteadyStateDetector::SetStopOnConvergence(true);
+    SteadyStateDetector::SetWarmedUpCallback(nullptr);
+    SteadyStateDetector::SetConvergedCallback(nullptr);
+  }
+
+  /**
+   * @brief Record a delay of 100 ms, with some noise, after a warm-up of 50 s whose delays
+   *        start at 1 s and decrease
+   */
+  static void
+  consume()
+  {
+    double now = Simulator::Now().ToDouble(Time::S);
+    double delay = 0.1 + (now < 50 ? 0.9 * (50 - now) / 50 : 0) + (int(now * 10) % 3) * 0.001;
+    SteadyStateDetector::RecordDelay(Seconds(delay));
+    SteadyStateDetector::RecordSatisfied();
+    Simulator::Schedule(MilliSeconds(100), &SteadyStateDetectorFixture::consume);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnSteadyStateDetector, SteadyStateDetectorFixture)
+
+BOOST_AUTO_TEST_CASE(Truncation)
+{
+  std::vector<double> batches = {5, 4, 3, 2, 1, 1.1, 0.9, 1, 1.1, 0.9, 1, 1.1, 0.9, 1};
+  BOOST_CHECK_EQUAL(SteadyStateDetector::FindTruncation(batches), 4);
+
+  std::vector<double> stable = {1, 1.1, 0.9, 1, 1.1, 0.9, 1, 1.1};
+  BOOST_CHECK_EQUAL(SteadyStateDetector::FindTruncation(stable), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Estimate)
+{
+  SteadyStateDetector::Estimate estimate = SteadyStateDetector::EstimateMean({1, 2, 3, 4, 5},
+                                                                             0.95);
+  BOOST_CHECK_EQUAL(estimate.nBatches, 5);
+  BOOST_CHECK_CLOSE(estimate.mean, 3, 0.001);
+  // t(0.975, 4) * sqrt(2.5 / 5)
+  BOOST_CHECK_CLOSE(estimate.halfWidth, 2.776 * std::sqrt(0.5), 0.01);
+  BOOST_CHECK(!estimate.IsPrecise(0.5));
+  BOOST_CHECK(estimate.IsPrecise(0.7));
+
+  // batches without samples are skipped
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  estimate = SteadyStateDetector::EstimateMean({nan, 2, 2}, 0.95);
+  BOOST_CHECK_EQUAL(estimate.nBatches, 2);
+  BOOST_CHECK_EQUAL(estimate.halfWidth, 0);
+}
+
+BOOST_AUTO_TEST_CASE(StopOnConvergence)
+{
+  bool isWarmedUp = false;
+  bool hasConverged = false;
+  SteadyStateDetector::SetWarmedUpCallback([&] { isWarmedUp = true; });
+  SteadyStateDetector::SetConvergedCallback([&] { hasConverged = true; });
+  SteadyStateDetector::Enable(Seconds(5), 0.01);
+
+  // nothing to measure before the consumers start
+  Simulator::Schedule(Seconds(20), &SteadyStateDetectorFixture::consume);
+  Simulator::Stop(Seconds(1000));
+  Simulator::Run();
+
+  BOOST_CHECK(isWarmedUp);
+  BOOST_CHECK(hasConverged);
+  BOOST_CHECK(SteadyStateDetector::HasConverged());
+  BOOST_CHECK_LT(Simulator::Now().ToDouble(Time::S), 200);
+
+  // the decreasing delays are truncated
+  BOOST_CHECK_GE(SteadyStateDetector::GetWarmupEnd().ToDouble(Time::S), 40);
+  BOOST_CHECK_LE(SteadyStateDetector::GetWarmupEnd().ToDouble(Time::S), 60);
+
+  SteadyStateDetector::Estimate delay = SteadyStateDetector::GetDelay();
+  BOOST_CHECK_CLOSE(delay.mean, 0.101, 1);
+  BOOST_CHECK_CLOSE(SteadyStateDetector::GetSatisfaction().mean, 1, 0.001);
+
+  boost::test_tools::output_test_stream os;
+  SteadyStateDetector::Print(os);
+  BOOST_CHECK(os.str().find("# converged at ") != std::string::npos);
+  BOOST_CHECK(os.str().find("\nSatisfaction\t") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(NoConvergence)
+{
+  SteadyStateDetector::Enable(Seconds(5), 0.01);
+  Simulator::Stop(Seconds(100));
+  Simulator::Run();
+
+  BOOST_CHECK(!SteadyStateDetector::IsWarmedUp());
+  BOOST_CHECK(!SteadyStateDetector::HasConverged());
+  BOOST_CHECK_EQUAL(SteadyStateDetector::GetDelay().nBatches, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-strategy-replay.hpp"
+#include "utils/tracers/ndn-strategy-tracer.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class StrategyReplayFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  StrategyReplayFixture()
+    : trace(make_shared<std::stringstream>())
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.99s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    Ptr<StrategyTracer> tracer = StrategyTracer::Install(getNode("2"), trace);
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+  }
+
+  ~StrategyReplayFixture()
+  {
+    StrategyTracer::Destroy();
+  }
+
+public:
+  shared_ptr<std::stringstream> trace;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnStrategyReplay, StrategyReplayFixture)
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  uint64_t upstreamId = getFace("2", "3")->getId();
+
+  for (const std::string& strategy : {"/localhost/nfd/strategy/best-route",
+                                      "/localhost/nfd/strategy/multicast"}) {
+    BOOST_TEST_MESSAGE(strategy);
+    trace->clear();
+    trace->seekg(0);
+
+    StrategyReplay replay(strategy);
+    auto decisions = make_shared<std::stringstream>();
+    replay.SetDecisionStream(decisions);
+    replay.Load(*trace);
+
+    Simulator::Stop(Seconds(2.0));
+    Simulator::Run();
+
+    BOOST_CHECK_EQUAL(replay.GetTriggerStats(strategy_trace::AfterReceiveInterest).nCalls, 10);
+    BOOST_CHECK_EQUAL(replay.GetTriggerStats(strategy_trace::BeforeSatisfyInterest).nCalls, 10);
+    BOOST_CHECK_EQUAL(replay.GetTriggerStats(strategy_trace::BeforeSatisfyInterest).nSkipped, 0);
+    BOOST_CHECK_EQUAL(replay.GetTriggerStats(strategy_trace::BeforeExpirePendingInterest).nCalls, 0);
+    BOOST_CHECK_EQUAL(replay.GetNInterests(), 10);
+    BOOST_CHECK_EQUAL(replay.GetNNacks(), 0);
+
+    std::string time, decision, name;
+    uint64_t faceId;
+    int nDecisions = 0;
+    while (*decisions >> time >> faceId >> decision >> name) {
+      BOOST_CHECK_EQUAL(faceId, upstreamId);
+      BOOST_CHECK_EQUAL(decision, "Interest");
+      ++nDecisions;
+    }
+    BOOST_CHECK_EQUAL(nDecisions, 10);
+
+    std::ostringstream report;
+    replay.PrintReport(report);
+    BOOST_CHECK(report.str().find("AfterReceiveInterest\t10\t0\t") != std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Errors)
+{
+  BOOST_CHECK_THROW(StrategyReplay("/localhost/nfd/strategy/unknown"), std::invalid_argument);
+
+  StrategyReplay replay("/localhost/nfd/strategy/best-route");
+  std::istringstream malformed(std::string("\xC8\x03\xD3\x01\x01", 5)); // AfterReceiveInterest without Time
+  BOOST_CHECK_THROW(replay.Load(malformed), tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/ndn-thread-confinement.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnThreadConfinement, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Nested)
+{
+  ThreadConfinement confinement;
+  {
+    ThreadConfinement::Scope outer(confinement);
+    ThreadConfinement::Scope inner(confinement);
+  }
+
+  // released by the outermost scope, another thread may take over
+  bool isEntered = false;
+  std::thread thread([&] {
+      ThreadConfinement::Scope scope(confinement);
+      isEntered = true;
+    });
+  thread.join();
+  BOOST_CHECK(isEntered);
+
+  ThreadConfinement::Scope scope(confinement);
+}
+
+BOOST_AUTO_TEST_CASE(Independent)
+{
+  // every node has its own confinement, different nodes run concurrently
+  std::vector<ThreadConfinement> confinements(4);
+  std::vector<std::thread> threads;
+  std::atomic<int> nEntered{0};
+  for (ThreadConfinement& confinement : confinements) {
+    threads.emplace_back([&] {
+        for (int i = 0; i < 1000; ++i) {
+          ThreadConfinement::Scope scope(confinement);
+          ++nEntered;
+        }
+      });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(nEntered, 4000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-virtual-payload.hpp"
+#include "model/ndn-ns3.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnVirtualPayload)
+
+BOOST_AUTO_TEST_CASE(ToPacketAndBack)
+{
+  Data data(Name("/prefix/1"));
+  data.setSignature(Signature(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)),
+                              ::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0)));
+  data.wireEncode();
+  BOOST_CHECK_EQUAL(getVirtualPayloadSize(data), 0);
+
+  setVirtualPayload(data, 10000);
+  BOOST_CHECK_EQUAL(getVirtualPayloadSize(data), 10000);
+  BOOST_CHECK_EQUAL(data.getContent().value_size(), 0);
+
+  Ptr<Packet> packet = Convert::ToPacket(data);
+  BOOST_CHECK_EQUAL(packet->GetSize(), data.wireEncode().size() + 10000);
+
+  // next hop sends packets of the same size
+  shared_ptr<const Data> received = Convert::FromPacket<Data>(packet);
+  BOOST_CHECK_EQUAL(received->getName(), data.getName());
+  BOOST_CHECK_EQUAL(getVirtualPayloadSize(*received), 10000);
+  BOOST_CHECK_EQUAL(Convert::ToPacket(*received)->GetSize(), data.wireEncode().size() + 10000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-model.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_READER_TOPO = boost::filesystem::path(TEST_CONFIG_PATH) / "reader-topo.txt";
+const boost::filesystem::path TEST_READER_CACHE = boost::filesystem::path(TEST_CONFIG_PATH) / "reader-topo.cache";
+
+class AnnotatedTopologyReaderFixture : public CleanupFixture
+{
+public:
+  AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    std::ofstream file(TEST_READER_TOPO.string().c_str());
+    file << "router\n\n"
+         << "#node city  y x mpi-partition\n"
+         << "A  NA  1 2\n"
+         << "B  NA  80  -40\n"
+         << "C\n\n"
+         << "link\n\n"
+         << "# comment\n"
+         << "A  B  10Mbps  100  1ms  100\n"
+         << "B  A  10Mbps  100\n"
+         << "B  C  1Mbps  1  5ms  20\n";
+  }
+
+  ~AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::remove(TEST_READER_TOPO);
+    boost::filesystem::remove(TEST_READER_CACHE);
+  }
+
+  void
+  check(AnnotatedTopologyReader& reader)
+  {
+    NodeContainer nodes = reader.Read();
+    BOOST_REQUIRE_EQUAL(nodes.GetN(), 3);
+    BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(0)), "A");
+    BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(2)), "C");
+
+    Vector position = nodes.Get(0)->GetObject<MobilityModel>()->GetPosition();
+    BOOST_CHECK_EQUAL(position.x, 2);
+    BOOST_CHECK_EQUAL(position.y, -1);
+
+    // reverse duplicate is skipped
+    BOOST_REQUIRE_EQUAL(reader.GetLinks().size(), 2);
+    const TopologyReader::Link& link = reader.GetLinks().back();
+    BOOST_CHECK_EQUAL(link.GetFromNodeName(), "B");
+    BOOST_CHECK_EQUAL(link.GetToNodeName(), "C");
+    BOOST_CHECK_EQUAL(link.GetAttribute("Delay"), "5ms");
+    BOOST_CHECK_EQUAL(link.GetAttribute("MaxPackets"), "20");
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyAnnotatedTopologyReader, AnnotatedTopologyReaderFixture)
+
+BOOST_AUTO_TEST_CASE(Read)
+{
+  AnnotatedTopologyReader reader("");
+  reader.SetFileName(TEST_READER_TOPO.string());
+  check(reader);
+}
+
+BOOST_AUTO_TEST_CASE(Cache)
+{
+  {
+    AnnotatedTopologyReader reader("");
+    reader.SetFileName(TEST_READER_TOPO.string());
+    reader.SetCacheFile(TEST_READER_CACHE.string());
+    check(reader);
+  }
+  BOOST_CHECK(boost::filesystem::exists(TEST_READER_CACHE));
+  Names::Clear();
+
+  // now from the cache
+  AnnotatedTopologyReader reader("");
+  reader.SetFileName(TEST_READER_TOPO.string());
+  reader.SetCacheFile(TEST_READER_CACHE.string());
+  check(reader);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-aggregation-tracer.hpp"
+#include "helper/ndn-strategy-choice-helper.hpp"
+
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class AggregationTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  AggregationTracerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    // 1   2
+    //  \ /      3 multicasts to all neighbors, consumers on 1 and 2 request
+    //   3       the same names 5ms apart
+    //   |
+    //   4
+    createTopology({
+        {"1", "3"},
+        {"2", "3"},
+        {"3", "4"}
+      });
+
+    addRoutes({
+        {"1", "3", "/prefix", 1},
+        {"2", "3", "/prefix", 1},
+        {"3", "1", "/prefix", 1},
+        {"3", "2", "/prefix", 1},
+        {"3", "4", "/prefix", 1}
+      });
+    StrategyChoiceHelper::Install(getNode("3"), "/prefix", "/localhost/nfd/strategy/multicast");
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "0.99s"},
+        {"2", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0.005s", "0.99s"},
+        {"4", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~AggregationTracerFixture()
+  {
+    AggregationTracer::Destroy();
+  }
+
+  /// runs the scenario and returns the trace of node 3, by type
+  std::map<std::string, double>
+  run()
+  {
+    auto output = make_shared<std::stringstream>();
+    Ptr<AggregationTracer> tracer = AggregationTracer::Install(getNode("3"), output, Seconds(1));
+
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+
+    tracer = nullptr; // destroy tracer
+
+    std::map<std::string, double> values;
+    std::string time, node, prefix, type;
+    double value;
+    while (*output >> time >> node >> prefix >> type >> value) {
+      BOOST_CHECK_EQUAL(node, "3");
+      BOOST_CHECK_EQUAL(prefix, "/prefix");
+      values[type] = value;
+    }
+    return values;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnAggregationTracer, AggregationTracerFixture)
+
+BOOST_AUTO_TEST_CASE(NoHold)
+{
+  std::map<std::string, double> values = run();
+
+  // Interests of 2 are aggregated, but those of 1 are multicast to 2 before 2 requests them
+  BOOST_CHECK_EQUAL(values["InInterests"], 20);
+  BOOST_CHECK_EQUAL(values["AggregatedInterests"], 10);
+  BOOST_CHECK_EQUAL(values["AggregationRatio"], 0.5);
+  BOOST_CHECK_GE(getFace("3", "2")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("3", "4")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_GT(values["OutInterests"], 10);
+}
+
+BOOST_AUTO_TEST_CASE(Hold)
+{
+  StrategyChoiceHelper::SetAggregationHold(getNode("3"), "/prefix", MilliSeconds(10));
+
+  std::map<std::string, double> values = run();
+
+  // both downstreams are known when the hold expires
+  BOOST_CHECK_EQUAL(values["InInterests"], 20);
+  BOOST_CHECK_EQUAL(values["AggregatedInterests"], 10);
+  BOOST_CHECK_EQUAL(values["OutInterests"], 10);
+  BOOST_CHECK_EQUAL(getFace("3", "1")->getFaceStatus().getNOutInterests(), 0);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getFaceStatus().getNOutInterests(), 0);
+  BOOST_CHECK_EQUAL(getFace("3", "4")->getFaceStatus().getNOutInterests(), 10);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getFaceStatus().getNInDatas(), 10);
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNInDatas(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,7 @@
  **/
 
 #include "utils/tracers/ndn-app-delay-tracer.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
@@ -28,6 +29,7 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
 
 class AppDelayTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -68,6 +70,7 @@ public:
   ~AppDelayTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
     AppDelayTracer::Destroy(); // additional cleanup
   }
 };
@@ -157,6 +160,58 @@ BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
     "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n"));
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  AppDelayTracer::InstallAll(TEST_BINARY_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  BinaryTraceReader::ConvertToText(TEST_BINARY_TRACE.string(), TEST_TRACE.string());
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417424	1	0	0	LastDelay	0.0417424	41742.4	1	2\n"
+    "0.0417424	1	0	0	FullDelay	0.0417424	41742.4	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02087	2	0	1	LastDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllSummary)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1.5));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  Simulator::Destroy(); // writes the last period
+  AppDelayTracer::Destroy();
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Type	Count	Mean	P50	P95	P99	Max\n"
+    "1.5	1	0	LastDelay	1	0.0417424	0.0417424	0.0417424	0.0417424	0.0417424\n"
+    "1.5	1	0	FullDelay	1	0.0417424	0.0417424	0.0417424	0.0417424	0.0417424\n"
+    "1.5	1	0	RetxCount	1	1	1	1	1	1\n"
+    "3	2	0	LastDelay	1	0	0	0	0	0\n"
+    "3	2	0	FullDelay	1	0	0	0	0	0\n"
+    "3	2	0	RetxCount	1	1	1	1	1	1\n"
+    "4	2	0	LastDelay	1	0.0208712	0.0208712	0.0208712	0.0208712	0.0208712\n"
+    "4	2	0	FullDelay	1	0.0208712	0.0208712	0.0208712	0.0208712	0.0208712\n"
+    "4	2	0	RetxCount	1	1	1	1	1	1\n");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-async-trace-writer.hpp"
+#include "utils/tracers/ndn-app-delay-tracer.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_DIR = boost::filesystem::path(TEST_CONFIG_PATH);
+
+class AsyncTraceWriterFixture : public CleanupFixture
+{
+public:
+  AsyncTraceWriterFixture()
+  {
+    boost::filesystem::create_directories(TEST_DIR);
+  }
+
+  ~AsyncTraceWriterFixture()
+  {
+    AsyncTraceWriter::Disable();
+    boost::filesystem::remove(TEST_DIR / "trace.txt");
+    boost::filesystem::remove(TEST_DIR / "trace.txt.gz");
+    boost::filesystem::remove(TEST_DIR / "trace.txt.zst");
+  }
+
+  static std::string
+  readFile(const boost::filesystem::path& file)
+  {
+    std::ifstream is(file.string().c_str(), std::ios_base::binary);
+    std::stringstream buffer;
+    buffer << is.rdbuf();
+    return buffer.str();
+  }
+
+  static std::string
+  makeTrace(int nRows)
+  {
+    std::ostringstream os;
+    for (int i = 0; i < nRows; ++i) {
+      os << i * 0.5 << "\t" << i << "\tInInterests\t" << i * 1.5 << "\n";
+    }
+    return os.str();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnAsyncTraceWriter, AsyncTraceWriterFixture)
+
+BOOST_AUTO_TEST_CASE(Synchronous)
+{
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open((TEST_DIR / "trace.txt").string());
+  BOOST_REQUIRE(os != nullptr);
+  *os << makeTrace(10);
+  os = nullptr;
+  BOOST_CHECK_EQUAL(readFile(TEST_DIR / "trace.txt"), makeTrace(10));
+
+  BOOST_CHECK(AsyncTraceWriter::Open((TEST_DIR / "missing" / "trace.txt").string()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Asynchronous)
+{
+  AsyncTraceWriter::Enable(256); // much smaller than the trace, the writer has to wait
+  BOOST_CHECK(AsyncTraceWriter::IsEnabled());
+
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open((TEST_DIR / "trace.txt").string());
+  BOOST_REQUIRE(os != nullptr);
+  for (int i = 0; i < 10000; ++i) {
+    *os << i * 0.5 << "\t" << i << "\tInInterests\t" << i * 1.5 << "\n";
+  }
+
+  AsyncTraceWriter::Flush();
+  BOOST_CHECK_EQUAL(readFile(TEST_DIR / "trace.txt"), makeTrace(10000));
+
+  *os << "last\n";
+  os = nullptr; // closes the file
+  BOOST_CHECK_EQUAL(readFile(TEST_DIR / "trace.txt"), makeTrace(10000) + "last\n");
+}
+
+BOOST_AUTO_TEST_CASE(Compressed)
+{
+  AsyncTraceWriter::Enable();
+
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open((TEST_DIR / "trace.txt.gz").string());
+  BOOST_REQUIRE(os != nullptr);
+  *os << makeTrace(1000);
+  os = nullptr;
+
+  std::ifstream file((TEST_DIR / "trace.txt.gz").string().c_str(), std::ios_base::binary);
+  boost::iostreams::filtering_istream is;
+  is.push(boost::iostreams::gzip_decompressor());
+  is.push(file);
+  std::stringstream buffer;
+  buffer << is.rdbuf();
+  BOOST_CHECK_EQUAL(buffer.str(), makeTrace(1000));
+  BOOST_CHECK_LT(boost::filesystem::file_size(TEST_DIR / "trace.txt.gz"), makeTrace(1000).size());
+}
+
+BOOST_AUTO_TEST_CASE(CompressedRoundTrip)
+{
+  AsyncTraceWriter::Enable();
+
+  for (const std::string& name : {"trace.txt", "trace.txt.gz", "trace.txt.zst"}) {
+    const std::string file = (TEST_DIR / name).string();
+    if (!AsyncTraceWriter::IsCompressionSupported(file)) {
+      BOOST_CHECK(AsyncTraceWriter::Open(file) == nullptr);
+      continue;
+    }
+    BOOST_CHECK_EQUAL(AsyncTraceWriter::StripCompressionSuffix(file), (TEST_DIR / "trace.txt").string());
+
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+    BOOST_REQUIRE(os != nullptr);
+    *os << makeTrace(10000);
+    os = nullptr;
+
+    shared_ptr<std::istream> is = AsyncTraceWriter::OpenForReading(file);
+    BOOST_REQUIRE(is != nullptr);
+    std::stringstream buffer;
+    buffer << is->rdbuf();
+    BOOST_CHECK_EQUAL(buffer.str(), makeTrace(10000));
+  }
+
+  BOOST_CHECK(AsyncTraceWriter::OpenForReading((TEST_DIR / "missing.txt.gz").string()) == nullptr);
+  BOOST_CHECK_EQUAL(AsyncTraceWriter::StripCompressionSuffix(".gz"), ".gz");
+}
+
+BOOST_AUTO_TEST_CASE(FlushOnDestroy)
+{
+  AsyncTraceWriter::Enable();
+
+  ScenarioHelper helper;
+  helper.createTopology({
+      {"1", "2"},
+    });
+  helper.addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+  helper.addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "0.95s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+  AppDelayTracer::InstallAll((TEST_DIR / "trace.txt").string());
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+  Simulator::Destroy(); // the tracers still exist, but their output is on disk
+
+  std::string trace = readFile(TEST_DIR / "trace.txt");
+  BOOST_CHECK_EQUAL(trace.substr(0, trace.find('\n')),
+                    "Time\tNode\tAppId\tSeqNo\tType\tDelayS\tDelayUS\tRetxCount\tHopCount");
+  BOOST_CHECK_EQUAL(std::count(trace.begin(), trace.end(), '\n'), 1 + 2 * 10);
+
+  AppDelayTracer::Destroy();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnBinaryTrace)
+
+BOOST_AUTO_TEST_CASE(WriteRead)
+{
+  auto os = make_shared<std::ostringstream>();
+  {
+    BinaryTraceWriter writer(os, {
+        {"Time", BinaryTraceWriter::TIME},
+        {"Node", BinaryTraceWriter::NAME},
+        {"FaceId", BinaryTraceWriter::INT32},
+        {"Type", BinaryTraceWriter::NAME},
+        {"Packets", BinaryTraceWriter::FLOAT},
+        {"Bytes", BinaryTraceWriter::DOUBLE}
+      }, 3); // several blocks
+
+    for (int i = 0; i < 10; ++i) {
+      writer << MilliSeconds(500 * i) << (i % 2 == 0 ? "router" : "consumer") << int32_t(i - 1)
+             << "InInterests" << 1.5 * i << 1024.0 * i;
+    }
+  }
+
+  std::istringstream is(os->str());
+  BinaryTraceReader reader(is);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 6);
+  BOOST_CHECK_EQUAL(reader.GetColumns()[3].name, "Type");
+  BOOST_CHECK_EQUAL(reader.GetColumns()[3].type, BinaryTraceWriter::NAME);
+
+  int i = 0;
+  for (; reader.Next(); ++i) {
+    BOOST_CHECK_EQUAL(reader.GetTime(0), MilliSeconds(500 * i));
+    BOOST_CHECK_EQUAL(reader.GetName(1), i % 2 == 0 ? "router" : "consumer");
+    BOOST_CHECK_EQUAL(reader.GetNumber(2), i - 1);
+    BOOST_CHECK_EQUAL(reader.GetName(3), "InInterests");
+    BOOST_CHECK_CLOSE(reader.GetNumber(4), 1.5 * i, 0.0001);
+    BOOST_CHECK_EQUAL(reader.GetNumber(5), 1024.0 * i);
+    BOOST_CHECK_THROW(reader.GetNumber(1), std::invalid_argument);
+  }
+  BOOST_CHECK_EQUAL(i, 10);
+
+  std::istringstream is2(os->str());
+  BinaryTraceReader reader2(is2);
+  std::ostringstream text;
+  reader2.PrintHeader(text);
+  text << "\n";
+  reader2.Next();
+  reader2.Next();
+  reader2.PrintRow(text);
+  BOOST_CHECK_EQUAL(text.str(),
+                    "Time\tNode\tFaceId\tType\tPackets\tBytes\n"
+                    "0.5\tconsumer\t0\tInInterests\t1.5\t1024\n");
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  std::istringstream notTrace("Time\tNode\tType\tPackets\n");
+  BOOST_CHECK_THROW(BinaryTraceReader{notTrace}, std::runtime_error);
+
+  auto os = make_shared<std::ostringstream>();
+  {
+    BinaryTraceWriter writer(os, {{"Time", BinaryTraceWriter::TIME}});
+    writer << Seconds(1) << Seconds(2);
+  }
+  std::string truncated = os->str().substr(0, os->str().size() - 4);
+  std::istringstream is(truncated);
+  BinaryTraceReader reader(is);
+  BOOST_CHECK_THROW(reader.Next(), std::runtime_error);
+
+  BOOST_CHECK(BinaryTraceWriter::IsBinaryFile("rate-trace.bin"));
+  BOOST_CHECK(!BinaryTraceWriter::IsBinaryFile("rate-trace.txt"));
+  BOOST_CHECK(!BinaryTraceWriter::IsBinaryFile(".bin"));
+  BOOST_CHECK(BinaryTraceWriter::IsBinaryFile("rate-trace.bin.gz"));
+  BOOST_CHECK(BinaryTraceWriter::IsBinaryFile("rate-trace.bin.zst"));
+  BOOST_CHECK(!BinaryTraceWriter::IsBinaryFile("rate-trace.txt.zst"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-consumer-event-tracer.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include "ns3/constant-position-mobility-model.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_EVENT_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "consumer-trace.txt";
+const boost::filesystem::path TEST_EVENT_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "consumer-trace.bin";
+
+class ConsumerEventTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ConsumerEventTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+    mobility->SetPosition(Vector(10.5, 20, 0));
+    getNode("1")->AggregateObject(mobility);
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "0.9s"}, // send just one packet
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~ConsumerEventTracerFixture()
+  {
+    boost::filesystem::remove(TEST_EVENT_TRACE);
+    boost::filesystem::remove(TEST_EVENT_BINARY_TRACE);
+    ConsumerEventTracer::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnConsumerEventTracer, ConsumerEventTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallAll)
+{
+  ConsumerEventTracer::InstallAll(TEST_EVENT_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  ConsumerEventTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_EVENT_TRACE.string().c_str());
+  std::string header, interest, data, extra;
+  std::getline(t, header);
+  std::getline(t, interest);
+  std::getline(t, data);
+  BOOST_CHECK(!std::getline(t, extra));
+
+  BOOST_CHECK_EQUAL(header, "Time\tNode\tAppId\tType\tPrefix\tSeqNo\tRto\tX\tY");
+
+  std::vector<std::string> fields;
+  boost::split(fields, interest, boost::is_any_of("\t"));
+  BOOST_REQUIRE_EQUAL(fields.size(), 9);
+  BOOST_CHECK_EQUAL(fields[0], "0");
+  BOOST_CHECK_EQUAL(fields[1], "1");
+  BOOST_CHECK_EQUAL(fields[3], "Interest");
+  BOOST_CHECK_EQUAL(fields[4], "/prefix");
+  BOOST_CHECK_EQUAL(fields[5], "0");
+  BOOST_CHECK_GT(boost::lexical_cast<double>(fields[6]), 0.0);
+  BOOST_CHECK_EQUAL(fields[7], "10.5");
+  BOOST_CHECK_EQUAL(fields[8], "20");
+
+  BOOST_CHECK_EQUAL(data, "0.0417424\t1\t0\tData\t/prefix\t0\t0\t10.5\t20");
+}
+
+BOOST_AUTO_TEST_CASE(InstallNodeWithoutConsumers)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  Ptr<ConsumerEventTracer> tracer = ConsumerEventTracer::Install(getNode("3"), output);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  BOOST_CHECK(output->is_empty()); // producers have no consumer trace sources
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  ConsumerEventTracer::InstallAll(TEST_EVENT_BINARY_TRACE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  ConsumerEventTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_EVENT_BINARY_TRACE.string().c_str(), std::ios_base::binary);
+  BinaryTraceReader reader(is);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 9);
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetName(3), "Interest");
+  BOOST_CHECK_EQUAL(reader.GetName(4), "/prefix");
+  BOOST_CHECK_EQUAL(reader.GetNumber(5), 0);
+  BOOST_CHECK_GT(reader.GetTime(6), Time(0));
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_CLOSE(reader.GetTime(0).ToDouble(Time::S), 0.0417424, 0.001);
+  BOOST_CHECK_EQUAL(reader.GetName(1), "1");
+  BOOST_CHECK_EQUAL(reader.GetName(3), "Data");
+  BOOST_CHECK_EQUAL(reader.GetName(4), "/prefix");
+  BOOST_CHECK_EQUAL(reader.GetTime(6), Time(0));
+  BOOST_CHECK_EQUAL(reader.GetNumber(7), 10.5);
+  BOOST_CHECK_EQUAL(reader.GetNumber(8), 20);
+
+  BOOST_CHECK(!reader.Next());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
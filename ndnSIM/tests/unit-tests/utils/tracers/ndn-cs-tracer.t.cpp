@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-cs-tracer.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_CS_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "cs-trace.txt";
+const boost::filesystem::path TEST_CS_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "cs-trace.bin";
+
+class CsTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  CsTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    // cache hits and misses are traced only by ndnSIM's content store
+    getStackHelper().SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    // the second consumer requests the first Data of the first one from the cache of node 1
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix/a"}, {"Frequency", "1"}},
+            "0s", "1.9s"}, // send two packets
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix/a"}, {"Frequency", "1"}},
+            "0.5s", "1.4s"}, // send one packet
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~CsTracerFixture()
+  {
+    boost::filesystem::remove(TEST_CS_TRACE);
+    boost::filesystem::remove(TEST_CS_BINARY_TRACE);
+    CsTracer::Destroy(); // additional cleanup
+  }
+
+  static std::vector<std::string>
+  split(const std::string& line)
+  {
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of("\t"));
+    return fields;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnCsTracer, CsTracerFixture)
+
+BOOST_AUTO_TEST_CASE(PerNode)
+{
+  CsTracer::Install(getNode("1"), TEST_CS_TRACE.string(), Seconds(2));
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_CS_TRACE.string().c_str());
+  std::string header, hits, misses;
+  std::getline(t, header);
+  std::getline(t, hits);
+  std::getline(t, misses);
+
+  BOOST_CHECK_EQUAL(header, "Time\tNode\tType\tPackets\t");
+  BOOST_CHECK_EQUAL(hits, "2\t1\tCacheHits\t1");
+  BOOST_CHECK_EQUAL(misses, "2\t1\tCacheMisses\t2");
+}
+
+BOOST_AUTO_TEST_CASE(PerPrefix)
+{
+  CsTracer::InstallAll(TEST_CS_TRACE.string(), Seconds(2), 2);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_CS_TRACE.string().c_str());
+  std::string header;
+  std::getline(t, header);
+  BOOST_CHECK_EQUAL(header, "Time\tNode\tPrefix\tCacheHits\tCacheMisses\tHitRatio");
+
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(t, line)) {
+    lines.push_back(line);
+  }
+
+  // Interest names are not traced beyond two components, /prefix/a/<seq>
+  BOOST_REQUIRE_EQUAL(lines.size(), 6);
+  BOOST_CHECK_EQUAL(lines[0], "2\t1\t/prefix\t1\t2\t0.333333");
+  BOOST_CHECK_EQUAL(lines[1], "2\t1\t/prefix/a\t1\t2\t0.333333");
+  BOOST_CHECK_EQUAL(lines[2], "2\t2\t/prefix\t0\t2\t0");
+  BOOST_CHECK_EQUAL(lines[3], "2\t2\t/prefix/a\t0\t2\t0");
+  BOOST_CHECK_EQUAL(split(lines[4])[1], "3");
+}
+
+BOOST_AUTO_TEST_CASE(PerPrefixBinary)
+{
+  CsTracer::Install(getNode("1"), TEST_CS_BINARY_TRACE.string(), Seconds(2), 1);
+
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  CsTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_CS_BINARY_TRACE.string().c_str(), std::ios_base::binary);
+  BinaryTraceReader reader(is);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 6);
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetTime(0), Seconds(2));
+  BOOST_CHECK_EQUAL(reader.GetName(1), "1");
+  BOOST_CHECK_EQUAL(reader.GetName(2), "/prefix");
+  BOOST_CHECK_EQUAL(reader.GetNumber(3), 1);
+  BOOST_CHECK_EQUAL(reader.GetNumber(4), 2);
+  BOOST_CHECK_CLOSE(reader.GetNumber(5), 1.0 / 3, 0.001);
+  BOOST_CHECK(!reader.Next());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
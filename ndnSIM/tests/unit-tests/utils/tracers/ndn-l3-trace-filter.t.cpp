@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-l3-trace-filter.hpp"
+
+#include "ns3/node.h"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3TraceFilter, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Everything)
+{
+  L3TraceFilter filter;
+  BOOST_CHECK(filter.IsEverything());
+  BOOST_CHECK(filter.Accept("/"));
+  BOOST_CHECK(filter.Accept("/S/addr_1/A"));
+  BOOST_CHECK_EQUAL(filter.GetWeight(), 1.0);
+  BOOST_CHECK(filter.IsSampledNode(CreateObject<Node>()));
+}
+
+BOOST_AUTO_TEST_CASE(Prefixes)
+{
+  L3TraceFilter filter;
+  filter.AddPrefix("/S/addr_0");
+
+  L3TraceFilter copy = filter;
+  copy.AddPrefix("/B");
+
+  BOOST_CHECK(!filter.IsEverything());
+  BOOST_CHECK(filter.Accept("/S/addr_0"));
+  BOOST_CHECK(filter.Accept("/S/addr_0/A/TrafficInformer/%FE%01"));
+  BOOST_CHECK(!filter.Accept("/S/addr_1/A"));
+  BOOST_CHECK(!filter.Accept("/S"));
+  BOOST_CHECK(!filter.Accept("/B/1"));
+
+  // copies do not share added prefixes
+  BOOST_CHECK(copy.Accept("/B/1"));
+  BOOST_CHECK(copy.Accept("/S/addr_0/A"));
+}
+
+BOOST_AUTO_TEST_CASE(PacketSampling)
+{
+  L3TraceFilter filter;
+  filter.SetPacketSamplingRate(0.25);
+  BOOST_CHECK(!filter.IsEverything());
+  BOOST_CHECK_EQUAL(filter.GetWeight(), 4.0);
+
+  int nAccepted = 0;
+  for (int i = 0; i < 10000; ++i) {
+    Name name("/prefix");
+    name.appendSequenceNumber(i);
+    bool isAccepted = filter.Accept(name);
+    BOOST_CHECK_EQUAL(filter.Accept(name), isAccepted); // same decision for the same name
+    nAccepted += isAccepted;
+  }
+  BOOST_CHECK_GT(nAccepted, 2250);
+  BOOST_CHECK_LT(nAccepted, 2750);
+
+  BOOST_CHECK_THROW(filter.SetPacketSamplingRate(0), std::invalid_argument);
+  BOOST_CHECK_THROW(filter.SetPacketSamplingRate(1.5), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(NodeSampling)
+{
+  L3TraceFilter filter;
+  filter.SetNodeSamplingRate(0.5);
+
+  int nSampled = 0;
+  for (int i = 0; i < 1000; ++i) {
+    nSampled += filter.IsSampledNode(CreateObject<Node>());
+  }
+  BOOST_CHECK_GT(nSampled, 400);
+  BOOST_CHECK_LT(nSampled, 600);
+
+  BOOST_CHECK_THROW(filter.SetNodeSamplingRate(-1), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-l3-trace-hub.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "helper/ndn-scenario-helper.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnL3TraceHub, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(SharedByTracers)
+{
+  ScenarioHelper helper;
+  helper.createTopology({
+      {"1", "2"},
+    });
+  helper.addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+  helper.addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "1s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "100s"}
+    });
+
+  Ptr<Node> node = helper.getNode("1");
+  auto hubOutput = make_shared<std::ostringstream>();
+  auto otherOutput = make_shared<std::ostringstream>();
+  auto legacyOutput = make_shared<std::ostringstream>();
+  Ptr<L3RateTracer> hubTracer = L3RateTracer::Install(node, hubOutput, Seconds(0.5));
+  Ptr<L3RateTracer> otherTracer = L3RateTracer::Install(node, otherOutput, Seconds(0.5));
+
+  // a filter accepting every packet, which still connects the tracer to the node
+  L3TraceFilter filter;
+  filter.AddPrefix("/");
+  Ptr<L3RateTracer> legacyTracer = L3RateTracer::Install(node, legacyOutput, Seconds(0.5), filter);
+
+  Ptr<L3TraceHub> hub = node->GetObject<L3TraceHub>();
+  BOOST_REQUIRE(hub != nullptr);
+  BOOST_CHECK(L3TraceHub::Get(node) == hub);
+
+  Simulator::Stop(Seconds(2));
+  Simulator::Run();
+
+  const std::vector<L3TraceHub::Counters>& counters = hub->GetCounters();
+  BOOST_REQUIRE_GE(counters.size(), 3); // all faces, the consumer and the link
+  BOOST_CHECK(hub->GetFace(0) == nullptr);
+  BOOST_CHECK_EQUAL(counters[0].packets[L3TraceHub::SATISFIED_INTERESTS], 10);
+
+  uint64_t nInData = 0;
+  uint64_t nInDataBytes = 0;
+  for (size_t slot = 1; slot < counters.size(); ++slot) {
+    BOOST_CHECK(hub->GetFace(slot) != nullptr);
+    nInData += counters[slot].packets[L3TraceHub::IN_DATA];
+    nInDataBytes += counters[slot].bytes[L3TraceHub::IN_DATA];
+  }
+  BOOST_CHECK_EQUAL(nInData, 10);
+  BOOST_CHECK_GT(nInDataBytes, 10 * 100);
+
+  BOOST_CHECK(!hubOutput->str().empty());
+  BOOST_CHECK_EQUAL(hubOutput->str(), otherOutput->str());
+  BOOST_CHECK_EQUAL(hubOutput->str(), legacyOutput->str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
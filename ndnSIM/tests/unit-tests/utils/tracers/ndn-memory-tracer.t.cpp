@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-memory-tracer.hpp"
+
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class MemoryTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  MemoryTracerFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~MemoryTracerFixture()
+  {
+    MemoryTracer::Destroy();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnMemoryTracer, MemoryTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<MemoryTracer> tracer = MemoryTracer::Install(getNode("1"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  std::map<std::string, std::vector<size_t>> bytes;
+  std::string time, node, table;
+  size_t nBytes;
+  while (*output >> time >> node >> table >> nBytes) {
+    BOOST_CHECK_EQUAL(node, "1");
+    bytes[table].push_back(nBytes);
+  }
+
+  for (const std::string& name : {"NameTree", "Pit", "Cs", "DeadNonceList", "Measurements",
+                                  "Consumers"}) {
+    BOOST_REQUIRE_MESSAGE(bytes[name].size() == 2, name + " is printed every period");
+  }
+  BOOST_CHECK_GT(bytes["NameTree"].back(), 0);
+  BOOST_CHECK_GT(bytes["Cs"].back(), 10 * 1024);
+  BOOST_CHECK_GT(bytes["Consumers"].back(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
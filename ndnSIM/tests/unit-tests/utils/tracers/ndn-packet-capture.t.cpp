@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-packet-capture.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_CAPTURE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "packets.cap";
+const boost::filesystem::path TEST_CAPTURE_INDEX =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "packets.cap.idx";
+
+class PacketCaptureFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  PacketCaptureFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "1.9s"}, // send two packets
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~PacketCaptureFixture()
+  {
+    boost::filesystem::remove(TEST_CAPTURE);
+    boost::filesystem::remove(TEST_CAPTURE_INDEX);
+    PacketCapture::Destroy(); // additional cleanup
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnPacketCapture, PacketCaptureFixture)
+
+BOOST_AUTO_TEST_CASE(CaptureAndQuery)
+{
+  PacketCapture::InstallAll(TEST_CAPTURE.string());
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  PacketCapture::Destroy(); // to close the capture
+
+  PacketCaptureReader reader(TEST_CAPTURE.string());
+  BOOST_CHECK(boost::filesystem::exists(TEST_CAPTURE_INDEX));
+
+  // each Interest and its Data are received and sent once by every node
+  BOOST_CHECK_EQUAL(reader.GetSize(), 24);
+
+  std::vector<PacketCaptureReader::Record> records;
+  reader.ForEach([&records] (const PacketCaptureReader::Record& record) {
+      records.push_back(record);
+    });
+  BOOST_REQUIRE_EQUAL(records.size(), 24);
+
+  // the Interest from the consumer on node 1
+  BOOST_CHECK_EQUAL(records[0].time, Seconds(0));
+  BOOST_CHECK_EQUAL(records[0].node, 0);
+  BOOST_CHECK_EQUAL(records[0].type, PacketCaptureWriter::INTEREST);
+  BOOST_CHECK_EQUAL(records[0].direction, PacketCaptureWriter::IN);
+
+  Name first = Name("/prefix").appendSequenceNumber(0);
+  BOOST_CHECK_EQUAL(records[0].GetName(), first);
+  Interest interest(records[0].GetWire());
+  BOOST_CHECK_EQUAL(interest.getName(), first);
+
+  // the Data returned to the consumer
+  BOOST_CHECK_EQUAL(records[11].time, Seconds(0.0417424));
+  BOOST_CHECK_EQUAL(records[11].type, PacketCaptureWriter::DATA);
+  BOOST_CHECK_EQUAL(records[11].direction, PacketCaptureWriter::OUT);
+  Data data(records[11].GetWire());
+  BOOST_CHECK_EQUAL(data.getName(), first);
+  BOOST_CHECK_EQUAL(data.getContent().value_size(), 1024);
+
+  auto ignore = [] (const PacketCaptureReader::Record&) {};
+  BOOST_CHECK_EQUAL(reader.Query("/prefix", Seconds(0), Time::Max(), ignore), 24);
+  BOOST_CHECK_EQUAL(reader.Query(first, Seconds(0), Time::Max(), ignore), 12);
+  BOOST_CHECK_EQUAL(reader.Query("/pre", Seconds(0), Time::Max(), ignore), 0);
+  BOOST_CHECK_EQUAL(reader.Query("/", Seconds(0.5), Seconds(2), ignore), 12);
+  BOOST_CHECK_EQUAL(reader.Query("/", Seconds(0.5), Seconds(1), ignore), 0);
+
+  // later readers load the saved index
+  PacketCaptureReader reloaded(TEST_CAPTURE.string());
+  BOOST_CHECK_EQUAL(reloaded.GetSize(), 24);
+  BOOST_CHECK_EQUAL(reloaded.Query(first, Seconds(0), Time::Max(), ignore), 12);
+}
+
+BOOST_AUTO_TEST_CASE(NotACapture)
+{
+  {
+    std::ofstream os(TEST_CAPTURE.string().c_str());
+    os << "Time\tNode\tFaceId\n";
+  }
+  BOOST_CHECK_THROW(PacketCaptureReader(TEST_CAPTURE.string()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
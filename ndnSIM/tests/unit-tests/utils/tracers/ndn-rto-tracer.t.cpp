@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "utils/tracers/ndn-rto-tracer.hpp"
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_RTO_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "rto-trace.txt";
+const boost::filesystem::path TEST_RTO_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "rto-trace.bin";
+
+class RtoTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RtoTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+            "0s", "1.9s"}, // send two packets
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~RtoTracerFixture()
+  {
+    boost::filesystem::remove(TEST_RTO_TRACE);
+    boost::filesystem::remove(TEST_RTO_BINARY_TRACE);
+    RtoTracer::Destroy(); // additional cleanup
+  }
+
+  static std::vector<std::string>
+  split(const std::string& line)
+  {
+    std::vector<std::string> fields;
+    boost::split(fields, line, boost::is_any_of("\t"));
+    return fields;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnRtoTracer, RtoTracerFixture)
+
+BOOST_AUTO_TEST_CASE(PerInterest)
+{
+  RtoTracer::InstallAll(TEST_RTO_TRACE.string(), Seconds(0));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  RtoTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_RTO_TRACE.string().c_str());
+  std::string header, first, second, extra;
+  std::getline(t, header);
+  std::getline(t, first);
+  std::getline(t, second);
+  BOOST_CHECK(!std::getline(t, extra));
+
+  BOOST_CHECK_EQUAL(header, "Time\tNode\tAppId\tSeqNo\tType\tTransmissions\tRto\tRtt\tSpurious\t"
+                            "WastedWait");
+
+  std::vector<std::string> fields = split(first);
+  BOOST_REQUIRE_EQUAL(fields.size(), 10);
+  BOOST_CHECK_EQUAL(fields[0], "0.0417424");
+  BOOST_CHECK_EQUAL(fields[1], "1");
+  BOOST_CHECK_EQUAL(fields[3], "0");
+  BOOST_CHECK_EQUAL(fields[4], "Data");
+  BOOST_CHECK_EQUAL(fields[5], "1");
+  BOOST_CHECK_GT(boost::lexical_cast<double>(fields[6]), 0.0);
+  BOOST_CHECK_EQUAL(fields[7], "0.0417424");
+  BOOST_CHECK_EQUAL(fields[8], "0");
+  BOOST_CHECK_EQUAL(fields[9], "0");
+
+  fields = split(second);
+  BOOST_REQUIRE_EQUAL(fields.size(), 10);
+  BOOST_CHECK_EQUAL(fields[3], "1");
+  BOOST_CHECK_EQUAL(fields[4], "Data");
+  BOOST_CHECK_EQUAL(fields[8], "0");
+}
+
+BOOST_AUTO_TEST_CASE(Aggregated)
+{
+  RtoTracer::InstallAll(TEST_RTO_TRACE.string(), Seconds(0.75));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+  Simulator::Destroy(); // writes the last, partial, period (empty)
+
+  RtoTracer::Destroy();
+
+  std::ifstream t(TEST_RTO_TRACE.string().c_str());
+  std::string header, first, second, extra;
+  std::getline(t, header);
+  std::getline(t, first);
+  std::getline(t, second);
+  BOOST_CHECK(!std::getline(t, extra));
+
+  BOOST_CHECK_EQUAL(header, "Time\tNode\tAppId\tInterests\tTimeouts\tSpurious\tGivenUp\tSamples\t"
+                            "Rto\tRtt\tRtoError\tWastedWait");
+
+  // Interest 0 answered in the first period, Interest 1 in the second
+  std::vector<std::string> fields = split(first);
+  BOOST_REQUIRE_EQUAL(fields.size(), 12);
+  BOOST_CHECK_EQUAL(fields[0], "0.75");
+  BOOST_CHECK_EQUAL(fields[1], "1");
+  BOOST_CHECK_EQUAL(fields[3], "1");
+  BOOST_CHECK_EQUAL(fields[4], "0");
+  BOOST_CHECK_EQUAL(fields[5], "0");
+  BOOST_CHECK_EQUAL(fields[6], "0");
+  BOOST_CHECK_EQUAL(fields[7], "1");
+  BOOST_CHECK_EQUAL(fields[9], "0.0417424");
+  BOOST_CHECK_CLOSE(boost::lexical_cast<double>(fields[10]),
+                    boost::lexical_cast<double>(fields[8]) - 0.0417424, 0.001);
+  BOOST_CHECK_EQUAL(fields[11], "0");
+
+  fields = split(second);
+  BOOST_REQUIRE_EQUAL(fields.size(), 12);
+  BOOST_CHECK_EQUAL(fields[0], "1.5");
+  BOOST_CHECK_EQUAL(fields[3], "1");
+  BOOST_CHECK_EQUAL(fields[7], "1");
+}
+
+BOOST_AUTO_TEST_CASE(InstallNodeWithoutConsumers)
+{
+  auto output = make_shared<boost::test_tools::output_test_stream>();
+  Ptr<RtoTracer> tracer = RtoTracer::Install(getNode("3"), output);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  tracer = nullptr; // destroy tracer
+
+  BOOST_CHECK(output->is_empty()); // producers have no consumer trace sources
+}
+
+BOOST_AUTO_TEST_CASE(PerInterestBinary)
+{
+  RtoTracer::InstallAll(TEST_RTO_BINARY_TRACE.string(), Seconds(0));
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  RtoTracer::Destroy(); // to force log to be written
+
+  std::ifstream is(TEST_RTO_BINARY_TRACE.string().c_str(), std::ios_base::binary);
+  BinaryTraceReader reader(is);
+  BOOST_REQUIRE_EQUAL(reader.GetColumns().size(), 10);
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetName(1), "1");
+  BOOST_CHECK_EQUAL(reader.GetNumber(3), 0);
+  BOOST_CHECK_EQUAL(reader.GetName(4), "Data");
+  BOOST_CHECK_EQUAL(reader.GetNumber(5), 1);
+  BOOST_CHECK_GT(reader.GetTime(6), Time(0));
+  BOOST_CHECK_CLOSE(reader.GetTime(7).ToDouble(Time::S), 0.0417424, 0.001);
+  BOOST_CHECK_EQUAL(reader.GetNumber(8), 0);
+  BOOST_CHECK_EQUAL(reader.GetTime(9), Time(0));
+
+  BOOST_REQUIRE(reader.Next());
+  BOOST_CHECK_EQUAL(reader.GetNumber(3), 1);
+
+  BOOST_CHECK(!reader.Next());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
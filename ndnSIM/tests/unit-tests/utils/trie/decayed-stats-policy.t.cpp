@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/decayed-stats-policy.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieDecayedStatsPolicy, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Decay)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>,
+                                   ndnSIM::decayed_stats_policy_traits> Trie;
+  Trie trie;
+  trie.getPolicy().set_half_life(Seconds(10));
+
+  BOOST_CHECK(trie.insert("/a", 1).second);
+  BOOST_CHECK(trie.insert("/b", 2).second);
+  trie.longest_prefix_match("/a");
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/a")), 2.0, 0.001);
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/b")), 1.0, 0.001);
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/a")), 1.0, 0.001);
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/b")), 0.5, 0.001);
+  BOOST_CHECK_CLOSE(trie.getPolicy().GetInserts(), 1.0, 0.001);
+
+  trie.longest_prefix_match("/b");
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/b")), 1.5, 0.001);
+  BOOST_CHECK_CLOSE(trie.getPolicy().GetLookups(), 1.5, 0.001);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/a")), 0.25, 0.001);
+  BOOST_CHECK_CLOSE(trie.getPolicy().get_popularity(trie.find_exact("/b")), 0.375, 0.001);
+
+  trie.erase("/a");
+  BOOST_CHECK_CLOSE(trie.getPolicy().GetErases(), 1.0, 0.001);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(NoDecay)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>,
+                                   ndnSIM::decayed_stats_policy_traits> Trie;
+  Trie trie;
+  trie.getPolicy().set_half_life(Seconds(0));
+
+  BOOST_CHECK(trie.insert("/a", 1).second);
+  Simulator::Stop(Seconds(100));
+  Simulator::Run();
+  trie.longest_prefix_match("/a");
+
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_popularity(trie.find_exact("/a")), 2);
+  BOOST_CHECK_EQUAL(trie.getPolicy().GetInserts(), 1);
+  BOOST_CHECK_EQUAL(trie.getPolicy().GetLookups(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+#include "utils/trie/byte-budget-policy.hpp"
+#include "utils/trie/greedy-dual-size-policy.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieSizeAwarePolicies, CleanupFixture)
+
+// payload of the test entries is their size
+struct PayloadSize {
+  template<class Iterator>
+  size_t
+  operator()(Iterator item) const
+  {
+    return item->payload();
+  }
+};
+
+struct UnitCost {
+  template<class Iterator>
+  double
+  operator()(Iterator) const
+  {
+    return 1;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ByteBudget)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<size_t>,
+                                   ndnSIM::byte_budget_policy_traits<ndnSIM::lru_policy_traits,
+                                                                     PayloadSize>> Trie;
+  BOOST_CHECK_EQUAL(ndnSIM::byte_budget_policy_traits<ndnSIM::lru_policy_traits,
+                                                      PayloadSize>::GetName(), "LruBytes");
+  Trie trie;
+  trie.getPolicy().set_max_size(10);
+
+  BOOST_CHECK(trie.insert("/a", 4).second);
+  BOOST_CHECK(trie.insert("/b", 4).second);
+  trie.longest_prefix_match("/a"); // /b is now the least recently used
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 8);
+
+  BOOST_CHECK(trie.insert("/c", 4).second);
+  BOOST_CHECK(trie.find_exact("/b") == trie.end());
+  BOOST_CHECK(trie.find_exact("/a") != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 8);
+
+  // evicts as many entries as needed
+  BOOST_CHECK(trie.insert("/d", 9).second);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 1);
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 9);
+
+  // larger than the whole budget
+  BOOST_CHECK(!trie.insert("/e", 11).second);
+  BOOST_CHECK(trie.find_exact("/d") != trie.end());
+
+  trie.erase("/d");
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(GreedyDualSize)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<size_t>,
+                                   ndnSIM::greedy_dual_size_policy_traits<PayloadSize, UnitCost>>
+    Trie;
+  Trie trie;
+  trie.getPolicy().set_max_size(10);
+
+  BOOST_CHECK(trie.insert("/big", 6).second);
+  BOOST_CHECK(trie.insert("/small", 2).second);
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 8);
+
+  // with the same cost, the larger entry goes first even though it was used more recently
+  trie.longest_prefix_match("/big");
+  BOOST_CHECK(trie.insert("/medium", 4).second);
+  BOOST_CHECK(trie.find_exact("/big") == trie.end());
+  BOOST_CHECK(trie.find_exact("/small") != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 6);
+
+  // entries of the same priority go in the order of insertion
+  BOOST_CHECK(trie.insert("/other", 4).second);
+  BOOST_CHECK(trie.insert("/last", 4).second);
+  BOOST_CHECK(trie.find_exact("/medium") == trie.end());
+  BOOST_CHECK(trie.find_exact("/other") != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 10);
+
+  // inflation ages out the small entry that is not used anymore
+  BOOST_CHECK(trie.insert("/next", 4).second);
+  BOOST_CHECK(trie.find_exact("/other") == trie.end());
+  BOOST_CHECK(trie.find_exact("/small") != trie.end());
+  BOOST_CHECK(trie.insert("/again", 2).second);
+  BOOST_CHECK(trie.find_exact("/small") == trie.end());
+  BOOST_CHECK(trie.find_exact("/last") != trie.end());
+  BOOST_CHECK(trie.find_exact("/next") != trie.end());
+  BOOST_CHECK_EQUAL(trie.getPolicy().get_current_size(), 10);
+
+  BOOST_CHECK(!trie.insert("/huge", 11).second);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
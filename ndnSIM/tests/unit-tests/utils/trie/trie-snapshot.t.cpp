@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-snapshot.hpp"
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/lru-policy.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieTrieSnapshot, CleanupFixture)
+
+typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>,
+                                 ndnSIM::lru_policy_traits> Trie;
+
+struct SavePayload {
+  void
+  operator()(ndnSIM::snapshot_writer& writer, const Trie::parent_trie& node) const
+  {
+    writer.write_number(node.payload());
+  }
+};
+
+struct LoadPayload {
+  int
+  operator()(ndnSIM::snapshot_reader& reader) const
+  {
+    return reader.read_number();
+  }
+};
+
+BOOST_AUTO_TEST_CASE(SaveLoad)
+{
+  Trie trie;
+  trie.getPolicy().set_max_size(3);
+  trie.insert("/a/b/c", 1);
+  trie.insert("/a/b/d", 2);
+  trie.insert("/a/x", 3);
+  trie.longest_prefix_match("/a/b/c"); // /a/b/d is now the least recently used
+
+  std::ostringstream os;
+  BOOST_CHECK_EQUAL(ndnSIM::save_snapshot(os, trie.getPolicy().begin(), trie.getPolicy().end(),
+                                          SavePayload()), 3);
+  std::string snapshot = os.str();
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(snapshot.data());
+
+  Trie loaded;
+  loaded.getPolicy().set_max_size(3);
+  BOOST_CHECK_EQUAL(ndnSIM::load_snapshot(loaded, begin, begin + snapshot.size(), LoadPayload()),
+                    3);
+  BOOST_CHECK_EQUAL(loaded.find_exact("/a/b/c")->payload(), 1);
+  BOOST_CHECK_EQUAL(loaded.find_exact("/a/b/d")->payload(), 2);
+  BOOST_CHECK_EQUAL(loaded.find_exact("/a/x")->payload(), 3);
+  BOOST_CHECK(loaded.find_exact("/a/b") == loaded.end());
+
+  // order of the policy is kept
+  loaded.insert("/z", 4);
+  BOOST_CHECK(loaded.find_exact("/a/b/d") == loaded.end());
+  BOOST_CHECK(loaded.find_exact("/a/b/c") != loaded.end());
+
+  // any order, e.g. of the trie itself
+  std::ostringstream os2;
+  Trie::parent_trie::recursive_iterator item(loaded.getTrie());
+  Trie::parent_trie::recursive_iterator end(0);
+  BOOST_CHECK_EQUAL(ndnSIM::save_snapshot(os2, item, end, SavePayload()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  Trie trie;
+  trie.insert("/a/b/c", 1);
+
+  std::ostringstream os;
+  ndnSIM::save_snapshot(os, trie.getPolicy().begin(), trie.getPolicy().end(), SavePayload());
+  std::string snapshot = os.str();
+  const uint8_t* begin = reinterpret_cast<const uint8_t*>(snapshot.data());
+
+  Trie loaded;
+  BOOST_CHECK_THROW(ndnSIM::load_snapshot(loaded, begin, begin + snapshot.size() - 1,
+                                          LoadPayload()),
+                    ndnSIM::snapshot_error);
+  BOOST_CHECK_THROW(ndnSIM::load_snapshot(loaded, begin + 1, begin + snapshot.size(),
+                                          LoadPayload()),
+                    ndnSIM::snapshot_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/adaptive-children.hpp"
+#include "utils/trie/lru-policy.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTrieTrie, CleanupFixture)
+
+typedef boost::mpl::vector<ndnSIM::hashed_children_traits,
+                           ndnSIM::adaptive_children_traits> ChildrenTraitsList;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertFindErase, ChildrenTraits, ChildrenTraitsList)
+{
+  typedef ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<int>,
+                                   ndnSIM::lru_policy_traits, ChildrenTraits> Trie;
+  Trie trie;
+  trie.getPolicy().set_max_size(0);
+
+  // enough children under /A to go through every form of adaptive_children
+  for (int i = 1; i <= 100; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    BOOST_CHECK(trie.insert(name, i).second);
+  }
+  BOOST_CHECK(!trie.insert("/A/%01", 1000).second);
+  BOOST_CHECK(trie.insert("/A", 1000).second);
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 101);
+
+  for (int i = 1; i <= 100; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    typename Trie::iterator item = trie.find_exact(name);
+    BOOST_REQUIRE(item != trie.end());
+    BOOST_CHECK_EQUAL(item->payload(), i);
+  }
+  BOOST_CHECK(trie.find_exact("/B") == trie.end());
+  BOOST_CHECK_EQUAL(trie.longest_prefix_match("/A/B/C")->payload(), 1000);
+
+  // down to a few children, every remaining one is still found
+  for (int i = 1; i <= 98; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    trie.erase(name);
+  }
+  BOOST_CHECK_EQUAL(trie.getPolicy().size(), 3);
+  BOOST_CHECK(trie.find_exact(Name("/A").appendNumber(50)) == trie.end());
+  BOOST_CHECK_EQUAL(trie.find_exact(Name("/A").appendNumber(99))->payload(), 99);
+  BOOST_CHECK_EQUAL(trie.find_exact(Name("/A").appendNumber(100))->payload(), 100);
+
+  size_t nPayloads = 0;
+  typename Trie::parent_trie::recursive_iterator item(trie.getTrie());
+  typename Trie::parent_trie::recursive_iterator end(0);
+  for (; item != end; item++) {
+    if (item->payload() != 0)
+      ++nPayloads;
+  }
+  BOOST_CHECK_EQUAL(nPayloads, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-adaptive-retx-controller.hpp"
+#include "ndn-rtt-hint-tag.hpp"
+
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AdaptiveRetxController");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(AdaptiveRetxController);
+
+TypeId
+AdaptiveRetxController::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::AdaptiveRetxController")
+      .SetGroupName("Ndn")
+      .SetParent<RetxController>()
+      .AddConstructor<AdaptiveRetxController>()
+      .AddAttribute("Gain", "Gain of the moving averages of loss and satisfaction ratios",
+                    DoubleValue(0.1), MakeDoubleAccessor(&AdaptiveRetxController::m_gain),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("MinTransmissions", "Lower bound of the budget",
+                    UintegerValue(2),
+                    MakeUintegerAccessor(&AdaptiveRetxController::m_minTransmissions),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("TransmissionsCap", "Upper bound of the budget",
+                    UintegerValue(8),
+                    MakeUintegerAccessor(&AdaptiveRetxController::m_transmissionsCap),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("TargetSatisfaction", "Satisfaction ratio the budget is sized for",
+                    DoubleValue(0.95),
+                    MakeDoubleAccessor(&AdaptiveRetxController::m_targetSatisfaction),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("MinRetxYield",
+                    "If fewer retransmissions of a prefix return, its budget is MinTransmissions",
+                    DoubleValue(0.05), MakeDoubleAccessor(&AdaptiveRetxController::m_minRetxYield),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("MinOutcomes",
+                    "Number of satisfied or given up Interests of a prefix before its budget "
+                    "is adapted",
+                    UintegerValue(10), MakeUintegerAccessor(&AdaptiveRetxController::m_minOutcomes),
+                    MakeUintegerChecker<uint32_t>())
+
+      .AddTraceSource("BudgetChanged", "Number of transmissions allowed for a prefix changed",
+                      MakeTraceSourceAccessor(&AdaptiveRetxController::m_budgetChanged),
+                      "ns3::ndn::AdaptiveRetxController::BudgetChangedCallback");
+  return tid;
+}
+
+AdaptiveRetxController::AdaptiveRetxController()
+  : m_gain(0.1)
+  , m_minTransmissions(2)
+  , m_transmissionsCap(8)
+  , m_targetSatisfaction(0.95)
+  , m_minRetxYield(0.05)
+  , m_minOutcomes(10)
+{
+}
+
+void
+AdaptiveRetxController::OnData(const Name& name, uint32_t nTransmissions)
+{
+  Name prefix;
+  Stats& stats = GetPrefixStats(name, prefix);
+  NoteTransmissionOutcome(stats, nTransmissions, false);
+  NoteInterestOutcome(stats, true);
+  UpdateBudget(prefix, stats);
+}
+
+uint32_t
+AdaptiveRetxController::GetBudget(const Name& name)
+{
+  Name prefix;
+  return GetPrefixStats(name, prefix).budget;
+}
+
+const AdaptiveRetxController::Stats*
+AdaptiveRetxController::GetStats(const Name& name) const
+{
+  auto entry = m_stats.find(RttHintTag::GetPrefix(name));
+  return entry != m_stats.end() ? &entry->second : nullptr;
+}
+
+void
+AdaptiveRetxController::NoteTimeout(const Name& name, uint32_t nTransmissions)
+{
+  Name prefix;
+  Stats& stats = GetPrefixStats(name, prefix);
+  NoteTransmissionOutcome(stats, nTransmissions, true);
+  UpdateBudget(prefix, stats);
+}
+
+void
+AdaptiveRetxController::NoteGiveUp(const Name& name, uint32_t nTransmissions)
+{
+  Name prefix;
+  Stats& stats = GetPrefixStats(name, prefix);
+  NoteInterestOutcome(stats, false);
+  UpdateBudget(prefix, stats);
+}
+
+AdaptiveRetxController::Stats&
+AdaptiveRetxController::GetPrefixStats(const Name& name, Name& prefix)
+{
+  prefix = RttHintTag::GetPrefix(name);
+  auto result = m_stats.insert(std::make_pair(prefix, Stats()));
+  Stats& stats = result.first->second;
+  if (result.second) {
+    stats.firstLoss = 0.0;
+    stats.retxLoss = 0.0;
+    stats.satisfaction = 1.0;
+    stats.nFirstSamples = 0;
+    stats.nRetxSamples = 0;
+    stats.nOutcomes = 0;
+    stats.budget = m_maxTransmissions;
+  }
+  return stats;
+}
+
+static void
+updateAverage(double& average, uint32_t& nSamples, double sample, double gain)
+{
+  average = nSamples == 0 ? sample : average + gain * (sample - average);
+  ++nSamples;
+}
+
+void
+AdaptiveRetxController::NoteTransmissionOutcome(Stats& stats, uint32_t nTransmissions,
+                                                bool isLost)
+{
+  // Data after a retransmission may answer an earlier transmission, it still counts for q
+  if (nTransmissions <= 1)
+    updateAverage(stats.firstLoss, stats.nFirstSamples, isLost ? 1.0 : 0.0, m_gain);
+  else
+    updateAverage(stats.retxLoss, stats.nRetxSamples, isLost ? 1.0 : 0.0, m_gain);
+}
+
+void
+AdaptiveRetxController::NoteInterestOutcome(Stats& stats, bool isSatisfied)
+{
+  updateAverage(stats.satisfaction, stats.nOutcomes, isSatisfied ? 1.0 : 0.0, m_gain);
+}
+
+void
+AdaptiveRetxController::UpdateBudget(const Name& prefix, Stats& stats)
+{
+  if (stats.nOutcomes < m_minOutcomes)
+    return;
+
+  uint32_t cap = std::max(m_minTransmissions, m_transmissionsCap);
+  // without retransmissions so far, assume they are lost as often as first transmissions
+  double retxLoss = stats.nRetxSamples > 0 ? stats.retxLoss : stats.firstLoss;
+
+  uint32_t budget = m_minTransmissions;
+  if (stats.nRetxSamples == 0 || 1.0 - retxLoss >= m_minRetxYield) {
+    double maxLoss = 1.0 - m_targetSatisfaction;
+    budget = 1;
+    for (double allLost = stats.firstLoss; allLost > maxLoss && budget < cap; allLost *= retxLoss)
+      ++budget;
+    if (stats.satisfaction < m_targetSatisfaction && budget < cap)
+      ++budget;
+    budget = std::max(budget, m_minTransmissions);
+  }
+
+  if (budget != stats.budget) {
+    NS_LOG_DEBUG(prefix << " budget " << stats.budget << " => " << budget << " (p="
+                        << stats.firstLoss << ", q=" << stats.retxLoss
+                        << ", satisfaction=" << stats.satisfaction << ")");
+    m_budgetChanged(prefix, stats.budget, budget);
+    stats.budget = budget;
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
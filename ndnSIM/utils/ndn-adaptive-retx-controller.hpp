@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ADAPTIVE_RETX_CONTROLLER_H
+#define NDN_ADAPTIVE_RETX_CONTROLLER_H
+
+#include "ndn-retx-controller.hpp"
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Retransmission controller that adapts the budget of every spatial prefix to its losses
+ *
+ * For every prefix (see RttHintTag::GetPrefix) the controller keeps moving averages of the
+ * loss ratio of first transmissions (p), of the loss ratio of retransmissions (q) and of the
+ * satisfaction ratio of Interests.  Once enough Interests of the prefix have been satisfied or
+ * given up, the budget is the smallest number of transmissions n for which p * q^(n-1), the
+ * probability that all of them are lost, does not exceed 1 - TargetSatisfaction, plus one if
+ * the observed satisfaction ratio is still below the target.  If retransmissions of the prefix
+ * hardly ever return (1 - q < MinRetxYield), as for Data that is out of reach, the budget drops
+ * to MinTransmissions so the channel is not wasted.
+ *
+ * MinTransmissions should allow at least one retransmission, otherwise q is no longer observed
+ * and the budget of the prefix cannot recover.
+ */
+class AdaptiveRetxController : public RetxController {
+public:
+  static TypeId
+  GetTypeId();
+
+  AdaptiveRetxController();
+
+  virtual void
+  OnData(const Name& name, uint32_t nTransmissions);
+
+  virtual uint32_t
+  GetBudget(const Name& name);
+
+  struct Stats {
+    double firstLoss;      ///< moving average of first transmissions that timed out
+    double retxLoss;       ///< moving average of retransmissions that timed out
+    double satisfaction;   ///< moving average of Interests that were satisfied
+    uint32_t nFirstSamples;
+    uint32_t nRetxSamples;
+    uint32_t nOutcomes;    ///< number of Interests satisfied or given up
+    uint32_t budget;       ///< current number of transmissions allowed
+  };
+
+  /**
+   * \brief Get statistics of the name's prefix, nullptr if there are none
+   */
+  const Stats*
+  GetStats(const Name& name) const;
+
+  typedef void (*BudgetChangedCallback)(const Name&, uint32_t, uint32_t);
+
+protected:
+  virtual void
+  NoteTimeout(const Name& name, uint32_t nTransmissions);
+
+  virtual void
+  NoteGiveUp(const Name& name, uint32_t nTransmissions);
+
+private:
+  Stats&
+  GetPrefixStats(const Name& name, Name& prefix);
+
+  void
+  NoteTransmissionOutcome(Stats& stats, uint32_t nTransmissions, bool isLost);
+
+  void
+  NoteInterestOutcome(Stats& stats, bool isSatisfied);
+
+  void
+  UpdateBudget(const Name& prefix, Stats& stats);
+
+private:
+  double m_gain;
+  uint32_t m_minTransmissions;
+  uint32_t m_transmissionsCap;
+  double m_targetSatisfaction;
+  double m_minRetxYield;
+  uint32_t m_minOutcomes;
+
+  std::unordered_map<Name, Stats> m_stats; ///< prefix => statistics
+
+  /// prefix, old budget, new budget
+  TracedCallback<const Name&, uint32_t, uint32_t> m_budgetChanged;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ADAPTIVE_RETX_CONTROLLER_H
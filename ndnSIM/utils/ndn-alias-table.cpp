@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-alias-table.hpp"
+
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+
+AliasTable::AliasTable(const AliasTable& other)
+  : m_ownedProb(other.m_ownedProb)
+  , m_ownedAlias(other.m_ownedAlias)
+  , m_prob(other.m_prob)
+  , m_alias(other.m_alias)
+  , m_size(other.m_size)
+{
+  if (other.m_prob == other.m_ownedProb.data())
+    useOwned();
+}
+
+AliasTable&
+AliasTable::operator=(const AliasTable& other)
+{
+  if (this != &other) {
+    m_ownedProb = other.m_ownedProb;
+    m_ownedAlias = other.m_ownedAlias;
+    m_prob = other.m_prob;
+    m_alias = other.m_alias;
+    m_size = other.m_size;
+    if (other.m_prob == other.m_ownedProb.data())
+      useOwned();
+  }
+  return *this;
+}
+
+void
+AliasTable::useOwned()
+{
+  m_prob = m_ownedProb.data();
+  m_alias = m_ownedAlias.data();
+  m_size = m_ownedProb.size();
+}
+
+void
+AliasTable::build(const std::vector<double>& weights)
+{
+  const uint32_t n = weights.size();
+  std::vector<double>& prob = m_ownedProb;
+  std::vector<uint32_t>& alias = m_ownedAlias;
+  prob.resize(n);
+  alias.resize(n);
+  useOwned();
+  if (n == 0)
+    return;
+
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; ++i)
+    sum += weights[i];
+
+  // scaled probabilities, columns below 1 are filled up by columns above 1
+  const double scale = sum > 0.0 ? n / sum : 0.0;
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  small.reserve(n);
+  large.reserve(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    prob[i] = sum > 0.0 ? weights[i] * scale : 1.0;
+    alias[i] = i;
+    if (prob[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    uint32_t more = large.back();
+    small.pop_back();
+
+    alias[less] = more;
+    prob[more] -= 1.0 - prob[less];
+    if (prob[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // what is left is 1 up to rounding errors
+  for (uint32_t i : small)
+    prob[i] = 1.0;
+  for (uint32_t i : large)
+    prob[i] = 1.0;
+}
+
+void
+AliasTable::save(std::ostream& os) const
+{
+  // the size, then the probabilities and the aliases, all aligned to their size
+  uint64_t n = m_size;
+  os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  os.write(reinterpret_cast<const char*>(m_prob), m_size * sizeof(double));
+  os.write(reinterpret_cast<const char*>(m_alias), m_size * sizeof(uint32_t));
+}
+
+bool
+AliasTable::attach(const uint8_t* data, size_t size)
+{
+  uint64_t n = 0;
+  if (data == nullptr || size < sizeof(n))
+    return false;
+  n = *reinterpret_cast<const uint64_t*>(data);
+  if ((size - sizeof(n)) / (sizeof(double) + sizeof(uint32_t)) < n ||
+      size != sizeof(n) + n * (sizeof(double) + sizeof(uint32_t)))
+    return false;
+
+  m_ownedProb.clear();
+  m_ownedProb.shrink_to_fit();
+  m_ownedAlias.clear();
+  m_ownedAlias.shrink_to_fit();
+  m_prob = reinterpret_cast<const double*>(data + sizeof(n));
+  m_alias = reinterpret_cast<const uint32_t*>(data + sizeof(n) + n * sizeof(double));
+  m_size = n;
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ALIAS_TABLE_H
+#define NDN_ALIAS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Walker's alias table for sampling a discrete distribution in constant time
+ *
+ * Every index owns a column of height 1/n, split between the index itself (probability
+ * m_prob) and its alias, so a sample needs one column pick and one comparison.  The table is
+ * built in O(n) with Vose's method.
+ *
+ * A table can be saved, and used later without a copy straight from memory holding the saved
+ * table, e.g., a file mapped with SharedInput by all the replications of a simulation.
+ */
+class AliasTable {
+public:
+  AliasTable() = default;
+
+  AliasTable(const AliasTable& other);
+
+  AliasTable&
+  operator=(const AliasTable& other);
+
+  /**
+   * \brief Builds the table for weights (not necessarily normalized, all non-negative)
+   */
+  void
+  build(const std::vector<double>& weights);
+
+  /**
+   * \brief Writes the table in the format read by attach
+   */
+  void
+  save(std::ostream& os) const;
+
+  /**
+   * \brief Uses the table saved at @p data, which must outlive this table and be aligned to 8
+   * \return false if @p data does not hold a saved table, which is then left unchanged
+   */
+  bool
+  attach(const uint8_t* data, size_t size);
+
+  /**
+   * \brief Returns index i with probability weights[i] / sum(weights)
+   * \param u uniform random value in [0, 1), used for both the column and the comparison
+   */
+  uint32_t
+  sample(double u) const
+  {
+    double x = u * m_size;
+    uint32_t column = static_cast<uint32_t>(x);
+    if (column >= m_size) // u too close to 1
+      column = m_size - 1;
+    return x - column < m_prob[column] ? column : m_alias[column];
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+private:
+  void
+  useOwned();
+
+private:
+  std::vector<double> m_ownedProb;
+  std::vector<uint32_t> m_ownedAlias;
+
+  // either the owned vectors or an attached table
+  const double* m_prob = nullptr;
+  const uint32_t* m_alias = nullptr;
+  size_t m_size = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ALIAS_TABLE_H
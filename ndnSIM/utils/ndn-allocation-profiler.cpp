@@ -0,0 +1,408 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-allocation-profiler.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AllocationProfiler");
+
+namespace ns3 {
+namespace ndn {
+
+bool AllocationProfiler::s_isEnabled = false;
+uint64_t AllocationProfiler::s_nPackets = 0;
+thread_local AllocationProfiler::Subsystem AllocationProfiler::s_current =
+  AllocationProfiler::OTHER;
+
+namespace {
+
+// plain atomics, usable by operator new before any static constructor has run
+std::atomic<uint64_t> g_nAllocations[AllocationProfiler::N_SUBSYSTEMS];
+std::atomic<uint64_t> g_nBytes[AllocationProfiler::N_SUBSYSTEMS];
+std::atomic<uint64_t> g_nSeen;
+uint32_t g_samplingPeriod = 0;
+
+// set while the profiler itself allocates, which is then not counted
+thread_local bool g_isRecording = false;
+
+const int MAX_FRAMES = 16;
+
+struct Sample
+{
+  uint64_t nSamples = 0;
+  uint64_t nBytes = 0;
+};
+
+typedef std::map<std::vector<void*>, Sample> Samples;
+
+std::mutex&
+getMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+Samples&
+getSamples()
+{
+  static Samples samples;
+  return samples;
+}
+
+std::string
+demangle(const char* name)
+{
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status != 0) {
+    return name;
+  }
+  std::string result(demangled);
+  free(demangled);
+  return result;
+}
+
+/**
+ * @brief Get the part of @p name from @p pos up to the first of @p stops outside of
+ *        brackets and parentheses
+ */
+std::string
+untilTopLevel(const std::string& name, size_t pos, const std::string& stops)
+{
+  int depth = 0;
+  for (size_t i = pos; i < name.size(); ++i) {
+    char c = name[i];
+    if (depth == 0 && stops.find(c) != std::string::npos) {
+      return name.substr(pos, i - pos);
+    }
+    if (c == '<' || c == '(') {
+      ++depth;
+    }
+    else if (c == '>' || c == ')') {
+      --depth;
+    }
+  }
+  return name.substr(pos);
+}
+
+/**
+ * @brief Name of the function with the instruction at @p address, empty if it belongs to the
+ *        allocator, to the standard library or to Boost
+ */
+std::string
+getFunctionName(void* address)
+{
+  static const std::vector<std::string> SKIPPED = {
+    "operator new",
+    "ns3::ndn::AllocationProfiler::",
+    "std::",
+    "__gnu_cxx::",
+    "boost::",
+    "ns3::Ptr<",
+    "ns3::Create<",
+  };
+  static std::unordered_map<void*, std::string> cache;
+
+  auto it = cache.find(address);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::string name = "?";
+  Dl_info info;
+  if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+    name = demangle(info.dli_sname);
+    // drop the return type of function templates and the arguments
+    std::string function = untilTopLevel(name, 0, " (");
+    if (function != "operator" && function.size() < name.size() && name[function.size()] == ' ') {
+      name = name.substr(function.size() + 1);
+    }
+    name = untilTopLevel(name, 0, "(");
+
+    for (const std::string& skipped : SKIPPED) {
+      if (name.compare(0, skipped.size(), skipped) == 0) {
+        name.clear();
+        break;
+      }
+    }
+  }
+  cache.emplace(address, name);
+  return name;
+}
+
+std::string
+getCallSite(const std::vector<void*>& frames)
+{
+  for (void* frame : frames) {
+    std::string name = getFunctionName(frame);
+    if (!name.empty()) {
+      return name;
+    }
+  }
+  return "?";
+}
+
+} // namespace
+
+bool
+AllocationProfiler::IsCompiledIn()
+{
+#ifdef NDNSIM_WITH_ALLOCATION_PROFILER
+  return true;
+#else
+  return false;
+#endif
+}
+
+void
+AllocationProfiler::Enable(uint32_t samplingPeriod)
+{
+  if (!IsCompiledIn()) {
+    NS_LOG_WARN("ndnSIM is compiled without NDNSIM_WITH_ALLOCATION_PROFILER, only explicitly "
+                "recorded allocations are counted");
+  }
+
+  g_samplingPeriod = samplingPeriod;
+  s_isEnabled = true;
+}
+
+void
+AllocationProfiler::Disable()
+{
+  s_isEnabled = false;
+}
+
+void
+AllocationProfiler::Reset()
+{
+  g_isRecording = true;
+  for (int subsystem = 0; subsystem < N_SUBSYSTEMS; ++subsystem) {
+    g_nAllocations[subsystem] = 0;
+    g_nBytes[subsystem] = 0;
+  }
+  g_nSeen = 0;
+  s_nPackets = 0;
+  {
+    std::lock_guard<std::mutex> lock(getMutex());
+    getSamples().clear();
+  }
+  g_isRecording = false;
+}
+
+const char*
+AllocationProfiler::GetSubsystemName(Subsystem subsystem)
+{
+  switch (subsystem) {
+  case OTHER:
+    return "Other";
+  case ENCODING:
+    return "Encoding";
+  case TABLES:
+    return "Tables";
+  case GLUE:
+    return "Glue";
+  case APPS:
+    return "Apps";
+  case TRACERS:
+    return "Tracers";
+  default:
+    return "Unknown";
+  }
+}
+
+AllocationProfiler::Counters
+AllocationProfiler::GetCounters(Subsystem subsystem)
+{
+  return Counters{g_nAllocations[subsystem].load(), g_nBytes[subsystem].load()};
+}
+
+uint64_t
+AllocationProfiler::GetNPackets()
+{
+  return s_nPackets;
+}
+
+void
+AllocationProfiler::RecordAllocation(size_t size)
+{
+  if (!s_isEnabled || g_isRecording)
+    return;
+
+  g_nAllocations[s_current].fetch_add(1, std::memory_order_relaxed);
+  g_nBytes[s_current].fetch_add(size, std::memory_order_relaxed);
+
+  uint32_t samplingPeriod = g_samplingPeriod;
+  if (samplingPeriod == 0 ||
+      (g_nSeen.fetch_add(1, std::memory_order_relaxed) + 1) % samplingPeriod != 0)
+    return;
+
+  g_isRecording = true;
+  void* frames[MAX_FRAMES];
+  int nFrames = backtrace(frames, MAX_FRAMES);
+  {
+    std::lock_guard<std::mutex> lock(getMutex());
+    // frame 0 is this function
+    Sample& sample = getSamples()[std::vector<void*>(frames + 1, frames + nFrames)];
+    ++sample.nSamples;
+    sample.nBytes += size;
+  }
+  g_isRecording = false;
+}
+
+std::vector<AllocationProfiler::CallSite>
+AllocationProfiler::GetCallSites()
+{
+  bool wasRecording = g_isRecording;
+  g_isRecording = true;
+
+  std::map<std::string, Sample> byFunction;
+  {
+    std::lock_guard<std::mutex> lock(getMutex());
+    for (const auto& sample : getSamples()) {
+      Sample& total = byFunction[getCallSite(sample.first)];
+      total.nSamples += sample.second.nSamples;
+      total.nBytes += sample.second.nBytes;
+    }
+  }
+
+  std::vector<CallSite> callSites;
+  for (const auto& function : byFunction) {
+    callSites.push_back(CallSite{function.first,
+                                 function.second.nSamples * g_samplingPeriod,
+                                 function.second.nBytes * g_samplingPeriod});
+  }
+  std::sort(callSites.begin(), callSites.end(), [] (const CallSite& a, const CallSite& b) {
+      return a.nAllocations > b.nAllocations;
+    });
+
+  g_isRecording = wasRecording;
+  return callSites;
+}
+
+void
+AllocationProfiler::PrintReport(std::ostream& os, size_t nTop)
+{
+  bool wasRecording = g_isRecording;
+  g_isRecording = true;
+
+  uint64_t nPackets = GetNPackets();
+  os << "Packets\t" << nPackets << "\n";
+  os << "Subsystem\tAllocations\tBytes\tAllocations/packet\tBytes/packet\n";
+  for (int subsystem = 0; subsystem < N_SUBSYSTEMS; ++subsystem) {
+    Counters counters = GetCounters(static_cast<Subsystem>(subsystem));
+    os << GetSubsystemName(static_cast<Subsystem>(subsystem)) << "\t"
+       << counters.nAllocations << "\t" << counters.nBytes << "\t";
+    if (nPackets > 0) {
+      os << static_cast<double>(counters.nAllocations) / nPackets << "\t"
+         << static_cast<double>(counters.nBytes) / nPackets << "\n";
+    }
+    else {
+      os << "-\t-\n";
+    }
+  }
+
+  std::vector<CallSite> callSites = GetCallSites();
+  if (!callSites.empty()) {
+    os << "\nCallSite\tAllocations\tBytes\n";
+    if (nTop > 0 && callSites.size() > nTop) {
+      callSites.resize(nTop);
+    }
+    for (const CallSite& callSite : callSites) {
+      os << callSite.function << "\t" << callSite.nAllocations << "\t" << callSite.nBytes << "\n";
+    }
+  }
+
+  g_isRecording = wasRecording;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NDNSIM_WITH_ALLOCATION_PROFILER
+
+void*
+operator new(std::size_t size)
+{
+  ns3::ndn::AllocationProfiler::RecordAllocation(size);
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void*
+operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  ns3::ndn::AllocationProfiler::RecordAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+  return ::operator new(size, tag);
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete[](void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete[](void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+#endif // NDNSIM_WITH_ALLOCATION_PROFILER
@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_ALLOCATION_PROFILER_HPP
+#define NDNSIM_UTILS_NDN_ALLOCATION_PROFILER_HPP
+
+// kept free of ns-3 and ndnSIM headers, as it is included by ndn-cxx and NFD as well
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Accounting of heap allocations by subsystem
+ *
+ * When compiled with NDNSIM_WITH_ALLOCATION_PROFILER (e.g.,
+ * CXXFLAGS=-DNDNSIM_WITH_ALLOCATION_PROFILER), the global operator new is replaced, and every
+ * allocation made while the profiler is enabled is attributed to the subsystem of the innermost
+ * NDN_ALLOCATION_SCOPE on the stack, OTHER outside of any.  Scopes are placed in the ndn-cxx
+ * packet encoding and decoding, the NFD forwarding pipelines, the ns-3 glue (NetDeviceFace,
+ * packet headers), the Consumer and Producer apps and the tracers.  Packets entering the
+ * forwarders are counted, so that allocations and bytes are reported per packet.
+ *
+ * Every samplingPeriod-th allocation, the stack is captured, and the report lists the
+ * functions allocating the most, estimated from the samples: the first caller of operator new
+ * outside of the standard library and Boost, resolved with dladdr (so functions that are not
+ * exported are attributed to the nearest exported symbol).
+ *
+ * Without NDNSIM_WITH_ALLOCATION_PROFILER, the macros expand to nothing and no allocation is
+ * counted.
+ *
+ * Example:
+ *
+ *     ndn::AllocationProfiler::Enable();
+ *     Simulator::Run();
+ *     ndn::AllocationProfiler::PrintReport(std::cout);
+ */
+class AllocationProfiler
+{
+public:
+  enum Subsystem {
+    OTHER,
+    ENCODING, ///< ndn-cxx encoding and decoding of packets
+    TABLES,   ///< NFD forwarding pipelines and tables
+    GLUE,     ///< ns-3 faces and packet headers
+    APPS,
+    TRACERS,
+    N_SUBSYSTEMS
+  };
+
+  struct Counters
+  {
+    uint64_t nAllocations;
+    uint64_t nBytes;
+  };
+
+  struct CallSite
+  {
+    std::string function;
+    uint64_t nAllocations; ///< estimated, samples times the sampling period
+    uint64_t nBytes;       ///< estimated, sampled bytes times the sampling period
+  };
+
+  /**
+   * @brief Whether ndnSIM is compiled with NDNSIM_WITH_ALLOCATION_PROFILER
+   */
+  static bool
+  IsCompiledIn();
+
+  /**
+   * @brief Start counting allocations
+   * @param samplingPeriod capture the stack of every samplingPeriod-th allocation, 0 to not
+   *        capture call sites
+   */
+  static void
+  Enable(uint32_t samplingPeriod = 1000);
+
+  static void
+  Disable();
+
+  static bool
+  IsEnabled()
+  {
+    return s_isEnabled;
+  }
+
+  /**
+   * @brief Clear the counters, the packet count and the call sites
+   */
+  static void
+  Reset();
+
+  static const char*
+  GetSubsystemName(Subsystem subsystem);
+
+  static Counters
+  GetCounters(Subsystem subsystem);
+
+  /**
+   * @brief Get the number of packets received by the forwarders while enabled
+   */
+  static uint64_t
+  GetNPackets();
+
+  /**
+   * @brief Get the call sites, the most allocations first
+   */
+  static std::vector<CallSite>
+  GetCallSites();
+
+  /**
+   * @brief Print allocations and bytes per subsystem, in total and per packet, and the
+   *        @p nTop call sites allocating the most (0 for all)
+   */
+  static void
+  PrintReport(std::ostream& os, size_t nTop = 20);
+
+  static void
+  CountPacket()
+  {
+    if (s_isEnabled)
+      ++s_nPackets;
+  }
+
+  /**
+   * @brief Attribute an allocation of @p size bytes to the current subsystem
+   *
+   * Called by the replaced operator new.
+   */
+  static void
+  RecordAllocation(size_t size);
+
+  /**
+   * @brief Attributes the allocations to @p subsystem from construction to destruction
+   */
+  class Scope
+  {
+  public:
+    explicit
+    Scope(Subsystem subsystem)
+      : m_previous(s_current)
+    {
+      s_current = subsystem;
+    }
+
+    ~Scope()
+    {
+      s_current = m_previous;
+    }
+
+    Scope(const Scope&) = delete;
+
+    Scope&
+    operator=(const Scope&) = delete;
+
+  private:
+    Subsystem m_previous;
+  };
+
+private:
+  static bool s_isEnabled;
+  static uint64_t s_nPackets;
+  static thread_local Subsystem s_current;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#define NDN_ALLOCATION_SCOPE_CONCAT(a, b) a##b
+#define NDN_ALLOCATION_SCOPE_VARIABLE(line) NDN_ALLOCATION_SCOPE_CONCAT(ndnAllocationScope, line)
+
+/**
+ * @def NDN_ALLOCATION_SCOPE(subsystem)
+ * @brief Attributes the allocations of the rest of the enclosing scope to @p subsystem, e.g.,
+ *        NDN_ALLOCATION_SCOPE(TABLES)
+ */
+#ifdef NDNSIM_WITH_ALLOCATION_PROFILER
+#define NDN_ALLOCATION_SCOPE(subsystem) \
+  ::ns3::ndn::AllocationProfiler::Scope NDN_ALLOCATION_SCOPE_VARIABLE(__LINE__)( \
+    ::ns3::ndn::AllocationProfiler::subsystem)
+#define NDN_ALLOCATION_COUNT_PACKET() ::ns3::ndn::AllocationProfiler::CountPacket()
+#else
+#define NDN_ALLOCATION_SCOPE(subsystem)
+#define NDN_ALLOCATION_COUNT_PACKET()
+#endif
+
+#endif // NDNSIM_UTILS_NDN_ALLOCATION_PROFILER_HPP
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CHECKPOINT_STREAM_H
+#define NDN_CHECKPOINT_STREAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/simulator.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ns3 {
+namespace ndn {
+namespace checkpoint {
+
+/**
+ * \brief Write a fixed-size value to the checkpoint, in host byte order
+ */
+template<class T>
+inline void
+write(std::ostream& os, const T& value)
+{
+  static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * \brief Read a fixed-size value from the checkpoint
+ * \throw std::runtime_error the checkpoint is truncated
+ */
+template<class T>
+inline T
+read(std::istream& is)
+{
+  static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+  T value;
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw std::runtime_error("Checkpoint is truncated");
+  }
+  return value;
+}
+
+/**
+ * \brief Write octets prefixed with their length
+ */
+inline void
+writeString(std::ostream& os, const std::string& value)
+{
+  write<uint32_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+inline std::string
+readString(std::istream& is)
+{
+  std::string value(read<uint32_t>(is), '\0');
+  if (!is.read(&value[0], value.size())) {
+    throw std::runtime_error("Checkpoint is truncated");
+  }
+  return value;
+}
+
+/**
+ * \brief Write a TLV block prefixed with its length
+ */
+inline void
+writeBlock(std::ostream& os, const Block& block)
+{
+  write<uint32_t>(os, block.size());
+  os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+}
+
+/**
+ * \throw std::runtime_error the checkpoint is truncated or the block is malformed
+ */
+inline Block
+readBlock(std::istream& is)
+{
+  std::string wire = readString(is);
+  try {
+    return Block(reinterpret_cast<const uint8_t*>(wire.data()), wire.size());
+  }
+  catch (const ::ndn::tlv::Error& e) {
+    throw std::runtime_error(std::string("Checkpoint has a malformed block: ") + e.what());
+  }
+}
+
+/**
+ * \brief Write a point in time as its distance from now
+ *
+ * Times are restored relative to the time the checkpoint is loaded, so that the restored
+ * state has the same age as when it was saved.
+ */
+inline void
+writeTime(std::ostream& os, Time time)
+{
+  write<int64_t>(os, (time - Simulator::Now()).GetNanoSeconds());
+}
+
+inline Time
+readTime(std::istream& is)
+{
+  return Simulator::Now() + NanoSeconds(read<int64_t>(is));
+}
+
+} // namespace checkpoint
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CHECKPOINT_STREAM_H
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-seq-table.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_CAPACITY = 64;
+
+ConsumerSeqTable::ConsumerSeqTable()
+  : m_slots(INITIAL_CAPACITY)
+  , m_size(0)
+{
+}
+
+size_t
+ConsumerSeqTable::bucket(uint32_t seq) const
+{
+  // Fibonacci hashing spreads consecutive sequence numbers over the table
+  return (seq * 2654435769u) & (m_slots.size() - 1);
+}
+
+ConsumerSeqTable::Entry*
+ConsumerSeqTable::find(uint32_t seq)
+{
+  for (size_t i = bucket(seq);; i = (i + 1) & (m_slots.size() - 1)) {
+    Slot& slot = m_slots[i];
+    if (!slot.isUsed)
+      return nullptr;
+    if (slot.entry.seq == seq)
+      return &slot.entry;
+  }
+}
+
+ConsumerSeqTable::Entry&
+ConsumerSeqTable::insert(uint32_t seq)
+{
+  Entry* existing = find(seq);
+  if (existing != nullptr)
+    return *existing;
+
+  // keep load factor at most 1/2
+  if (2 * (m_size + 1) > m_slots.size())
+    rehash(2 * m_slots.size());
+
+  size_t i = bucket(seq);
+  while (m_slots[i].isUsed)
+    i = (i + 1) & (m_slots.size() - 1);
+
+  Slot& slot = m_slots[i];
+  slot.isUsed = true;
+  slot.entry = Entry();
+  slot.entry.seq = seq;
+  slot.entry.retxCount = 0;
+  slot.entry.hasDeadline = false;
+  ++m_size;
+  return slot.entry;
+}
+
+void
+ConsumerSeqTable::erase(uint32_t seq)
+{
+  const size_t mask = m_slots.size() - 1;
+
+  size_t i = bucket(seq);
+  for (;; i = (i + 1) & mask) {
+    if (!m_slots[i].isUsed)
+      return;
+    if (m_slots[i].entry.seq == seq)
+      break;
+  }
+
+  // backward shift deletion: move up following entries whose probe sequence crosses the hole
+  for (size_t j = (i + 1) & mask; m_slots[j].isUsed; j = (j + 1) & mask) {
+    size_t home = bucket(m_slots[j].entry.seq);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      m_slots[i].entry = std::move(m_slots[j].entry);
+      i = j;
+    }
+  }
+  m_slots[i].isUsed = false;
+  m_slots[i].entry.interest.reset();
+  --m_size;
+
+  if (m_size == 0) {
+    m_deadlines = decltype(m_deadlines)();
+  }
+}
+
+void
+ConsumerSeqTable::clear()
+{
+  m_slots.assign(INITIAL_CAPACITY, Slot());
+  m_size = 0;
+  m_deadlines = decltype(m_deadlines)();
+}
+
+size_t
+ConsumerSeqTable::getMemoryUsage() const
+{
+  size_t n = m_slots.capacity() * sizeof(Slot) + m_deadlines.size() * sizeof(Deadline);
+  for (const Slot& slot : m_slots) {
+    if (slot.isUsed && slot.entry.interest != nullptr) {
+      n += sizeof(Interest) + 2 * sizeof(void*) + slot.entry.interest->wireEncode().size();
+    }
+  }
+  return n;
+}
+
+void
+ConsumerSeqTable::rehash(size_t capacity)
+{
+  std::vector<Slot> slots(capacity);
+  slots.swap(m_slots);
+
+  for (Slot& slot : slots) {
+    if (!slot.isUsed)
+      continue;
+
+    size_t i = bucket(slot.entry.seq);
+    while (m_slots[i].isUsed)
+      i = (i + 1) & (capacity - 1);
+    m_slots[i].isUsed = true;
+    m_slots[i].entry = std::move(slot.entry);
+  }
+}
+
+void
+ConsumerSeqTable::setDeadline(Entry& entry, Time deadline)
+{
+  entry.hasDeadline = true;
+  entry.deadline = deadline;
+
+  // drop outdated heap items if they outnumber the live ones
+  if (m_deadlines.size() > 2 * m_size + INITIAL_CAPACITY) {
+    decltype(m_deadlines) deadlines;
+    for (const Slot& slot : m_slots) {
+      if (slot.isUsed && slot.entry.hasDeadline && &slot.entry != &entry)
+        deadlines.push(Deadline{slot.entry.deadline, slot.entry.seq});
+    }
+    m_deadlines.swap(deadlines);
+  }
+
+  m_deadlines.push(Deadline{deadline, entry.seq});
+}
+
+ConsumerSeqTable::Entry*
+ConsumerSeqTable::earliestDeadline()
+{
+  while (!m_deadlines.empty()) {
+    const Deadline& top = m_deadlines.top();
+    Entry* entry = find(top.seq);
+    if (entry != nullptr && entry->hasDeadline && entry->deadline == top.time)
+      return entry;
+    m_deadlines.pop(); // entry is gone or its deadline has been moved
+  }
+  return nullptr;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_SEQ_TABLE_H
+#define NDN_CONSUMER_SEQ_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <queue>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Per-sequence-number state of Interests sent by a Consumer
+ *
+ * Entries are stored in place in an open-addressed (linear probing) hash table, so a lookup
+ * touches one or two cache lines and no memory is allocated per Interest in the steady state.
+ * Retransmission deadlines are kept in a separate binary heap; heap items that no longer match
+ * the deadline of their entry are discarded lazily.
+ *
+ * Pointers to entries are invalidated by insert() and erase().
+ */
+class ConsumerSeqTable {
+public:
+  struct Entry {
+    uint32_t seq;
+    uint32_t retxCount;            ///< \brief number of transmissions so far
+    bool hasDeadline;              ///< \brief whether the entry waits for retransmission timeout
+    Time firstSendTime;            ///< \brief time of the first transmission
+    Time lastSendTime;             ///< \brief time of the last transmission
+    Time deadline;                 ///< \brief retransmission deadline, valid if hasDeadline
+    Time rto;                      ///< \brief RTO of the last transmission
+    shared_ptr<const Interest> interest; ///< \brief last transmitted Interest, may be empty
+  };
+
+  ConsumerSeqTable();
+
+  /**
+   * \brief Find entry for the sequence number
+   * \return pointer to the entry or nullptr
+   */
+  Entry*
+  find(uint32_t seq);
+
+  /**
+   * \brief Find or create entry for the sequence number
+   *
+   * A new entry has zero retxCount and no deadline.
+   */
+  Entry&
+  insert(uint32_t seq);
+
+  /**
+   * \brief Remove entry for the sequence number, if any
+   */
+  void
+  erase(uint32_t seq);
+
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  /**
+   * \brief Get approximate number of bytes used by the table, the heap and the stored Interests
+   */
+  size_t
+  getMemoryUsage() const;
+
+  /**
+   * \brief Set (or move) retransmission deadline of the entry
+   */
+  void
+  setDeadline(Entry& entry, Time deadline);
+
+  void
+  clearDeadline(Entry& entry)
+  {
+    entry.hasDeadline = false;
+  }
+
+  /**
+   * \brief Find the entry with the earliest retransmission deadline
+   * \return pointer to the entry or nullptr if no entry has a deadline
+   */
+  Entry*
+  earliestDeadline();
+
+private:
+  size_t
+  bucket(uint32_t seq) const;
+
+  void
+  rehash(size_t capacity);
+
+private:
+  struct Slot {
+    Slot()
+      : isUsed(false)
+    {
+    }
+
+    bool isUsed;
+    Entry entry;
+  };
+
+  struct Deadline {
+    Time time;
+    uint32_t seq;
+
+    bool
+    operator>(const Deadline& other) const
+    {
+      return time > other.time || (time == other.time && seq > other.seq);
+    }
+  };
+
+  std::vector<Slot> m_slots; // capacity is a power of two
+  size_t m_size;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> m_deadlines;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_SEQ_TABLE_H
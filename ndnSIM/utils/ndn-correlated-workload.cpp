@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-correlated-workload.hpp"
+
+#include "apps/ndn-consumer-zipf-mandelbrot.hpp"
+
+#include "ns3/log.h"
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.CorrelatedWorkload");
+
+namespace ns3 {
+namespace ndn {
+
+CorrelatedWorkload::CorrelatedWorkload()
+  : m_nContents(100)
+  , m_q(0.7)
+  , m_s(0.7)
+  , m_localProbability(0.8)
+  , m_repeatProbability(0.2)
+  , m_historySize(16)
+  , m_isBuilt(false)
+  , m_historyPos(0)
+  , m_rng(CreateObject<UniformRandomVariable>())
+{
+}
+
+void
+CorrelatedWorkload::Load(std::istream& is)
+{
+  std::string line;
+  size_t lineNo = 0;
+  while (std::getline(is, line)) {
+    ++lineNo;
+    std::istringstream fields(line);
+    std::string uri;
+    if (!(fields >> uri) || uri[0] == '#')
+      continue;
+
+    double weight = 1.0;
+    std::string rest;
+    if (fields >> rest) {
+      std::istringstream number(rest);
+      if (!(number >> weight) || !number.eof() || weight < 0.0 || (fields >> rest)) {
+        throw std::runtime_error("Line " + std::to_string(lineNo) + " of the hierarchy: " +
+                                 "the weight must be a non-negative number");
+      }
+    }
+
+    Name name(uri);
+    if (!name.empty() && name.at(0) == name::Component("S"))
+      AddSpatialName(name, weight);
+    else if (!name.empty() && name.at(0) == name::Component("A"))
+      AddAppName(name, weight);
+    else
+      throw std::runtime_error("Line " + std::to_string(lineNo) + " of the hierarchy: " + uri +
+                               " starts with neither /S nor /A");
+  }
+}
+
+void
+CorrelatedWorkload::Load(const std::string& file)
+{
+  std::ifstream is(file.c_str());
+  if (!is.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for reading");
+  }
+  Load(is);
+}
+
+void
+CorrelatedWorkload::AddSpatialName(const Name& spatialName, double weight)
+{
+  m_spatialIndex.insert(std::make_pair(spatialName, m_spatialNames.size()));
+  m_spatialNames.push_back(spatialName);
+  m_spatialWeights.push_back(weight);
+  m_isBuilt = false;
+}
+
+void
+CorrelatedWorkload::AddAppName(const Name& appName, double weight)
+{
+  m_appNames.push_back(appName);
+  m_appWeights.push_back(weight);
+  m_isBuilt = false;
+}
+
+void
+CorrelatedWorkload::SetPopularity(uint32_t nContents, double q, double s)
+{
+  if (nContents != m_nContents || q != m_q || s != m_s)
+    m_isBuilt = false;
+  m_nContents = nContents;
+  m_q = q;
+  m_s = s;
+}
+
+void
+CorrelatedWorkload::SetRepeatProbability(double probability, uint32_t historySize)
+{
+  m_repeatProbability = probability;
+  if (historySize != m_historySize) {
+    m_history.clear();
+    m_historyPos = 0;
+  }
+  m_historySize = historySize;
+}
+
+int64_t
+CorrelatedWorkload::AssignStreams(int64_t stream)
+{
+  m_rng->SetStream(stream);
+  return 1;
+}
+
+void
+CorrelatedWorkload::Build()
+{
+  if (m_spatialNames.empty() || m_appNames.empty() || m_nContents == 0) {
+    throw std::runtime_error("The workload needs spatial names, application names and contents");
+  }
+  uint64_t nIds = static_cast<uint64_t>(m_spatialNames.size()) * m_appNames.size() * m_nContents;
+  if (nIds > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("The workload has more contents than sequence numbers");
+  }
+
+  NS_LOG_DEBUG(m_spatialNames.size() << " spatial names, " << m_appNames.size()
+               << " application names, " << m_nContents << " contents each");
+  m_spatialTable.build(m_spatialWeights);
+  m_appTable.build(m_appWeights);
+  m_sharedTable = ConsumerZipfMandelbrot::BuildPopularityTable(m_nContents, m_q, m_s,
+                                                               m_contentTable);
+  // ids of the previous names may not be valid anymore
+  m_history.clear();
+  m_historyPos = 0;
+  m_isBuilt = true;
+}
+
+uint32_t
+CorrelatedWorkload::Next(const Name* region, Name& prefix)
+{
+  if (!m_isBuilt)
+    Build();
+
+  uint32_t id;
+  if (!m_history.empty() && m_repeatProbability > 0.0 &&
+      m_rng->GetValue() < m_repeatProbability) {
+    id = m_history[m_rng->GetInteger(0, m_history.size() - 1)];
+    NS_LOG_DEBUG("repeat " << id);
+  }
+  else {
+    id = DrawNew(region);
+    if (m_history.size() < m_historySize) {
+      m_history.push_back(id);
+    }
+    else if (m_historySize > 0) {
+      m_history[m_historyPos] = id; // the oldest
+      m_historyPos = (m_historyPos + 1) % m_historySize;
+    }
+  }
+
+  prefix = GetPrefix(id);
+  return id;
+}
+
+uint32_t
+CorrelatedWorkload::DrawNew(const Name* region)
+{
+  uint32_t spatial;
+  auto local = region != nullptr ? m_spatialIndex.find(*region) : m_spatialIndex.end();
+  if (local != m_spatialIndex.end() && m_rng->GetValue() < m_localProbability)
+    spatial = local->second;
+  else
+    spatial = m_spatialTable.sample(m_rng->GetValue());
+
+  uint32_t app = m_appTable.sample(m_rng->GetValue());
+  uint32_t content = m_contentTable.sample(m_rng->GetValue());
+  return (spatial * static_cast<uint32_t>(m_appNames.size()) + app) * m_nContents + content;
+}
+
+Name
+CorrelatedWorkload::GetPrefix(uint32_t id) const
+{
+  uint32_t pair = id / m_nContents;
+  Name prefix(m_spatialNames[pair / m_appNames.size()]);
+  prefix.append(m_appNames[pair % m_appNames.size()]);
+  return prefix;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CORRELATED_WORKLOAD_H
+#define NDN_CORRELATED_WORKLOAD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-alias-table.hpp"
+#include "ns3/ndnSIM/utils/ndn-shared-input.hpp"
+
+#include "ns3/random-variable-stream.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Draws Interest names with the popularity, spatial and temporal locality of vehicular
+ *        requests
+ *
+ * A name is a spatial name (/S/...), an application name (/A/...) and the content id as the
+ * sequence number.  Every content of the hierarchy has its own id, so the same content is
+ * always requested with the same name, and repeated requests can be answered from caches.
+ * - Spatial locality: with the local probability, the spatial name is the region the node is
+ *   in (given by the caller, see MobilityPrefetcher); otherwise, or without region, it is drawn
+ *   by the weights of the spatial names.
+ * - Popularity: the application name is drawn by its weight, and one of the NumberOfContents
+ *   contents of the pair by Zipf-Mandelbrot (see ConsumerZipfMandelbrot).
+ * - Temporal locality: with the repeat probability, one of the last HistorySize contents drawn
+ *   as above is requested again instead.
+ *
+ * The tables are built on the first draw after the names or the parameters changed.
+ */
+class CorrelatedWorkload {
+public:
+  CorrelatedWorkload();
+
+  /**
+   * @brief Adds the names of a hierarchy, one per line, each optionally followed by its weight
+   *        (1 if not given); empty lines and lines starting with '#' are ignored
+   * @throw std::runtime_error a name is neither spatial nor an application name, or a
+   *        weight is not a non-negative number
+   */
+  void
+  Load(std::istream& is);
+
+  /**
+   * @throw std::runtime_error the file cannot be opened, or as Load(std::istream&)
+   */
+  void
+  Load(const std::string& file);
+
+  /**
+   * @brief Adds a spatial name, e.g. /S/NankaiDistrict/WeijingRoad
+   */
+  void
+  AddSpatialName(const Name& spatialName, double weight = 1.0);
+
+  /**
+   * @brief Adds an application name, e.g. /A/TrafficInformer/RoadCongestion
+   */
+  void
+  AddAppName(const Name& appName, double weight = 1.0);
+
+  size_t
+  GetNSpatialNames() const
+  {
+    return m_spatialNames.size();
+  }
+
+  const Name&
+  GetSpatialName(size_t i) const
+  {
+    return m_spatialNames[i];
+  }
+
+  size_t
+  GetNAppNames() const
+  {
+    return m_appNames.size();
+  }
+
+  /**
+   * @brief Sets the number of contents of every pair of spatial and application names, and
+   *        the parameters of their Zipf-Mandelbrot popularity
+   */
+  void
+  SetPopularity(uint32_t nContents, double q, double s);
+
+  void
+  SetLocalProbability(double probability)
+  {
+    m_localProbability = probability;
+  }
+
+  void
+  SetRepeatProbability(double probability, uint32_t historySize);
+
+  int64_t
+  AssignStreams(int64_t stream);
+
+  /**
+   * @brief Draws the next request
+   * @param region spatial name of the region the node is in, or nullptr if unknown
+   * @param[out] prefix spatial and application names of the content
+   * @return id of the content, to be used as sequence number
+   * @throw std::runtime_error there are no spatial or no application names, or more
+   *        contents than sequence numbers
+   */
+  uint32_t
+  Next(const Name* region, Name& prefix);
+
+  /**
+   * @brief Spatial and application names of content @p id
+   */
+  Name
+  GetPrefix(uint32_t id) const;
+
+private:
+  void
+  Build();
+
+  uint32_t
+  DrawNew(const Name* region);
+
+private:
+  std::vector<Name> m_spatialNames;
+  std::vector<double> m_spatialWeights;
+  std::map<Name, uint32_t> m_spatialIndex;
+  std::vector<Name> m_appNames;
+  std::vector<double> m_appWeights;
+
+  uint32_t m_nContents;
+  double m_q;
+  double m_s;
+  double m_localProbability;
+  double m_repeatProbability;
+  uint32_t m_historySize;
+
+  bool m_isBuilt;
+  AliasTable m_spatialTable;
+  AliasTable m_appTable;
+  std::shared_ptr<const SharedInput> m_sharedTable; // holds m_contentTable if it is shared
+  AliasTable m_contentTable;
+
+  std::vector<uint32_t> m_history; ///< ring buffer of the last contents
+  size_t m_historyPos;
+
+  Ptr<UniformRandomVariable> m_rng;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CORRELATED_WORKLOAD_H
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-correlativity-knowledge-base.hpp"
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.CorrelativityKnowledgeBase");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(CorrelativityKnowledgeBase);
+
+TypeId
+CorrelativityKnowledgeBase::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::CorrelativityKnowledgeBase")
+                        .SetGroupName("Ndn")
+                        .SetParent<Object>()
+                        .AddConstructor<CorrelativityKnowledgeBase>();
+  return tid;
+}
+
+CorrelativityKnowledgeBase::CorrelativityKnowledgeBase()
+  : m_nEstimators(0)
+{
+}
+
+Ptr<CorrelativityKnowledgeBase>
+CorrelativityKnowledgeBase::GetOrCreate(Ptr<Node> node)
+{
+  Ptr<CorrelativityKnowledgeBase> knowledgeBase = node->GetObject<CorrelativityKnowledgeBase>();
+  if (knowledgeBase == 0) {
+    NS_LOG_DEBUG("Aggregating correlativity knowledge base to node " << node->GetId());
+    knowledgeBase = CreateObject<CorrelativityKnowledgeBase>();
+    node->AggregateObject(knowledgeBase);
+  }
+  return knowledgeBase;
+}
+
+uint32_t
+CorrelativityKnowledgeBase::RegisterEstimator()
+{
+  return ++m_nEstimators;
+}
+
+void
+CorrelativityKnowledgeBase::AddSample(uint32_t estimator, const RttHistory& h)
+{
+  m_engine.AddSample(h, estimator);
+}
+
+void
+CorrelativityKnowledgeBase::RemoveSample(uint32_t estimator, const RttHistory& h)
+{
+  m_engine.RemoveSample(h, estimator);
+}
+
+bool
+CorrelativityKnowledgeBase::Estimate(const Name& name, Time now, double& rto,
+                                     bool isHopStratified)
+{
+  return m_engine.Estimate(name, now, rto, isHopStratified);
+}
+
+} // namespace ndn
+} // namespace ns3
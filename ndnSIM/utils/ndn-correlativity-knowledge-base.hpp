@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CORRELATIVITY_KNOWLEDGE_BASE_H
+#define NDN_CORRELATIVITY_KNOWLEDGE_BASE_H
+
+#include "ndn-rtt-correlativity.hpp"
+
+#include "ns3/object.h"
+#include "ns3/node.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief RTT samples shared by all correlativity RTO estimators on a node
+ *
+ * The knowledge base is aggregated to the Node.  Estimators attached to it (see
+ * RttMeanDeviation::SetKnowledgeBase) add their acknowledged samples to it and estimate RTO
+ * from the samples of all of them, so a newly started application benefits from RTTs measured
+ * by other applications of the node.  Every estimator still ages its own samples, as it keeps
+ * the history records they are made of.
+ */
+class CorrelativityKnowledgeBase : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  CorrelativityKnowledgeBase();
+
+  /**
+   * \brief Get knowledge base aggregated to the node, aggregating a new one if needed
+   */
+  static Ptr<CorrelativityKnowledgeBase>
+  GetOrCreate(Ptr<Node> node);
+
+  /**
+   * \brief Returns identifier that distinguishes samples of a new estimator
+   */
+  uint32_t
+  RegisterEstimator();
+
+  void
+  AddSample(uint32_t estimator, const RttHistory& h);
+
+  void
+  RemoveSample(uint32_t estimator, const RttHistory& h);
+
+  /**
+   * \brief Calculate the correlativity-weighted RTO for the name from samples of all estimators
+   * \see RttCorrelativityEngine::Estimate
+   */
+  bool
+  Estimate(const Name& name, Time now, double& rto, bool isHopStratified = false);
+
+  size_t
+  GetNSamples() const
+  {
+    return m_engine.GetNSamples();
+  }
+
+  size_t
+  GetMemoryUsage() const
+  {
+    return sizeof(*this) + m_engine.GetMemoryUsage();
+  }
+
+private:
+  RttCorrelativityEngine m_engine;
+  uint32_t m_nEstimators;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CORRELATIVITY_KNOWLEDGE_BASE_H
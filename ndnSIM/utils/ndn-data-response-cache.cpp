@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-response-cache.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+DataResponseCache::DataResponseCache(size_t capacity)
+  : m_capacity(capacity)
+{
+}
+
+shared_ptr<const Data>
+DataResponseCache::find(const Name& name)
+{
+  auto i = m_index.find(name);
+  if (i == m_index.end())
+    return nullptr;
+
+  m_queue.splice(m_queue.begin(), m_queue, i->second);
+  return *i->second;
+}
+
+void
+DataResponseCache::insert(shared_ptr<const Data> data)
+{
+  if (m_capacity == 0)
+    return;
+
+  auto i = m_index.find(data->getName());
+  if (i != m_index.end()) {
+    *i->second = data;
+    m_queue.splice(m_queue.begin(), m_queue, i->second);
+    return;
+  }
+
+  m_queue.push_front(data);
+  m_index.emplace(data->getName(), m_queue.begin());
+  evict();
+}
+
+void
+DataResponseCache::setCapacity(size_t capacity)
+{
+  m_capacity = capacity;
+  evict();
+}
+
+void
+DataResponseCache::clear()
+{
+  m_index.clear();
+  m_queue.clear();
+}
+
+void
+DataResponseCache::evict()
+{
+  while (m_index.size() > m_capacity) {
+    m_index.erase(m_queue.back()->getName());
+    m_queue.pop_back();
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DATA_RESPONSE_CACHE_H
+#define NDN_DATA_RESPONSE_CACHE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief LRU-bounded cache of encoded Data packets of a producer, by name
+ *
+ * Repeated and retransmitted Interests for a name are answered with a copy of the cached Data,
+ * which shares its wire encoding, instead of making and encoding the Data again.  The cached
+ * packets are never handed out themselves, as the forwarder modifies the Data it receives.
+ */
+class DataResponseCache {
+public:
+  /**
+   * \param capacity maximum number of cached Data packets, 0 disables the cache
+   */
+  explicit
+  DataResponseCache(size_t capacity = 0);
+
+  /**
+   * \brief Returns the Data of the name and makes it the most recently used, nullptr if none
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /**
+   * \brief Caches the encoded Data, evicting the least recently used entry if the cache is full
+   */
+  void
+  insert(shared_ptr<const Data> data);
+
+  void
+  setCapacity(size_t capacity);
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  size_t
+  size() const
+  {
+    return m_index.size();
+  }
+
+  void
+  clear();
+
+private:
+  void
+  evict();
+
+private:
+  typedef std::list<shared_ptr<const Data>> Queue; // most recently used first
+
+  size_t m_capacity;
+  Queue m_queue;
+  std::unordered_map<Name, Queue::iterator> m_index;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DATA_RESPONSE_CACHE_H
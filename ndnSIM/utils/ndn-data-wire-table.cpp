@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-wire-table.hpp"
+
+#include "core/city-hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+bool DataWireTable::s_isEnabled = false;
+
+// minimum number of entries at which expired entries are purged
+static const size_t MIN_PURGE_SIZE = 1024;
+
+namespace {
+
+struct State
+{
+  /// hash of the wire => buffer holding exactly the wire
+  std::unordered_multimap<uint64_t, std::weak_ptr<const ::ndn::Buffer>> entries;
+  size_t purgeSize = MIN_PURGE_SIZE; ///< size at which expired entries are purged next
+  uint64_t nLookups = 0;
+  uint64_t nHits = 0;
+  uint64_t nSharedBytes = 0;
+  std::mutex mutex; ///< nodes run on different threads under a multithreaded simulator
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+void
+purgeExpired(State& state)
+{
+  for (auto i = state.entries.begin(); i != state.entries.end();) {
+    if (i->second.expired())
+      i = state.entries.erase(i);
+    else
+      ++i;
+  }
+  state.purgeSize = std::max(MIN_PURGE_SIZE, 2 * state.entries.size());
+}
+
+} // namespace
+
+void
+DataWireTable::Enable()
+{
+  s_isEnabled = true;
+}
+
+void
+DataWireTable::Disable()
+{
+  s_isEnabled = false;
+  State& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.entries.clear();
+  state.purgeSize = MIN_PURGE_SIZE;
+  state.nLookups = 0;
+  state.nHits = 0;
+  state.nSharedBytes = 0;
+}
+
+Block
+DataWireTable::Intern(const Block& wire)
+{
+  State& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  ++state.nLookups;
+
+  uint64_t hash = CityHash64(reinterpret_cast<const char*>(wire.wire()), wire.size());
+  auto range = state.entries.equal_range(hash);
+  for (auto i = range.first; i != range.second; ++i) {
+    std::shared_ptr<const ::ndn::Buffer> buffer = i->second.lock();
+    if (buffer != nullptr && buffer->size() == wire.size() &&
+        std::memcmp(buffer->buf(), wire.wire(), wire.size()) == 0) {
+      ++state.nHits;
+      state.nSharedBytes += wire.size();
+      return Block(buffer);
+    }
+  }
+
+  if (state.entries.size() >= state.purgeSize) {
+    purgeExpired(state);
+  }
+
+  // the entry must not keep more than the wire alive
+  Block interned = wire;
+  if (wire.getBuffer()->size() != wire.size()) {
+    interned = Block(std::make_shared<const ::ndn::Buffer>(wire.wire(), wire.size()));
+  }
+  state.entries.emplace(hash, interned.getBuffer());
+  return interned;
+}
+
+size_t
+DataWireTable::GetNEntries()
+{
+  std::lock_guard<std::mutex> lock(getState().mutex);
+  return getState().entries.size();
+}
+
+uint64_t
+DataWireTable::GetNHits()
+{
+  std::lock_guard<std::mutex> lock(getState().mutex);
+  return getState().nHits;
+}
+
+uint64_t
+DataWireTable::GetNLookups()
+{
+  std::lock_guard<std::mutex> lock(getState().mutex);
+  return getState().nLookups;
+}
+
+uint64_t
+DataWireTable::GetNSharedBytes()
+{
+  std::lock_guard<std::mutex> lock(getState().mutex);
+  return getState().nSharedBytes;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_DATA_WIRE_TABLE_HPP
+#define NDNSIM_UTILS_NDN_DATA_WIRE_TABLE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Simulation-wide table of the wire encodings of received Data, so that all nodes
+ *        holding the same Data share one buffer
+ *
+ * Without it, every node that receives a Data decodes it into a buffer of its own (see
+ * Convert::FromPacket), and a popular Data is in memory once per content store it is cached in.
+ * Once enabled, a received Data whose wire encoding is byte for byte the one of a Data still
+ * held somewhere in the simulation is decoded from the buffer of that Data instead.  Equal
+ * wire encodings are equivalent to equal implicit digests, without computing SHA-256.
+ *
+ * The table does not own the buffers: a buffer goes away with the last Data using it, e.g.,
+ * when the last content store evicts it, and its entry is purged lazily.  The decoded Data
+ * objects (name, tags) remain per node, only the wire, with the Content, is shared.
+ *
+ * Example:
+ *
+ *     ndn::DataWireTable::Enable();
+ *     ...
+ *     Simulator::Run();
+ *     std::cout << ndn::DataWireTable::GetNSharedBytes() << " bytes not copied\n";
+ */
+class DataWireTable
+{
+public:
+  static void
+  Enable();
+
+  /**
+   * @brief Stop sharing, and forget the entries and the counters
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled()
+  {
+    return s_isEnabled;
+  }
+
+  /**
+   * @brief Get a block sharing the buffer of an equal wire in the table, or add @p wire
+   * @param wire TLV block of a Data
+   */
+  static Block
+  Intern(const Block& wire);
+
+  /**
+   * @brief Number of entries, including entries whose buffer is gone but not purged yet
+   */
+  static size_t
+  GetNEntries();
+
+  /**
+   * @brief Number of wires of which an equal one was in the table
+   */
+  static uint64_t
+  GetNHits();
+
+  static uint64_t
+  GetNLookups();
+
+  /**
+   * @brief Total size of the wires of the hits, i.e., of the copies not kept
+   */
+  static uint64_t
+  GetNSharedBytes();
+
+private:
+  static bool s_isEnabled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_DATA_WIRE_TABLE_HPP
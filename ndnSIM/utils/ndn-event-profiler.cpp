@@ -0,0 +1,741 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-event-profiler.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/simulator-impl.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/global-value.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+#include "ns3/node-list.h"
+#include "ns3/mobility-model.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.EventProfiler");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double
+toSeconds(Clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+std::string
+demangle(const char* name)
+{
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (status != 0) {
+    return name;
+  }
+  std::string result(demangled);
+  free(demangled);
+  return result;
+}
+
+/**
+ * @brief Get the part of @p name from @p pos up to the first of @p stops outside of
+ *        brackets and parentheses
+ */
+std::string
+untilTopLevel(const std::string& name, size_t pos, const std::string& stops)
+{
+  int depth = 0;
+  for (size_t i = pos; i < name.size(); ++i) {
+    char c = name[i];
+    if (depth == 0 && stops.find(c) != std::string::npos) {
+      return name.substr(pos, i - pos);
+    }
+    if (c == '<' || c == '(') {
+      ++depth;
+    }
+    else if (c == '>' || c == ')') {
+      --depth;
+    }
+  }
+  return name.substr(pos);
+}
+
+/**
+ * @brief Get the type of the callback of an event created by ns3::MakeEvent
+ *
+ * "ns3::MakeEvent<void (ns3::ndn::Consumer::*)(), ns3::ndn::Consumer*>(...)::EventMemberImpl0"
+ * becomes "void (ns3::ndn::Consumer::*)()".
+ */
+std::string
+getCallbackType(const EventImpl& event)
+{
+  static std::unordered_map<std::type_index, std::string> cache;
+
+  std::type_index type(typeid(event));
+  auto it = cache.find(type);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::string name = demangle(type.name());
+  const std::string makeEvent = "ns3::MakeEvent<";
+  if (name.compare(0, makeEvent.size(), makeEvent) == 0) {
+    name = untilTopLevel(name, makeEvent.size(), ",>");
+  }
+  cache.emplace(type, name);
+  return name;
+}
+
+/**
+ * @brief Name of the function with the instruction at @p address, empty if it belongs to the
+ *        simulator or to a scheduler
+ */
+std::string
+getFunctionName(void* address)
+{
+  static const std::vector<std::string> SKIPPED = {
+    "ns3::Simulator::",
+    "ns3::MakeEvent",
+    "ns3::Timer",
+    "ns3::EventId::",
+    "ns3::ndn::ProfilingSimulatorImpl::",
+    "ndn::util::scheduler::",
+    "nfd::scheduler::",
+  };
+  static std::unordered_map<void*, std::string> cache;
+
+  auto it = cache.find(address);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::string name = "?";
+  Dl_info info;
+  if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
+    name = demangle(info.dli_sname);
+    // drop the return type of function templates and the arguments
+    std::string function = untilTopLevel(name, 0, " (");
+    if (function.size() < name.size() && name[function.size()] == ' ') {
+      name = name.substr(function.size() + 1);
+    }
+    name = untilTopLevel(name, 0, "(");
+
+    for (const std::string& skipped : SKIPPED) {
+      if (name.compare(0, skipped.size(), skipped) == 0) {
+        name.clear();
+        break;
+      }
+    }
+  }
+  cache.emplace(address, name);
+  return name;
+}
+
+std::string
+getCaller()
+{
+  const int MAX_FRAMES = 32;
+  void* frames[MAX_FRAMES];
+  int nFrames = backtrace(frames, MAX_FRAMES);
+
+  // frame 0 is this function, frame 1 is ProfilingSimulatorImpl::profile
+  for (int i = 2; i < nFrames; ++i) {
+    std::string name = getFunctionName(frames[i]);
+    if (!name.empty()) {
+      return name;
+    }
+  }
+  return "?";
+}
+
+struct NodeCounters
+{
+  uint64_t nExecuted = 0;
+  double wallTime = 0;
+};
+
+/**
+ * @brief Profiling state, shared by the enabled simulator implementation and EventProfiler
+ */
+struct State
+{
+  bool isEnabled = false;
+  EventProfiler::Attribution attribution = EventProfiler::CALLBACK_TYPE;
+  std::string wrappedType;
+  Time reportInterval;
+  size_t nTop = 10;
+  std::string csvFile;
+  std::string nodeCsvFile;
+
+  std::mutex mutex;
+  std::map<std::string, EventProfiler::Record> records;
+  std::deque<NodeCounters> nodes; ///< by context; a deque, so the counters never move
+  NodeCounters noContext;
+  Clock::duration runTime = Clock::duration::zero();
+  bool isProfiling = false; ///< whether the current simulator is profiling
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+} // namespace
+
+/**
+ * @brief Event that executes the scheduled event and adds its wall time to its record
+ */
+class ProfiledEvent : public EventImpl
+{
+public:
+  ProfiledEvent(EventImpl* event, EventProfiler::Record& record, NodeCounters& node)
+    : m_event(event, false)
+    , m_record(record)
+    , m_node(node)
+  {
+  }
+
+  EventProfiler::Record&
+  getRecord()
+  {
+    return m_record;
+  }
+
+protected:
+  virtual void
+  Notify()
+  {
+    Clock::time_point start = Clock::now();
+    m_event->Invoke();
+    double wallTime = toSeconds(Clock::now() - start);
+    m_record.wallTime += wallTime;
+    ++m_record.nExecuted;
+    m_node.wallTime += wallTime;
+    ++m_node.nExecuted;
+  }
+
+private:
+  Ptr<EventImpl> m_event;
+  EventProfiler::Record& m_record;
+  NodeCounters& m_node;
+};
+
+/**
+ * @brief Simulator implementation that profiles the events of the wrapped implementation
+ */
+class ProfilingSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::ProfilingSimulatorImpl")
+      .SetParent<SimulatorImpl>()
+      .AddConstructor<ProfilingSimulatorImpl>();
+    return tid;
+  }
+
+  ProfilingSimulatorImpl()
+  {
+    State& state = getState();
+    state.records.clear();
+    state.nodes.clear();
+    state.noContext = NodeCounters();
+    state.runTime = Clock::duration::zero();
+    state.isProfiling = true;
+
+    ObjectFactory factory;
+    factory.SetTypeId(state.wrappedType);
+    m_impl = factory.Create<SimulatorImpl>();
+  }
+
+  virtual void
+  Destroy()
+  {
+    State& state = getState();
+    // while the nodes, and their positions, still exist
+    if (!state.nodeCsvFile.empty()) {
+      std::ofstream os(state.nodeCsvFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+      if (!os.is_open()) {
+        NS_LOG_ERROR("File " << state.nodeCsvFile << " cannot be opened for writing");
+      }
+      else {
+        EventProfiler::WriteNodeCsv(os);
+      }
+    }
+
+    m_impl->Destroy();
+
+    state.isProfiling = false;
+    if (!state.csvFile.empty()) {
+      std::ofstream os(state.csvFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+      if (!os.is_open()) {
+        NS_LOG_ERROR("File " << state.csvFile << " cannot be opened for writing");
+      }
+      else {
+        EventProfiler::WriteCsv(os);
+      }
+    }
+  }
+
+  virtual bool
+  IsFinished() const
+  {
+    return m_impl->IsFinished();
+  }
+
+  virtual void
+  Stop()
+  {
+    m_impl->Stop();
+  }
+
+  virtual void
+  Stop(const Time& time)
+  {
+    m_impl->Stop(time);
+  }
+
+  virtual EventId
+  Schedule(const Time& time, EventImpl* event)
+  {
+    return m_impl->Schedule(time, profile(event, m_impl->GetContext()));
+  }
+
+  virtual void
+  ScheduleWithContext(uint32_t context, const Time& time, EventImpl* event)
+  {
+    m_impl->ScheduleWithContext(context, time, profile(event, context));
+  }
+
+  virtual EventId
+  ScheduleNow(EventImpl* event)
+  {
+    return m_impl->ScheduleNow(profile(event, m_impl->GetContext()));
+  }
+
+  virtual EventId
+  ScheduleDestroy(EventImpl* event)
+  {
+    return m_impl->ScheduleDestroy(profile(event, Simulator::NO_CONTEXT));
+  }
+
+  virtual void
+  Remove(const EventId& id)
+  {
+    countCancelled(id);
+    m_impl->Remove(id);
+  }
+
+  virtual void
+  Cancel(const EventId& id)
+  {
+    countCancelled(id);
+    m_impl->Cancel(id);
+  }
+
+  virtual bool
+  IsExpired(const EventId& id) const
+  {
+    return m_impl->IsExpired(id);
+  }
+
+  virtual void
+  Run()
+  {
+    State& state = getState();
+    if (!state.reportInterval.IsZero()) {
+      scheduleReport();
+    }
+
+    Clock::time_point start = Clock::now();
+    m_impl->Run();
+    state.runTime += Clock::now() - start;
+
+    if (!state.reportInterval.IsZero()) {
+      std::clog << "Event profile at the end of the simulation" << std::endl;
+      EventProfiler::PrintReport(std::clog, state.nTop);
+    }
+  }
+
+  virtual Time
+  Now() const
+  {
+    return m_impl->Now();
+  }
+
+  virtual Time
+  GetDelayLeft(const EventId& id) const
+  {
+    return m_impl->GetDelayLeft(id);
+  }
+
+  virtual Time
+  GetMaximumSimulationTime() const
+  {
+    return m_impl->GetMaximumSimulationTime();
+  }
+
+  virtual void
+  SetScheduler(ObjectFactory schedulerFactory)
+  {
+    m_impl->SetScheduler(schedulerFactory);
+  }
+
+  virtual uint32_t
+  GetSystemId() const
+  {
+    return m_impl->GetSystemId();
+  }
+
+  virtual uint32_t
+  GetContext() const
+  {
+    return m_impl->GetContext();
+  }
+
+protected:
+  virtual void
+  DoDispose()
+  {
+    m_impl = 0;
+    SimulatorImpl::DoDispose();
+  }
+
+private:
+  /**
+   * @param context context in which the event will run
+   */
+  EventImpl*
+  profile(EventImpl* event, uint32_t context)
+  {
+    State& state = getState();
+    // events can be scheduled from other threads, e.g., with the realtime simulator
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::string label = getCallbackType(*event);
+    if (state.attribution == EventProfiler::CALLER) {
+      label = getCaller() + " " + label;
+    }
+
+    EventProfiler::Record& record = state.records[label];
+    if (record.label.empty()) {
+      record = {label, 0, 0, 0, 0.0};
+    }
+    ++record.nScheduled;
+
+    NodeCounters* node = &state.noContext;
+    if (context != Simulator::NO_CONTEXT) {
+      if (context >= state.nodes.size()) {
+        state.nodes.resize(context + 1);
+      }
+      node = &state.nodes[context];
+    }
+    return new ProfiledEvent(event, record, *node);
+  }
+
+  void
+  countCancelled(const EventId& id)
+  {
+    ProfiledEvent* event = dynamic_cast<ProfiledEvent*>(id.PeekEventImpl());
+    if (event != nullptr && !m_impl->IsExpired(id)) {
+      ++event->getRecord().nCancelled;
+    }
+  }
+
+  /**
+   * The report is scheduled in the wrapped implementation, so it is not profiled itself
+   */
+  void
+  scheduleReport()
+  {
+    m_impl->Schedule(getState().reportInterval,
+                     MakeEvent(&ProfilingSimulatorImpl::report, this));
+  }
+
+  void
+  report()
+  {
+    std::clog << "Event profile at " << Now().ToDouble(Time::S) << "s" << std::endl;
+    EventProfiler::PrintReport(std::clog, getState().nTop);
+    scheduleReport();
+  }
+
+private:
+  Ptr<SimulatorImpl> m_impl;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+void
+EventProfiler::Enable(Attribution attribution)
+{
+  State& state = getState();
+  state.attribution = attribution;
+  if (state.isEnabled) {
+    return;
+  }
+
+  StringValue type;
+  GlobalValue::GetValueByName("SimulatorImplementationType", type);
+  state.wrappedType = type.Get();
+  GlobalValue::Bind("SimulatorImplementationType",
+                    StringValue(ProfilingSimulatorImpl::GetTypeId().GetName()));
+  state.isEnabled = true;
+
+  if (DynamicCast<ProfilingSimulatorImpl>(Simulator::GetImplementation()) == 0) {
+    NS_FATAL_ERROR("EventProfiler::Enable must be called before the simulator is used");
+  }
+}
+
+void
+EventProfiler::Disable()
+{
+  State& state = getState();
+  if (!state.isEnabled) {
+    return;
+  }
+
+  GlobalValue::Bind("SimulatorImplementationType", StringValue(state.wrappedType));
+  state.isEnabled = false;
+}
+
+bool
+EventProfiler::IsEnabled()
+{
+  return getState().isProfiling;
+}
+
+void
+EventProfiler::SetReportInterval(Time interval, size_t nTop)
+{
+  getState().reportInterval = interval;
+  getState().nTop = nTop;
+}
+
+void
+EventProfiler::SetCsvFile(const std::string& file)
+{
+  getState().csvFile = file;
+}
+
+void
+EventProfiler::SetNodeCsvFile(const std::string& file)
+{
+  getState().nodeCsvFile = file;
+}
+
+std::vector<EventProfiler::Record>
+EventProfiler::GetRecords()
+{
+  State& state = getState();
+  std::vector<Record> records;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (const auto& record : state.records) {
+      records.push_back(record.second);
+    }
+  }
+
+  std::sort(records.begin(), records.end(), [] (const Record& a, const Record& b) {
+      return a.wallTime > b.wallTime;
+    });
+  return records;
+}
+
+std::vector<EventProfiler::NodeRecord>
+EventProfiler::GetNodeRecords()
+{
+  State& state = getState();
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<NodeRecord> records;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (size_t id = 0; id < state.nodes.size(); ++id) {
+      const NodeCounters& counters = state.nodes[id];
+      if (counters.nExecuted == 0) {
+        continue;
+      }
+      NodeRecord record = {static_cast<uint32_t>(id), counters.nExecuted, counters.wallTime,
+                           Vector(nan, nan, nan)};
+      if (id < NodeList::GetNNodes()) {
+        Ptr<MobilityModel> mobility = NodeList::GetNode(id)->GetObject<MobilityModel>();
+        if (mobility != nullptr) {
+          record.position = mobility->GetPosition();
+        }
+      }
+      records.push_back(record);
+    }
+    if (state.noContext.nExecuted > 0) {
+      records.push_back({Simulator::NO_CONTEXT, state.noContext.nExecuted,
+                         state.noContext.wallTime, Vector(nan, nan, nan)});
+    }
+  }
+
+  std::sort(records.begin(), records.end(), [] (const NodeRecord& a, const NodeRecord& b) {
+      return a.wallTime > b.wallTime;
+    });
+  return records;
+}
+
+void
+EventProfiler::PrintReport(std::ostream& os, size_t nTop)
+{
+  std::vector<Record> records = GetRecords();
+
+  double eventTime = 0;
+  uint64_t nExecuted = 0;
+  for (const Record& record : records) {
+    eventTime += record.wallTime;
+    nExecuted += record.nExecuted;
+  }
+  double runTime = toSeconds(getState().runTime);
+  double total = std::max(eventTime, runTime);
+
+  os << std::fixed << std::setprecision(3)
+     << "Executed " << nExecuted << " events in " << eventTime << "s";
+  if (runTime > 0) {
+    os << ", simulator overhead " << std::max(0.0, runTime - eventTime) << "s";
+  }
+  os << "\n";
+
+  os << std::setw(12) << "Executed" << std::setw(12) << "Scheduled" << std::setw(12) << "Cancelled"
+     << std::setw(12) << "Wall(s)" << std::setw(8) << "%" << "  Label\n";
+  for (size_t i = 0; i < records.size() && (nTop == 0 || i < nTop); ++i) {
+    const Record& record = records[i];
+    os << std::setw(12) << record.nExecuted
+       << std::setw(12) << record.nScheduled
+       << std::setw(12) << record.nCancelled
+       << std::setw(12) << record.wallTime
+       << std::setw(8) << std::setprecision(1) << (total > 0 ? 100 * record.wallTime / total : 0.0)
+       << std::setprecision(3) << "  " << record.label << "\n";
+  }
+  os.unsetf(std::ios_base::floatfield);
+  os << std::flush;
+}
+
+void
+EventProfiler::WriteCsv(std::ostream& os)
+{
+  os << "Label,Scheduled,Executed,Cancelled,WallTime,MeanTime\n";
+  for (const Record& record : GetRecords()) {
+    std::string label = record.label;
+    for (size_t pos = label.find('"'); pos != std::string::npos; pos = label.find('"', pos + 2)) {
+      label.insert(pos, 1, '"');
+    }
+    os << '"' << label << '"' << ","
+       << record.nScheduled << ","
+       << record.nExecuted << ","
+       << record.nCancelled << ","
+       << record.wallTime << ","
+       << (record.nExecuted > 0 ? 1e6 * record.wallTime / record.nExecuted : 0.0) << "\n";
+  }
+  os << std::flush;
+}
+
+void
+EventProfiler::PrintNodeReport(std::ostream& os, size_t nTop)
+{
+  std::vector<NodeRecord> records = GetNodeRecords();
+
+  double eventTime = 0;
+  for (const NodeRecord& record : records) {
+    eventTime += record.wallTime;
+  }
+
+  os << std::fixed << std::setprecision(3)
+     << std::setw(12) << "Executed" << std::setw(12) << "Wall(s)" << std::setw(8) << "%"
+     << std::setw(10) << "X" << std::setw(10) << "Y" << "  Node\n";
+  for (size_t i = 0; i < records.size() && (nTop == 0 || i < nTop); ++i) {
+    const NodeRecord& record = records[i];
+    os << std::setw(12) << record.nExecuted
+       << std::setw(12) << record.wallTime
+       << std::setw(8) << std::setprecision(1)
+       << (eventTime > 0 ? 100 * record.wallTime / eventTime : 0.0)
+       << std::setw(10) << record.position.x << std::setw(10) << record.position.y
+       << std::setprecision(3) << "  ";
+    if (record.node == Simulator::NO_CONTEXT) {
+      os << "-";
+    }
+    else {
+      os << record.node;
+    }
+    os << "\n";
+  }
+  os.unsetf(std::ios_base::floatfield);
+  os << std::flush;
+}
+
+void
+EventProfiler::WriteNodeCsv(std::ostream& os)
+{
+  std::vector<NodeRecord> records = GetNodeRecords();
+
+  double eventTime = 0;
+  for (const NodeRecord& record : records) {
+    eventTime += record.wallTime;
+  }
+
+  os << "Node,Executed,WallTime,MeanTime,Share,X,Y\n";
+  for (const NodeRecord& record : records) {
+    if (record.node != Simulator::NO_CONTEXT) {
+      os << record.node;
+    }
+    os << ","
+       << record.nExecuted << ","
+       << record.wallTime << ","
+       << (record.nExecuted > 0 ? 1e6 * record.wallTime / record.nExecuted : 0.0) << ","
+       << (eventTime > 0 ? record.wallTime / eventTime : 0.0) << ",";
+    if (!std::isnan(record.position.x)) {
+      os << record.position.x << "," << record.position.y;
+    }
+    else {
+      os << ",";
+    }
+    os << "\n";
+  }
+  os << std::flush;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_UTILS_NDN_EVENT_PROFILER_HPP
+#define NDNSIM_UTILS_NDN_EVENT_PROFILER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <iostream>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Profiler of the events executed by the simulator
+ *
+ * When enabled, the simulator implementation is wrapped (see SimulatorImplementationType), and
+ * every event is attributed to a label:
+ *  - CALLBACK_TYPE: the type of the scheduled callback, e.g.,
+ *    "void (ns3::ndn::Consumer::*)()" for member functions of Consumer without arguments.  All
+ *    events of the ndn-cxx and NFD schedulers (PIT timers, strategy retransmissions, etc.) have
+ *    the same type "void (std::function<void ()>::*)() const"
+ *  - CALLER: the function that scheduled the event, followed by the type of the callback, e.g.,
+ *    "ns3::ndn::Consumer::ScheduleNextPacket void (ns3::ndn::Consumer::*)()".  Frames of the
+ *    simulator, of ns3::Timer and of the ndn-cxx and NFD schedulers are skipped, so PIT timers
+ *    are attributed to the forwarder code that sets them.  Names are resolved with dladdr, so
+ *    functions that are not exported are attributed to the nearest exported symbol.
+ *
+ * For every label, the number of scheduled, executed and cancelled events and the wall time
+ * spent in the executed events are counted.  Attribution by caller takes a stack trace on every
+ * Schedule call and is therefore considerably slower than attribution by callback type.
+ *
+ * The executed events and their wall time are also counted per node, i.e., per context of the
+ * event (Simulator::GetContext): events scheduled with a context run in it, and the others in
+ * the context of the event that scheduled them.  The nodes costing the most, with their
+ * positions, show the dense regions worth partitioning differently or culling.
+ *
+ * Example:
+ *
+ *     ndn::EventProfiler::Enable(); // before any other use of the simulator
+ *     ndn::EventProfiler::SetReportInterval(Seconds(100));
+ *     ndn::EventProfiler::SetCsvFile("event-profile.csv");
+ *     ...
+ *     Simulator::Run();
+ *     Simulator::Destroy(); // writes event-profile.csv
+ */
+class EventProfiler
+{
+public:
+  enum Attribution {
+    CALLBACK_TYPE,
+    CALLER
+  };
+
+  struct Record
+  {
+    std::string label;
+    uint64_t nScheduled;
+    uint64_t nExecuted;
+    uint64_t nCancelled;
+    double wallTime; ///< seconds spent executing the events
+  };
+
+  struct NodeRecord
+  {
+    uint32_t node;    ///< id of the node, Simulator::NO_CONTEXT for events outside of nodes
+    uint64_t nExecuted;
+    double wallTime;  ///< seconds spent executing the events of the node
+    Vector position;  ///< current position of the node, NaN without mobility model
+  };
+
+  /**
+   * @brief Enable profiling of the simulations created from now on
+   *
+   * Must be called before the simulator is used, as the implementation of the simulator
+   * cannot be replaced afterwards.  The implementation selected before is wrapped, so
+   * profiling also works with the realtime and distributed simulators.
+   */
+  static void
+  Enable(Attribution attribution = CALLBACK_TYPE);
+
+  /**
+   * @brief Restore the simulator implementation selected before Enable
+   *
+   * Takes effect for the simulation created after the current one is destroyed.
+   */
+  static void
+  Disable();
+
+  /**
+   * @brief Whether events of the current simulation are profiled
+   */
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Print the report to std::clog every @p interval of simulation time, and when
+   *        Simulator::Run returns
+   * @param interval 0 to disable the reports (default)
+   * @param nTop number of labels with the largest wall time in a report, 0 for all
+   */
+  static void
+  SetReportInterval(Time interval, size_t nTop = 10);
+
+  /**
+   * @brief Write the records as CSV to the file when the simulation is destroyed
+   * @param file empty to disable (default)
+   */
+  static void
+  SetCsvFile(const std::string& file);
+
+  /**
+   * @brief Write the node records as CSV to the file before the simulation is destroyed
+   * @param file empty to disable (default)
+   */
+  static void
+  SetNodeCsvFile(const std::string& file);
+
+  /**
+   * @brief Get the records of the current simulation, the largest wall time first
+   */
+  static std::vector<Record>
+  GetRecords();
+
+  /**
+   * @brief Get the records of the nodes with executed events, the largest wall time first
+   */
+  static std::vector<NodeRecord>
+  GetNodeRecords();
+
+  /**
+   * @brief Print the labels with the largest wall time, their share of the wall time of
+   *        Simulator::Run, and the time spent by the simulator outside of the events
+   */
+  static void
+  PrintReport(std::ostream& os, size_t nTop = 0);
+
+  /**
+   * @brief Write the records as CSV
+   *
+   * Columns are Label, Scheduled, Executed, Cancelled, WallTime (seconds) and MeanTime
+   * (microseconds per executed event).
+   */
+  static void
+  WriteCsv(std::ostream& os);
+
+  /**
+   * @brief Print the nodes with the largest wall time, and their share of the wall time of
+   *        the events
+   */
+  static void
+  PrintNodeReport(std::ostream& os, size_t nTop = 0);
+
+  /**
+   * @brief Write the node records as CSV
+   *
+   * Columns are Node (empty for events outside of nodes), Executed, WallTime (seconds),
+   * MeanTime (microseconds per executed event), Share (of the wall time of all events), X
+   * and Y.
+   */
+  static void
+  WriteNodeCsv(std::ostream& os);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_EVENT_PROFILER_HPP
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-geo-position-tag.hpp"
+#include "ndn-ns3-packet-tag.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+namespace ndn {
+
+TypeId
+GeoPositionTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::GeoPositionTag").SetParent<Tag>().AddConstructor<GeoPositionTag>();
+  return tid;
+}
+
+TypeId
+GeoPositionTag::GetInstanceTypeId() const
+{
+  return GeoPositionTag::GetTypeId();
+}
+
+bool
+GeoPositionTag::GetPreviousHopPosition(const ::ndn::TagHost& packet, Vector& position)
+{
+  std::shared_ptr<Ns3PacketTag> packetTag = packet.getTag<Ns3PacketTag>();
+  GeoPositionTag tag;
+  if (packetTag == nullptr || !packetTag->getPacket()->PeekPacketTag(tag))
+    return false;
+
+  position = tag.GetPosition();
+  return true;
+}
+
+bool
+GeoPositionTag::GetCurrentNodePosition(Vector& position)
+{
+  uint32_t context = Simulator::GetContext();
+  if (context >= NodeList::GetNNodes())
+    return false;
+
+  Ptr<MobilityModel> mobility = NodeList::GetNode(context)->GetObject<MobilityModel>();
+  if (mobility == 0)
+    return false;
+
+  position = mobility->GetPosition();
+  return true;
+}
+
+uint32_t
+GeoPositionTag::GetSerializedSize() const
+{
+  return 3 * sizeof(double);
+}
+
+void
+GeoPositionTag::Serialize(TagBuffer i) const
+{
+  i.WriteDouble(m_position.x);
+  i.WriteDouble(m_position.y);
+  i.WriteDouble(m_position.z);
+}
+
+void
+GeoPositionTag::Deserialize(TagBuffer i)
+{
+  m_position.x = i.ReadDouble();
+  m_position.y = i.ReadDouble();
+  m_position.z = i.ReadDouble();
+}
+
+void
+GeoPositionTag::Print(std::ostream& os) const
+{
+  os << "pos=(" << m_position.x << "," << m_position.y << "," << m_position.z << ")";
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GEO_POSITION_TAG_H
+#define NDN_GEO_POSITION_TAG_H
+
+#include "ns3/tag.h"
+#include "ns3/vector.h"
+
+#include <ndn-cxx/tag-host.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Packet tag carrying the position of the node that sent the frame
+ *
+ * NetDeviceFace attaches the position of its node to every frame it sends, if the node has
+ * a MobilityModel, so that receivers (e.g., GeoForwardingStrategy) know where the previous
+ * hop of a packet was.  Nodes that forward the packet replace the tag with their own position.
+ */
+class GeoPositionTag : public Tag {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  GeoPositionTag()
+  {
+  }
+
+  explicit
+  GeoPositionTag(const Vector& position)
+    : m_position(position)
+  {
+  }
+
+  const Vector&
+  GetPosition() const
+  {
+    return m_position;
+  }
+
+  /**
+   * @brief Get position of the node that sent the Interest or Data to this node
+   * @return false if the packet did not come from a NetDeviceFace of a node with mobility
+   */
+  static bool
+  GetPreviousHopPosition(const ::ndn::TagHost& packet, Vector& position);
+
+  /**
+   * @brief Get position of the node of the current simulation context
+   *
+   * The forwarder of a node runs in the context of its node.
+   *
+   * @return false if there is no node context or the node has no MobilityModel
+   */
+  static bool
+  GetCurrentNodePosition(Vector& position);
+
+  ////////////////////////////////////////////////////////
+  // from ObjectBase
+  ////////////////////////////////////////////////////////
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  ////////////////////////////////////////////////////////
+  // from Tag
+  ////////////////////////////////////////////////////////
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  Vector m_position;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GEO_POSITION_TAG_H
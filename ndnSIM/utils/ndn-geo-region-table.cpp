@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-geo-region-table.hpp"
+
+#include <ndn-cxx/structured-name-view.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+std::map<Name, GeoRegionTable::Region>&
+GeoRegionTable::GetRegions()
+{
+  static std::map<Name, Region> regions;
+  return regions;
+}
+
+void
+GeoRegionTable::Add(const Name& spatialPrefix, const Vector& center, double radius)
+{
+  Region& region = GetRegions()[spatialPrefix];
+  region.center = center;
+  region.radius = radius;
+}
+
+void
+GeoRegionTable::Clear()
+{
+  GetRegions().clear();
+}
+
+const GeoRegionTable::Region*
+GeoRegionTable::Find(const Name& name)
+{
+  std::map<Name, Region>& regions = GetRegions();
+  if (regions.empty())
+    return nullptr;
+
+  ::ndn::StructuredNameView view(name);
+  if (!view.hasSpatialPart())
+    return nullptr;
+
+  size_t begin = view.spatialBegin() - name.begin();
+  for (size_t length = view.spatialEnd() - view.spatialBegin(); length > 0; --length) {
+    auto region = regions.find(name.getSubName(begin, length));
+    if (region != regions.end())
+      return &region->second;
+  }
+  return nullptr;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GEO_REGION_TABLE_H
+#define NDN_GEO_REGION_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/vector.h"
+
+#include <map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Geographic location of the spatial segments of structured names
+ *
+ * Maps spatial segments (the components between "S" and "A" of /.../S/<spatial>/A/<...>
+ * names, see ::ndn::StructuredNameView) to a circular area.  A region can be registered at
+ * any depth, e.g. "/NankaiDistrict" and "/NankaiDistrict/WeijingRoad"; lookups use the
+ * longest registered prefix of the spatial segment of the name.
+ *
+ * The table is shared by all nodes of the simulation.
+ */
+class GeoRegionTable {
+public:
+  struct Region {
+    Vector center;
+    double radius; ///< meters
+  };
+
+  /**
+   * @brief Register (or replace) the area of a spatial segment
+   * @param spatialPrefix components of the spatial segment, without the "S" marker
+   */
+  static void
+  Add(const Name& spatialPrefix, const Vector& center, double radius = 0.0);
+
+  static void
+  Clear();
+
+  /**
+   * @brief Find area of the longest registered prefix of the name's spatial segment
+   * @return nullptr if the name has no spatial segment or no prefix of it is registered
+   */
+  static const Region*
+  Find(const Name& name);
+
+  static size_t
+  GetNRegions()
+  {
+    return GetRegions().size();
+  }
+
+private:
+  static std::map<Name, Region>&
+  GetRegions();
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GEO_REGION_TABLE_H
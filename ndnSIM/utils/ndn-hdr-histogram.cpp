@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-hdr-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t LINEAR_BUCKETS = 128; ///< values below have a bucket each
+static const size_t SUB_BUCKETS = 64;     ///< buckets per power of two range above
+
+HdrHistogram::HdrHistogram()
+  : m_count(0)
+  , m_sum(0)
+  , m_min(std::numeric_limits<uint64_t>::max())
+  , m_max(0)
+{
+}
+
+size_t
+HdrHistogram::GetBucket(uint64_t value)
+{
+  if (value < LINEAR_BUCKETS)
+    return value;
+
+  int magnitude = 63 - __builtin_clzll(value); // >= 7
+  int shift = magnitude - 6;                   // keeps the top 7 bits, in [64, 128)
+  return LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+}
+
+void
+HdrHistogram::GetRange(size_t bucket, uint64_t& lowest, uint64_t& width)
+{
+  if (bucket < LINEAR_BUCKETS) {
+    lowest = bucket;
+    width = 1;
+    return;
+  }
+
+  int shift = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+  uint64_t top = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+  lowest = top << shift;
+  width = uint64_t(1) << shift;
+}
+
+void
+HdrHistogram::Record(uint64_t value, uint64_t count/* = 1*/)
+{
+  if (count == 0)
+    return;
+
+  size_t bucket = GetBucket(value);
+  if (bucket >= m_counts.size())
+    m_counts.resize(bucket + 1, 0);
+
+  m_counts[bucket] += count;
+  m_count += count;
+  m_sum += static_cast<double>(value) * count;
+  m_min = std::min(m_min, value);
+  m_max = std::max(m_max, value);
+}
+
+void
+HdrHistogram::Merge(const HdrHistogram& other)
+{
+  if (other.m_count == 0)
+    return;
+
+  if (other.m_counts.size() > m_counts.size())
+    m_counts.resize(other.m_counts.size(), 0);
+  for (size_t i = 0; i < other.m_counts.size(); ++i)
+    m_counts[i] += other.m_counts[i];
+
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+  m_min = std::min(m_min, other.m_min);
+  m_max = std::max(m_max, other.m_max);
+}
+
+void
+HdrHistogram::Reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0); // keep the buckets for the next period
+  m_count = 0;
+  m_sum = 0;
+  m_min = std::numeric_limits<uint64_t>::max();
+  m_max = 0;
+}
+
+double
+HdrHistogram::GetMean() const
+{
+  return m_count == 0 ? 0 : m_sum / m_count;
+}
+
+uint64_t
+HdrHistogram::GetMin() const
+{
+  return m_count == 0 ? 0 : m_min;
+}
+
+uint64_t
+HdrHistogram::GetPercentile(double percent) const
+{
+  if (m_count == 0)
+    return 0;
+
+  uint64_t rank = static_cast<uint64_t>(std::ceil(std::max(0.0, std::min(100.0, percent)) / 100
+                                                  * m_count));
+  if (rank <= 1)
+    return m_min;
+  if (rank >= m_count)
+    return m_max;
+
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < m_counts.size(); ++bucket) {
+    seen += m_counts[bucket];
+    if (seen >= rank) {
+      uint64_t lowest = 0, width = 0;
+      GetRange(bucket, lowest, width);
+      return std::max(m_min, std::min(m_max, lowest + width / 2));
+    }
+  }
+  return m_max;
+}
+
+} // namespace ndn
+} // namespace ns3
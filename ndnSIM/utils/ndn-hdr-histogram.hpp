@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_HDR_HISTOGRAM_H
+#define NDN_HDR_HISTOGRAM_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Histogram of non-negative integers with a bounded relative error, in the way of
+ *        HdrHistogram
+ *
+ * Values below 128 have a bucket each.  Above, every power of two range is split into 64
+ * buckets of equal width, so a bucket is at most 1/64 of its values wide and percentiles are
+ * reported with less than 1% error.  The buckets of values up to 2^k take 128 + 64 (k - 7)
+ * counters, e.g., 2240 counters (18 KB) for delays up to 18 minutes in nanoseconds, allocated
+ * up to the largest recorded value.  Count, sum, minimum and maximum are exact.
+ */
+class HdrHistogram {
+public:
+  HdrHistogram();
+
+  void
+  Record(uint64_t value, uint64_t count = 1);
+
+  /**
+   * @brief Add the values recorded in the other histogram
+   */
+  void
+  Merge(const HdrHistogram& other);
+
+  void
+  Reset();
+
+  uint64_t
+  GetCount() const
+  {
+    return m_count;
+  }
+
+  double
+  GetMean() const;
+
+  uint64_t
+  GetMin() const;
+
+  uint64_t
+  GetMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Smallest value not exceeded by @p percent % of the recorded values
+   *
+   * Returns the middle of the bucket of that value, clamped to the recorded minimum and
+   * maximum; the exact minimum and maximum for the lowest and highest rank; 0 if nothing was
+   * recorded.
+   */
+  uint64_t
+  GetPercentile(double percent) const;
+
+  size_t
+  GetMemoryUsage() const
+  {
+    return sizeof(HdrHistogram) + m_counts.capacity() * sizeof(uint64_t);
+  }
+
+private:
+  static size_t
+  GetBucket(uint64_t value);
+
+  /**
+   * @brief Lowest value and width of the bucket
+   */
+  static void
+  GetRange(size_t bucket, uint64_t& lowest, uint64_t& width);
+
+private:
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  double m_sum;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HDR_HISTOGRAM_H
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-interest-template.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+#include <cstring>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Buffer;
+using ::ndn::makeBuffer;
+
+InterestTemplate::InterestTemplate(const Name& prefix, time::milliseconds lifetime)
+  : m_prefix(prefix)
+  , m_lifetime(lifetime)
+{
+}
+
+size_t
+InterestTemplate::getSeqLength(uint32_t seq)
+{
+  // same as Encoder::prependNonNegativeInteger
+  if (seq <= std::numeric_limits<uint8_t>::max())
+    return 1;
+  else if (seq <= std::numeric_limits<uint16_t>::max())
+    return 2;
+  else
+    return 4;
+}
+
+const InterestTemplate::Encoding&
+InterestTemplate::getEncoding(size_t seqLength) const
+{
+  size_t index = seqLength == 1 ? 0 : (seqLength == 2 ? 1 : 2);
+  Encoding& encoding = m_encodings[index];
+  if (encoding.wire != nullptr)
+    return encoding;
+
+  static const uint32_t SAMPLE_SEQ[] = {0, 1u << 8, 1u << 16};
+
+  Interest interest;
+  interest.setName(Name(m_prefix).appendSequenceNumber(SAMPLE_SEQ[index]));
+  interest.setNonce(0);
+  interest.setInterestLifetime(m_lifetime);
+
+  // wireEncode re-decodes the Interest, so name and nonce point into the encoding
+  const Block& wire = interest.wireEncode();
+  encoding.wire = makeBuffer(wire.wire(), wire.size());
+  encoding.seqOffset = interest.getName().get(-1).value() + 1 - wire.wire();
+  encoding.nonceOffset = wire.find(::ndn::tlv::Nonce)->value() - wire.wire();
+  return encoding;
+}
+
+shared_ptr<Interest>
+InterestTemplate::makeInterest(uint32_t seq, uint32_t nonce) const
+{
+  size_t seqLength = getSeqLength(seq);
+  const Encoding& encoding = getEncoding(seqLength);
+
+  shared_ptr<Buffer> buffer = makeBuffer(encoding.wire->begin(), encoding.wire->end());
+  uint8_t* seqValue = &(*buffer)[encoding.seqOffset];
+  for (size_t i = seqLength; i > 0; --i) {
+    seqValue[i - 1] = static_cast<uint8_t>(seq);
+    seq >>= 8;
+  }
+  // Interest::setNonce copies the nonce in host byte order, so does this
+  std::memcpy(&(*buffer)[encoding.nonceOffset], &nonce, sizeof(nonce));
+
+  return make_shared<Interest>(Block(buffer));
+}
+
+shared_ptr<Interest>
+InterestTemplate::refreshNonce(const Interest& interest, uint32_t nonce)
+{
+  const Block& wire = interest.wireEncode();
+  Block::element_const_iterator nonceBlock = wire.find(::ndn::tlv::Nonce);
+  if (nonceBlock == wire.elements_end() || nonceBlock->value_size() != sizeof(nonce)) {
+    shared_ptr<Interest> copy = make_shared<Interest>(interest);
+    copy->setNonce(nonce); // no wire in place patching, encoding is made anew
+    copy->wireEncode();
+    return copy;
+  }
+
+  shared_ptr<Buffer> buffer = makeBuffer(wire.wire(), wire.size());
+  std::memcpy(&(*buffer)[nonceBlock->value() - wire.wire()], &nonce, sizeof(nonce));
+  return make_shared<Interest>(Block(buffer));
+}
+
+shared_ptr<Interest>
+InterestTemplate::refreshNonce(const Interest& interest, uint32_t nonce,
+                               time::milliseconds lifetime)
+{
+  if (interest.getInterestLifetime() == lifetime)
+    return refreshNonce(interest, nonce);
+
+  const Block& wire = interest.wireEncode();
+  Block::element_const_iterator nonceBlock = wire.find(::ndn::tlv::Nonce);
+  Block::element_const_iterator lifetimeBlock = wire.find(::ndn::tlv::InterestLifetime);
+  if (nonceBlock == wire.elements_end() || nonceBlock->value_size() != sizeof(nonce)
+      || lifetimeBlock == wire.elements_end() || lifetime < time::milliseconds::zero()
+      || ::ndn::tlv::sizeOfNonNegativeInteger(lifetime.count()) > lifetimeBlock->value_size()) {
+    shared_ptr<Interest> copy = make_shared<Interest>(interest);
+    copy->setNonce(nonce);
+    copy->setInterestLifetime(lifetime);
+    copy->wireEncode();
+    return copy;
+  }
+
+  shared_ptr<Buffer> buffer = makeBuffer(wire.wire(), wire.size());
+  std::memcpy(&(*buffer)[nonceBlock->value() - wire.wire()], &nonce, sizeof(nonce));
+
+  // a NonNegativeInteger may have leading zero octets
+  uint8_t* lifetimeValue = &(*buffer)[lifetimeBlock->value() - wire.wire()];
+  uint64_t value = lifetime.count();
+  for (size_t i = lifetimeBlock->value_size(); i > 0; --i) {
+    lifetimeValue[i - 1] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+  return make_shared<Interest>(Block(buffer));
+}
+
+} // namespace ndn
+} // namespace ns3
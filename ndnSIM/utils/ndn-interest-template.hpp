@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_INTEREST_TEMPLATE_H
+#define NDN_INTEREST_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Pre-encoded Interest for names of the form /<prefix>/<sequence number>
+ *
+ * The template keeps the wire encoding of such an Interest for every possible length of the
+ * sequence number component.  An Interest is made by copying the encoding and patching the
+ * sequence number and the nonce in place, which avoids building the name and encoding the
+ * Interest for every transmission.
+ */
+class InterestTemplate {
+public:
+  /**
+   * \param prefix   name prefix, the sequence number component is appended to it
+   * \param lifetime lifetime of the Interests (DEFAULT_INTEREST_LIFETIME is not encoded)
+   */
+  InterestTemplate(const Name& prefix,
+                   time::milliseconds lifetime = ::ndn::DEFAULT_INTEREST_LIFETIME);
+
+  const Name&
+  getPrefix() const
+  {
+    return m_prefix;
+  }
+
+  time::milliseconds
+  getInterestLifetime() const
+  {
+    return m_lifetime;
+  }
+
+  /**
+   * \brief Make Interest for /<prefix>/<seq> with the nonce
+   */
+  shared_ptr<Interest>
+  makeInterest(uint32_t seq, uint32_t nonce) const;
+
+  /**
+   * \brief Make a copy of the Interest with a different nonce, reusing its wire encoding
+   *
+   * The encoding of \p interest is not modified, as it may be shared with Interests that are
+   * still in use.
+   */
+  static shared_ptr<Interest>
+  refreshNonce(const Interest& interest, uint32_t nonce);
+
+  /**
+   * \brief Make a copy of the Interest with a different nonce and lifetime
+   *
+   * The lifetime is written in place of the encoded one if it fits in as many octets, which is
+   * the case for every lifetime up to that of the template the Interest was made from.
+   * Otherwise, and for Interests without encoded lifetime, the copy is encoded anew.
+   */
+  static shared_ptr<Interest>
+  refreshNonce(const Interest& interest, uint32_t nonce, time::milliseconds lifetime);
+
+private:
+  struct Encoding {
+    ::ndn::ConstBufferPtr wire;
+    size_t seqOffset;   // offset of the sequence number, after the marker
+    size_t nonceOffset; // offset of the nonce value
+  };
+
+  static size_t
+  getSeqLength(uint32_t seq);
+
+  const Encoding&
+  getEncoding(size_t seqLength) const;
+
+private:
+  Name m_prefix;
+  time::milliseconds m_lifetime;
+  mutable Encoding m_encodings[3]; // sequence numbers of 1, 2 and 4 octets, made on demand
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_INTEREST_TEMPLATE_H
@@ -0,0 +1,574 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-metrics-exporter.hpp"
+#include "ndn-event-profiler.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+
+#include "apps/ndn-app.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/ndn-mpi.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "mem-usage.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.MetricsExporter");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Interval at which the background thread checks for new snapshots and stopping
+ */
+const int POLL_INTERVAL_MS = 50;
+
+double
+toSeconds(Clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+/**
+ * @brief Exporter state; the snapshot is shared with the background thread, everything else
+ *        belongs to the simulator thread
+ */
+struct State
+{
+  ~State()
+  {
+    stopThread();
+    closeSockets();
+  }
+
+  void
+  stopThread()
+  {
+    if (thread.joinable()) {
+      isStopping = true;
+      thread.join();
+      isStopping = false;
+    }
+  }
+
+  void
+  closeSockets()
+  {
+    if (httpFd >= 0) {
+      ::close(httpFd);
+      httpFd = -1;
+    }
+    if (statsdFd >= 0) {
+      ::close(statsdFd);
+      statsdFd = -1;
+    }
+    httpPort = 0;
+  }
+
+  // shared with the background thread
+  std::mutex mutex;
+  MetricsExporter::Snapshot snapshot;
+  Clock::time_point snapshotTime;
+  uint64_t version = 0;
+
+  // set before the background thread starts
+  int httpFd = -1;
+  uint16_t httpPort = 0;
+  int statsdFd = -1;
+  sockaddr_storage statsdAddress;
+  socklen_t statsdAddressLength = 0;
+  std::string statsdPrefix;
+  std::thread thread;
+  std::atomic<bool> isStopping{false};
+
+  // simulator thread
+  bool isActive = false;
+  Clock::duration interval = std::chrono::seconds(1);
+  Time granularity = MilliSeconds(10);
+  EventId checkEvent;
+  EventId destroyEvent;
+  bool isConnected = false;
+  Clock::time_point start;
+  Clock::time_point lastSample;
+  double lastSimulationTime = 0;
+  uint64_t lastEvents = 0;
+  uint64_t nSatisfied = 0;
+  uint64_t nGivenUp = 0;
+  uint64_t lastSatisfied = 0;
+  uint64_t lastGivenUp = 0;
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+void
+onDataReceived(Ptr<App> app, const Name& name, uint32_t seqno)
+{
+  ++getState().nSatisfied;
+}
+
+void
+onInterestGivenUp(Ptr<App> app, uint32_t seqno)
+{
+  ++getState().nGivenUp;
+}
+
+void
+takeSnapshot()
+{
+  State& state = getState();
+  if (!state.isConnected) {
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/DataReceived",
+                                  MakeCallback(&onDataReceived));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/InterestGivenUp",
+                                  MakeCallback(&onInterestGivenUp));
+    state.isConnected = true;
+  }
+
+  Clock::time_point now = Clock::now();
+  double wallInterval = toSeconds(now - state.lastSample);
+
+  MetricsExporter::Snapshot snapshot;
+  snapshot.simulationTime = Simulator::Now().ToDouble(Time::S);
+  snapshot.wallTime = toSeconds(now - state.start);
+  if (wallInterval > 0) {
+    snapshot.speedRatio = (snapshot.simulationTime - state.lastSimulationTime) / wallInterval;
+  }
+
+  if (EventProfiler::IsEnabled()) {
+    snapshot.hasEvents = true;
+    for (const EventProfiler::Record& record : EventProfiler::GetRecords()) {
+      snapshot.nEvents += record.nExecuted;
+    }
+    if (wallInterval > 0) {
+      snapshot.eventRate = (snapshot.nEvents - state.lastEvents) / wallInterval;
+    }
+    state.lastEvents = snapshot.nEvents;
+  }
+
+  snapshot.memory = MemUsage::Get();
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol>();
+    if (ndn != nullptr) {
+      snapshot.nPitEntries += ndn->getForwarder()->getPit().size();
+      snapshot.nCsEntries += ndn->getForwarder()->getCs().size();
+    }
+  }
+
+  snapshot.nSatisfied = state.nSatisfied;
+  snapshot.nGivenUp = state.nGivenUp;
+  uint64_t nSatisfied = state.nSatisfied - state.lastSatisfied;
+  uint64_t nGivenUp = state.nGivenUp - state.lastGivenUp;
+  snapshot.satisfactionRatio = nSatisfied + nGivenUp > 0 ?
+                                 static_cast<double>(nSatisfied) / (nSatisfied + nGivenUp) : NAN;
+
+  state.lastSample = now;
+  state.lastSimulationTime = snapshot.simulationTime;
+  state.lastSatisfied = state.nSatisfied;
+  state.lastGivenUp = state.nGivenUp;
+
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.snapshot = snapshot;
+  state.snapshotTime = now;
+  ++state.version;
+}
+
+void
+check()
+{
+  State& state = getState();
+  if (Clock::now() - state.lastSample >= state.interval) {
+    takeSnapshot();
+  }
+
+  // do not keep a simulation without other events running
+  if (!Simulator::IsFinished()) {
+    state.checkEvent = Simulator::Schedule(state.granularity, &check);
+  }
+}
+
+/**
+ * @brief Take the last snapshot of the simulation, at Simulator::Destroy
+ */
+void
+finish()
+{
+  takeSnapshot();
+  getState().isConnected = false; // the next simulation has other applications
+}
+
+void
+scheduleChecks()
+{
+  State& state = getState();
+  if (state.checkEvent.IsExpired()) {
+    state.checkEvent = Simulator::Schedule(state.granularity, &check);
+  }
+  if (state.destroyEvent.IsExpired()) {
+    // the final state of the simulation
+    state.destroyEvent = Simulator::ScheduleDestroy(&finish);
+  }
+}
+
+/**
+ * @brief Answer one HTTP request with the last snapshot
+ */
+void
+serveHttp(State& state)
+{
+  int client = ::accept(state.httpFd, nullptr, nullptr);
+  if (client < 0) {
+    return;
+  }
+
+  // the request is not parsed, every path returns the metrics
+  timeval timeout = {1, 0};
+  ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+    ssize_t n = ::recv(client, buffer, sizeof(buffer), 0);
+    if (n <= 0) {
+      break;
+    }
+    request.append(buffer, n);
+  }
+
+  MetricsExporter::Snapshot snapshot;
+  Clock::time_point snapshotTime;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    snapshot = state.snapshot;
+    snapshotTime = state.snapshotTime;
+  }
+
+  std::ostringstream body;
+  MetricsExporter::PrintPrometheus(body, snapshot, toSeconds(Clock::now() - snapshotTime));
+
+  std::ostringstream response;
+  response << "HTTP/1.0 200 OK\r\n"
+           << "Content-Type: text/plain; version=0.0.4\r\n"
+           << "Content-Length: " << body.str().size() << "\r\n"
+           << "Connection: close\r\n"
+           << "\r\n"
+           << body.str();
+
+  const std::string& data = response.str();
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = ::send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) {
+      break;
+    }
+    sent += n;
+  }
+  ::close(client);
+}
+
+void
+pushStatsd(State& state, const MetricsExporter::Snapshot& snapshot)
+{
+  std::ostringstream os;
+  os.precision(15);
+  auto gauge = [&] (const char* name, double value) {
+    if (!std::isnan(value)) {
+      os << state.statsdPrefix << "." << name << ":" << value << "|g\n";
+    }
+  };
+
+  gauge("simulation_time_seconds", snapshot.simulationTime);
+  gauge("wall_time_seconds", snapshot.wallTime);
+  gauge("speed_ratio", snapshot.speedRatio);
+  if (snapshot.hasEvents) {
+    gauge("events_per_second", snapshot.eventRate);
+  }
+  gauge("memory_bytes", snapshot.memory);
+  gauge("pit_entries", snapshot.nPitEntries);
+  gauge("cs_entries", snapshot.nCsEntries);
+  gauge("satisfied_interests", snapshot.nSatisfied);
+  gauge("given_up_interests", snapshot.nGivenUp);
+  gauge("satisfaction_ratio", snapshot.satisfactionRatio);
+
+  const std::string& datagram = os.str();
+  ::sendto(state.statsdFd, datagram.data(), datagram.size(), 0,
+           reinterpret_cast<const sockaddr*>(&state.statsdAddress), state.statsdAddressLength);
+}
+
+void
+run(State& state)
+{
+  uint64_t pushedVersion = 0;
+  while (!state.isStopping) {
+    pollfd fd = {state.httpFd, POLLIN, 0};
+    int n = ::poll(&fd, state.httpFd >= 0 ? 1 : 0, POLL_INTERVAL_MS);
+    if (n > 0 && (fd.revents & POLLIN)) {
+      serveHttp(state);
+    }
+
+    if (state.statsdFd >= 0) {
+      MetricsExporter::Snapshot snapshot;
+      {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.version == pushedVersion) {
+          continue;
+        }
+        snapshot = state.snapshot;
+        pushedVersion = state.version;
+      }
+      pushStatsd(state, snapshot);
+    }
+  }
+}
+
+void
+start()
+{
+  State& state = getState();
+  if (!state.isActive) {
+    state.isActive = true;
+    state.start = state.lastSample = Clock::now();
+    state.lastSimulationTime = Simulator::Now().ToDouble(Time::S);
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.snapshotTime = state.start;
+  }
+
+  state.stopThread();
+  state.thread = std::thread(&run, std::ref(state));
+
+  scheduleChecks();
+}
+
+} // namespace
+
+void
+MetricsExporter::EnableHttp(uint16_t port/* = 9464*/, const std::string& address/* = "127.0.0.1"*/)
+{
+  State& state = getState();
+  state.stopThread();
+  if (state.httpFd >= 0) {
+    ::close(state.httpFd);
+    state.httpFd = -1;
+  }
+
+#ifdef NS3_MPI
+  if (port != 0 && MpiInterface::IsEnabled()) {
+    port += MpiInterface::GetSystemId();
+  }
+#endif
+
+  sockaddr_in local;
+  std::memset(&local, 0, sizeof(local));
+  local.sin_family = AF_INET;
+  local.sin_port = htons(port);
+  if (::inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1) {
+    throw std::runtime_error("Invalid address " + address + " for the metrics exporter");
+  }
+
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  int yes = 1;
+  if (fd < 0 || ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes)) != 0 ||
+      ::bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0 ||
+      ::listen(fd, 16) != 0) {
+    std::string error = std::strerror(errno);
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error("Cannot listen on " + address + ":" + std::to_string(port) +
+                             " for the metrics exporter: " + error);
+  }
+
+  socklen_t length = sizeof(local);
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&local), &length);
+  state.httpFd = fd;
+  state.httpPort = ntohs(local.sin_port);
+  NS_LOG_INFO("Serving metrics on " << address << ":" << state.httpPort);
+
+  start();
+}
+
+void
+MetricsExporter::EnableStatsd(const std::string& host/* = "127.0.0.1"*/,
+                              uint16_t port/* = 8125*/,
+                              const std::string& prefix/* = "ndnsim"*/)
+{
+  State& state = getState();
+  state.stopThread();
+  if (state.statsdFd >= 0) {
+    ::close(state.statsdFd);
+    state.statsdFd = -1;
+  }
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_DGRAM;
+  addrinfo* result = nullptr;
+  if (::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 ||
+      result == nullptr) {
+    throw std::runtime_error("Cannot resolve " + host + " for the metrics exporter");
+  }
+
+  int fd = ::socket(result->ai_family, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    ::freeaddrinfo(result);
+    throw std::runtime_error("Cannot create a UDP socket for the metrics exporter");
+  }
+  std::memcpy(&state.statsdAddress, result->ai_addr, result->ai_addrlen);
+  state.statsdAddressLength = result->ai_addrlen;
+  ::freeaddrinfo(result);
+
+  state.statsdFd = fd;
+  state.statsdPrefix = prefix;
+
+  start();
+}
+
+void
+MetricsExporter::Disable()
+{
+  State& state = getState();
+  state.stopThread();
+  state.closeSockets();
+  state.isActive = false;
+  state.nSatisfied = state.nGivenUp = state.lastSatisfied = state.lastGivenUp = 0;
+  state.lastEvents = 0;
+
+  if (!state.checkEvent.IsExpired()) {
+    Simulator::Remove(state.checkEvent);
+  }
+}
+
+bool
+MetricsExporter::IsEnabled()
+{
+  return getState().isActive;
+}
+
+void
+MetricsExporter::SetInterval(Time interval)
+{
+  getState().interval = std::chrono::nanoseconds(interval.GetNanoSeconds());
+}
+
+void
+MetricsExporter::SetGranularity(Time granularity)
+{
+  getState().granularity = granularity;
+}
+
+uint16_t
+MetricsExporter::GetHttpPort()
+{
+  return getState().httpPort;
+}
+
+MetricsExporter::Snapshot
+MetricsExporter::GetSnapshot()
+{
+  State& state = getState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.snapshot;
+}
+
+void
+MetricsExporter::PrintPrometheus(std::ostream& os, const Snapshot& snapshot, double age)
+{
+  // enough digits for the counters and the memory size
+  std::streamsize precision = os.precision(15);
+
+  auto metric = [&os] (const char* name, const char* type, const char* help, double value) {
+    os << "# HELP ndnsim_" << name << " " << help << "\n"
+       << "# TYPE ndnsim_" << name << " " << type << "\n"
+       << "ndnsim_" << name << " ";
+    if (std::isnan(value)) {
+      os << "NaN";
+    }
+    else {
+      os << value;
+    }
+    os << "\n";
+  };
+
+  metric("simulation_time_seconds", "gauge", "Simulation time", snapshot.simulationTime);
+  metric("wall_time_seconds", "gauge", "Wall time since the exporter was enabled",
+         snapshot.wallTime);
+  metric("speed_ratio", "gauge", "Simulation seconds per wall second in the last interval",
+         snapshot.speedRatio);
+  if (snapshot.hasEvents) {
+    metric("events_total", "counter", "Executed simulator events", snapshot.nEvents);
+    metric("events_per_second", "gauge", "Executed events per wall second in the last interval",
+           snapshot.eventRate);
+  }
+  metric("memory_bytes", "gauge", "Resident size of the process", snapshot.memory);
+  metric("pit_entries", "gauge", "PIT entries of the local nodes", snapshot.nPitEntries);
+  metric("cs_entries", "gauge", "CS entries of the local nodes", snapshot.nCsEntries);
+  metric("satisfied_interests_total", "counter", "Interests of consumers answered by Data",
+         snapshot.nSatisfied);
+  metric("given_up_interests_total", "counter", "Interests given up by consumers",
+         snapshot.nGivenUp);
+  metric("satisfaction_ratio", "gauge",
+         "Satisfied / (satisfied + given up) Interests in the last interval",
+         snapshot.satisfactionRatio);
+  metric("snapshot_age_seconds", "gauge", "Wall time since the snapshot was taken", age);
+
+  os.precision(precision);
+}
+
+} // namespace ndn
+} // namespace ns3
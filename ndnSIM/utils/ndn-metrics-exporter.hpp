@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_UTILS_NDN_METRICS_EXPORTER_HPP
+#define NDNSIM_UTILS_NDN_METRICS_EXPORTER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Exporter of live metrics of a running simulation
+ *
+ * Every interval of wall time, the simulator thread takes a snapshot of the metrics of the
+ * simulation (see Snapshot).  A background thread publishes the last snapshot, so that a
+ * stalled or diverging run can be noticed, and killed, before it ends:
+ *  - EnableHttp serves the snapshot in the Prometheus text format at any path, e.g.,
+ *    http://127.0.0.1:9464/metrics.  As the HTTP requests are answered by the background
+ *    thread, the age of the snapshot (ndnsim_snapshot_age_seconds) keeps growing when the
+ *    simulator is stuck in an event
+ *  - EnableStatsd pushes every snapshot as StatsD gauges over UDP
+ *
+ * The simulator thread checks the wall clock in an event scheduled every SetGranularity of
+ * simulation time (10 ms by default), which stops being rescheduled when no other events are
+ * left.  The events per second are only known when EventProfiler is enabled.  Interests
+ * satisfied and given up are counted for the consumers installed before Simulator::Run.
+ *
+ * In a distributed simulation, every process exports the metrics of its nodes; the HTTP port
+ * is increased by the MPI rank.
+ *
+ * Example:
+ *
+ *     ndn::MetricsExporter::EnableHttp(9464);
+ *     ndn::MetricsExporter::SetInterval(Seconds(5));
+ *     Simulator::Run();
+ *
+ * and, e.g., `curl -s 127.0.0.1:9464/metrics`.
+ */
+class MetricsExporter
+{
+public:
+  struct Snapshot
+  {
+    double simulationTime = 0; ///< seconds
+    double wallTime = 0;       ///< seconds since the exporter was enabled
+    double speedRatio = 0;     ///< simulation seconds per wall second, during the last interval
+    bool hasEvents = false;    ///< whether nEvents and eventRate are known (EventProfiler)
+    uint64_t nEvents = 0;      ///< executed events
+    double eventRate = 0;      ///< executed events per wall second, during the last interval
+    int64_t memory = 0;        ///< resident size of the process in bytes, see MemUsage
+    uint64_t nPitEntries = 0;  ///< of the local nodes
+    uint64_t nCsEntries = 0;   ///< of the local nodes
+    uint64_t nSatisfied = 0;   ///< Interests answered by Data, see Consumer::DataReceived
+    uint64_t nGivenUp = 0;     ///< Interests given up, see Consumer::InterestGivenUp
+    double satisfactionRatio = 0; ///< satisfied / (satisfied + given up) in the last interval,
+                                  ///< NaN without either
+  };
+
+  /**
+   * @brief Serve the metrics over HTTP
+   * @param port TCP port, 0 for any free port (see GetHttpPort)
+   * @param address local address to listen on
+   * @throw std::runtime_error the socket cannot be bound
+   */
+  static void
+  EnableHttp(uint16_t port = 9464, const std::string& address = "127.0.0.1");
+
+  /**
+   * @brief Push every snapshot to a StatsD server over UDP
+   * @param prefix prefix of the names of the gauges, e.g., ndnsim.pit_entries
+   * @throw std::runtime_error the address is invalid
+   */
+  static void
+  EnableStatsd(const std::string& host = "127.0.0.1", uint16_t port = 8125,
+               const std::string& prefix = "ndnsim");
+
+  /**
+   * @brief Stop exporting, close the sockets and stop the background thread
+   *
+   * The counters of satisfied and given up Interests start from zero when enabled again.
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Set the interval of wall time between snapshots (1 second by default)
+   */
+  static void
+  SetInterval(Time interval);
+
+  /**
+   * @brief Set the interval of simulation time between checks of the wall clock
+   */
+  static void
+  SetGranularity(Time granularity);
+
+  /**
+   * @brief Get the TCP port of the HTTP server, 0 if not enabled
+   */
+  static uint16_t
+  GetHttpPort();
+
+  /**
+   * @brief Get the last snapshot
+   */
+  static Snapshot
+  GetSnapshot();
+
+  /**
+   * @brief Print the snapshot in the Prometheus text format
+   * @param age seconds since the snapshot was taken
+   */
+  static void
+  PrintPrometheus(std::ostream& os, const Snapshot& snapshot, double age);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_METRICS_EXPORTER_HPP
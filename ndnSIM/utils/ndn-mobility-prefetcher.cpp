@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mobility-prefetcher.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MobilityPrefetcher");
+
+namespace ns3 {
+namespace ndn {
+
+MobilityPrefetcher::MobilityPrefetcher()
+  : m_rate(std::numeric_limits<double>::infinity())
+  , m_burst(1)
+  , m_tokens(1)
+{
+}
+
+bool
+MobilityPrefetcher::AddSpatialName(const Name& spatialName)
+{
+  // GeoRegionTable looks at the segment between the "S" and "A" markers
+  const GeoRegionTable::Region* region = GeoRegionTable::Find(Name(spatialName).append("A"));
+  if (region == nullptr) {
+    NS_LOG_DEBUG("no region for " << spatialName);
+    return false;
+  }
+
+  m_candidates.push_back(Candidate{spatialName, *region});
+  return true;
+}
+
+const Name*
+MobilityPrefetcher::Predict(Ptr<const MobilityModel> mobility, Time after) const
+{
+  Vector position = mobility->GetPosition();
+  Vector velocity = mobility->GetVelocity();
+  double t = after.ToDouble(Time::S);
+  Vector predicted(position.x + velocity.x * t, position.y + velocity.y * t,
+                   position.z + velocity.z * t);
+
+  const Name* best = nullptr;
+  double bestDistance = std::numeric_limits<double>::infinity();
+  for (const Candidate& candidate : m_candidates) {
+    double distance = CalculateDistance(predicted, candidate.region.center);
+    if (candidate.region.radius > 0.0 && distance > candidate.region.radius)
+      continue;
+    if (distance < bestDistance) {
+      best = &candidate.spatialName;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
+
+void
+MobilityPrefetcher::SetRateLimit(double rate, uint32_t burst)
+{
+  NS_ASSERT(rate > 0 && burst > 0);
+  m_rate = rate;
+  m_burst = burst;
+  m_tokens = m_burst;
+  m_lastRefill = Simulator::Now();
+}
+
+bool
+MobilityPrefetcher::TryAcquire()
+{
+  if (std::isinf(m_rate))
+    return true;
+
+  Time now = Simulator::Now();
+  m_tokens = std::min(m_burst, m_tokens + (now - m_lastRefill).ToDouble(Time::S) * m_rate);
+  m_lastRefill = now;
+
+  if (m_tokens < 1.0)
+    return false;
+  m_tokens -= 1.0;
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_MOBILITY_PREFETCHER_H
+#define NDN_MOBILITY_PREFETCHER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-geo-region-table.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Predicts the spatial names a moving node will be in, and limits the rate of prefetching
+ *
+ * The position after a given time is extrapolated from the current velocity of the
+ * MobilityModel, which is exact between the waypoints of Ns2MobilityHelper traces.  The
+ * predicted spatial name is the one whose region (see GeoRegionTable) contains that position
+ * with the closest center; a region with zero radius contains every position, so regions
+ * without radius split the plane by their nearest center.
+ *
+ * Spatial names are checked one by one, which is cheap for the few dozen regions of a scene.
+ */
+class MobilityPrefetcher {
+public:
+  MobilityPrefetcher();
+
+  /**
+   * @brief Adds a candidate spatial name, e.g. /S/NankaiDistrict/WeijingRoad
+   * @return whether GeoRegionTable has a region for the name; if not, the name is not added
+   */
+  bool
+  AddSpatialName(const Name& spatialName);
+
+  size_t
+  GetNSpatialNames() const
+  {
+    return m_candidates.size();
+  }
+
+  /**
+   * @brief Spatial name of the region the node will be in after \p after
+   * @return nullptr if there is no candidate region at the predicted position
+   */
+  const Name*
+  Predict(Ptr<const MobilityModel> mobility, Time after) const;
+
+  /**
+   * @brief Limits prefetching to \p rate Interests per second, in bursts of up to \p burst
+   */
+  void
+  SetRateLimit(double rate, uint32_t burst);
+
+  /**
+   * @brief Takes a token of the rate limit
+   * @return false if a prefetch Interest must not be sent now
+   */
+  bool
+  TryAcquire();
+
+private:
+  struct Candidate {
+    Name spatialName;
+    GeoRegionTable::Region region;
+  };
+
+  std::vector<Candidate> m_candidates;
+
+  double m_rate; ///< tokens per second
+  double m_burst;
+  double m_tokens;
+  Time m_lastRefill;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_MOBILITY_PREFETCHER_H
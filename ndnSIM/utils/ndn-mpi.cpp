@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-mpi.hpp"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace mpi {
+
+bool
+IsLocalNode(Ptr<const Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled() && node->GetSystemId() != MpiInterface::GetSystemId()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+std::string
+GetLocalFileName(const std::string& file)
+{
+#ifdef NS3_MPI
+  if (file != "-" && MpiInterface::IsEnabled() && MpiInterface::GetSize() > 1) {
+    std::string suffix = "-" + boost::lexical_cast<std::string>(MpiInterface::GetSystemId());
+
+    // before the extension, if there is one in the last path component
+    size_t dot = file.rfind('.');
+    size_t slash = file.rfind('/');
+    if (dot == std::string::npos || dot == 0 || (slash != std::string::npos && dot < slash + 2)) {
+      return file + suffix;
+    }
+    return file.substr(0, dot) + suffix + file.substr(dot);
+  }
+#endif
+  return file;
+}
+
+} // namespace mpi
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,55 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_MPI_HPP
+#define NDNSIM_UTILS_NDN_MPI_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+
+namespace ns3 {
+namespace ndn {
+namespace mpi {
+
+/**
+ * @brief Whether the node is simulated by this process
+ *
+ * In a distributed simulation (MPI enabled, see ns3::MpiInterface) every process builds the
+ * whole topology, but only simulates the nodes of its system id.  Applications and tracers are
+ * only installed on those.  Always true if ndnSIM is built without MPI or it is not enabled.
+ */
+bool
+IsLocalNode(Ptr<const Node> node);
+
+/**
+ * @brief File name of the output of this process
+ *
+ * In a distributed simulation with several processes, every process writes its own file:
+ * "rate-trace.txt" becomes "rate-trace-<system id>.txt".  Otherwise, and for "-" (standard
+ * output), the name is returned unchanged.
+ */
+std::string
+GetLocalFileName(const std::string& file);
+
+} // namespace mpi
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_MPI_HPP
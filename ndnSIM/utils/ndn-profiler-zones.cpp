@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-profiler-zones.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ProfilerZones");
+
+namespace ns3 {
+namespace ndn {
+
+bool ProfilerZones::s_isEnabled = false;
+const size_t ProfilerZones::NO_ZONE = static_cast<size_t>(-1);
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Zone
+{
+  const char* name;
+  int64_t begin;     ///< nanoseconds of wall time since Enable
+  int64_t end;       ///< equal to begin for the markers of simulated seconds
+  double simulation; ///< simulation time in seconds when the zone began
+};
+
+struct State
+{
+  std::string file;
+  size_t maxZones = 0;
+  size_t nDropped = 0;
+  Clock::time_point origin;
+  int64_t lastSecond = -1;
+  std::vector<Zone> zones;
+  EventId destroyEvent;
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+int64_t
+sinceOrigin(const State& state)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - state.origin)
+    .count();
+}
+
+const char* const SIMULATED_SECOND = "SimulatedSecond";
+
+} // namespace
+
+void
+ProfilerZones::Enable(const std::string& file, size_t maxZones)
+{
+#if !defined(NDNSIM_WITH_ZONE_TRACE)
+  NS_LOG_WARN("ndnSIM is compiled without NDNSIM_WITH_ZONE_TRACE, only explicit "
+              "ProfilerZones::Scope objects are recorded");
+#endif
+
+  State& state = getState();
+  state.file = file;
+  state.maxZones = maxZones;
+  state.nDropped = 0;
+  state.origin = Clock::now();
+  state.lastSecond = -1;
+  state.zones.clear();
+  state.zones.reserve(std::min<size_t>(maxZones, 1 << 20));
+  if (!state.destroyEvent.IsRunning()) {
+    state.destroyEvent = Simulator::ScheduleDestroy(&ProfilerZones::Disable);
+  }
+  s_isEnabled = true;
+}
+
+void
+ProfilerZones::Disable()
+{
+  if (!s_isEnabled)
+    return;
+  s_isEnabled = false;
+
+  State& state = getState();
+  Simulator::Cancel(state.destroyEvent);
+  if (state.nDropped > 0) {
+    NS_LOG_WARN(state.nDropped << " zones were dropped, beyond the maximum of " << state.maxZones);
+  }
+  if (!state.file.empty()) {
+    std::ofstream os(state.file.c_str());
+    if (!os.is_open()) {
+      NS_LOG_ERROR("Trace file " << state.file << " cannot be opened for writing");
+    }
+    else {
+      WriteTrace(os);
+    }
+  }
+  state.zones.clear();
+  state.zones.shrink_to_fit();
+}
+
+size_t
+ProfilerZones::GetNZones()
+{
+  return getState().zones.size();
+}
+
+size_t
+ProfilerZones::Begin(const char* name)
+{
+  State& state = getState();
+  if (state.zones.size() + 2 > state.maxZones) {
+    ++state.nDropped;
+    return NO_ZONE;
+  }
+
+  int64_t now = sinceOrigin(state);
+  double simulation = Simulator::Now().ToDouble(Time::S);
+  int64_t second = static_cast<int64_t>(std::floor(simulation));
+  if (second != state.lastSecond) {
+    state.lastSecond = second;
+    state.zones.push_back(Zone{SIMULATED_SECOND, now, now, simulation});
+  }
+
+  state.zones.push_back(Zone{name, now, -1, simulation});
+  return state.zones.size() - 1;
+}
+
+void
+ProfilerZones::End(size_t index)
+{
+  State& state = getState();
+  // the zones may have been written and cleared in the meantime
+  if (index < state.zones.size())
+    state.zones[index].end = sinceOrigin(state);
+}
+
+void
+ProfilerZones::WriteTrace(std::ostream& os)
+{
+  State& state = getState();
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+     << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+     << "\"args\":{\"name\":\"ndnSIM\"}}";
+
+  int64_t now = sinceOrigin(state);
+  for (const Zone& zone : state.zones) {
+    os << ",\n{\"name\":\"" << zone.name << "\",\"pid\":1,\"tid\":1,\"ts\":"
+       << zone.begin / 1000.0;
+    if (zone.name == SIMULATED_SECOND) {
+      os << ",\"ph\":\"i\",\"s\":\"g\"";
+    }
+    else {
+      // zones still open, e.g., when written from within a zone, end now
+      int64_t end = zone.end < 0 ? now : zone.end;
+      os << ",\"ph\":\"X\",\"dur\":" << (end - zone.begin) / 1000.0;
+    }
+    os << ",\"args\":{\"sim\":" << zone.simulation << "}}";
+  }
+  os << "\n]}\n";
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,181 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_PROFILER_ZONES_HPP
+#define NDNSIM_UTILS_NDN_PROFILER_ZONES_HPP
+
+// kept free of ns-3 and ndnSIM headers, as it is included by ndn-cxx and NFD as well
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+#if defined(NDNSIM_WITH_TRACY)
+#include <tracy/Tracy.hpp>
+#elif defined(NDNSIM_WITH_ITT)
+#include <ittnotify.h>
+#endif
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Zones of the hot paths of the simulator, for timeline profilers
+ *
+ * NDN_PROFILE_ZONE("name") marks the rest of the enclosing scope as a zone.  Zones are sent to
+ * the profiler selected when compiling, e.g., with CXXFLAGS=-DNDNSIM_WITH_TRACY:
+ *  - NDNSIM_WITH_TRACY: Tracy (ZoneScopedN)
+ *  - NDNSIM_WITH_ITT: Intel ITT tasks of the "ndnSIM" domain (VTune)
+ *  - NDNSIM_WITH_ZONE_TRACE: the zones are recorded by ProfilerZones once enabled, and written
+ *    as Chrome trace events, to open in chrome://tracing or Perfetto
+ *
+ * Without any of them, NDN_PROFILE_ZONE expands to nothing.
+ *
+ * The zones written by ProfilerZones carry the simulation time at which they started, and an
+ * instant event marks the first zone of every simulated second, so the timeline shows where
+ * the wall time of each simulated second goes.
+ */
+class ProfilerZones
+{
+public:
+  /**
+   * @brief Start recording zones, only with NDNSIM_WITH_ZONE_TRACE
+   * @param file Chrome trace file, written by Disable or when the simulation is destroyed
+   * @param maxZones zones beyond this number are dropped
+   */
+  static void
+  Enable(const std::string& file, size_t maxZones = 10000000);
+
+  /**
+   * @brief Stop recording and write the trace file
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled()
+  {
+    return s_isEnabled;
+  }
+
+  /**
+   * @brief Get the number of recorded zones, including the markers of simulated seconds
+   */
+  static size_t
+  GetNZones();
+
+  /**
+   * @brief Write the recorded zones as a Chrome trace (JSON object format)
+   */
+  static void
+  WriteTrace(std::ostream& os);
+
+  /**
+   * @brief Records a zone from construction to destruction, if recording is enabled
+   */
+  class Scope
+  {
+  public:
+    explicit
+    Scope(const char* name)
+      : m_index(s_isEnabled ? Begin(name) : NO_ZONE)
+    {
+    }
+
+    ~Scope()
+    {
+      if (m_index != NO_ZONE)
+        End(m_index);
+    }
+
+    Scope(const Scope&) = delete;
+
+    Scope&
+    operator=(const Scope&) = delete;
+
+  private:
+    size_t m_index;
+  };
+
+private:
+  static const size_t NO_ZONE;
+
+  /**
+   * @return index of the zone, NO_ZONE if it is dropped
+   */
+  static size_t
+  Begin(const char* name);
+
+  static void
+  End(size_t index);
+
+private:
+  static bool s_isEnabled;
+};
+
+#if defined(NDNSIM_WITH_ITT)
+inline __itt_domain*
+GetIttDomain()
+{
+  static __itt_domain* domain = __itt_domain_create("ndnSIM");
+  return domain;
+}
+
+class IttZone
+{
+public:
+  explicit
+  IttZone(__itt_string_handle* name)
+  {
+    __itt_task_begin(GetIttDomain(), __itt_null, __itt_null, name);
+  }
+
+  ~IttZone()
+  {
+    __itt_task_end(GetIttDomain());
+  }
+};
+#endif // NDNSIM_WITH_ITT
+
+} // namespace ndn
+} // namespace ns3
+
+#define NDN_PROFILE_ZONE_CONCAT(a, b) a##b
+#define NDN_PROFILE_ZONE_VARIABLE(prefix, line) NDN_PROFILE_ZONE_CONCAT(prefix, line)
+
+/**
+ * @brief Marks the rest of the enclosing scope as a zone named @p name (a string literal)
+ */
+#if defined(NDNSIM_WITH_TRACY)
+#define NDN_PROFILE_ZONE(name) ZoneScopedN(name)
+#elif defined(NDNSIM_WITH_ITT)
+#define NDN_PROFILE_ZONE(name) \
+  static __itt_string_handle* NDN_PROFILE_ZONE_VARIABLE(ndnIttName, __LINE__) = \
+    __itt_string_handle_create(name); \
+  ::ns3::ndn::IttZone NDN_PROFILE_ZONE_VARIABLE(ndnIttZone, __LINE__)( \
+    NDN_PROFILE_ZONE_VARIABLE(ndnIttName, __LINE__))
+#elif defined(NDNSIM_WITH_ZONE_TRACE)
+#define NDN_PROFILE_ZONE(name) \
+  ::ns3::ndn::ProfilerZones::Scope NDN_PROFILE_ZONE_VARIABLE(ndnProfileZone, __LINE__)(name)
+#else
+#define NDN_PROFILE_ZONE(name)
+#endif
+
+#endif // NDNSIM_UTILS_NDN_PROFILER_ZONES_HPP
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-push-cache.hpp"
+#include "ndn-pushed-data-tag.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/model/ndn-net-device-face.hpp"
+
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <ndn-cxx/structured-name-view.hpp>
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PushCache");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(PushCache);
+
+// names pushed or served are only cleaned up when there are more than this many
+static const size_t MAX_RECENT_ENTRIES = 4096;
+
+// the dictionary of candidate components is emptied when it has more components than this
+static const size_t MAX_DICTIONARY_SIZE = 65536;
+
+TypeId
+PushCache::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PushCache")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<PushCache>()
+      .AddAttribute("SpatialThreshold",
+                    "Minimum spatial correlativity of pushed Data with the served Data",
+                    DoubleValue(0.5), MakeDoubleAccessor(&PushCache::m_spatialThreshold),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("ApplicationThreshold",
+                    "Minimum application correlativity of pushed Data with the served Data",
+                    DoubleValue(0.5), MakeDoubleAccessor(&PushCache::m_applicationThreshold),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("MaxPushes", "Maximum number of Data pushed after a served Data",
+                    UintegerValue(4), MakeUintegerAccessor(&PushCache::m_maxPushes),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MaxScan",
+                    "Maximum number of content store entries looked at after a served Data",
+                    UintegerValue(256), MakeUintegerAccessor(&PushCache::m_maxScan),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("MinInterval", "Data pushed or served within that long are not pushed",
+                    TimeValue(Seconds(10)), MakeTimeAccessor(&PushCache::m_minInterval),
+                    MakeTimeChecker());
+  return tid;
+}
+
+PushCache::PushCache()
+  : m_spatialThreshold(0.5)
+  , m_applicationThreshold(0.5)
+  , m_maxPushes(4)
+  , m_maxScan(256)
+  , m_minInterval(Seconds(10))
+  , m_isPushing(false)
+  , m_nPushed(0)
+{
+}
+
+Ptr<PushCache>
+PushCache::Install(Ptr<Node> node)
+{
+  Ptr<PushCache> pushCache = node->GetObject<PushCache>();
+  if (pushCache != 0)
+    return pushCache;
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3 != 0, "NDN stack should be installed on node " << node->GetId());
+
+  pushCache = CreateObject<PushCache>();
+  pushCache->m_node = node;
+  pushCache->m_forwarder = l3->getForwarder();
+  node->AggregateObject(pushCache);
+  l3->TraceConnectWithoutContext("OutData", MakeCallback(&PushCache::OutData, pushCache));
+  return pushCache;
+}
+
+void
+PushCache::Install(const NodeContainer& c)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    Install(*i);
+  }
+}
+
+void
+PushCache::InstallReceiver(Ptr<Node> node)
+{
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3 != 0, "NDN stack should be installed on node " << node->GetId());
+
+  for (const auto& face : l3->getForwarder()->getFaceTable()) {
+    shared_ptr<NetDeviceFace> netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+    if (netDeviceFace != nullptr)
+      netDeviceFace->setOverhearing(true);
+  }
+  l3->getForwarder()->setOverheardDataAdmission([] (const nfd::Face&, const Data& data) {
+    return PushedDataTag::IsPushed(data);
+  });
+}
+
+void
+PushCache::InstallReceiver(const NodeContainer& c)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    InstallReceiver(*i);
+  }
+}
+
+double
+PushCache::GetCorrelativity(const Name& served, const Name& candidate) const
+{
+  double spatial = served.getSpcorrelativityWith(candidate);
+  if (spatial <= 0.0 || spatial < m_spatialThreshold)
+    return 0.0;
+
+  return Combine(spatial, served.getAppcorrelativityWith(candidate));
+}
+
+double
+PushCache::Combine(double spatial, double application) const
+{
+  if (spatial <= 0.0 || spatial < m_spatialThreshold)
+    return 0.0;
+  if (application <= 0.0 || application < m_applicationThreshold)
+    return 0.0;
+
+  return spatial * application;
+}
+
+void
+PushCache::OutData(const Data& data, const Face& face)
+{
+  if (m_isPushing || face.isLocal())
+    return;
+
+  m_recent[data.getName()] = Simulator::Now();
+
+  // the served Data is sent after the trace, pushed Data must not overtake it
+  Simulator::ScheduleNow(&PushCache::PushOnFace, this, face.getId(), data.getName());
+}
+
+void
+PushCache::PushOnFace(nfd::FaceId faceId, Name served)
+{
+  shared_ptr<NetDeviceFace> face =
+    std::dynamic_pointer_cast<NetDeviceFace>(m_node->GetObject<L3Protocol>()->getFaceById(faceId));
+  if (face == nullptr || face->isCongested())
+    return;
+
+  Push(served, *face);
+}
+
+size_t
+PushCache::Push(const Name& served, NetDeviceFace& face)
+{
+  ::ndn::StructuredNameView view(served);
+  if (!view.hasSpatialPart() || view.spatialBegin() == view.spatialEnd() || m_maxPushes == 0)
+    return 0;
+
+  // Data about other top level regions are hardly correlated
+  Name region = served.getPrefix(view.spatialBegin() - served.begin() + 1);
+
+  PurgeRecent();
+  if (m_dictionary.size() > MAX_DICTIONARY_SIZE)
+    m_dictionary.clear();
+
+  const nfd::Cs& cs = m_forwarder->getCs();
+  std::vector<const Data*> scanned;
+  m_batch.clear();
+  uint32_t nScanned = 0;
+  for (auto i = cs.lowerBound(region); i != cs.end() && nScanned < m_maxScan; ++i, ++nScanned) {
+    const Name& name = i->getName();
+    if (!region.isPrefixOf(name))
+      break;
+    if (i->isStale() || WasPushedRecently(name))
+      continue;
+
+    scanned.push_back(&i->getData());
+    m_batch.add(::ndn::InternedStructuredName(::ndn::StructuredNameView(name), m_dictionary));
+  }
+
+  m_batch.score(::ndn::InternedStructuredName::lookup(view, m_dictionary), m_spatial,
+                m_application);
+  std::vector<std::pair<double, const Data*>> candidates;
+  for (size_t k = 0; k < scanned.size(); ++k) {
+    double correlativity = Combine(m_spatial[k], m_application[k]);
+    if (correlativity > 0.0)
+      candidates.emplace_back(correlativity, scanned[k]);
+  }
+
+  size_t nPushes = std::min<size_t>(candidates.size(), m_maxPushes);
+  std::partial_sort(candidates.begin(), candidates.begin() + nPushes, candidates.end(),
+                    [] (const std::pair<double, const Data*>& a,
+                        const std::pair<double, const Data*>& b) {
+                      return a.first > b.first;
+                    });
+
+  m_isPushing = true;
+  for (size_t i = 0; i < nPushes; ++i) {
+    const Data& data = *candidates[i].second;
+    NS_LOG_DEBUG("push " << data.getName() << " after " << served
+                 << " correlativity=" << candidates[i].first);
+    m_recent[data.getName()] = Simulator::Now();
+    face.pushData(data, candidates[i].first);
+  }
+  m_isPushing = false;
+
+  m_nPushed += nPushes;
+  return nPushes;
+}
+
+bool
+PushCache::WasPushedRecently(const Name& name) const
+{
+  auto recent = m_recent.find(name);
+  return recent != m_recent.end() && Simulator::Now() - recent->second < m_minInterval;
+}
+
+void
+PushCache::PurgeRecent()
+{
+  if (m_recent.size() <= MAX_RECENT_ENTRIES)
+    return;
+
+  Time now = Simulator::Now();
+  for (auto i = m_recent.begin(); i != m_recent.end();) {
+    if (now - i->second >= m_minInterval)
+      i = m_recent.erase(i);
+    else
+      ++i;
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
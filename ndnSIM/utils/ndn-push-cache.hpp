@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_PUSH_CACHE_H
+#define NDN_PUSH_CACHE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <ndn-cxx/correlativity-batch.hpp>
+
+#include <unordered_map>
+
+namespace nfd {
+class Forwarder;
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceFace;
+
+/**
+ * @ingroup ndn-fw
+ * @brief Pushes Data correlated with the Data a node serves into the caches of its neighbors
+ *
+ * Vehicles near a road side unit tend to request Data of the same and adjacent regions and
+ * applications.  After the node sends Data on a NetDeviceFace, the push cache looks in the
+ * content store of the node for Data whose spatial and application correlativity (see
+ * ndn::Name::getSpcorrelativityWith and ndn::Name::getAppcorrelativityWith) with the served
+ * name both reach their thresholds, and broadcasts the MaxPushes most correlated ones, by the
+ * product of the two, on the same face (see NetDeviceFace::pushData).  Nothing is pushed while
+ * the face is congested.
+ *
+ * Only fresh Data under the same first spatial component as the served name are candidates,
+ * as the content store is ordered by name, and at most MaxScan of them are looked at.  Data
+ * pushed or served within MinInterval are not pushed again.  The candidates are scored all at
+ * once with ndn::CorrelativityBatch.
+ *
+ * Neighbors cache pushed Data only if installed with InstallReceiver.  The ndnSIM content store
+ * (see StackHelper::SetOldContentStore) is not supported.
+ */
+class PushCache : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  PushCache();
+
+  /**
+   * @brief Aggregate push cache to the node (if not yet) and start pushing
+   *
+   * The NDN stack must be installed on the node.
+   */
+  static Ptr<PushCache>
+  Install(Ptr<Node> node);
+
+  static void
+  Install(const NodeContainer& c);
+
+  /**
+   * @brief Make the node cache Data pushed by its neighbors
+   *
+   * Enables overhearing on the NetDeviceFaces of the node, and makes the forwarder admit
+   * unsolicited Data from them into the content store if they were pushed, replacing the
+   * admission filter that was set before (see nfd::Forwarder::setOverheardDataAdmission).
+   * The NDN stack must be installed on the node.
+   */
+  static void
+  InstallReceiver(Ptr<Node> node);
+
+  static void
+  InstallReceiver(const NodeContainer& c);
+
+  /**
+   * @brief Correlativity of \p candidate with \p served
+   * @return the product of spatial and application correlativity, or 0 if either is below
+   *         its threshold
+   */
+  double
+  GetCorrelativity(const Name& served, const Name& candidate) const;
+
+  /**
+   * @brief Push Data correlated with \p served on \p face
+   * @return number of pushed Data
+   */
+  size_t
+  Push(const Name& served, NetDeviceFace& face);
+
+  uint64_t
+  GetNPushed() const
+  {
+    return m_nPushed;
+  }
+
+private:
+  /**
+   * @brief Product of the correlativities, or 0 if either is below its threshold
+   */
+  double
+  Combine(double spatial, double application) const;
+
+  void
+  OutData(const Data& data, const Face& face);
+
+  void
+  PushOnFace(nfd::FaceId faceId, Name served);
+
+  bool
+  WasPushedRecently(const Name& name) const;
+
+  void
+  PurgeRecent();
+
+private:
+  double m_spatialThreshold;
+  double m_applicationThreshold;
+  uint32_t m_maxPushes;
+  uint32_t m_maxScan;
+  Time m_minInterval;
+
+  Ptr<Node> m_node;
+  shared_ptr<nfd::Forwarder> m_forwarder;
+  bool m_isPushing;
+  std::unordered_map<Name, Time> m_recent; ///< name => time pushed or served
+  uint64_t m_nPushed;
+
+  // reused by Push
+  ::ndn::name::Dictionary m_dictionary; ///< components of the candidates
+  ::ndn::CorrelativityBatch m_batch;
+  std::vector<double> m_spatial;
+  std::vector<double> m_application;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PUSH_CACHE_H
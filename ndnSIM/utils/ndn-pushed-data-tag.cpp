@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-pushed-data-tag.hpp"
+#include "ndn-ns3-packet-tag.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+TypeId
+PushedDataTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PushedDataTag").SetParent<Tag>().AddConstructor<PushedDataTag>();
+  return tid;
+}
+
+TypeId
+PushedDataTag::GetInstanceTypeId() const
+{
+  return PushedDataTag::GetTypeId();
+}
+
+bool
+PushedDataTag::IsPushed(const ::ndn::TagHost& packet)
+{
+  std::shared_ptr<Ns3PacketTag> packetTag = packet.getTag<Ns3PacketTag>();
+  PushedDataTag tag;
+  return packetTag != nullptr && packetTag->getPacket()->PeekPacketTag(tag);
+}
+
+uint32_t
+PushedDataTag::GetSerializedSize() const
+{
+  return sizeof(double);
+}
+
+void
+PushedDataTag::Serialize(TagBuffer i) const
+{
+  i.WriteDouble(m_correlativity);
+}
+
+void
+PushedDataTag::Deserialize(TagBuffer i)
+{
+  m_correlativity = i.ReadDouble();
+}
+
+void
+PushedDataTag::Print(std::ostream& os) const
+{
+  os << "pushed correlativity=" << m_correlativity;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PUSHED_DATA_TAG_H
+#define NDN_PUSHED_DATA_TAG_H
+
+#include "ns3/tag.h"
+
+#include <ndn-cxx/tag-host.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Packet tag of Data pushed into the caches of neighbors (see PushCache)
+ *
+ * The tag carries the correlativity of the pushed Data with the Data whose delivery triggered
+ * the push.  NetDeviceFace sends tagged packets in the bulk transmit class, and never puts
+ * them into a container frame.
+ */
+class PushedDataTag : public Tag {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  PushedDataTag()
+    : m_correlativity(0.0)
+  {
+  }
+
+  explicit
+  PushedDataTag(double correlativity)
+    : m_correlativity(correlativity)
+  {
+  }
+
+  double
+  GetCorrelativity() const
+  {
+    return m_correlativity;
+  }
+
+  /**
+   * @brief Whether the Data was received as pushed Data
+   */
+  static bool
+  IsPushed(const ::ndn::TagHost& packet);
+
+  ////////////////////////////////////////////////////////
+  // from ObjectBase
+  ////////////////////////////////////////////////////////
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  ////////////////////////////////////////////////////////
+  // from Tag
+  ////////////////////////////////////////////////////////
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  double m_correlativity;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PUSHED_DATA_TAG_H
@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t RequestTraceReader::NO_NODE = std::numeric_limits<uint32_t>::max();
+
+static const char REQUEST_TRACE_MAGIC[8] = {'N', 'D', 'N', 'R', 'Q', 'T', '0', '1'};
+
+struct RequestHeader {
+  int64_t time;
+  uint32_t node;
+  uint32_t nameSize;
+};
+
+RequestTraceReader::RequestTraceReader(const std::string& file, uint32_t nodeId,
+                                       const std::string& nodeName)
+  : m_fileName(file)
+  , m_nodeId(nodeId)
+  , m_nodeName(nodeName)
+  , m_isBinary(false)
+  , m_offset(0)
+  , m_line(1)
+{
+  try {
+    m_file.open(file);
+  }
+  catch (const std::exception& e) {
+    throw std::runtime_error("Cannot open request log " + file + ": " + e.what());
+  }
+
+  if (m_file.size() >= sizeof(REQUEST_TRACE_MAGIC) &&
+      std::memcmp(m_file.data(), REQUEST_TRACE_MAGIC, sizeof(REQUEST_TRACE_MAGIC)) == 0) {
+    m_isBinary = true;
+    m_offset = sizeof(REQUEST_TRACE_MAGIC);
+  }
+}
+
+std::string
+RequestTraceReader::where() const
+{
+  if (m_isBinary)
+    return m_fileName + " at offset " + std::to_string(m_offset);
+  return m_fileName + ":" + std::to_string(m_line);
+}
+
+bool
+RequestTraceReader::next(Request& request)
+{
+  return m_isBinary ? nextBinary(request) : nextCsv(request);
+}
+
+bool
+RequestTraceReader::nextBinary(Request& request)
+{
+  const char* data = m_file.data();
+  while (m_offset < m_file.size()) {
+    RequestHeader header;
+    if (m_offset + sizeof(header) > m_file.size())
+      throw std::runtime_error("Truncated request in " + where());
+    std::memcpy(&header, data + m_offset, sizeof(header));
+
+    size_t nameOffset = m_offset + sizeof(header);
+    if (nameOffset + header.nameSize > m_file.size())
+      throw std::runtime_error("Truncated request in " + where());
+
+    if (header.node != m_nodeId) {
+      m_offset = nameOffset + header.nameSize;
+      continue;
+    }
+
+    try {
+      request.name.wireDecode(Block(reinterpret_cast<const uint8_t*>(data + nameOffset),
+                                    header.nameSize));
+    }
+    catch (const ::ndn::tlv::Error& e) {
+      throw std::runtime_error("Malformed name in " + where() + ": " + e.what());
+    }
+    request.time = NanoSeconds(header.time);
+    m_offset = nameOffset + header.nameSize;
+    return true;
+  }
+  return false;
+}
+
+bool
+RequestTraceReader::nextCsv(Request& request)
+{
+  const char* data = m_file.data();
+  size_t size = m_file.size();
+  for (; m_offset < size; ++m_line) {
+    const char* begin = data + m_offset;
+    const char* end = static_cast<const char*>(std::memchr(begin, '\n', size - m_offset));
+    if (end == nullptr)
+      end = data + size;
+    m_offset = end - data + 1;
+
+    const char* lineEnd = end;
+    if (lineEnd > begin && lineEnd[-1] == '\r')
+      --lineEnd;
+    if (begin == lineEnd || *begin == '#' ||
+        (lineEnd - begin >= 4 && std::memcmp(begin, "time", 4) == 0))
+      continue;
+
+    const char* comma1 = static_cast<const char*>(std::memchr(begin, ',', lineEnd - begin));
+    const char* comma2 = comma1 == nullptr ? nullptr :
+      static_cast<const char*>(std::memchr(comma1 + 1, ',', lineEnd - comma1 - 1));
+    if (comma2 == nullptr)
+      throw std::runtime_error("Expected <time>,<node>,<name> in " + where());
+
+    // only the requests of the node are parsed further
+    std::string node(comma1 + 1, comma2);
+    bool isNode = !m_nodeName.empty() && node == m_nodeName;
+    if (!isNode && !node.empty() && node.find_first_not_of("0123456789") == std::string::npos)
+      isNode = std::strtoul(node.c_str(), nullptr, 10) == m_nodeId;
+    if (!isNode)
+      continue;
+
+    std::string time(begin, comma1);
+    char* timeEnd = nullptr;
+    double seconds = std::strtod(time.c_str(), &timeEnd);
+    if (time.empty() || *timeEnd != '\0')
+      throw std::runtime_error("Malformed time in " + where());
+
+    try {
+      request.name = Name(std::string(comma2 + 1, lineEnd));
+    }
+    catch (const std::exception& e) {
+      throw std::runtime_error("Malformed name in " + where() + ": " + e.what());
+    }
+    request.time = Seconds(seconds);
+    ++m_line;
+    return true;
+  }
+  return false;
+}
+
+RequestTraceWriter::RequestTraceWriter(const std::string& file)
+  : m_os(file, std::ios::binary | std::ios::trunc)
+{
+  if (!m_os)
+    throw std::runtime_error("Cannot create request log " + file);
+  m_os.write(REQUEST_TRACE_MAGIC, sizeof(REQUEST_TRACE_MAGIC));
+}
+
+void
+RequestTraceWriter::write(Time time, uint32_t nodeId, const Name& name)
+{
+  const Block& wire = name.wireEncode();
+  RequestHeader header;
+  header.time = time.GetNanoSeconds();
+  header.node = nodeId;
+  header.nameSize = wire.size();
+  m_os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  m_os.write(reinterpret_cast<const char*>(wire.wire()), wire.size());
+}
+
+void
+RequestTraceWriter::close()
+{
+  m_os.close();
+}
+
+} // namespace ndn
+} // namespace ns3
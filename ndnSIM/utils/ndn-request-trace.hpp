@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_TRACE_H
+#define NDN_REQUEST_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <fstream>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sequential reader of the requests of one node in a request log
+ *
+ * A request log lists (time, node, name) of requests, sorted by time, in one of two formats:
+ *  - CSV: one request per line, `<time in seconds>,<node>,<name URI>`, the node being a node
+ *    id or a name registered by Names class.  Empty lines, lines starting with # and a header
+ *    line starting with "time" are skipped.
+ *  - binary, as written by RequestTraceWriter (host byte order):
+ *
+ *        header:   "NDNRQT01"
+ *        requests: int64 time in nanoseconds, uint32 node id, uint32 name size, Name TLV
+ *
+ * The file is memory-mapped and read as the simulation goes, so logs with millions of requests
+ * are replayed without being loaded into memory.  Requests of other nodes are skipped without
+ * decoding their names.
+ */
+class RequestTraceReader : noncopyable {
+public:
+  static const uint32_t NO_NODE;
+
+  struct Request {
+    Time time;
+    Name name;
+  };
+
+  /**
+   * @param file     request log
+   * @param nodeId   id of the node whose requests are read
+   * @param nodeName name of the node, matched against node names in CSV logs (empty to match
+   *                 only ids)
+   * @throw std::runtime_error the file cannot be opened
+   */
+  RequestTraceReader(const std::string& file, uint32_t nodeId, const std::string& nodeName = "");
+
+  bool
+  isBinary() const
+  {
+    return m_isBinary;
+  }
+
+  /**
+   * @brief Read the next request of the node
+   * @return false at the end of the log
+   * @throw std::runtime_error the log is malformed
+   */
+  bool
+  next(Request& request);
+
+private:
+  bool
+  nextBinary(Request& request);
+
+  bool
+  nextCsv(Request& request);
+
+  std::string
+  where() const;
+
+private:
+  boost::iostreams::mapped_file_source m_file;
+  std::string m_fileName;
+  uint32_t m_nodeId;
+  std::string m_nodeName;
+  bool m_isBinary;
+  size_t m_offset;
+  size_t m_line; ///< of the CSV line at m_offset
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Writer of binary request logs
+ * @sa RequestTraceReader
+ */
+class RequestTraceWriter : noncopyable {
+public:
+  /**
+   * @throw std::runtime_error the file cannot be created
+   */
+  explicit
+  RequestTraceWriter(const std::string& file);
+
+  void
+  write(Time time, uint32_t nodeId, const Name& name);
+
+  void
+  close();
+
+private:
+  std::ofstream m_os;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_TRACE_H
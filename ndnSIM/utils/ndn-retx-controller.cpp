@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-retx-controller.hpp"
+
+#include "ns3/uinteger.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.RetxController");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RetxController);
+
+TypeId
+RetxController::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RetxController")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<RetxController>()
+      .AddAttribute("MaxTransmissions",
+                    "Maximum number of transmissions of an Interest "
+                    "(initial budget of adaptive controllers)",
+                    UintegerValue(3), MakeUintegerAccessor(&RetxController::m_maxTransmissions),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddTraceSource("Decision", "Timed out Interest is retransmitted or given up",
+                      MakeTraceSourceAccessor(&RetxController::m_decision),
+                      "ns3::ndn::RetxController::DecisionCallback");
+  return tid;
+}
+
+RetxController::RetxController()
+  : m_maxTransmissions(3)
+{
+}
+
+bool
+RetxController::OnTimeout(const Name& name, uint32_t nTransmissions)
+{
+  NoteTimeout(name, nTransmissions);
+
+  bool isRetransmitted = nTransmissions < GetBudget(name);
+  NS_LOG_DEBUG(name << " timed out after " << nTransmissions << " transmissions, "
+                    << (isRetransmitted ? "retransmit" : "give up"));
+  if (!isRetransmitted)
+    NoteGiveUp(name, nTransmissions);
+
+  m_decision(name, nTransmissions, isRetransmitted);
+  return isRetransmitted;
+}
+
+void
+RetxController::OnData(const Name& name, uint32_t nTransmissions)
+{
+}
+
+uint32_t
+RetxController::GetBudget(const Name& name)
+{
+  return m_maxTransmissions;
+}
+
+void
+RetxController::SetMaxTransmissions(uint32_t maxTransmissions)
+{
+  m_maxTransmissions = maxTransmissions;
+}
+
+uint32_t
+RetxController::GetMaxTransmissions() const
+{
+  return m_maxTransmissions;
+}
+
+void
+RetxController::NoteTimeout(const Name& name, uint32_t nTransmissions)
+{
+}
+
+void
+RetxController::NoteGiveUp(const Name& name, uint32_t nTransmissions)
+{
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RETX_CONTROLLER_H
+#define NDN_RETX_CONTROLLER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Base class of retransmission controllers: decides whether a timed out Interest is
+ *        retransmitted
+ *
+ * This controller allows a fixed number of transmissions for every Interest (MaxTransmissions).
+ * Subclasses adapt the number to the outcome of earlier Interests.
+ */
+class RetxController : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  RetxController();
+
+  /**
+   * \brief Note that the Interest timed out and decide whether to retransmit it
+   * \param name Interest name
+   * \param nTransmissions number of times the Interest has been sent
+   * \return true if the Interest should be retransmitted, false to give it up
+   */
+  bool
+  OnTimeout(const Name& name, uint32_t nTransmissions);
+
+  /**
+   * \brief Note that Data for the Interest came back
+   * \param nTransmissions number of times the Interest has been sent
+   */
+  virtual void
+  OnData(const Name& name, uint32_t nTransmissions);
+
+  /**
+   * \brief Get the number of transmissions allowed for an Interest with the name
+   */
+  virtual uint32_t
+  GetBudget(const Name& name);
+
+  void
+  SetMaxTransmissions(uint32_t maxTransmissions);
+
+  uint32_t
+  GetMaxTransmissions() const;
+
+  typedef void (*DecisionCallback)(const Name&, uint32_t, bool);
+
+protected:
+  /**
+   * \brief Update statistics with the timeout, called before the budget is checked
+   */
+  virtual void
+  NoteTimeout(const Name& name, uint32_t nTransmissions);
+
+  /**
+   * \brief Note that the Interest was given up
+   */
+  virtual void
+  NoteGiveUp(const Name& name, uint32_t nTransmissions);
+
+protected:
+  uint32_t m_maxTransmissions;
+
+  /// name, number of transmissions, true if retransmitted
+  TracedCallback<const Name&, uint32_t, bool> m_decision;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RETX_CONTROLLER_H
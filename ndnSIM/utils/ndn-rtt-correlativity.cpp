@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-correlativity.hpp"
+#include "ns3/log.h"
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttCorrelativityEngine");
+
+namespace ns3 {
+namespace ndn {
+
+// weights are rebased before exp() of the time since the reference gets large
+static const double REBASE_INTERVAL_MIN = 10.0;
+
+const size_t RttCorrelativityEngine::N_HOP_BANDS;
+
+namespace {
+
+/**
+ * \brief Correlativity-weighted sums over the samples of correlated clusters
+ */
+struct EstimateSums {
+  double scSum = 0.0, acSum = 0.0, tcSum = 0.0;
+  double rttScSum = 0.0, rttAcSum = 0.0, rttTcSum = 0.0;
+  double mass = 0.0; ///< sum(sc_i + ac_i)
+
+  void
+  add(const EstimateSums& other)
+  {
+    scSum += other.scSum;
+    acSum += other.acSum;
+    tcSum += other.tcSum;
+    rttScSum += other.rttScSum;
+    rttAcSum += other.rttAcSum;
+    rttTcSum += other.rttTcSum;
+    mass += other.mass;
+  }
+
+  bool
+  combine(double& rto) const
+  {
+    if (tcSum == 0)
+      return false;
+
+    if (scSum != 0 && acSum != 0)
+      rto = (rttScSum / scSum + rttAcSum / acSum + rttTcSum / tcSum) / 3.0;
+    else if (scSum == 0 && acSum != 0)
+      rto = (rttAcSum / acSum + rttTcSum / tcSum) / 2.0;
+    else if (scSum != 0 && acSum == 0)
+      rto = (rttScSum / scSum + rttTcSum / tcSum) / 2.0;
+    else
+      rto = rttTcSum / tcSum;
+    return true;
+  }
+};
+
+} // namespace
+
+RttCorrelativityEngine::RttCorrelativityEngine()
+  : m_reference(Seconds(0))
+  , m_nEstimates(0)
+{
+}
+
+void
+RttCorrelativityEngine::Index(ComponentIndex& index, Name::const_iterator first,
+                              Name::const_iterator last, Cluster* cluster, bool isAdd)
+{
+  for (; first != last; ++first) {
+    ComponentKey key(*first);
+    if (isAdd) {
+      // returns the existing node if the component is already indexed
+      ComponentIndex::iterator node = index.insert(key, ClusterSet()).first;
+      node->payload().insert(cluster);
+    }
+    else {
+      ComponentIndex::iterator node = index.find_exact(key);
+      if (node == index.end())
+        continue;
+      node->payload().erase(cluster);
+      if (node->payload().empty())
+        index.erase(node);
+    }
+  }
+}
+
+void
+RttCorrelativityEngine::IndexCluster(Cluster& cluster, bool isAdd)
+{
+  // the last component is the sequence number of the representative, it is not shared by
+  // other samples of the cluster
+  const ::ndn::StructuredNameView& view = cluster.view;
+  Name::const_iterator nameEnd = cluster.representative.end() - 1;
+
+  if (view.hasSpatialPart())
+    Index(m_spatialIndex, view.spatialBegin(), std::min(view.spatialEnd(), nameEnd), &cluster,
+          isAdd);
+  if (view.hasApplicationPart())
+    Index(m_applicationIndex, view.applicationBegin(), std::max(view.applicationBegin(), nameEnd),
+          &cluster, isAdd);
+}
+
+void
+RttCorrelativityEngine::CollectCandidates(ComponentIndex& index, Name::const_iterator first,
+                                          Name::const_iterator last,
+                                          std::vector<Cluster*>& candidates)
+{
+  for (; first != last; ++first) {
+    ComponentIndex::iterator node = index.find_exact(ComponentKey(*first));
+    if (node == index.end())
+      continue;
+
+    for (Cluster* cluster : node->payload()) {
+      if (cluster->visited != m_nEstimates) {
+        cluster->visited = m_nEstimates;
+        candidates.push_back(cluster);
+      }
+    }
+  }
+}
+
+size_t
+RttCorrelativityEngine::GetHopBand(int32_t hopCount)
+{
+  if (hopCount < 0)
+    return N_HOP_BANDS;
+  if (hopCount < 2)
+    return 0;
+  if (hopCount < 4)
+    return 1;
+  if (hopCount < 8)
+    return 2;
+  return 3;
+}
+
+double
+RttCorrelativityEngine::GetWeight(Time rcvTime) const
+{
+  return std::exp((rcvTime - m_reference).ToDouble(Time::MIN));
+}
+
+void
+RttCorrelativityEngine::Rebase(Time now)
+{
+  double factor = std::exp((m_reference - now).ToDouble(Time::MIN));
+  for (auto& cluster : m_clusters) {
+    cluster.second.sumWeight *= factor;
+    cluster.second.sumRttWeight *= factor;
+  }
+  m_reference = now;
+}
+
+void
+RttCorrelativityEngine::AddSample(const RttHistory& h, uint32_t owner)
+{
+  if (h.rcvTime <= h.time)
+    return; // same condition as the full scan: record has no valid RTT
+
+  RemoveSample(h, owner);
+
+  size_t band = GetHopBand(h.hopCount);
+  Cluster& cluster =
+    m_clusters[ClusterKey(::ndn::InternedName(h.name.getPrefix(-1), m_dictionary), band)];
+  if (cluster.nSamples == 0) {
+    cluster.band = band;
+    cluster.representative = h.name;
+    cluster.view = ::ndn::StructuredNameView(cluster.representative);
+    // the sequence number is not interned, so the dictionary does not grow with the samples
+    cluster.segments = ::ndn::InternedStructuredName(cluster.view, m_dictionary, true);
+    IndexCluster(cluster, true);
+  }
+
+  double rtt = (h.rcvTime - h.time).ToDouble(Time::S);
+  double weight = GetWeight(h.rcvTime);
+
+  cluster.nSamples++;
+  cluster.sumRtt += rtt;
+  cluster.sumWeight += weight;
+  cluster.sumRttWeight += rtt * weight;
+
+  Sample sample;
+  sample.cluster = &cluster;
+  sample.rtt = rtt;
+  sample.rcvTime = h.rcvTime;
+  m_samples[GetSampleKey(h, owner)] = sample;
+}
+
+void
+RttCorrelativityEngine::RemoveSample(const RttHistory& h, uint32_t owner)
+{
+  auto entry = m_samples.find(GetSampleKey(h, owner));
+  if (entry == m_samples.end())
+    return;
+
+  const Sample& sample = entry->second;
+  Cluster& cluster = *sample.cluster;
+  cluster.nSamples--;
+  if (cluster.nSamples == 0) {
+    // drop accumulated rounding errors together with the cluster
+    IndexCluster(cluster, false);
+    m_clusters.erase(ClusterKey(::ndn::InternedName(cluster.representative.getPrefix(-1),
+                                                    m_dictionary), cluster.band));
+  }
+  else {
+    double weight = GetWeight(sample.rcvTime);
+    cluster.sumRtt -= sample.rtt;
+    cluster.sumWeight -= weight;
+    cluster.sumRttWeight -= sample.rtt * weight;
+  }
+  m_samples.erase(entry);
+}
+
+void
+RttCorrelativityEngine::Clear()
+{
+  m_samples.clear();
+  m_spatialIndex.clear();
+  m_applicationIndex.clear();
+  m_clusters.clear();
+  m_dictionary.clear();
+}
+
+size_t
+RttCorrelativityEngine::GetMemoryUsage() const
+{
+  // unordered_map and unordered_set nodes have the link and the cached hash next to the value
+  static const size_t NODE_OVERHEAD = 2 * sizeof(void*);
+
+  size_t n = m_samples.size() * (sizeof(decltype(m_samples)::value_type) + NODE_OVERHEAD) +
+             m_samples.bucket_count() * sizeof(void*) +
+             m_clusters.bucket_count() * sizeof(void*) +
+             m_candidates.capacity() * sizeof(Cluster*) +
+             m_dictionary.getMemoryUsage();
+  for (const auto& cluster : m_clusters) {
+    // key holds handles of the components, representative holds the components,
+    // and the cluster is in the index set of each of its components
+    n += sizeof(decltype(m_clusters)::value_type) + NODE_OVERHEAD +
+         cluster.first.first.getMemoryUsage() - sizeof(::ndn::InternedName) +
+         cluster.second.segments.getMemoryUsage() - sizeof(::ndn::InternedStructuredName) +
+         cluster.second.representative.size() * (sizeof(name::Component) +
+                                                 sizeof(Cluster*) + NODE_OVERHEAD);
+  }
+  return n;
+}
+
+bool
+RttCorrelativityEngine::Estimate(const Name& name, Time now, double& rto, bool isHopStratified)
+{
+  if (m_clusters.empty())
+    return false;
+
+  if ((now - m_reference).ToDouble(Time::MIN) > REBASE_INTERVAL_MIN)
+    Rebase(now);
+
+  // converts weights relative to m_reference into exp(-(now - rcvTime) / 1min)
+  double scale = std::exp((m_reference - now).ToDouble(Time::MIN));
+
+  ::ndn::StructuredNameView query(name);
+
+  // per hop band, the last one for samples with unknown hop count
+  EstimateSums bands[N_HOP_BANDS + 1];
+  bool hasCorrelated = false;
+
+  // only clusters sharing a component with the name have non-zero correlativity
+  ++m_nEstimates;
+  m_candidates.clear();
+  if (query.hasSpatialPart())
+    CollectCandidates(m_spatialIndex, query.spatialBegin(), query.spatialEnd(), m_candidates);
+  if (query.hasApplicationPart())
+    CollectCandidates(m_applicationIndex, query.applicationBegin(), query.applicationEnd(),
+                      m_candidates);
+
+  m_batch.clear();
+  for (const Cluster* candidate : m_candidates) {
+    m_batch.add(candidate->segments);
+  }
+  m_batch.score(::ndn::InternedStructuredName::lookup(query, m_dictionary),
+                m_spatial, m_application);
+
+  for (size_t k = 0; k < m_candidates.size(); ++k) {
+    const Cluster& cluster = *m_candidates[k];
+
+    // same assignment as in the full scan: sc is application, ac is spatial correlativity
+    double sc = m_application[k];
+    double ac = m_spatial[k];
+    if (sc <= 0.0 && ac <= 0.0)
+      continue;
+
+    hasCorrelated = true;
+    EstimateSums& sums = bands[cluster.band];
+    sums.scSum += sc * cluster.nSamples;
+    sums.acSum += ac * cluster.nSamples;
+    sums.tcSum += cluster.sumWeight * scale;
+    sums.rttScSum += sc * cluster.sumRtt;
+    sums.rttAcSum += ac * cluster.sumRtt;
+    sums.rttTcSum += cluster.sumRttWeight * scale;
+    sums.mass += (sc + ac) * cluster.nSamples;
+  }
+
+  if (!hasCorrelated)
+    return false;
+
+  if (isHopStratified) {
+    // predicted hop distance: the band most correlated samples came from, the farther on ties
+    size_t predicted = N_HOP_BANDS;
+    for (size_t band = 0; band < N_HOP_BANDS; ++band) {
+      if (bands[band].mass > 0.0 &&
+          (predicted == N_HOP_BANDS || bands[band].mass >= bands[predicted].mass))
+        predicted = band;
+    }
+    if (predicted != N_HOP_BANDS && bands[predicted].combine(rto)) {
+      NS_LOG_DEBUG("Correlativity RTO for " << name << " in hop band " << predicted << ": "
+                   << rto << "s");
+      return true;
+    }
+  }
+
+  EstimateSums total;
+  for (const EstimateSums& sums : bands) {
+    total.add(sums);
+  }
+  if (!total.combine(rto))
+    return false;
+
+  NS_LOG_DEBUG("Correlativity RTO for " << name << ": " << rto << "s");
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,260 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_CORRELATIVITY_H
+#define NDN_RTT_CORRELATIVITY_H
+
+#include "ndn-rtt-estimator.hpp"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp" // boost::hash_value for name::Component
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/empty-policy.hpp"
+
+#include <ndn-cxx/correlativity-batch.hpp>
+#include <ndn-cxx/name-dictionary.hpp>
+#include <ndn-cxx/structured-name-view.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Incremental engine for the correlativity-weighted RTO
+ *
+ * For a set of samples with spatial correlativity sc_i, application correlativity ac_i,
+ * temporal correlativity tc_i and RTT rtt_i, the correlativity RTO can be written as
+ *
+ *     RTO = (sum(rtt_i * sc_i) / S + sum(rtt_i * ac_i) / A + sum(rtt_i * tc_i) / T) / 3
+ *
+ * where S, A and T are the sums of sc_i, ac_i and tc_i (terms with a zero sum are
+ * dropped and the divisor is reduced accordingly).
+ *
+ * Names that differ only in their last (sequence number) component have the same spatial
+ * and application correlativity with any other name, so samples are grouped into clusters
+ * keyed by the name without its last component.  Keys are interned in a dictionary owned by
+ * the engine, so a key costs 4 bytes per component and is hashed and compared as a sequence of
+ * handles; last components are not interned (they are usually unique).  Each cluster keeps running sums of RTT
+ * and of exp(rcvTime / 1min) relative to a reference time, which makes the temporal term
+ * a single multiplication at query time.  An estimate costs two correlativity evaluations
+ * per cluster, independent of the number of samples.
+ *
+ * Correlativity of two segments is non-zero only if they have a common component.  Every
+ * component of the spatial and application segments of a cluster is indexed in a trie
+ * (one level per component), so an estimate only visits clusters that share at least one
+ * component with the queried name: O(name depth + number of correlated clusters).  The
+ * segments of each cluster are also kept as handles of the dictionary, and the candidates are
+ * scored all at once by ::ndn::CorrelativityBatch.
+ *
+ * Samples are also grouped by the hop distance of their Data (see RttHistory::hopCount), in
+ * bands of 0-1, 2-3, 4-7 and 8 or more hops, with a separate cluster per band.  A hop-stratified
+ * estimate predicts the band of the name as the one with the largest correlativity mass
+ * (sum of (sc_i + ac_i) over correlated samples with a known hop count), and uses only the
+ * samples of that band.  Unstratified estimates use all samples, as if there were no bands.
+ *
+ * The result equals the full scan of RttMeanDeviation::CalRTObyCorrelativityFullScan up to
+ * floating point rounding (relative difference below 1e-9 in practice), provided the last
+ * components of the compared names are distinct and do not appear elsewhere in the names,
+ * which holds for sequence-numbered Interests.
+ */
+class RttCorrelativityEngine {
+public:
+  RttCorrelativityEngine();
+
+  /**
+   * \brief Add RTT sample of an acknowledged record (replaces a previous sample for the seq)
+   * \param owner distinguishes records of different estimators sharing the engine
+   */
+  void
+  AddSample(const RttHistory& h, uint32_t owner = 0);
+
+  /**
+   * \brief Remove sample of the record, if it was added
+   */
+  void
+  RemoveSample(const RttHistory& h, uint32_t owner = 0);
+
+  void
+  Clear();
+
+  /**
+   * \brief Calculate the correlativity-weighted RTO for the name
+   * \param name Interest name
+   * \param now current time
+   * \param[out] rto estimated RTO in seconds
+   * \param isHopStratified use only samples of the hop band predicted for the name, if any
+   *        correlated sample has a known hop count
+   * \return false if none of the samples is correlated with the name
+   */
+  bool
+  Estimate(const Name& name, Time now, double& rto, bool isHopStratified = false);
+
+  /**
+   * \brief Hop band of a hop count: 0 for 0-1 hops, 1 for 2-3, 2 for 4-7, 3 for 8 or more
+   * \return N_HOP_BANDS if the hop count is unknown (negative)
+   */
+  static size_t
+  GetHopBand(int32_t hopCount);
+
+  static const size_t N_HOP_BANDS = 4;
+
+  size_t
+  GetNSamples() const
+  {
+    return m_samples.size();
+  }
+
+  size_t
+  GetNClusters() const
+  {
+    return m_clusters.size();
+  }
+
+  /**
+   * \brief Get approximate number of bytes used by samples, clusters and the component indexes
+   *
+   * An index item is counted per indexed component of a cluster; trie nodes are not counted.
+   */
+  size_t
+  GetMemoryUsage() const;
+
+private:
+  struct Cluster {
+    Cluster()
+      : band(N_HOP_BANDS)
+      , nSamples(0)
+      , visited(0)
+      , sumRtt(0.0)
+      , sumWeight(0.0)
+      , sumRttWeight(0.0)
+    {
+    }
+
+    Name representative; ///< any name of the cluster, used to evaluate correlativity
+    ::ndn::StructuredNameView view; ///< S/A segments of the representative
+    ::ndn::InternedStructuredName segments; ///< S/A segments, last component not interned
+    size_t band;         ///< hop band of the samples, N_HOP_BANDS if unknown
+    uint32_t nSamples;
+    uint64_t visited;    ///< number of the last estimate that visited the cluster
+    double sumRtt;       ///< sum(rtt_i), seconds
+    double sumWeight;    ///< sum(exp((rcvTime_i - reference) / 1min))
+    double sumRttWeight; ///< sum(rtt_i * exp((rcvTime_i - reference) / 1min))
+  };
+
+  struct Sample {
+    Cluster* cluster;
+    double rtt;
+    Time rcvTime;
+  };
+
+  /**
+   * \brief Single name component used as a trie key
+   */
+  class ComponentKey {
+  public:
+    typedef name::Component value_type;
+    typedef const name::Component* const_iterator;
+    typedef const_iterator iterator;
+
+    explicit ComponentKey(const name::Component& component)
+      : m_component(&component)
+    {
+    }
+
+    const_iterator
+    begin() const
+    {
+      return m_component;
+    }
+
+    const_iterator
+    end() const
+    {
+      return m_component + 1;
+    }
+
+  private:
+    const name::Component* m_component;
+  };
+
+  typedef std::unordered_set<Cluster*> ClusterSet;
+
+  /**
+   * \brief Name without the last component, and hop band
+   */
+  typedef std::pair<::ndn::InternedName, size_t> ClusterKey;
+
+  struct ClusterKeyHash {
+    size_t
+    operator()(const ClusterKey& key) const
+    {
+      return std::hash<::ndn::InternedName>()(key.first) * 31 + key.second;
+    }
+  };
+
+  typedef ndnSIM::trie_with_policy<ComponentKey, ndnSIM::non_pointer_traits<ClusterSet>,
+                                   ndnSIM::empty_policy_traits> ComponentIndex;
+
+  static uint64_t
+  GetSampleKey(const RttHistory& h, uint32_t owner)
+  {
+    return (static_cast<uint64_t>(owner) << 32) | h.seq.GetValue();
+  }
+
+  double
+  GetWeight(Time rcvTime) const;
+
+  void
+  Rebase(Time now);
+
+  /**
+   * \brief Add (or remove) the cluster to the index entries of components in [first, last)
+   */
+  static void
+  Index(ComponentIndex& index, Name::const_iterator first, Name::const_iterator last,
+        Cluster* cluster, bool isAdd);
+
+  void
+  IndexCluster(Cluster& cluster, bool isAdd);
+
+  void
+  CollectCandidates(ComponentIndex& index, Name::const_iterator first, Name::const_iterator last,
+                    std::vector<Cluster*>& candidates);
+
+private:
+  ::ndn::name::Dictionary m_dictionary; ///< components of cluster keys
+  std::unordered_map<ClusterKey, Cluster, ClusterKeyHash> m_clusters;
+  ComponentIndex m_spatialIndex;
+  ComponentIndex m_applicationIndex;
+  uint64_t m_nEstimates;
+  std::vector<Cluster*> m_candidates; ///< scratch space reused by Estimate
+  ::ndn::CorrelativityBatch m_batch;  ///< segments of the candidates, reused by Estimate
+  std::vector<double> m_spatial;      ///< correlativity of the candidates, reused by Estimate
+  std::vector<double> m_application;
+  std::unordered_map<uint64_t, Sample> m_samples; ///< (owner, seq) => sample
+  Time m_reference;                               ///< reference time of the weights
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_CORRELATIVITY_H
@@ -29,12 +29,16 @@
 //#include <iostream>
 
 #include "ndn-rtt-estimator.hpp"
+#include "ndn-checkpoint-stream.hpp"
 #include "ns3/simulator.h"
 #include "ns3/double.h"
 #include "ns3/integer.h"
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <limits>
+
 NS_LOG_COMPONENT_DEFINE("ndn.RttEstimator");
 
 
@@ -113,6 +117,7 @@ RttHistory::RttHistory(SequenceNumber32 s, uint32_t c, Time t)
   , rto(0)
   , rcvTime(t)
   , retx(false)
+  , hopCount(-1)
   , name("\11\22\33\44\55\66")   //Yuwei
 {
   NS_LOG_FUNCTION(this);
@@ -125,6 +130,7 @@ RttHistory::RttHistory(SequenceNumber32 s, uint32_t c, Time t, Time r, Name n)
   , rto(r)
   , rcvTime(t)
   , retx(false)
+  , hopCount(-1)
   , name(n)
 {
   NS_LOG_FUNCTION(this);
@@ -137,6 +143,7 @@ RttHistory::RttHistory(const RttHistory& h)
   , rto(h.rto)
   , rcvTime(h.rcvTime)
   , retx(h.retx)
+  , hopCount(h.hopCount)
   , name(h.name)
 {
   NS_LOG_FUNCTION(this);
@@ -152,6 +159,122 @@ CorrelativityRcd::CorrelativityRcd(double sc, double ac, double tc, Time t)
 }
 //=======================================================================
 
+RttHistoryContainer::RttHistoryContainer()
+{
+}
+
+RttHistoryContainer::RttHistoryContainer(const RttHistoryContainer& other)
+  : m_list(other.m_list)
+{
+  rebuildIndex();
+}
+
+RttHistoryContainer&
+RttHistoryContainer::operator=(const RttHistoryContainer& other)
+{
+  if (this != &other) {
+    m_list = other.m_list;
+    rebuildIndex();
+  }
+  return *this;
+}
+
+void
+RttHistoryContainer::push_back(const RttHistory& h)
+{
+  erase(h.seq);
+  iterator i = m_list.insert(m_list.end(), h);
+  m_index[h.seq.GetValue()] = i;
+}
+
+void
+RttHistoryContainer::pop_front()
+{
+  notifyErase(m_list.front());
+  m_index.erase(m_list.front().seq.GetValue());
+  m_list.pop_front();
+}
+
+RttHistoryContainer::iterator
+RttHistoryContainer::erase(iterator i)
+{
+  notifyErase(*i);
+  m_index.erase(i->seq.GetValue());
+  return m_list.erase(i);
+}
+
+bool
+RttHistoryContainer::erase(SequenceNumber32 seq)
+{
+  auto entry = m_index.find(seq.GetValue());
+  if (entry == m_index.end())
+    return false;
+
+  notifyErase(*entry->second);
+  m_list.erase(entry->second);
+  m_index.erase(entry);
+  return true;
+}
+
+RttHistoryContainer::iterator
+RttHistoryContainer::find(SequenceNumber32 seq)
+{
+  auto entry = m_index.find(seq.GetValue());
+  if (entry == m_index.end())
+    return m_list.end();
+  return entry->second;
+}
+
+RttHistoryContainer::const_iterator
+RttHistoryContainer::find(SequenceNumber32 seq) const
+{
+  auto entry = m_index.find(seq.GetValue());
+  if (entry == m_index.end())
+    return m_list.end();
+  return entry->second;
+}
+
+void
+RttHistoryContainer::markReceived(iterator i, Time rcvTime)
+{
+  i->rcvTime = rcvTime;
+  m_list.splice(m_list.end(), m_list, i); // iterators stay valid, index needs no update
+}
+
+void
+RttHistoryContainer::clear()
+{
+  if (m_onErase) {
+    for (const RttHistory& h : m_list)
+      m_onErase(h);
+  }
+  m_index.clear();
+  m_list.clear();
+}
+
+size_t
+RttHistoryContainer::getMemoryUsage() const
+{
+  size_t n = 0;
+  for (const RttHistory& h : m_list) {
+    // list node links, plus the components of the name
+    n += sizeof(RttHistory) + 2 * sizeof(void*) + h.name.size() * sizeof(name::Component);
+  }
+  // unordered_map node has the link next to the key-value pair
+  n += m_index.size() * (sizeof(decltype(m_index)::value_type) + sizeof(void*)) +
+       m_index.bucket_count() * sizeof(void*);
+  return n;
+}
+
+void
+RttHistoryContainer::rebuildIndex()
+{
+  m_index.clear();
+  for (iterator i = m_list.begin(); i != m_list.end(); ++i) {
+    m_index[i->seq.GetValue()] = i;
+  }
+}
+
 // Base class methods
 
 RttEstimator::RttEstimator()
@@ -207,18 +330,20 @@ RttEstimator::SentSeq(SequenceNumber32 seq, uint32_t size)
     m_next = seq + SequenceNumber32(size); // Update next expected
   }
   else { // This is a retransmit, find in list and mark as re-tx
-    for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i)
-    {
-      if ((seq >= i->seq) && (seq < (i->seq + SequenceNumber32(i->count))))
-      { // Found it
-        i->retx = true;
-        // One final test..be sure this re-tx does not extend "next"
-        if ((seq + SequenceNumber32(size)) > m_next)
-        {
-          m_next = seq + SequenceNumber32(size);
-          i->count = ((seq + SequenceNumber32(size)) - i->seq); // And update count in hist
-        }
-        break;
+    RttHistory_t::iterator i = m_history.find(seq);
+    if (i == m_history.end()) {
+      // seq is not the first sequence number of a record, fall back to the range search
+      for (i = m_history.begin(); i != m_history.end(); ++i) {
+        if ((seq >= i->seq) && (seq < (i->seq + SequenceNumber32(i->count))))
+          break;
+      }
+    }
+    if (i != m_history.end()) { // Found it
+      i->retx = true;
+      // One final test..be sure this re-tx does not extend "next"
+      if ((seq + SequenceNumber32(size)) > m_next) {
+        m_next = seq + SequenceNumber32(size);
+        i->count = ((seq + SequenceNumber32(size)) - i->seq); // And update count in hist
       }
     }
   }
@@ -253,6 +378,20 @@ RttEstimator::AckSeq(Name name, SequenceNumber32 ackSeq)
   return m;
 }
 
+Time
+RttEstimator::AckSeq(Name name, SequenceNumber32 ackSeq, int32_t hopCount)
+{
+  RttHistory_t::iterator i = m_history.find(ackSeq);
+  if (i != m_history.end())
+    i->hopCount = hopCount < 0 ? -1 : hopCount;
+  return AckSeq(name, ackSeq);
+}
+
+void
+RttEstimator::AddRttHint(const Name& name, Time srtt, Time rttvar, uint32_t nSamples)
+{
+}
+
 void
 RttEstimator::ClearSent()
 {
@@ -262,6 +401,57 @@ RttEstimator::ClearSent()
   m_history.clear();
 }
 
+size_t
+RttEstimator::GetMemoryUsage() const
+{
+  return sizeof(RttEstimator) + m_history.getMemoryUsage();
+}
+
+void
+RttEstimator::SaveState(std::ostream& os) const
+{
+  checkpoint::write<int64_t>(os, m_currentEstimatedRtt.GetNanoSeconds());
+  checkpoint::write<uint32_t>(os, m_nSamples);
+  checkpoint::write<uint16_t>(os, m_multiplier);
+
+  uint32_t nReceived = std::count_if(m_history.begin(), m_history.end(),
+                                     [] (const RttHistory& h) { return h.rcvTime > h.time; });
+  checkpoint::write<uint32_t>(os, nReceived);
+  for (const RttHistory& h : m_history) {
+    if (h.rcvTime <= h.time)
+      continue;
+    checkpoint::write<uint32_t>(os, h.count);
+    checkpoint::writeTime(os, h.time);
+    checkpoint::writeTime(os, h.rcvTime);
+    checkpoint::write<int64_t>(os, h.rto.GetNanoSeconds());
+    checkpoint::writeBlock(os, h.name.wireEncode());
+  }
+}
+
+void
+RttEstimator::LoadState(std::istream& is)
+{
+  NS_LOG_FUNCTION(this);
+  m_history.clear();
+  m_currentEstimatedRtt = NanoSeconds(checkpoint::read<int64_t>(is));
+  m_nSamples = checkpoint::read<uint32_t>(is);
+  m_multiplier = checkpoint::read<uint16_t>(is);
+
+  uint32_t nRecords = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nRecords; ++i) {
+    uint32_t count = checkpoint::read<uint32_t>(is);
+    Time time = checkpoint::readTime(is);
+    Time rcvTime = checkpoint::readTime(is);
+    Time rto = NanoSeconds(checkpoint::read<int64_t>(is));
+    Name name(checkpoint::readBlock(is));
+
+    RttHistory h(SequenceNumber32(std::numeric_limits<uint32_t>::max() - (nRecords - 1 - i)),
+                 count, time, rto, name);
+    h.rcvTime = rcvTime;
+    m_history.push_back(h);
+  }
+}
+
 void
 RttEstimator::IncreaseMultiplier()
 {
@@ -298,68 +488,48 @@ RttEstimator::GetTmpcorrelativity(Time curTime, Time rcvTime)const
 	return exp(-timeDiff.ToDouble(Time::MIN));
 }
 
-void
+uint32_t
 RttEstimator::UpateRttHistory(double min)
 {
+	// history is sorted by receive time, so only the expired head needs to be visited
+	uint32_t nEvicted = 0;
 	Time timeDiff;
-	RttHistory_t::iterator i;
-	for (i = m_history.begin(); i != m_history.end(); ++i)
+	while (!m_history.empty())
 	{
-		timeDiff = Simulator::Now() - i->rcvTime;
-		if(timeDiff.ToDouble(Time::MIN)>min)  //min minutes
-		{
-			m_history.erase(i);
-		}
+		timeDiff = Simulator::Now() - m_history.front().rcvTime;
+		if(timeDiff.ToDouble(Time::MIN)<=min)  //min minutes
+			break;
+		m_history.pop_front();
+		++nEvicted;
 	}
+	return nEvicted;
 }
 
 Time
 RttEstimator::GetRtobySeq(SequenceNumber32 seq)
 {
-	Time rto(0);
-	RttHistory_t::iterator i;
-	for (i = m_history.begin(); i != m_history.end(); ++i)
-	{
-		if(i->seq == seq)
-		{
-			rto =i->rto;
-			break;
-		}
-	}
-	return rto;
+	RttHistory_t::iterator i = m_history.find(seq);
+	if (i == m_history.end())
+		return Time(0);
+	return i->rto;
 }
 
 Time
 RttEstimator::GetRetransRtobySeq(SequenceNumber32 seq)
 {
-	double retval=0.0;
-	RttHistory_t::iterator i;
-	for (i = m_history.begin(); i != m_history.end(); ++i)
-	{
-		if(i->seq == seq)
-		{
-			retval =std::min(m_maxRto.ToDouble(Time::S), i->rto.ToDouble(Time::S)*2);
-
-			break;
-		}
-	}
-	return Seconds(retval);
+	RttHistory_t::iterator i = m_history.find(seq);
+	if (i == m_history.end())
+		return Seconds(0.0);
+	return Seconds(std::min(m_maxRto.ToDouble(Time::S), i->rto.ToDouble(Time::S)*2));
 }
 
 Name
 RttEstimator::GetNamebySeq(SequenceNumber32 seq)
 {
-	Name tmp("");
-	RttHistory_t::iterator i;
-	for (i = m_history.begin(); i != m_history.end(); ++i)
-	{
-		if(i->seq == seq)
-		{
-			tmp = i->name;
-			break;
-		}
-	}
-	return tmp;
+	RttHistory_t::iterator i = m_history.find(seq);
+	if (i == m_history.end())
+		return Name("");
+	return i->name;
 }
 
 Time
@@ -410,17 +580,13 @@ RttEstimator::CalRTObyHistory(void)
 void
 RttEstimator::SetRetransmitbySeq(SequenceNumber32 seq)
 {
-	  RttHistory_t::iterator i;
-	  for (i = m_history.begin(); i != m_history.end(); ++i)
+	  RttHistory_t::iterator i = m_history.find(seq);
+	  if (i == m_history.end())
 	  {
-	    if (seq == i->seq)
-	    {
-	    	i->retx = true;
-	    	break;
-	    }
+	    NS_LOG_DEBUG("Seq " << seq << " is not in the history");
+	    return;
 	  }
-	  if (i == m_history.end())
-	    cout<<"ERROR!"<<endl;
+	  i->retx = true;
 }
 
 } // namespace ndn
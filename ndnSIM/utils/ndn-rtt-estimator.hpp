@@ -26,7 +26,9 @@
 #ifndef NDN_RTT_ESTIMATOR_H
 #define NDN_RTT_ESTIMATOR_H
 
-#include <deque>
+#include <functional>
+#include <list>
+#include <unordered_map>
 #include "ns3/sequence-number.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -59,6 +61,7 @@ public:
   Time rcvTime;        // receive Time
   Time rto;                // the rto value estimated before send, Yuwei
   bool retx;              // True if this has been retransmitted
+  int32_t hopCount;       // hops travelled by the Data (FwHopCountTag), -1 if unknown
   //Add the name of this interest
   //Yuwei
   Name name;   //name of this interest packet
@@ -78,7 +81,155 @@ public:
 };
 
 //==================================================================
-typedef std::deque<RttHistory> RttHistory_t;
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Container of RttHistory records indexed by sequence number
+ *
+ * Records are kept in a list ordered by their receive time (a record that has not been
+ * acknowledged yet uses its send time), so ageing can stop at the first record that is
+ * still fresh.  A hash index on the sequence number makes per-Interest lookups O(1)
+ * regardless of the history length.
+ *
+ * Sequence numbers are unique within the container.
+ */
+class RttHistoryContainer {
+public:
+  typedef std::list<RttHistory> List;
+  typedef List::iterator iterator;
+  typedef List::const_iterator const_iterator;
+
+  typedef std::function<void(const RttHistory&)> EraseCallback;
+
+  RttHistoryContainer();
+  RttHistoryContainer(const RttHistoryContainer& other);
+
+  /**
+   * \brief Copy the records
+   *
+   * The erase callback is not copied, it is bound to the owner of the container.
+   */
+  RttHistoryContainer&
+  operator=(const RttHistoryContainer& other);
+
+  /**
+   * \brief Set callback invoked for every record before it is removed from the container
+   */
+  void
+  setEraseCallback(const EraseCallback& callback)
+  {
+    m_onErase = callback;
+  }
+
+  iterator
+  begin()
+  {
+    return m_list.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_list.end();
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_list.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_list.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_list.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_list.empty();
+  }
+
+  RttHistory&
+  front()
+  {
+    return m_list.front();
+  }
+
+  /**
+   * \brief Append a record, replacing a previous record with the same sequence number
+   */
+  void
+  push_back(const RttHistory& h);
+
+  void
+  pop_front();
+
+  /**
+   * \brief Erase the record and return iterator to the next one
+   */
+  iterator
+  erase(iterator i);
+
+  /**
+   * \brief Erase the record with the sequence number, if any
+   * \return true if a record was erased
+   */
+  bool
+  erase(SequenceNumber32 seq);
+
+  /**
+   * \brief Find the record with the sequence number
+   * \return iterator to the record or end()
+   */
+  iterator
+  find(SequenceNumber32 seq);
+
+  const_iterator
+  find(SequenceNumber32 seq) const;
+
+  /**
+   * \brief Set receive time of the record and move it to the back of the list
+   *
+   * Receive times are non-decreasing, so the list remains sorted by receive time.
+   */
+  void
+  markReceived(iterator i, Time rcvTime);
+
+  void
+  clear();
+
+  /**
+   * \brief Get approximate number of bytes used by the records and the index
+   */
+  size_t
+  getMemoryUsage() const;
+
+private:
+  void
+  rebuildIndex();
+
+  void
+  notifyErase(const RttHistory& h)
+  {
+    if (m_onErase)
+      m_onErase(h);
+  }
+
+private:
+  List m_list;
+  std::unordered_map<uint32_t, iterator> m_index;
+  EraseCallback m_onErase;
+};
+
+typedef RttHistoryContainer RttHistory_t;
 typedef std::list<CorrelativityRcd> CoHistory_t;
 
 /**
@@ -128,6 +279,25 @@ public:
   AckSeq(Name name, SequenceNumber32 ackSeq);
   //AckSeq(SequenceNumber32 ackSeq);
 
+  /**
+   * \brief Note that a particular ack sequence has been received by Data from \p hopCount hops
+   *
+   * The hop count is kept with the record of the sequence number (see
+   * RttMeanDeviation HopStratified), then AckSeq(name, ackSeq) is called.
+   *
+   * \param hopCount hops travelled by the Data (FwHopCountTag), negative if unknown
+   */
+  virtual Time
+  AckSeq(Name name, SequenceNumber32 ackSeq, int32_t hopCount);
+
+  /**
+   * \brief Note RTT statistics piggybacked on Data for the name (see RttHintTag)
+   *
+   * The default implementation ignores the hint.
+   */
+  virtual void
+  AddRttHint(const Name& name, Time srtt, Time rttvar, uint32_t nSamples);
+
   /**
    * \brief Clear all history entries
    */
@@ -151,6 +321,31 @@ public:
   virtual Ptr<RttEstimator>
   Copy() const = 0;
 
+  /**
+   * \brief Get approximate number of bytes used by the estimator, including its history
+   */
+  virtual size_t
+  GetMemoryUsage() const;
+
+  /**
+   * \brief Save the estimate and the acknowledged history records for a checkpoint
+   *
+   * Records of Interests that are still in flight are not saved.
+   */
+  virtual void
+  SaveState(std::ostream& os) const;
+
+  /**
+   * \brief Replace the estimate and the history with the state saved by SaveState
+   *
+   * Restored records keep their age.  Their sequence numbers are remapped to the top of the
+   * sequence number space, so that Interests sent after the restore do not replace them.
+   *
+   * \throw std::runtime_error the state is truncated or malformed
+   */
+  virtual void
+  LoadState(std::istream& is);
+
   /**
    * \brief Increase the estimation multiplier up to MaxMultiplier.
    */
@@ -216,7 +411,11 @@ public:
   double
   GetTmpcorrelativity(Time curTime, Time rcvTime)const;
 
-  void
+  /**
+   * \brief Drop history records received more than \p min minutes ago
+   * \return number of dropped records
+   */
+  uint32_t
   UpateRttHistory(double min);
 
   Time
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-hint-table.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "daemon/table/pit-entry.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.RttHintTable");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RttHintTable);
+
+TypeId
+RttHintTable::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RttHintTable")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<RttHintTable>()
+      .AddAttribute("Gain", "Gain used in estimating the smoothed RTT, must be 0 < Gain < 1",
+                    DoubleValue(0.125), MakeDoubleAccessor(&RttHintTable::m_gain),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("Gain2", "Gain used in estimating the RTT deviation, must be 0 < Gain2 < 1",
+                    DoubleValue(0.25), MakeDoubleAccessor(&RttHintTable::m_gain2),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+      .AddAttribute("MaxAge", "Statistics not updated for that long are not piggybacked",
+                    TimeValue(Seconds(30)), MakeTimeAccessor(&RttHintTable::m_maxAge),
+                    MakeTimeChecker());
+  return tid;
+}
+
+RttHintTable::RttHintTable()
+  : m_gain(0.125)
+  , m_gain2(0.25)
+{
+}
+
+Ptr<RttHintTable>
+RttHintTable::Install(Ptr<Node> node)
+{
+  Ptr<RttHintTable> table = node->GetObject<RttHintTable>();
+  if (table != 0)
+    return table;
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3 != 0, "NDN stack should be installed on node " << node->GetId());
+
+  table = CreateObject<RttHintTable>();
+  node->AggregateObject(table);
+  l3->TraceConnectWithoutContext("SatisfiedInterests",
+                                 MakeCallback(&RttHintTable::SatisfiedInterests, table));
+  return table;
+}
+
+void
+RttHintTable::Install(const NodeContainer& c)
+{
+  for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+    Install(*i);
+  }
+}
+
+void
+RttHintTable::InstallAll()
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+void
+RttHintTable::Measurement(const Name& name, Time rtt)
+{
+  auto result = m_stats.insert(std::make_pair(RttHintTag::GetPrefix(name), Stats()));
+  Stats& stats = result.first->second;
+  if (result.second || Simulator::Now() - stats.lastUpdate > m_maxAge) {
+    // new or outdated statistics, start over (same as RttMeanDeviation::Measurement)
+    stats.srtt = rtt;
+    stats.rttvar = Seconds(rtt.ToDouble(Time::S) / 2);
+    stats.nSamples = 0;
+  }
+  else {
+    Time err = rtt - stats.srtt;
+    stats.srtt += Time::FromDouble(err.ToDouble(Time::S) * m_gain, Time::S);
+    stats.rttvar += Time::FromDouble((Abs(err) - stats.rttvar).ToDouble(Time::S) * m_gain2,
+                                     Time::S);
+  }
+  ++stats.nSamples;
+  stats.lastUpdate = Simulator::Now();
+}
+
+bool
+RttHintTable::GetHint(const Name& name, RttHintTag& hint) const
+{
+  auto entry = m_stats.find(RttHintTag::GetPrefix(name));
+  if (entry == m_stats.end() || Simulator::Now() - entry->second.lastUpdate > m_maxAge)
+    return false;
+
+  const Stats& stats = entry->second;
+  hint = RttHintTag(stats.srtt, stats.rttvar, stats.nSamples);
+  return true;
+}
+
+void
+RttHintTable::SatisfiedInterests(const nfd::pit::Entry& entry, const Face& inFace,
+                                 const Data& data)
+{
+  if (inFace.isLocal())
+    return; // Data of a local producer, RTT is not that of the network
+
+  // no out-record for content store hits
+  auto outRecord = entry.getOutRecord(inFace);
+  if (outRecord == entry.getOutRecords().end())
+    return;
+
+  time::nanoseconds rtt = time::steady_clock::now() - outRecord->getLastRenewed();
+  NS_LOG_DEBUG(data.getName() << " rtt=" << rtt);
+  Measurement(data.getName(), NanoSeconds(rtt.count()));
+}
+
+} // namespace ndn
+} // namespace ns3
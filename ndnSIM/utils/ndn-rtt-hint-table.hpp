@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_HINT_TABLE_H
+#define NDN_RTT_HINT_TABLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include "ndn-rtt-hint-tag.hpp"
+
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+#include <unordered_map>
+
+namespace nfd {
+namespace pit {
+class Entry;
+} // namespace pit
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Per-node RTT statistics of spatial prefixes, piggybacked on outgoing Data
+ *
+ * The table measures the RTT of every Interest the node forwarded to a non-local face, from
+ * the last transmission to the arrival of the Data, and keeps mean--deviation statistics (as
+ * in RttMeanDeviation) for the spatial prefix of the Data name (see RttHintTag::GetPrefix).
+ * NetDeviceFace attaches the statistics of the prefix as RttHintTag to every Data it sends,
+ * including Data from the content store and from local producers, so consumers downstream
+ * learn what RTT to expect before they have samples of their own.  The hint does not include
+ * the hop(s) between the hinting node and the consumer.
+ */
+class RttHintTable : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  RttHintTable();
+
+  /**
+   * @brief Aggregate hint table to the node (if not yet) and start measuring its RTTs
+   *
+   * The NDN stack must be installed on the node.
+   */
+  static Ptr<RttHintTable>
+  Install(Ptr<Node> node);
+
+  static void
+  Install(const NodeContainer& c);
+
+  static void
+  InstallAll();
+
+  /**
+   * @brief Add RTT sample of the name
+   */
+  void
+  Measurement(const Name& name, Time rtt);
+
+  /**
+   * @brief Get statistics of the name's prefix
+   * @return false if there are no statistics updated within MaxAge
+   */
+  bool
+  GetHint(const Name& name, RttHintTag& hint) const;
+
+  size_t
+  GetNPrefixes() const
+  {
+    return m_stats.size();
+  }
+
+private:
+  void
+  SatisfiedInterests(const nfd::pit::Entry& entry, const Face& inFace, const Data& data);
+
+private:
+  struct Stats {
+    Time srtt;
+    Time rttvar;
+    uint32_t nSamples;
+    Time lastUpdate;
+  };
+
+  double m_gain;
+  double m_gain2;
+  Time m_maxAge;
+  std::unordered_map<Name, Stats> m_stats; ///< RttHintTag::GetPrefix => statistics
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_HINT_TABLE_H
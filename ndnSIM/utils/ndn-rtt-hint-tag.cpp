@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rtt-hint-tag.hpp"
+
+#include <ndn-cxx/structured-name-view.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+TypeId
+RttHintTag::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RttHintTag").SetParent<Tag>().AddConstructor<RttHintTag>();
+  return tid;
+}
+
+TypeId
+RttHintTag::GetInstanceTypeId() const
+{
+  return RttHintTag::GetTypeId();
+}
+
+Name
+RttHintTag::GetPrefix(const Name& name)
+{
+  ::ndn::StructuredNameView view(name);
+  if (view.hasSpatialPart())
+    return name.getPrefix(view.spatialEnd() - name.begin());
+  else
+    return name.getPrefix(-1);
+}
+
+uint32_t
+RttHintTag::GetSerializedSize() const
+{
+  return 2 * sizeof(int64_t) + sizeof(uint32_t);
+}
+
+void
+RttHintTag::Serialize(TagBuffer i) const
+{
+  i.WriteU64(static_cast<uint64_t>(m_srtt.GetNanoSeconds()));
+  i.WriteU64(static_cast<uint64_t>(m_rttvar.GetNanoSeconds()));
+  i.WriteU32(m_nSamples);
+}
+
+void
+RttHintTag::Deserialize(TagBuffer i)
+{
+  m_srtt = NanoSeconds(static_cast<int64_t>(i.ReadU64()));
+  m_rttvar = NanoSeconds(static_cast<int64_t>(i.ReadU64()));
+  m_nSamples = i.ReadU32();
+}
+
+void
+RttHintTag::Print(std::ostream& os) const
+{
+  os << "srtt=" << m_srtt.ToDouble(Time::MS) << "ms rttvar=" << m_rttvar.ToDouble(Time::MS)
+     << "ms samples=" << m_nSamples;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RTT_HINT_TAG_H
+#define NDN_RTT_HINT_TAG_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/tag.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-fw
+ * @brief Packet tag piggybacking RTT statistics on Data
+ *
+ * The statistics are observed by the node that sent the Data for the spatial prefix of the
+ * Data name (see RttHintTable).  Every node that has its own statistics for the prefix
+ * replaces the hint of the upstream node.
+ */
+class RttHintTag : public Tag {
+public:
+  static TypeId
+  GetTypeId(void);
+
+  RttHintTag()
+    : m_nSamples(0)
+  {
+  }
+
+  RttHintTag(Time srtt, Time rttvar, uint32_t nSamples)
+    : m_srtt(srtt)
+    , m_rttvar(rttvar)
+    , m_nSamples(nSamples)
+  {
+  }
+
+  /**
+   * @brief Get the prefix the hint for the name describes
+   *
+   * That is the name up to the application marker for names with a spatial segment and the
+   * name without its last (sequence number) component otherwise.
+   */
+  static Name
+  GetPrefix(const Name& name);
+
+  /**
+   * @brief Get smoothed RTT
+   */
+  Time
+  GetSrtt() const
+  {
+    return m_srtt;
+  }
+
+  /**
+   * @brief Get RTT mean deviation
+   */
+  Time
+  GetRttvar() const
+  {
+    return m_rttvar;
+  }
+
+  /**
+   * @brief Get number of samples the statistics are made of
+   */
+  uint32_t
+  GetNSamples() const
+  {
+    return m_nSamples;
+  }
+
+  ////////////////////////////////////////////////////////
+  // from ObjectBase
+  ////////////////////////////////////////////////////////
+  virtual TypeId
+  GetInstanceTypeId() const;
+
+  ////////////////////////////////////////////////////////
+  // from Tag
+  ////////////////////////////////////////////////////////
+
+  virtual uint32_t
+  GetSerializedSize() const;
+
+  virtual void
+  Serialize(TagBuffer i) const;
+
+  virtual void
+  Deserialize(TagBuffer i);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  Time m_srtt;
+  Time m_rttvar;
+  uint32_t m_nSamples;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTT_HINT_TAG_H
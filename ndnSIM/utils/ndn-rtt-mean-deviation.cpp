@@ -26,10 +26,15 @@
 // George F. Riley.  Georgia Tech, Spring 2002
 
 #include "ndn-rtt-mean-deviation.hpp"
+#include "ndn-checkpoint-stream.hpp"
+#include "ndn-profiler-zones.hpp"
 #include "ns3/simulator.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/integer.h"
 #include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/log.h"
 
 NS_LOG_COMPONENT_DEFINE("ndn.RttMeanDeviation");
@@ -54,14 +59,42 @@ RttMeanDeviation::GetTypeId(void)
                     MakeDoubleChecker<double>())
       .AddAttribute("Gain2", "Gain2 used in estimating the RTT (variance), must be 0 < Gain2 < 1",
                     DoubleValue(0.25), MakeDoubleAccessor(&RttMeanDeviation::m_gain2),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>())
+      .AddAttribute("HistoryWindow",
+                    "Only samples received within this window are used to estimate RTO "
+                    "by correlativity",
+                    TimeValue(Minutes(3)), MakeTimeAccessor(&RttMeanDeviation::m_historyWindow),
+                    MakeTimeChecker())
+      .AddAttribute("AgeingGranularity",
+                    "Minimum interval between two passes dropping expired history records "
+                    "(0 ages the history on every RTO calculation)",
+                    TimeValue(Seconds(0)), MakeTimeAccessor(&RttMeanDeviation::m_ageingGranularity),
+                    MakeTimeChecker())
+      .AddAttribute("MaxHintSamples",
+                    "Maximum weight (in samples) of RTT hints piggybacked on Data, 0 ignores hints",
+                    UintegerValue(16), MakeUintegerAccessor(&RttMeanDeviation::m_maxHintSamples),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("HopStratified",
+                    "If true, RTO by correlativity uses only samples whose Data came from the "
+                    "hop distance predicted for the name from correlated samples",
+                    BooleanValue(false), MakeBooleanAccessor(&RttMeanDeviation::m_isHopStratified),
+                    MakeBooleanChecker())
+
+      .AddTraceSource("HistoryEvictions", "Total number of records aged out of the RTT history",
+                      MakeTraceSourceAccessor(&RttMeanDeviation::m_historyEvictions),
+                      "ns3::ndn::RttMeanDeviation::HistoryEvictionsTraceCallback");
   return tid;
 }
 
 RttMeanDeviation::RttMeanDeviation()
   : m_variance(0)
+  , m_knowledgeBaseId(0)
+  , m_historyEvictions(0)
+  , m_maxHintSamples(16)
+  , m_isHopStratified(false)
 {
   NS_LOG_FUNCTION(this);
+  InitCorrelativity();
 }
 
 RttMeanDeviation::RttMeanDeviation(const RttMeanDeviation& c)
@@ -69,8 +102,80 @@ RttMeanDeviation::RttMeanDeviation(const RttMeanDeviation& c)
   , m_gain(c.m_gain)
   , m_gain2(c.m_gain2)
   , m_variance(c.m_variance)
+  , m_knowledgeBaseId(0)
+  , m_historyWindow(c.m_historyWindow)
+  , m_ageingGranularity(c.m_ageingGranularity)
+  , m_nextAgeing(c.m_nextAgeing)
+  , m_historyEvictions(c.m_historyEvictions)
+  , m_hints(c.m_hints)
+  , m_maxHintSamples(c.m_maxHintSamples)
+  , m_isHopStratified(c.m_isHopStratified)
 {
   NS_LOG_FUNCTION(this);
+  InitCorrelativity();
+}
+
+RttMeanDeviation::~RttMeanDeviation()
+{
+  if (m_knowledgeBase != 0)
+    m_history.clear(); // withdraw the samples from the knowledge base
+}
+
+void
+RttMeanDeviation::InitCorrelativity()
+{
+  m_correlativity.Clear();
+  for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
+    AddCorrelativitySample(*i);
+  }
+
+  m_history.setEraseCallback([this] (const RttHistory& h) {
+      if (m_knowledgeBase != 0)
+        m_knowledgeBase->RemoveSample(m_knowledgeBaseId, h);
+      else
+        m_correlativity.RemoveSample(h);
+    });
+}
+
+void
+RttMeanDeviation::AddCorrelativitySample(const RttHistory& h)
+{
+  if (m_knowledgeBase != 0)
+    m_knowledgeBase->AddSample(m_knowledgeBaseId, h);
+  else
+    m_correlativity.AddSample(h);
+}
+
+void
+RttMeanDeviation::SetKnowledgeBase(Ptr<CorrelativityKnowledgeBase> knowledgeBase)
+{
+  if (knowledgeBase == m_knowledgeBase)
+    return;
+
+  if (m_knowledgeBase != 0) {
+    for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i) {
+      m_knowledgeBase->RemoveSample(m_knowledgeBaseId, *i);
+    }
+  }
+
+  m_knowledgeBase = knowledgeBase;
+  m_knowledgeBaseId = knowledgeBase != 0 ? knowledgeBase->RegisterEstimator() : 0;
+  InitCorrelativity();
+}
+
+void
+RttMeanDeviation::AgeHistory()
+{
+  Time now = Simulator::Now();
+  if (now < m_nextAgeing)
+    return;
+  m_nextAgeing = now + m_ageingGranularity;
+
+  uint32_t nEvicted = UpateRttHistory(m_historyWindow.ToDouble(Time::MIN));
+  if (nEvicted > 0) {
+    NS_LOG_DEBUG("Aged out " << nEvicted << " history records");
+    m_historyEvictions += nEvicted;
+  }
 }
 
 TypeId
@@ -132,9 +237,60 @@ RttMeanDeviation::Reset()
   NS_LOG_FUNCTION(this);
   // Reset to initial state
   m_variance = Seconds(0);
+  m_hints.clear();
   RttEstimator::Reset();
 }
 
+size_t
+RttMeanDeviation::GetMemoryUsage() const
+{
+  size_t n = RttEstimator::GetMemoryUsage() + sizeof(RttMeanDeviation) - sizeof(RttEstimator) +
+             m_correlativity.GetMemoryUsage() + m_hints.bucket_count() * sizeof(void*);
+  for (const auto& hint : m_hints) {
+    n += sizeof(hint) + 2 * sizeof(void*) + hint.first.size() * sizeof(name::Component);
+  }
+  return n;
+}
+
+void
+RttMeanDeviation::SaveState(std::ostream& os) const
+{
+  RttEstimator::SaveState(os);
+  checkpoint::write<int64_t>(os, m_variance.GetNanoSeconds());
+
+  checkpoint::write<uint32_t>(os, m_hints.size());
+  for (const auto& hint : m_hints) {
+    checkpoint::writeBlock(os, hint.first.wireEncode());
+    checkpoint::write<int64_t>(os, hint.second.srtt.GetNanoSeconds());
+    checkpoint::write<int64_t>(os, hint.second.rttvar.GetNanoSeconds());
+    checkpoint::write<uint32_t>(os, hint.second.nSamples);
+    checkpoint::writeTime(os, hint.second.rcvTime);
+  }
+}
+
+void
+RttMeanDeviation::LoadState(std::istream& is)
+{
+  NS_LOG_FUNCTION(this);
+  RttEstimator::LoadState(is);
+  m_variance = NanoSeconds(checkpoint::read<int64_t>(is));
+
+  m_hints.clear();
+  uint32_t nHints = checkpoint::read<uint32_t>(is);
+  for (uint32_t i = 0; i < nHints; ++i) {
+    Name prefix(checkpoint::readBlock(is));
+    RttHint& hint = m_hints[prefix];
+    hint.srtt = NanoSeconds(checkpoint::read<int64_t>(is));
+    hint.rttvar = NanoSeconds(checkpoint::read<int64_t>(is));
+    hint.nSamples = checkpoint::read<uint32_t>(is);
+    hint.rcvTime = checkpoint::readTime(is);
+  }
+
+  // restored records were added to the history without being counted as samples
+  InitCorrelativity();
+  m_nextAgeing = Simulator::Now();
+}
+
 void
 RttMeanDeviation::Gain(double g)
 {
@@ -150,17 +306,13 @@ RttMeanDeviation::SentSeq(SequenceNumber32 seq, uint32_t size)
   NS_LOG_FUNCTION(this << seq << size);
   //cout<<"RttMeanDeviation::SentSeq"<<endl;
 
-  RttHistory_t::iterator i;
-  for (i = m_history.begin(); i != m_history.end(); ++i) {
-    if (seq == i->seq) { // Found it
-      i->retx = true;
-      break;
-    }
+  RttHistory_t::iterator i = m_history.find(seq);
+  if (i != m_history.end()) { // Found it
+    i->retx = true;
   }
-
-  // Note that a particular sequence has been sent
-  if (i == m_history.end())
+  else { // Note that a particular sequence has been sent
     m_history.push_back(RttHistory(seq, size, Simulator::Now()));
+  }
 }
 
 //======================================================
@@ -171,38 +323,97 @@ RttMeanDeviation::SetInterestInfo(Name name, SequenceNumber32 seq, uint32_t size
 	NS_LOG_FUNCTION(this << seq << size);
 	//cout<<"RttEstimator=="<<name.toUri()<<endl;
 
-	RttHistory_t::iterator i;
-	for (i = m_history.begin(); i != m_history.end(); ++i)
-	{
-		if (seq == i->seq)
-	    { // Found it
-	      i->retx = true;
-	      i->rto = rto;
-	      break;
-	    }
+	RttHistory_t::iterator i = m_history.find(seq);
+	if (i != m_history.end())
+	{ // Found it
+	  i->retx = true;
+	  i->rto = rto;
+	}
+	else
+	{ // Note that a particular sequence has been sent
+	  m_history.push_back(RttHistory(seq, size, Simulator::Now(), rto, name));
 	}
-
-	// Note that a particular sequence has been sent
-	if (i == m_history.end())
-	    m_history.push_back(RttHistory(seq, size, Simulator::Now(), rto, name));
 }
 //----------------------------------------------------------------------------------------------------------------
 void
 RttMeanDeviation::DiscardInterestBySeq(SequenceNumber32 disSeq)
 {
-	for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i)
-	{
-		if (disSeq == i->seq)
-	    {
-			//cout<<"Discarding "<<disSeq<<"...."<<endl;
-			m_history.erase(i);             //rtt is nor calculated for retransmitted data
-			break;
-	    }
-	}
+	m_history.erase(disSeq);             //rtt is nor calculated for retransmitted data
 }
 //----------------------------------------------------------------------------------------------------------------
 Time
 RttMeanDeviation::CalRTObyCorrelativity(Name name)
+{
+  NDN_PROFILE_ZONE("RttMeanDeviation::CalRTObyCorrelativity");
+  double rtoValue = 0.0;
+  bool hasEstimate = false;
+
+  if (m_knowledgeBase != 0) {
+    // other estimators may have samples even if this one has none
+    AgeHistory();
+    hasEstimate = m_knowledgeBase->Estimate(name, Simulator::Now(), rtoValue, m_isHopStratified);
+  }
+  else if (m_history.size() != 0) {
+    AgeHistory();
+    hasEstimate = m_correlativity.Estimate(name, Simulator::Now(), rtoValue, m_isHopStratified);
+  }
+
+  double hintRto = 0.0;
+  uint32_t hintWeight = GetHintRto(name, hintRto);
+  if (hintWeight > 0) {
+    double w = hasEstimate ? static_cast<double>(hintWeight) / (hintWeight + m_nSamples) : 1.0;
+    rtoValue = w * hintRto + (1 - w) * rtoValue;
+  }
+  else if (!hasEstimate) {
+    rtoValue = GetInitialEstimatedRtt().ToDouble(Time::S);
+  }
+
+  double retval = std::min(m_maxRto.ToDouble(Time::S),
+                           std::max(m_minRto.ToDouble(Time::S), rtoValue));
+  return Seconds(retval);
+}
+
+void
+RttMeanDeviation::AddRttHint(const Name& name, Time srtt, Time rttvar, uint32_t nSamples)
+{
+  NS_LOG_FUNCTION(this << name << srtt << rttvar << nSamples);
+  if (m_maxHintSamples == 0 || nSamples == 0)
+    return;
+
+  RttHint& hint = m_hints[RttHintTag::GetPrefix(name)];
+  hint.srtt = srtt;
+  hint.rttvar = rttvar;
+  hint.nSamples = std::min(nSamples, m_maxHintSamples);
+  hint.rcvTime = Simulator::Now();
+
+  if (m_nSamples == 0) {
+    // the hint takes the place of the first sample, so the first measurement refines it
+    m_currentEstimatedRtt = srtt;
+    m_variance = rttvar;
+    m_nSamples = 1;
+  }
+}
+
+uint32_t
+RttMeanDeviation::GetHintRto(const Name& name, double& rto)
+{
+  if (m_hints.empty())
+    return 0;
+
+  auto entry = m_hints.find(RttHintTag::GetPrefix(name));
+  if (entry == m_hints.end())
+    return 0;
+  if (Simulator::Now() - entry->second.rcvTime > m_historyWindow) {
+    m_hints.erase(entry);
+    return 0;
+  }
+
+  rto = entry->second.srtt.ToDouble(Time::S) + 4 * entry->second.rttvar.ToDouble(Time::S);
+  return entry->second.nSamples;
+}
+//----------------------------------------------------------------------------------------------------------------
+Time
+RttMeanDeviation::CalRTObyCorrelativityFullScan(Name name)
 {
 	//SiYan Yao
 	CoHistory_t coList;
@@ -219,14 +430,14 @@ RttMeanDeviation::CalRTObyCorrelativity(Name name)
 	}
 	else
 	{
-		//Update with 3 minutes
-		UpateRttHistory(3.0);
+		//Update with HistoryWindow
+		AgeHistory();
 		for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i)
 		{
 			if(i->rcvTime > i->time)
 			{
 				timeDiff = Simulator::Now() - i->rcvTime;
-				if(timeDiff.ToDouble(Time::MIN)<=3)  //3 minutes
+				if(timeDiff<=m_historyWindow)
 				{
 					//cout<<"Have received..."<<i->name;
 					sc=name.getAppcorrelativityWith(i->name);
@@ -298,46 +509,34 @@ RttMeanDeviation::AckSeq(Name name, SequenceNumber32 ackSeq)
   NS_LOG_FUNCTION(this << ackSeq);
   //cout<<"I'm in AckSeq!!!!"<<endl;
   // An ack has been received, calculate rtt and log this measurement
-  // Note we use a linear search (O(n)) for this since for the common
-  // case the ack'ed packet will be at the head of the list
   Time m = Seconds(0.0);
   if (m_history.size() == 0)
     return (m); // No pending history, just exit
 
-  for (RttHistory_t::iterator i = m_history.begin(); i != m_history.end(); ++i)
+  RttHistory_t::iterator i = m_history.find(ackSeq);
+  if (i == m_history.end())
+    return m;
+
+  //------------------------------------------------
+  if (name != i->name) {
+    NS_LOG_WARN("Name mismatch for seq " << ackSeq << ": acked " << name << ", sent " << i->name);
+  }
+  // Found it
+  if (!i->retx)
   {
-    if (ackSeq == i->seq)
-    {
-      //------------------------------------------------
-      if(name != i->name)
-      {
-    	cout<<"NAME DISMATCH ERROR"<<endl;
-    	cout<<name<<endl;
-    	cout<<i->name<<endl;
-    	cout<<"----------------------------------------------------------------------------"<<endl;
-      }
-      // Found it
-      if (!i->retx)
-      {
-    	i->rcvTime = Simulator::Now();
-    	//---------------------------------------------------------------------------------------------
-        m = i->rcvTime - i->time; // Elapsed time
-        //cout<<i->time<<endl;
-        //cout<<i->rcvTime<<endl;
-        //cout<<m.ToDouble(Time::MS)<<endl;
-        //cout<<"-----------------------------------"<<endl;
-        //---------------------------------------------------------------------------------------------
-        Measurement(m);                      // Log the measurement
-        ResetMultiplier();              // Reset multiplier on valid measurement
-      }
-      else
-      {
-    	  cout<<"Seq="<<i->seq<<" was retransmitted !!!"<<endl;
-    	  //retransmit packet will not longer record
-    	  m_history.erase(i);
-      }
-      break;
-    }
+    m_history.markReceived(i, Simulator::Now()); // keeps history in receive-time order
+    AddCorrelativitySample(*i);
+    //---------------------------------------------------------------------------------------------
+    m = i->rcvTime - i->time; // Elapsed time
+    //---------------------------------------------------------------------------------------------
+    Measurement(m);                      // Log the measurement
+    ResetMultiplier();              // Reset multiplier on valid measurement
+  }
+  else
+  {
+    NS_LOG_DEBUG("Seq " << i->seq << " was retransmitted, no RTT sample");
+    //retransmit packet will not longer record
+    m_history.erase(i);
   }
   return m;
 }
@@ -390,7 +589,7 @@ RttMeanDeviation::AckInterest(SequenceNumber32 ackSeq)
 	      break;
 	    }
 	  }*/
-	 cout<<"I'm in AckInterest!"<<endl;
+	 NS_LOG_FUNCTION(this << ackSeq);
 	 Time m = Seconds(0.0);
 	 return m;
 }
@@ -29,6 +29,11 @@
 #define NDN_RTT_MEAN_DEVIATION_H
 
 #include "ndn-rtt-estimator.hpp"
+#include "ndn-rtt-correlativity.hpp"
+#include "ndn-correlativity-knowledge-base.hpp"
+#include "ndn-rtt-hint-tag.hpp"
+
+#include "ns3/traced-value.h"
 
 namespace ns3 {
 namespace ndn {
@@ -51,6 +56,7 @@ public:
 
   RttMeanDeviation();
   RttMeanDeviation(const RttMeanDeviation&);
+  virtual ~RttMeanDeviation();
 
   virtual TypeId
   GetInstanceTypeId(void) const;
@@ -66,9 +72,40 @@ public:
   void
   DiscardInterestBySeq(SequenceNumber32 disSeq);
 
+  /**
+   * \brief Calculate RTO for the first transmission of the Interest from RTT samples of
+   *        correlated names (see RttCorrelativityEngine)
+   *
+   * With HopStratified, only samples from the hop distance predicted for the name are used,
+   * so that RTTs of nearby cache hits do not shorten the RTO of names served from afar,
+   * and the other way around.
+   */
   Time
   CalRTObyCorrelativity(Name name);
 
+  /**
+   * \brief Reference implementation of CalRTObyCorrelativity that scans the whole history
+   */
+  Time
+  CalRTObyCorrelativityFullScan(Name name);
+
+  /**
+   * \brief Share correlativity samples with other estimators through the knowledge base
+   *
+   * Samples of the history are moved to the knowledge base and CalRTObyCorrelativity uses the
+   * samples of all estimators attached to it.  The estimator keeps ageing its own samples, so
+   * samples of an estimator that no longer calculates RTO stay until it is reset or destroyed.
+   * Copies of the estimator do not share the knowledge base.
+   */
+  void
+  SetKnowledgeBase(Ptr<CorrelativityKnowledgeBase> knowledgeBase);
+
+  Ptr<CorrelativityKnowledgeBase>
+  GetKnowledgeBase() const
+  {
+    return m_knowledgeBase;
+  }
+
   //Time
   //GetRtobySeq(SequenceNumber32 seq);
 
@@ -77,10 +114,23 @@ public:
   AckInterest(SequenceNumber32 ackSeq);
   //=====================================================
 
+  using RttEstimator::AckSeq;
+
   Time
   AckSeq(Name name, SequenceNumber32 ackSeq);
   //AckSeq(SequenceNumber32 ackSeq);
 
+  /**
+   * \brief Seed the estimates from RTT statistics of the name's spatial prefix
+   *
+   * Before the first measurement, the hint is used as the first sample.  RTO by correlativity
+   * of names with the same prefix returns a mix of srtt + 4 * rttvar of the hint and the
+   * correlativity estimate, where the hint weights min(nSamples, MaxHintSamples) against the
+   * number of own samples.  Hints older than HistoryWindow are ignored.
+   */
+  virtual void
+  AddRttHint(const Name& name, Time srtt, Time rttvar, uint32_t nSamples);
+
   void
   Measurement(Time measure);
   Time
@@ -92,10 +142,80 @@ public:
   void
   Gain(double g);
 
+  /**
+   * \brief Get approximate number of bytes used by the estimator
+   *
+   * A knowledge base shared with other estimators is not included.
+   */
+  size_t
+  GetMemoryUsage() const;
+
+  /**
+   * \brief Save the estimates, the acknowledged history records and the hints
+   */
+  virtual void
+  SaveState(std::ostream& os) const;
+
+  /**
+   * \brief Restore the state saved by SaveState
+   *
+   * Restored records are added to the knowledge base, if the estimator shares one.
+   */
+  virtual void
+  LoadState(std::istream& is);
+
+  typedef void (*HistoryEvictionsTraceCallback)(uint32_t, uint32_t);
+
+private:
+  /**
+   * \brief Add samples of the history to the own engine or to the knowledge base
+   */
+  void
+  InitCorrelativity();
+
+  void
+  AddCorrelativitySample(const RttHistory& h);
+
+  /**
+   * \brief Get RTO (seconds) of the latest hint for the name's prefix
+   * \return weight of the hint, 0 if there is no valid hint
+   */
+  uint32_t
+  GetHintRto(const Name& name, double& rto);
+
+  /**
+   * \brief Drop history records that fell out of HistoryWindow
+   *
+   * The history is kept in receive-time order, so ageing only visits the expired head.  The
+   * check itself runs at most once per AgeingGranularity.
+   */
+  void
+  AgeHistory();
+
 private:
   double m_gain;   // Filter gain
   double m_gain2;  // Filter gain
   Time m_variance; // Current variance
+
+  RttCorrelativityEngine m_correlativity; // running sums of acknowledged samples
+  Ptr<CorrelativityKnowledgeBase> m_knowledgeBase; // replaces m_correlativity, if set
+  uint32_t m_knowledgeBaseId;                      // owner of the samples in m_knowledgeBase
+
+  Time m_historyWindow;      // samples older than that do not contribute to correlativity RTO
+  Time m_ageingGranularity;  // minimum interval between two ageing passes
+  Time m_nextAgeing;         // earliest time of the next ageing pass
+  TracedValue<uint32_t> m_historyEvictions; // total number of records aged out of the history
+
+  struct RttHint {
+    Time srtt;
+    Time rttvar;
+    uint32_t nSamples;
+    Time rcvTime;
+  };
+  std::unordered_map<Name, RttHint> m_hints; // RttHintTag::GetPrefix => latest hint
+  uint32_t m_maxHintSamples;                 // upper bound of the weight of a hint
+
+  bool m_isHopStratified; // RTO by correlativity from samples of the predicted hop distance
 };
 
 } // namespace ndn
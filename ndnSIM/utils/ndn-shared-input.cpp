@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-shared-input.hpp"
+
+#include "ns3/log.h"
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SharedInput");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct State
+{
+  std::string directory;
+  // not owning, the mapping goes away with the last user
+  std::map<std::string, std::weak_ptr<const SharedInput>> inputs;
+  std::mutex mutex; ///< of inputs, opened from the threads of a multithreaded simulator
+  std::atomic<uint64_t> nTemporaries{0};
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+std::runtime_error
+makeError(const std::string& what, const std::string& file)
+{
+  return std::runtime_error(what + " " + file + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+SharedInput::SharedInput(const std::string& file)
+  : m_file(file)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_device(0)
+  , m_inode(0)
+{
+  int fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw makeError("Cannot open", file);
+  }
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0) {
+    std::runtime_error error = makeError("Cannot stat", file);
+    ::close(fd);
+    throw error;
+  }
+  m_size = status.st_size;
+  m_device = status.st_dev;
+  m_inode = status.st_ino;
+
+  // an empty file cannot be mapped, and has nothing to map anyway
+  if (m_size > 0) {
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      std::runtime_error error = makeError("Cannot map", file);
+      ::close(fd);
+      throw error;
+    }
+    m_data = static_cast<const uint8_t*>(data);
+  }
+  // the mapping stays valid without the descriptor
+  ::close(fd);
+
+  NS_LOG_DEBUG("Mapped " << file << ", " << m_size << " bytes");
+}
+
+SharedInput::~SharedInput()
+{
+  if (m_data != nullptr) {
+    ::munmap(const_cast<uint8_t*>(m_data), m_size);
+  }
+}
+
+std::shared_ptr<const SharedInput>
+SharedInput::Open(const std::string& file)
+{
+  std::lock_guard<std::mutex> lock(getState().mutex);
+  std::weak_ptr<const SharedInput>& existing = getState().inputs[file];
+  std::shared_ptr<const SharedInput> input = existing.lock();
+
+  struct stat status;
+  if (input != nullptr && (::stat(file.c_str(), &status) != 0 ||
+                           static_cast<uint64_t>(status.st_dev) != input->m_device ||
+                           static_cast<uint64_t>(status.st_ino) != input->m_inode)) {
+    input.reset();
+  }
+
+  if (input == nullptr) {
+    input.reset(new SharedInput(file));
+    existing = input;
+  }
+  return input;
+}
+
+void
+SharedInput::SetDirectory(const std::string& directory)
+{
+  if (!directory.empty()) {
+    try {
+      boost::filesystem::create_directories(directory);
+    }
+    catch (const boost::filesystem::filesystem_error& e) {
+      throw std::runtime_error("Directory " + directory + " cannot be created: " + e.what());
+    }
+  }
+  getState().directory = directory;
+}
+
+const std::string&
+SharedInput::GetDirectory()
+{
+  return getState().directory;
+}
+
+std::shared_ptr<const SharedInput>
+SharedInput::GetOrCreate(const std::string& name, const std::function<void(std::ostream&)>& write)
+{
+  if (!IsEnabled())
+    return nullptr;
+
+  std::string file = (boost::filesystem::path(GetDirectory()) / name).string();
+  if (::access(file.c_str(), F_OK) != 0) {
+    // another replication or thread may be writing the same input, each writes its own
+    // temporary file
+    std::string temporary = file + ".tmp." + std::to_string(::getpid()) + "." +
+                            std::to_string(getState().nTemporaries++);
+    {
+      std::ofstream os(temporary.c_str(), std::ios_base::out | std::ios_base::trunc |
+                                          std::ios_base::binary);
+      if (!os.is_open()) {
+        throw std::runtime_error("File " + temporary + " cannot be opened for writing");
+      }
+      write(os);
+      os.flush();
+      if (!os) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("File " + temporary + " cannot be written");
+      }
+    }
+    if (std::rename(temporary.c_str(), file.c_str()) != 0) {
+      std::remove(temporary.c_str());
+      throw makeError("Cannot rename to", file);
+    }
+    NS_LOG_INFO("Created " << file);
+  }
+
+  return Open(file);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_SHARED_INPUT_HPP
+#define NDNSIM_UTILS_NDN_SHARED_INPUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Immutable simulation input, mapped read-only into memory
+ *
+ * Replications of the same scenario run in parallel processes read the same preprocessed
+ * inputs (converted mobility traces, popularity tables, ...).  Mapping the files instead of
+ * reading them lets all the processes share the same physical pages of the page cache, and a
+ * file is mapped only once per process however many times it is opened.
+ *
+ * Inputs computed by the simulation itself are written once into the directory set with
+ * SetDirectory (e.g., on /dev/shm) by GetOrCreate, and mapped by every later replication:
+ *
+ *     ndn::SharedInput::SetDirectory("/dev/shm/scene1");
+ *     ...
+ *     // in all replications, only the first one computes the table
+ *     auto input = ndn::SharedInput::GetOrCreate("table-1000", [] (std::ostream& os) { ... });
+ *
+ * The files are never modified once written: they are written to a temporary file and renamed,
+ * so processes racing to create the same input all map a complete file.
+ */
+class SharedInput
+{
+public:
+  /**
+   * @brief Map a file read-only, or get the existing mapping of the file in this process
+   *
+   * A file replaced since it was mapped (i.e., renamed over, not modified in place) is mapped
+   * again, users of the previous mapping keep the previous content.
+   *
+   * @throw std::runtime_error the file cannot be opened or mapped
+   */
+  static std::shared_ptr<const SharedInput>
+  Open(const std::string& file);
+
+  /**
+   * @brief Set the directory of the inputs created by GetOrCreate, created if needed
+   *
+   * An empty directory (the default) disables GetOrCreate.
+   */
+  static void
+  SetDirectory(const std::string& directory);
+
+  static const std::string&
+  GetDirectory();
+
+  static bool
+  IsEnabled()
+  {
+    return !GetDirectory().empty();
+  }
+
+  /**
+   * @brief Map the input @p name of the directory, written by @p write if it does not exist yet
+   * @param name file name in the directory, the same for identical inputs
+   * @return the input, or nullptr if no directory is set
+   * @throw std::runtime_error the input cannot be written or mapped
+   */
+  static std::shared_ptr<const SharedInput>
+  GetOrCreate(const std::string& name, const std::function<void(std::ostream&)>& write);
+
+  SharedInput(const SharedInput&) = delete;
+
+  SharedInput&
+  operator=(const SharedInput&) = delete;
+
+  ~SharedInput();
+
+  const std::string&
+  GetFile() const
+  {
+    return m_file;
+  }
+
+  /**
+   * @brief Beginning of the mapped file, aligned to a page
+   */
+  const uint8_t*
+  GetData() const
+  {
+    return m_data;
+  }
+
+  size_t
+  GetSize() const
+  {
+    return m_size;
+  }
+
+private:
+  SharedInput(const std::string& file);
+
+private:
+  std::string m_file;
+  const uint8_t* m_data;
+  size_t m_size;
+  uint64_t m_device;
+  uint64_t m_inode;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_SHARED_INPUT_HPP
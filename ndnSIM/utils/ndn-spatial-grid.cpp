@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-spatial-grid.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SpatialGrid");
+
+namespace ns3 {
+namespace ndn {
+
+SpatialGrid::SpatialGrid(double cellSize)
+  : m_cellSize(cellSize)
+  , m_nCellChanges(0)
+{
+  if (!(cellSize > 0.0)) {
+    throw std::invalid_argument("Cell size of SpatialGrid must be positive");
+  }
+}
+
+SpatialGrid::~SpatialGrid()
+{
+  for (auto& i : m_nodes) {
+    Simulator::Cancel(i.second.crossEvent);
+    i.second.mobility->TraceDisconnectWithoutContext("CourseChange",
+                                                     MakeCallback(&SpatialGrid::OnCourseChange,
+                                                                  this));
+  }
+}
+
+void
+SpatialGrid::Add(Ptr<Node> node)
+{
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+  if (mobility == 0) {
+    throw std::invalid_argument("Node " + std::to_string(node->GetId()) +
+                                " has no MobilityModel");
+  }
+
+  auto inserted = m_nodes.emplace(node->GetId(), Record());
+  if (!inserted.second)
+    return;
+
+  Record& record = inserted.first->second;
+  record.node = node;
+  record.mobility = mobility;
+  record.cell = GetCellKey(GetCellIndex(mobility->GetPosition().x),
+                           GetCellIndex(mobility->GetPosition().y));
+  m_cells[record.cell].insert(node->GetId());
+
+  mobility->TraceConnectWithoutContext("CourseChange",
+                                       MakeCallback(&SpatialGrid::OnCourseChange, this));
+  Update(node->GetId());
+}
+
+void
+SpatialGrid::Install(const NodeContainer& nodes)
+{
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Add(*node);
+  }
+}
+
+void
+SpatialGrid::InstallAll()
+{
+  Install(NodeContainer::GetGlobal());
+}
+
+int64_t
+SpatialGrid::GetCellIndex(double coordinate) const
+{
+  return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+}
+
+SpatialGrid::CellKey
+SpatialGrid::GetCellKey(int64_t x, int64_t y)
+{
+  return (static_cast<CellKey>(x) << 32) ^ static_cast<uint32_t>(y);
+}
+
+void
+SpatialGrid::OnCourseChange(Ptr<const MobilityModel> mobility)
+{
+  Ptr<Node> node = mobility->GetObject<Node>();
+  if (node != 0)
+    Update(node->GetId());
+}
+
+void
+SpatialGrid::Update(uint32_t nodeId)
+{
+  auto it = m_nodes.find(nodeId);
+  if (it == m_nodes.end())
+    return;
+  Record& record = it->second;
+
+  Simulator::Cancel(record.crossEvent);
+
+  Vector position = record.mobility->GetPosition();
+  CellKey cell = GetCellKey(GetCellIndex(position.x), GetCellIndex(position.y));
+  if (cell != record.cell) {
+    m_cells[record.cell].erase(nodeId);
+    if (m_cells[record.cell].empty())
+      m_cells.erase(record.cell);
+    m_cells[cell].insert(nodeId);
+    record.cell = cell;
+    ++m_nCellChanges;
+    NS_LOG_DEBUG("Node " << nodeId << " moved to cell " << GetCellIndex(position.x)
+                 << "," << GetCellIndex(position.y));
+  }
+
+  double timeToBorder = GetTimeToCellBorder(position, record.mobility->GetVelocity());
+  if (timeToBorder >= 0) {
+    // slightly after the crossing, so the position is in the next cell
+    Time delay = Seconds(timeToBorder) + NanoSeconds(1);
+    record.crossEvent = Simulator::Schedule(delay, &SpatialGrid::Update, this, nodeId);
+  }
+}
+
+double
+SpatialGrid::GetTimeToCellBorder(const Vector& position, const Vector& velocity) const
+{
+  double time = std::numeric_limits<double>::infinity();
+  double coordinates[] = {position.x, position.y};
+  double speeds[] = {velocity.x, velocity.y};
+  for (int i = 0; i < 2; ++i) {
+    if (speeds[i] == 0.0)
+      continue;
+
+    double begin = GetCellIndex(coordinates[i]) * m_cellSize;
+    double border = speeds[i] > 0 ? begin + m_cellSize : begin;
+    time = std::min(time, std::max(0.0, (border - coordinates[i]) / speeds[i]));
+  }
+  return std::isinf(time) ? -1.0 : time;
+}
+
+std::vector<Ptr<Node>>
+SpatialGrid::GetNodesInRange(const Vector& position, double range) const
+{
+  std::vector<Ptr<Node>> nodes;
+  int64_t xBegin = GetCellIndex(position.x - range), xEnd = GetCellIndex(position.x + range);
+  int64_t yBegin = GetCellIndex(position.y - range), yEnd = GetCellIndex(position.y + range);
+  for (int64_t x = xBegin; x <= xEnd; ++x) {
+    for (int64_t y = yBegin; y <= yEnd; ++y) {
+      auto cell = m_cells.find(GetCellKey(x, y));
+      if (cell == m_cells.end())
+        continue;
+
+      for (uint32_t nodeId : cell->second) {
+        const Record& record = m_nodes.find(nodeId)->second;
+        if (CalculateDistance(record.mobility->GetPosition(), position) <= range)
+          nodes.push_back(record.node);
+      }
+    }
+  }
+  return nodes;
+}
+
+std::vector<Ptr<Node>>
+SpatialGrid::GetNeighbors(Ptr<Node> node, double range) const
+{
+  auto it = m_nodes.find(node->GetId());
+  if (it == m_nodes.end())
+    return {};
+
+  std::vector<Ptr<Node>> nodes = GetNodesInRange(it->second.mobility->GetPosition(), range);
+  nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+  return nodes;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_SPATIAL_GRID_H
+#define NDN_SPATIAL_GRID_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-model.h"
+#include "ns3/event-id.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Uniform grid index of node positions
+ *
+ * Nodes are kept in square cells of the XY plane, so that the nodes within a range of a
+ * position are found by checking the cells overlapping the range only, instead of all nodes
+ * of the simulation.
+ *
+ * The cell of a node is updated on course changes of its MobilityModel and, for a moving node,
+ * when it crosses the border of its cell, so lookups stay exact between course changes (e.g.,
+ * between the setdest waypoints of Ns2MobilityHelper traces).  The cost is one event per cell
+ * crossing, larger cells mean fewer events but more nodes checked per lookup.  A cell size
+ * close to the radio range is a good start.
+ */
+class SpatialGrid : noncopyable {
+public:
+  explicit
+  SpatialGrid(double cellSize);
+
+  ~SpatialGrid();
+
+  /**
+   * @brief Add the node to the index
+   * @throw std::invalid_argument the node has no MobilityModel
+   */
+  void
+  Add(Ptr<Node> node);
+
+  /**
+   * @brief Add all nodes of the container to the index
+   */
+  void
+  Install(const NodeContainer& nodes);
+
+  /**
+   * @brief Add all nodes of the simulation to the index
+   */
+  void
+  InstallAll();
+
+  /**
+   * @brief Nodes at \p range meters or closer to \p position
+   */
+  std::vector<Ptr<Node>>
+  GetNodesInRange(const Vector& position, double range) const;
+
+  /**
+   * @brief Other nodes at \p range meters or closer to the node
+   */
+  std::vector<Ptr<Node>>
+  GetNeighbors(Ptr<Node> node, double range) const;
+
+  double
+  GetCellSize() const
+  {
+    return m_cellSize;
+  }
+
+  size_t
+  GetNNodes() const
+  {
+    return m_nodes.size();
+  }
+
+  /**
+   * @brief Number of cell changes of nodes so far
+   */
+  uint64_t
+  GetNCellChanges() const
+  {
+    return m_nCellChanges;
+  }
+
+private:
+  typedef uint64_t CellKey;
+
+  struct Record {
+    Ptr<Node> node;
+    Ptr<MobilityModel> mobility;
+    CellKey cell;
+    EventId crossEvent; ///< when the node leaves its cell
+  };
+
+  int64_t
+  GetCellIndex(double coordinate) const;
+
+  static CellKey
+  GetCellKey(int64_t x, int64_t y);
+
+  void
+  OnCourseChange(Ptr<const MobilityModel> mobility);
+
+  void
+  Update(uint32_t nodeId);
+
+  /**
+   * @brief Time until a node at \p position moving with \p velocity leaves its cell
+   * @return negative if it does not move in the XY plane
+   */
+  double
+  GetTimeToCellBorder(const Vector& position, const Vector& velocity) const;
+
+private:
+  double m_cellSize;
+  std::unordered_map<uint32_t, Record> m_nodes;                  ///< by node id
+  std::unordered_map<CellKey, std::unordered_set<uint32_t>> m_cells; ///< node ids by cell
+  uint64_t m_nCellChanges;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_SPATIAL_GRID_H
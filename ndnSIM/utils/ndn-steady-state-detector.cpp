@@ -0,0 +1,468 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-steady-state-detector.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+
+#include "apps/ndn-app.hpp"
+
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SteadyStateDetector");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+struct State
+{
+  bool isEnabled = false;
+  Time batchDuration;
+  double relativeWidth = 0.05;
+  double confidence = 0.95;
+  uint32_t minBatches = 10;
+  bool shouldStop = true;
+  std::function<void()> warmedUpCallback;
+  std::function<void()> convergedCallback;
+
+  bool isConnected = false;
+  EventId connectEvent;
+  EventId batchEvent;
+  EventId destroyEvent;
+
+  // current batch
+  Time batchStart;
+  double sumDelays = 0;
+  uint64_t nDelays = 0;
+  uint64_t nSatisfied = 0;
+  uint64_t nGivenUp = 0;
+
+  // batches with delays
+  std::vector<Time> batchStarts;
+  std::vector<double> delays;
+  std::vector<double> satisfactions;
+
+  bool isWarmedUp = false;
+  size_t truncation = 0;
+  bool hasConverged = false;
+  Time convergedAt;
+};
+
+State&
+getState()
+{
+  static State state;
+  return state;
+}
+
+void
+onFirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
+                         int32_t hopCount)
+{
+  SteadyStateDetector::RecordDelay(delay);
+}
+
+void
+onDataReceived(Ptr<App> app, const Name& name, uint32_t seqno)
+{
+  SteadyStateDetector::RecordSatisfied();
+}
+
+void
+onInterestGivenUp(Ptr<App> app, uint32_t seqno)
+{
+  SteadyStateDetector::RecordGivenUp();
+}
+
+void
+connect()
+{
+  State& state = getState();
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/FirstInterestDataDelay",
+                                MakeCallback(&onFirstInterestDataDelay));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/DataReceived",
+                                MakeCallback(&onDataReceived));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/InterestGivenUp",
+                                MakeCallback(&onInterestGivenUp));
+  state.isConnected = true;
+}
+
+void
+disconnect()
+{
+  State& state = getState();
+  if (!state.isConnected)
+    return;
+
+  Config::DisconnectWithoutContext("/NodeList/*/ApplicationList/*/FirstInterestDataDelay",
+                                   MakeCallback(&onFirstInterestDataDelay));
+  Config::DisconnectWithoutContext("/NodeList/*/ApplicationList/*/DataReceived",
+                                   MakeCallback(&onDataReceived));
+  Config::DisconnectWithoutContext("/NodeList/*/ApplicationList/*/InterestGivenUp",
+                                   MakeCallback(&onInterestGivenUp));
+  state.isConnected = false;
+}
+
+/**
+ * @brief Forget the events and connections of the destroyed simulation, keeping the results
+ */
+void
+forgetSimulation()
+{
+  State& state = getState();
+  state.connectEvent = EventId();
+  state.batchEvent = EventId();
+  state.destroyEvent = EventId();
+  state.isConnected = false;
+}
+
+/**
+ * @brief Two-sided quantile of Student's t distribution
+ */
+double
+getTQuantile(double confidence, size_t df)
+{
+  static const double t90[] = {6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833,
+                               1.812, 1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734,
+                               1.729, 1.725, 1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703,
+                               1.701, 1.699, 1.697};
+  static const double t95[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                               2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+                               2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+                               2.048, 2.045, 2.042};
+  static const double t99[] = {63.657, 9.925, 5.841, 4.604, 4.032, 3.707, 3.499, 3.355, 3.250,
+                               3.169, 3.106, 3.055, 3.012, 2.977, 2.947, 2.921, 2.898, 2.878,
+                               2.861, 2.845, 2.831, 2.819, 2.807, 2.797, 2.787, 2.779, 2.771,
+                               2.763, 2.756, 2.750};
+
+  const double* table = confidence >= 0.99 ? t99 : confidence >= 0.95 ? t95 : t90;
+  double normal = confidence >= 0.99 ? 2.576 : confidence >= 0.95 ? 1.960 : 1.645;
+  if (df == 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return df <= 30 ? table[df - 1] : normal;
+}
+
+void
+evaluate()
+{
+  State& state = getState();
+  size_t nBatches = state.delays.size();
+
+  if (!state.isWarmedUp && nBatches >= state.minBatches) {
+    size_t truncation = SteadyStateDetector::FindTruncation(state.delays);
+    if (truncation <= nBatches / 2 && nBatches - truncation >= state.minBatches) {
+      state.isWarmedUp = true;
+      state.truncation = truncation;
+      NS_LOG_INFO("Warm-up ended at " << state.batchStarts[truncation].ToDouble(Time::S)
+                  << " s, " << truncation << " batches truncated");
+      if (state.warmedUpCallback) {
+        state.warmedUpCallback();
+      }
+    }
+  }
+
+  if (!state.isWarmedUp) {
+    return;
+  }
+
+  SteadyStateDetector::Estimate delay = SteadyStateDetector::GetDelay();
+  SteadyStateDetector::Estimate satisfaction = SteadyStateDetector::GetSatisfaction();
+  if (delay.nBatches >= state.minBatches && delay.IsPrecise(state.relativeWidth) &&
+      satisfaction.IsPrecise(state.relativeWidth)) {
+    state.hasConverged = true;
+    state.convergedAt = Simulator::Now();
+    NS_LOG_INFO("Converged at " << state.convergedAt.ToDouble(Time::S) << " s, delay "
+                << delay.mean << " ± " << delay.halfWidth << " s, satisfaction "
+                << satisfaction.mean << " ± " << satisfaction.halfWidth);
+    if (state.convergedCallback) {
+      state.convergedCallback();
+    }
+    if (state.shouldStop) {
+      Simulator::Stop();
+    }
+  }
+}
+
+void
+closeBatch()
+{
+  State& state = getState();
+  if (state.nDelays > 0) {
+    state.batchStarts.push_back(state.batchStart);
+    state.delays.push_back(state.sumDelays / state.nDelays);
+    uint64_t nFinished = state.nSatisfied + state.nGivenUp;
+    state.satisfactions.push_back(nFinished > 0 ?
+                                    static_cast<double>(state.nSatisfied) / nFinished :
+                                    std::numeric_limits<double>::quiet_NaN());
+  }
+  state.batchStart = Simulator::Now();
+  state.sumDelays = 0;
+  state.nDelays = 0;
+  state.nSatisfied = 0;
+  state.nGivenUp = 0;
+
+  evaluate();
+
+  // do not keep a simulation without other events running
+  if (!state.hasConverged && !Simulator::IsFinished()) {
+    state.batchEvent = Simulator::Schedule(state.batchDuration, &closeBatch);
+  }
+}
+
+} // namespace
+
+bool
+SteadyStateDetector::Estimate::IsPrecise(double relativeWidth) const
+{
+  return nBatches >= 2 && !std::isnan(halfWidth) && halfWidth <= relativeWidth * std::abs(mean);
+}
+
+void
+SteadyStateDetector::Enable(Time batchDuration, double relativeWidth, double confidence)
+{
+  Disable();
+
+  State& state = getState();
+  state.isEnabled = true;
+  state.batchDuration = batchDuration;
+  state.relativeWidth = relativeWidth;
+  state.confidence = confidence;
+  state.batchStart = Simulator::Now();
+
+  // the consumers are connected when the simulation runs, after they are installed
+  state.connectEvent = Simulator::ScheduleNow(&connect);
+  state.batchEvent = Simulator::Schedule(batchDuration, &closeBatch);
+  if (state.destroyEvent.IsExpired()) {
+    state.destroyEvent = Simulator::ScheduleDestroy(&forgetSimulation);
+  }
+}
+
+void
+SteadyStateDetector::Disable()
+{
+  State& state = getState();
+  Simulator::Cancel(state.connectEvent);
+  Simulator::Cancel(state.batchEvent);
+  disconnect();
+
+  state.isEnabled = false;
+  state.sumDelays = 0;
+  state.nDelays = 0;
+  state.nSatisfied = 0;
+  state.nGivenUp = 0;
+  state.batchStarts.clear();
+  state.delays.clear();
+  state.satisfactions.clear();
+  state.isWarmedUp = false;
+  state.truncation = 0;
+  state.hasConverged = false;
+}
+
+bool
+SteadyStateDetector::IsEnabled()
+{
+  return getState().isEnabled;
+}
+
+void
+SteadyStateDetector::SetMinBatches(uint32_t nBatches)
+{
+  getState().minBatches = std::max<uint32_t>(nBatches, 2);
+}
+
+void
+SteadyStateDetector::SetStopOnConvergence(bool shouldStop)
+{
+  getState().shouldStop = shouldStop;
+}
+
+void
+SteadyStateDetector::SetWarmedUpCallback(const std::function<void()>& callback)
+{
+  getState().warmedUpCallback = callback;
+}
+
+void
+SteadyStateDetector::SetConvergedCallback(const std::function<void()>& callback)
+{
+  getState().convergedCallback = callback;
+}
+
+bool
+SteadyStateDetector::IsWarmedUp()
+{
+  return getState().isWarmedUp;
+}
+
+Time
+SteadyStateDetector::GetWarmupEnd()
+{
+  State& state = getState();
+  return state.isWarmedUp ? state.batchStarts[state.truncation] : Time::Max();
+}
+
+bool
+SteadyStateDetector::HasConverged()
+{
+  return getState().hasConverged;
+}
+
+SteadyStateDetector::Estimate
+SteadyStateDetector::GetDelay()
+{
+  State& state = getState();
+  return EstimateMean(std::vector<double>(state.delays.begin() + state.truncation,
+                                          state.delays.end()),
+                      state.confidence);
+}
+
+SteadyStateDetector::Estimate
+SteadyStateDetector::GetSatisfaction()
+{
+  State& state = getState();
+  return EstimateMean(std::vector<double>(state.satisfactions.begin() + state.truncation,
+                                          state.satisfactions.end()),
+                      state.confidence);
+}
+
+void
+SteadyStateDetector::Print(std::ostream& os)
+{
+  State& state = getState();
+  if (state.isWarmedUp) {
+    os << "# warm-up ended at " << GetWarmupEnd().ToDouble(Time::S) << " s, "
+       << state.truncation << " batches truncated\n";
+  }
+  else {
+    os << "# warm-up not ended, " << state.delays.size() << " batches\n";
+  }
+  if (state.hasConverged) {
+    os << "# converged at " << state.convergedAt.ToDouble(Time::S) << " s\n";
+  }
+  else {
+    os << "# not converged\n";
+  }
+
+  os << "Metric"
+     << "\t"
+     << "Batches"
+     << "\t"
+     << "Mean"
+     << "\t"
+     << "CI"
+     << "\t"
+     << "RelativeCI(%)"
+     << "\n";
+  auto printEstimate = [&os] (const char* metric, const Estimate& estimate) {
+    os << metric << "\t" << estimate.nBatches << "\t" << estimate.mean << "\t"
+       << estimate.halfWidth << "\t" << estimate.halfWidth * 100 / std::abs(estimate.mean) << "\n";
+  };
+  printEstimate("Delay(s)", GetDelay());
+  printEstimate("Satisfaction", GetSatisfaction());
+}
+
+void
+SteadyStateDetector::RecordDelay(Time delay)
+{
+  State& state = getState();
+  state.sumDelays += delay.ToDouble(Time::S);
+  ++state.nDelays;
+}
+
+void
+SteadyStateDetector::RecordSatisfied()
+{
+  ++getState().nSatisfied;
+}
+
+void
+SteadyStateDetector::RecordGivenUp()
+{
+  ++getState().nGivenUp;
+}
+
+size_t
+SteadyStateDetector::FindTruncation(const std::vector<double>& batches)
+{
+  size_t n = batches.size();
+  if (n < 2) {
+    return 0;
+  }
+
+  // sums of the batches from d to the end, for every d
+  std::vector<double> sums(n + 1, 0);
+  std::vector<double> squares(n + 1, 0);
+  for (size_t i = n; i-- > 0;) {
+    sums[i] = sums[i + 1] + batches[i];
+    squares[i] = squares[i + 1] + batches[i] * batches[i];
+  }
+
+  size_t best = 0;
+  double bestStatistic = std::numeric_limits<double>::infinity();
+  for (size_t d = 0; d <= n / 2; ++d) {
+    double count = n - d;
+    double mean = sums[d] / count;
+    // sum of the squared deviations over the squared number of batches
+    double statistic = std::max(0.0, squares[d] - count * mean * mean) / (count * count);
+    if (statistic < bestStatistic) {
+      bestStatistic = statistic;
+      best = d;
+    }
+  }
+  return best;
+}
+
+SteadyStateDetector::Estimate
+SteadyStateDetector::EstimateMean(const std::vector<double>& batches, double confidence)
+{
+  Estimate estimate;
+  double sum = 0;
+  for (double batch : batches) {
+    if (!std::isnan(batch)) {
+      sum += batch;
+      ++estimate.nBatches;
+    }
+  }
+  if (estimate.nBatches == 0) {
+    return estimate;
+  }
+  estimate.mean = sum / estimate.nBatches;
+  if (estimate.nBatches < 2) {
+    return estimate;
+  }
+
+  double deviations = 0;
+  for (double batch : batches) {
+    if (!std::isnan(batch)) {
+      deviations += (batch - estimate.mean) * (batch - estimate.mean);
+    }
+  }
+  double standardError = std::sqrt(deviations / (estimate.nBatches - 1) / estimate.nBatches);
+  estimate.halfWidth = getTQuantile(confidence, estimate.nBatches - 1) * standardError;
+  return estimate;
+}
+
+} // namespace ndn
+} // namespace ns3
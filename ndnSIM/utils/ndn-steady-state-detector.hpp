@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_STEADY_STATE_DETECTOR_HPP
+#define NDNSIM_UTILS_NDN_STEADY_STATE_DETECTOR_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Online detection of the end of the warm-up and of the convergence of the delay and
+ *        satisfaction ratio of the consumers, to stop simulations early
+ *
+ * The delays (Consumer::FirstInterestDataDelay) and the Interests satisfied and given up
+ * (Consumer::DataReceived, Consumer::InterestGivenUp) of the consumers installed before
+ * Simulator::Run are grouped into batches of simulation time.  Batches without any delay,
+ * e.g., before the consumers start, are skipped.
+ *
+ * After every batch:
+ *  - until the warm-up has ended, the MSER rule, applied to the mean delays of the batches,
+ *    truncates the leading batches that minimize the standard error of the mean of the
+ *    rest.  The warm-up ends when the truncation point is in the first half of the batches and
+ *    at least SetMinBatches batches remain; the truncation is then kept, and the warm-up
+ *    callback is called, e.g., to start tracing
+ *  - after the warm-up, the confidence intervals of the mean delay and satisfaction ratio are
+ *    computed from the batch means.  Once both are narrower than the target (relative to the
+ *    mean), the simulation has converged: the converged callback is called, and the
+ *    simulation is stopped, unless disabled with SetStopOnConvergence
+ *
+ * The batches should be long enough for their means to be nearly independent, i.e., longer
+ * than the correlation time of the delays (e.g., several RTOs and mobility changes).
+ *
+ * Example:
+ *
+ *     ndn::SteadyStateDetector::Enable(Seconds(10), 0.05);
+ *     ndn::SteadyStateDetector::SetWarmedUpCallback([] {
+ *         ndn::AppDelayTracer::InstallAll("app-delays-trace.txt");
+ *       });
+ *     Simulator::Stop(Seconds(1798));
+ *     Simulator::Run();
+ *     ndn::SteadyStateDetector::Print(std::cout);
+ */
+class SteadyStateDetector
+{
+public:
+  struct Estimate
+  {
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double halfWidth = std::numeric_limits<double>::quiet_NaN(); ///< of the confidence interval
+    uint32_t nBatches = 0;
+
+    /**
+     * @brief Whether the confidence interval is at most @p relativeWidth times the mean wide
+     *        on each side
+     */
+    bool
+    IsPrecise(double relativeWidth) const;
+  };
+
+  /**
+   * @brief Start watching the consumers
+   * @param batchDuration simulation time of a batch
+   * @param relativeWidth target half width of the confidence intervals, relative to the means
+   * @param confidence confidence level of the intervals: 0.90, 0.95 or 0.99
+   */
+  static void
+  Enable(Time batchDuration = Seconds(10), double relativeWidth = 0.05,
+         double confidence = 0.95);
+
+  /**
+   * @brief Stop watching, and forget the batches
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Set the minimum number of batches after the warm-up (10 by default)
+   */
+  static void
+  SetMinBatches(uint32_t nBatches);
+
+  /**
+   * @brief Whether to stop the simulation once it has converged (true by default)
+   */
+  static void
+  SetStopOnConvergence(bool shouldStop);
+
+  static void
+  SetWarmedUpCallback(const std::function<void()>& callback);
+
+  static void
+  SetConvergedCallback(const std::function<void()>& callback);
+
+  static bool
+  IsWarmedUp();
+
+  /**
+   * @brief Get the simulation time at which the measurement started, i.e., the beginning of
+   *        the first batch after the warm-up
+   */
+  static Time
+  GetWarmupEnd();
+
+  static bool
+  HasConverged();
+
+  /**
+   * @brief Get the mean delay in seconds after the warm-up, over all batches so far if the
+   *        warm-up has not ended
+   */
+  static Estimate
+  GetDelay();
+
+  /**
+   * @brief Get the satisfaction ratio after the warm-up, over all batches so far if the
+   *        warm-up has not ended
+   */
+  static Estimate
+  GetSatisfaction();
+
+  /**
+   * @brief Print the warm-up, the convergence and the estimates
+   */
+  static void
+  Print(std::ostream& os);
+
+  /**
+   * @brief Add a delay to the current batch, called for every Data of the consumers
+   */
+  static void
+  RecordDelay(Time delay);
+
+  static void
+  RecordSatisfied();
+
+  static void
+  RecordGivenUp();
+
+  /**
+   * @brief Number of leading batches to truncate, by the MSER rule
+   */
+  static size_t
+  FindTruncation(const std::vector<double>& batches);
+
+  /**
+   * @brief Mean of the batches with the half width of its confidence interval
+   */
+  static Estimate
+  EstimateMean(const std::vector<double>& batches, double confidence);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_STEADY_STATE_DETECTOR_HPP
@@ -0,0 +1,303 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-strategy-replay.hpp"
+#include "utils/tracers/ndn-strategy-tracer.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/fw/strategy.hpp"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.StrategyReplay");
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Face that reports what the strategy sends through it
+ */
+class StrategyReplay::ReplayFace : public nfd::Face
+{
+public:
+  ReplayFace(StrategyReplay& replay, uint64_t recordedId)
+    : nfd::Face(nfd::FaceUri("replay://"), nfd::FaceUri("replay://"))
+    , m_replay(replay)
+    , m_recordedId(recordedId)
+  {
+  }
+
+  uint64_t
+  getRecordedId() const
+  {
+    return m_recordedId;
+  }
+
+  virtual void
+  sendInterest(const Interest& interest)
+  {
+    ++m_replay.m_nInterests;
+    m_replay.OnDecision(*this, "Interest", interest.getName());
+  }
+
+  virtual void
+  sendData(const Data& data)
+  {
+    m_replay.OnDecision(*this, "Data", data.getName());
+  }
+
+  virtual void
+  sendNack(const lp::Nack& nack)
+  {
+    ++m_replay.m_nNacks;
+    m_replay.OnDecision(*this, "Nack", nack.getInterest().getName());
+  }
+
+  virtual void
+  close()
+  {
+    this->fail("close");
+  }
+
+private:
+  StrategyReplay& m_replay;
+  uint64_t m_recordedId;
+};
+
+StrategyReplay::StrategyReplay(const Name& strategyName)
+  : m_forwarder(make_shared<nfd::Forwarder>())
+  , m_nInterests(0)
+  , m_nNacks(0)
+{
+  nfd::StrategyChoice& strategyChoice = m_forwarder->getStrategyChoice();
+  if (!strategyChoice.hasStrategy(strategyName)) {
+    throw std::invalid_argument("Strategy " + strategyName.toUri() + " is not registered");
+  }
+
+  // the strategy under test owns every namespace
+  strategyChoice.insert("/", strategyName);
+  strategyChoice.erase("/S");
+  m_strategy = &strategyChoice.findEffectiveStrategy(Name("/"));
+}
+
+StrategyReplay::~StrategyReplay()
+{
+}
+
+void
+StrategyReplay::Load(std::istream& is)
+{
+  uint64_t firstTime = 0;
+  bool isFirst = true;
+  while (is.peek() != std::istream::traits_type::eof()) {
+    Block record = Block::fromStream(is);
+    record.parse();
+    if (record.elements().empty() || record.elements().front().type() != strategy_trace::Time) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Strategy trace record does not start with Time"));
+    }
+
+    uint64_t time = readNonNegativeInteger(record.elements().front());
+    if (isFirst) {
+      firstTime = time;
+      isFirst = false;
+    }
+    Simulator::Schedule(NanoSeconds(time > firstTime ? time - firstTime : 0),
+                        &StrategyReplay::Replay, this, record);
+  }
+}
+
+void
+StrategyReplay::Load(const std::string& file)
+{
+  std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    throw std::runtime_error("File " + file + " cannot be opened for reading");
+  }
+  Load(is);
+}
+
+void
+StrategyReplay::SetDecisionStream(shared_ptr<std::ostream> os)
+{
+  m_decisions = os;
+}
+
+const StrategyReplay::TriggerStats&
+StrategyReplay::GetTriggerStats(uint32_t trigger) const
+{
+  static const TriggerStats NONE;
+  auto stats = m_triggers.find(trigger);
+  return stats == m_triggers.end() ? NONE : stats->second;
+}
+
+shared_ptr<StrategyReplay::ReplayFace>
+StrategyReplay::GetFace(uint64_t recordedId)
+{
+  shared_ptr<ReplayFace>& face = m_faces[recordedId];
+  if (face == nullptr) {
+    face = make_shared<ReplayFace>(ref(*this), recordedId);
+    m_forwarder->getFaceTable().add(face);
+  }
+  return face;
+}
+
+template<class Function>
+void
+StrategyReplay::Measure(uint32_t trigger, const Function& call)
+{
+  TriggerStats& stats = m_triggers[trigger];
+  auto start = std::chrono::steady_clock::now();
+  call();
+  stats.cpuTime += std::chrono::steady_clock::now() - start;
+  ++stats.nCalls;
+}
+
+void
+StrategyReplay::Replay(Block record)
+{
+  const Block::element_container& elements = record.elements();
+  switch (record.type()) {
+  case strategy_trace::AfterReceiveInterest:
+    AfterReceiveInterest(elements);
+    break;
+  case strategy_trace::BeforeSatisfyInterest:
+    BeforeSatisfyInterest(elements);
+    break;
+  case strategy_trace::BeforeExpirePendingInterest:
+    BeforeExpirePendingInterest(elements);
+    break;
+  default:
+    NS_LOG_DEBUG("Ignoring record of type " << record.type());
+    break;
+  }
+}
+
+void
+StrategyReplay::AfterReceiveInterest(const Block::element_container& elements)
+{
+  if (elements.size() < 4) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Malformed AfterReceiveInterest record"));
+  }
+  shared_ptr<ReplayFace> inFace = GetFace(readNonNegativeInteger(elements[1]));
+  shared_ptr<Interest> interest = make_shared<Interest>(elements[2]);
+  interest->setIncomingFaceId(inFace->getId());
+
+  // the FIB entry as the strategy saw it
+  shared_ptr<nfd::fib::Entry> fibEntry = m_forwarder->getFib().insert(Name(elements[3])).first;
+  nfd::fib::NextHopList oldNexthops = fibEntry->getNextHops();
+  for (const nfd::fib::NextHop& nexthop : oldNexthops) {
+    fibEntry->removeNextHop(nexthop.getFace());
+  }
+  for (auto element = elements.begin() + 4; element != elements.end(); ++element) {
+    element->parse();
+    if (element->type() != strategy_trace::NextHop || element->elements().size() != 2) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Malformed NextHop in AfterReceiveInterest record"));
+    }
+    fibEntry->addNextHop(GetFace(readNonNegativeInteger(element->elements()[0])),
+                         readNonNegativeInteger(element->elements()[1]));
+  }
+
+  shared_ptr<nfd::pit::Entry> pitEntry = m_forwarder->getPit().insert(*interest).first;
+  pitEntry->insertOrUpdateInRecord(inFace, *interest);
+
+  Measure(strategy_trace::AfterReceiveInterest, [&] {
+    m_strategy->afterReceiveInterest(*inFace, *interest, fibEntry, pitEntry);
+  });
+}
+
+void
+StrategyReplay::BeforeSatisfyInterest(const Block::element_container& elements)
+{
+  if (elements.size() < 4) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Malformed BeforeSatisfyInterest record"));
+  }
+  shared_ptr<ReplayFace> inFace = GetFace(readNonNegativeInteger(elements[1]));
+  shared_ptr<nfd::pit::Entry> pitEntry = m_forwarder->getPit().find(Interest(elements[2]));
+  if (pitEntry == nullptr) {
+    ++m_triggers[strategy_trace::BeforeSatisfyInterest].nSkipped;
+    return;
+  }
+
+  shared_ptr<Data> data = make_shared<Data>(Name(elements[3]));
+  if (elements.size() > 4) {
+    data->setFreshnessPeriod(time::milliseconds(readNonNegativeInteger(elements[4])));
+  }
+
+  Measure(strategy_trace::BeforeSatisfyInterest, [&] {
+    m_strategy->beforeSatisfyInterest(pitEntry, *inFace, *data);
+  });
+
+  pitEntry->deleteInRecords();
+  pitEntry->deleteOutRecord(*inFace);
+}
+
+void
+StrategyReplay::BeforeExpirePendingInterest(const Block::element_container& elements)
+{
+  if (elements.size() < 2) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Malformed BeforeExpirePendingInterest record"));
+  }
+  shared_ptr<nfd::pit::Entry> pitEntry = m_forwarder->getPit().find(Interest(elements[1]));
+  if (pitEntry == nullptr) {
+    ++m_triggers[strategy_trace::BeforeExpirePendingInterest].nSkipped;
+    return;
+  }
+
+  Measure(strategy_trace::BeforeExpirePendingInterest, [&] {
+    m_strategy->beforeExpirePendingInterest(pitEntry);
+  });
+
+  pitEntry->deleteInRecords();
+  while (!pitEntry->getOutRecords().empty()) {
+    pitEntry->deleteOutRecord(*pitEntry->getOutRecords().front().getFace());
+  }
+}
+
+void
+StrategyReplay::OnDecision(const ReplayFace& face, const char* decision, const Name& name)
+{
+  if (m_decisions != nullptr) {
+    *m_decisions << Simulator::Now().ToDouble(Time::S) << "\t" << face.getRecordedId() << "\t"
+                 << decision << "\t" << name << "\n";
+  }
+}
+
+void
+StrategyReplay::PrintReport(std::ostream& os) const
+{
+  os << "Strategy\t" << m_strategy->getName() << "\n";
+  os << "Trigger\tCalls\tSkipped\tCpuTime(us)\tPerCall(us)\n";
+  for (const auto& trigger : {std::make_pair(strategy_trace::AfterReceiveInterest, "AfterReceiveInterest"),
+                              std::make_pair(strategy_trace::BeforeSatisfyInterest, "BeforeSatisfyInterest"),
+                              std::make_pair(strategy_trace::BeforeExpirePendingInterest,
+                                             "BeforeExpirePendingInterest")}) {
+    const TriggerStats& stats = GetTriggerStats(trigger.first);
+    double cpuTime = std::chrono::duration<double, std::micro>(stats.cpuTime).count();
+    os << trigger.second << "\t" << stats.nCalls << "\t" << stats.nSkipped << "\t" << cpuTime
+       << "\t" << (stats.nCalls > 0 ? cpuTime / stats.nCalls : 0) << "\n";
+  }
+  os << "Interests\t" << m_nInterests << "\n"
+     << "Nacks\t" << m_nNacks << "\n";
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_STRATEGY_REPLAY_H
+#define NDN_STRATEGY_REPLAY_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <chrono>
+#include <map>
+
+namespace nfd {
+class Forwarder;
+namespace fw {
+class Strategy;
+} // namespace fw
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Replays a trace of StrategyTracer against a strategy, without the rest of the simulation
+ *
+ * The replay owns a forwarder that is not attached to any node.  Every record of the trace
+ * is scheduled at its recorded time relative to the time of Load, and on Simulator::Run:
+ * - AfterReceiveInterest sets the FIB entry to the recorded nexthops, inserts the in-record
+ *   and triggers the strategy;
+ * - BeforeSatisfyInterest and BeforeExpirePendingInterest trigger the strategy on the PIT
+ *   entry, if it still exists, and then delete its in-records and out-records.
+ *
+ * Faces of the trace are replaced by faces that record the Interests and Nacks the
+ * strategy sends (the forwarding decisions).  Timers of the strategy run as usual, so the
+ * decisions include its retransmissions.  The time of each trigger call is measured with
+ * the steady clock of the process.
+ */
+class StrategyReplay : noncopyable
+{
+public:
+  struct TriggerStats
+  {
+    uint64_t nCalls = 0;
+    uint64_t nSkipped = 0; ///< @brief records whose PIT entry did not exist anymore
+    std::chrono::nanoseconds cpuTime{0};
+  };
+
+  /**
+   * @throw std::invalid_argument the strategy is not registered
+   */
+  explicit
+  StrategyReplay(const Name& strategyName);
+
+  ~StrategyReplay();
+
+  /**
+   * @brief Schedule the records of the trace, the first one now
+   * @throw tlv::Error the trace is malformed
+   */
+  void
+  Load(std::istream& is);
+
+  /**
+   * @throw std::runtime_error the file cannot be opened
+   * @throw tlv::Error the trace is malformed
+   */
+  void
+  Load(const std::string& file);
+
+  /**
+   * @brief Write every decision to @p os (Time, Face, Decision and Name, tab-separated)
+   */
+  void
+  SetDecisionStream(shared_ptr<std::ostream> os);
+
+  /**
+   * @param trigger strategy_trace::AfterReceiveInterest, BeforeSatisfyInterest or
+   *                BeforeExpirePendingInterest
+   */
+  const TriggerStats&
+  GetTriggerStats(uint32_t trigger) const;
+
+  uint64_t
+  GetNInterests() const
+  {
+    return m_nInterests;
+  }
+
+  uint64_t
+  GetNNacks() const
+  {
+    return m_nNacks;
+  }
+
+  /**
+   * @brief Print calls and CPU time per trigger, and the number of decisions
+   */
+  void
+  PrintReport(std::ostream& os) const;
+
+private:
+  class ReplayFace;
+
+  shared_ptr<ReplayFace>
+  GetFace(uint64_t recordedId);
+
+  void
+  Replay(Block record);
+
+  void
+  AfterReceiveInterest(const Block::element_container& elements);
+
+  void
+  BeforeSatisfyInterest(const Block::element_container& elements);
+
+  void
+  BeforeExpirePendingInterest(const Block::element_container& elements);
+
+  void
+  OnDecision(const ReplayFace& face, const char* decision, const Name& name);
+
+  template<class Function>
+  void
+  Measure(uint32_t trigger, const Function& call);
+
+private:
+  shared_ptr<nfd::Forwarder> m_forwarder;
+  nfd::fw::Strategy* m_strategy;
+  std::map<uint64_t, shared_ptr<ReplayFace>> m_faces; ///< @brief by face id in the trace
+
+  std::map<uint32_t, TriggerStats> m_triggers;
+  uint64_t m_nInterests;
+  uint64_t m_nNacks;
+  shared_ptr<std::ostream> m_decisions;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_STRATEGY_REPLAY_H
@@ -0,0 +1,52 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-thread-confinement.hpp"
+
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace ndn {
+
+ThreadConfinement::Scope::Scope(ThreadConfinement& confinement)
+  : m_confinement(confinement)
+  , m_isOutermost(false)
+{
+  std::thread::id self = std::this_thread::get_id();
+  std::thread::id owner;
+  if (m_confinement.m_owner.compare_exchange_strong(owner, self)) {
+    m_isOutermost = true;
+  }
+  else {
+    // nested scopes of the same thread, e.g., Data satisfying Interests of a local application
+    NS_ASSERT_MSG(owner == self, "State of a node used by two threads at once, the node is "
+                                 "reached from outside of its logical process");
+  }
+}
+
+ThreadConfinement::Scope::~Scope()
+{
+  if (m_isOutermost) {
+    m_confinement.m_owner.store(std::thread::id());
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDNSIM_UTILS_NDN_THREAD_CONFINEMENT_HPP
+#define NDNSIM_UTILS_NDN_THREAD_CONFINEMENT_HPP
+
+#include <atomic>
+#include <thread>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Detects concurrent use of the state of one node, e.g., of its forwarder
+ *
+ * A multithreaded simulator implementation partitions the nodes into logical processes, which
+ * are synchronized conservatively with the lookahead of the links between them (the delay of
+ * point-to-point links, the propagation delay of wireless channels).  The events of a logical
+ * process run on one thread at a time, so the forwarder, tables, faces and applications of a
+ * node need no locks, as long as nothing reaches into another node directly.  What is shared by
+ * all nodes (counters, DataWireTable, SharedInput, Convert::FanOut) is atomic, locked or
+ * per thread.
+ *
+ * NDN_CONFINED_SCOPE(confinement) marks the rest of the enclosing scope as using the state
+ * guarded by @p confinement.  In builds with assertions (NS3_ASSERT_ENABLE), it asserts that no
+ * other thread is within a scope of the same confinement, e.g., that a node is not reached
+ * from the logical process of another one.  Otherwise it expands to nothing.
+ */
+class ThreadConfinement
+{
+public:
+  class Scope
+  {
+  public:
+    explicit
+    Scope(ThreadConfinement& confinement);
+
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+
+    Scope&
+    operator=(const Scope&) = delete;
+
+  private:
+    ThreadConfinement& m_confinement;
+    bool m_isOutermost;
+  };
+
+private:
+  std::atomic<std::thread::id> m_owner{std::thread::id()};
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#ifdef NS3_ASSERT_ENABLE
+#define NDN_CONFINED_SCOPE_CONCAT(a, b) a##b
+#define NDN_CONFINED_SCOPE_VARIABLE(line) NDN_CONFINED_SCOPE_CONCAT(ndnConfinedScope, line)
+#define NDN_CONFINED_SCOPE(confinement) \
+  ::ns3::ndn::ThreadConfinement::Scope NDN_CONFINED_SCOPE_VARIABLE(__LINE__)(confinement)
+#else
+#define NDN_CONFINED_SCOPE(confinement)
+#endif // NS3_ASSERT_ENABLE
+
+#endif // NDNSIM_UTILS_NDN_THREAD_CONFINEMENT_HPP
@@ -0,0 +1,43 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-virtual-payload.hpp"
+#include "ndn-ns3-packet-tag.hpp"
+
+#include "ns3/packet.h"
+
+namespace ns3 {
+namespace ndn {
+
+void
+setVirtualPayload(Data& data, uint32_t size)
+{
+  // Packet(size) does not allocate the zero-filled octets
+  data.setTag(make_shared<Ns3PacketTag>(Create<Packet>(size)));
+}
+
+uint32_t
+getVirtualPayloadSize(const Data& data)
+{
+  shared_ptr<Ns3PacketTag> tag = data.getTag<Ns3PacketTag>();
+  return tag != nullptr ? tag->getPacket()->GetSize() : 0;
+}
+
+} // namespace ndn
+} // namespace ns3
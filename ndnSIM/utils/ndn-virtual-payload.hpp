@@ -0,0 +1,53 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_VIRTUAL_PAYLOAD_H
+#define NDN_VIRTUAL_PAYLOAD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-apps
+ *
+ * \brief Attaches a virtual payload of \p size zero octets to the Data
+ *
+ * The payload is not part of the Data content and takes no memory: it is the zero-filled area
+ * of the ns-3 packet that carries the Data, which Convert::ToPacket appends after the encoded
+ * Data and Convert::FromPacket keeps with the received Data.  Links therefore see frames of the
+ * full size, while forwarders and content stores only hold the name, meta information and
+ * signature.  Content of the Data should be empty.
+ *
+ * Packet tags of the ns-3 packet kept with the Data, if there is one, are lost.
+ */
+void
+setVirtualPayload(Data& data, uint32_t size);
+
+/**
+ * \brief Size of the virtual payload of the Data, 0 if it has none
+ */
+uint32_t
+getVirtualPayloadSize(const Data& data);
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_VIRTUAL_PAYLOAD_H
@@ -51,8 +51,15 @@
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
-#include <set>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sys/stat.h>
 
 #ifdef NS3_MPI
 #include <ns3/mpi-interface.h>
@@ -151,93 +158,388 @@ AnnotatedTopologyReader::GetLinks() const
   return m_linksList;
 }
 
-NodeContainer
-AnnotatedTopologyReader::Read(void)
+/// @cond include_hidden
+
+struct AnnotatedTopologyReader::Records {
+  struct RouterRecord {
+    std::string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+
+  enum { FROM, TO, CAPACITY, METRIC, DELAY, MAX_PACKETS, LOSS_RATE, N_LINK_FIELDS };
+
+  struct LinkRecord {
+    std::string fields[N_LINK_FIELDS];
+  };
+
+  bool hasLinkSection = false;
+  std::vector<RouterRecord> nodes;
+  std::vector<LinkRecord> links;
+};
+
+namespace {
+
+typedef std::pair<const char*, const char*> Token;
+
+/**
+ * \brief Get the next line of [pos, end) without the end-of-line characters
+ */
+bool
+nextLine(const char*& pos, const char* end, Token& line)
+{
+  if (pos == end)
+    return false;
+
+  const char* eol = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+  line.first = pos;
+  line.second = eol != nullptr ? eol : end;
+  pos = eol != nullptr ? eol + 1 : end;
+
+  if (line.second != line.first && *(line.second - 1) == '\r')
+    --line.second;
+  return true;
+}
+
+bool
+isLine(const Token& line, const char* keyword)
+{
+  size_t length = line.second - line.first;
+  return std::strlen(keyword) == length && std::memcmp(line.first, keyword, length) == 0;
+}
+
+/**
+ * \brief Split the line into at most \p maxFields fields separated by spaces or tabs
+ * \return number of fields
+ */
+size_t
+splitFields(const Token& line, Token* fields, size_t maxFields)
+{
+  size_t nFields = 0;
+  const char* pos = line.first;
+  while (nFields < maxFields) {
+    while (pos != line.second && (*pos == ' ' || *pos == '\t'))
+      ++pos;
+    if (pos == line.second)
+      break;
+
+    fields[nFields].first = pos;
+    while (pos != line.second && *pos != ' ' && *pos != '\t')
+      ++pos;
+    fields[nFields].second = pos;
+    ++nFields;
+  }
+  return nFields;
+}
+
+/**
+ * \brief Parse the field as number, as operator>> of the stream would
+ */
+template<class T>
+bool
+parseNumber(const Token& field, T& value)
+{
+  std::string str(field.first, field.second);
+  char* end = nullptr;
+  double number = std::strtod(str.c_str(), &end);
+  if (end == str.c_str())
+    return false;
+  value = static_cast<T>(number);
+  return true;
+}
+
+template<class T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+writeString(std::ostream& os, const std::string& value)
+{
+  writeValue(os, static_cast<uint32_t>(value.size()));
+  os.write(value.data(), value.size());
+}
+
+class CacheReader {
+public:
+  CacheReader(const char* begin, const char* end)
+    : m_pos(begin)
+    , m_end(end)
+  {
+  }
+
+  template<class T>
+  bool
+  read(T& value)
+  {
+    if (static_cast<size_t>(m_end - m_pos) < sizeof(value))
+      return false;
+    std::memcpy(&value, m_pos, sizeof(value));
+    m_pos += sizeof(value);
+    return true;
+  }
+
+  bool
+  read(std::string& value)
+  {
+    uint32_t size;
+    if (!read(size) || static_cast<size_t>(m_end - m_pos) < size)
+      return false;
+    value.assign(m_pos, size);
+    m_pos += size;
+    return true;
+  }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+};
+
+const char CACHE_MAGIC[4] = {'A', 'T', 'C', '1'};
+
+bool
+getFileVersion(const std::string& file, uint64_t& size, int64_t& mtime)
+{
+  struct stat info;
+  if (::stat(file.c_str(), &info) != 0)
+    return false;
+  size = info.st_size;
+  mtime = info.st_mtime;
+  return true;
+}
+
+} // namespace
+
+/// @endcond
+
+void
+AnnotatedTopologyReader::SetCacheFile(const std::string& file)
 {
-  ifstream topgen;
-  topgen.open(GetFileName().c_str());
+  m_cacheFile = file;
+}
 
-  if (!topgen.is_open() || !topgen.good()) {
+void
+AnnotatedTopologyReader::ParseFile(Records& records) const
+{
+  boost::iostreams::mapped_file_source file;
+  try {
+    file.open(GetFileName());
+  }
+  catch (const std::exception&) {
     NS_FATAL_ERROR("Cannot open file " << GetFileName() << " for reading");
-    return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
+  const char* pos = file.data();
+  const char* end = file.data() + file.size();
+  Token line;
+  Token fields[Records::N_LINK_FIELDS];
 
-    if (line == "router")
+  bool hasRouterSection = false;
+  while (nextLine(pos, end, line)) {
+    if (isLine(line, "router")) {
+      hasRouterSection = true;
       break;
+    }
   }
 
-  if (topgen.eof()) {
+  if (!hasRouterSection) {
     NS_FATAL_ERROR("Topology file " << GetFileName() << " does not have \"router\" section");
-    return m_nodes;
   }
 
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line[0] == '#')
+  while (nextLine(pos, end, line)) {
+    if (line.first != line.second && *line.first == '#')
       continue; // comments
-    if (line == "link")
+    if (isLine(line, "link")) {
+      records.hasLinkSection = true;
       break; // stop reading nodes
+    }
 
-    istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
+    size_t nFields = splitFields(line, fields, 5);
+    if (nFields == 0)
+      continue;
+
+    Records::RouterRecord node;
+    node.name.assign(fields[0].first, fields[0].second);
+    node.latitude = 0;
+    node.longitude = 0;
+    node.systemId = 0;
+
+    // fields after one that is not a number are ignored
+    if (nFields >= 3 && parseNumber(fields[2], node.latitude)) {
+      if (nFields >= 4 && parseNumber(fields[3], node.longitude)) {
+        if (nFields >= 5)
+          parseNumber(fields[4], node.systemId);
+      }
+    }
 
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
+    records.nodes.push_back(node);
+  }
+
+  if (!records.hasLinkSection)
+    return;
+
+  while (nextLine(pos, end, line)) {
+    if (line.first == line.second)
       continue;
+    if (*line.first == '#')
+      continue; // comments
+
+    size_t nFields = splitFields(line, fields, Records::N_LINK_FIELDS);
+
+    Records::LinkRecord link;
+    for (size_t i = 0; i < nFields; ++i) {
+      link.fields[i].assign(fields[i].first, fields[i].second);
+    }
+    records.links.push_back(link);
+  }
+}
+
+bool
+AnnotatedTopologyReader::LoadCache(Records& records) const
+{
+  uint64_t size;
+  int64_t mtime;
+  if (!getFileVersion(GetFileName(), size, mtime))
+    return false;
+
+  boost::iostreams::mapped_file_source file;
+  try {
+    file.open(m_cacheFile);
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+
+  CacheReader reader(file.data(), file.data() + file.size());
+  char magic[sizeof(CACHE_MAGIC)];
+  uint64_t cachedSize;
+  int64_t cachedMtime;
+  uint8_t hasLinkSection;
+  uint32_t nNodes, nLinks;
+  if (!reader.read(magic) || std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+      || !reader.read(cachedSize) || !reader.read(cachedMtime) || cachedSize != size
+      || cachedMtime != mtime || !reader.read(hasLinkSection) || !reader.read(nNodes)
+      || !reader.read(nLinks)) {
+    NS_LOG_DEBUG("Cache " << m_cacheFile << " is not valid for " << GetFileName());
+    return false;
+  }
+
+  records.hasLinkSection = hasLinkSection != 0;
+  records.nodes.resize(nNodes);
+  for (Records::RouterRecord& node : records.nodes) {
+    if (!reader.read(node.name) || !reader.read(node.latitude) || !reader.read(node.longitude)
+        || !reader.read(node.systemId))
+      return false;
+  }
+
+  records.links.resize(nLinks);
+  for (Records::LinkRecord& link : records.links) {
+    for (std::string& field : link.fields) {
+      if (!reader.read(field))
+        return false;
+    }
+  }
+
+  NS_LOG_DEBUG("Loaded " << GetFileName() << " from cache " << m_cacheFile);
+  return true;
+}
 
+void
+AnnotatedTopologyReader::SaveCache(const Records& records) const
+{
+  uint64_t size;
+  int64_t mtime;
+  if (!getFileVersion(GetFileName(), size, mtime))
+    return;
+
+  ofstream os(m_cacheFile.c_str(), ios::binary | ios::trunc);
+  if (!os.is_open()) {
+    NS_LOG_WARN("Cannot open cache " << m_cacheFile << " for writing");
+    return;
+  }
+
+  os.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  writeValue(os, size);
+  writeValue(os, mtime);
+  writeValue(os, static_cast<uint8_t>(records.hasLinkSection));
+  writeValue(os, static_cast<uint32_t>(records.nodes.size()));
+  writeValue(os, static_cast<uint32_t>(records.links.size()));
+
+  for (const Records::RouterRecord& node : records.nodes) {
+    writeString(os, node.name);
+    writeValue(os, node.latitude);
+    writeValue(os, node.longitude);
+    writeValue(os, node.systemId);
+  }
+
+  for (const Records::LinkRecord& link : records.links) {
+    for (const std::string& field : link.fields) {
+      writeString(os, field);
+    }
+  }
+}
+
+NodeContainer
+AnnotatedTopologyReader::Read(void)
+{
+  Records records;
+  if (m_cacheFile.empty() || !LoadCache(records)) {
+    ParseFile(records);
+    if (!m_cacheFile.empty())
+      SaveCache(records);
+  }
+
+  // links are resolved without going through ns3::Names
+  std::unordered_map<std::string, Ptr<Node>> nodes;
+  nodes.reserve(records.nodes.size());
+
+  for (const Records::RouterRecord& record : records.nodes) {
     Ptr<Node> node;
 
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
+    if (abs(record.latitude) > 0.001 && abs(record.latitude) > 0.001)
+      node = CreateNode(record.name, m_scale * record.longitude, -m_scale * record.latitude,
+                        record.systemId);
     else {
       Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
+      node = CreateNode(record.name, var->GetValue(0, 200), var->GetValue(0, 200),
+                        record.systemId);
       // node = CreateNode (name, systemId);
     }
+    nodes[record.name] = node;
   }
 
-  map<string, set<string>> processedLinks; // to eliminate duplications
-
-  if (topgen.eof()) {
+  if (!records.hasLinkSection) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
     return m_nodes;
   }
 
-  // SeekToSection ("link");
-  while (!topgen.eof()) {
-    string line;
-    getline(topgen, line);
-    if (line == "")
-      continue;
-    if (line[0] == '#')
-      continue; // comments
-
-    // NS_LOG_DEBUG ("Input: [" << line << "]");
-
-    istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  // to eliminate duplications
+  std::unordered_map<std::string, std::unordered_set<std::string>> processedLinks;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+  for (const Records::LinkRecord& record : records.links) {
+    const string& from = record.fields[Records::FROM];
+    const string& to = record.fields[Records::TO];
+    const string& capacity = record.fields[Records::CAPACITY];
+    const string& metric = record.fields[Records::METRIC];
+    const string& delay = record.fields[Records::DELAY];
+    const string& maxPackets = record.fields[Records::MAX_PACKETS];
+    const string& lossRate = record.fields[Records::LOSS_RATE];
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
+    auto reverse = processedLinks.find(to);
+    if (reverse != processedLinks.end() && reverse->second.count(from) != 0) {
       continue; // duplicated link
     }
     processedLinks[from].insert(to);
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    auto fromNode = nodes.find(from);
+    NS_ASSERT_MSG(fromNode != nodes.end(), from << " node not found");
+    auto toNode = nodes.find(to);
+    NS_ASSERT_MSG(toNode != nodes.end(), to << " node not found");
 
-    Link link(fromNode, from, toNode, to);
+    Link link(fromNode->second, from, toNode->second, to);
 
     link.SetAttribute("DataRate", capacity);
     link.SetAttribute("OSPF", metric);
@@ -259,7 +561,6 @@ AnnotatedTopologyReader::Read(void)
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
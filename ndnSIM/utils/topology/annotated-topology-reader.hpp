@@ -103,6 +103,18 @@ public:
   virtual void
   ApplyOspfMetric();
 
+  /**
+   * \brief Keep the parsed topology in a binary cache file for repeated runs
+   *
+   * If the cache exists and was made from the current version of the topology file (same size
+   * and modification time), Read loads the cache instead of parsing the file.  Otherwise, Read
+   * parses the file and writes the cache.  The cache uses the byte order of the host.
+   *
+   * \param file name of the cache file, empty to disable the cache (default)
+   */
+  void
+  SetCacheFile(const std::string& file);
+
   /**
    * \brief Save positions (e.g., after manual modification using visualizer)
    */
@@ -135,6 +147,18 @@ protected:
   std::string m_path;
   NodeContainer m_nodes;
 
+private:
+  struct Records;
+
+  void
+  ParseFile(Records& records) const;
+
+  bool
+  LoadCache(Records& records) const;
+
+  void
+  SaveCache(const Records& records) const;
+
 private:
   AnnotatedTopologyReader(const AnnotatedTopologyReader&);
   AnnotatedTopologyReader&
@@ -147,6 +171,8 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+
+  std::string m_cacheFile;
 };
 }
 
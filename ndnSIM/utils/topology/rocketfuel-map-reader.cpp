@@ -52,6 +52,8 @@
 #include <boost/graph/connected_components.hpp>
 
 #include <iomanip>
+#include <memory>
+#include <unordered_map>
 
 using namespace std;
 using namespace boost;
@@ -93,26 +95,29 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
+RocketfuelMapReader::LinkParams::LinkParams(const string& minBw, const string& maxBw,
+                                             const string& minDelay, const string& maxDelay)
+  : minBandwidth(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()))
+  , maxBandwidth(static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate()))
+  , minDelay(lexical_cast<Time>(minDelay).ToDouble(Time::US))
+  , maxDelay(lexical_cast<Time>(maxDelay).ToDouble(Time::US))
+{
+}
+
 void
-RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
+RocketfuelMapReader::CreateLink(Ptr<Node> node1, const string& nodeName1, Ptr<Node> node2,
+                                const string& nodeName2, double averageRtt,
+                                const LinkParams& params)
 {
-  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
   Link link(node1, nodeName1, node2, nodeName2);
 
-  DataRate randBandwidth(
-    m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
-                          static_cast<uint32_t>(lexical_cast<DataRate>(maxBw).GetBitRate())));
+  DataRate randBandwidth(m_randVar->GetInteger(params.minBandwidth, params.maxBandwidth));
 
   int32_t metric = std::max(1, static_cast<int32_t>(1.0 * m_referenceOspfRate.GetBitRate()
                                                     / randBandwidth.GetBitRate()));
 
   Time randDelay =
-    Time::FromDouble((m_randVar->GetValue(lexical_cast<Time>(minDelay).ToDouble(Time::US),
-                                          lexical_cast<Time>(maxDelay).ToDouble(Time::US))),
-                     Time::US);
+    Time::FromDouble((m_randVar->GetValue(params.minDelay, params.maxDelay)), Time::US);
 
   uint32_t queue = ceil(averageRtt * (randBandwidth.GetBitRate() / 8.0 / 1100.0));
 
@@ -284,8 +289,16 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     return m_nodes;
   }
 
+  // the expression is compiled once for the whole file
+  regex_t regex;
+  int ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
+  if (ret != 0) {
+    regerror(ret, &regex, errbuf, sizeof(errbuf));
+    regfree(&regex);
+    NS_FATAL_ERROR("Cannot compile expression for maps file: " << errbuf);
+  }
+
   while (!topgen.eof()) {
-    int ret;
     int argc;
     char* argv[REGMATCH_MAX];
     char* buf;
@@ -298,19 +311,10 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     buf = (char*)line.c_str();
 
     regmatch_t regmatch[REGMATCH_MAX];
-    regex_t regex;
-
-    ret = regcomp(&regex, ROCKETFUEL_MAPS_LINE, REG_EXTENDED | REG_NEWLINE);
-    if (ret != 0) {
-      regerror(ret, &regex, errbuf, sizeof(errbuf));
-      regfree(&regex);
-      continue;
-    }
 
     ret = regexec(&regex, buf, REGMATCH_MAX, regmatch, 0);
     if (ret == REG_NOMATCH) {
       NS_LOG_WARN("match failed (maps file): %s" << buf);
-      regfree(&regex);
       continue;
     }
 
@@ -330,8 +334,8 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     }
 
     GenerateFromMapsFile(argc, argv);
-    regfree(&regex);
   }
+  regfree(&regex);
 
   if (keepOneComponent) {
     NS_LOG_DEBUG("Before eliminating disconnected nodes: " << num_vertices(m_graph));
@@ -396,56 +400,89 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
   }
 
+  // nodes are created with their final names, and links are resolved without ns3::Names
+  std::unordered_map<std::string, Ptr<Node>> nodes;
+  nodes.reserve(num_vertices(m_graph));
+
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
 
     node_type_t type = get(vertex_rank, m_graph, *v);
     switch (type) {
     case BACKBONE:
-      Names::Rename(nodeName, "bb-" + nodeName);
-      put(vertex_name, m_graph, *v, "bb-" + nodeName);
+      nodeName = "bb-" + nodeName;
+      break;
+    case CLIENT:
+      nodeName = "leaf-" + nodeName;
+      break;
+    case GATEWAY:
+      nodeName = "gw-" + nodeName;
+      break;
+    case UNKNOWN:
+      NS_FATAL_ERROR("Should not happen");
+      break;
+    }
+
+    Ptr<Node> node = CreateNode(nodeName, 0);
+    put(vertex_name, m_graph, *v, nodeName);
+    nodes[nodeName] = node;
+
+    switch (type) {
+    case BACKBONE:
       m_backboneRouters.Add(node);
       break;
     case CLIENT:
-      Names::Rename(nodeName, "leaf-" + nodeName);
-      put(vertex_name, m_graph, *v, "leaf-" + nodeName);
       m_customerRouters.Add(node);
       break;
     case GATEWAY:
-      Names::Rename(nodeName, "gw-" + nodeName);
-      put(vertex_name, m_graph, *v, "gw-" + nodeName);
       m_gatewayRouters.Add(node);
       break;
     case UNKNOWN:
-      NS_FATAL_ERROR("Should not happen");
       break;
     }
   }
 
+  // parameters are parsed on the first link of each type rather than for every link
+  std::unique_ptr<LinkParams> b2bParams, b2gParams, g2cParams;
+  auto b2b = [&] () -> const LinkParams& {
+    if (b2bParams == nullptr)
+      b2bParams.reset(new LinkParams(params.minb2bBandwidth, params.maxb2bBandwidth,
+                                     params.minb2bDelay, params.maxb2bDelay));
+    return *b2bParams;
+  };
+  auto b2g = [&] () -> const LinkParams& {
+    if (b2gParams == nullptr)
+      b2gParams.reset(new LinkParams(params.minb2gBandwidth, params.maxb2gBandwidth,
+                                     params.minb2gDelay, params.maxb2gDelay));
+    return *b2gParams;
+  };
+  auto g2c = [&] () -> const LinkParams& {
+    if (g2cParams == nullptr)
+      g2cParams.reset(new LinkParams(params.ming2cBandwidth, params.maxg2cBandwidth,
+                                     params.ming2cDelay, params.maxg2cDelay));
+    return *g2cParams;
+  };
+
   for (tie(e, ende) = edges(m_graph); e != ende; e++) {
     Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
 
     node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
 
     string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
+    Ptr<Node> u_node = nodes[u_name], v_node = nodes[v_name];
 
     if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
+      CreateLink(u_node, u_name, v_node, v_name, params.averageRtt, b2b());
     }
     else if ((u_type == GATEWAY && v_type == BACKBONE)
              || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      CreateLink(u_node, u_name, v_node, v_name, params.averageRtt, b2g());
     }
     else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
+      CreateLink(u_node, u_name, v_node, v_name, params.averageRtt, b2g());
     }
     else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
+      CreateLink(u_node, u_name, v_node, v_name, params.averageRtt, g2c());
     }
     else {
       NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
@@ -604,8 +641,10 @@ RocketfuelMapReader::SaveGraphviz(const std::string& file)
 void
 RocketfuelMapReader::KeepOnlyBiggestConnectedComponent()
 {
-  std::map<graph_traits<Graph>::vertex_descriptor, int> temp;
-  associative_property_map<std::map<graph_traits<Graph>::vertex_descriptor, int>> components(temp);
+  // vertex indexes are kept contiguous, so components can be stored in a plain vector
+  std::vector<int> temp(num_vertices(m_graph));
+  iterator_property_map<std::vector<int>::iterator, property_map<Graph, vertex_index_t>::type>
+    components(temp.begin(), get(vertex_index, m_graph));
 
   // //check if topology has breaks in its structure and trim it if yes
   // property_map<Graph, vertex_index1_t>::type components = get (vertex_index1, m_graph);
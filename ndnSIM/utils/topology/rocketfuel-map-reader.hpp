@@ -133,9 +133,22 @@ private:
   void
   GenerateFromMapsFile(int argc, char* argv[]);
 
+  /**
+   * \brief Ranges of bandwidth (bps) and delay (us) of a link type
+   */
+  struct LinkParams {
+    LinkParams(const string& minBw, const string& maxBw, const string& minDelay,
+               const string& maxDelay);
+
+    uint32_t minBandwidth;
+    uint32_t maxBandwidth;
+    double minDelay;
+    double maxDelay;
+  };
+
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  CreateLink(Ptr<Node> node1, const string& nodeName1, Ptr<Node> node2, const string& nodeName2,
+             double averageRtt, const LinkParams& params);
   void
   KeepOnlyBiggestConnectedComponent();
 
@@ -18,6 +18,9 @@
  **/
 
 #include "l2-rate-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
 
 #include "ns3/node.h"
 #include "ns3/packet.h"
@@ -50,10 +53,9 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
   std::list<Ptr<L2RateTracer>> tracers;
   std::shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -157,6 +159,8 @@ const double alpha = 0.8;
 void
 L2RateTracer::Print(std::ostream& os) const
 {
+  NDN_PROFILE_ZONE("L2RateTracer::Print");
+  NDN_ALLOCATION_SCOPE(TRACERS);
   Time time = Simulator::Now();
 
   PRINTER("Drop", m_drop, "combined");
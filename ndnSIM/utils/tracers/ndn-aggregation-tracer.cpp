@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-aggregation-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AggregationTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<AggregationTracer>>>> g_tracers;
+
+void
+AggregationTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+static shared_ptr<std::ostream>
+OpenOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+  if (os == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+void
+AggregationTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+  Install(nodes, file, averagingPeriod);
+}
+
+void
+AggregationTracer::Install(const NodeContainer& nodes, const std::string& file,
+                           Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = OpenOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<AggregationTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Install(*node, outputStream, averagingPeriod));
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+AggregationTracer::Install(Ptr<Node> node, const std::string& file,
+                           Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  Install(NodeContainer(node), file, averagingPeriod);
+}
+
+Ptr<AggregationTracer>
+AggregationTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                           Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AggregationTracer> trace = Create<AggregationTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+AggregationTracer::AggregationTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+AggregationTracer::~AggregationTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+AggregationTracer::Connect()
+{
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  if (ndn == nullptr) {
+    return;
+  }
+  m_forwarder = ndn->getForwarder();
+
+  ndn->TraceConnectWithoutContext("InInterests", MakeCallback(&AggregationTracer::InInterests, this));
+  ndn->TraceConnectWithoutContext("AggregatedInterests",
+                                  MakeCallback(&AggregationTracer::AggregatedInterests, this));
+  ndn->TraceConnectWithoutContext("OutInterests",
+                                  MakeCallback(&AggregationTracer::OutInterests, this));
+}
+
+void
+AggregationTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AggregationTracer::PeriodicPrinter, this);
+}
+
+void
+AggregationTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+  m_stats.clear();
+
+  m_printEvent = Simulator::Schedule(m_period, &AggregationTracer::PeriodicPrinter, this);
+}
+
+void
+AggregationTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Prefix"
+     << "\t"
+
+     << "Type"
+     << "\t"
+     << "Packets";
+}
+
+void
+AggregationTracer::Print(std::ostream& os) const
+{
+  NDN_PROFILE_ZONE("AggregationTracer::Print");
+  NDN_ALLOCATION_SCOPE(TRACERS);
+  double time = Simulator::Now().ToDouble(Time::S);
+  for (const auto& stats : m_stats) {
+    auto printLine = [&] (const char* type, double value) {
+      os << time << "\t" << m_node << "\t" << stats.first << "\t" << type << "\t" << value << "\n";
+    };
+
+    printLine("InInterests", stats.second.m_inInterests);
+    printLine("AggregatedInterests", stats.second.m_aggregatedInterests);
+    printLine("OutInterests", stats.second.m_outInterests);
+    printLine("AggregationRatio", stats.second.m_inInterests > 0 ?
+              stats.second.m_aggregatedInterests / stats.second.m_inInterests : 0);
+  }
+}
+
+aggregation::Stats&
+AggregationTracer::GetStats(const Interest& interest)
+{
+  shared_ptr<nfd::fib::Entry> fibEntry = m_forwarder->getFib().findLongestPrefixMatch(interest.getName());
+  return m_stats.insert({fibEntry->getPrefix(), aggregation::Stats{0, 0, 0}}).first->second;
+}
+
+void
+AggregationTracer::InInterests(const Interest& interest, const Face&)
+{
+  GetStats(interest).m_inInterests++;
+}
+
+void
+AggregationTracer::AggregatedInterests(const nfd::pit::Entry&, const Face&,
+                                       const Interest& interest)
+{
+  GetStats(interest).m_aggregatedInterests++;
+}
+
+void
+AggregationTracer::OutInterests(const Interest& interest, const Face&)
+{
+  GetStats(interest).m_outInterests++;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,10 @@
  **/
 
 #include "ndn-app-delay-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
+#include "ndn-binary-trace.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -25,6 +29,7 @@
 #include "ns3/callback.h"
 
 #include "apps/ndn-app.hpp"
+#include "utils/ndn-mpi.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
@@ -49,7 +54,7 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, Time summaryPeriod/* = Time(0)*/)
 {
   using namespace boost;
   using namespace std;
@@ -57,10 +62,9 @@ AppDelayTracer::InstallAll(const std::string& file)
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -71,12 +75,21 @@ AppDelayTracer::InstallAll(const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !summaryPeriod.IsZero());
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, summaryPeriod);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -86,7 +99,8 @@ AppDelayTracer::InstallAll(const std::string& file)
 }
 
 void
-AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
+AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file,
+                        Time summaryPeriod/* = Time(0)*/)
 {
   using namespace boost;
   using namespace std;
@@ -94,10 +108,9 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -108,12 +121,21 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !summaryPeriod.IsZero());
+  }
+
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<AppDelayTracer> trace = Install(*node, outputStream, summaryPeriod);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -123,18 +145,20 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 }
 
 void
-AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
+AppDelayTracer::Install(Ptr<Node> node, const std::string& file, Time summaryPeriod/* = Time(0)*/)
 {
+  if (!mpi::IsLocalNode(node))
+    return; // simulated by another MPI process
+
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<AppDelayTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -145,10 +169,16 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<AppDelayTracer> trace = Install(node, outputStream);
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !summaryPeriod.IsZero());
+  }
+
+  Ptr<AppDelayTracer> trace = Install(node, outputStream, summaryPeriod);
+  trace->m_binary = binary;
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -158,11 +188,15 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 }
 
 Ptr<AppDelayTracer>
-AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time summaryPeriod/* = Time(0)*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  if (!summaryPeriod.IsZero()) {
+    trace->SetSummaryPeriod(summaryPeriod);
+  }
 
   return trace;
 }
@@ -192,7 +226,41 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& n
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+AppDelayTracer::SetSummaryPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+
+  // the last, possibly partial, period; keeps the tracer until then
+  Simulator::ScheduleDestroy(&AppDelayTracer::PrintLastSummaries, Ptr<AppDelayTracer>(this));
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  PrintSummaries();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PrintLastSummaries()
+{
+  m_printEvent.Cancel();
+  PrintSummaries();
+
+  if (m_binary != nullptr) {
+    m_binary->Flush();
+  }
+  m_os->flush();
+}
 
 void
 AppDelayTracer::Connect()
@@ -209,6 +277,30 @@ AppDelayTracer::Connect()
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (!m_period.IsZero()) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Type"
+       << "\t"
+       << "Count"
+       << "\t"
+       << "Mean"
+       << "\t"
+       << "P50"
+       << "\t"
+       << "P95"
+       << "\t"
+       << "P99"
+       << "\t"
+       << "Max"
+       << "";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -234,6 +326,19 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  NDN_PROFILE_ZONE("AppDelayTracer::LastRetransmittedInterestDataDelay");
+  NDN_ALLOCATION_SCOPE(TRACERS);
+  if (!m_period.IsZero()) {
+    m_summaries[app->GetId()].lastDelay.Record(std::max<int64_t>(0, delay.GetNanoSeconds()));
+    return;
+  }
+
+  if (m_binary != nullptr) {
+    *m_binary << Simulator::Now() << m_node << app->GetId() << seqno << "LastDelay" << delay
+              << delay.ToDouble(Time::US) << static_cast<uint32_t>(1) << hopCount;
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +350,21 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  NDN_PROFILE_ZONE("AppDelayTracer::FirstInterestDataDelay");
+  NDN_ALLOCATION_SCOPE(TRACERS);
+  if (!m_period.IsZero()) {
+    Summary& summary = m_summaries[app->GetId()];
+    summary.fullDelay.Record(std::max<int64_t>(0, delay.GetNanoSeconds()));
+    summary.retxCount.Record(retxCount);
+    return;
+  }
+
+  if (m_binary != nullptr) {
+    *m_binary << Simulator::Now() << m_node << app->GetId() << seqno << "FullDelay" << delay
+              << delay.ToDouble(Time::US) << retxCount << hopCount;
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
@@ -252,5 +372,82 @@ AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
         << "\t" << hopCount << "\n";
 }
 
+void
+AppDelayTracer::PrintSummaries()
+{
+  Time now = Simulator::Now();
+
+  for (auto& i : m_summaries) {
+    // delays are recorded in nanoseconds and printed in seconds
+    std::tuple<const char*, const HdrHistogram*, double> histograms[] = {
+      std::make_tuple("LastDelay", &i.second.lastDelay, 1e-9),
+      std::make_tuple("FullDelay", &i.second.fullDelay, 1e-9),
+      std::make_tuple("RetxCount", &i.second.retxCount, 1.0)};
+
+    for (const auto& histogram : histograms) {
+      const char* type = std::get<0>(histogram);
+      const HdrHistogram& h = *std::get<1>(histogram);
+      double scale = std::get<2>(histogram);
+      if (h.GetCount() == 0)
+        continue;
+
+      double values[] = {h.GetMean() * scale,
+                         h.GetPercentile(50) * scale,
+                         h.GetPercentile(95) * scale,
+                         h.GetPercentile(99) * scale,
+                         h.GetMax() * scale};
+
+      if (m_binary != nullptr) {
+        *m_binary << now << m_node << i.first << type
+                  << static_cast<uint32_t>(h.GetCount());
+        for (double value : values) {
+          *m_binary << value;
+        }
+        continue;
+      }
+
+      *m_os << now.ToDouble(Time::S) << "\t" << m_node << "\t" << i.first << "\t"
+            << type << "\t" << h.GetCount();
+      for (double value : values) {
+        *m_os << "\t" << value;
+      }
+      *m_os << "\n";
+    }
+
+    i.second.lastDelay.Reset();
+    i.second.fullDelay.Reset();
+    i.second.retxCount.Reset();
+  }
+}
+
+shared_ptr<BinaryTraceWriter>
+AppDelayTracer::CreateBinaryWriter(shared_ptr<std::ostream> outputStream, bool isSummary)
+{
+  if (isSummary) {
+    return BinaryTraceWriter::Create(outputStream, {
+        {"Time", BinaryTraceWriter::TIME},
+        {"Node", BinaryTraceWriter::NAME},
+        {"AppId", BinaryTraceWriter::UINT32},
+        {"Type", BinaryTraceWriter::NAME},
+        {"Count", BinaryTraceWriter::UINT32},
+        {"Mean", BinaryTraceWriter::DOUBLE},
+        {"P50", BinaryTraceWriter::DOUBLE},
+        {"P95", BinaryTraceWriter::DOUBLE},
+        {"P99", BinaryTraceWriter::DOUBLE},
+        {"Max", BinaryTraceWriter::DOUBLE}});
+  }
+
+  return BinaryTraceWriter::Create(outputStream, {
+      {"Time", BinaryTraceWriter::TIME},
+      {"Node", BinaryTraceWriter::NAME},
+      {"AppId", BinaryTraceWriter::UINT32},
+      {"SeqNo", BinaryTraceWriter::UINT32},
+      {"Type", BinaryTraceWriter::NAME},
+      {"DelayS", BinaryTraceWriter::TIME},
+      {"DelayUS", BinaryTraceWriter::DOUBLE},
+      {"RetxCount", BinaryTraceWriter::UINT32},
+      {"HopCount", BinaryTraceWriter::INT32}});
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -28,8 +28,11 @@
 #include <ns3/event-id.h>
 #include <ns3/node-container.h>
 
+#include "ns3/ndnSIM/utils/ndn-hdr-histogram.hpp"
+
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -39,57 +42,68 @@ class Packet;
 namespace ndn {
 
 class App;
+class BinaryTraceWriter;
 
 /**
  * @ingroup ndn-tracers
  * @brief Tracer to obtain application-level delays
+ *
+ * If the name of the trace file ends with ".bin", the trace is written in the binary format of
+ * BinaryTraceWriter, with the same columns.
+ *
+ * With a non-zero summary period, the tracer writes no row per Data.  It keeps HdrHistogram
+ * histograms of the delays and of the number of transmissions per application instead, and
+ * every period writes one row per delay type (LastDelay, FullDelay) and one for RetxCount: the
+ * number of samples and their mean, median, 95th and 99th percentile and maximum (delays in
+ * seconds).  Applications without Data in the period have no rows.
  */
 class AppDelayTracer : public SimpleRefCount<AppDelayTracer> {
 public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
-   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * In a distributed simulation, only the nodes of this process are traced, into a file of its
+   * own (see mpi::GetLocalFileName).
    *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param summaryPeriod If non-zero, how often summaries are written instead of raw rows
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, Time summaryPeriod = Time(0));
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   *
+   * @param summaryPeriod If non-zero, how often summaries are written instead of raw rows
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file);
+  Install(const NodeContainer& nodes, const std::string& file, Time summaryPeriod = Time(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param file File to which traces will be written.  If filename is -, then std::out is used
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param summaryPeriod If non-zero, how often summaries are written instead of raw rows
    */
   static void
-  Install(Ptr<Node> node, const std::string& file);
+  Install(Ptr<Node> node, const std::string& file, Time summaryPeriod = Time(0));
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
    *
    * @param nodes Nodes on which to install tracer
    * @param outputStream Smart pointer to a stream
-   * @param averagingPeriod How often data will be written into the trace file (default, every half
-   *        second)
+   * @param summaryPeriod If non-zero, how often summaries are written instead of raw rows
    *
    * @returns a tuple of reference to output stream and list of tracers.
    *          !!! Attention !!! This tuple needs to be preserved for the lifetime of simulation,
    *          otherwise SEGFAULTs are inevitable
    */
   static Ptr<AppDelayTracer>
-  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream, Time summaryPeriod = Time(0));
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -138,11 +152,43 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  SetSummaryPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
+  /**
+   * @brief Write the summaries of the last period, at Simulator::Destroy
+   */
+  void
+  PrintLastSummaries();
+
+  /**
+   * @brief Write summaries of the applications with samples, and reset the histograms
+   */
+  void
+  PrintSummaries();
+
+  static shared_ptr<BinaryTraceWriter>
+  CreateBinaryWriter(shared_ptr<std::ostream> outputStream, bool isSummary);
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_binary; ///< @brief if set, the trace is written in binary
+
+  struct Summary {
+    HdrHistogram lastDelay; ///< @brief nanoseconds
+    HdrHistogram fullDelay; ///< @brief nanoseconds
+    HdrHistogram retxCount;
+  };
+
+  Time m_period; ///< @brief if non-zero, summaries are written with this period
+  EventId m_printEvent;
+  std::map<uint32_t, Summary> m_summaries; ///< @brief per application id
 };
 
 } // namespace ndn
@@ -0,0 +1,580 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-async-trace-writer.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/version.hpp>
+
+// the zstd filter is available since Boost 1.70
+#if BOOST_VERSION >= 107000
+#define NDNSIM_HAVE_ZSTD_FILTER
+#include <boost/iostreams/filter/zstd.hpp>
+#endif // BOOST_VERSION >= 107000
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+namespace async_trace {
+
+/**
+ * @brief Interval at which the I/O thread drains the rings if not woken up earlier
+ */
+const std::chrono::milliseconds BATCH_INTERVAL(10);
+
+/**
+ * @brief Single-producer single-consumer ring of octets
+ */
+class Ring : noncopyable
+{
+public:
+  explicit
+  Ring(size_t capacity)
+  {
+    size_t size = 64;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_buffer.resize(size);
+    m_mask = size - 1;
+  }
+
+  size_t
+  capacity() const
+  {
+    return m_buffer.size();
+  }
+
+  size_t
+  size() const
+  {
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Copy as many of the @p n octets into the ring as fit (producer)
+   * @return number of octets copied
+   */
+  size_t
+  push(const char* data, size_t n)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    n = std::min(n, m_buffer.size() - (head - tail));
+
+    size_t offset = head & m_mask;
+    size_t first = std::min(n, m_buffer.size() - offset);
+    std::memcpy(&m_buffer[offset], data, first);
+    std::memcpy(&m_buffer[0], data + first, n - first);
+
+    m_head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  /**
+   * @brief Pass all octets in the ring to @p sink, in at most two pieces (consumer)
+   */
+  template<class Sink>
+  void
+  pop(const Sink& sink)
+  {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t n = head - tail;
+    if (n == 0) {
+      return;
+    }
+
+    size_t offset = tail & m_mask;
+    size_t first = std::min(n, m_buffer.size() - offset);
+    sink(&m_buffer[offset], first);
+    if (n > first) {
+      sink(&m_buffer[0], n - first);
+    }
+
+    m_tail.store(head, std::memory_order_release);
+  }
+
+private:
+  std::vector<char> m_buffer;
+  size_t m_mask;
+  std::atomic<size_t> m_head{0}; ///< number of octets ever pushed
+  std::atomic<size_t> m_tail{0}; ///< number of octets ever popped
+};
+
+/**
+ * @brief Compressed file, the compressor and the file are closed by the destructor
+ */
+class CompressedFileStream : public boost::iostreams::filtering_ostream
+{
+public:
+  ~CompressedFileStream()
+  {
+    reset(); // writes the trailer of the compressed stream and closes the file
+  }
+};
+
+enum Compression {
+  NONE,
+  GZIP,
+  ZSTD
+};
+
+static Compression
+getCompression(const std::string& file, size_t* suffixLength = nullptr)
+{
+  static const std::pair<std::string, Compression> suffixes[] = {
+    {".gz", GZIP},
+    {".zst", ZSTD}
+  };
+
+  for (const auto& suffix : suffixes) {
+    if (file.size() > suffix.first.size() &&
+        file.compare(file.size() - suffix.first.size(), suffix.first.size(), suffix.first) == 0) {
+      if (suffixLength != nullptr) {
+        *suffixLength = suffix.first.size();
+      }
+      return suffix.second;
+    }
+  }
+  return NONE;
+}
+
+/**
+ * @brief Add the (de)compressor of @p file to the chain, if any
+ * @return false if the compression is not supported
+ */
+template<class Chain>
+static bool
+pushCompression(Chain& chain, Compression compression, bool isOutput)
+{
+  switch (compression) {
+  case GZIP:
+    if (isOutput) {
+      chain.push(boost::iostreams::gzip_compressor());
+    }
+    else {
+      chain.push(boost::iostreams::gzip_decompressor());
+    }
+    return true;
+  case ZSTD:
+#ifdef NDNSIM_HAVE_ZSTD_FILTER
+    if (isOutput) {
+      // level 3 (zstd's default) compresses traces about as well as gzip -6, several times faster
+      chain.push(boost::iostreams::zstd_compressor(boost::iostreams::zstd_params(3)));
+    }
+    else {
+      chain.push(boost::iostreams::zstd_decompressor());
+    }
+    return true;
+#else
+    return false;
+#endif // NDNSIM_HAVE_ZSTD_FILTER
+  case NONE:
+  default:
+    return true;
+  }
+}
+
+static std::unique_ptr<std::ostream>
+openFile(const std::string& file)
+{
+  Compression compression = getCompression(file);
+  if (compression != NONE) {
+    std::unique_ptr<CompressedFileStream> os(new CompressedFileStream);
+    if (!pushCompression(*os, compression, true)) {
+      return nullptr;
+    }
+
+    boost::iostreams::file_sink sink(file, std::ios_base::out | std::ios_base::trunc |
+                                             std::ios_base::binary);
+    if (!sink.is_open()) {
+      return nullptr;
+    }
+    os->push(sink);
+    return std::move(os);
+  }
+
+  std::unique_ptr<std::ofstream> os(new std::ofstream(file.c_str(), std::ios_base::out |
+                                                                 std::ios_base::trunc));
+  if (!os->is_open()) {
+    return nullptr;
+  }
+  return std::move(os);
+}
+
+/**
+ * @brief Trace file written by the I/O thread
+ */
+struct Channel : noncopyable
+{
+  Channel(std::unique_ptr<std::ostream> file, size_t ringSize)
+    : ring(ringSize)
+    , file(std::move(file))
+  {
+  }
+
+  Ring ring;
+  std::unique_ptr<std::ostream> file;
+  bool isClosed = false;   ///< the stream is destroyed, guarded by the mutex of the Backend
+  bool isDetached = false; ///< the Backend is destroyed, the file is written synchronously
+};
+
+/**
+ * @brief Owner of the I/O thread
+ */
+class Backend : noncopyable
+{
+public:
+  static Backend&
+  get()
+  {
+    static Backend backend;
+    return backend;
+  }
+
+  ~Backend()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_thread.joinable()) {
+        return;
+      }
+      m_isStopping = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+
+    // streams destroyed after the backend (static destruction) write their files themselves
+    for (const shared_ptr<Channel>& channel : m_channels) {
+      channel->isDetached = true;
+    }
+  }
+
+  void
+  add(shared_ptr<Channel> channel)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_channels.push_back(channel);
+    if (!m_thread.joinable()) {
+      m_thread = std::thread(&Backend::run, this);
+    }
+  }
+
+  void
+  write(Channel& channel, const char* data, size_t n)
+  {
+    while (true) {
+      size_t nPushed = channel.ring.push(data, n);
+      data += nPushed;
+      n -= nPushed;
+      if (n == 0) {
+        break;
+      }
+
+      // ring is full, wait for the I/O thread to drain it
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_isDrainRequested = true;
+      m_wakeup.notify_one();
+      m_drained.wait_for(lock, std::chrono::milliseconds(1));
+    }
+
+    if (channel.ring.size() > channel.ring.capacity() / 2 && !m_isDrainRequested.exchange(true)) {
+      m_wakeup.notify_one();
+    }
+  }
+
+  void
+  flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) {
+      return;
+    }
+
+    uint64_t request = ++m_nFlushRequests;
+    m_wakeup.notify_one();
+    m_drained.wait(lock, [this, request] { return m_nFlushesCompleted >= request; });
+  }
+
+  /**
+   * @brief Write the rest of the file and close it
+   */
+  void
+  close(shared_ptr<Channel> channel)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      channel->isClosed = true;
+    }
+    flush();
+  }
+
+private:
+  void
+  run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_wakeup.wait_for(lock, BATCH_INTERVAL, [this] {
+          return m_isDrainRequested || m_nFlushRequests > m_nFlushesCompleted || m_isStopping;
+        });
+
+      m_isDrainRequested = false;
+      uint64_t request = m_nFlushRequests;
+      bool isFlushing = request > m_nFlushesCompleted || m_isStopping;
+      bool isStopping = m_isStopping;
+      std::vector<std::pair<shared_ptr<Channel>, bool>> channels;
+      for (const shared_ptr<Channel>& channel : m_channels) {
+        channels.push_back(std::make_pair(channel, channel->isClosed));
+      }
+      lock.unlock();
+
+      for (const auto& channel : channels) {
+        std::ostream& file = *channel.first->file;
+        channel.first->ring.pop([&file] (const char* data, size_t n) { file.write(data, n); });
+        if (channel.second) {
+          channel.first->file.reset();
+        }
+        else if (isFlushing) {
+          file.flush();
+        }
+      }
+
+      lock.lock();
+      m_channels.remove_if([] (const shared_ptr<Channel>& channel) {
+          return channel->isClosed && channel->file == nullptr;
+        });
+      m_nFlushesCompleted = request;
+      m_drained.notify_all();
+
+      if (isStopping) {
+        break;
+      }
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;  ///< wakes up the I/O thread
+  std::condition_variable m_drained; ///< notified after every pass of the I/O thread
+  std::list<shared_ptr<Channel>> m_channels;
+  std::thread m_thread;
+
+  std::atomic<bool> m_isDrainRequested{false};
+  uint64_t m_nFlushRequests = 0;
+  uint64_t m_nFlushesCompleted = 0;
+  bool m_isStopping = false;
+};
+
+/**
+ * @brief Stream buffer that copies everything into the ring of the channel
+ */
+class RingStreamBuf : public std::streambuf
+{
+public:
+  explicit
+  RingStreamBuf(shared_ptr<Channel> channel)
+    : m_channel(channel)
+  {
+  }
+
+protected:
+  virtual std::streamsize
+  xsputn(const char* data, std::streamsize n)
+  {
+    if (m_channel->isDetached) {
+      m_channel->file->write(data, n);
+    }
+    else {
+      Backend::get().write(*m_channel, data, n);
+    }
+    return n;
+  }
+
+  virtual int_type
+  overflow(int_type c)
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      char octet = traits_type::to_char_type(c);
+      xsputn(&octet, 1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  /**
+   * @brief Wait until the I/O thread wrote everything to disk, for std::ostream::flush
+   */
+  virtual int
+  sync()
+  {
+    if (m_channel->isDetached) {
+      m_channel->file->flush();
+    }
+    else {
+      Backend::get().flush();
+    }
+    return 0;
+  }
+
+private:
+  shared_ptr<Channel> m_channel;
+};
+
+class AsyncStream : public std::ostream
+{
+public:
+  explicit
+  AsyncStream(shared_ptr<Channel> channel)
+    : std::ostream(nullptr)
+    , m_channel(channel)
+    , m_buffer(channel)
+  {
+    rdbuf(&m_buffer);
+  }
+
+  ~AsyncStream()
+  {
+    if (m_channel->isDetached) {
+      m_channel->file.reset();
+    }
+    else {
+      Backend::get().close(m_channel);
+    }
+  }
+
+private:
+  shared_ptr<Channel> m_channel;
+  RingStreamBuf m_buffer;
+};
+
+static bool g_isEnabled = false;
+static size_t g_ringSize = 0;
+static EventId g_flushEvent;
+
+} // namespace async_trace
+
+using namespace async_trace;
+
+void
+AsyncTraceWriter::Enable(size_t ringSize)
+{
+  g_isEnabled = true;
+  g_ringSize = ringSize;
+}
+
+void
+AsyncTraceWriter::Disable()
+{
+  g_isEnabled = false;
+}
+
+bool
+AsyncTraceWriter::IsEnabled()
+{
+  return g_isEnabled;
+}
+
+shared_ptr<std::ostream>
+AsyncTraceWriter::Open(const std::string& file)
+{
+  std::unique_ptr<std::ostream> os = openFile(file);
+  if (os == nullptr) {
+    return nullptr;
+  }
+
+  if (!g_isEnabled) {
+    return shared_ptr<std::ostream>(std::move(os));
+  }
+
+  auto channel = make_shared<Channel>(std::move(os), g_ringSize);
+  Backend::get().add(channel);
+
+  if (Simulator::IsExpired(g_flushEvent)) {
+    g_flushEvent = Simulator::ScheduleDestroy(&AsyncTraceWriter::Flush);
+  }
+
+  return make_shared<AsyncStream>(channel);
+}
+
+void
+AsyncTraceWriter::Flush()
+{
+  Backend::get().flush();
+}
+
+shared_ptr<std::istream>
+AsyncTraceWriter::OpenForReading(const std::string& file)
+{
+  Compression compression = getCompression(file);
+  if (compression == NONE) {
+    auto is = make_shared<std::ifstream>(file.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!is->is_open()) {
+      return nullptr;
+    }
+    return is;
+  }
+
+  auto is = make_shared<boost::iostreams::filtering_istream>();
+  if (!pushCompression(*is, compression, false)) {
+    return nullptr;
+  }
+
+  boost::iostreams::file_source source(file, std::ios_base::in | std::ios_base::binary);
+  if (!source.is_open()) {
+    return nullptr;
+  }
+  is->push(source);
+  return is;
+}
+
+bool
+AsyncTraceWriter::IsCompressionSupported(const std::string& file)
+{
+  boost::iostreams::filtering_ostream chain;
+  return pushCompression(chain, getCompression(file), true);
+}
+
+std::string
+AsyncTraceWriter::StripCompressionSuffix(const std::string& file)
+{
+  size_t suffixLength = 0;
+  if (getCompression(file, &suffixLength) == NONE) {
+    return file;
+  }
+  return file.substr(0, file.size() - suffixLength);
+}
+
+} // namespace ndn
+} // namespace ns3
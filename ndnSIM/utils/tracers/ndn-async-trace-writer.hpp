@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_ASYNC_TRACE_WRITER_H
+#define NDN_ASYNC_TRACE_WRITER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iostream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Backend of the tracers for writing trace files
+ *
+ * The tracers open their files with Open().  By default, the returned stream writes into the
+ * file synchronously, as std::ofstream does.  After Enable(), files are written by a background
+ * I/O thread instead: every stream has a single-producer single-consumer ring buffer, and
+ * writing to the stream only copies the formatted octets into the ring.  The I/O thread
+ * periodically drains the rings of all open files in large batches.  When a ring is full, the
+ * simulator waits for the I/O thread to drain it.
+ *
+ * Files whose names end with ".gz" are compressed with gzip, and files whose names end with
+ * ".zst" with zstd (if Boost.Iostreams has the zstd filter, i.e., Boost 1.70 or later).  The
+ * compression runs on the I/O thread, if enabled.
+ *
+ * Everything written to the trace files is on disk:
+ *  - when the stream is destroyed (e.g., by L3RateTracer::Destroy), which waits for the I/O
+ *    thread to write and close the file
+ *  - after Flush(), which is also called from Simulator::Destroy, or std::ostream::flush
+ *  - at exit
+ *
+ * The I/O thread is started when the first asynchronous file is opened; processes forked
+ * afterwards (e.g., by ParameterSweep) must not write to the files opened before the fork.
+ *
+ * Example:
+ *
+ *     ndn::AsyncTraceWriter::Enable();
+ *     ndn::L3RateTracer::InstallAll("rate-trace.txt.zst", Seconds(1.0));
+ */
+class AsyncTraceWriter {
+public:
+  /**
+   * @brief Write the trace files opened from now on asynchronously
+   * @param ringSize size of the ring buffer of every file, in octets
+   */
+  static void
+  Enable(size_t ringSize = 4 * 1024 * 1024);
+
+  /**
+   * @brief Write the trace files opened from now on synchronously (default)
+   */
+  static void
+  Disable();
+
+  static bool
+  IsEnabled();
+
+  /**
+   * @brief Open a trace file for writing, replacing its content
+   * @return stream to write the trace into, or nullptr if the file cannot be opened or its
+   *         compression is not supported
+   */
+  static shared_ptr<std::ostream>
+  Open(const std::string& file);
+
+  /**
+   * @brief Wait until everything written to the asynchronous trace files is written to disk
+   *
+   * Must be called from the simulator thread.
+   */
+  static void
+  Flush();
+
+  /**
+   * @brief Open a trace file for reading, decompressing it if its name has a compression suffix
+   * @return stream to read the trace from, or nullptr if the file cannot be opened
+   */
+  static shared_ptr<std::istream>
+  OpenForReading(const std::string& file);
+
+  /**
+   * @brief Whether the compression selected by the suffix of @p file is available in this build
+   */
+  static bool
+  IsCompressionSupported(const std::string& file);
+
+  /**
+   * @brief Strip the compression suffix (".gz" or ".zst"), if any, from the file name
+   */
+  static std::string
+  StripCompressionSuffix(const std::string& file);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ASYNC_TRACE_WRITER_H
@@ -0,0 +1,431 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-binary-trace.hpp"
+#include "ndn-async-trace-writer.hpp"
+
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace ns3 {
+namespace ndn {
+
+namespace binary_trace {
+
+const char MAGIC[8] = {'N', 'D', 'N', 'B', 'T', 'R', 'C', '1'};
+
+const char DICTIONARY_ENTRY = 'D';
+const char ROWS = 'R';
+
+struct Header
+{
+  char magic[8];
+  uint32_t nColumns;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 16, "Header must not be padded");
+
+static size_t
+getWidth(BinaryTraceWriter::ColumnType type)
+{
+  switch (type) {
+  case BinaryTraceWriter::TIME:
+  case BinaryTraceWriter::DOUBLE:
+    return 8;
+  case BinaryTraceWriter::NAME:
+  case BinaryTraceWriter::INT32:
+  case BinaryTraceWriter::UINT32:
+  case BinaryTraceWriter::FLOAT:
+    return 4;
+  }
+  throw std::runtime_error("Unknown column type " + std::to_string(type));
+}
+
+template<class T>
+static void
+appendValue(std::vector<char>& buffer, const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+template<class T>
+static void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<class T>
+static T
+readValue(std::istream& is)
+{
+  T value;
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw std::runtime_error("Binary trace is truncated");
+  }
+  return value;
+}
+
+static std::string
+readString(std::istream& is)
+{
+  std::string value(readValue<uint32_t>(is), '\0');
+  if (!is.read(&value[0], value.size())) {
+    throw std::runtime_error("Binary trace is truncated");
+  }
+  return value;
+}
+
+static void
+flushOnDestroy(std::weak_ptr<BinaryTraceWriter> writer, std::weak_ptr<std::ostream> os)
+{
+  shared_ptr<BinaryTraceWriter> w = writer.lock();
+  shared_ptr<std::ostream> s = os.lock();
+  if (w != nullptr && s != nullptr) {
+    w->Flush();
+    s->flush();
+  }
+}
+
+} // namespace binary_trace
+
+using namespace binary_trace;
+
+shared_ptr<BinaryTraceWriter>
+BinaryTraceWriter::Create(shared_ptr<std::ostream> os, const std::vector<Column>& columns)
+{
+  auto writer = make_shared<BinaryTraceWriter>(os, columns);
+  Simulator::ScheduleDestroy(&flushOnDestroy, std::weak_ptr<BinaryTraceWriter>(writer),
+                             std::weak_ptr<std::ostream>(os));
+  return writer;
+}
+
+bool
+BinaryTraceWriter::IsBinaryFile(const std::string& file)
+{
+  const std::string suffix = ".bin";
+  const std::string name = AsyncTraceWriter::StripCompressionSuffix(file);
+  return name.size() > suffix.size() &&
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+BinaryTraceWriter::BinaryTraceWriter(shared_ptr<std::ostream> os,
+                                     const std::vector<Column>& columns, size_t nBlockRows)
+  : m_os(os)
+  , m_columns(columns)
+  , m_nBlockRows(std::max<size_t>(nBlockRows, 1))
+  , m_values(columns.size())
+  , m_nRows(0)
+  , m_column(0)
+{
+  NS_ASSERT(!m_columns.empty());
+
+  Header header;
+  std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+  header.nColumns = m_columns.size();
+  header.reserved = 0;
+  m_os->write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    writeValue<uint8_t>(*m_os, m_columns[i].type);
+    writeValue<uint32_t>(*m_os, m_columns[i].name.size());
+    m_os->write(m_columns[i].name.data(), m_columns[i].name.size());
+    m_values[i].reserve(m_nBlockRows * getWidth(m_columns[i].type));
+  }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+  Flush();
+  m_os->flush();
+}
+
+template<class T>
+void
+BinaryTraceWriter::Append(ColumnType type, const T& value)
+{
+  NS_ASSERT_MSG(m_columns[m_column].type == type,
+                "Value does not match the type of column " << m_columns[m_column].name);
+
+  appendValue(m_values[m_column], value);
+  if (++m_column == m_columns.size()) {
+    m_column = 0;
+    if (++m_nRows == m_nBlockRows) {
+      Flush();
+    }
+  }
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::operator<<(const Time& value)
+{
+  Append<int64_t>(TIME, value.GetNanoSeconds());
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::operator<<(const std::string& value)
+{
+  auto entry = m_dictionary.emplace(value, m_dictionary.size());
+  if (entry.second) {
+    m_newEntries.push_back(DICTIONARY_ENTRY);
+    appendValue<uint32_t>(m_newEntries, entry.first->second);
+    appendValue<uint32_t>(m_newEntries, value.size());
+    m_newEntries.insert(m_newEntries.end(), value.begin(), value.end());
+  }
+
+  Append<uint32_t>(NAME, entry.first->second);
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::operator<<(int32_t value)
+{
+  Append(INT32, value);
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::operator<<(uint32_t value)
+{
+  Append(UINT32, value);
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::operator<<(double value)
+{
+  if (m_columns[m_column].type == FLOAT) {
+    Append(FLOAT, static_cast<float>(value));
+  }
+  else {
+    Append(DOUBLE, value);
+  }
+  return *this;
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+  NS_ASSERT_MSG(m_column == 0, "Incomplete row");
+
+  // dictionary entries precede the first block that refers to them
+  m_os->write(m_newEntries.data(), m_newEntries.size());
+  m_newEntries.clear();
+
+  if (m_nRows == 0) {
+    return;
+  }
+
+  writeValue(*m_os, ROWS);
+  writeValue<uint32_t>(*m_os, m_nRows);
+  for (std::vector<char>& values : m_values) {
+    m_os->write(values.data(), values.size());
+    values.clear();
+  }
+  m_nRows = 0;
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_is(is)
+  , m_nRows(0)
+  , m_row(0)
+{
+  Header header;
+  if (!m_is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      !std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic)) {
+    throw std::runtime_error("Stream does not contain a binary trace");
+  }
+
+  for (uint32_t i = 0; i < header.nColumns; ++i) {
+    BinaryTraceWriter::Column column;
+    column.type = static_cast<BinaryTraceWriter::ColumnType>(readValue<uint8_t>(m_is));
+    getWidth(column.type); // validates the type
+    column.name = readString(m_is);
+    m_columns.push_back(column);
+  }
+  m_values.resize(m_columns.size());
+}
+
+void
+BinaryTraceReader::ConvertToText(const std::string& binaryFile, const std::string& textFile)
+{
+  shared_ptr<std::istream> is = AsyncTraceWriter::OpenForReading(binaryFile);
+  if (is == nullptr) {
+    throw std::runtime_error("File " + binaryFile + " cannot be opened for reading");
+  }
+  BinaryTraceReader reader(*is);
+
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open(textFile);
+  if (os == nullptr) {
+    throw std::runtime_error("File " + textFile + " cannot be opened for writing");
+  }
+
+  reader.PrintHeader(*os);
+  *os << "\n";
+  while (reader.Next()) {
+    reader.PrintRow(*os);
+  }
+  os->flush();
+  if (!*os) {
+    throw std::runtime_error("File " + textFile + " cannot be written");
+  }
+}
+
+bool
+BinaryTraceReader::Next()
+{
+  if (m_row + 1 < m_nRows) {
+    ++m_row;
+    return true;
+  }
+
+  while (true) {
+    char type = 0;
+    if (!m_is.get(type)) {
+      return false;
+    }
+
+    if (type == DICTIONARY_ENTRY) {
+      uint32_t id = readValue<uint32_t>(m_is);
+      if (id != m_dictionary.size()) {
+        throw std::runtime_error("Binary trace has a malformed dictionary");
+      }
+      m_dictionary.push_back(readString(m_is));
+    }
+    else if (type == ROWS) {
+      m_nRows = readValue<uint32_t>(m_is);
+      for (size_t i = 0; i < m_columns.size(); ++i) {
+        m_values[i].resize(m_nRows * getWidth(m_columns[i].type));
+        if (!m_is.read(m_values[i].data(), m_values[i].size())) {
+          throw std::runtime_error("Binary trace is truncated");
+        }
+      }
+      if (m_nRows > 0) {
+        m_row = 0;
+        return true;
+      }
+    }
+    else {
+      throw std::runtime_error("Binary trace has an unknown block type");
+    }
+  }
+}
+
+template<class T>
+T
+BinaryTraceReader::Get(size_t column) const
+{
+  NS_ASSERT(m_row < m_nRows);
+  T value;
+  std::memcpy(&value, m_values.at(column).data() + m_row * sizeof(T), sizeof(T));
+  return value;
+}
+
+Time
+BinaryTraceReader::GetTime(size_t column) const
+{
+  return NanoSeconds(Get<int64_t>(column));
+}
+
+const std::string&
+BinaryTraceReader::GetName(size_t column) const
+{
+  uint32_t id = Get<uint32_t>(column);
+  if (id >= m_dictionary.size()) {
+    throw std::runtime_error("Binary trace refers to an unknown dictionary entry");
+  }
+  return m_dictionary[id];
+}
+
+double
+BinaryTraceReader::GetNumber(size_t column) const
+{
+  switch (m_columns.at(column).type) {
+  case BinaryTraceWriter::TIME:
+    return GetTime(column).ToDouble(Time::S);
+  case BinaryTraceWriter::INT32:
+    return Get<int32_t>(column);
+  case BinaryTraceWriter::UINT32:
+    return Get<uint32_t>(column);
+  case BinaryTraceWriter::FLOAT:
+    return Get<float>(column);
+  case BinaryTraceWriter::DOUBLE:
+    return Get<double>(column);
+  case BinaryTraceWriter::NAME:
+    break;
+  }
+  throw std::invalid_argument("Column " + m_columns[column].name + " is not numeric");
+}
+
+void
+BinaryTraceReader::PrintHeader(std::ostream& os) const
+{
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    os << (i > 0 ? "\t" : "") << m_columns[i].name;
+  }
+}
+
+void
+BinaryTraceReader::PrintRow(std::ostream& os) const
+{
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    if (i > 0) {
+      os << "\t";
+    }
+
+    switch (m_columns[i].type) {
+    case BinaryTraceWriter::NAME:
+      os << GetName(i);
+      break;
+    case BinaryTraceWriter::INT32:
+      os << Get<int32_t>(i);
+      break;
+    case BinaryTraceWriter::UINT32:
+      os << Get<uint32_t>(i);
+      break;
+    case BinaryTraceWriter::DOUBLE: {
+      // counters such as the size of the content store are stored as doubles
+      double value = Get<double>(i);
+      if (value == std::floor(value) && std::abs(value) < 1e15) {
+        os << static_cast<int64_t>(value);
+      }
+      else {
+        os << value;
+      }
+      break;
+    }
+    default:
+      os << GetNumber(i);
+      break;
+    }
+  }
+  os << "\n";
+}
+
+} // namespace ndn
+} // namespace ns3
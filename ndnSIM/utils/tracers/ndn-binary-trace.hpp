@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_BINARY_TRACE_H
+#define NDN_BINARY_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of traces in a binary columnar format
+ *
+ * Text traces spend most of their size and much of their writing time on formatting numbers
+ * and repeating node names, face descriptions and record types on every row.  The binary
+ * format stores rows with a fixed schema in blocks: every block holds the values of one column
+ * for all of its rows, then those of the next column, each value with the fixed width of its
+ * column type.  Strings (NAME columns) are dictionary-encoded: the first occurrence of a string
+ * is written once as a dictionary entry, rows refer to it by a 32-bit id.
+ *
+ * Layout of the file (host byte order):
+ *
+ *     header:     "NDNBTRC1", uint32 number of columns, uint32 reserved
+ *     columns:    uint8 type, uint32 length of name, name
+ *     blocks:     'D' uint32 id, uint32 length, octets   (dictionary entry)
+ *                 'R' uint32 number of rows, values of column 0, values of column 1, ...
+ *
+ * Values are written in the order of the columns, e.g., for the columns Time, Node, Packets:
+ *
+ *     writer << Simulator::Now() << nodeName << packets;
+ *
+ * The tracers write this format when the name of the trace file ends with ".bin"; use
+ * BinaryTraceReader or the ndn-binary-trace-convert program to read it or convert it to the
+ * text format.
+ */
+class BinaryTraceWriter : noncopyable {
+public:
+  enum ColumnType : uint8_t {
+    TIME = 0,   ///< int64 nanoseconds, printed in seconds
+    NAME = 1,   ///< uint32 dictionary id
+    INT32 = 2,
+    UINT32 = 3,
+    FLOAT = 4,  ///< 32-bit floating point, enough for the 6 digits of the text traces
+    DOUBLE = 5
+  };
+
+  struct Column {
+    std::string name;
+    ColumnType type;
+  };
+
+  /**
+   * @brief Whether traces written into @p file should use the binary format
+   */
+  static bool
+  IsBinaryFile(const std::string& file);
+
+  /**
+   * @brief Create a writer whose buffered rows are also written to the stream, and the stream
+   *        flushed, when the simulation is destroyed (Simulator::Destroy)
+   */
+  static shared_ptr<BinaryTraceWriter>
+  Create(shared_ptr<std::ostream> os, const std::vector<Column>& columns);
+
+  /**
+   * @param os output stream, should be opened in binary mode
+   * @param columns schema of the rows
+   * @param nBlockRows number of rows buffered before a block is written
+   */
+  BinaryTraceWriter(shared_ptr<std::ostream> os, const std::vector<Column>& columns,
+                    size_t nBlockRows = 4096);
+
+  /**
+   * @brief Writes the buffered rows
+   */
+  ~BinaryTraceWriter();
+
+  BinaryTraceWriter&
+  operator<<(const Time& value);
+
+  BinaryTraceWriter&
+  operator<<(const std::string& value);
+
+  BinaryTraceWriter&
+  operator<<(const char* value)
+  {
+    return *this << std::string(value);
+  }
+
+  BinaryTraceWriter&
+  operator<<(int32_t value);
+
+  BinaryTraceWriter&
+  operator<<(uint32_t value);
+
+  /**
+   * @brief Append a value of a FLOAT or DOUBLE column
+   */
+  BinaryTraceWriter&
+  operator<<(double value);
+
+  /**
+   * @brief Write the buffered rows as a block
+   */
+  void
+  Flush();
+
+private:
+  template<class T>
+  void
+  Append(ColumnType type, const T& value);
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<Column> m_columns;
+  size_t m_nBlockRows;
+
+  std::vector<std::vector<char>> m_values; ///< buffered values of the current block, per column
+  size_t m_nRows;
+  size_t m_column; ///< column of the next value
+
+  std::unordered_map<std::string, uint32_t> m_dictionary;
+  std::vector<char> m_newEntries; ///< dictionary entries not written yet
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of traces written by BinaryTraceWriter
+ *
+ * Example:
+ *
+ *     std::ifstream is("rate-trace.bin", std::ios_base::binary);
+ *     BinaryTraceReader reader(is);
+ *     while (reader.Next()) {
+ *       std::cout << reader.GetTime(0) << " " << reader.GetName(1) << std::endl;
+ *     }
+ */
+class BinaryTraceReader : noncopyable {
+public:
+  /**
+   * @brief Read the header of the trace
+   * @throw std::runtime_error the stream does not contain a binary trace
+   */
+  explicit
+  BinaryTraceReader(std::istream& is);
+
+  /**
+   * @brief Convert a binary trace to the tab-separated text format of the tracers
+   * @throw std::runtime_error a file cannot be opened or the trace is malformed
+   */
+  static void
+  ConvertToText(const std::string& binaryFile, const std::string& textFile);
+
+  const std::vector<BinaryTraceWriter::Column>&
+  GetColumns() const
+  {
+    return m_columns;
+  }
+
+  /**
+   * @brief Advance to the next row
+   * @return false at the end of the trace
+   * @throw std::runtime_error the trace is truncated or malformed
+   */
+  bool
+  Next();
+
+  /**
+   * @brief Value of the TIME column @p column in the current row
+   */
+  Time
+  GetTime(size_t column) const;
+
+  /**
+   * @brief Value of the NAME column @p column in the current row
+   */
+  const std::string&
+  GetName(size_t column) const;
+
+  /**
+   * @brief Value of a numeric column in the current row; TIME values are in seconds
+   */
+  double
+  GetNumber(size_t column) const;
+
+  /**
+   * @brief Print the column names, separated by tabs
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+  /**
+   * @brief Print the current row as the text tracers do
+   */
+  void
+  PrintRow(std::ostream& os) const;
+
+private:
+  template<class T>
+  T
+  Get(size_t column) const;
+
+private:
+  std::istream& m_is;
+  std::vector<BinaryTraceWriter::Column> m_columns;
+  std::vector<std::string> m_dictionary;
+
+  std::vector<std::vector<char>> m_values;
+  size_t m_nRows;
+  size_t m_row; ///< current row, m_nRows before the first one
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_H
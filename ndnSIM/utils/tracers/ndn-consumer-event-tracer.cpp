@@ -0,0 +1,325 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-consumer-event-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ns3/node.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/mobility-model.h"
+
+#include "apps/ndn-app.hpp"
+#include "utils/ndn-mpi.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerEventTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<ConsumerEventTracer>>>>
+  g_tracers;
+
+void
+ConsumerEventTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+ConsumerEventTracer::InstallAll(const std::string& file)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<ConsumerEventTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<ConsumerEventTracer> trace = Install(*node, outputStream);
+    trace->m_binary = binary;
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+ConsumerEventTracer::Install(const NodeContainer& nodes, const std::string& file)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<ConsumerEventTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<ConsumerEventTracer> trace = Install(*node, outputStream);
+    trace->m_binary = binary;
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+ConsumerEventTracer::Install(Ptr<Node> node, const std::string& file)
+{
+  if (!mpi::IsLocalNode(node))
+    return; // simulated by another MPI process
+
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<ConsumerEventTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
+  Ptr<ConsumerEventTracer> trace = Install(node, outputStream);
+  trace->m_binary = binary;
+  tracers.push_back(trace);
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<ConsumerEventTracer>
+ConsumerEventTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<ConsumerEventTracer> trace = Create<ConsumerEventTracer>(outputStream, node);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+ConsumerEventTracer::ConsumerEventTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+  m_mobility = m_nodePtr->GetObject<MobilityModel>();
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+ConsumerEventTracer::ConsumerEventTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_os(os)
+{
+  m_nodePtr = Names::Find<Node>(node);
+  if (m_nodePtr != nullptr) {
+    m_mobility = m_nodePtr->GetObject<MobilityModel>();
+  }
+
+  Connect();
+}
+
+ConsumerEventTracer::~ConsumerEventTracer(){};
+
+void
+ConsumerEventTracer::Connect()
+{
+  Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/InterestSent",
+                                MakeCallback(&ConsumerEventTracer::InterestSent, this));
+
+  Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/DataReceived",
+                                MakeCallback(&ConsumerEventTracer::DataReceived, this));
+}
+
+void
+ConsumerEventTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "AppId"
+     << "\t"
+     << "Type"
+     << "\t"
+     << "Prefix"
+     << "\t"
+     << "SeqNo"
+     << "\t"
+     << "Rto"
+     << "\t"
+     << "X"
+     << "\t"
+     << "Y"
+     << "";
+}
+
+void
+ConsumerEventTracer::InterestSent(Ptr<App> app, const Name& name, uint32_t seqno, Time rto)
+{
+  Print(app, "Interest", name, seqno, rto);
+}
+
+void
+ConsumerEventTracer::DataReceived(Ptr<App> app, const Name& name, uint32_t seqno)
+{
+  Print(app, "Data", name, seqno, Time(0));
+}
+
+void
+ConsumerEventTracer::Print(Ptr<App> app, const char* type, const Name& name, uint32_t seqno,
+                           Time rto)
+{
+  Vector position;
+  if (m_mobility != nullptr) {
+    position = m_mobility->GetPosition();
+  }
+
+  if (m_binary != nullptr) {
+    *m_binary << Simulator::Now() << m_node << app->GetId() << type << GetPrefixUri(name)
+              << seqno << rto << position.x << position.y;
+    return;
+  }
+
+  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
+        << type << "\t" << GetPrefixUri(name) << "\t" << seqno << "\t" << rto.ToDouble(Time::S)
+        << "\t" << position.x << "\t" << position.y << "\n";
+}
+
+const std::string&
+ConsumerEventTracer::GetPrefixUri(const Name& name)
+{
+  bool hasSequenceNumber = !name.empty() && name.at(-1).isSequenceNumber();
+  size_t prefixSize = hasSequenceNumber ? name.size() - 1 : name.size();
+
+  if (m_lastPrefixUri.empty() || m_lastPrefix.size() != prefixSize
+      || !m_lastPrefix.isPrefixOf(name)) {
+    m_lastPrefix = name.getPrefix(prefixSize);
+    m_lastPrefixUri = m_lastPrefix.toUri();
+  }
+  return m_lastPrefixUri;
+}
+
+shared_ptr<BinaryTraceWriter>
+ConsumerEventTracer::CreateBinaryWriter(shared_ptr<std::ostream> outputStream)
+{
+  return BinaryTraceWriter::Create(outputStream, {
+      {"Time", BinaryTraceWriter::TIME},
+      {"Node", BinaryTraceWriter::NAME},
+      {"AppId", BinaryTraceWriter::UINT32},
+      {"Type", BinaryTraceWriter::NAME},
+      {"Prefix", BinaryTraceWriter::NAME},
+      {"SeqNo", BinaryTraceWriter::UINT32},
+      {"Rto", BinaryTraceWriter::TIME},
+      {"X", BinaryTraceWriter::DOUBLE},
+      {"Y", BinaryTraceWriter::DOUBLE}});
+}
+
+} // namespace ndn
+} // namespace ns3
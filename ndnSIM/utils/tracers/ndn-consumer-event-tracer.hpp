@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_CONSUMER_EVENT_TRACER_H
+#define NDN_CONSUMER_EVENT_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/node-container.h>
+
+#include <tuple>
+#include <list>
+
+namespace ns3 {
+
+class Node;
+class MobilityModel;
+
+namespace ndn {
+
+class App;
+class BinaryTraceWriter;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of the Interests sent and the Data received by consumers
+ *
+ * Records the InterestSent and DataReceived trace sources of Consumer: one row per
+ * (re)transmitted Interest with its RTO, and one per received Data, each with the position of
+ * the node.  The sequence number is recorded separately from the prefix of the name, so in the
+ * binary format (the name of the trace file ends with ".bin") every prefix is stored once in
+ * the dictionary of BinaryTraceWriter.
+ *
+ * The mobility model of the node is looked up when the tracer is created; the position is 0,0
+ * if the node has none.
+ */
+class ConsumerEventTracer : public SimpleRefCount<ConsumerEventTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * In a distributed simulation, only the nodes of this process are traced, into a file of its
+   * own (see mpi::GetLocalFileName).
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   */
+  static void
+  InstallAll(const std::string& file);
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   *
+   * @returns the tracer, which needs to be preserved for the lifetime of simulation
+   */
+  static Ptr<ConsumerEventTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to all consumers on the node using node's pointer
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  ConsumerEventTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all consumers on the node using node's name
+   * @param os        reference to the output stream
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  ConsumerEventTracer(shared_ptr<std::ostream> os, const std::string& node);
+
+  ~ConsumerEventTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+private:
+  void
+  Connect();
+
+  void
+  InterestSent(Ptr<App> app, const Name& name, uint32_t seqno, Time rto);
+
+  void
+  DataReceived(Ptr<App> app, const Name& name, uint32_t seqno);
+
+  void
+  Print(Ptr<App> app, const char* type, const Name& name, uint32_t seqno, Time rto);
+
+  /**
+   * @brief URI of the name without the sequence number, cached for the last prefix
+   */
+  const std::string&
+  GetPrefixUri(const Name& name);
+
+  static shared_ptr<BinaryTraceWriter>
+  CreateBinaryWriter(shared_ptr<std::ostream> outputStream);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+  Ptr<MobilityModel> m_mobility;
+
+  Name m_lastPrefix;
+  std::string m_lastPrefixUri;
+
+  shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_binary; ///< @brief if set, the trace is written in binary
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONSUMER_EVENT_TRACER_H
@@ -18,6 +18,10 @@
  **/
 
 #include "ndn-cs-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
+#include "ndn-binary-trace.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -26,12 +30,18 @@
 
 #include "apps/ndn-app.hpp"
 #include "model/cs/ndn-content-store.hpp"
+#include "model/ndn-l3-protocol.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/empty-policy.hpp"
+
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 #include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("ndn.CsTracer");
@@ -41,6 +51,71 @@ namespace ndn {
 
 static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<CsTracer>>>> g_tracers;
 
+namespace cs {
+
+/// @cond include_hidden
+struct PrefixStats : public Stats {
+  PrefixStats()
+  {
+    Reset();
+  }
+
+  explicit PrefixStats(const Name& prefix)
+    : m_prefix(prefix)
+  {
+    Reset();
+  }
+
+  bool
+  operator==(const PrefixStats& other) const
+  {
+    return m_prefix == other.m_prefix;
+  }
+
+  Name m_prefix;
+};
+/// @endcond
+
+} // namespace cs
+
+class CsTracer::PrefixTrie
+  : public ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<cs::PrefixStats>,
+                                    ndnSIM::empty_policy_traits> {
+public:
+  /**
+   * @brief Get stats of the prefixes looked up since the last reset, in name order
+   */
+  std::vector<const cs::PrefixStats*>
+  GetActive() const
+  {
+    std::vector<const cs::PrefixStats*> active;
+    parent_trie::const_recursive_iterator item(getTrie()), end(0);
+    for (; item != end; item++) {
+      const cs::PrefixStats& stats = item->payload();
+      if (stats.m_cacheHits + stats.m_cacheMisses > 0) {
+        active.push_back(&stats);
+      }
+    }
+    std::sort(active.begin(), active.end(),
+              [] (const cs::PrefixStats* a, const cs::PrefixStats* b) {
+                return a->m_prefix < b->m_prefix;
+              });
+    return active;
+  }
+
+  /**
+   * @brief Zero the counters, keeping the prefixes for the next periods
+   */
+  void
+  Reset()
+  {
+    parent_trie::recursive_iterator item(getTrie()), end(0);
+    for (; item != end; item++) {
+      item->payload().Reset();
+    }
+  }
+};
+
 void
 CsTracer::Destroy()
 {
@@ -48,7 +123,8 @@ CsTracer::Destroy()
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                     size_t prefixDepth/* = 0*/)
 {
   using namespace boost;
   using namespace std;
@@ -56,10 +132,9 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -70,12 +145,18 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, prefixDepth);
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod, prefixDepth);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -86,7 +167,7 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
 
 void
 CsTracer::Install(const NodeContainer& nodes, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/, size_t prefixDepth/* = 0*/)
 {
   using namespace boost;
   using namespace std;
@@ -94,10 +175,9 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -108,12 +188,18 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, prefixDepth);
+  }
+
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod, prefixDepth);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -124,7 +210,7 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
 
 void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/, size_t prefixDepth/* = 0*/)
 {
   using namespace boost;
   using namespace std;
@@ -132,10 +218,9 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   std::list<Ptr<CsTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -146,10 +231,16 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod);
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, prefixDepth);
+  }
+
+  Ptr<CsTracer> trace = Install(node, outputStream, averagingPeriod, prefixDepth);
+  trace->m_binary = binary;
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -160,11 +251,12 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
 
 Ptr<CsTracer>
 CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-                  Time averagingPeriod /* = Seconds (0.5)*/)
+                  Time averagingPeriod /* = Seconds (0.5)*/, size_t prefixDepth/* = 0*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
   Ptr<CsTracer> trace = Create<CsTracer>(outputStream, node);
+  trace->SetPrefixDepth(prefixDepth);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
@@ -177,6 +269,8 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_csBytes(0)
+  , m_prefixDepth(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -191,6 +285,8 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_csBytes(0)
+  , m_prefixDepth(0)
 {
   Connect();
 }
@@ -200,9 +296,17 @@ CsTracer::~CsTracer(){};
 void
 CsTracer::Connect()
 {
+  // ndnSIM 1.0 content store exists only if NFD's content store has been disabled
   Ptr<ContentStore> cs = m_nodePtr->GetObject<ContentStore>();
-  cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
-  cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+  if (cs != nullptr) {
+    cs->TraceConnectWithoutContext("CacheHits", MakeCallback(&CsTracer::CacheHits, this));
+    cs->TraceConnectWithoutContext("CacheMisses", MakeCallback(&CsTracer::CacheMisses, this));
+  }
+
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  if (ndn != nullptr) {
+    ndn->TraceConnectWithoutContext("CsBytes", MakeCallback(&CsTracer::CsBytes, this));
+  }
 
   Reset();
 }
@@ -215,10 +319,35 @@ CsTracer::SetAveragingPeriod(const Time& period)
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
 }
 
+void
+CsTracer::SetPrefixDepth(size_t prefixDepth)
+{
+  m_prefixDepth = prefixDepth;
+  if (m_prefixDepth > 0) {
+    m_prefixes = make_shared<PrefixTrie>();
+  }
+  else {
+    m_prefixes.reset();
+  }
+}
+
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_prefixes != nullptr) {
+    if (m_binary != nullptr) {
+      PrintPrefixesBinary(*m_binary);
+    }
+    else {
+      PrintPrefixes(*m_os);
+    }
+  }
+  else if (m_binary != nullptr) {
+    PrintBinary(*m_binary);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -227,6 +356,21 @@ CsTracer::PeriodicPrinter()
 void
 CsTracer::PrintHeader(std::ostream& os) const
 {
+  if (m_prefixes != nullptr) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "Prefix"
+       << "\t"
+       << "CacheHits"
+       << "\t"
+       << "CacheMisses"
+       << "\t"
+       << "HitRatio";
+    return;
+  }
+
   os << "Time"
      << "\t"
 
@@ -243,6 +387,9 @@ void
 CsTracer::Reset()
 {
   m_stats.Reset();
+  if (m_prefixes != nullptr) {
+    m_prefixes->Reset();
+  }
 }
 
 #define PRINTER(printName, fieldName)                                                              \
@@ -252,22 +399,109 @@ CsTracer::Reset()
 void
 CsTracer::Print(std::ostream& os) const
 {
+  NDN_PROFILE_ZONE("CsTracer::Print");
+  NDN_ALLOCATION_SCOPE(TRACERS);
   Time time = Simulator::Now();
 
   PRINTER("CacheHits", m_cacheHits);
   PRINTER("CacheMisses", m_cacheMisses);
+
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t"
+     << "CsBytes" << "\t" << m_csBytes << "\n";
+}
+
+void
+CsTracer::PrintBinary(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+  writer << time << m_node << "CacheHits" << m_stats.m_cacheHits;
+  writer << time << m_node << "CacheMisses" << m_stats.m_cacheMisses;
+  writer << time << m_node << "CsBytes" << static_cast<double>(m_csBytes);
+}
+
+void
+CsTracer::PrintPrefixes(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+
+  for (const cs::PrefixStats* stats : m_prefixes->GetActive()) {
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << stats->m_prefix << "\t"
+       << stats->m_cacheHits << "\t" << stats->m_cacheMisses << "\t"
+       << stats->m_cacheHits / (stats->m_cacheHits + stats->m_cacheMisses) << "\n";
+  }
 }
 
 void
-CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
+CsTracer::PrintPrefixesBinary(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+  for (const cs::PrefixStats* stats : m_prefixes->GetActive()) {
+    double hitRatio = stats->m_cacheHits / (stats->m_cacheHits + stats->m_cacheMisses);
+    writer << time << m_node << stats->m_prefix.toUri() << stats->m_cacheHits
+           << stats->m_cacheMisses << hitRatio;
+  }
+}
+
+shared_ptr<BinaryTraceWriter>
+CsTracer::CreateBinaryWriter(shared_ptr<std::ostream> outputStream, size_t prefixDepth)
+{
+  if (prefixDepth > 0) {
+    return BinaryTraceWriter::Create(outputStream, {
+        {"Time", BinaryTraceWriter::TIME},
+        {"Node", BinaryTraceWriter::NAME},
+        {"Prefix", BinaryTraceWriter::NAME},
+        {"CacheHits", BinaryTraceWriter::DOUBLE},
+        {"CacheMisses", BinaryTraceWriter::DOUBLE},
+        {"HitRatio", BinaryTraceWriter::DOUBLE}});
+  }
+
+  return BinaryTraceWriter::Create(outputStream, {
+      {"Time", BinaryTraceWriter::TIME},
+      {"Node", BinaryTraceWriter::NAME},
+      {"Type", BinaryTraceWriter::NAME},
+      {"Packets", BinaryTraceWriter::DOUBLE}});
+}
+
+void
+CsTracer::CacheHits(shared_ptr<const Interest> interest, shared_ptr<const Data>)
 {
   m_stats.m_cacheHits++;
+  if (m_prefixes != nullptr) {
+    PrefixLookup(interest->getName(), true);
+  }
 }
 
 void
-CsTracer::CacheMisses(shared_ptr<const Interest>)
+CsTracer::CacheMisses(shared_ptr<const Interest> interest)
 {
   m_stats.m_cacheMisses++;
+  if (m_prefixes != nullptr) {
+    PrefixLookup(interest->getName(), false);
+  }
+}
+
+void
+CsTracer::PrefixLookup(const Name& name, bool isHit)
+{
+  size_t depth = std::min(m_prefixDepth, name.size());
+  for (size_t i = 1; i <= depth; ++i) {
+    Name prefix = name.getPrefix(i);
+    PrefixTrie::iterator item = m_prefixes->insert(prefix, cs::PrefixStats(prefix)).first;
+    if (isHit) {
+      item->payload().m_cacheHits++;
+    }
+    else {
+      item->payload().m_cacheMisses++;
+    }
+  }
+}
+
+void
+CsTracer::CsBytes(size_t nBytes)
+{
+  m_csBytes = nBytes;
 }
 
 } // namespace ndn
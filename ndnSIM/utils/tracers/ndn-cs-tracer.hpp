@@ -55,9 +55,19 @@ struct Stats {
 /// @endcond
 }
 
+class BinaryTraceWriter;
+
 /**
  * @ingroup ndn-tracers
- * @brief NDN tracer for cache performance (hits and misses)
+ * @brief NDN tracer for cache performance (hits and misses) and size of NFD's content store
+ *
+ * If the name of the trace file ends with ".bin", the trace is written in the binary format of
+ * BinaryTraceWriter, with the same columns.
+ *
+ * If prefixDepth is not zero, the tracer instead aggregates cache hits and misses per name
+ * prefix, at every level from one up to prefixDepth components of the Interest name.  Each
+ * period only the prefixes that have been looked up are written, with columns Time, Node,
+ * Prefix, CacheHits, CacheMisses and HitRatio.
  */
 class CsTracer : public SimpleRefCount<CsTracer> {
 public:
@@ -67,6 +77,8 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param prefixDepth If not zero, maximum number of name components of the prefixes for which
+   *hits and misses are aggregated (default, per-node totals only)
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -74,7 +86,8 @@ public:
    *
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             size_t prefixDepth = 0);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -83,6 +96,8 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param prefixDepth If not zero, maximum number of name components of the prefixes for which
+   *hits and misses are aggregated (default, per-node totals only)
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -90,7 +105,8 @@ public:
    *
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file,
+          Time averagingPeriod = Seconds(0.5), size_t prefixDepth = 0);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -99,6 +115,8 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param prefixDepth If not zero, maximum number of name components of the prefixes for which
+   *hits and misses are aggregated (default, per-node totals only)
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -106,7 +124,8 @@ public:
    *
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          size_t prefixDepth = 0);
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -115,6 +134,8 @@ public:
    * @param outputStream Smart pointer to a stream
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param prefixDepth If not zero, maximum number of name components of the prefixes for which
+   *hits and misses are aggregated (default, per-node totals only)
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -122,7 +143,7 @@ public:
    */
   static Ptr<CsTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-          Time averagingPeriod = Seconds(0.5));
+          Time averagingPeriod = Seconds(0.5), size_t prefixDepth = 0);
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -178,25 +199,56 @@ private:
   void
   CacheMisses(shared_ptr<const Interest>);
 
+  void
+  CsBytes(size_t nBytes);
+
+  /**
+   * @brief Account a lookup of the name under each of its prefixes up to m_prefixDepth
+   */
+  void
+  PrefixLookup(const Name& name, bool isHit);
+
 private:
   void
   SetAveragingPeriod(const Time& period);
 
+  void
+  SetPrefixDepth(size_t prefixDepth);
+
   void
   Reset();
 
   void
   PeriodicPrinter();
 
+  void
+  PrintBinary(BinaryTraceWriter& writer) const;
+
+  void
+  PrintPrefixes(std::ostream& os) const;
+
+  void
+  PrintPrefixesBinary(BinaryTraceWriter& writer) const;
+
+  static shared_ptr<BinaryTraceWriter>
+  CreateBinaryWriter(shared_ptr<std::ostream> outputStream, size_t prefixDepth);
+
+  class PrefixTrie;
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_binary; ///< @brief if set, the trace is written in binary
 
   Time m_period;
   EventId m_printEvent;
   cs::Stats m_stats;
+  size_t m_csBytes; ///< @brief latest size of Data in NFD's content store, not reset per period
+
+  size_t m_prefixDepth;
+  shared_ptr<PrefixTrie> m_prefixes; ///< @brief per-prefix stats, set only if m_prefixDepth > 0
 };
 
 /**
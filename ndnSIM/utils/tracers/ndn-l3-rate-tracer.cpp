@@ -18,6 +18,10 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "utils/ndn-allocation-profiler.hpp"
+#include "utils/ndn-profiler-zones.hpp"
+#include "ndn-binary-trace.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -27,6 +31,7 @@
 #include "ns3/node-list.h"
 
 #include "daemon/table/pit-entry.hpp"
+#include "utils/ndn-mpi.hpp"
 
 #include <fstream>
 #include <boost/lexical_cast.hpp>
@@ -46,15 +51,15 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         const L3TraceFilter& filter /* = L3TraceFilter()*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -65,12 +70,23 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+    if (!filter.IsSampledNode(*node))
+      continue;
+
+    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod, filter);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -81,7 +97,8 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
 
 void
 L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TraceFilter& filter /* = L3TraceFilter()*/)
 {
   using namespace boost;
   using namespace std;
@@ -89,10 +106,9 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -103,12 +119,23 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+    if (!filter.IsSampledNode(*node))
+      continue;
+
+    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod, filter);
+    trace->m_binary = binary;
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -119,18 +146,21 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
 
 void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TraceFilter& filter /* = L3TraceFilter()*/)
 {
+  if (!mpi::IsLocalNode(node))
+    return; // simulated by another MPI process
+
   using namespace boost;
   using namespace std;
 
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
 
-    if (!os->is_open()) {
+    if (os == nullptr) {
       NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
       return;
     }
@@ -141,10 +171,16 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream);
+  }
+
+  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod, filter);
+  trace->m_binary = binary;
   tracers.push_back(trace);
 
-  if (tracers.size() > 0) {
+  if (tracers.size() > 0 && binary == nullptr) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -155,25 +191,31 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
 
 Ptr<L3RateTracer>
 L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+                      Time averagingPeriod /* = Seconds (0.5)*/,
+                      const L3TraceFilter& filter /* = L3TraceFilter()*/)
 {
   NS_LOG_DEBUG("Node: " << node->GetId());
 
-  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node);
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(outputStream, node, filter);
   trace->SetAveragingPeriod(averagingPeriod);
 
   return trace;
 }
 
-L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
-  : L3Tracer(node)
+L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node,
+                           const L3TraceFilter& filter /* = L3TraceFilter()*/)
+  : L3Tracer(node, filter, !filter.IsEverything())
   , m_os(os)
 {
+  if (filter.IsEverything()) {
+    m_hub = L3TraceHub::Get(node);
+  }
   SetAveragingPeriod(Seconds(1.0));
 }
 
-L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
-  : L3Tracer(node)
+L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node,
+                           const L3TraceFilter& filter /* = L3TraceFilter()*/)
+  : L3Tracer(node, filter)
   , m_os(os)
 {
   SetAveragingPeriod(Seconds(1.0));
@@ -195,7 +237,12 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_binary != nullptr) {
+    PrintBinary(*m_binary);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -245,21 +292,56 @@ const double alpha = 0.8;
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
                        + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
                                                                                                    \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nullptr) {                                                                    \
-    os << stats.first->getId() << "\t" << stats.first->getLocalUri() << "\t";                      \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+  printRow(time, stats.first.get(), printName, STATS(2).fieldName, STATS(3).fieldName,             \
+           STATS(0).fieldName, STATS(1).fieldName / 1024.0);
 
 void
-L3RateTracer::Print(std::ostream& os) const
+L3RateTracer::CollectFromHub() const
+{
+  // fields of Stats in the order of L3TraceHub::Counter
+  static double Stats::*const FIELDS[L3TraceHub::N_COUNTERS] = {
+    &Stats::m_inInterests,
+    &Stats::m_outInterests,
+    &Stats::m_inData,
+    &Stats::m_outData,
+    &Stats::m_satisfiedInterests,
+    &Stats::m_timedOutInterests,
+    &Stats::m_outSatisfiedInterests,
+    &Stats::m_outTimedOutInterests,
+  };
+
+  const std::vector<L3TraceHub::Counters>& counters = m_hub->GetCounters();
+  m_collected.resize(counters.size());
+
+  for (size_t slot = 0; slot < counters.size(); ++slot) {
+    const L3TraceHub::Counters& now = counters[slot];
+    L3TraceHub::Counters& last = m_collected[slot];
+
+    // like the per-packet sinks, no row for all faces before the first satisfied or timed out
+    if (slot == 0 && now.packets[L3TraceHub::SATISFIED_INTERESTS] == 0 &&
+        now.packets[L3TraceHub::TIMED_OUT_INTERESTS] == 0)
+      continue;
+
+    auto& stats = m_stats[m_hub->GetFace(slot)];
+    for (int counter = 0; counter < L3TraceHub::N_COUNTERS; ++counter) {
+      std::get<0>(stats).*FIELDS[counter] +=
+        m_weight * (now.packets[counter] - last.packets[counter]);
+      std::get<1>(stats).*FIELDS[counter] += m_weight * (now.bytes[counter] - last.bytes[counter]);
+    }
+    last = now;
+  }
+}
+
+template<class RowPrinter>
+void
+L3RateTracer::PrintRows(const RowPrinter& printRow) const
 {
   Time time = Simulator::Now();
 
+  if (m_hub != nullptr) {
+    CollectFromHub();
+  }
+
   for (auto& stats : m_stats) {
     if (stats.first == nullptr)
       continue;
@@ -287,73 +369,123 @@ L3RateTracer::Print(std::ostream& os) const
   }
 }
 
+void
+L3RateTracer::Print(std::ostream& os) const
+{
+  NDN_PROFILE_ZONE("L3RateTracer::Print");
+  NDN_ALLOCATION_SCOPE(TRACERS);
+  PrintRows([this, &os] (const Time& time, const Face* face, const char* type, double packets,
+                         double kilobytes, double packetsRaw, double kilobytesRaw) {
+      os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+      if (face != nullptr) {
+        os << face->getId() << "\t" << face->getLocalUri() << "\t";
+      }
+      else {
+        os << "-1\tall\t";
+      }
+      os << type << "\t" << packets << "\t" << kilobytes << "\t"
+         << packetsRaw << "\t" << kilobytesRaw << "\n";
+    });
+}
+
+void
+L3RateTracer::PrintBinary(BinaryTraceWriter& writer) const
+{
+  PrintRows([this, &writer] (const Time& time, const Face* face, const char* type, double packets,
+                             double kilobytes, double packetsRaw, double kilobytesRaw) {
+      writer << time << m_node;
+      if (face != nullptr) {
+        writer << static_cast<int32_t>(face->getId()) << face->getLocalUri().toString();
+      }
+      else {
+        writer << static_cast<int32_t>(-1) << "all";
+      }
+      writer << type << packets << kilobytes << packetsRaw << kilobytesRaw;
+    });
+}
+
+shared_ptr<BinaryTraceWriter>
+L3RateTracer::CreateBinaryWriter(shared_ptr<std::ostream> outputStream)
+{
+  return BinaryTraceWriter::Create(outputStream, {
+      {"Time", BinaryTraceWriter::TIME},
+      {"Node", BinaryTraceWriter::NAME},
+      {"FaceId", BinaryTraceWriter::INT32},
+      {"FaceDescr", BinaryTraceWriter::NAME},
+      {"Type", BinaryTraceWriter::NAME},
+      {"Packets", BinaryTraceWriter::FLOAT},
+      {"Kilobytes", BinaryTraceWriter::FLOAT},
+      {"PacketRaw", BinaryTraceWriter::FLOAT},
+      {"KilobytesRaw", BinaryTraceWriter::FLOAT}});
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outInterests++;
+  std::get<0>(m_stats[face.shared_from_this()]).m_outInterests += m_weight;
   if (interest.hasWire()) {
     std::get<1>(m_stats[face.shared_from_this()]).m_outInterests +=
-      interest.wireEncode().size();
+      m_weight * interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inInterests++;
+  std::get<0>(m_stats[face.shared_from_this()]).m_inInterests += m_weight;
   if (interest.hasWire()) {
     std::get<1>(m_stats[face.shared_from_this()]).m_inInterests +=
-      interest.wireEncode().size();
+      m_weight * interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_outData++;
+  std::get<0>(m_stats[face.shared_from_this()]).m_outData += m_weight;
   if (data.hasWire()) {
     std::get<1>(m_stats[face.shared_from_this()]).m_outData +=
-      data.wireEncode().size();
+      m_weight * data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  std::get<0>(m_stats[face.shared_from_this()]).m_inData++;
+  std::get<0>(m_stats[face.shared_from_this()]).m_inData += m_weight;
   if (data.hasWire()) {
     std::get<1>(m_stats[face.shared_from_this()]).m_inData +=
-      data.wireEncode().size();
+      m_weight * data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nullptr]).m_satisfiedInterests++;
+  std::get<0>(m_stats[nullptr]).m_satisfiedInterests += m_weight;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_satisfiedInterests ++;
+    std::get<0>(m_stats[in.getFace()]).m_satisfiedInterests += m_weight;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outSatisfiedInterests ++;
+    std::get<0>(m_stats[out.getFace()]).m_outSatisfiedInterests += m_weight;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nullptr]).m_timedOutInterests++;
+  std::get<0>(m_stats[nullptr]).m_timedOutInterests += m_weight;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    std::get<0>(m_stats[in.getFace()]).m_timedOutInterests++;
+    std::get<0>(m_stats[in.getFace()]).m_timedOutInterests += m_weight;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    std::get<0>(m_stats[out.getFace()]).m_outTimedOutInterests++;
+    std::get<0>(m_stats[out.getFace()]).m_outTimedOutInterests += m_weight;
   }
 }
 
@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-l3-trace-hub.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -31,26 +32,43 @@
 #include <tuple>
 #include <map>
 #include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class BinaryTraceWriter;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * If the name of the trace file ends with ".bin", the trace is written in the binary format of
+ * BinaryTraceWriter, with the same columns.
+ *
+ * With an L3TraceFilter, only the sampled nodes get tracers and only packets under the
+ * filter's prefixes are counted; faces without such packets have no rows.
+ *
+ * Without a filter, tracers attached to the node pointer read the counters of the
+ * L3TraceHub of the node when they print, instead of being called for every packet.
  */
 class L3RateTracer : public L3Tracer {
 public:
   /**
    * @brief Helper method to install tracers on all simulation nodes
    *
+   * In a distributed simulation, only the nodes of this process are traced, into a file of its
+   * own (see mpi::GetLocalFileName).
+   *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param filter Nodes and packets to trace (default, everything)
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -59,9 +77,11 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param filter Nodes and packets to trace (default, everything)
    */
   static void
-  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(const NodeContainer& nodes, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Helper method to install tracers on a specific simulation node
@@ -70,9 +90,12 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param filter Packets to trace (default, everything); the node is traced even if it is
+   *        not sampled by the filter
    */
   static void
-  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5));
+  Install(Ptr<Node> node, const std::string& file, Time averagingPeriod = Seconds(0.5),
+          const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Explicit request to remove all statically created tracers
@@ -87,15 +110,19 @@ public:
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
    * @param node  pointer to the node
+   * @param filter  packets to trace
    */
-  L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
+  L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node,
+               const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Trace constructor that attaches to the node using node name
    * @param os        reference to the output stream
    * @param nodeName  name of the node registered using Names::Add
+   * @param filter  packets to trace
    */
-  L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
+  L3RateTracer(shared_ptr<std::ostream> os, const std::string& node,
+               const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Destructor
@@ -116,7 +143,7 @@ public:
    */
   static Ptr<L3RateTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
-          Time averagingPeriod = Seconds(0.5));
+          Time averagingPeriod = Seconds(0.5), const L3TraceFilter& filter = L3TraceFilter());
 
   // from L3Tracer
   virtual void
@@ -155,12 +182,35 @@ private:
   void
   Reset();
 
+  /**
+   * @brief Add the counters of the hub since the last call to the stats of the period
+   */
+  void
+  CollectFromHub() const;
+
+  /**
+   * @brief Update the averaged rates and pass every row of the current period to @p printRow
+   */
+  template<class RowPrinter>
+  void
+  PrintRows(const RowPrinter& printRow) const;
+
+  void
+  PrintBinary(BinaryTraceWriter& writer) const;
+
+  static shared_ptr<BinaryTraceWriter>
+  CreateBinaryWriter(shared_ptr<std::ostream> outputStream);
+
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_binary; ///< @brief if set, the trace is written in binary
   Time m_period;
   EventId m_printEvent;
 
   mutable std::map<shared_ptr<const Face>, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
+
+  Ptr<L3TraceHub> m_hub; ///< @brief if set, the source of the stats
+  mutable std::vector<L3TraceHub::Counters> m_collected; ///< @brief counters of the last collection
 };
 
 } // namespace ndn
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-l3-trace-filter.hpp"
+
+#include "ns3/node.h"
+#include "ns3/rng-seed-manager.h"
+
+#include "utils/trie/trie-with-policy.hpp"
+#include "utils/trie/empty-policy.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace ns3 {
+namespace ndn {
+
+class L3TraceFilter::PrefixTrie
+  : public ndnSIM::trie_with_policy<Name, ndnSIM::non_pointer_traits<bool>,
+                                    ndnSIM::empty_policy_traits> {
+};
+
+/**
+ * @brief Mix the bits of the value (finalizer of splitmix64)
+ */
+static uint64_t
+mix(uint64_t value)
+{
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+static uint64_t
+getThreshold(double rate)
+{
+  if (rate >= 1.0)
+    return std::numeric_limits<uint64_t>::max();
+  return static_cast<uint64_t>(rate * std::numeric_limits<uint64_t>::max());
+}
+
+static void
+checkRate(double rate)
+{
+  if (!(rate > 0.0 && rate <= 1.0))
+    throw std::invalid_argument("Sampling rate must be in (0, 1]");
+}
+
+L3TraceFilter::L3TraceFilter()
+  : m_nodeSamplingRate(1.0)
+  , m_packetSamplingRate(1.0)
+  , m_packetThreshold(getThreshold(1.0))
+{
+}
+
+L3TraceFilter::~L3TraceFilter()
+{
+}
+
+L3TraceFilter&
+L3TraceFilter::AddPrefix(const Name& prefix)
+{
+  m_prefixNames.push_back(prefix);
+
+  // copies of the filter share the trie, build a new one
+  shared_ptr<PrefixTrie> prefixes = make_shared<PrefixTrie>();
+  for (const Name& name : m_prefixNames) {
+    prefixes->insert(name, true);
+  }
+  m_prefixes = prefixes;
+  return *this;
+}
+
+L3TraceFilter&
+L3TraceFilter::SetNodeSamplingRate(double rate)
+{
+  checkRate(rate);
+  m_nodeSamplingRate = rate;
+  return *this;
+}
+
+L3TraceFilter&
+L3TraceFilter::SetPacketSamplingRate(double rate)
+{
+  checkRate(rate);
+  m_packetSamplingRate = rate;
+  m_packetThreshold = getThreshold(rate);
+  return *this;
+}
+
+bool
+L3TraceFilter::IsEverything() const
+{
+  return m_prefixes == nullptr && m_nodeSamplingRate >= 1.0 && m_packetSamplingRate >= 1.0;
+}
+
+bool
+L3TraceFilter::IsSampledNode(Ptr<const Node> node) const
+{
+  if (m_nodeSamplingRate >= 1.0)
+    return true;
+
+  uint64_t hash = mix(mix(node->GetId()) ^ RngSeedManager::GetRun());
+  return hash < getThreshold(m_nodeSamplingRate);
+}
+
+bool
+L3TraceFilter::Accept(const Name& name) const
+{
+  if (m_prefixes != nullptr && m_prefixes->longest_prefix_match(name) == m_prefixes->end())
+    return false;
+
+  if (m_packetSamplingRate >= 1.0)
+    return true;
+
+  return mix(std::hash<Name>()(name)) < m_packetThreshold;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_L3_TRACE_FILTER_H
+#define NDN_L3_TRACE_FILTER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Selection of the nodes and packets recorded by network-layer tracers
+ *
+ * A default constructed filter selects everything, and the tracers then connect their trace
+ * sinks directly.  Otherwise, every packet is first matched against the filter:
+ *
+ * - prefixes: only packets whose names are under one of the prefixes are recorded.  The
+ *   prefixes are kept in a trie of name components, so a name outside the filter usually costs
+ *   one lookup of its first component;
+ * - packet sampling rate: only this fraction of the names is recorded, chosen by a hash of the
+ *   name, so an Interest and its Data are recorded (or not) together on every node.  Recorded
+ *   packets are counted with the weight 1 / rate, so the traced rates estimate all packets;
+ * - node sampling rate: InstallAll and Install(NodeContainer) of the tracers install tracers on
+ *   this fraction of the nodes only, chosen by a hash of the node id and of the run number
+ *   (RngSeedManager::SetRun).
+ *
+ * Example:
+ *
+ *     L3TraceFilter filter;
+ *     filter.AddPrefix("/S/addr_0").SetNodeSamplingRate(0.1);
+ *     L3RateTracer::InstallAll("rate-trace.txt", Seconds(1.0), filter);
+ */
+class L3TraceFilter {
+public:
+  L3TraceFilter();
+
+  ~L3TraceFilter();
+
+  /**
+   * @brief Record packets under the prefix (in addition to the prefixes added before)
+   */
+  L3TraceFilter&
+  AddPrefix(const Name& prefix);
+
+  /**
+   * @throw std::invalid_argument @p rate is not in (0, 1]
+   */
+  L3TraceFilter&
+  SetNodeSamplingRate(double rate);
+
+  /**
+   * @throw std::invalid_argument @p rate is not in (0, 1]
+   */
+  L3TraceFilter&
+  SetPacketSamplingRate(double rate);
+
+  /**
+   * @brief Whether the filter selects all nodes and all packets
+   */
+  bool
+  IsEverything() const;
+
+  bool
+  IsSampledNode(Ptr<const Node> node) const;
+
+  /**
+   * @brief Whether packets with the name are recorded
+   */
+  bool
+  Accept(const Name& name) const;
+
+  /**
+   * @brief Weight of a recorded packet, 1 / packet sampling rate
+   */
+  double
+  GetWeight() const
+  {
+    return 1.0 / m_packetSamplingRate;
+  }
+
+private:
+  class PrefixTrie;
+
+  std::vector<Name> m_prefixNames;
+  shared_ptr<PrefixTrie> m_prefixes; ///< @brief nullptr if all prefixes are recorded
+  double m_nodeSamplingRate;
+  double m_packetSamplingRate;
+  uint64_t m_packetThreshold; ///< @brief hashes below are sampled
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_L3_TRACE_FILTER_H
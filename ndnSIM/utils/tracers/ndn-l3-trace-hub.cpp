@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-l3-trace-hub.hpp"
+
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+
+#include "ns3/node.h"
+#include "ns3/callback.h"
+
+#include "daemon/table/pit-entry.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(L3TraceHub);
+
+TypeId
+L3TraceHub::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::L3TraceHub")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<L3TraceHub>();
+  return tid;
+}
+
+Ptr<L3TraceHub>
+L3TraceHub::Get(Ptr<Node> node)
+{
+  Ptr<L3TraceHub> hub = node->GetObject<L3TraceHub>();
+  if (hub != 0)
+    return hub;
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  NS_ASSERT_MSG(l3 != 0, "NDN stack should be installed on node " << node->GetId());
+
+  hub = CreateObject<L3TraceHub>();
+  hub->m_counters.resize(1);
+  hub->m_faces.resize(1);
+  node->AggregateObject(hub);
+
+  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3TraceHub::OutInterests, hub));
+  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3TraceHub::InInterests, hub));
+  l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3TraceHub::OutData, hub));
+  l3->TraceConnectWithoutContext("InData", MakeCallback(&L3TraceHub::InData, hub));
+  l3->TraceConnectWithoutContext("SatisfiedInterests",
+                                 MakeCallback(&L3TraceHub::SatisfiedInterests, hub));
+  l3->TraceConnectWithoutContext("TimedOutInterests",
+                                 MakeCallback(&L3TraceHub::TimedOutInterests, hub));
+  return hub;
+}
+
+void
+L3TraceHub::DoDispose()
+{
+  m_counters.clear();
+  m_faces.clear();
+  m_slots.clear();
+  Object::DoDispose();
+}
+
+size_t
+L3TraceHub::GetSlot(const Face& face)
+{
+  // face ids of a forwarder are small and assigned in sequence
+  size_t id = static_cast<size_t>(face.getId());
+  if (id >= m_slots.size())
+    m_slots.resize(id + 1, 0);
+
+  uint32_t& slot = m_slots[id];
+  if (slot == 0) {
+    slot = m_counters.size();
+    m_counters.emplace_back();
+    m_faces.push_back(face.shared_from_this());
+  }
+  return slot;
+}
+
+void
+L3TraceHub::Count(const Face& face, Counter counter, const Block* wire)
+{
+  Counters& counters = m_counters[GetSlot(face)];
+  ++counters.packets[counter];
+  if (wire != nullptr)
+    counters.bytes[counter] += wire->size();
+}
+
+void
+L3TraceHub::OutInterests(const Interest& interest, const Face& face)
+{
+  Count(face, OUT_INTERESTS, interest.hasWire() ? &interest.wireEncode() : nullptr);
+}
+
+void
+L3TraceHub::InInterests(const Interest& interest, const Face& face)
+{
+  Count(face, IN_INTERESTS, interest.hasWire() ? &interest.wireEncode() : nullptr);
+}
+
+void
+L3TraceHub::OutData(const Data& data, const Face& face)
+{
+  Count(face, OUT_DATA, data.hasWire() ? &data.wireEncode() : nullptr);
+}
+
+void
+L3TraceHub::InData(const Data& data, const Face& face)
+{
+  Count(face, IN_DATA, data.hasWire() ? &data.wireEncode() : nullptr);
+}
+
+void
+L3TraceHub::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
+{
+  ++m_counters[0].packets[SATISFIED_INTERESTS];
+
+  for (const auto& in : entry.getInRecords()) {
+    Count(*in.getFace(), SATISFIED_INTERESTS, nullptr);
+  }
+
+  for (const auto& out : entry.getOutRecords()) {
+    Count(*out.getFace(), OUT_SATISFIED_INTERESTS, nullptr);
+  }
+}
+
+void
+L3TraceHub::TimedOutInterests(const nfd::pit::Entry& entry)
+{
+  ++m_counters[0].packets[TIMED_OUT_INTERESTS];
+
+  for (const auto& in : entry.getInRecords()) {
+    Count(*in.getFace(), TIMED_OUT_INTERESTS, nullptr);
+  }
+
+  for (const auto& out : entry.getOutRecords()) {
+    Count(*out.getFace(), OUT_TIMED_OUT_INTERESTS, nullptr);
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
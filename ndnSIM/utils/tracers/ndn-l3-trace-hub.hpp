@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_L3_TRACE_HUB_H
+#define NDN_L3_TRACE_HUB_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <vector>
+
+namespace nfd {
+namespace pit {
+class Entry;
+} // namespace pit
+} // namespace nfd
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Per-node counters of the network-layer events, shared by all tracers of the node
+ *
+ * Every tracer connected to the trace sources of L3Protocol on its own is called for every
+ * packet, and looks the face up in its own map.  The hub of a node is the only subscriber
+ * instead: it counts every event into the slot of its face in a flat array, found by face id,
+ * and the tracers read the counters when they print (see L3RateTracer).
+ *
+ * The counters are cumulative, so tracers with different periods can share them: every tracer
+ * keeps a copy of the counters it printed last, and prints the difference.  Slot 0 holds the
+ * satisfied and timed out Interests of the whole node.
+ */
+class L3TraceHub : public Object {
+public:
+  enum Counter {
+    IN_INTERESTS,
+    OUT_INTERESTS,
+    IN_DATA,
+    OUT_DATA,
+    SATISFIED_INTERESTS,
+    TIMED_OUT_INTERESTS,
+    OUT_SATISFIED_INTERESTS,
+    OUT_TIMED_OUT_INTERESTS,
+    N_COUNTERS
+  };
+
+  struct Counters {
+    uint64_t packets[N_COUNTERS] = {};
+    uint64_t bytes[N_COUNTERS] = {}; ///< @brief of packets with a wire encoding
+  };
+
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get the hub of the node, aggregating it to the node and connecting it on first use
+   *
+   * The NDN stack must be installed on the node.
+   */
+  static Ptr<L3TraceHub>
+  Get(Ptr<Node> node);
+
+  /**
+   * @brief Counters of every slot, to be read as the events happen
+   */
+  const std::vector<Counters>&
+  GetCounters() const
+  {
+    return m_counters;
+  }
+
+  /**
+   * @brief Face of the slot, nullptr for slot 0
+   */
+  shared_ptr<const Face>
+  GetFace(size_t slot) const
+  {
+    return m_faces[slot];
+  }
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  size_t
+  GetSlot(const Face& face);
+
+  void
+  Count(const Face& face, Counter counter, const Block* wire);
+
+  void
+  OutInterests(const Interest& interest, const Face& face);
+
+  void
+  InInterests(const Interest& interest, const Face& face);
+
+  void
+  OutData(const Data& data, const Face& face);
+
+  void
+  InData(const Data& data, const Face& face);
+
+  void
+  SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&);
+
+  void
+  TimedOutInterests(const nfd::pit::Entry& entry);
+
+private:
+  std::vector<Counters> m_counters;
+  std::vector<shared_ptr<const Face>> m_faces; ///< @brief of the slots
+  std::vector<uint32_t> m_slots;               ///< @brief by face id, 0 if the face has none
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_L3_TRACE_HUB_H
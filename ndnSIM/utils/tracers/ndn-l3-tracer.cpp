@@ -27,16 +27,26 @@
 #include <boost/lexical_cast.hpp>
 
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "daemon/table/pit-entry.hpp"
 
 namespace ns3 {
 namespace ndn {
 
-L3Tracer::L3Tracer(Ptr<Node> node)
+L3Tracer::L3Tracer(Ptr<Node> node, const L3TraceFilter& filter/* = L3TraceFilter()*/)
+  : L3Tracer(node, filter, true)
+{
+}
+
+L3Tracer::L3Tracer(Ptr<Node> node, const L3TraceFilter& filter, bool shouldConnect)
   : m_nodePtr(node)
+  , m_filter(filter)
+  , m_weight(filter.GetWeight())
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
-  Connect();
+  if (shouldConnect) {
+    Connect();
+  }
 
   std::string name = Names::FindName(node);
   if (!name.empty()) {
@@ -44,8 +54,10 @@ L3Tracer::L3Tracer(Ptr<Node> node)
   }
 }
 
-L3Tracer::L3Tracer(const std::string& node)
+L3Tracer::L3Tracer(const std::string& node, const L3TraceFilter& filter/* = L3TraceFilter()*/)
   : m_node(node)
+  , m_filter(filter)
+  , m_weight(filter.GetWeight())
 {
   Connect();
 }
@@ -57,6 +69,20 @@ L3Tracer::Connect()
 {
   Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
 
+  if (!m_filter.IsEverything()) {
+    l3->TraceConnectWithoutContext("OutInterests",
+                                   MakeCallback(&L3Tracer::FilteredOutInterests, this));
+    l3->TraceConnectWithoutContext("InInterests",
+                                   MakeCallback(&L3Tracer::FilteredInInterests, this));
+    l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::FilteredOutData, this));
+    l3->TraceConnectWithoutContext("InData", MakeCallback(&L3Tracer::FilteredInData, this));
+    l3->TraceConnectWithoutContext("SatisfiedInterests",
+                                   MakeCallback(&L3Tracer::FilteredSatisfiedInterests, this));
+    l3->TraceConnectWithoutContext("TimedOutInterests",
+                                   MakeCallback(&L3Tracer::FilteredTimedOutInterests, this));
+    return;
+  }
+
   l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&L3Tracer::OutInterests, this));
   l3->TraceConnectWithoutContext("InInterests", MakeCallback(&L3Tracer::InInterests, this));
   l3->TraceConnectWithoutContext("OutData", MakeCallback(&L3Tracer::OutData, this));
@@ -70,5 +96,48 @@ L3Tracer::Connect()
                                  MakeCallback(&L3Tracer::TimedOutInterests, this));
 }
 
+void
+L3Tracer::FilteredOutInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter.Accept(interest.getName()))
+    OutInterests(interest, face);
+}
+
+void
+L3Tracer::FilteredInInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter.Accept(interest.getName()))
+    InInterests(interest, face);
+}
+
+void
+L3Tracer::FilteredOutData(const Data& data, const Face& face)
+{
+  if (m_filter.Accept(data.getName()))
+    OutData(data, face);
+}
+
+void
+L3Tracer::FilteredInData(const Data& data, const Face& face)
+{
+  if (m_filter.Accept(data.getName()))
+    InData(data, face);
+}
+
+void
+L3Tracer::FilteredSatisfiedInterests(const nfd::pit::Entry& entry, const Face& face,
+                                     const Data& data)
+{
+  if (m_filter.Accept(entry.getName()))
+    SatisfiedInterests(entry, face, data);
+}
+
+void
+L3Tracer::FilteredTimedOutInterests(const nfd::pit::Entry& entry)
+{
+  if (m_filter.Accept(entry.getName()))
+    TimedOutInterests(entry);
+}
+
 } // namespace ndn
 } // namespace ns3
@@ -23,6 +23,8 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include "ndn-l3-trace-filter.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
@@ -48,14 +50,16 @@ public:
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param node  pointer to the node
+   * @param filter  packets to trace, packets outside are not passed to the tracer
    */
-  L3Tracer(Ptr<Node> node);
+  L3Tracer(Ptr<Node> node, const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Trace constructor that attaches to the node using node name
    * @param nodeName  name of the node registered using Names::Add
+   * @param filter  packets to trace, packets outside are not passed to the tracer
    */
-  L3Tracer(const std::string& node);
+  L3Tracer(const std::string& node, const L3TraceFilter& filter = L3TraceFilter());
 
   /**
    * @brief Destructor
@@ -79,6 +83,12 @@ public:
   Print(std::ostream& os) const = 0;
 
 protected:
+  /**
+   * @brief Trace constructor for tracers that get the events of the node elsewhere
+   * @param shouldConnect whether to connect to the trace sources of the node
+   */
+  L3Tracer(Ptr<Node> node, const L3TraceFilter& filter, bool shouldConnect);
+
   void
   Connect();
 
@@ -100,10 +110,33 @@ protected:
   virtual void
   TimedOutInterests(const nfd::pit::Entry&) = 0;
 
+private:
+  // sinks checking the filter before passing the packet to the tracer
+  void
+  FilteredOutInterests(const Interest&, const Face&);
+
+  void
+  FilteredInInterests(const Interest&, const Face&);
+
+  void
+  FilteredOutData(const Data&, const Face&);
+
+  void
+  FilteredInData(const Data&, const Face&);
+
+  void
+  FilteredSatisfiedInterests(const nfd::pit::Entry&, const Face&, const Data&);
+
+  void
+  FilteredTimedOutInterests(const nfd::pit::Entry&);
+
 protected:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
+  L3TraceFilter m_filter;
+  double m_weight; ///< @brief count of every traced packet, 1 / packet sampling rate
+
   struct Stats {
     inline void
     Reset()
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-memory-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "apps/ndn-consumer.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/ndn-correlativity-knowledge-base.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.MemoryTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<MemoryTracer>>>> g_tracers;
+
+void
+MemoryTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+static shared_ptr<std::ostream>
+OpenOutputStream(const std::string& file)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+  if (os == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return nullptr;
+  }
+  return os;
+}
+
+void
+MemoryTracer::InstallAll(const std::string& file, Time period /* = Seconds (1.0)*/)
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    nodes.Add(*node);
+  }
+  Install(nodes, file, period);
+}
+
+void
+MemoryTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time period /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream = OpenOutputStream(file);
+  if (outputStream == nullptr) {
+    return;
+  }
+
+  std::list<Ptr<MemoryTracer>> tracers;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    tracers.push_back(Install(*node, outputStream, period));
+  }
+
+  if (tracers.size() > 0) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+MemoryTracer::Install(Ptr<Node> node, const std::string& file, Time period /* = Seconds (1.0)*/)
+{
+  Install(NodeContainer(node), file, period);
+}
+
+Ptr<MemoryTracer>
+MemoryTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                      Time period /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<MemoryTracer> trace = Create<MemoryTracer>(outputStream, node);
+  trace->SetPeriod(period);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+MemoryTracer::MemoryTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+MemoryTracer::~MemoryTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+MemoryTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+void
+MemoryTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &MemoryTracer::PeriodicPrinter, this);
+}
+
+void
+MemoryTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Bytes";
+}
+
+void
+MemoryTracer::Print(std::ostream& os) const
+{
+  double time = Simulator::Now().ToDouble(Time::S);
+  auto printLine = [&] (const char* table, size_t nBytes) {
+    os << time << "\t" << m_node << "\t" << table << "\t" << nBytes << "\n";
+  };
+
+  Ptr<L3Protocol> ndn = m_nodePtr->GetObject<L3Protocol>();
+  if (ndn != nullptr) {
+    shared_ptr<nfd::Forwarder> forwarder = ndn->getForwarder();
+    printLine("NameTree", forwarder->getNameTree().getMemoryUsage());
+    printLine("Pit", forwarder->getPit().getMemoryUsage());
+    printLine("Cs", forwarder->getCs().getMemoryUsage());
+    printLine("DeadNonceList", forwarder->getDeadNonceList().getMemoryUsage());
+    printLine("Measurements", forwarder->getMeasurements().getMemoryUsage());
+  }
+
+  size_t nConsumerBytes = 0;
+  for (uint32_t i = 0; i < m_nodePtr->GetNApplications(); ++i) {
+    Ptr<Consumer> consumer = DynamicCast<Consumer>(m_nodePtr->GetApplication(i));
+    if (consumer != nullptr) {
+      nConsumerBytes += consumer->GetMemoryUsage();
+    }
+  }
+  printLine("Consumers", nConsumerBytes);
+
+  Ptr<CorrelativityKnowledgeBase> knowledgeBase =
+    m_nodePtr->GetObject<CorrelativityKnowledgeBase>();
+  if (knowledgeBase != nullptr) {
+    printLine("KnowledgeBase", knowledgeBase->GetMemoryUsage());
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
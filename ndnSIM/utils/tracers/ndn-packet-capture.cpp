@@ -0,0 +1,593 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-packet-capture.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/ndn-mpi.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PacketCapture");
+
+namespace ns3 {
+namespace ndn {
+
+/// @cond include_hidden
+namespace capture {
+
+const char FILE_MAGIC[8] = {'N', 'D', 'N', 'P', 'C', 'A', 'P', '1'};
+const char INDEX_MAGIC[8] = {'N', 'D', 'N', 'P', 'C', 'I', 'X', '1'};
+
+const uint64_t INITIAL_CAPACITY = 1 << 20;
+const size_t BLOOM_BITS = 1024;
+const size_t BLOOM_HASHES = 3;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t recordHeaderSize;
+  uint32_t reserved;
+};
+
+struct RecordHeader {
+  uint32_t wireSize;
+  uint8_t type;
+  uint8_t direction;
+  uint16_t reserved;
+  uint32_t node;
+  int32_t face;
+  int64_t time;
+};
+
+struct IndexHeader {
+  char magic[8];
+  uint64_t fileSize; ///< size of the capture when the index was built
+  uint64_t end;
+  uint64_t nRecords;
+  uint64_t nEntries;
+  uint32_t blockSize;
+  uint32_t nameDepth;
+};
+
+static_assert(sizeof(FileHeader) == 16, "Unexpected size of capture file header");
+static_assert(sizeof(RecordHeader) == 24, "Unexpected size of capture record header");
+
+inline uint64_t
+align(uint64_t size)
+{
+  return (size + 7) & ~static_cast<uint64_t>(7);
+}
+
+/**
+ * @brief Find the Name TLV of an Interest or Data wire encoding
+ */
+bool
+findName(const uint8_t* wire, size_t wireSize, const uint8_t*& name, size_t& nameSize,
+         const uint8_t*& value, size_t& valueSize)
+{
+  const uint8_t* begin = wire;
+  const uint8_t* end = wire + wireSize;
+  uint32_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readType(begin, end, type) || !tlv::readVarNumber(begin, end, length))
+    return false;
+
+  name = begin;
+  if (!tlv::readType(begin, end, type) || type != tlv::Name ||
+      !tlv::readVarNumber(begin, end, length) || length > static_cast<uint64_t>(end - begin))
+    return false;
+
+  value = begin;
+  valueSize = length;
+  nameSize = value + valueSize - name;
+  return true;
+}
+
+/**
+ * @brief Call @p f with the hash of every prefix of the name, up to @p depth components
+ *
+ * The hash of a prefix is FNV-1a of the TLV encodings of its components.
+ */
+template<class F>
+void
+forEachPrefixHash(const uint8_t* value, size_t valueSize, size_t depth, F f)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  const uint8_t* begin = value;
+  const uint8_t* end = value + valueSize;
+  for (size_t i = 0; i < depth && begin != end; ++i) {
+    const uint8_t* component = begin;
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!tlv::readType(begin, end, type) || !tlv::readVarNumber(begin, end, length) ||
+        length > static_cast<uint64_t>(end - begin))
+      return;
+    begin += length;
+
+    for (; component != begin; ++component) {
+      hash ^= *component;
+      hash *= 1099511628211ULL;
+    }
+    f(hash);
+  }
+}
+
+/**
+ * @brief Positions of the Bloom filter bits of a hash (double hashing)
+ */
+template<class F>
+void
+forEachBloomBit(uint64_t hash, F f)
+{
+  uint64_t h1 = hash ^ (hash >> 29);
+  uint64_t h2 = (hash >> 32) | 1;
+  for (size_t i = 0; i < BLOOM_HASHES; ++i) {
+    f((h1 + i * h2) % BLOOM_BITS);
+  }
+}
+
+} // namespace capture
+/// @endcond
+
+PacketCaptureWriter::PacketCaptureWriter(const std::string& file)
+  : m_size(0)
+{
+  // create the file with the usual permissions, the mapping would create it executable
+  if (!std::ofstream(file, std::ios_base::binary | std::ios_base::trunc).is_open())
+    throw std::runtime_error("Cannot create packet capture " + file);
+
+  boost::iostreams::mapped_file_params params(file);
+  params.flags = boost::iostreams::mapped_file::readwrite;
+  params.new_file_size = capture::INITIAL_CAPACITY;
+  try {
+    m_file.open(params);
+  }
+  catch (const std::exception& e) {
+    throw std::runtime_error("Cannot map packet capture " + file + ": " + e.what());
+  }
+
+  capture::FileHeader header;
+  std::memcpy(header.magic, capture::FILE_MAGIC, sizeof(header.magic));
+  header.recordHeaderSize = sizeof(capture::RecordHeader);
+  header.reserved = 0;
+  std::memcpy(m_file.data(), &header, sizeof(header));
+  m_size = sizeof(header);
+}
+
+PacketCaptureWriter::~PacketCaptureWriter()
+{
+  Close();
+}
+
+void
+PacketCaptureWriter::Append(Time time, uint32_t node, int32_t face, Type type,
+                            Direction direction, const Block& wire)
+{
+  uint64_t size = sizeof(capture::RecordHeader) + capture::align(wire.size());
+  Reserve(m_size + size);
+
+  capture::RecordHeader header;
+  header.wireSize = static_cast<uint32_t>(wire.size());
+  header.type = type;
+  header.direction = direction;
+  header.reserved = 0;
+  header.node = node;
+  header.face = face;
+  header.time = time.GetNanoSeconds();
+
+  // the rest of the mapping is zero-filled, including the padding
+  char* record = m_file.data() + m_size;
+  std::memcpy(record, &header, sizeof(header));
+  std::memcpy(record + sizeof(header), wire.wire(), wire.size());
+  m_size += size;
+}
+
+void
+PacketCaptureWriter::Reserve(uint64_t size)
+{
+  if (size <= m_file.size())
+    return;
+
+  m_file.resize(std::max<uint64_t>(size, 2 * m_file.size()));
+}
+
+void
+PacketCaptureWriter::Close()
+{
+  if (!m_file.is_open())
+    return;
+
+  m_file.resize(m_size);
+  m_file.close();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static std::list<std::tuple<shared_ptr<PacketCaptureWriter>, std::list<Ptr<PacketCapture>>>>
+  g_captures;
+
+static shared_ptr<PacketCaptureWriter>
+OpenWriter(const std::string& file)
+{
+  try {
+    return make_shared<PacketCaptureWriter>(mpi::GetLocalFileName(file));
+  }
+  catch (const std::runtime_error& e) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Capture disabled");
+    return nullptr;
+  }
+}
+
+void
+PacketCapture::Destroy()
+{
+  g_captures.clear();
+}
+
+void
+PacketCapture::InstallAll(const std::string& file,
+                          const L3TraceFilter& filter/* = L3TraceFilter()*/)
+{
+  shared_ptr<PacketCaptureWriter> writer = OpenWriter(file);
+  if (writer == nullptr)
+    return;
+
+  std::list<Ptr<PacketCapture>> captures;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+    if (!filter.IsSampledNode(*node))
+      continue;
+
+    captures.push_back(Create<PacketCapture>(writer, *node, filter));
+  }
+
+  g_captures.push_back(std::make_tuple(writer, captures));
+}
+
+void
+PacketCapture::Install(const NodeContainer& nodes, const std::string& file,
+                       const L3TraceFilter& filter/* = L3TraceFilter()*/)
+{
+  shared_ptr<PacketCaptureWriter> writer = OpenWriter(file);
+  if (writer == nullptr)
+    return;
+
+  std::list<Ptr<PacketCapture>> captures;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+    if (!filter.IsSampledNode(*node))
+      continue;
+
+    captures.push_back(Create<PacketCapture>(writer, *node, filter));
+  }
+
+  g_captures.push_back(std::make_tuple(writer, captures));
+}
+
+void
+PacketCapture::Install(Ptr<Node> node, const std::string& file,
+                       const L3TraceFilter& filter/* = L3TraceFilter()*/)
+{
+  shared_ptr<PacketCaptureWriter> writer = OpenWriter(file);
+  if (writer == nullptr)
+    return;
+
+  std::list<Ptr<PacketCapture>> captures;
+  captures.push_back(Create<PacketCapture>(writer, node, filter));
+
+  g_captures.push_back(std::make_tuple(writer, captures));
+}
+
+PacketCapture::PacketCapture(shared_ptr<PacketCaptureWriter> writer, Ptr<Node> node,
+                             const L3TraceFilter& filter/* = L3TraceFilter()*/)
+  : m_writer(writer)
+  , m_nodePtr(node)
+  , m_filter(filter)
+{
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  l3->TraceConnectWithoutContext("OutInterests",
+                                 MakeCallback(&PacketCapture::OutInterests, this));
+  l3->TraceConnectWithoutContext("InInterests",
+                                 MakeCallback(&PacketCapture::InInterests, this));
+  l3->TraceConnectWithoutContext("OutData", MakeCallback(&PacketCapture::OutData, this));
+  l3->TraceConnectWithoutContext("InData", MakeCallback(&PacketCapture::InData, this));
+}
+
+PacketCapture::~PacketCapture()
+{
+}
+
+void
+PacketCapture::OutInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter.Accept(interest.getName()))
+    m_writer->Append(Simulator::Now(), m_nodePtr->GetId(), face.getId(),
+                     PacketCaptureWriter::INTEREST, PacketCaptureWriter::OUT,
+                     interest.wireEncode());
+}
+
+void
+PacketCapture::InInterests(const Interest& interest, const Face& face)
+{
+  if (m_filter.Accept(interest.getName()))
+    m_writer->Append(Simulator::Now(), m_nodePtr->GetId(), face.getId(),
+                     PacketCaptureWriter::INTEREST, PacketCaptureWriter::IN,
+                     interest.wireEncode());
+}
+
+void
+PacketCapture::OutData(const Data& data, const Face& face)
+{
+  if (m_filter.Accept(data.getName()))
+    m_writer->Append(Simulator::Now(), m_nodePtr->GetId(), face.getId(),
+                     PacketCaptureWriter::DATA, PacketCaptureWriter::OUT, data.wireEncode());
+}
+
+void
+PacketCapture::InData(const Data& data, const Face& face)
+{
+  if (m_filter.Accept(data.getName()))
+    m_writer->Append(Simulator::Now(), m_nodePtr->GetId(), face.getId(),
+                     PacketCaptureWriter::DATA, PacketCaptureWriter::IN, data.wireEncode());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Block
+PacketCaptureReader::Record::GetWire() const
+{
+  return Block(wire, wireSize);
+}
+
+Name
+PacketCaptureReader::Record::GetName() const
+{
+  const uint8_t* name = nullptr;
+  const uint8_t* value = nullptr;
+  size_t nameSize = 0, valueSize = 0;
+  if (!capture::findName(wire, wireSize, name, nameSize, value, valueSize))
+    throw std::runtime_error("Captured packet has no name");
+
+  return Name(Block(name, nameSize));
+}
+
+PacketCaptureReader::PacketCaptureReader(const std::string& file)
+  : m_end(0)
+  , m_nRecords(0)
+{
+  try {
+    m_file.open(file);
+  }
+  catch (const std::exception& e) {
+    throw std::runtime_error("Cannot open packet capture " + file + ": " + e.what());
+  }
+
+  capture::FileHeader header;
+  if (m_file.size() < sizeof(header))
+    throw std::runtime_error(file + " is not a packet capture");
+  std::memcpy(&header, m_file.data(), sizeof(header));
+  if (std::memcmp(header.magic, capture::FILE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.recordHeaderSize != sizeof(capture::RecordHeader))
+    throw std::runtime_error(file + " is not a packet capture");
+
+  if (!LoadIndex(file + ".idx")) {
+    BuildIndex();
+    SaveIndex(file + ".idx");
+  }
+}
+
+uint64_t
+PacketCaptureReader::ReadRecord(uint64_t offset, Record& record) const
+{
+  capture::RecordHeader header;
+  if (offset + sizeof(header) > m_file.size())
+    return 0;
+  std::memcpy(&header, m_file.data() + offset, sizeof(header));
+  if (header.wireSize == 0 || offset + sizeof(header) + header.wireSize > m_file.size())
+    return 0; // end of the records, or a record cut short
+
+  record.time = NanoSeconds(header.time);
+  record.node = header.node;
+  record.face = header.face;
+  record.type = static_cast<PacketCaptureWriter::Type>(header.type);
+  record.direction = static_cast<PacketCaptureWriter::Direction>(header.direction);
+  record.wire = reinterpret_cast<const uint8_t*>(m_file.data()) + offset + sizeof(header);
+  record.wireSize = header.wireSize;
+  return offset + sizeof(header) + capture::align(header.wireSize);
+}
+
+void
+PacketCaptureReader::BuildIndex()
+{
+  m_index.clear();
+  m_nRecords = 0;
+
+  Record record;
+  uint64_t offset = sizeof(capture::FileHeader);
+  uint64_t next = 0;
+  while ((next = ReadRecord(offset, record)) != 0) {
+    if (m_index.empty() || m_index.back().nRecords == INDEX_BLOCK_SIZE) {
+      IndexEntry entry;
+      std::memset(&entry, 0, sizeof(entry));
+      entry.offset = offset;
+      entry.firstTime = record.time.GetNanoSeconds();
+      m_index.push_back(entry);
+    }
+
+    IndexEntry& entry = m_index.back();
+    entry.lastTime = record.time.GetNanoSeconds();
+    entry.nRecords++;
+
+    const uint8_t* name = nullptr;
+    const uint8_t* value = nullptr;
+    size_t nameSize = 0, valueSize = 0;
+    if (capture::findName(record.wire, record.wireSize, name, nameSize, value, valueSize)) {
+      capture::forEachPrefixHash(value, valueSize, INDEX_NAME_DEPTH, [&entry] (uint64_t hash) {
+          capture::forEachBloomBit(hash, [&entry] (size_t bit) {
+              entry.bloom[bit / 64] |= static_cast<uint64_t>(1) << (bit % 64);
+            });
+        });
+    }
+
+    m_nRecords++;
+    offset = next;
+  }
+  m_end = offset;
+}
+
+bool
+PacketCaptureReader::LoadIndex(const std::string& file)
+{
+  std::ifstream is(file, std::ios_base::binary);
+  if (!is.is_open())
+    return false;
+
+  capture::IndexHeader header;
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, capture::INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+      header.fileSize != m_file.size() || header.end > m_file.size() ||
+      header.blockSize != INDEX_BLOCK_SIZE || header.nameDepth != INDEX_NAME_DEPTH)
+    return false; // stale or foreign index
+
+  std::vector<IndexEntry> index(header.nEntries);
+  if (!is.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(IndexEntry)))
+    return false;
+
+  m_index.swap(index);
+  m_end = header.end;
+  m_nRecords = header.nRecords;
+  return true;
+}
+
+void
+PacketCaptureReader::SaveIndex(const std::string& file) const
+{
+  std::ofstream os(file, std::ios_base::binary | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_WARN("Index of the packet capture cannot be saved into " << file);
+    return;
+  }
+
+  capture::IndexHeader header;
+  std::memcpy(header.magic, capture::INDEX_MAGIC, sizeof(header.magic));
+  header.fileSize = m_file.size();
+  header.end = m_end;
+  header.nRecords = m_nRecords;
+  header.nEntries = m_index.size();
+  header.blockSize = INDEX_BLOCK_SIZE;
+  header.nameDepth = INDEX_NAME_DEPTH;
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(m_index.data()), m_index.size() * sizeof(IndexEntry));
+}
+
+uint64_t
+PacketCaptureReader::Query(const Name& prefix, Time from, Time to, const Visitor& visitor) const
+{
+  const Block& prefixWire = prefix.wireEncode();
+  const uint8_t* prefixValue = prefixWire.value();
+  size_t prefixSize = prefixWire.value_size();
+
+  // the index holds prefixes up to INDEX_NAME_DEPTH components
+  uint64_t prefixHash = 0;
+  capture::forEachPrefixHash(prefixValue, prefixSize, INDEX_NAME_DEPTH,
+                             [&prefixHash] (uint64_t hash) { prefixHash = hash; });
+
+  uint64_t nVisited = 0;
+  for (const IndexEntry& entry : m_index) {
+    if (entry.lastTime < from.GetNanoSeconds() || entry.firstTime >= to.GetNanoSeconds())
+      continue;
+
+    if (!prefix.empty()) {
+      bool isCandidate = true;
+      capture::forEachBloomBit(prefixHash, [&entry, &isCandidate] (size_t bit) {
+          if ((entry.bloom[bit / 64] & (static_cast<uint64_t>(1) << (bit % 64))) == 0)
+            isCandidate = false;
+        });
+      if (!isCandidate)
+        continue;
+    }
+
+    Record record;
+    uint64_t offset = entry.offset;
+    for (uint32_t i = 0; i < entry.nRecords; ++i) {
+      uint64_t next = ReadRecord(offset, record);
+      if (next == 0)
+        break;
+      offset = next;
+
+      if (record.time < from || record.time >= to)
+        continue;
+
+      if (!prefix.empty()) {
+        // equal components have equal encodings, so a prefix is a byte prefix of the name
+        const uint8_t* name = nullptr;
+        const uint8_t* value = nullptr;
+        size_t nameSize = 0, valueSize = 0;
+        if (!capture::findName(record.wire, record.wireSize, name, nameSize, value, valueSize) ||
+            valueSize < prefixSize || std::memcmp(value, prefixValue, prefixSize) != 0)
+          continue;
+      }
+
+      visitor(record);
+      nVisited++;
+    }
+  }
+  return nVisited;
+}
+
+uint64_t
+PacketCaptureReader::ForEach(const Visitor& visitor) const
+{
+  Record record;
+  uint64_t nVisited = 0;
+  uint64_t offset = sizeof(capture::FileHeader);
+  while (offset < m_end && (offset = ReadRecord(offset, record)) != 0) {
+    visitor(record);
+    nVisited++;
+  }
+  return nVisited;
+}
+
+void
+PacketCaptureReader::PrintRecord(std::ostream& os, const Record& record)
+{
+  os << record.time.ToDouble(Time::S) << "\t" << record.node << "\t" << record.face << "\t"
+     << (record.direction == PacketCaptureWriter::IN ? "In" : "Out") << "\t"
+     << (record.type == PacketCaptureWriter::INTEREST ? "Interest" : "Data") << "\t"
+     << record.wireSize << "\t" << record.GetName() << "\n";
+}
+
+} // namespace ndn
+} // namespace ns3
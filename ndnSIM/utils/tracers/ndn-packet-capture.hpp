@@ -0,0 +1,310 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_PACKET_CAPTURE_H
+#define NDN_PACKET_CAPTURE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-face.hpp"
+
+#include "ndn-l3-trace-filter.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <functional>
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Append-only writer of NDN packet captures
+ *
+ * Every record holds the TLV wire encoding of an Interest or Data, as received or sent by the
+ * node, after a fixed-size header with the time, node, face, packet type and direction.  The
+ * wire block of the packet is copied as it is, nothing is encoded or decoded.
+ *
+ * The file is memory-mapped: records are copied into the mapping, which grows by doubling.  When
+ * the writer is closed, the file is truncated to the end of the last record.
+ *
+ * Layout of the file (host byte order, records aligned to 8 bytes):
+ *
+ *     header:  "NDNPCAP1", uint32 size of record header, uint32 reserved
+ *     records: uint32 wire size, uint8 type, uint8 direction, uint16 reserved, uint32 node id,
+ *              int32 face id, int64 time (nanoseconds), wire, padding
+ *
+ * A wire size of zero marks the end of the records, e.g., when the simulation has crashed
+ * before closing the capture.
+ */
+class PacketCaptureWriter : noncopyable {
+public:
+  enum Type : uint8_t {
+    INTEREST = 0,
+    DATA = 1
+  };
+
+  enum Direction : uint8_t {
+    IN = 0,
+    OUT = 1
+  };
+
+  /**
+   * @brief Create or truncate the capture file
+   * @throw std::runtime_error the file cannot be created or mapped
+   */
+  explicit
+  PacketCaptureWriter(const std::string& file);
+
+  ~PacketCaptureWriter();
+
+  void
+  Append(Time time, uint32_t node, int32_t face, Type type, Direction direction,
+         const Block& wire);
+
+  /**
+   * @brief Truncate the file to the written records and unmap it
+   */
+  void
+  Close();
+
+  /**
+   * @brief Size of the written records, including the file header
+   */
+  uint64_t
+  GetSize() const
+  {
+    return m_size;
+  }
+
+private:
+  void
+  Reserve(uint64_t size);
+
+private:
+  boost::iostreams::mapped_file m_file;
+  uint64_t m_size;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN packet capture attached to the network-layer trace sources of L3Protocol
+ *
+ * All incoming and outgoing Interests and Data of the traced nodes are written with
+ * PacketCaptureWriter, and can be queried by name prefix and time with PacketCaptureReader or
+ * the ndn-packet-capture-query program.
+ *
+ * With an L3TraceFilter, only the sampled nodes are captured and only packets under the
+ * filter's prefixes are written.
+ */
+class PacketCapture : public SimpleRefCount<PacketCapture> {
+public:
+  /**
+   * @brief Helper method to capture packets of all simulation nodes
+   *
+   * In a distributed simulation, only the nodes of this process are captured, into a file of
+   * its own (see mpi::GetLocalFileName).
+   *
+   * @param file File to which packets will be written
+   * @param filter Nodes and packets to capture (default, everything)
+   */
+  static void
+  InstallAll(const std::string& file, const L3TraceFilter& filter = L3TraceFilter());
+
+  /**
+   * @brief Helper method to capture packets of the selected simulation nodes
+   *
+   * @param nodes Nodes of which to capture packets
+   * @param file File to which packets will be written
+   * @param filter Nodes and packets to capture (default, everything)
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file,
+          const L3TraceFilter& filter = L3TraceFilter());
+
+  /**
+   * @brief Helper method to capture packets of a specific simulation node
+   *
+   * @param node Node of which to capture packets
+   * @param file File to which packets will be written
+   * @param filter Packets to capture (default, everything); the node is captured even if it is
+   *        not sampled by the filter
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file, const L3TraceFilter& filter = L3TraceFilter());
+
+  /**
+   * @brief Explicit request to remove all statically created captures, closing their files
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Capture packets of the node into the writer
+   */
+  PacketCapture(shared_ptr<PacketCaptureWriter> writer, Ptr<Node> node,
+                const L3TraceFilter& filter = L3TraceFilter());
+
+  ~PacketCapture();
+
+private:
+  void
+  OutInterests(const Interest& interest, const Face& face);
+
+  void
+  InInterests(const Interest& interest, const Face& face);
+
+  void
+  OutData(const Data& data, const Face& face);
+
+  void
+  InData(const Data& data, const Face& face);
+
+private:
+  shared_ptr<PacketCaptureWriter> m_writer;
+  Ptr<Node> m_nodePtr;
+  L3TraceFilter m_filter;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of packet captures written by PacketCaptureWriter
+ *
+ * The capture is memory-mapped and records are decoded lazily: iteration only reads the
+ * fixed-size headers, Record::GetName parses just the Name of the packet and
+ * Record::GetWire creates the packet block on request.
+ *
+ * Queries use an index of blocks of INDEX_BLOCK_SIZE consecutive records, with the offset and
+ * time range of each block and a Bloom filter of the name prefixes of its packets, up to
+ * INDEX_NAME_DEPTH components.  Blocks outside the time range of a query or without its prefix
+ * are skipped without reading their records.  The index is built on the first use of a capture
+ * and saved next to it, as "<file>.idx", for later queries.
+ */
+class PacketCaptureReader : noncopyable {
+public:
+  static const size_t INDEX_BLOCK_SIZE = 4096;
+  static const size_t INDEX_NAME_DEPTH = 4;
+
+  struct Record {
+    Time time;
+    uint32_t node;
+    int32_t face;
+    PacketCaptureWriter::Type type;
+    PacketCaptureWriter::Direction direction;
+    const uint8_t* wire;
+    size_t wireSize;
+
+    /**
+     * @brief Copy of the packet TLV block, e.g., to decode it into an Interest or Data
+     */
+    Block
+    GetWire() const;
+
+    /**
+     * @brief Name of the packet, decoded without decoding the rest of the packet
+     */
+    Name
+    GetName() const;
+  };
+
+  typedef std::function<void(const Record&)> Visitor;
+
+  /**
+   * @brief Open the capture, load its index or build and save it
+   * @throw std::runtime_error the file cannot be opened or is not a packet capture
+   */
+  explicit
+  PacketCaptureReader(const std::string& file);
+
+  /**
+   * @brief Number of records in the capture
+   */
+  uint64_t
+  GetSize() const
+  {
+    return m_nRecords;
+  }
+
+  /**
+   * @brief Visit every record in [from, to) whose packet name is under the prefix, in order
+   * @return number of visited records
+   */
+  uint64_t
+  Query(const Name& prefix, Time from, Time to, const Visitor& visitor) const;
+
+  /**
+   * @brief Visit every record, in order
+   */
+  uint64_t
+  ForEach(const Visitor& visitor) const;
+
+  /**
+   * @brief Print a record as a tab-separated text line: Time, Node, FaceId, Direction, Type,
+   *        Size, Name
+   */
+  static void
+  PrintRecord(std::ostream& os, const Record& record);
+
+private:
+  struct IndexEntry {
+    uint64_t offset;
+    int64_t firstTime;
+    int64_t lastTime;
+    uint32_t nRecords;
+    uint32_t reserved;
+    uint64_t bloom[16];
+  };
+
+  void
+  BuildIndex();
+
+  bool
+  LoadIndex(const std::string& file);
+
+  void
+  SaveIndex(const std::string& file) const;
+
+  /**
+   * @brief Read the record at the offset
+   * @return offset of the next record, or 0 at the end of the records
+   */
+  uint64_t
+  ReadRecord(uint64_t offset, Record& record) const;
+
+private:
+  boost::iostreams::mapped_file_source m_file;
+  uint64_t m_end; ///< @brief end of the records
+  uint64_t m_nRecords;
+  std::vector<IndexEntry> m_index;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PACKET_CAPTURE_H
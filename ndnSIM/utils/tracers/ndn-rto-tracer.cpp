@@ -0,0 +1,500 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-rto-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "ndn-binary-trace.hpp"
+#include "ns3/node.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+
+#include "apps/ndn-app.hpp"
+#include "utils/ndn-mpi.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RtoTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<RtoTracer>>>> g_tracers;
+
+void
+RtoTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+RtoTracer::InstallAll(const std::string& file, Time period/* = Seconds(1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<RtoTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !period.IsZero());
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<RtoTracer> trace = Install(*node, outputStream, period);
+    trace->m_binary = binary;
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+RtoTracer::Install(const NodeContainer& nodes, const std::string& file,
+                   Time period/* = Seconds(1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<RtoTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(mpi::GetLocalFileName(file));
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !period.IsZero());
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!mpi::IsLocalNode(*node))
+      continue; // simulated by another MPI process
+
+    Ptr<RtoTracer> trace = Install(*node, outputStream, period);
+    trace->m_binary = binary;
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+RtoTracer::Install(Ptr<Node> node, const std::string& file, Time period/* = Seconds(1.0)*/)
+{
+  if (!mpi::IsLocalNode(node))
+    return; // simulated by another MPI process
+
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<RtoTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+
+    if (os == nullptr) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  shared_ptr<BinaryTraceWriter> binary;
+  if (BinaryTraceWriter::IsBinaryFile(file)) {
+    binary = CreateBinaryWriter(outputStream, !period.IsZero());
+  }
+
+  Ptr<RtoTracer> trace = Install(node, outputStream, period);
+  trace->m_binary = binary;
+  tracers.push_back(trace);
+
+  if (tracers.size() > 0 && binary == nullptr) {
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<RtoTracer>
+RtoTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                   Time period/* = Seconds(1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<RtoTracer> trace = Create<RtoTracer>(outputStream, node);
+  if (!period.IsZero()) {
+    trace->SetPeriod(period);
+  }
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+RtoTracer::RtoTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+RtoTracer::RtoTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_os(os)
+{
+  Connect();
+}
+
+RtoTracer::~RtoTracer()
+{
+  m_printEvent.Cancel();
+}
+
+void
+RtoTracer::SetPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &RtoTracer::PeriodicPrinter, this);
+
+  // the last, possibly partial, period; keeps the tracer until then
+  Simulator::ScheduleDestroy(&RtoTracer::PrintLastPeriod, Ptr<RtoTracer>(this));
+}
+
+void
+RtoTracer::PeriodicPrinter()
+{
+  PrintPeriod();
+
+  m_printEvent = Simulator::Schedule(m_period, &RtoTracer::PeriodicPrinter, this);
+}
+
+void
+RtoTracer::PrintLastPeriod()
+{
+  m_printEvent.Cancel();
+  PrintPeriod();
+
+  if (m_binary != nullptr) {
+    m_binary->Flush();
+  }
+  m_os->flush();
+}
+
+void
+RtoTracer::Connect()
+{
+  const std::string path = "/NodeList/" + m_node + "/ApplicationList/*/";
+
+  Config::ConnectWithoutContext(path + "InterestSent",
+                                MakeCallback(&RtoTracer::InterestSent, this));
+  Config::ConnectWithoutContext(path + "Timeout", MakeCallback(&RtoTracer::Timeout, this));
+  Config::ConnectWithoutContext(path + "InterestGivenUp",
+                                MakeCallback(&RtoTracer::InterestGivenUp, this));
+  Config::ConnectWithoutContext(path + "DataReceived",
+                                MakeCallback(&RtoTracer::DataReceived, this));
+}
+
+void
+RtoTracer::PrintHeader(std::ostream& os) const
+{
+  if (!m_period.IsZero()) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Interests"
+       << "\t"
+       << "Timeouts"
+       << "\t"
+       << "Spurious"
+       << "\t"
+       << "GivenUp"
+       << "\t"
+       << "Samples"
+       << "\t"
+       << "Rto"
+       << "\t"
+       << "Rtt"
+       << "\t"
+       << "RtoError"
+       << "\t"
+       << "WastedWait"
+       << "";
+    return;
+  }
+
+  os << "Time"
+     << "\t"
+     << "Node"
+     << "\t"
+     << "AppId"
+     << "\t"
+     << "SeqNo"
+     << "\t"
+     << "Type"
+     << "\t"
+     << "Transmissions"
+     << "\t"
+     << "Rto"
+     << "\t"
+     << "Rtt"
+     << "\t"
+     << "Spurious"
+     << "\t"
+     << "WastedWait"
+     << "";
+}
+
+void
+RtoTracer::InterestSent(Ptr<App> app, const Name& name, uint32_t seqno, Time rto)
+{
+  AppState& state = m_apps[app->GetId()];
+  Pending& pending = state.pending[seqno];
+  if (pending.transmissions > 0) {
+    pending.previousSendTime = pending.lastSendTime;
+    pending.previousRto = pending.lastRto;
+  }
+  pending.lastSendTime = Simulator::Now();
+  pending.lastRto = rto;
+  ++pending.transmissions;
+
+  ++state.stats.interests;
+}
+
+void
+RtoTracer::Timeout(Ptr<App> app, uint32_t seqno, Time rto)
+{
+  AppState& state = m_apps[app->GetId()];
+  auto pending = state.pending.find(seqno);
+  if (pending == state.pending.end())
+    return; // sent before the tracer was installed
+
+  ++pending->second.timeouts;
+  pending->second.timeoutRtoSum += rto;
+
+  ++state.stats.timeouts;
+}
+
+void
+RtoTracer::InterestGivenUp(Ptr<App> app, uint32_t seqno)
+{
+  AppState& state = m_apps[app->GetId()];
+  auto pending = state.pending.find(seqno);
+  if (pending == state.pending.end())
+    return;
+
+  ++state.stats.givenUp;
+  if (m_period.IsZero()) {
+    PrintInterest(app, seqno, "GivenUp", pending->second.transmissions, pending->second.lastRto,
+                  Time(0), false, Time(0));
+  }
+  state.pending.erase(pending);
+}
+
+void
+RtoTracer::DataReceived(Ptr<App> app, const Name& name, uint32_t seqno)
+{
+  AppState& state = m_apps[app->GetId()];
+  auto i = state.pending.find(seqno);
+  if (i == state.pending.end())
+    return; // duplicate Data, or Data for a given up Interest
+
+  const Pending& pending = i->second;
+  Time now = Simulator::Now();
+  Time rtt = now - pending.lastSendTime;
+  Time rto = pending.lastRto;
+  uint32_t genuineTimeouts = pending.timeouts;
+  Time genuineRtoSum = pending.timeoutRtoSum;
+
+  // Data sooner after the retransmission than any RTT answers the previous transmission
+  bool isSpurious = pending.timeouts > 0 && pending.transmissions > 1 &&
+                    !state.minRtt.IsZero() && rtt < state.minRtt;
+  if (isSpurious) {
+    rtt = now - pending.previousSendTime;
+    rto = pending.previousRto;
+    --genuineTimeouts;
+    genuineRtoSum -= pending.previousRto;
+  }
+
+  Time wastedWait = std::max(genuineRtoSum - NanoSeconds(rtt.GetNanoSeconds() * genuineTimeouts),
+                             Time(0));
+
+  if (pending.transmissions == 1 && (state.minRtt.IsZero() || rtt < state.minRtt)) {
+    state.minRtt = rtt;
+  }
+
+  Stats& stats = state.stats;
+  ++stats.samples;
+  stats.rtoSum += rto;
+  stats.rttSum += rtt;
+  stats.wastedWait += wastedWait;
+  if (isSpurious) {
+    ++stats.spurious;
+  }
+
+  if (m_period.IsZero()) {
+    PrintInterest(app, seqno, "Data", pending.transmissions, rto, rtt, isSpurious, wastedWait);
+  }
+  state.pending.erase(i);
+}
+
+void
+RtoTracer::PrintInterest(Ptr<App> app, uint32_t seqno, const char* type, uint32_t transmissions,
+                         Time rto, Time rtt, bool isSpurious, Time wastedWait)
+{
+  if (m_binary != nullptr) {
+    *m_binary << Simulator::Now() << m_node << app->GetId() << seqno << type << transmissions
+              << rto << rtt << static_cast<uint32_t>(isSpurious) << wastedWait;
+    return;
+  }
+
+  *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
+        << seqno << "\t" << type << "\t" << transmissions << "\t" << rto.ToDouble(Time::S) << "\t"
+        << rtt.ToDouble(Time::S) << "\t" << isSpurious << "\t" << wastedWait.ToDouble(Time::S)
+        << "\n";
+}
+
+void
+RtoTracer::PrintPeriod()
+{
+  Time now = Simulator::Now();
+
+  for (auto& i : m_apps) {
+    Stats& stats = i.second.stats;
+    if (stats.interests == 0 && stats.timeouts == 0 && stats.givenUp == 0 && stats.samples == 0)
+      continue;
+
+    Time rto, rtt;
+    if (stats.samples > 0) {
+      rto = NanoSeconds(stats.rtoSum.GetNanoSeconds() / stats.samples);
+      rtt = NanoSeconds(stats.rttSum.GetNanoSeconds() / stats.samples);
+    }
+    double rtoError = (rto - rtt).ToDouble(Time::S);
+
+    if (m_binary != nullptr) {
+      *m_binary << now << m_node << i.first << stats.interests << stats.timeouts << stats.spurious
+                << stats.givenUp << stats.samples << rto << rtt << rtoError << stats.wastedWait;
+    }
+    else {
+      *m_os << now.ToDouble(Time::S) << "\t" << m_node << "\t" << i.first << "\t"
+            << stats.interests << "\t" << stats.timeouts << "\t" << stats.spurious << "\t"
+            << stats.givenUp << "\t" << stats.samples << "\t" << rto.ToDouble(Time::S) << "\t"
+            << rtt.ToDouble(Time::S) << "\t" << rtoError << "\t"
+            << stats.wastedWait.ToDouble(Time::S) << "\n";
+    }
+
+    stats = Stats();
+  }
+}
+
+shared_ptr<BinaryTraceWriter>
+RtoTracer::CreateBinaryWriter(shared_ptr<std::ostream> outputStream, bool isAggregated)
+{
+  if (isAggregated) {
+    return BinaryTraceWriter::Create(outputStream, {
+        {"Time", BinaryTraceWriter::TIME},
+        {"Node", BinaryTraceWriter::NAME},
+        {"AppId", BinaryTraceWriter::UINT32},
+        {"Interests", BinaryTraceWriter::UINT32},
+        {"Timeouts", BinaryTraceWriter::UINT32},
+        {"Spurious", BinaryTraceWriter::UINT32},
+        {"GivenUp", BinaryTraceWriter::UINT32},
+        {"Samples", BinaryTraceWriter::UINT32},
+        {"Rto", BinaryTraceWriter::TIME},
+        {"Rtt", BinaryTraceWriter::TIME},
+        {"RtoError", BinaryTraceWriter::DOUBLE},
+        {"WastedWait", BinaryTraceWriter::TIME}});
+  }
+
+  return BinaryTraceWriter::Create(outputStream, {
+      {"Time", BinaryTraceWriter::TIME},
+      {"Node", BinaryTraceWriter::NAME},
+      {"AppId", BinaryTraceWriter::UINT32},
+      {"SeqNo", BinaryTraceWriter::UINT32},
+      {"Type", BinaryTraceWriter::NAME},
+      {"Transmissions", BinaryTraceWriter::UINT32},
+      {"Rto", BinaryTraceWriter::TIME},
+      {"Rtt", BinaryTraceWriter::TIME},
+      {"Spurious", BinaryTraceWriter::UINT32},
+      {"WastedWait", BinaryTraceWriter::TIME}});
+}
+
+} // namespace ndn
+} // namespace ns3
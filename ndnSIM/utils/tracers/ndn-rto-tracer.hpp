@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_RTO_TRACER_H
+#define NDN_RTO_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <tuple>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+class App;
+class BinaryTraceWriter;
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Tracer of the accuracy of the retransmission timeouts of consumers
+ *
+ * Records the InterestSent, Timeout, InterestGivenUp and DataReceived trace sources of
+ * Consumer.  For every Interest answered by Data, the tracer compares the RTO of the answered
+ * transmission with its actual RTT, and decides whether the last timeout was spurious.
+ *
+ * NDN Data does not tell which transmission it answers.  The tracer assumes that Data
+ * arriving sooner after the last retransmission than the minimum RTT of the application (over
+ * Interests answered without retransmission) answers the previous transmission: the timeout
+ * of that transmission was spurious, and its RTT is measured from its own send time.
+ *
+ * The time wasted waiting for an Interest is the time its timed out (not spurious)
+ * transmissions waited beyond the RTT of the answered transmission, i.e., the sum of RTO - RTT
+ * over these transmissions.
+ *
+ * With a non-zero period (the default), every period the tracer writes one row per
+ * application with activity in the period:
+ *
+ * - ``Interests``: number of transmitted Interests, including retransmissions
+ * - ``Timeouts``: number of expired RTOs
+ * - ``Spurious``: number of spurious timeouts
+ * - ``GivenUp``: number of Interests given up by the retransmission controller
+ * - ``Samples``: number of Interests answered by Data
+ * - ``Rto``, ``Rtt``: mean RTO and RTT of the answered transmissions, in seconds
+ * - ``RtoError``: mean RTO - RTT of the answered transmissions, in seconds
+ * - ``WastedWait``: total time wasted waiting, in seconds
+ *
+ * With a zero period, there is a row per answered (Type "Data") or given up (Type "GivenUp")
+ * Interest instead, with its number of transmissions, the RTO and RTT of the answered
+ * transmission, whether the last timeout was spurious and the time wasted waiting.
+ *
+ * If the name of the trace file ends with ".bin", the trace is written in the binary format of
+ * BinaryTraceWriter, with the same columns.
+ */
+class RtoTracer : public SimpleRefCount<RtoTracer> {
+public:
+  /**
+   * @brief Helper method to install tracers on all simulation nodes
+   *
+   * In a distributed simulation, only the nodes of this process are traced, into a file of its
+   * own (see mpi::GetLocalFileName).
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often the aggregated rows are written, zero for a row per Interest
+   */
+  static void
+  InstallAll(const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracers on the selected simulation nodes
+   *
+   * @param nodes Nodes on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often the aggregated rows are written, zero for a row per Interest
+   */
+  static void
+  Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param period How often the aggregated rows are written, zero for a row per Interest
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file, Time period = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   * @param period How often the aggregated rows are written, zero for a row per Interest
+   *
+   * @returns the tracer, which needs to be preserved for the lifetime of simulation
+   */
+  static Ptr<RtoTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream, Time period = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to all consumers on the node using node's pointer
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  RtoTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
+
+  /**
+   * @brief Trace constructor that attaches to all consumers on the node using node's name
+   * @param os        reference to the output stream
+   * @param nodeName  name of the node registered using Names::Add
+   */
+  RtoTracer(shared_ptr<std::ostream> os, const std::string& node);
+
+  ~RtoTracer();
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  void
+  PrintHeader(std::ostream& os) const;
+
+private:
+  void
+  Connect();
+
+  void
+  InterestSent(Ptr<App> app, const Name& name, uint32_t seqno, Time rto);
+
+  void
+  Timeout(Ptr<App> app, uint32_t seqno, Time rto);
+
+  void
+  InterestGivenUp(Ptr<App> app, uint32_t seqno);
+
+  void
+  DataReceived(Ptr<App> app, const Name& name, uint32_t seqno);
+
+  void
+  PrintInterest(Ptr<App> app, uint32_t seqno, const char* type, uint32_t transmissions, Time rto,
+                Time rtt, bool isSpurious, Time wastedWait);
+
+  void
+  SetPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
+  /**
+   * @brief Write the rows of the last period, at Simulator::Destroy
+   */
+  void
+  PrintLastPeriod();
+
+  /**
+   * @brief Write rows of the applications with activity, and reset the counters
+   */
+  void
+  PrintPeriod();
+
+  static shared_ptr<BinaryTraceWriter>
+  CreateBinaryWriter(shared_ptr<std::ostream> outputStream, bool isAggregated);
+
+private:
+  std::string m_node;
+  Ptr<Node> m_nodePtr;
+
+  shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_binary; ///< @brief if set, the trace is written in binary
+
+  /**
+   * @brief Outstanding Interest
+   */
+  struct Pending {
+    uint32_t transmissions = 0;
+    uint32_t timeouts = 0;
+    Time lastSendTime;
+    Time lastRto;
+    Time previousSendTime; ///< @brief send time of the transmission before the last one
+    Time previousRto;
+    Time timeoutRtoSum;    ///< @brief sum of the RTOs of the timed out transmissions
+  };
+
+  struct Stats {
+    uint32_t interests = 0;
+    uint32_t timeouts = 0;
+    uint32_t spurious = 0;
+    uint32_t givenUp = 0;
+    uint32_t samples = 0;
+    Time rtoSum;
+    Time rttSum;
+    Time wastedWait;
+  };
+
+  struct AppState {
+    std::unordered_map<uint32_t, Pending> pending; ///< @brief per sequence number
+    Time minRtt; ///< @brief of Interests answered without retransmission, zero if none yet
+    Stats stats; ///< @brief of the current period
+  };
+
+  Time m_period; ///< @brief if non-zero, aggregated rows are written with this period
+  EventId m_printEvent;
+  std::map<uint32_t, AppState> m_apps; ///< @brief per application id
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RTO_TRACER_H
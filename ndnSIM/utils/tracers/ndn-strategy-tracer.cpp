@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-strategy-tracer.hpp"
+#include "ndn-async-trace-writer.hpp"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include "model/ndn-l3-protocol.hpp"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.StrategyTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, Ptr<StrategyTracer>>> g_tracers;
+
+void
+StrategyTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+StrategyTracer::Install(Ptr<Node> node, const std::string& file)
+{
+  shared_ptr<std::ostream> os = AsyncTraceWriter::Open(file);
+  if (os == nullptr) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+    return;
+  }
+
+  g_tracers.push_back(std::make_tuple(os, Install(node, os)));
+}
+
+Ptr<StrategyTracer>
+StrategyTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  return Create<StrategyTracer>(outputStream, node);
+}
+
+static Block
+makeRecord(uint32_t type)
+{
+  Block record(type);
+  record.push_back(makeNonNegativeIntegerBlock(strategy_trace::Time,
+                                               Simulator::Now().GetNanoSeconds()));
+  return record;
+}
+
+StrategyTracer::StrategyTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_os(os)
+{
+  Ptr<L3Protocol> ndn = node->GetObject<L3Protocol>();
+  NS_ASSERT(ndn != nullptr);
+  nfd::Forwarder& forwarder = *ndn->getForwarder();
+
+  m_afterReceiveInterest = forwarder.afterReceiveInterest.connect(
+    [this] (const nfd::Face& inFace, const Interest& interest,
+            const shared_ptr<nfd::fib::Entry>& fibEntry, const shared_ptr<nfd::pit::Entry>&) {
+      Block record = makeRecord(strategy_trace::AfterReceiveInterest);
+      record.push_back(makeNonNegativeIntegerBlock(strategy_trace::FaceId, inFace.getId()));
+      record.push_back(interest.wireEncode());
+      record.push_back(fibEntry->getPrefix().wireEncode());
+      for (const nfd::fib::NextHop& nexthop : fibEntry->getNextHops()) {
+        Block nexthopBlock(strategy_trace::NextHop);
+        nexthopBlock.push_back(makeNonNegativeIntegerBlock(strategy_trace::FaceId,
+                                                           nexthop.getFace()->getId()));
+        nexthopBlock.push_back(makeNonNegativeIntegerBlock(strategy_trace::Cost,
+                                                           nexthop.getCost()));
+        nexthopBlock.encode();
+        record.push_back(nexthopBlock);
+      }
+      Write(record);
+    });
+
+  m_beforeSatisfyInterest = forwarder.beforeSatisfyInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry, const nfd::Face& inFace, const Data& data) {
+      Block record = makeRecord(strategy_trace::BeforeSatisfyInterest);
+      record.push_back(makeNonNegativeIntegerBlock(strategy_trace::FaceId, inFace.getId()));
+      record.push_back(pitEntry.getInterest().wireEncode());
+      record.push_back(data.getName().wireEncode());
+      if (data.getFreshnessPeriod() >= time::milliseconds::zero()) {
+        record.push_back(makeNonNegativeIntegerBlock(strategy_trace::FreshnessPeriod,
+                                                     data.getFreshnessPeriod().count()));
+      }
+      Write(record);
+    });
+
+  m_beforeExpirePendingInterest = forwarder.beforeExpirePendingInterest.connect(
+    [this] (const nfd::pit::Entry& pitEntry) {
+      Block record = makeRecord(strategy_trace::BeforeExpirePendingInterest);
+      record.push_back(pitEntry.getInterest().wireEncode());
+      Write(record);
+    });
+}
+
+void
+StrategyTracer::Write(Block& record)
+{
+  record.encode();
+  m_os->write(reinterpret_cast<const char*>(record.wire()), record.size());
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_STRATEGY_TRACER_H
+#define NDN_STRATEGY_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <ndn-cxx/util/signal.hpp>
+
+#include <tuple>
+#include <list>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+namespace strategy_trace {
+
+/**
+ * @brief TLV types of the strategy trace
+ *
+ * The trace is a sequence of records, one per strategy trigger:
+ *
+ *     AfterReceiveInterest ::= Time FaceId Interest Name(FIB prefix) NextHop*
+ *     BeforeSatisfyInterest ::= Time FaceId Interest(of PIT entry) Name(of Data) FreshnessPeriod?
+ *     BeforeExpirePendingInterest ::= Time Interest(of PIT entry)
+ *     NextHop ::= FaceId Cost
+ *
+ * Time is the simulation time in nanoseconds, FreshnessPeriod is in milliseconds, other
+ * elements are nonNegativeIntegers or the usual Interest and Name TLVs.
+ */
+enum : uint32_t {
+  AfterReceiveInterest = 200,
+  BeforeSatisfyInterest = 201,
+  BeforeExpirePendingInterest = 202,
+  Time = 210,
+  FaceId = 211,
+  NextHop = 212,
+  Cost = 213,
+  FreshnessPeriod = 214
+};
+
+} // namespace strategy_trace
+
+/**
+ * @ingroup ndn-tracers
+ * @brief NDN tracer that records the strategy triggers of a node to a compact binary trace
+ *
+ * The trace can be replayed against any registered strategy with StrategyReplay, without
+ * running the rest of the simulation.
+ */
+class StrategyTracer : public SimpleRefCount<StrategyTracer> {
+public:
+  /**
+   * @brief Helper method to install tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param file File to which the binary trace will be written
+   */
+  static void
+  Install(Ptr<Node> node, const std::string& file);
+
+  /**
+   * @brief Helper method to install tracer on a specific simulation node
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a binary stream
+   */
+  static Ptr<StrategyTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
+
+  /**
+   * @brief Explicit request to remove all statically created tracers
+   *
+   * This method can be helpful if simulation scenario contains several independent run,
+   * or if it is desired to do a postprocessing of the resulting data
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   * @param os    reference to the output stream
+   * @param node  pointer to the node
+   */
+  StrategyTracer(shared_ptr<std::ostream> os, Ptr<Node> node);
+
+private:
+  void
+  Write(Block& record);
+
+private:
+  shared_ptr<std::ostream> m_os;
+
+  ::ndn::util::signal::ScopedConnection m_afterReceiveInterest;
+  ::ndn::util::signal::ScopedConnection m_beforeSatisfyInterest;
+  ::ndn::util::signal::ScopedConnection m_beforeExpirePendingInterest;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_STRATEGY_TRACER_H
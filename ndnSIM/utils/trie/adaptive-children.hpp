@@ -0,0 +1,380 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ADAPTIVE_CHILDREN_H_
+#define ADAPTIVE_CHILDREN_H_
+
+/// @cond include_hidden
+
+#include <boost/functional/hash.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Children of a trie node in an array that adapts its form to the number of children
+ *
+ * Like the nodes of an adaptive radix tree, the array grows with the node:
+ *  - up to 4 and then up to 16 children are kept in a dense array, scanned linearly
+ *  - more children are kept in an open addressing table indexed by the key hash, with linear
+ *    probing, at most half full
+ *
+ * Each slot caches the hash of the child key, so keys are compared only when the hashes match.
+ * A node without children holds no array.  Compared to hashed_children, a trie node needs no
+ * hook and bucket array of its own, and a lookup neither allocates nor copies the key.
+ */
+template<class Node, class Key>
+class adaptive_children : boost::noncopyable {
+private:
+  struct slot {
+    std::size_t hash;
+    Node* node;
+  };
+
+  template<class N, class S>
+  class iterator_base {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef N value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef N* pointer;
+    typedef N& reference;
+
+    iterator_base()
+      : pos_(0)
+      , end_(0)
+    {
+    }
+
+    iterator_base(S* pos, S* end)
+      : pos_(pos)
+      , end_(end)
+    {
+      skip();
+    }
+
+    N& operator*() const
+    {
+      return *pos_->node;
+    }
+
+    N* operator->() const
+    {
+      return pos_->node;
+    }
+
+    iterator_base&
+    operator++()
+    {
+      ++pos_;
+      skip();
+      return *this;
+    }
+
+    iterator_base
+    operator++(int)
+    {
+      iterator_base copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    bool
+    operator==(const iterator_base& other) const
+    {
+      return pos_ == other.pos_;
+    }
+
+    bool
+    operator!=(const iterator_base& other) const
+    {
+      return pos_ != other.pos_;
+    }
+
+  private:
+    void
+    skip()
+    {
+      while (pos_ != end_ && pos_->node == 0)
+        ++pos_;
+    }
+
+  private:
+    S* pos_;
+    S* end_;
+  };
+
+public:
+  typedef iterator_base<Node, slot> iterator;
+  typedef iterator_base<const Node, const slot> const_iterator;
+
+  /// @brief Largest number of children kept in a dense array
+  static const uint32_t MAX_DENSE = 16;
+
+  adaptive_children(size_t /*bucketSize*/ = 1, size_t /*bucketIncrement*/ = 1)
+    : slots_(0)
+    , size_(0)
+    , capacity_(0)
+  {
+  }
+
+  ~adaptive_children()
+  {
+    delete[] slots_;
+  }
+
+  size_t
+  size() const
+  {
+    return size_;
+  }
+
+  iterator
+  begin()
+  {
+    return iterator(slots_, slots_ + capacity_);
+  }
+
+  iterator
+  end()
+  {
+    return iterator(slots_ + capacity_, slots_ + capacity_);
+  }
+
+  const_iterator
+  begin() const
+  {
+    return const_iterator(slots_, slots_ + capacity_);
+  }
+
+  const_iterator
+  end() const
+  {
+    return const_iterator(slots_ + capacity_, slots_ + capacity_);
+  }
+
+  iterator
+  find(const Key& key)
+  {
+    slot* found = lookup(key, boost::hash<Key>()(key));
+    return found != 0 ? iterator(found, slots_ + capacity_) : end();
+  }
+
+  const_iterator
+  find(const Key& key) const
+  {
+    const slot* found = const_cast<adaptive_children*>(this)->lookup(key, boost::hash<Key>()(key));
+    return found != 0 ? const_iterator(found, slots_ + capacity_) : end();
+  }
+
+  iterator
+  iterator_to(Node& node)
+  {
+    return find(node.key());
+  }
+
+  const_iterator
+  iterator_to(const Node& node) const
+  {
+    return find(node.key());
+  }
+
+  /**
+   * @brief Adds a child, whose key must not be among the children yet
+   */
+  std::pair<iterator, bool>
+  insert(Node& node)
+  {
+    std::size_t hash = boost::hash<Key>()(node.key());
+    if (capacity_ <= MAX_DENSE) {
+      if (size_ == capacity_)
+        resize(capacity_ == 0 ? 4 : (capacity_ < MAX_DENSE ? MAX_DENSE : 4 * MAX_DENSE));
+    }
+    else if (2 * (size_ + 1) > capacity_) {
+      resize(2 * capacity_);
+    }
+
+    slot* free = place(hash);
+    free->hash = hash;
+    free->node = &node;
+    ++size_;
+    return std::make_pair(iterator(free, slots_ + capacity_), true);
+  }
+
+  template<class Disposer>
+  void
+  erase_and_dispose(Node& node, Disposer disposer)
+  {
+    slot* found = lookup(node.key(), boost::hash<Key>()(node.key()));
+    if (found == 0)
+      return;
+
+    if (capacity_ <= MAX_DENSE) {
+      // keep the array dense
+      *found = slots_[size_ - 1];
+      slots_[size_ - 1].node = 0;
+    }
+    else {
+      removeFromTable(found);
+    }
+    --size_;
+    disposer(&node);
+
+    if (size_ == 0)
+      resize(0);
+    else if (capacity_ > MAX_DENSE && size_ <= MAX_DENSE / 2)
+      resize(MAX_DENSE);
+    else if (capacity_ == MAX_DENSE && size_ <= 2)
+      resize(4);
+  }
+
+  template<class Disposer>
+  void
+  clear_and_dispose(Disposer disposer)
+  {
+    slot* slots = slots_;
+    uint32_t capacity = capacity_;
+    slots_ = 0;
+    size_ = 0;
+    capacity_ = 0;
+
+    for (uint32_t i = 0; i < capacity; ++i) {
+      if (slots[i].node != 0)
+        disposer(slots[i].node);
+    }
+    delete[] slots;
+  }
+
+  /**
+   * @brief Prints the form of the array
+   */
+  void
+  print_stat(std::ostream& os) const
+  {
+    os << " " << (capacity_ <= MAX_DENSE ? "dense " : "table ") << capacity_;
+  }
+
+private:
+  slot*
+  lookup(const Key& key, std::size_t hash)
+  {
+    if (capacity_ <= MAX_DENSE) {
+      for (uint32_t i = 0; i < size_; ++i) {
+        if (slots_[i].hash == hash && slots_[i].node->key() == key)
+          return slots_ + i;
+      }
+      return 0;
+    }
+
+    uint32_t mask = capacity_ - 1;
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+      if (slots_[i].node == 0)
+        return 0;
+      if (slots_[i].hash == hash && slots_[i].node->key() == key)
+        return slots_ + i;
+    }
+  }
+
+  /**
+   * @brief Finds the slot for a new child
+   */
+  slot*
+  place(std::size_t hash)
+  {
+    if (capacity_ <= MAX_DENSE)
+      return slots_ + size_;
+
+    uint32_t mask = capacity_ - 1;
+    uint32_t i = hash & mask;
+    while (slots_[i].node != 0)
+      i = (i + 1) & mask;
+    return slots_ + i;
+  }
+
+  /**
+   * @brief Empties a table slot, moving back the following children of the same probe sequence
+   */
+  void
+  removeFromTable(slot* removed)
+  {
+    uint32_t mask = capacity_ - 1;
+    uint32_t hole = removed - slots_;
+    for (uint32_t i = (hole + 1) & mask; slots_[i].node != 0; i = (i + 1) & mask) {
+      uint32_t home = slots_[i].hash & mask;
+      // the child may fill the hole, if the hole is between its home slot and its slot
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        slots_[hole] = slots_[i];
+        hole = i;
+      }
+    }
+    slots_[hole].node = 0;
+  }
+
+  void
+  resize(uint32_t capacity)
+  {
+    slot* slots = slots_;
+    uint32_t oldCapacity = capacity_;
+
+    slots_ = capacity > 0 ? new slot[capacity]() : 0;
+    capacity_ = capacity;
+    size_ = 0;
+    for (uint32_t i = 0; i < oldCapacity; ++i) {
+      if (slots[i].node != 0) {
+        slot* free = place(slots[i].hash);
+        *free = slots[i];
+        ++size_;
+      }
+    }
+    delete[] slots;
+  }
+
+private:
+  slot* slots_;
+  uint32_t size_;
+  uint32_t capacity_;
+};
+
+/**
+ * @brief Children of trie nodes in adaptive_children
+ */
+struct adaptive_children_traits {
+  struct hook_type {
+  };
+
+  template<class Node, class Key>
+  struct container {
+    typedef adaptive_children<Node, Key> type;
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // ADAPTIVE_CHILDREN_H_
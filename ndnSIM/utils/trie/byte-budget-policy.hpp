@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef BYTE_BUDGET_POLICY_H_
+#define BYTE_BUDGET_POLICY_H_
+
+/// @cond include_hidden
+
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for a replacement policy that caps the total size of the entries, rather than
+ *        their number
+ * @tparam PolicyTraits count-based policy that orders the entries, e.g. lru_policy_traits,
+ *         fifo_policy_traits, lfu_policy_traits or random_policy_traits
+ * @tparam Sizer functor returning the size of the entry at a trie iterator, e.g. in octets
+ *
+ * The maximum size (set_max_size) is the budget in the units of Sizer.  Inserting an entry
+ * removes the entries that PolicyTraits would replace first, until the new one fits.  An entry
+ * larger than the whole budget is not inserted.  Sizer must return the same value for an entry
+ * during its whole lifetime in the container.
+ */
+template<class PolicyTraits, class Sizer>
+struct byte_budget_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return PolicyTraits::GetName() + "Bytes";
+  }
+
+  typedef typename PolicyTraits::policy_hook_type policy_hook_type;
+
+  template<class Container>
+  struct container_hook {
+    typedef typename PolicyTraits::template container_hook<Container>::type type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename PolicyTraits::template policy<Base, Container, Hook>::type order_policy;
+
+    class type : public order_policy {
+    public:
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : order_policy(base)
+        , base_(base)
+        , max_bytes_(100)
+        , bytes_(0)
+      {
+        order_policy::set_max_size(0);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = Sizer()(item);
+        if (max_bytes_ != 0) {
+          if (size > max_bytes_)
+            return false;
+
+          while (bytes_ + size > max_bytes_ && order_policy::size() > 0) {
+            base_.erase(&(*order_policy::begin()));
+          }
+        }
+
+        if (!order_policy::insert(item))
+          return false;
+        bytes_ += size;
+        return true;
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        bytes_ -= Sizer()(item);
+        order_policy::erase(item);
+      }
+
+      inline void
+      clear()
+      {
+        order_policy::clear();
+        bytes_ = 0;
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_bytes_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_bytes_;
+      }
+
+      /**
+       * @brief Total size of the entries
+       */
+      inline size_t
+      get_current_size() const
+      {
+        return bytes_;
+      }
+
+    private:
+      Base& base_;
+      size_t max_bytes_;
+      size_t bytes_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // BYTE_BUDGET_POLICY_H_
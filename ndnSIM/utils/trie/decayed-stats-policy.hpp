@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef DECAYED_STATS_POLICY_H_
+#define DECAYED_STATS_POLICY_H_
+
+/// @cond include_hidden
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/list.hpp>
+
+#include <ns3/nstime.h>
+#include <ns3/simulator.h>
+
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for policy that keeps exponentially decayed statistics of the elements
+ *
+ * Every element has a popularity: the number of times it was inserted or looked up, where each
+ * access counts half as much after every half-life.  The same decay applies to the aggregate
+ * number of updates, inserts, lookups and erases.  Decay is applied lazily, when a value is
+ * accessed, from the time it was last updated, so no periodic walk of the trie is needed.
+ *
+ * With half-life 0, values are not decayed and the policy counts the accesses since the start.
+ */
+struct decayed_stats_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "DecayedStats";
+  }
+
+  struct policy_hook_type : public boost::intrusive::list_member_hook<> {
+    double popularity;
+    Time lastAccess;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    typedef typename boost::intrusive::list<Container, Hook> policy_container;
+
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static const policy_hook_type&
+    get_hook(typename Container::const_iterator item)
+    {
+      return *static_cast<const policy_hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , m_halfLife(Seconds(60))
+        , m_updates(0)
+        , m_inserts(0)
+        , m_lookups(0)
+        , m_erases(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        decayStats();
+        m_updates++;
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        decayStats();
+        m_inserts++;
+
+        policy_hook_type& hook = get_hook(item);
+        hook.popularity = 1;
+        hook.lastAccess = Simulator::Now();
+
+        policy_container::push_back(*item);
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        decayStats();
+        m_lookups++;
+
+        policy_hook_type& hook = get_hook(item);
+        hook.popularity = decay(hook.popularity, hook.lastAccess) + 1;
+        hook.lastAccess = Simulator::Now();
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        decayStats();
+        m_erases++;
+
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+      }
+
+      inline void set_max_size(uint32_t)
+      {
+      }
+
+      inline uint32_t
+      get_max_size() const
+      {
+        return 0;
+      }
+
+      /**
+       * @brief Set time after which an access counts half as much, 0 to disable the decay
+       */
+      inline void
+      set_half_life(const Time& halfLife)
+      {
+        decayStats();
+        m_halfLife = halfLife;
+      }
+
+      inline const Time&
+      get_half_life() const
+      {
+        return m_halfLife;
+      }
+
+      /**
+       * @brief Decayed number of accesses of the element, as of now
+       */
+      inline double
+      get_popularity(typename parent_trie::const_iterator item) const
+      {
+        const policy_hook_type& hook = get_hook(item);
+        return decay(hook.popularity, hook.lastAccess);
+      }
+
+      inline void
+      ResetStats()
+      {
+        m_statsTime = Simulator::Now();
+        m_updates = 0;
+        m_inserts = 0;
+        m_lookups = 0;
+        m_erases = 0;
+      }
+
+      inline double
+      GetUpdates() const
+      {
+        return decay(m_updates, m_statsTime);
+      }
+
+      inline double
+      GetInserts() const
+      {
+        return decay(m_inserts, m_statsTime);
+      }
+
+      inline double
+      GetLookups() const
+      {
+        return decay(m_lookups, m_statsTime);
+      }
+
+      inline double
+      GetErases() const
+      {
+        return decay(m_erases, m_statsTime);
+      }
+
+    private:
+      inline double
+      decay(double value, const Time& since) const
+      {
+        if (m_halfLife.IsZero() || value == 0)
+          return value;
+        double age = (Simulator::Now() - since).GetSeconds();
+        return value * std::exp2(-age / m_halfLife.GetSeconds());
+      }
+
+      inline void
+      decayStats()
+      {
+        Time now = Simulator::Now();
+        if (now == m_statsTime)
+          return;
+
+        m_updates = decay(m_updates, m_statsTime);
+        m_inserts = decay(m_inserts, m_statsTime);
+        m_lookups = decay(m_lookups, m_statsTime);
+        m_erases = decay(m_erases, m_statsTime);
+        m_statsTime = now;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      Time m_halfLife;
+
+      Time m_statsTime;
+      double m_updates;
+      double m_inserts;
+      double m_lookups;
+      double m_erases;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // DECAYED_STATS_POLICY_H_
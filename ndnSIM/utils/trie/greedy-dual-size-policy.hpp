@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef GREEDY_DUAL_SIZE_POLICY_H_
+#define GREEDY_DUAL_SIZE_POLICY_H_
+
+/// @cond include_hidden
+
+#include <boost/intrusive/options.hpp>
+#include <boost/intrusive/set.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Traits for GreedyDual-Size replacement policy
+ * @tparam Sizer functor returning the size of the entry at a trie iterator, e.g. in octets
+ * @tparam Cost functor returning the cost of fetching the entry again, e.g. in hops
+ *
+ * Each entry is given the priority L + cost / size, where L is the priority of the last
+ * evicted entry.  The entry with the lowest priority is replaced first, and a hit restores the
+ * priority of the entry against the current L.  The maximum size (set_max_size) is the budget
+ * in the units of Sizer.  The size of an entry is recorded on insertion and on update.
+ */
+template<class Sizer, class Cost>
+struct greedy_dual_size_policy_traits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "GreedyDualSize";
+  }
+
+  struct policy_hook_type : public boost::intrusive::set_member_hook<> {
+    double priority;
+    size_t size;
+  };
+
+  template<class Container>
+  struct container_hook {
+    typedef boost::intrusive::member_hook<Container, policy_hook_type, &Container::policy_hook_>
+      type;
+  };
+
+  template<class Base, class Container, class Hook>
+  struct policy {
+    static policy_hook_type&
+    get_hook(typename Container::iterator item)
+    {
+      return *static_cast<policy_hook_type*>(policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    static const policy_hook_type&
+    get_hook(typename Container::const_iterator item)
+    {
+      return *static_cast<const policy_hook_type*>(
+               policy_container::value_traits::to_node_ptr(*item));
+    }
+
+    template<class Key>
+    struct MemberHookLess {
+      bool
+      operator()(const Key& a, const Key& b) const
+      {
+        return get_hook(&a).priority < get_hook(&b).priority;
+      }
+    };
+
+    typedef boost::intrusive::multiset<Container,
+                                       boost::intrusive::compare<MemberHookLess<Container>>,
+                                       Hook> policy_container;
+
+    class type : public policy_container {
+    public:
+      typedef policy policy_base; // to get access to get_hook methods from outside
+      typedef Container parent_trie;
+
+      type(Base& base)
+        : base_(base)
+        , max_size_(100)
+        , current_size_(0)
+        , inflation_(0)
+      {
+      }
+
+      inline void
+      update(typename parent_trie::iterator item)
+      {
+        policy_container::erase(policy_container::s_iterator_to(*item));
+        current_size_ -= get_hook(item).size;
+        get_hook(item).size = get_size(item);
+        current_size_ += get_hook(item).size;
+        prioritize(item);
+        policy_container::insert(*item);
+      }
+
+      inline bool
+      insert(typename parent_trie::iterator item)
+      {
+        size_t size = get_size(item);
+
+        if (max_size_ != 0) {
+          if (size > max_size_)
+            return false;
+
+          while (current_size_ + size > max_size_ && !policy_container::empty()) {
+            inflation_ = get_hook(&(*policy_container::begin())).priority;
+            base_.erase(&(*policy_container::begin()));
+          }
+        }
+
+        get_hook(item).size = size;
+        prioritize(item);
+        policy_container::insert(*item);
+        current_size_ += size;
+        return true;
+      }
+
+      inline void
+      lookup(typename parent_trie::iterator item)
+      {
+        policy_container::erase(policy_container::s_iterator_to(*item));
+        prioritize(item);
+        policy_container::insert(*item);
+      }
+
+      inline void
+      erase(typename parent_trie::iterator item)
+      {
+        current_size_ -= get_hook(item).size;
+        policy_container::erase(policy_container::s_iterator_to(*item));
+      }
+
+      inline void
+      clear()
+      {
+        policy_container::clear();
+        current_size_ = 0;
+        inflation_ = 0;
+      }
+
+      inline void
+      set_max_size(size_t max_size)
+      {
+        max_size_ = max_size;
+      }
+
+      inline size_t
+      get_max_size() const
+      {
+        return max_size_;
+      }
+
+      /**
+       * @brief Total size of the entries
+       */
+      inline size_t
+      get_current_size() const
+      {
+        return current_size_;
+      }
+
+    private:
+      inline size_t
+      get_size(typename parent_trie::iterator item)
+      {
+        return std::max<size_t>(sizer_(item), 1);
+      }
+
+      inline void
+      prioritize(typename parent_trie::iterator item)
+      {
+        policy_hook_type& hook = get_hook(item);
+        hook.priority = inflation_ + static_cast<double>(cost_(item)) / hook.size;
+      }
+
+    private:
+      type()
+        : base_(*((Base*)0)){};
+
+    private:
+      Base& base_;
+      Sizer sizer_;
+      Cost cost_;
+      size_t max_size_;
+      size_t current_size_;
+      double inflation_;
+    };
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // GREEDY_DUAL_SIZE_POLICY_H_
@@ -0,0 +1,400 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TRIE_SNAPSHOT_H_
+#define TRIE_SNAPSHOT_H_
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Error while reading a trie snapshot
+ */
+class snapshot_error : public std::runtime_error {
+public:
+  explicit snapshot_error(const std::string& what)
+    : std::runtime_error(what)
+  {
+  }
+};
+
+/**
+ * @brief Writes fields of a trie snapshot
+ */
+class snapshot_writer {
+public:
+  explicit snapshot_writer(std::ostream& os)
+    : os_(os)
+  {
+  }
+
+  /**
+   * @brief Write unsigned number in LEB128 encoding (7 bits per octet)
+   */
+  void
+  write_number(uint64_t value)
+  {
+    do {
+      uint8_t octet = value & 0x7F;
+      value >>= 7;
+      if (value != 0)
+        octet |= 0x80;
+      os_.put(static_cast<char>(octet));
+    } while (value != 0);
+  }
+
+  void
+  write_bytes(const uint8_t* buf, size_t size)
+  {
+    os_.write(reinterpret_cast<const char*>(buf), size);
+  }
+
+  /**
+   * @brief Write size of the buffer followed by the buffer
+   */
+  void
+  write_block(const uint8_t* buf, size_t size)
+  {
+    write_number(size);
+    write_bytes(buf, size);
+  }
+
+private:
+  std::ostream& os_;
+};
+
+/**
+ * @brief Reads fields of a trie snapshot from memory, e.g. a mapped file
+ *
+ * Blocks are returned as pointers into the memory, without copying.
+ */
+class snapshot_reader {
+public:
+  snapshot_reader(const uint8_t* begin, const uint8_t* end)
+    : pos_(begin)
+    , end_(end)
+  {
+  }
+
+  uint64_t
+  read_number()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (pos_ == end_)
+        throw snapshot_error("Truncated number");
+      uint8_t octet = *pos_++;
+      value |= static_cast<uint64_t>(octet & 0x7F) << shift;
+      if ((octet & 0x80) == 0)
+        return value;
+    }
+    throw snapshot_error("Number is too large");
+  }
+
+  const uint8_t*
+  read_bytes(size_t size)
+  {
+    if (static_cast<size_t>(end_ - pos_) < size)
+      throw snapshot_error("Truncated block");
+    const uint8_t* bytes = pos_;
+    pos_ += size;
+    return bytes;
+  }
+
+  /**
+   * @brief Read block written by snapshot_writer::write_block
+   * @returns pointer to the block, its size is stored in @p size
+   */
+  const uint8_t*
+  read_block(size_t& size)
+  {
+    size = read_number();
+    return read_bytes(size);
+  }
+
+  /**
+   * @brief Reader limited to the next block, for fields of an entry
+   */
+  snapshot_reader
+  sub_reader()
+  {
+    size_t size;
+    const uint8_t* block = read_block(size);
+    return snapshot_reader(block, block + size);
+  }
+
+  bool
+  empty() const
+  {
+    return pos_ == end_;
+  }
+
+private:
+  const uint8_t* pos_;
+  const uint8_t* end_;
+};
+
+/**
+ * @brief How the keys of the trie are stored in a snapshot
+ *
+ * The default implementation is for ndn::Name, where every component is stored as its TLV.
+ * Specialize it for other key types.
+ */
+template<class FullKey>
+struct snapshot_key_traits {
+  typedef typename FullKey::value_type Key;
+
+  static void
+  write_component(snapshot_writer& writer, const Key& component)
+  {
+    const Block& wire = component.wireEncode();
+    writer.write_block(wire.wire(), wire.size());
+  }
+
+  static Key
+  read_component(snapshot_reader& reader)
+  {
+    size_t size;
+    const uint8_t* wire = reader.read_block(size);
+    try {
+      return Key(Block(wire, size));
+    }
+    catch (const ::ndn::tlv::Error&) {
+      throw snapshot_error("Invalid name component");
+    }
+  }
+
+  static void
+  truncate(FullKey& key, size_t nComponents)
+  {
+    key = key.getPrefix(nComponents);
+  }
+
+  static void
+  append(FullKey& key, const Key& component)
+  {
+    key.append(component);
+  }
+};
+
+/// @cond include_hidden
+struct snapshot_no_metadata {
+  template<class Node>
+  void
+  operator()(snapshot_writer&, const Node&) const
+  {
+  }
+
+  template<class Iterator>
+  void
+  operator()(snapshot_reader&, Iterator) const
+  {
+  }
+};
+/// @endcond
+
+static const char SNAPSHOT_MAGIC[4] = {'N', 'T', 'S', '1'};
+
+/**
+ * @brief Write entries of a trie as a snapshot
+ *
+ * Entries are written in the order of the range, so a range over the replacement policy,
+ * e.g. getPolicy().begin() and getPolicy().end() for LRU or FIFO, keeps that order when the
+ * snapshot is loaded.  A recursive_iterator range over the trie works with any policy.  Nodes
+ * without payload are skipped.
+ *
+ * Each name is stored as the number of leading components shared with the previous name,
+ * followed by the remaining components.
+ *
+ * @param savePayload called as savePayload(writer, node) to store the payload of the node
+ * @param saveMetadata called as saveMetadata(writer, node) after the payload, to store state
+ *                     of the policy, e.g. LFU frequency
+ * @returns number of entries written
+ */
+template<class Iterator, class PayloadSaver, class MetadataSaver>
+size_t
+save_snapshot(std::ostream& os, Iterator begin, Iterator end, PayloadSaver savePayload,
+              MetadataSaver saveMetadata)
+{
+  typedef typename std::remove_const<typename std::remove_reference<decltype(*begin)>::type>::type
+    node_type;
+  typedef snapshot_key_traits<typename node_type::full_key_type> key_traits;
+
+  std::vector<const node_type*> nodes;
+  for (Iterator i = begin; i != end; ++i) {
+    if (!(i->payload() == node_type::payload_traits::empty_payload))
+      nodes.push_back(&*i);
+  }
+
+  os.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  snapshot_writer writer(os);
+  writer.write_number(nodes.size());
+
+  std::vector<const node_type*> previous;
+  std::vector<const node_type*> path;
+  std::ostringstream field;
+  for (const node_type* entry : nodes) {
+    // path from the root (excluded) to the node
+    path.clear();
+    for (const node_type* node = entry; node->parent() != 0; node = node->parent()) {
+      path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+
+    size_t nShared = 0;
+    while (nShared < path.size() && nShared < previous.size() &&
+           path[nShared] == previous[nShared]) {
+      ++nShared;
+    }
+    writer.write_number(nShared);
+    writer.write_number(path.size() - nShared);
+    for (size_t i = nShared; i < path.size(); ++i) {
+      key_traits::write_component(writer, path[i]->key());
+    }
+
+    field.str("");
+    snapshot_writer payloadWriter(field);
+    savePayload(payloadWriter, *entry);
+    std::string payload = field.str();
+    writer.write_block(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+
+    field.str("");
+    snapshot_writer metadataWriter(field);
+    saveMetadata(metadataWriter, *entry);
+    std::string metadata = field.str();
+    writer.write_block(reinterpret_cast<const uint8_t*>(metadata.data()), metadata.size());
+
+    previous.swap(path);
+  }
+
+  return nodes.size();
+}
+
+/**
+ * @brief Write entries of a trie as a snapshot, without policy state
+ */
+template<class Iterator, class PayloadSaver>
+size_t
+save_snapshot(std::ostream& os, Iterator begin, Iterator end, PayloadSaver savePayload)
+{
+  return save_snapshot(os, begin, end, savePayload, snapshot_no_metadata());
+}
+
+/**
+ * @brief Insert entries of a snapshot into a trie_with_policy
+ *
+ * @param loadPayload called as loadPayload(reader), returns the payload to insert
+ * @param loadMetadata called as loadMetadata(reader, iterator) after the entry is inserted
+ * @returns number of inserted entries; entries that already exist or that the policy rejects
+ *          are not counted
+ * @throws snapshot_error the snapshot is malformed
+ */
+template<class Trie, class PayloadLoader, class MetadataLoader>
+size_t
+load_snapshot(Trie& trie, const uint8_t* begin, const uint8_t* end, PayloadLoader loadPayload,
+              MetadataLoader loadMetadata)
+{
+  typedef typename Trie::parent_trie::payload_traits::storage_type storage_type;
+  typedef snapshot_key_traits<typename Trie::full_key_type> key_traits;
+
+  if (static_cast<size_t>(end - begin) < sizeof(SNAPSHOT_MAGIC) ||
+      std::memcmp(begin, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+    throw snapshot_error("Not a trie snapshot");
+
+  snapshot_reader reader(begin + sizeof(SNAPSHOT_MAGIC), end);
+  uint64_t nEntries = reader.read_number();
+
+  typename Trie::full_key_type key;
+  size_t keySize = 0;
+  size_t nInserted = 0;
+  for (uint64_t i = 0; i < nEntries; ++i) {
+    uint64_t nShared = reader.read_number();
+    uint64_t nNew = reader.read_number();
+    if (nShared > keySize)
+      throw snapshot_error("Invalid shared prefix");
+
+    key_traits::truncate(key, nShared);
+    for (uint64_t j = 0; j < nNew; ++j) {
+      key_traits::append(key, key_traits::read_component(reader));
+    }
+    keySize = nShared + nNew;
+
+    snapshot_reader payloadReader = reader.sub_reader();
+    storage_type payload = loadPayload(payloadReader);
+    snapshot_reader metadataReader = reader.sub_reader();
+
+    std::pair<typename Trie::iterator, bool> item = trie.insert(key, payload);
+    if (item.second) {
+      loadMetadata(metadataReader, item.first);
+      ++nInserted;
+    }
+  }
+
+  return nInserted;
+}
+
+/**
+ * @brief Insert entries of a snapshot into a trie_with_policy, without policy state
+ */
+template<class Trie, class PayloadLoader>
+size_t
+load_snapshot(Trie& trie, const uint8_t* begin, const uint8_t* end, PayloadLoader loadPayload)
+{
+  return load_snapshot(trie, begin, end, loadPayload, snapshot_no_metadata());
+}
+
+/**
+ * @brief Map the snapshot file into memory and insert its entries into a trie_with_policy
+ */
+template<class Trie, class PayloadLoader, class MetadataLoader>
+size_t
+load_snapshot_file(Trie& trie, const std::string& file, PayloadLoader loadPayload,
+                   MetadataLoader loadMetadata)
+{
+  boost::iostreams::mapped_file_source mapped(file);
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(mapped.data());
+  return load_snapshot(trie, data, data + mapped.size(), loadPayload, loadMetadata);
+}
+
+template<class Trie, class PayloadLoader>
+size_t
+load_snapshot_file(Trie& trie, const std::string& file, PayloadLoader loadPayload)
+{
+  return load_snapshot_file(trie, file, loadPayload, snapshot_no_metadata());
+}
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+#endif // TRIE_SNAPSHOT_H_
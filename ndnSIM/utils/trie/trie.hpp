@@ -98,24 +98,191 @@ struct non_pointer_traits {
 template<typename Payload, typename BasePayload>
 Payload non_pointer_traits<Payload, BasePayload>::empty_payload = Payload();
 
+/////////////////////////////////////////////////////
+// Allow customization for children of a node
+//
+
+/**
+ * @brief Children of a trie node in an intrusive hash set with a bucket array of the node
+ *
+ * The bucket array grows by bucketIncrement buckets, and bucketIncrement doubles every time.
+ */
+template<class Node, class Key>
+class hashed_children : boost::noncopyable {
+private:
+  typedef boost::intrusive::member_hook<Node, boost::intrusive::unordered_set_member_hook<>,
+                                        &Node::children_hook_> member_hook;
+
+  typedef boost::intrusive::unordered_set<Node, member_hook> unordered_set;
+  typedef typename unordered_set::bucket_type bucket_type;
+  typedef typename unordered_set::bucket_traits bucket_traits;
+
+  template<class D>
+  struct array_disposer {
+    void
+    operator()(D* array)
+    {
+      delete[] array;
+    }
+  };
+
+  struct key_equal {
+    bool
+    operator()(const Key& key, const Node& node) const
+    {
+      return key == node.key();
+    }
+  };
+
+public:
+  typedef typename unordered_set::iterator iterator;
+  typedef typename unordered_set::const_iterator const_iterator;
+
+  hashed_children(size_t bucketSize = 1, size_t bucketIncrement = 1)
+    : bucketSize_(bucketSize)
+    , bucketIncrement_(bucketIncrement)
+    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
+                                             // buckets should be larger than lifetime of the
+                                             // container
+    , children_(bucket_traits(buckets_.get(), bucketSize_))
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return children_.size();
+  }
+
+  iterator
+  begin()
+  {
+    return children_.begin();
+  }
+
+  iterator
+  end()
+  {
+    return children_.end();
+  }
+
+  const_iterator
+  begin() const
+  {
+    return children_.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return children_.end();
+  }
+
+  iterator
+  find(const Key& key)
+  {
+    return children_.find(key, boost::hash<Key>(), key_equal());
+  }
+
+  const_iterator
+  find(const Key& key) const
+  {
+    return children_.find(key, boost::hash<Key>(), key_equal());
+  }
+
+  iterator
+  iterator_to(Node& node)
+  {
+    return children_.iterator_to(node);
+  }
+
+  const_iterator
+  iterator_to(const Node& node) const
+  {
+    return children_.iterator_to(node);
+  }
+
+  std::pair<iterator, bool>
+  insert(Node& node)
+  {
+    if (children_.size() >= bucketSize_) {
+      bucketSize_ += bucketIncrement_;
+      bucketIncrement_ *= 2; // increase bucketIncrement exponentially
+
+      buckets_array newBuckets(new bucket_type[bucketSize_]);
+      children_.rehash(bucket_traits(newBuckets.get(), bucketSize_));
+      buckets_.swap(newBuckets);
+    }
+
+    return children_.insert(node);
+  }
+
+  template<class Disposer>
+  void
+  erase_and_dispose(Node& node, Disposer disposer)
+  {
+    children_.erase_and_dispose(node, disposer);
+  }
+
+  template<class Disposer>
+  void
+  clear_and_dispose(Disposer disposer)
+  {
+    children_.clear_and_dispose(disposer);
+  }
+
+  /**
+   * @brief Prints the number of children in each bucket
+   */
+  void
+  print_stat(std::ostream& os) const
+  {
+    for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
+      os << " " << children_.bucket_size(bucket);
+    }
+  }
+
+private:
+  size_t bucketSize_;
+  size_t bucketIncrement_;
+
+  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
+  buckets_array buckets_;
+  unordered_set children_;
+};
+
+/**
+ * @brief Children of trie nodes in hashed_children, the default
+ */
+struct hashed_children_traits {
+  typedef boost::intrusive::unordered_set_member_hook<> hook_type;
+
+  template<class Node, class Key>
+  struct container {
+    typedef hashed_children<Node, Key> type;
+  };
+};
+
 ////////////////////////////////////////////////////
 // forward declarations
 //
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         typename ChildrenTraits = hashed_children_traits>
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+operator<<(std::ostream& os,
+           const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& b);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -126,9 +293,15 @@ class trie_iterator;
 template<class T>
 class trie_point_iterator;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+/**
+ * @brief Trie of names, each node holding a payload and a name component as its key
+ * @tparam ChildrenTraits how children of a node are kept (hashed_children_traits or
+ *         adaptive_children_traits)
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 class trie {
 public:
+  typedef FullKey full_key_type;
   typedef typename FullKey::value_type Key;
 
   typedef trie* iterator;
@@ -146,11 +319,7 @@ public:
     : key_(key)
     , initialBucketSize_(bucketSize)
     , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
+    , children_(bucketSize, bucketIncrement)
     , payload_(PayloadTraits::empty_payload)
     , parent_(nullptr)
   {
@@ -184,11 +353,10 @@ public:
   }
 
   // actual entry
-  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-                           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+  friend bool operator==<>(const trie& a, const trie& b);
 
   friend std::size_t
-  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+  hash_value<>(const trie& trie_node);
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
@@ -196,22 +364,13 @@ public:
     trie* trieNode = this;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename children_type::iterator item = trieNode->children_.find(subkey);
       if (item == trieNode->children_.end()) {
         trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
         // std::cout << "new " << newNode << "\n";
         newNode->parent_ = trieNode;
 
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
-          trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
-
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
-          trieNode->buckets_.swap(newBuckets);
-        }
-
-        std::pair<typename unordered_set::iterator, bool> ret =
+        std::pair<typename children_type::iterator, bool> ret =
           trieNode->children_.insert(*newNode);
 
         trieNode = &(*ret.first);
@@ -295,7 +454,7 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename children_type::iterator item = trieNode->children_.find(subkey);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -326,7 +485,7 @@ public:
     bool reachLast = true;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename children_type::iterator item = trieNode->children_.find(subkey);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -354,8 +513,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
+    for (typename children_type::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++)
     // BOOST_FOREACH (trie &subnode, children_)
     {
@@ -380,8 +538,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
+    for (typename children_type::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++)
     // BOOST_FOREACH (const trie &subnode, children_)
     {
@@ -406,8 +563,7 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-    for (typename trie::unordered_set::iterator subnode = children_.begin();
+    for (typename children_type::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++) {
       if (pred(subnode->key())) {
         return subnode->find();
@@ -447,12 +603,21 @@ public:
     payload_ = payload;
   }
 
-  Key
+  const Key&
   key() const
   {
     return key_;
   }
 
+  /**
+   * @brief Parent node, 0 for the root
+   */
+  const_iterator
+  parent() const
+  {
+    return parent_;
+  }
+
   inline void
   PrintStat(std::ostream& os) const;
 
@@ -466,31 +631,16 @@ private:
     }
   };
 
-  template<class D>
-  struct array_disposer {
-    void
-    operator()(D* array)
-    {
-      delete[] array;
-    }
-  };
-
   friend std::ostream& operator<<<>(std::ostream& os, const trie& trie_node);
 
 public:
   PolicyHook policy_hook_;
+  typename ChildrenTraits::hook_type children_hook_; ///< used by the children container
 
 private:
-  boost::intrusive::unordered_set_member_hook<> unordered_set_member_hook_;
-
   // necessary typedefs
   typedef trie self_type;
-  typedef boost::intrusive::member_hook<trie, boost::intrusive::unordered_set_member_hook<>,
-                                        &trie::unordered_set_member_hook_> member_hook;
-
-  typedef boost::intrusive::unordered_set<trie, member_hook> unordered_set;
-  typedef typename unordered_set::bucket_type bucket_type;
-  typedef typename unordered_set::bucket_traits bucket_traits;
+  typedef typename ChildrenTraits::template container<trie, Key>::type children_type;
 
   template<class T, class NonConstT>
   friend class trie_iterator;
@@ -507,24 +657,22 @@ private:
   size_t initialBucketSize_;
   size_t bucketIncrement_;
 
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
-  unordered_set children_;
+  children_type children_;
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
 };
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+operator<<(std::ostream& os,
+           const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& trie_node)
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
      << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits> trie;
 
-  for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
+  for (typename trie::children_type::const_iterator subnode = trie_node.children_.begin();
        subnode != trie_node.children_.end(); subnode++)
   // BOOST_FOREACH (const trie &subnode, trie_node.children_)
   {
@@ -546,19 +694,16 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>::PrintStat(std::ostream& os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
      << children_.size() << " children" << std::endl;
-  for (size_t bucket = 0, maxbucket = children_.bucket_count(); bucket < maxbucket; bucket++) {
-    os << " " << children_.bucket_size(bucket);
-  }
+  children_.print_stat(os);
   os << "\n";
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
-  for (typename trie::unordered_set::const_iterator subnode = children_.begin();
+  for (typename children_type::const_iterator subnode = children_.begin();
        subnode != children_.end(); subnode++)
   // BOOST_FOREACH (const trie &subnode, children_)
   {
@@ -566,17 +711,17 @@ trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
   }
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 inline bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b)
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& b)
 {
   return a.key_ == b.key_;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename ChildrenTraits>
 inline std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, ChildrenTraits>& trie_node)
 {
   return boost::hash_value(trie_node.key_);
 }
@@ -653,8 +798,8 @@ public:
 
 private:
   typedef typename boost::mpl::if_<boost::is_same<Trie, NonConstTrie>,
-                                   typename Trie::unordered_set::iterator,
-                                   typename Trie::unordered_set::const_iterator>::type set_iterator;
+                                   typename Trie::children_type::iterator,
+                                   typename Trie::children_type::const_iterator>::type set_iterator;
 
   Trie*
   goUp()
@@ -684,8 +829,8 @@ template<class Trie>
 class trie_point_iterator {
 private:
   typedef typename boost::mpl::if_<boost::is_same<Trie, const Trie>,
-                                   typename Trie::unordered_set::const_iterator,
-                                   typename Trie::unordered_set::iterator>::type set_iterator;
+                                   typename Trie::children_type::const_iterator,
+                                   typename Trie::children_type::iterator>::type set_iterator;
 
 public:
   trie_point_iterator()
@@ -104,22 +104,20 @@ int main (int argc, char *argv[])
   ndn::AppHelper consumerHelper1("ns3::ndn::ConsumerRandomCbr");
   consumerHelper1.SetAttribute("Frequency", StringValue("1.0"));  //1 interests a second
   ApplicationContainer consumerApp2 = consumerHelper1.Install(c.Get(100));
+  ndn::AppHelper::AssignStreams(consumerApp2, 0); // reproducible names for a given --RngRun
   consumerApp2.Start(Seconds(710));
   consumerApp2.Stop(Seconds(800));
 
   // Producer
-  ndn::AppHelper producerHelper1("ns3::ndn::Producer");
-  // Producer will reply to all requests starting with /prefix
-  producerHelper1.SetPrefix("/S/addr_0/addr_0_1/addr_0_1_0/A/app_0");
+  // One producer app (and face) serves all prefixes of the last node
+  ndn::AppHelper producerHelper1("ns3::ndn::MultiPrefixProducer");
+  // Producer will reply to all requests starting with one of the prefixes
+  producerHelper1.SetAttribute("Prefixes", StringValue("/S/addr_0/addr_0_1/addr_0_1_0/A/app_0 "
+                                                       "/S/addr_0/addr_0_1/addr_0_1_1/A/app_0 "
+                                                       "/S/addr_0/addr_0_1/addr_0_1_2/A/app_0"));
   producerHelper1.SetAttribute("PayloadSize", StringValue("1024"));  //1-Chunk
   producerHelper1.Install(c.Get(nodeNum-1)); // last node
 
-  producerHelper1.SetPrefix("/S/addr_0/addr_0_1/addr_0_1_1/A/app_0");
-  producerHelper1.Install(c.Get(nodeNum-1)); // last nod
-
-  producerHelper1.SetPrefix("/S/addr_0/addr_0_1/addr_0_1_2/A/app_0");
-  producerHelper1.Install(c.Get(nodeNum-1)); // last node
-
   /*
   ndn::AppHelper producerHelper2("ns3::ndn::Producer");
   // Producer will reply to all requests starting with /prefix
@@ -0,0 +1,131 @@
+#!/bin/bash
+#
+# Run independent replications of a scratch scenario in parallel and merge their traces.
+#
+# Every replication runs with its own --RngRun in a separate directory that mirrors the
+# working directory (input files are symlinked), so trace files written to relative paths
+# do not clash.  Each trace file is then merged into OUTDIR with an extra leading "Run" column.
+#
+# Usage: run-replications.sh [options] <scenario> <trace-file>... [-- <scenario arguments>]
+#
+#   -n N        number of replications (default 10)
+#   -j JOBS     number of replications running at the same time (default: number of CPUs)
+#   -r RUN      first RngRun value (default 1)
+#   -o OUTDIR   output directory (default replications-<scenario>)
+#   -w WORKDIR  directory the scenario is normally run from (default: current directory)
+#   -B          do not build the scenario before running
+#
+# Example:
+#   scratch/run-replications.sh -n 20 Simulation2 \
+#     Liutingting/app-delays-trace.txt Liutingting/rate-trace.txt
+
+set -e
+
+NS3_DIR=${NS3_DIR:-$(cd "$(dirname "$0")/.." && pwd)}
+
+runs=10
+maxJobs=$(nproc 2>/dev/null || echo 1)
+firstRun=1
+outDir=
+workDir=$(pwd)
+build=1
+
+while getopts "n:j:r:o:w:B" opt; do
+  case $opt in
+    n) runs=$OPTARG ;;
+    j) maxJobs=$OPTARG ;;
+    r) firstRun=$OPTARG ;;
+    o) outDir=$OPTARG ;;
+    w) workDir=$(cd "$OPTARG" && pwd) ;;
+    B) build=0 ;;
+    *) sed -n '2,20p' "$0"; exit 1 ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 2 ]; then
+  sed -n '2,20p' "$0"
+  exit 1
+fi
+
+scenario=$1
+shift
+
+traces=()
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+  traces+=("$1")
+  shift
+done
+[ "$1" == "--" ] && shift
+scenarioArgs=("$@")
+
+outDir=$(mkdir -p "${outDir:-replications-$scenario}" && cd "${outDir:-replications-$scenario}" && pwd)
+
+if [ $build -eq 1 ]; then
+  (cd "$NS3_DIR" && ./waf build)
+fi
+
+binary="$NS3_DIR/build/scratch/$scenario"
+if [ ! -x "$binary" ]; then
+  echo "Cannot find scenario binary $binary" >&2
+  exit 1
+fi
+export LD_LIBRARY_PATH="$NS3_DIR/build${LD_LIBRARY_PATH:+:$LD_LIBRARY_PATH}"
+
+runOne() {
+  local run=$1
+  local runDir="$outDir/run-$run"
+
+  rm -rf "$runDir"
+  mkdir -p "$runDir"
+  for entry in "$workDir"/*; do
+    [ "$entry" == "$outDir" ] && continue
+    cp -rs "$entry" "$runDir/"
+  done
+  for trace in "${traces[@]}"; do
+    rm -f "$runDir/$trace"
+    mkdir -p "$runDir/$(dirname "$trace")"
+  done
+
+  if (cd "$runDir" && "$binary" --RngRun=$run "${scenarioArgs[@]}" > stdout.log 2> stderr.log); then
+    echo "Run $run done"
+  else
+    echo "Run $run FAILED, see $runDir/stderr.log" >&2
+    return 1
+  fi
+}
+
+failed=0
+pids=()
+for ((run = firstRun; run < firstRun + runs; run++)); do
+  while [ $(jobs -rp | wc -l) -ge $maxJobs ]; do
+    sleep 1
+  done
+  runOne $run &
+  pids+=($!)
+done
+for pid in "${pids[@]}"; do
+  wait $pid || failed=$((failed + 1))
+done
+
+# merge traces: header of the first replication, rows prefixed with the run number
+for trace in "${traces[@]}"; do
+  merged="$outDir/$(basename "$trace")"
+  header=0
+  : > "$merged"
+  for ((run = firstRun; run < firstRun + runs; run++)); do
+    file="$outDir/run-$run/$trace"
+    [ -f "$file" ] || continue
+    if [ $header -eq 0 ]; then
+      head -n 1 "$file" | sed 's/^/Run\t/' >> "$merged"
+      header=1
+    fi
+    tail -n +2 "$file" | sed "s/^/$run\t/" >> "$merged"
+  done
+  echo "Merged $trace into $merged"
+done
+
+if [ $failed -gt 0 ]; then
+  echo "$failed replication(s) failed" >&2
+  exit 1
+fi